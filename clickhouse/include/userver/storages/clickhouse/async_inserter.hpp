@@ -0,0 +1,162 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/async_inserter.hpp
+/// @brief @copybrief storages::clickhouse::AsyncInserter
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/storages/clickhouse/fwd.hpp>
+#include <userver/storages/clickhouse/impl/insertion_request.hpp>
+#include <userver/storages/clickhouse/options.hpp>
+#include <userver/utils/meta.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+/// Settings of storages::clickhouse::AsyncInserter
+struct AsyncInserterSettings final {
+  /// Table to insert into
+  std::string table_name;
+
+  /// Names of the columns of the table, in the order of the row fields
+  std::vector<std::string> column_names;
+
+  /// The buffer is flushed once it has this many rows
+  std::size_t max_rows{100'000};
+
+  /// The buffer is flushed once its estimated size reaches this many bytes
+  std::size_t max_bytes{16 * 1024 * 1024};
+
+  /// The buffer is flushed at least this often
+  std::chrono::milliseconds flush_interval{1000};
+
+  /// Rows that do not fit into the buffer are dropped, e.g. while
+  /// ClickHouse is unavailable
+  std::size_t max_buffered_rows{1'000'000};
+
+  /// Number of retries of a failed insert before its rows are dropped
+  std::size_t max_retries{3};
+
+  /// Delay between the retries of a failed insert
+  std::chrono::milliseconds retry_delay{100};
+
+  /// Command control of the inserts
+  OptionalCommandControl command_control;
+};
+
+// clang-format off
+
+/// @brief Accumulates rows from many tasks into column buffers and inserts
+/// them into a table of the cluster as large blocks on a background task.
+///
+/// ClickHouse is optimized for large and infrequent inserts, so instead of
+/// an INSERT per Cluster::InsertRows call the rows are buffered and flushed
+/// when the buffer reaches AsyncInserterSettings::max_rows or
+/// AsyncInserterSettings::max_bytes, or AsyncInserterSettings::flush_interval
+/// passes. Failed inserts are retried, the remaining buffered rows are flushed
+/// on destruction.
+///
+/// `Row` requirements are the same as for Cluster::InsertRows, see
+/// @ref clickhouse_io.
+///
+/// Usually retrieved from components::ClickHouseAsyncInserter component.
+
+// clang-format on
+class AsyncInserter final {
+ public:
+  AsyncInserter(ClusterPtr cluster, AsyncInserterSettings settings);
+
+  /// Stops the background task and flushes the buffered rows
+  ~AsyncInserter();
+
+  AsyncInserter(AsyncInserter&&) = delete;
+  AsyncInserter& operator=(AsyncInserter&&) = delete;
+
+  /// Adds a row to the buffer
+  template <typename Row>
+  void Insert(const Row& row);
+
+  /// Adds the rows of the container to the buffer
+  template <typename Container>
+  void InsertRows(const Container& rows);
+
+  /// Synchronously inserts the buffered rows
+  void Flush();
+
+  /// Write inserter statistics
+  void WriteStatistics(
+      USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
+
+ private:
+  const std::string& GetTableName() const;
+  const std::vector<std::string_view>& GetColumnNames() const;
+
+  void DoInsert(impl::InsertionRequest&& request, std::size_t bytes);
+
+  static void InsertBlock(const Cluster& cluster, OptionalCommandControl,
+                          const impl::InsertionRequest& request);
+
+  template <typename T>
+  static std::size_t EstimateSize(const T& value);
+
+  template <typename Row>
+  static std::size_t EstimateRowSize(const Row& row);
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+template <typename Row>
+void AsyncInserter::Insert(const Row& row) {
+  InsertRows(std::vector<Row>{row});
+}
+
+template <typename Container>
+void AsyncInserter::InsertRows(const Container& rows) {
+  if (rows.empty()) return;
+
+  std::size_t bytes = 0;
+  for (const auto& row : rows) bytes += EstimateRowSize(row);
+
+  DoInsert(impl::InsertionRequest::CreateFromRows(GetTableName(),
+                                                  GetColumnNames(), rows),
+           bytes);
+}
+
+template <typename T>
+std::size_t AsyncInserter::EstimateSize(const T& value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return sizeof(std::uint64_t) + value.size();
+  } else if constexpr (meta::kIsOptional<T>) {
+    return 1 + (value ? EstimateSize(*value) : 0);
+  } else if constexpr (meta::kIsVector<T>) {
+    std::size_t size = sizeof(std::uint64_t);
+    for (const auto& item : value) size += EstimateSize(item);
+    return size;
+  } else {
+    return sizeof(T);
+  }
+}
+
+template <typename Row>
+std::size_t AsyncInserter::EstimateRowSize(const Row& row) {
+  std::size_t size = 0;
+  boost::pfr::for_each_field(
+      row, [&size](const auto& field) { size += EstimateSize(field); });
+  return size;
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
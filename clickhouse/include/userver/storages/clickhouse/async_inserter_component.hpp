@@ -0,0 +1,77 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/async_inserter_component.hpp
+/// @brief @copybrief components::ClickHouseAsyncInserter
+
+#include <memory>
+
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+class AsyncInserter;
+}
+
+namespace components {
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Buffered asynchronous inserter into a single ClickHouse table
+///
+/// Provides storages::clickhouse::AsyncInserter for the table, see its
+/// description for the details.
+///
+/// ## Static configuration example:
+///
+/// ```
+/// # yaml
+/// clickhouse-events-inserter:
+///     clickhouse: clickhouse-database
+///     table: events
+///     columns: [id, name, created_at]
+///     max_rows: 100000
+///     flush_interval: 1s
+/// ```
+///
+/// ## Static options:
+/// Name              | Description                                           | Default value
+/// ----------------- | ----------------------------------------------------- | -------------
+/// clickhouse        | name of the components::ClickHouse component to use   | -
+/// table             | name of the table to insert into                      | -
+/// columns           | names of the columns, in the order of the row fields  | -
+/// max_rows          | flush once the buffer has this many rows              | 100000
+/// max_bytes         | flush once the buffer has this many bytes (estimated) | 16777216
+/// flush_interval    | flush at least this often                             | 1s
+/// max_buffered_rows | rows that do not fit into the buffer are dropped      | 1000000
+/// max_retries       | retries of a failed insert before dropping its rows   | 3
+/// retry_delay       | delay between the retries of a failed insert          | 100ms
+
+// clang-format on
+
+class ClickHouseAsyncInserter : public LoggableComponentBase {
+ public:
+  /// Component constructor
+  ClickHouseAsyncInserter(const ComponentConfig&, const ComponentContext&);
+  /// Component destructor
+  ~ClickHouseAsyncInserter() override;
+
+  /// Inserter accessor
+  storages::clickhouse::AsyncInserter& GetInserter() const;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::unique_ptr<storages::clickhouse::AsyncInserter> inserter_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+template <>
+inline constexpr bool kHasValidate<ClickHouseAsyncInserter> = true;
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,92 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/block_view.hpp
+/// @brief @copybrief storages::clickhouse::BlockView
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/storages/clickhouse/impl/block_wrapper_fwd.hpp>
+#include <userver/storages/clickhouse/io/impl/validate.hpp>
+#include <userver/storages/clickhouse/io/result_mapper.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+// clang-format off
+
+/// @brief Non-owning view of a single block of data received from the server,
+/// passed to the handler of storages::clickhouse::Cluster::ExecuteStreaming.
+///
+/// The view and the columns obtained from it are only valid until
+/// the handler returns.
+///
+/// ## Usage example:
+///
+/// @snippet storages/tests/execute_chtest.cpp  Sample BlockView usage
+
+// clang-format on
+class BlockView final {
+ public:
+  explicit BlockView(impl::BlockWrapper& block);
+
+  /// Returns number of columns in the block.
+  size_t GetColumnsCount() const;
+
+  /// Returns number of rows in the block.
+  size_t GetRowsCount() const;
+
+  /// Returns typed columns of the block, as mapped by
+  /// `io::CppToClickhouse<T>::mapped_type`, without copying the data.
+  /// See @ref clickhouse_io for better understanding of `T`'s requirements.
+  template <typename T>
+  typename io::CppToClickhouse<T>::mapped_type GetColumns() const;
+
+  /// Converts the block to strongly-typed struct of vectors.
+  /// See @ref clickhouse_io for better understanding of `T`'s requirements.
+  template <typename T>
+  T As() const;
+
+ private:
+  template <typename MappedType, size_t... Indices>
+  MappedType DoGetColumns(std::index_sequence<Indices...>) const;
+
+  impl::BlockWrapper& block_;
+};
+
+template <typename T>
+typename io::CppToClickhouse<T>::mapped_type BlockView::GetColumns() const {
+  io::impl::ValidateColumnsCount<T>(GetColumnsCount());
+
+  using MappedType = typename io::CppToClickhouse<T>::mapped_type;
+  return DoGetColumns<MappedType>(
+      std::make_index_sequence<std::tuple_size_v<MappedType>>{});
+}
+
+template <typename T>
+T BlockView::As() const {
+  T result{};
+  io::impl::ValidateColumnsMapping(result);
+  io::impl::ValidateColumnsCount<T>(GetColumnsCount());
+
+  using MappedType = typename io::CppToClickhouse<T>::mapped_type;
+  io::ColumnsMapper<MappedType> mapper{block_};
+
+  boost::pfr::for_each_field(result, mapper);
+
+  return result;
+}
+
+template <typename MappedType, size_t... Indices>
+MappedType BlockView::DoGetColumns(std::index_sequence<Indices...>) const {
+  return MappedType{std::tuple_element_t<Indices, MappedType>{
+      io::columns::GetWrappedColumn(block_, Indices)}...};
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
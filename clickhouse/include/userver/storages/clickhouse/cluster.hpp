@@ -6,11 +6,13 @@
 #include <atomic>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/components/component_fwd.hpp>
 
+#include <userver/storages/clickhouse/block_view.hpp>
 #include <userver/storages/clickhouse/fwd.hpp>
 #include <userver/storages/clickhouse/impl/insertion_request.hpp>
 #include <userver/storages/clickhouse/impl/pool.hpp>
@@ -60,6 +62,28 @@ class Cluster final {
   ExecutionResult Execute(OptionalCommandControl, const Query& query,
                           const Args&... args) const;
 
+  /// @brief Execute a statement at some host of the cluster
+  /// with args as query parameters, passing each block of the result
+  /// to `handler` as soon as it is received.
+  ///
+  /// Unlike Execute, the result is never materialized as a whole, so the
+  /// memory usage is bounded by the size of a single block.
+  /// `handler` is invoked as `handler(const BlockView&)`, an exception thrown
+  /// from it aborts the query and is rethrown.
+  /// @note CommandControl::execute limits the whole query, including the time
+  /// spent in `handler`.
+  template <typename BlockHandler, typename... Args>
+  void ExecuteStreaming(const Query& query, BlockHandler&& handler,
+                        const Args&... args) const;
+
+  /// @brief Execute a statement with specified command control settings
+  /// at some host of the cluster with args as query parameters, passing each
+  /// block of the result to `handler` as soon as it is received.
+  /// @see ExecuteStreaming
+  template <typename BlockHandler, typename... Args>
+  void ExecuteStreaming(OptionalCommandControl, const Query& query,
+                        BlockHandler&& handler, const Args&... args) const;
+
   /// @brief Insert data at some host of the cluster;
   /// `T` is expected to be a struct of vectors of same length.
   /// @param table_name table to insert into
@@ -126,11 +150,16 @@ class Cluster final {
   };
 
  private:
+  friend class AsyncInserter;
+
   void DoInsert(OptionalCommandControl,
                 const impl::InsertionRequest& request) const;
 
   ExecutionResult DoExecute(OptionalCommandControl, const Query& query) const;
 
+  void DoExecuteStreaming(OptionalCommandControl, const Query& query,
+                          impl::BlockHandler handler) const;
+
   const impl::Pool& GetPool() const;
 
   std::vector<impl::Pool> pools_;
@@ -189,6 +218,25 @@ ExecutionResult Cluster::Execute(OptionalCommandControl optional_cc,
   return DoExecute(optional_cc, formatted_query);
 }
 
+template <typename BlockHandler, typename... Args>
+void Cluster::ExecuteStreaming(const Query& query, BlockHandler&& handler,
+                               const Args&... args) const {
+  ExecuteStreaming(OptionalCommandControl{}, query,
+                   std::forward<BlockHandler>(handler), args...);
+}
+
+template <typename BlockHandler, typename... Args>
+void Cluster::ExecuteStreaming(OptionalCommandControl optional_cc,
+                               const Query& query, BlockHandler&& handler,
+                               const Args&... args) const {
+  const auto formatted_query = query.WithArgs(args...);
+  DoExecuteStreaming(optional_cc, formatted_query,
+                     [&handler](impl::BlockWrapper& block) {
+                       const BlockView view{block};
+                       handler(view);
+                     });
+}
+
 }  // namespace storages::clickhouse
 
 USERVER_NAMESPACE_END
@@ -2,6 +2,8 @@
 
 #include <memory>
 
+#include <userver/utils/function_ref.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::clickhouse::impl {
@@ -13,6 +15,9 @@ struct BlockWrapperDeleter final {
 
 using BlockWrapperPtr = std::unique_ptr<BlockWrapper, BlockWrapperDeleter>;
 
+using BlockHandler =
+    USERVER_NAMESPACE::utils::function_ref<void(BlockWrapper&)>;
+
 }  // namespace storages::clickhouse::impl
 
 USERVER_NAMESPACE_END
@@ -40,6 +40,11 @@ class InsertionRequest final {
 
   const impl::BlockWrapper& GetBlock() const;
 
+  size_t GetRowsCount() const;
+
+  /// Appends the rows of a request to the same table and columns
+  void Append(const InsertionRequest& other);
+
  private:
   template <typename MappedType>
   class ColumnsMapper final {
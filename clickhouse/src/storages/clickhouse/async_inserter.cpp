@@ -0,0 +1,224 @@
+#include <userver/storages/clickhouse/async_inserter.hpp>
+
+#include <exception>
+#include <mutex>
+#include <utility>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+#include <storages/clickhouse/stats/pool_statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+class AsyncInserter::Impl final {
+ public:
+  Impl(ClusterPtr cluster, AsyncInserterSettings&& settings);
+  ~Impl();
+
+  const std::string& GetTableName() const { return settings_.table_name; }
+  const std::vector<std::string_view>& GetColumnNames() const {
+    return column_names_;
+  }
+
+  void Append(impl::InsertionRequest&& request, std::size_t bytes);
+
+  void Flush();
+
+  void WriteStatistics(
+      USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
+
+ private:
+  void FlushLoop();
+
+  // returns false if cancelled before the rows are inserted or dropped
+  bool InsertWithRetries(const impl::InsertionRequest& request,
+                         std::size_t bytes);
+
+  const ClusterPtr cluster_;
+  const AsyncInserterSettings settings_;
+  const std::vector<std::string_view> column_names_;
+
+  engine::Mutex buffer_mutex_;
+  std::optional<impl::InsertionRequest> buffer_;
+  std::size_t buffered_rows_{0};
+  std::size_t buffered_bytes_{0};
+
+  // keeps the order of the flushes
+  engine::Mutex flush_mutex_;
+  engine::SingleConsumerEvent flush_requested_;
+
+  stats::AsyncInserterStatistics stats_;
+
+  engine::TaskWithResult<void> flush_task_;
+};
+
+AsyncInserter::Impl::Impl(ClusterPtr cluster, AsyncInserterSettings&& settings)
+    : cluster_{std::move(cluster)},
+      settings_{std::move(settings)},
+      column_names_{settings_.column_names.begin(),
+                    settings_.column_names.end()} {
+  UINVARIANT(cluster_, "Cluster must not be null");
+  UINVARIANT(settings_.max_rows > 0, "max_rows must be positive");
+
+  flush_task_ = USERVER_NAMESPACE::utils::CriticalAsync(
+      "clickhouse_async_inserter", [this] { FlushLoop(); });
+}
+
+AsyncInserter::Impl::~Impl() {
+  flush_task_.SyncCancel();
+  Flush();
+}
+
+void AsyncInserter::Impl::Append(impl::InsertionRequest&& request,
+                                 std::size_t bytes) {
+  const auto rows = request.GetRowsCount();
+
+  std::lock_guard lock{buffer_mutex_};
+  if (buffered_rows_ + rows > settings_.max_buffered_rows) {
+    stats_.dropped_rows += rows;
+    LOG_LIMITED_WARNING() << "Dropping " << rows << " rows for '"
+                          << settings_.table_name
+                          << "': the insertion buffer is full";
+    return;
+  }
+
+  if (buffer_) {
+    buffer_->Append(request);
+  } else {
+    buffer_.emplace(std::move(request));
+  }
+  buffered_rows_ += rows;
+  buffered_bytes_ += bytes;
+
+  if (buffered_rows_ >= settings_.max_rows ||
+      buffered_bytes_ >= settings_.max_bytes) {
+    flush_requested_.Send();
+  }
+}
+
+void AsyncInserter::Impl::Flush() {
+  std::lock_guard flush_lock{flush_mutex_};
+
+  std::optional<impl::InsertionRequest> request;
+  std::size_t bytes = 0;
+  {
+    std::lock_guard lock{buffer_mutex_};
+    if (!buffer_) return;
+    request.emplace(std::move(*buffer_));
+    buffer_.reset();
+    // the rows are counted as buffered until they are inserted, so that
+    // the buffer does not grow while ClickHouse is unavailable
+    bytes = std::exchange(buffered_bytes_, 0);
+  }
+
+  const bool done = InsertWithRetries(*request, bytes);
+
+  std::lock_guard lock{buffer_mutex_};
+  if (done) {
+    buffered_rows_ -= request->GetRowsCount();
+    return;
+  }
+
+  // put the rows back in front of the ones buffered meanwhile
+  if (buffer_) {
+    request->Append(*buffer_);
+    buffer_.reset();
+  }
+  buffer_.emplace(std::move(*request));
+  buffered_bytes_ += bytes;
+}
+
+void AsyncInserter::Impl::WriteStatistics(
+    USERVER_NAMESPACE::utils::statistics::Writer& writer) const {
+  writer.ValueWithLabels(stats_, {{"clickhouse_table", settings_.table_name}});
+}
+
+void AsyncInserter::Impl::FlushLoop() {
+  while (!engine::current_task::ShouldCancel()) {
+    [[maybe_unused]] const bool is_full =
+        flush_requested_.WaitForEventFor(settings_.flush_interval);
+    if (engine::current_task::ShouldCancel()) break;
+
+    Flush();
+  }
+}
+
+bool AsyncInserter::Impl::InsertWithRetries(
+    const impl::InsertionRequest& request, std::size_t bytes) {
+  const auto rows = request.GetRowsCount();
+
+  for (std::size_t attempt = 0;; ++attempt) {
+    const auto start = std::chrono::steady_clock::now();
+    try {
+      InsertBlock(*cluster_, settings_.command_control, request);
+    } catch (const std::exception& ex) {
+      ++stats_.flush_errors;
+      if (engine::current_task::ShouldCancel()) return false;
+      if (attempt >= settings_.max_retries) {
+        stats_.dropped_rows += rows;
+        LOG_ERROR() << "Dropping " << rows << " rows for '"
+                    << settings_.table_name << "' after " << attempt + 1
+                    << " failed inserts: " << ex;
+        return true;
+      }
+      LOG_WARNING() << "Failed to insert " << rows << " rows for '"
+                    << settings_.table_name << "', retrying: " << ex;
+      engine::InterruptibleSleepFor(settings_.retry_delay);
+      continue;
+    }
+
+    stats_.flush_timings.GetCurrentCounter().Account(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    ++stats_.blocks;
+    stats_.inserted_rows += rows;
+    stats_.inserted_bytes += bytes;
+    return true;
+  }
+}
+
+AsyncInserter::AsyncInserter(ClusterPtr cluster, AsyncInserterSettings settings)
+    : impl_{std::make_unique<Impl>(std::move(cluster), std::move(settings))} {}
+
+AsyncInserter::~AsyncInserter() = default;
+
+void AsyncInserter::Flush() { impl_->Flush(); }
+
+void AsyncInserter::WriteStatistics(
+    USERVER_NAMESPACE::utils::statistics::Writer& writer) const {
+  impl_->WriteStatistics(writer);
+}
+
+const std::string& AsyncInserter::GetTableName() const {
+  return impl_->GetTableName();
+}
+
+const std::vector<std::string_view>& AsyncInserter::GetColumnNames() const {
+  return impl_->GetColumnNames();
+}
+
+void AsyncInserter::DoInsert(impl::InsertionRequest&& request,
+                             std::size_t bytes) {
+  impl_->Append(std::move(request), bytes);
+}
+
+void AsyncInserter::InsertBlock(const Cluster& cluster,
+                                OptionalCommandControl optional_cc,
+                                const impl::InsertionRequest& request) {
+  cluster.DoInsert(optional_cc, request);
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
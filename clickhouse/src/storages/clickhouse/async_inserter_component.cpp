@@ -0,0 +1,112 @@
+#include <userver/storages/clickhouse/async_inserter_component.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <userver/storages/clickhouse/async_inserter.hpp>
+#include <userver/storages/clickhouse/component.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+namespace {
+
+storages::clickhouse::AsyncInserterSettings ParseSettings(
+    const ComponentConfig& config) {
+  storages::clickhouse::AsyncInserterSettings settings;
+  settings.table_name = config["table"].As<std::string>();
+  settings.column_names = config["columns"].As<std::vector<std::string>>();
+  settings.max_rows = config["max_rows"].As<std::size_t>(settings.max_rows);
+  settings.max_bytes = config["max_bytes"].As<std::size_t>(settings.max_bytes);
+  settings.flush_interval =
+      config["flush_interval"].As<std::chrono::milliseconds>(
+          settings.flush_interval);
+  settings.max_buffered_rows =
+      config["max_buffered_rows"].As<std::size_t>(settings.max_buffered_rows);
+  settings.max_retries =
+      config["max_retries"].As<std::size_t>(settings.max_retries);
+  settings.retry_delay = config["retry_delay"].As<std::chrono::milliseconds>(
+      settings.retry_delay);
+  return settings;
+}
+
+}  // namespace
+
+ClickHouseAsyncInserter::ClickHouseAsyncInserter(
+    const ComponentConfig& config, const ComponentContext& context)
+    : LoggableComponentBase{config, context},
+      inserter_{std::make_unique<storages::clickhouse::AsyncInserter>(
+          context
+              .FindComponent<ClickHouse>(config["clickhouse"].As<std::string>())
+              .GetCluster(),
+          ParseSettings(config))} {
+  auto& statistics_storage =
+      context.FindComponent<components::StatisticsStorage>();
+  statistics_holder_ = statistics_storage.GetStorage().RegisterWriter(
+      "clickhouse.async_inserter", [this](utils::statistics::Writer& writer) {
+        inserter_->WriteStatistics(writer);
+      });
+}
+
+ClickHouseAsyncInserter::~ClickHouseAsyncInserter() {
+  statistics_holder_.Unregister();
+}
+
+storages::clickhouse::AsyncInserter& ClickHouseAsyncInserter::GetInserter()
+    const {
+  return *inserter_;
+}
+
+yaml_config::Schema ClickHouseAsyncInserter::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<LoggableComponentBase>(R"(
+type: object
+description: Buffered asynchronous inserter into a single ClickHouse table
+additionalProperties: false
+properties:
+    clickhouse:
+        type: string
+        description: name of the components::ClickHouse component to use
+    table:
+        type: string
+        description: name of the table to insert into
+    columns:
+        type: array
+        description: names of the columns, in the order of the row fields
+        items:
+            type: string
+            description: column name
+    max_rows:
+        type: integer
+        description: flush once the buffer has this many rows
+        defaultDescription: 100000
+    max_bytes:
+        type: integer
+        description: flush once the buffer has this many bytes (estimated)
+        defaultDescription: 16777216
+    flush_interval:
+        type: string
+        description: flush at least this often
+        defaultDescription: 1s
+    max_buffered_rows:
+        type: integer
+        description: rows that do not fit into the buffer are dropped
+        defaultDescription: 1000000
+    max_retries:
+        type: integer
+        description: retries of a failed insert before dropping its rows
+        defaultDescription: 3
+    retry_delay:
+        type: string
+        description: delay between the retries of a failed insert
+        defaultDescription: 100ms
+)");
+}
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
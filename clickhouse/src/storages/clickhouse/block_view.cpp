@@ -0,0 +1,17 @@
+#include <userver/storages/clickhouse/block_view.hpp>
+
+#include <storages/clickhouse/impl/block_wrapper.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+BlockView::BlockView(impl::BlockWrapper& block) : block_{block} {}
+
+size_t BlockView::GetColumnsCount() const { return block_.GetColumnsCount(); }
+
+size_t BlockView::GetRowsCount() const { return block_.GetRowsCount(); }
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
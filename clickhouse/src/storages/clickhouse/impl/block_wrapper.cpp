@@ -1,5 +1,7 @@
 #include "block_wrapper.hpp"
 
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::clickhouse::impl {
@@ -21,6 +23,22 @@ void BlockWrapper::AppendColumn(std::string_view name,
   native_.AppendColumn(std::string{name}, column);
 }
 
+void BlockWrapper::Append(const BlockWrapper& other) {
+  const auto& other_native = other.native_;
+  UINVARIANT(native_.GetColumnCount() == other_native.GetColumnCount(),
+             "Columns count mismatch");
+
+  for (size_t ind = 0; ind < native_.GetColumnCount(); ++ind) {
+    const auto& column = native_[ind];
+    const auto& other_column = other_native[ind];
+    UINVARIANT(column->Type()->IsEqual(other_column->Type()),
+               "Column types mismatch");
+    column->Append(other_column);
+  }
+
+  native_.RefreshRowCount();
+}
+
 const clickhouse_cpp::Block& BlockWrapper::GetNative() const { return native_; }
 
 void BlockWrapperDeleter::operator()(BlockWrapper* ptr) const noexcept {
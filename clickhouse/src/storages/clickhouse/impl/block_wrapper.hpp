@@ -23,6 +23,9 @@ class BlockWrapper final {
   void AppendColumn(std::string_view name,
                     const clickhouse_cpp::ColumnRef& column);
 
+  /// Appends the rows of a block with the same structure
+  void Append(const BlockWrapper& other);
+
   const clickhouse_cpp::Block& GetNative() const;
 
  private:
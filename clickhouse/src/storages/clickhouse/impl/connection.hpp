@@ -28,6 +28,8 @@ class Connection final {
 
   ExecutionResult Execute(OptionalCommandControl, const Query&);
 
+  void ExecuteStreaming(OptionalCommandControl, const Query&, BlockHandler);
+
   void Insert(OptionalCommandControl, const InsertionRequest&);
 
   void Ping();
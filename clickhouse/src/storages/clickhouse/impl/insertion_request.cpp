@@ -26,6 +26,13 @@ const std::string& InsertionRequest::GetTableName() const {
 
 const impl::BlockWrapper& InsertionRequest::GetBlock() const { return *block_; }
 
+size_t InsertionRequest::GetRowsCount() const { return block_->GetRowsCount(); }
+
+void InsertionRequest::Append(const InsertionRequest& other) {
+  UASSERT(table_name_ == other.table_name_);
+  block_->Append(*other.block_);
+}
+
 }  // namespace storages::clickhouse::impl
 
 USERVER_NAMESPACE_END
@@ -31,6 +31,16 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
   writer["busy"] = stats.busy;
 }
 
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const AsyncInserterStatistics& stats) {
+  writer["blocks"] = stats.blocks;
+  writer["inserted_rows"] = stats.inserted_rows;
+  writer["inserted_bytes"] = stats.inserted_bytes;
+  writer["dropped_rows"] = stats.dropped_rows;
+  writer["flush_errors"] = stats.flush_errors;
+  writer["flush_timings"] = stats.flush_timings;
+}
+
 }  // namespace storages::clickhouse::stats
 
 USERVER_NAMESPACE_END
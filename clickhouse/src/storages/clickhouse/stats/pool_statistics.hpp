@@ -36,6 +36,15 @@ struct PoolStatistics final {
   PoolQueryStatistics inserts{};
 };
 
+struct AsyncInserterStatistics final {
+  Counter blocks{};
+  Counter inserted_rows{};
+  Counter inserted_bytes{};
+  Counter dropped_rows{};
+  Counter flush_errors{};
+  RecentPeriod flush_timings{};
+};
+
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
                 const PoolStatistics& stats);
 
@@ -45,6 +54,9 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
                 const PoolConnectionStatistics& stats);
 
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const AsyncInserterStatistics& stats);
+
 }  // namespace storages::clickhouse::stats
 
 USERVER_NAMESPACE_END
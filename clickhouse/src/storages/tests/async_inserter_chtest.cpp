@@ -0,0 +1,133 @@
+#include <userver/utest/utest.hpp>
+
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/storages/clickhouse/async_inserter.hpp>
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/execution_result.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Row final {
+  uint64_t id;
+  std::string value;
+};
+
+struct CountResult final {
+  std::vector<uint64_t> count;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Row> {
+  using mapped_type = std::tuple<columns::UInt64Column, columns::StringColumn>;
+};
+
+template <>
+struct CppToClickhouse<CountResult> {
+  using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+}  // namespace storages::clickhouse::io
+
+namespace {
+
+namespace clickhouse = storages::clickhouse;
+
+clickhouse::ClusterPtr MakeNonOwningPtr(ClusterWrapper& cluster) {
+  return clickhouse::ClusterPtr{clickhouse::ClusterPtr{}, &*cluster};
+}
+
+void RecreateTable(ClusterWrapper& cluster) {
+  cluster->Execute(
+      clickhouse::Query{"DROP TABLE IF EXISTS async_inserter_table"});
+  cluster->Execute(clickhouse::Query{
+      "CREATE TABLE async_inserter_table (id UInt64, value String) "
+      "ENGINE = Memory"});
+}
+
+uint64_t CountRows(ClusterWrapper& cluster) {
+  const auto result =
+      cluster
+          ->Execute(clickhouse::Query{
+              "SELECT toUInt64(count()) FROM async_inserter_table"})
+          .As<CountResult>();
+  return result.count.at(0);
+}
+
+clickhouse::AsyncInserterSettings MakeSettings() {
+  clickhouse::AsyncInserterSettings settings;
+  settings.table_name = "async_inserter_table";
+  settings.column_names = {"id", "value"};
+  return settings;
+}
+
+}  // namespace
+
+UTEST_MT(AsyncInserter, FlushesOnRowsCount, 4) {
+  ClusterWrapper cluster{};
+  RecreateTable(cluster);
+
+  auto settings = MakeSettings();
+  settings.max_rows = 100;
+  settings.flush_interval = std::chrono::hours{1};
+  clickhouse::AsyncInserter inserter{MakeNonOwningPtr(cluster), settings};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (uint64_t i = 0; i < 10; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&inserter, i] {
+      std::vector<Row> rows;
+      for (uint64_t j = 0; j < 10; ++j) rows.push_back({i * 10 + j, "value"});
+      inserter.InsertRows(rows);
+    }));
+  }
+  engine::WaitAllChecked(tasks);
+
+  for (int i = 0; i < 100 && CountRows(cluster) != 100; ++i) {
+    engine::SleepFor(std::chrono::milliseconds{50});
+  }
+  EXPECT_EQ(CountRows(cluster), 100);
+}
+
+UTEST(AsyncInserter, FlushesOnDestruction) {
+  ClusterWrapper cluster{};
+  RecreateTable(cluster);
+
+  auto settings = MakeSettings();
+  settings.flush_interval = std::chrono::hours{1};
+  {
+    clickhouse::AsyncInserter inserter{MakeNonOwningPtr(cluster), settings};
+    inserter.Insert(Row{1, "one"});
+    inserter.Insert(Row{2, "two"});
+    EXPECT_EQ(CountRows(cluster), 0);
+  }
+  EXPECT_EQ(CountRows(cluster), 2);
+}
+
+UTEST(AsyncInserter, DropsOverflowingRows) {
+  ClusterWrapper cluster{};
+  RecreateTable(cluster);
+
+  auto settings = MakeSettings();
+  settings.flush_interval = std::chrono::hours{1};
+  settings.max_buffered_rows = 2;
+  clickhouse::AsyncInserter inserter{MakeNonOwningPtr(cluster), settings};
+  inserter.InsertRows(std::vector<Row>{{1, "one"}, {2, "two"}, {3, "three"}});
+  inserter.Insert(Row{4, "four"});
+  inserter.Flush();
+
+  EXPECT_EQ(CountRows(cluster), 1);
+}
+
+USERVER_NAMESPACE_END
@@ -75,6 +75,54 @@ UTEST(Execute, MappingWorks) {
   EXPECT_EQ(sum, 10000 * (10000 - 1) / 2);
 }
 
+UTEST(Execute, StreamingWorks) {
+  ClusterWrapper cluster{};
+
+  const storages::clickhouse::Query q{
+      "SELECT c.number, randomString(10), c.number as t, NOW64(9) "
+      "FROM numbers(0, 200000) c"};
+
+  /// [Sample BlockView usage]
+  size_t blocks = 0;
+  size_t rows = 0;
+  uint64_t sum = 0;
+  cluster->ExecuteStreaming(
+      q, [&](const storages::clickhouse::BlockView& block) {
+        ++blocks;
+        rows += block.GetRowsCount();
+
+        const auto [numbers, strings, other_numbers, tps] =
+            block.GetColumns<Data>();
+        for (const auto number : numbers) sum += number;
+      });
+  /// [Sample BlockView usage]
+
+  EXPECT_GT(blocks, 1);
+  EXPECT_EQ(rows, 200000);
+  EXPECT_EQ(sum, uint64_t{200000} * (200000 - 1) / 2);
+
+  std::vector<uint64_t> first_block;
+  cluster->ExecuteStreaming(
+      common_query, [&](const storages::clickhouse::BlockView& block) {
+        if (first_block.empty()) first_block = block.As<Data>().numbers;
+      });
+  ASSERT_FALSE(first_block.empty());
+  EXPECT_EQ(first_block[0], 0);
+}
+
+UTEST(Execute, StreamingHandlerThrows) {
+  ClusterWrapper cluster{};
+
+  UEXPECT_THROW(cluster->ExecuteStreaming(
+                    common_query,
+                    [](const storages::clickhouse::BlockView&) {
+                      throw std::runtime_error{"handler failed"};
+                    }),
+                std::runtime_error);
+
+  EXPECT_EQ(cluster->Execute(common_query).GetRowsCount(), 10000);
+}
+
 namespace {
 namespace io = storages::clickhouse::io;
 
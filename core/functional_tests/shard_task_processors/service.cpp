@@ -0,0 +1,37 @@
+#include <userver/clients/dns/component.hpp>
+#include <userver/testsuite/testsuite_support.hpp>
+
+#include <userver/clients/http/component.hpp>
+#include <userver/components/minimal_server_component_list.hpp>
+#include <userver/components/single_threaded_task_processors.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/handlers/tests_control.hpp>
+#include <userver/utils/daemon_run.hpp>
+#include <userver/utils/thread_name.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+// Responds with the name of the thread that runs the request
+class ThreadNameHandler final : public server::handlers::HttpHandlerBase {
+ public:
+  using HttpHandlerBase::HttpHandlerBase;
+
+  std::string HandleRequestThrow(
+      const server::http::HttpRequest&,
+      server::request::RequestContext&) const override {
+    return utils::GetCurrentThreadName();
+  }
+};
+
+int main(int argc, char* argv[]) {
+  const auto component_list =
+      components::MinimalServerComponentList()
+          .Append<components::SingleThreadedTaskProcessors>()
+          .Append<ThreadNameHandler>("handler-thread-name")
+          .Append<ThreadNameHandler>("handler-thread-name-on-connection")
+          .Append<clients::dns::Component>()
+          .Append<components::HttpClient>()
+          .Append<components::TestsuiteSupport>()
+          .Append<server::handlers::TestsControl>();
+  return utils::DaemonMain(argc, argv, component_list);
+}
@@ -0,0 +1,11 @@
+async def test_handler_task_processor(service_client):
+    response = await service_client.get('/thread-name')
+    assert response.status == 200
+    assert response.text.startswith('main-worker')
+
+
+async def test_connection_task_processor(service_client):
+    for _ in range(10):
+        response = await service_client.get('/thread-name-on-connection')
+        assert response.status == 200
+        assert response.text.startswith('shard-'), response.text
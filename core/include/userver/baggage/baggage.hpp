@@ -4,6 +4,7 @@
 /// @brief @copybrief baggage::Baggage
 
 #include <algorithm>  // TODO: remove
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -20,6 +21,10 @@ namespace baggage {
 using BaggageProperties =
     std::vector<std::pair<std::string, std::optional<std::string>>>;
 
+/// Allowed keys shared between the baggages parsed with the same settings
+using SharedAllowedKeys =
+    std::shared_ptr<const std::unordered_set<std::string>>;
+
 class Baggage;
 class BaggageEntryProperty;
 
@@ -75,6 +80,12 @@ class BaggageEntry {
  private:
   /// @brief Add entry to the received header string
   void ConcatenateWith(std::string& header) const;
+
+  /// @brief Copy of the entry that points into `new_header`, which must be a
+  /// copy of `old_header` the entry was parsed from
+  BaggageEntry Rebased(std::string_view old_header,
+                       std::string_view new_header) const;
+
   const std::string_view key_;
   std::string_view value_;
   std::vector<BaggageEntryProperty> properties_;
@@ -89,6 +100,7 @@ class BaggageEntry {
 class Baggage {
  public:
   Baggage(std::string header, std::unordered_set<std::string> allowed_keys);
+  Baggage(std::string header, SharedAllowedKeys allowed_keys);
   Baggage(const Baggage&) noexcept;
   Baggage(Baggage&&) noexcept;
 
@@ -117,6 +129,9 @@ class Baggage {
   /// @brief get baggage allowed keys
   std::unordered_set<std::string> GetAllowedKeys() const;
 
+  /// @brief get baggage allowed keys without copying them
+  const SharedAllowedKeys& GetSharedAllowedKeys() const;
+
  protected:
   /// @brief parsers
   /// @returns std::nullopt If key, value or properties
@@ -133,8 +148,13 @@ class Baggage {
   /// @brief Create result_header
   void CreateResultHeader();
 
+  /// @brief Fill entries_ with copies of `entries` without parsing,
+  /// header_value_ must be equal to `old_header` they were parsed from
+  void RebaseEntries(const std::vector<BaggageEntry>& entries,
+                     std::string_view old_header);
+
   std::string header_value_;
-  std::unordered_set<std::string> allowed_keys_;
+  SharedAllowedKeys allowed_keys_;
   std::vector<BaggageEntry> entries_;
 
   // result header after parsing entities.
@@ -149,6 +169,10 @@ class Baggage {
 std::optional<Baggage> TryMakeBaggage(
     std::string header, std::unordered_set<std::string> allowed_keys);
 
+/// @overload
+std::optional<Baggage> TryMakeBaggage(std::string header,
+                                      SharedAllowedKeys allowed_keys);
+
 template <typename T>
 bool HasInvalidSymbols(const T& obj) {
   return std::find_if(obj.begin(), obj.end(), [](unsigned char x) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_set>
 
@@ -12,6 +13,15 @@ namespace baggage {
 
 struct BaggageSettings final {
   std::unordered_set<std::string> allowed_keys;
+
+  /// Same keys as `allowed_keys`, filled by Parse(). Shared with the parsed
+  /// baggages so that the set is not copied on each request.
+  std::shared_ptr<const std::unordered_set<std::string>> shared_allowed_keys{};
+
+  /// @returns `shared_allowed_keys`, or a shared copy of `allowed_keys` if the
+  /// settings were not parsed
+  std::shared_ptr<const std::unordered_set<std::string>> GetSharedAllowedKeys()
+      const;
 };
 
 BaggageSettings Parse(const formats::json::Value& value,
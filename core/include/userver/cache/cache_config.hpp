@@ -8,6 +8,7 @@
 
 #include <userver/cache/update_type.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
+#include <userver/engine/task/priority.hpp>
 #include <userver/formats/json_fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
@@ -73,6 +74,8 @@ struct Config final {
   std::chrono::milliseconds cleanup_interval;
   bool is_strong_period;
   std::optional<std::uint64_t> failed_updates_before_expiration;
+  engine::TaskPriority update_priority;
+  double update_cpu_share;
 
   FirstUpdateMode first_update_mode;
   FirstUpdateType first_update_type;
@@ -88,6 +91,9 @@ struct Config final {
 extern const dynamic_config::Key<std::unordered_map<std::string, ConfigPatch>>
     kCacheConfigSet;
 
+/// The process-wide limit of concurrent periodic cache updates, 0 - no limit
+extern const dynamic_config::Key<std::size_t> kCacheUpdateConcurrency;
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
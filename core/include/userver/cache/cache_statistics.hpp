@@ -59,6 +59,10 @@ class UpdateStatisticsScope final {
   ~UpdateStatisticsScope();
 
   impl::UpdateState GetState(utils::InternalTag) const;
+
+  // Makes IncreaseDocumentsReadCount sleep to keep the share of the wall time
+  // used by the update
+  void SetCpuShare(double cpu_share, utils::InternalTag);
   /// @endcond
 
   /// @brief Mark that the `Update` has finished with changes
@@ -74,6 +78,8 @@ class UpdateStatisticsScope final {
   /// @brief Each item received from the data source should be accounted with
   /// this function
   /// @note This method can be called multiple times per `Update`
+  /// @note With `update-cpu-share` set the method may sleep, do not call it
+  /// under a non-engine mutex
   /// @param add the number of items (both valid and non-valid) newly received
   void IncreaseDocumentsReadCount(std::size_t add);
 
@@ -86,10 +92,14 @@ class UpdateStatisticsScope final {
  private:
   void DoFinish(impl::UpdateState new_state);
 
+  void Throttle();
+
   impl::Statistics& stats_;
   impl::UpdateStatistics& update_stats_;
   impl::UpdateState state_{impl::UpdateState::kNotFinished};
   const std::chrono::steady_clock::time_point update_start_time_;
+  double cpu_share_{1.0};
+  std::chrono::steady_clock::time_point busy_since_;
 };
 
 }  // namespace cache
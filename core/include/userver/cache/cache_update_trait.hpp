@@ -84,6 +84,9 @@ class CacheUpdateTrait {
   /// Checks for the presence of the flag for pre-assign check
   bool HasPreAssignCheck() const;
 
+  /// Whether `dump.differential` is enabled for the cache
+  bool HasDifferentialDumps() const;
+
   // For internal use only
   // TODO remove after TAXICOMMON-3959
   engine::TaskProcessor& GetCacheTaskProcessor() const;
@@ -131,6 +134,10 @@ class CacheUpdateTrait {
 
   virtual void ReadAndSet(dump::Reader& reader);
 
+  virtual void GetAndWriteDelta(dump::Writer& writer) const;
+
+  virtual void ReadAndApplyDelta(dump::Reader& reader);
+
   class Impl;
   std::unique_ptr<Impl> impl_;
 };
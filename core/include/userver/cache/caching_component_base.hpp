@@ -48,6 +48,10 @@ namespace components {
 ///
 /// @ref scripts/docs/en/userver/caches.md provide a more detailed introduction.
 ///
+/// For incremental updates of huge caches consider cache::PersistentMap as T:
+/// copying it is O(1) and the new snapshot shares most of its nodes with the
+/// previous one.
+///
 /// ## Dynamic config
 /// * @ref USERVER_CACHES
 /// * @ref USERVER_DUMPS
@@ -66,6 +70,8 @@ namespace components {
 /// exception-interval | Used instead of `update-interval` in case of exception | update_interval
 /// additional-cleanup-interval | how often to run background RCU garbage collector | 10 seconds
 /// is-strong-period | whether to include Update execution time in update-interval | false
+/// update-priority | engine::TaskPriority (`low`, `normal` or `high`) of the updates after the first one, see @ref cache_update_pacing | low
+/// update-cpu-share | share of the wall time in (0, 1] that the updates after the first one may use, see @ref cache_update_pacing | 1
 /// testsuite-force-periodic-update | override testsuite-periodic-update-enabled in TestsuiteSupport component config | --
 /// failed-updates-before-expiration | the number of consecutive failed updates for data expiration | --
 /// has-pre-assign-check | enables the check before changing the value in the cache, by default it is the check that the new value is not empty | false
@@ -103,6 +109,19 @@ namespace components {
 /// `required`    | make a synchronous update of type `first-update-type`, stop the service on failure
 /// `best-effort` | make a synchronous update of type `first-update-type`, keep working and use data from dump on failure
 ///
+/// @anchor cache_update_pacing
+/// ### Update pacing
+/// The updates after the first one are background work:
+///  * they run with `update-priority`, which takes effect only if the
+///    `task-processor` has `task-processor-queue: priority-task-queue`;
+///  * with `update-cpu-share` below 1 the update sleeps in
+///    cache::UpdateStatisticsScope::IncreaseDocumentsReadCount, so that the
+///    update takes at most that share of the time it runs;
+///  * the `USERVER_CACHE_UPDATE_CONCURRENCY` dynamic config limits the number
+///    of caches that update at the same time in the process.
+///
+/// The first update is not paced, it blocks the service start.
+///
 /// ### testsuite-force-periodic-update
 ///  use it to enable periodic cache update for a component in testsuite environment
 ///  where testsuite-periodic-update-enabled from TestsuiteSupport config is false
@@ -171,6 +190,19 @@ class CachingComponentBase : public LoggableComponentBase,
   virtual std::unique_ptr<const T> ReadContents(dump::Reader& reader) const;
   /// @}
 
+  /// @{
+  /// Override to support `dump.differential`: write the changes from
+  /// `previous`, the contents of the previous dump, to `contents`, and return
+  /// `contents` with the written changes applied. If `T` is cheap to copy,
+  /// e.g. cache::PersistentMap, the previous contents do not take extra memory.
+  /// By default the whole `contents` are written with `WriteContents`.
+  virtual void WriteContentsDelta(dump::Writer& writer, const T& previous,
+                                  const T& contents) const;
+
+  virtual std::unique_ptr<const T> ReadContentsDelta(dump::Reader& reader,
+                                                     const T& contents) const;
+  /// @}
+
  private:
   void OnAllComponentsLoaded() final;
 
@@ -180,6 +212,8 @@ class CachingComponentBase : public LoggableComponentBase,
 
   void GetAndWrite(dump::Writer& writer) const final;
   void ReadAndSet(dump::Reader& reader) final;
+  void GetAndWriteDelta(dump::Writer& writer) const final;
+  void ReadAndApplyDelta(dump::Reader& reader) final;
 
   /// @brief If the option has-pre-assign-check is set true in static config,
   /// this function is called before assigning the new value to the cache
@@ -188,6 +222,9 @@ class CachingComponentBase : public LoggableComponentBase,
                               const T* new_value_ptr) const;
 
   rcu::Variable<std::shared_ptr<const T>> cache_;
+  // The contents of the previous dump, for differential dumps. Only accessed
+  // by the dumper, that never calls the dump methods in parallel.
+  mutable std::shared_ptr<const T> dumped_contents_;
   concurrent::AsyncEventChannel<const std::shared_ptr<const T>&> event_channel_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 };
@@ -209,6 +246,7 @@ template <typename T>
 CachingComponentBase<T>::~CachingComponentBase() {
   // Avoid a deadlock in WaitForAllTokens
   cache_.Assign(nullptr);
+  dumped_contents_.reset();
   // We must wait for destruction of all instances of T to finish, otherwise
   // it's UB if T's destructor accesses dependent components
   wait_token_storage_.WaitForAllTokens();
@@ -297,14 +335,37 @@ bool CachingComponentBase<T>::MayReturnNull() const {
 
 template <typename T>
 void CachingComponentBase<T>::GetAndWrite(dump::Writer& writer) const {
-  const auto contents = GetUnsafe();
+  auto contents = cache_.ReadCopy();
   if (!contents) throw cache::EmptyCacheError(Name());
   WriteContents(writer, *contents);
+  if (HasDifferentialDumps()) {
+    dumped_contents_ = std::move(contents);
+  }
 }
 
 template <typename T>
 void CachingComponentBase<T>::ReadAndSet(dump::Reader& reader) {
   Set(ReadContents(reader));
+  if (HasDifferentialDumps()) {
+    dumped_contents_ = cache_.ReadCopy();
+  }
+}
+
+template <typename T>
+void CachingComponentBase<T>::GetAndWriteDelta(dump::Writer& writer) const {
+  auto contents = cache_.ReadCopy();
+  if (!contents) throw cache::EmptyCacheError(Name());
+  UINVARIANT(dumped_contents_, "A delta is requested before a full dump");
+  WriteContentsDelta(writer, *dumped_contents_, *contents);
+  dumped_contents_ = std::move(contents);
+}
+
+template <typename T>
+void CachingComponentBase<T>::ReadAndApplyDelta(dump::Reader& reader) {
+  const auto contents = cache_.ReadCopy();
+  if (!contents) throw cache::EmptyCacheError(Name());
+  Set(ReadContentsDelta(reader, *contents));
+  dumped_contents_ = cache_.ReadCopy();
 }
 
 template <typename T>
@@ -328,6 +389,19 @@ std::unique_ptr<const T> CachingComponentBase<T>::ReadContents(
   }
 }
 
+template <typename T>
+void CachingComponentBase<T>::WriteContentsDelta(dump::Writer& writer,
+                                                 const T& /*previous*/,
+                                                 const T& contents) const {
+  WriteContents(writer, contents);
+}
+
+template <typename T>
+std::unique_ptr<const T> CachingComponentBase<T>::ReadContentsDelta(
+    dump::Reader& reader, const T& /*contents*/) const {
+  return ReadContents(reader);
+}
+
 template <typename T>
 void CachingComponentBase<T>::OnAllComponentsLoaded() {
   AssertPeriodicUpdateStarted();
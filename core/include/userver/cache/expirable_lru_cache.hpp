@@ -5,16 +5,28 @@
 
 #include <atomic>
 #include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
+#include <utility>
 
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_cache_statistics.hpp>
 #include <userver/cache/nway_lru_cache.hpp>
-#include <userver/concurrent/mutex_set.hpp>
 #include <userver/dump/common.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/datetime.hpp>
+#include <userver/utils/fixed_array.hpp>
 #include <userver/utils/impl/cached_time.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
 
@@ -47,6 +59,113 @@ impl::ExpirableValue<Value> Read(dump::Reader& reader,
       reader.Read<std::chrono::system_clock::time_point>() - now + steady_now};
 }
 
+/// The result of an update that other coroutines wait for
+template <typename Value>
+class InFlightUpdate final {
+ public:
+  /// @returns the value of the update, std::nullopt on timeout, on
+  /// cancellation of the caller or if the updater was cancelled
+  /// @throws the exception of the update function
+  std::optional<Value> WaitUntil(engine::Deadline deadline) {
+    std::unique_lock lock(mutex_);
+    if (!cv_.WaitUntil(lock, deadline, [this] { return is_finished_; })) {
+      return std::nullopt;
+    }
+    if (exception_) std::rethrow_exception(exception_);
+    return value_;
+  }
+
+  void SetValue(const Value& value) {
+    const std::lock_guard lock(mutex_);
+    value_.emplace(value);
+    is_finished_ = true;
+    cv_.NotifyAll();
+  }
+
+  void SetException(std::exception_ptr exception) {
+    const std::lock_guard lock(mutex_);
+    exception_ = std::move(exception);
+    is_finished_ = true;
+    cv_.NotifyAll();
+  }
+
+  // The waiters call the update function on their own
+  void Abandon() {
+    const std::lock_guard lock(mutex_);
+    is_finished_ = true;
+    cv_.NotifyAll();
+  }
+
+ private:
+  engine::Mutex mutex_;
+  engine::ConditionVariable cv_;
+  bool is_finished_{false};
+  std::optional<Value> value_;
+  std::exception_ptr exception_;
+};
+
+/// Single-flight registry: at most one update per key is in flight, the
+/// concurrent misses of the key wait for its result
+template <typename Key, typename Value, typename Hash, typename Equal>
+class InFlightUpdates final {
+ public:
+  using UpdatePtr = std::shared_ptr<InFlightUpdate<Value>>;
+
+  InFlightUpdates(std::size_t shards, const Hash& hash, const Equal& equal)
+      : hash_(hash), shards_(shards, hash, equal) {}
+
+  /// @returns the update of the key and true if the caller has started it
+  /// and must finish it
+  std::pair<UpdatePtr, bool> Join(const Key& key) {
+    auto& shard = GetShard(key);
+    const std::lock_guard lock(shard.mutex);
+    auto& update = shard.updates[key];
+    if (update) return {update, false};
+    update = std::make_shared<InFlightUpdate<Value>>();
+    return {update, true};
+  }
+
+  /// @returns nullptr if an update of the key is in flight already
+  UpdatePtr TryStart(const Key& key) {
+    auto& shard = GetShard(key);
+    const std::lock_guard lock(shard.mutex);
+    auto [it, inserted] = shard.updates.try_emplace(key);
+    if (!inserted) return nullptr;
+    it->second = std::make_shared<InFlightUpdate<Value>>();
+    return it->second;
+  }
+
+  void Finish(const Key& key, const UpdatePtr& update) {
+    auto& shard = GetShard(key);
+    const std::lock_guard lock(shard.mutex);
+    const auto it = shard.updates.find(key);
+    if (it != shard.updates.end() && it->second == update) {
+      shard.updates.erase(it);
+    }
+  }
+
+ private:
+  struct Shard final {
+    Shard(const Hash& hash, const Equal& equal) : updates(0, hash, equal) {}
+
+    engine::Mutex mutex;
+    std::unordered_map<Key, UpdatePtr, Hash, Equal> updates;
+  };
+
+  Shard& GetShard(const Key& key) {
+    return shards_[hash_(key) % shards_.size()];
+  }
+
+  const Hash hash_;
+  utils::FixedArray<Shard> shards_;
+};
+
+template <typename Key, typename Value>
+struct NegativeLookupFilter final {
+  std::function<bool(const Key&)> may_contain;
+  Value absent_value;
+};
+
 }  // namespace impl
 
 /// @ingroup userver_containers
@@ -69,7 +188,8 @@ class ExpirableLruCache final {
   };
 
   ExpirableLruCache(size_t ways, size_t way_size, const Hash& hash = Hash(),
-                    const Equal& equal = Equal());
+                    const Equal& equal = Equal(),
+                    CachePolicy policy = CachePolicy::kLru);
 
   ~ExpirableLruCache();
 
@@ -86,10 +206,51 @@ class ExpirableLruCache final {
    */
   void SetBackgroundUpdate(BackgroundUpdateMode background_update);
 
+  /**
+   * Sets how long the concurrent misses of a key wait for the update that is
+   * already in flight before calling "update_func" on their own, 0 waits
+   * without a limit.
+   */
+  void SetCoalescedWaitTimeout(std::chrono::milliseconds timeout);
+
+  /**
+   * Enables the accounting of the memory used by the values, "weigher"
+   * returns the approximate size of a key and its value in bytes, e.g. with
+   * cache::ApproximateSizeOf. See cache::NWayLRU::SetWeigher.
+   *
+   * Not thread-safe, call it before the cache is used.
+   */
+  void SetWeigher(std::function<std::size_t(const Key&, const Value&)> weigher);
+
+  /// Limits the total memory of the values, 0 disables the limit. Requires
+  /// SetWeigher().
+  void SetMaxBytes(std::size_t max_bytes);
+
+  /**
+   * Sets the filter of the keys that are known to be absent from the source
+   * of "update_func", e.g. a utils::BlockedBloomFilter of all the existing
+   * keys. On a miss Get() returns "absent_value" without calling
+   * "update_func" if "may_contain" returns false for the key. The result is
+   * not stored in the cache.
+   *
+   * Thread-safe, the owner is expected to set a rebuilt filter on each full
+   * update of the source of the keys.
+   */
+  void SetNegativeLookupFilter(std::function<bool(const Key&)> may_contain,
+                               Value absent_value);
+
+  /// Disables the filter set by SetNegativeLookupFilter()
+  void ResetNegativeLookupFilter();
+
   /**
    * @returns GetOptional("key", update_func) if it is not std::nullopt.
    * Otherwise the result of update_func(key) is returned, and additionally
    * stored in cache if "read_mode" is kUseCache.
+   *
+   * Concurrent misses of the same key are coalesced: only one of them calls
+   * "update_func", the rest wait for its value (or exception) for up to the
+   * coalesced wait timeout. Background updates are coalesced with the misses
+   * in the same way.
    */
   Value Get(const Key& key, const UpdateValueFunc& update_func,
             ReadMode read_mode = ReadMode::kUseCache);
@@ -131,6 +292,10 @@ class ExpirableLruCache final {
 
   size_t GetSizeApproximate() const;
 
+  /// Memory used by the values according to the weigher, std::nullopt
+  /// without SetWeigher()
+  std::optional<std::size_t> GetBytesApproximate() const;
+
   /// Clear cache
   void Invalidate();
 
@@ -155,21 +320,35 @@ class ExpirableLruCache final {
   bool ShouldUpdate(std::chrono::steady_clock::time_point update_time,
                     std::chrono::steady_clock::time_point now) const;
 
+  using UpdatePtr =
+      typename impl::InFlightUpdates<Key, Value, Hash, Equal>::UpdatePtr;
+
+  // Calls "update_func" on behalf of all the waiters of the "update"
+  Value RunUpdate(const Key& key, const UpdateValueFunc& update_func,
+                  const UpdatePtr& update, ReadMode read_mode,
+                  std::chrono::steady_clock::time_point now);
+
   cache::NWayLRU<Key, impl::ExpirableValue<Value>, Hash, Equal> lru_;
   std::atomic<std::chrono::milliseconds> max_lifetime_{
       std::chrono::milliseconds(0)};
   std::atomic<BackgroundUpdateMode> background_update_mode_{
       BackgroundUpdateMode::kDisabled};
+  std::atomic<std::chrono::milliseconds> coalesced_wait_timeout_{
+      std::chrono::milliseconds(0)};
+  bool has_weigher_{false};
+  rcu::Variable<std::optional<impl::NegativeLookupFilter<Key, Value>>>
+      negative_lookup_filter_;
   impl::ExpirableLruCacheStatistics stats_;
-  concurrent::MutexSet<Key, Hash, Equal> mutex_set_;
+  impl::InFlightUpdates<Key, Value, Hash, Equal> in_flight_updates_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 };
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
-    size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
-    : lru_(ways, way_size, hash, equal),
-      mutex_set_{ways, way_size, hash, equal} {}
+    size_t ways, size_t way_size, const Hash& hash, const Equal& equal,
+    CachePolicy policy)
+    : lru_(ways, way_size, hash, equal, policy),
+      in_flight_updates_{ways, hash, equal} {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::~ExpirableLruCache() {
@@ -199,6 +378,47 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetBackgroundUpdate(
   background_update_mode_ = background_update;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetCoalescedWaitTimeout(
+    std::chrono::milliseconds timeout) {
+  coalesced_wait_timeout_ = timeout;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetWeigher(
+    std::function<std::size_t(const Key&, const Value&)> weigher) {
+  has_weigher_ = static_cast<bool>(weigher);
+  if (!weigher) {
+    lru_.SetWeigher({});
+    return;
+  }
+
+  lru_.SetWeigher([weigher = std::move(weigher)](
+                      const Key& key,
+                      const impl::ExpirableValue<Value>& expirable) {
+    return weigher(key, expirable.value) + sizeof(expirable.update_time);
+  });
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetMaxBytes(
+    std::size_t max_bytes) {
+  lru_.UpdateMaxWeight(max_bytes);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetNegativeLookupFilter(
+    std::function<bool(const Key&)> may_contain, Value absent_value) {
+  UASSERT(may_contain);
+  negative_lookup_filter_.Assign(impl::NegativeLookupFilter<Key, Value>{
+      std::move(may_contain), std::move(absent_value)});
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::ResetNegativeLookupFilter() {
+  negative_lookup_filter_.Assign(std::nullopt);
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     const Key& key, const UpdateValueFunc& update_func, ReadMode read_mode) {
@@ -208,20 +428,41 @@ Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     return std::move(*opt_old_value);
   }
 
-  auto mutex = mutex_set_.GetMutexForKey(key);
-  std::lock_guard lock(mutex);
+  {
+    const auto filter = negative_lookup_filter_.Read();
+    if (*filter && !(*filter)->may_contain(key)) {
+      return (*filter)->absent_value;
+    }
+  }
+
+  auto [update, is_updater] = in_flight_updates_.Join(key);
+  if (!is_updater) {
+    impl::CacheCoalesced(stats_);
+    const auto timeout = coalesced_wait_timeout_.load();
+    const auto deadline = timeout.count() == 0
+                              ? engine::Deadline{}
+                              : engine::Deadline::FromDuration(timeout);
+    auto value = update->WaitUntil(deadline);
+    if (value) return std::move(*value);
+
+    // Fallback: the update takes too long or was abandoned
+    auto own_value = update_func(key);
+    if (read_mode == ReadMode::kUseCache) {
+      lru_.Put(key, {own_value, now});
+    }
+    return own_value;
+  }
+
   // Test one more time - concurrent ExpirableLruCache::Get()
   // might have put the value
   auto old_value = lru_.Get(key);
   if (old_value && !IsExpired(old_value->update_time, now)) {
+    update->SetValue(old_value->value);
+    in_flight_updates_.Finish(key, update);
     return std::move(old_value->value);
   }
 
-  auto value = update_func(key);
-  if (read_mode == ReadMode::kUseCache) {
-    lru_.Put(key, {value, now});
-  }
-  return value;
+  return RunUpdate(key, update_func, update, read_mode, now);
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -328,6 +569,13 @@ size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetSizeApproximate() const {
   return lru_.GetSize();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::optional<std::size_t>
+ExpirableLruCache<Key, Value, Hash, Equal>::GetBytesApproximate() const {
+  if (!has_weigher_) return std::nullopt;
+  return lru_.GetWeight();
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Invalidate() {
   lru_.Invalidate();
@@ -348,19 +596,43 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateInBackground(
   // cache will wait for all detached tasks in ~ExpirableLruCache()
   engine::AsyncNoSpan([token = wait_token_storage_.GetToken(), this, key,
                        update_func = std::move(update_func)] {
-    auto mutex = mutex_set_.GetMutexForKey(key);
-    std::unique_lock lock(mutex, std::try_to_lock);
-    if (!lock) {
+    const auto update = in_flight_updates_.TryStart(key);
+    if (!update) {
       // someone is updating the key right now
       return;
     }
 
     auto now = utils::datetime::SteadyNow();
-    auto value = update_func(key);
-    lru_.Put(key, {value, now});
+    RunUpdate(key, update_func, update, ReadMode::kUseCache, now);
   }).Detach();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+Value ExpirableLruCache<Key, Value, Hash, Equal>::RunUpdate(
+    const Key& key, const UpdateValueFunc& update_func,
+    const UpdatePtr& update, ReadMode read_mode,
+    std::chrono::steady_clock::time_point now) {
+  try {
+    auto value = update_func(key);
+    if (read_mode == ReadMode::kUseCache) {
+      lru_.Put(key, {value, now});
+    }
+    update->SetValue(value);
+    in_flight_updates_.Finish(key, update);
+    return value;
+  } catch (...) {
+    if (engine::current_task::ShouldCancel()) {
+      // The waiters should not fail because of the cancellation of another
+      // task
+      update->Abandon();
+    } else {
+      update->SetException(std::current_exception());
+    }
+    in_flight_updates_.Finish(key, update);
+    throw;
+  }
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 bool ExpirableLruCache<Key, Value, Hash, Equal>::IsExpired(
     std::chrono::steady_clock::time_point update_time,
@@ -437,6 +709,9 @@ template <typename Key, typename Value, typename Hash, typename Equal>
 void DumpMetric(utils::statistics::Writer& writer,
                 const ExpirableLruCache<Key, Value, Hash, Equal>& cache) {
   writer["current-documents-count"] = cache.GetSizeApproximate();
+  if (const auto bytes = cache.GetBytesApproximate()) {
+    writer["current-bytes"] = *bytes;
+  }
   writer = cache.GetStatistics();
 }
 
@@ -0,0 +1,175 @@
+#pragma once
+
+/// @file userver/cache/frozen_hash_map.hpp
+/// @brief @copybrief cache::FrozenHashMap
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/meta.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief Immutable flat hash map for read-only cache snapshots.
+///
+/// Built once in O(n) from a vector of key-value pairs, e.g. in
+/// CachingComponentBase::Update, and only read afterwards. Compared to
+/// `std::unordered_map` it has no per-element allocations and no pointer
+/// chasing: the pairs are stored contiguously in the order of the
+/// construction, and the lookups probe a compact open addressing index with
+/// a 7-bit hash tag per slot, so that most mismatches are rejected without
+/// touching the pairs.
+///
+/// If the source contains duplicate keys, the last value of a key wins.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class FrozenHashMap final {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+  using size_type = std::size_t;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+  using iterator = const_iterator;
+
+  FrozenHashMap() = default;
+
+  explicit FrozenHashMap(std::vector<value_type>&& items,
+                         const Hash& hash = Hash(),
+                         const Equal& equal = Equal());
+
+  size_type size() const noexcept { return entries_.size(); }
+  bool empty() const noexcept { return entries_.empty(); }
+
+  const_iterator begin() const noexcept { return entries_.begin(); }
+  const_iterator end() const noexcept { return entries_.end(); }
+
+  /// @returns a pointer to the value of the key or nullptr
+  const Value* Find(const Key& key) const;
+
+  bool Contains(const Key& key) const { return Find(key) != nullptr; }
+
+ private:
+  using Index = std::uint32_t;
+
+  static constexpr std::uint8_t kEmptyTag = 0;
+
+  // Spreads the bits of identity-like hashes, e.g. std::hash<int>
+  static std::size_t Mix(std::size_t hash) noexcept {
+    auto mixed = static_cast<std::uint64_t>(hash);
+    mixed ^= mixed >> 32;
+    mixed *= 0x9E3779B97F4A7C15ULL;
+    mixed ^= mixed >> 29;
+    return static_cast<std::size_t>(mixed);
+  }
+
+  static std::uint8_t MakeTag(std::size_t mixed) noexcept {
+    return static_cast<std::uint8_t>(mixed & 0x7F) | 0x80;
+  }
+
+  std::size_t FirstSlot(std::size_t mixed) const noexcept {
+    return (mixed >> 7) & (tags_.size() - 1);
+  }
+
+  Hash hash_;
+  Equal equal_;
+  std::vector<value_type> entries_;
+  // open addressing index with linear probing, the size is a power of 2
+  std::vector<std::uint8_t> tags_;
+  std::vector<Index> slots_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+FrozenHashMap<Key, Value, Hash, Equal>::FrozenHashMap(
+    std::vector<value_type>&& items, const Hash& hash, const Equal& equal)
+    : hash_(hash), equal_(equal) {
+  UINVARIANT(items.size() < std::numeric_limits<Index>::max(),
+             "Too many items for FrozenHashMap");
+  if (items.empty()) return;
+
+  // load factor is kept under 3/4 to keep the probe sequences short
+  std::size_t capacity = 8;
+  while (capacity * 3 < items.size() * 4) capacity *= 2;
+  tags_.assign(capacity, kEmptyTag);
+  slots_.resize(capacity);
+  entries_.reserve(items.size());
+
+  for (auto& item : items) {
+    const auto mixed = Mix(hash_(item.first));
+    const auto tag = MakeTag(mixed);
+    auto slot = FirstSlot(mixed);
+    while (true) {
+      if (tags_[slot] == kEmptyTag) {
+        tags_[slot] = tag;
+        slots_[slot] = static_cast<Index>(entries_.size());
+        entries_.push_back(std::move(item));
+        break;
+      }
+      auto& entry = entries_[slots_[slot]];
+      if (tags_[slot] == tag && equal_(entry.first, item.first)) {
+        entry.second = std::move(item.second);
+        break;
+      }
+      slot = (slot + 1) & (capacity - 1);
+    }
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+const Value* FrozenHashMap<Key, Value, Hash, Equal>::Find(
+    const Key& key) const {
+  if (entries_.empty()) return nullptr;
+
+  const auto mixed = Mix(hash_(key));
+  const auto tag = MakeTag(mixed);
+  for (auto slot = FirstSlot(mixed); tags_[slot] != kEmptyTag;
+       slot = (slot + 1) & (tags_.size() - 1)) {
+    if (tags_[slot] != tag) continue;
+    const auto& entry = entries_[slots_[slot]];
+    if (equal_(entry.first, key)) return &entry.second;
+  }
+  return nullptr;
+}
+
+}  // namespace cache
+
+namespace dump {
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::enable_if_t<kIsWritable<Key> && kIsWritable<Value>> Write(
+    Writer& writer, const cache::FrozenHashMap<Key, Value, Hash, Equal>& map) {
+  writer.Write(map.size());
+  for (const auto& [key, value] : map) {
+    writer.Write(key);
+    writer.Write(value);
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::enable_if_t<kIsReadable<Key> && kIsReadable<Value>,
+                 cache::FrozenHashMap<Key, Value, Hash, Equal>>
+Read(Reader& reader, To<cache::FrozenHashMap<Key, Value, Hash, Equal>>) {
+  const auto size = reader.Read<std::size_t>();
+  std::vector<std::pair<Key, Value>> items;
+  items.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    auto key = reader.Read<Key>();
+    auto value = reader.Read<Value>();
+    items.emplace_back(std::move(key), std::move(value));
+  }
+  return cache::FrozenHashMap<Key, Value, Hash, Equal>{std::move(items)};
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,362 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+enum class ConcurrentReadResult {
+  kHit,
+  kMiss,
+  /// The slot of the key is being changed right now, retry under the lock
+  kBusy,
+};
+
+/// The slot that the thread reads in ConcurrentClockMap::ReadConcurrently(),
+/// if any. Each thread publishes its reads in a record of its own, so that the
+/// readers of a hot key do not write to a shared cache line.
+struct alignas(64) ClockMapReaderRecord final {
+  std::atomic<const void*> slot{nullptr};
+  std::atomic<bool> is_used{true};
+  // The records are never freed, the ones of the finished threads are reused
+  ClockMapReaderRecord* next{nullptr};
+};
+
+ClockMapReaderRecord& GetClockMapReaderRecord();
+
+/// Waits until no thread reads the `slot`
+void WaitForClockMapReaders(const void* slot) noexcept;
+
+/// Set-associative CLOCK map for NWayLRU with CachePolicy::kClock.
+///
+/// A key maps to a bucket of up to kBucketSize slots. A hit only sets the
+/// `referenced` bit of its slot, so ReadConcurrently() does not need the way
+/// mutex: it finds the slot by the hash tag and publishes the slot in the
+/// ClockMapReaderRecord of its thread while the value is used. A hit does no
+/// read-modify-write operations, and the slots do not share cache lines. All
+/// the other member functions must be serialized by the caller, like the
+/// ones of LruMap. A writer waits for the readers of the slot it changes, the
+/// readers never wait.
+///
+/// On eviction the clock hand of the bucket clears the `referenced` bits
+/// until it finds a slot that was not read since the previous pass.
+///
+/// The capacity is rounded up to the whole number of buckets.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class ConcurrentClockMap final {
+ public:
+  static constexpr std::size_t kBucketSize = 8;
+
+  explicit ConcurrentClockMap(std::size_t max_size, const Hash& hash = Hash(),
+                              const Equal& equal = Equal());
+
+  ConcurrentClockMap(ConcurrentClockMap&&) = default;
+  ConcurrentClockMap& operator=(ConcurrentClockMap&&) = default;
+
+  /// Calls `func(const U&)` for the value of the key, if any. Thread-safe
+  /// with respect to concurrent calls of all the other member functions.
+  /// @warning `func` delays the writers of the slot, keep it short. It must
+  /// not switch the coroutine, as the read is published for the thread.
+  template <typename Function>
+  ConcurrentReadResult ReadConcurrently(const T& key, Function&& func) const;
+
+  bool Put(const T& key, U value);
+
+  U* Get(const T& key);
+
+  U GetOr(const T& key, const U& default_value);
+
+  void Erase(const T& key);
+
+  void SetMaxSize(std::size_t new_max_size);
+
+  void Clear();
+
+  template <typename Function>
+  void VisitAll(Function&& func) const;
+
+  std::size_t GetSize() const { return current_->size; }
+
+  std::size_t GetCapacity() const { return current_->slots.size(); }
+
+ private:
+  struct alignas(64) Slot final {
+    void Lock() noexcept {
+      // Pairs with the publication of the read in ReadConcurrently(): either
+      // the reader sees the flag, or the writer sees the reader
+      is_writing.store(true, std::memory_order_seq_cst);
+      // The readers only finish copying the value, the wait is short
+      WaitForClockMapReaders(this);
+    }
+
+    void Unlock() noexcept {
+      is_writing.store(false, std::memory_order_release);
+    }
+
+    void MarkReferenced() const noexcept {
+      // Avoids writing the cache line of a hot key on each hit
+      if (!referenced.load(std::memory_order_relaxed)) {
+        referenced.store(true, std::memory_order_relaxed);
+      }
+    }
+
+    std::atomic<bool> is_writing{false};
+    mutable std::atomic<bool> referenced{false};
+    // Zero for an empty slot
+    std::atomic<std::uint64_t> tag{0};
+    std::optional<std::pair<T, U>> entry;
+  };
+
+  class ReadGuard final {
+   public:
+    ReadGuard(ClockMapReaderRecord& record, const Slot& slot) noexcept
+        : record_(record) {
+      record_.slot.store(&slot, std::memory_order_seq_cst);
+    }
+    ReadGuard(const ReadGuard&) = delete;
+    ~ReadGuard() { record_.slot.store(nullptr, std::memory_order_release); }
+
+   private:
+    ClockMapReaderRecord& record_;
+  };
+
+  class WriteGuard final {
+   public:
+    explicit WriteGuard(Slot& slot) noexcept : slot_(slot) { slot_.Lock(); }
+    WriteGuard(const WriteGuard&) = delete;
+    ~WriteGuard() { slot_.Unlock(); }
+
+   private:
+    Slot& slot_;
+  };
+
+  struct Table final {
+    explicit Table(std::size_t max_size);
+
+    std::size_t GetBucketBegin(std::uint64_t hash) const noexcept {
+      // Fibonacci hashing, NWayLRU takes the remainder of the same hash to
+      // choose the way
+      return ((hash * 0x9E3779B97F4A7C15ULL) >> 32) % buckets_count *
+             bucket_size;
+    }
+
+    const std::size_t bucket_size;
+    const std::size_t buckets_count;
+    utils::FixedArray<Slot> slots;
+    // Modified by the writers only
+    utils::FixedArray<std::size_t> hands;
+    std::size_t size{0};
+  };
+
+  using TablePtr = std::shared_ptr<Table>;
+
+  static std::uint64_t MakeTag(std::uint64_t hash) noexcept { return hash | 1; }
+
+  Slot* Find(const T& key, std::uint64_t hash) const;
+
+  void Insert(Table& table, const T& key, std::uint64_t hash, U value,
+              bool referenced);
+
+  Hash hash_;
+  Equal equal_;
+  // The readers go through rcu, so that SetMaxSize() could replace the table
+  std::unique_ptr<rcu::Variable<TablePtr>> table_;
+  TablePtr current_;
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+ConcurrentClockMap<T, U, Hash, Equal>::Table::Table(std::size_t max_size)
+    : bucket_size(std::clamp<std::size_t>(max_size, 1, kBucketSize)),
+      buckets_count((std::max<std::size_t>(max_size, 1) + bucket_size - 1) /
+                    bucket_size),
+      slots(buckets_count * bucket_size),
+      hands(buckets_count, 0) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+ConcurrentClockMap<T, U, Hash, Equal>::ConcurrentClockMap(std::size_t max_size,
+                                                          const Hash& hash,
+                                                          const Equal& equal)
+    : hash_(hash),
+      equal_(equal),
+      current_(std::make_shared<Table>(max_size)) {
+  table_ = std::make_unique<rcu::Variable<TablePtr>>(
+      rcu::DestructionType::kSync, current_);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+ConcurrentReadResult ConcurrentClockMap<T, U, Hash, Equal>::ReadConcurrently(
+    const T& key, Function&& func) const {
+  const std::uint64_t hash = hash_(key);
+  const auto tag = MakeTag(hash);
+  const auto table_ptr = table_->Read();
+  const Table& table = **table_ptr;
+
+  auto& record = GetClockMapReaderRecord();
+  const auto begin = table.GetBucketBegin(hash);
+  for (auto i = begin; i < begin + table.bucket_size; ++i) {
+    const Slot& slot = table.slots[i];
+    if (slot.tag.load(std::memory_order_relaxed) != tag) continue;
+
+    const ReadGuard guard{record, slot};
+    if (slot.is_writing.load(std::memory_order_seq_cst)) {
+      return ConcurrentReadResult::kBusy;
+    }
+    if (slot.entry && equal_(slot.entry->first, key)) {
+      slot.MarkReferenced();
+      func(std::as_const(slot.entry->second));
+      return ConcurrentReadResult::kHit;
+    }
+  }
+  return ConcurrentReadResult::kMiss;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool ConcurrentClockMap<T, U, Hash, Equal>::Put(const T& key, U value) {
+  const std::uint64_t hash = hash_(key);
+  if (auto* const slot = Find(key, hash)) {
+    slot->MarkReferenced();
+    const WriteGuard guard{*slot};
+    slot->entry->second = std::move(value);
+    return false;
+  }
+
+  Insert(*current_, key, hash, std::move(value), false);
+  return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* ConcurrentClockMap<T, U, Hash, Equal>::Get(const T& key) {
+  auto* const slot = Find(key, hash_(key));
+  if (!slot) return nullptr;
+
+  slot->MarkReferenced();
+  return &slot->entry->second;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U ConcurrentClockMap<T, U, Hash, Equal>::GetOr(const T& key,
+                                               const U& default_value) {
+  auto* const value = Get(key);
+  if (value) return *value;
+  return default_value;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentClockMap<T, U, Hash, Equal>::Erase(const T& key) {
+  auto* const slot = Find(key, hash_(key));
+  if (!slot) return;
+
+  const WriteGuard guard{*slot};
+  slot->tag.store(0, std::memory_order_relaxed);
+  slot->entry.reset();
+  --current_->size;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentClockMap<T, U, Hash, Equal>::SetMaxSize(
+    std::size_t new_max_size) {
+  auto new_table = std::make_shared<Table>(new_max_size);
+  if (new_table->slots.size() == GetCapacity()) return;
+
+  // The readers keep using the old table until the new one is published
+  for (const auto& slot : current_->slots) {
+    if (!slot.entry) continue;
+    Insert(*new_table, slot.entry->first, hash_(slot.entry->first),
+           slot.entry->second,
+           slot.referenced.load(std::memory_order_relaxed));
+  }
+
+  table_->Assign(new_table);
+  current_ = std::move(new_table);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentClockMap<T, U, Hash, Equal>::Clear() {
+  for (auto& slot : current_->slots) {
+    if (!slot.entry) continue;
+
+    const WriteGuard guard{slot};
+    slot.tag.store(0, std::memory_order_relaxed);
+    slot.entry.reset();
+  }
+  current_->size = 0;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void ConcurrentClockMap<T, U, Hash, Equal>::VisitAll(Function&& func) const {
+  for (const auto& slot : current_->slots) {
+    if (slot.entry) func(slot.entry->first, slot.entry->second);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename ConcurrentClockMap<T, U, Hash, Equal>::Slot*
+ConcurrentClockMap<T, U, Hash, Equal>::Find(const T& key,
+                                            std::uint64_t hash) const {
+  // The caller is the only writer, the slots are read without the guards
+  auto& table = *current_;
+  const auto tag = MakeTag(hash);
+  const auto begin = table.GetBucketBegin(hash);
+  for (auto i = begin; i < begin + table.bucket_size; ++i) {
+    auto& slot = table.slots[i];
+    if (slot.tag.load(std::memory_order_relaxed) == tag && slot.entry &&
+        equal_(slot.entry->first, key)) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ConcurrentClockMap<T, U, Hash, Equal>::Insert(Table& table, const T& key,
+                                                   std::uint64_t hash, U value,
+                                                   bool referenced) {
+  const auto begin = table.GetBucketBegin(hash);
+  auto victim = begin;
+  while (victim < begin + table.bucket_size && table.slots[victim].entry) {
+    ++victim;
+  }
+
+  if (victim == begin + table.bucket_size) {
+    // Terminates in two passes at most: the first one clears all the bits
+    auto& hand = table.hands[begin / table.bucket_size];
+    while (true) {
+      victim = begin + hand;
+      hand = (hand + 1) % table.bucket_size;
+      if (!table.slots[victim].referenced.exchange(
+              false, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+  }
+
+  auto& slot = table.slots[victim];
+  const WriteGuard guard{slot};
+  if (slot.entry) {
+    slot.tag.store(0, std::memory_order_relaxed);
+    slot.entry.reset();
+    --table.size;
+  }
+  slot.entry.emplace(key, std::move(value));
+  ++table.size;
+  slot.referenced.store(referenced, std::memory_order_relaxed);
+  slot.tag.store(MakeTag(hash), std::memory_order_relaxed);
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -7,6 +7,7 @@
 
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/cache/lru_cache_config.hpp>
+#include <userver/cache/size_of.hpp>
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dump/dumper.hpp>
@@ -61,7 +62,10 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// size | max amount of items to store in cache | --
 /// ways | number of ways for associative cache | --
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
+/// coalesced-wait-timeout | how long concurrent misses of a key wait for the in-flight update (0 is unlimited) | 0
+/// max-bytes | approximate limit of the memory used by the elements, see cache::ApproximateSizeOf (0 is unlimited, not supported by `clock`) | 0
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
+/// policy | eviction policy of the ways: `lru`, `w-tiny-lfu` (frequency based admission, resists scans) or `clock` (hits do not lock the ways) | lru
 ///
 /// ## Example usage:
 ///
@@ -111,6 +115,8 @@ class LruCacheComponent : public components::LoggableComponentBase,
   void ReadAndSet(dump::Reader& reader) override;
 
  protected:
+  /// Allows the descendants to tune the cache, e.g. with
+  /// Cache::SetNegativeLookupFilter on the full updates of the keys
   std::shared_ptr<Cache> GetCacheRaw() { return cache_; }
 
  private:
@@ -131,7 +137,16 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
       cache_(std::make_shared<Cache>(static_config_.ways,
-                                     static_config_.GetWaySize())) {
+                                     static_config_.GetWaySize(), Hash(),
+                                     Equal(), static_config_.policy)) {
+  if (static_config_.policy != CachePolicy::kClock) {
+    // Unqualified call, so that ApproximateSizeOf could be customized via ADL
+    cache_->SetWeigher([](const Key& key, const Value& value) {
+      return ApproximateSizeOf(key) + ApproximateSizeOf(value);
+    });
+    cache_->SetMaxBytes(static_config_.config.max_bytes);
+  }
+
   if (impl::IsDumpSupportEnabled(config)) {
     dumper_ = std::make_shared<dump::Dumper>(
         config, context, static_cast<dump::DumpableEntity&>(*this));
@@ -141,6 +156,7 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
 
   cache_->SetMaxLifetime(static_config_.config.lifetime);
   cache_->SetBackgroundUpdate(static_config_.config.background_update);
+  cache_->SetCoalescedWaitTimeout(static_config_.config.coalesced_wait_timeout);
 
   if (static_config_.use_dynamic_config) {
     LOG_INFO() << "Dynamic LRU cache config is enabled, subscribing on "
@@ -210,6 +226,10 @@ void LruCacheComponent<Key, Value, Hash, Equal>::UpdateConfig(
   cache_->SetWaySize(config.GetWaySize(static_config_.ways));
   cache_->SetMaxLifetime(config.lifetime);
   cache_->SetBackgroundUpdate(config.background_update);
+  cache_->SetCoalescedWaitTimeout(config.coalesced_wait_timeout);
+  if (static_config_.policy != CachePolicy::kClock) {
+    cache_->SetMaxBytes(config.max_bytes);
+  }
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
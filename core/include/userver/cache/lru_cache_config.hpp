@@ -5,6 +5,7 @@
 #include <optional>
 #include <unordered_map>
 
+#include <userver/cache/lru_map.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -30,6 +31,10 @@ struct LruCacheConfig final {
   std::size_t size;
   std::chrono::milliseconds lifetime;
   BackgroundUpdateMode background_update;
+  // 0 waits for the in-flight update of the key without a limit
+  std::chrono::milliseconds coalesced_wait_timeout;
+  // Approximate limit of the memory used by the elements, 0 disables it
+  std::size_t max_bytes;
 };
 
 LruCacheConfig Parse(const formats::json::Value& value,
@@ -44,8 +49,12 @@ struct LruCacheConfigStatic final {
   LruCacheConfig config;
   std::size_t ways;
   bool use_dynamic_config;
+  CachePolicy policy;
 };
 
+CachePolicy Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<CachePolicy>);
+
 extern const dynamic_config::Key<
     std::unordered_map<std::string, LruCacheConfig>>
     kLruCacheConfigSet;
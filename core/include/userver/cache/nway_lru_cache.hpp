@@ -1,25 +1,47 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <optional>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
+#include <userver/cache/impl/concurrent_clock_map.hpp>
 #include <userver/cache/lru_map.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace cache {
 
 /// @ingroup userver_containers
+///
+/// @brief Thread-safe LRU cache split into `ways` independent LRU maps, each
+/// one guarded by its own mutex.
+///
+/// With CachePolicy::kClock the hits do not take the mutex of the way, see
+/// cache::impl::ConcurrentClockMap. Use it for the read-mostly caches of hot
+/// keys that are read from many threads.
+///
+/// With a weigher the cache also tracks the total weight of the elements,
+/// e.g. their memory usage, and evicts the least used elements to keep it
+/// under the limit. Like the size, the weight limit is split evenly between
+/// the ways.
 template <typename T, typename U, typename Hash = std::hash<T>,
           typename Equal = std::equal_to<T>>
 class NWayLRU final {
  public:
+  /// Returns the weight of the element, e.g. cache::ApproximateSizeOf
+  using Weigher = std::function<std::size_t(const T&, const U&)>;
+
   NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
-          const Equal& equal = Equal());
+          const Equal& equal = Equal(),
+          CachePolicy policy = CachePolicy::kLru);
 
   void Put(const T& key, U value);
 
@@ -44,6 +66,19 @@ class NWayLRU final {
 
   void UpdateWaySize(size_t way_size);
 
+  /// @brief Enables the accounting of the weight of the elements.
+  /// @throws std::logic_error for CachePolicy::kClock
+  /// @note Not thread-safe, call it before the cache is used
+  void SetWeigher(Weigher weigher);
+
+  /// Sets the limit of the total weight of the elements, 0 disables the
+  /// limit. An element heavier than the limit of its way is not stored.
+  /// Requires SetWeigher().
+  void UpdateMaxWeight(std::size_t max_weight);
+
+  /// Total weight of the elements, 0 without a weigher
+  std::size_t GetWeight() const;
+
   void Write(dump::Writer& writer) const;
   void Read(dump::Reader& reader);
 
@@ -53,33 +88,86 @@ class NWayLRU final {
 
  private:
   struct Way {
-    Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
+    using Lru = LruMap<T, U, Hash, Equal, CachePolicy::kLru>;
+    using WTinyLfu = LruMap<T, U, Hash, Equal, CachePolicy::kWTinyLfu>;
+    using Clock = impl::ConcurrentClockMap<T, U, Hash, Equal>;
+
+    Way(Way&& other) noexcept
+        : cache(std::move(other.cache)),
+          weight(other.weight),
+          max_weight(other.max_weight) {}
 
     // max_size is not used, will be reset by Resize() in NWayLRU::NWayLRU
-    Way(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
+    Way(const Hash& hash, const Equal& equal, CachePolicy policy)
+        : cache(std::in_place_type<Lru>, 1, hash, equal) {
+      if (policy == CachePolicy::kWTinyLfu) {
+        cache.template emplace<WTinyLfu>(1, hash, equal);
+      } else if (policy == CachePolicy::kClock) {
+        cache.template emplace<Clock>(1, hash, equal);
+      }
+    }
+
+    template <typename Function>
+    decltype(auto) Visit(Function&& func) {
+      return std::visit(std::forward<Function>(func), cache);
+    }
+
+    template <typename Function>
+    decltype(auto) Visit(Function&& func) const {
+      return std::visit(std::forward<Function>(func), cache);
+    }
 
     mutable engine::Mutex mutex;
-    LruMap<T, U, Hash, Equal> cache;
+    std::variant<Lru, WTinyLfu, Clock> cache;
+    // Maintained only with a weigher
+    std::size_t weight{0};
+    std::size_t max_weight{std::numeric_limits<std::size_t>::max()};
   };
 
+  // ConcurrentClockMap evicts in the bucket of the new key, the weights of its
+  // elements are not tracked
+  template <typename Cache>
+  static constexpr bool kIsWeighable =
+      !std::is_same_v<std::decay_t<Cache>, typename Way::Clock>;
+
   Way& GetWay(const T& key);
 
+  // Returns std::nullopt if the lookup should be repeated under the lock
+  template <typename Validator>
+  static std::optional<std::optional<U>> TryGetWithoutLock(
+      const Way& way, const T& key, Validator& validator);
+
+  template <typename Cache>
+  void PutWeighted(Way& way, Cache& cache, const T& key, U&& value);
+
+  template <typename Cache>
+  void Erase(Way& way, Cache& cache, const T& key);
+
+  template <typename Cache>
+  void EvictOverweight(Way& way, Cache& cache);
+
+  template <typename Cache>
+  void RecomputeWeight(Way& way, const Cache& cache) const;
+
   void NotifyDumper();
 
   std::vector<Way> caches_;
   Hash hash_fn_;
+  Weigher weigher_;
   std::shared_ptr<dump::Dumper> dumper_{nullptr};
 };
 
 template <typename T, typename U, typename Hash, typename Eq>
 NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
-                                 const Eq& equal)
+                                 const Eq& equal, CachePolicy policy)
     : caches_(), hash_fn_(hash) {
   caches_.reserve(ways);
-  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
+  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal, policy);
   if (ways == 0) throw std::logic_error("Ways must be positive");
 
-  for (auto& way : caches_) way.cache.SetMaxSize(way_size);
+  for (auto& way : caches_) {
+    way.Visit([way_size](auto& cache) { cache.SetMaxSize(way_size); });
+  }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -87,7 +175,15 @@ void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
   auto& way = GetWay(key);
   {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Put(key, std::move(value));
+    way.Visit([&](auto& cache) {
+      if constexpr (kIsWeighable<decltype(cache)>) {
+        if (weigher_) {
+          PutWeighted(way, cache, key, std::move(value));
+          return;
+        }
+      }
+      cache.Put(key, std::move(value));
+    });
   }
   NotifyDumper();
 }
@@ -97,15 +193,21 @@ template <typename Validator>
 std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
                                               Validator validator) {
   auto& way = GetWay(key);
+  if (auto result = TryGetWithoutLock(way, key, validator)) {
+    return std::move(*result);
+  }
+
   std::unique_lock<engine::Mutex> lock(way.mutex);
-  auto* value = way.cache.Get(key);
+  return way.Visit([&](auto& cache) -> std::optional<U> {
+    auto* value = cache.Get(key);
 
-  if (value) {
-    if (validator(*value)) return *value;
-    way.cache.Erase(key);
-  }
+    if (value) {
+      if (validator(*value)) return *value;
+      Erase(way, cache, key);
+    }
 
-  return std::nullopt;
+    return std::nullopt;
+  });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -113,7 +215,7 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
   auto& way = GetWay(key);
   {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Erase(key);
+    way.Visit([&](auto& cache) { Erase(way, cache, key); });
   }
   NotifyDumper();
 }
@@ -121,15 +223,22 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
 template <typename T, typename U, typename Hash, typename Eq>
 U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
   auto& way = GetWay(key);
+  const auto validator = [](const U&) { return true; };
+  if (auto result = TryGetWithoutLock(way, key, validator)) {
+    return *result ? std::move(**result) : default_value;
+  }
+
   std::unique_lock<engine::Mutex> lock(way.mutex);
-  return way.cache.GetOr(key, default_value);
+  return way.Visit(
+      [&](auto& cache) { return cache.GetOr(key, default_value); });
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Invalidate() {
   for (auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Clear();
+    way.Visit([](auto& cache) { cache.Clear(); });
+    way.weight = 0;
   }
   NotifyDumper();
 }
@@ -139,7 +248,7 @@ template <typename Function>
 void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
   for (const auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.VisitAll(func);
+    way.Visit([&func](const auto& cache) { cache.VisitAll(func); });
   }
 }
 
@@ -148,7 +257,7 @@ size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
   size_t size{0};
   for (const auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    size += way.cache.GetSize();
+    size += way.Visit([](const auto& cache) { return cache.GetSize(); });
   }
   return size;
 }
@@ -157,10 +266,122 @@ template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
   for (auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.SetMaxSize(way_size);
+    way.Visit([&](auto& cache) {
+      cache.SetMaxSize(way_size);
+      // The evicted elements are not known
+      if (weigher_) RecomputeWeight(way, cache);
+    });
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::SetWeigher(Weigher weigher) {
+  if (std::holds_alternative<typename Way::Clock>(caches_.front().cache)) {
+    throw std::logic_error("CachePolicy::kClock does not support weighers");
+  }
+
+  weigher_ = std::move(weigher);
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    way.Visit([&](const auto& cache) {
+      if (weigher_) {
+        RecomputeWeight(way, cache);
+      } else {
+        way.weight = 0;
+      }
+    });
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayLRU<T, U, Hash, Eq>::UpdateMaxWeight(std::size_t max_weight) {
+  UASSERT_MSG(weigher_ || max_weight == 0, "SetWeigher() was not called");
+  const auto way_max_weight =
+      max_weight == 0 ? std::numeric_limits<std::size_t>::max()
+                      : std::max<std::size_t>(max_weight / caches_.size(), 1);
+
+  for (auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    way.max_weight = way_max_weight;
+    way.Visit([&](auto& cache) {
+      if constexpr (kIsWeighable<decltype(cache)>) {
+        if (weigher_) EvictOverweight(way, cache);
+      }
+    });
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+std::size_t NWayLRU<T, U, Hash, Eq>::GetWeight() const {
+  std::size_t weight{0};
+  for (const auto& way : caches_) {
+    std::unique_lock<engine::Mutex> lock(way.mutex);
+    weight += way.weight;
+  }
+  return weight;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Cache>
+void NWayLRU<T, U, Hash, Eq>::PutWeighted(Way& way, Cache& cache,
+                                          const T& key, U&& value) {
+  const auto weight = weigher_(key, value);
+  if (auto* const old_value = cache.Get(key)) {
+    way.weight -= weigher_(key, *old_value);
+    if (weight > way.max_weight) {
+      cache.Erase(key);
+      return;
+    }
+    *old_value = std::move(value);
+  } else {
+    if (weight > way.max_weight) return;
+    cache.VisitEvictionCandidate([&](const T& evicted_key, const U& evicted) {
+      way.weight -= weigher_(evicted_key, evicted);
+    });
+    cache.Put(key, std::move(value));
+  }
+
+  way.weight += weight;
+  EvictOverweight(way, cache);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Cache>
+void NWayLRU<T, U, Hash, Eq>::Erase(Way& way, Cache& cache, const T& key) {
+  if constexpr (kIsWeighable<Cache>) {
+    if (weigher_) {
+      if (const auto* const value = cache.Get(key)) {
+        way.weight -= weigher_(key, *value);
+      }
+    }
+  }
+  cache.Erase(key);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Cache>
+void NWayLRU<T, U, Hash, Eq>::EvictOverweight(Way& way, Cache& cache) {
+  while (way.weight > way.max_weight) {
+    const auto* const key = cache.GetLeastUsedKey();
+    if (!key) break;
+
+    // The key is destroyed by the Erase()
+    const T evicted_key = *key;
+    way.weight -= weigher_(evicted_key, *cache.GetLeastUsed());
+    cache.Erase(evicted_key);
   }
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Cache>
+void NWayLRU<T, U, Hash, Eq>::RecomputeWeight(Way& way,
+                                              const Cache& cache) const {
+  way.weight = 0;
+  cache.VisitAll([&](const T& key, const U& value) {
+    way.weight += weigher_(key, value);
+  });
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(
     const T& key) {
@@ -174,6 +395,33 @@ typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(
   return caches_[n];
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Validator>
+std::optional<std::optional<U>> NWayLRU<T, U, Hash, Eq>::TryGetWithoutLock(
+    const Way& way, const T& key, Validator& validator) {
+  const auto* const clock = std::get_if<typename Way::Clock>(&way.cache);
+  if (!clock) return std::nullopt;
+
+  std::optional<U> result;
+  bool is_valid = true;
+  const auto status = clock->ReadConcurrently(key, [&](const U& value) {
+    is_valid = validator(value);
+    if (is_valid) result.emplace(value);
+  });
+
+  switch (status) {
+    case impl::ConcurrentReadResult::kHit:
+      // An invalid value is erased under the lock
+      if (!is_valid) return std::nullopt;
+      return std::optional<std::optional<U>>{std::move(result)};
+    case impl::ConcurrentReadResult::kMiss:
+      return std::optional<std::optional<U>>{std::optional<U>{}};
+    case impl::ConcurrentReadResult::kBusy:
+      return std::nullopt;
+  }
+  return std::nullopt;
+}
+
 template <typename T, typename U, typename Hash, typename Equal>
 void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
   writer.Write(caches_.size());
@@ -181,11 +429,13 @@ void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
   for (const Way& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
 
-    writer.Write(way.cache.GetSize());
+    way.Visit([&writer](const auto& cache) {
+      writer.Write(cache.GetSize());
 
-    way.cache.VisitAll([&writer](const T& key, const U& value) {
-      writer.Write(key);
-      writer.Write(value);
+      cache.VisitAll([&writer](const T& key, const U& value) {
+        writer.Write(key);
+        writer.Write(value);
+      });
     });
   }
 }
@@ -0,0 +1,379 @@
+#pragma once
+
+/// @file userver/cache/persistent_map.hpp
+/// @brief @copybrief cache::PersistentMap
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/meta.hpp>
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief Immutable-by-version hash map with structural sharing.
+///
+/// Copying a PersistentMap is O(1): the copies share all their nodes, and a
+/// modification of a copy replaces only O(log n) nodes on the path to the
+/// modified key (hash array mapped trie). This makes the following pattern
+/// cheap for incremental updates of caches with huge data:
+///
+/// @code
+/// auto data = *Get();  // O(1)
+/// for (auto& [key, value] : changes) data.InsertOrAssign(key, value);
+/// Set(std::move(data));  // shares most of the nodes with the old snapshot
+/// @endcode
+///
+/// Different copies may be used concurrently from different threads, a
+/// single copy may not be modified concurrently. Iterators are invalidated by
+/// any modification of the map they point to.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class PersistentMap final {
+  struct Node;
+  using NodePtr = std::shared_ptr<const Node>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+  using size_type = std::size_t;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  PersistentMap() = default;
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  /// @returns a pointer to the value of the key or nullptr
+  const Value* Find(const Key& key) const;
+  bool Contains(const Key& key) const { return Find(key) != nullptr; }
+
+  /// @returns true if the key was inserted, false if it was assigned
+  bool InsertOrAssign(Key key, Value value);
+
+  /// @returns true if the key was erased
+  bool Erase(const Key& key);
+
+  void Clear() noexcept {
+    root_.reset();
+    size_ = 0;
+  }
+
+  const_iterator begin() const { return const_iterator{root_.get()}; }
+  const_iterator end() const { return const_iterator{}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+ private:
+  static constexpr std::size_t kBits = 5;
+  static constexpr std::size_t kHashBits = sizeof(std::size_t) * 8;
+
+  // A leaf if `entries` is not empty, all the entries of a leaf have the same
+  // hash. Nodes are never modified after they are published.
+  struct Node {
+    std::uint32_t bitmap{0};
+    std::vector<NodePtr> children;
+    std::size_t hash{0};
+    std::vector<value_type> entries;
+
+    bool IsLeaf() const noexcept { return !entries.empty(); }
+  };
+
+  static std::size_t Index(std::size_t hash, std::size_t shift) {
+    return (hash >> shift) & ((std::size_t{1} << kBits) - 1);
+  }
+
+  static std::size_t Position(const Node& node, std::size_t index) {
+    const std::uint32_t lower_bits = (std::uint32_t{1} << index) - 1;
+    return std::bitset<32>(node.bitmap & lower_bits).count();
+  }
+
+  static bool HasChild(const Node& node, std::size_t index) {
+    return node.bitmap & (std::uint32_t{1} << index);
+  }
+
+  static NodePtr MakeLeaf(std::size_t hash, Key&& key, Value&& value);
+  static NodePtr MakeBranch(NodePtr first, NodePtr second, std::size_t shift);
+  NodePtr DoInsert(const NodePtr& node, std::size_t hash, std::size_t shift,
+                   Key&& key, Value&& value, bool& inserted) const;
+  NodePtr DoErase(const NodePtr& node, std::size_t hash, std::size_t shift,
+                  const Key& key, bool& erased) const;
+
+  NodePtr root_;
+  size_type size_{0};
+  Hash hash_{};
+  Equal equal_{};
+};
+
+/// Forward iterator over the entries of a PersistentMap in unspecified order
+template <typename Key, typename Value, typename Hash, typename Equal>
+class PersistentMap<Key, Value, Hash, Equal>::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = PersistentMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  const_iterator() = default;
+
+  reference operator*() const {
+    const auto& [leaf, index] = path_.back();
+    return leaf->entries[index];
+  }
+  pointer operator->() const { return &**this; }
+
+  const_iterator& operator++() {
+    Advance();
+    return *this;
+  }
+  const_iterator operator++(int) {
+    auto copy = *this;
+    Advance();
+    return copy;
+  }
+
+  bool operator==(const const_iterator& other) const {
+    return path_ == other.path_;
+  }
+  bool operator!=(const const_iterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  friend class PersistentMap;
+
+  explicit const_iterator(const Node* root) {
+    if (root) Descend(root);
+  }
+
+  void Descend(const Node* node) {
+    while (!node->IsLeaf()) {
+      path_.emplace_back(node, 0);
+      node = node->children.front().get();
+    }
+    path_.emplace_back(node, 0);
+  }
+
+  void Advance() {
+    if (++path_.back().second < path_.back().first->entries.size()) return;
+    path_.pop_back();
+    while (!path_.empty()) {
+      auto& [node, index] = path_.back();
+      if (++index < node->children.size()) {
+        Descend(node->children[index].get());
+        return;
+      }
+      path_.pop_back();
+    }
+  }
+
+  // Branches with the index of the current child and the leaf with the index
+  // of the current entry
+  std::vector<std::pair<const Node*, std::size_t>> path_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+const Value* PersistentMap<Key, Value, Hash, Equal>::Find(
+    const Key& key) const {
+  const auto hash = hash_(key);
+  const Node* node = root_.get();
+  for (std::size_t shift = 0; node && !node->IsLeaf(); shift += kBits) {
+    const auto index = Index(hash, shift);
+    if (!HasChild(*node, index)) return nullptr;
+    node = node->children[Position(*node, index)].get();
+  }
+  if (!node || node->hash != hash) return nullptr;
+  for (const auto& entry : node->entries) {
+    if (equal_(entry.first, key)) return &entry.second;
+  }
+  return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentMap<Key, Value, Hash, Equal>::InsertOrAssign(Key key,
+                                                            Value value) {
+  const auto hash = hash_(key);
+  bool inserted = false;
+  root_ = DoInsert(root_, hash, 0, std::move(key), std::move(value), inserted);
+  if (inserted) ++size_;
+  return inserted;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentMap<Key, Value, Hash, Equal>::Erase(const Key& key) {
+  bool erased = false;
+  root_ = DoErase(root_, hash_(key), 0, key, erased);
+  if (erased) --size_;
+  return erased;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::MakeLeaf(std::size_t hash,
+                                                      Key&& key, Value&& value)
+    -> NodePtr {
+  auto leaf = std::make_shared<Node>();
+  leaf->hash = hash;
+  leaf->entries.emplace_back(std::move(key), std::move(value));
+  return leaf;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::MakeBranch(NodePtr first,
+                                                        NodePtr second,
+                                                        std::size_t shift)
+    -> NodePtr {
+  auto branch = std::make_shared<Node>();
+  const auto first_index = Index(first->hash, shift);
+  const auto second_index = Index(second->hash, shift);
+  // Leaves have different hashes, so they diverge before the hash bits end
+  if (first_index == second_index) {
+    branch->bitmap = std::uint32_t{1} << first_index;
+    branch->children.push_back(
+        MakeBranch(std::move(first), std::move(second), shift + kBits));
+    return branch;
+  }
+  branch->bitmap =
+      (std::uint32_t{1} << first_index) | (std::uint32_t{1} << second_index);
+  if (first_index > second_index) std::swap(first, second);
+  branch->children.push_back(std::move(first));
+  branch->children.push_back(std::move(second));
+  return branch;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::DoInsert(
+    const NodePtr& node, std::size_t hash, std::size_t shift, Key&& key,
+    Value&& value, bool& inserted) const -> NodePtr {
+  if (!node) {
+    inserted = true;
+    return MakeLeaf(hash, std::move(key), std::move(value));
+  }
+
+  if (node->IsLeaf()) {
+    if (node->hash != hash) {
+      inserted = true;
+      return MakeBranch(node, MakeLeaf(hash, std::move(key), std::move(value)),
+                        shift);
+    }
+    auto leaf = std::make_shared<Node>(*node);
+    for (auto& entry : leaf->entries) {
+      if (equal_(entry.first, key)) {
+        entry.second = std::move(value);
+        return leaf;
+      }
+    }
+    inserted = true;
+    leaf->entries.emplace_back(std::move(key), std::move(value));
+    return leaf;
+  }
+
+  const auto index = Index(hash, shift);
+  const auto position = Position(*node, index);
+  auto branch = std::make_shared<Node>(*node);
+  if (HasChild(*node, index)) {
+    branch->children[position] =
+        DoInsert(node->children[position], hash, shift + kBits, std::move(key),
+                 std::move(value), inserted);
+  } else {
+    inserted = true;
+    branch->bitmap |= std::uint32_t{1} << index;
+    branch->children.insert(branch->children.begin() + position,
+                            MakeLeaf(hash, std::move(key), std::move(value)));
+  }
+  return branch;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentMap<Key, Value, Hash, Equal>::DoErase(const NodePtr& node,
+                                                     std::size_t hash,
+                                                     std::size_t shift,
+                                                     const Key& key,
+                                                     bool& erased) const
+    -> NodePtr {
+  if (!node) return node;
+
+  if (node->IsLeaf()) {
+    if (node->hash != hash) return node;
+    for (std::size_t i = 0; i < node->entries.size(); ++i) {
+      if (!equal_(node->entries[i].first, key)) continue;
+      erased = true;
+      if (node->entries.size() == 1) return nullptr;
+      auto leaf = std::make_shared<Node>(*node);
+      leaf->entries.erase(leaf->entries.begin() + i);
+      return leaf;
+    }
+    return node;
+  }
+
+  const auto index = Index(hash, shift);
+  if (!HasChild(*node, index)) return node;
+  const auto position = Position(*node, index);
+  auto child =
+      DoErase(node->children[position], hash, shift + kBits, key, erased);
+  if (!erased) return node;
+
+  if (!child) {
+    if (node->children.size() == 1) return nullptr;
+    if (node->children.size() == 2) {
+      // Collapse the branch into the remaining leaf, leaves contain the whole
+      // hash and may be placed at any depth
+      const auto& other = node->children[1 - position];
+      if (other->IsLeaf()) return other;
+    }
+    auto branch = std::make_shared<Node>(*node);
+    branch->bitmap &= ~(std::uint32_t{1} << index);
+    branch->children.erase(branch->children.begin() + position);
+    return branch;
+  }
+
+  if (child->IsLeaf() && node->children.size() == 1) return child;
+  auto branch = std::make_shared<Node>(*node);
+  branch->children[position] = std::move(child);
+  return branch;
+}
+
+}  // namespace cache
+
+namespace dump {
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::enable_if_t<kIsWritable<Key> && kIsWritable<Value>> Write(
+    Writer& writer, const cache::PersistentMap<Key, Value, Hash, Equal>& map) {
+  writer.Write(map.size());
+  for (const auto& [key, value] : map) {
+    writer.Write(key);
+    writer.Write(value);
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::enable_if_t<kIsReadable<Key> && kIsReadable<Value>,
+                 cache::PersistentMap<Key, Value, Hash, Equal>>
+Read(Reader& reader, To<cache::PersistentMap<Key, Value, Hash, Equal>>) {
+  const auto size = reader.Read<std::size_t>();
+  cache::PersistentMap<Key, Value, Hash, Equal> map;
+  for (std::size_t i = 0; i < size; ++i) {
+    auto key = reader.Read<Key>();
+    auto value = reader.Read<Value>();
+    map.InsertOrAssign(std::move(key), std::move(value));
+  }
+  return map;
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,364 @@
+#pragma once
+
+/// @file userver/cache/sharded_caching_component_base.hpp
+/// @brief @copybrief components::ShardedCachingComponentBase
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/cache/cache_update_trait.hpp>
+#include <userver/cache/exceptions.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/helpers.hpp>
+#include <userver/dump/meta.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/impl/wait_token_storage.hpp>
+#include <userver/utils/shared_readable_ptr.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+// clang-format off
+
+/// @ingroup userver_components userver_base_classes
+///
+/// @brief Base class for caching components that split the cached data into
+/// independently updated shards
+///
+/// The cached value consists of `shards-count` values of type T, each one is
+/// stored in its own RCU variable. On each cache update
+/// ShardedCachingComponentBase::UpdateShard is called for all the shards in
+/// parallel on the cache task processor. Readers get a consistent snapshot of
+/// a single shard via Get(shard).
+///
+/// Each shard has its own update cycle: a shard that has never been updated
+/// successfully gets UpdateType::kFull, and `last_update` is the time of the
+/// last successful update of the shard. A failure of one shard does not
+/// prevent the other shards from updating; the cache update as a whole is
+/// considered failed and the failed shards are retried on the next update.
+///
+/// Cache dumps contain all the shards in a single dump file.
+///
+/// ## Static options:
+/// All the options of components::CachingComponentBase and:
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// shards-count | number of shards | 1
+
+// clang-format on
+
+template <typename T>
+// NOLINTNEXTLINE(fuchsia-multiple-inheritance)
+class ShardedCachingComponentBase : public LoggableComponentBase,
+                                    protected cache::CacheUpdateTrait {
+ public:
+  ShardedCachingComponentBase(const ComponentConfig& config,
+                              const ComponentContext&);
+  ~ShardedCachingComponentBase() override;
+
+  using cache::CacheUpdateTrait::Name;
+
+  using DataType = T;
+
+  std::size_t GetShardsCount() const { return shards_.size(); }
+
+  /// @return the index of the shard for the key, may be used by the
+  /// implementations to distribute the data between the shards
+  template <typename Key, typename Hash = std::hash<Key>>
+  std::size_t GetShardIndex(const Key& key, const Hash& hash = Hash{}) const {
+    return hash(key) % shards_.size();
+  }
+
+  /// @return contents of the shard
+  /// @throws cache::EmptyCacheError if the shard has not been updated yet
+  utils::SharedReadablePtr<T> Get(std::size_t shard) const;
+
+  /// @return contents of the shard, may be nullptr
+  utils::SharedReadablePtr<T> GetUnsafe(std::size_t shard) const;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ protected:
+  /// @brief Should be overridden in a derived class to update a single shard,
+  /// may be called concurrently for different shards.
+  ///
+  /// If the shard has changes, the implementation should call SetShard and
+  /// return the number of documents in the shard. If there are no changes,
+  /// std::nullopt should be returned. Throw an exception on failure.
+  virtual std::optional<std::size_t> UpdateShard(
+      std::size_t shard, cache::UpdateType type,
+      const std::chrono::system_clock::time_point& last_update,
+      const std::chrono::system_clock::time_point& now) = 0;
+
+  void SetShard(std::size_t shard, std::unique_ptr<const T> value_ptr);
+  void SetShard(std::size_t shard, T&& value);
+
+  /// @{
+  /// Override to use custom serialization for cache dumps
+  virtual void WriteContents(dump::Writer& writer, const T& contents) const;
+
+  virtual std::unique_ptr<const T> ReadContents(dump::Reader& reader) const;
+  /// @}
+
+ private:
+  struct Shard {
+    rcu::Variable<std::shared_ptr<const T>> value;
+    std::chrono::system_clock::time_point last_update{};
+    std::size_t documents_count{0};
+  };
+
+  void Update(cache::UpdateType type,
+              const std::chrono::system_clock::time_point& last_update,
+              const std::chrono::system_clock::time_point& now,
+              cache::UpdateStatisticsScope& stats_scope) final;
+
+  void OnAllComponentsLoaded() final;
+
+  void Cleanup() final;
+
+  void MarkAsExpired() final;
+
+  void GetAndWrite(dump::Writer& writer) const final;
+  void ReadAndSet(dump::Reader& reader) final;
+
+  Shard& GetShard(std::size_t shard);
+  const Shard& GetShard(std::size_t shard) const;
+
+  std::vector<Shard> shards_;
+  utils::impl::WaitTokenStorage wait_token_storage_;
+};
+
+template <typename T>
+ShardedCachingComponentBase<T>::ShardedCachingComponentBase(
+    const ComponentConfig& config, const ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      cache::CacheUpdateTrait(config, context),
+      shards_(config["shards-count"].As<std::size_t>(1)) {}
+
+template <typename T>
+ShardedCachingComponentBase<T>::~ShardedCachingComponentBase() {
+  // Avoid a deadlock in WaitForAllTokens
+  for (auto& shard : shards_) shard.value.Assign(nullptr);
+  // We must wait for destruction of all instances of T to finish, otherwise
+  // it's UB if T's destructor accesses dependent components
+  wait_token_storage_.WaitForAllTokens();
+}
+
+template <typename T>
+utils::SharedReadablePtr<T> ShardedCachingComponentBase<T>::Get(
+    std::size_t shard) const {
+  auto ptr = GetUnsafe(shard);
+  if (!ptr) throw cache::EmptyCacheError(Name());
+  return ptr;
+}
+
+template <typename T>
+utils::SharedReadablePtr<T> ShardedCachingComponentBase<T>::GetUnsafe(
+    std::size_t shard) const {
+  return utils::SharedReadablePtr<T>(GetShard(shard).value.ReadCopy());
+}
+
+template <typename T>
+void ShardedCachingComponentBase<T>::SetShard(
+    std::size_t shard, std::unique_ptr<const T> value_ptr) {
+  auto deleter = [token = wait_token_storage_.GetToken(),
+                  &cache_task_processor =
+                      GetCacheTaskProcessor()](const T* raw_ptr) mutable {
+    std::unique_ptr<const T> ptr{raw_ptr};
+
+    // Kill garbage asynchronously as T::~T() might be very slow
+    engine::CriticalAsyncNoSpan(cache_task_processor, [ptr = std::move(ptr),
+                                                       token = std::move(
+                                                           token)]() mutable {
+      // Make sure *ptr is deleted before token is destroyed
+      ptr.reset();
+    }).Detach();
+  };
+
+  GetShard(shard).value.Assign(
+      std::shared_ptr<const T>(value_ptr.release(), std::move(deleter)));
+}
+
+template <typename T>
+void ShardedCachingComponentBase<T>::SetShard(std::size_t shard, T&& value) {
+  SetShard(shard, std::make_unique<const T>(std::move(value)));
+}
+
+template <typename T>
+void ShardedCachingComponentBase<T>::Update(
+    cache::UpdateType type,
+    const std::chrono::system_clock::time_point& /*last_update*/,
+    const std::chrono::system_clock::time_point& now,
+    cache::UpdateStatisticsScope& stats_scope) {
+  std::vector<engine::TaskWithResult<std::optional<std::size_t>>> tasks;
+  tasks.reserve(shards_.size());
+  for (std::size_t i = 0; i < shards_.size(); ++i) {
+    const auto& shard = shards_[i];
+    const auto shard_type =
+        shard.last_update == std::chrono::system_clock::time_point{}
+            ? cache::UpdateType::kFull
+            : type;
+    tasks.push_back(utils::Async(
+        GetCacheTaskProcessor(), "cache-update-shard",
+        [this, i, shard_type, shard_last_update = shard.last_update, now] {
+          return UpdateShard(i, shard_type, shard_last_update, now);
+        }));
+  }
+
+  std::size_t failed_count = 0;
+  bool has_changes = false;
+  for (std::size_t i = 0; i < tasks.size(); ++i) {
+    auto& shard = shards_[i];
+    try {
+      const auto documents_count = tasks[i].Get();
+      shard.last_update = now;
+      if (documents_count) {
+        shard.documents_count = *documents_count;
+        has_changes = true;
+      }
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "Failed to update shard " << i << " of cache '"
+                    << Name() << "': " << ex;
+      ++failed_count;
+    }
+  }
+
+  if (has_changes) OnCacheModified();
+  if (failed_count) {
+    throw std::runtime_error(fmt::format("{} of {} shards failed to update",
+                                         failed_count, shards_.size()));
+  }
+
+  if (has_changes) {
+    std::size_t total_documents_count = 0;
+    for (const auto& shard : shards_) {
+      total_documents_count += shard.documents_count;
+    }
+    stats_scope.Finish(total_documents_count);
+  } else {
+    stats_scope.FinishNoChanges();
+  }
+}
+
+template <typename T>
+void ShardedCachingComponentBase<T>::OnAllComponentsLoaded() {
+  AssertPeriodicUpdateStarted();
+}
+
+template <typename T>
+void ShardedCachingComponentBase<T>::Cleanup() {
+  for (auto& shard : shards_) shard.value.Cleanup();
+}
+
+template <typename T>
+void ShardedCachingComponentBase<T>::MarkAsExpired() {
+  for (std::size_t i = 0; i < shards_.size(); ++i) {
+    SetShard(i, std::unique_ptr<const T>{});
+    shards_[i].last_update = {};
+  }
+  OnCacheModified();
+}
+
+template <typename T>
+void ShardedCachingComponentBase<T>::GetAndWrite(dump::Writer& writer) const {
+  std::vector<utils::SharedReadablePtr<T>> contents;
+  contents.reserve(shards_.size());
+  for (std::size_t i = 0; i < shards_.size(); ++i) {
+    contents.push_back(GetUnsafe(i));
+    if (!contents.back()) throw cache::EmptyCacheError(Name());
+  }
+  writer.Write(shards_.size());
+  for (const auto& shard : contents) WriteContents(writer, *shard);
+}
+
+template <typename T>
+void ShardedCachingComponentBase<T>::ReadAndSet(dump::Reader& reader) {
+  const auto shards_count = reader.Read<std::size_t>();
+  if (shards_count != shards_.size()) {
+    throw dump::Error(fmt::format(
+        "Dump of cache '{}' contains {} shards, while {} are configured",
+        Name(), shards_count, shards_.size()));
+  }
+  std::vector<std::unique_ptr<const T>> contents;
+  contents.reserve(shards_count);
+  for (std::size_t i = 0; i < shards_count; ++i) {
+    contents.push_back(ReadContents(reader));
+  }
+  for (std::size_t i = 0; i < shards_count; ++i) {
+    SetShard(i, std::move(contents[i]));
+  }
+  OnCacheModified();
+}
+
+template <typename T>
+void ShardedCachingComponentBase<T>::WriteContents(dump::Writer& writer,
+                                                   const T& contents) const {
+  if constexpr (dump::kIsDumpable<T>) {
+    writer.Write(contents);
+  } else {
+    dump::ThrowDumpUnimplemented(Name());
+  }
+}
+
+template <typename T>
+std::unique_ptr<const T> ShardedCachingComponentBase<T>::ReadContents(
+    dump::Reader& reader) const {
+  if constexpr (dump::kIsDumpable<T>) {
+    // To avoid an extra move and avoid including common_containers.hpp
+    return std::unique_ptr<const T>{new T(reader.Read<T>())};
+  } else {
+    dump::ThrowDumpUnimplemented(Name());
+  }
+}
+
+template <typename T>
+typename ShardedCachingComponentBase<T>::Shard&
+ShardedCachingComponentBase<T>::GetShard(std::size_t shard) {
+  UINVARIANT(shard < shards_.size(),
+             fmt::format("Shard {} is out of range for cache '{}'", shard,
+                         Name()));
+  return shards_[shard];
+}
+
+template <typename T>
+const typename ShardedCachingComponentBase<T>::Shard&
+ShardedCachingComponentBase<T>::GetShard(std::size_t shard) const {
+  UINVARIANT(shard < shards_.size(),
+             fmt::format("Shard {} is out of range for cache '{}'", shard,
+                         Name()));
+  return shards_[shard];
+}
+
+namespace impl {
+
+yaml_config::Schema GetShardedCachingComponentBaseSchema();
+
+}
+
+template <typename T>
+yaml_config::Schema ShardedCachingComponentBase<T>::GetStaticConfigSchema() {
+  return impl::GetShardedCachingComponentBaseSchema();
+}
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
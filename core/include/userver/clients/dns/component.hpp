@@ -33,6 +33,8 @@ namespace clients::dns {
 /// cache-size-per-way | size of each way of network cache | 256
 /// cache-max-reply-ttl | TTL limit for network replies caching | 5m
 /// cache-failure-ttl | TTL for network failures caching | 5s
+/// cache-max-failure-ttl | TTL limit for consecutive network failures caching | 1m
+/// cache-update-ratio | fraction of the reply TTL at the end of which the record is updated in background | 0.1
 ///
 /// ## Static configuration example:
 ///
@@ -39,6 +39,14 @@ struct ResolverConfig {
 
   /// Network cache failure TTL
   std::chrono::milliseconds cache_failure_ttl{std::chrono::seconds{5}};
+
+  /// Network cache upper failure TTL limit, the failure TTL is doubled for
+  /// each consecutive failure of a name
+  std::chrono::milliseconds cache_max_failure_ttl{std::chrono::minutes{1}};
+
+  /// Fraction of the reply TTL at the end of which the record is updated
+  /// in background (but not less than the network timeout)
+  double cache_update_ratio{0.1};
 };
 
 }  // namespace clients::dns
@@ -65,7 +65,7 @@ class Resolver {
 
  private:
   class Impl;
-  constexpr static size_t kSize = 1728;
+  constexpr static size_t kSize = 1744;
   constexpr static size_t kAlignment = 16;
   utils::FastPimpl<Impl, kSize, kAlignment> impl_;
 };
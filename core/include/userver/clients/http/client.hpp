@@ -7,11 +7,13 @@
 #error Use clients::Http from clients/http.hpp instead
 #endif
 
+#include <functional>
 #include <memory>
 
 #include <userver/moodycamel/concurrentqueue_fwd.h>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/clients/http/hedging.hpp>
 #include <userver/clients/http/impl/config.hpp>
 #include <userver/clients/http/plugin.hpp>
 #include <userver/clients/http/request.hpp>
@@ -36,6 +38,7 @@ class HeadersPropagator;
 namespace curl {
 class easy;
 class multi;
+class share;
 class ConnectRateLimiter;
 }  // namespace curl
 
@@ -83,6 +86,30 @@ class Client final {
   /// @note This method is thread-safe despite being non-const.
   Request CreateNotSignedRequest() { return CreateRequest(); }
 
+  /// @brief Performs the request returned by `request_factory(0)` and, if
+  /// there is no response within HedgingSettings::timings_percentile of the
+  /// recent timings of its destination, the hedged request returned by
+  /// `request_factory(1)` and so on up to HedgingSettings::max_attempts
+  /// concurrent requests.
+  ///
+  /// Returns the first response without an error, the rest of the requests are
+  /// cancelled. The hedged requests are limited by the budget of the
+  /// destination, see HedgingSettings::max_extra_load_percent, so that they
+  /// do not amplify an overload.
+  ///
+  /// The hedged requests should usually go to another host, e.g. to the next
+  /// replica of the service. Use Request::SetDestinationMetricName to share
+  /// the timings and the budget between the replicas.
+  ///
+  /// If none of the requests succeeds, the last response with a server error
+  /// is returned, even if the later requests failed with an exception.
+  ///
+  /// @throws the exception of the last request if all of the requests fail
+  /// without a response
+  std::shared_ptr<Response> PerformHedged(
+      const HedgingSettings& settings,
+      const std::function<Request(std::size_t attempt)>& request_factory);
+
   /// @cond
   // For internal use only.
   void SetMultiplexingEnabled(bool enabled);
@@ -108,6 +135,10 @@ class Client final {
 
   // For internal use only.
   void SetConfig(const impl::Config&);
+
+  // Starts periodic warmup of the connections to the destinations from
+  // impl::ClientSettings::warmup. For internal use only.
+  void StartWarmup();
   /// @endcond
 
   /// @brief Sets User-Agent headers for all the requests or removes that
@@ -133,9 +164,15 @@ class Client final {
  private:
   void ReinitEasy();
 
+  Request CreateRequestForMulti(size_t multi_index);
+  void SetupRequest(Request& request);
+
+  void Warmup();
+
   InstanceStatistics GetMultiStatistics(size_t n) const;
 
   size_t FindMultiIndex(const curl::multi*) const;
+  size_t ChooseMultiIndex() const;
 
   // Functions for EasyWrapper that must be noexcept, as they are called from
   // the EasyWrapper destructor.
@@ -175,11 +212,17 @@ class Client final {
   rcu::Variable<std::vector<std::string>> allowed_urls_extra_;
 
   std::shared_ptr<curl::ConnectRateLimiter> connect_rate_limiter_;
+  // TLS sessions of all the easy handles, to resume them on reconnects
+  std::shared_ptr<curl::share> ssl_session_share_;
 
   clients::dns::Resolver* resolver_{nullptr};
   utils::NotNull<const tracing::TracingManagerBase*> tracing_manager_;
   const server::http::HeadersPropagator* headers_propagator_{nullptr};
+  const impl::WarmupSettings warmup_settings_;
   impl::PluginPipeline plugin_pipeline_;
+
+  // Must be the last member, uses the other ones
+  utils::PeriodicTask warmup_task_;
 };
 
 }  // namespace clients::http
@@ -48,6 +48,10 @@ namespace components {
 /// dns_resolver | server hostname resolver type (getaddrinfo or async) | 'async'
 /// set-deadline-propagation-header | whether to set http::common::kXYaTaxiClientTimeoutMs request header, see @ref scripts/docs/en/userver/deadline_propagation.md | true
 /// plugins | Plugin names to apply. A plugin component is called "http-client-plugin-" plus the plugin name.
+/// warmup.destinations | URLs to establish the connections to at start and to keep them alive with periodic HEAD requests, see the `sockets.reused` metric for the connections reuse | []
+/// warmup.connections | number of connections to keep warm to each destination on each of the IO threads | 1
+/// warmup.interval | how often to repeat the warmup, the warmup requests also check the health of the idle connections | 10s
+/// warmup.timeout | timeout of a warmup request | 1s
 ///
 /// ## Static configuration example:
 ///
@@ -0,0 +1,34 @@
+#pragma once
+
+/// @file userver/clients/http/hedging.hpp
+/// @brief @copybrief clients::http::HedgingSettings
+
+#include <chrono>
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+/// @brief Settings of the hedged requests, see
+/// clients::http::Client::PerformHedged
+struct HedgingSettings final {
+  /// A hedged request is sent if there is no response within this percentile
+  /// of the recent timings of the destination
+  double timings_percentile{95.0};
+
+  /// Delay before a hedged request while there are too few recent timings of
+  /// the destination
+  std::chrono::milliseconds default_delay{100};
+
+  /// Max extra load of the destination from the hedged requests, in percents
+  /// of the requests performed via clients::http::Client::PerformHedged
+  double max_extra_load_percent{5.0};
+
+  /// Max number of the concurrent requests, including the first one
+  std::size_t max_attempts{2};
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include <userver/dynamic_config/fwd.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -23,12 +24,20 @@ struct DeadlinePropagationConfig {
   bool update_header{true};
 };
 
+struct WarmupSettings {
+  std::vector<std::string> destinations{};
+  size_t connections{1};
+  std::chrono::milliseconds interval{std::chrono::seconds{10}};
+  std::chrono::milliseconds timeout{1000};
+};
+
 // Static config
 struct ClientSettings final {
   std::string thread_name_prefix{};
   size_t io_threads{8};
   bool defer_events{false};
   DeadlinePropagationConfig deadline_propagation{};
+  WarmupSettings warmup{};
   const tracing::TracingManagerBase* tracing_manager{nullptr};
   const server::http::HeadersPropagator* headers_propagator{nullptr};
 };
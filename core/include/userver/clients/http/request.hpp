@@ -158,9 +158,36 @@ class Request final {
   /// data for POST request
   Request& data(std::string data) &;
   Request data(std::string data) &&;
+  /// @brief data for POST request that is shared with the caller instead of
+  /// being copied, e.g. a body received by a proxy handler from
+  /// server::http::HttpRequest::GetSharedRequestBody(). The buffer must not be
+  /// modified while the request is alive.
+  Request& data(std::shared_ptr<const std::string> data) &;
+  Request data(std::shared_ptr<const std::string> data) &&;
+  /// @brief data for POST request, compressed with gzip of the `level` in
+  /// [1, 9] and sent with `Content-Encoding: gzip`.
+  ///
+  /// The server must support compressed request bodies, as userver handlers
+  /// do by default.
+  Request& gzipped_data(std::string_view data, int level = 6) &;
+  Request gzipped_data(std::string_view data, int level = 6) &&;
   /// form for POST request
   Request& form(const Form& form) &;
   Request form(const Form& form) &&;
+  /// @brief Body for POST, PUT or PATCH request that is read from the queue
+  /// while the request is performed; the body ends once all the producers of
+  /// the queue are destroyed.
+  ///
+  /// The body is not buffered as a whole: the producer waits in `Push()`
+  /// while the queue is full and the body is being sent. The body is sent with
+  /// `Transfer-Encoding: chunked` in HTTP/1.1. Retries are disabled, as the
+  /// body can not be sent again, and the request can not be performed again.
+  ///
+  /// @snippet src/clients/http/client_test.cpp  HTTP Client - streamed body
+  Request& data_stream(
+      const std::shared_ptr<concurrent::StringStreamQueue>& queue) &;
+  Request data_stream(
+      const std::shared_ptr<concurrent::StringStreamQueue>& queue) &&;
   /// Headers for request as map
   Request& headers(const Headers& headers) &;
   Request headers(const Headers& headers) &&;
@@ -246,7 +273,9 @@ class Request final {
 
   /// Set unix domain socket as connection endpoint and provide path to it
   /// When enabled, request will connect to the Unix domain socket instead
-  /// of establishing a TCP connection to a host.
+  /// of establishing a TCP connection to a host. A path starting with '@'
+  /// names a socket in the abstract namespace, e.g. '@envoy' for a sidecar
+  /// listening on such socket.
   Request& unix_socket_path(const std::string& path) &;
   Request unix_socket_path(const std::string& path) &&;
 
@@ -294,6 +323,9 @@ class Request final {
       const impl::DeadlinePropagationConfig& deadline_propagation_config) &;
 
   void SetHeadersPropagator(const server::http::HeadersPropagator*) &;
+
+  // Name of the destination for the statistics. For internal use only.
+  const std::string& GetDestinationMetricName() const;
   /// @endcond
 
   /// Disable auto-decoding of received replies.
@@ -28,6 +28,7 @@ namespace impl {
 
 enum class ComponentLifetimeStage;
 class ComponentInfo;
+struct StartupReport;
 
 template <class T>
 constexpr auto NameFromComponentType() -> decltype(std::string_view{T::kName}) {
@@ -184,6 +185,8 @@ class ComponentContext final {
 
   void CancelComponentsLoad();
 
+  impl::StartupReport GetStartupReport() const;
+
   [[noreturn]] void ThrowNonRegisteredComponent(std::string_view name,
                                                 std::string_view type) const;
   [[noreturn]] void ThrowComponentTypeMismatch(
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include <userver/components/component_fwd.hpp>
@@ -7,6 +8,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace dump {
+class ReadScheduler;
+}  // namespace dump
+
 namespace components {
 
 // clang-format off
@@ -21,6 +26,7 @@ namespace components {
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// dump-root | Components store dumps in subdirectories of this directory | -
+/// max-concurrent-reads | Max number of dumps that are read at the same time, the largest dumps are read first; 0 means no limit | 0
 ///
 /// ## Config example:
 ///
@@ -36,12 +42,20 @@ class DumpConfigurator final : public LoggableComponentBase {
   DumpConfigurator(const ComponentConfig& config,
                    const ComponentContext& context);
 
+  ~DumpConfigurator() override;
+
   const std::string& GetDumpRoot() const;
 
+  /// @cond
+  // For internal use only
+  dump::ReadScheduler& GetReadScheduler() const;
+  /// @endcond
+
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
   const std::string dump_root_;
+  const std::unique_ptr<dump::ReadScheduler> read_scheduler_;
 };
 
 template <>
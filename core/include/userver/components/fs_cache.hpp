@@ -24,6 +24,7 @@ namespace components {
 /// dir               | directory to cache files from                        | /var/www
 /// update-period     | Update period (0 - fill the cache only at startup)   | 0
 /// fs-task-processor | task processor to do filesystem operations           | fs-task-processor
+/// mmap-min-size     | files of at least this size in bytes are kept memory mapped instead of being copied into memory, 0 - never map files; the mapped files must not be truncated or rewritten in place, otherwise the process gets SIGBUS | 0
 
 // clang-format on
 
@@ -3,11 +3,15 @@
 /// @file userver/components/manager_controller_component.hpp
 /// @brief @copybrief components::ManagerControllerComponent
 
+#include <chrono>
+#include <optional>
+
 #include <userver/components/component_fwd.hpp>
 #include <userver/components/impl/component_base.hpp>
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/utils/periodic_task.hpp>
 #include <userver/utils/statistics/entry.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +30,7 @@ class Manager;
 /// ## Dynamic config
 /// * @ref USERVER_TASK_PROCESSOR_PROFILER_DEBUG
 /// * @ref USERVER_TASK_PROCESSOR_QOS
+/// * @ref USERVER_JEMALLOC_DECAY
 ///
 /// ## Static options:
 /// Name | Description | Default value
@@ -33,8 +38,15 @@ class Manager;
 /// coro_pool.initial_size | amount of coroutines to preallocate on startup | 1000
 /// coro_pool.max_size | max amount of coroutines to keep preallocated | 4000
 /// coro_pool.stack_size | size of a single coroutine | 256 * 1024
+/// coro_pool.stack_size_classes | additional coroutine stack sizes; a task runs on the smallest one that fits the size requested by its task processor `stack-size` or by engine::StackSize | []
+/// coro_pool.stack_usage_sample_every | measure the stack high-water mark of each N-th coroutine and report the recommended stack size per task kind (the name of the first span of the task) in `engine.coro-pool.stack-usage` metrics, 0 to disable | 0
+/// coro_pool.idle_stacks_release_period | release the memory of the coroutine stacks that stayed idle for the whole period to the OS, 0 to disable | 0
+/// coro_pool.huge_pages | advise the kernel to back the coroutine stacks with transparent huge pages (MADV_HUGEPAGE); only the stacks of at least 2MiB could get them, see `stack_size_classes` | false
 /// event_thread_pool.threads | number of threads to process low level IO system calls (number of ev loops to start in libev) | 2
 /// event_thread_pool.thread_name | set OS thread name to this value | 'event-worker'
+/// event_thread_pool.cpu-affinity | CPUs to pin the ev threads to in the Linux cpulist format, for example '0-7,16-23' | -
+/// event_thread_pool.numa-node | NUMA node to pin the ev threads to, mutually exclusive with cpu-affinity | -
+/// event_thread_pool.io_engine | I/O engine for sockets and pipes: 'libev' or 'io_uring'; falls back to 'libev' if io_uring is not supported by the kernel | 'libev'
 /// components | dictionary of "component name": "options" | -
 /// default_task_processor | name of the default task processor to use in components | -
 /// task_processors.*NAME*.*OPTIONS* | dictionary of task processors to create and their options. See description below | -
@@ -49,6 +61,12 @@ class Manager;
 /// worker_threads | threads count for the task processor | -
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest priority. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
 /// spinning-iterations | tunes the number of spin-wait iterations in case of an empty task queue before threads go to sleep | 10000
+/// io-poll-iterations | number of non-blocking poll(2) calls a task makes on a socket that is not ready while the task queue is empty, before waiting for the socket in the ev thread; saves the cross-thread wakeup on fast replies at the cost of CPU | 0
+/// task-processor-queue | task queue implementation: 'global-task-queue' is a single queue shared by all the workers, 'work-stealing-task-queue' uses a local queue per worker with a LIFO slot for just woken tasks and stealing from siblings | global-task-queue
+/// cpu-affinity | CPUs to pin the task processor threads to in the Linux cpulist format, for example '0-7,16-23' | -
+/// numa-node | NUMA node to pin the task processor threads to, mutually exclusive with cpu-affinity. Statistics of the task processors are also aggregated per NUMA node | -
+/// jemalloc-arena | whether the workers allocate from a jemalloc arena of their own, so that the long-lived data of the task processor does not share pages with the short-lived garbage of the others; the arena usage is reported in `engine.task-processors.jemalloc-arena` metrics | false
+/// stack-size | coroutine stack size of the tasks; the smallest of coro_pool.stack_size and coro_pool.stack_size_classes that fits is used | coro_pool.stack_size
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
@@ -81,6 +99,9 @@ class ManagerControllerComponent final : public impl::ComponentBase {
   const components::Manager& components_manager_;
   utils::statistics::Entry statistics_holder_;
   concurrent::AsyncEventSubscriberScope config_subscription_;
+  utils::PeriodicTask idle_stacks_release_task_;
+  std::optional<std::chrono::milliseconds> jemalloc_dirty_decay_;
+  std::optional<std::chrono::milliseconds> jemalloc_muzzy_decay_;
 };
 
 template <>
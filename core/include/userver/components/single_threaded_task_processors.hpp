@@ -25,10 +25,16 @@ namespace components {
 /// Usefull to process tasks in a single threaded third-party libraries
 /// (for example in Python/JS interpreters).
 ///
+/// Could also serve a thread-per-core setup: with `cpu-affinity` each task
+/// processor is pinned to a CPU of its own and the `shard_task_processors`
+/// option of the components::Server listener runs a listener shard with its
+/// connections on each of them.
+///
 /// ## Static options:
 /// See "Static task_processor options" at
 /// components::ManagerControllerComponent for options description and
-/// sample.
+/// sample. Unlike a task processor, the N-th single threaded task processor
+/// is pinned to the single N-th CPU of `cpu-affinity` or `numa-node`.
 class SingleThreadedTaskProcessors final : public LoggableComponentBase {
  public:
   /// @ingroup userver_component_names
@@ -3,6 +3,9 @@
 /// @file userver/concurrent/async_event_channel.hpp
 /// @brief @copybrief concurrent::AsyncEventChannel
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <string_view>
@@ -16,8 +19,10 @@
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task_with_result.hpp>
+#include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/async.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -27,6 +32,9 @@ namespace impl {
 
 void WaitForTask(std::string_view name, engine::TaskWithResult<void>& task);
 
+void ReportListenerException(std::string_view name,
+                             const std::exception& e) noexcept;
+
 [[noreturn]] void ReportAlreadySubscribed(std::string_view channel_name,
                                           std::string_view listener_name);
 
@@ -76,6 +84,14 @@ class AsyncEventChannel : public AsyncEventSource<Args...> {
   using Function = typename AsyncEventSource<Args...>::Function;
   using OnRemoveCallback = std::function<void(Function&)>;
 
+  /// Time spent by a listener in processing the events
+  struct ListenerStatistics final {
+    std::string name;
+    std::uint64_t events{0};
+    std::chrono::microseconds last_duration{0};
+    std::chrono::microseconds max_duration{0};
+  };
+
   /// @brief The primary constructor
   /// @param name used for diagnostic purposes and is also accessible with Name
   explicit AsyncEventChannel(std::string name)
@@ -140,13 +156,20 @@ class AsyncEventChannel : public AsyncEventSource<Args...> {
     auto data = data_.Lock();
     auto& listeners = data->listeners;
 
+    const auto max_concurrency = max_concurrency_.load();
+    if (max_concurrency != 0 && max_concurrency < listeners.size()) {
+      SendEventBounded(listeners, max_concurrency, args...);
+      return;
+    }
+
     std::vector<engine::TaskWithResult<void>> tasks;
     tasks.reserve(listeners.size());
 
     for (const auto& [_, listener] : listeners) {
-      tasks.push_back(utils::Async(
-          listener.task_name,
-          [&, &callback = listener.callback] { callback(args...); }));
+      tasks.push_back(
+          utils::Async(listener.task_name, [&, &listener = listener] {
+            CallListener(listener, args...);
+          }));
     }
 
     std::size_t i = 0;
@@ -155,6 +178,30 @@ class AsyncEventChannel : public AsyncEventSource<Args...> {
     }
   }
 
+  /// @brief Limits the number of tasks that call the listeners of an event.
+  ///
+  /// By default (0) each listener is called in a separate task. With the limit
+  /// of 1 the listeners are called one by one in the task of SendEvent, which
+  /// suits the channels with many cheap listeners. With the limit of N the
+  /// task of SendEvent and N - 1 additional tasks take the listeners one by
+  /// one, so a slow listener delays only the listeners after it.
+  void SetMaxConcurrency(std::size_t max_concurrency) noexcept {
+    max_concurrency_ = max_concurrency;
+  }
+
+  /// @returns the time spent by each listener in processing the events, to
+  /// find the listeners that slow down the event delivery
+  std::vector<ListenerStatistics> GetListenerStatistics() const {
+    auto data = data_.Lock();
+    std::vector<ListenerStatistics> result;
+    result.reserve(data->listeners.size());
+    for (const auto& [_, listener] : data->listeners) {
+      result.push_back({listener.name, listener.events,
+                        listener.last_duration, listener.max_duration});
+    }
+    return result;
+  }
+
   /// @returns the name of this event channel
   const std::string& Name() const noexcept { return name_; }
 
@@ -163,6 +210,11 @@ class AsyncEventChannel : public AsyncEventSource<Args...> {
     std::string name;
     Function callback;
     std::string task_name;
+
+    // Only modified while SendEvent holds the lock of data_
+    mutable std::uint64_t events{0};
+    mutable std::chrono::microseconds last_duration{0};
+    mutable std::chrono::microseconds max_duration{0};
   };
 
   struct ListenersData final {
@@ -170,6 +222,49 @@ class AsyncEventChannel : public AsyncEventSource<Args...> {
     OnRemoveCallback on_listener_removal;
   };
 
+  using Listeners = decltype(ListenersData::listeners);
+
+  static void CallListener(const Listener& listener, const Args&... args) {
+    const auto start = std::chrono::steady_clock::now();
+    const utils::FastScopeGuard account_duration([&]() noexcept {
+      const auto duration =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start);
+      ++listener.events;
+      listener.last_duration = duration;
+      if (duration > listener.max_duration) listener.max_duration = duration;
+    });
+    listener.callback(args...);
+  }
+
+  void SendEventBounded(const Listeners& listeners, std::size_t max_concurrency,
+                        const Args&... args) const {
+    std::vector<const Listener*> queue;
+    queue.reserve(listeners.size());
+    for (const auto& [_, listener] : listeners) queue.push_back(&listener);
+
+    std::atomic<std::size_t> next{0};
+    const auto worker = [&] {
+      for (auto i = next++; i < queue.size(); i = next++) {
+        const auto& listener = *queue[i];
+        tracing::Span span(listener.task_name);
+        try {
+          CallListener(listener, args...);
+        } catch (const std::exception& e) {
+          impl::ReportListenerException(listener.name, e);
+        }
+      }
+    };
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(max_concurrency - 1);
+    for (std::size_t i = 1; i < max_concurrency; ++i) {
+      tasks.push_back(utils::Async(name_, worker));
+    }
+    worker();
+    for (auto& task : tasks) impl::WaitForTask(name_, task);
+  }
+
   void RemoveListener(FunctionId id, UnsubscribingKind kind) noexcept final {
     engine::TaskCancellationBlocker blocker;
     auto data = data_.Lock();
@@ -210,6 +305,7 @@ class AsyncEventChannel : public AsyncEventSource<Args...> {
   const std::string name_;
   concurrent::Variable<ListenersData> data_;
   mutable engine::Mutex event_mutex_;
+  std::atomic<std::size_t> max_concurrency_{0};
 };
 
 }  // namespace concurrent
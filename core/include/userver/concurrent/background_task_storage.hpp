@@ -149,6 +149,14 @@ class BackgroundTaskStorage final {
                                         std::forward<Args>(args)...));
   }
 
+  /// @brief Launch a short non-blocking function without a coroutine, see
+  /// engine::AsyncStacklessNoSpan. No tracing span is created for it.
+  template <typename... Args>
+  void AsyncDetachStackless(Args&&... args) {
+    core_.Detach(engine::AsyncStacklessNoSpan(task_processor_,
+                                              std::forward<Args>(args)...));
+  }
+
   /// Approximate number of currently active tasks
   std::int64_t ActiveTasksApprox() const noexcept;
 
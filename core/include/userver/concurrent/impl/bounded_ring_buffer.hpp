@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+/// Bounded lock-free ring buffer with a sequence number per slot (the bounded
+/// MPMC queue by D. Vyukov). A batch of elements claims its positions with a
+/// single atomic operation, so the shared counters are touched once per batch.
+///
+/// The ring buffer does not block on its own, the free places and the pushed
+/// elements are accounted by the GenericQueue sides.
+template <typename T>
+class BoundedRingBuffer final {
+ public:
+  static_assert(std::is_nothrow_move_constructible_v<T> &&
+                    std::is_nothrow_move_assignable_v<T>,
+                "A claimed slot must always be filled or emptied");
+
+  /// @param capacity is rounded up to a power of two
+  explicit BoundedRingBuffer(std::size_t capacity);
+
+  BoundedRingBuffer(const BoundedRingBuffer&) = delete;
+  BoundedRingBuffer& operator=(const BoundedRingBuffer&) = delete;
+  ~BoundedRingBuffer();
+
+  std::size_t GetCapacity() const noexcept { return mask_ + 1; }
+
+  /// Moves `count` values starting from `first` into the ring buffer. The
+  /// caller must own `count` free places: spins while the consumers of the
+  /// claimed slots have not finished moving the old values out.
+  template <typename Iterator>
+  void PushBulk(Iterator first, std::size_t count) noexcept;
+
+  /// Moves up to `max_count` ready values into `out`, stops at the first
+  /// value that is not pushed completely yet.
+  /// @returns the number of values moved
+  /// @warning `out` must not throw, e.g. reserve the target container
+  template <typename OutputIterator>
+  std::size_t TryPopBulk(OutputIterator out, std::size_t max_count);
+
+ private:
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  struct alignas(kCacheLineSize) Slot final {
+    // `position` when the slot is free for the producer of `position`,
+    // `position + 1` when the value of `position` is ready
+    std::atomic<std::size_t> sequence{0};
+    alignas(T) std::byte storage[sizeof(T)];
+
+    T& Get() noexcept { return *std::launder(reinterpret_cast<T*>(storage)); }
+  };
+
+  static std::size_t RoundUpCapacity(std::size_t capacity) noexcept;
+
+  Slot& GetSlot(std::size_t position) noexcept {
+    return slots_[position & mask_];
+  }
+
+  const std::size_t mask_;
+  const std::unique_ptr<Slot[]> slots_;
+
+  alignas(kCacheLineSize) std::atomic<std::size_t> push_position_{0};
+  alignas(kCacheLineSize) std::atomic<std::size_t> pop_position_{0};
+};
+
+template <typename T>
+BoundedRingBuffer<T>::BoundedRingBuffer(std::size_t capacity)
+    : mask_(RoundUpCapacity(capacity) - 1),
+      slots_(std::make_unique<Slot[]>(mask_ + 1)) {
+  for (std::size_t i = 0; i <= mask_; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+template <typename T>
+BoundedRingBuffer<T>::~BoundedRingBuffer() {
+  const auto end = push_position_.load();
+  for (auto position = pop_position_.load(); position != end; ++position) {
+    auto& slot = GetSlot(position);
+    if (slot.sequence.load() == position + 1) slot.Get().~T();
+  }
+}
+
+template <typename T>
+std::size_t BoundedRingBuffer<T>::RoundUpCapacity(
+    std::size_t capacity) noexcept {
+  std::size_t result = 1;
+  while (result < capacity) result <<= 1;
+  return result;
+}
+
+template <typename T>
+template <typename Iterator>
+void BoundedRingBuffer<T>::PushBulk(Iterator first,
+                                    std::size_t count) noexcept {
+  if (count == 0) return;
+  UASSERT(count <= GetCapacity());
+
+  // The owned places guarantee that the previous values of the claimed slots
+  // are already claimed by their consumers, so the wait below is short
+  const auto position =
+      push_position_.fetch_add(count, std::memory_order_relaxed);
+
+  for (std::size_t i = 0; i < count; ++i, ++first) {
+    auto& slot = GetSlot(position + i);
+    for (std::size_t spins = 0;
+         slot.sequence.load(std::memory_order_acquire) != position + i;
+         ++spins) {
+      if (spins > 64) std::this_thread::yield();
+    }
+    ::new (static_cast<void*>(slot.storage)) T(std::move(*first));
+    slot.sequence.store(position + i + 1, std::memory_order_release);
+  }
+}
+
+template <typename T>
+template <typename OutputIterator>
+std::size_t BoundedRingBuffer<T>::TryPopBulk(OutputIterator out,
+                                             std::size_t max_count) {
+  auto position = pop_position_.load(std::memory_order_relaxed);
+  std::size_t count = 0;
+  while (true) {
+    count = 0;
+    while (count < max_count &&
+           GetSlot(position + count).sequence.load(
+               std::memory_order_acquire) == position + count + 1) {
+      ++count;
+    }
+    if (count == 0) return 0;
+
+    // Only the consumer that claims the positions could change the sequences
+    // of the ready slots, so they are still ready after a successful CAS
+    if (pop_position_.compare_exchange_weak(position, position + count,
+                                            std::memory_order_relaxed)) {
+      break;
+    }
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& slot = GetSlot(position + i);
+    *out = std::move(slot.Get());
+    ++out;
+    slot.Get().~T();
+    slot.sequence.store(position + i + GetCapacity(),
+                        std::memory_order_release);
+  }
+  return count;
+}
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
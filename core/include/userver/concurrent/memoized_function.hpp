@@ -0,0 +1,88 @@
+#pragma once
+
+/// @file userver/concurrent/memoized_function.hpp
+/// @brief @copybrief concurrent::MemoizedFunction
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+/// Settings of concurrent::MemoizedFunction
+struct MemoizedFunctionSettings final {
+  /// Count of the independently locked shards, more ways mean less contention
+  std::size_t ways{16};
+
+  /// Max count of the memoized results per way
+  std::size_t way_size{64};
+
+  /// Results older than this are computed again, 0 keeps them until evicted
+  std::chrono::milliseconds max_lifetime{0};
+};
+
+/// @brief Keyed memoization of a pure function with multiple users, a keyed
+/// counterpart of concurrent::LazyValue.
+///
+/// Memoizes at most `ways * way_size` results of `f`, evicting the least
+/// recently used ones, in a cache::ExpirableLruCache. Concurrent calls with
+/// the same key are coalesced: `f` is called by one of them, the rest wait
+/// for its result. Results are shared, not copied, so that they stay valid
+/// after the eviction for as long as the caller holds them.
+///
+/// Meant for expensive computations that only depend on the key, e.g.
+/// compilation of regular expressions, templates or schemas.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class MemoizedFunction final {
+ public:
+  using ValuePtr = std::shared_ptr<const Value>;
+
+  explicit MemoizedFunction(std::function<Value(const Key&)> f,
+                            const MemoizedFunctionSettings& settings = {},
+                            const Hash& hash = Hash(),
+                            const Equal& equal = Equal())
+      : f_(std::move(f)),
+        cache_(settings.ways, settings.way_size, hash, equal) {
+    UASSERT(f_);
+    cache_.SetMaxLifetime(settings.max_lifetime);
+  }
+
+  /// @brief Get the memoized result for the key or calculate it.
+  ///        Can be called concurrently from multiple coroutines.
+  /// @throws anything `f` throws; exceptions are not memoized.
+  ValuePtr operator()(const Key& key) {
+    return cache_.Get(key, [this](const Key& missing_key) {
+      return std::make_shared<const Value>(f_(missing_key));
+    });
+  }
+
+  /// Forgets the result for the key, if any
+  void Forget(const Key& key) { cache_.InvalidateByKey(key); }
+
+  /// Forgets all the results
+  void ForgetAll() { cache_.Invalidate(); }
+
+  /// @returns the approximate count of the memoized results
+  std::size_t GetSizeApproximate() const { return cache_.GetSizeApproximate(); }
+
+  /// @returns hit, miss and coalescing statistics of the underlying cache
+  const cache::impl::ExpirableLruCacheStatistics& GetStatistics() const {
+    return cache_.GetStatistics();
+  }
+
+ private:
+  const std::function<Value(const Key&)> f_;
+  cache::ExpirableLruCache<Key, ValuePtr, Hash, Equal> cache_;
+};
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <atomic>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include <moodycamel/concurrentqueue.h>
 
+#include <userver/concurrent/impl/bounded_ring_buffer.hpp>
 #include <userver/concurrent/impl/semaphore_capacity_control.hpp>
 #include <userver/concurrent/queue_helpers.hpp>
 #include <userver/engine/deadline.hpp>
@@ -30,6 +33,7 @@ struct SimpleQueuePolicy {
 
   static constexpr bool kIsMultipleProducer{MultipleProducer};
   static constexpr bool kIsMultipleConsumer{MultipleConsumer};
+  static constexpr bool kIsRingBuffer{false};
 };
 
 template <bool MultipleProducer, bool MultipleConsumer>
@@ -41,6 +45,19 @@ struct ContainerQueuePolicy {
 
   static constexpr bool kIsMultipleProducer{MultipleProducer};
   static constexpr bool kIsMultipleConsumer{MultipleConsumer};
+  static constexpr bool kIsRingBuffer{false};
+};
+
+template <bool MultipleProducer, bool MultipleConsumer>
+struct RingQueuePolicy {
+  template <typename T>
+  static constexpr std::size_t GetElementSize(const T&) {
+    return 1;
+  }
+
+  static constexpr bool kIsMultipleProducer{MultipleProducer};
+  static constexpr bool kIsMultipleConsumer{MultipleConsumer};
+  static constexpr bool kIsRingBuffer{true};
 };
 
 }  // namespace impl
@@ -56,12 +73,26 @@ class GenericQueue final
     explicit EmplaceEnabler() = default;
   };
 
+  static constexpr bool kIsRingBuffer = QueuePolicy::kIsRingBuffer;
+
+  using Storage =
+      std::conditional_t<kIsRingBuffer, impl::BoundedRingBuffer<T>,
+                         moodycamel::ConcurrentQueue<T>>;
+
+  // The ring buffer is not split into sub-queues and needs no tokens
+  using StorageProducerToken =
+      std::conditional_t<kIsRingBuffer, impl::NoToken,
+                         moodycamel::ProducerToken>;
+  using StorageConsumerToken =
+      std::conditional_t<kIsRingBuffer, impl::NoToken,
+                         moodycamel::ConsumerToken>;
+
   using ProducerToken =
       std::conditional_t<QueuePolicy::kIsMultipleProducer,
-                         moodycamel::ProducerToken, impl::NoToken>;
+                         StorageProducerToken, impl::NoToken>;
   using ConsumerToken =
       std::conditional_t<QueuePolicy::kIsMultipleProducer,
-                         moodycamel::ConsumerToken, impl::NoToken>;
+                         StorageConsumerToken, impl::NoToken>;
   using MultiProducerToken = impl::MultiToken;
   using MultiConsumerToken =
       std::conditional_t<QueuePolicy::kIsMultipleProducer, impl::MultiToken,
@@ -69,7 +100,7 @@ class GenericQueue final
 
   using SingleProducerToken =
       std::conditional_t<!QueuePolicy::kIsMultipleProducer,
-                         moodycamel::ProducerToken, impl::NoToken>;
+                         StorageProducerToken, impl::NoToken>;
 
   friend class Producer<GenericQueue, ProducerToken, EmplaceEnabler>;
   friend class Producer<GenericQueue, MultiProducerToken, EmplaceEnabler>;
@@ -94,7 +125,7 @@ class GenericQueue final
   /// @cond
   // For internal use only
   explicit GenericQueue(std::size_t max_size, EmplaceEnabler /*unused*/)
-      : queue_(),
+      : queue_(MakeStorage(max_size)),
         single_producer_token_(queue_),
         producer_side_(*this, std::min(max_size, kUnbounded)),
         consumer_side_(*this) {}
@@ -122,6 +153,7 @@ class GenericQueue final
   /// @endcond
 
   /// Create a new queue
+  /// @note concurrent::BoundedMpmcQueue requires a bounded `max_size`
   static std::shared_ptr<GenericQueue> Create(
       std::size_t max_size = kUnbounded) {
     return std::make_shared<GenericQueue>(max_size, EmplaceEnabler{});
@@ -183,7 +215,12 @@ class GenericQueue final
 
   /// @brief Sets the limit on the queue size, pushes over this limit will block
   /// @note This is a soft limit and may be slightly overrun under load.
+  /// @note The limit of concurrent::BoundedMpmcQueue could not exceed its
+  /// initial `max_size` rounded up to a power of two
   void SetSoftMaxSize(std::size_t max_size) {
+    if constexpr (kIsRingBuffer) {
+      max_size = std::min(max_size, queue_.GetCapacity());
+    }
     producer_side_.SetSoftMaxSize(std::min(max_size, kUnbounded));
   }
 
@@ -223,6 +260,13 @@ class GenericQueue final
     return producer_side_.PushNoblock(token, std::move(value));
   }
 
+  template <typename Token>
+  [[nodiscard]] bool PushBatch(Token& token, std::vector<T>&& values,
+                               engine::Deadline deadline) {
+    if (values.empty()) return true;
+    return producer_side_.PushBatch(token, values, deadline);
+  }
+
   template <typename Token>
   [[nodiscard]] bool Pop(Token& token, T& value, engine::Deadline deadline) {
     return consumer_side_.Pop(token, value, deadline);
@@ -233,6 +277,32 @@ class GenericQueue final
     return consumer_side_.PopNoblock(token, value);
   }
 
+  template <typename Token>
+  [[nodiscard]] std::size_t PopBatch(Token& token, std::vector<T>& values,
+                                     std::size_t max_count,
+                                     engine::Deadline deadline) {
+    if (max_count == 0) return 0;
+    return consumer_side_.PopBatch(token, values, max_count, deadline);
+  }
+
+  static Storage MakeStorage(std::size_t max_size) {
+    if constexpr (kIsRingBuffer) {
+      UINVARIANT(max_size < kUnbounded,
+                 "A ring buffer queue must be created with a bounded size");
+      return Storage(max_size);
+    } else {
+      return Storage();
+    }
+  }
+
+  static std::size_t GetBatchSize(const std::vector<T>& values) {
+    std::size_t batch_size = 0;
+    for (const auto& value : values) {
+      batch_size += QueuePolicy::GetElementSize(value);
+    }
+    return batch_size;
+  }
+
   void PrepareProducer() {
     std::size_t old_producers_count{};
     utils::AtomicUpdate(producers_count_, [&](auto old_value) {
@@ -289,7 +359,9 @@ class GenericQueue final
  private:
   template <typename Token>
   void DoPush(Token& token, T&& value) {
-    if constexpr (std::is_same_v<Token, moodycamel::ProducerToken>) {
+    if constexpr (kIsRingBuffer) {
+      queue_.PushBulk(&value, 1);
+    } else if constexpr (std::is_same_v<Token, moodycamel::ProducerToken>) {
       static_assert(QueuePolicy::kIsMultipleProducer);
       queue_.enqueue(token, std::move(value));
     } else if constexpr (std::is_same_v<Token, MultiProducerToken>) {
@@ -308,7 +380,9 @@ class GenericQueue final
   [[nodiscard]] bool DoPop(Token& token, T& value) {
     bool success{};
 
-    if constexpr (std::is_same_v<Token, moodycamel::ConsumerToken>) {
+    if constexpr (kIsRingBuffer) {
+      success = queue_.TryPopBulk(&value, 1) != 0;
+    } else if constexpr (std::is_same_v<Token, moodycamel::ConsumerToken>) {
       static_assert(QueuePolicy::kIsMultipleProducer);
       success = queue_.try_dequeue(token, value);
     } else if constexpr (std::is_same_v<Token, impl::MultiToken>) {
@@ -328,7 +402,62 @@ class GenericQueue final
     return false;
   }
 
-  moodycamel::ConcurrentQueue<T> queue_{1};
+  template <typename Token>
+  void DoPushBatch(Token& token, std::vector<T>& values) {
+    const auto first = std::make_move_iterator(values.begin());
+    const auto count = values.size();
+    if constexpr (kIsRingBuffer) {
+      queue_.PushBulk(first, count);
+    } else if constexpr (std::is_same_v<Token, moodycamel::ProducerToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      queue_.enqueue_bulk(token, first, count);
+    } else if constexpr (std::is_same_v<Token, MultiProducerToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      queue_.enqueue_bulk(first, count);
+    } else {
+      static_assert(std::is_same_v<Token, impl::NoToken>);
+      static_assert(!QueuePolicy::kIsMultipleProducer);
+      queue_.enqueue_bulk(single_producer_token_, first, count);
+    }
+
+    values.clear();
+    consumer_side_.OnElementsPushed(count);
+  }
+
+  template <typename Token>
+  [[nodiscard]] std::size_t DoPopBatch(Token& token, std::vector<T>& values,
+                                       std::size_t max_count) {
+    const auto old_size = values.size();
+    values.reserve(old_size + max_count);
+    const auto out = std::back_inserter(values);
+    std::size_t count{};
+
+    if constexpr (kIsRingBuffer) {
+      count = queue_.TryPopBulk(out, max_count);
+    } else if constexpr (std::is_same_v<Token, moodycamel::ConsumerToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      count = queue_.try_dequeue_bulk(token, out, max_count);
+    } else if constexpr (std::is_same_v<Token, impl::MultiToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      count = queue_.try_dequeue_bulk(out, max_count);
+    } else {
+      static_assert(std::is_same_v<Token, impl::NoToken>);
+      static_assert(!QueuePolicy::kIsMultipleProducer);
+      count = queue_.try_dequeue_bulk_from_producer(single_producer_token_,
+                                                    out, max_count);
+    }
+
+    if (count != 0) {
+      std::size_t released_capacity = 0;
+      for (auto i = old_size; i < values.size(); ++i) {
+        released_capacity += QueuePolicy::GetElementSize(values[i]);
+      }
+      producer_side_.OnElementPopped(released_capacity);
+    }
+    return count;
+  }
+
+  Storage queue_;
   std::atomic<std::size_t> consumers_count_{0};
   std::atomic<std::size_t> producers_count_{0};
 
@@ -368,6 +497,19 @@ class GenericQueue<T, QueuePolicy>::SingleProducerSide final {
     return DoPush(token, std::move(value));
   }
 
+  template <typename Token>
+  [[nodiscard]] bool PushBatch(Token& token, std::vector<T>& values,
+                               engine::Deadline deadline) {
+    const std::size_t batch_size = GetBatchSize(values);
+    while (!DoPushBatch(token, values, batch_size)) {
+      if (queue_.NoMoreConsumers() || batch_size > total_capacity_.load() ||
+          !non_full_event_.WaitForEventUntil(deadline)) {
+        return DoPushBatch(token, values, batch_size);
+      }
+    }
+    return true;
+  }
+
   void OnElementPopped(std::size_t released_capacity) {
     used_capacity_.fetch_sub(released_capacity);
     non_full_event_.Send();
@@ -406,6 +548,20 @@ class GenericQueue<T, QueuePolicy>::SingleProducerSide final {
     return true;
   }
 
+  template <typename Token>
+  [[nodiscard]] bool DoPushBatch(Token& token, std::vector<T>& values,
+                                 std::size_t batch_size) {
+    if (queue_.NoMoreConsumers() ||
+        used_capacity_.load() + batch_size > total_capacity_.load()) {
+      return false;
+    }
+
+    used_capacity_.fetch_add(batch_size);
+    queue_.DoPushBatch(token, values);
+    non_full_event_.Reset();
+    return true;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent non_full_event_;
   std::atomic<std::size_t> used_capacity_;
@@ -438,6 +594,16 @@ class GenericQueue<T, QueuePolicy>::MultiProducerSide final {
            DoPush(token, std::move(value));
   }
 
+  // A single semaphore operation for the whole batch
+  template <typename Token>
+  [[nodiscard]] bool PushBatch(Token& token, std::vector<T>& values,
+                               engine::Deadline deadline) {
+    const std::size_t batch_size = GetBatchSize(values);
+    return remaining_capacity_.try_lock_shared_until_count(deadline,
+                                                           batch_size) &&
+           DoPushBatch(token, values, batch_size);
+  }
+
   void OnElementPopped(std::size_t value_size) {
     remaining_capacity_.unlock_shared_count(value_size);
   }
@@ -476,6 +642,18 @@ class GenericQueue<T, QueuePolicy>::MultiProducerSide final {
     return true;
   }
 
+  template <typename Token>
+  [[nodiscard]] bool DoPushBatch(Token& token, std::vector<T>& values,
+                                 std::size_t batch_size) {
+    if (queue_.NoMoreConsumers()) {
+      remaining_capacity_.unlock_shared_count(batch_size);
+      return false;
+    }
+
+    queue_.DoPushBatch(token, values);
+    return true;
+  }
+
   GenericQueue& queue_;
   engine::CancellableSemaphore remaining_capacity_;
   concurrent::impl::SemaphoreCapacityControl remaining_capacity_control_;
@@ -508,11 +686,31 @@ class GenericQueue<T, QueuePolicy>::SingleConsumerSide final {
     return DoPop(token, value);
   }
 
+  template <typename Token>
+  [[nodiscard]] std::size_t PopBatch(Token& token, std::vector<T>& values,
+                                     std::size_t max_count,
+                                     engine::Deadline deadline) {
+    std::size_t count{};
+    while ((count = DoPopBatch(token, values, max_count)) == 0) {
+      if (queue_.NoMoreProducers() ||
+          !nonempty_event_.WaitForEventUntil(deadline)) {
+        // See the comment in Pop
+        return DoPopBatch(token, values, max_count);
+      }
+    }
+    return count;
+  }
+
   void OnElementPushed() {
     ++element_count_;
     nonempty_event_.Send();
   }
 
+  void OnElementsPushed(std::size_t count) {
+    element_count_ += count;
+    nonempty_event_.Send();
+  }
+
   void StopBlockingOnPop() { nonempty_event_.Send(); }
 
   void ResumeBlockingOnPop() {}
@@ -530,6 +728,17 @@ class GenericQueue<T, QueuePolicy>::SingleConsumerSide final {
     return false;
   }
 
+  template <typename Token>
+  [[nodiscard]] std::size_t DoPopBatch(Token& token, std::vector<T>& values,
+                                       std::size_t max_count) {
+    const auto count = queue_.DoPopBatch(token, values, max_count);
+    if (count != 0) {
+      element_count_ -= count;
+      nonempty_event_.Reset();
+    }
+    return count;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent nonempty_event_;
   std::atomic<std::size_t> element_count_;
@@ -561,8 +770,22 @@ class GenericQueue<T, QueuePolicy>::MultiConsumerSide final {
     return element_count_.try_lock_shared() && DoPop(token, value);
   }
 
+  // Waits only for the first element, the rest of the batch is taken from
+  // the elements that are already there
+  template <typename Token>
+  [[nodiscard]] std::size_t PopBatch(Token& token, std::vector<T>& values,
+                                     std::size_t max_count,
+                                     engine::Deadline deadline) {
+    if (!element_count_.try_lock_shared_until(deadline)) return 0;
+    return DoPopBatch(token, values, 1 + TryLockMore(max_count - 1));
+  }
+
   void OnElementPushed() { element_count_.unlock_shared(); }
 
+  void OnElementsPushed(std::size_t count) {
+    element_count_.unlock_shared_count(count);
+  }
+
   void StopBlockingOnPop() {
     element_count_control_.SetCapacityOverride(kUnbounded +
                                                kSemaphoreUnlockValue);
@@ -598,6 +821,28 @@ class GenericQueue<T, QueuePolicy>::MultiConsumerSide final {
     }
   }
 
+  std::size_t TryLockMore(std::size_t max_count) {
+    auto count = std::min(max_count, element_count_.RemainingApprox());
+    while (count != 0 && !element_count_.try_lock_shared_count(count)) {
+      count /= 2;
+    }
+    return count;
+  }
+
+  template <typename Token>
+  [[nodiscard]] std::size_t DoPopBatch(Token& token, std::vector<T>& values,
+                                       std::size_t count) {
+    std::size_t popped = 0;
+    while (true) {
+      popped += queue_.DoPopBatch(token, values, count - popped);
+      if (popped == count) return popped;
+      if (queue_.NoMoreProducers()) {
+        element_count_.unlock_shared_count(count - popped);
+        return popped;
+      }
+    }
+  }
+
   GenericQueue& queue_;
   engine::CancellableSemaphore element_count_;
   concurrent::impl::SemaphoreCapacityControl element_count_control_;
@@ -645,6 +890,23 @@ using SpmcQueue = GenericQueue<T, impl::SimpleQueuePolicy<false, true>>;
 template <typename T>
 using SpscQueue = GenericQueue<T, impl::SimpleQueuePolicy<false, false>>;
 
+/// @ingroup userver_concurrency
+///
+/// @brief Bounded FIFO multiple producers multiple consumers queue on top of a
+/// ring buffer.
+///
+/// Unlike the NonFifo queues it keeps a single order for all the producers and
+/// preallocates all its memory: a cache line per element of `max_size`
+/// rounded up to a power of two, so `max_size` of Create() is required. Only
+/// nothrow-movable types are supported.
+///
+/// Producers and consumers that move data with PushBatch() and PopBatch()
+/// synchronize once per batch.
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename T>
+using BoundedMpmcQueue = GenericQueue<T, impl::RingQueuePolicy<true, true>>;
+
 /// @ingroup userver_concurrency
 ///
 /// @brief Single producer single consumer queue of std::string which is bounded
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 #include <userver/engine/deadline.hpp>
 
@@ -63,6 +65,18 @@ class Producer final {
     return queue_->PushNoblock(token_, std::move(value));
   }
 
+  /// Push all the `values` into queue at once. May wait asynchronously until
+  /// there is enough space for the whole batch. Clears the `values` on success
+  /// and leaves them unmodified if the operation does not succeed.
+  /// @returns whether push succeeded before the deadline and before the task
+  /// was canceled. Always fails if the batch does not fit into the max size of
+  /// the queue.
+  [[nodiscard]] bool PushBatch(std::vector<ValueType>&& values,
+                               engine::Deadline deadline = {}) const {
+    UASSERT(queue_);
+    return queue_->PushBatch(token_, std::move(values), deadline);
+  }
+
   void Reset() && {
     if (queue_) queue_->MarkProducerIsDead();
     queue_.reset();
@@ -124,6 +138,17 @@ class Consumer final {
     return queue_->PopNoblock(token_, value);
   }
 
+  /// Pop up to `max_count` elements from queue and append them to `values`.
+  /// May wait asynchronously if the queue is empty, but the producer is alive.
+  /// Does not wait for the whole batch once some elements are available.
+  /// @returns the number of popped elements, 0 if nothing was popped before
+  /// the deadline or when the producer is no longer alive.
+  [[nodiscard]] std::size_t PopBatch(std::vector<ValueType>& values,
+                                     std::size_t max_count,
+                                     engine::Deadline deadline = {}) const {
+    return queue_->PopBatch(token_, values, max_count, deadline);
+  }
+
   /// Const access to source queue.
   [[nodiscard]] std::shared_ptr<const QueueType> Queue() const {
     return {queue_};
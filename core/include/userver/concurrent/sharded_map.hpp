@@ -0,0 +1,292 @@
+#pragma once
+
+/// @file userver/concurrent/sharded_map.hpp
+/// @brief @copybrief concurrent::ShardedMap
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Concurrent map of `std::shared_ptr<Value>` split into shards, each
+/// one protected by its own rcu::Variable.
+///
+/// Reads do not take any locks. A modification copies only the keyset of
+/// a single shard and blocks only the writers of the same shard, so unlike
+/// rcu::RcuMap the map could be large and changed often. Writers wait for each
+/// other with engine::Mutex, so the map should be used from coroutines.
+///
+/// Choose the shards count so that a shard stays at most a few thousands of
+/// keys, copying of a shard is the price of a modification.
+///
+/// @note No synchronization is provided for value access, it must be
+/// implemented by Value when necessary.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/sharded_map_test.cpp  Sample concurrent::ShardedMap
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class ShardedMap final {
+ public:
+  static_assert(!std::is_reference_v<Key>);
+  static_assert(!std::is_reference_v<Value>);
+  static_assert(!std::is_const_v<Key>);
+
+  using ValuePtr = std::shared_ptr<Value>;
+  using ConstValuePtr = std::shared_ptr<const Value>;
+  using Snapshot = std::unordered_map<Key, ConstValuePtr, Hash, KeyEqual>;
+
+  struct InsertReturnType {
+    ValuePtr value;
+    bool inserted;
+  };
+
+  static constexpr std::size_t kDefaultShardsCount = 256;
+
+  /// @param shards_count is rounded up to a power of two
+  explicit ShardedMap(std::size_t shards_count = kDefaultShardsCount,
+                      const Hash& hash = Hash{});
+
+  ShardedMap(const ShardedMap&) = delete;
+  ShardedMap(ShardedMap&&) = delete;
+  ShardedMap& operator=(const ShardedMap&) = delete;
+  ShardedMap& operator=(ShardedMap&&) = delete;
+
+  /// Returns an estimated size of the map, shards are counted at different
+  /// points in time
+  std::size_t SizeApprox() const;
+
+  std::size_t GetShardsCount() const noexcept { return shards_.size(); }
+
+  /// @brief Returns a readonly value pointer by its key or an empty pointer
+  ConstValuePtr Get(const Key& key) const;
+
+  /// @brief Returns a modifiable value pointer by key or an empty pointer
+  ValuePtr Get(const Key& key);
+
+  /// @brief Inserts a new element if there is no element with the key.
+  /// Returns a pointer to the inserted or the already existing element and
+  /// whether the insertion took place.
+  InsertReturnType Insert(const Key& key, ValuePtr value);
+
+  /// @brief Inserts a new element constructed from `args` if there is no
+  /// element with the key. The value is not constructed if the key exists.
+  template <typename... Args>
+  InsertReturnType TryEmplace(const Key& key, Args&&... args);
+
+  /// @brief Replaces the value of the key or inserts a new element
+  void InsertOrAssign(const Key& key, ValuePtr value);
+
+  /// @brief Removes a key from the map
+  /// @returns whether the key was present
+  bool Erase(const Key& key);
+
+  /// @brief Removes a key from the map returning its value
+  /// @returns a value if the key was present, empty pointer otherwise
+  ValuePtr Pop(const Key& key);
+
+  /// Resets the map to an empty state, shard by shard
+  void Clear();
+
+  /// @brief Calls `func(const Key&, const ConstValuePtr&)` for each element.
+  /// @details Each shard is visited in a snapshot taken at the start of its
+  /// iteration, changes to other shards during the visit may or may not be
+  /// seen. No locks are held while `func` is called.
+  template <typename Func>
+  void VisitAll(Func&& func) const;
+
+  /// @brief Returns a readonly copy of the map, consistent per shard
+  Snapshot GetSnapshot() const;
+
+ private:
+  using RawMap = std::unordered_map<Key, ValuePtr, Hash, KeyEqual>;
+  using RcuTraits = rcu::EpochRcuTraits<RawMap>;
+
+  struct Shard final {
+    rcu::Variable<RawMap, RcuTraits> map;
+    // only changed with the writer lock of `map`
+    std::atomic<std::size_t> size{0};
+  };
+
+  static std::size_t RoundUpShardsCount(std::size_t shards_count) noexcept;
+
+  Shard& GetShard(const Key& key);
+  const Shard& GetShard(const Key& key) const;
+
+  template <typename Factory>
+  InsertReturnType DoInsert(const Key& key, Factory&& factory);
+
+  Hash hash_;
+  std::size_t shard_bits_;
+  utils::FixedArray<Shard> shards_;
+};
+
+template <typename K, typename V, typename H, typename E>
+ShardedMap<K, V, H, E>::ShardedMap(std::size_t shards_count, const H& hash)
+    : hash_(hash),
+      shard_bits_(0),
+      shards_(RoundUpShardsCount(shards_count)) {
+  while ((std::size_t{1} << shard_bits_) < shards_.size()) ++shard_bits_;
+}
+
+template <typename K, typename V, typename H, typename E>
+std::size_t ShardedMap<K, V, H, E>::RoundUpShardsCount(
+    std::size_t shards_count) noexcept {
+  std::size_t result = 1;
+  while (result < shards_count) result <<= 1;
+  return result;
+}
+
+template <typename K, typename V, typename H, typename E>
+auto ShardedMap<K, V, H, E>::GetShard(const K& key) -> Shard& {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  return const_cast<Shard&>(std::as_const(*this).GetShard(key));
+}
+
+template <typename K, typename V, typename H, typename E>
+auto ShardedMap<K, V, H, E>::GetShard(const K& key) const -> const Shard& {
+  if (shard_bits_ == 0) return shards_[0];
+
+  // The high bits of the mixed hash, the low bits of the hash are used by
+  // the buckets of the shard
+  constexpr std::uint64_t kGoldenRatio = 0x9E3779B97F4A7C15;
+  const auto mixed = static_cast<std::uint64_t>(hash_(key)) * kGoldenRatio;
+  return shards_[static_cast<std::size_t>(mixed >> (64 - shard_bits_))];
+}
+
+template <typename K, typename V, typename H, typename E>
+std::size_t ShardedMap<K, V, H, E>::SizeApprox() const {
+  std::size_t result = 0;
+  for (const auto& shard : shards_) {
+    result += shard.size.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+template <typename K, typename V, typename H, typename E>
+auto ShardedMap<K, V, H, E>::Get(const K& key) const -> ConstValuePtr {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  return const_cast<ShardedMap*>(this)->Get(key);
+}
+
+template <typename K, typename V, typename H, typename E>
+auto ShardedMap<K, V, H, E>::Get(const K& key) -> ValuePtr {
+  const auto snapshot = GetShard(key).map.Read();
+  const auto it = snapshot->find(key);
+  if (it == snapshot->end()) return {};
+  return it->second;
+}
+
+template <typename K, typename V, typename H, typename E>
+auto ShardedMap<K, V, H, E>::Insert(const K& key, ValuePtr value)
+    -> InsertReturnType {
+  return DoInsert(key, [&value] { return std::move(value); });
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename... Args>
+auto ShardedMap<K, V, H, E>::TryEmplace(const K& key, Args&&... args)
+    -> InsertReturnType {
+  return DoInsert(key, [&] {
+    return std::make_shared<V>(std::forward<Args>(args)...);
+  });
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename Factory>
+auto ShardedMap<K, V, H, E>::DoInsert(const K& key, Factory&& factory)
+    -> InsertReturnType {
+  InsertReturnType result{Get(key), false};
+  if (result.value) return result;
+
+  auto& shard = GetShard(key);
+  auto txn = shard.map.StartWrite();
+  auto [it, inserted] = txn->try_emplace(key, nullptr);
+  if (!inserted) return {it->second, false};
+
+  it->second = factory();
+  result = {it->second, true};
+  shard.size.store(txn->size(), std::memory_order_relaxed);
+  txn.Commit();
+  return result;
+}
+
+template <typename K, typename V, typename H, typename E>
+void ShardedMap<K, V, H, E>::InsertOrAssign(const K& key, ValuePtr value) {
+  auto& shard = GetShard(key);
+  auto txn = shard.map.StartWrite();
+  txn->insert_or_assign(key, std::move(value));
+  shard.size.store(txn->size(), std::memory_order_relaxed);
+  txn.Commit();
+}
+
+template <typename K, typename V, typename H, typename E>
+bool ShardedMap<K, V, H, E>::Erase(const K& key) {
+  return Pop(key) != nullptr;
+}
+
+template <typename K, typename V, typename H, typename E>
+auto ShardedMap<K, V, H, E>::Pop(const K& key) -> ValuePtr {
+  if (!Get(key)) return {};
+
+  auto& shard = GetShard(key);
+  auto txn = shard.map.StartWrite();
+  const auto it = txn->find(key);
+  if (it == txn->end()) return {};
+
+  auto value = std::move(it->second);
+  txn->erase(it);
+  shard.size.store(txn->size(), std::memory_order_relaxed);
+  txn.Commit();
+  return value;
+}
+
+template <typename K, typename V, typename H, typename E>
+void ShardedMap<K, V, H, E>::Clear() {
+  for (auto& shard : shards_) {
+    auto txn = shard.map.StartWriteEmplace();
+    shard.size.store(0, std::memory_order_relaxed);
+    txn.Commit();
+  }
+}
+
+template <typename K, typename V, typename H, typename E>
+template <typename Func>
+void ShardedMap<K, V, H, E>::VisitAll(Func&& func) const {
+  for (const auto& shard : shards_) {
+    const auto snapshot = shard.map.Read();
+    for (const auto& [key, value] : *snapshot) {
+      const ConstValuePtr const_value = value;
+      func(key, const_value);
+    }
+  }
+}
+
+template <typename K, typename V, typename H, typename E>
+auto ShardedMap<K, V, H, E>::GetSnapshot() const -> Snapshot {
+  Snapshot result(SizeApprox());
+  VisitAll([&result](const K& key, const ConstValuePtr& value) {
+    result.emplace(key, value);
+  });
+  return result;
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,174 @@
+#pragma once
+
+/// @file userver/concurrent/task_group.hpp
+/// @brief @copybrief concurrent::TaskGroup
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+namespace impl {
+
+class TaskGroupItemBase {
+ public:
+  virtual ~TaskGroupItemBase() = default;
+  virtual void Run() = 0;
+};
+
+template <typename Function>
+class TaskGroupItem final : public TaskGroupItemBase {
+ public:
+  explicit TaskGroupItem(Function func) : func_(std::move(func)) {}
+
+  void Run() override { func_(); }
+
+ private:
+  Function func_;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency
+///
+/// @brief Runs many work items with a bounded number of coroutines, the first
+/// failed item cancels the rest of the group.
+///
+/// Up to `max_parallelism` worker tasks are started on demand, each one runs
+/// the spawned items one after another until the group is waited for. So
+/// thousands of small items cost a few tasks and a few tracing spans: a worker
+/// task is started by utils::Async with the name of the group, the items run
+/// within the span of their worker.
+///
+/// When an item throws, the group remembers the exception, drops the items
+/// that have not started yet and requests cancellation of the running ones.
+/// The exception is rethrown from Wait().
+///
+/// Spawn() and Wait() must be called from the coroutine that owns the group.
+/// The destructor cancels and waits for the unfinished items.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/task_group_test.cpp  Sample concurrent::TaskGroup
+///
+/// @see concurrent::ParallelFor
+class TaskGroup final {
+ public:
+  /// Creates a group that starts the workers in the engine::TaskProcessor of
+  /// the current task.
+  /// @param name the name of the worker tasks spans
+  /// @param max_parallelism maximum number of concurrently running items
+  TaskGroup(std::string name, std::size_t max_parallelism);
+
+  /// Creates a group that starts the workers in the specified
+  /// engine::TaskProcessor.
+  TaskGroup(engine::TaskProcessor& task_processor, std::string name,
+            std::size_t max_parallelism);
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+  ~TaskGroup();
+
+  /// @brief Schedules `func()` to run in one of the workers, starts a new
+  /// worker if none of them is idle and the limit is not reached yet.
+  /// @note Does nothing if the group is cancelled
+  template <typename Function>
+  void Spawn(Function&& func);
+
+  /// @brief Waits for all the spawned items.
+  /// @throws std::exception the exception of the first failed item, if any
+  /// @throws engine::WaitInterruptedException on the caller cancellation
+  /// @note New items must not be spawned after this call
+  void Wait();
+
+  /// Drops the items that have not started yet and requests cancellation of
+  /// the running ones. Exceptions of the items are ignored after this call.
+  void Cancel() noexcept;
+
+  /// True if the group was cancelled explicitly or because of a failed item
+  bool IsCancelled() const noexcept {
+    return is_cancelled_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  using ItemPtr = std::unique_ptr<impl::TaskGroupItemBase>;
+  using Queue = NonFifoMpmcQueue<ItemPtr>;
+
+  void DoSpawn(ItemPtr&& item);
+  void StartWorker();
+  void RunItems(Queue::Consumer& consumer) noexcept;
+  void OnItemFailed(std::exception_ptr exception) noexcept;
+  void RequestCancelWorkers() noexcept;
+
+  engine::TaskProcessor& task_processor_;
+  const std::string name_;
+  const std::size_t max_parallelism_;
+
+  std::shared_ptr<Queue> queue_;
+  std::optional<Queue::Producer> producer_;
+  std::atomic<std::size_t> idle_workers_{0};
+  std::atomic<bool> is_cancelled_{false};
+  std::exception_ptr exception_;
+
+  // workers_ are only changed by the owner, tokens_ are also read by workers
+  std::vector<engine::TaskWithResult<void>> workers_;
+  engine::Mutex tokens_mutex_;
+  std::vector<engine::TaskCancellationToken> tokens_;
+};
+
+template <typename Function>
+void TaskGroup::Spawn(Function&& func) {
+  using Item = impl::TaskGroupItem<std::decay_t<Function>>;
+  if (IsCancelled()) return;
+  DoSpawn(std::make_unique<Item>(std::forward<Function>(func)));
+}
+
+/// @ingroup userver_concurrency
+///
+/// @brief Calls `func(index)` for each index in `[0, count)` with at most
+/// `max_parallelism` concurrent calls, rethrows the first exception.
+///
+/// Each worker coroutine claims the next index after finishing the previous
+/// one, so no task is started per index. On the first exception the rest of
+/// the indices are skipped and the running calls are cancelled.
+///
+/// @see concurrent::TaskGroup
+template <typename Function>
+void ParallelFor(std::string name, std::size_t count,
+                 std::size_t max_parallelism, Function&& func) {
+  if (count == 0) return;
+
+  TaskGroup group(std::move(name), max_parallelism);
+  std::atomic<std::size_t> next_index{0};
+  const auto workers_count = std::min(count, max_parallelism);
+  for (std::size_t i = 0; i < workers_count; ++i) {
+    group.Spawn([&group, &next_index, &func, count] {
+      while (!group.IsCancelled()) {
+        const auto index = next_index.fetch_add(1, std::memory_order_relaxed);
+        if (index >= count) break;
+        func(index);
+      }
+    });
+  }
+  group.Wait();
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
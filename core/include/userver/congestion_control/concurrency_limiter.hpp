@@ -0,0 +1,138 @@
+#pragma once
+
+/// @file userver/congestion_control/concurrency_limiter.hpp
+/// @brief @copybrief congestion_control::ConcurrencyLimiter
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control {
+
+/// Thrown by ConcurrencyLimiter::Execute if the limit is reached
+class ConcurrencyLimitExceededError final : public std::runtime_error {
+ public:
+  ConcurrencyLimitExceededError();
+};
+
+struct ConcurrencyLimiterSettings final {
+  std::size_t initial_limit{20};
+  std::size_t min_limit{1};
+  std::size_t max_limit{1000};
+  /// Share of the new estimation applied on each sample
+  double smoothing{0.2};
+  /// How much the RTT may grow over the long term average before the limit
+  /// is reduced
+  double rtt_tolerance{1.5};
+  /// The queue allowed on the dependency side, the limit grows by it
+  std::size_t queue_size{4};
+  /// The number of samples in the long term RTT average
+  std::size_t long_window{600};
+};
+
+ConcurrencyLimiterSettings Parse(
+    const yaml_config::YamlConfig& value,
+    formats::parse::To<ConcurrencyLimiterSettings>);
+
+/// @brief Adaptive limit of the concurrent requests to a dependency.
+///
+/// Implements the gradient algorithm (Netflix gradient2, close to TCP Vegas):
+/// the limit is multiplied by the ratio of the long term average RTT to the
+/// current RTT and grows by `queue_size`. It converges to the concurrency at
+/// which the dependency starts to queue the requests, so a slow dependency
+/// gets fewer requests in flight instead of accumulating them.
+///
+/// Works with any client, the requests are wrapped at the call site:
+/// @code
+/// auto response = limiter.Execute([&] { return request.perform(); });
+/// @endcode
+///
+/// Thread-safe.
+class ConcurrencyLimiter final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief A slot of a request in flight, releases it in the destructor and
+  /// accounts the time since the acquisition as the RTT sample.
+  class Token final {
+   public:
+    Token(Token&& other) noexcept;
+    Token& operator=(Token&&) = delete;
+    ~Token();
+
+    /// The request was dropped or timed out, the limit is reduced
+    void SetDropped() noexcept { is_dropped_ = true; }
+
+    /// The request tells nothing about the dependency latency (e.g. it was
+    /// cancelled early), release the slot without a sample
+    void IgnoreSample() noexcept { is_ignored_ = true; }
+
+   private:
+    friend class ConcurrencyLimiter;
+
+    explicit Token(ConcurrencyLimiter& limiter) noexcept;
+
+    ConcurrencyLimiter* limiter_;
+    Clock::time_point start_;
+    bool is_dropped_{false};
+    bool is_ignored_{false};
+  };
+
+  explicit ConcurrencyLimiter(ConcurrencyLimiterSettings settings = {});
+
+  ConcurrencyLimiter(const ConcurrencyLimiter&) = delete;
+  ConcurrencyLimiter& operator=(const ConcurrencyLimiter&) = delete;
+
+  /// Returns the slot for a request or std::nullopt if the limit is reached
+  std::optional<Token> TryAcquire() noexcept;
+
+  /// @brief Calls `func` in a slot, the exceptions are accounted as the
+  /// samples as well: the timeouts have a long RTT.
+  /// @throws ConcurrencyLimitExceededError if the limit is reached
+  template <typename Func>
+  std::invoke_result_t<Func> Execute(Func&& func) {
+    auto token = TryAcquire();
+    if (!token) throw ConcurrencyLimitExceededError();
+    return std::forward<Func>(func)();
+  }
+
+  std::size_t GetLimit() const noexcept;
+
+  std::size_t GetInFlight() const noexcept;
+
+  /// @cond
+  // For internal use only
+  void OnSample(Clock::duration rtt, std::size_t in_flight, bool is_dropped);
+  /// @endcond
+
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const ConcurrencyLimiter& limiter);
+
+ private:
+  void Release(const Token& token) noexcept;
+
+  const ConcurrencyLimiterSettings settings_;
+  std::atomic<std::size_t> limit_;
+  std::atomic<std::size_t> in_flight_{0};
+  std::atomic<std::uint64_t> rejected_{0};
+
+  std::mutex mutex_;
+  double estimated_limit_;
+  double long_rtt_{0};
+  std::size_t samples_{0};
+};
+
+}  // namespace congestion_control
+
+USERVER_NAMESPACE_END
@@ -45,6 +45,14 @@ struct Config final {
   std::optional<std::chrono::milliseconds> max_dump_age;
   bool max_dump_age_set;
   bool dump_is_encrypted;
+  bool dump_is_compressed;
+  int compression_level;
+  bool dump_is_memory_mapped;
+  // The dumps are written by another process sharing the dump directory
+  bool dump_is_follower;
+  // A full dump is followed by up to `max_deltas` dumps of the changes
+  bool dump_is_differential;
+  uint64_t max_deltas;
 
   bool static_dumps_enabled;
   std::chrono::milliseconds static_min_dump_interval;
@@ -43,6 +43,19 @@ class DumpableEntity {
   virtual void GetAndWrite(dump::Writer& writer) const = 0;
 
   virtual void ReadAndSet(dump::Reader& reader) = 0;
+
+  /// @brief Writes the changes since the previous `GetAndWrite`,
+  /// `GetAndWriteDelta`, `ReadAndSet` or `ReadAndApplyDelta` call
+  /// @note Only called for `differential` dumps. If the call throws, the next
+  /// dump is written with `GetAndWrite`. By default the whole entity is
+  /// written with `GetAndWrite`.
+  virtual void GetAndWriteDelta(dump::Writer& writer) const;
+
+  /// @brief Applies the changes written by `GetAndWriteDelta`
+  /// @note Only called for `differential` dumps. If the call throws, it must
+  /// leave the data unchanged. By default the whole entity is read with
+  /// `ReadAndSet`.
+  virtual void ReadAndApplyDelta(dump::Reader& reader);
 };
 
 enum class UpdateType {
@@ -85,10 +98,31 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `compressed` | `boolean` | Whether to compress the dump with gzip, before the encryption if it is enabled | `false`
+/// `compression-level` | `integer` | gzip compression level of the dump, from 1 (fastest) to 9 (smallest) | `1`
+/// `memory-mapped` | `boolean` | Whether to read the dump from memory mapping, so that the containers from userver/dump/mapped_containers.hpp are used in place without deserialization; can not be combined with `encrypted` and `compressed` | `false`
+/// `follower` | `boolean` | Whether the dumps are written by another process that shares the dump directory; the `Dumper` never writes and only reads the newer dumps, see @ref scripts/docs/en/userver/cache_dumps.md | `false`
+/// `differential` | `boolean` | Whether to write only the changes since the previous dump, see @ref dump_differential "Differential dumps" | `false`
+/// `max-deltas` | `integer` | The number of deltas after which a full dump is written again, for `differential` dumps | `16`
 ///
 /// ## Sample usage
 /// @snippet core/src/dump/dumper_test.cpp  Sample Dumper usage
 ///
+/// @anchor dump_differential
+/// ## Differential dumps
+/// With `differential: true` a full dump is written once, and the following
+/// dumps are deltas written with `DumpableEntity::GetAndWriteDelta`, that only
+/// contain the changes since the previous dump. Each `max-deltas` deltas the
+/// deltas are compacted: a full dump is written again in the background task
+/// and the outdated deltas are removed with the old dump.
+///
+/// On reading, the latest full dump is loaded and then its deltas are applied
+/// in order with `DumpableEntity::ReadAndApplyDelta`. If a delta is broken,
+/// the data stays as of the previous delta and the next dump is a full one.
+///
+/// `max-age` is checked against the time of the full dump, so it should be
+/// greater than `max-deltas` * `min-interval`.
+///
 /// @see components::DumpConfigurator
 // clang-format on
 class Dumper final {
@@ -117,6 +151,12 @@ class Dumper final {
   /// @returns `update_time` of the loaded dump on success, `null` otherwise
   std::optional<TimePoint> ReadDump();
 
+  /// @brief Read data from the latest dump if it is newer than the data that
+  /// was read or written by this `Dumper`, e.g. in the `follower` mode
+  /// @note Catches and logs any exceptions related to read operation failure
+  /// @returns `update_time` of the loaded dump on success, `null` otherwise
+  std::optional<TimePoint> ReadNewerDump();
+
   /// @brief Forces the `Dumper` to write a dump synchronously
   /// @throws std::exception if the `Dumper` failed to write a dump
   void WriteDumpSyncDebug();
@@ -166,7 +206,7 @@ class Dumper final {
          const components::ComponentContext& context, DumpableEntity& dumpable);
 
   class Impl;
-  utils::FastPimpl<Impl, 1056, 16> impl_;
+  utils::FastPimpl<Impl, 1128, 16> impl_;
 };
 
 }  // namespace dump
@@ -0,0 +1,135 @@
+#pragma once
+
+/// @file userver/dump/mapped_containers.hpp
+/// @brief Flat containers that are used in place of a memory-mapped dump
+///
+/// When a dump is read with dump::MappedReader, reading these containers
+/// costs O(1) regardless of their size: the elements are not deserialized,
+/// the containers point into the mapping and keep it alive. With other
+/// readers the data is copied into a single allocation.
+///
+/// @ingroup userver_dump_read_write
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/utils/assert.hpp>
+
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace impl {
+
+/// Size-prefixed bytes along with the owner of their memory
+struct PinnedBytes final {
+  std::string_view bytes;
+  std::shared_ptr<const void> owner;
+};
+
+PinnedBytes MakePinnedBytes(std::string&& bytes);
+
+PinnedBytes ReadPinnedBytes(Reader& reader);
+
+void WritePinnedBytes(Writer& writer, std::string_view bytes);
+
+}  // namespace impl
+
+/// @brief A read-only array of trivially copyable values stored as raw bytes
+/// @note The elements are returned by value, as the mapped data may be
+/// unaligned
+template <typename T>
+class MappedArray final {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MappedArray elements must be trivially copyable");
+
+ public:
+  MappedArray() = default;
+
+  /// Copies the values into a single allocation
+  explicit MappedArray(const std::vector<T>& values)
+      : MappedArray(impl::MakePinnedBytes(
+            std::string(reinterpret_cast<const char*>(values.data()),
+                        values.size() * sizeof(T)))) {}
+
+  std::size_t size() const noexcept { return data_.bytes.size() / sizeof(T); }
+  bool empty() const noexcept { return data_.bytes.empty(); }
+
+  T operator[](std::size_t index) const noexcept {
+    UASSERT(index < size());
+    T result;
+    std::memcpy(&result, data_.bytes.data() + index * sizeof(T), sizeof(T));
+    return result;
+  }
+
+  /// The raw bytes of the elements
+  std::string_view GetBytes() const noexcept { return data_.bytes; }
+
+  /// @cond
+  explicit MappedArray(impl::PinnedBytes&& data) : data_(std::move(data)) {
+    if (data_.bytes.size() % sizeof(T) != 0) {
+      throw Error("Unexpected size of the MappedArray data");
+    }
+  }
+  /// @endcond
+
+ private:
+  impl::PinnedBytes data_;
+};
+
+/// @brief A read-only array of strings stored as offsets and a single blob
+class MappedStringArray final {
+ public:
+  MappedStringArray() = default;
+
+  /// Copies the strings into a single allocation
+  explicit MappedStringArray(const std::vector<std::string>& values);
+
+  std::size_t size() const noexcept { return ends_.size(); }
+  bool empty() const noexcept { return ends_.empty(); }
+
+  std::string_view operator[](std::size_t index) const noexcept {
+    UASSERT(index < size());
+    const auto begin = index == 0 ? 0 : ends_[index - 1];
+    return chars_.bytes.substr(begin, ends_[index] - begin);
+  }
+
+  /// @cond
+  MappedStringArray(MappedArray<std::uint64_t>&& ends,
+                    impl::PinnedBytes&& chars);
+
+  const MappedArray<std::uint64_t>& GetEnds() const noexcept { return ends_; }
+  std::string_view GetChars() const noexcept { return chars_.bytes; }
+  /// @endcond
+
+ private:
+  MappedArray<std::uint64_t> ends_;
+  impl::PinnedBytes chars_;
+};
+
+template <typename T>
+void Write(Writer& writer, const MappedArray<T>& value) {
+  impl::WritePinnedBytes(writer, value.GetBytes());
+}
+
+template <typename T>
+MappedArray<T> Read(Reader& reader, To<MappedArray<T>>) {
+  return MappedArray<T>{impl::ReadPinnedBytes(reader)};
+}
+
+void Write(Writer& writer, const MappedStringArray& value);
+
+MappedStringArray Read(Reader& reader, To<MappedStringArray>);
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// Compresses the data with gzip and writes it to another `Writer`
+class CompressedWriter final : public Writer {
+ public:
+  /// @brief Starts a gzip stream with the `level` in [1, 9]
+  /// @throws `Error` on a compression library error
+  CompressedWriter(std::unique_ptr<Writer> base, int level);
+
+  ~CompressedWriter() override;
+
+  void Finish() override;
+
+ private:
+  void WriteRaw(std::string_view data) override;
+
+  struct Impl;
+  utils::FastPimpl<Impl, 152, 8> impl_;
+};
+
+/// Reads the data from another `Reader` and decompresses it on the fly
+class CompressedReader final : public Reader {
+ public:
+  /// @throws `Error` on a compression library error
+  explicit CompressedReader(std::unique_ptr<Reader> base);
+
+  ~CompressedReader() override;
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  struct Impl;
+  utils::FastPimpl<Impl, 160, 8> impl_;
+};
+
+/// Wraps the Readers and Writers of another factory with gzip compression
+class CompressedOperationsFactory final : public OperationsFactory {
+ public:
+  CompressedOperationsFactory(std::unique_ptr<OperationsFactory> base,
+                              int level);
+
+  std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+  std::unique_ptr<Writer> CreateWriter(std::string full_path,
+                                       tracing::ScopeTime& scope) override;
+
+ private:
+  const std::unique_ptr<OperationsFactory> base_;
+  const int level_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/fs/blocking/mapped_file.hpp>
+
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief A handle to a dump file mapped into memory.
+///
+/// The data is not copied on reads, the returned memory points into the
+/// mapping and is paged in on demand. Containers from
+/// userver/dump/mapped_containers.hpp keep the mapping alive and are used
+/// in place after the dump is read.
+class MappedReader final : public Reader {
+ public:
+  /// @brief Opens an existing dump file and maps it into memory
+  /// @throws `Error` on a filesystem error
+  explicit MappedReader(std::string path);
+
+  void Finish() override;
+
+  /// The memory returned by `ReadRaw` stays valid while the mapping is alive
+  std::shared_ptr<const fs::blocking::MappedFile> GetMapping() const;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  std::string path_;
+  std::shared_ptr<const fs::blocking::MappedFile> file_;
+  std::size_t position_{0};
+};
+
+/// Writes the dumps with `FileWriter` and reads them with `MappedReader`
+class MappedOperationsFactory final : public OperationsFactory {
+ public:
+  explicit MappedOperationsFactory(boost::filesystem::perms perms);
+
+  std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+  std::unique_ptr<Writer> CreateWriter(std::string full_path,
+                                       tracing::ScopeTime& scope) override;
+
+ private:
+  const boost::filesystem::perms perms_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
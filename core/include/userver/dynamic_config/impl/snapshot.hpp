@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <exception>
 #include <functional>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <typeindex>
@@ -56,6 +57,11 @@ class SnapshotData final {
   SnapshotData(const SnapshotData& defaults,
                const std::vector<KeyValue>& overrides);
 
+  /// Parses only the configs whose docs differ from the ones `previous` was
+  /// parsed from, the rest of the parsed configs are shared with `previous`.
+  /// Parses all the configs if `previous` is nullptr or empty.
+  SnapshotData(const DocsMap& docs_map, const SnapshotData* previous);
+
   SnapshotData(SnapshotData&&) noexcept = default;
   SnapshotData& operator=(SnapshotData&&) noexcept = default;
 
@@ -71,9 +77,13 @@ class SnapshotData final {
   bool IsEmpty() const noexcept;
 
  private:
+  struct ParsedConfig;
+
   const std::any& DoGet(ConfigId id) const;
 
-  std::vector<std::any> user_configs_;
+  void Parse(const DocsMap& docs_map, const SnapshotData* previous);
+
+  std::vector<std::shared_ptr<const ParsedConfig>> user_configs_;
 };
 
 class StorageData;
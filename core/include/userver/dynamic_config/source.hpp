@@ -11,6 +11,7 @@
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/meta.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -183,7 +184,9 @@ class Source final {
   /// @note Сallbacks occur only if one of the passed config is changed. This is
   /// true under any components::DynamicConfigClientUpdater options.
   ///
-  /// @warning To use this function, configs must have the `operator==`.
+  /// @note The configs with unchanged docs are shared between the snapshots,
+  /// they are compared by address first. The configs that have no
+  /// `operator==` are considered changed on every update of their docs.
   ///
   /// @param obj the subscriber, which is the owner of the listener method, and
   /// is also used as the unique identifier of the subscription
@@ -223,10 +226,22 @@ class Source final {
     UASSERT(!current.GetData().IsEmpty());
     UASSERT(!previous.GetData().IsEmpty());
 
-    const bool is_equal = (true && ... && (previous[keys] == current[keys]));
+    const bool is_equal =
+        (true && ... && IsEqual(previous[keys], current[keys]));
     return !is_equal;
   }
 
+  template <typename VariableType>
+  static bool IsEqual(const VariableType& previous,
+                      const VariableType& current) {
+    if (&previous == &current) return true;
+    if constexpr (meta::kIsEqualityComparable<VariableType>) {
+      return previous == current;
+    } else {
+      return false;
+    }
+  }
+
   concurrent::AsyncEventSubscriberScope DoUpdateAndListen(
       concurrent::FunctionId id, std::string_view name,
       SnapshotEventSource::Function&& func);
@@ -3,6 +3,7 @@
 #include <optional>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include <userver/formats/json/value.hpp>
 #include <userver/formats/parse/common_containers.hpp>
@@ -40,11 +41,17 @@ class DocsMap final {
 
   const utils::impl::TransparentSet<std::string>& GetConfigsExpectedToBeUsed(
       utils::InternalTag) const;
+
+  // Names passed to 'Get' and 'Has' are appended to 'names' until the
+  // recorder is reset with nullptr
+  void SetUsedNamesRecorder(std::vector<std::string>* names,
+                            utils::InternalTag) const;
   /// @endcond
 
  private:
   utils::impl::TransparentMap<std::string, formats::json::Value> docs_;
   mutable utils::impl::TransparentSet<std::string> configs_to_be_used_;
+  mutable std::vector<std::string>* used_names_{nullptr};
 };
 
 template <typename T>
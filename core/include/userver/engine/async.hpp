@@ -6,6 +6,7 @@
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/impl/task_context_factory.hpp>
 #include <userver/engine/task/shared_task_with_result.hpp>
+#include <userver/engine/task/stack_size.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/utils/impl/wrapped_call.hpp>
@@ -16,18 +17,42 @@ namespace engine {
 
 namespace impl {
 
+template <template <typename> typename TaskType, typename Function,
+          typename... Args>
+[[nodiscard]] auto MakeTaskWithResult(TaskProcessor& task_processor,
+                                      Task::Importance importance,
+                                      Deadline deadline, StackSize stack_size,
+                                      Function&& f, Args&&... args) {
+  using ResultType =
+      typename utils::impl::WrappedCallImplType<Function, Args...>::ResultType;
+  constexpr auto kWaitMode = TaskType<ResultType>::kWaitMode;
+
+  return TaskType<ResultType>{MakeTask(
+      {task_processor, importance, kWaitMode, deadline, stack_size.bytes},
+      std::forward<Function>(f), std::forward<Args>(args)...)};
+}
+
 template <template <typename> typename TaskType, typename Function,
           typename... Args>
 [[nodiscard]] auto MakeTaskWithResult(TaskProcessor& task_processor,
                                       Task::Importance importance,
                                       Deadline deadline, Function&& f,
                                       Args&&... args) {
+  return MakeTaskWithResult<TaskType>(
+      task_processor, importance, deadline, StackSize{0},
+      std::forward<Function>(f), std::forward<Args>(args)...);
+}
+
+template <typename Function, typename... Args>
+[[nodiscard]] auto MakeStacklessTaskWithResult(TaskProcessor& task_processor,
+                                               Function&& f, Args&&... args) {
   using ResultType =
       typename utils::impl::WrappedCallImplType<Function, Args...>::ResultType;
-  constexpr auto kWaitMode = TaskType<ResultType>::kWaitMode;
+  constexpr auto kWaitMode = TaskWithResult<ResultType>::kWaitMode;
 
-  return TaskType<ResultType>{
-      MakeTask({task_processor, importance, kWaitMode, deadline},
+  return TaskWithResult<ResultType>{
+      MakeTask({task_processor, Task::Importance::kNormal, kWaitMode, {}, 0,
+                /*is_stackless=*/true},
                std::forward<Function>(f), std::forward<Args>(args)...)};
 }
 
@@ -51,6 +76,17 @@ template <typename Function, typename... Args>
       std::forward<Args>(args)...);
 }
 
+/// Runs an asynchronous function call on a coroutine with at least
+/// `stack_size` bytes of stack using specified task processor
+template <typename Function, typename... Args>
+[[nodiscard]] auto AsyncNoSpan(TaskProcessor& task_processor,
+                               StackSize stack_size, Function&& f,
+                               Args&&... args) {
+  return impl::MakeTaskWithResult<TaskWithResult>(
+      task_processor, Task::Importance::kNormal, {}, stack_size,
+      std::forward<Function>(f), std::forward<Args>(args)...);
+}
+
 /// Runs an asynchronous function call with deadline using specified task
 /// processor
 template <typename Function, typename... Args>
@@ -106,6 +142,31 @@ template <typename Function, typename... Args>
                            std::forward<Args>(args)...);
 }
 
+/// @brief Runs a short non-blocking function call right on a thread of the
+/// specified task processor, without a coroutine.
+///
+/// The task is queued and could be waited for, cancelled or detached as usual,
+/// but it skips the coroutine acquisition and the context switches, so it is
+/// much cheaper to start. Fits the continuations and fire-and-forget updates.
+///
+/// @warning The function must not suspend: any wait for a synchronization
+/// primitive, engine::Yield or a sleep throws utils::InvariantError.
+template <typename Function, typename... Args>
+[[nodiscard]] auto AsyncStacklessNoSpan(TaskProcessor& task_processor,
+                                        Function&& f, Args&&... args) {
+  return impl::MakeStacklessTaskWithResult(task_processor,
+                                           std::forward<Function>(f),
+                                           std::forward<Args>(args)...);
+}
+
+/// @overload
+template <typename Function, typename... Args>
+[[nodiscard]] auto AsyncStacklessNoSpan(Function&& f, Args&&... args) {
+  return AsyncStacklessNoSpan(current_task::GetTaskProcessor(),
+                              std::forward<Function>(f),
+                              std::forward<Args>(args)...);
+}
+
 /// @brief Runs an asynchronous function call that will start regardless of
 /// cancellations using specified task processor
 /// @see Task::Importance::Critical
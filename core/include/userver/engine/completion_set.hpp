@@ -0,0 +1,145 @@
+#pragma once
+
+/// @file userver/engine/completion_set.hpp
+/// @brief @copybrief engine::CompletionSet
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+
+/// Indices of the completed tasks of a CompletionSet, in completion order
+class CompletionQueue final {
+ public:
+  /// Makes room for `total` completions, so that Push never allocates
+  void Reserve(std::size_t total);
+
+  void Push(std::size_t index) noexcept;
+
+  std::optional<std::size_t> WaitPop(Deadline deadline);
+
+ private:
+  engine::Mutex mutex_;
+  std::vector<std::size_t> completed_;
+  std::size_t head_{0};
+  SingleConsumerEvent event_;
+};
+
+class CompletionNotifier final {
+ public:
+  CompletionNotifier(CompletionQueue& queue, std::size_t index) noexcept
+      : queue_(queue), index_(index) {}
+
+  CompletionNotifier(const CompletionNotifier&) = delete;
+  CompletionNotifier& operator=(const CompletionNotifier&) = delete;
+
+  ~CompletionNotifier() { queue_.Push(index_); }
+
+ private:
+  CompletionQueue& queue_;
+  const std::size_t index_;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency
+///
+/// @brief A set of tasks that reports their completions in completion order.
+///
+/// Each task of the set pushes its index to a queue shared with the consumer
+/// when its payload finishes, so waiting for the next completed task costs
+/// O(1) regardless of the number of the tasks in the set. Prefer it over
+/// engine::WaitAny for draining many tasks one by one, where WaitAny costs
+/// O(N) per completion.
+///
+/// Only one task may wait on a CompletionSet at a time.
+///
+/// @warning A task of the set that is cancelled before it starts is never
+/// reported by WaitNext. Tasks are cancelled and waited for on destruction of
+/// the set.
+template <typename T>
+class CompletionSet final {
+ public:
+  CompletionSet() = default;
+
+  CompletionSet(const CompletionSet&) = delete;
+  CompletionSet& operator=(const CompletionSet&) = delete;
+
+  /// @brief Starts a task in the set, see engine::AsyncNoSpan.
+  /// @returns the index of the task in the set
+  template <typename Function, typename... Args>
+  std::size_t AsyncNoSpan(TaskProcessor& task_processor, Function&& f,
+                          Args&&... args) {
+    const auto index = tasks_.size();
+    queue_.Reserve(index + 1);
+    tasks_.push_back(engine::AsyncNoSpan(
+        task_processor,
+        [&queue = queue_, index](auto&& func, auto&&... func_args) {
+          const impl::CompletionNotifier notifier{queue, index};
+          return std::invoke(std::forward<decltype(func)>(func),
+                             std::forward<decltype(func_args)>(func_args)...);
+        },
+        std::forward<Function>(f), std::forward<Args>(args)...));
+    ++pending_;
+    return index;
+  }
+
+  /// @overload
+  template <typename Function, typename... Args>
+  std::size_t AsyncNoSpan(Function&& f, Args&&... args) {
+    return AsyncNoSpan(current_task::GetTaskProcessor(),
+                       std::forward<Function>(f), std::forward<Args>(args)...);
+  }
+
+  /// @brief Waits for the next completed task of the set.
+  /// @returns the index of the completed task, or `std::nullopt` if all the
+  /// tasks have already been reported, the deadline was reached or the
+  /// current task was cancelled.
+  std::optional<std::size_t> WaitNextUntil(Deadline deadline) {
+    if (pending_ == 0) return std::nullopt;
+    auto index = queue_.WaitPop(deadline);
+    if (index) --pending_;
+    return index;
+  }
+
+  /// @overload
+  std::optional<std::size_t> WaitNext() { return WaitNextUntil({}); }
+
+  /// @returns the task with the specified index; the payload of a reported
+  /// task has already finished, so its Get() returns promptly
+  TaskWithResult<T>& GetTask(std::size_t index) {
+    UASSERT(index < tasks_.size());
+    return tasks_[index];
+  }
+
+  /// @returns the number of the tasks in the set
+  std::size_t Size() const noexcept { return tasks_.size(); }
+
+  /// @returns the number of the tasks not yet reported by WaitNext
+  std::size_t PendingCount() const noexcept { return pending_; }
+
+ private:
+  // tasks reference queue_, so they are destroyed (cancelled and waited
+  // for) first
+  impl::CompletionQueue queue_;
+  std::vector<TaskWithResult<T>> tasks_;
+  std::size_t pending_{0};
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -24,6 +24,10 @@ struct TaskConfig final {
   Task::Importance importance{Task::Importance::kNormal};
   Task::WaitMode wait_mode{Task::WaitMode::kSingleWaiter};
   engine::Deadline deadline;
+  // 0 for the task processor default
+  std::size_t stack_size{0};
+  // run on the worker thread stack without a coroutine
+  bool is_stackless{false};
 };
 
 [[nodiscard]] TaskContext& PlacementNewTaskContext(
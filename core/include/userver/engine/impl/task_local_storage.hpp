@@ -83,6 +83,8 @@ class DataImpl final : public ConditionalDataBase<Kind> {
 
 [[noreturn]] void ReportVariableNotSet(const std::type_info& type);
 
+struct InheritedSnapshot;
+
 class Storage final {
  public:
   Storage();
@@ -91,7 +93,8 @@ class Storage final {
   Storage& operator=(Storage&&) = delete;
   ~Storage();
 
-  // Copies pointers to inherited variables from 'other'
+  // Shares the inherited variables of 'other' without copying them, they are
+  // copied on the first modification of an inherited variable in 'this'
   // 'this' must not contain any variables
   void InheritFrom(Storage& other);
 
@@ -141,7 +144,7 @@ class Storage final {
   }
 
   template <typename T, VariableKind Kind>
-  void Erase(Key key) noexcept {
+  void Erase(Key key) {
     static_assert(Kind == VariableKind::kInherited);
     EraseInherited(key);
   }
@@ -153,10 +156,15 @@ class Storage final {
 
   void SetGeneric(Key key, InheritedDataBase& node, bool has_existing_variable);
 
-  void EraseInherited(Key key) noexcept;
+  // May allocate to copy the variables shared with the parent task
+  void EraseInherited(Key key);
 
   void InheritNode(InheritedDataBase&);
 
+  std::shared_ptr<const InheritedSnapshot> GetInheritedSnapshot();
+
+  void CopyParentInherited();
+
   // Provides strong exception guarantee. Does not delete the old data, if any.
   template <typename T, VariableKind Kind, typename... Args>
   T& DoEmplace(Key key, bool has_existing_variable, Args&&... args) {
@@ -167,7 +175,7 @@ class Storage final {
   }
 
   struct Impl;
-  utils::FastPimpl<Impl, 40, 8> impl_;
+  utils::FastPimpl<Impl, 72, 8> impl_;
 };
 
 class Variable final {
@@ -4,6 +4,7 @@
 /// @brief Common definitions and base classes for stream like objects
 
 #include <cstddef>
+#include <initializer_list>
 #include <memory>
 
 #include <userver/engine/deadline.hpp>
@@ -61,9 +62,18 @@ class WritableBase {
 
   [[nodiscard]] virtual size_t WriteAll(std::initializer_list<IoData> list,
                                         Deadline deadline) {
+    return WriteAllv(list.begin(), list.size(), deadline);
+  }
+
+  /// @brief Sends exactly list_size IoData in order, preferably in a single
+  /// scatter-gather operation.
+  /// @note Can return less than the total length if stream is closed by peer.
+  [[nodiscard]] virtual size_t WriteAllv(const IoData* list,
+                                         std::size_t list_size,
+                                         Deadline deadline) {
     size_t result{0};
-    for (const auto& io_data : list) {
-      result += WriteAll(io_data.data, io_data.len, deadline);
+    for (std::size_t i = 0; i < list_size; ++i) {
+      result += WriteAll(list[i].data, list[i].len, deadline);
     }
     return result;
   }
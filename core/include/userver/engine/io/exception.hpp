@@ -48,6 +48,13 @@ class IoCancelled : public IoInterrupted {
   explicit IoCancelled(size_t bytes_transferred);
 };
 
+/// Reason of an I/O interruption reported without an exception, e.g. by
+/// engine::io::Socket::TryRecvSome.
+enum class IoInterruption {
+  kTimeout,    ///< deadline was reached, same as IoTimeout
+  kCancelled,  ///< current task was cancelled, same as IoCancelled
+};
+
 /// Operating system I/O error.
 class IoSystemError : public IoException {
  public:
@@ -78,8 +78,10 @@ class Sockaddr final {
   /// Native socket address structure pointer.
   const struct sockaddr* Data() const { return As<struct sockaddr>(); }
 
-  /// Maximum supported native socket address structure size.
-  socklen_t Size() const { return Addrlen(Domain()); }
+  /// @brief Native socket address structure size.
+  /// @note For the abstract unix socket addresses it covers the name only,
+  /// as the trailing zeros are a part of such address.
+  socklen_t Size() const;
 
   /// Maximum supported native socket address structure size.
   socklen_t Capacity() const { return sizeof(data_); }
@@ -99,8 +101,12 @@ class Sockaddr final {
   /// Sets a port for address families that allow for one, otherwise throws.
   void SetPort(std::uint16_t port);
 
+  /// Whether the address is a unix socket one in the abstract namespace.
+  bool IsAbstractUnix() const;
+
   /// @brief Human-readable address representation.
-  /// @note Does not include port number.
+  /// @note Does not include port number. The abstract unix socket addresses
+  /// are represented with a leading '@'.
   std::string PrimaryAddressString() const;
 
   /// Domain-specific native socket address structure size.
@@ -12,6 +12,7 @@
 #include <userver/engine/io/exception.hpp>
 #include <userver/engine/io/fd_control_holder.hpp>
 #include <userver/engine/io/sockaddr.hpp>
+#include <userver/utils/expected.hpp>
 
 struct iovec;
 
@@ -79,6 +80,19 @@ class [[nodiscard]] Socket final : public RwBase {
   /// received any more, received bytes count otherwise.
   [[nodiscard]] size_t RecvSome(void* buf, size_t len, Deadline deadline);
 
+  /// @brief Receives at least one byte from the socket, reporting timeouts
+  /// and cancellations without throwing.
+  ///
+  /// Meant for hot paths that routinely hit deadlines, where unwinding of
+  /// IoTimeout and IoCancelled would dominate the cost of the operation.
+  /// @returns 0 if connection is closed on one side and no data could be
+  /// received any more, received bytes count otherwise.
+  /// @throws IoSystemError on operating system errors, same as RecvSome.
+  /// @note Always waits for readiness of the socket, even if io_uring is
+  /// enabled for the engine.
+  [[nodiscard]] utils::expected<size_t, IoInterruption> TryRecvSome(
+      void* buf, size_t len, Deadline deadline);
+
   /// @brief Receives exactly len bytes from the socket.
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t RecvAll(void* buf, size_t len, Deadline deadline);
@@ -108,6 +122,21 @@ class [[nodiscard]] Socket final : public RwBase {
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const void* buf, size_t len, Deadline deadline);
 
+  /// @brief Sends exactly list_size IoData to the socket with writev.
+  /// @note Can return less than len if socket is closed by peer.
+  [[nodiscard]] size_t WriteAllv(const IoData* list, std::size_t list_size,
+                                 Deadline deadline) override {
+    return SendAll(list, list_size, deadline);
+  }
+
+  /// @brief Sends exactly len bytes of the file starting at offset to the
+  /// socket without copying them to the userspace, e.g. with sendfile.
+  /// @note Can return less than len if socket is closed by peer or if the
+  /// file is shorter than offset + len.
+  /// @note File data that is not in the page cache is read synchronously.
+  [[nodiscard]] size_t SendFile(int in_fd, std::size_t offset, std::size_t len,
+                                Deadline deadline);
+
   /// @brief Accepts a connection from a listening socket.
   /// @see engine::io::Listen
   [[nodiscard]] Socket Accept(Deadline);
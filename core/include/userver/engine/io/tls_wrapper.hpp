@@ -25,16 +25,31 @@ namespace engine::io {
 /// @snippet src/engine/io/tls_wrapper_test.cpp TLS wrapper usage
 class [[nodiscard]] TlsWrapper final : public RwBase {
  public:
+  /// Offload of the TLS records encryption to the kernel (Linux kTLS)
+  enum class KernelTls {
+    /// The records are encrypted by OpenSSL
+    kDisabled,
+    /// The records are encrypted by the kernel after the handshake if
+    /// OpenSSL, the kernel and the negotiated cipher support it, by OpenSSL
+    /// otherwise. The socket can not be returned by StopTls.
+    kIfSupported,
+  };
+
   /// Starts a TLS client on an opened socket
   static TlsWrapper StartTlsClient(Socket&& socket,
                                    const std::string& server_name,
-                                   Deadline deadline);
+                                   Deadline deadline,
+                                   KernelTls kernel_tls = KernelTls::kDisabled);
 
-  /// Starts a TLS server on an opened socket
+  /// @brief Starts a TLS server on an opened socket
+  /// @param alpn_protocols application protocols to negotiate via ALPN in the
+  /// order of preference, e.g. "h2", "http/1.1"
   static TlsWrapper StartTlsServer(
       Socket&& socket, const crypto::Certificate& cert,
       const crypto::PrivateKey& key, Deadline deadline,
-      const std::vector<crypto::Certificate>& cert_authorities = {});
+      const std::vector<crypto::Certificate>& cert_authorities = {},
+      const std::vector<std::string>& alpn_protocols = {},
+      KernelTls kernel_tls = KernelTls::kDisabled);
 
   ~TlsWrapper() override;
 
@@ -69,6 +84,8 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   /// @brief Finishes TLS session and returns the socket.
   /// @warning Wrapper becomes invalid on entry and can only be used to retry
   ///   socket extraction if interrupted.
+  /// @throws TlsException if the kernel encrypts the records, the socket is
+  ///   closed after the shutdown in this case.
   [[nodiscard]] Socket StopTls(Deadline deadline);
 
   /// @brief Receives at least one byte from the socket.
@@ -93,13 +110,39 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
     return SendAll(buf, len, deadline);
   }
 
+  /// @brief Writes exactly list_size IoData to the socket.
+  ///
+  /// Small buffers are coalesced to be encrypted into as few TLS records as
+  /// possible.
+  /// @note Can return less than len if socket is closed by peer.
+  [[nodiscard]] size_t WriteAllv(const IoData* list, std::size_t list_size,
+                                 Deadline deadline) override;
+
   int GetRawFd();
 
+  /// Whether the sent records are encrypted by the kernel
+  bool IsKernelTlsSend() const;
+
+  /// Whether the received records are decrypted by the kernel
+  bool IsKernelTlsRecv() const;
+
+  /// @brief Whether the handshake resumed a previous session instead of a
+  /// full one.
+  ///
+  /// Client wrappers resume the sessions of the same server name and peer
+  /// address, server wrappers resume the session tickets issued by any
+  /// server wrapper of the process during the last hour.
+  bool IsSessionReused() const;
+
+  /// @brief Returns the application protocol negotiated via ALPN, empty if
+  /// none was negotiated
+  std::string GetAlpnProtocol() const;
+
  private:
   explicit TlsWrapper(Socket&&);
 
   class Impl;
-  constexpr static size_t kSize = 296;
+  constexpr static size_t kSize = 328;
   constexpr static size_t kAlignment = 8;
   utils::FastPimpl<Impl, kSize, kAlignment> impl_;
 };
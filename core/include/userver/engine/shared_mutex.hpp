@@ -3,6 +3,8 @@
 /// @file userver/engine/shared_mutex.hpp
 /// @brief @copybrief engine::SharedMutex
 
+#include <memory>
+
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/semaphore.hpp>
@@ -21,6 +23,9 @@ namespace engine {
 /// thus new shared lock waits for the pending writes to finish, which in turn
 /// waits for existing existing shared locks to unlock first.
 ///
+/// For the read-mostly data SharedMutex::Mode::kReadBiased could be used to
+/// make the readers scale with the number of worker threads.
+///
 /// ## Example usage:
 ///
 /// @snippet engine/shared_mutex_test.cpp  Sample engine::SharedMutex usage
@@ -28,8 +33,24 @@ namespace engine {
 /// @see @ref scripts/docs/en/userver/synchronization.md
 class SharedMutex final {
  public:
+  /// The way of counting the readers
+  enum class Mode {
+    /// Readers share a single counter with writers
+    kDefault,
+
+    /// Readers increment and decrement counters spread over a few cache lines
+    /// and do not touch the writers state while there are no writers.
+    /// Makes writers slower, as they wait for all the counters to drain, and
+    /// takes about a kilobyte of memory per mutex.
+    ///
+    /// @warning unlock_shared() must be called from the same task that
+    /// locked the mutex for shared ownership.
+    kReadBiased,
+  };
+
   SharedMutex();
-  ~SharedMutex() = default;
+  explicit SharedMutex(Mode mode);
+  ~SharedMutex();
 
   SharedMutex(const SharedMutex&) = delete;
   SharedMutex(SharedMutex&&) = delete;
@@ -114,8 +135,14 @@ class SharedMutex final {
   [[nodiscard]] bool try_lock_shared_until(Deadline deadline);
 
  private:
+  struct BiasedReaders;
+
   bool HasWaitingWriter() const noexcept;
 
+  bool TryLockBiasedShared(Deadline deadline);
+
+  bool WaitForNoBiasedReaders(Deadline deadline);
+
   bool WaitForNoWaitingWriters(Deadline deadline);
 
   void DecWaitingWriters();
@@ -136,6 +163,11 @@ class SharedMutex final {
   std::atomic_size_t waiting_writers_count_;
   Mutex waiting_writers_count_mutex_;
   ConditionVariable waiting_writers_count_cv_;
+
+  /* Only for Mode::kReadBiased: readers do not use semaphore_ at all, writers
+   * lock semaphore_ and then wait for these readers to leave.
+   */
+  std::unique_ptr<BiasedReaders> biased_readers_;
 };
 
 template <typename Rep, typename Period>
@@ -66,7 +66,7 @@ class SingleWaitingTaskMutex final {
  private:
   class Impl;
 
-  utils::FastPimpl<Impl, 32, 16> impl_;
+  utils::FastPimpl<Impl, 48, 16> impl_;
 };
 
 template <typename Rep, typename Period>
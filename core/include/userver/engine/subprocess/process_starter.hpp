@@ -20,11 +20,20 @@ namespace ev {
 class ThreadControl;
 }  // namespace ev
 
+namespace io {
+class Pipe;
+}  // namespace io
+
 namespace subprocess {
 
 /// @ingroup userver_clients
 ///
 /// @brief Creates a new OS subprocess and executes a command in it.
+///
+/// The subprocess is spawned via `posix_spawn`, so the cost of starting it
+/// does not depend on the memory size of the current process.
+///
+/// @throws std::system_error if the command could not be executed.
 class ProcessStarter {
  public:
   explicit ProcessStarter(TaskProcessor& task_processor);
@@ -33,7 +42,6 @@ class ProcessStarter {
   ChildProcess Exec(
       const std::string& command, const std::vector<std::string>& args,
       const EnvironmentVariables& env,
-      // TODO: use something like pipes instead of path to files
       const std::optional<std::string>& stdout_file = std::nullopt,
       const std::optional<std::string>& stderr_file = std::nullopt);
 
@@ -42,14 +50,25 @@ class ProcessStarter {
   ChildProcess Exec(
       const std::string& command, const std::vector<std::string>& args,
       EnvironmentVariablesUpdate env_update,
-      // TODO: use something like pipes instead of path to files
       const std::optional<std::string>& stdout_file = std::nullopt,
       const std::optional<std::string>& stderr_file = std::nullopt);
 
+  /// `env` redefines all environment variables.
+  ///
+  /// stdout and stderr of the subprocess are redirected to the writing ends of
+  /// `stdout_pipe` and `stderr_pipe`, nullptr keeps the stream inherited.
+  /// The writing ends are closed in the current process once the subprocess
+  /// is started, so reading from the reading ends finishes when the subprocess
+  /// closes its output.
+  ChildProcess ExecWithPipes(const std::string& command,
+                             const std::vector<std::string>& args,
+                             const EnvironmentVariables& env,
+                             io::Pipe* stdout_pipe,
+                             io::Pipe* stderr_pipe = nullptr);
+
   /// Exec subprocess using current environment.
   ChildProcess Exec(
       const std::string& command, const std::vector<std::string>& args,
-      // TODO: use something like pipes instead of path to files
       const std::optional<std::string>& stdout_file = std::nullopt,
       const std::optional<std::string>& stderr_file = std::nullopt);
 
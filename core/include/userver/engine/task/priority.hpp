@@ -0,0 +1,48 @@
+#pragma once
+
+/// @file userver/engine/task/priority.hpp
+/// @brief @copybrief engine::TaskPriority
+
+#include <cstdint>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// @brief Scheduling class of a task.
+///
+/// Only the task processors with `task-processor-queue: priority-task-queue`
+/// take it into account, other task queues are FIFO. A task inherits the
+/// priority of the task that started it.
+///
+/// @see current_task::SetPriority
+enum class TaskPriority : std::uint8_t {
+  kHigh,    ///< Latency-critical work, e.g. health checks and monitoring
+  kNormal,  ///< The default
+  kLow,     ///< Bulk background work
+};
+
+namespace current_task {
+
+/// Sets the priority of the current task, it is applied the next time the
+/// task is scheduled. Tasks started afterwards inherit the new priority.
+void SetPriority(TaskPriority priority);
+
+/// Returns the priority of the current task
+TaskPriority GetPriority();
+
+/// @brief Sets the deadline used for the earliest-deadline-first ordering of
+/// the current task and of the tasks started from it afterwards.
+///
+/// The request deadline of handlers is set automatically. Only the
+/// `kNormal` tasks are ordered by deadline, and only when the task processor
+/// has `task-processor-queue: priority-task-queue` with `deadline-ordering`.
+void SetSchedulingDeadline(Deadline deadline);
+
+}  // namespace current_task
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
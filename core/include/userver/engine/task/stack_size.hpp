@@ -0,0 +1,29 @@
+#pragma once
+
+/// @file userver/engine/task/stack_size.hpp
+/// @brief @copybrief engine::StackSize
+
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// @brief Minimal coroutine stack size requested for a task, bytes.
+///
+/// The task runs on the smallest of `coro_pool.stack_size` and
+/// `coro_pool.stack_size_classes` (see components::ManagerControllerComponent)
+/// that fits the requested size, or on the biggest one if none fits. Use
+/// `coro_pool.stack_usage_sample_every` to find out the stack usage of the
+/// tasks.
+///
+/// @see engine::AsyncNoSpan, utils::Async
+struct StackSize final {
+  constexpr explicit StackSize(std::size_t bytes) noexcept : bytes(bytes) {}
+
+  std::size_t bytes;
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -17,13 +17,23 @@ namespace engine {
 /// @brief Component to monitor CPU usage for every TaskProcessor present in
 /// the service, and dump per-thread stats into metrics.
 ///
+/// The component also autoscales the task processors with the `autoscale`
+/// option: a worker is parked if the cgroup of the service is throttled by the
+/// CPU quota for a few samples in a row, and unparked if the tasks wait in the
+/// queue for too long while there is CPU quota left.
+///
 /// ## Static options:
 /// Inherits all the options from components::LoggableComponentBase and adds the
 /// following ones:
 ///
-/// Name           | Description                                    | Default value
-/// -------------- | ---------------------------------------------- | ---------------------------------
-/// task-processor | name of the TaskProcessor to run monitoring on | default monitoring task processor
+/// Name                           | Description                                                                 | Default value
+/// ------------------------------ | --------------------------------------------------------------------------- | ---------------------------------
+/// task-processor                 | name of the TaskProcessor to run monitoring on                              | default monitoring task processor
+/// fs-task-processor              | task processor to read the cgroup CPU stats on                              | fs-task-processor
+/// autoscale-interval             | how often the autoscaled task processors are tuned                          | 1s
+/// autoscale-max-throttled-ratio  | workers are parked if a bigger share of the CFS periods is throttled        | 0.01
+/// autoscale-queue-wait-threshold | workers are unparked if the tasks wait in the queue longer                  | 1ms
+/// autoscale-hysteresis-samples   | consecutive samples voting for a change of the active workers count         | 3
 // clang-format on
 class TaskProcessorsLoadMonitor final
     : public components::LoggableComponentBase {
@@ -3,6 +3,9 @@
 /// @file userver/fs/fs_cache_client.hpp
 /// @brief @copybref fs::FsCacheClient
 
+#include <cstddef>
+#include <optional>
+
 #include <userver/engine/io/sys/linux/inotify.hpp>
 #include <userver/fs/read.hpp>
 #include <userver/rcu/rcu_map.hpp>
@@ -23,8 +26,11 @@ class FsCacheClient final {
   /// @param update_period time (0 - fill the cache only at startup), not used
   /// in Linux
   /// @param tp task processor to do filesystem operations
+  /// @param mmap_min_size files of at least this size are kept memory mapped
+  /// instead of being copied into memory, std::nullopt disables mapping
   FsCacheClient(std::string_view dir, std::chrono::milliseconds update_period,
-                engine::TaskProcessor& tp);
+                engine::TaskProcessor& tp,
+                std::optional<std::size_t> mmap_min_size = std::nullopt);
 
   /// @brief get file from memory
   /// @param path to file
@@ -53,6 +59,7 @@ class FsCacheClient final {
   const std::string dir_;
   const std::chrono::milliseconds update_period_;
   engine::TaskProcessor& tp_;
+  const std::optional<std::size_t> mmap_min_size_;
 #ifndef __linux__
   utils::PeriodicTask cache_updater_;
 #endif
@@ -3,11 +3,15 @@
 /// @file userver/fs/read.hpp
 /// @brief functions for asynchronous file read operations
 
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/fs/blocking/mapped_file.hpp>
 #include <userver/utils/flags.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +23,13 @@ namespace fs {
 struct FileInfoWithData {
   std::string data;
   std::string extension;
+  /// Contents of the file if it was memory mapped, `data` is empty then
+  std::shared_ptr<const blocking::MappedFile> mapped_file;
+
+  /// Returns the file contents regardless of the way they are stored
+  std::string_view GetContents() const noexcept {
+    return mapped_file ? mapped_file->GetView() : std::string_view{data};
+  }
 };
 
 using FileInfoWithDataConstPtr = std::shared_ptr<const FileInfoWithData>;
@@ -42,12 +53,27 @@ std::string GetLexicallyRelative(std::string_view path, std::string_view dir);
 /// @param async_tp TaskProcessor for synchronous waiting
 /// @param path to directory to traverse recursively
 /// @param flags settings read files
+/// @param mmap_min_size files of at least this size are memory mapped instead
+/// of being read, std::nullopt disables mapping
 /// @returns map with relative to `path` filepaths and file info
 /// @throws std::runtime_error if read fails for any reason (e.g. no such file,
 /// read error, etc.),
 FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     engine::TaskProcessor& async_tp, const std::string& path,
-    utils::Flags<SettingsReadFile> flags = {SettingsReadFile::kSkipHidden});
+    utils::Flags<SettingsReadFile> flags = {SettingsReadFile::kSkipHidden},
+    std::optional<std::size_t> mmap_min_size = std::nullopt);
+
+/// @brief Reads file contents or maps them into memory asynchronously
+/// @param async_tp TaskProcessor for synchronous waiting
+/// @param path file to open
+/// @param mmap_min_size the file is memory mapped instead of being read if
+/// it is at least this size, std::nullopt disables mapping
+/// @returns file info and contents
+/// @throws std::runtime_error if read fails for any reason (e.g. no such file,
+/// read error, etc.),
+FileInfoWithData ReadFileInfoWithData(
+    engine::TaskProcessor& async_tp, const std::string& path,
+    std::optional<std::size_t> mmap_min_size = std::nullopt);
 
 /// @brief Reads file contents asynchronously
 /// @param async_tp TaskProcessor for synchronous waiting
@@ -51,6 +51,7 @@ namespace components {
 /// flush_level | messages of this and higher levels get flushed to the file immediately | warning
 /// message_queue_size | the size of internal message queue, must be a power of 2 | 65536
 /// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue | discard
+/// deferred_formatting | escape and format the log records on the logger task processor instead of the logging task, only the raw keys and values are copied into the queue | false
 /// testsuite-capture | if exists, setups additional TCP log sink for testing purposes | {}
 /// fs-task-processor | task processor for disk I/O operations for this logger | fs-task-processor of the loggers component
 ///
@@ -60,7 +61,7 @@ namespace components {
 /// - Use `@stderr` to write your logs to standard error stream;
 /// - Use `@null` to suppress sending of logs;
 /// - Use `%file_name%` to write your logs in file. Use USR1 signal or `OnLogRotate` handler to reopen files after log rotation;
-/// - Use `unix:%socket_name%` to write your logs to unix socket. Socket must be created before the service starts and closed by listener afert service is shuted down.
+/// - Use `unix:%socket_name%` to write your logs to unix socket. Socket must be created before the service starts and closed by listener afert service is shuted down. If the listener is slow or restarts, up to 4MB of logs are kept in memory and sent after reconnection, older logs are dropped and counted in the `dropped` metric.
 ///
 /// ### testsuite-capture options:
 /// Name | Description | Default value
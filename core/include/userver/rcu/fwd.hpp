@@ -19,6 +19,9 @@ namespace rcu {
 template <typename T>
 struct DefaultRcuTraits;
 
+template <typename T>
+struct EpochRcuTraits;
+
 template <typename Key, typename Value>
 struct DefaultRcuMapTraits;
 
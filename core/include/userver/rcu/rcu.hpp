@@ -3,10 +3,15 @@
 /// @file userver/rcu/rcu.hpp
 /// @brief Implementation of hazard pointer
 
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <cstdlib>
 #include <list>
+#include <memory>
+#include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 #include <userver/compiler/impl/tls.hpp>
 #include <userver/engine/async.hpp>
@@ -25,8 +30,36 @@ USERVER_NAMESPACE_BEGIN
 /// with modified API
 namespace rcu {
 
+/// @brief How rcu::Variable reclaims the replaced values, could be set in
+/// the `kReclamation` member of the rcu::Variable traits.
+enum class ReclamationType {
+  /// Readers publish hazard pointers, writers scan all of them on each update.
+  /// The replaced values are freed as soon as there are no readers for them.
+  kHazardPointers,
+
+  /// Readers increment a counter of the current grace period in a per-thread
+  /// shard, writers flip the grace period once the readers of the previous
+  /// one are gone and free the values replaced two flips ago in a batch.
+  /// Reads and writes are cheaper, but a long living ReadablePtr delays the
+  /// reclamation of all the values replaced after it was obtained.
+  kEpoch,
+};
+
 namespace impl {
 
+template <typename RcuTraits, typename = void>
+inline constexpr ReclamationType kReclamationType =
+    ReclamationType::kHazardPointers;
+
+template <typename RcuTraits>
+inline constexpr ReclamationType kReclamationType<
+    RcuTraits, std::void_t<decltype(RcuTraits::kReclamation)>> =
+    RcuTraits::kReclamation;
+
+template <typename RcuTraits>
+inline constexpr bool kIsEpochReclamation =
+    kReclamationType<RcuTraits> == ReclamationType::kEpoch;
+
 // Hazard pointer implementation. Pointers form a linked list. \p ptr points
 // to the data they 'hold', next - to the next element in a list.
 // kUsed is a filler value to show that hazard pointer is not free. Please see
@@ -74,16 +107,61 @@ USERVER_IMPL_PREVENT_TLS_CACHING CachedData<T, RcuTraits>& GetCachedData() {
 
 uint64_t GetNextEpoch() noexcept;
 
+inline constexpr std::size_t kEpochReaderSlots = 16;
+
+// Readers of both grace periods for ReclamationType::kEpoch. A reader
+// decrements the counter it has incremented, even if its coroutine has
+// migrated to another thread.
+struct alignas(64) EpochReaderSlot final {
+  std::array<std::atomic<std::int64_t>, 2> readers{};
+};
+
+std::size_t GetEpochReaderSlotIndex() noexcept;
+
+template <typename T>
+struct EpochReclamationState final {
+  std::unique_ptr<EpochReaderSlot[]> slots{
+      new EpochReaderSlot[kEpochReaderSlots]};
+  // only changed with the writer's mutex held
+  std::atomic<std::uint64_t> grace_period{0};
+  // replaced after the last grace period flip
+  std::vector<std::unique_ptr<T>> pending;
+  // replaced before the last grace period flip
+  std::vector<std::unique_ptr<T>> waiting;
+};
+
+struct NoEpochReclamationState final {};
+
+template <typename T, typename RcuTraits>
+using ReclamationState =
+    std::conditional_t<kIsEpochReclamation<RcuTraits>,
+                       EpochReclamationState<T>, NoEpochReclamationState>;
+
+template <typename T, typename RcuTraits>
+using ReaderRecord = std::conditional_t<kIsEpochReclamation<RcuTraits>,
+                                        std::atomic<std::int64_t>,
+                                        HazardPointerRecord<T, RcuTraits>>;
+
 }  // namespace impl
 
 /// Default Rcu traits.
 /// - `MutexType` is a writer's mutex type that has to be used to protect
 /// structure on update
+/// - optional `kReclamation` of type rcu::ReclamationType, hazard pointers
+/// are used if it is missing
 template <typename T>
 struct DefaultRcuTraits {
   using MutexType = engine::Mutex;
 };
 
+/// Rcu traits with rcu::ReclamationType::kEpoch, for the often updated
+/// variables
+template <typename T>
+struct EpochRcuTraits {
+  using MutexType = engine::Mutex;
+  static constexpr ReclamationType kReclamation = ReclamationType::kEpoch;
+};
+
 /// Reader smart pointer for rcu::Variable<T>. You may use operator*() or
 /// operator->() to do something with the stored value. Once created,
 /// ReadablePtr references the same immutable value: if Variable's value is
@@ -93,17 +171,23 @@ template <typename T, typename RcuTraits>
 class [[nodiscard]] ReadablePtr final {
  public:
   explicit ReadablePtr(const Variable<T, RcuTraits>& ptr)
-      : hp_record_(&ptr.MakeHazardPointer()) {
-    // This cycle guarantees that at the end of it both t_ptr_ and
-    // hp_record_->ptr will both be set to
-    // 1. something meaningful
-    // 2. and that this meaningful value was not removed between assigning to
-    //    t_ptr_ and storing  it in a hazard pointer
-    do {
+      : hp_record_(&ptr.MakeReaderRecord()) {
+    if constexpr (impl::kIsEpochReclamation<RcuTraits>) {
+      // The reader counter is incremented before the load, so a value
+      // replaced after the load waits for the counter to drain
       t_ptr_ = ptr.GetCurrent();
-
-      hp_record_->ptr.store(t_ptr_);
-    } while (t_ptr_ != ptr.GetCurrent());
+    } else {
+      // This cycle guarantees that at the end of it both t_ptr_ and
+      // hp_record_->ptr will both be set to
+      // 1. something meaningful
+      // 2. and that this meaningful value was not removed between assigning
+      //    to t_ptr_ and storing  it in a hazard pointer
+      do {
+        t_ptr_ = ptr.GetCurrent();
+
+        hp_record_->ptr.store(t_ptr_);
+      } while (t_ptr_ != ptr.GetCurrent());
+    }
   }
 
   ReadablePtr(ReadablePtr<T, RcuTraits>&& other) noexcept
@@ -135,7 +219,7 @@ class [[nodiscard]] ReadablePtr final {
 
     // Get rid of our current hp_record_
     if (t_ptr_) {
-      hp_record_->Release();
+      ReleaseRecord();
     }
     // After that moment, the content of our hp_record_ can't be used -
     // no more hp_record_->xyz calls, because it is probably already reused in
@@ -155,7 +239,8 @@ class [[nodiscard]] ReadablePtr final {
   }
 
   ReadablePtr(const ReadablePtr<T, RcuTraits>& other)
-      : ReadablePtr(other.hp_record_->owner) {}
+      : ReadablePtr(other, std::bool_constant<
+                               impl::kIsEpochReclamation<RcuTraits>>{}) {}
 
   ReadablePtr& operator=(const ReadablePtr<T, RcuTraits>& other) {
     if (this != &other) *this = ReadablePtr<T, RcuTraits>{other};
@@ -165,7 +250,7 @@ class [[nodiscard]] ReadablePtr final {
   ~ReadablePtr() {
     if (!t_ptr_) return;
     UASSERT(hp_record_ != nullptr);
-    hp_record_->Release();
+    ReleaseRecord();
   }
 
   const T* Get() const& {
@@ -182,6 +267,25 @@ class [[nodiscard]] ReadablePtr final {
   const T& operator*() && { return *GetOnRvalue(); }
 
  private:
+  // With hazard pointers a copy reads the current value of the variable
+  ReadablePtr(const ReadablePtr<T, RcuTraits>& other, std::false_type)
+      : ReadablePtr(other.hp_record_->owner) {}
+
+  // With epochs a copy references the same value, the reader counter does not
+  // drain while `other` holds it
+  ReadablePtr(const ReadablePtr<T, RcuTraits>& other, std::true_type)
+      : t_ptr_(other.t_ptr_), hp_record_(other.hp_record_) {
+    if (t_ptr_) hp_record_->fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void ReleaseRecord() noexcept {
+    if constexpr (impl::kIsEpochReclamation<RcuTraits>) {
+      hp_record_->fetch_sub(1, std::memory_order_release);
+    } else {
+      hp_record_->Release();
+    }
+  }
+
   const T* GetOnRvalue() {
     static_assert(!sizeof(T),
                   "Don't use temporary ReadablePtr, store it to a variable");
@@ -196,7 +300,8 @@ class [[nodiscard]] ReadablePtr final {
   // Invariant is this: if t_ptr_ is not nullptr, then hp_record_ is also
   // not nullptr and points to hazard pointer containing same T*.
   // Thus, if t_ptr_ is nullptr, then hp_record_ is undefined.
-  impl::HazardPointerRecord<T, RcuTraits>* hp_record_;
+  // For ReclamationType::kEpoch it is the incremented reader counter.
+  impl::ReaderRecord<T, RcuTraits>* hp_record_;
 };
 
 /// Smart pointer for rcu::Variable<T> for changing RCU value. It stores a
@@ -302,6 +407,9 @@ enum class DestructionType { kSync, kAsync };
 /// be eventually freed when a subsequent writer identifies that nobody works
 /// with this version.
 ///
+/// The way of finding the unused versions is set by rcu::ReclamationType in
+/// the traits, for example rcu::EpochRcuTraits.
+///
 /// @note There is no way to create a "null" `Variable`.
 ///
 /// ## Example usage:
@@ -355,6 +463,14 @@ class Variable final {
       delete hp;
       hp = next;
     }
+    if constexpr (impl::kIsEpochReclamation<RcuTraits>) {
+      for (std::size_t i = 0; i < impl::kEpochReaderSlots; ++i) {
+        for (const auto& readers : reclamation_.slots[i].readers) {
+          UASSERT_MSG(readers.load() == 0,
+                      "RCU variable is destroyed while being used");
+        }
+      }
+    }
 
     // Make sure all data is deleted after return from dtr
     if (destruction_type_ == DestructionType::kAsync) {
@@ -409,12 +525,55 @@ class Variable final {
       return;
     }
 
-    ScanRetiredList(CollectHazardPtrs(lock));
+    if constexpr (impl::kIsEpochReclamation<RcuTraits>) {
+      ReclaimEpoch(lock);
+    } else {
+      ScanRetiredList(CollectHazardPtrs(lock));
+    }
   }
 
  private:
   T* GetCurrent() const { return current_.load(); }
 
+  impl::ReaderRecord<T, RcuTraits>& MakeReaderRecord() const {
+    if constexpr (impl::kIsEpochReclamation<RcuTraits>) {
+      return LockEpochReader();
+    } else {
+      return MakeHazardPointer();
+    }
+  }
+
+  std::atomic<std::int64_t>& LockEpochReader() const {
+    auto& slot = reclamation_.slots[impl::GetEpochReaderSlotIndex()];
+    const auto grace_period =
+        reclamation_.grace_period.load(std::memory_order_relaxed);
+    auto& readers = slot.readers[grace_period % 2];
+    // seq_cst, so that the following load of current_ is not reordered before
+    readers.fetch_add(1);
+    return readers;
+  }
+
+  // A value replaced before two grace period flips is not referenced by any
+  // reader: both counters have drained after its replacement.
+  void ReclaimEpoch(std::unique_lock<MutexType>&) {
+    auto& state = reclamation_;
+    for (int flip = 0; flip < 2; ++flip) {
+      if (state.pending.empty() && state.waiting.empty()) return;
+
+      const auto grace_period =
+          state.grace_period.load(std::memory_order_relaxed);
+      const auto previous = (grace_period + 1) % 2;
+      for (std::size_t i = 0; i < impl::kEpochReaderSlots; ++i) {
+        if (state.slots[i].readers[previous].load() != 0) return;
+      }
+
+      state.grace_period.store(grace_period + 1);
+      DeleteAsync(std::move(state.waiting));
+      state.waiting = std::move(state.pending);
+      state.pending.clear();
+    }
+  }
+
   impl::HazardPointerRecord<T, RcuTraits>* MakeHazardPointerCached() const {
     auto& cache = impl::GetCachedData<T, RcuTraits>();
     auto* hp = cache.hp;
@@ -476,6 +635,12 @@ class Variable final {
 
   void Retire(std::unique_ptr<T> old_ptr, std::unique_lock<MutexType>& lock) {
     LOG_TRACE() << "Retiring ptr=" << old_ptr.get();
+    if constexpr (impl::kIsEpochReclamation<RcuTraits>) {
+      reclamation_.pending.push_back(std::move(old_ptr));
+      ReclaimEpoch(lock);
+      return;
+    }
+
     auto hazard_ptrs = CollectHazardPtrs(lock);
 
     if (hazard_ptrs.count(old_ptr.get()) > 0) {
@@ -532,6 +697,23 @@ class Variable final {
     }
   }
 
+  void DeleteAsync(std::vector<std::unique_ptr<T>> ptrs) {
+    if (ptrs.empty()) return;
+    switch (destruction_type_) {
+      case DestructionType::kSync:
+        ptrs.clear();
+        break;
+      case DestructionType::kAsync:
+        engine::CriticalAsyncNoSpan([ptrs = std::move(ptrs),
+                                     token = wait_token_storage_
+                                                 .GetToken()]() mutable {
+          // Make sure the values are deleted before token is destroyed
+          ptrs.clear();
+        }).Detach();
+        break;
+    }
+  }
+
   const DestructionType destruction_type_;
   const uint64_t epoch_;
 
@@ -542,6 +724,7 @@ class Variable final {
   // may be read without mutex_ locked, but must be changed with held mutex_
   std::atomic<T*> current_;
   std::list<std::unique_ptr<T>> retire_list_head_;
+  mutable impl::ReclamationState<T, RcuTraits> reclamation_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 
   friend class ReadablePtr<T, RcuTraits>;
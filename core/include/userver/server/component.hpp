@@ -64,6 +64,7 @@ namespace components {
 /// tls.cert | path to TLS certificate | -
 /// tls.private-key | path to TLS certificate private key | -
 /// tls.private-key-passphrase-name | passphrase name located in secdist's "passphrases" section | -
+/// tls.kernel-offload | encrypt the records in the kernel (Linux kTLS) after the handshake if the kernel, OpenSSL and the cipher support it | false
 /// handler-defaults.max_url_size | max path/URL size or empty to not limit | 8192
 /// handler-defaults.max_request_size | max size of the whole request | 1024 * 1024
 /// handler-defaults.max_headers_size | max request headers size | 65536
@@ -71,10 +72,16 @@ namespace components {
 /// handler-defaults.set_tracing_headers | whether to set http tracing headers (X-YaTraceId, X-YaSpanId, X-RequestId) | true
 /// handler-defaults.deadline_propagation_enabled | when `false`, disables HTTP handler deadline propagation | true
 /// handler-defaults.deadline_expired_status_code | the HTTP status code to return if the request deadline expires | 498
-/// connection.in_buffer_size | size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU | 32 * 1024
+/// connection.in_buffer_size | maximum size of the buffer for request receive, the buffer grows while the reads fill it and shrinks on idle keepalive connections: bigger values use more RAM and less CPU | 32 * 1024
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow throttling if there's more pending requests than allowed by this value | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
-/// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
+/// connection.simd_request_parser | parse HTTP/1.x requests by whole lines with SIMD instead of the http_parser library | false
+/// connection.http2.enabled | accept HTTP/2 connections: negotiated with ALPN for TLS, detected by the connection preface otherwise | false
+/// connection.http2.max_concurrent_streams | maximum number of concurrently processed streams (requests) of a connection | 100
+/// connection.http2.initial_window_size | initial flow control window size in bytes for the request bodies of a stream and of the whole connection | 65535
+/// shards | how many listening sockets to bind to the same port with SO_REUSEPORT, each one has its own accept loop; do not set if not sure what it is doing | number of the event threads of the task processor
+/// reuseport_cpu_steering | pass each connection to the listening socket with the index of the CPU that received the SYN (modulo the shards count) instead of the hash of the connection addresses; gives better locality if the shards count matches the CPUs handling the NIC queues | false
+/// shard_task_processors | name of a components::SingleThreadedTaskProcessors component; the N-th listener shard accepts and processes its connections on the N-th task processor of it (modulo its size) instead of `task_processor`. Together with `reuseport_cpu_steering`, `cpu-affinity` of the task processors and `run_on_connection_task_processor` of the handlers, a request is received, handled and responded on a single core | ''
 ///
 /// @see @ref scripts/docs/en/userver/http_server.md
 
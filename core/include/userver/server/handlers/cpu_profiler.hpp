@@ -0,0 +1,95 @@
+#pragma once
+
+/// @file userver/server/handlers/cpu_profiler.hpp
+/// @brief @copybrief server::handlers::CpuProfiler
+
+#include <chrono>
+
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/utils/periodic_task.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that controls the sampling CPU profiler of the task
+/// processors threads.
+///
+/// When started, each task processor worker thread is interrupted by SIGPROF
+/// every `1 / frequency` seconds of its CPU time and the stacktrace is
+/// recorded along with the names of the root span (usually the handler) and
+/// the current span of the running task. The output is in the folded stacks
+/// format, suitable for `flamegraph.pl` and other flame graph tools:
+/// @code
+/// http/handler-foo;pg_query;main;...;Foo::Parse() 42
+/// @endcode
+///
+/// Samples of the code outside of any span are attributed to `[no span]`.
+/// Linux only.
+///
+/// The component is not in the components::CommonServerComponentList() and
+/// should be added manually.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// start-on-boot | whether to start the profiler at the service start | false
+/// frequency | default sampling frequency in Hz per thread | 100
+/// collect-period | how often the samples are moved from the per-thread buffers into the aggregate | 1s
+///
+/// ## Static configuration example:
+///
+/// @code
+/// handler-cpu-profiler:
+///     path: /service/profile/{command}
+///     method: GET,POST
+///     task_processor: monitor-task-processor
+/// @endcode
+///
+/// ## Schema
+/// Set an URL path argument `command` to one of the following values:
+/// * `start` - to start profiling, an optional `frequency` argument overrides
+///   the static config option
+/// * `stop` - to stop profiling, the collected samples are kept
+/// * `dump` - to get the collected samples in folded stacks format, with
+///   the `reset=true` argument the samples are cleared after that
+/// * `status` - to get the profiler state and the number of samples
+
+// clang-format on
+
+class CpuProfiler final : public HttpHandlerBase {
+ public:
+  CpuProfiler(const components::ComponentConfig&,
+              const components::ComponentContext&);
+
+  ~CpuProfiler() override;
+
+  /// @ingroup userver_component_names
+  /// @brief The default name of server::handlers::CpuProfiler
+  static constexpr std::string_view kName = "handler-cpu-profiler";
+
+  std::string HandleRequestThrow(const http::HttpRequest&,
+                                 request::RequestContext&) const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::string GetResponseDataForLogging(
+      const http::HttpRequest& request, request::RequestContext& context,
+      const std::string& response_data) const override;
+
+  const std::size_t default_frequency_;
+  utils::PeriodicTask collect_task_;
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool components::kHasValidate<server::handlers::CpuProfiler> =
+    true;
+
+USERVER_NAMESPACE_END
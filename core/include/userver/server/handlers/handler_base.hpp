@@ -37,12 +37,23 @@ namespace server::handlers {
 /// response_data_size_log_limit | trim responses to this size before logging | 512
 /// max_requests_per_second | integer to limit RPS to this handler | <no limit>
 /// decompress_request | allow decompression of the requests | true
+/// compress_response | compress the responses with gzip if the client accepts it in `Accept-Encoding` | false
+/// compress_response_min_size | minimal size of a non-streamed response body to compress; streamed bodies are always compressed | 1024
+/// compress_response_level | gzip compression level of the responses, from 1 (fastest) to 9 (smallest) | 6
 /// throttling_enabled | allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options | true
 /// set-response-server-hostname | set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header | <takes the value from components::Server config>
+/// response-body-stream-buffer-size | coalesce the chunks of a streamed response body until this many bytes are buffered, see server::http::ResponseBodyStream::Flush(); 0 to send each chunk as is | 0
+/// response-body-stream-flush-delay | max time a chunk of a streamed response body stays in the buffer of `response-body-stream-buffer-size` | 10ms
+/// request-body-stream | pass the request body to the handler as it is received, see server::http::HttpRequest::GetBodyStream() | false
+/// response-headers | map of the headers to add to each response, formatted once at start; the headers set by the handler take precedence | --
+/// response-cache | cache the responses of the GET and HEAD requests by the path, `args` and `headers`, for `ttl`; a hit or a matching `If-None-Match` skips the handler | --
 /// monitor-handler | Overrides the in-code `is_monitor` flag that makes the handler run either on `server.listener` or on `server.listener-monitor` | --
 /// set_tracing_headers | whether to set http tracing headers (X-YaTraceId, X-YaSpanId, X-RequestId) | true
 /// deadline_propagation_enabled | when `false`, disables HTTP handler @ref scripts/docs/en/userver/deadline_propagation.md "deadline propagation" | true
 /// deadline_expired_status_code | the HTTP status code to return if the request @ref scripts/docs/en/userver/deadline_propagation.md "deadline expires" | 498
+/// wait_time_stats | account the off-CPU time of the requests by the wait reason (mutex, semaphore, future, sleep, io ...) and the time in the task processor queue; written into the span tags and into the handler metrics under `wait` | false
+/// allocation_stats | account the bytes allocated and freed by the requests, requires jemalloc; written into the span tags and into the handler metrics under `allocations` | false
+/// run_on_connection_task_processor | run the requests on the task processor that reads the connection (see the `task_processor` and `shard_task_processors` options of components::Server listener) instead of `task_processor`, which saves a hop between threads; the handler must not block the task processor of the listener | false
 
 // clang-format on
 class HandlerBase : public components::LoggableComponentBase {
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -26,6 +29,19 @@ enum class UrlTrailingSlashOption {
   kDefault = kBoth,
 };
 
+/// Config of the built-in response cache of a handler
+struct ResponseCacheConfig {
+  std::chrono::milliseconds ttl{1000};
+  std::size_t size{1000};
+  std::size_t ways{16};
+  std::size_t max_body_size{128 * 1024};
+  /// Query arguments and request headers that make up the key along with
+  /// the method and the path. The whole query string is used if `args` is
+  /// empty.
+  std::vector<std::string> args;
+  std::vector<std::string> headers;
+};
+
 struct HandlerConfig {
   std::variant<std::string, FallbackHandler> path;
   std::string task_processor;
@@ -38,12 +54,24 @@ struct HandlerConfig {
   std::optional<size_t> max_requests_in_flight;
   std::optional<size_t> max_requests_per_second;
   bool decompress_request{true};
+  bool compress_response{false};
+  size_t compress_response_min_size{1024};
+  int compress_response_level{6};
   bool throttling_enabled{true};
   bool response_body_stream{false};
+  std::size_t response_body_stream_buffer_size{0};
+  std::chrono::milliseconds response_body_stream_flush_delay{10};
+  bool request_body_stream{false};
   std::optional<bool> set_response_server_hostname;
   bool set_tracing_headers{true};
   bool deadline_propagation_enabled{true};
   http::HttpStatus deadline_expired_status_code{498};
+  bool wait_time_stats{false};
+  bool allocation_stats{false};
+  bool run_on_connection_task_processor{false};
+  std::optional<ResponseCacheConfig> response_cache;
+  /// Formatted once and sent with each response of the handler
+  std::unordered_map<std::string, std::string> response_headers;
 };
 
 HandlerConfig ParseHandlerConfigsWithDefaults(
@@ -36,6 +36,7 @@ class HttpHandlerStatistics;
 class HttpRequestStatistics;
 class HttpHandlerMethodStatistics;
 class HttpHandlerStatisticsScope;
+class HttpResponseCache;
 
 // clang-format off
 
@@ -179,6 +180,8 @@ class HttpHandlerBase : public HandlerBase {
 
   void DecompressRequestBody(http::HttpRequest& http_request) const;
 
+  void CompressResponseBody(const http::HttpRequest& http_request) const;
+
   template <typename HttpStatistics>
   void FormatStatistics(utils::statistics::Writer result,
                         const HttpStatistics& stats);
@@ -201,6 +204,8 @@ class HttpHandlerBase : public HandlerBase {
   bool set_response_server_hostname_;
   mutable utils::TokenBucket rate_limit_;
   bool is_body_streamed_;
+  std::unique_ptr<HttpResponseCache> response_cache_;
+  std::shared_ptr<const http::HttpResponse::PreparedHeaders> static_headers_;
 };
 
 }  // namespace server::handlers
@@ -0,0 +1,198 @@
+#pragma once
+
+/// @file userver/server/handlers/http_handler_flatbuf_view_base.hpp
+/// @brief @copybrief server::handlers::HttpHandlerFlatbufViewBase
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <flatbuffers/flatbuffers.h>
+
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/http/http_error.hpp>
+#include <userver/utils/log.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace impl {
+
+/// Takes a cleared FlatBufferBuilder from the pool of the current thread and
+/// returns it there on destruction, so that the buffers of the responses are
+/// not reallocated for every request.
+class PooledFlatBufferBuilder final {
+ public:
+  PooledFlatBufferBuilder() {
+    auto& pool = GetThreadPool();
+    if (pool.empty()) {
+      builder_ = std::make_unique<flatbuffers::FlatBufferBuilder>();
+    } else {
+      builder_ = std::move(pool.back());
+      pool.pop_back();
+    }
+  }
+
+  PooledFlatBufferBuilder(const PooledFlatBufferBuilder&) = delete;
+  PooledFlatBufferBuilder& operator=(const PooledFlatBufferBuilder&) = delete;
+
+  ~PooledFlatBufferBuilder() {
+    // The coroutine could have migrated, the builder goes to the pool of the
+    // thread it is destroyed on. Builders of huge responses are not kept.
+    auto& pool = GetThreadPool();
+    if (pool.size() < kMaxPoolSize && builder_->GetSize() <= kMaxKeptSize) {
+      builder_->Clear();
+      pool.push_back(std::move(builder_));
+    }
+  }
+
+  flatbuffers::FlatBufferBuilder& Get() noexcept { return *builder_; }
+
+ private:
+  static constexpr std::size_t kMaxPoolSize = 4;
+  static constexpr std::size_t kMaxKeptSize = 1024 * 1024;
+
+  using Pool = std::vector<std::unique_ptr<flatbuffers::FlatBufferBuilder>>;
+
+  static Pool& GetThreadPool() {
+    thread_local Pool pool;
+    return pool;
+  }
+
+  std::unique_ptr<flatbuffers::FlatBufferBuilder> builder_;
+};
+
+}  // namespace impl
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers userver_base_classes
+///
+/// @brief Base for handlers that accept requests with body in Flatbuffer
+/// format and respond with body in Flatbuffer format, without the object API.
+///
+/// Unlike server::handlers::HttpHandlerFlatbufBase the request is not unpacked
+/// into `InputType::NativeTableType`: the handler gets a verified `InputType`
+/// view over the request body. The response is built in place with a
+/// `flatbuffers::FlatBufferBuilder` taken from a per-thread pool, and the
+/// finished buffer is copied once into the response body.
+///
+/// ## Example usage:
+///
+/// @code
+/// flatbuffers::Offset<fbs::SampleResponse> HandleRequestFlatbufThrow(
+///     const server::http::HttpRequest&, const fbs::SampleRequest& request,
+///     flatbuffers::FlatBufferBuilder& fbb,
+///     server::request::RequestContext&) const override {
+///   const auto echo = fbb.CreateString(request.data());
+///   return fbs::CreateSampleResponse(fbb, request.arg1() + request.arg2(),
+///                                    echo);
+/// }
+/// @endcode
+
+// clang-format on
+
+template <typename InputType, typename ReturnType>
+class HttpHandlerFlatbufViewBase : public HttpHandlerBase {
+  static_assert(std::is_base_of<flatbuffers::Table, InputType>::value,
+                "Input type should be auto-generated FlatBuffers table type");
+  static_assert(std::is_base_of<flatbuffers::Table, ReturnType>::value,
+                "Return type should be auto-generated FlatBuffers table type");
+
+ public:
+  HttpHandlerFlatbufViewBase(
+      const components::ComponentConfig& config,
+      const components::ComponentContext& component_context);
+
+  std::string HandleRequestThrow(const http::HttpRequest& request,
+                                 request::RequestContext& context) const final;
+
+  /// @param input verified view over the request body, valid until the end
+  /// of the request handling
+  /// @param fbb empty builder of the response, do not call Finish() on it
+  /// @returns the root table of the response built with `fbb`
+  virtual flatbuffers::Offset<ReturnType> HandleRequestFlatbufThrow(
+      const http::HttpRequest& request, const InputType& input,
+      flatbuffers::FlatBufferBuilder& fbb,
+      request::RequestContext& context) const = 0;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ protected:
+  /// Override it if you need a custom request body logging.
+  std::string GetRequestBodyForLogging(
+      const http::HttpRequest& request, request::RequestContext& context,
+      const std::string& request_body) const override;
+
+  /// Override it if you need a custom response data logging.
+  std::string GetResponseDataForLogging(
+      const http::HttpRequest& request, request::RequestContext& context,
+      const std::string& response_data) const override;
+
+  void ParseRequestData(const http::HttpRequest& request,
+                        request::RequestContext& context) const final;
+};
+
+template <typename InputType, typename ReturnType>
+HttpHandlerFlatbufViewBase<InputType, ReturnType>::HttpHandlerFlatbufViewBase(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& component_context)
+    : HttpHandlerBase(config, component_context) {}
+
+template <typename InputType, typename ReturnType>
+std::string
+HttpHandlerFlatbufViewBase<InputType, ReturnType>::HandleRequestThrow(
+    const http::HttpRequest& request, request::RequestContext& context) const {
+  // verified in ParseRequestData
+  const auto& input =
+      *flatbuffers::GetRoot<InputType>(request.RequestBody().data());
+
+  impl::PooledFlatBufferBuilder builder;
+  auto& fbb = builder.Get();
+  fbb.Finish(HandleRequestFlatbufThrow(request, input, fbb, context));
+  return {reinterpret_cast<const char*>(fbb.GetBufferPointer()), fbb.GetSize()};
+}
+
+template <typename InputType, typename ReturnType>
+std::string
+HttpHandlerFlatbufViewBase<InputType, ReturnType>::GetRequestBodyForLogging(
+    const http::HttpRequest&, request::RequestContext&,
+    const std::string& request_body) const {
+  size_t limit = GetConfig().request_body_size_log_limit;
+  return utils::log::ToLimitedHex(request_body, limit);
+}
+
+template <typename InputType, typename ReturnType>
+std::string
+HttpHandlerFlatbufViewBase<InputType, ReturnType>::GetResponseDataForLogging(
+    const http::HttpRequest&, request::RequestContext&,
+    const std::string& response_data) const {
+  size_t limit = GetConfig().response_data_size_log_limit;
+  return utils::log::ToLimitedHex(response_data, limit);
+}
+
+template <typename InputType, typename ReturnType>
+void HttpHandlerFlatbufViewBase<InputType, ReturnType>::ParseRequestData(
+    const http::HttpRequest& request, request::RequestContext&) const {
+  const auto& body = request.RequestBody();
+  flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t*>(body.data()),
+                                 body.size());
+  if (!verifier.VerifyBuffer<InputType>(nullptr)) {
+    throw ClientError(
+        InternalMessage{"Invalid FlatBuffers format in request body"});
+  }
+}
+
+template <typename InputType, typename ReturnType>
+yaml_config::Schema
+HttpHandlerFlatbufViewBase<InputType, ReturnType>::GetStaticConfigSchema() {
+  auto schema = HttpHandlerBase::GetStaticConfigSchema();
+  schema.UpdateDescription("HTTP handler flatbuf view base config");
+  return schema;
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 /// @file userver/server/handlers/http_handler_json_base.hpp
 /// @brief @copybrief server::handlers::HttpHandlerJsonBase
 
+#include <userver/formats/json/lazy_value.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,6 +17,14 @@ namespace server::handlers {
 /// @brief Convenient base for handlers that accept requests with body in
 /// JSON format and respond with body in JSON format.
 ///
+/// ## Static options:
+/// Inherits all the options from server::handlers::HttpHandlerBase and adds the
+/// following ones:
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// lazy-request-json | pass the request body to HandleRequestLazyJsonThrow() as a formats::json::LazyValue instead of parsing it | false
+///
 /// ## Example usage:
 ///
 /// @snippet samples/config_service/config_service.cpp Config service sample - component
@@ -28,19 +37,37 @@ class HttpHandlerJsonBase : public HttpHandlerBase {
                       const components::ComponentContext& component_context,
                       bool is_monitor = false);
 
-  std::string HandleRequestThrow(const http::HttpRequest& request,
-                                 request::RequestContext& context) const final;
+  std::string HandleRequestThrow(
+      const http::HttpRequest& request,
+      request::RequestContext& context) const override;
 
+  /// The core method for JSON request handling.
+  /// @note It is used only if IsRequestJsonLazy() returned `false`.
   virtual formats::json::Value HandleRequestJsonThrow(
       const http::HttpRequest& request,
       const formats::json::Value& request_json,
-      request::RequestContext& context) const = 0;
+      request::RequestContext& context) const;
+
+  /// The core method for JSON request handling that gets the request body
+  /// unparsed. Only the members that the handler reads are parsed, which is
+  /// cheaper for the handlers that read a few fields of big requests.
+  /// @note It is used only if IsRequestJsonLazy() returned `true`.
+  virtual formats::json::Value HandleRequestLazyJsonThrow(
+      const http::HttpRequest& request,
+      const formats::json::LazyValue& request_json,
+      request::RequestContext& context) const;
+
+  /// If IsRequestJsonLazy() returns `true`, HandleRequestLazyJsonThrow() is
+  /// called for request handling, otherwise HandleRequestJsonThrow() is.
+  /// @note The default implementation returns the cached value of
+  /// "lazy-request-json" value from static config.
+  virtual bool IsRequestJsonLazy() const { return is_request_json_lazy_; }
 
   static yaml_config::Schema GetStaticConfigSchema();
 
  protected:
   /// @returns A pointer to json request if it was parsed successfully or
-  /// nullptr otherwise.
+  /// nullptr otherwise. Always nullptr if IsRequestJsonLazy() returns `true`.
   static const formats::json::Value* GetRequestJson(
       const request::RequestContext& context);
 
@@ -55,6 +82,8 @@ class HttpHandlerJsonBase : public HttpHandlerBase {
  private:
   FormattedErrorData GetFormattedExternalErrorBody(
       const CustomHandlerException& exc) const final;
+
+  const bool is_request_json_lazy_;
 };
 
 }  // namespace server::handlers
@@ -0,0 +1,138 @@
+#pragma once
+
+/// @file userver/server/handlers/http_handler_json_typed_base.hpp
+/// @brief @copybrief server::handlers::HttpHandlerJsonTypedBase
+
+#include <string>
+
+#include <userver/formats/json/aggregates.hpp>
+#include <userver/formats/json/exception.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/handlers/http_handler_json_base.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace impl {
+
+inline const std::string kJsonTypedRequestDataName = "__request_json_typed";
+inline const std::string kJsonTypedResponseDataName = "__response_json_typed";
+
+}  // namespace impl
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers userver_base_classes
+///
+/// @brief Convenient base for handlers that accept requests with body in
+/// JSON format and respond with body in JSON format, with the bodies
+/// represented by C++ types.
+///
+/// The request body is parsed straight into `InputType` by the SAX parser and
+/// the `ReturnType` is written straight into a formats::json::StringBuilder,
+/// no formats::json::Value is built. The types are aggregates with
+/// formats::json::AggregateFields or containers of them, see
+/// @ref userver/formats/json/aggregates.hpp. An empty request body is an
+/// error.
+
+// clang-format on
+
+template <typename InputType, typename ReturnType>
+class HttpHandlerJsonTypedBase : public HttpHandlerJsonBase {
+ public:
+  HttpHandlerJsonTypedBase(
+      const components::ComponentConfig& config,
+      const components::ComponentContext& component_context,
+      bool is_monitor = false);
+
+  std::string HandleRequestThrow(const http::HttpRequest& request,
+                                 request::RequestContext& context) const final;
+
+  virtual ReturnType HandleRequestTypedThrow(
+      const http::HttpRequest& request, const InputType& input,
+      request::RequestContext& context) const = 0;
+
+  /// @returns A pointer to input data if it was parsed successfully or
+  /// nullptr otherwise.
+  const InputType* GetInputData(const request::RequestContext& context) const;
+
+  /// @returns a pointer to output data if it was returned successfully by
+  /// `HandleRequestTypedThrow()` or nullptr otherwise.
+  const ReturnType* GetOutputData(const request::RequestContext& context) const;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ protected:
+  void ParseRequestData(const http::HttpRequest& request,
+                        request::RequestContext& context) const final;
+};
+
+template <typename InputType, typename ReturnType>
+HttpHandlerJsonTypedBase<InputType, ReturnType>::HttpHandlerJsonTypedBase(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& component_context, bool is_monitor)
+    : HttpHandlerJsonBase(config, component_context, is_monitor) {}
+
+template <typename InputType, typename ReturnType>
+std::string HttpHandlerJsonTypedBase<InputType, ReturnType>::HandleRequestThrow(
+    const http::HttpRequest& request, request::RequestContext& context) const {
+  const auto& input =
+      context.GetData<const InputType&>(impl::kJsonTypedRequestDataName);
+
+  auto& response = request.GetHttpResponse();
+  response.SetContentType(
+      USERVER_NAMESPACE::http::content_type::kApplicationJson);
+
+  const auto& ret = context.SetData<const ReturnType>(
+      impl::kJsonTypedResponseDataName,
+      HandleRequestTypedThrow(request, input, context));
+
+  const auto scope_time =
+      tracing::Span::CurrentSpan().CreateScopeTime("serialize_json");
+  return formats::json::AggregateToString(ret);
+}
+
+template <typename InputType, typename ReturnType>
+const InputType* HttpHandlerJsonTypedBase<InputType, ReturnType>::GetInputData(
+    const request::RequestContext& context) const {
+  return context.GetDataOptional<const InputType>(
+      impl::kJsonTypedRequestDataName);
+}
+
+template <typename InputType, typename ReturnType>
+const ReturnType*
+HttpHandlerJsonTypedBase<InputType, ReturnType>::GetOutputData(
+    const request::RequestContext& context) const {
+  return context.GetDataOptional<const ReturnType>(
+      impl::kJsonTypedResponseDataName);
+}
+
+template <typename InputType, typename ReturnType>
+void HttpHandlerJsonTypedBase<InputType, ReturnType>::ParseRequestData(
+    const http::HttpRequest& request, request::RequestContext& context) const {
+  try {
+    context.SetData<const InputType>(
+        impl::kJsonTypedRequestDataName,
+        formats::json::AggregateFromString<InputType>(request.RequestBody()));
+  } catch (const formats::json::Exception& e) {
+    throw RequestParseError(
+        InternalMessage{"Invalid JSON body"},
+        ExternalBody{std::string("Invalid JSON body: ") + e.what()});
+  }
+}
+
+template <typename InputType, typename ReturnType>
+yaml_config::Schema
+HttpHandlerJsonTypedBase<InputType, ReturnType>::GetStaticConfigSchema() {
+  auto schema = HttpHandlerJsonBase::GetStaticConfigSchema();
+  schema.UpdateDescription("HTTP handler JSON typed base config");
+  return schema;
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
+
 #include <userver/dynamic_config/snapshot.hpp>
+#include <userver/formats/json_fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -8,6 +11,19 @@ namespace server::handlers::impl {
 
 extern const dynamic_config::Key<bool> kDeadlinePropagationEnabled;
 
+struct PredictiveDeadlineConfig final {
+  bool enabled{false};
+  // 50 or 90
+  int percentile{90};
+  std::uint64_t min_samples{100};
+};
+
+PredictiveDeadlineConfig Parse(const formats::json::Value& value,
+                               formats::parse::To<PredictiveDeadlineConfig>);
+
+extern const dynamic_config::Key<PredictiveDeadlineConfig>
+    kPredictiveDeadlineConfig;
+
 }  // namespace server::handlers::impl
 
 USERVER_NAMESPACE_END
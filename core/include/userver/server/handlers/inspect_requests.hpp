@@ -28,6 +28,13 @@ namespace handlers {
 /// ## Scheme
 /// Provide an optional query parameter `body` to get the bodies of all the
 /// in-flight requests.
+///
+/// Provide an optional query parameter `slowest=N` to get only the N longest
+/// running requests, the longest first.
+///
+/// The in-flight requests are only remembered if this handler is registered.
+/// The registration does not synchronize the requests on different CPUs and
+/// the handler walks all of them only on demand.
 
 // clang-format on
 class InspectRequests final : public HttpHandlerJsonBase {
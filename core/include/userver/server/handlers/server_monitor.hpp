@@ -3,8 +3,10 @@
 /// @file userver/server/handlers/server_monitor.hpp
 /// @brief @copybrief server::handlers::ServerMonitor
 
+#include <userver/engine/mutex.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -39,6 +41,11 @@ namespace server::handlers {
 ///   be a JSON dictionary in the form '{"label1":"value1", "label2":"value2"}'.
 /// * path - return metrics on for the following path
 /// * prefix - return metrics whose path starts from the specified prefix.
+///
+/// Rendered Prometheus metric names and labels are cached between the
+/// requests. With `response-body-stream: true` in the static config the
+/// Prometheus output is sent in chunks as it is formatted, without
+/// accumulating the whole response in memory.
 
 // clang-format on
 class ServerMonitor final : public HttpHandlerBase {
@@ -53,6 +60,10 @@ class ServerMonitor final : public HttpHandlerBase {
   std::string HandleRequestThrow(const http::HttpRequest& request,
                                  request::RequestContext&) const override;
 
+  void HandleStreamRequest(
+      const http::HttpRequest& request, request::RequestContext&,
+      http::ResponseBodyStream& response_body_stream) const override;
+
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
@@ -60,10 +71,19 @@ class ServerMonitor final : public HttpHandlerBase {
       const http::HttpRequest& request, request::RequestContext& context,
       const std::string& response_data) const override;
 
+  void FormatPrometheus(
+      bool typed, const utils::statistics::Request& statistics_request,
+      utils::function_ref<void(std::string&&)> consumer) const;
+
   utils::statistics::Storage& statistics_storage_;
 
   using CommonLabels = std::unordered_map<std::string, std::string>;
   const CommonLabels common_labels_;
+
+  // Only one request at a time uses the cache, the concurrent ones
+  // format the metrics from scratch
+  mutable engine::Mutex prometheus_cache_mutex_;
+  mutable utils::statistics::PrometheusFormatCache prometheus_cache_;
 };
 
 }  // namespace server::handlers
@@ -0,0 +1,67 @@
+#pragma once
+
+/// @file userver/server/handlers/startup_report.hpp
+/// @brief @copybrief server::handlers::StartupReport
+
+#include <userver/server/handlers/http_handler_json_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+class Manager;
+}  // namespace components
+
+namespace server::handlers {
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that returns the components startup timings.
+///
+/// The component has no service configuration except the
+/// @ref userver_http_handlers "common handler options".
+///
+/// ## Static configuration example:
+///
+/// @snippet components/common_server_component_list_test.cpp  Sample handler startup report component config
+///
+/// ## Scheme
+/// Returns a JSON object with the following fields:
+/// * `load-ms` - time from the start of the components loading until all the
+///   components are loaded
+/// * `critical-path` - the chain of components that defines the construction
+///   time: each of them waited for the previous one in FindComponent()
+/// * `components` - for each component the start of its construction
+///   relative to the start of the components loading, the construction
+///   duration, the time its constructor was blocked waiting for other
+///   components and the duration of its OnAllComponentsLoaded()
+
+// clang-format on
+class StartupReport final : public HttpHandlerJsonBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of server::handlers::StartupReport
+  static constexpr std::string_view kName = "handler-startup-report";
+
+  StartupReport(const components::ComponentConfig& config,
+                const components::ComponentContext& component_context);
+
+  formats::json::Value HandleRequestJsonThrow(
+      const http::HttpRequest& request,
+      const formats::json::Value& request_json,
+      request::RequestContext& context) const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  const components::Manager& manager_;
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool
+    components::kHasValidate<server::handlers::StartupReport> = true;
+
+USERVER_NAMESPACE_END
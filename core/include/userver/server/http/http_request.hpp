@@ -5,6 +5,7 @@
 
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -28,6 +29,7 @@ class Sockaddr;
 namespace server::http {
 
 class HttpRequestImpl;
+class RequestBodyStream;
 
 /// @brief HTTP Request data
 class HttpRequest final {
@@ -187,9 +189,22 @@ class HttpRequest final {
   /// @return List of cookies names.
   CookiesMapKeys GetCookieNames() const;
 
-  /// @return HTTP body.
+  /// @return HTTP body. Empty if the body is streamed, see IsBodyStreamed().
   const std::string& RequestBody() const;
 
+  /// @return HTTP body that can be passed to
+  /// clients::http::Request::data() without a copy, e.g. by proxy handlers.
+  /// Empty if the body is streamed, see IsBodyStreamed().
+  std::shared_ptr<const std::string> GetSharedRequestBody() const;
+
+  /// @return Incremental reader of the HTTP body. Reads RequestBody() if the
+  /// body is not streamed.
+  RequestBodyStream& GetBodyStream() const;
+
+  /// @return true if the body is passed to the handler as it is received,
+  /// see `request-body-stream` option of server::handlers::HandlerBase
+  bool IsBodyStreamed() const;
+
   /// @return HTTP headers.
   const HeadersMap& RequestHeaders() const;
 
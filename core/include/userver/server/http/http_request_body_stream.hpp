@@ -0,0 +1,95 @@
+#pragma once
+
+/// @file userver/server/http/http_request_body_stream.hpp
+/// @brief @copybrief server::http::RequestBodyStream
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace impl {
+
+enum class BodyStreamStatus {
+  kReading,
+  kComplete,
+  kTooLarge,
+};
+
+using BodyStreamStatusPtr = std::shared_ptr<std::atomic<BodyStreamStatus>>;
+
+}  // namespace impl
+
+/// @brief Incremental reader of the HTTP request body.
+///
+/// With `request-body-stream: true` in the static config of the handler the
+/// request is passed to the handler right after its headers are received,
+/// and the body is read from the stream while the client sends it. The
+/// connection stops reading from the socket while the handler is behind, so
+/// only a small part of the body is kept in memory.
+///
+/// For the requests that are not streamed (e.g. HTTP/2 ones or the handlers
+/// without the option), the stream reads the already received
+/// server::http::HttpRequest::RequestBody().
+///
+/// @note The body is not decompressed, arguments and multipart/form-data are
+/// not parsed from the streamed body. See server::http::MultipartFormDataStream
+/// for the incremental multipart/form-data parsing.
+class RequestBodyStream final {
+ public:
+  using Queue = concurrent::StringStreamQueue;
+
+  RequestBodyStream(RequestBodyStream&&) = delete;
+  RequestBodyStream& operator=(RequestBodyStream&&) = delete;
+  ~RequestBodyStream();
+
+  /// Reads up to `size` bytes of the body into `buf`, waits for the data if
+  /// none is received yet.
+  /// @returns the number of bytes read, 0 if the whole body is read
+  /// @throws engine::io::IoTimeout if the deadline is reached
+  /// @throws engine::io::IoCancelled if the task is cancelled
+  /// @throws server::handlers::CustomHandlerException if the body is
+  /// incomplete or exceeds `max_request_size`
+  std::size_t ReadSome(char* buf, std::size_t size,
+                       engine::Deadline deadline = {});
+
+  /// Reads the next part of the body into `output`, any previous data in
+  /// `output` is dropped. The part size is not related to the HTTP chunks.
+  /// @returns false if the whole body is read
+  /// @throws the same exceptions as ReadSome()
+  bool ReadChunk(std::string& output, engine::Deadline deadline = {});
+
+  /// @returns true if the whole body was read
+  bool IsFinished() const noexcept { return is_finished_; }
+
+  /// @cond
+  // For internal use only
+  RequestBodyStream(Queue::Consumer&& queue_consumer,
+                    impl::BodyStreamStatusPtr status);
+
+  // Reads the already received body
+  explicit RequestBodyStream(std::string_view body);
+  /// @endcond
+
+ private:
+  bool FetchChunk(engine::Deadline deadline);
+
+  std::optional<Queue::Consumer> queue_consumer_;
+  impl::BodyStreamStatusPtr status_;
+  std::string chunk_;
+  std::string_view available_;
+  bool is_finished_{false};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
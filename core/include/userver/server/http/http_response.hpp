@@ -4,8 +4,11 @@
 /// @brief @copybrief server::http::HttpResponse
 
 #include <chrono>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/single_consumer_event.hpp>
@@ -20,6 +23,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace fs::blocking {
+class MappedFile;
+}  // namespace fs::blocking
+
 namespace server::http {
 
 namespace impl {
@@ -30,6 +37,7 @@ void OutputHeader(USERVER_NAMESPACE::http::headers::HeadersString& header,
 }  // namespace impl
 
 class HttpRequestImpl;
+class Http2Session;
 
 /// @brief HTTP Response data
 class HttpResponse final : public request::ResponseBase {
@@ -137,7 +145,56 @@ class HttpResponse final : public request::ResponseBase {
   // Can be called only once
   Queue::Producer GetBodyProducer();
 
+  /// @brief Use the contents of the mapped file as the response body.
+  ///
+  /// For plain TCP connections the file is sent directly from the page cache
+  /// with sendfile, otherwise the mapped memory is written to the connection.
+  /// The body set with SetData() takes precedence if not empty.
+  void SetFileBody(std::shared_ptr<const fs::blocking::MappedFile> file);
+
+  /// @cond
+  /// Headers formatted in advance, e.g. the static headers of a handler
+  struct PreparedHeaders {
+    /// For HTTP/2 and for GetHeader()/HasHeader()
+    HeadersMap headers;
+    /// The same headers in HTTP/1.x format, each one ends with CRLF
+    std::string http1;
+  };
+
+  /// @throws std::runtime_error on invalid header names or values and on the
+  /// headers that are produced for each response: Date, Connection,
+  /// Content-Length and Transfer-Encoding
+  static std::shared_ptr<const PreparedHeaders> MakePreparedHeaders(
+      HeadersMap headers);
+
+  // For internal use only. The prepared headers are sent along with the ones
+  // of SetHeader(), the latter take precedence.
+  void SetPreparedHeaders(std::shared_ptr<const PreparedHeaders> headers);
+  const std::shared_ptr<const PreparedHeaders>& GetPreparedHeaders() const {
+    return prepared_headers_;
+  }
+  /// @endcond
+
  private:
+  friend class Http2Session;
+
+  struct Http2Response {
+    /// Lowercase names, without the connection-specific headers
+    std::vector<std::pair<std::string, std::string>> headers;
+    /// Not streamed body to send, empty for HEAD requests and for statuses
+    /// that forbid the body
+    std::string_view body;
+    bool is_body_streamed{false};
+  };
+
+  // For Http2Session
+  Http2Response PrepareHttp2Response();
+
+  bool IsPreparedHeaderOverridden(std::string_view name) const;
+
+  void OutputPreparedHeaders(
+      USERVER_NAMESPACE::http::headers::HeadersString& header) const;
+
   // Returns total size of the response
   std::size_t SetBodyStreamed(
       engine::io::RwBase& socket,
@@ -148,6 +205,11 @@ class HttpResponse final : public request::ResponseBase {
       engine::io::RwBase& socket,
       USERVER_NAMESPACE::http::headers::HeadersString& header);
 
+  // Returns total size of the response
+  std::size_t SetBodyFromFile(
+      engine::io::RwBase& socket,
+      USERVER_NAMESPACE::http::headers::HeadersString& header);
+
   const HttpRequestImpl& request_;
   HttpStatus status_ = HttpStatus::kOk;
   HeadersMap headers_;
@@ -156,6 +218,8 @@ class HttpResponse final : public request::ResponseBase {
   engine::SingleConsumerEvent headers_end_;
   std::optional<Queue::Consumer> body_stream_;
   std::optional<Queue::Producer> body_stream_producer_;
+  std::shared_ptr<const fs::blocking::MappedFile> file_body_;
+  std::shared_ptr<const PreparedHeaders> prepared_headers_;
 };
 
 void SetThrottleReason(http::HttpResponse& http_response,
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <memory>
 #include <string>
 
 #include <userver/server/http/http_response.hpp>
@@ -11,16 +14,32 @@ namespace server::handlers {
 class HttpHandlerBase;
 }
 
+namespace compression::gzip {
+class Compressor;
+}
+
 namespace server::http {
 
 class ResponseBodyStream final {
  public:
-  ResponseBodyStream(ResponseBodyStream&&) = default;
+  ResponseBodyStream(ResponseBodyStream&&) noexcept;
+  ~ResponseBodyStream();
 
   // Send a chunk of response data. It may NOT generate
   // exactly one HTTP chunk per call to PushBodyChunk().
+  // The chunk is compressed if the compression of the response is enabled
+  // in the handler config and is accepted by the client.
+  // With `response-body-stream-buffer-size` in the handler config the chunks
+  // are coalesced in a buffer that is sent once it is full or once its first
+  // chunk has waited for `response-body-stream-flush-delay`. Blocks while the
+  // client does not read the already sent data.
   void PushBodyChunk(std::string&& chunk, engine::Deadline deadline);
 
+  // Sends the chunks coalesced by PushBodyChunk() right away, e.g. before
+  // waiting for the next event to stream. Does nothing if the buffering is
+  // not enabled.
+  void Flush(engine::Deadline deadline);
+
   void SetHeader(const std::string&, const std::string&);
 
   void SetHeader(std::string_view, const std::string&);
@@ -38,7 +57,24 @@ class ResponseBodyStream final {
       server::http::HttpResponse::Queue::Producer&& queue_producer,
       server::http::HttpResponse& http_response);
 
+  // Must be called before SetEndOfHeaders()
+  void EnableCompression(int level);
+
+  // Must be called before PushBodyChunk()
+  void EnableBuffering(std::size_t buffer_size,
+                       std::chrono::milliseconds flush_delay);
+
+  // Sends the buffered data and the end of the compressed body, may be called
+  // several times
+  void Finish() noexcept;
+  void FinishCompression() noexcept;
+
+  struct Buffer;
+
   bool headers_ended_{false};
+  std::unique_ptr<compression::gzip::Compressor> compressor_;
+  // Owns the queue_producer_ if the buffering is enabled
+  std::unique_ptr<Buffer> buffer_;
   HttpResponse::Queue::Producer queue_producer_;
   server::http::HttpResponse& http_response_;
 };
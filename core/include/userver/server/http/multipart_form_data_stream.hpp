@@ -0,0 +1,92 @@
+#pragma once
+
+/// @file userver/server/http/multipart_form_data_stream.hpp
+/// @brief @copybrief server::http::MultipartFormDataStream
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+class HttpRequest;
+class RequestBodyStream;
+class MultipartFormDataStreamParser;
+
+/// @brief Incremental reader of the multipart/form-data request body.
+///
+/// Reads the parts from server::http::HttpRequest::GetBodyStream() one by
+/// one, the part values are not accumulated in memory. Intended for the
+/// handlers with `request-body-stream: true` in the static config, for them
+/// server::http::HttpRequest::GetFormDataArg() is not filled.
+///
+/// @code
+/// server::http::MultipartFormDataStream form_data{request};
+/// while (form_data.NextPart(deadline)) {
+///   std::string chunk;
+///   while (form_data.ReadChunk(chunk, deadline)) {
+///     Store(form_data.GetName(), chunk);
+///   }
+/// }
+/// @endcode
+///
+/// @note Only CRLF line breaks are supported, the `_charset_` part is
+/// returned as is.
+class MultipartFormDataStream final {
+ public:
+  /// @throws server::handlers::RequestParseError if the request is not a
+  /// multipart/form-data one
+  explicit MultipartFormDataStream(const HttpRequest& request);
+
+  MultipartFormDataStream(MultipartFormDataStream&&) = delete;
+  MultipartFormDataStream& operator=(MultipartFormDataStream&&) = delete;
+  ~MultipartFormDataStream();
+
+  /// Skips the rest of the current part and reads the headers of the next
+  /// one.
+  /// @returns false if there are no more parts
+  /// @throws server::handlers::RequestParseError on malformed body and the
+  /// exceptions of server::http::RequestBodyStream::ReadSome()
+  bool NextPart(engine::Deadline deadline = {});
+
+  /// Reads up to `size` bytes of the current part value into `buf`.
+  /// @returns the number of bytes read, 0 if the whole value is read
+  /// @throws the same exceptions as NextPart()
+  std::size_t ReadSome(char* buf, std::size_t size,
+                       engine::Deadline deadline = {});
+
+  /// Reads the next part of the current part value into `output`, any
+  /// previous data in `output` is dropped.
+  /// @returns false if the whole value is read
+  /// @throws the same exceptions as NextPart()
+  bool ReadChunk(std::string& output, engine::Deadline deadline = {});
+
+  /// @name Headers of the current part, valid after NextPart() returned true
+  /// @{
+  const std::string& GetName() const;
+  const std::optional<std::string>& GetFilename() const;
+  const std::optional<std::string>& GetContentType() const;
+  const std::string& GetContentDisposition() const;
+  /// @}
+
+ private:
+  bool FetchValueData(engine::Deadline deadline);
+  void FetchBody(engine::Deadline deadline);
+
+  RequestBodyStream& body_;
+  std::unique_ptr<MultipartFormDataStreamParser> parser_;
+  std::string chunk_;
+  std::string_view available_;
+  bool has_part_{false};
+  bool is_part_finished_{true};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -24,6 +24,7 @@ class RequestBase {
   virtual ~RequestBase();
 
   virtual bool IsFinal() const = 0;
+  virtual bool IsBodyStreamed() const = 0;
   virtual bool IsUpgradeWebsocket() const = 0;
   virtual void DoUpgrade(std::unique_ptr<engine::io::RwBase>&& socket,
                          engine::io::Sockaddr&& peer_name) const = 0;
@@ -49,6 +50,14 @@ class RequestBase {
     return start_time_;
   }
 
+  std::chrono::steady_clock::time_point TaskCreateTime() const {
+    return task_create_time_;
+  }
+
+  std::chrono::steady_clock::time_point TaskStartTime() const {
+    return task_start_time_;
+  }
+
   virtual void MarkAsInternalServerError() const = 0;
 
   virtual void AccountResponseTime() = 0;
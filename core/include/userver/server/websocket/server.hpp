@@ -5,6 +5,8 @@
 
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
 
 #include <userver/engine/io/socket.hpp>
 #include <userver/server/http/http_request.hpp>
@@ -48,6 +50,9 @@ class WebSocketConnectionImpl;
 struct Config final {
   unsigned max_remote_payload = 65536;
   unsigned fragment_size = 65536;  // 0 - do not fragment
+  bool permessage_deflate = false;
+  bool deflate_server_no_context_takeover = false;
+  bool deflate_client_no_context_takeover = false;
 };
 
 Config Parse(const yaml_config::YamlConfig&, formats::parse::To<Config>);
@@ -59,6 +64,28 @@ struct Statistics final {
   std::atomic<int64_t> bytes_recv{0};
 };
 
+/// @brief Data message serialized into a WebSocket frame once, to be sent to
+/// many connections by WebSocketConnection::SendPrepared() without
+/// serializing, fragmenting or compressing it for each of them.
+///
+/// The message is sent as a single frame regardless of the `fragment-size`.
+class PreparedMessage final {
+ public:
+  /// @param compress also compress the frame for the connections that have
+  /// negotiated permessage-deflate with server_no_context_takeover, the rest
+  /// of the connections get the uncompressed frame
+  PreparedMessage(std::string_view data, bool is_text, bool compress = false);
+
+  std::size_t GetPayloadSize() const noexcept { return payload_size_; }
+
+ private:
+  friend class WebSocketConnectionImpl;
+
+  std::string frame_;
+  std::string compressed_frame_;
+  std::size_t payload_size_;
+};
+
 /// @brief Main class for Websocket connection
 class WebSocketConnection {
  public:
@@ -91,6 +118,10 @@ class WebSocketConnection {
   virtual void Send(const Message& message) = 0;
   virtual void SendText(std::string_view message) = 0;
 
+  /// @brief Send a prepared message, see PreparedMessage.
+  /// @throws engine::io::IoException in case of socket errors
+  virtual void SendPrepared(const PreparedMessage& message) = 0;
+
   template <typename ContiguousContainer>
   void SendBinary(const ContiguousContainer& message) {
     static_assert(sizeof(typename ContiguousContainer::value_type) == 1,
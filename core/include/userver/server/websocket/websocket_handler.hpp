@@ -28,6 +28,9 @@ namespace server::websocket {
 /// status-codes-log-level | map of "status": log_level items to override span log level for specific status codes | {}
 /// max-remote-payload | max remote payload size | 65536
 /// fragment-size | max output fragment size | 65536
+/// permessage-deflate | accept the permessage-deflate extension offered by the clients and compress the messages | false
+/// deflate-server-no-context-takeover | compress each message independently, uses less memory and allows sending the compressed websocket::PreparedMessage | false
+/// deflate-client-no-context-takeover | ask the clients to compress each message independently, uses less memory for the decompression | false
 ///
 /// ## Example usage:
 ///
@@ -26,6 +26,10 @@ namespace components {
 /// ---- | ----------- | -------------
 /// service-name | name of the service to write in traces | ''
 /// tracer | type of the tracer to trace, currently supported only 'native' | 'native'
+/// tail-sampling | if set, the spans of a trace are buffered until its root span ends, and only failed, slow and randomly sampled traces are logged, see tracing::TailSamplingSettings | -
+/// tail-sampling.max-spans | spans of a trace over this number are dropped while the trace is buffered | 1000
+/// tail-sampling.latency-threshold | traces with the root span at least this long are logged | 1s
+/// tail-sampling.sample-rate | probability to log a trace that is neither failed nor slow | 0.01
 ///
 /// ## Static configuration example:
 ///
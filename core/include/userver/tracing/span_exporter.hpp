@@ -0,0 +1,48 @@
+#pragma once
+
+/// @file userver/tracing/span_exporter.hpp
+/// @brief @copybrief tracing::SpanExporter
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <userver/logging/log_extra.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+/// A finished span passed to tracing::SpanExporter
+struct ExportedSpan final {
+  std::string name;
+  std::string trace_id;
+  std::string span_id;
+  std::string parent_id;
+
+  std::chrono::system_clock::time_point start_time;
+  std::chrono::system_clock::time_point end_time;
+
+  /// The span has the tracing::kErrorFlag tag set
+  bool is_failed{false};
+
+  /// Inheritable and non-inheritable tags of the span
+  std::vector<std::pair<std::string, logging::LogExtra::Value>> attributes;
+};
+
+/// @brief Base class for the exporters of the finished spans into external
+/// tracing systems, see tracing::Tracer::SetSpanExporter.
+///
+/// Export is called on the destruction of every span that passes the log
+/// level checks, independently of the span logging, so it must not block.
+class SpanExporter {
+ public:
+  virtual ~SpanExporter();
+
+  virtual void Export(ExportedSpan&& span) = 0;
+};
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 
 #include <userver/tracing/span.hpp>
@@ -16,12 +19,40 @@ class TagWriter;
 namespace tracing {
 
 struct NoLogSpans;
+class SpanExporter;
+
+/// @brief Settings of the tail-based sampling of traces.
+///
+/// The spans of a trace are buffered until its local root span ends. Then the
+/// whole trace is either logged or dropped: failed traces (with the
+/// tracing::kErrorFlag tag or with spans of the error level) and traces with
+/// the root span longer than `latency_threshold` are always logged, other
+/// traces are logged with the `sample_rate` probability.
+struct TailSamplingSettings final {
+  /// Spans of a trace over this number are dropped while the trace is buffered
+  std::size_t max_spans{1000};
+
+  /// Traces with a root span that is at least this long are logged
+  std::chrono::milliseconds latency_threshold{1000};
+
+  /// Probability to log a trace that is neither failed nor slow
+  double sample_rate{0.01};
+};
 
 class Tracer : public std::enable_shared_from_this<Tracer> {
  public:
   static void SetNoLogSpans(NoLogSpans&& spans);
   static bool IsNoLogSpan(const std::string& name);
 
+  /// Enables the tail-based sampling of the traces started after the call,
+  /// or disables it if `settings` is `std::nullopt`
+  static void SetTailSampling(std::optional<TailSamplingSettings> settings);
+  static std::optional<TailSamplingSettings> GetTailSampling();
+
+  /// Sets the exporter of the finished spans, nullptr to disable the export
+  static void SetSpanExporter(std::shared_ptr<SpanExporter> exporter);
+  static std::shared_ptr<SpanExporter> GetSpanExporter();
+
   static void SetTracer(TracerPtr tracer);
 
   static TracerPtr GetTracer();
@@ -121,6 +121,10 @@ inline auto SpanLazyPrvalue(std::string&& name) {
 /// parameter. If the deadline expires, the task is cancelled. See `*Async*`
 /// function signatures for details.
 ///
+/// By stack size: `utils::Async` and `engine::AsyncNoSpan` accept an
+/// engine::StackSize parameter to run a task with a deep call stack on a
+/// bigger coroutine stack than the task processor default.
+///
 /// ## Lifetime of captures
 ///
 /// @note To launch background tasks, which are not awaited in the local scope,
@@ -415,6 +419,46 @@ template <typename Function, typename... Args>
                       std::forward<Args>(args)...);
 }
 
+/// @overload
+/// @ingroup userver_concurrency
+///
+/// Task execution may be cancelled before the function starts execution
+/// in case of TaskProcessor overload.
+///
+/// @param task_processor Task processor to run on
+/// @param name Name of the task to show in logs
+/// @param stack_size Minimal coroutine stack size for the task
+/// @param f Function to execute asynchronously
+/// @param args Arguments to pass to the function
+/// @returns engine::TaskWithResult
+template <typename Function, typename... Args>
+[[nodiscard]] auto Async(engine::TaskProcessor& task_processor,
+                         std::string name, engine::StackSize stack_size,
+                         Function&& f, Args&&... args) {
+  return engine::AsyncNoSpan(
+      task_processor, stack_size, impl::SpanLazyPrvalue(std::move(name)),
+      std::forward<Function>(f), std::forward<Args>(args)...);
+}
+
+/// @overload
+/// @ingroup userver_concurrency
+///
+/// Task execution may be cancelled before the function starts execution
+/// in case of TaskProcessor overload.
+///
+/// @param name Name of the task to show in logs
+/// @param stack_size Minimal coroutine stack size for the task
+/// @param f Function to execute asynchronously
+/// @param args Arguments to pass to the function
+/// @returns engine::TaskWithResult
+template <typename Function, typename... Args>
+[[nodiscard]] auto Async(std::string name, engine::StackSize stack_size,
+                         Function&& f, Args&&... args) {
+  return utils::Async(engine::current_task::GetTaskProcessor(), std::move(name),
+                      stack_size, std::forward<Function>(f),
+                      std::forward<Args>(args)...);
+}
+
 /// @overload
 /// @ingroup userver_concurrency
 ///
@@ -3,7 +3,9 @@
 /// @file userver/utils/periodic_task.hpp
 /// @brief @copybrief utils::PeriodicTask
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <string>
@@ -52,6 +54,9 @@ class PeriodicTask final {
     /// Subtasks that may be spawned in the callback
     /// are not critical by default and may be cancelled as usual.
     kCritical = 1 << 4,
+    /// Wait for a random part of the period before the first iteration, so
+    /// that the tasks started at the same time do not run at the same moments
+    kSpread = 1 << 5,
   };
 
   /// Configuration parameters for PeriodicTask.
@@ -109,12 +114,34 @@ class PeriodicTask final {
     /// uses this logging level.
     logging::Level span_level{logging::Level::kInfo};
 
+    /// @brief Wakeup time is rounded up to a multiple of this duration, so
+    /// that the periodic tasks due within the same quantum are woken up by
+    /// the same timer event. Zero disables the rounding.
+    std::chrono::milliseconds wakeup_quantum{0};
+
+    /// @brief If the task queue wait time of the TaskProcessor exceeds its
+    /// overload threshold, the iteration is postponed until the overload goes
+    /// away, but for no longer than this duration. Zero disables postponing.
+    std::chrono::milliseconds max_overload_deferral{0};
+
     /// @brief TaskProcessor to execute the task. If nullptr then the
     /// PeriodicTask::Start() calls engine::current_task::GetTaskProcessor()
     /// to get the TaskProcessor.
     engine::TaskProcessor* task_processor{nullptr};
   };
 
+  /// Scheduling statistics of the periodic iterations
+  struct Statistics final {
+    /// Iterations started by the timer
+    std::uint64_t steps{0};
+    /// Iterations postponed because of the TaskProcessor overload
+    std::uint64_t deferred_steps{0};
+    /// Delay between the planned and the actual wakeup of the last iteration
+    std::chrono::microseconds last_lag{0};
+    /// Maximum delay between the planned and the actual wakeup
+    std::chrono::microseconds max_lag{0};
+  };
+
   /// Signature of the task to be executed each period.
   using Callback = std::function<void()>;
 
@@ -193,6 +220,9 @@ class PeriodicTask final {
   /// Get current settings. Note that they might become stale very quickly.
   Settings GetCurrentSettings() const;
 
+  /// Get the scheduling statistics since the construction of the task.
+  Statistics GetStatistics() const;
+
  private:
   enum class SuspendState { kRunning, kSuspended };
 
@@ -208,6 +238,14 @@ class PeriodicTask final {
 
   std::chrono::milliseconds MutatePeriod(std::chrono::milliseconds period);
 
+  std::chrono::steady_clock::time_point MakeWakeupTime(
+      std::chrono::steady_clock::time_point start,
+      std::chrono::milliseconds period, bool is_first_wait);
+
+  void AccountWakeupLag(std::chrono::steady_clock::time_point planned);
+
+  void DeferOnOverload();
+
   rcu::Variable<std::string> name_;
   Callback callback_;
   engine::TaskWithResult<void> task_;
@@ -219,9 +257,23 @@ class PeriodicTask final {
   engine::Mutex step_mutex_;
   std::atomic<SuspendState> suspend_state_;
 
+  std::atomic<std::uint64_t> steps_{0};
+  std::atomic<std::uint64_t> deferred_steps_{0};
+  std::atomic<std::chrono::microseconds> last_lag_{};
+  std::atomic<std::chrono::microseconds> max_lag_{};
+
   std::optional<testsuite::PeriodicTaskRegistrationHolder> registration_holder_;
 };
 
+namespace statistics {
+class Writer;
+}  // namespace statistics
+
+/// @brief PeriodicTask::Statistics values support for
+/// utils::statistics::Writer
+void DumpMetric(statistics::Writer& writer,
+                const PeriodicTask::Statistics& stats);
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
@@ -57,6 +57,9 @@ struct BoundsBlock;
 ///
 /// Histogram can be used in utils::statistics::MetricTag:
 /// @snippet utils/statistics/histogram_test.cpp  metric tag
+///
+/// @see utils::statistics::ShardedHistogram for the histograms accounted
+/// from many threads at a high rate
 class Histogram final {
  public:
   /// Sets upper bounds for each non-"infinite" bucket. The lowest bound is
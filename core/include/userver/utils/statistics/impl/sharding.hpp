@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+/// Number of shards of the sharded metrics, one per CPU
+std::size_t GetShardCount() noexcept;
+
+/// Shard of the CPU the current thread runs on, in [0, GetShardCount()).
+/// The thread may migrate to another CPU right after the call, so the shards
+/// must still be updated atomically.
+std::size_t GetCurrentShard() noexcept;
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
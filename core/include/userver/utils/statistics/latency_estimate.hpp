@@ -0,0 +1,82 @@
+#pragma once
+
+/// @file userver/utils/statistics/latency_estimate.hpp
+/// @brief @copybrief utils::statistics::LatencyEstimate
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief Cheap streaming estimate of the median and the 90th percentile of
+/// an operation latency, e.g. to reject operations that can not finish before
+/// the deadline.
+///
+/// Unlike utils::statistics::Percentile it is not a metric: it takes two
+/// atomics, can be read on each operation and adapts to the latency changes
+/// within a few hundred samples. Each sample moves the estimate by a small
+/// relative step towards the sample, the steps up and down are weighted so
+/// that the estimate settles at the quantile.
+///
+/// Thread-safe, the concurrent updates may be lost.
+class LatencyEstimate final {
+ public:
+  using Duration = std::chrono::microseconds;
+
+  void Account(Duration latency) noexcept {
+    const auto sample = static_cast<std::int64_t>(latency.count());
+    Update(p50_, sample, 50);
+    Update(p90_, sample, 90);
+    samples_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  Duration GetP50() const noexcept {
+    return Duration{p50_.load(std::memory_order_relaxed)};
+  }
+
+  Duration GetP90() const noexcept {
+    return Duration{p90_.load(std::memory_order_relaxed)};
+  }
+
+  /// The estimates are not meaningful until enough samples are accounted
+  std::uint64_t GetSamplesCount() const noexcept {
+    return samples_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // The step is 1/kStepDivisor of the estimate
+  static constexpr std::int64_t kStepDivisor = 32;
+
+  static void Update(std::atomic<std::int64_t>& estimate, std::int64_t sample,
+                     std::int64_t percent) noexcept {
+    const auto current = estimate.load(std::memory_order_relaxed);
+    if (current == 0) {
+      estimate.store(sample, std::memory_order_relaxed);
+      return;
+    }
+
+    const auto step = current / kStepDivisor + 1;
+    auto next = current;
+    if (sample > current) {
+      next = current + step * percent / 100 + 1;
+      if (next > sample) next = sample;
+    } else if (sample < current) {
+      next = current - step * (100 - percent) / 100 - 1;
+      if (next < sample) next = sample;
+    }
+    // Zero is reserved for "no samples"
+    if (next < 1) next = 1;
+    estimate.store(next, std::memory_order_relaxed);
+  }
+
+  std::atomic<std::int64_t> p50_{0};
+  std::atomic<std::int64_t> p90_{0};
+  std::atomic<std::uint64_t> samples_{0};
+};
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,197 @@
+#pragma once
+
+/// @file userver/utils/statistics/log_linear_histogram.hpp
+/// @brief @copybrief utils::statistics::LogLinearHistogram
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief Log-linear (HDR-style) histogram of non-negative integer values,
+/// e.g. latencies in microseconds.
+///
+/// Values below `2^(PrecisionBits+1)` are stored precisely. Each next power
+/// of two range is split into `2^PrecisionBits` linear buckets, so that the
+/// relative error of the stored values is at most `2^-PrecisionBits`
+/// (~3% by default) for the whole range from 0 to `2^MaxValueBits - 1`.
+/// Greater values are accounted as the greatest one.
+///
+/// Unlike utils::statistics::Percentile, the memory does not grow linearly
+/// with the range of the values, and unlike utils::statistics::Histogram,
+/// the bounds need not be chosen manually. Account is O(1), merging
+/// LogLinearHistogram across threads or utils::statistics::RecentPeriod
+/// epochs is a sum of the buckets.
+///
+/// Percentiles are available via GetPercentile. For export, the buckets are
+/// merged into power of two buckets of a utils::statistics::Histogram,
+/// which is summable across hosts and is supported by Solomon and Prometheus
+/// formats.
+///
+/// @code
+/// using Timings = utils::statistics::RecentPeriod<
+///     utils::statistics::LogLinearHistogram<>,
+///     utils::statistics::LogLinearHistogram<>>;
+///
+/// void Account(Timings& timings, std::chrono::microseconds us) {
+///   timings.GetCurrentCounter().Account(us.count());
+/// }
+/// @endcode
+///
+/// @tparam PrecisionBits the number of linear buckets of each power of two
+/// range is `2^PrecisionBits`
+/// @tparam MaxValueBits the values up to `2^MaxValueBits - 1` are stored
+template <std::size_t PrecisionBits = 5, std::size_t MaxValueBits = 32>
+class LogLinearHistogram final {
+  static_assert(PrecisionBits >= 1 && PrecisionBits < MaxValueBits &&
+                MaxValueBits <= 64);
+
+ public:
+  static constexpr std::uint64_t kMaxValue =
+      MaxValueBits == 64 ? std::numeric_limits<std::uint64_t>::max()
+                         : (std::uint64_t{1} << (MaxValueBits % 64)) - 1;
+
+  LogLinearHistogram() noexcept = default;
+
+  LogLinearHistogram(const LogLinearHistogram& other) noexcept {
+    *this = other;
+  }
+
+  LogLinearHistogram& operator=(const LogLinearHistogram& other) noexcept {
+    if (this == &other) return *this;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      buckets_[i].store(other.buckets_[i].load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+    }
+    return *this;
+  }
+
+  /// Atomically increment the bucket corresponding to the given value.
+  void Account(std::uint64_t value, std::uint64_t count = 1) noexcept {
+    buckets_[BucketIndex(value)].fetch_add(count, std::memory_order_relaxed);
+  }
+
+  /// Add the other histogram to the current one.
+  template <class Duration = std::chrono::seconds>
+  void Add(const LogLinearHistogram& other,
+           [[maybe_unused]] Duration this_epoch_duration = Duration(),
+           [[maybe_unused]] Duration before_this_epoch_duration = Duration()) {
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      const auto value = other.buckets_[i].load(std::memory_order_relaxed);
+      if (value) buckets_[i].fetch_add(value, std::memory_order_relaxed);
+    }
+  }
+
+  void Reset() noexcept {
+    for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+  }
+
+  /// Total number of the accounted values.
+  std::uint64_t Count() const noexcept {
+    std::uint64_t count = 0;
+    for (const auto& bucket : buckets_) {
+      count += bucket.load(std::memory_order_relaxed);
+    }
+    return count;
+  }
+
+  /// @brief Get X percentile - the greatest value of the first bucket, such
+  /// that the total number of values in the buckets up to it is greater than
+  /// X percent of all of the values.
+  /// @param percent - value in [0..100] - requested percentile
+  ///                  if 100, then returns the greatest value of the last
+  ///                  bucket that has any values in it.
+  std::uint64_t GetPercentile(double percent) const noexcept {
+    const auto count = Count();
+    if (count == 0) return 0;
+
+    const auto want_sum = static_cast<double>(count) * percent;
+    std::uint64_t sum = 0;
+    std::uint64_t max_value = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      const auto value = buckets_[i].load(std::memory_order_relaxed);
+      if (!value) continue;
+      sum += value;
+      max_value = BucketUpperBound(i);
+      if (static_cast<double>(sum) * 100 > want_sum) return max_value;
+    }
+    return max_value;
+  }
+
+  /// Merges the buckets into power of two buckets of a Histogram.
+  Histogram ToHistogram() const {
+    static const auto kBounds = [] {
+      std::vector<double> bounds;
+      for (auto bits = PrecisionBits + 1; bits <= MaxValueBits; ++bits) {
+        bounds.push_back(
+            static_cast<double>(kMaxValue >> (MaxValueBits - bits)));
+      }
+      return bounds;
+    }();
+
+    Histogram histogram{kBounds};
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      const auto value = buckets_[i].load(std::memory_order_relaxed);
+      if (value) {
+        histogram.Account(static_cast<double>(BucketUpperBound(i)), value);
+      }
+    }
+    return histogram;
+  }
+
+ private:
+  static constexpr std::size_t kSubBucketCount = std::size_t{1}
+                                                 << PrecisionBits;
+  static constexpr std::size_t kBucketCount =
+      (MaxValueBits - PrecisionBits + 1) * kSubBucketCount;
+
+  static std::size_t BucketIndex(std::uint64_t value) noexcept {
+    if (value > kMaxValue) value = kMaxValue;
+    if (value < kSubBucketCount) return value;
+
+    const std::size_t exponent = 63 - __builtin_clzll(value);
+    const auto shift = exponent - PrecisionBits;
+    return (shift + 1) * kSubBucketCount +
+           ((value >> shift) - kSubBucketCount);
+  }
+
+  static std::uint64_t BucketUpperBound(std::size_t index) noexcept {
+    if (index < kSubBucketCount) return index;
+
+    const auto shift = index / kSubBucketCount - 1;
+    const auto lower = (kSubBucketCount + index % kSubBucketCount) << shift;
+    return lower + ((std::uint64_t{1} << shift) - 1);
+  }
+
+  std::array<std::atomic<std::uint64_t>, kBucketCount> buckets_{};
+};
+
+/// Metric serialization support for LogLinearHistogram, writes a
+/// utils::statistics::HistogramView with power of two bounds.
+template <std::size_t PrecisionBits, std::size_t MaxValueBits>
+void DumpMetric(
+    Writer& writer,
+    const LogLinearHistogram<PrecisionBits, MaxValueBits>& histogram) {
+  const auto merged = histogram.ToHistogram();
+  writer = merged.GetView();
+}
+
+template <std::size_t PrecisionBits, std::size_t MaxValueBits>
+void ResetMetric(
+    LogLinearHistogram<PrecisionBits, MaxValueBits>& histogram) noexcept {
+  histogram.Reset();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -52,6 +52,7 @@ namespace utils::statistics {
  * total timing percentiles.
  *
  * @see utils::statistics::Histogram for the summable equivalent
+ * @see utils::statistics::LogLinearHistogram for the values of a wide range
  */
 template <size_t M, typename Counter = uint32_t, size_t ExtraBuckets = 0,
           size_t ExtraBucketSize = 500>
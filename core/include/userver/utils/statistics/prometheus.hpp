@@ -3,8 +3,10 @@
 /// @file userver/utils/statistics/prometheus.hpp
 /// @brief Statistics output in Prometheus format.
 
+#include <memory>
 #include <string>
 
+#include <userver/utils/function_ref.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +28,32 @@ std::string ToPrometheusLabel(std::string_view name);
 
 }  // namespace impl
 
+/// @brief Keeps the rendered Prometheus metric names and label sets between
+/// the outputs, so that only the values are formatted on each scrape.
+///
+/// The series that were not output the last time are evicted once they
+/// outnumber the output ones. Not thread-safe.
+class PrometheusFormatCache final {
+ public:
+  PrometheusFormatCache();
+  PrometheusFormatCache(PrometheusFormatCache&&) noexcept;
+  PrometheusFormatCache& operator=(PrometheusFormatCache&&) noexcept;
+  ~PrometheusFormatCache();
+
+  struct Impl;
+
+ private:
+  friend void ToPrometheusFormat(const utils::statistics::Storage&,
+                                 const utils::statistics::Request&,
+                                 PrometheusFormatCache&,
+                                 utils::function_ref<void(std::string&&)>);
+  friend void ToPrometheusFormatUntyped(
+      const utils::statistics::Storage&, const utils::statistics::Request&,
+      PrometheusFormatCache&, utils::function_ref<void(std::string&&)>);
+
+  std::unique_ptr<Impl> impl_;
+};
+
 /// Output `statistics` in Prometheus format, each metric has `gauge` type.
 std::string ToPrometheusFormat(const utils::statistics::Storage& statistics,
                                const utils::statistics::Request& request = {});
@@ -35,6 +63,21 @@ std::string ToPrometheusFormatUntyped(
     const utils::statistics::Storage& statistics,
     const utils::statistics::Request& request = {});
 
+/// @brief Output `statistics` in Prometheus format using the `cache`,
+/// passing the output to the `consumer` in chunks of about 64KB.
+void ToPrometheusFormat(
+    const utils::statistics::Storage& statistics,
+    const utils::statistics::Request& request, PrometheusFormatCache& cache,
+    utils::function_ref<void(std::string&& chunk)> consumer);
+
+/// @brief Output `statistics` in Prometheus format without metric types
+/// using the `cache`, passing the output to the `consumer` in chunks of about
+/// 64KB.
+void ToPrometheusFormatUntyped(
+    const utils::statistics::Storage& statistics,
+    const utils::statistics::Request& request, PrometheusFormatCache& cache,
+    utils::function_ref<void(std::string&& chunk)> consumer);
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,56 @@
+#pragma once
+
+/// @file userver/utils/statistics/sharded_histogram.hpp
+/// @brief @copybrief utils::statistics::ShardedHistogram
+
+#include <cstdint>
+#include <vector>
+
+#include <userver/utils/span.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief utils::statistics::Histogram sharded by CPU to avoid contention
+///
+/// Keeps a separate utils::statistics::Histogram per CPU and sums them up
+/// lazily in Aggregate, e.g. when the metrics are visited.
+///
+/// The histogram takes the memory of a Histogram per CPU, so only use it for
+/// the metrics that are accounted from many threads at a high rate.
+///
+/// This class is represented as a utils::statistics::HistogramView metric
+/// when serializing to statistics.
+class ShardedHistogram final {
+ public:
+  /// Sets upper bounds for each non-"infinite" bucket. The lowest bound is
+  /// always 0.
+  explicit ShardedHistogram(utils::span<const double> upper_bounds);
+
+  ShardedHistogram(const ShardedHistogram&) = delete;
+  ShardedHistogram& operator=(const ShardedHistogram&) = delete;
+  ~ShardedHistogram();
+
+  /// Atomically increment the bucket of the current shard corresponding to
+  /// the given value.
+  void Account(double value, std::uint64_t count = 1) noexcept;
+
+  /// Sums up all the shards, the concurrent increments may be missed
+  Histogram Aggregate() const;
+
+  /// Resets all the shards to zero, the concurrent increments may survive
+  friend void ResetMetric(ShardedHistogram& histogram) noexcept;
+
+ private:
+  std::vector<Histogram> shards_;
+};
+
+/// Metric serialization support for ShardedHistogram.
+void DumpMetric(Writer& writer, const ShardedHistogram& histogram);
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
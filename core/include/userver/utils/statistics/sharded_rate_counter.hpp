@@ -0,0 +1,65 @@
+#pragma once
+
+/// @file userver/utils/statistics/sharded_rate_counter.hpp
+/// @brief @copybrief utils::statistics::ShardedRateCounter
+
+#include <memory>
+
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/rate.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+struct RateCounterShard;
+}  // namespace impl
+
+/// @brief Counter of type Rate, sharded by CPU to avoid contention
+///
+/// Concurrent increments of a utils::statistics::RateCounter from many
+/// threads fight over a single cache line. ShardedRateCounter keeps a
+/// separate cache line per CPU and sums them up lazily in Load, e.g. when the
+/// metrics are visited.
+///
+/// The counter takes a cache line per CPU, so only use it for the metrics
+/// that are incremented from many threads at a high rate.
+///
+/// This class is represented as Rate metric when serializing to statistics.
+class ShardedRateCounter final {
+ public:
+  using ValueType = Rate;
+
+  ShardedRateCounter();
+  ShardedRateCounter(const ShardedRateCounter&) = delete;
+  ShardedRateCounter& operator=(const ShardedRateCounter&) = delete;
+  ~ShardedRateCounter();
+
+  /// Sums up all the shards, the concurrent increments may be missed
+  Rate Load() const noexcept;
+
+  void Add(Rate arg) noexcept;
+
+  ShardedRateCounter& operator++() noexcept {
+    Add(Rate{1});
+    return *this;
+  }
+
+  ShardedRateCounter& operator+=(Rate arg) noexcept {
+    Add(arg);
+    return *this;
+  }
+
+  /// Resets all the shards to zero, the concurrent increments may survive
+  friend void ResetMetric(ShardedRateCounter& value) noexcept;
+
+ private:
+  std::unique_ptr<impl::RateCounterShard[]> shards_;
+};
+
+void DumpMetric(Writer& writer, const ShardedRateCounter& value);
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
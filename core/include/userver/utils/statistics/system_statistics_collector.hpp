@@ -3,6 +3,8 @@
 /// @file userver/utils/statistics/system_statistics_collector.hpp
 /// @brief @copybrief components::SystemStatisticsCollector
 
+#include <memory>
+
 #include <userver/components/component_fwd.hpp>
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -10,6 +12,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace utils::statistics::impl {
+class SelfStatsReader;
+}  // namespace utils::statistics::impl
+
 namespace components {
 
 // clang-format off
@@ -25,9 +31,15 @@ namespace components {
 /// ---- | ----------- | -------------
 /// fs-task-processor | Task processor to use for statistics gathering | -
 /// with-nginx | Whether to collect and report nginx processes statistics | false
+/// with-cgroup | Whether to report the CPU throttling, memory and pressure stall (PSI) statistics of the cgroup v2 of the process as `cgroup.*` metrics | false
+/// with-huge-pages | Whether to report the memory of the process backed by transparent huge pages (`AnonHugePages` of smaps) and the system-wide THP allocation and memory compaction counters of /proc/vmstat as `huge_pages.*` metrics | false
 ///
 /// Note that `with-nginx` is a relatively expensive option as it requires full
-/// process list scan.
+/// process list scan. `with-huge-pages` makes the kernel walk all the memory
+/// mappings of the process on each collection.
+///
+/// The files of the current process and of its cgroup are opened once and
+/// re-read on each collection.
 ///
 /// ## Static configuration example:
 ///
@@ -50,7 +62,10 @@ class SystemStatisticsCollector final : public LoggableComponentBase {
   void ExtendStatistics(utils::statistics::Writer& writer);
 
   const bool with_nginx_;
+  const bool with_cgroup_;
+  const bool with_huge_pages_;
   engine::TaskProcessor& fs_task_processor_;
+  std::unique_ptr<utils::statistics::impl::SelfStatsReader> self_stats_reader_;
   utils::statistics::Entry statistics_holder_;
 };
 
@@ -8,6 +8,7 @@
 #include <userver/http/parser/http_request_parse_args.hpp>
 #include <userver/http/url.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -62,6 +63,22 @@ void BaggageEntry::ConcatenateWith(std::string& header) const {
   }
 }
 
+BaggageEntry BaggageEntry::Rebased(std::string_view old_header,
+                                   std::string_view new_header) const {
+  const auto rebase = [&](std::string_view view) {
+    return new_header.substr(view.data() - old_header.data(), view.size());
+  };
+
+  std::vector<BaggageEntryProperty> properties;
+  properties.reserve(properties_.size());
+  for (const auto& property : properties_) {
+    std::optional<std::string_view> value;
+    if (property.value_) value = rebase(*property.value_);
+    properties.emplace_back(rebase(property.key_), value);
+  }
+  return BaggageEntry(rebase(key_), rebase(value_), std::move(properties));
+}
+
 std::string BaggageEntry::GetValue() const {
   return http::parser::UrlDecode(value_);
 }
@@ -122,7 +139,13 @@ const BaggageEntry& Baggage::GetEntry(const std::string& key) const {
 
 Baggage::Baggage(std::string header,
                  std::unordered_set<std::string> allowed_keys)
+    : Baggage(std::move(header),
+              std::make_shared<const std::unordered_set<std::string>>(
+                  std::move(allowed_keys))) {}
+
+Baggage::Baggage(std::string header, SharedAllowedKeys allowed_keys)
     : header_value_(std::move(header)), allowed_keys_(std::move(allowed_keys)) {
+  UASSERT(allowed_keys_);
   header_value_.erase(
       std::remove_if(header_value_.begin(), header_value_.end(),
                      [](unsigned char x) { return std::isspace(x); }),
@@ -139,10 +162,12 @@ Baggage::Baggage(std::string header,
 Baggage::Baggage(const Baggage& baggage_copy) noexcept
     : allowed_keys_(baggage_copy.allowed_keys_) {
   if (baggage_copy.is_valid_header_) {
+    // the header is copied as is, no need to parse it again
     header_value_ = baggage_copy.header_value_;
-  } else {
-    header_value_ = baggage_copy.result_header_;
+    RebaseEntries(baggage_copy.entries_, baggage_copy.header_value_);
+    return;
   }
+  header_value_ = baggage_copy.result_header_;
   FillEntries();
 
   // if header contains invalid symbols, we should fill result_header_
@@ -154,10 +179,14 @@ Baggage::Baggage(const Baggage& baggage_copy) noexcept
 Baggage::Baggage(Baggage&& baggage_copy) noexcept
     : allowed_keys_(std::move(baggage_copy.allowed_keys_)) {
   if (baggage_copy.is_valid_header_) {
+    // small strings do not keep their buffer on move, so the entries are
+    // rebased instead of being reused
+    const std::string_view old_header{baggage_copy.header_value_};
     header_value_ = std::move(baggage_copy.header_value_);
-  } else {
-    header_value_ = std::move(baggage_copy.result_header_);
+    RebaseEntries(baggage_copy.entries_, old_header);
+    return;
   }
+  header_value_ = std::move(baggage_copy.result_header_);
   FillEntries();
 
   // if header contains invalid symbols, we should fill result_header_
@@ -226,10 +255,14 @@ void Baggage::AddEntry(std::string key, std::string value,
 }
 
 bool Baggage::IsValidEntry(const std::string& key) const {
-  return allowed_keys_.count(key);
+  return allowed_keys_->count(key);
 }
 
 std::unordered_set<std::string> Baggage::GetAllowedKeys() const {
+  return *allowed_keys_;
+}
+
+const SharedAllowedKeys& Baggage::GetSharedAllowedKeys() const {
   return allowed_keys_;
 }
 
@@ -243,6 +276,14 @@ void Baggage::CreateResultHeader() {
   }
 }
 
+void Baggage::RebaseEntries(const std::vector<BaggageEntry>& entries,
+                            std::string_view old_header) {
+  entries_.reserve(kEntitiesLimit);
+  for (const auto& entry : entries) {
+    entries_.push_back(entry.Rebased(old_header, header_value_));
+  }
+}
+
 void Baggage::FillEntries() {
   entries_.reserve(kEntitiesLimit);
   for (size_t header_pos = 0;
@@ -289,7 +330,7 @@ std::optional<BaggageEntry> Baggage::TryMakeBaggageEntry(
     return std::nullopt;
   }
   key.remove_suffix(entry.size() - entry_delimiter);
-  if (!allowed_keys_.count(http::parser::UrlDecode(key))) {
+  if (!allowed_keys_->count(http::parser::UrlDecode(key))) {
     LOG_LIMITED_WARNING() << fmt::format("Key {} is not available", key);
     return std::nullopt;
   }
@@ -382,6 +423,13 @@ std::optional<BaggageEntryProperty> Baggage::TryMakeBaggageEntryProperty(
 
 std::optional<Baggage> TryMakeBaggage(
     std::string header, std::unordered_set<std::string> allowed_keys) {
+  return TryMakeBaggage(std::move(header),
+                        std::make_shared<const std::unordered_set<std::string>>(
+                            std::move(allowed_keys)));
+}
+
+std::optional<Baggage> TryMakeBaggage(std::string header,
+                                      SharedAllowedKeys allowed_keys) {
   if (header.size() > kHeaderLengthLimit) {
     LOG_LIMITED_WARNING() << fmt::format(
         "Exceeded the limit of header length: {}", kHeaderLengthLimit);
@@ -12,9 +12,18 @@ BaggageSettings Parse(const formats::json::Value& value,
   BaggageSettings result{};
   result.allowed_keys =
       value["allowed_keys"].As<std::unordered_set<std::string>>();
+  result.shared_allowed_keys =
+      std::make_shared<const std::unordered_set<std::string>>(
+          result.allowed_keys);
   return result;
 }
 
+std::shared_ptr<const std::unordered_set<std::string>>
+BaggageSettings::GetSharedAllowedKeys() const {
+  if (shared_allowed_keys) return shared_allowed_keys;
+  return std::make_shared<const std::unordered_set<std::string>>(allowed_keys);
+}
+
 const dynamic_config::Key<BaggageSettings> kBaggageSettings{
     "BAGGAGE_SETTINGS",
     dynamic_config::DefaultAsJsonString{R"({"allowed_keys": []})"},
@@ -342,4 +342,24 @@ UTEST(Baggage, Parsers) {
   UTestBaggage::UTestTryMakeBaggageProperty();
 }
 
+UTEST(Baggage, CopyAndMove) {
+  // short header is kept in the small string buffer, long one is not
+  for (std::string header : {"key1=v1;p", "key1=value1;property1=value1,"
+                                          "key2=value2,key3=value3,key4=value4,"
+                                          "key5=value5;property5"}) {
+    auto baggage = baggage::TryMakeBaggage(header, kAllowedKeys);
+    ASSERT_TRUE(baggage);
+    const auto expected = PrintBaggage(*baggage);
+
+    const auto copy = *baggage;
+    EXPECT_EQ(PrintBaggage(copy), expected);
+    EXPECT_EQ(copy.ToString(), header);
+
+    const auto moved = std::move(*baggage);
+    EXPECT_EQ(PrintBaggage(moved), expected);
+    EXPECT_EQ(moved.ToString(), header);
+    EXPECT_EQ(moved.GetSharedAllowedKeys(), copy.GetSharedAllowedKeys());
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -34,6 +34,8 @@ constexpr std::string_view kExceptionInterval = "exception-interval";
 constexpr std::string_view kCleanupInterval = "additional-cleanup-interval";
 constexpr std::string_view kIsStrongPeriod = "is-strong-period";
 constexpr std::string_view kHasPreAssignCheck = "has-pre-assign-check";
+constexpr std::string_view kUpdatePriority = "update-priority";
+constexpr std::string_view kUpdateCpuShare = "update-cpu-share";
 
 constexpr std::string_view kFirstUpdateFailOk = "first-update-fail-ok";
 constexpr std::string_view kUpdateTypes = "update-types";
@@ -80,6 +82,19 @@ constexpr utils::TrivialBiMap kFirstUpdateTypeMap([](auto selector) {
             "incremental-then-async-full");
 });
 
+constexpr utils::TrivialBiMap kUpdatePriorityMap([](auto selector) {
+  return selector()
+      .Case(engine::TaskPriority::kHigh, "high")
+      .Case(engine::TaskPriority::kNormal, "normal")
+      .Case(engine::TaskPriority::kLow, "low");
+});
+
+engine::TaskPriority ParseUpdatePriority(
+    const yaml_config::YamlConfig& config) {
+  if (config.IsMissing()) return engine::TaskPriority::kLow;
+  return utils::ParseFromValueString(config, kUpdatePriorityMap);
+}
+
 }  // namespace
 
 using dump::impl::ParseMs;
@@ -145,6 +160,8 @@ Config::Config(const yaml_config::YamlConfig& config,
       is_strong_period(config[kIsStrongPeriod].As<bool>(false)),
       failed_updates_before_expiration(config[kFailedUpdatesBeforeExpiration]
                                            .As<std::optional<std::uint64_t>>()),
+      update_priority(ParseUpdatePriority(config[kUpdatePriority])),
+      update_cpu_share(config[kUpdateCpuShare].As<double>(1.0)),
       first_update_mode(
           config[dump::kDump][kFirstUpdateMode].As<FirstUpdateMode>(
               FirstUpdateMode::kSkip)),
@@ -161,6 +178,11 @@ Config::Config(const yaml_config::YamlConfig& config,
       updates_enabled(config[kUpdatesEnabled].As<bool>(true)),
       alert_on_failing_to_update_times(
           config[kAlertOnFailingToUpdateTimes].As<size_t>(0)) {
+  if (!(update_cpu_share > 0 && update_cpu_share <= 1)) {
+    throw ConfigError(fmt::format("{} must be in (0, 1] at '{}'",
+                                  kUpdateCpuShare, config.GetPath()));
+  }
+
   switch (allowed_update_types) {
     case AllowedUpdateTypes::kFullAndIncremental:
       if (!update_interval.count() || !full_update_interval.count()) {
@@ -250,6 +272,9 @@ const dynamic_config::Key<std::unordered_map<std::string, ConfigPatch>>
     kCacheConfigSet{"USERVER_CACHES",
                     dynamic_config::DefaultAsJsonString{"{}"}};
 
+const dynamic_config::Key<std::size_t> kCacheUpdateConcurrency{
+    "USERVER_CACHE_UPDATE_CONCURRENCY", 0};
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include <userver/cache/cache_statistics.hpp>
 
+#include <userver/engine/sleep.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/datetime.hpp>
 #include <userver/utils/statistics/writer.hpp>
@@ -17,6 +18,9 @@ constexpr const char* kStatisticsNameAny = "any";
 constexpr const char* kStatisticsNameCurrentDocumentsCount =
     "current-documents-count";
 
+// The update works at least that long between the pauses
+constexpr std::chrono::milliseconds kThrottleInterval{10};
+
 template <typename Clock, typename Duration>
 std::int64_t TimeStampToMillisecondsFromNow(
     std::chrono::time_point<Clock, Duration> time) {
@@ -114,6 +118,12 @@ impl::UpdateState UpdateStatisticsScope::GetState(utils::InternalTag) const {
   return state_;
 }
 
+void UpdateStatisticsScope::SetCpuShare(double cpu_share, utils::InternalTag) {
+  UASSERT(cpu_share > 0 && cpu_share <= 1);
+  cpu_share_ = cpu_share;
+  busy_since_ = std::chrono::steady_clock::now();
+}
+
 void UpdateStatisticsScope::Finish(std::size_t total_documents_count) {
   stats_.documents_current_count = total_documents_count;
   DoFinish(impl::UpdateState::kSuccess);
@@ -131,12 +141,24 @@ void UpdateStatisticsScope::FinishWithError() {
 
 void UpdateStatisticsScope::IncreaseDocumentsReadCount(std::size_t add) {
   update_stats_.documents_read_count += add;
+  if (cpu_share_ < 1.0) Throttle();
 }
 
 void UpdateStatisticsScope::IncreaseDocumentsParseFailures(std::size_t add) {
   update_stats_.documents_parse_failures += add;
 }
 
+void UpdateStatisticsScope::Throttle() {
+  const auto busy_time = std::chrono::steady_clock::now() - busy_since_;
+  if (busy_time < kThrottleInterval) return;
+
+  // The time of the other tasks on the same thread is counted as busy, so the
+  // update is throttled more under load
+  engine::SleepFor(std::chrono::duration_cast<std::chrono::microseconds>(
+      busy_time * ((1.0 - cpu_share_) / cpu_share_)));
+  busy_since_ = std::chrono::steady_clock::now();
+}
+
 void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
   UASSERT(new_state != impl::UpdateState::kNotFinished);
   // TODO Some production caches call Finish multiple times. We should fix those
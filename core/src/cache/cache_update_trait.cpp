@@ -49,6 +49,10 @@ bool CacheUpdateTrait::HasPreAssignCheck() const {
   return impl_->HasPreAssignCheck();
 }
 
+bool CacheUpdateTrait::HasDifferentialDumps() const {
+  return impl_->HasDifferentialDumps();
+}
+
 rcu::ReadablePtr<Config> CacheUpdateTrait::GetConfig() const {
   return impl_->GetConfig();
 }
@@ -67,6 +71,14 @@ void CacheUpdateTrait::ReadAndSet(dump::Reader&) {
   dump::ThrowDumpUnimplemented(Name());
 }
 
+void CacheUpdateTrait::GetAndWriteDelta(dump::Writer& writer) const {
+  GetAndWrite(writer);
+}
+
+void CacheUpdateTrait::ReadAndApplyDelta(dump::Reader& reader) {
+  ReadAndSet(reader);
+}
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
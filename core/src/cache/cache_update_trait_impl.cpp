@@ -1,11 +1,16 @@
 #include <cache/cache_update_trait_impl.hpp>
 
+#include <limits>
+#include <shared_mutex>
+
 #include <fmt/format.h>
 
 #include <userver/components/component.hpp>
 #include <userver/components/dump_configurator.hpp>
 #include <userver/dynamic_config/source.hpp>
+#include <userver/engine/semaphore.hpp>
 #include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/priority.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/testsuite/cache_control.hpp>
 #include <userver/tracing/tracer.hpp>
@@ -14,6 +19,7 @@
 #include <userver/utils/async.hpp>
 #include <userver/utils/atomic.hpp>
 #include <userver/utils/datetime.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 #include <userver/utils/statistics/metadata.hpp>
 
 #include <cache/cache_dependencies.hpp>
@@ -34,6 +40,13 @@ T CheckNotNull(T ptr) {
   return ptr;
 }
 
+// Shared by all the caches, see kCacheUpdateConcurrency
+engine::CancellableSemaphore& GetUpdateConcurrencySemaphore() {
+  static engine::CancellableSemaphore semaphore{
+      std::numeric_limits<engine::CancellableSemaphore::Counter>::max()};
+  return semaphore;
+}
+
 }  // namespace
 
 void CacheUpdateTrait::Impl::InvalidateAsync(UpdateType update_type) {
@@ -99,6 +112,10 @@ CacheUpdateTrait::Impl::Impl(CacheDependencies&& dependencies,
       periodic_update_enabled_(
           dependencies.cache_control.IsPeriodicUpdateEnabled(static_config_,
                                                              name_)),
+      is_dump_follower_(dependencies.dump_config &&
+                        dependencies.dump_config->dump_is_follower),
+      has_differential_dumps_(dependencies.dump_config &&
+                              dependencies.dump_config->dump_is_differential),
       periodic_task_flags_{utils::PeriodicTask::Flags::kChaotic},
       dumpable_(customized_trait_) {
   if (dependencies.dump_config) {
@@ -270,6 +287,12 @@ void CacheUpdateTrait::Impl::OnConfigUpdate(
     const dynamic_config::Snapshot& config) {
   const auto patch = utils::FindOptional(config[kCacheConfigSet], Name());
   config_.Assign(patch ? static_config_.MergeWith(*patch) : static_config_);
+
+  const auto concurrency = config[kCacheUpdateConcurrency];
+  GetUpdateConcurrencySemaphore().SetCapacity(
+      concurrency == 0
+          ? std::numeric_limits<engine::CancellableSemaphore::Counter>::max()
+          : concurrency);
   const auto new_config = config_.Read();
   update_task_.SetSettings(GetPeriodicTaskSettings(*new_config));
   cleanup_task_.SetSettings({new_config->cleanup_interval});
@@ -318,9 +341,17 @@ void CacheUpdateTrait::Impl::DoPeriodicUpdate() {
     return;
   }
 
+  // The first update blocks the service start, it is not paced
+  const bool is_background = !is_first_update;
+  std::shared_lock<engine::CancellableSemaphore> concurrency_lock;
+  if (is_background) {
+    concurrency_lock = std::shared_lock<engine::CancellableSemaphore>{
+        GetUpdateConcurrencySemaphore()};
+  }
+
   const auto update_type = NextUpdateType(*config);
   try {
-    DoUpdate(update_type, *config);
+    DoUpdate(update_type, *config, is_background);
     // Note: "on update success" logic goes inside DoUpdate
   } catch (const std::exception& ex) {
     LOG_WARNING() << "Error while updating cache " << name_
@@ -363,12 +394,29 @@ bool CacheUpdateTrait::Impl::HasPreAssignCheck() const {
   return static_config_.has_pre_assign_check;
 }
 
+bool CacheUpdateTrait::Impl::HasDifferentialDumps() const {
+  return has_differential_dumps_;
+}
+
 engine::TaskProcessor& CacheUpdateTrait::Impl::GetCacheTaskProcessor() const {
   return task_processor_;
 }
 
 void CacheUpdateTrait::Impl::DoUpdate(UpdateType update_type,
-                                      const Config& config) {
+                                      const Config& config,
+                                      bool is_background) {
+  const auto priority = engine::current_task::GetPriority();
+  if (is_background) {
+    engine::current_task::SetPriority(config.update_priority);
+  }
+  const utils::FastScopeGuard priority_guard{
+      [priority]() noexcept { engine::current_task::SetPriority(priority); }};
+
+  if (is_dump_follower_) {
+    ReadNewerDump();
+    return;
+  }
+
   const auto steady_now = utils::datetime::SteadyNow();
   const auto now =
       std::chrono::round<dump::TimePoint::duration>(utils::datetime::Now());
@@ -378,6 +426,9 @@ void CacheUpdateTrait::Impl::DoUpdate(UpdateType update_type,
                                       std::string{update_type_str});
 
   UpdateStatisticsScope stats(statistics_, update_type);
+  if (is_background && config.update_cpu_share < 1.0) {
+    stats.SetCpuShare(config.update_cpu_share, utils::InternalTag{});
+  }
   LOG_INFO() << "Updating cache update_type=" << update_type_str
              << " name=" << name_;
 
@@ -406,6 +457,22 @@ void CacheUpdateTrait::Impl::DoUpdate(UpdateType update_type,
   }
 }
 
+void CacheUpdateTrait::Impl::ReadNewerDump() {
+  UASSERT(dumper_);
+  const auto dump_time = dumper_->ReadNewerDump();
+  if (dump_time) {
+    LOG_INFO() << "Loaded a newer dump of cache " << name_;
+    last_update_ = *dump_time;
+    dump_first_update_type_ = {};
+    failed_updates_counter_ = 0;
+    cache_modified_ = false;
+  } else if (last_update_ == dump::TimePoint{}) {
+    throw std::runtime_error(
+        fmt::format("No dump of cache '{}' to follow has been written yet",
+                    name_));
+  }
+}
+
 void CacheUpdateTrait::Impl::CheckUpdateState(
     impl::UpdateState update_state, std::string_view update_type_str) {
   switch (update_state) {
@@ -451,6 +518,16 @@ void CacheUpdateTrait::Impl::DumpableEntityProxy::ReadAndSet(
   cache_.ReadAndSet(reader);
 }
 
+void CacheUpdateTrait::Impl::DumpableEntityProxy::GetAndWriteDelta(
+    dump::Writer& writer) const {
+  cache_.GetAndWriteDelta(writer);
+}
+
+void CacheUpdateTrait::Impl::DumpableEntityProxy::ReadAndApplyDelta(
+    dump::Reader& reader) {
+  cache_.ReadAndApplyDelta(reader);
+}
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
@@ -56,6 +56,8 @@ class CacheUpdateTrait::Impl final {
 
   bool HasPreAssignCheck() const;
 
+  bool HasDifferentialDumps() const;
+
   rcu::ReadablePtr<Config> GetConfig() const;
 
   engine::TaskProcessor& GetCacheTaskProcessor() const;
@@ -69,6 +71,10 @@ class CacheUpdateTrait::Impl final {
 
     void ReadAndSet(dump::Reader& reader) override;
 
+    void GetAndWriteDelta(dump::Writer& writer) const override;
+
+    void ReadAndApplyDelta(dump::Reader& reader) override;
+
    private:
     CacheUpdateTrait& cache_;
   };
@@ -81,11 +87,16 @@ class CacheUpdateTrait::Impl final {
 
   void OnUpdateFailure(const Config& config);
 
-  // Throws if `Update` throws
-  void DoUpdate(UpdateType type, const Config& config);
+  // Throws if `Update` throws. The background updates are run with the pacing
+  // from the config
+  void DoUpdate(UpdateType type, const Config& config,
+                bool is_background = false);
   void CheckUpdateState(impl::UpdateState update_state,
                         std::string_view update_type_str);
 
+  // Replaces `Update` for a dump follower
+  void ReadNewerDump();
+
   utils::PeriodicTask::Settings GetPeriodicTaskSettings(const Config& config);
 
   void OnConfigUpdate(const dynamic_config::Snapshot& config);
@@ -105,6 +116,8 @@ class CacheUpdateTrait::Impl final {
   const std::string update_task_name_;
   engine::TaskProcessor& task_processor_;
   const bool periodic_update_enabled_;
+  const bool is_dump_follower_;
+  const bool has_differential_dumps_;
   std::atomic<bool> is_running_{false};
   bool first_update_attempted_{false};
   std::atomic<bool> cache_modified_{false};
@@ -17,7 +17,9 @@
 #include <userver/dump/common.hpp>
 #include <userver/dump/test_helpers.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/priority.hpp>
 #include <userver/formats/yaml/serialize.hpp>
 #include <userver/formats/yaml/value_builder.hpp>
 #include <userver/fs/blocking/temp_directory.hpp>
@@ -27,6 +29,9 @@
 #include <userver/utest/utest.hpp>
 #include <userver/utils/enumerate.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
+#include <utils/internal_tag.hpp>
+
+using namespace std::chrono_literals;
 
 USERVER_NAMESPACE_BEGIN
 
@@ -903,4 +908,97 @@ UTEST(CacheUpdateTrait, FinishWithError) {
                     std::exception, "FinishWithError");
 }
 
+namespace {
+
+class PriorityCache final : public cache::CacheMockBase {
+ public:
+  static constexpr std::string_view kName = "priority-cache";
+
+  PriorityCache(const yaml_config::YamlConfig& config,
+                cache::MockEnvironment& environment)
+      : CacheMockBase(kName, config, environment) {
+    StartPeriodicUpdates();
+  }
+
+  ~PriorityCache() final { StopPeriodicUpdates(); }
+
+  std::vector<engine::TaskPriority> GetPriorities() {
+    const std::lock_guard lock(mutex_);
+    return priorities_;
+  }
+
+ private:
+  void Update(cache::UpdateType /*type*/,
+              const std::chrono::system_clock::time_point& /*last_update*/,
+              const std::chrono::system_clock::time_point& /*now*/,
+              cache::UpdateStatisticsScope& stats_scope) override {
+    {
+      const std::lock_guard lock(mutex_);
+      priorities_.push_back(engine::current_task::GetPriority());
+    }
+    stats_scope.Finish(kDummyDocumentsCount);
+  }
+
+  engine::Mutex mutex_;
+  std::vector<engine::TaskPriority> priorities_;
+};
+
+}  // namespace
+
+UTEST(CacheUpdateTrait, BackgroundUpdatePriority) {
+  const yaml_config::YamlConfig config{formats::yaml::FromString(R"(
+update-interval: 1ms
+update-jitter: 0ms
+additional-cleanup-interval: 10h
+)"),
+                                       {}};
+  cache::MockEnvironment environment(
+      testsuite::CacheControl::PeriodicUpdatesMode::kEnabled);
+
+  PriorityCache test_cache(config, environment);
+  while (test_cache.GetPriorities().size() < 2) engine::SleepFor(1ms);
+
+  const auto priorities = test_cache.GetPriorities();
+  // The first update blocks the start, it keeps the priority of the caller
+  EXPECT_EQ(priorities[0], engine::TaskPriority::kNormal);
+  EXPECT_EQ(priorities[1], engine::TaskPriority::kLow);
+}
+
+UTEST(CacheUpdateTrait, UpdateCpuShareConfig) {
+  const auto parse = [](std::string_view extra) {
+    return cache::Config{
+        yaml_config::YamlConfig{
+            formats::yaml::FromString(kFakeCacheConfig + std::string{extra}),
+            {}},
+        std::nullopt};
+  };
+
+  EXPECT_EQ(parse("").update_cpu_share, 1.0);
+  EXPECT_EQ(parse("").update_priority, engine::TaskPriority::kLow);
+  EXPECT_EQ(parse("update-cpu-share: 0.25").update_cpu_share, 0.25);
+  EXPECT_EQ(parse("update-priority: normal").update_priority,
+            engine::TaskPriority::kNormal);
+  UEXPECT_THROW(parse("update-cpu-share: 0"), cache::ConfigError);
+  UEXPECT_THROW(parse("update-cpu-share: 1.5"), cache::ConfigError);
+}
+
+UTEST(UpdateStatisticsScope, CpuShare) {
+  cache::impl::Statistics statistics;
+  cache::UpdateStatisticsScope stats(statistics, cache::UpdateType::kFull);
+  stats.SetCpuShare(0.5, utils::InternalTag{});
+
+  const auto start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::duration paused{};
+  while (std::chrono::steady_clock::now() - start < 100ms) {
+    const auto before = std::chrono::steady_clock::now();
+    stats.IncreaseDocumentsReadCount(1);
+    paused += std::chrono::steady_clock::now() - before;
+  }
+  stats.FinishNoChanges();
+
+  // About a half of the time is spent sleeping
+  EXPECT_GE(paused, 30ms);
+  EXPECT_GT(statistics.full_update.documents_read_count.load(), 0);
+}
+
 USERVER_NAMESPACE_END
@@ -63,6 +63,26 @@ properties:
             enables the check before changing the value in the cache, by
             default it is the check that the new value is not empty
         defaultDescription: false
+    update-priority:
+        type: string
+        description: |
+            engine::TaskPriority of the updates after the first one, only
+            takes effect on a task processor with
+            `task-processor-queue: priority-task-queue`
+        defaultDescription: low
+        enum:
+          - low
+          - normal
+          - high
+    update-cpu-share:
+        type: number
+        description: |
+            share of the wall time that the updates after the first one may
+            use, the update sleeps in
+            cache::UpdateStatisticsScope::IncreaseDocumentsReadCount to keep it
+        defaultDescription: 1
+        minimum: 0
+        maximum: 1
     testsuite-force-periodic-update:
         type: boolean
         description: |
@@ -0,0 +1,57 @@
+#include <userver/cache/impl/concurrent_clock_map.hpp>
+
+#include <thread>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+namespace {
+
+std::atomic<ClockMapReaderRecord*> reader_records{nullptr};
+
+ClockMapReaderRecord& AcquireReaderRecord() {
+  for (auto* record = reader_records.load(std::memory_order_acquire); record;
+       record = record->next) {
+    bool is_used = false;
+    if (record->is_used.compare_exchange_strong(is_used, true)) return *record;
+  }
+
+  auto* const record = new ClockMapReaderRecord();
+  auto* head = reader_records.load(std::memory_order_relaxed);
+  do {
+    record->next = head;
+  } while (!reader_records.compare_exchange_weak(
+      head, record, std::memory_order_release, std::memory_order_relaxed));
+  return *record;
+}
+
+struct ThreadReaderRecord final {
+  ThreadReaderRecord() : record(AcquireReaderRecord()) {}
+  ~ThreadReaderRecord() {
+    record.is_used.store(false, std::memory_order_release);
+  }
+
+  ClockMapReaderRecord& record;
+};
+
+}  // namespace
+
+ClockMapReaderRecord& GetClockMapReaderRecord() {
+  thread_local ThreadReaderRecord thread_record;
+  return thread_record.record;
+}
+
+void WaitForClockMapReaders(const void* slot) noexcept {
+  for (const auto* record = reader_records.load(std::memory_order_acquire);
+       record; record = record->next) {
+    for (std::size_t spins = 0;
+         record->slot.load(std::memory_order_seq_cst) == slot; ++spins) {
+      if (spins > 64) std::this_thread::yield();
+    }
+  }
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,129 @@
+#include <userver/cache/impl/concurrent_clock_map.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using ClockMap = cache::impl::ConcurrentClockMap<int, std::string>;
+using cache::impl::ConcurrentReadResult;
+
+std::optional<std::string> Read(const ClockMap& map, int key) {
+  std::optional<std::string> result;
+  const auto status = map.ReadConcurrently(
+      key, [&result](const std::string& value) { result = value; });
+  EXPECT_NE(status, ConcurrentReadResult::kBusy);
+  EXPECT_EQ(status == ConcurrentReadResult::kHit, result.has_value());
+  return result;
+}
+
+}  // namespace
+
+UTEST(ConcurrentClockMap, PutGet) {
+  ClockMap map(16);
+  EXPECT_EQ(map.GetCapacity(), 16);
+  EXPECT_FALSE(Read(map, 1));
+
+  EXPECT_TRUE(map.Put(1, "a"));
+  EXPECT_FALSE(map.Put(1, "b"));
+  EXPECT_EQ(Read(map, 1), "b");
+  ASSERT_TRUE(map.Get(1));
+  EXPECT_EQ(*map.Get(1), "b");
+  EXPECT_EQ(map.GetOr(2, "default"), "default");
+  EXPECT_EQ(map.GetSize(), 1);
+
+  map.Erase(1);
+  EXPECT_FALSE(Read(map, 1));
+  EXPECT_EQ(map.GetSize(), 0);
+}
+
+UTEST(ConcurrentClockMap, Capacity) {
+  ClockMap map(100);
+  for (int i = 0; i < 1000; ++i) map.Put(i, std::to_string(i));
+  EXPECT_LE(map.GetSize(), map.GetCapacity());
+  EXPECT_GE(map.GetCapacity(), 100);
+  EXPECT_LT(map.GetCapacity(), 100 + ClockMap::kBucketSize);
+
+  std::size_t visited = 0;
+  map.VisitAll([&visited](int key, const std::string& value) {
+    EXPECT_EQ(std::to_string(key), value);
+    ++visited;
+  });
+  EXPECT_EQ(visited, map.GetSize());
+
+  map.Clear();
+  EXPECT_EQ(map.GetSize(), 0);
+  EXPECT_FALSE(Read(map, 999));
+}
+
+UTEST(ConcurrentClockMap, ReferencedSurvive) {
+  ClockMap map(ClockMap::kBucketSize);
+  for (int i = 0; i < 4; ++i) map.Put(i, "hot");
+
+  // A single bucket: the keys that were read get a second chance
+  for (int i = 0; i < 100; ++i) {
+    for (int hot = 0; hot < 4; ++hot) EXPECT_TRUE(Read(map, hot));
+    map.Put(100 + i, "cold");
+  }
+  EXPECT_EQ(map.GetSize(), ClockMap::kBucketSize);
+}
+
+UTEST(ConcurrentClockMap, SetMaxSize) {
+  ClockMap map(8);
+  for (int i = 0; i < 8; ++i) map.Put(i, std::to_string(i));
+
+  map.SetMaxSize(64);
+  EXPECT_EQ(map.GetCapacity(), 64);
+  EXPECT_EQ(map.GetSize(), 8);
+  for (int i = 0; i < 8; ++i) EXPECT_EQ(Read(map, i), std::to_string(i));
+
+  map.SetMaxSize(2);
+  EXPECT_EQ(map.GetCapacity(), 2);
+  EXPECT_LE(map.GetSize(), 2);
+}
+
+UTEST_MT(ConcurrentClockMap, ConcurrentReadsAndWrites, 4) {
+  constexpr int kKeys = 16;
+  ClockMap map(kKeys);
+  const auto make_value = [](int key, std::size_t size) {
+    return std::string(size, static_cast<char>('a' + key));
+  };
+
+  std::atomic<bool> stop{false};
+  std::vector<engine::TaskWithResult<void>> readers;
+  for (int reader = 0; reader < 3; ++reader) {
+    readers.push_back(engine::AsyncNoSpan([&] {
+      while (!stop) {
+        for (int key = 0; key < kKeys; ++key) {
+          map.ReadConcurrently(key, [key](const std::string& value) {
+            EXPECT_EQ(value.find_first_not_of(static_cast<char>('a' + key)),
+                      std::string::npos);
+          });
+        }
+        engine::Yield();
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < 2000; ++i) {
+    const auto key = static_cast<int>(i % kKeys);
+    if (i % 7 == 0) {
+      map.Erase(key);
+    } else {
+      // The values of different sizes reallocate the strings
+      map.Put(key, make_value(key, i % 100));
+    }
+    if (i % 100 == 0) engine::Yield();
+  }
+  stop = true;
+  for (auto& reader : readers) reader.Get();
+}
+
+USERVER_NAMESPACE_END
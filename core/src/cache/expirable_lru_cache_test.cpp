@@ -1,10 +1,14 @@
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/dump/operations_mock.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/utils/mock_now.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -330,6 +334,135 @@ UTEST(ExpirableLruCache, BackgroundUpdate) {
   EXPECT_EQ(2, cache.Get(key, UpdateNever()));
 }
 
+UTEST_MT(ExpirableLruCache, CoalescedMisses, 4) {
+  constexpr std::size_t kGetters = 10;
+  auto counter = std::make_shared<Counter>();
+  engine::SingleConsumerEvent update_started;
+  engine::SingleConsumerEvent release_update;
+
+  auto cache = CreateSimpleCache();
+  const SimpleCacheKey key = "my-key";
+
+  const auto slow_update = [&](const SimpleCacheKey&) {
+    ++(*counter);
+    update_started.Send();
+    EXPECT_TRUE(release_update.WaitForEventFor(utest::kMaxTestWaitTime));
+    return 1;
+  };
+
+  std::vector<engine::TaskWithResult<SimpleCacheValue>> tasks;
+  tasks.push_back(
+      engine::AsyncNoSpan([&] { return cache.Get(key, slow_update); }));
+  ASSERT_TRUE(update_started.WaitForEventFor(utest::kMaxTestWaitTime));
+  for (std::size_t i = 1; i < kGetters; ++i) {
+    tasks.push_back(
+        engine::AsyncNoSpan([&] { return cache.Get(key, slow_update); }));
+  }
+  while (cache.GetStatistics().total.coalesced < kGetters - 1) {
+    engine::Yield();
+  }
+
+  release_update.Send();
+  for (auto& task : tasks) EXPECT_EQ(task.Get(), 1);
+  EXPECT_EQ(Counter::One(), *counter);
+  EXPECT_EQ(cache.GetStatistics().total.coalesced, kGetters - 1);
+  EXPECT_EQ(1, cache.Get(key, UpdateNever()));
+}
+
+UTEST(ExpirableLruCache, CoalescedMissesShareException) {
+  engine::SingleConsumerEvent update_started;
+  engine::SingleConsumerEvent release_update;
+
+  auto cache = CreateSimpleCache();
+  const SimpleCacheKey key = "my-key";
+
+  auto first = engine::AsyncNoSpan([&] {
+    return cache.Get(key, [&](const SimpleCacheKey&) -> SimpleCacheValue {
+      update_started.Send();
+      EXPECT_TRUE(release_update.WaitForEventFor(utest::kMaxTestWaitTime));
+      throw std::runtime_error("update failed");
+    });
+  });
+  ASSERT_TRUE(update_started.WaitForEventFor(utest::kMaxTestWaitTime));
+
+  auto second =
+      engine::AsyncNoSpan([&] { return cache.Get(key, UpdateNever()); });
+  while (cache.GetStatistics().total.coalesced == 0) engine::Yield();
+
+  release_update.Send();
+  UEXPECT_THROW_MSG(first.Get(), std::runtime_error, "update failed");
+  UEXPECT_THROW_MSG(second.Get(), std::runtime_error, "update failed");
+}
+
+UTEST(ExpirableLruCache, CoalescedWaitTimeout) {
+  auto counter = std::make_shared<Counter>();
+  engine::SingleConsumerEvent update_started;
+  engine::SingleConsumerEvent release_update;
+
+  auto cache = CreateSimpleCache();
+  cache.SetCoalescedWaitTimeout(std::chrono::milliseconds{10});
+  const SimpleCacheKey key = "my-key";
+
+  auto first = engine::AsyncNoSpan([&] {
+    return cache.Get(key, [&](const SimpleCacheKey&) {
+      update_started.Send();
+      EXPECT_TRUE(release_update.WaitForEventFor(utest::kMaxTestWaitTime));
+      return 1;
+    });
+  });
+  ASSERT_TRUE(update_started.WaitForEventFor(utest::kMaxTestWaitTime));
+
+  // The update is stuck, fall back to the own one
+  EXPECT_EQ(2, cache.Get(key, UpdateValue(counter, 2)));
+  EXPECT_EQ(Counter::One(), *counter);
+
+  release_update.Send();
+  EXPECT_EQ(first.Get(), 1);
+}
+
+UTEST(ExpirableLruCache, MaxBytes) {
+  SimpleCache cache(1, 100);
+  EXPECT_EQ(std::nullopt, cache.GetBytesApproximate());
+
+  cache.SetWeigher([](const SimpleCacheKey& key, SimpleCacheValue) {
+    return key.size();
+  });
+  const auto overhead = *cache.GetBytesApproximate();
+  EXPECT_EQ(0, overhead);
+
+  cache.Put("a", 1);
+  const auto bytes_per_element = *cache.GetBytesApproximate();
+  EXPECT_GT(bytes_per_element, 1);
+
+  cache.SetMaxBytes(bytes_per_element * 2);
+  cache.Put("b", 2);
+  cache.Put("c", 3);
+  EXPECT_EQ(2, cache.GetSizeApproximate());
+  EXPECT_EQ(bytes_per_element * 2, cache.GetBytesApproximate());
+  EXPECT_EQ(std::nullopt, cache.GetOptionalNoUpdate("a"));
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetBytesApproximate());
+}
+
+UTEST(ExpirableLruCache, NegativeLookupFilter) {
+  auto counter = std::make_shared<Counter>();
+  auto cache = CreateSimpleCache();
+
+  cache.SetNegativeLookupFilter(
+      [](const SimpleCacheKey& key) { return key == "present"; }, -1);
+  EXPECT_EQ(-1, cache.Get("absent", UpdateNever()));
+  EXPECT_EQ(0U, cache.GetSizeApproximate());
+
+  EXPECT_EQ(1, cache.Get("present", UpdateValue(counter, 1)));
+  EXPECT_EQ(Counter::One(), *counter);
+
+  cache.ResetNegativeLookupFilter();
+  counter->Flush();
+  EXPECT_EQ(2, cache.Get("absent", UpdateValue(counter, 2)));
+  EXPECT_EQ(Counter::One(), *counter);
+}
+
 UTEST(ExpirableLruCache, Example) {
   /// [Sample ExpirableLruCache]
   using Key = std::string;
@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/cache/frozen_hash_map.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kLookups = 1024;
+
+struct Struct final {
+  std::int64_t id{0};
+  std::string name;
+  double score{0};
+};
+
+std::vector<std::pair<std::int64_t, Struct>> MakeItems(std::size_t size) {
+  std::vector<std::pair<std::int64_t, Struct>> items;
+  items.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto id = static_cast<std::int64_t>(i * 7919);
+    items.push_back({id, Struct{id, "name", 0.5}});
+  }
+  return items;
+}
+
+// Half of the keys are present in the map
+std::vector<std::int64_t> MakeLookupKeys(std::size_t size) {
+  std::vector<std::int64_t> keys;
+  keys.reserve(kLookups);
+  for (std::size_t i = 0; i < kLookups; ++i) {
+    const auto index = static_cast<std::int64_t>(utils::RandRange(size * 2));
+    keys.push_back(index * 7919);
+  }
+  return keys;
+}
+
+}  // namespace
+
+void frozen_hash_map_std_unordered_map_find(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  auto items = MakeItems(size);
+  const std::unordered_map<std::int64_t, Struct> map(
+      std::make_move_iterator(items.begin()),
+      std::make_move_iterator(items.end()));
+  const auto keys = MakeLookupKeys(size);
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto key : keys) {
+      const auto it = map.find(key);
+      benchmark::DoNotOptimize(it == map.end() ? nullptr : &it->second);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kLookups);
+}
+BENCHMARK(frozen_hash_map_std_unordered_map_find)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 20);
+
+void frozen_hash_map_find(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const cache::FrozenHashMap<std::int64_t, Struct> map{MakeItems(size)};
+  const auto keys = MakeLookupKeys(size);
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto key : keys) {
+      benchmark::DoNotOptimize(map.Find(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kLookups);
+}
+BENCHMARK(frozen_hash_map_find)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+void frozen_hash_map_std_unordered_map_build(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    state.PauseTiming();
+    auto items = MakeItems(size);
+    state.ResumeTiming();
+    const std::unordered_map<std::int64_t, Struct> map(
+        std::make_move_iterator(items.begin()),
+        std::make_move_iterator(items.end()));
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(frozen_hash_map_std_unordered_map_build)
+    ->RangeMultiplier(16)
+    ->Range(1 << 8, 1 << 20);
+
+void frozen_hash_map_build(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    state.PauseTiming();
+    auto items = MakeItems(size);
+    state.ResumeTiming();
+    const cache::FrozenHashMap<std::int64_t, Struct> map{std::move(items)};
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(frozen_hash_map_build)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+USERVER_NAMESPACE_END
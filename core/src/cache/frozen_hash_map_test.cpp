@@ -0,0 +1,105 @@
+#include <userver/cache/frozen_hash_map.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/test_helpers.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::FrozenHashMap<int, std::string>;
+
+// Lots of collisions to test the probing
+struct BadHash {
+  std::size_t operator()(int key) const { return key % 7; }
+};
+
+}  // namespace
+
+TEST(FrozenHashMap, Empty) {
+  const Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0U);
+  EXPECT_EQ(map.Find(1), nullptr);
+  EXPECT_EQ(map.begin(), map.end());
+
+  const Map built{{}};
+  EXPECT_TRUE(built.empty());
+  EXPECT_FALSE(built.Contains(1));
+}
+
+TEST(FrozenHashMap, Find) {
+  const Map map{{{1, "one"}, {2, "two"}, {3, "three"}}};
+  EXPECT_EQ(map.size(), 3U);
+  ASSERT_NE(map.Find(2), nullptr);
+  EXPECT_EQ(*map.Find(2), "two");
+  EXPECT_TRUE(map.Contains(3));
+  EXPECT_FALSE(map.Contains(4));
+
+  // iteration keeps the order of the construction
+  std::vector<int> keys;
+  for (const auto& [key, value] : map) keys.push_back(key);
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(FrozenHashMap, DuplicatesLastWins) {
+  const Map map{{{1, "a"}, {2, "b"}, {1, "c"}}};
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(*map.Find(1), "c");
+  EXPECT_EQ(*map.Find(2), "b");
+}
+
+TEST(FrozenHashMap, Collisions) {
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 1000; ++i) items.emplace_back(i, i * 2);
+  const cache::FrozenHashMap<int, int, BadHash> map{std::move(items)};
+
+  EXPECT_EQ(map.size(), 1000U);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_NE(map.Find(i), nullptr) << i;
+    EXPECT_EQ(*map.Find(i), i * 2);
+  }
+  EXPECT_FALSE(map.Contains(1000));
+  EXPECT_FALSE(map.Contains(-1));
+}
+
+TEST(FrozenHashMap, Random) {
+  std::unordered_map<int, int> expected;
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 10'000; ++i) {
+    const auto key = static_cast<int>(utils::RandRange(20'000));
+    items.emplace_back(key, i);
+    expected[key] = i;
+  }
+  const cache::FrozenHashMap<int, int> map{std::move(items)};
+
+  EXPECT_EQ(map.size(), expected.size());
+  for (int key = 0; key < 20'000; ++key) {
+    const auto it = expected.find(key);
+    const auto* value = map.Find(key);
+    if (it == expected.end()) {
+      EXPECT_EQ(value, nullptr) << key;
+    } else {
+      ASSERT_NE(value, nullptr) << key;
+      EXPECT_EQ(*value, it->second);
+    }
+  }
+}
+
+TEST(FrozenHashMap, Dump) {
+  const Map map{{{1, "one"}, {2, "two"}, {3, "three"}}};
+  const auto read = dump::FromBinary<Map>(dump::ToBinary(map));
+  EXPECT_EQ(read.size(), 3U);
+  for (const auto& [key, value] : map) {
+    ASSERT_TRUE(read.Contains(key));
+    EXPECT_EQ(*read.Find(key), value);
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -69,10 +69,30 @@ properties:
         type: boolean
         description: enables asynchronous updates for expring values
         defaultDescription: false
+    coalesced-wait-timeout:
+        type: string
+        description: |
+            how long concurrent misses of a key wait for the in-flight update
+            before calling the update on their own (0 is unlimited)
+        defaultDescription: 0
+    max-bytes:
+        type: integer
+        description: |
+            approximate limit of the memory used by the cached elements
+            (0 is unlimited)
+        defaultDescription: 0
     config-settings:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
         defaultDescription: true
+    policy:
+        type: string
+        description: eviction policy of the ways
+        defaultDescription: lru
+        enum:
+          - lru
+          - w-tiny-lfu
+          - clock
 )");
 }
 
@@ -6,6 +6,7 @@
 #include <userver/dump/config.hpp>
 #include <userver/dynamic_config/value.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/trivial_map.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -18,6 +19,10 @@ constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kCoalescedWaitTimeout = "coalesced-wait-timeout";
+constexpr std::string_view kCoalescedWaitTimeoutMs =
+    "coalesced-wait-timeout-ms";
+constexpr std::string_view kMaxBytes = "max-bytes";
 
 }  // namespace
 
@@ -28,7 +33,10 @@ LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
       lifetime(config[kLifetime].As<std::chrono::milliseconds>(0)),
       background_update(config[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      coalesced_wait_timeout(
+          config[kCoalescedWaitTimeout].As<std::chrono::milliseconds>(0)),
+      max_bytes(config[kMaxBytes].As<std::size_t>(0)) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -40,7 +48,10 @@ LruCacheConfig::LruCacheConfig(const formats::json::Value& value)
       lifetime(ParseMs(value[kLifetimeMs])),
       background_update(value[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      coalesced_wait_timeout(ParseMs(value[kCoalescedWaitTimeoutMs],
+                                     std::chrono::milliseconds::zero())),
+      max_bytes(value[kMaxBytes].As<std::size_t>(0)) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -58,7 +69,8 @@ LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
-      use_dynamic_config(config["config-settings"].As<bool>(true)) {
+      use_dynamic_config(config["config-settings"].As<bool>(true)),
+      policy(config["policy"].As<CachePolicy>(CachePolicy::kLru)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
 }
 
@@ -71,6 +83,18 @@ std::size_t LruCacheConfigStatic::GetWaySize() const {
   return config.GetWaySize(ways);
 }
 
+CachePolicy Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<CachePolicy>) {
+  static constexpr utils::TrivialBiMap kMap([](auto selector) {
+    return selector()
+        .Case(CachePolicy::kLru, "lru")
+        .Case(CachePolicy::kWTinyLfu, "w-tiny-lfu")
+        .Case(CachePolicy::kClock, "clock");
+  });
+
+  return utils::ParseFromValueString(value, kMap);
+}
+
 const dynamic_config::Key<std::unordered_map<std::string, LruCacheConfig>>
     kLruCacheConfigSet{"USERVER_LRU_CACHES",
                        dynamic_config::DefaultAsJsonString{"{}"}};
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kWays = 8;
+constexpr int kHotKeys = 256;
+constexpr int kGetsPerTask = 10'000;
+
+}  // namespace
+
+// All the tasks read the keys in [0, key_count)
+template <cache::CachePolicy Policy>
+void NWayLruGets(benchmark::State& state, int key_count) {
+  const auto threads = static_cast<std::size_t>(state.range(0));
+  engine::RunStandalone(threads, [&] {
+    cache::NWayLRU<int, int> cache(kWays, kHotKeys, std::hash<int>{},
+                                   std::equal_to<int>{}, Policy);
+    for (int i = 0; i < key_count; ++i) cache.Put(i, i);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(threads);
+    for ([[maybe_unused]] auto _ : state) {
+      for (std::size_t task = 0; task < threads; ++task) {
+        tasks.push_back(engine::AsyncNoSpan([&cache, task, key_count] {
+          for (int i = 0; i < kGetsPerTask; ++i) {
+            benchmark::DoNotOptimize(
+                cache.Get((i + static_cast<int>(task)) % key_count));
+          }
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+      tasks.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * threads * kGetsPerTask);
+  });
+}
+
+template <cache::CachePolicy Policy>
+void NWayLruHotGets(benchmark::State& state) {
+  NWayLruGets<Policy>(state, kHotKeys);
+}
+
+// A single hot key shows the sharing of its cache line between the readers
+template <cache::CachePolicy Policy>
+void NWayLruSingleKeyGets(benchmark::State& state) {
+  NWayLruGets<Policy>(state, 1);
+}
+BENCHMARK_TEMPLATE(NWayLruHotGets, cache::CachePolicy::kLru)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(NWayLruHotGets, cache::CachePolicy::kClock)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(NWayLruSingleKeyGets, cache::CachePolicy::kLru)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(NWayLruSingleKeyGets, cache::CachePolicy::kClock)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,10 @@
 #include <userver/utest/utest.hpp>
 
+#include <atomic>
+#include <vector>
+
 #include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -54,6 +58,142 @@ UTEST(NWayLRU, SetMultipleWays) {
   EXPECT_EQ(1, cache.Get(1));
 }
 
+UTEST(NWayLRU, WTinyLfu) {
+  Cache cache(2, 100, std::hash<int>{}, std::equal_to<int>{},
+              cache::CachePolicy::kWTinyLfu);
+  for (int round = 0; round < 5; ++round) {
+    for (int i = 0; i < 50; ++i) cache.Put(i, i);
+  }
+  for (int i = 0; i < 1000; ++i) cache.Put(1000 + i, i);
+
+  EXPECT_LE(cache.GetSize(), 200);
+  int hits = 0;
+  for (int i = 0; i < 50; ++i) hits += cache.Get(i).has_value();
+  EXPECT_GE(hits, 45);
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST(NWayLRU, Clock) {
+  Cache cache(2, 16, std::hash<int>{}, std::equal_to<int>{},
+              cache::CachePolicy::kClock);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(2, cache.GetOr(2, -1));
+  EXPECT_EQ(-1, cache.GetOr(3, -1));
+
+  EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_EQ(1, cache.GetSize());
+
+  cache.InvalidateByKey(2);
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST_MT(NWayLRU, ClockConcurrentReads, 4) {
+  constexpr int kKeys = 64;
+  Cache cache(4, kKeys, std::hash<int>{}, std::equal_to<int>{},
+              cache::CachePolicy::kClock);
+  for (int i = 0; i < kKeys; ++i) cache.Put(i, i);
+
+  std::atomic<bool> stop{false};
+  std::vector<engine::TaskWithResult<void>> readers;
+  for (int task = 0; task < 3; ++task) {
+    readers.push_back(engine::AsyncNoSpan([&] {
+      while (!stop) {
+        for (int i = 0; i < kKeys; ++i) {
+          const auto value = cache.Get(i);
+          if (value) {
+            EXPECT_EQ(*value % kKeys, i);
+          }
+        }
+      }
+    }));
+  }
+
+  for (int round = 1; round < 100; ++round) {
+    for (int i = 0; i < kKeys; ++i) cache.Put(i, round * kKeys + i);
+    cache.InvalidateByKey(round % kKeys);
+    cache.UpdateWaySize(round % 2 ? kKeys / 2 : kKeys);
+  }
+  stop = true;
+  for (auto& reader : readers) reader.Get();
+}
+
+UTEST(NWayLRU, Weighted) {
+  Cache cache(1, 100);
+  cache.SetWeigher([](int, int value) { return value; });
+  cache.UpdateMaxWeight(10);
+
+  cache.Put(1, 4);
+  cache.Put(2, 4);
+  EXPECT_EQ(8, cache.GetWeight());
+
+  // The least recently used element is evicted to fit the new one
+  cache.Put(3, 4);
+  EXPECT_EQ(8, cache.GetWeight());
+  EXPECT_FALSE(cache.Get(1).has_value());
+
+  // The replaced value is not counted
+  cache.Put(3, 1);
+  EXPECT_EQ(5, cache.GetWeight());
+
+  // Heavier than the limit, not stored
+  cache.Put(4, 11);
+  EXPECT_FALSE(cache.Get(4).has_value());
+  EXPECT_EQ(5, cache.GetWeight());
+
+  cache.InvalidateByKey(2);
+  EXPECT_EQ(1, cache.GetWeight());
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetWeight());
+}
+
+UTEST(NWayLRU, WeightedShrink) {
+  Cache cache(2, 100);
+  cache.SetWeigher([](int, int) { return 1; });
+  for (int i = 0; i < 50; ++i) cache.Put(i, i);
+  EXPECT_EQ(50, cache.GetWeight());
+
+  cache.UpdateMaxWeight(20);
+  EXPECT_LE(cache.GetWeight(), 20);
+  EXPECT_EQ(cache.GetWeight(), cache.GetSize());
+
+  cache.UpdateMaxWeight(0);
+  for (int i = 0; i < 50; ++i) cache.Put(i, i);
+  EXPECT_EQ(50, cache.GetWeight());
+
+  cache.UpdateWaySize(10);
+  EXPECT_EQ(cache.GetWeight(), cache.GetSize());
+}
+
+UTEST(NWayLRU, WeightedWTinyLfu) {
+  Cache cache(2, 50, std::hash<int>{}, std::equal_to<int>{},
+              cache::CachePolicy::kWTinyLfu);
+  cache.SetWeigher([](int key, int) { return key % 7 + 1; });
+  cache.UpdateMaxWeight(200);
+
+  for (int i = 0; i < 2000; ++i) {
+    cache.Put(i % 300, i);
+    if (i % 3 == 0) cache.Get(i % 50);
+  }
+  EXPECT_LE(cache.GetWeight(), 200);
+
+  std::size_t weight = 0;
+  cache.VisitAll([&weight](int key, int) { weight += key % 7 + 1; });
+  EXPECT_EQ(weight, cache.GetWeight());
+}
+
+UTEST(NWayLRU, WeightedClock) {
+  Cache cache(1, 16, std::hash<int>{}, std::equal_to<int>{},
+              cache::CachePolicy::kClock);
+  UEXPECT_THROW(cache.SetWeigher([](int, int) { return 1; }),
+                std::logic_error);
+}
+
 UTEST(NWayLRU, HashCombine) {
   for (const auto seed : std::vector<std::size_t>{0, 1, 7, 42, 100, 1000}) {
     /// @note: checking for seed used in way selection to not be equal after
@@ -0,0 +1,119 @@
+#include <userver/cache/persistent_map.hpp>
+
+#include <map>
+#include <string>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/test_helpers.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::PersistentMap<int, std::string>;
+
+// Lots of collisions to test the leaves with several entries
+struct BadHash {
+  std::size_t operator()(int key) const { return key % 7; }
+};
+
+template <typename PersistentMap>
+std::map<int, std::string> ToStdMap(const PersistentMap& map) {
+  std::map<int, std::string> result;
+  for (const auto& [key, value] : map) {
+    EXPECT_TRUE(result.emplace(key, value).second) << "Duplicate key " << key;
+  }
+  return result;
+}
+
+template <typename PersistentMap>
+void TestRandomOperations() {
+  PersistentMap map;
+  std::map<int, std::string> expected;
+  for (int i = 0; i < 10'000; ++i) {
+    const int key = utils::RandRange(1000);
+    if (utils::RandRange(3) == 0) {
+      EXPECT_EQ(map.Erase(key), expected.erase(key) == 1);
+    } else {
+      const auto value = std::to_string(i);
+      EXPECT_EQ(map.InsertOrAssign(key, value),
+                expected.insert_or_assign(key, value).second);
+    }
+    ASSERT_EQ(map.size(), expected.size());
+  }
+
+  EXPECT_EQ(ToStdMap(map), expected);
+  for (int key = 0; key < 1000; ++key) {
+    const auto* value = map.Find(key);
+    const auto it = expected.find(key);
+    if (it == expected.end()) {
+      EXPECT_EQ(value, nullptr);
+    } else {
+      ASSERT_NE(value, nullptr);
+      EXPECT_EQ(*value, it->second);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(PersistentMap, Empty) {
+  const Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_FALSE(map.Contains(1));
+}
+
+TEST(PersistentMap, InsertFindErase) {
+  Map map;
+  EXPECT_TRUE(map.InsertOrAssign(1, "one"));
+  EXPECT_TRUE(map.InsertOrAssign(2, "two"));
+  EXPECT_FALSE(map.InsertOrAssign(1, "uno"));
+  EXPECT_EQ(map.size(), 2);
+  ASSERT_TRUE(map.Contains(1));
+  EXPECT_EQ(*map.Find(1), "uno");
+
+  EXPECT_TRUE(map.Erase(1));
+  EXPECT_FALSE(map.Erase(1));
+  EXPECT_FALSE(map.Contains(1));
+  EXPECT_EQ(map.size(), 1);
+
+  map.Clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(PersistentMap, RandomOperations) { TestRandomOperations<Map>(); }
+
+TEST(PersistentMap, RandomOperationsWithCollisions) {
+  TestRandomOperations<cache::PersistentMap<int, std::string, BadHash>>();
+}
+
+TEST(PersistentMap, CopiesAreIndependent) {
+  Map original;
+  for (int i = 0; i < 1000; ++i) original.InsertOrAssign(i, std::to_string(i));
+  const auto expected = ToStdMap(original);
+
+  auto copy = original;
+  for (int i = 0; i < 1000; i += 2) copy.Erase(i);
+  copy.InsertOrAssign(1, "changed");
+  copy.InsertOrAssign(5000, "new");
+
+  EXPECT_EQ(ToStdMap(original), expected);
+  EXPECT_EQ(original.size(), 1000);
+  EXPECT_EQ(copy.size(), 501);
+  EXPECT_EQ(*copy.Find(1), "changed");
+  EXPECT_EQ(*original.Find(1), "1");
+  EXPECT_FALSE(original.Contains(5000));
+}
+
+TEST(PersistentMap, Dump) {
+  Map map;
+  for (int i = 0; i < 100; ++i) map.InsertOrAssign(i, std::to_string(i));
+  const auto after_cycle = dump::FromBinary<Map>(dump::ToBinary(map));
+  EXPECT_EQ(ToStdMap(after_cycle), ToStdMap(map));
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,28 @@
+#include <userver/cache/sharded_caching_component_base.hpp>
+
+#include <userver/cache/caching_component_base.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components::impl {
+
+yaml_config::Schema GetShardedCachingComponentBaseSchema() {
+  auto schema = yaml_config::impl::SchemaFromString(R"(
+type: object
+description: Base class for sharded caching components
+additionalProperties: false
+properties:
+    shards-count:
+        type: integer
+        description: number of independently updated shards
+        defaultDescription: 1
+        minimum: 1
+)");
+  yaml_config::impl::Merge(schema, GetCachingComponentBaseSchema());
+  return schema;
+}
+
+}  // namespace components::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,98 @@
+#include <userver/cache/sharded_caching_component_base.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include <components/component_list_test.hpp>
+#include <userver/components/component_list.hpp>
+#include <userver/components/minimal_component_list.hpp>
+#include <userver/components/run.hpp>
+#include <userver/testsuite/testsuite_support.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kStaticConfig = R"(
+components_manager:
+  default_task_processor: main-task-processor
+  event_thread_pool:
+    threads: 1
+  task_processors:
+    main-task-processor:
+      worker_threads: 4
+  components:
+    sharded-cache:
+      update-types: only-full
+      update-interval: 1h
+      config-settings: false
+      shards-count: 4
+    logging:
+      fs-task-processor: main-task-processor
+      loggers:
+        default:
+          file_path: '@null'
+    testsuite-support:
+)";
+
+constexpr std::size_t kValuesPerShard = 100;
+
+class ShardedCache final
+    : public components::ShardedCachingComponentBase<std::vector<int>> {
+ public:
+  static constexpr std::string_view kName = "sharded-cache";
+
+  ShardedCache(const components::ComponentConfig& config,
+               const components::ComponentContext& context)
+      : ShardedCachingComponentBase(config, context) {
+    StartPeriodicUpdates();
+
+    EXPECT_EQ(GetShardsCount(), 4);
+    EXPECT_EQ(updates_.load(), GetShardsCount());
+    for (std::size_t shard = 0; shard < GetShardsCount(); ++shard) {
+      const auto data = Get(shard);
+      EXPECT_EQ(data->size(), kValuesPerShard);
+      for (const auto value : *data) {
+        EXPECT_EQ(GetShardIndex(value), shard);
+      }
+    }
+  }
+
+  ~ShardedCache() override { StopPeriodicUpdates(); }
+
+ private:
+  std::optional<std::size_t> UpdateShard(
+      std::size_t shard, cache::UpdateType type,
+      const std::chrono::system_clock::time_point&,
+      const std::chrono::system_clock::time_point&) override {
+    EXPECT_EQ(type, cache::UpdateType::kFull);
+    ++updates_;
+
+    std::vector<int> data;
+    for (int value = 0; data.size() < kValuesPerShard; ++value) {
+      if (GetShardIndex(value) == shard) data.push_back(value);
+    }
+    SetShard(shard, std::move(data));
+    return kValuesPerShard;
+  }
+
+  std::atomic<std::size_t> updates_{0};
+};
+
+}  // namespace
+
+template <>
+inline constexpr bool components::kHasValidate<ShardedCache> = true;
+
+TEST_F(ComponentList, ShardedCachingComponentBase) {
+  auto component_list = components::MinimalComponentList();
+  component_list.Append<ShardedCache>();
+  component_list.Append<components::TestsuiteSupport>();
+
+  components::RunOnce(components::InMemoryConfig{kStaticConfig},
+                      component_list);
+}
+
+USERVER_NAMESPACE_END
@@ -42,6 +42,11 @@ ResolverConfig ParseResolverConfig(
   config.cache_failure_ttl =
       component_config["cache_failure_ttl"].As<std::chrono::milliseconds>(
           config.cache_failure_ttl);
+  config.cache_max_failure_ttl =
+      component_config["cache-max-failure-ttl"].As<std::chrono::milliseconds>(
+          config.cache_max_failure_ttl);
+  config.cache_update_ratio = component_config["cache-update-ratio"].As<double>(
+      config.cache_update_ratio);
   return config;
 }
 
@@ -122,6 +127,18 @@ properties:
         type: string
         description: TTL for network failures caching
         defaultDescription: 5s
+    cache-max-failure-ttl:
+        type: string
+        description: TTL limit for consecutive network failures caching
+        defaultDescription: 1m
+    cache-update-ratio:
+        type: number
+        description: |
+            fraction of the reply TTL at the end of which the record is
+            updated in background
+        defaultDescription: 0.1
+        minimum: 0
+        maximum: 1
 )");
 }
 
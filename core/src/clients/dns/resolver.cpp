@@ -2,6 +2,7 @@
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <algorithm>
 #include <cctype>
 #include <chrono>
 #include <string_view>
@@ -171,8 +172,16 @@ class Resolver::Impl {
     AddrVector addrs;
     std::chrono::steady_clock::time_point expiration;
     bool is_failure{false};
+    // time before the expiration to start the background update at
+    std::chrono::milliseconds update_margin{0};
+    // for failures, the TTL the entry was cached with
+    std::chrono::milliseconds failure_ttl{0};
   };
 
+  std::chrono::milliseconds GetUpdateMargin(
+      std::chrono::milliseconds ttl) const;
+  std::chrono::milliseconds GetFailureTtl(const std::string& name);
+
   template <typename Mutex>
   void MoveQueryToBackground(std::unique_lock<Mutex>& lock, Mutex&& mutex,
                              engine::Future<NetResolver::Response>&& future,
@@ -190,6 +199,8 @@ class Resolver::Impl {
   const std::chrono::milliseconds net_cache_update_margin_;
   const std::chrono::milliseconds net_cache_max_reply_ttl_;
   const std::chrono::milliseconds net_cache_failure_ttl_;
+  const std::chrono::milliseconds net_cache_max_failure_ttl_;
+  const double net_cache_update_ratio_;
   cache::NWayLRU<std::string, NetCacheEntry> net_cache_;
   concurrent::MutexSet<std::string> net_cache_update_mutexes_;
   utils::impl::WaitTokenStorage wait_token_storage_;
@@ -204,6 +215,9 @@ Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor,
       net_cache_update_margin_{config.network_timeout},
       net_cache_max_reply_ttl_{config.cache_max_reply_ttl},
       net_cache_failure_ttl_{config.cache_failure_ttl},
+      net_cache_max_failure_ttl_{
+          std::max(config.cache_max_failure_ttl, config.cache_failure_ttl)},
+      net_cache_update_ratio_{config.cache_update_ratio},
       net_cache_{config.cache_ways, config.cache_size_per_way},
       net_cache_update_mutexes_(config.cache_ways) {}
 
@@ -253,7 +267,7 @@ Resolver::Impl::NetCacheResult Resolver::Impl::QueryNetCache(
     ++source_counters_.cached_stale;
   }
 
-  if (cached->expiration - now >= net_cache_update_margin_) {
+  if (cached->expiration - now >= cached->update_margin) {
     result.status = NetCacheResult::Status::kHitReply;
   } else {
     result.status = NetCacheResult::Status::kHitReplyWithUpdate;
@@ -266,6 +280,28 @@ auto Resolver::Impl::GetUpdateMutex(const std::string& name) {
   return net_cache_update_mutexes_.GetMutexForKey(name);
 }
 
+std::chrono::milliseconds Resolver::Impl::GetUpdateMargin(
+    std::chrono::milliseconds ttl) const {
+  return std::max(
+      net_cache_update_margin_,
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::duration<double, std::milli>{ttl} *
+          net_cache_update_ratio_));
+}
+
+// Consecutive failures are cached for exponentially growing periods, a failure
+// is consecutive if the name was queried again soon after the previous one
+// expired
+std::chrono::milliseconds Resolver::Impl::GetFailureTtl(
+    const std::string& name) {
+  const auto prev = net_cache_.Get(name);
+  if (!prev || !prev->is_failure ||
+      prev->expiration + prev->failure_ttl < utils::datetime::MockSteadyNow()) {
+    return net_cache_failure_ttl_;
+  }
+  return std::min(prev->failure_ttl * 2, net_cache_max_failure_ttl_);
+}
+
 void Resolver::Impl::AccountNetUpdateFailure() {
   ++source_counters_.network_failure;
 }
@@ -347,11 +383,15 @@ void Resolver::Impl::FinishNetUpdate(
   } catch (const ResolverException& ex) {
     LOG_LIMITED_ERROR() << "Resolving of '" << name << "' failed: " << ex;
     if (failure_mode == FailureMode::kCache) {
-      LOG_TRACE() << "Caching failure for '" << name << '\'';
-      net_cache_.Put(name, NetCacheEntry{{},
-                                         utils::datetime::MockSteadyNow() +
-                                             net_cache_failure_ttl_,
-                                         true});
+      const auto failure_ttl = GetFailureTtl(name);
+      LOG_TRACE() << "Caching failure for '" << name << "' for "
+                  << failure_ttl.count() << "ms";
+      net_cache_.Put(
+          name, NetCacheEntry{{},
+                              utils::datetime::MockSteadyNow() + failure_ttl,
+                              true,
+                              std::chrono::milliseconds{0},
+                              failure_ttl});
     }
     ++source_counters_.network_failure;
     throw;
@@ -366,7 +406,8 @@ void Resolver::Impl::FinishNetUpdate(
     LOG_TRACE() << "Updating cache for '" << name << '\'';
     net_cache_.Put(
         name, NetCacheEntry{std::move(response.addrs),
-                            utils::datetime::MockSteadyNow() + effective_ttl});
+                            utils::datetime::MockSteadyNow() + effective_ttl,
+                            false, GetUpdateMargin(effective_ttl)});
   } else {
     LOG_TRACE() << "Skipping cache update for '" << name << '\'';
   }
@@ -426,6 +426,67 @@ UTEST(Resolver, CacheFailures) {
   EXPECT_EQ(counters.network_failure, 2);
 }
 
+UTEST(Resolver, CacheFailuresBackoff) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  MockedResolver resolver{1, 1};
+
+  utils::datetime::MockNowSet({});
+
+  UEXPECT_THROW(resolver->Resolve("fail", test_deadline),
+                clients::dns::NotResolvedException);
+
+  utils::datetime::MockSleep(std::chrono::milliseconds{1500});
+
+  // the consecutive failure is cached for 2 seconds
+  UEXPECT_THROW(resolver->Resolve("fail", test_deadline),
+                clients::dns::NotResolvedException);
+
+  utils::datetime::MockSleep(std::chrono::milliseconds{1500});
+
+  UEXPECT_THROW(resolver->Resolve("fail", test_deadline),
+                clients::dns::NotResolvedException);
+
+  const auto& counters = resolver->GetLookupSourceCounters();
+  EXPECT_EQ(counters.cached_failure, 1);
+  EXPECT_EQ(counters.network_failure, 2);
+}
+
+UTEST(Resolver, CacheUpdateAhead) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  MockedResolver resolver{1000, 1};
+
+  utils::datetime::MockNowSet({});
+
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  utils::datetime::MockSleep(std::chrono::seconds{850});
+
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  const auto& counters = resolver->GetLookupSourceCounters();
+  EXPECT_EQ(counters.network, 1);
+
+  // the last 10% of the TTL
+  utils::datetime::MockSleep(std::chrono::seconds{100});
+
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  while (counters.network < 2 && !test_deadline.IsReached()) {
+    engine::SleepFor(std::chrono::milliseconds{1});
+  }
+  EXPECT_EQ(counters.cached, 2);
+  EXPECT_EQ(counters.cached_stale, 0);
+  EXPECT_EQ(counters.network, 2);
+  EXPECT_EQ(counters.network_failure, 0);
+}
+
 UTEST(Resolver, FileDoesNotCache) {
   const auto test_deadline =
       engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
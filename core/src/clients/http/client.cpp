@@ -3,12 +3,16 @@
 #include <chrono>
 #include <cstdlib>
 #include <limits>
+#include <vector>
 
 #include <moodycamel/concurrentqueue.h>
 
 #include <userver/components/headers_propagator_component.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/wait_any.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/manager.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/rand.hpp>
 #include <userver/utils/userver_info.hpp>
@@ -20,6 +24,7 @@
 #include <crypto/openssl.hpp>
 #include <curl-ev/multi.hpp>
 #include <curl-ev/ratelimit.hpp>
+#include <curl-ev/share.hpp>
 #include <engine/ev/thread_pool.hpp>
 #include <server/http/headers_propagator.hpp>
 
@@ -43,6 +48,12 @@ const tracing::TracingManagerBase* GetTracingManager(
   return settings.tracing_manager;
 }
 
+std::shared_ptr<curl::share> MakeSslSessionShare() {
+  auto share = std::make_shared<curl::share>();
+  share->set_share_ssl_session(true);
+  return share;
+}
+
 }  // namespace
 
 Client::Client(impl::ClientSettings settings,
@@ -54,8 +65,10 @@ Client::Client(impl::ClientSettings settings,
       fs_task_processor_(fs_task_processor),
       user_agent_(utils::GetUserverIdentifier()),
       connect_rate_limiter_(std::make_shared<curl::ConnectRateLimiter>()),
+      ssl_session_share_(MakeSslSessionShare()),
       tracing_manager_(GetTracingManager(settings)),
       headers_propagator_(settings.headers_propagator),
+      warmup_settings_(std::move(settings.warmup)),
       plugin_pipeline_(std::move(plugin_pipeline)) {
   const auto io_threads = settings.io_threads;
   const auto& thread_name_prefix = settings.thread_name_prefix;
@@ -90,6 +103,7 @@ Client::Client(impl::ClientSettings settings,
 }
 
 Client::~Client() {
+  warmup_task_.Stop();
   easy_reinit_task_.Stop();
 
   // We have to destroy *this only when all the requests are finished, because
@@ -114,37 +128,145 @@ Client::~Client() {
 }
 
 Request Client::CreateRequest() {
-  auto request = [this] {
-    auto easy = TryDequeueIdle();
-    if (easy) {
-      auto idx = FindMultiIndex(easy->GetMulti());
-      auto wrapper =
-          std::make_shared<impl::EasyWrapper>(std::move(easy), *this);
-      return Request{
-          std::move(wrapper),      statistics_[idx].CreateRequestStats(),
-          destination_statistics_, resolver_,
-          plugin_pipeline_,        *tracing_manager_.GetBase()};
-    } else {
-      auto i = utils::RandRange(multis_.size());
-      auto& multi = multis_[i];
-
-      try {
-        auto wrapper = engine::AsyncNoSpan(fs_task_processor_, [this, &multi] {
-                         return std::make_shared<impl::EasyWrapper>(
-                             easy_.Get()->GetBoundBlocking(*multi), *this);
-                       }).Get();
-        return Request{
-            std::move(wrapper),      statistics_[i].CreateRequestStats(),
-            destination_statistics_, resolver_,
-            plugin_pipeline_,        *tracing_manager_.GetBase()};
-      } catch (engine::WaitInterruptedException&) {
-        throw clients::http::CancelException();
-      } catch (engine::TaskCancelledException&) {
-        throw clients::http::CancelException();
+  auto easy = TryDequeueIdle();
+  if (!easy) return CreateRequestForMulti(ChooseMultiIndex());
+
+  auto idx = FindMultiIndex(easy->GetMulti());
+  auto wrapper = std::make_shared<impl::EasyWrapper>(std::move(easy), *this);
+  Request request{std::move(wrapper),
+                  statistics_[idx].CreateRequestStats(),
+                  destination_statistics_,
+                  resolver_,
+                  plugin_pipeline_,
+                  *tracing_manager_.GetBase()};
+  SetupRequest(request);
+  return request;
+}
+
+std::shared_ptr<Response> Client::PerformHedged(
+    const HedgingSettings& settings,
+    const std::function<Request(std::size_t attempt)>& request_factory) {
+  UINVARIANT(settings.max_attempts > 0, "max_attempts must be positive");
+
+  std::vector<ResponseFuture> responses;
+  std::vector<std::size_t> attempts;
+  responses.reserve(settings.max_attempts);
+  attempts.reserve(settings.max_attempts);
+
+  const auto perform = [&](std::size_t attempt) {
+    auto request = request_factory(attempt);
+    responses.push_back(request.async_perform());
+    attempts.push_back(attempt);
+    return request.GetDestinationMetricName();
+  };
+
+  // The statistics of the destination appear once the first request starts
+  const auto destination = perform(0);
+  auto stats = destination_statistics_->GetExistingStatistics(destination);
+  std::chrono::milliseconds delay = settings.default_delay;
+  if (stats) {
+    stats->AccountHedgingBudget(settings.max_extra_load_percent);
+    delay = stats->GetRecentTimingsPercentile(settings.timings_percentile)
+                .value_or(settings.default_delay);
+  }
+
+  std::size_t next_attempt = 1;
+  bool can_hedge = stats && next_attempt < settings.max_attempts;
+  // Returned if the rest of the requests fail with an exception
+  std::shared_ptr<Response> server_error_response;
+  while (true) {
+    const auto deadline = can_hedge ? engine::Deadline::FromDuration(delay)
+                                    : engine::Deadline{};
+    const auto index = engine::WaitAnyUntil(deadline, responses);
+
+    if (!index) {
+      if (engine::current_task::ShouldCancel()) {
+        // throws CancelException
+        return responses.front().Get();
       }
+      if (stats->TryConsumeHedgingBudget()) {
+        perform(next_attempt++);
+        can_hedge = next_attempt < settings.max_attempts;
+      } else {
+        LOG_LIMITED_INFO() << "Hedging budget of '" << destination
+                           << "' is exhausted";
+        can_hedge = false;
+      }
+      continue;
     }
-  }();
 
+    auto response_future = std::move(responses[*index]);
+    const auto attempt = attempts[*index];
+    responses.erase(responses.begin() + *index);
+    attempts.erase(attempts.begin() + *index);
+
+    std::shared_ptr<Response> response;
+    try {
+      response = response_future.Get();
+    } catch (const std::exception& e) {
+      if (!responses.empty()) {
+        LOG_INFO() << "Hedged request failed, waiting for the rest: " << e;
+        continue;
+      }
+      if (!server_error_response) throw;
+      LOG_INFO() << "Hedged request failed, returning the previous response "
+                    "with a server error: "
+                 << e;
+      return server_error_response;
+    }
+
+    const bool is_server_error = static_cast<int>(response->status_code()) >=
+                                 static_cast<int>(Status::InternalServerError);
+    if (is_server_error && !responses.empty()) {
+      server_error_response = std::move(response);
+      continue;
+    }
+
+    if (attempt > 0 && !is_server_error) stats->AccountHedgeWin();
+    for (auto& other : responses) other.Cancel();
+    return response;
+  }
+}
+
+void Client::StartWarmup() {
+  if (warmup_settings_.destinations.empty()) return;
+
+  LOG_INFO() << "http client: warming up connections to "
+             << warmup_settings_.destinations.size() << " destinations";
+  warmup_task_.Start(
+      "http_warmup",
+      utils::PeriodicTask::Settings{warmup_settings_.interval,
+                                    utils::PeriodicTask::Flags::kNow},
+      [this] { Warmup(); });
+}
+
+Request Client::CreateRequestForMulti(size_t multi_index) {
+  auto& multi = multis_[multi_index];
+
+  try {
+    auto wrapper = engine::AsyncNoSpan(fs_task_processor_, [this, &multi] {
+                     auto easy = easy_.Get()->GetBoundBlocking(*multi);
+                     // duplicated handles do not inherit the share
+                     easy->set_share(ssl_session_share_);
+                     return std::make_shared<impl::EasyWrapper>(
+                         std::move(easy), *this);
+                   }).Get();
+    Request request{std::move(wrapper),
+                    statistics_[multi_index].CreateRequestStats(),
+                    destination_statistics_,
+                    resolver_,
+                    plugin_pipeline_,
+                    *tracing_manager_.GetBase()};
+    SetupRequest(request);
+    return request;
+  } catch (engine::WaitInterruptedException&) {
+    throw clients::http::CancelException();
+  } catch (engine::TaskCancelledException&) {
+    throw clients::http::CancelException();
+  }
+}
+
+void Client::SetupRequest(Request& request) {
   if (testsuite_config_) {
     request.SetTestsuiteConfig(testsuite_config_);
   }
@@ -164,8 +286,38 @@ Request Client::CreateRequest() {
     request.proxy(*proxy_value);
   }
   request.SetDeadlinePropagationConfig(deadline_propagation_config_);
+}
 
-  return request;
+void Client::Warmup() {
+  // Connections are cached by each multi separately, so every multi gets
+  // its own set of concurrent requests. Requests to an idle cached connection
+  // also check its health: curl drops the dead ones and reconnects.
+  std::vector<ResponseFuture> responses;
+  responses.reserve(multis_.size() * warmup_settings_.destinations.size() *
+                    warmup_settings_.connections);
+  for (size_t i = 0; i < multis_.size(); ++i) {
+    for (const auto& url : warmup_settings_.destinations) {
+      for (size_t j = 0; j < warmup_settings_.connections; ++j) {
+        auto request = CreateRequestForMulti(i);
+        request.head(url).timeout(warmup_settings_.timeout);
+        responses.push_back(request.async_perform());
+      }
+    }
+  }
+
+  size_t failed = 0;
+  for (auto& response : responses) {
+    try {
+      response.Get();
+    } catch (const CancelException&) {
+      throw;
+    } catch (const std::exception& e) {
+      ++failed;
+      LOG_LIMITED_WARNING() << "http client: warmup request failed: " << e;
+    }
+  }
+  LOG_DEBUG() << "http client: warmed up " << responses.size() - failed << '/'
+              << responses.size() << " connections";
 }
 
 void Client::SetMultiplexingEnabled(bool enabled) {
@@ -216,6 +368,20 @@ size_t Client::FindMultiIndex(const curl::multi* multi) const {
   throw std::logic_error("Unknown multi");
 }
 
+size_t Client::ChooseMultiIndex() const {
+  // Power of two choices: the less loaded of two random multis keeps the
+  // pending requests balanced between the io threads without a global scan.
+  const auto first = utils::RandRange(multis_.size());
+  if (multis_.size() == 1) return first;
+
+  auto second = utils::RandRange(multis_.size() - 1);
+  if (second >= first) ++second;
+  return statistics_[second].GetPendingRequests() <
+                 statistics_[first].GetPendingRequests()
+             ? second
+             : first;
+}
+
 PoolStatistics Client::GetPoolStatistics() const {
   PoolStatistics stats;
   stats.multi.reserve(multis_.size());
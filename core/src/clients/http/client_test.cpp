@@ -8,6 +8,7 @@
 
 #include <clients/http/client_utils_test.hpp>
 #include <clients/http/testsuite.hpp>
+#include <compression/gzip.hpp>
 #include <engine/task/task_processor.hpp>
 #include <userver/clients/dns/resolver.hpp>
 #include <userver/clients/http/connect_to.hpp>
@@ -612,6 +613,28 @@ UTEST(HttpClient, PostEcho) {
   }
 }
 
+UTEST(HttpClient, PostSharedData) {
+  EchoCallback cb;
+  const utest::SimpleServer http_server{cb};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  const auto data = std::make_shared<const std::string>(kTestData);
+  auto request = http_client_ptr->CreateRequest()
+                     .post(http_server.GetBaseUrl())
+                     .data(data)
+                     .retry(1)
+                     .verify(true)
+                     .http_version(clients::http::HttpVersion::k11)
+                     .timeout(kTimeout);
+
+  // The buffer is not copied
+  EXPECT_EQ(request.GetData().data(), data->data());
+
+  const auto res = request.perform();
+  EXPECT_EQ(res->body(), kTestData);
+  EXPECT_EQ(*cb.responses_200, 1);
+}
+
 UTEST(HttpClient, StatsOnTimeout) {
   const int kRetries = 5;
   const utest::SimpleServer http_server{&sleep_callback};
@@ -1321,6 +1344,155 @@ UTEST(HttpClient, Retry) {
   EXPECT_EQ(2, response->GetStats().retries_count);
 }
 
+UTEST(HttpClient, StreamedRequestBody) {
+  const utest::SimpleServer http_server{[](const HttpRequest& request) {
+    if (request.find("\r\n0\r\n\r\n") == std::string::npos) {
+      return HttpResponse{{}, HttpResponse::kTryReadMore};
+    }
+    // Echo the whole request back, including the headers and the chunks
+    return HttpResponse{
+        fmt::format("HTTP/1.1 200 OK\r\nConnection: close\r\n"
+                    "Content-Length: {}\r\n\r\n{}",
+                    request.size(), request),
+        HttpResponse::kWriteAndClose};
+  }};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  /// [HTTP Client - streamed body]
+  // The queue holds at most 16 bytes of the body
+  auto queue = concurrent::StringStreamQueue::Create(16);
+  auto response_future = http_client_ptr->CreateRequest()
+                             .post(http_server.GetBaseUrl())
+                             .data_stream(queue)
+                             .timeout(kTimeout)
+                             .async_perform();
+  {
+    auto producer = queue->GetProducer();
+    for (unsigned i = 0; i < kFewRepetitions; ++i) {
+      ASSERT_TRUE(producer.Push(fmt::format("chunk-{};", i)));
+    }
+  }  // the body ends with the destruction of the producer
+  const auto response = response_future.Get();
+  /// [HTTP Client - streamed body]
+
+  EXPECT_TRUE(response->IsOk());
+  const auto& echo = response->body();
+  EXPECT_NE(echo.find("Transfer-Encoding: chunked"), std::string::npos);
+  for (unsigned i = 0; i < kFewRepetitions; ++i) {
+    EXPECT_NE(echo.find(fmt::format("chunk-{};", i)), std::string::npos);
+  }
+}
+
+UTEST(HttpClient, GzippedRequestBody) {
+  const auto compressed = compression::gzip::Compress(kTestData);
+  const utest::SimpleServer http_server{[&compressed](
+                                            const HttpRequest& request) {
+    const auto data_pos = request.find("\r\n\r\n");
+    if (data_pos == std::string::npos ||
+        request.size() - data_pos - 4 < compressed.size()) {
+      return HttpResponse{{}, HttpResponse::kTryReadMore};
+    }
+    EXPECT_NE(request.find("Content-Encoding: gzip\r\n"), std::string::npos);
+    const auto payload = request.substr(data_pos + 4);
+    return HttpResponse{
+        fmt::format("HTTP/1.1 200 OK\r\nConnection: close\r\n"
+                    "Content-Length: {}\r\n\r\n{}",
+                    payload.size(), payload),
+        HttpResponse::kWriteAndClose};
+  }};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  const auto response = http_client_ptr->CreateRequest()
+                            .post(http_server.GetBaseUrl())
+                            .gzipped_data(kTestData)
+                            .timeout(kTimeout)
+                            .perform();
+
+  EXPECT_TRUE(response->IsOk());
+  EXPECT_EQ(response->body(), compressed);
+  EXPECT_EQ(compression::gzip::Decompress(response->body(), 1024),
+            kTestData);
+}
+
+UTEST(HttpClient, Hedging) {
+  auto http_client_ptr = utest::CreateHttpClient();
+  const utest::SimpleServer slow_server{[](const HttpRequest& request) {
+    engine::InterruptibleSleepFor(kTimeout);
+    return clients::http::Response200WithHeader{"xxx: slow"}(request);
+  }};
+  const utest::SimpleServer fast_server{
+      clients::http::Response200WithHeader{"xxx: fast"}};
+
+  clients::http::HedgingSettings settings;
+  settings.default_delay = kSmallTimeout;
+  settings.max_extra_load_percent = 100;
+
+  const auto response = http_client_ptr->PerformHedged(
+      settings, [&](std::size_t attempt) {
+        const auto& server = (attempt == 0 ? slow_server : fast_server);
+        return http_client_ptr->CreateRequest()
+            .get(server.GetBaseUrl())
+            .timeout(kTimeout)
+            .SetDestinationMetricName("hedged");
+      });
+
+  EXPECT_TRUE(response->IsOk());
+  EXPECT_EQ(response->headers()[std::string_view{"xxx"}], "fast");
+}
+
+UTEST(HttpClient, HedgingBudget) {
+  auto http_client_ptr = utest::CreateHttpClient();
+  const utest::SimpleServer slow_server{[](const HttpRequest& request) {
+    engine::SleepFor(kSmallTimeout * 2);
+    return clients::http::Response200WithHeader{"xxx: slow"}(request);
+  }};
+
+  clients::http::HedgingSettings settings;
+  settings.default_delay = kSmallTimeout / 10;
+  settings.max_extra_load_percent = 0;
+
+  std::size_t requests = 0;
+  const auto response =
+      http_client_ptr->PerformHedged(settings, [&](std::size_t) {
+        ++requests;
+        return http_client_ptr->CreateRequest()
+            .get(slow_server.GetBaseUrl())
+            .timeout(kTimeout);
+      });
+
+  EXPECT_TRUE(response->IsOk());
+  EXPECT_EQ(requests, 1);
+}
+
+UTEST(HttpClient, HedgingKeepsServerError) {
+  auto http_client_ptr = utest::CreateHttpClient();
+  const utest::SimpleServer server_error_server{[](const HttpRequest&) {
+    engine::SleepFor(kSmallTimeout * 2);
+    return HttpResponse{
+        "HTTP/1.1 500 Internal Server Error\r\nConnection: close\r\n"
+        "Content-Length: 0\r\n\r\n",
+        HttpResponse::kWriteAndClose};
+  }};
+  const utest::SimpleServer timeout_server{sleep_callback};
+
+  clients::http::HedgingSettings settings;
+  settings.default_delay = kSmallTimeout / 10;
+  settings.max_extra_load_percent = 100;
+
+  const auto response = http_client_ptr->PerformHedged(
+      settings, [&](std::size_t attempt) {
+        // The hedged request times out after the server error of the first one
+        return http_client_ptr->CreateRequest()
+            .get(attempt == 0 ? server_error_server.GetBaseUrl()
+                              : timeout_server.GetBaseUrl())
+            .timeout(attempt == 0 ? kTimeout : kSmallTimeout * 4)
+            .SetDestinationMetricName("hedged-server-error");
+      });
+
+  EXPECT_EQ(response->status_code(),
+            clients::http::Status::InternalServerError);
+}
+
 UTEST(HttpClient, TinyTimeout) {
   auto http_client_ptr = utest::CreateHttpClient();
   const utest::SimpleServer http_server{sleep_callback_1s};
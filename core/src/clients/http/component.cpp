@@ -149,6 +149,8 @@ HttpClient::HttpClient(const ComponentConfig& component_config,
       std::move(stats_name), [this](utils::statistics::Writer& writer) {
         return WriteStatistics(writer);
       });
+
+  http_client_.StartWarmup();
 }
 
 std::vector<utils::NotNull<clients::http::Plugin*>> HttpClient::FindPlugins(
@@ -253,6 +255,31 @@ properties:
         items:
             type: string
             description: plugin name
+    warmup:
+        type: object
+        description: settings of the connections warmup
+        additionalProperties: false
+        properties:
+            destinations:
+                type: array
+                description: URLs to establish the connections to at start and to keep them alive
+                defaultDescription: '[]'
+                items:
+                    type: string
+                    description: URL to send HEAD requests to
+            connections:
+                type: integer
+                description: number of connections to keep warm to each destination on each of the IO threads
+                defaultDescription: 1
+                minimum: 1
+            interval:
+                type: string
+                description: how often to repeat the warmup, the warmup requests also check the health of the idle connections
+                defaultDescription: 10s
+            timeout:
+                type: string
+                description: timeout of a warmup request
+                defaultDescription: 1s
 )");
 }
 
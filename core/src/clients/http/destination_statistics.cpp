@@ -62,6 +62,11 @@ DestinationStatistics::GetStatisticsForDestinationAuto(
   return CreateStatisticsForDestination(destination);
 }
 
+std::shared_ptr<Statistics> DestinationStatistics::GetExistingStatistics(
+    const std::string& destination) {
+  return rcu_map_.Get(destination);
+}
+
 void DestinationStatistics::SetAutoMaxSize(size_t max_auto_destinations) {
   max_auto_destinations_ = max_auto_destinations;
 }
@@ -23,6 +23,11 @@ class DestinationStatistics final {
   std::shared_ptr<RequestStats> GetStatisticsForDestinationAuto(
       const std::string& destination);
 
+  // Return pointer to the statistics of the destination if they exist,
+  // nullptr otherwise
+  std::shared_ptr<Statistics> GetExistingStatistics(
+      const std::string& destination);
+
   void SetAutoMaxSize(size_t max_auto_destinations);
 
   using DestinationsMap = rcu::RcuMap<std::string, Statistics>;
@@ -2,8 +2,10 @@
 
 #include <unordered_set>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task.hpp>
 
 #include <userver/clients/http/client.hpp>
+#include <userver/tracing/manager.hpp>
 #include <userver/utest/http_client.hpp>
 #include <userver/utest/simple_server.hpp>
 #include <userver/utest/utest.hpp>
@@ -134,4 +136,49 @@ UTEST(DestinationStatistics, Multiple) {
   }
 }
 
+UTEST(DestinationStatistics, WarmupConnectionIsReused) {
+  const utest::SimpleServer http_server{[](const HttpRequest& request) {
+    LOG_INFO() << "HTTP Server receive: " << request;
+    return HttpResponse{"HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n",
+                        HttpResponse::kWriteAndContinue};
+  }};
+  auto url = http_server.GetBaseUrl();
+
+  const tracing::GenericTracingManager tracing_manager{
+      tracing::Format::kYandexTaxi, tracing::Format::kYandexTaxi};
+  clients::http::impl::ClientSettings settings;
+  settings.io_threads = 1;
+  settings.tracing_manager = &tracing_manager;
+  settings.warmup.destinations = {url};
+  settings.warmup.timeout = utest::kMaxTestWaitTime;
+  clients::http::Client client{
+      std::move(settings), engine::current_task::GetTaskProcessor(),
+      std::vector<utils::NotNull<clients::http::Plugin*>>{}};
+  client.StartWarmup();
+
+  const auto ok =
+      static_cast<size_t>(clients::http::Statistics::ErrorGroup::kOk);
+  const auto get_stats = [&client, &url] {
+    for (const auto& [stat_url, stat_ptr] : client.GetDestinationStatistics()) {
+      if (stat_url == url) return clients::http::InstanceStatistics(*stat_ptr);
+    }
+    return clients::http::InstanceStatistics{};
+  };
+  while (get_stats().error_count[ok] == utils::statistics::Rate{0}) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+
+  auto response = client.CreateRequest()
+                      .get(url)
+                      .retry(1)
+                      .timeout(utest::kMaxTestWaitTime)
+                      .perform();
+  EXPECT_EQ(200, response->status_code());
+
+  const auto stats = get_stats();
+  EXPECT_EQ(utils::statistics::Rate{2}, stats.error_count[ok]);
+  EXPECT_EQ(utils::statistics::Rate{1}, stats.multi.socket_open);
+  EXPECT_EQ(utils::statistics::Rate{1}, stats.multi.socket_reused);
+}
+
 USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 
 #include <userver/dynamic_config/value.hpp>
 #include <userver/formats/json/value.hpp>
+#include <userver/formats/parse/common_containers.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -37,6 +38,18 @@ DeadlinePropagationConfig ParseDeadlinePropagationConfig(
   return result;
 }
 
+WarmupSettings ParseWarmupSettings(const yaml_config::YamlConfig& value) {
+  WarmupSettings result;
+  result.destinations =
+      value["destinations"].As<std::vector<std::string>>(result.destinations);
+  result.connections = value["connections"].As<size_t>(result.connections);
+  result.interval =
+      value["interval"].As<std::chrono::milliseconds>(result.interval);
+  result.timeout =
+      value["timeout"].As<std::chrono::milliseconds>(result.timeout);
+  return result;
+}
+
 }  // namespace
 
 ClientSettings Parse(const yaml_config::YamlConfig& value,
@@ -47,6 +60,7 @@ ClientSettings Parse(const yaml_config::YamlConfig& value,
   result.io_threads = value["threads"].As<size_t>(result.io_threads);
   result.defer_events = value["defer-events"].As<bool>(result.defer_events);
   result.deadline_propagation = ParseDeadlinePropagationConfig(value);
+  result.warmup = ParseWarmupSettings(value["warmup"]);
   return result;
 }
 
@@ -26,6 +26,7 @@
 #include <clients/http/request_state.hpp>
 #include <clients/http/statistics.hpp>
 #include <clients/http/testsuite.hpp>
+#include <compression/gzip.hpp>
 #include <crypto/helpers.hpp>
 #include <engine/ev/watcher/timer_watcher.hpp>
 #include <utils/impl/assert_extra.hpp>
@@ -376,6 +377,27 @@ Request Request::data(std::string data) && {
   return std::move(this->data(std::move(data)));
 }
 
+Request& Request::data(std::shared_ptr<const std::string> data) & {
+  if (data && !data->empty())
+    pimpl_->easy().add_header(kHeaderExpect, "",
+                              curl::easy::EmptyHeaderAction::kDoNotSend);
+  pimpl_->easy().set_shared_post_fields(std::move(data));
+  return *this;
+}
+Request Request::data(std::shared_ptr<const std::string> data) && {
+  return std::move(this->data(std::move(data)));
+}
+
+Request& Request::gzipped_data(std::string_view data, int level) & {
+  pimpl_->easy().add_header(USERVER_NAMESPACE::http::headers::kContentEncoding,
+                            "gzip",
+                            curl::easy::DuplicateHeaderAction::kReplace);
+  return this->data(compression::gzip::Compress(data, level));
+}
+Request Request::gzipped_data(std::string_view data, int level) && {
+  return std::move(this->gzipped_data(data, level));
+}
+
 Request& Request::form(const Form& form) & {
   pimpl_->easy().set_http_post(form.GetNative());
   pimpl_->easy().add_header(kHeaderExpect, "",
@@ -386,6 +408,16 @@ Request Request::form(const Form& form) && {
   return std::move(this->form(form));
 }
 
+Request& Request::data_stream(
+    const std::shared_ptr<concurrent::StringStreamQueue>& queue) & {
+  pimpl_->SetBodyStream(queue);
+  return *this;
+}
+Request Request::data_stream(
+    const std::shared_ptr<concurrent::StringStreamQueue>& queue) && {
+  return std::move(this->data_stream(queue));
+}
+
 Request& Request::headers(const Headers& headers) & {
   SetHeaders(pimpl_->easy(), headers);
   return *this;
@@ -501,7 +533,7 @@ Request& Request::method(HttpMethod method) & {
     case HttpMethod::kPatch:
       pimpl_->easy().set_custom_request(ToString(method));
       // ensure a body as we should send Content-Length for this method
-      if (!pimpl_->easy().has_post_data()) data({});
+      if (!pimpl_->easy().has_post_data()) data(std::string{});
       break;
   };
   return *this;
@@ -646,6 +678,10 @@ void Request::SetHeadersPropagator(
   pimpl_->SetHeadersPropagator(headers_propagator);
 }
 
+const std::string& Request::GetDestinationMetricName() const {
+  return pimpl_->GetDestinationMetricName();
+}
+
 const std::string& Request::GetUrl() const& {
   return pimpl_->easy().get_original_url();
 }
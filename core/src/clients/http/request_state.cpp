@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <map>
 #include <string_view>
 
@@ -17,6 +18,7 @@
 #include <userver/baggage/baggage.hpp>
 #include <userver/clients/dns/resolver.hpp>
 #include <userver/clients/http/connect_to.hpp>
+#include <userver/engine/async.hpp>
 #include <userver/server/request/task_inherited_data.hpp>
 #include <userver/utils/algo.hpp>
 #include <userver/utils/assert.hpp>
@@ -104,9 +106,10 @@ char* rfind_not_space(char* ptr, size_t size) {
 void SetBaggageHeader(curl::easy& e) {
   const auto* baggage = baggage::kInheritedBaggage.GetOptional();
   if (baggage != nullptr) {
-    LOG_DEBUG() << fmt::format("Send baggage: {}", baggage->ToString());
-    e.add_header(USERVER_NAMESPACE::http::headers::kXBaggage,
-                 baggage->ToString(), curl::easy::EmptyHeaderAction::kDoNotSend,
+    const auto header = baggage->ToString();
+    LOG_DEBUG() << fmt::format("Send baggage: {}", header);
+    e.add_header(USERVER_NAMESPACE::http::headers::kXBaggage, header,
+                 curl::easy::EmptyHeaderAction::kDoNotSend,
                  curl::easy::DuplicateHeaderAction::kReplace);
   }
 }
@@ -274,7 +277,11 @@ void RequestState::retry(short retries, bool on_fails) {
 }
 
 void RequestState::unix_socket_path(const std::string& path) {
-  easy().set_unix_socket_path(path);
+  if (!path.empty() && path[0] == '@') {
+    easy().set_abstract_unix_socket(path.substr(1));
+  } else {
+    easy().set_unix_socket_path(path);
+  }
 }
 
 void RequestState::connect_to(const ConnectTo& connect_to) {
@@ -313,6 +320,11 @@ void RequestState::SetDestinationMetricNameAuto(std::string destination) {
 
 void RequestState::SetDestinationMetricName(const std::string& destination) {
   dest_req_stats_ = dest_stats_->GetStatisticsForDestination(destination);
+  destination_metric_name_ = destination;
+}
+
+void RequestState::SetBodyStream(const std::shared_ptr<Queue>& queue) {
+  body_stream_ = std::make_shared<BodyStreamData>(queue->GetConsumer());
 }
 
 void RequestState::SetTestsuiteConfig(
@@ -392,6 +404,8 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
     LOG_DEBUG() << "Stream API, status code is set (with body)";
   }
 
+  if (holder->body_stream_) holder->StopBodyStream();
+
   const auto status_code = static_cast<Status>(easy.get_response_code());
 
   holder->CheckResponseDeadline(err, status_code);
@@ -403,8 +417,11 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
 
   holder->AccountResponse(err);
   const auto sockets = easy.get_num_connects();
-  holder->WithRequestStats(
-      [sockets](RequestStats& stats) { stats.AccountOpenSockets(sockets); });
+  const bool reused = !err && sockets == 0;
+  holder->WithRequestStats([sockets, reused](RequestStats& stats) {
+    stats.AccountOpenSockets(sockets);
+    if (reused) stats.AccountReusedSocket();
+  });
 
   span.AddTag(tracing::kAttempts, holder->retry_.current);
   if (holder->deadline_propagation_config_.update_header) {
@@ -605,6 +622,8 @@ engine::Future<std::shared_ptr<Response>> RequestState::async_perform(
   // set place for response body
   easy().set_sink(&response_->sink_string());
 
+  if (body_stream_) StartBodyStream();
+
   auto future = std::get_if<FullBufferedData>(&data_)->promise_.get_future();
 
   if (UpdateTimeoutFromDeadlineAndCheck()) {
@@ -631,6 +650,8 @@ engine::Future<void> RequestState::async_perform_stream(
   // Force no retries
   retry_.retries = 1;
 
+  if (body_stream_) StartBodyStream();
+
   auto future = std::get_if<StreamData>(&data_)->headers_promise.get_future();
 
   if (UpdateTimeoutFromDeadlineAndCheck()) {
@@ -909,6 +930,85 @@ size_t RequestState::StreamWriteFunction(char* ptr, size_t size, size_t nmemb,
   return CURL_WRITEFUNC_PAUSE;
 }
 
+size_t RequestState::StreamReadFunction(void* ptr, size_t size, size_t nmemb,
+                                        void* userdata) {
+  RequestState& rs = *static_cast<RequestState*>(userdata);
+  UASSERT(rs.body_stream_);
+  auto& body_stream = *rs.body_stream_;
+
+  const std::lock_guard lock{body_stream.mutex};
+  if (body_stream.is_aborted) return CURL_READFUNC_ABORT;
+
+  const auto available = body_stream.chunk.size() - body_stream.chunk_offset;
+  if (available == 0) {
+    // resumed by easy::unpause() once the next chunk is ready
+    return body_stream.is_finished ? 0 : CURL_READFUNC_PAUSE;
+  }
+
+  const auto bytes = std::min(available, size * nmemb);
+  std::memcpy(ptr, body_stream.chunk.data() + body_stream.chunk_offset, bytes);
+  body_stream.chunk_offset += bytes;
+  if (body_stream.chunk_offset == body_stream.chunk.size()) {
+    body_stream.chunk_consumed.Send();
+  }
+  return bytes;
+}
+
+void RequestState::StartBodyStream() {
+  UASSERT(body_stream_);
+
+  // The body is read by StreamReadFunction, its size is not known beforehand
+  easy().set_post(true);
+  easy().set_post_fields(static_cast<void*>(nullptr));
+  easy().set_post_field_size_large(-1);
+  easy().set_read_function(&RequestState::StreamReadFunction);
+  easy().set_read_data(this);
+  easy().add_header(USERVER_NAMESPACE::http::headers::kTransferEncoding,
+                    "chunked", curl::easy::DuplicateHeaderAction::kReplace);
+  easy().add_header(USERVER_NAMESPACE::http::headers::kExpect, "",
+                    curl::easy::EmptyHeaderAction::kDoNotSend,
+                    curl::easy::DuplicateHeaderAction::kReplace);
+  // The body can not be sent again
+  retry_.retries = 1;
+
+  // Moves the chunks from the queue one by one, so that the producer waits
+  // in Push() while the queue is full and the body is not sent
+  engine::CriticalAsyncNoSpan([holder = shared_from_this(),
+                               body_stream = body_stream_,
+                               deadline = engine::Deadline::FromDuration(
+                                   original_timeout_)] {
+    while (true) {
+      std::string chunk;
+      const bool has_chunk = body_stream->queue_consumer.Pop(chunk, deadline);
+      if (has_chunk && chunk.empty()) continue;
+
+      {
+        const std::lock_guard lock{body_stream->mutex};
+        if (body_stream->is_aborted) return;
+        body_stream->chunk = std::move(chunk);
+        body_stream->chunk_offset = 0;
+        if (!has_chunk) {
+          body_stream->is_finished =
+              body_stream->queue_consumer.Queue()->NoMoreProducers();
+          body_stream->is_aborted = !body_stream->is_finished;
+        }
+      }
+      holder->easy().unpause();
+
+      if (!has_chunk) return;
+      if (!body_stream->chunk_consumed.WaitForEventUntil(deadline)) return;
+    }
+  }).Detach();
+}
+
+void RequestState::StopBodyStream() {
+  UASSERT(body_stream_);
+
+  const std::lock_guard lock{body_stream_->mutex};
+  body_stream_->is_aborted = true;
+  body_stream_->chunk_consumed.Send();
+}
+
 void RequestState::ApplyTestsuiteConfig() {
   if (!testsuite_config_) {
     return;
@@ -3,6 +3,7 @@
 #include <array>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <system_error>
@@ -18,6 +19,7 @@
 #include <userver/crypto/private_key.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/future.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/http/url.hpp>
 #include <userver/tracing/in_place_span.hpp>
@@ -93,6 +95,8 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   /// sets proxy auth type and credentials to use
   void http_auth_type(curl::easy::httpauth_t value, bool auth_only,
                       std::string_view user, std::string_view password);
+  /// set the queue to read the request body from
+  void SetBodyStream(const std::shared_ptr<Queue>& queue);
 
   /// get timeout value in milliseconds
   long timeout() const { return original_timeout_.count(); }
@@ -112,6 +116,10 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
 
   void SetDestinationMetricName(const std::string& destination);
 
+  const std::string& GetDestinationMetricName() const noexcept {
+    return destination_metric_name_;
+  }
+
   void SetTestsuiteConfig(const std::shared_ptr<const TestsuiteConfig>& config);
 
   void SetAllowedUrlsExtra(const std::vector<std::string>& urls);
@@ -167,6 +175,11 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
 
   static size_t StreamWriteFunction(char* ptr, size_t size, size_t nmemb,
                                     void* userdata);
+  static size_t StreamReadFunction(void* ptr, size_t size, size_t nmemb,
+                                   void* userdata);
+
+  void StartBodyStream();
+  void StopBodyStream();
 
   void AccountResponse(std::error_code err);
   std::exception_ptr PrepareException(std::error_code err);
@@ -248,6 +261,25 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   };
 
   std::variant<FullBufferedData, StreamData> data_;
+
+  struct BodyStreamData {
+    BodyStreamData(Queue::Consumer&& queue_consumer)
+        : queue_consumer(std::move(queue_consumer)) {}
+
+    Queue::Consumer queue_consumer;
+
+    // Guards the fields below, they are accessed from the ev thread and from
+    // the task that moves the chunks from the queue
+    std::mutex mutex;
+    std::string chunk;
+    std::size_t chunk_offset{0};
+    bool is_finished{false};
+    bool is_aborted{false};
+
+    engine::SingleConsumerEvent chunk_consumed;
+  };
+
+  std::shared_ptr<BodyStreamData> body_stream_;
 };
 
 }  // namespace clients::http
@@ -1,5 +1,7 @@
 #include <clients/http/statistics.hpp>
 
+#include <algorithm>
+
 #include <curl-ev/error_code.hpp>
 
 #include <userver/logging/log.hpp>
@@ -13,6 +15,13 @@ namespace clients::http {
 
 namespace {
 
+// Hedging budget is accounted in 1/kHedgeCost parts of a request
+constexpr std::int64_t kHedgeCost = 10'000;
+// Allows short bursts of hedged requests after a quiet period
+constexpr std::int64_t kMaxHedgingBudget = 10 * kHedgeCost;
+// Percentiles of fewer timings are too noisy to hedge upon
+constexpr std::size_t kMinTimingsForPercentile = 100;
+
 template <typename T, typename U>
 T SumToMean(T sum, U count) {
   if (count == 0) return 0;
@@ -62,6 +71,8 @@ void RequestStats::AccountOpenSockets(size_t sockets) noexcept {
   stats_.socket_open_ += utils::statistics::Rate{sockets};
 }
 
+void RequestStats::AccountReusedSocket() noexcept { ++stats_.socket_reused_; }
+
 void RequestStats::AccountTimeoutUpdatedByDeadline() noexcept {
   ++stats_.timeout_updated_by_deadline_;
 }
@@ -139,6 +150,35 @@ void Statistics::AccountError(ErrorGroup error) {
 
 void Statistics::AccountStatus(int code) { reply_status_.Account(code); }
 
+std::optional<std::chrono::milliseconds> Statistics::GetRecentTimingsPercentile(
+    double percent) const {
+  const auto timings = timings_percentile_.GetStatsForPeriod();
+  if (timings.Count() < kMinTimingsForPercentile) return std::nullopt;
+  return std::chrono::milliseconds{timings.GetPercentile(percent)};
+}
+
+void Statistics::AccountHedgingBudget(double extra_load_percent) noexcept {
+  const auto deposit =
+      static_cast<std::int64_t>(extra_load_percent * kHedgeCost / 100);
+  auto budget = hedging_budget_.load();
+  while (budget < kMaxHedgingBudget &&
+         !hedging_budget_.compare_exchange_weak(
+             budget, std::min(budget + deposit, kMaxHedgingBudget))) {
+  }
+}
+
+bool Statistics::TryConsumeHedgingBudget() noexcept {
+  auto budget = hedging_budget_.load();
+  do {
+    if (budget < kHedgeCost) return false;
+  } while (!hedging_budget_.compare_exchange_weak(budget, budget - kHedgeCost));
+
+  ++hedged_;
+  return true;
+}
+
+void Statistics::AccountHedgeWin() noexcept { ++hedge_wins_; }
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const DestinationStatisticsView& view) {
   const auto& stats = view.stats;
@@ -160,7 +200,13 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["timeout-updated-by-deadline"] = stats.timeout_updated_by_deadline;
   writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
 
+  writer["hedging"]["sent"] = stats.hedged;
+  writer["hedging"]["wins"] = stats.hedge_wins;
+
   writer["sockets"]["open"] = stats.multi.socket_open;
+  // requests served over an already established connection, the reuse
+  // ratio is reused / (reused + open)
+  writer["sockets"]["reused"] = stats.multi.socket_reused;
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -199,10 +245,13 @@ InstanceStatistics::InstanceStatistics(const Statistics& other)
       retries(other.retries_.Load()),
       timeout_updated_by_deadline(other.timeout_updated_by_deadline_.Load()),
       cancelled_by_deadline(other.cancelled_by_deadline_.Load()),
-      reply_status(other.reply_status_) {
+      reply_status(other.reply_status_),
+      hedged(other.hedged_.Load()),
+      hedge_wins(other.hedge_wins_.Load()) {
   for (size_t i = 0; i < error_count.size(); i++)
     error_count[i] = other.error_count_[i].Load();
   multi.socket_open = other.socket_open_.Load();
+  multi.socket_reused = other.socket_reused_.Load();
 }
 
 uint64_t InstanceStatistics::GetNotOkErrorCount() const {
@@ -235,6 +284,9 @@ InstanceStatistics& InstanceStatistics::operator+=(
   cancelled_by_deadline += stat.cancelled_by_deadline;
   reply_status += stat.reply_status;
 
+  hedged += stat.hedged;
+  hedge_wins += stat.hedge_wins;
+
   multi += stat.multi;
   return *this;
 }
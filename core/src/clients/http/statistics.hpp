@@ -1,7 +1,9 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -31,6 +33,7 @@ class RequestStats final {
   void StoreTimeToStart(std::chrono::microseconds micro_seconds) noexcept;
 
   void AccountOpenSockets(size_t sockets) noexcept;
+  void AccountReusedSocket() noexcept;
 
   void AccountTimeoutUpdatedByDeadline() noexcept;
   void AccountCancelledByDeadline() noexcept;
@@ -44,12 +47,14 @@ class RequestStats final {
 
 struct MultiStats {
   utils::statistics::Rate socket_open;
+  utils::statistics::Rate socket_reused;
   utils::statistics::Rate socket_close;
   utils::statistics::Rate socket_ratelimit;
   double current_load{0};
 
   MultiStats& operator+=(const MultiStats& other) {
     socket_open += other.socket_open;
+    socket_reused += other.socket_reused;
     socket_close += other.socket_close;
     socket_ratelimit += other.socket_ratelimit;
     current_load += other.current_load;
@@ -88,10 +93,25 @@ class Statistics {
 
   static const char* ToString(ErrorGroup error);
 
+  std::uint64_t GetPendingRequests() const noexcept {
+    return easy_handles_.load(std::memory_order_relaxed);
+  }
+
   void AccountError(ErrorGroup error);
 
   void AccountStatus(int);
 
+  // Returns the percentile of the recent request timings, or std::nullopt if
+  // there are too few requests to rely on
+  std::optional<std::chrono::milliseconds> GetRecentTimingsPercentile(
+      double percent) const;
+
+  // Each request adds `extra_load_percent` percents of a request to the
+  // hedging budget, each hedged request consumes the whole request
+  void AccountHedgingBudget(double extra_load_percent) noexcept;
+  bool TryConsumeHedgingBudget() noexcept;
+  void AccountHedgeWin() noexcept;
+
  private:
   std::atomic<uint64_t> easy_handles_{0};
   std::atomic<uint64_t> last_time_to_start_us_{0};
@@ -101,9 +121,13 @@ class Statistics {
   std::array<utils::statistics::RateCounter, kErrorGroupCount> error_count_;
   utils::statistics::RateCounter retries_;
   utils::statistics::RateCounter socket_open_{0};
+  utils::statistics::RateCounter socket_reused_{0};
   utils::statistics::RateCounter timeout_updated_by_deadline_;
   utils::statistics::RateCounter cancelled_by_deadline_;
   utils::statistics::HttpCodes reply_status_;
+  std::atomic<std::int64_t> hedging_budget_{0};
+  utils::statistics::RateCounter hedged_;
+  utils::statistics::RateCounter hedge_wins_;
 
   friend struct InstanceStatistics;
   friend class RequestStats;
@@ -132,6 +156,9 @@ struct InstanceStatistics {
   utils::statistics::Rate cancelled_by_deadline;
   utils::statistics::HttpCodes::Snapshot reply_status;
 
+  utils::statistics::Rate hedged;
+  utils::statistics::Rate hedge_wins;
+
   MultiStats multi;
 };
 
@@ -67,6 +67,7 @@ components_manager:
 # yaml
     dump-configurator:
       dump-root: $userver-dumps-root
+      max-concurrent-reads: 4
 # /// [Sample dump configurator component config]
 # /// [Sample testsuite support component config]
 # yaml
@@ -108,6 +109,8 @@ components_manager:
       cache-size-per-way: 256
       cache-max-reply-ttl: 5m
       cache-failure-ttl: 5s
+      cache-max-failure-ttl: 1m
+      cache-update-ratio: 0.1
 # /// [Sample dns client component config]
 # /// [Sample dynamic configs client component config]
 # yaml
@@ -40,6 +40,10 @@ void ComponentContext::OnAllComponentsAreStopping() {
 
 void ComponentContext::ClearComponents() { impl_->ClearComponents(); }
 
+impl::StartupReport ComponentContext::GetStartupReport() const {
+  return impl_->MakeStartupReport();
+}
+
 engine::TaskProcessor& ComponentContext::GetTaskProcessor(
     const std::string& name) const {
   return impl_->GetTaskProcessor(name);
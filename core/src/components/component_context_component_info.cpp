@@ -149,6 +149,31 @@ std::string ComponentInfo::GetDependencies() const {
                      fmt::join(it_depends_on_, delimiter));
 }
 
+void ComponentInfo::SetCreationTime(
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point finish) {
+  std::lock_guard<engine::Mutex> lock(mutex_);
+  timings_.create_start = start;
+  timings_.create_finish = finish;
+}
+
+void ComponentInfo::AddDependenciesWait(
+    std::chrono::steady_clock::duration duration) {
+  std::lock_guard<engine::Mutex> lock(mutex_);
+  timings_.dependencies_wait += duration;
+}
+
+void ComponentInfo::SetOnAllComponentsLoadedDuration(
+    std::chrono::steady_clock::duration duration) {
+  std::lock_guard<engine::Mutex> lock(mutex_);
+  timings_.on_all_components_loaded = duration;
+}
+
+ComponentTimings ComponentInfo::GetTimings() const {
+  std::lock_guard<engine::Mutex> lock(mutex_);
+  return timings_;
+}
+
 bool ComponentInfo::HasComponent() const {
   std::lock_guard<engine::Mutex> lock(mutex_);
   return !!component_;
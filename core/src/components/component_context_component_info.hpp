@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <set>
 #include <string>
@@ -27,6 +28,14 @@ class StageSwitchingCancelledException : public std::runtime_error {
   explicit StageSwitchingCancelledException(const std::string& message);
 };
 
+struct ComponentTimings {
+  std::chrono::steady_clock::time_point create_start;
+  std::chrono::steady_clock::time_point create_finish;
+  // total time the constructor was blocked in FindComponent()
+  std::chrono::steady_clock::duration dependencies_wait{};
+  std::chrono::steady_clock::duration on_all_components_loaded{};
+};
+
 class ComponentInfo final {
  public:
   explicit ComponentInfo(std::string name);
@@ -72,6 +81,13 @@ class ComponentInfo final {
 
   std::string GetDependencies() const;
 
+  void SetCreationTime(std::chrono::steady_clock::time_point start,
+                       std::chrono::steady_clock::time_point finish);
+  void AddDependenciesWait(std::chrono::steady_clock::duration duration);
+  void SetOnAllComponentsLoadedDuration(
+      std::chrono::steady_clock::duration duration);
+  ComponentTimings GetTimings() const;
+
  private:
   bool HasComponent() const;
   std::unique_ptr<ComponentBase> ExtractComponent();
@@ -90,6 +106,7 @@ class ComponentInfo final {
   std::set<ComponentNameFromInfo> it_depends_on_;
   std::set<ComponentNameFromInfo> depends_on_it_;
   ComponentLifetimeStage stage_ = ComponentLifetimeStage::kNull;
+  ComponentTimings timings_;
   bool stage_switching_cancelled_{false};
   std::atomic<bool> on_loading_cancelled_called_{false};
 };
@@ -1,6 +1,7 @@
 #include <components/component_context_impl.hpp>
 
 #include <algorithm>
+#include <optional>
 #include <queue>
 
 #include <fmt/format.h>
@@ -80,7 +81,7 @@ ComponentContext::Impl::SearchingComponentScope::~SearchingComponentScope() {
 
 ComponentContext::Impl::Impl(const Manager& manager,
                              std::vector<std::string>&& loading_component_names)
-    : manager_(manager) {
+    : manager_(manager), load_start_(std::chrono::steady_clock::now()) {
   UASSERT(std::is_sorted(loading_component_names.begin(),
                          loading_component_names.end()));
   UASSERT(std::unique(loading_component_names.begin(),
@@ -117,7 +118,10 @@ impl::ComponentBase* ComponentContext::Impl::AddComponent(
     throw std::runtime_error("trying to add component " + std::string{name} +
                              " multiple times");
 
+  const auto create_start = std::chrono::steady_clock::now();
   component_info.SetComponent(factory(context));
+  component_info.SetCreationTime(create_start,
+                                 std::chrono::steady_clock::now());
   auto* component = component_info.GetComponent();
   if (component) {
     // Call the following command on logs to get the component dependencies:
@@ -258,7 +262,12 @@ void ComponentContext::Impl::ProcessSingleComponentLifetimeStageSwitching(
 
     LOG_DEBUG() << "Call " << params.stage_switch_handler_name
                 << " for component " << name;
+    const auto handler_start = std::chrono::steady_clock::now();
     (component_info.*params.stage_switch_handler)();
+    if (params.next_stage == impl::ComponentLifetimeStage::kRunning) {
+      component_info.SetOnAllComponentsLoadedDuration(
+          std::chrono::steady_clock::now() - handler_start);
+    }
   } catch (const impl::StageSwitchingCancelledException& ex) {
     LOG_WARNING() << params.stage_switch_handler_name
                   << " failed for component " << name << ": " << ex;
@@ -343,7 +352,85 @@ impl::ComponentBase* ComponentContext::Impl::DoFindComponent(
   }
   SearchingComponentScope finder(*this, this_component_name);
 
-  return component_info.WaitAndGetComponent();
+  const auto wait_start = std::chrono::steady_clock::now();
+  component = component_info.WaitAndGetComponent();
+  components_.at(this_component_name)
+      .AddDependenciesWait(std::chrono::steady_clock::now() - wait_start);
+  return component;
+}
+
+impl::StartupReport ComponentContext::Impl::MakeStartupReport() const {
+  const auto to_ms = [](std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+  };
+
+  std::unordered_map<impl::ComponentNameFromInfo, impl::ComponentTimings>
+      timings;
+  timings.reserve(components_.size());
+  for (const auto& [name, component_info] : components_) {
+    timings.emplace(name, component_info.GetTimings());
+  }
+
+  // Walk back from the component constructed last, each time stepping to the
+  // dependency that was constructed last while its dependent already waited
+  std::vector<impl::ComponentNameFromInfo> critical_path;
+  const auto last = std::max_element(
+      timings.begin(), timings.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second.create_finish < rhs.second.create_finish;
+      });
+  if (last != timings.end() &&
+      last->second.create_finish != std::chrono::steady_clock::time_point{}) {
+    auto current = last->first;
+    for (;;) {
+      critical_path.push_back(current);
+      const auto& current_timings = timings.at(current);
+      std::optional<impl::ComponentNameFromInfo> next;
+      components_.at(current).ForEachItDependsOn(
+          [&](impl::ComponentNameFromInfo dependency) {
+            const auto& dependency_timings = timings.at(dependency);
+            if (dependency_timings.create_finish <=
+                current_timings.create_start) {
+              return;
+            }
+            if (!next || timings.at(*next).create_finish <
+                             dependency_timings.create_finish) {
+              next = dependency;
+            }
+          });
+      if (!next) break;
+      current = *next;
+    }
+  }
+
+  impl::StartupReport report;
+  report.components.reserve(timings.size());
+  for (const auto& [name, component_timings] : timings) {
+    const bool is_created = component_timings.create_finish !=
+                            std::chrono::steady_clock::time_point{};
+    if (!is_created) continue;
+    auto& component = report.components.emplace_back();
+    component.name = std::string{name.StringViewName()};
+    component.create_start =
+        to_ms(component_timings.create_start - load_start_);
+    component.create_duration =
+        to_ms(component_timings.create_finish - component_timings.create_start);
+    component.dependencies_wait = to_ms(component_timings.dependencies_wait);
+    component.on_all_components_loaded =
+        to_ms(component_timings.on_all_components_loaded);
+    component.is_on_critical_path =
+        std::find(critical_path.begin(), critical_path.end(), name) !=
+        critical_path.end();
+  }
+  std::sort(report.components.begin(), report.components.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.create_start < rhs.create_start;
+            });
+
+  report.critical_path.reserve(critical_path.size());
+  for (auto it = critical_path.rbegin(); it != critical_path.rend(); ++it) {
+    report.critical_path.emplace_back(it->StringViewName());
+  }
+  return report;
 }
 
 void ComponentContext::Impl::AddDependency(impl::ComponentNameFromInfo name) {
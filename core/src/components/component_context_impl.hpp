@@ -3,6 +3,7 @@
 #include <userver/components/component_context.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <set>
 #include <stdexcept>
 #include <unordered_map>
@@ -18,6 +19,7 @@
 
 #include <components/component_context_component_info.hpp>
 #include <components/impl/component_name_from_info.hpp>
+#include <components/impl/startup_report.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -55,6 +57,8 @@ struct ComponentContext::Impl {
 
   impl::ComponentBase* DoFindComponent(std::string_view name);
 
+  impl::StartupReport MakeStartupReport() const;
+
  private:
   class TaskToComponentMapScope final {
    public:
@@ -140,6 +144,7 @@ struct ComponentContext::Impl {
   void PrintAddingComponents() const;
 
   const Manager& manager_;
+  const std::chrono::steady_clock::time_point load_start_;
 
   ComponentMap components_;
   std::atomic_flag components_load_cancelled_ ATOMIC_FLAG_INIT;
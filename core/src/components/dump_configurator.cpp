@@ -3,6 +3,8 @@
 #include <userver/components/component.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include <dump/read_scheduler.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace components {
@@ -10,10 +12,18 @@ namespace components {
 DumpConfigurator::DumpConfigurator(const ComponentConfig& config,
                                    const ComponentContext& context)
     : LoggableComponentBase(config, context),
-      dump_root_(config["dump-root"].As<std::string>()) {}
+      dump_root_(config["dump-root"].As<std::string>()),
+      read_scheduler_(std::make_unique<dump::ReadScheduler>(
+          config["max-concurrent-reads"].As<std::size_t>(0))) {}
+
+DumpConfigurator::~DumpConfigurator() = default;
 
 const std::string& DumpConfigurator::GetDumpRoot() const { return dump_root_; }
 
+dump::ReadScheduler& DumpConfigurator::GetReadScheduler() const {
+  return *read_scheduler_;
+}
+
 yaml_config::Schema DumpConfigurator::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<LoggableComponentBase>(R"(
 type: object
@@ -23,6 +33,13 @@ properties:
     dump-root:
         type: string
         description: Components store dumps in subdirectories of this directory
+    max-concurrent-reads:
+        type: integer
+        description: |
+            max number of dumps that are read at the same time, the largest
+            dumps are read first; 0 means no limit
+        defaultDescription: 0
+        minimum: 0
 )");
 }
 
@@ -7,6 +7,17 @@ USERVER_NAMESPACE_BEGIN
 
 namespace components {
 
+namespace {
+
+std::optional<std::size_t> GetMmapMinSize(
+    const components::ComponentConfig& config) {
+  const auto size = config["mmap-min-size"].As<std::size_t>(0);
+  if (size == 0) return std::nullopt;
+  return size;
+}
+
+}  // namespace
+
 const FsCache::Client& FsCache::GetClient() const { return client_; }
 
 FsCache::FsCache(const components::ComponentConfig& config,
@@ -16,7 +27,8 @@ FsCache::FsCache(const components::ComponentConfig& config,
           config["dir"].As<std::string>("/var/www"),
           config["update-period"].As<std::chrono::milliseconds>(0),
           context.GetTaskProcessor(config["fs-task-processor"].As<std::string>(
-              "fs-task-processor"))) {}
+              "fs-task-processor")),
+          GetMmapMinSize(config)) {}
 
 yaml_config::Schema FsCache::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
@@ -37,6 +49,15 @@ properties:
         type: string
         description: task processor to do filesystem operations
         defaultDescription: fs-task-processor
+    mmap-min-size:
+        type: integer
+        description: |
+            files of at least this size in bytes are kept memory mapped
+            instead of being copied into memory, 0 - never map files;
+            the mapped files must not be truncated or rewritten in place,
+            otherwise the process gets SIGBUS
+        defaultDescription: 0
+        minimum: 0
 )");
 }
 
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components::impl {
+
+struct ComponentStartupReport {
+  std::string name;
+  // relative to the start of components loading
+  std::chrono::milliseconds create_start{0};
+  std::chrono::milliseconds create_duration{0};
+  std::chrono::milliseconds dependencies_wait{0};
+  std::chrono::milliseconds on_all_components_loaded{0};
+  bool is_on_critical_path{false};
+};
+
+struct StartupReport {
+  // sorted by the construction start
+  std::vector<ComponentStartupReport> components;
+
+  // The chain of components that defines the time of construction of all the
+  // components: each of them waited for the previous one in FindComponent().
+  // Starts with the component that was constructed first.
+  std::vector<std::string> critical_path;
+};
+
+}  // namespace components::impl
+
+USERVER_NAMESPACE_END
@@ -7,7 +7,7 @@
 #include <thread>
 #include <type_traits>
 
-#include <fmt/core.h>
+#include <fmt/format.h>
 
 #include <components/manager_config.hpp>
 #include <engine/task/exception_hacks.hpp>
@@ -95,6 +95,19 @@ void ValidateConfigs(const components::ComponentList& component_list,
   }
 }
 
+void LogStartupReport(const components::impl::StartupReport& report) {
+  for (const auto& component : report.components) {
+    LOG_DEBUG() << "Component " << component.name << " started at "
+                << component.create_start.count() << "ms, constructed in "
+                << component.create_duration.count() << "ms (waited for "
+                << "dependencies for " << component.dependencies_wait.count()
+                << "ms), OnAllComponentsLoaded() took "
+                << component.on_all_components_loaded.count() << "ms";
+  }
+  LOG_INFO() << "Components construction critical path: "
+             << fmt::to_string(fmt::join(report.critical_path, " -> "));
+}
+
 }  // namespace
 
 namespace components {
@@ -232,6 +245,10 @@ std::chrono::milliseconds Manager::GetLoadDuration() const {
   return load_duration_;
 }
 
+impl::StartupReport Manager::GetStartupReport() const {
+  return component_context_.GetStartupReport();
+}
+
 void Manager::CreateComponentContext(const ComponentList& component_list) {
   std::set<std::string> loading_component_names;
   for (const auto& adder : component_list) {
@@ -373,6 +390,7 @@ void Manager::AddComponents(const ComponentList& component_list) {
   auto stop_time = std::chrono::steady_clock::now();
   load_duration_ = std::chrono::duration_cast<std::chrono::milliseconds>(
       stop_time - start_time);
+  LogStartupReport(component_context_.GetStartupReport());
 
   LOG_INFO() << "All components loaded";
 }
@@ -14,6 +14,8 @@
 #include <userver/components/impl/component_base.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 
+#include <components/impl/startup_report.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::impl {
@@ -52,6 +54,10 @@ class Manager final {
 
   std::chrono::milliseconds GetLoadDuration() const;
 
+  // Safe to call concurrently with the components loading, the timings of
+  // the components that are not loaded yet are zero
+  impl::StartupReport GetStartupReport() const;
+
  private:
   class TaskProcessorsStorage {
    public:
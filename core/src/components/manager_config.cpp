@@ -103,6 +103,38 @@ properties:
                 type: integer
                 description: size of a single coroutine, bytes
                 defaultDescription: 256 * 1024
+            stack_size_classes:
+                type: array
+                description: |
+                    additional coroutine stack sizes, bytes. A task runs on
+                    the smallest one that fits the size requested by its
+                    task processor `stack-size` or by engine::StackSize
+                defaultDescription: '[]'
+                items:
+                    type: integer
+                    description: stack size, bytes
+                    minimum: 1
+            stack_usage_sample_every:
+                type: integer
+                description: |
+                    measure the stack high-water mark of each N-th coroutine
+                    and report the recommended stack size per task kind in
+                    `engine.coro-pool.stack-usage` metrics, 0 to disable
+                defaultDescription: 0
+                minimum: 0
+            idle_stacks_release_period:
+                type: string
+                description: |
+                    release the memory of the coroutine stacks that stayed
+                    idle for the whole period to the OS, 0 to disable
+                defaultDescription: 0
+            huge_pages:
+                type: boolean
+                description: |
+                    advise the kernel to back the coroutine stacks with
+                    transparent huge pages, only the stacks of at least 2MiB
+                    could get them
+                defaultDescription: false
     event_thread_pool:
         type: object
         description: event thread pool options
@@ -125,6 +157,27 @@ properties:
                 description: >
                     Whether to defer timer events to a per-thread periodic timer
                     or notify ev-loop right away
+            cpu-affinity:
+                type: string
+                description: >
+                    CPUs to pin the ev threads to in the Linux cpulist format,
+                    for example '0-7,16-23'. Mutually exclusive with numa-node
+            numa-node:
+                type: integer
+                description: >
+                    NUMA node to pin the ev threads to. Mutually exclusive with
+                    cpu-affinity
+            io_engine:
+                type: string
+                description: >
+                    I/O engine for sockets and pipes. With io_uring the
+                    operations that would block are submitted to a per ev
+                    thread io_uring instead of waiting for readiness via libev.
+                    Falls back to libev if io_uring is not supported
+                defaultDescription: libev
+                enum:
+                  - libev
+                  - io_uring
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -148,6 +201,20 @@ properties:
                     type: boolean
                     description: .
                     defaultDescription: false
+                autoscale:
+                    type: boolean
+                    description: |
+                        let engine::TaskProcessorsLoadMonitor park and unpark
+                        the worker threads at runtime, depending on the
+                        cgroup CPU throttling and the task queue wait time
+                    defaultDescription: false
+                min-worker-threads:
+                    type: integer
+                    description: |
+                        minimal number of the active worker threads if
+                        autoscale is enabled
+                    defaultDescription: 1
+                    minimum: 1
                 os-scheduling:
                     type: string
                     description: |
@@ -166,6 +233,78 @@ properties:
                         tunes the number of spin-wait iterations in case of
                         an empty task queue before threads go to sleep
                     defaultDescription: 10000
+                io-poll-iterations:
+                    type: integer
+                    description: |
+                        number of non-blocking poll(2) calls a task makes on
+                        a socket that is not ready, before waiting for it in
+                        the ev thread. The polling is done only while the
+                        task queue is empty, it saves the wakeup through the
+                        ev thread on fast replies at the cost of CPU. 0
+                        disables the polling
+                    defaultDescription: 0
+                    minimum: 0
+                jemalloc-arena:
+                    type: boolean
+                    description: |
+                        whether the workers allocate from a jemalloc arena of
+                        their own, so that the long-lived data allocated by
+                        the task processor does not share pages with the
+                        short-lived garbage of the other task processors.
+                        The arena is reported in the
+                        `engine.task-processors.jemalloc-arena` metrics
+                    defaultDescription: false
+                task-processor-queue:
+                    type: string
+                    description: |
+                        task queue implementation. `global-task-queue` is a
+                        single queue shared by all the workers.
+                        `work-stealing-task-queue` uses a local queue per
+                        worker with stealing from siblings, it scales better
+                        on machines with many cores.
+                        `priority-task-queue` serves the tasks according to
+                        engine::TaskPriority, see priority-starvation-limit
+                        and priority-deadline-ordering.
+                    defaultDescription: global-task-queue
+                    enum:
+                      - global-task-queue
+                      - work-stealing-task-queue
+                      - priority-task-queue
+                priority-starvation-limit:
+                    type: integer
+                    description: |
+                        for priority-task-queue, each N-th task taken by
+                        a worker comes from a lower priority class if there
+                        is any, 0 for the strict priorities
+                    defaultDescription: 16
+                    minimum: 0
+                priority-deadline-ordering:
+                    type: boolean
+                    description: |
+                        for priority-task-queue, run the normal priority
+                        tasks with a scheduling deadline (e.g. the request
+                        deadline) earliest-deadline-first, before the tasks
+                        without a deadline
+                    defaultDescription: false
+                cpu-affinity:
+                    type: string
+                    description: |
+                        CPUs to pin the task processor threads to in the Linux
+                        cpulist format, for example '0-7,16-23'. Mutually
+                        exclusive with numa-node
+                numa-node:
+                    type: integer
+                    description: |
+                        NUMA node to pin the task processor threads to.
+                        Mutually exclusive with cpu-affinity
+                stack-size:
+                    type: integer
+                    description: |
+                        coroutine stack size of the tasks, bytes. The smallest
+                        of coro_pool.stack_size and coro_pool.stack_size_classes
+                        that fits is used
+                    defaultDescription: coro_pool.stack_size
+                    minimum: 1
                 task-trace:
                     type: object
                     description: .
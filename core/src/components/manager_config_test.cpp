@@ -33,6 +33,8 @@ components_manager:
       worker_threads: $bg_worker_threads
       worker_threads#fallback: 2
       os-scheduling: low-priority
+      cpu-affinity: 0-1,3
+      task-processor-queue: work-stealing-task-queue
     fs-task-processor:
       thread_name: fs-worker
       worker_threads: $fs_worker_threads
@@ -225,6 +227,25 @@ TEST(ManagerConfig, Basic) {
       [](const auto& conf) { return conf.Name() == "logging-configurator"; }));
 }
 
+TEST(ManagerConfig, TaskProcessorOptions) {
+  const auto mc = MakeManagerConfig();
+
+  const auto it = std::find_if(
+      mc.task_processors.cbegin(), mc.task_processors.cend(),
+      [](const auto& tp) { return tp.thread_name == "bg-worker"; });
+  ASSERT_NE(it, mc.task_processors.cend());
+
+  EXPECT_EQ(it->cpu_affinity.cpus, (std::vector<std::size_t>{0, 1, 3}));
+  EXPECT_FALSE(it->cpu_affinity.numa_node);
+  EXPECT_EQ(it->task_queue, engine::TaskQueueType::kWorkStealingTaskQueue);
+
+  for (const auto& tp : mc.task_processors) {
+    if (&tp == &*it) continue;
+    EXPECT_TRUE(tp.cpu_affinity.cpus.empty());
+    EXPECT_EQ(tp.task_queue, engine::TaskQueueType::kGlobalTaskQueue);
+  }
+}
+
 TEST(ManagerConfig, HandlerConfig) {
   const auto mc = MakeManagerConfig();
 
@@ -1,5 +1,9 @@
 #include <userver/components/manager_controller_component.hpp>
 
+#include <algorithm>
+#include <map>
+#include <string>
+
 #include <components/manager_config.hpp>
 #include <components/manager_controller_component_config.hpp>
 #include <engine/task/task_processor.hpp>
@@ -8,7 +12,9 @@
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
 #include <userver/logging/component.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/utils/statistics/metadata.hpp>
+#include <utils/jemalloc.hpp>
 
 #include <components/manager.hpp>
 
@@ -49,12 +55,64 @@ void DumpMetric(utils::statistics::Writer& writer,
   }
 
   writer["worker-threads"] = task_processor.GetWorkerCount();
+  writer["worker-threads-active"] = task_processor.GetActiveWorkerCount();
+
+  if (const auto arena = task_processor.GetJemallocArena()) {
+    if (const auto stats = utils::jemalloc::GetArenaStats(*arena)) {
+      auto arena_writer = writer["jemalloc-arena"];
+      arena_writer["active-bytes"] = stats->active_bytes;
+      arena_writer["dirty-bytes"] = stats->dirty_bytes;
+      arena_writer["muzzy-bytes"] = stats->muzzy_bytes;
+    }
+  }
+}
+
+namespace {
+
+struct NumaNodeStats {
+  std::size_t worker_threads{0};
+  std::size_t tasks_queued{0};
+  std::size_t tasks_running{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const NumaNodeStats& stats) {
+  writer["worker-threads"] = stats.worker_threads;
+  if (auto tasks = writer["tasks"]) {
+    tasks["queued"] = stats.tasks_queued;
+    tasks["running"] = stats.tasks_running;
+  }
 }
 
+}  // namespace
+
 }  // namespace engine
 
 namespace components {
 
+namespace {
+
+void UpdateJemallocDecay(
+    std::optional<std::chrono::milliseconds> new_decay,
+    std::optional<std::chrono::milliseconds>& current_decay,
+    std::error_code (*set_decay)(std::chrono::milliseconds),
+    std::string_view kind) {
+  // Setting the decay restarts the purging, so the same value is not reapplied
+  if (!new_decay || new_decay == current_decay) return;
+
+  const auto ec = set_decay(*new_decay);
+  if (ec) {
+    LOG_WARNING() << "Failed to set jemalloc " << kind
+                  << " pages decay: " << ec.message();
+    return;
+  }
+  LOG_INFO() << "jemalloc " << kind << " pages decay is set to "
+             << new_decay->count() << "ms";
+  current_decay = new_decay;
+}
+
+}  // namespace
+
 ManagerControllerComponent::ManagerControllerComponent(
     const components::ComponentConfig&,
     const components::ComponentContext& context)
@@ -80,9 +138,22 @@ ManagerControllerComponent::ManagerControllerComponent(
       task_processor->SetTaskTraceLogger(std::move(logger));
     }
   }
+
+  const auto idle_stacks_release_period =
+      components_manager_.GetConfig().coro_pool.idle_stacks_release_period;
+  if (idle_stacks_release_period.count() > 0) {
+    idle_stacks_release_task_.Start(
+        "coro-pool-release-idle-stacks", {idle_stacks_release_period},
+        [this] {
+          components_manager_.GetTaskProcessorPools()
+              ->GetCoroPool()
+              .ReleaseIdleStacks();
+        });
+  }
 }
 
 ManagerControllerComponent::~ManagerControllerComponent() {
+  idle_stacks_release_task_.Stop();
   statistics_holder_.Unregister();
   config_subscription_.Unsubscribe();
 }
@@ -90,12 +161,41 @@ ManagerControllerComponent::~ManagerControllerComponent() {
 void ManagerControllerComponent::WriteStatistics(
     utils::statistics::Writer& writer) {
   // task processors
-  for (const auto& [name, task_processor] :
-       components_manager_.GetTaskProcessorsMap()) {
+  const auto& task_processors = components_manager_.GetTaskProcessorsMap();
+  const bool has_jemalloc_arenas =
+      std::any_of(task_processors.begin(), task_processors.end(),
+                  [](const auto& item) {
+                    return item.second->GetJemallocArena().has_value();
+                  });
+  if (has_jemalloc_arenas) utils::jemalloc::RefreshStats();
+
+  for (const auto& [name, task_processor] : task_processors) {
     writer["task-processors"].ValueWithLabels(*task_processor,
                                               {{"task_processor", name}});
   }
 
+  // task processors aggregated by NUMA node
+  std::map<std::size_t, engine::NumaNodeStats> numa_nodes;
+  for (const auto& [name, task_processor] :
+       components_manager_.GetTaskProcessorsMap()) {
+    const auto node = task_processor->GetNumaNode();
+    if (!node) continue;
+
+    const auto& counter = task_processor->GetTaskCounter();
+    const auto started = counter.GetStartedTasks();
+    const auto stopped = counter.GetStoppedTasks();
+
+    auto& node_stats = numa_nodes[*node];
+    node_stats.worker_threads += task_processor->GetWorkerCount();
+    node_stats.tasks_queued += task_processor->GetTaskQueueSize();
+    node_stats.tasks_running +=
+        started.value - std::min(stopped, started).value;
+  }
+  for (const auto& [node, node_stats] : numa_nodes) {
+    writer["numa-nodes"].ValueWithLabels(
+        node_stats, {{"numa_node", std::to_string(node)}});
+  }
+
   // ev-threads
   const auto& pools_ptr = components_manager_.GetTaskProcessorPools();
   auto& ev_thread_pool = pools_ptr->EventThreadPool();
@@ -107,12 +207,37 @@ void ManagerControllerComponent::WriteStatistics(
 
   // coroutines
   if (auto coro_pool = writer["coro-pool"]) {
+    const auto& pool =
+        components_manager_.GetTaskProcessorPools()->GetCoroPool();
     if (auto coro_stats = coro_pool["coroutines"]) {
-      auto stats =
-          components_manager_.GetTaskProcessorPools()->GetCoroPool().GetStats();
+      auto stats = pool.GetStats();
       coro_stats["active"] = stats.active_coroutines;
       coro_stats["total"] = stats.total_coroutines;
     }
+
+    const auto& stack_sizes = pool.GetStackSizes();
+    if (stack_sizes.size() > 1) {
+      auto by_stack_size = coro_pool["by-stack-size"];
+      for (std::size_t i = 0; i < stack_sizes.size(); ++i) {
+        const auto stats = pool.GetStats(i);
+        const auto stack_size = std::to_string(stack_sizes[i]);
+        by_stack_size["active"].ValueWithLabels(stats.active_coroutines,
+                                                {"stack_size", stack_size});
+        by_stack_size["total"].ValueWithLabels(stats.total_coroutines,
+                                               {"stack_size", stack_size});
+      }
+    }
+
+    if (pool.IsStackUsageSampled()) {
+      auto stack_usage = coro_pool["stack-usage"];
+      for (const auto& entry : pool.GetStackUsageReport()) {
+        const utils::statistics::LabelView label{"task_kind", entry.task_kind};
+        stack_usage["samples"].ValueWithLabels(entry.samples, label);
+        stack_usage["max-bytes"].ValueWithLabels(entry.max_usage, label);
+        stack_usage["recommended-stack-size-bytes"].ValueWithLabels(
+            entry.recommended_stack_size, label);
+      }
+    }
   }
 
   // misc
@@ -138,6 +263,11 @@ void ManagerControllerComponent::OnConfigUpdate(
       task_processor->SetSettings(config.default_settings);
     }
   }
+
+  UpdateJemallocDecay(config.jemalloc_dirty_decay, jemalloc_dirty_decay_,
+                      &utils::jemalloc::SetDirtyDecay, "dirty");
+  UpdateJemallocDecay(config.jemalloc_muzzy_decay, jemalloc_muzzy_decay_,
+                      &utils::jemalloc::SetMuzzyDecay, "muzzy");
 }
 
 }  // namespace components
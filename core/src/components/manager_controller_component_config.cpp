@@ -34,6 +34,8 @@ constexpr dynamic_config::DefaultAsJsonString kProfilerDefault{R"(
 }
 )"};
 
+constexpr dynamic_config::DefaultAsJsonString kJemallocDecayDefault{"{}"};
+
 }  // namespace
 
 ManagerControllerDynamicConfig ManagerControllerDynamicConfig::Parse(
@@ -65,6 +67,16 @@ ManagerControllerDynamicConfig ManagerControllerDynamicConfig::Parse(
     }
   }
 
+  const auto jemalloc_doc = docs_map.Get("USERVER_JEMALLOC_DECAY");
+  const auto parse_decay = [&jemalloc_doc](std::string_view name) {
+    const auto decay_ms =
+        jemalloc_doc[std::string{name}].As<std::optional<std::int64_t>>();
+    return decay_ms ? std::optional{std::chrono::milliseconds{*decay_ms}}
+                    : std::nullopt;
+  };
+  result.jemalloc_dirty_decay = parse_decay("dirty-decay-ms");
+  result.jemalloc_muzzy_decay = parse_decay("muzzy-decay-ms");
+
   return result;
 }
 
@@ -74,6 +86,7 @@ const dynamic_config::Key<ManagerControllerDynamicConfig>
         {
             {"USERVER_TASK_PROCESSOR_QOS", kQosDefault},
             {"USERVER_TASK_PROCESSOR_PROFILER_DEBUG", kProfilerDefault},
+            {"USERVER_JEMALLOC_DECAY", kJemallocDecayDefault},
         },
     };
 
@@ -42,6 +42,17 @@ properties:
           - normal
           - low-priority
           - idle
+    cpu-affinity:
+        type: string
+        description: |
+            CPUs in the Linux cpulist format, for example '0-7,16-23'. The
+            N-th task processor is pinned to the N-th CPU of the list, modulo
+            the list size. Mutually exclusive with numa-node
+    numa-node:
+        type: integer
+        description: |
+            NUMA node, the N-th task processor is pinned to the N-th CPU of
+            the node. Mutually exclusive with cpu-affinity
     task-trace:
         type: object
         description: .
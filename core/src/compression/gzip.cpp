@@ -1,15 +1,30 @@
 #include <compression/gzip.hpp>
 
+#include <limits>
+#include <string>
+
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 
+#include <zlib.h>
+
+#include <userver/utils/assert.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace compression::gzip {
 
 namespace {
 constexpr auto kDecompressBufferSize = 1024;
-}
+
+// 15 is the maximum window size, +16 selects the gzip header and trailer
+constexpr int kGzipWindowBits = 15 + 16;
+constexpr int kMemLevel = 8;
+
+// Room for the sync flush marker and the gzip header and trailer, that are
+// not accounted by deflateBound() for an already initialized stream
+constexpr std::size_t kFlushReserve = 32;
+}  // namespace
 
 std::string Decompress(std::string_view compressed, size_t max_size) {
   std::string decompressed;
@@ -38,6 +53,63 @@ std::string Decompress(std::string_view compressed, size_t max_size) {
   return decompressed;
 }
 
+std::string Compress(std::string_view data, int level) {
+  Compressor compressor{level};
+  return compressor.Finish(data);
+}
+
+Compressor::Compressor(int level) : stream_(std::make_unique<z_stream>()) {
+  const auto ret = deflateInit2(stream_.get(), level, Z_DEFLATED,
+                                kGzipWindowBits, kMemLevel, Z_DEFAULT_STRATEGY);
+  if (ret != Z_OK) {
+    throw CompressionError("failed to initialize gzip compression with level " +
+                           std::to_string(level));
+  }
+}
+
+Compressor::~Compressor() { deflateEnd(stream_.get()); }
+
+std::string Compressor::Compress(std::string_view chunk) {
+  if (chunk.empty()) return {};
+  return Deflate(chunk, Z_SYNC_FLUSH);
+}
+
+std::string Compressor::Finish(std::string_view last_chunk) {
+  auto result = Deflate(last_chunk, Z_FINISH);
+  is_finished_ = true;
+  return result;
+}
+
+std::string Compressor::Deflate(std::string_view data, int flush) {
+  UINVARIANT(!is_finished_, "gzip stream is already finished");
+  UASSERT(data.size() <= std::numeric_limits<uInt>::max());
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  stream_->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream_->avail_in = static_cast<uInt>(data.size());
+
+  std::string result;
+  result.resize(deflateBound(stream_.get(), data.size()) + kFlushReserve);
+  std::size_t size = 0;
+  while (true) {
+    stream_->next_out = reinterpret_cast<Bytef*>(result.data() + size);
+    stream_->avail_out = static_cast<uInt>(result.size() - size);
+
+    const auto ret = deflate(stream_.get(), flush);
+    if (ret == Z_STREAM_ERROR) {
+      throw CompressionError("failed to gzip data");
+    }
+    size = result.size() - stream_->avail_out;
+
+    const bool is_done = (flush == Z_FINISH) ? (ret == Z_STREAM_END)
+                                             : (stream_->avail_out != 0);
+    if (is_done) break;
+    result.resize(result.size() * 2);
+  }
+  result.resize(size);
+  return result;
+}
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
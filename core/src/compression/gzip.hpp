@@ -1,17 +1,59 @@
 #pragma once
 
+#include <memory>
+#include <string>
 #include <string_view>
 
 #include <compression/error.hpp>
 
+struct z_stream_s;
+
 USERVER_NAMESPACE_BEGIN
 
 namespace compression::gzip {
 
+/// Compression level used when none is configured
+inline constexpr int kDefaultCompressionLevel = 6;
+
 /// Decompresses the string.
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
 
+/// Compresses the string with the level in [1, 9].
+/// @throws CompressionError
+std::string Compress(std::string_view data,
+                     int level = kDefaultCompressionLevel);
+
+/// Compresses a stream of chunks into a single gzip stream. Output of each
+/// Compress() call is flushed, so that the receiver could decompress the
+/// data received so far.
+class Compressor final {
+ public:
+  /// @throws CompressionError
+  explicit Compressor(int level = kDefaultCompressionLevel);
+  ~Compressor();
+
+  Compressor(Compressor&&) = delete;
+  Compressor& operator=(Compressor&&) = delete;
+
+  /// Compresses the chunk and flushes the output.
+  /// @throws CompressionError
+  std::string Compress(std::string_view chunk);
+
+  /// Compresses the last chunk and finishes the stream, no more chunks could
+  /// be compressed after that.
+  /// @throws CompressionError
+  std::string Finish(std::string_view last_chunk = {});
+
+  bool IsFinished() const noexcept { return is_finished_; }
+
+ private:
+  std::string Deflate(std::string_view data, int flush);
+
+  std::unique_ptr<z_stream_s> stream_;
+  bool is_finished_{false};
+};
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
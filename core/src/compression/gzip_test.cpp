@@ -0,0 +1,64 @@
+#include <compression/gzip.hpp>
+
+#include <string>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kMaxSize = 1024 * 1024;
+
+std::string MakeData() {
+  std::string data;
+  for (int i = 0; i < 10000; ++i) {
+    data += R"({"id":)" + std::to_string(i) + R"(,"name":"value"},)";
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(Gzip, CompressDecompress) {
+  const auto data = MakeData();
+
+  const auto compressed = compression::gzip::Compress(data);
+  EXPECT_LT(compressed.size(), data.size() / 4);
+  EXPECT_EQ(compression::gzip::Decompress(compressed, kMaxSize), data);
+
+  const auto empty = compression::gzip::Compress({});
+  EXPECT_EQ(compression::gzip::Decompress(empty, kMaxSize), "");
+}
+
+TEST(Gzip, Levels) {
+  const auto data = MakeData();
+
+  const auto fastest = compression::gzip::Compress(data, 1);
+  const auto smallest = compression::gzip::Compress(data, 9);
+  EXPECT_LE(smallest.size(), fastest.size());
+  EXPECT_EQ(compression::gzip::Decompress(fastest, kMaxSize), data);
+  EXPECT_EQ(compression::gzip::Decompress(smallest, kMaxSize), data);
+
+  UEXPECT_THROW(compression::gzip::Compressor{42},
+                compression::CompressionError);
+}
+
+TEST(Gzip, StreamingCompressor) {
+  const auto data = MakeData();
+
+  compression::gzip::Compressor compressor;
+  std::string compressed;
+  for (std::size_t pos = 0; pos < data.size(); pos += 1000) {
+    const auto chunk = compressor.Compress(data.substr(pos, 1000));
+    EXPECT_FALSE(chunk.empty());
+    compressed += chunk;
+  }
+  EXPECT_FALSE(compressor.IsFinished());
+  compressed += compressor.Finish();
+  EXPECT_TRUE(compressor.IsFinished());
+
+  EXPECT_EQ(compression::gzip::Decompress(compressed, kMaxSize), data);
+}
+
+USERVER_NAMESPACE_END
@@ -24,10 +24,15 @@ void WaitForTask(std::string_view name, engine::TaskWithResult<void>& task) {
   try {
     task.Get();
   } catch (const std::exception& e) {
-    LOG_ERROR() << "Unhandled exception in subscriber " << name << ": " << e;
+    ReportListenerException(name, e);
   }
 }
 
+void ReportListenerException(std::string_view name,
+                             const std::exception& e) noexcept {
+  LOG_ERROR() << "Unhandled exception in subscriber " << name << ": " << e;
+}
+
 [[noreturn]] void ReportAlreadySubscribed(std::string_view channel_name,
                                           std::string_view listener_name) {
   UINVARIANT(false, fmt::format("{} is already subscribed to channel {}",
@@ -1,7 +1,9 @@
 #include <userver/utest/utest.hpp>
 
 #include <atomic>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 #include <userver/concurrent/async_event_channel.hpp>
 
@@ -91,6 +93,65 @@ UTEST(AsyncEventChannel, PublishException) {
   sub1.Unsubscribe();
 }
 
+UTEST_MT(AsyncEventChannel, MaxConcurrency, 4) {
+  for (const std::size_t max_concurrency : {1, 3}) {
+    concurrent::AsyncEventChannel<int> channel("channel");
+    channel.SetMaxConcurrency(max_concurrency);
+
+    constexpr std::size_t kSubscribers = 10;
+    std::vector<int> values(kSubscribers, 0);
+    std::vector<std::unique_ptr<Subscriber>> subscribers;
+    std::vector<concurrent::AsyncEventSubscriberScope> scopes;
+    for (auto& value : values) {
+      subscribers.push_back(std::make_unique<Subscriber>(value));
+      scopes.push_back(channel.AddListener(subscribers.back().get(), "",
+                                           &Subscriber::OnEvent));
+    }
+
+    channel.SendEvent(1);
+    for (const auto value : values) EXPECT_EQ(value, 1);
+
+    for (auto& scope : scopes) scope.Unsubscribe();
+  }
+}
+
+UTEST(AsyncEventChannel, MaxConcurrencyException) {
+  concurrent::AsyncEventChannel<int> channel("channel");
+  channel.SetMaxConcurrency(1);
+
+  struct X {
+    // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+    void OnEvent(int) { throw std::runtime_error("error msg"); }
+  };
+  X x1;
+  X x2;
+
+  auto sub1 = channel.AddListener(&x1, "subscriber1", &X::OnEvent);
+  auto sub2 = channel.AddListener(&x2, "subscriber2", &X::OnEvent);
+  UEXPECT_NO_THROW(channel.SendEvent(1));
+  sub1.Unsubscribe();
+  sub2.Unsubscribe();
+}
+
+UTEST(AsyncEventChannel, ListenerStatistics) {
+  concurrent::AsyncEventChannel<int> channel("channel");
+
+  int value{0};
+  Subscriber s(value);
+  auto sub = channel.AddListener(&s, "subscriber", &Subscriber::OnEvent);
+
+  channel.SendEvent(1);
+  channel.SendEvent(2);
+
+  const auto stats = channel.GetListenerStatistics();
+  ASSERT_EQ(stats.size(), 1U);
+  EXPECT_EQ(stats[0].name, "subscriber");
+  EXPECT_EQ(stats[0].events, 2U);
+  EXPECT_LE(stats[0].last_duration, stats[0].max_duration);
+
+  sub.Unsubscribe();
+}
+
 UTEST(AsyncEventChannel, OnListenerRemoval) {
   int counter = 0;
   auto on_remove = [&counter](std::function<void(int)> func) {
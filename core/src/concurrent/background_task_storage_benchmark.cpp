@@ -41,4 +41,33 @@ BENCHMARK(background_task_storage)
     ->Arg(16)
     ->Arg(32);
 
+void background_task_storage_stackless(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    concurrent::BackgroundTaskStorage bts;
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (std::int64_t i = 0; i < state.range(0) - 1; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        while (!engine::current_task::ShouldCancel()) {
+          bts.AsyncDetachStackless([] {});
+          engine::Yield();
+        }
+      }));
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+      bts.AsyncDetachStackless([] {});
+      engine::Yield();
+    }
+  });
+}
+BENCHMARK(background_task_storage_stackless)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(6)
+    ->Arg(8)
+    ->Arg(12)
+    ->Arg(16)
+    ->Arg(32);
+
 USERVER_NAMESPACE_END
@@ -24,6 +24,15 @@ UTEST(BackgroundTaskStorage, TaskStart) {
   EXPECT_TRUE(event.WaitForEvent());
 }
 
+UTEST(BackgroundTaskStorage, StacklessTaskStart) {
+  concurrent::BackgroundTaskStorage bts;
+
+  engine::SingleConsumerEvent event;
+  bts.AsyncDetachStackless([&event] { event.Send(); });
+
+  EXPECT_TRUE(event.WaitForEvent());
+}
+
 UTEST(BackgroundTaskStorage, CancelAndWaitInDtr) {
   std::atomic<bool> started{false};
   std::atomic<bool> cancelled{false};
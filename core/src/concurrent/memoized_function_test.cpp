@@ -0,0 +1,119 @@
+#include <userver/concurrent/memoized_function.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using namespace std::chrono_literals;
+
+}  // namespace
+
+UTEST(MemoizedFunction, Basic) {
+  int calls = 0;
+  concurrent::MemoizedFunction<int, std::string> f([&calls](int key) {
+    ++calls;
+    return std::to_string(key);
+  });
+
+  const auto one = f(1);
+  EXPECT_EQ(*one, "1");
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(f(1), one);
+  EXPECT_EQ(calls, 1);
+
+  EXPECT_EQ(*f(2), "2");
+  EXPECT_EQ(calls, 2);
+
+  f.Forget(1);
+  EXPECT_EQ(*f(1), "1");
+  EXPECT_EQ(calls, 3);
+  EXPECT_EQ(*one, "1");
+}
+
+UTEST(MemoizedFunction, Bounded) {
+  int calls = 0;
+  concurrent::MemoizedFunction<int, int> f(
+      [&calls](int key) {
+        ++calls;
+        return key;
+      },
+      {/*ways=*/1, /*way_size=*/2});
+
+  f(1);
+  f(2);
+  f(3);
+  EXPECT_EQ(f.GetSizeApproximate(), 2U);
+  EXPECT_EQ(calls, 3);
+
+  // 1 was evicted
+  f(1);
+  EXPECT_EQ(calls, 4);
+}
+
+UTEST(MemoizedFunction, Expiration) {
+  int calls = 0;
+  concurrent::MemoizedFunction<int, int> f(
+      [&calls](int key) {
+        ++calls;
+        return key;
+      },
+      {/*ways=*/1, /*way_size=*/2, /*max_lifetime=*/10ms});
+
+  f(1);
+  f(1);
+  EXPECT_EQ(calls, 1);
+
+  engine::SleepFor(20ms);
+  f(1);
+  EXPECT_EQ(calls, 2);
+}
+
+UTEST(MemoizedFunction, ExceptionIsNotMemoized) {
+  int calls = 0;
+  concurrent::MemoizedFunction<int, int> f([&calls](int key) {
+    if (++calls == 1) throw std::runtime_error("first call fails");
+    return key;
+  });
+
+  EXPECT_THROW(f(1), std::runtime_error);
+  EXPECT_EQ(*f(1), 1);
+  EXPECT_EQ(calls, 2);
+}
+
+UTEST_MT(MemoizedFunction, SingleFlight, 4) {
+  std::atomic<int> calls{0};
+  engine::SingleConsumerEvent started;
+  engine::SingleConsumerEvent release;
+  concurrent::MemoizedFunction<int, int> f([&](int key) {
+    ++calls;
+    started.Send();
+    if (!release.WaitForEvent()) throw std::runtime_error("cancelled");
+    return key;
+  });
+
+  auto first = utils::Async("first", [&f] { return *f(42); });
+  ASSERT_TRUE(started.WaitForEvent());
+
+  std::vector<engine::TaskWithResult<int>> others;
+  for (int i = 0; i < 4; ++i) {
+    others.push_back(utils::Async("other", [&f] { return *f(42); }));
+  }
+  engine::SleepFor(10ms);
+  release.Send();
+
+  EXPECT_EQ(first.Get(), 42);
+  for (auto& task : others) EXPECT_EQ(task.Get(), 42);
+  EXPECT_EQ(calls, 1);
+}
+
+USERVER_NAMESPACE_END
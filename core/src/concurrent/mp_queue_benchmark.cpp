@@ -31,6 +31,42 @@ auto GetConsumerTask(std::shared_ptr<QueueType> queue,
     }
   });
 }
+
+std::vector<std::size_t> MakeBatch(std::size_t& message,
+                                   std::size_t batch_size) {
+  std::vector<std::size_t> batch(batch_size);
+  for (auto& value : batch) value = message++;
+  return batch;
+}
+
+template <typename QueueType>
+auto GetBatchProducerTask(std::shared_ptr<QueueType> queue,
+                          std::atomic<bool>& run, std::size_t batch_size) {
+  return utils::Async(
+      "producer", [producer = queue->GetProducer(), &run, batch_size] {
+        std::size_t message = 0;
+        while (run) {
+          bool res = producer.PushBatch(MakeBatch(message, batch_size));
+          benchmark::DoNotOptimize(res);
+        }
+      });
+}
+
+template <typename QueueType>
+auto GetBatchConsumerTask(std::shared_ptr<QueueType> queue,
+                          const std::atomic<bool>& run,
+                          std::size_t batch_size) {
+  return utils::Async(
+      "consumer", [consumer = queue->GetConsumer(), &run, batch_size] {
+        std::vector<std::size_t> values;
+        while (run) {
+          values.clear();
+          auto res = consumer.PopBatch(values, batch_size);
+          benchmark::DoNotOptimize(res);
+        }
+      });
+}
+
 }  // namespace
 
 template <typename QueueType>
@@ -71,6 +107,10 @@ BENCHMARK_TEMPLATE(producer_consumer, concurrent::NonFifoMpmcQueue<std::size_t>)
     ->RangeMultiplier(2)
     ->Ranges({{1, 4}, {1, 4}, {128, 512}});
 
+BENCHMARK_TEMPLATE(producer_consumer, concurrent::BoundedMpmcQueue<std::size_t>)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 4}, {1, 4}, {128, 512}});
+
 BENCHMARK_TEMPLATE(producer_consumer, concurrent::NonFifoMpmcQueue<std::size_t>)
     ->RangeMultiplier(2)
     ->Ranges({{1, 4}, {1, 4}, {1'000'000'000, 1'000'000'000}});
@@ -87,6 +127,56 @@ BENCHMARK_TEMPLATE(producer_consumer, concurrent::SpscQueue<std::size_t>)
     ->RangeMultiplier(2)
     ->Ranges({{1, 1}, {1, 1}, {1'000'000'000, 1'000'000'000}});
 
+template <typename QueueType>
+void producer_consumer_batch(benchmark::State& state) {
+  engine::RunStandalone(state.range(0) + state.range(1), [&] {
+    const std::size_t producers_count = state.range(0);
+    const std::size_t consumers_count = state.range(1);
+    const std::size_t batch_size = state.range(2);
+
+    std::atomic<bool> run{true};
+    auto queue = QueueType::Create(batch_size * 16);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(producers_count + consumers_count - 1);
+    for (std::size_t i = 0; i < producers_count - 1; ++i) {
+      tasks.push_back(GetBatchProducerTask(queue, run, batch_size));
+    }
+
+    for (std::size_t i = 0; i < consumers_count; ++i) {
+      tasks.push_back(GetBatchConsumerTask(queue, run, batch_size));
+    }
+
+    // Current thread work
+    {
+      std::size_t message = 0;
+      auto producer = queue->GetProducer();
+      for ([[maybe_unused]] auto _ : state) {
+        bool res = producer.PushBatch(MakeBatch(message, batch_size));
+        benchmark::DoNotOptimize(res);
+      }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+    run = false;
+  });
+}
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::NonFifoMpmcQueue<std::size_t>)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 4}, {1, 4}, {1, 64}});
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::BoundedMpmcQueue<std::size_t>)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 4}, {1, 4}, {1, 64}});
+
+BENCHMARK_TEMPLATE(producer_consumer_batch,
+                   concurrent::SpscQueue<std::size_t>)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 1}, {1, 1}, {1, 64}});
+
 BENCHMARK_TEMPLATE(producer_consumer, concurrent::MpscQueue<std::size_t>)
     ->RangeMultiplier(2)
     ->Ranges({{1, 4}, {1, 1}, {128, 512}});
@@ -1,5 +1,6 @@
 #include <userver/concurrent/queue.hpp>
 
+#include <numeric>
 #include <optional>
 #include <unordered_set>
 
@@ -11,12 +12,15 @@
 #include <userver/utils/async.hpp>
 #include <userver/utils/fixed_array.hpp>
 
+using namespace std::chrono_literals;
+
 USERVER_NAMESPACE_BEGIN
 
 namespace {
 constexpr std::size_t kProducersCount = 4;
 constexpr std::size_t kConsumersCount = 4;
 constexpr std::size_t kMessageCount = 1000;
+constexpr std::size_t kBatchSize = 16;
 
 template <typename Producer>
 auto GetProducerTask(const Producer& producer, std::size_t i) {
@@ -45,6 +49,22 @@ using TestQueueTypes = testing::Types<concurrent::NonFifoMpmcQueue<std::size_t>,
                                       concurrent::SpmcQueue<std::size_t>,
                                       concurrent::SpscQueue<std::size_t>>;
 
+template <typename T>
+class QueueBatchTest : public ::testing::Test {};
+
+using TestBatchQueueTypes =
+    testing::Types<concurrent::NonFifoMpmcQueue<std::size_t>,
+                   concurrent::NonFifoMpscQueue<std::size_t>,
+                   concurrent::SpmcQueue<std::size_t>,
+                   concurrent::SpscQueue<std::size_t>,
+                   concurrent::BoundedMpmcQueue<std::size_t>>;
+
+std::vector<std::size_t> MakeBatch(std::size_t first, std::size_t count) {
+  std::vector<std::size_t> batch(count);
+  std::iota(batch.begin(), batch.end(), first);
+  return batch;
+}
+
 }  // namespace
 
 INSTANTIATE_TYPED_UTEST_SUITE_P(NonFifoMpmcQueue, QueueFixture,
@@ -83,6 +103,168 @@ TYPED_TEST(NonCoroutineTest, PushPopNoblock) {
   EXPECT_EQ(value, 2);
 }
 
+TYPED_UTEST_SUITE(QueueBatchTest, TestBatchQueueTypes);
+
+TYPED_UTEST(QueueBatchTest, PushPopBatch) {
+  auto queue = TypeParam::Create(10);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  auto batch = MakeBatch(0, 4);
+  EXPECT_TRUE(producer.PushBatch(std::move(batch)));
+  EXPECT_TRUE(batch.empty());
+  EXPECT_TRUE(producer.PushBatch(MakeBatch(4, 4)));
+  EXPECT_TRUE(producer.PushBatch({}));
+  EXPECT_EQ(queue->GetSizeApproximate(), 8);
+
+  std::vector<std::size_t> values;
+  EXPECT_EQ(consumer.PopBatch(values, 0), 0);
+  EXPECT_EQ(consumer.PopBatch(values, 5), 5);
+  EXPECT_EQ(values, MakeBatch(0, 5));
+  EXPECT_EQ(queue->GetSizeApproximate(), 3);
+
+  EXPECT_EQ(consumer.PopBatch(values, 100), 3);
+  EXPECT_EQ(values, MakeBatch(0, 8));
+  EXPECT_EQ(queue->GetSizeApproximate(), 0);
+
+  std::size_t value{};
+  EXPECT_TRUE(producer.Push(42));
+  EXPECT_TRUE(consumer.Pop(value));
+  EXPECT_EQ(value, 42);
+}
+
+TYPED_UTEST(QueueBatchTest, BatchDoesNotFit) {
+  auto queue = TypeParam::Create(4);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  auto batch = MakeBatch(0, 5);
+  EXPECT_FALSE(producer.PushBatch(std::move(batch),
+                                  engine::Deadline::FromDuration(10ms)));
+  EXPECT_EQ(batch, MakeBatch(0, 5));
+
+  EXPECT_TRUE(producer.PushBatch(MakeBatch(0, 3)));
+  batch = MakeBatch(3, 2);
+  EXPECT_FALSE(producer.PushBatch(std::move(batch),
+                                  engine::Deadline::FromDuration(10ms)));
+  EXPECT_EQ(batch, MakeBatch(3, 2));
+  EXPECT_EQ(queue->GetSizeApproximate(), 3);
+
+  std::vector<std::size_t> values;
+  EXPECT_EQ(consumer.PopBatch(values, 2), 2);
+  EXPECT_TRUE(producer.PushBatch(std::move(batch)));
+  EXPECT_EQ(consumer.PopBatch(values, 10), 3);
+  EXPECT_EQ(values, MakeBatch(0, 5));
+}
+
+TYPED_UTEST(QueueBatchTest, PopBatchWaitsForProducer) {
+  auto queue = TypeParam::Create(10);
+  std::optional producer(queue->GetProducer());
+  auto consumer = queue->GetConsumer();
+
+  std::vector<std::size_t> values;
+  EXPECT_EQ(consumer.PopBatch(values, 10, engine::Deadline::FromDuration(1ms)),
+            0);
+
+  auto task = utils::Async("producer", [&producer] {
+    engine::SleepFor(10ms);
+    EXPECT_TRUE(producer->PushBatch(MakeBatch(0, 3)));
+  });
+  EXPECT_EQ(consumer.PopBatch(values, 10), 3);
+  task.Get();
+
+  EXPECT_TRUE(producer->PushBatch(MakeBatch(3, 2)));
+  producer.reset();
+  EXPECT_EQ(consumer.PopBatch(values, 10), 2);
+  EXPECT_EQ(consumer.PopBatch(values, 10), 0);
+  EXPECT_EQ(values, MakeBatch(0, 5));
+}
+
+TEST(BoundedMpmcQueue, PushPopNoblock) {
+  auto queue = concurrent::BoundedMpmcQueue<std::size_t>::Create(2);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  std::size_t value = 0;
+  EXPECT_FALSE(consumer.PopNoblock(value));
+
+  EXPECT_TRUE(producer.PushNoblock(0));
+  EXPECT_TRUE(producer.PushNoblock(1));
+  EXPECT_FALSE(producer.PushNoblock(2));
+
+  EXPECT_TRUE(consumer.PopNoblock(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(producer.PushNoblock(2));
+  EXPECT_TRUE(consumer.PopNoblock(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(consumer.PopNoblock(value));
+  EXPECT_EQ(value, 2);
+}
+
+TEST(BoundedMpmcQueue, DestroysRemainingValues) {
+  auto queue = concurrent::BoundedMpmcQueue<std::unique_ptr<RefCountData>>::
+      Create(kMessageCount);
+  const auto objects_count = RefCountData::objects_count.load();
+  {
+    auto producer = queue->GetProducer();
+    for (int i = 0; i < 10; ++i) {
+      EXPECT_TRUE(producer.PushNoblock(std::make_unique<RefCountData>(i)));
+    }
+  }
+  EXPECT_EQ(RefCountData::objects_count.load(), objects_count + 10);
+  queue.reset();
+  EXPECT_EQ(RefCountData::objects_count.load(), objects_count);
+}
+
+UTEST_MT(BoundedMpmcQueue, MpmcBatches, kProducersCount + kConsumersCount) {
+  using Queue = concurrent::BoundedMpmcQueue<std::size_t>;
+  auto queue = Queue::Create(kBatchSize * 4);
+
+  std::vector<Queue::Producer> producers;
+  producers.reserve(kProducersCount);
+  std::vector<engine::TaskWithResult<void>> producers_tasks;
+  producers_tasks.reserve(kProducersCount);
+  for (std::size_t i = 0; i < kProducersCount; ++i) {
+    producers_tasks.push_back(utils::Async(
+        "producer", [&producer = producers.emplace_back(queue->GetProducer()),
+                     i] {
+          const auto end = (i + 1) * kMessageCount;
+          for (auto message = i * kMessageCount; message < end;) {
+            const auto count = std::min(kBatchSize, end - message);
+            ASSERT_TRUE(producer.PushBatch(MakeBatch(message, count)));
+            message += count;
+          }
+        }));
+  }
+
+  std::vector<int> consumed_messages(kMessageCount * kProducersCount, 0);
+  engine::Mutex mutex;
+
+  std::vector<engine::TaskWithResult<void>> consumers_tasks;
+  consumers_tasks.reserve(kConsumersCount);
+  for (std::size_t i = 0; i < kConsumersCount; ++i) {
+    consumers_tasks.push_back(utils::Async(
+        "consumer", [consumer = queue->GetConsumer(), &consumed_messages,
+                     &mutex, i] {
+          std::vector<std::size_t> values;
+          // a mix of single element and batch consumers
+          while (i % 2 == 0 ? consumer.PopBatch(values, kBatchSize) != 0
+                            : consumer.Pop(values.emplace_back())) {
+            const std::lock_guard lock(mutex);
+            for (const auto value : values) ++consumed_messages[value];
+            values.clear();
+          }
+        }));
+  }
+
+  for (auto& task : producers_tasks) task.Get();
+  producers.clear();
+  for (auto& task : consumers_tasks) task.Get();
+
+  ASSERT_TRUE(std::all_of(consumed_messages.begin(), consumed_messages.end(),
+                          [](int item) { return item == 1; }));
+}
+
 UTEST(NonFifoMpmcQueue, ConsumerIsDead) {
   auto queue = concurrent::NonFifoMpmcQueue<int>::Create();
   auto producer = queue->GetProducer();
@@ -0,0 +1,118 @@
+#include <userver/concurrent/sharded_map.hpp>
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/rcu/rcu_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kThreads = 4;
+
+// A plain map under a single engine::Mutex, the MutexSet-like baseline
+class MutexMap final {
+ public:
+  std::shared_ptr<int> Get(int key) {
+    auto data = map_.UniqueLock();
+    const auto it = data->find(key);
+    return it == data->end() ? nullptr : it->second;
+  }
+
+  void TryEmplace(int key, int value) {
+    auto data = map_.UniqueLock();
+    data->try_emplace(key, std::make_shared<int>(value));
+  }
+
+  bool Erase(int key) {
+    auto data = map_.UniqueLock();
+    return data->erase(key) != 0;
+  }
+
+ private:
+  concurrent::Variable<std::unordered_map<int, std::shared_ptr<int>>> map_;
+};
+
+class RcuMapAdaptor final {
+ public:
+  std::shared_ptr<int> Get(int key) { return map_.Get(key); }
+  void TryEmplace(int key, int value) { map_.TryEmplace(key, value); }
+  bool Erase(int key) { return map_.Erase(key); }
+
+ private:
+  rcu::RcuMap<int, int> map_;
+};
+
+class ShardedMapAdaptor final {
+ public:
+  std::shared_ptr<int> Get(int key) { return map_.Get(key); }
+  void TryEmplace(int key, int value) { map_.TryEmplace(key, value); }
+  bool Erase(int key) { return map_.Erase(key); }
+
+ private:
+  concurrent::ShardedMap<int, int> map_{1024};
+};
+
+// range(0) - keys count, range(1) - percent of writes
+template <typename Map>
+void sharded_map_read_write(benchmark::State& state) {
+  engine::RunStandalone(kThreads, [&] {
+    const auto keys = static_cast<int>(state.range(0));
+    const auto write_percent = static_cast<int>(state.range(1));
+
+    Map map;
+    for (int i = 0; i < keys; i += 2) map.TryEmplace(i, i);
+
+    std::atomic<bool> keep_running{true};
+    const auto do_work = [&](unsigned& seed) {
+      seed = seed * 1103515245 + 12345;
+      const auto key = static_cast<int>((seed >> 8) % keys);
+      if (static_cast<int>(seed % 100) < write_percent) {
+        if (!map.Erase(key)) map.TryEmplace(key, key);
+      } else {
+        benchmark::DoNotOptimize(map.Get(key));
+      }
+    };
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kThreads - 1);
+    for (std::size_t i = 1; i < kThreads; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&, seed = unsigned(i)]() mutable {
+        while (keep_running) do_work(seed);
+      }));
+    }
+
+    unsigned seed = 0;
+    for ([[maybe_unused]] auto _ : state) do_work(seed);
+
+    keep_running = false;
+    for (auto& task : tasks) task.Get();
+  });
+}
+
+void ReadWriteArgs(benchmark::internal::Benchmark* b) {
+  for (const int keys : {1'000, 100'000}) {
+    for (const int write_percent : {0, 1, 10, 50}) {
+      b->Args({keys, write_percent});
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(sharded_map_read_write, ShardedMapAdaptor)
+    ->Apply(ReadWriteArgs);
+BENCHMARK_TEMPLATE(sharded_map_read_write, RcuMapAdaptor)
+    ->Apply(ReadWriteArgs);
+BENCHMARK_TEMPLATE(sharded_map_read_write, MutexMap)->Apply(ReadWriteArgs);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,111 @@
+#include <userver/concurrent/sharded_map.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(ShardedMap, Basic) {
+  concurrent::ShardedMap<std::string, int> map(10);
+  EXPECT_EQ(map.GetShardsCount(), 16);
+  EXPECT_EQ(map.SizeApprox(), 0);
+  EXPECT_FALSE(map.Get("a"));
+
+  auto result = map.Insert("a", std::make_shared<int>(1));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ(*result.value, 1);
+
+  result = map.Insert("a", std::make_shared<int>(2));
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ(*result.value, 1);
+
+  result = map.TryEmplace("b", 3);
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ(*map.Get("b"), 3);
+
+  map.InsertOrAssign("a", std::make_shared<int>(4));
+  EXPECT_EQ(*map.Get("a"), 4);
+  EXPECT_EQ(map.SizeApprox(), 2);
+
+  EXPECT_TRUE(map.Erase("a"));
+  EXPECT_FALSE(map.Erase("a"));
+  EXPECT_EQ(*map.Pop("b"), 3);
+  EXPECT_FALSE(map.Pop("b"));
+  EXPECT_EQ(map.SizeApprox(), 0);
+}
+
+UTEST(ShardedMap, SnapshotAndClear) {
+  concurrent::ShardedMap<int, int> map(4);
+  for (int i = 0; i < 100; ++i) map.TryEmplace(i, i * 2);
+  EXPECT_EQ(map.SizeApprox(), 100);
+
+  const auto snapshot = map.GetSnapshot();
+  ASSERT_EQ(snapshot.size(), 100);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(*snapshot.at(i), i * 2);
+
+  int sum = 0;
+  map.VisitAll([&sum](int key, const auto& value) {
+    EXPECT_EQ(*value, key * 2);
+    sum += *value;
+  });
+  EXPECT_EQ(sum, 99 * 100);
+
+  map.Clear();
+  EXPECT_EQ(map.SizeApprox(), 0);
+  EXPECT_FALSE(map.Get(1));
+  EXPECT_EQ(*snapshot.at(1), 2);
+}
+
+UTEST(ShardedMap, Sample) {
+  /// [Sample concurrent::ShardedMap]
+  struct Data {
+    // Access to ShardedMap values must be synchronized via std::atomic
+    // or other synchronization primitives
+    std::atomic<int> hits{0};
+  };
+  concurrent::ShardedMap<std::string, Data> map;
+
+  map.TryEmplace("user-1").value->hits++;
+  map.TryEmplace("user-1").value->hits++;
+  ASSERT_EQ(map.Get("user-1")->hits.load(), 2);
+  ASSERT_FALSE(map.Get("user-2"));
+  /// [Sample concurrent::ShardedMap]
+}
+
+UTEST_MT(ShardedMap, ConcurrentReadWrite, 4) {
+  concurrent::ShardedMap<int, int> map(8);
+  std::atomic<bool> keep_running{true};
+  constexpr int kKeys = 1000;
+  for (int i = 0; i < kKeys; i += 2) map.TryEmplace(i, i);
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int writer = 0; writer < 2; ++writer) {
+    tasks.push_back(engine::AsyncNoSpan([&, writer] {
+      for (int i = writer; keep_running; i = (i + 2) % kKeys) {
+        if (!map.Erase(i)) map.TryEmplace(i, i);
+      }
+    }));
+  }
+  tasks.push_back(engine::AsyncNoSpan([&] {
+    for (int i = 0; keep_running; i = (i + 1) % kKeys) {
+      const auto value = map.Get(i);
+      if (value) {
+        ASSERT_EQ(*value, i);
+      }
+    }
+  }));
+
+  engine::SleepFor(std::chrono::milliseconds{50});
+  keep_running = false;
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(map.SizeApprox(), map.GetSnapshot().size());
+}
+
+USERVER_NAMESPACE_END
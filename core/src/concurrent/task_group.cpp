@@ -0,0 +1,113 @@
+#include <userver/concurrent/task_group.hpp>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+TaskGroup::TaskGroup(std::string name, std::size_t max_parallelism)
+    : TaskGroup(engine::current_task::GetTaskProcessor(), std::move(name),
+                max_parallelism) {}
+
+TaskGroup::TaskGroup(engine::TaskProcessor& task_processor, std::string name,
+                     std::size_t max_parallelism)
+    : task_processor_(task_processor),
+      name_(std::move(name)),
+      max_parallelism_(max_parallelism),
+      queue_(Queue::Create()),
+      producer_(queue_->GetProducer()) {
+  UINVARIANT(max_parallelism_ > 0, "TaskGroup needs at least one worker");
+  workers_.reserve(max_parallelism_);
+  tokens_.reserve(max_parallelism_);
+}
+
+TaskGroup::~TaskGroup() {
+  Cancel();
+  producer_.reset();
+  // Workers use the fields of the group, they must be joined first
+  workers_.clear();
+}
+
+void TaskGroup::Wait() {
+  UASSERT_MSG(producer_, "TaskGroup::Wait should be called no more than once");
+  // Lets the idle workers know that they are not needed anymore
+  producer_.reset();
+
+  for (auto& worker : workers_) worker.Wait();
+
+  // A worker that was cancelled before it started (e.g. by the TaskProcessor
+  // overload) leaves its items in the queue
+  if (!IsCancelled()) {
+    auto consumer = queue_->GetConsumer();
+    RunItems(consumer);
+  }
+
+  if (exception_) std::rethrow_exception(std::exchange(exception_, {}));
+}
+
+void TaskGroup::Cancel() noexcept {
+  if (is_cancelled_.exchange(true)) return;
+  RequestCancelWorkers();
+}
+
+void TaskGroup::DoSpawn(ItemPtr&& item) {
+  UASSERT_MSG(producer_, "TaskGroup::Spawn after TaskGroup::Wait");
+
+  const bool need_worker =
+      idle_workers_.load(std::memory_order_relaxed) == 0 &&
+      workers_.size() < max_parallelism_;
+  [[maybe_unused]] const bool success = producer_->Push(std::move(item));
+  UASSERT(success);
+
+  if (need_worker) StartWorker();
+}
+
+void TaskGroup::StartWorker() {
+  workers_.push_back(utils::Async(
+      task_processor_, std::string{name_},
+      [this, consumer = queue_->GetConsumer()]() mutable {
+        RunItems(consumer);
+      }));
+
+  const std::lock_guard lock(tokens_mutex_);
+  auto& token = tokens_.emplace_back(workers_.back());
+  // A worker may have failed before the token was registered
+  if (IsCancelled()) token.RequestCancel();
+}
+
+void TaskGroup::RunItems(Queue::Consumer& consumer) noexcept {
+  ItemPtr item;
+  while (true) {
+    idle_workers_.fetch_add(1, std::memory_order_relaxed);
+    const bool popped = consumer.Pop(item);
+    idle_workers_.fetch_sub(1, std::memory_order_relaxed);
+    if (!popped) break;
+
+    if (!IsCancelled()) {
+      try {
+        item->Run();
+      } catch (...) {
+        OnItemFailed(std::current_exception());
+      }
+    }
+    item.reset();
+  }
+}
+
+void TaskGroup::OnItemFailed(std::exception_ptr exception) noexcept {
+  if (is_cancelled_.exchange(true)) return;
+  // Read by the owner only after the worker is joined
+  exception_ = std::move(exception);
+  RequestCancelWorkers();
+}
+
+void TaskGroup::RequestCancelWorkers() noexcept {
+  const std::lock_guard lock(tokens_mutex_);
+  for (auto& token : tokens_) token.RequestCancel();
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
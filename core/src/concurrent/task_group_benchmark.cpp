@@ -0,0 +1,69 @@
+#include <userver/concurrent/task_group.hpp>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kItemsCount = 10'000;
+constexpr std::size_t kMaxParallelism = 16;
+
+}  // namespace
+
+// The baseline: a task per item
+void task_group_async_per_item(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    std::vector<std::size_t> results(kItemsCount);
+    for ([[maybe_unused]] auto _ : state) {
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(kItemsCount);
+      for (std::size_t i = 0; i < kItemsCount; ++i) {
+        tasks.push_back(
+            utils::Async("item", [&results, i] { results[i] = i; }));
+      }
+      engine::GetAll(tasks);
+    }
+    benchmark::DoNotOptimize(results);
+  });
+  state.SetItemsProcessed(state.iterations() * kItemsCount);
+}
+BENCHMARK(task_group_async_per_item)->Arg(1)->Arg(4)->Arg(8);
+
+void task_group_spawn(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    std::vector<std::size_t> results(kItemsCount);
+    for ([[maybe_unused]] auto _ : state) {
+      concurrent::TaskGroup group("items", kMaxParallelism);
+      for (std::size_t i = 0; i < kItemsCount; ++i) {
+        group.Spawn([&results, i] { results[i] = i; });
+      }
+      group.Wait();
+    }
+    benchmark::DoNotOptimize(results);
+  });
+  state.SetItemsProcessed(state.iterations() * kItemsCount);
+}
+BENCHMARK(task_group_spawn)->Arg(1)->Arg(4)->Arg(8);
+
+void task_group_parallel_for(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    std::vector<std::size_t> results(kItemsCount);
+    for ([[maybe_unused]] auto _ : state) {
+      concurrent::ParallelFor(
+          "items", kItemsCount, kMaxParallelism,
+          [&results](std::size_t index) { results[index] = index; });
+    }
+    benchmark::DoNotOptimize(results);
+  });
+  state.SetItemsProcessed(state.iterations() * kItemsCount);
+}
+BENCHMARK(task_group_parallel_for)->Arg(1)->Arg(4)->Arg(8);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,161 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <userver/concurrent/task_group.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/tracing/span.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class ConcurrencyCounter final {
+ public:
+  void Enter() {
+    const auto current = ++current_;
+    auto max = max_.load();
+    while (current > max && !max_.compare_exchange_weak(max, current)) {
+    }
+  }
+
+  void Leave() { --current_; }
+
+  int GetMax() const { return max_.load(); }
+
+ private:
+  std::atomic<int> current_{0};
+  std::atomic<int> max_{0};
+};
+
+}  // namespace
+
+UTEST_MT(TaskGroup, RunsAllItems, 4) {
+  /// [Sample concurrent::TaskGroup]
+  std::vector<int> results(100);
+  concurrent::TaskGroup group("compute", 4);
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    group.Spawn([&results, i] { results[i] = static_cast<int>(i) * 2; });
+  }
+  group.Wait();
+  /// [Sample concurrent::TaskGroup]
+
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i], static_cast<int>(i) * 2);
+  }
+}
+
+UTEST_MT(TaskGroup, LimitsParallelism, 4) {
+  ConcurrencyCounter counter;
+  std::atomic<int> done{0};
+
+  concurrent::TaskGroup group("limit", 3);
+  for (int i = 0; i < 30; ++i) {
+    group.Spawn([&] {
+      counter.Enter();
+      engine::SleepFor(1ms);
+      counter.Leave();
+      ++done;
+    });
+  }
+  group.Wait();
+
+  EXPECT_EQ(done, 30);
+  EXPECT_LE(counter.GetMax(), 3);
+}
+
+UTEST(TaskGroup, FirstErrorCancelsSiblings) {
+  std::atomic<bool> sibling_cancelled{false};
+  engine::SingleConsumerEvent sibling_started;
+
+  concurrent::TaskGroup group("errors", 2);
+  group.Spawn([&] {
+    sibling_started.Send();
+    engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+    sibling_cancelled = engine::current_task::ShouldCancel();
+  });
+  ASSERT_TRUE(sibling_started.WaitForEventFor(utest::kMaxTestWaitTime));
+  group.Spawn([] { throw std::runtime_error("first"); });
+
+  UEXPECT_THROW_MSG(group.Wait(), std::runtime_error, "first");
+  EXPECT_TRUE(group.IsCancelled());
+  EXPECT_TRUE(sibling_cancelled);
+}
+
+UTEST(TaskGroup, CancelInDestructor) {
+  std::atomic<bool> cancelled{false};
+  {
+    concurrent::TaskGroup group("destructor", 1);
+    group.Spawn([&] {
+      engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+      cancelled = engine::current_task::ShouldCancel();
+    });
+    engine::Yield();
+  }
+  EXPECT_TRUE(cancelled);
+}
+
+UTEST(TaskGroup, SpawnAfterCancel) {
+  std::atomic<int> calls{0};
+  concurrent::TaskGroup group("cancel", 2);
+  group.Cancel();
+  group.Spawn([&] { ++calls; });
+  UEXPECT_NO_THROW(group.Wait());
+  EXPECT_EQ(calls, 0);
+}
+
+UTEST(TaskGroup, ItemsRunInWorkerSpans) {
+  tracing::Span span("parent");
+  const auto trace_id = span.GetTraceId();
+
+  std::atomic<int> matched{0};
+  concurrent::TaskGroup group("worker", 2);
+  for (int i = 0; i < 10; ++i) {
+    group.Spawn([&] {
+      auto* current = tracing::Span::CurrentSpanUnchecked();
+      if (current && current->GetTraceId() == trace_id) ++matched;
+    });
+  }
+  group.Wait();
+  EXPECT_EQ(matched, 10);
+}
+
+UTEST_MT(ParallelFor, VisitsEachIndexOnce, 4) {
+  constexpr std::size_t kCount = 10'000;
+  std::vector<std::atomic<int>> visits(kCount);
+  ConcurrencyCounter counter;
+
+  concurrent::ParallelFor("parallel-for", kCount, 4, [&](std::size_t index) {
+    counter.Enter();
+    ++visits[index];
+    counter.Leave();
+  });
+
+  for (const auto& visit : visits) EXPECT_EQ(visit.load(), 1);
+  EXPECT_LE(counter.GetMax(), 4);
+}
+
+UTEST(ParallelFor, Empty) {
+  concurrent::ParallelFor("empty", 0, 4, [](std::size_t) { FAIL(); });
+}
+
+UTEST_MT(ParallelFor, StopsOnError, 2) {
+  std::atomic<std::size_t> calls{0};
+  const auto func = [&calls](std::size_t index) {
+    ++calls;
+    if (index == 10) throw std::runtime_error("error");
+    engine::Yield();
+  };
+
+  UEXPECT_THROW(concurrent::ParallelFor("error", 10'000, 2, func),
+                std::runtime_error);
+  EXPECT_LT(calls, 10'000);
+}
+
+USERVER_NAMESPACE_END
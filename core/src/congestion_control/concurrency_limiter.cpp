@@ -0,0 +1,158 @@
+#include <userver/congestion_control/concurrency_limiter.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control {
+
+namespace {
+
+// The long term RTT is a simple average until that many samples are collected
+constexpr std::size_t kWarmupSamples = 10;
+
+constexpr double kMinGradient = 0.5;
+
+}  // namespace
+
+ConcurrencyLimitExceededError::ConcurrencyLimitExceededError()
+    : std::runtime_error("Concurrency limit exceeded") {}
+
+ConcurrencyLimiterSettings Parse(
+    const yaml_config::YamlConfig& value,
+    formats::parse::To<ConcurrencyLimiterSettings>) {
+  const ConcurrencyLimiterSettings defaults;
+  ConcurrencyLimiterSettings settings{
+      value["initial-limit"].As<std::size_t>(defaults.initial_limit),
+      value["min-limit"].As<std::size_t>(defaults.min_limit),
+      value["max-limit"].As<std::size_t>(defaults.max_limit),
+      value["smoothing"].As<double>(defaults.smoothing),
+      value["rtt-tolerance"].As<double>(defaults.rtt_tolerance),
+      value["queue-size"].As<std::size_t>(defaults.queue_size),
+      value["long-window"].As<std::size_t>(defaults.long_window),
+  };
+
+  if (settings.min_limit == 0 || settings.min_limit > settings.max_limit ||
+      settings.initial_limit < settings.min_limit ||
+      settings.initial_limit > settings.max_limit) {
+    throw std::runtime_error(
+        "Invalid limits of ConcurrencyLimiter at '" + value.GetPath() +
+        "', 0 < min-limit <= initial-limit <= max-limit is required");
+  }
+  if (!(settings.smoothing > 0 && settings.smoothing <= 1) ||
+      settings.rtt_tolerance < 1 || settings.long_window == 0) {
+    throw std::runtime_error("Invalid settings of ConcurrencyLimiter at '" +
+                             value.GetPath() + "'");
+  }
+  return settings;
+}
+
+ConcurrencyLimiter::Token::Token(ConcurrencyLimiter& limiter) noexcept
+    : limiter_(&limiter), start_(Clock::now()) {}
+
+ConcurrencyLimiter::Token::Token(Token&& other) noexcept
+    : limiter_(std::exchange(other.limiter_, nullptr)),
+      start_(other.start_),
+      is_dropped_(other.is_dropped_),
+      is_ignored_(other.is_ignored_) {}
+
+ConcurrencyLimiter::Token::~Token() {
+  if (limiter_) limiter_->Release(*this);
+}
+
+ConcurrencyLimiter::ConcurrencyLimiter(ConcurrencyLimiterSettings settings)
+    : settings_(settings),
+      limit_(settings.initial_limit),
+      estimated_limit_(static_cast<double>(settings.initial_limit)) {
+  UASSERT(settings_.min_limit <= settings_.initial_limit &&
+          settings_.initial_limit <= settings_.max_limit);
+}
+
+std::optional<ConcurrencyLimiter::Token>
+ConcurrencyLimiter::TryAcquire() noexcept {
+  const auto in_flight = in_flight_.fetch_add(1, std::memory_order_relaxed);
+  if (in_flight >= limit_.load(std::memory_order_relaxed)) {
+    in_flight_.fetch_sub(1, std::memory_order_relaxed);
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+  return Token{*this};
+}
+
+std::size_t ConcurrencyLimiter::GetLimit() const noexcept {
+  return limit_.load(std::memory_order_relaxed);
+}
+
+std::size_t ConcurrencyLimiter::GetInFlight() const noexcept {
+  return in_flight_.load(std::memory_order_relaxed);
+}
+
+void ConcurrencyLimiter::Release(const Token& token) noexcept {
+  // The request itself is still counted, as it was in flight all the time
+  const auto in_flight = in_flight_.load(std::memory_order_relaxed);
+  if (!token.is_ignored_) {
+    try {
+      OnSample(Clock::now() - token.start_, in_flight, token.is_dropped_);
+    } catch (const std::exception& ex) {
+      UASSERT_MSG(false, ex.what());
+    }
+  }
+  in_flight_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ConcurrencyLimiter::OnSample(Clock::duration rtt, std::size_t in_flight,
+                                  bool is_dropped) {
+  const auto short_rtt =
+      std::max(std::chrono::duration<double, std::micro>(rtt).count(), 1.0);
+
+  const std::lock_guard lock(mutex_);
+  ++samples_;
+  if (samples_ <= kWarmupSamples) {
+    long_rtt_ += (short_rtt - long_rtt_) / static_cast<double>(samples_);
+  } else {
+    const auto alpha =
+        2.0 / (static_cast<double>(settings_.long_window) + 1.0);
+    long_rtt_ += (short_rtt - long_rtt_) * alpha;
+  }
+
+  // The average is slow to follow the drop of RTT after an overload, while
+  // the limit stays low
+  if (long_rtt_ / short_rtt > 2) long_rtt_ *= 0.95;
+
+  // The requests do not saturate the limit, the RTT tells nothing about it
+  if (!is_dropped &&
+      static_cast<double>(in_flight) < estimated_limit_ / 2) {
+    return;
+  }
+
+  const auto gradient =
+      is_dropped ? kMinGradient
+                 : std::clamp(settings_.rtt_tolerance * long_rtt_ / short_rtt,
+                              kMinGradient, 1.0);
+  const auto new_limit =
+      estimated_limit_ * gradient + static_cast<double>(settings_.queue_size);
+  estimated_limit_ = std::clamp(
+      estimated_limit_ * (1 - settings_.smoothing) +
+          new_limit * settings_.smoothing,
+      static_cast<double>(settings_.min_limit),
+      static_cast<double>(settings_.max_limit));
+
+  limit_.store(static_cast<std::size_t>(estimated_limit_),
+               std::memory_order_relaxed);
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ConcurrencyLimiter& limiter) {
+  writer["limit"] = limiter.GetLimit();
+  writer["in-flight"] = limiter.GetInFlight();
+  writer["rejected"] = limiter.rejected_.load(std::memory_order_relaxed);
+}
+
+}  // namespace congestion_control
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,103 @@
+#include <userver/congestion_control/concurrency_limiter.hpp>
+
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using congestion_control::ConcurrencyLimiter;
+using congestion_control::ConcurrencyLimiterSettings;
+
+ConcurrencyLimiterSettings MakeSettings() {
+  ConcurrencyLimiterSettings settings;
+  settings.initial_limit = 10;
+  settings.max_limit = 100;
+  return settings;
+}
+
+void Feed(ConcurrencyLimiter& limiter, std::chrono::milliseconds rtt,
+          int count, bool is_dropped = false) {
+  for (int i = 0; i < count; ++i) {
+    limiter.OnSample(rtt, limiter.GetLimit(), is_dropped);
+  }
+}
+
+}  // namespace
+
+TEST(ConcurrencyLimiter, Acquire) {
+  ConcurrencyLimiter limiter{MakeSettings()};
+  std::vector<ConcurrencyLimiter::Token> tokens;
+  for (int i = 0; i < 10; ++i) {
+    auto token = limiter.TryAcquire();
+    ASSERT_TRUE(token);
+    token->IgnoreSample();
+    tokens.push_back(std::move(*token));
+  }
+  EXPECT_EQ(limiter.GetInFlight(), 10);
+  EXPECT_FALSE(limiter.TryAcquire());
+
+  tokens.pop_back();
+  EXPECT_EQ(limiter.GetInFlight(), 9);
+  EXPECT_TRUE(limiter.TryAcquire());
+
+  tokens.clear();
+  EXPECT_EQ(limiter.GetInFlight(), 0);
+  EXPECT_EQ(limiter.GetLimit(), 10);
+}
+
+TEST(ConcurrencyLimiter, Execute) {
+  ConcurrencyLimiter limiter{MakeSettings()};
+  EXPECT_EQ(limiter.Execute([&limiter] { return limiter.GetInFlight(); }), 1);
+  EXPECT_EQ(limiter.GetInFlight(), 0);
+
+  std::vector<ConcurrencyLimiter::Token> tokens;
+  while (auto token = limiter.TryAcquire()) {
+    token->IgnoreSample();
+    tokens.push_back(std::move(*token));
+  }
+  EXPECT_THROW(limiter.Execute([] {}),
+               congestion_control::ConcurrencyLimitExceededError);
+}
+
+TEST(ConcurrencyLimiter, GrowsWithStableRtt) {
+  ConcurrencyLimiter limiter{MakeSettings()};
+  Feed(limiter, 10ms, 200);
+  EXPECT_EQ(limiter.GetLimit(), 100);
+}
+
+TEST(ConcurrencyLimiter, ShrinksWithGrowingRtt) {
+  ConcurrencyLimiter limiter{MakeSettings()};
+  Feed(limiter, 10ms, 100);
+  const auto limit = limiter.GetLimit();
+
+  Feed(limiter, 100ms, 20);
+  EXPECT_LT(limiter.GetLimit(), limit / 2);
+
+  // Recovers once the dependency is fast again
+  Feed(limiter, 10ms, 200);
+  EXPECT_GT(limiter.GetLimit(), limit / 2);
+}
+
+TEST(ConcurrencyLimiter, ShrinksOnDrops) {
+  ConcurrencyLimiter limiter{MakeSettings()};
+  Feed(limiter, 10ms, 100);
+  const auto limit = limiter.GetLimit();
+
+  Feed(limiter, 10ms, 20, true);
+  EXPECT_LT(limiter.GetLimit(), limit / 2);
+  EXPECT_GE(limiter.GetLimit(), 1);
+}
+
+TEST(ConcurrencyLimiter, AppLimited) {
+  ConcurrencyLimiter limiter{MakeSettings()};
+  // Few requests in flight, the limit is not changed by their RTT
+  for (int i = 0; i < 100; ++i) limiter.OnSample(100ms, 1, false);
+  EXPECT_EQ(limiter.GetLimit(), 10);
+}
+
+USERVER_NAMESPACE_END
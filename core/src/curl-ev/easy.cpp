@@ -215,6 +215,14 @@ void easy::cancel(size_t request_num) {
   }
 }
 
+void easy::unpause() {
+  if (multi_) {
+    multi_->GetThreadControl().RunInEvLoopAsync([self = shared_from_this()] {
+      native::curl_easy_pause(self->handle_, CURLPAUSE_CONT);
+    });
+  }
+}
+
 void easy::do_ev_cancel(size_t request_num) {
   // RunInEvLoopAsync(do_ev_async_perform) and RunInEvLoopSync(do_ev_cancel) are
   // not synchronized. So we need to count last cancelled request to prevent its
@@ -234,12 +242,13 @@ void easy::reset() {
 
   orig_url_str_.clear();
   std::string{}.swap(post_fields_);  // forced memory freeing
+  shared_post_fields_.reset();
   form_.reset();
   if (headers_) headers_->clear();
   if (proxy_headers_) proxy_headers_->clear();
   if (http200_aliases_) http200_aliases_->clear();
   if (resolved_hosts_) resolved_hosts_->clear();
-  share_.reset();
+  // curl_easy_reset() keeps the share attached, so does share_
   retries_count_ = 0;
   sockets_opened_ = 0;
   rate_limit_error_.clear();
@@ -346,6 +355,7 @@ void easy::set_post_fields(std::string&& post_fields) {
 }
 
 void easy::set_post_fields(std::string&& post_fields, std::error_code& ec) {
+  shared_post_fields_.reset();
   post_fields_ = std::move(post_fields);
   ec =
       std::error_code{static_cast<errc::EasyErrorCode>(native::curl_easy_setopt(
@@ -356,6 +366,24 @@ void easy::set_post_fields(std::string&& post_fields, std::error_code& ec) {
         static_cast<native::curl_off_t>(post_fields_.length()), ec);
 }
 
+void easy::set_shared_post_fields(
+    std::shared_ptr<const std::string> post_fields) {
+  if (!post_fields) {
+    set_post_fields({});
+    return;
+  }
+
+  std::string{}.swap(post_fields_);
+  shared_post_fields_ = std::move(post_fields);
+  std::error_code ec{static_cast<errc::EasyErrorCode>(native::curl_easy_setopt(
+      handle_, native::CURLOPT_POSTFIELDS, shared_post_fields_->c_str()))};
+  if (!ec) {
+    set_post_field_size_large(
+        static_cast<native::curl_off_t>(shared_post_fields_->length()), ec);
+  }
+  throw_error(ec, "set_shared_post_fields");
+}
+
 void easy::set_http_post(std::shared_ptr<form> form) {
   std::error_code ec;
   set_http_post(std::move(form), ec);
@@ -603,7 +631,7 @@ void easy::set_share(std::shared_ptr<share> share) {
 void easy::set_share(std::shared_ptr<share> share, std::error_code& ec) {
   share_ = std::move(share);
 
-  if (share) {
+  if (share_) {
     ec = std::error_code{
         static_cast<errc::EasyErrorCode>(native::curl_easy_setopt(
             handle_, native::CURLOPT_SHARE, share_->native_handle()))};
@@ -613,12 +641,18 @@ void easy::set_share(std::shared_ptr<share> share, std::error_code& ec) {
   }
 }
 
-bool easy::has_post_data() const { return !post_fields_.empty() || form_; }
+bool easy::has_post_data() const {
+  return !get_post_data().empty() || form_;
+}
 
-const std::string& easy::get_post_data() const { return post_fields_; }
+const std::string& easy::get_post_data() const {
+  return shared_post_fields_ ? *shared_post_fields_ : post_fields_;
+}
 
 std::string easy::extract_post_data() {
-  auto data = std::move(post_fields_);
+  // The shared buffer may be used by others, so it is copied
+  auto data =
+      shared_post_fields_ ? *shared_post_fields_ : std::move(post_fields_);
   set_post_fields({});
   return data;
 }
@@ -177,6 +177,8 @@ class easy final : public std::enable_shared_from_this<easy> {
   void perform(std::error_code& ec);
   void async_perform(handler_type handler);
   void cancel();
+  // Resumes the transfer paused by the read function, asynchronously
+  void unpause();
   void reset();
   void set_source(std::shared_ptr<std::istream> source);
   void set_source(std::shared_ptr<std::istream> source, std::error_code& ec);
@@ -320,6 +322,8 @@ class easy final : public std::enable_shared_from_this<easy> {
                         long);
   IMPLEMENT_CURL_OPTION_STRING(set_unix_socket_path,
                                native::CURLOPT_UNIX_SOCKET_PATH);
+  IMPLEMENT_CURL_OPTION_STRING(set_abstract_unix_socket,
+                               native::CURLOPT_ABSTRACT_UNIX_SOCKET);
   IMPLEMENT_CURL_OPTION(set_connect_to, native::CURLOPT_CONNECT_TO,
                         native::curl_slist*);
   // authentication options
@@ -392,6 +396,8 @@ class easy final : public std::enable_shared_from_this<easy> {
   IMPLEMENT_CURL_OPTION_BOOLEAN(set_put, native::CURLOPT_PUT);
   void set_post_fields(std::string&& post_fields);
   void set_post_fields(std::string&& post_fields, std::error_code& ec);
+  // The buffer is shared with the caller and is not copied
+  void set_shared_post_fields(std::shared_ptr<const std::string> post_fields);
   IMPLEMENT_CURL_OPTION(set_post_fields, native::CURLOPT_POSTFIELDS, void*);
   IMPLEMENT_CURL_OPTION(set_post_field_size, native::CURLOPT_POSTFIELDSIZE,
                         long);
@@ -782,6 +788,7 @@ class easy final : public std::enable_shared_from_this<easy> {
   std::shared_ptr<std::istream> source_;
   std::string* sink_{nullptr};
   std::string post_fields_;
+  std::shared_ptr<const std::string> shared_post_fields_;
   std::shared_ptr<form> form_;
   std::shared_ptr<string_list> headers_;
   std::shared_ptr<string_list> proxy_headers_;
@@ -18,9 +18,17 @@ constexpr std::string_view kDumpFormatVersion = "format-version";
 constexpr std::string_view kMaxDumpCount = "max-count";
 constexpr std::string_view kWorldReadable = "world-readable";
 constexpr std::string_view kEncrypted = "encrypted";
+constexpr std::string_view kCompressed = "compressed";
+constexpr std::string_view kCompressionLevel = "compression-level";
+constexpr std::string_view kMemoryMapped = "memory-mapped";
+constexpr std::string_view kFollower = "follower";
+constexpr std::string_view kDifferential = "differential";
+constexpr std::string_view kMaxDeltas = "max-deltas";
 
 constexpr auto kDefaultFsTaskProcessor = std::string_view{"fs-task-processor"};
 constexpr auto kDefaultMaxDumpCount = uint64_t{1};
+constexpr auto kDefaultCompressionLevel = 1;
+constexpr auto kDefaultMaxDeltas = uint64_t{16};
 
 }  // namespace
 
@@ -67,6 +75,13 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
           config[kMaxDumpAge].As<std::optional<std::chrono::milliseconds>>()),
       max_dump_age_set(config.HasMember(kMaxDumpAge)),
       dump_is_encrypted(config[kEncrypted].As<bool>(false)),
+      dump_is_compressed(config[kCompressed].As<bool>(false)),
+      compression_level(
+          config[kCompressionLevel].As<int>(kDefaultCompressionLevel)),
+      dump_is_memory_mapped(config[kMemoryMapped].As<bool>(false)),
+      dump_is_follower(config[kFollower].As<bool>(false)),
+      dump_is_differential(config[kDifferential].As<bool>(false)),
+      max_deltas(config[kMaxDeltas].As<uint64_t>(kDefaultMaxDeltas)),
       static_dumps_enabled(config[kDumpsEnabled].As<bool>()),
       static_min_dump_interval(
           config[kMinDumpInterval].As<std::chrono::milliseconds>(0)) {
@@ -78,6 +93,19 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
     throw std::logic_error(
         fmt::format("{}: {} must not be 0", this->name, kMaxDumpCount));
   }
+  if (compression_level < 1 || compression_level > 9) {
+    throw std::logic_error(fmt::format("{}: {} must be in [1, 9]", this->name,
+                                       kCompressionLevel));
+  }
+  if (dump_is_memory_mapped && (dump_is_encrypted || dump_is_compressed)) {
+    throw std::logic_error(
+        fmt::format("{}: {} dumps can be neither {} nor {}", this->name,
+                    kMemoryMapped, kEncrypted, kCompressed));
+  }
+  if (dump_is_differential && max_deltas == 0) {
+    throw std::logic_error(fmt::format("{}: {} must not be 0 for {} dumps",
+                                       this->name, kMaxDeltas, kDifferential));
+  }
 }
 
 DynamicConfig::DynamicConfig(const Config& config, ConfigPatch&& patch)
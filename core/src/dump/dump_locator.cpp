@@ -26,7 +26,8 @@ const std::string kTimeZone = "UTC";
 DumpLocator::DumpLocator(Config static_config)
     : config_(static_config),
       filename_regex_(GenerateFilenameRegex(FileFormatType::kNormal)),
-      tmp_filename_regex_(GenerateFilenameRegex(FileFormatType::kTmp)) {}
+      tmp_filename_regex_(GenerateFilenameRegex(FileFormatType::kTmp)),
+      delta_filename_regex_(GenerateFilenameRegex(FileFormatType::kDelta)) {}
 
 DumpFileStats DumpLocator::RegisterNewDump(TimePoint update_time) {
   std::string dump_path = GenerateDumpPath(update_time);
@@ -79,9 +80,60 @@ bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
                                                  kFilenameDateFormat);
   }
 
-  const std::string old_name = GenerateDumpPath({old_update_time});
-  const std::string new_name = GenerateDumpPath({new_update_time});
+  return RenameDump(GenerateDumpPath(old_update_time),
+                    GenerateDumpPath(new_update_time));
+}
+
+DumpFileStats DumpLocator::RegisterNewDelta(TimePoint base_update_time,
+                                            TimePoint update_time) {
+  std::string delta_path = GenerateDeltaPath(base_update_time, update_time);
+
+  if (boost::filesystem::exists(delta_path)) {
+    throw std::runtime_error(fmt::format(
+        "{}: could not write a delta to \"{}\", because the file already "
+        "exists",
+        config_.name, delta_path));
+  }
+
+  return {update_time, std::move(delta_path), config_.dump_format_version};
+}
+
+std::vector<DumpFileStats> DumpLocator::GetDeltas(
+    TimePoint base_update_time) const {
+  const auto base_filename =
+      boost::filesystem::path{GenerateDumpPath(base_update_time)}
+          .filename()
+          .string();
+  std::vector<DumpFileStats> deltas;
+
+  for (const auto& file :
+       boost::filesystem::directory_iterator{config_.dump_directory}) {
+    if (!boost::filesystem::is_regular_file(file.status())) {
+      continue;
+    }
+
+    auto delta = ParseDeltaName(file.path().string());
+    if (delta && delta->second == base_filename) {
+      deltas.push_back(std::move(delta->first));
+    }
+  }
+
+  std::sort(deltas.begin(), deltas.end(),
+            [](const DumpFileStats& a, const DumpFileStats& b) {
+              return a.update_time < b.update_time;
+            });
+  return deltas;
+}
+
+bool DumpLocator::BumpDeltaTime(TimePoint base_update_time,
+                                TimePoint old_update_time,
+                                TimePoint new_update_time) {
+  return RenameDump(GenerateDeltaPath(base_update_time, old_update_time),
+                    GenerateDeltaPath(base_update_time, new_update_time));
+}
 
+bool DumpLocator::RenameDump(const std::string& old_name,
+                             const std::string& new_name) {
   try {
     if (!boost::filesystem::is_regular_file(old_name)) {
       LOG_WARNING()
@@ -103,6 +155,7 @@ bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
 void DumpLocator::Cleanup() {
   const auto min_update_time = MinAcceptableUpdateTime();
   std::vector<DumpFileStats> dumps;
+  std::vector<std::string> deltas;
 
   try {
     if (!boost::filesystem::exists(config_.dump_directory)) {
@@ -126,6 +179,11 @@ void DumpLocator::Cleanup() {
         continue;
       }
 
+      if (boost::regex_match(filename, delta_filename_regex_)) {
+        deltas.push_back(file.path().string());
+        continue;
+      }
+
       auto dump = ParseDumpName(file.path().string());
       if (!dump) {
         LOG_WARNING() << config_.name
@@ -157,6 +215,16 @@ void DumpLocator::Cleanup() {
                   << dumps[i].full_path << "\"";
       boost::filesystem::remove(dumps[i].full_path);
     }
+
+    for (const auto& delta_path : deltas) {
+      const auto delta = ParseDeltaName(delta_path);
+      if (!delta || !boost::filesystem::exists(fmt::format(
+                        "{}/{}", config_.dump_directory, delta->second))) {
+        LOG_DEBUG() << config_.name << ": removing a delta without a dump \""
+                    << delta_path << "\"";
+        boost::filesystem::remove(delta_path);
+      }
+    }
   } catch (const std::exception& ex) {
     LOG_ERROR() << config_.name
                 << ": error while cleaning up old dumps. Cause: " << ex;
@@ -191,6 +259,35 @@ std::optional<DumpFileStats> DumpLocator::ParseDumpName(
   return std::nullopt;
 }
 
+std::optional<std::pair<DumpFileStats, std::string>>
+DumpLocator::ParseDeltaName(std::string full_path) const {
+  const auto filename = boost::filesystem::path{full_path}.filename().string();
+
+  boost::smatch regex;
+  if (!boost::regex_match(filename, regex, delta_filename_regex_)) {
+    return std::nullopt;
+  }
+  UASSERT_MSG(regex.size() == 3,
+              fmt::format("Incorrect sub-match count: {} for filename {}",
+                          regex.size(), filename));
+
+  auto base = ParseDumpName(regex[1].str());
+  if (!base) return std::nullopt;
+
+  try {
+    const auto date = utils::datetime::Stringtime(regex[2].str(), kTimeZone,
+                                                  kFilenameDateFormat);
+    return std::pair{DumpFileStats{{Round(date)},
+                                   std::move(full_path),
+                                   base->format_version},
+                     regex[1].str()};
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "A filename looks like a delta, but it is not, path=\""
+                  << filename << "\". Reason: " << ex;
+    return std::nullopt;
+  }
+}
+
 std::optional<DumpFileStats> DumpLocator::GetLatestDumpImpl() const {
   const auto min_update_time = MinAcceptableUpdateTime();
   std::optional<DumpFileStats> best_dump;
@@ -210,8 +307,11 @@ std::optional<DumpFileStats> DumpLocator::GetLatestDumpImpl() const {
 
       auto curr_dump = ParseDumpName(file.path().string());
       if (!curr_dump) {
-        if (boost::regex_match(file.path().filename().string(),
-                               tmp_filename_regex_)) {
+        const auto filename = file.path().filename().string();
+        if (boost::regex_match(filename, delta_filename_regex_)) {
+          continue;
+        }
+        if (boost::regex_match(filename, tmp_filename_regex_)) {
           LOG_DEBUG() << "A leftover tmp file found: \"" << file.path().string()
                       << "\". It will be removed on next Cleanup";
         } else {
@@ -257,6 +357,13 @@ std::string DumpLocator::GenerateDumpPath(TimePoint update_time) const {
       config_.dump_format_version);
 }
 
+std::string DumpLocator::GenerateDeltaPath(TimePoint base_update_time,
+                                           TimePoint update_time) const {
+  return fmt::format(
+      FMT_COMPILE("{}.delta-{}"), GenerateDumpPath(base_update_time),
+      utils::datetime::Timestring(update_time, kTimeZone, kFilenameDateFormat));
+}
+
 TimePoint DumpLocator::MinAcceptableUpdateTime() const {
   return config_.max_dump_age
              ? Round(utils::datetime::Now()) - *config_.max_dump_age
@@ -264,9 +371,18 @@ TimePoint DumpLocator::MinAcceptableUpdateTime() const {
 }
 
 std::string DumpLocator::GenerateFilenameRegex(FileFormatType type) {
-  return std::string{
-             R"(^(\d{4}-\d{2}-\d{2}T\d{2}:?\d{2}:?\d{2}\.\d{6}Z?)-v(\d+))"} +
-         (type == FileFormatType::kTmp ? "\\.tmp$" : "$");
+  const std::string time = R"(\d{4}-\d{2}-\d{2}T\d{2}:?\d{2}:?\d{2}\.\d{6}Z?)";
+  const std::string delta_time = R"(\d{4}-\d{2}-\d{2}T\d{6}\.\d{6}Z)";
+  switch (type) {
+    case FileFormatType::kNormal:
+      return "^(" + time + R"()-v(\d+)$)";
+    case FileFormatType::kTmp:
+      return "^(" + time + R"()-v(\d+)(\.delta-)" + delta_time +
+             R"()?\.tmp$)";
+    case FileFormatType::kDelta:
+      return "^(" + time + R"(-v\d+)\.delta-()" + delta_time + ")$";
+  }
+  UINVARIANT(false, "Unexpected FileFormatType");
 }
 
 TimePoint DumpLocator::Round(std::chrono::system_clock::time_point time) {
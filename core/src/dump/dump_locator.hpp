@@ -4,6 +4,8 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <boost/regex.hpp>
 
@@ -47,20 +49,50 @@ class DumpLocator final {
   /// @return `true` on success, `false` if the dump is not available
   bool BumpDumpTime(TimePoint old_update_time, TimePoint new_update_time);
 
-  /// @brief Removes old dumps and tmp files
+  /// @brief Prepare the place for a new delta of the dump written at
+  /// `base_update_time`
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  /// @note The actual creation of the file is a caller's responsibility
+  /// @throws On a filesystem error
+  DumpFileStats RegisterNewDelta(TimePoint base_update_time,
+                                 TimePoint update_time);
+
+  /// @brief Finds the deltas of the dump written at `base_update_time`
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  /// @returns The deltas sorted by the update time
+  /// @throws On a filesystem error
+  std::vector<DumpFileStats> GetDeltas(TimePoint base_update_time) const;
+
+  /// @brief Modifies the update time for a delta of the dump written at
+  /// `base_update_time`
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  /// @return `true` on success, `false` if the delta is not available
+  bool BumpDeltaTime(TimePoint base_update_time, TimePoint old_update_time,
+                     TimePoint new_update_time);
+
+  /// @brief Removes old dumps, deltas of the removed dumps and tmp files
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @warning Must not be called concurrently with `RegisterNewDump`
   void Cleanup();
 
  private:
-  enum class FileFormatType { kNormal, kTmp };
+  enum class FileFormatType { kNormal, kTmp, kDelta };
 
   std::optional<DumpFileStats> ParseDumpName(std::string full_path) const;
 
+  // Returns the delta and the filename of its base dump
+  std::optional<std::pair<DumpFileStats, std::string>> ParseDeltaName(
+      std::string full_path) const;
+
+  bool RenameDump(const std::string& old_name, const std::string& new_name);
+
   std::optional<DumpFileStats> GetLatestDumpImpl() const;
 
   std::string GenerateDumpPath(TimePoint update_time) const;
 
+  std::string GenerateDeltaPath(TimePoint base_update_time,
+                                TimePoint update_time) const;
+
   TimePoint MinAcceptableUpdateTime() const;
 
   static std::string GenerateFilenameRegex(FileFormatType type);
@@ -70,6 +102,7 @@ class DumpLocator final {
   const Config config_;
   const boost::regex filename_regex_;
   const boost::regex tmp_filename_regex_;
+  const boost::regex delta_filename_regex_;
 };
 
 }  // namespace dump
@@ -221,6 +221,65 @@ max-age: null
   EXPECT_EQ(dump::FilenamesInDirectory(dir, kDumperName), expected_files);
 }
 
+UTEST(DumpLocator, Deltas) {
+  using namespace std::chrono_literals;
+
+  const std::string kConfig = R"(
+enable: true
+world-readable: false
+format-version: 5
+max-age: null
+differential: true
+)";
+  const auto dir = fs::blocking::TempDirectory::Create();
+
+  const dump::Config config{dump::ConfigFromYaml(kConfig, dir, kDumperName)};
+  dump::DumpLocator locator{config};
+
+  const auto base_stats = locator.RegisterNewDump(BaseTime());
+  fs::blocking::RewriteFileContents(base_stats.full_path, "base");
+  for (const auto delay : {2s, 1s}) {
+    const auto delta_stats =
+        locator.RegisterNewDelta(BaseTime(), BaseTime() + delay);
+    fs::blocking::RewriteFileContents(delta_stats.full_path, "delta");
+  }
+  // A leftover delta of a removed dump
+  dump::CreateDumps({"2015-03-22T085959.000000Z-v5.delta-"
+                     "2015-03-22T090010.000000Z"},
+                    dir, kDumperName);
+
+  {
+    // Deltas are not dumps
+    const auto dump_stats = locator.GetLatestDump();
+    ASSERT_TRUE(dump_stats);
+    EXPECT_EQ(dump_stats->update_time, BaseTime());
+  }
+
+  {
+    // Deltas are ordered by the update time
+    const auto deltas = locator.GetDeltas(BaseTime());
+    ASSERT_EQ(deltas.size(), 2);
+    EXPECT_EQ(Filename(deltas[0].full_path),
+              "2015-03-22T090000.000000Z-v5.delta-2015-03-22T090001.000000Z");
+    EXPECT_EQ(deltas[0].update_time, BaseTime() + 1s);
+    EXPECT_EQ(deltas[1].update_time, BaseTime() + 2s);
+  }
+
+  EXPECT_TRUE(locator.BumpDeltaTime(BaseTime(), BaseTime() + 2s,
+                                    BaseTime() + 3s));
+  EXPECT_FALSE(locator.BumpDeltaTime(BaseTime(), BaseTime() + 2s,
+                                     BaseTime() + 4s));
+
+  // Only the delta without a dump is removed
+  locator.Cleanup();
+  EXPECT_EQ(dump::FilenamesInDirectory(dir, kDumperName),
+            (std::set<std::string>{
+                "2015-03-22T090000.000000Z-v5",
+                "2015-03-22T090000.000000Z-v5.delta-2015-03-22T090001.000000Z",
+                "2015-03-22T090000.000000Z-v5.delta-2015-03-22T090003.000000Z",
+            }));
+}
+
 UTEST(DumpLocator, LegacyFilenames) {
   using namespace std::chrono_literals;
   using namespace std::string_literals;
@@ -30,6 +30,7 @@
 #include <userver/yaml_config/schema.hpp>
 
 #include <dump/dump_locator.hpp>
+#include <dump/read_scheduler.hpp>
 #include <dump/statistics.hpp>
 #include <userver/components/dump_configurator.hpp>
 #include <userver/dump/config.hpp>
@@ -48,6 +49,14 @@ void ThrowDumpUnimplemented(const std::string& name) {
 
 DumpableEntity::~DumpableEntity() = default;
 
+void DumpableEntity::GetAndWriteDelta(dump::Writer& writer) const {
+  GetAndWrite(writer);
+}
+
+void DumpableEntity::ReadAndApplyDelta(dump::Reader& reader) {
+  ReadAndSet(reader);
+}
+
 namespace {
 
 struct UpdateTime final {
@@ -69,6 +78,9 @@ struct DumpData {
   DumpableEntity& dumpable;
   DumpLocator locator;
   std::optional<UpdateTime> dumped_update_time;
+  // The full dump that the next delta extends, for `differential` dumps
+  std::optional<TimePoint> base_update_time;
+  std::uint64_t deltas_count{0};
 };
 
 struct UpdateData {
@@ -86,6 +98,12 @@ Config ParseConfig(const components::ComponentConfig& config,
       context.FindComponent<components::DumpConfigurator>().GetDumpRoot()};
 }
 
+ReadScheduler* FindReadScheduler(const components::ComponentContext& context) {
+  auto* configurator =
+      context.FindComponentOptional<components::DumpConfigurator>();
+  return configurator ? &configurator->GetReadScheduler() : nullptr;
+}
+
 using NoAutoReset = engine::SingleConsumerEvent::NoAutoReset;
 
 enum class SignalStatus {
@@ -111,7 +129,7 @@ class Dumper::Impl {
        dynamic_config::Source config_source,
        utils::statistics::Storage& statistics_storage,
        testsuite::DumpControl& dump_control, DumpableEntity& dumpable,
-       Dumper& self);
+       ReadScheduler* read_scheduler, Dumper& self);
 
   ~Impl();
 
@@ -119,6 +137,8 @@ class Dumper::Impl {
 
   std::optional<TimePoint> ReadDump();
 
+  std::optional<TimePoint> ReadNewerDump();
+
   void WriteDumpSyncDebug();
 
   void ReadDumpDebug();
@@ -141,11 +161,22 @@ class Dumper::Impl {
   void DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
                    DumpData& dump_data);
 
+  /// @throws std::exception on failure
+  void DoWriteDelta(TimePoint update_time, tracing::ScopeTime& scope,
+                    DumpData& dump_data);
+
+  bool IsDeltaAllowed(const DumpData& dump_data) const;
+
+  /// @returns `false` if the latest dump or delta is not available
+  bool BumpDumpTime(DumpData& dump_data, TimePoint old_update_time,
+                    TimePoint new_update_time);
+
   enum class DumpOperation { kNewDump, kBumpTime };
 
   /// @returns `update_time` of the loaded dump on success, `null` otherwise
-  std::optional<TimePoint> LoadFromDump(DumpData& dump_data,
-                                        const DynamicConfig& config);
+  std::optional<TimePoint> LoadFromDump(
+      DumpData& dump_data, const DynamicConfig& config,
+      std::optional<TimePoint> newer_than = std::nullopt);
 
   rcu::ReadablePtr<DynamicConfig> ReadConfigForPeriodicTask();
 
@@ -156,6 +187,8 @@ class Dumper::Impl {
   const std::string read_span_name_;
   rcu::Variable<DynamicConfig> dynamic_config_;
   engine::TaskProcessor& fs_task_processor_;
+  // nullptr means that reads are not limited
+  ReadScheduler* const read_scheduler_;
   Statistics statistics_;
   std::atomic<bool> tried_to_read_dump_{false};
 
@@ -181,12 +214,14 @@ Dumper::Impl::Impl(const Config& initial_config,
                    dynamic_config::Source config_source,
                    utils::statistics::Storage& statistics_storage,
                    testsuite::DumpControl& dump_control,
-                   DumpableEntity& dumpable, Dumper& self)
+                   DumpableEntity& dumpable, ReadScheduler* read_scheduler,
+                   Dumper& self)
     : static_config_(initial_config),
       write_span_name_("write-dump/" + Name()),
       read_span_name_("read-dump/" + Name()),
       dynamic_config_(static_config_, ConfigPatch{}),
       fs_task_processor_(fs_task_processor),
+      read_scheduler_(read_scheduler),
       dump_data_(static_config_, std::move(rw_factory), dumpable),
       update_data_(statistics_),
       testsuite_registration_(std::in_place, dump_control, self) {
@@ -196,8 +231,10 @@ Dumper::Impl::Impl(const Config& initial_config,
       });
   config_subscription_ = config_source.UpdateAndListen(this, "dump." + Name(),
                                                        &Impl::OnConfigUpdate);
-  if (dump_control.GetPeriodicsMode() ==
-      testsuite::DumpControl::PeriodicsMode::kEnabled) {
+  // The leader process writes the dumps of a follower
+  if (!static_config_.dump_is_follower &&
+      dump_control.GetPeriodicsMode() ==
+          testsuite::DumpControl::PeriodicsMode::kEnabled) {
     periodic_task_ = engine::CriticalAsyncNoSpan(
         fs_task_processor_, [this] { PeriodicWriteTask(); });
   }
@@ -218,6 +255,20 @@ std::optional<TimePoint> Dumper::Impl::ReadDump() {
   return LoadFromDump(*dump_data, *config);
 }
 
+std::optional<TimePoint> Dumper::Impl::ReadNewerDump() {
+  auto dump_data = dump_data_.Lock();
+  const auto config = dynamic_config_.Read();
+
+  std::optional<TimePoint> current_time;
+  {
+    const auto update_data = update_data_.Lock();
+    if (update_data->update_time) {
+      current_time = update_data->update_time->last_update;
+    }
+  }
+  return LoadFromDump(*dump_data, *config, current_time);
+}
+
 void Dumper::Impl::WriteDumpSyncDebug() {
   if (!tried_to_read_dump_.load()) {
     throw Error(fmt::format(
@@ -353,14 +404,18 @@ void Dumper::Impl::WriteDump(DumpData& dump_data) {
 
   switch (operation_type) {
     case DumpOperation::kNewDump: {
-      dump_data.locator.Cleanup();
-      DoWriteDump(update_time.last_update, scope_time, dump_data);
+      if (IsDeltaAllowed(dump_data)) {
+        DoWriteDelta(update_time.last_update, scope_time, dump_data);
+      } else {
+        dump_data.locator.Cleanup();
+        DoWriteDump(update_time.last_update, scope_time, dump_data);
+      }
       break;
     }
     case DumpOperation::kBumpTime: {
       UASSERT(dumped_update_time);
-      if (!dump_data.locator.BumpDumpTime(dumped_update_time->last_update,
-                                          update_time.last_update)) {
+      if (!BumpDumpTime(dump_data, dumped_update_time->last_update,
+                        update_time.last_update)) {
         DoWriteDump(update_time.last_update, scope_time, dump_data);
       }
       break;
@@ -422,6 +477,10 @@ void Dumper::Impl::DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
                                DumpData& dump_data) {
   const auto dump_start = std::chrono::steady_clock::now();
 
+  // The deltas of the previous dump do not apply to the data being written
+  dump_data.base_update_time.reset();
+  dump_data.deltas_count = 0;
+
   const auto dump_stats = dump_data.locator.RegisterNewDump(update_time);
   const auto& dump_path = dump_stats.full_path;
   auto writer = dump_data.rw_factory->CreateWriter(dump_path, scope);
@@ -432,6 +491,10 @@ void Dumper::Impl::DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
   LOG_INFO() << Name() << ": a new dump has been written at \"" << dump_path
              << '"';
 
+  if (static_config_.dump_is_differential) {
+    dump_data.base_update_time = update_time;
+  }
+
   statistics_.last_written_size = dump_size;
   statistics_.last_nontrivial_write_duration =
       std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -439,8 +502,62 @@ void Dumper::Impl::DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
   statistics_.last_nontrivial_write_start_time = dump_start;
 }
 
+void Dumper::Impl::DoWriteDelta(TimePoint update_time,
+                                tracing::ScopeTime& scope,
+                                DumpData& dump_data) {
+  UASSERT(dump_data.base_update_time);
+  const auto dump_start = std::chrono::steady_clock::now();
+
+  std::string delta_path;
+  try {
+    delta_path = dump_data.locator
+                     .RegisterNewDelta(*dump_data.base_update_time, update_time)
+                     .full_path;
+    auto writer = dump_data.rw_factory->CreateWriter(delta_path, scope);
+    dump_data.dumpable.GetAndWriteDelta(*writer);
+    writer->Finish();
+  } catch (const std::exception&) {
+    // The entity may consider the changes dumped, start over with a full dump
+    dump_data.base_update_time.reset();
+    throw;
+  }
+  ++dump_data.deltas_count;
+  const auto delta_size = boost::filesystem::file_size(delta_path);
+
+  LOG_INFO() << Name() << ": a new delta has been written at \"" << delta_path
+             << '"';
+
+  statistics_.last_written_size = delta_size;
+  statistics_.last_nontrivial_write_duration =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - dump_start);
+  statistics_.last_nontrivial_write_start_time = dump_start;
+}
+
+bool Dumper::Impl::IsDeltaAllowed(const DumpData& dump_data) const {
+  return static_config_.dump_is_differential && dump_data.base_update_time &&
+         dump_data.deltas_count < static_config_.max_deltas;
+}
+
+bool Dumper::Impl::BumpDumpTime(DumpData& dump_data, TimePoint old_update_time,
+                                TimePoint new_update_time) {
+  if (dump_data.deltas_count != 0) {
+    UASSERT(dump_data.base_update_time);
+    return dump_data.locator.BumpDeltaTime(*dump_data.base_update_time,
+                                           old_update_time, new_update_time);
+  }
+  if (!dump_data.locator.BumpDumpTime(old_update_time, new_update_time)) {
+    return false;
+  }
+  if (dump_data.base_update_time) {
+    dump_data.base_update_time = new_update_time;
+  }
+  return true;
+}
+
 std::optional<TimePoint> Dumper::Impl::LoadFromDump(
-    DumpData& dump_data, const DynamicConfig& config) {
+    DumpData& dump_data, const DynamicConfig& config,
+    std::optional<TimePoint> newer_than) {
   tried_to_read_dump_.store(true);
   if (!config.dumps_enabled) {
     LOG_DEBUG() << Name()
@@ -458,6 +575,24 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
         try {
           auto dump_stats = dump_data.locator.GetLatestDump();
           if (!dump_stats) return std::optional<TimePoint>{};
+          const auto deltas =
+              static_config_.dump_is_differential
+                  ? dump_data.locator.GetDeltas(dump_stats->update_time)
+                  : std::vector<DumpFileStats>{};
+          const auto latest_update_time = deltas.empty()
+                                              ? dump_stats->update_time
+                                              : deltas.back().update_time;
+          if (newer_than && latest_update_time <= *newer_than) {
+            return std::optional<TimePoint>{};
+          }
+
+          ReadScheduler::Slot read_slot;
+          if (read_scheduler_) {
+            boost::system::error_code error;
+            const auto dump_size =
+                boost::filesystem::file_size(dump_stats->full_path, error);
+            read_slot = read_scheduler_->Acquire(error ? 0 : dump_size);
+          }
 
           auto reader =
               dump_data.rw_factory->CreateReader(dump_stats->full_path);
@@ -465,7 +600,37 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
           reader->Finish();
 
           LOG_INFO() << Name() << ": a dump has been loaded successfully";
-          return std::optional{dump_stats->update_time};
+          if (!static_config_.dump_is_differential) {
+            return std::optional{dump_stats->update_time};
+          }
+
+          dump_data.base_update_time = dump_stats->update_time;
+          dump_data.deltas_count = 0;
+          auto update_time = dump_stats->update_time;
+          std::size_t applied_deltas = 0;
+          for (const auto& delta : deltas) {
+            try {
+              auto delta_reader =
+                  dump_data.rw_factory->CreateReader(delta.full_path);
+              dump_data.dumpable.ReadAndApplyDelta(*delta_reader);
+              delta_reader->Finish();
+            } catch (const std::exception& ex) {
+              LOG_ERROR() << Name() << ": error while reading a delta \""
+                          << delta.full_path
+                          << "\", the next dump will be full. Reason: " << ex;
+              dump_data.base_update_time.reset();
+              dump_data.deltas_count = 0;
+              break;
+            }
+            update_time = delta.update_time;
+            ++applied_deltas;
+            ++dump_data.deltas_count;
+          }
+          if (!deltas.empty()) {
+            LOG_INFO() << Name() << ": " << applied_deltas << " of "
+                       << deltas.size() << " deltas have been applied";
+          }
+          return std::optional{update_time};
         } catch (const std::exception& ex) {
           LOG_ERROR() << Name()
                       << ": error while reading a dump. Reason: " << ex;
@@ -498,7 +663,8 @@ Dumper::Dumper(const Config& initial_config,
                utils::statistics::Storage& statistics_storage,
                testsuite::DumpControl& dump_control, DumpableEntity& dumpable)
     : impl_(initial_config, std::move(rw_factory), fs_task_processor,
-            config_source, statistics_storage, dump_control, dumpable, *this) {}
+            config_source, statistics_storage, dump_control, dumpable,
+            nullptr, *this) {}
 
 Dumper::Dumper(const components::ComponentConfig& config,
                const components::ComponentContext& context,
@@ -514,7 +680,7 @@ Dumper::Dumper(const Config& initial_config,
             context.FindComponent<components::StatisticsStorage>().GetStorage(),
             context.FindComponent<components::TestsuiteSupport>()
                 .GetDumpControl(),
-            dumpable, *this) {}
+            dumpable, FindReadScheduler(context), *this) {}
 
 Dumper::~Dumper() = default;
 
@@ -522,6 +688,10 @@ const std::string& Dumper::Name() const { return impl_->Name(); }
 
 std::optional<TimePoint> Dumper::ReadDump() { return impl_->ReadDump(); }
 
+std::optional<TimePoint> Dumper::ReadNewerDump() {
+  return impl_->ReadNewerDump();
+}
+
 void Dumper::WriteDumpSyncDebug() { impl_->WriteDumpSyncDebug(); }
 
 void Dumper::ReadDumpDebug() { impl_->ReadDumpDebug(); }
@@ -574,6 +744,39 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            compressed:
+                type: boolean
+                description: Whether to compress the dump with gzip
+                defaultDescription: false
+            compression-level:
+                type: integer
+                description: gzip compression level of the dump
+                defaultDescription: 1
+                minimum: 1
+                maximum: 9
+            memory-mapped:
+                type: boolean
+                description: Whether to read the dump from memory mapping
+                defaultDescription: false
+            follower:
+                type: boolean
+                description: |
+                    Whether the dumps are written by another process that
+                    shares the dump directory, only the newer dumps are read
+                defaultDescription: false
+            differential:
+                type: boolean
+                description: |
+                    Whether to write only the changes since the previous dump,
+                    a full dump is written each max-deltas dumps
+                defaultDescription: false
+            max-deltas:
+                type: integer
+                description: |
+                    The number of deltas after which a full dump is written
+                    again, for differential dumps
+                defaultDescription: 16
+                minimum: 1
 )");
 }
 
@@ -73,6 +73,7 @@ max-count: 3
 struct DumperFixtureConfig final {
   testsuite::DumpControl::PeriodicsMode periodics_mode{
       testsuite::DumpControl::PeriodicsMode::kEnabled};
+  bool follower{false};
 };
 
 class DumperFixture : public ::testing::Test {
@@ -81,7 +82,9 @@ class DumperFixture : public ::testing::Test {
 
   explicit DumperFixture(DumperFixtureConfig config)
       : root_(fs::blocking::TempDirectory::Create()),
-        config_(dump::ConfigFromYaml(kConfig, root_, DummyEntity::kName)),
+        config_(dump::ConfigFromYaml(
+            config.follower ? kConfig + "follower: true\n" : kConfig, root_,
+            DummyEntity::kName)),
         control_(config.periodics_mode) {}
 
   dump::Dumper MakeDumper() {
@@ -284,6 +287,53 @@ UTEST_F(DumperFixture, ReadDumpChecking) {
           ": unable to write a dump, there was no attempt to read а dump");
 }
 
+UTEST_F(DumperFixture, ReadNewerDump) {
+  utils::datetime::MockNowSet({});
+  auto dumper = MakeDumper();
+  EXPECT_EQ(dumper.ReadNewerDump(), std::nullopt);
+
+  dump::CreateDump(dump::ToBinary(1), GetConfig());
+  EXPECT_EQ(dumper.ReadNewerDump(), Now());
+  EXPECT_EQ(GetDumpable().value, 1);
+
+  EXPECT_EQ(dumper.ReadNewerDump(), std::nullopt);
+  EXPECT_EQ(GetDumpable().read_count, 1);
+
+  utils::datetime::MockSleep(3s);
+  dump::CreateDump(dump::ToBinary(2), GetConfig());
+  EXPECT_EQ(dumper.ReadNewerDump(), Now());
+  EXPECT_EQ(GetDumpable().value, 2);
+}
+
+namespace {
+
+class DumperFixtureFollower : public DumperFixture {
+ protected:
+  DumperFixtureFollower()
+      : DumperFixture([] {
+          DumperFixtureConfig config;
+          config.follower = true;
+          return config;
+        }()) {}
+};
+
+}  // namespace
+
+UTEST_F(DumperFixtureFollower, NoWrites) {
+  utils::datetime::MockNowSet({});
+  dump::CreateDump(dump::ToBinary(1), GetConfig());
+  auto dumper = MakeDumper();
+  EXPECT_TRUE(dumper.ReadDump());
+
+  utils::datetime::MockSleep(3s);
+  GetDumpable().value = 2;
+  dumper.OnUpdateCompleted(Now(), dump::UpdateType::kModified);
+  engine::Yield();
+
+  EXPECT_EQ(GetDumpable().write_count, 0);
+  EXPECT_EQ(dumper.ReadNewerDump(), std::nullopt);
+}
+
 namespace {
 
 class DumperFixtureNonPeriodic : public DumperFixture {
@@ -351,6 +401,134 @@ UTEST_F(DumperFixtureNonPeriodic, ForcedReadsEnabled) {
 
 namespace {
 
+// The values are only appended, a delta is the values since the previous dump
+struct AppendOnlyEntity final : public dump::DumpableEntity {
+  void GetAndWrite(dump::Writer& writer) const override {
+    writer.Write(values);
+    dumped_count = values.size();
+    ++write_count;
+  }
+
+  void ReadAndSet(dump::Reader& reader) override {
+    values = reader.Read<std::vector<int>>();
+    dumped_count = values.size();
+  }
+
+  void GetAndWriteDelta(dump::Writer& writer) const override {
+    writer.Write(std::vector<int>(values.begin() + dumped_count, values.end()));
+    dumped_count = values.size();
+    ++delta_write_count;
+  }
+
+  void ReadAndApplyDelta(dump::Reader& reader) override {
+    const auto delta = reader.Read<std::vector<int>>();
+    values.insert(values.end(), delta.begin(), delta.end());
+    dumped_count = values.size();
+  }
+
+  std::vector<int> values;
+  mutable std::size_t dumped_count{0};
+  mutable int write_count{0};
+  mutable int delta_write_count{0};
+};
+
+}  // namespace
+
+UTEST(Dumper, Differential) {
+  const auto root = fs::blocking::TempDirectory::Create();
+  const auto config = dump::ConfigFromYaml(
+      kConfig + "differential: true\nmax-deltas: 2\n", root, "append-only");
+  testsuite::DumpControl control{
+      testsuite::DumpControl::PeriodicsMode::kDisabled};
+  utils::statistics::Storage statistics_storage;
+  dynamic_config::StorageMock config_storage{{dump::kConfigSet, {}}};
+
+  const auto make_dumper = [&](AppendOnlyEntity& entity) {
+    return dump::Dumper{
+        config,
+        dump::CreateDefaultOperationsFactory(config),
+        engine::current_task::GetTaskProcessor(),
+        config_storage.GetSource(),
+        statistics_storage,
+        control,
+        entity,
+    };
+  };
+
+  utils::datetime::MockNowSet({});
+  AppendOnlyEntity written;
+  {
+    auto dumper = make_dumper(written);
+    dumper.ReadDump();
+    for (int i = 0; i < 5; ++i) {
+      utils::datetime::MockSleep(1s);
+      written.values.push_back(i);
+      dumper.OnUpdateCompleted(Now(), dump::UpdateType::kModified);
+      dumper.WriteDumpSyncDebug();
+    }
+  }
+  // A full dump, 2 deltas, a full dump again and a delta
+  EXPECT_EQ(written.write_count, 2);
+  EXPECT_EQ(written.delta_write_count, 3);
+
+  AppendOnlyEntity read;
+  auto dumper = make_dumper(read);
+  EXPECT_EQ(dumper.ReadDump(), Now());
+  EXPECT_EQ(read.values, written.values);
+
+  // The next dump extends the deltas that have been read
+  utils::datetime::MockSleep(1s);
+  read.values.push_back(5);
+  dumper.OnUpdateCompleted(Now(), dump::UpdateType::kModified);
+  dumper.WriteDumpSyncDebug();
+  EXPECT_EQ(read.write_count, 0);
+  EXPECT_EQ(read.delta_write_count, 1);
+}
+
+UTEST(Dumper, DifferentialFallbackToFull) {
+  const auto root = fs::blocking::TempDirectory::Create();
+  const auto config = dump::ConfigFromYaml(
+      kConfig + "differential: true\nmax-deltas: 2\n", root, "dummy");
+  testsuite::DumpControl control{
+      testsuite::DumpControl::PeriodicsMode::kDisabled};
+  utils::statistics::Storage statistics_storage;
+  dynamic_config::StorageMock config_storage{{dump::kConfigSet, {}}};
+
+  const auto make_dumper = [&](DummyEntity& entity) {
+    return dump::Dumper{
+        config,
+        dump::CreateDefaultOperationsFactory(config),
+        engine::current_task::GetTaskProcessor(),
+        config_storage.GetSource(),
+        statistics_storage,
+        control,
+        entity,
+    };
+  };
+
+  utils::datetime::MockNowSet({});
+  DummyEntity written;
+  {
+    auto dumper = make_dumper(written);
+    dumper.ReadDump();
+    for (int i = 1; i <= 3; ++i) {
+      utils::datetime::MockSleep(1s);
+      written.value = i;
+      dumper.OnUpdateCompleted(Now(), dump::UpdateType::kModified);
+      dumper.WriteDumpSyncDebug();
+    }
+  }
+  // Without delta support, each delta holds the whole entity
+  EXPECT_EQ(written.write_count, 3);
+
+  DummyEntity read;
+  auto dumper = make_dumper(read);
+  EXPECT_EQ(dumper.ReadDump(), Now());
+  EXPECT_EQ(read.value, 3);
+}
+
+namespace {
+
 /// [Sample Dumper usage]
 // NOLINTNEXTLINE(fuchsia-multiple-inheritance)
 class SampleComponentWithDumps final : public components::LoggableComponentBase,
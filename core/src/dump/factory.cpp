@@ -1,8 +1,10 @@
 #include <userver/dump/factory.hpp>
 
 #include <dump/secdist.hpp>
+#include <userver/dump/operations_compressed.hpp>
 #include <userver/dump/operations_encrypted.hpp>
 #include <userver/dump/operations_file.hpp>
+#include <userver/dump/operations_mapped.hpp>
 #include <userver/storages/secdist/component.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,26 +21,43 @@ boost::filesystem::perms GetPerms(const Config& config) {
     return perms::owner_read;
 }
 
+std::unique_ptr<dump::OperationsFactory> WrapCompression(
+    std::unique_ptr<dump::OperationsFactory> factory, const Config& config) {
+  if (!config.dump_is_compressed) return factory;
+  // The data is compressed before the encryption, encrypted data is not
+  // compressible
+  return std::make_unique<dump::CompressedOperationsFactory>(
+      std::move(factory), config.compression_level);
+}
+
 }  // namespace
 
 std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
     const Config& config, const components::ComponentContext& context) {
   auto dump_perms = GetPerms(config);
 
-  if (config.dump_is_encrypted) {
+  if (config.dump_is_memory_mapped) {
+    return std::make_unique<dump::MappedOperationsFactory>(dump_perms);
+  } else if (config.dump_is_encrypted) {
     const auto& secdist = context.FindComponent<components::Secdist>().Get();
     auto secret_key = secdist.Get<dump::Secdist>().GetSecretKey(config.name);
-    return std::make_unique<dump::EncryptedOperationsFactory>(
-        std::move(secret_key), dump_perms);
+    return WrapCompression(std::make_unique<dump::EncryptedOperationsFactory>(
+                               std::move(secret_key), dump_perms),
+                           config);
   } else {
-    return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+    return WrapCompression(
+        std::make_unique<dump::FileOperationsFactory>(dump_perms), config);
   }
 }
 
 std::unique_ptr<dump::OperationsFactory> CreateDefaultOperationsFactory(
     const Config& config) {
   auto dump_perms = GetPerms(config);
-  return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+  if (config.dump_is_memory_mapped) {
+    return std::make_unique<dump::MappedOperationsFactory>(dump_perms);
+  }
+  return WrapCompression(
+      std::make_unique<dump::FileOperationsFactory>(dump_perms), config);
 }
 
 }  // namespace dump
@@ -0,0 +1,80 @@
+#include <userver/dump/mapped_containers.hpp>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations_mapped.hpp>
+#include <userver/dump/unsafe.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace impl {
+
+PinnedBytes MakePinnedBytes(std::string&& bytes) {
+  auto owner = std::make_shared<const std::string>(std::move(bytes));
+  const std::string_view view = *owner;
+  return {view, std::move(owner)};
+}
+
+PinnedBytes ReadPinnedBytes(Reader& reader) {
+  const auto bytes = ReadStringViewUnsafe(reader);
+  if (auto* const mapped_reader = dynamic_cast<MappedReader*>(&reader)) {
+    // The bytes point into the mapping, no copy is needed
+    return {bytes, mapped_reader->GetMapping()};
+  }
+  return MakePinnedBytes(std::string{bytes});
+}
+
+void WritePinnedBytes(Writer& writer, std::string_view bytes) {
+  writer.Write(bytes);
+}
+
+}  // namespace impl
+
+namespace {
+
+std::vector<std::uint64_t> MakeEnds(const std::vector<std::string>& values) {
+  std::vector<std::uint64_t> ends;
+  ends.reserve(values.size());
+  std::uint64_t end = 0;
+  for (const auto& value : values) {
+    end += value.size();
+    ends.push_back(end);
+  }
+  return ends;
+}
+
+std::string MakeChars(const std::vector<std::string>& values) {
+  std::string chars;
+  for (const auto& value : values) chars += value;
+  return chars;
+}
+
+}  // namespace
+
+MappedStringArray::MappedStringArray(const std::vector<std::string>& values)
+    : ends_(MakeEnds(values)),
+      chars_(impl::MakePinnedBytes(MakeChars(values))) {}
+
+MappedStringArray::MappedStringArray(MappedArray<std::uint64_t>&& ends,
+                                     impl::PinnedBytes&& chars)
+    : ends_(std::move(ends)), chars_(std::move(chars)) {
+  if (!ends_.empty() && ends_[ends_.size() - 1] != chars_.bytes.size()) {
+    throw Error("Unexpected size of the MappedStringArray data");
+  }
+}
+
+void Write(Writer& writer, const MappedStringArray& value) {
+  writer.Write(value.GetEnds());
+  impl::WritePinnedBytes(writer, value.GetChars());
+}
+
+MappedStringArray Read(Reader& reader, To<MappedStringArray>) {
+  auto ends = reader.Read<MappedArray<std::uint64_t>>();
+  auto chars = impl::ReadPinnedBytes(reader);
+  return MappedStringArray{std::move(ends), std::move(chars)};
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
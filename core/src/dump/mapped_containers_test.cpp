@@ -0,0 +1,117 @@
+#include <userver/utest/utest.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/mapped_containers.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/dump/operations_mapped.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr auto kPerms = boost::filesystem::perms::owner_read;
+
+struct Point final {
+  std::int32_t x;
+  double y;
+};
+
+std::string WriteTestDump(const fs::blocking::TempDirectory& dir) {
+  const auto path = dir.GetPath() + "/dump";
+
+  std::vector<Point> points;
+  std::vector<std::string> names;
+  for (int i = 0; i < 1000; ++i) {
+    points.push_back({i, i * 0.5});
+    names.push_back(std::string(i % 10, 'a'));
+  }
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, kPerms, scope_time);
+  writer.Write(dump::MappedArray<Point>{points});
+  writer.Write(dump::MappedStringArray{names});
+  writer.Finish();
+
+  return path;
+}
+
+void CheckContents(const dump::MappedArray<Point>& points,
+                   const dump::MappedStringArray& names) {
+  ASSERT_EQ(points.size(), 1000);
+  ASSERT_EQ(names.size(), 1000);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(points[i].x, i);
+    EXPECT_EQ(points[i].y, i * 0.5);
+    EXPECT_EQ(names[i], std::string(i % 10, 'a'));
+  }
+}
+
+}  // namespace
+
+UTEST(DumpMappedContainers, ReadInPlace) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = WriteTestDump(dir);
+
+  std::optional<dump::MappedArray<Point>> points;
+  std::optional<dump::MappedStringArray> names;
+  {
+    dump::MappedReader reader(path);
+    points = reader.Read<dump::MappedArray<Point>>();
+    names = reader.Read<dump::MappedStringArray>();
+    UEXPECT_NO_THROW(reader.Finish());
+
+    // The data is not copied out of the mapping
+    const auto mapped = reader.GetMapping()->GetView();
+    EXPECT_GE(points->GetBytes().data(), mapped.data());
+    EXPECT_LT(points->GetBytes().data(), mapped.data() + mapped.size());
+  }
+
+  // The containers keep the mapping alive after the reader is destroyed
+  CheckContents(*points, *names);
+}
+
+UTEST(DumpMappedContainers, ReadCopy) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = WriteTestDump(dir);
+
+  dump::FileReader reader(path);
+  const auto points = reader.Read<dump::MappedArray<Point>>();
+  const auto names = reader.Read<dump::MappedStringArray>();
+  UEXPECT_NO_THROW(reader.Finish());
+
+  CheckContents(points, names);
+}
+
+UTEST(DumpMappedContainers, UnreadData) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = WriteTestDump(dir);
+
+  dump::MappedReader reader(path);
+  EXPECT_EQ(reader.Read<dump::MappedArray<Point>>().size(), 1000);
+  UEXPECT_THROW(reader.Finish(), dump::Error);
+}
+
+UTEST(DumpMappedContainers, Empty) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/dump";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, kPerms, scope_time);
+  writer.Write(dump::MappedStringArray{});
+  writer.Finish();
+
+  dump::MappedReader reader(path);
+  EXPECT_TRUE(reader.Read<dump::MappedStringArray>().empty());
+  UEXPECT_NO_THROW(reader.Finish());
+}
+
+USERVER_NAMESPACE_END
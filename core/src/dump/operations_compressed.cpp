@@ -0,0 +1,194 @@
+#include <userver/dump/operations_compressed.hpp>
+
+#include <limits>
+#include <utility>
+
+#include <fmt/format.h>
+#include <zlib.h>
+
+#include <userver/dump/unsafe.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace {
+
+// 15 is the maximum window size, +16 selects the gzip header and trailer, so
+// that the dumps could be inspected with the standard tools
+constexpr int kGzipWindowBits = 15 + 16;
+constexpr int kMemLevel = 8;
+
+// Size of the compressed data passed to and read from the base Writer/Reader
+constexpr std::size_t kChunkSize = 256 * 1024;
+
+Bytef* ToBytes(char* data) { return reinterpret_cast<Bytef*>(data); }
+
+Bytef* ToBytes(const char* data) {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  return reinterpret_cast<Bytef*>(const_cast<char*>(data));
+}
+
+uInt ToSize(std::size_t size) {
+  UASSERT(size <= std::numeric_limits<uInt>::max());
+  return static_cast<uInt>(size);
+}
+
+}  // namespace
+
+struct CompressedWriter::Impl {
+  explicit Impl(std::unique_ptr<Writer>&& base) : base(std::move(base)) {
+    UINVARIANT(this->base, "Base writer must not be null");
+    buffer.resize(kChunkSize);
+  }
+
+  ~Impl() { deflateEnd(&stream); }
+
+  // Sends the compressed data to the base writer whenever the buffer fills up
+  void Deflate(int flush) {
+    while (true) {
+      if (stream.avail_out == 0) {
+        WriteStringViewUnsafe(*base, buffer);
+        stream.next_out = ToBytes(buffer.data());
+        stream.avail_out = ToSize(buffer.size());
+      }
+
+      const auto ret = deflate(&stream, flush);
+      if (ret == Z_STREAM_ERROR) {
+        throw Error("Failed to compress the dump");
+      }
+
+      // The rest of the output is kept in the buffer
+      const bool is_done = (flush == Z_FINISH) ? (ret == Z_STREAM_END)
+                                               : (stream.avail_in == 0);
+      if (is_done) return;
+    }
+  }
+
+  std::unique_ptr<Writer> base;
+  z_stream stream{};
+  std::string buffer;
+};
+
+CompressedWriter::CompressedWriter(std::unique_ptr<Writer> base, int level)
+    : impl_(std::move(base)) {
+  auto& stream = impl_->stream;
+  const auto ret = deflateInit2(&stream, level, Z_DEFLATED, kGzipWindowBits,
+                                kMemLevel, Z_DEFAULT_STRATEGY);
+  if (ret != Z_OK) {
+    throw Error(fmt::format(
+        "Failed to initialize the dump compression with level {}", level));
+  }
+  stream.next_out = ToBytes(impl_->buffer.data());
+  stream.avail_out = ToSize(impl_->buffer.size());
+}
+
+CompressedWriter::~CompressedWriter() = default;
+
+void CompressedWriter::WriteRaw(std::string_view data) {
+  auto& stream = impl_->stream;
+  stream.next_in = ToBytes(data.data());
+  stream.avail_in = ToSize(data.size());
+  impl_->Deflate(Z_NO_FLUSH);
+}
+
+void CompressedWriter::Finish() {
+  auto& stream = impl_->stream;
+  stream.next_in = nullptr;
+  stream.avail_in = 0;
+  impl_->Deflate(Z_FINISH);
+
+  const auto size = impl_->buffer.size() - stream.avail_out;
+  WriteStringViewUnsafe(*impl_->base,
+                        std::string_view{impl_->buffer.data(), size});
+  impl_->base->Finish();
+}
+
+struct CompressedReader::Impl {
+  explicit Impl(std::unique_ptr<Reader>&& base) : base(std::move(base)) {
+    UINVARIANT(this->base, "Base reader must not be null");
+  }
+
+  ~Impl() { inflateEnd(&stream); }
+
+  std::unique_ptr<Reader> base;
+  z_stream stream{};
+  std::string curr_chunk;
+  bool is_stream_end{false};
+};
+
+CompressedReader::CompressedReader(std::unique_ptr<Reader> base)
+    : impl_(std::move(base)) {
+  if (inflateInit2(&impl_->stream, kGzipWindowBits) != Z_OK) {
+    throw Error("Failed to initialize the dump decompression");
+  }
+}
+
+CompressedReader::~CompressedReader() = default;
+
+std::string_view CompressedReader::ReadRaw(std::size_t max_size) {
+  auto& stream = impl_->stream;
+  auto& chunk = impl_->curr_chunk;
+
+  // the storage of curr_chunk is reused between ReadRaw calls, as in
+  // FileReader
+  if (chunk.size() < max_size) chunk.resize(max_size);
+  stream.next_out = ToBytes(chunk.data());
+  stream.avail_out = ToSize(max_size);
+
+  while (stream.avail_out != 0 && !impl_->is_stream_end) {
+    if (stream.avail_in == 0) {
+      // The data returned by the base reader stays valid until the next
+      // ReadRaw call on it, and it is only called once the data is consumed
+      const auto compressed = ReadUnsafeAtMost(*impl_->base, kChunkSize);
+      if (compressed.empty()) {
+        throw Error("Unexpected end of the compressed dump");
+      }
+      stream.next_in = ToBytes(compressed.data());
+      stream.avail_in = ToSize(compressed.size());
+    }
+
+    const auto ret = inflate(&stream, Z_NO_FLUSH);
+    if (ret == Z_STREAM_END) {
+      impl_->is_stream_end = true;
+    } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      throw Error(fmt::format("Failed to decompress the dump: {}",
+                              stream.msg ? stream.msg : "unknown error"));
+    }
+  }
+
+  return {chunk.data(), max_size - stream.avail_out};
+}
+
+void CompressedReader::Finish() {
+  if (!impl_->is_stream_end && !ReadRaw(1).empty()) {
+    throw Error("Unexpected extra data at the end of the compressed dump");
+  }
+  if (impl_->stream.avail_in != 0) {
+    throw Error("Unexpected extra data after the compressed dump");
+  }
+  impl_->base->Finish();
+}
+
+CompressedOperationsFactory::CompressedOperationsFactory(
+    std::unique_ptr<OperationsFactory> base, int level)
+    : base_(std::move(base)), level_(level) {
+  UINVARIANT(base_, "Base operations factory must not be null");
+}
+
+std::unique_ptr<Reader> CompressedOperationsFactory::CreateReader(
+    std::string full_path) {
+  return std::make_unique<CompressedReader>(
+      base_->CreateReader(std::move(full_path)));
+}
+
+std::unique_ptr<Writer> CompressedOperationsFactory::CreateWriter(
+    std::string full_path, tracing::ScopeTime& scope) {
+  return std::make_unique<CompressedWriter>(
+      base_->CreateWriter(std::move(full_path), scope), level_);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
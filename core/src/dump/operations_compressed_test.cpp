@@ -0,0 +1,115 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations_compressed.hpp>
+#include <userver/dump/operations_encrypted.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr auto kPerms = boost::filesystem::perms::owner_read;
+constexpr int kLevel = 1;
+constexpr int kValuesCount = 100'000;
+
+std::string DumpFilePath(const fs::blocking::TempDirectory& dir) {
+  return dir.GetPath() + "/dump";
+}
+
+void WriteValues(dump::Writer& writer) {
+  for (int i = 0; i < kValuesCount; ++i) {
+    writer.Write(i);
+    writer.Write(std::string{"value"});
+  }
+  UEXPECT_NO_THROW(writer.Finish());
+}
+
+void ReadValues(dump::Reader& reader) {
+  for (int i = 0; i < kValuesCount; ++i) {
+    ASSERT_EQ(reader.Read<int>(), i);
+    ASSERT_EQ(reader.Read<std::string>(), "value");
+  }
+}
+
+}  // namespace
+
+UTEST(DumpOperationsCompressed, WriteRead) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  dump::CompressedOperationsFactory factory{
+      std::make_unique<dump::FileOperationsFactory>(kPerms), kLevel};
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  WriteValues(*factory.CreateWriter(path, scope_time));
+
+  // The data is repetitive, so it must be compressed well
+  EXPECT_LT(boost::filesystem::file_size(path), kValuesCount * sizeof(int));
+
+  const auto reader = factory.CreateReader(path);
+  ReadValues(*reader);
+  UEXPECT_THROW(reader->Read<int>(), dump::Error);
+  UEXPECT_NO_THROW(reader->Finish());
+}
+
+UTEST(DumpOperationsCompressed, Encrypted) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  dump::CompressedOperationsFactory factory{
+      std::make_unique<dump::EncryptedOperationsFactory>(
+          dump::SecretKey{"12345678901234567890123456789012"}, kPerms),
+      kLevel};
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  WriteValues(*factory.CreateWriter(path, scope_time));
+
+  const auto reader = factory.CreateReader(path);
+  ReadValues(*reader);
+  UEXPECT_NO_THROW(reader->Finish());
+}
+
+UTEST(DumpOperationsCompressed, UnreadData) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  dump::CompressedOperationsFactory factory{
+      std::make_unique<dump::FileOperationsFactory>(kPerms), kLevel};
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  WriteValues(*factory.CreateWriter(path, scope_time));
+
+  const auto reader = factory.CreateReader(path);
+  EXPECT_EQ(reader->Read<int>(), 0);
+  UEXPECT_THROW(reader->Finish(), dump::Error);
+}
+
+UTEST(DumpOperationsCompressed, Truncated) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  dump::CompressedOperationsFactory factory{
+      std::make_unique<dump::FileOperationsFactory>(kPerms), kLevel};
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  WriteValues(*factory.CreateWriter(path, scope_time));
+
+  auto contents = fs::blocking::ReadFileContents(path);
+  contents.resize(contents.size() / 2);
+  boost::filesystem::remove(path);
+  fs::blocking::RewriteFileContents(path, contents);
+
+  const auto reader = factory.CreateReader(path);
+  UEXPECT_THROW(ReadValues(*reader), dump::Error);
+}
+
+USERVER_NAMESPACE_END
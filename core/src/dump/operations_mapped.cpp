@@ -0,0 +1,64 @@
+#include <userver/dump/operations_mapped.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/dump/operations_file.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+MappedReader::MappedReader(std::string path) : path_(std::move(path)) {
+  try {
+    file_ = std::make_shared<const fs::blocking::MappedFile>(
+        fs::blocking::MappedFile::Open(path_));
+  } catch (const std::exception& ex) {
+    throw Error(
+        fmt::format("Failed to map the dump file \"{}\". Reason: {}", path_,
+                    ex.what()));
+  }
+}
+
+std::string_view MappedReader::ReadRaw(std::size_t max_size) {
+  const auto view = file_->GetView();
+  const auto size = std::min(max_size, view.size() - position_);
+  const auto result = view.substr(position_, size);
+  position_ += size;
+  return result;
+}
+
+void MappedReader::Finish() {
+  const auto file_size = file_->GetSize();
+  if (position_ != file_size) {
+    throw Error(
+        fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
+                    "file-size={}, position={}, unread-size={}",
+                    path_, file_size, position_, file_size - position_));
+  }
+}
+
+std::shared_ptr<const fs::blocking::MappedFile> MappedReader::GetMapping()
+    const {
+  return file_;
+}
+
+MappedOperationsFactory::MappedOperationsFactory(
+    boost::filesystem::perms perms)
+    : perms_(perms) {}
+
+std::unique_ptr<Reader> MappedOperationsFactory::CreateReader(
+    std::string full_path) {
+  return std::make_unique<MappedReader>(std::move(full_path));
+}
+
+std::unique_ptr<Writer> MappedOperationsFactory::CreateWriter(
+    std::string full_path, tracing::ScopeTime& scope) {
+  return std::make_unique<FileWriter>(std::move(full_path), perms_, scope);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
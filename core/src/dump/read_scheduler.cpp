@@ -0,0 +1,74 @@
+#include <dump/read_scheduler.hpp>
+
+#include <utility>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+ReadScheduler::Slot::Slot(ReadScheduler& scheduler) noexcept
+    : scheduler_(&scheduler) {}
+
+ReadScheduler::Slot::Slot(Slot&& other) noexcept
+    : scheduler_(std::exchange(other.scheduler_, nullptr)) {}
+
+ReadScheduler::Slot& ReadScheduler::Slot::operator=(Slot&& other) noexcept {
+  if (this != &other) {
+    if (scheduler_) scheduler_->Release();
+    scheduler_ = std::exchange(other.scheduler_, nullptr);
+  }
+  return *this;
+}
+
+ReadScheduler::Slot::~Slot() {
+  if (scheduler_) scheduler_->Release();
+}
+
+ReadScheduler::ReadScheduler(std::size_t max_concurrent_reads)
+    : max_concurrent_reads_(max_concurrent_reads) {}
+
+ReadScheduler::Slot ReadScheduler::Acquire(std::uint64_t dump_size) {
+  std::unique_lock lock(mutex_);
+  if (max_concurrent_reads_ == 0) {
+    ++active_reads_;
+    return Slot{*this};
+  }
+
+  const auto ticket = pending_.insert(Ticket{dump_size, next_ticket_++}).first;
+  const bool ok = cv_.Wait(lock, [&] {
+    return active_reads_ < max_concurrent_reads_ && ticket == pending_.begin();
+  });
+  pending_.erase(ticket);
+
+  if (!ok) {
+    // Someone else may be next in line now
+    cv_.NotifyAll();
+    throw engine::WaitInterruptedException(
+        engine::current_task::CancellationReason());
+  }
+
+  ++active_reads_;
+  if (active_reads_ < max_concurrent_reads_ && !pending_.empty()) {
+    cv_.NotifyAll();
+  }
+  return Slot{*this};
+}
+
+std::size_t ReadScheduler::GetMaxConcurrentReads() const noexcept {
+  return max_concurrent_reads_;
+}
+
+void ReadScheduler::Release() noexcept {
+  {
+    std::lock_guard lock(mutex_);
+    --active_reads_;
+  }
+  cv_.NotifyAll();
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
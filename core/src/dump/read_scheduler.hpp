@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief Limits the number of dumps that are read concurrently and hands out
+/// the free slots to the largest pending dumps first.
+///
+/// All the caches try to load their dumps at once at service startup. Reading
+/// all of them in parallel only makes them compete for the disk, while
+/// starting the largest dumps first shortens the total loading time.
+/// @note The class is thread-safe
+class ReadScheduler final {
+ public:
+  /// Releases the read slot on destruction
+  class Slot final {
+   public:
+    Slot() noexcept = default;
+    Slot(Slot&&) noexcept;
+    Slot& operator=(Slot&&) noexcept;
+    ~Slot();
+
+   private:
+    friend class ReadScheduler;
+
+    explicit Slot(ReadScheduler& scheduler) noexcept;
+
+    ReadScheduler* scheduler_{nullptr};
+  };
+
+  /// @param max_concurrent_reads 0 means no limit
+  explicit ReadScheduler(std::size_t max_concurrent_reads);
+
+  ReadScheduler(ReadScheduler&&) = delete;
+  ReadScheduler& operator=(ReadScheduler&&) = delete;
+
+  /// @brief Waits until the dump of `dump_size` bytes may be read
+  /// @throws engine::WaitInterruptedException on task cancellation
+  Slot Acquire(std::uint64_t dump_size);
+
+  std::size_t GetMaxConcurrentReads() const noexcept;
+
+ private:
+  struct Ticket final {
+    std::uint64_t dump_size;
+    std::uint64_t order;
+  };
+
+  // The largest dumps come first, equal ones are served in the arrival order
+  struct TicketPriority final {
+    bool operator()(const Ticket& lhs, const Ticket& rhs) const noexcept {
+      if (lhs.dump_size != rhs.dump_size) return lhs.dump_size > rhs.dump_size;
+      return lhs.order < rhs.order;
+    }
+  };
+
+  void Release() noexcept;
+
+  const std::size_t max_concurrent_reads_;
+  engine::Mutex mutex_;
+  engine::ConditionVariable cv_;
+  std::set<Ticket, TicketPriority> pending_;
+  std::uint64_t next_ticket_{0};
+  std::size_t active_reads_{0};
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,91 @@
+#include <dump/read_scheduler.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+void YieldMany() {
+  for (int i = 0; i < 10; ++i) engine::Yield();
+}
+
+}  // namespace
+
+UTEST(DumpReadScheduler, LargestFirst) {
+  dump::ReadScheduler scheduler{1};
+  std::vector<std::uint64_t> order;
+
+  auto first_slot = scheduler.Acquire(0);
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (const std::uint64_t size : {10, 30, 20, 30}) {
+    tasks.push_back(engine::AsyncNoSpan([&, size] {
+      const auto slot = scheduler.Acquire(size);
+      order.push_back(size);
+    }));
+    YieldMany();
+  }
+  EXPECT_TRUE(order.empty());
+
+  first_slot = {};
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(order, (std::vector<std::uint64_t>{30, 30, 20, 10}));
+}
+
+UTEST_MT(DumpReadScheduler, ConcurrencyLimit, 4) {
+  constexpr std::size_t kMaxReads = 2;
+  dump::ReadScheduler scheduler{kMaxReads};
+  std::atomic<std::size_t> active{0};
+  std::atomic<std::size_t> max_active{0};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::uint64_t size = 0; size < 20; ++size) {
+    tasks.push_back(engine::AsyncNoSpan([&, size] {
+      const auto slot = scheduler.Acquire(size);
+      const auto current = ++active;
+      auto max = max_active.load();
+      while (max < current &&
+             !max_active.compare_exchange_weak(max, current)) {
+      }
+      YieldMany();
+      --active;
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_LE(max_active.load(), kMaxReads);
+  EXPECT_GT(max_active.load(), 0);
+}
+
+UTEST(DumpReadScheduler, Unlimited) {
+  dump::ReadScheduler scheduler{0};
+  auto first = scheduler.Acquire(1);
+  auto second = scheduler.Acquire(2);
+  auto third = scheduler.Acquire(3);
+  SUCCEED();
+}
+
+UTEST(DumpReadScheduler, Cancellation) {
+  dump::ReadScheduler scheduler{1};
+  auto slot = scheduler.Acquire(1);
+
+  auto waiter = engine::AsyncNoSpan([&] { return scheduler.Acquire(2); });
+  YieldMany();
+  waiter.SyncCancel();
+
+  auto next = engine::AsyncNoSpan([&] { return scheduler.Acquire(3); });
+  YieldMany();
+  slot = {};
+  UEXPECT_NO_THROW(next.Get());
+}
+
+USERVER_NAMESPACE_END
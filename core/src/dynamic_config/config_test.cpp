@@ -1,12 +1,18 @@
 #include <userver/utest/utest.hpp>
 
+#include <atomic>
 #include <vector>
 
+#include <userver/dynamic_config/impl/snapshot.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/dynamic_config/source.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
 #include <userver/dynamic_config/test_helpers.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
 
 using namespace std::chrono_literals;
 
@@ -193,6 +199,53 @@ UTEST(DynamicConfig, Extend) {
   EXPECT_EQ(config[kDummyConfig].foo, 42);
 }
 
+UTEST(DynamicConfig, SnapshotsFollowUpdates) {
+  dynamic_config::StorageMock storage{{kIntConfig, 1}};
+  const auto source = storage.GetSource();
+
+  const auto old_snapshot = source.GetSnapshot();
+  EXPECT_EQ(source.GetCopy(kIntConfig), 1);
+
+  storage.Extend({{kIntConfig, 2}});
+  EXPECT_EQ(source.GetCopy(kIntConfig), 2);
+  const auto new_snapshot = source.GetSnapshot();
+  EXPECT_EQ(new_snapshot[kIntConfig], 2);
+  EXPECT_EQ(old_snapshot[kIntConfig], 1);
+
+  // The cached snapshot of another storage is not reused
+  const dynamic_config::StorageMock other_storage{{kIntConfig, 3}};
+  EXPECT_EQ(other_storage.GetSource().GetCopy(kIntConfig), 3);
+  EXPECT_EQ(source.GetCopy(kIntConfig), 2);
+}
+
+UTEST_MT(DynamicConfig, ConcurrentReadsAndUpdates, 4) {
+  dynamic_config::StorageMock storage{{kIntConfig, 0}};
+  const auto source = storage.GetSource();
+  std::atomic<bool> keep_running{true};
+
+  std::vector<engine::TaskWithResult<void>> readers;
+  for (int i = 0; i < 3; ++i) {
+    readers.push_back(engine::AsyncNoSpan([&] {
+      int previous = 0;
+      while (keep_running) {
+        const auto current = source.GetCopy(kIntConfig);
+        ASSERT_GE(current, previous);
+        previous = current;
+      }
+    }));
+  }
+
+  constexpr int kUpdates = 100;
+  for (int i = 1; i <= kUpdates; ++i) {
+    storage.Extend({{kIntConfig, i}});
+    engine::Yield();
+  }
+  keep_running = false;
+  for (auto& reader : readers) reader.Get();
+
+  EXPECT_EQ(source.GetCopy(kIntConfig), kUpdates);
+}
+
 /// [StorageMock from JSON]
 const auto kJson = formats::json::FromString(R"( {"foo": 42, "bar": "what"} )");
 
@@ -388,6 +441,60 @@ UTEST(DynamicConfig, SubsetSubscription) {
   EXPECT_EQ(subscribers[1].GetCounter(), 3);
 }
 
+UTEST(DynamicConfig, SubsetSubscriptionWithoutEquality) {
+  dynamic_config::StorageMock storage{
+      {kSampleStructConfig, {true, 1s}},
+      {kIntConfig, 1},
+  };
+  auto source = storage.GetSource();
+  Subscriber subscriber;
+  auto scope = source.UpdateAndListen(
+      &subscriber, "", &Subscriber::OnConfigUpdate, kSampleStructConfig);
+  EXPECT_EQ(subscriber.GetCounter(), 1);
+
+  // The unchanged config is shared with the previous snapshot
+  storage.Extend({{kIntConfig, 2}});
+  EXPECT_EQ(subscriber.GetCounter(), 1);
+
+  storage.Extend({{kSampleStructConfig, {false, 1s}}});
+  EXPECT_EQ(subscriber.GetCounter(), 2);
+}
+
+const dynamic_config::Key<int> kSampleIntConfig{"SAMPLE_INT_CONFIG", 1};
+
+UTEST(DynamicConfig, UnchangedDocsAreNotParsed) {
+  using dynamic_config::impl::ConfigIdGetter;
+  using dynamic_config::impl::SnapshotData;
+  const auto struct_id = ConfigIdGetter::Get(kSampleStructConfig);
+  const auto int_id = ConfigIdGetter::Get(kSampleIntConfig);
+
+  auto docs_map = dynamic_config::impl::MakeDefaultDocsMap();
+  const SnapshotData first{docs_map, nullptr};
+
+  docs_map.Set("SAMPLE_INT_CONFIG",
+               formats::json::ValueBuilder{2}.ExtractValue());
+  const SnapshotData second{docs_map, &first};
+
+  EXPECT_EQ(&first.Get<SampleStructConfig>(struct_id),
+            &second.Get<SampleStructConfig>(struct_id));
+  EXPECT_EQ(first.Get<int>(int_id), 1);
+  EXPECT_EQ(second.Get<int>(int_id), 2);
+
+  // The docs are compared by value
+  docs_map.Set("SAMPLE_STRUCT_CONFIG",
+               formats::json::FromString(
+                   R"({"is_foo_enabled": false, "bar_period_ms": 42000})"));
+  const SnapshotData third{docs_map, &second};
+  EXPECT_EQ(&second.Get<SampleStructConfig>(struct_id),
+            &third.Get<SampleStructConfig>(struct_id));
+
+  docs_map.Set("SAMPLE_STRUCT_CONFIG",
+               formats::json::FromString(
+                   R"({"is_foo_enabled": true, "bar_period_ms": 42000})"));
+  const SnapshotData fourth{docs_map, &third};
+  EXPECT_TRUE(fourth.Get<SampleStructConfig>(struct_id).is_foo_enabled);
+}
+
 class CustomSubscriber final {
  public:
   void OnConfigUpdate(const dynamic_config::Diff&) { counter_++; }
@@ -1,5 +1,8 @@
 #include <userver/dynamic_config/impl/snapshot.hpp>
 
+#include <algorithm>
+#include <optional>
+
 #include <fmt/format.h>
 
 #include <userver/compiler/demangle.hpp>
@@ -8,6 +11,7 @@
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/utils/enumerate.hpp>
 #include <userver/utils/impl/static_registration.hpp>
+#include <utils/internal_tag.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -107,31 +111,60 @@ DocsMap MakeDefaultDocsMap() {
   return result;
 }
 
+struct SnapshotData::ParsedConfig final {
+  std::any value;
+  // The docs the value was parsed from, std::nullopt for a missing doc.
+  // Empty for the overrides.
+  std::vector<std::pair<std::string, std::optional<formats::json::Value>>>
+      docs;
+};
+
+namespace {
+
+class UsedNamesRecorder final {
+ public:
+  UsedNamesRecorder(const DocsMap& docs_map, std::vector<std::string>& names)
+      : docs_map_(docs_map) {
+    docs_map_.SetUsedNamesRecorder(&names, utils::InternalTag{});
+  }
+
+  UsedNamesRecorder(const UsedNamesRecorder&) = delete;
+
+  ~UsedNamesRecorder() {
+    docs_map_.SetUsedNamesRecorder(nullptr, utils::InternalTag{});
+  }
+
+ private:
+  const DocsMap& docs_map_;
+};
+
+template <typename ParsedConfig>
+bool AreDocsUnchanged(const ParsedConfig& parsed, const DocsMap& docs_map) {
+  if (parsed.docs.empty()) return false;
+  for (const auto& [name, doc] : parsed.docs) {
+    if (docs_map.Has(name) != doc.has_value()) return false;
+    // 'Get' also marks the config as used, like the factory would
+    if (doc && docs_map.Get(name) != *doc) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 SnapshotData::SnapshotData(const std::vector<KeyValue>& config_variables) {
   utils::impl::AssertStaticRegistrationFinished();
   user_configs_.resize(Registry().size());
 
   for (const auto& config_variable : config_variables) {
-    user_configs_[config_variable.GetId()] = config_variable.GetValue();
+    user_configs_[config_variable.GetId()] = std::make_shared<ParsedConfig>(
+        ParsedConfig{config_variable.GetValue(), {}});
   }
 }
 
 SnapshotData::SnapshotData(const DocsMap& defaults,
                            const std::vector<KeyValue>& overrides)
     : SnapshotData(overrides) {
-  utils::StreamingCpuRelax relax(1, nullptr);
-  for (const auto [id, metadata] : utils::enumerate(Registry())) {
-    if (!user_configs_[id].has_value()) {
-      relax.Relax(1);
-      try {
-        user_configs_[id] = metadata.factory(defaults);
-      } catch (const std::exception& ex) {
-        throw ConfigParseError(
-            fmt::format("While parsing dynamic config values: {} ({})",
-                        ex.what(), compiler::GetTypeName(typeid(ex))));
-      }
-    }
-  }
+  Parse(defaults, nullptr);
 }
 
 SnapshotData::SnapshotData(const SnapshotData& defaults,
@@ -140,20 +173,67 @@ SnapshotData::SnapshotData(const SnapshotData& defaults,
   if (defaults.IsEmpty()) return;
 
   for (const auto [id, factory] : utils::enumerate(Registry())) {
-    if (user_configs_[id].has_value()) continue;
+    if (user_configs_[id]) continue;
     user_configs_[id] = defaults.user_configs_[id];
   }
 }
 
+SnapshotData::SnapshotData(const DocsMap& docs_map,
+                           const SnapshotData* previous)
+    : SnapshotData(std::vector<KeyValue>{}) {
+  Parse(docs_map, previous && !previous->IsEmpty() ? previous : nullptr);
+}
+
 bool SnapshotData::IsEmpty() const noexcept { return user_configs_.empty(); }
 
 const std::any& SnapshotData::DoGet(ConfigId id) const {
   UASSERT_MSG(id < user_configs_.size(), "SnapshotData is in an empty state.");
   const auto& config = user_configs_[id];
-  if (!config.has_value()) {
+  if (!config || !config->value.has_value()) {
     throw std::logic_error("This type is not registered as config");
   }
-  return config;
+  return config->value;
+}
+
+void SnapshotData::Parse(const DocsMap& docs_map,
+                         const SnapshotData* previous) {
+  utils::StreamingCpuRelax relax(1, nullptr);
+  std::vector<std::string> used_names;
+
+  for (const auto [id, metadata] : utils::enumerate(Registry())) {
+    if (user_configs_[id]) continue;
+
+    if (previous) {
+      const auto& previous_config = previous->user_configs_[id];
+      if (previous_config && AreDocsUnchanged(*previous_config, docs_map)) {
+        user_configs_[id] = previous_config;
+        continue;
+      }
+    }
+
+    relax.Relax(1);
+    auto parsed = std::make_shared<ParsedConfig>();
+    used_names.clear();
+    try {
+      const UsedNamesRecorder recorder{docs_map, used_names};
+      parsed->value = metadata.factory(docs_map);
+    } catch (const std::exception& ex) {
+      throw ConfigParseError(
+          fmt::format("While parsing dynamic config values: {} ({})",
+                      ex.what(), compiler::GetTypeName(typeid(ex))));
+    }
+
+    std::sort(used_names.begin(), used_names.end());
+    used_names.erase(std::unique(used_names.begin(), used_names.end()),
+                     used_names.end());
+    parsed->docs.reserve(used_names.size());
+    for (auto& name : used_names) {
+      auto doc = docs_map.Has(name) ? std::optional{docs_map.Get(name)}
+                                    : std::nullopt;
+      parsed->docs.emplace_back(std::move(name), std::move(doc));
+    }
+    user_configs_[id] = std::move(parsed);
+  }
 }
 
 }  // namespace dynamic_config::impl
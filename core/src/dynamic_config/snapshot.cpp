@@ -1,7 +1,8 @@
 #include <userver/dynamic_config/snapshot.hpp>
 
+#include <memory>
+
 #include <userver/dynamic_config/storage_mock.hpp>
-#include <userver/rcu/rcu.hpp>
 
 #include <dynamic_config/storage_data.hpp>
 
@@ -16,7 +17,7 @@ ConfigDefault::ConfigDefault(std::string_view name,
 struct Snapshot::Impl final {
   explicit Impl(const impl::StorageData& storage) : data_ptr(storage.Read()) {}
 
-  rcu::ReadablePtr<impl::SnapshotData> data_ptr;
+  std::shared_ptr<const impl::SnapshotData> data_ptr;
 };
 
 Snapshot::Snapshot(const Snapshot&) = default;
@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+
+#include <userver/dynamic_config/source.hpp>
+#include <userver/dynamic_config/storage_mock.hpp>
+#include <userver/engine/run_standalone.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+const dynamic_config::Key kIntConfig{dynamic_config::ConstantConfig{}, 0};
+
+}  // namespace
+
+void dynamic_config_get_snapshot(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const dynamic_config::StorageMock storage{{kIntConfig, 42}};
+    const auto source = storage.GetSource();
+
+    for ([[maybe_unused]] auto _ : state) {
+      const auto snapshot = source.GetSnapshot();
+      benchmark::DoNotOptimize(snapshot[kIntConfig]);
+    }
+  });
+}
+BENCHMARK(dynamic_config_get_snapshot);
+
+void dynamic_config_get_copy(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const dynamic_config::StorageMock storage{{kIntConfig, 42}};
+    const auto source = storage.GetSource();
+
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(source.GetCopy(kIntConfig));
+    }
+  });
+}
+BENCHMARK(dynamic_config_get_copy);
+
+USERVER_NAMESPACE_END
@@ -177,7 +177,9 @@ void DynamicConfig::Impl::NotifyLoadingFailed(std::string_view updater,
 dynamic_config::impl::SnapshotData DynamicConfig::Impl::ParseConfig(
     const dynamic_config::DocsMap& value) {
   try {
-    dynamic_config::impl::SnapshotData config(value, {});
+    // The configs with unchanged docs are not parsed again
+    const auto previous = cache_.Read();
+    dynamic_config::impl::SnapshotData config(value, &*previous);
     stats_.was_last_parse_successful = true;
     alert_storage_.StopAlertNow("config_parse_error");
     return config;
@@ -3,6 +3,7 @@
 #include <mutex>
 #include <optional>
 
+#include <userver/compiler/impl/tls.hpp>
 #include <userver/dynamic_config/impl/snapshot.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/dynamic_config/source.hpp>
@@ -11,8 +12,35 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dynamic_config::impl {
 
+namespace {
+
+struct LocalSnapshotCache final {
+  // ensures that the cache was filled by the current StorageData instance
+  std::uint64_t storage_id{0};
+  std::uint64_t version{0};
+  // Aliases a thread-local copy of the shared_ptr from StorageData, so that
+  // copying it does not touch the reference counter shared between threads
+  std::shared_ptr<const SnapshotData> data;
+};
+
+USERVER_IMPL_PREVENT_TLS_CACHING LocalSnapshotCache& GetLocalSnapshotCache() {
+  thread_local LocalSnapshotCache cache;
+
+  // NOLINTNEXTLINE
+  USERVER_IMPL_PREVENT_TLS_CACHING_ASM;
+  return cache;
+}
+
+std::uint64_t GetNextStorageId() noexcept {
+  static std::atomic<std::uint64_t> counter{1};  // 0 is the empty cache
+  return counter++;
+}
+
+}  // namespace
+
 StorageData::StorageData(SnapshotData config)
-    : config_(std::move(config)),
+    : id_(GetNextStorageId()),
+      config_(std::make_shared<const SnapshotData>(std::move(config))),
       snapshot_channel_("dynamic-config-snapshot",
                         [&](auto& func) {
                           const auto snapshot = GetSnapshot();
@@ -27,8 +55,21 @@ StorageData::StorageData(SnapshotData config)
 
 StorageData::StorageData() : StorageData(SnapshotData{}) {}
 
-rcu::ReadablePtr<SnapshotData> StorageData::Read() const {
-  return config_.Read();
+std::shared_ptr<const SnapshotData> StorageData::Read() const {
+  auto& cache = GetLocalSnapshotCache();
+  // acquire is a plain load on x86, it guarantees that config_ is read after
+  // the assignment that the version belongs to
+  const auto version = version_.load(std::memory_order_acquire);
+  if (cache.storage_id != id_ || cache.version != version) {
+    const auto current = config_.Read();
+    auto holder =
+        std::make_shared<const std::shared_ptr<const SnapshotData>>(*current);
+    const auto* data = holder->get();
+    cache.data = std::shared_ptr<const SnapshotData>(std::move(holder), data);
+    cache.storage_id = id_;
+    cache.version = version;
+  }
+  return cache.data;
 }
 
 void StorageData::Update(SnapshotData config,
@@ -42,7 +83,8 @@ void StorageData::Update(SnapshotData config,
       previous_config = std::move(current_config);
   }
 
-  config_.Assign(std::move(config));
+  config_.Assign(std::make_shared<const SnapshotData>(std::move(config)));
+  version_.fetch_add(1, std::memory_order_release);
   after_assign_hook();
 
   const Diff diff{std::move(previous_config), GetSnapshot()};
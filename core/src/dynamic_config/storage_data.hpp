@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
 #include <userver/concurrent/async_event_channel.hpp>
 #include <userver/dynamic_config/impl/snapshot.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
@@ -20,7 +24,12 @@ class StorageData final {
   StorageData();
   explicit StorageData(SnapshotData config);
 
-  rcu::ReadablePtr<SnapshotData> Read() const;
+  /// Returns the current config. The result is cached per thread and is
+  /// revalidated by a single load of the version counter, so that the hot
+  /// readers do not touch the shared rcu::Variable. The cache keeps the
+  /// config that the thread has seen last alive until the next Read() on that
+  /// thread.
+  std::shared_ptr<const SnapshotData> Read() const;
 
   void Update(SnapshotData config, AfterAssignHook after_assign_hook);
 
@@ -37,7 +46,10 @@ class StorageData final {
  private:
   Snapshot GetSnapshot() { return Snapshot{*this}; }
 
-  rcu::Variable<SnapshotData> config_;
+  const std::uint64_t id_;
+  rcu::Variable<std::shared_ptr<const SnapshotData>> config_;
+  // Incremented after each config_ assignment
+  std::atomic<std::uint64_t> version_{0};
   SnapshotChannel snapshot_channel_;
   DiffChannel diff_channel_;
 
@@ -23,11 +23,13 @@ formats::json::Value DocsMap::Get(std::string_view name) const {
   if (used_it != configs_to_be_used_.end()) {
     configs_to_be_used_.erase(used_it);
   }
+  if (used_names_) used_names_->emplace_back(name);
 
   return it->second;
 }
 
 bool DocsMap::Has(std::string_view name) const {
+  if (used_names_) used_names_->emplace_back(name);
   return utils::impl::FindTransparent(docs_, name) != docs_.end();
 }
 
@@ -84,6 +86,11 @@ DocsMap::GetConfigsExpectedToBeUsed(utils::InternalTag) const {
   return configs_to_be_used_;
 }
 
+void DocsMap::SetUsedNamesRecorder(std::vector<std::string>* names,
+                                   utils::InternalTag) const {
+  used_names_ = names;
+}
+
 const std::string kValueDictDefaultName = "__default__";
 
 namespace impl {
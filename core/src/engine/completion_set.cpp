@@ -0,0 +1,38 @@
+#include <userver/engine/completion_set.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+void CompletionQueue::Reserve(std::size_t total) {
+  const std::lock_guard lock{mutex_};
+  if (completed_.capacity() < total) {
+    completed_.reserve(std::max(total, completed_.capacity() * 2));
+  }
+}
+
+void CompletionQueue::Push(std::size_t index) noexcept {
+  {
+    const std::lock_guard lock{mutex_};
+    UASSERT(completed_.size() < completed_.capacity());
+    completed_.push_back(index);
+  }
+  event_.Send();
+}
+
+std::optional<std::size_t> CompletionQueue::WaitPop(Deadline deadline) {
+  while (true) {
+    {
+      const std::lock_guard lock{mutex_};
+      if (head_ < completed_.size()) return completed_[head_++];
+    }
+    if (!event_.WaitForEventUntil(deadline)) return std::nullopt;
+  }
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,104 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+#include <userver/engine/completion_set.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using namespace std::chrono_literals;
+
+UTEST(CompletionSet, Empty) {
+  engine::CompletionSet<int> set;
+  EXPECT_EQ(set.WaitNext(), std::nullopt);
+  EXPECT_EQ(set.Size(), 0U);
+}
+
+UTEST(CompletionSet, CompletionOrder) {
+  constexpr std::size_t kTaskCount = 4;
+  engine::CompletionSet<std::size_t> set;
+  std::vector<engine::SingleConsumerEvent> events(kTaskCount);
+
+  for (std::size_t i = 0; i < kTaskCount; ++i) {
+    const auto index = set.AsyncNoSpan([&events, i] {
+      if (!events[i].WaitForEvent()) throw std::runtime_error("cancelled");
+      return i;
+    });
+    EXPECT_EQ(index, i);
+  }
+  EXPECT_EQ(set.PendingCount(), kTaskCount);
+
+  for (std::size_t i = kTaskCount; i-- > 0;) {
+    events[i].Send();
+    const auto index = set.WaitNext();
+    ASSERT_EQ(index, i);
+    EXPECT_EQ(set.GetTask(*index).Get(), i);
+  }
+  EXPECT_EQ(set.PendingCount(), 0U);
+  EXPECT_EQ(set.WaitNext(), std::nullopt);
+}
+
+UTEST(CompletionSet, Exception) {
+  engine::CompletionSet<void> set;
+  set.AsyncNoSpan([] { throw std::runtime_error("error"); });
+
+  const auto index = set.WaitNext();
+  ASSERT_EQ(index, 0U);
+  EXPECT_THROW(set.GetTask(*index).Get(), std::runtime_error);
+}
+
+UTEST(CompletionSet, Deadline) {
+  engine::CompletionSet<void> set;
+  engine::SingleConsumerEvent event;
+  set.AsyncNoSpan([&event] {
+    [[maybe_unused]] const bool is_sent = event.WaitForEvent();
+  });
+
+  EXPECT_EQ(set.WaitNextUntil(engine::Deadline::FromDuration(10ms)),
+            std::nullopt);
+  EXPECT_EQ(set.PendingCount(), 1U);
+
+  event.Send();
+  EXPECT_EQ(set.WaitNext(), 0U);
+}
+
+UTEST(CompletionSet, Cancellation) {
+  engine::CompletionSet<void> set;
+  engine::SingleConsumerEvent event;
+  set.AsyncNoSpan([&event] {
+    [[maybe_unused]] const bool is_sent = event.WaitForEvent();
+  });
+
+  engine::current_task::GetCancellationToken().RequestCancel();
+  EXPECT_EQ(set.WaitNext(), std::nullopt);
+  EXPECT_EQ(set.PendingCount(), 1U);
+}
+
+UTEST_MT(CompletionSet, Many, 4) {
+  constexpr std::size_t kTaskCount = 1000;
+  engine::CompletionSet<std::size_t> set;
+  for (std::size_t i = 0; i < kTaskCount; ++i) {
+    set.AsyncNoSpan([i] {
+      engine::Yield();
+      return i;
+    });
+  }
+
+  std::vector<bool> completed(kTaskCount, false);
+  for (std::size_t i = 0; i < kTaskCount; ++i) {
+    const auto index = set.WaitNext();
+    ASSERT_TRUE(index);
+    EXPECT_FALSE(completed[*index]);
+    completed[*index] = true;
+    EXPECT_EQ(set.GetTask(*index).Get(), *index);
+  }
+  EXPECT_EQ(set.WaitNext(), std::nullopt);
+}
+
+USERVER_NAMESPACE_END
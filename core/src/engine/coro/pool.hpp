@@ -1,24 +1,36 @@
 #pragma once
 
 #include <algorithm>  // for std::max
+#include <array>
 #include <atomic>
 #include <cerrno>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
+#include <fmt/format.h>
 #include <moodycamel/concurrentqueue.h>
 
 #include <coroutines/coroutine.hpp>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/huge_page_allocator.hpp>
 
 #include "pool_config.hpp"
 #include "pool_stats.hpp"
+#include "stack_usage.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::coro {
 
+inline constexpr std::size_t kMaxStackSizeClasses = 8;
+
 template <typename Task>
 class Pool final {
  public:
@@ -30,78 +42,202 @@ class Pool final {
   Pool(PoolConfig config, Executor executor);
   ~Pool();
 
-  CoroutinePtr GetCoroutine();
-  void PutCoroutine(CoroutinePtr&& coroutine_ptr);
+  /// `stack_size_class` is the result of FindStackSizeClass()
+  CoroutinePtr GetCoroutine(std::size_t stack_size_class);
+  CoroutinePtr GetCoroutine() { return GetCoroutine(default_class_); }
+  void PutCoroutine(CoroutinePtr&& coroutine_ptr,
+                    std::string_view task_kind = {});
   PoolStats GetStats() const;
   std::size_t GetStackSize() const;
 
+  /// The smallest stack size class of at least `stack_size` bytes, or the
+  /// biggest one if none fits. 0 selects the default `stack_size`.
+  std::size_t FindStackSizeClass(std::size_t stack_size) const noexcept;
+
+  /// Stack sizes of the classes in ascending order
+  const std::vector<std::size_t>& GetStackSizes() const noexcept {
+    return stack_sizes_;
+  }
+  PoolStats GetStats(std::size_t stack_size_class) const;
+
+  bool IsStackUsageSampled() const noexcept {
+    return config_.stack_usage_sample_every != 0;
+  }
+  std::vector<StackUsageReportEntry> GetStackUsageReport() const;
+
+  /// Releases to the OS the stacks that stayed idle since the previous call
+  void ReleaseIdleStacks();
+
  private:
-  Coroutine CreateCoroutine(bool quiet = false);
-  void OnCoroutineDestruction() noexcept;
+  struct PooledCoroutine {
+    Coroutine coroutine;
+    StackBounds stack;
+  };
+
+  // Remembers the stack of the coroutine being created
+  class StackAllocator final {
+   public:
+    StackAllocator(std::size_t stack_size, bool huge_pages,
+                   StackBounds& stack) noexcept
+        : allocator_(stack_size), huge_pages_(huge_pages), stack_(&stack) {}
+
+    boost::context::stack_context allocate() {
+      auto context = allocator_.allocate();
+      auto* const top = static_cast<std::byte*>(context.sp);
+      // protected_fixedsize_stack puts a guard page at the bottom
+      *stack_ = {top - context.size +
+                     boost::context::stack_traits::page_size(),
+                 top};
+      if (huge_pages_) {
+        utils::impl::AdviseHugePages(
+            stack_->bottom, static_cast<std::size_t>(top - stack_->bottom));
+      }
+      return context;
+    }
+
+    void deallocate(boost::context::stack_context& context) noexcept {
+      allocator_.deallocate(context);
+    }
+
+   private:
+    boost::coroutines2::protected_fixedsize_stack allocator_;
+    bool huge_pages_;
+    StackBounds* stack_;
+  };
+
+  struct SizeClass {
+    SizeClass(std::size_t index, std::size_t stack_size,
+              std::size_t initial_size, std::size_t max_size)
+        : index(index),
+          stack_size(stack_size),
+          initial_coroutines(initial_size),
+          used_coroutines(max_size),
+          idle_coroutines_num(initial_size) {}
+
+    const std::size_t index;
+    const std::size_t stack_size;
+
+    // We aim to reuse coroutines as much as possible,
+    // because since coroutine stack is a mmap-ed chunk of memory and not
+    // actually an allocated memory we don't want to de-virtualize that memory
+    // excessively.
+    //
+    // The same could've been achieved with some LIFO container, but
+    // apparently we don't have a container handy enough to not just use 2
+    // queues. The stacks released by ReleaseIdleStacks() are moved back into
+    // `initial_coroutines`.
+    moodycamel::ConcurrentQueue<PooledCoroutine> initial_coroutines;
+    moodycamel::ConcurrentQueue<PooledCoroutine> used_coroutines;
+
+    std::atomic<std::size_t> idle_coroutines_num;
+    std::atomic<std::size_t> total_coroutines_num{0};
+    // the lowest `idle_coroutines_num` since the last ReleaseIdleStacks()
+    std::atomic<std::size_t> idle_coroutines_low_watermark{0};
+  };
+
+  struct CoroutineMover {
+    std::optional<PooledCoroutine>& result;
+
+    CoroutineMover& operator=(PooledCoroutine&& coro) {
+      result.emplace(std::move(coro));
+      return *this;
+    }
+  };
+
+  PooledCoroutine CreateCoroutine(SizeClass& size_class, bool quiet = false);
+  void OnCoroutineDestruction(SizeClass& size_class) noexcept;
 
   template <typename Token>
-  Token& GetUsedPoolToken();
+  Token& GetUsedPoolToken(SizeClass& size_class);
 
   const PoolConfig config_;
   const Executor executor_;
 
-  boost::coroutines2::protected_fixedsize_stack stack_allocator_;
-
-  // We aim to reuse coroutines as much as possible,
-  // because since coroutine stack is a mmap-ed chunk of memory and not actually
-  // an allocated memory we don't want to de-virtualize that memory excessively.
-  //
-  // The same could've been achieved with some LIFO container, but apparently
-  // we don't have a container handy enough to not just use 2 queues.
-  moodycamel::ConcurrentQueue<Coroutine> initial_coroutines_;
-  moodycamel::ConcurrentQueue<Coroutine> used_coroutines_;
+  std::vector<std::size_t> stack_sizes_;
+  std::vector<std::unique_ptr<SizeClass>> classes_;
+  std::size_t default_class_{0};
 
-  std::atomic<std::size_t> idle_coroutines_num_;
-  std::atomic<std::size_t> total_coroutines_num_;
+  std::atomic<std::size_t> sampling_counter_{0};
+  StackUsageSampler stack_usage_sampler_;
 };
 
 template <typename Task>
 class Pool<Task>::CoroutinePtr final {
  public:
-  CoroutinePtr(Coroutine&& coro, Pool<Task>& pool) noexcept
-      : coro_(std::move(coro)), pool_(&pool) {}
+  CoroutinePtr(PooledCoroutine&& coro, Pool<Task>& pool,
+               SizeClass& size_class) noexcept
+      : coro_(std::move(coro)), pool_(&pool), class_(&size_class) {}
 
   CoroutinePtr(CoroutinePtr&&) noexcept = default;
   CoroutinePtr& operator=(CoroutinePtr&&) noexcept = default;
 
   ~CoroutinePtr() {
     UASSERT(pool_);
-    if (coro_) pool_->OnCoroutineDestruction();
+    if (coro_.coroutine) pool_->OnCoroutineDestruction(*class_);
   }
 
   Coroutine& Get() noexcept {
-    UASSERT(coro_);
-    return coro_;
+    UASSERT(coro_.coroutine);
+    return coro_.coroutine;
+  }
+
+  std::size_t GetStackSize() const noexcept { return class_->stack_size; }
+
+  bool IsStackUsageSampled() const noexcept {
+    return sampled_task_kind_ != nullptr;
+  }
+
+  /// Only the first kind is kept, no-op if the stack usage is not sampled
+  void SetTaskKind(std::string_view task_kind) {
+    if (sampled_task_kind_ && sampled_task_kind_->empty()) {
+      sampled_task_kind_->assign(task_kind);
+    }
   }
 
   void ReturnToPool() && {
-    UASSERT(coro_);
+    UASSERT(coro_.coroutine);
     pool_->PutCoroutine(std::move(*this));
   }
 
  private:
-  Coroutine coro_;
+  friend class Pool<Task>;
+
+  PooledCoroutine coro_;
   Pool<Task>* pool_;
+  SizeClass* class_;
+  // non-null if the stack usage of the coroutine is measured
+  std::unique_ptr<std::string> sampled_task_kind_;
 };
 
 template <typename Task>
 Pool<Task>::Pool(PoolConfig config, Executor executor)
-    : config_(std::move(config)),
-      executor_(executor),
-      stack_allocator_(config_.stack_size),
-      initial_coroutines_(config_.initial_size),
-      used_coroutines_(config_.max_size),
-      idle_coroutines_num_(config_.initial_size),
-      total_coroutines_num_(0) {
-  moodycamel::ProducerToken token(initial_coroutines_);
+    : config_(std::move(config)), executor_(executor) {
+  stack_sizes_ = config_.stack_size_classes;
+  stack_sizes_.push_back(config_.stack_size);
+  std::sort(stack_sizes_.begin(), stack_sizes_.end());
+  stack_sizes_.erase(std::unique(stack_sizes_.begin(), stack_sizes_.end()),
+                     stack_sizes_.end());
+  if (stack_sizes_.size() > kMaxStackSizeClasses ||
+      stack_sizes_.front() == 0) {
+    throw std::runtime_error(fmt::format(
+        "Invalid coroutine stack size classes: at most {} non-zero sizes "
+        "are allowed",
+        kMaxStackSizeClasses));
+  }
+
+  for (std::size_t i = 0; i < stack_sizes_.size(); ++i) {
+    const bool is_default = (stack_sizes_[i] == config_.stack_size);
+    if (is_default) default_class_ = i;
+    classes_.push_back(std::make_unique<SizeClass>(
+        i, stack_sizes_[i], is_default ? config_.initial_size : 0,
+        config_.max_size));
+  }
+
+  auto& default_class = *classes_[default_class_];
+  moodycamel::ProducerToken token(default_class.initial_coroutines);
   for (std::size_t i = 0; i < config_.initial_size; ++i) {
-    bool ok =
-        initial_coroutines_.enqueue(token, CreateCoroutine(/*quiet =*/true));
+    bool ok = default_class.initial_coroutines.enqueue(
+        token, CreateCoroutine(default_class, /*quiet =*/true));
     UINVARIANT(ok, "Failed to allocate the initial coro pool");
   }
 }
@@ -110,63 +246,134 @@ template <typename Task>
 Pool<Task>::~Pool() = default;
 
 template <typename Task>
-typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
-  struct CoroutineMover {
-    std::optional<Coroutine>& result;
-
-    CoroutineMover& operator=(Coroutine&& coro) {
-      result.emplace(std::move(coro));
-      return *this;
-    }
-  };
+typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine(
+    std::size_t stack_size_class) {
+  UASSERT(stack_size_class < classes_.size());
+  auto& size_class = *classes_[stack_size_class];
 
-  std::optional<Coroutine> coroutine;
+  std::optional<PooledCoroutine> coroutine;
   CoroutineMover mover{coroutine};
 
   // First try to dequeue from 'working set': if we can get a coroutine
   // from there we are happy, because we saved on minor-page-faulting (thus
   // increasing resident memory usage) a not-yet-de-virtualized coroutine stack.
-  if (used_coroutines_.try_dequeue(
-          GetUsedPoolToken<moodycamel::ConsumerToken>(), mover) ||
-      initial_coroutines_.try_dequeue(mover)) {
-    --idle_coroutines_num_;
+  if (size_class.used_coroutines.try_dequeue(
+          GetUsedPoolToken<moodycamel::ConsumerToken>(size_class), mover) ||
+      size_class.initial_coroutines.try_dequeue(mover)) {
+    const auto idle = --size_class.idle_coroutines_num;
+    // racy, but the watermark is only a hint for ReleaseIdleStacks()
+    if (idle < size_class.idle_coroutines_low_watermark.load(
+                   std::memory_order_relaxed)) {
+      size_class.idle_coroutines_low_watermark.store(
+          idle, std::memory_order_relaxed);
+    }
   } else {
-    coroutine.emplace(CreateCoroutine());
+    coroutine.emplace(CreateCoroutine(size_class));
+  }
+
+  CoroutinePtr result(std::move(*coroutine), *this, size_class);
+  if (IsStackUsageSampled() &&
+      sampling_counter_.fetch_add(1, std::memory_order_relaxed) %
+              config_.stack_usage_sample_every ==
+          0) {
+    ReleaseStackPages(result.coro_.stack);
+    result.sampled_task_kind_ = std::make_unique<std::string>();
   }
-  return CoroutinePtr(std::move(*coroutine), *this);
+  return result;
 }
 
 template <typename Task>
-void Pool<Task>::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
-  if (idle_coroutines_num_.load() >= config_.max_size) return;
-  auto& token = GetUsedPoolToken<moodycamel::ProducerToken>();
+void Pool<Task>::PutCoroutine(CoroutinePtr&& coroutine_ptr,
+                              std::string_view task_kind) {
+  if (coroutine_ptr.sampled_task_kind_) {
+    auto sampled_task_kind = std::move(coroutine_ptr.sampled_task_kind_);
+    if (sampled_task_kind->empty()) sampled_task_kind->assign(task_kind);
+    stack_usage_sampler_.Account(*sampled_task_kind,
+                                 GetStackUsage(coroutine_ptr.coro_.stack));
+  }
+
+  auto& size_class = *coroutine_ptr.class_;
+  if (size_class.idle_coroutines_num.load() >= config_.max_size) return;
+  auto& token = GetUsedPoolToken<moodycamel::ProducerToken>(size_class);
   const bool ok =
       // We only ever return coroutines into our 'working set'.
-      used_coroutines_.enqueue(token, std::move(coroutine_ptr.Get()));
-  if (ok) ++idle_coroutines_num_;
+      size_class.used_coroutines.enqueue(token,
+                                         std::move(coroutine_ptr.coro_));
+  if (ok) ++size_class.idle_coroutines_num;
 }
 
 template <typename Task>
 PoolStats Pool<Task>::GetStats() const {
   PoolStats stats;
-  stats.active_coroutines =
-      total_coroutines_num_.load() -
-      (used_coroutines_.size_approx() + initial_coroutines_.size_approx());
-  stats.total_coroutines =
-      std::max(total_coroutines_num_.load(), stats.active_coroutines);
+  for (std::size_t i = 0; i < classes_.size(); ++i) stats += GetStats(i);
   return stats;
 }
 
 template <typename Task>
-typename Pool<Task>::Coroutine Pool<Task>::CreateCoroutine(bool quiet) {
+PoolStats Pool<Task>::GetStats(std::size_t stack_size_class) const {
+  UASSERT(stack_size_class < classes_.size());
+  const auto& size_class = *classes_[stack_size_class];
+
+  PoolStats stats;
+  stats.active_coroutines = size_class.total_coroutines_num.load() -
+                            (size_class.used_coroutines.size_approx() +
+                             size_class.initial_coroutines.size_approx());
+  stats.total_coroutines = std::max(size_class.total_coroutines_num.load(),
+                                    stats.active_coroutines);
+  return stats;
+}
+
+template <typename Task>
+std::vector<StackUsageReportEntry> Pool<Task>::GetStackUsageReport() const {
+  return stack_usage_sampler_.GetReport(stack_sizes_);
+}
+
+template <typename Task>
+void Pool<Task>::ReleaseIdleStacks() {
+  for (auto& size_class_ptr : classes_) {
+    auto& size_class = *size_class_ptr;
+    const auto idle_for_whole_period =
+        size_class.idle_coroutines_low_watermark.exchange(
+            size_class.idle_coroutines_num.load(), std::memory_order_relaxed);
+    const auto to_release = std::min(
+        idle_for_whole_period, size_class.used_coroutines.size_approx());
+
+    std::size_t released = 0;
+    std::optional<PooledCoroutine> coroutine;
+    CoroutineMover mover{coroutine};
+    while (released < to_release &&
+           size_class.used_coroutines.try_dequeue(mover)) {
+      ReleaseStackPages(coroutine->stack);
+      if (!size_class.initial_coroutines.enqueue(std::move(*coroutine))) {
+        --size_class.idle_coroutines_num;
+        OnCoroutineDestruction(size_class);
+      }
+      coroutine.reset();
+      ++released;
+    }
+
+    if (released) {
+      LOG_DEBUG() << "Released the stacks of " << released
+                  << " idle coroutines of size " << size_class.stack_size;
+    }
+  }
+}
+
+template <typename Task>
+typename Pool<Task>::PooledCoroutine Pool<Task>::CreateCoroutine(
+    SizeClass& size_class, bool quiet) {
   try {
-    Coroutine coroutine(stack_allocator_, executor_);
-    const auto new_total = ++total_coroutines_num_;
+    StackBounds stack;
+    Coroutine coroutine(
+        StackAllocator{size_class.stack_size, config_.huge_pages, stack},
+        executor_);
+    const auto new_total = ++size_class.total_coroutines_num;
     if (!quiet) {
       LOG_DEBUG() << "Created a coroutine #" << new_total << '/'
-                  << config_.max_size;
+                  << config_.max_size << " of stack size "
+                  << size_class.stack_size;
     }
-    return coroutine;
+    return {std::move(coroutine), stack};
   } catch (const std::bad_alloc&) {
     if (errno == ENOMEM) {
       // It should be ok to allocate here (which LOG_ERROR might do),
@@ -176,7 +383,7 @@ typename Pool<Task>::Coroutine Pool<Task>::CreateCoroutine(bool quiet) {
       // boost/context/posix/protected_fixedsize_stack.hpp
       LOG_ERROR() << "Failed to allocate a coroutine (ENOMEM), current "
                      "coroutines count: "
-                  << total_coroutines_num_.load()
+                  << GetStats().total_coroutines
                   << "; are you hitting the vm.max_map_count limit?";
     }
 
@@ -185,8 +392,8 @@ typename Pool<Task>::Coroutine Pool<Task>::CreateCoroutine(bool quiet) {
 }
 
 template <typename Task>
-void Pool<Task>::OnCoroutineDestruction() noexcept {
-  --total_coroutines_num_;
+void Pool<Task>::OnCoroutineDestruction(SizeClass& size_class) noexcept {
+  --size_class.total_coroutines_num;
 }
 
 template <typename Task>
@@ -194,11 +401,23 @@ std::size_t Pool<Task>::GetStackSize() const {
   return config_.stack_size;
 }
 
+template <typename Task>
+std::size_t Pool<Task>::FindStackSizeClass(
+    std::size_t stack_size) const noexcept {
+  if (stack_size == 0) return default_class_;
+  const auto it =
+      std::lower_bound(stack_sizes_.begin(), stack_sizes_.end(), stack_size);
+  if (it == stack_sizes_.end()) return stack_sizes_.size() - 1;
+  return it - stack_sizes_.begin();
+}
+
 template <typename Task>
 template <typename Token>
-Token& Pool<Task>::GetUsedPoolToken() {
-  thread_local Token token(used_coroutines_);
-  return token;
+Token& Pool<Task>::GetUsedPoolToken(SizeClass& size_class) {
+  thread_local std::array<std::optional<Token>, kMaxStackSizeClasses> tokens;
+  auto& token = tokens[size_class.index];
+  if (!token) token.emplace(size_class.used_coroutines);
+  return *token;
 }
 
 }  // namespace engine::coro
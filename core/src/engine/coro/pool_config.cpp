@@ -10,6 +10,15 @@ PoolConfig Parse(const yaml_config::YamlConfig& value,
   config.initial_size = value["initial_size"].As<size_t>(config.initial_size);
   config.max_size = value["max_size"].As<size_t>(config.max_size);
   config.stack_size = value["stack_size"].As<size_t>(config.stack_size);
+  config.stack_size_classes =
+      value["stack_size_classes"].As<std::vector<std::size_t>>({});
+  config.stack_usage_sample_every =
+      value["stack_usage_sample_every"].As<size_t>(
+          config.stack_usage_sample_every);
+  config.idle_stacks_release_period =
+      value["idle_stacks_release_period"].As<std::chrono::milliseconds>(
+          config.idle_stacks_release_period);
+  config.huge_pages = value["huge_pages"].As<bool>(config.huge_pages);
   return config;
 }
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <chrono>
 #include <string>
+#include <vector>
 
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -13,6 +15,21 @@ struct PoolConfig {
   std::size_t initial_size = 1000;
   std::size_t max_size = 4000;
   std::size_t stack_size = 256 * 1024ULL;
+
+  // Additional stack sizes. Coroutines of these sizes are created on demand,
+  // at most `max_size` idle coroutines are kept for each of them.
+  std::vector<std::size_t> stack_size_classes{};
+
+  // Measure the stack high-water mark of each N-th coroutine, 0 to disable
+  std::size_t stack_usage_sample_every = 0;
+
+  // How often the pages of the stacks that stayed idle for the whole period
+  // are released to the OS, 0 to disable
+  std::chrono::milliseconds idle_stacks_release_period{0};
+
+  // Advise the kernel to back the stacks with transparent huge pages. Only
+  // stacks of at least 2MiB could actually get them.
+  bool huge_pages = false;
 };
 
 PoolConfig Parse(const yaml_config::YamlConfig& value,
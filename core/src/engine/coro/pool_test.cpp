@@ -0,0 +1,129 @@
+#include <engine/coro/pool.hpp>
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct FakeTask {
+  std::size_t stack_usage{0};
+};
+
+// The pool keeps thread_local queue tokens per instantiation, so each test
+// uses a pool of its own type
+template <int kTestIndex>
+struct FakeTaskOf final : FakeTask {};
+
+template <int kTestIndex>
+using FakePool = engine::coro::Pool<FakeTaskOf<kTestIndex>>;
+
+// Keeps the array on the stack of the coroutine
+__attribute__((noinline)) void UseStack(std::size_t bytes) {
+  constexpr std::size_t kChunk = 4096;
+  if (bytes < kChunk) return;
+  std::array<volatile unsigned char, kChunk> chunk{};
+  chunk[0] = 1;
+  UseStack(bytes - kChunk);
+  chunk[kChunk - 1] = chunk[0];
+}
+
+template <int kTestIndex>
+void Executor(typename FakePool<kTestIndex>::TaskPipe& task_pipe) {
+  for (FakeTask* task : task_pipe) UseStack(task->stack_usage);
+}
+
+template <typename Pool>
+std::size_t GetMaxUsage(const Pool& pool, std::string_view task_kind) {
+  for (const auto& entry : pool.GetStackUsageReport()) {
+    if (entry.task_kind == task_kind) return entry.max_usage;
+  }
+  ADD_FAILURE() << "no samples for " << task_kind;
+  return 0;
+}
+
+}  // namespace
+
+TEST(CoroPool, StackSizeClasses) {
+  engine::coro::PoolConfig config;
+  config.initial_size = 1;
+  config.stack_size = 256 * 1024;
+  config.stack_size_classes = {64 * 1024, 32 * 1024};
+  FakePool<0> pool(config, &Executor<0>);
+
+  EXPECT_EQ(pool.GetStackSizes(),
+            (std::vector<std::size_t>{32 * 1024, 64 * 1024, 256 * 1024}));
+  EXPECT_EQ(pool.FindStackSizeClass(0), 2);
+  EXPECT_EQ(pool.FindStackSizeClass(1), 0);
+  EXPECT_EQ(pool.FindStackSizeClass(33 * 1024), 1);
+  EXPECT_EQ(pool.FindStackSizeClass(1024 * 1024), 2);
+
+  auto coroutine = pool.GetCoroutine(0);
+  EXPECT_EQ(coroutine.GetStackSize(), 32 * 1024);
+  EXPECT_EQ(pool.GetStats(0).active_coroutines, 1);
+  EXPECT_EQ(pool.GetStats(2).total_coroutines, 1);
+  EXPECT_EQ(pool.GetStats().total_coroutines, 2);
+
+  std::move(coroutine).ReturnToPool();
+  EXPECT_EQ(pool.GetStats(0).active_coroutines, 0);
+}
+
+TEST(CoroPool, StackUsageSampling) {
+  engine::coro::PoolConfig config;
+  config.initial_size = 0;
+  config.stack_size = 512 * 1024;
+  config.stack_size_classes = {64 * 1024};
+  config.stack_usage_sample_every = 1;
+  FakePool<1> pool(config, &Executor<1>);
+
+  for (const auto& [task_kind, usage] :
+       {std::pair{"deep", 300 * 1024}, std::pair{"shallow", 0}}) {
+    FakeTaskOf<1> task{{static_cast<std::size_t>(usage)}};
+    auto coroutine = pool.GetCoroutine();
+    ASSERT_TRUE(coroutine.IsStackUsageSampled());
+    coroutine.Get()(&task);
+    std::move(coroutine).ReturnToPool();
+    // the same coroutine is reused, the pages used before must not count
+    coroutine = pool.GetCoroutine();
+    coroutine.SetTaskKind(task_kind);
+    coroutine.Get()(&task);
+    std::move(coroutine).ReturnToPool();
+  }
+
+  EXPECT_GE(GetMaxUsage(pool, "deep"), 300 * 1024);
+  EXPECT_LT(GetMaxUsage(pool, "shallow"), 64 * 1024);
+  for (const auto& entry : pool.GetStackUsageReport()) {
+    if (entry.task_kind == "shallow") {
+      EXPECT_EQ(entry.recommended_stack_size, 64 * 1024);
+    } else {
+      EXPECT_EQ(entry.recommended_stack_size, 512 * 1024);
+    }
+  }
+}
+
+TEST(CoroPool, ReleaseIdleStacks) {
+  engine::coro::PoolConfig config;
+  config.initial_size = 0;
+  config.stack_size = 512 * 1024;
+  FakePool<2> pool(config, &Executor<2>);
+
+  FakeTaskOf<2> task{{300 * 1024}};
+  auto coroutine = pool.GetCoroutine();
+  coroutine.Get()(&task);
+  std::move(coroutine).ReturnToPool();
+
+  // the first call starts the period
+  pool.ReleaseIdleStacks();
+  pool.ReleaseIdleStacks();
+  EXPECT_EQ(pool.GetStats().total_coroutines, 1);
+  EXPECT_EQ(pool.GetStats().active_coroutines, 0);
+
+  // the released coroutine is still usable
+  coroutine = pool.GetCoroutine();
+  coroutine.Get()(&task);
+  std::move(coroutine).ReturnToPool();
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,116 @@
+#include <engine/coro/stack_usage.hpp>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+namespace {
+
+constexpr std::size_t kMaxTaskKinds = 1000;
+constexpr std::string_view kNoSpanTaskKind = "[no span]";
+constexpr std::string_view kOtherTaskKind = "[other]";
+
+std::size_t GetPageSize() noexcept {
+  static const auto kPageSize =
+      static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return kPageSize;
+}
+
+// The part of the stack that may be released, page-aligned;
+// empty if the stack is not bigger than the top reserve
+StackBounds GetReleasableRange(StackBounds stack) noexcept {
+  const auto page_size = GetPageSize();
+  const auto bottom = reinterpret_cast<std::uintptr_t>(stack.bottom);
+  const auto top = reinterpret_cast<std::uintptr_t>(stack.top);
+  if (top - bottom <= kStackTopReserve) return {stack.bottom, stack.bottom};
+
+  const auto end = (top - kStackTopReserve) / page_size * page_size;
+  const auto begin = (bottom + page_size - 1) / page_size * page_size;
+  if (end <= begin) return {stack.bottom, stack.bottom};
+  return {reinterpret_cast<std::byte*>(begin),
+          reinterpret_cast<std::byte*>(end)};
+}
+
+}  // namespace
+
+void ReleaseStackPages(StackBounds stack) noexcept {
+  const auto range = GetReleasableRange(stack);
+  if (range.bottom == range.top) return;
+
+  // MADV_FREE is lazier, but the pages stay resident until the memory
+  // pressure, which breaks GetStackUsage()
+  [[maybe_unused]] const int result =
+      ::madvise(range.bottom, range.top - range.bottom, MADV_DONTNEED);
+  UASSERT_MSG(result == 0, "madvise failed on a coroutine stack");
+}
+
+std::size_t GetStackUsage(StackBounds stack) noexcept {
+  const auto page_size = GetPageSize();
+  const auto range = GetReleasableRange(stack);
+
+  // the lowest resident page is the deepest point the stack has reached
+  constexpr std::size_t kPagesPerCall = 64;
+  std::array<unsigned char, kPagesPerCall> residency{};
+  for (auto* chunk = range.bottom; chunk < range.top;
+       chunk += kPagesPerCall * page_size) {
+    const auto pages = std::min<std::size_t>(
+        kPagesPerCall, (range.top - chunk) / page_size);
+    if (::mincore(chunk, pages * page_size, residency.data()) != 0) {
+      UASSERT_MSG(false, "mincore failed on a coroutine stack");
+      return stack.top - stack.bottom;
+    }
+    for (std::size_t i = 0; i < pages; ++i) {
+      if (residency[i] & 1) return stack.top - (chunk + i * page_size);
+    }
+  }
+  return stack.top - range.top;
+}
+
+void StackUsageSampler::Account(std::string_view task_kind,
+                                std::size_t usage) {
+  if (task_kind.empty()) task_kind = kNoSpanTaskKind;
+
+  const std::lock_guard lock{mutex_};
+  auto it = entries_.find(std::string{task_kind});
+  if (it == entries_.end()) {
+    if (entries_.size() >= kMaxTaskKinds) task_kind = kOtherTaskKind;
+    it = entries_.try_emplace(std::string{task_kind}).first;
+  }
+  ++it->second.samples;
+  it->second.max_usage = std::max(it->second.max_usage, usage);
+}
+
+std::vector<StackUsageReportEntry> StackUsageSampler::GetReport(
+    const std::vector<std::size_t>& stack_sizes) const {
+  UASSERT(!stack_sizes.empty());
+  UASSERT(std::is_sorted(stack_sizes.begin(), stack_sizes.end()));
+
+  std::vector<StackUsageReportEntry> result;
+  const std::lock_guard lock{mutex_};
+  result.reserve(entries_.size());
+  for (const auto& [task_kind, entry] : entries_) {
+    const auto fitting = std::lower_bound(
+        stack_sizes.begin(), stack_sizes.end(), entry.max_usage * 2);
+    result.push_back({
+        task_kind,
+        entry.samples,
+        entry.max_usage,
+        fitting == stack_sizes.end() ? stack_sizes.back() : *fitting,
+    });
+  }
+  return result;
+}
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+/// Usable memory of a coroutine stack, the stack grows down from `top`
+struct StackBounds {
+  std::byte* bottom{nullptr};
+  std::byte* top{nullptr};
+};
+
+/// The top of an idle coroutine stack is never released: it holds the
+/// coroutine control block and the frames of the suspended executor.
+inline constexpr std::size_t kStackTopReserve = 16 * 1024;
+
+/// Returns the pages of the stack below kStackTopReserve to the OS, they are
+/// zero-filled on the next access. The coroutine must be suspended.
+void ReleaseStackPages(StackBounds stack) noexcept;
+
+/// High-water mark of the stack usage since the last ReleaseStackPages(),
+/// the top reserve is always counted as used. The coroutine must be suspended.
+std::size_t GetStackUsage(StackBounds stack) noexcept;
+
+struct StackUsageReportEntry {
+  std::string task_kind;
+  std::size_t samples{0};
+  std::size_t max_usage{0};
+  // the smallest stack size class that fits twice the observed maximum
+  std::size_t recommended_stack_size{0};
+};
+
+/// Aggregates the sampled stack usage by task kind, thread-safe
+class StackUsageSampler final {
+ public:
+  void Account(std::string_view task_kind, std::size_t usage);
+
+  /// `stack_sizes` must be sorted in ascending order
+  std::vector<StackUsageReportEntry> GetReport(
+      const std::vector<std::size_t>& stack_sizes) const;
+
+ private:
+  struct Entry {
+    std::size_t samples{0};
+    std::size_t max_usage{0};
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
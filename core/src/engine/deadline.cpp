@@ -1,5 +1,7 @@
 #include <userver/engine/deadline.hpp>
 
+#include <ctime>
+
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/datetime/steady_coarse_clock.hpp>
@@ -10,10 +12,30 @@ namespace engine {
 
 using CoarseClock = utils::datetime::SteadyCoarseClock;
 
+namespace {
+
+#ifdef CLOCK_MONOTONIC_COARSE
+// The coarse clock is the precise one as of the last timer tick, so it lags
+// behind by about a tick. The margin leaves some room for the delayed ticks.
+constexpr int kCoarseLagMarginTicks = 4;
+#endif
+
+}  // namespace
+
 bool Deadline::IsReached() const noexcept {
   if (!IsReachable()) return false;
   if (value_ == kPassed) return true;
 
+#ifdef CLOCK_MONOTONIC_COARSE
+  // Most of the checks are done long before the deadline, the coarse clock
+  // read is several times cheaper than the precise one for them
+  if (value_.time_since_epoch() >
+      CoarseClock::now().time_since_epoch() +
+          kCoarseLagMarginTicks * CoarseClock::resolution()) {
+    return false;
+  }
+#endif
+
   return value_ <= TimePoint::clock::now();
 }
 
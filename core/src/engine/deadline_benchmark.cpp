@@ -1,7 +1,9 @@
 #include <benchmark/benchmark.h>
 
 #include <chrono>
+#include <vector>
 
+#include <engine/ev/timer_wheel.hpp>
 #include <userver/engine/deadline.hpp>
 
 #include <utils/gbench_auxilary.hpp>
@@ -27,6 +29,15 @@ void deadline_is_reached(benchmark::State& state,
   }
 }
 
+void deadline_is_surely_reached_approx(benchmark::State& state,
+                                       std::chrono::nanoseconds duration) {
+  auto deadline = engine::Deadline::FromDuration(duration);
+  for ([[maybe_unused]] auto _ : state) {
+    bool is_reached = deadline.IsSurelyReachedApprox();
+    benchmark::DoNotOptimize(is_reached);
+  }
+}
+
 void deadline_1us_interval_construction(benchmark::State& state) {
   deadline_from_duration(state, std::chrono::microseconds{1});
 }
@@ -47,6 +58,52 @@ void deadline_100s_interval_reached(benchmark::State& state) {
   deadline_is_reached(state, std::chrono::seconds{100});
 }
 
+void deadline_100s_interval_surely_reached_approx(benchmark::State& state) {
+  deadline_is_surely_reached_approx(state, std::chrono::seconds{100});
+}
+
+void deadline_100s_interval_time_left_approx(benchmark::State& state) {
+  auto deadline = engine::Deadline::FromDuration(std::chrono::seconds{100});
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(deadline.TimeLeftApprox());
+  }
+}
+
+class NoopWheelEntry final : public engine::ev::TimerWheel::Entry {
+  void OnExpiredLocked() noexcept override {}
+  void OnExpired() noexcept override {}
+};
+
+// A timeout that is set and then cancelled before the expiration
+void timer_wheel_arm_disarm(benchmark::State& state) {
+  engine::ev::TimerWheel wheel;
+  NoopWheelEntry entry;
+  const std::chrono::milliseconds timeout{state.range(0)};
+  for ([[maybe_unused]] auto _ : state) {
+    wheel.Arm(entry, engine::Deadline::FromDuration(timeout));
+    benchmark::DoNotOptimize(wheel.Disarm(entry));
+  }
+}
+
+void timer_wheel_advance(benchmark::State& state) {
+  const auto start = engine::ev::TimerWheel::Clock::now();
+  engine::ev::TimerWheel wheel{start};
+  std::vector<NoopWheelEntry> entries(state.range(0));
+
+  auto now = start;
+  for ([[maybe_unused]] auto _ : state) {
+    state.PauseTiming();
+    for (auto& entry : entries) {
+      wheel.Arm(entry, engine::Deadline::FromDuration(std::chrono::seconds{1}));
+    }
+    now += std::chrono::seconds{2};
+    state.ResumeTiming();
+
+    wheel.Advance(now);
+  }
+  state.SetItemsProcessed(state.iterations() * entries.size());
+}
+
 }  // namespace
 
 BENCHMARK(deadline_1us_interval_construction);
@@ -55,5 +112,10 @@ BENCHMARK(deadline_20ms_interval_construction);
 BENCHMARK(deadline_1us_interval_reached);
 BENCHMARK(deadline_20ms_interval_reached);
 BENCHMARK(deadline_100s_interval_reached);
+BENCHMARK(deadline_100s_interval_surely_reached_approx);
+BENCHMARK(deadline_100s_interval_time_left_approx);
+
+BENCHMARK(timer_wheel_arm_disarm)->Arg(50)->Arg(5'000)->Arg(600'000);
+BENCHMARK(timer_wheel_advance)->RangeMultiplier(8)->Range(1, 4096);
 
 USERVER_NAMESPACE_END
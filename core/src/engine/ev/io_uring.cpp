@@ -0,0 +1,387 @@
+#include "io_uring.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define USERVER_IMPL_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+#ifdef USERVER_IMPL_HAS_IO_URING
+
+namespace {
+
+// Completions of the operations that are not waited for, e.g. cancellations
+constexpr std::uint64_t kIgnoredUserData = 0;
+
+int SysIoUringSetup(unsigned entries, io_uring_params* params) noexcept {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int SysIoUringEnter(int ring_fd, unsigned to_submit, unsigned min_complete,
+                    unsigned flags) noexcept {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+int SysIoUringRegister(int ring_fd, unsigned opcode, const void* arg,
+                       unsigned nr_args) noexcept {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+// NODROP guarantees that completions are never lost on CQ overflow, FAST_POLL
+// makes the kernel wait for readiness internally instead of punting
+// operations on non-blocking sockets to a worker thread.
+constexpr unsigned kRequiredFeatures =
+    IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL;
+
+bool DetectSupport() noexcept {
+  io_uring_params params{};
+  const int fd = SysIoUringSetup(1, &params);
+  if (fd < 0) {
+    LOG_INFO() << "io_uring is not available: "
+               << std::error_code(errno, std::system_category()).message();
+    return false;
+  }
+  ::close(fd);
+
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+    LOG_INFO() << "io_uring is available, but lacks required features";
+    return false;
+  }
+  return true;
+}
+
+std::uint64_t ToUserData(const IoUring::Completion& completion) noexcept {
+  return reinterpret_cast<std::uintptr_t>(&completion);
+}
+
+}  // namespace
+
+IoUring::IoUring(std::uint32_t entries) {
+  try {
+    Init(entries);
+  } catch (const std::exception&) {
+    ReleaseResources();
+    throw;
+  }
+}
+
+IoUring::~IoUring() { ReleaseResources(); }
+
+void IoUring::Init(std::uint32_t entries) {
+  io_uring_params params{};
+  ring_fd_ = utils::CheckSyscall(SysIoUringSetup(entries, &params),
+                                 "setting up io_uring with {} entries",
+                                 entries);
+  UINVARIANT((params.features & kRequiredFeatures) == kRequiredFeatures,
+             "io_uring lacks required features");
+
+  // IORING_FEAT_SINGLE_MMAP: both rings share a single mapping
+  ring_size_ = std::max<std::size_t>(
+      params.sq_off.array + params.sq_entries * sizeof(unsigned),
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  ring_ = ::mmap(nullptr, ring_size_, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (ring_ == MAP_FAILED) {
+    ring_ = nullptr;
+    utils::CheckSyscall(-1, "mapping io_uring rings");
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes_ == MAP_FAILED) {
+    sqes_ = nullptr;
+    utils::CheckSyscall(-1, "mapping io_uring sqes");
+  }
+
+  auto* base = static_cast<char*>(ring_);
+  sq_head_ = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+  sq_flags_ = reinterpret_cast<unsigned*>(base + params.sq_off.flags);
+  sq_array_ = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+  sq_mask_ = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  sq_local_tail_ = *sq_tail_;
+
+  cq_head_ = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+  cqes_ = base + params.cq_off.cqes;
+  cq_mask_ = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+
+  event_fd_ = utils::CheckSyscall(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC),
+                                  "creating eventfd for io_uring");
+  utils::CheckSyscall(
+      SysIoUringRegister(ring_fd_, IORING_REGISTER_EVENTFD, &event_fd_, 1),
+      "registering eventfd for io_uring");
+}
+
+void IoUring::ReleaseResources() noexcept {
+  if (sqes_) ::munmap(sqes_, sqes_size_);
+  if (ring_) ::munmap(ring_, ring_size_);
+  if (event_fd_ != -1) ::close(event_fd_);
+  if (ring_fd_ != -1) ::close(ring_fd_);
+  sqes_ = ring_ = nullptr;
+  event_fd_ = ring_fd_ = -1;
+}
+
+bool IoUring::IsSupported() noexcept {
+  static const bool is_supported = DetectSupport();
+  return is_supported;
+}
+
+template <typename Prepare>
+bool IoUring::Submit(Prepare&& prepare) {
+  std::unique_lock lock(submit_mutex_);
+
+  const auto head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  if (sq_local_tail_ - head >= sq_entries_) return false;
+
+  const auto index = sq_local_tail_ & sq_mask_;
+  auto* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+  std::memset(sqe, 0, sizeof(*sqe));
+  prepare(*sqe);
+  sq_array_[index] = index;
+  ++sq_local_tail_;
+  __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+  ++pending_submissions_;
+
+  // Someone else is already in io_uring_enter, it will pick up our sqe.
+  if (is_flushing_) return true;
+
+  is_flushing_ = true;
+  while (pending_submissions_ != 0) {
+    const auto to_submit = std::exchange(pending_submissions_, 0);
+    lock.unlock();
+    Enter(to_submit, 0);
+    lock.lock();
+  }
+  is_flushing_ = false;
+  return true;
+}
+
+void IoUring::Enter(std::uint32_t to_submit, unsigned flags) noexcept {
+  while (to_submit != 0 || flags != 0) {
+    const int submitted = SysIoUringEnter(ring_fd_, to_submit, 0, flags);
+    if (submitted >= 0) {
+      UASSERT(static_cast<std::uint32_t>(submitted) <= to_submit);
+      to_submit -= submitted;
+      flags = 0;
+      continue;
+    }
+
+    const auto error_code = errno;
+    if (error_code == EINTR) continue;
+    if (error_code == EAGAIN || error_code == EBUSY) {
+      // The kernel is short on resources or the completion queue overflow
+      // backlog is full. The ev thread frees it up by reaping completions.
+      std::this_thread::yield();
+      flags = IORING_ENTER_GETEVENTS;
+      continue;
+    }
+
+    UINVARIANT(false, "io_uring_enter failed: " +
+                          std::error_code(error_code, std::system_category())
+                              .message());
+  }
+}
+
+bool IoUring::SubmitRecv(int fd, void* buf, std::size_t len, int flags,
+                         Completion& completion) {
+  return Submit([&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_RECV;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(buf);
+    sqe.len = static_cast<std::uint32_t>(len);
+    sqe.msg_flags = static_cast<std::uint32_t>(flags);
+    sqe.user_data = ToUserData(completion);
+  });
+}
+
+bool IoUring::SubmitSend(int fd, const void* buf, std::size_t len, int flags,
+                         Completion& completion) {
+  return Submit([&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_SEND;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(buf);
+    sqe.len = static_cast<std::uint32_t>(len);
+    sqe.msg_flags = static_cast<std::uint32_t>(flags);
+    sqe.user_data = ToUserData(completion);
+  });
+}
+
+bool IoUring::SubmitRead(int fd, void* buf, std::size_t len,
+                         Completion& completion) {
+  return Submit([&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(buf);
+    sqe.len = static_cast<std::uint32_t>(len);
+    // use and advance the current file position, as read(2) does
+    sqe.off = static_cast<std::uint64_t>(-1);
+    sqe.user_data = ToUserData(completion);
+  });
+}
+
+bool IoUring::SubmitWrite(int fd, const void* buf, std::size_t len,
+                          Completion& completion) {
+  return Submit([&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_WRITE;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(buf);
+    sqe.len = static_cast<std::uint32_t>(len);
+    sqe.off = static_cast<std::uint64_t>(-1);
+    sqe.user_data = ToUserData(completion);
+  });
+}
+
+bool IoUring::SubmitWritev(int fd, const struct iovec* list,
+                           std::size_t list_size, Completion& completion) {
+  return Submit([&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_WRITEV;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(list);
+    sqe.len = static_cast<std::uint32_t>(list_size);
+    sqe.off = static_cast<std::uint64_t>(-1);
+    sqe.user_data = ToUserData(completion);
+  });
+}
+
+bool IoUring::SubmitAccept(int fd, struct sockaddr* addr, socklen_t* addrlen,
+                           int flags, Completion& completion) {
+  return Submit([&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_ACCEPT;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(addr);
+    sqe.addr2 = reinterpret_cast<std::uintptr_t>(addrlen);
+    sqe.accept_flags = static_cast<std::uint32_t>(flags);
+    sqe.user_data = ToUserData(completion);
+  });
+}
+
+bool IoUring::SubmitConnect(int fd, const struct sockaddr* addr,
+                            socklen_t addrlen, Completion& completion) {
+  return Submit([&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_CONNECT;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(addr);
+    sqe.off = addrlen;
+    sqe.user_data = ToUserData(completion);
+  });
+}
+
+bool IoUring::SubmitCancel(const Completion& target) {
+  return Submit([&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_ASYNC_CANCEL;
+    sqe.fd = -1;
+    sqe.addr = ToUserData(target);
+    sqe.user_data = kIgnoredUserData;
+  });
+}
+
+void IoUring::ReapCompletions() noexcept {
+  std::uint64_t counter = 0;
+  // the value is irrelevant, we only need to reset the readiness
+  [[maybe_unused]] const auto res =
+      ::read(event_fd_, &counter, sizeof(counter));
+
+  for (;;) {
+    auto head = __atomic_load_n(cq_head_, __ATOMIC_RELAXED);
+    const auto tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+
+    while (head != tail) {
+      const auto& cqe = static_cast<io_uring_cqe*>(cqes_)[head & cq_mask_];
+      const auto user_data = cqe.user_data;
+      const auto result = cqe.res;
+      ++head;
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+      if (user_data == kIgnoredUserData) continue;
+      // NOLINTNEXTLINE(performance-no-int-to-ptr)
+      reinterpret_cast<Completion*>(static_cast<std::uintptr_t>(user_data))
+          ->OnComplete(result);
+    }
+
+    // Completions that did not fit into the CQ are kept by the kernel
+    // (IORING_FEAT_NODROP) and are flushed into the ring on the next enter.
+    if (!(__atomic_load_n(sq_flags_, __ATOMIC_ACQUIRE) &
+          IORING_SQ_CQ_OVERFLOW)) {
+      break;
+    }
+    SysIoUringEnter(ring_fd_, 0, 0, IORING_ENTER_GETEVENTS);
+  }
+}
+
+#else  // USERVER_IMPL_HAS_IO_URING
+
+IoUring::IoUring(std::uint32_t) {
+  throw std::runtime_error("io_uring is not supported on this platform");
+}
+
+IoUring::~IoUring() = default;
+
+void IoUring::Init(std::uint32_t) {}
+
+void IoUring::ReleaseResources() noexcept {}
+
+bool IoUring::IsSupported() noexcept { return false; }
+
+bool IoUring::SubmitRecv(int, void*, std::size_t, int, Completion&) {
+  return false;
+}
+
+bool IoUring::SubmitSend(int, const void*, std::size_t, int, Completion&) {
+  return false;
+}
+
+bool IoUring::SubmitRead(int, void*, std::size_t, Completion&) { return false; }
+
+bool IoUring::SubmitWrite(int, const void*, std::size_t, Completion&) {
+  return false;
+}
+
+bool IoUring::SubmitWritev(int, const struct iovec*, std::size_t,
+                           Completion&) {
+  return false;
+}
+
+bool IoUring::SubmitAccept(int, struct sockaddr*, socklen_t*, int,
+                           Completion&) {
+  return false;
+}
+
+bool IoUring::SubmitConnect(int, const struct sockaddr*, socklen_t,
+                            Completion&) {
+  return false;
+}
+
+bool IoUring::SubmitCancel(const Completion&) { return false; }
+
+void IoUring::ReapCompletions() noexcept {}
+
+#endif  // USERVER_IMPL_HAS_IO_URING
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
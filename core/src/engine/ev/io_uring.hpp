@@ -0,0 +1,110 @@
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// Minimal io_uring instance bound to an ev thread.
+///
+/// Submission is thread-safe: submitters that race with each other are
+/// coalesced into a single io_uring_enter call. Completions are reaped by the
+/// bound ev thread, which watches the eventfd registered with the ring.
+///
+/// Operations are never executed synchronously by the Submit* functions, each
+/// successful submission is followed by exactly one Completion::OnComplete
+/// call. Submit* functions return false if the submission queue is full, in
+/// that case the caller should fall back to the readiness based I/O.
+class IoUring final {
+ public:
+  class Completion {
+   public:
+    /// Called from the bound ev thread with the result of the operation:
+    /// a non-negative value on success, negated errno on failure.
+    virtual void OnComplete(int result) noexcept = 0;
+
+   protected:
+    ~Completion() = default;
+  };
+
+  explicit IoUring(std::uint32_t entries);
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+  ~IoUring();
+
+  /// Returns true if the running kernel provides all the io_uring features
+  /// required by this class.
+  static bool IsSupported() noexcept;
+
+  /// Becomes readable when there are completions to reap
+  int GetEventFd() const noexcept { return event_fd_; }
+
+  [[nodiscard]] bool SubmitRecv(int fd, void* buf, std::size_t len, int flags,
+                                Completion& completion);
+  [[nodiscard]] bool SubmitSend(int fd, const void* buf, std::size_t len,
+                                int flags, Completion& completion);
+  [[nodiscard]] bool SubmitRead(int fd, void* buf, std::size_t len,
+                                Completion& completion);
+  [[nodiscard]] bool SubmitWrite(int fd, const void* buf, std::size_t len,
+                                 Completion& completion);
+  [[nodiscard]] bool SubmitWritev(int fd, const struct iovec* list,
+                                  std::size_t list_size,
+                                  Completion& completion);
+  [[nodiscard]] bool SubmitAccept(int fd, struct sockaddr* addr,
+                                  socklen_t* addrlen, int flags,
+                                  Completion& completion);
+  [[nodiscard]] bool SubmitConnect(int fd, const struct sockaddr* addr,
+                                   socklen_t addrlen, Completion& completion);
+
+  /// Requests cancellation of an operation submitted with `target`. The
+  /// target operation is still completed, possibly with -ECANCELED.
+  [[nodiscard]] bool SubmitCancel(const Completion& target);
+
+  /// Must be called from the bound ev thread only
+  void ReapCompletions() noexcept;
+
+ private:
+  void Init(std::uint32_t entries);
+  void ReleaseResources() noexcept;
+
+  template <typename Prepare>
+  bool Submit(Prepare&& prepare);
+
+  void Enter(std::uint32_t to_submit, unsigned flags) noexcept;
+
+  int ring_fd_{-1};
+  int event_fd_{-1};
+
+  void* ring_{nullptr};
+  std::size_t ring_size_{0};
+  void* sqes_{nullptr};
+  std::size_t sqes_size_{0};
+
+  unsigned* sq_head_{nullptr};
+  unsigned* sq_tail_{nullptr};
+  unsigned* sq_flags_{nullptr};
+  unsigned* sq_array_{nullptr};
+  unsigned sq_mask_{0};
+  unsigned sq_entries_{0};
+
+  unsigned* cq_head_{nullptr};
+  unsigned* cq_tail_{nullptr};
+  void* cqes_{nullptr};
+  unsigned cq_mask_{0};
+
+  std::mutex submit_mutex_;
+  unsigned sq_local_tail_{0};
+  std::uint32_t pending_submissions_{0};
+  bool is_flushing_{false};
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
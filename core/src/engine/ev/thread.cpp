@@ -60,23 +60,59 @@ void ReleaseEvDefaultLoop() {
 constexpr std::chrono::milliseconds kCpuStatsCollectInterval{1000};
 constexpr std::size_t kCpuStatsThrottle{16};
 
+// Submissions are flushed right away, so the submission queue only has to
+// hold a burst of concurrent submitters. In-flight operations are not
+// limited by this value.
+constexpr std::uint32_t kIoUringEntries{256};
+
+std::unique_ptr<IoUring> MakeIoUring(IoEngine io_engine,
+                                     const std::string& thread_name) {
+  if (io_engine != IoEngine::kIoUring) return {};
+
+  if (!IoUring::IsSupported()) {
+    LOG_WARNING() << "io_uring is not supported by the kernel, falling back "
+                     "to libev for thread_name="
+                  << thread_name;
+    return {};
+  }
+
+  try {
+    return std::make_unique<IoUring>(kIoUringEntries);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to set up io_uring, falling back to libev for "
+                     "thread_name="
+                  << thread_name << ": " << ex;
+    return {};
+  }
+}
+
 }  // namespace
 
 Thread::Thread(const std::string& thread_name,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, false, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               const engine::impl::CpuAffinityConfig& cpu_affinity,
+               IoEngine io_engine)
+    : Thread(thread_name, false, register_event_mode, cpu_affinity,
+             io_engine) {}
 
 Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, true, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               const engine::impl::CpuAffinityConfig& cpu_affinity,
+               IoEngine io_engine)
+    : Thread(thread_name, true, register_event_mode, cpu_affinity, io_engine) {
+}
 
 Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
-               RegisterEventMode register_event_mode)
+               RegisterEventMode register_event_mode,
+               const engine::impl::CpuAffinityConfig& cpu_affinity,
+               IoEngine io_engine)
     : use_ev_default_loop_(use_ev_default_loop),
       register_event_mode_(register_event_mode),
       loop_(nullptr),
       lock_(loop_mutex_, std::defer_lock),
       name_{thread_name},
+      cpu_affinity_{cpu_affinity},
+      io_uring_{MakeIoUring(io_engine, thread_name)},
       cpu_stats_storage_{kCpuStatsCollectInterval, kCpuStatsThrottle},
       is_running_(false) {
   if (use_ev_default_loop_) AcquireEvDefaultLoop(name_);
@@ -92,7 +128,8 @@ Thread::~Thread() {
 void Thread::RunInEvLoopAsync(AsyncPayloadBase& payload) noexcept {
   RegisterInEvLoop(payload);
 
-  if (!IsInEvThread()) {
+  if (!IsInEvThread() &&
+      !drain_pending_.exchange(true, std::memory_order_acq_rel)) {
     ev_async_send(loop_, &watch_update_);
   }
 }
@@ -156,6 +193,7 @@ void Thread::Start() {
 
   using LibEvDuration = std::chrono::duration<double>;
   if (register_event_mode_ == RegisterEventMode::kDeferred) {
+    timer_wheel_ = std::make_unique<TimerWheel>();
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
     ev_timer_init(
         &timers_driver_, UpdateTimersWatcher, 0.0,
@@ -180,8 +218,16 @@ void Thread::Start() {
     ev_child_start(loop_, &watch_child_);
   }
 
+  if (io_uring_) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+    ev_io_init(&watch_io_uring_, IoUringWatcher, io_uring_->GetEventFd(),
+               EV_READ);
+    ev_io_start(loop_, &watch_io_uring_);
+  }
+
   is_running_ = true;
   thread_ = std::thread([this] {
+    engine::impl::ApplyCpuAffinity(cpu_affinity_);
     utils::SetCurrentThreadName(name_);
     RunEvLoop();
   });
@@ -216,6 +262,7 @@ void Thread::RunEvLoop() {
     ev_timer_stop(loop_, &stats_timer_);
   }
   if (use_ev_default_loop_) ev_child_stop(loop_, &watch_child_);
+  if (io_uring_) ev_io_stop(loop_, &watch_io_uring_);
 }
 
 void Thread::UpdateLoopWatcher(struct ev_loop* loop, ev_async*, int) noexcept {
@@ -229,9 +276,14 @@ void Thread::UpdateTimersWatcher(struct ev_loop* loop, ev_timer*,
   auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
   UASSERT(ev_thread != nullptr);
   ev_thread->UpdateLoopWatcherImpl();
+  if (ev_thread->timer_wheel_) ev_thread->timer_wheel_->Advance();
 }
 
 void Thread::UpdateLoopWatcherImpl() {
+  // Reset before draining: a payload pushed after the drain has started wakes
+  // up the ev-loop again. Acquire makes the payloads of the producers that
+  // skipped the wakeup visible to the drain.
+  drain_pending_.exchange(false, std::memory_order_acq_rel);
   while (AsyncPayloadBase* payload = func_queue_.TryPop()) {
     LOG_TRACE() << "Thread::UpdateLoopWatcherImpl(), "
                 << compiler::GetTypeName(typeid(*payload));
@@ -302,6 +354,13 @@ void Thread::ChildWatcherImpl(ev_child* w) {
   }
 }
 
+void Thread::IoUringWatcher(struct ev_loop* loop, ev_io*, int) noexcept {
+  auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
+  UASSERT(ev_thread != nullptr);
+  UASSERT(ev_thread->io_uring_);
+  ev_thread->io_uring_->ReapCompletions();
+}
+
 void Thread::Acquire(struct ev_loop* loop) noexcept {
   auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
   UASSERT(ev_thread != nullptr);
@@ -12,6 +12,10 @@
 
 #include <concurrent/impl/intrusive_mpsc_queue.hpp>
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/io_uring.hpp>
+#include <engine/ev/thread_pool_config.hpp>
+#include <engine/ev/timer_wheel.hpp>
+#include <engine/impl/cpu_affinity.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -34,14 +38,20 @@ class Thread final {
     kDeferred
   };
 
-  Thread(const std::string& thread_name, RegisterEventMode);
-  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode);
+  Thread(const std::string& thread_name, RegisterEventMode,
+         const engine::impl::CpuAffinityConfig& cpu_affinity = {},
+         IoEngine io_engine = IoEngine::kLibEv);
+  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode,
+         const engine::impl::CpuAffinityConfig& cpu_affinity = {},
+         IoEngine io_engine = IoEngine::kLibEv);
   ~Thread();
 
   struct ev_loop* GetEvLoop() const { return loop_; }
 
   // Callbacks passed to RunInEvLoopAsync() are serialized.
-  // All callbacks are guaranteed to execute.
+  // All callbacks are guaranteed to execute. A burst of callbacks from any
+  // number of threads results in a single ev_async_send and is performed in
+  // a single drain.
   void RunInEvLoopAsync(AsyncPayloadBase& payload) noexcept;
 
   // Callbacks passed to RunInEvLoopDeferred() are serialized.
@@ -52,12 +62,21 @@ class Thread final {
 
   bool IsInEvThread() const;
 
+  // Returns nullptr if io_uring is disabled or not supported
+  IoUring* GetIoUring() const noexcept { return io_uring_.get(); }
+
+  // Returns nullptr for RegisterEventMode::kImmediate, as the wheel is driven
+  // by the periodic timer of RegisterEventMode::kDeferred
+  TimerWheel* GetTimerWheel() const noexcept { return timer_wheel_.get(); }
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
  private:
   Thread(const std::string& thread_name, bool use_ev_default_loop,
-         RegisterEventMode register_event_mode);
+         RegisterEventMode register_event_mode,
+         const engine::impl::CpuAffinityConfig& cpu_affinity,
+         IoEngine io_engine);
 
   void RegisterInEvLoop(AsyncPayloadBase& payload);
 
@@ -73,6 +92,7 @@ class Thread final {
   void BreakLoopWatcherImpl();
   static void ChildWatcher(struct ev_loop*, ev_child* w, int) noexcept;
   static void ChildWatcherImpl(ev_child* w);
+  static void IoUringWatcher(struct ev_loop*, ev_io* w, int) noexcept;
 
   static void Acquire(struct ev_loop* loop) noexcept;
   static void Release(struct ev_loop* loop) noexcept;
@@ -80,6 +100,9 @@ class Thread final {
   void ReleaseImpl() noexcept;
 
   concurrent::impl::IntrusiveMpscQueue<AsyncPayloadBase> func_queue_;
+  // Set by the first producer after a drain, while set the producers do not
+  // wake up the ev-loop
+  std::atomic<bool> drain_pending_{false};
 
   bool use_ev_default_loop_;
   RegisterEventMode register_event_mode_;
@@ -94,8 +117,12 @@ class Thread final {
   ev_async watch_update_{};
   ev_async watch_break_{};
   ev_child watch_child_{};
+  ev_io watch_io_uring_{};
 
   const std::string name_;
+  const engine::impl::CpuAffinityConfig cpu_affinity_;
+  std::unique_ptr<IoUring> io_uring_;
+  std::unique_ptr<TimerWheel> timer_wheel_;
   utils::statistics::ThreadCpuStatsStorage cpu_stats_storage_;
 
   bool is_running_;
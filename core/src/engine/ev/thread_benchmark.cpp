@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+
+#include <engine/ev/thread.hpp>
+#include <engine/ev/thread_control.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kBurstSize = 64;
+
+engine::ev::Thread& GetEvThread() {
+  static engine::ev::Thread thread(
+      "bench_thread", engine::ev::Thread::RegisterEventMode::kImmediate);
+  return thread;
+}
+
+}  // namespace
+
+// Producers push bursts of payloads concurrently, the wakeups of the ev-loop
+// are coalesced while a drain is pending.
+void ev_thread_run_in_ev_loop_async(benchmark::State& state) {
+  engine::ev::ThreadControl thread_control(GetEvThread());
+  std::atomic<std::size_t> performed{0};
+  std::size_t pushed = 0;
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (std::size_t i = 0; i < kBurstSize; ++i) {
+      thread_control.RunInEvLoopAsync(
+          [&performed] { performed.fetch_add(1, std::memory_order_release); });
+    }
+    pushed += kBurstSize;
+  }
+
+  // `performed` must outlive the payloads
+  while (performed.load(std::memory_order_acquire) != pushed) {
+  }
+  state.SetItemsProcessed(pushed);
+}
+BENCHMARK(ev_thread_run_in_ev_loop_async)->ThreadRange(1, 4);
+
+USERVER_NAMESPACE_END
@@ -28,6 +28,14 @@ bool ThreadControlBase::IsInEvThread() const noexcept {
   return thread_.IsInEvThread();
 }
 
+IoUring* ThreadControlBase::GetIoUring() const noexcept {
+  return thread_.GetIoUring();
+}
+
+TimerWheel* ThreadControlBase::GetTimerWheel() const noexcept {
+  return thread_.GetTimerWheel();
+}
+
 std::uint8_t ThreadControlBase::GetCurrentLoadPercent() const {
   return thread_.GetCurrentLoadPercent();
 }
@@ -97,7 +97,9 @@ class CallerOwnedPayloadBlocking final
 
 }  // namespace impl
 
+class IoUring;
 class Thread;
+class TimerWheel;
 
 class ThreadControlBase {
  public:
@@ -129,6 +131,12 @@ class ThreadControlBase {
 
   bool IsInEvThread() const noexcept;
 
+  /// Returns nullptr if io_uring is disabled for the thread
+  IoUring* GetIoUring() const noexcept;
+
+  /// Returns nullptr if the thread does not defer events
+  TimerWheel* GetTimerWheel() const noexcept;
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
@@ -38,8 +38,10 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
               fmt::format("{}_{}", config.thread_name, index);
           return (use_ev_default_loop && index == 0)
                      ? Thread(thread_name, Thread::kUseDefaultEvLoop,
-                              register_timer_event_mode)
-                     : Thread(thread_name, register_timer_event_mode);
+                              register_timer_event_mode, config.cpu_affinity,
+                              config.io_engine)
+                     : Thread(thread_name, register_timer_event_mode,
+                              config.cpu_affinity, config.io_engine);
         });
 
     default_threads_.thread_controls = utils::GenerateFixedArray(
@@ -50,9 +52,10 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
 
   {
     timer_threads_.threads = utils::GenerateFixedArray(
-        config.dedicated_timer_threads, [](std::size_t index) {
+        config.dedicated_timer_threads, [&config](std::size_t index) {
           return Thread{fmt::format("ev-timer_{}", index),
-                        Thread::RegisterEventMode::kDeferred};
+                        Thread::RegisterEventMode::kDeferred,
+                        config.cpu_affinity};
         });
 
     // Although we expect to always have a dedicated timer thread[s]
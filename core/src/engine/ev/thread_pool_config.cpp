@@ -1,9 +1,22 @@
 #include "thread_pool_config.hpp"
 
+#include <userver/utils/trivial_map.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+IoEngine Parse(const yaml_config::YamlConfig& value,
+               formats::parse::To<IoEngine>) {
+  static constexpr utils::TrivialBiMap kMap([](auto selector) {
+    return selector()
+        .Case(IoEngine::kLibEv, "libev")
+        .Case(IoEngine::kIoUring, "io_uring");
+  });
+
+  return utils::ParseFromValueString(value, kMap);
+}
+
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ThreadPoolConfig>) {
   ThreadPoolConfig config;
@@ -13,6 +26,8 @@ ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
           config.dedicated_timer_threads);
   config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
   config.defer_events = value["defer_events"].As<bool>(config.defer_events);
+  config.cpu_affinity = engine::impl::ParseCpuAffinity(value);
+  config.io_engine = value["io_engine"].As<IoEngine>(config.io_engine);
   return config;
 }
 
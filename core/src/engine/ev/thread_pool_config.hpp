@@ -2,6 +2,7 @@
 
 #include <string>
 
+#include <engine/impl/cpu_affinity.hpp>
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
@@ -9,12 +10,22 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+enum class IoEngine {
+  kLibEv,
+  kIoUring,
+};
+
+IoEngine Parse(const yaml_config::YamlConfig& value,
+               formats::parse::To<IoEngine>);
+
 struct ThreadPoolConfig {
   std::size_t threads = 2;
   std::size_t dedicated_timer_threads = 0;
   std::string thread_name = "event-worker";
   bool ev_default_loop_disabled = false;
   bool defer_events = false;
+  engine::impl::CpuAffinityConfig cpu_affinity;
+  IoEngine io_engine{IoEngine::kLibEv};
 };
 
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
@@ -0,0 +1,134 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <algorithm>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+namespace {
+
+constexpr std::size_t kInitialExpiredCapacity = 1024;
+
+}  // namespace
+
+TimerWheel::TimerWheel(Clock::time_point start) : start_(start) {
+  expired_.reserve(kInitialExpiredCapacity);
+}
+
+TimerWheel::~TimerWheel() {
+  for (auto& slot : slots_) slot.clear();
+}
+
+void TimerWheel::Arm(Entry& entry, Deadline deadline) {
+  UASSERT(deadline.IsReachable());
+
+  // Rounding up, so that the entry never fires before the deadline
+  const auto expire_time = Clock::now() + deadline.TimeLeft();
+  const auto since_start = std::max(expire_time - start_, Clock::duration{0});
+  const auto expire_tick =
+      static_cast<std::uint64_t>((since_start + kTick - Clock::duration{1}) /
+                                 kTick);
+
+  const std::lock_guard lock(mutex_);
+  if (entry.hook_.is_linked()) {
+    slots_[entry.slot_].erase(List::s_iterator_to(entry));
+  } else {
+    ++armed_count_;
+  }
+  entry.expire_tick_ = expire_tick;
+  LinkLocked(entry);
+}
+
+bool TimerWheel::Disarm(Entry& entry) noexcept {
+  const std::lock_guard lock(mutex_);
+  if (!entry.hook_.is_linked()) return false;
+
+  slots_[entry.slot_].erase(List::s_iterator_to(entry));
+  --armed_count_;
+  return true;
+}
+
+void TimerWheel::Advance(Clock::time_point now) noexcept {
+  const auto target_tick = ToTick(now);
+  {
+    const std::lock_guard lock(mutex_);
+    while (current_tick_ < target_tick) {
+      ++current_tick_;
+      for (std::size_t level = kLevels - 1; level > 0; --level) {
+        const auto level_mask = (std::uint64_t{1} << (kSlotBits * level)) - 1;
+        if ((current_tick_ & level_mask) == 0) CascadeLocked(level);
+      }
+      ExpireSlotLocked();
+    }
+  }
+
+  for (auto* entry : expired_) entry->OnExpired();
+  expired_.clear();
+}
+
+std::size_t TimerWheel::GetArmedCount() const noexcept {
+  const std::lock_guard lock(mutex_);
+  return armed_count_;
+}
+
+std::uint64_t TimerWheel::ToTick(Clock::time_point tp) const noexcept {
+  if (tp <= start_) return 0;
+  return static_cast<std::uint64_t>((tp - start_) / kTick);
+}
+
+void TimerWheel::LinkLocked(Entry& entry) noexcept {
+  // Already expired entries fire on the next tick
+  auto target = std::max(entry.expire_tick_, current_tick_ + 1);
+  const auto delta = target - current_tick_;
+
+  std::size_t level = 0;
+  while (level < kLevels - 1 && (delta >> (kSlotBits * (level + 1))) != 0) {
+    ++level;
+  }
+  if ((delta >> (kSlotBits * kLevels)) != 0) {
+    // Beyond the wheel range, the entry is relinked on the last level
+    // expiration until its time comes
+    target = current_tick_ + (std::uint64_t{1} << (kSlotBits * kLevels)) - 1;
+  }
+
+  const auto index = (target >> (kSlotBits * level)) & (kSlots - 1);
+  entry.slot_ = static_cast<std::uint16_t>(level * kSlots + index);
+  slots_[entry.slot_].push_back(entry);
+}
+
+void TimerWheel::CascadeLocked(std::size_t level) noexcept {
+  const auto index = (current_tick_ >> (kSlotBits * level)) & (kSlots - 1);
+  List entries;
+  entries.swap(slots_[level * kSlots + index]);
+
+  while (!entries.empty()) {
+    auto& entry = entries.front();
+    entries.pop_front();
+    LinkLocked(entry);
+  }
+}
+
+void TimerWheel::ExpireSlotLocked() noexcept {
+  List entries;
+  entries.swap(slots_[current_tick_ & (kSlots - 1)]);
+
+  while (!entries.empty()) {
+    auto& entry = entries.front();
+    entries.pop_front();
+    if (entry.expire_tick_ > current_tick_) {
+      LinkLocked(entry);
+      continue;
+    }
+
+    --armed_count_;
+    entry.OnExpiredLocked();
+    expired_.push_back(&entry);
+  }
+}
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
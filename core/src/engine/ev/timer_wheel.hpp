@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <boost/intrusive/list.hpp>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// Hierarchical timing wheel with a 1ms tick, driven by the periodic timer of
+/// an ev::Thread in RegisterEventMode::kDeferred.
+///
+/// Arm() and Disarm() are O(1) and could be called from any thread, they do
+/// not touch the libev timers heap and do not wake up the ev thread. Expired
+/// entries are fired in batches from Advance(), so a timeout that is armed
+/// and then disarmed before the expiration costs only two list operations.
+class TimerWheel final {
+ public:
+  using Clock = Deadline::Clock;
+
+  static constexpr std::chrono::milliseconds kTick{1};
+
+  class Entry {
+   public:
+    Entry() = default;
+    Entry(const Entry&) = delete;
+    Entry& operator=(const Entry&) = delete;
+
+   protected:
+    ~Entry() = default;
+
+   private:
+    friend class TimerWheel;
+
+    /// Called under the wheel lock for an expired entry. Should only take the
+    /// ownership of the data required by OnExpired(), as the entry could be
+    /// disarmed and destroyed right after the lock is released.
+    virtual void OnExpiredLocked() noexcept = 0;
+
+    /// Called without the wheel lock in the ev thread after
+    /// OnExpiredLocked(). The entry must keep itself alive until then.
+    virtual void OnExpired() noexcept = 0;
+
+    using Hook = boost::intrusive::list_member_hook<>;
+
+    Hook hook_;
+    std::uint64_t expire_tick_{0};
+    std::uint16_t slot_{0};
+  };
+
+  explicit TimerWheel(Clock::time_point start = Clock::now());
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+  ~TimerWheel();
+
+  /// Arms the entry to fire via Advance() no earlier than the reachable
+  /// `deadline`. Re-arms an already armed entry.
+  void Arm(Entry& entry, Deadline deadline);
+
+  /// Disarms the entry, returns false if the entry was not armed or has
+  /// already been taken for firing.
+  bool Disarm(Entry& entry) noexcept;
+
+  /// Fires all the entries expired by `now`. Must be called from a single
+  /// thread, usually the ev thread from its periodic timer.
+  void Advance(Clock::time_point now = Clock::now()) noexcept;
+
+  std::size_t GetArmedCount() const noexcept;
+
+ private:
+  static constexpr std::size_t kSlotBits = 8;
+  static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+  static constexpr std::size_t kLevels = 4;
+
+  using List = boost::intrusive::list<
+      Entry,
+      boost::intrusive::member_hook<Entry, Entry::Hook, &Entry::hook_>,
+      boost::intrusive::constant_time_size<false>>;
+
+  std::uint64_t ToTick(Clock::time_point tp) const noexcept;
+  void LinkLocked(Entry& entry) noexcept;
+  void CascadeLocked(std::size_t level) noexcept;
+  void ExpireSlotLocked() noexcept;
+
+  const Clock::time_point start_;
+
+  mutable std::mutex mutex_;
+  std::array<List, kSlots * kLevels> slots_;
+  std::uint64_t current_tick_{0};
+  std::size_t armed_count_{0};
+
+  // entries taken for firing by the last Advance(), only used by its thread
+  std::vector<Entry*> expired_;
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,146 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <vector>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using engine::ev::TimerWheel;
+
+class TestEntry final : public TimerWheel::Entry {
+ public:
+  int locked_calls{0};
+  int fired{0};
+
+ private:
+  void OnExpiredLocked() noexcept override { ++locked_calls; }
+  void OnExpired() noexcept override {
+    EXPECT_EQ(locked_calls, fired + 1);
+    ++fired;
+  }
+};
+
+}  // namespace
+
+TEST(TimerWheel, FiresNotBeforeDeadline) {
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel{start};
+
+  TestEntry entry;
+  wheel.Arm(entry, engine::Deadline::FromDuration(50ms));
+  EXPECT_EQ(wheel.GetArmedCount(), 1);
+
+  wheel.Advance(start + 40ms);
+  EXPECT_EQ(entry.fired, 0);
+
+  wheel.Advance(start + 60ms);
+  EXPECT_EQ(entry.fired, 1);
+  EXPECT_EQ(wheel.GetArmedCount(), 0);
+
+  wheel.Advance(start + 100ms);
+  EXPECT_EQ(entry.fired, 1);
+}
+
+TEST(TimerWheel, PassedDeadlineFiresOnNextTick) {
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel{start};
+  wheel.Advance(start + 10ms);
+
+  TestEntry entry;
+  wheel.Arm(entry, engine::Deadline::Passed());
+  wheel.Advance(start + 11ms);
+  EXPECT_EQ(entry.fired, 1);
+}
+
+TEST(TimerWheel, Disarm) {
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel{start};
+
+  TestEntry entry;
+  EXPECT_FALSE(wheel.Disarm(entry));
+
+  wheel.Arm(entry, engine::Deadline::FromDuration(10ms));
+  EXPECT_TRUE(wheel.Disarm(entry));
+  EXPECT_FALSE(wheel.Disarm(entry));
+  EXPECT_EQ(wheel.GetArmedCount(), 0);
+
+  wheel.Advance(start + 1s);
+  EXPECT_EQ(entry.fired, 0);
+  EXPECT_EQ(entry.locked_calls, 0);
+}
+
+TEST(TimerWheel, Rearm) {
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel{start};
+
+  TestEntry entry;
+  wheel.Arm(entry, engine::Deadline::FromDuration(10ms));
+  wheel.Arm(entry, engine::Deadline::FromDuration(500ms));
+  EXPECT_EQ(wheel.GetArmedCount(), 1);
+
+  wheel.Advance(start + 400ms);
+  EXPECT_EQ(entry.fired, 0);
+  wheel.Advance(start + 600ms);
+  EXPECT_EQ(entry.fired, 1);
+
+  wheel.Arm(entry, engine::Deadline::FromDuration(50ms));
+  EXPECT_EQ(entry.fired, 1);
+  EXPECT_TRUE(wheel.Disarm(entry));
+}
+
+TEST(TimerWheel, CascadesThroughLevels) {
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel{start};
+
+  std::vector<TestEntry> entries(4);
+  wheel.Arm(entries[0], engine::Deadline::FromDuration(200ms));
+  wheel.Arm(entries[1], engine::Deadline::FromDuration(3s));
+  wheel.Arm(entries[2], engine::Deadline::FromDuration(70s));
+  wheel.Arm(entries[3], engine::Deadline::FromDuration(20min));
+  EXPECT_EQ(wheel.GetArmedCount(), 4);
+
+  const std::vector<std::chrono::milliseconds> before = {199ms, 2999ms, 69s,
+                                                         19min};
+  const std::vector<std::chrono::milliseconds> after = {220ms, 3020ms, 70020ms,
+                                                        1200020ms};
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    wheel.Advance(start + before[i]);
+    EXPECT_EQ(entries[i].fired, 0) << i;
+    wheel.Advance(start + after[i]);
+    EXPECT_EQ(entries[i].fired, 1) << i;
+  }
+  EXPECT_EQ(wheel.GetArmedCount(), 0);
+}
+
+TEST(TimerWheel, BeyondRange) {
+  const auto start = TimerWheel::Clock::now();
+  TimerWheel wheel{start};
+
+  TestEntry entry;
+  wheel.Arm(entry, engine::Deadline::FromDuration(24h * 100));
+  wheel.Advance(start + 1s);
+  EXPECT_EQ(entry.fired, 0);
+  EXPECT_TRUE(wheel.Disarm(entry));
+}
+
+UTEST(TimerWheel, SleepsAndTimeouts) {
+  for (const auto duration : {25ms, 50ms}) {
+    const auto before = std::chrono::steady_clock::now();
+    engine::SleepFor(duration);
+    EXPECT_GE(std::chrono::steady_clock::now() - before, duration);
+  }
+
+  engine::SingleConsumerEvent event;
+  EXPECT_FALSE(event.WaitForEventFor(30ms));
+  event.Send();
+  EXPECT_TRUE(event.WaitForEventFor(10min));
+}
+
+USERVER_NAMESPACE_END
@@ -3,12 +3,15 @@
 #include <condition_variable>
 #include <future>
 #include <mutex>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/completion_set.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/wait_any.hpp>
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -136,4 +139,42 @@ void future_coro_set_and_get(benchmark::State& state) {
 }
 BENCHMARK(future_coro_set_and_get);
 
+// Drains range(0) tasks one by one as they complete
+void future_wait_any_drain(benchmark::State& state) {
+  const auto task_count = static_cast<std::size_t>(state.range(0));
+  engine::RunStandalone(4, [&] {
+    for ([[maybe_unused]] auto _ : state) {
+      std::vector<engine::TaskWithResult<std::size_t>> tasks;
+      tasks.reserve(task_count);
+      for (std::size_t i = 0; i < task_count; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([i] { return i; }));
+      }
+      for (std::size_t i = 0; i < task_count; ++i) {
+        const auto index = engine::WaitAny(tasks);
+        UASSERT(index);
+        benchmark::DoNotOptimize(tasks[*index].Get());
+      }
+    }
+  });
+  state.SetItemsProcessed(state.iterations() * task_count);
+}
+BENCHMARK(future_wait_any_drain)->RangeMultiplier(4)->Range(16, 4096);
+
+void future_completion_set_drain(benchmark::State& state) {
+  const auto task_count = static_cast<std::size_t>(state.range(0));
+  engine::RunStandalone(4, [&] {
+    for ([[maybe_unused]] auto _ : state) {
+      engine::CompletionSet<std::size_t> set;
+      for (std::size_t i = 0; i < task_count; ++i) {
+        set.AsyncNoSpan([i] { return i; });
+      }
+      while (const auto index = set.WaitNext()) {
+        benchmark::DoNotOptimize(set.GetTask(*index).Get());
+      }
+    }
+  });
+  state.SetItemsProcessed(state.iterations() * task_count);
+}
+BENCHMARK(future_completion_set_drain)->RangeMultiplier(4)->Range(16, 4096);
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+inline void CpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+/// Bounded spinning for the primitives with short critical sections, in the
+/// spirit of glibc PTHREAD_MUTEX_ADAPTIVE_NP: the limit of iterations follows
+/// the number of iterations that the recent spins took. The caller stops the
+/// spinning right away if waiting for the lock makes no sense, e.g. when its
+/// owner sleeps with the lock held.
+class AdaptiveSpinner final {
+ public:
+  static constexpr std::int32_t kMaxSpins = 100;
+
+  /// Calls `try_lock()` until it succeeds, the learned limit is reached or
+  /// `keep_spinning()` returns false. `keep_spinning()` is checked once in a
+  /// few iterations, it may be relatively expensive.
+  /// @returns the result of the last `try_lock()`
+  template <typename TryLock, typename KeepSpinning>
+  bool Spin(TryLock try_lock, KeepSpinning keep_spinning) noexcept {
+    const auto estimate = estimate_.load(std::memory_order_relaxed);
+    const auto max_spins = std::min(kMaxSpins, estimate * 2 + kMinSpins);
+
+    for (std::int32_t spins = 0; spins < max_spins; ++spins) {
+      if (spins % kKeepSpinningCheckPeriod == 0 && !keep_spinning()) {
+        // The owner is not going to release the lock soon, nothing to learn
+        return false;
+      }
+      CpuRelax();
+      if (try_lock()) {
+        Learn(estimate, spins + 1);
+        return true;
+      }
+    }
+
+    Learn(estimate, max_spins);
+    return false;
+  }
+
+ private:
+  static constexpr std::int32_t kMinSpins = 10;
+  static constexpr std::int32_t kKeepSpinningCheckPeriod = 8;
+
+  void Learn(std::int32_t estimate, std::int32_t spins) noexcept {
+    estimate_.store(estimate + (spins - estimate) / 8,
+                    std::memory_order_relaxed);
+  }
+
+  std::atomic<std::int32_t> estimate_{0};
+};
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -22,7 +22,7 @@ class CvWaitStrategy final : public WaitStrategy {
  public:
   CvWaitStrategy(Deadline deadline, WaitList& waiters, TaskContext& current,
                  std::unique_lock<MutexType>& mutex_lock) noexcept
-      : WaitStrategy(deadline),
+      : WaitStrategy(deadline, WaitReason::kConditionVariable),
         waiters_(waiters),
         waiter_token_(waiters_),
         current_(current),
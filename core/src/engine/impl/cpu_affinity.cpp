@@ -0,0 +1,73 @@
+#include <engine/impl/cpu_affinity.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/threads.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+void CheckCpusAvailable(const std::vector<std::size_t>& cpus,
+                        const yaml_config::YamlConfig& value) {
+  const auto available = utils::GetCurrentThreadAffinity();
+  for (const auto cpu : cpus) {
+    if (!std::binary_search(available.begin(), available.end(), cpu)) {
+      throw std::runtime_error(fmt::format(
+          "CPU {} at '{}' is not available to the process, available CPUs: {}",
+          cpu, value.GetPath(), fmt::join(available, ",")));
+    }
+  }
+}
+
+}  // namespace
+
+CpuAffinityConfig ParseCpuAffinity(const yaml_config::YamlConfig& value) {
+  CpuAffinityConfig config;
+
+  const auto cpu_affinity = value["cpu-affinity"];
+  const auto numa_node = value["numa-node"];
+  if (!cpu_affinity.IsMissing() && !numa_node.IsMissing()) {
+    throw std::runtime_error(fmt::format(
+        "Only one of 'cpu-affinity' and 'numa-node' may be specified at '{}'",
+        value.GetPath()));
+  }
+
+  if (!cpu_affinity.IsMissing()) {
+    config.cpus = utils::ParseCpuList(cpu_affinity.As<std::string>());
+    if (config.cpus.empty()) {
+      throw std::runtime_error(fmt::format("Empty CPU list at '{}'",
+                                           cpu_affinity.GetPath()));
+    }
+  } else if (!numa_node.IsMissing()) {
+    config.numa_node = numa_node.As<std::size_t>();
+    config.cpus = utils::GetNumaNodeCpus(*config.numa_node);
+  }
+
+  if (!config.cpus.empty()) CheckCpusAvailable(config.cpus, value);
+  return config;
+}
+
+void ApplyCpuAffinity(const CpuAffinityConfig& config) noexcept {
+  if (config.cpus.empty()) return;
+  try {
+    utils::SetCurrentThreadAffinity(config.cpus);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to pin the thread to CPUs "
+                << fmt::format("{}", fmt::join(config.cpus, ",")) << ": "
+                << ex;
+  }
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
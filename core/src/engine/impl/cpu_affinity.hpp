@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+/// CPUs to pin OS threads to. Empty `cpus` means no pinning.
+struct CpuAffinityConfig {
+  std::vector<std::size_t> cpus;
+  std::optional<std::size_t> numa_node;
+};
+
+/// Parses the `cpu-affinity` and `numa-node` options of `value`. NUMA node
+/// is resolved into its CPUs right away. Throws if some of the CPUs are not
+/// available to the process.
+CpuAffinityConfig ParseCpuAffinity(const yaml_config::YamlConfig& value);
+
+/// Pins the current thread to the CPUs, does nothing if no CPUs are set.
+/// Runs at the start of the threads, so a failure is logged, not thrown.
+void ApplyCpuAffinity(const CpuAffinityConfig& config) noexcept;
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,447 @@
+#include <engine/impl/cpu_profiler.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include <boost/stacktrace/frame.hpp>
+#include <fmt/format.h>
+
+#include <engine/task/task_context.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <utils/check_syscall.hpp>
+
+#if defined(__linux__) && !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+// ~5 seconds of samples at 100Hz between the Collect() calls
+constexpr std::size_t kMaxSamplesPerThread = 512;
+constexpr std::size_t kMaxFrames = 62;
+// the signal handler and the signal trampoline
+constexpr std::size_t kSkippedFrames = 2;
+// further stacks are dropped to bound the memory usage
+constexpr std::size_t kMaxStacks = 100'000;
+
+constexpr std::string_view kNoSpan = "[no span]";
+
+std::atomic<bool> is_running{false};
+// incremented on each Start(), so that stale span names are not used
+std::atomic<std::uint32_t> running_epoch{0};
+
+std::uint8_t CopyName(std::string_view name, char* out) noexcept {
+  const auto size = std::min(name.size(), CpuProfilerTag::kMaxNameSize);
+  std::memcpy(out, name.data(), size);
+  return static_cast<std::uint8_t>(size);
+}
+
+// Folded stacks use ';' as the frames separator
+void AppendFrame(std::string& out, std::string_view frame) {
+  out.push_back(';');
+  const auto start = out.size();
+  out.append(frame);
+  std::replace(out.begin() + start, out.end(), ';', ':');
+}
+
+}  // namespace
+
+void CpuProfilerTag::Set(std::uint32_t new_epoch, std::string_view root_span,
+                         std::string_view current_span) noexcept {
+  const auto old_generation = generation.load(std::memory_order_relaxed);
+  generation.store(old_generation + 1, std::memory_order_relaxed);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+
+  epoch = new_epoch;
+  root_span_size = CopyName(root_span, this->root_span);
+  current_span_size = CopyName(current_span, this->current_span);
+
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  generation.store(old_generation + 2, std::memory_order_relaxed);
+}
+
+struct CpuProfiler::ThreadSamples final {
+  struct Sample final {
+    std::uint8_t frames_count;
+    std::uint8_t root_span_size;
+    std::uint8_t current_span_size;
+    char root_span[CpuProfilerTag::kMaxNameSize];
+    char current_span[CpuProfilerTag::kMaxNameSize];
+    void* frames[kMaxFrames];
+  };
+
+  // Single producer (the signal handler), single consumer (Collect()).
+  // Allocated once the profiler is started for the thread.
+  std::unique_ptr<Sample[]> samples;
+  std::atomic<std::size_t> write_index{0};
+  std::atomic<std::size_t> read_index{0};
+  std::atomic<std::uint64_t> dropped{0};
+
+#ifdef __linux__
+  pthread_t thread{};
+  pid_t tid{0};
+  timer_t timer{};
+#endif
+  bool has_timer{false};
+};
+
+namespace {
+
+thread_local CpuProfiler::ThreadSamples* current_thread_samples = nullptr;
+
+#ifdef __linux__
+void FillSpans(CpuProfiler::ThreadSamples::Sample& sample) noexcept {
+  sample.root_span_size = 0;
+  sample.current_span_size = 0;
+
+  const auto* const context = current_task::GetCurrentTaskContextUnchecked();
+  if (!context) return;
+  const auto* const tag = context->GetCpuProfilerTagUnchecked();
+  if (!tag) return;
+
+  const auto generation = tag->generation.load(std::memory_order_relaxed);
+  // the signal interrupted CpuProfilerTag::Set()
+  if (generation % 2 != 0) return;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  if (tag->epoch != running_epoch.load(std::memory_order_relaxed)) return;
+
+  sample.root_span_size = tag->root_span_size;
+  sample.current_span_size = tag->current_span_size;
+  std::memcpy(sample.root_span, tag->root_span, tag->root_span_size);
+  std::memcpy(sample.current_span, tag->current_span, tag->current_span_size);
+}
+
+// Runs in a signal handler: only async-signal-safe functions and lock-free
+// atomics here. backtrace() is the single exception: it is not
+// async-signal-safe in general and is only safe here because of the warm-up
+// in CpuProfiler(). Do not add other calls that may allocate or take locks.
+void HandleSigprof(int, siginfo_t*, void*) noexcept {
+  const auto saved_errno = errno;
+
+  auto* const thread = current_thread_samples;
+  if (thread && thread->samples && is_running.load(std::memory_order_relaxed)) {
+    const auto write = thread->write_index.load(std::memory_order_relaxed);
+    const auto read = thread->read_index.load(std::memory_order_acquire);
+    if (write - read >= kMaxSamplesPerThread) {
+      thread->dropped.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      auto& sample = thread->samples[write % kMaxSamplesPerThread];
+      sample.frames_count = static_cast<std::uint8_t>(
+          ::backtrace(sample.frames, static_cast<int>(kMaxFrames)));
+      FillSpans(sample);
+      thread->write_index.store(write + 1, std::memory_order_release);
+    }
+  }
+
+  errno = saved_errno;
+}
+#endif
+
+}  // namespace
+
+CpuProfiler::CpuProfiler() {
+#ifdef __linux__
+  // The first backtrace() call loads libgcc with dlopen() and allocates, which
+  // is not async-signal-safe. The profiler is created by the first task
+  // processor thread on startup, long before the SIGPROF handler is
+  // installed, so the handler only ever runs the non-allocating unwinding.
+  void* frames[1];
+  ::backtrace(frames, 1);
+#endif
+}
+
+CpuProfiler::~CpuProfiler() = default;
+
+CpuProfiler& CpuProfiler::Get() {
+  // not destroyed, the signal handler may run until the process exits
+  static auto* const profiler = new CpuProfiler();
+  return *profiler;
+}
+
+bool CpuProfiler::IsRunning() noexcept {
+  return is_running.load(std::memory_order_relaxed);
+}
+
+void CpuProfiler::SetCurrentSpans(std::string_view root_span,
+                                  std::string_view current_span) noexcept {
+  if (!IsRunning()) return;
+
+  auto* const context = current_task::GetCurrentTaskContextUnchecked();
+  if (!context) return;
+  auto* const tag = context->GetCpuProfilerTag();
+  if (!tag) return;
+
+  tag->Set(running_epoch.load(std::memory_order_relaxed), root_span,
+           current_span);
+}
+
+void CpuProfiler::Start(std::chrono::microseconds period) {
+#ifdef __linux__
+  UINVARIANT(period.count() > 0, "CPU profiler period must be positive");
+
+  std::lock_guard lock{mutex_};
+  if (IsRunning()) return;
+
+  if (!is_signal_handler_installed_) {
+    struct sigaction action {};
+    action.sa_sigaction = &HandleSigprof;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    utils::CheckSyscall(::sigaction(SIGPROF, &action, nullptr),
+                        "installing SIGPROF handler");
+    // The handler is never uninstalled: the default action of SIGPROF is to
+    // terminate the process, and the signals may still be pending after
+    // the timers are deleted
+    is_signal_handler_installed_ = true;
+  }
+
+  period_ = period;
+  running_epoch.fetch_add(1, std::memory_order_relaxed);
+  is_running.store(true, std::memory_order_relaxed);
+
+  try {
+    for (const auto& thread : threads_) StartTimer(*thread);
+  } catch (const std::exception&) {
+    is_running.store(false, std::memory_order_relaxed);
+    for (const auto& thread : threads_) {
+      if (thread->has_timer) {
+        ::timer_delete(thread->timer);
+        thread->has_timer = false;
+      }
+    }
+    throw;
+  }
+
+  LOG_INFO() << "CPU profiler started for " << threads_.size()
+             << " threads with period " << period.count() << "us";
+#else
+  (void)period;
+  throw std::runtime_error("CPU profiler is only supported on Linux");
+#endif
+}
+
+void CpuProfiler::Stop() noexcept {
+  std::lock_guard lock{mutex_};
+  if (!IsRunning()) return;
+
+  is_running.store(false, std::memory_order_relaxed);
+#ifdef __linux__
+  for (const auto& thread : threads_) {
+    if (thread->has_timer) {
+      ::timer_delete(thread->timer);
+      thread->has_timer = false;
+    }
+  }
+#endif
+
+  LOG_INFO() << "CPU profiler stopped";
+}
+
+void CpuProfiler::RegisterCurrentThread() {
+  UASSERT(!current_thread_samples);
+
+  auto thread = std::make_unique<ThreadSamples>();
+#ifdef __linux__
+  thread->thread = ::pthread_self();
+  thread->tid = static_cast<pid_t>(::syscall(SYS_gettid));
+#endif
+
+  std::lock_guard lock{mutex_};
+  if (IsRunning()) {
+    try {
+      StartTimer(*thread);
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to start CPU profiler for a thread: " << ex;
+    }
+  }
+  current_thread_samples = thread.get();
+  threads_.push_back(std::move(thread));
+}
+
+void CpuProfiler::UnregisterCurrentThread() noexcept {
+  auto* const thread = current_thread_samples;
+  if (!thread) return;
+
+  std::lock_guard lock{mutex_};
+#ifdef __linux__
+  if (thread->has_timer) ::timer_delete(thread->timer);
+#endif
+  // a pending signal may still be delivered
+  current_thread_samples = nullptr;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+
+  const auto it =
+      std::find_if(threads_.begin(), threads_.end(),
+                   [thread](const auto& ptr) { return ptr.get() == thread; });
+  UASSERT(it != threads_.end());
+  if (it != threads_.end()) threads_.erase(it);
+}
+
+void CpuProfiler::Collect() {
+  std::lock_guard lock{mutex_};
+  CollectUnlocked();
+}
+
+std::string CpuProfiler::DumpFolded(bool reset) {
+  std::lock_guard lock{mutex_};
+  CollectUnlocked();
+
+  std::string result;
+  std::string line;
+  for (const auto& [key, count] : stacks_) {
+    // see CollectUnlocked() for the key layout
+    const auto root_size = static_cast<std::uint8_t>(key[0]);
+    const auto current_size = static_cast<std::uint8_t>(key[1]);
+    const std::string_view root_span{key.data() + 2, root_size};
+    const std::string_view current_span{key.data() + 2 + root_size,
+                                        current_size};
+    const auto* const frames_begin = key.data() + 2 + root_size + current_size;
+    const auto frames_count =
+        (key.size() - 2 - root_size - current_size) / sizeof(void*);
+
+    line.clear();
+    AppendFrame(line, root_span.empty() ? kNoSpan : root_span);
+    if (!current_span.empty() && current_span != root_span) {
+      AppendFrame(line, current_span);
+    }
+    for (std::size_t i = frames_count; i > 0; --i) {
+      void* address = nullptr;
+      std::memcpy(&address, frames_begin + (i - 1) * sizeof(void*),
+                  sizeof(void*));
+      AppendFrame(line, Symbolize(address));
+    }
+
+    // skip the leading ';'
+    result.append(line, 1);
+    fmt::format_to(std::back_inserter(result), " {}\n", count);
+  }
+
+  if (reset) ResetUnlocked();
+  return result;
+}
+
+CpuProfiler::Stats CpuProfiler::GetStats() {
+  std::lock_guard lock{mutex_};
+  CollectUnlocked();
+
+  Stats stats;
+  stats.is_running = IsRunning();
+  stats.threads = threads_.size();
+  stats.samples = samples_;
+  stats.dropped_samples = dropped_samples_;
+  stats.stacks = stacks_.size();
+  return stats;
+}
+
+void CpuProfiler::StartTimer([[maybe_unused]] ThreadSamples& thread) {
+#ifdef __linux__
+  UASSERT(!thread.has_timer);
+  if (!thread.samples) {
+    thread.samples = std::make_unique<ThreadSamples::Sample[]>(
+        kMaxSamplesPerThread);
+  }
+
+  clockid_t clock{};
+  const auto error = ::pthread_getcpuclockid(thread.thread, &clock);
+  if (error) {
+    throw std::system_error(error, std::system_category(),
+                            "pthread_getcpuclockid");
+  }
+
+  sigevent event{};
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = thread.tid;
+  utils::CheckSyscall(::timer_create(clock, &event, &thread.timer),
+                      "creating CPU profiler timer");
+
+  const auto seconds = period_.count() / 1'000'000;
+  const auto nanoseconds = (period_.count() % 1'000'000) * 1'000;
+  itimerspec spec{};
+  spec.it_interval.tv_sec = seconds;
+  spec.it_interval.tv_nsec = nanoseconds;
+  spec.it_value = spec.it_interval;
+  if (::timer_settime(thread.timer, 0, &spec, nullptr) == -1) {
+    const auto saved_errno = errno;
+    ::timer_delete(thread.timer);
+    throw std::system_error(saved_errno, std::system_category(),
+                            "starting CPU profiler timer");
+  }
+  thread.has_timer = true;
+#endif
+}
+
+void CpuProfiler::CollectUnlocked() {
+  std::string key;
+  for (const auto& thread : threads_) {
+    if (!thread->samples) continue;
+    dropped_samples_ += thread->dropped.exchange(0, std::memory_order_relaxed);
+
+    const auto read = thread->read_index.load(std::memory_order_relaxed);
+    const auto write = thread->write_index.load(std::memory_order_acquire);
+    for (auto i = read; i != write; ++i) {
+      const auto& sample = thread->samples[i % kMaxSamplesPerThread];
+      const auto frames_count =
+          std::max<std::size_t>(sample.frames_count, kSkippedFrames);
+
+      // root span size, current span size, root span, current span, frames
+      key.clear();
+      key.push_back(static_cast<char>(sample.root_span_size));
+      key.push_back(static_cast<char>(sample.current_span_size));
+      key.append(sample.root_span, sample.root_span_size);
+      key.append(sample.current_span, sample.current_span_size);
+      key.append(reinterpret_cast<const char*>(sample.frames + kSkippedFrames),
+                 (frames_count - kSkippedFrames) * sizeof(void*));
+
+      ++samples_;
+      if (stacks_.size() < kMaxStacks) {
+        ++stacks_[key];
+      } else if (const auto it = stacks_.find(key); it != stacks_.end()) {
+        ++it->second;
+      } else {
+        ++dropped_samples_;
+      }
+    }
+    thread->read_index.store(write, std::memory_order_release);
+  }
+}
+
+void CpuProfiler::ResetUnlocked() noexcept {
+  stacks_.clear();
+  samples_ = 0;
+  dropped_samples_ = 0;
+}
+
+const std::string& CpuProfiler::Symbolize(void* address) {
+  auto [it, inserted] = symbols_.try_emplace(address);
+  if (inserted) {
+    // the return address points to the instruction after the call
+    const auto call_address = reinterpret_cast<std::uintptr_t>(address) - 1;
+    auto name =
+        boost::stacktrace::frame(reinterpret_cast<const void*>(call_address))
+            .name();
+    if (name.empty()) name = fmt::format("{}", address);
+    it->second = std::move(name);
+  }
+  return it->second;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
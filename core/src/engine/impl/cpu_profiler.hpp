@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+/// Names of the spans of a task the CPU samples are attributed to. Written
+/// by the task, read by the SIGPROF handler on the same thread.
+struct CpuProfilerTag final {
+  static constexpr std::size_t kMaxNameSize = 64;
+
+  void Set(std::uint32_t epoch, std::string_view root_span,
+           std::string_view current_span) noexcept;
+
+  // odd while the names are updated
+  std::atomic<std::uint32_t> generation{0};
+  // CpuProfiler::Start() epoch the names were set in
+  std::uint32_t epoch{0};
+  std::uint8_t root_span_size{0};
+  std::uint8_t current_span_size{0};
+  char root_span[kMaxNameSize];
+  char current_span[kMaxNameSize];
+};
+
+/// @brief Process-wide sampling CPU profiler of the task processor threads.
+///
+/// A per-thread CPU time timer sends SIGPROF to the worker thread, the signal
+/// handler stores the stacktrace and the names of the root and the current
+/// span of the running task into a preallocated per-thread buffer. Collect()
+/// aggregates the buffered samples, DumpFolded() symbolizes them into
+/// the folded stacks format of flamegraph.pl.
+///
+/// Linux only.
+class CpuProfiler final {
+ public:
+  struct Stats final {
+    bool is_running{false};
+    std::size_t threads{0};
+    std::uint64_t samples{0};
+    std::uint64_t dropped_samples{0};
+    std::size_t stacks{0};
+  };
+
+  static CpuProfiler& Get();
+
+  /// Cheap check, whether the span names should be tracked
+  static bool IsRunning() noexcept;
+
+  /// Remembers the span names of the current task for the samples
+  static void SetCurrentSpans(std::string_view root_span,
+                              std::string_view current_span) noexcept;
+
+  /// @throws std::runtime_error if the timers could not be created
+  void Start(std::chrono::microseconds period);
+  void Stop() noexcept;
+
+  /// Must be called on the worker thread before it runs any tasks
+  void RegisterCurrentThread();
+  /// Must be called on the worker thread after it has run all its tasks
+  void UnregisterCurrentThread() noexcept;
+
+  /// Moves the samples from the per-thread buffers into the aggregate
+  void Collect();
+
+  /// Collects the samples and outputs the aggregate as
+  /// `root_span;current_span;outer_frame;...;inner_frame count` lines
+  std::string DumpFolded(bool reset);
+
+  Stats GetStats();
+
+  struct ThreadSamples;
+
+ private:
+  CpuProfiler();
+  ~CpuProfiler();
+
+  void StartTimer(ThreadSamples& thread);
+  void CollectUnlocked();
+  void ResetUnlocked() noexcept;
+  const std::string& Symbolize(void* address);
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<ThreadSamples>> threads_;
+  std::chrono::microseconds period_{0};
+  bool is_signal_handler_installed_{false};
+
+  // raw sample key -> count
+  std::unordered_map<std::string, std::uint64_t> stacks_;
+  std::unordered_map<void*, std::string> symbols_;
+  std::uint64_t samples_{0};
+  std::uint64_t dropped_samples_{0};
+};
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
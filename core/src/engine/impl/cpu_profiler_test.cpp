@@ -0,0 +1,78 @@
+#include <engine/impl/cpu_profiler.hpp>
+
+#include <chrono>
+#include <cmath>
+
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/scope_guard.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+#ifdef __linux__
+
+namespace {
+
+using engine::impl::CpuProfiler;
+
+double BurnCpu(std::chrono::milliseconds duration) {
+  volatile double result = 0;
+  const auto deadline = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < deadline) {
+    for (int i = 0; i < 1000; ++i) result = result + std::sqrt(i);
+  }
+  return result;
+}
+
+}  // namespace
+
+UTEST(CpuProfiler, AttributesSamplesToSpans) {
+  auto& profiler = CpuProfiler::Get();
+  profiler.DumpFolded(/*reset=*/true);
+
+  profiler.Start(1ms);
+  const utils::ScopeGuard stop([&profiler] { profiler.Stop(); });
+  EXPECT_TRUE(CpuProfiler::IsRunning());
+
+  {
+    tracing::Span root_span{"cpu_profiler_root"};
+    tracing::Span span{"cpu_profiler_child"};
+    BurnCpu(300ms);
+  }
+  BurnCpu(100ms);
+  profiler.Stop();
+  EXPECT_FALSE(CpuProfiler::IsRunning());
+
+  const auto stats = profiler.GetStats();
+  EXPECT_GT(stats.samples, 0);
+  EXPECT_GE(stats.threads, 1);
+
+  const auto folded = profiler.DumpFolded(/*reset=*/true);
+  EXPECT_NE(folded.find("cpu_profiler_root;cpu_profiler_child;"),
+            std::string::npos)
+      << folded;
+
+  EXPECT_EQ(profiler.GetStats().samples, 0);
+  EXPECT_TRUE(profiler.DumpFolded(/*reset=*/false).empty());
+}
+
+UTEST(CpuProfiler, RestartIgnoresStaleSpans) {
+  auto& profiler = CpuProfiler::Get();
+  profiler.DumpFolded(/*reset=*/true);
+
+  tracing::Span span{"cpu_profiler_before_start"};
+  profiler.Start(1ms);
+  const utils::ScopeGuard stop([&profiler] { profiler.Stop(); });
+  BurnCpu(200ms);
+  profiler.Stop();
+
+  const auto folded = profiler.DumpFolded(/*reset=*/true);
+  EXPECT_EQ(folded.find("cpu_profiler_before_start"), std::string::npos)
+      << folded;
+}
+
+#endif
+
+USERVER_NAMESPACE_END
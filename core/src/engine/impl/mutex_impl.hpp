@@ -6,9 +6,11 @@
 
 #include <userver/utils/assert.hpp>
 
+#include <engine/impl/adaptive_spinner.hpp>
 #include <engine/impl/wait_list.hpp>
 #include <engine/impl/wait_list_light.hpp>
 #include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -37,10 +39,12 @@ class MutexImpl {
   class MutexWaitStrategy;
 
   bool LockFastPath(TaskContext&) noexcept;
+  bool LockSpinning(TaskContext&) noexcept;
   bool LockSlowPath(TaskContext&, Deadline);
 
   std::atomic<TaskContext*> owner_;
   Waiters lock_waiters_;
+  AdaptiveSpinner spinner_;
 };
 
 template <>
@@ -48,7 +52,7 @@ class MutexImpl<WaitList>::MutexWaitStrategy final : public WaitStrategy {
  public:
   MutexWaitStrategy(MutexImpl<WaitList>& mutex, TaskContext& current,
                     Deadline deadline)
-      : WaitStrategy(deadline),
+      : WaitStrategy(deadline, WaitReason::kMutex),
         mutex_(mutex),
         current_(current),
         waiter_token_(mutex_.lock_waiters_),
@@ -76,7 +80,9 @@ class MutexImpl<WaitListLight>::MutexWaitStrategy final : public WaitStrategy {
  public:
   MutexWaitStrategy(MutexImpl<WaitListLight>& mutex, TaskContext& current,
                     Deadline deadline)
-      : WaitStrategy(deadline), mutex_(mutex), current_(current) {}
+      : WaitStrategy(deadline, WaitReason::kMutex),
+        mutex_(mutex),
+        current_(current) {}
 
   void SetupWakeups() override {
     mutex_.lock_waiters_.Append(&current_);
@@ -105,6 +111,23 @@ bool MutexImpl<Waiters>::LockFastPath(TaskContext& current) noexcept {
                                         std::memory_order_acquire);
 }
 
+template <class Waiters>
+bool MutexImpl<Waiters>::LockSpinning(TaskContext& current) noexcept {
+  // Parking and waking up costs much more than a short critical section, so
+  // it is worth to wait a bit for an owner that runs on another worker
+  return spinner_.Spin(
+      [&] {
+        return owner_.load(std::memory_order_relaxed) == nullptr &&
+               LockFastPath(current);
+      },
+      [&] {
+        const auto* owner = owner_.load(std::memory_order_relaxed);
+        return owner == nullptr ||
+               (owner != &current &&
+                current.GetTaskProcessor().IsRunningOnWorker(owner));
+      });
+}
+
 template <class Waiters>
 bool MutexImpl<Waiters>::LockSlowPath(TaskContext& current, Deadline deadline) {
   TaskContext* expected = nullptr;
@@ -156,7 +179,8 @@ bool MutexImpl<Waiters>::try_lock() {
 template <class Waiters>
 bool MutexImpl<Waiters>::try_lock_until(Deadline deadline) {
   auto& current = current_task::GetCurrentTaskContext();
-  return LockFastPath(current) || LockSlowPath(current, deadline);
+  return LockFastPath(current) || LockSpinning(current) ||
+         LockSlowPath(current, deadline);
 }
 
 }  // namespace engine::impl
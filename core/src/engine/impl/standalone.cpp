@@ -19,12 +19,17 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
   coro_config.initial_size = pools_config.initial_coro_pool_size;
   coro_config.max_size = pools_config.max_coro_pool_size;
   coro_config.stack_size = pools_config.coro_stack_size;
+  coro_config.stack_size_classes = pools_config.coro_stack_size_classes;
+  coro_config.stack_usage_sample_every =
+      pools_config.coro_stack_usage_sample_every;
 
   ev::ThreadPoolConfig ev_config;
   ev_config.threads = pools_config.ev_threads_num;
   ev_config.thread_name = pools_config.ev_thread_name;
   ev_config.ev_default_loop_disabled = pools_config.ev_default_loop_disabled;
   ev_config.defer_events = pools_config.defer_events;
+  ev_config.io_engine = pools_config.ev_use_io_uring ? ev::IoEngine::kIoUring
+                                                     : ev::IoEngine::kLibEv;
 
   return std::make_shared<TaskProcessorPools>(std::move(coro_config),
                                               std::move(ev_config));
@@ -32,10 +37,11 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
 
 TaskProcessorHolder TaskProcessorHolder::Make(
     std::size_t threads_num, std::string thread_name,
-    std::shared_ptr<TaskProcessorPools> pools) {
+    std::shared_ptr<TaskProcessorPools> pools, TaskQueueType task_queue) {
   TaskProcessorConfig config;
   config.worker_threads = threads_num;
   config.thread_name = std::move(thread_name);
+  config.task_queue = task_queue;
 
   return TaskProcessorHolder(
       std::make_unique<TaskProcessor>(std::move(config), std::move(pools)));
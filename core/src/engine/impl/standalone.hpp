@@ -14,6 +14,7 @@
 #include <memory>
 #include <string>
 
+#include <engine/task/task_processor_config.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/not_null.hpp>
@@ -31,7 +32,9 @@ class TaskProcessorHolder final {
  public:
   static TaskProcessorHolder Make(std::size_t threads_num,
                                   std::string thread_name,
-                                  std::shared_ptr<TaskProcessorPools> pools);
+                                  std::shared_ptr<TaskProcessorPools> pools,
+                                  TaskQueueType task_queue =
+                                      TaskQueueType::kGlobalTaskQueue);
 
   explicit TaskProcessorHolder(std::unique_ptr<TaskProcessor>&&);
 
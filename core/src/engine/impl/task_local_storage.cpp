@@ -1,5 +1,8 @@
 #include <userver/engine/impl/task_local_storage.hpp>
 
+#include <utility>
+#include <vector>
+
 #include <fmt/format.h>
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/list_hook.hpp>
@@ -54,6 +57,34 @@ using InheritedDataList = boost::intrusive::list<
 
 }  // namespace
 
+// Immutable set of inherited variables, shared by the child tasks of a task.
+// Holds a reference to each of the variables.
+struct InheritedSnapshot final {
+  InheritedSnapshot()
+      : data(std::make_unique<InheritedDataBase*[]>(variable_count)) {}
+
+  InheritedSnapshot(const InheritedSnapshot&) = delete;
+  InheritedSnapshot& operator=(const InheritedSnapshot&) = delete;
+
+  ~InheritedSnapshot() {
+    // Newest first, as in Storage::~Storage()
+    for (const Key key : boost::adaptors::reverse(keys)) {
+      data[key]->DeleteSelf();
+    }
+  }
+
+  void Add(InheritedDataBase& node) {
+    UASSERT(!data[node.GetKey()]);
+    node.AddRef();
+    data[node.GetKey()] = &node;
+    keys.push_back(node.GetKey());
+  }
+
+  std::unique_ptr<InheritedDataBase*[]> data;
+  // From the oldest to the newest variable
+  std::vector<Key> keys;
+};
+
 DataBase::DataBase(Deleter deleter) : deleter_(deleter) {}
 
 void DataBase::DeleteSelf() noexcept { deleter_(*this); }
@@ -73,6 +104,15 @@ struct Storage::Impl final {
   NormalDataList normal_data_storage;
   InheritedDataList inherited_data_storage;
 
+  // Inherited variables of the parent task, shared with its other children
+  // instead of being copied into `data`. Copied on the first modification of
+  // an inherited variable in this task.
+  std::shared_ptr<const InheritedSnapshot> parent_inherited;
+
+  // Own inherited variables for the child tasks, built on the first spawn
+  // and reset on modification of an inherited variable
+  std::shared_ptr<const InheritedSnapshot> inherited_snapshot;
+
   void DoSetGeneric(Key key, DataBase& node);
 };
 
@@ -99,40 +139,60 @@ Storage::~Storage() {
 void Storage::InheritFrom(Storage& other) {
   UASSERT(impl_->normal_data_storage.empty());
   UASSERT(impl_->inherited_data_storage.empty());
+  UASSERT(!impl_->parent_inherited);
 
-  if (!other.impl_->inherited_data_storage.empty() && !impl_->data) {
-    impl_->data = std::make_unique<DataPtr[]>(variable_count);
-  }
-
-  for (DataPtr& their_ptr :
-       other.impl_->inherited_data_storage | boost::adaptors::reversed) {
-    UASSERT(their_ptr.ptr);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
-    auto& node = static_cast<InheritedDataBase&>(*their_ptr.ptr);
-
-    InheritNode(node);
-  }
+  impl_->parent_inherited = other.GetInheritedSnapshot();
 }
 
 void Storage::InheritNodeIfExists(Storage& other, Key key) {
   UASSERT(key < variable_count);
 
   // we want to stop asap if there is nothing to copy
-  if (!other.impl_->data) {
-    return;
-  }
-  auto& their_ptr = other.impl_->data[key];
-  if (!their_ptr.ptr) {
+  DataBase* const their_data = other.GetGeneric(key);
+  if (!their_data) {
     return;
   }
 
+  CopyParentInherited();
   if (!impl_->data) {
     impl_->data = std::make_unique<DataPtr[]>(variable_count);
   }
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
-  auto& node = static_cast<InheritedDataBase&>(*their_ptr.ptr);
+  auto& node = static_cast<InheritedDataBase&>(*their_data);
 
   InheritNode(node);
+  impl_->inherited_snapshot.reset();
+}
+
+std::shared_ptr<const InheritedSnapshot> Storage::GetInheritedSnapshot() {
+  if (impl_->inherited_data_storage.empty()) return impl_->parent_inherited;
+  UASSERT(!impl_->parent_inherited);
+
+  if (!impl_->inherited_snapshot) {
+    auto snapshot = std::make_shared<InheritedSnapshot>();
+    for (DataPtr& ptr :
+         impl_->inherited_data_storage | boost::adaptors::reversed) {
+      UASSERT(ptr.ptr);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+      snapshot->Add(static_cast<InheritedDataBase&>(*ptr.ptr));
+    }
+    impl_->inherited_snapshot = std::move(snapshot);
+  }
+  return impl_->inherited_snapshot;
+}
+
+void Storage::CopyParentInherited() {
+  if (!impl_->parent_inherited) return;
+
+  // The only allocation happens before the parent is released, so that
+  // the variables stay visible if it throws
+  if (!impl_->data) {
+    impl_->data = std::make_unique<DataPtr[]>(variable_count);
+  }
+  const auto parent = std::exchange(impl_->parent_inherited, nullptr);
+  for (const Key key : parent->keys) {
+    InheritNode(*parent->data[key]);
+  }
 }
 
 void Storage::InheritNode(InheritedDataBase& node) {
@@ -148,13 +208,15 @@ void Storage::InheritNode(InheritedDataBase& node) {
 void Storage::InitializeFrom(Storage&& other) noexcept {
   UASSERT(impl_->normal_data_storage.empty());
   UASSERT(impl_->inherited_data_storage.empty());
+  UASSERT(!impl_->parent_inherited);
   impl_ = std::move(other.impl_);
 }
 
 DataBase* Storage::GetGeneric(Key key) noexcept {
   UASSERT(key < variable_count);
-  if (!impl_->data) return nullptr;
-  return impl_->data[key].ptr;
+  if (impl_->data && impl_->data[key].ptr) return impl_->data[key].ptr;
+  if (impl_->parent_inherited) return impl_->parent_inherited->data[key];
+  return nullptr;
 }
 
 void Storage::Impl::DoSetGeneric(Key key, DataBase& node) {
@@ -173,15 +235,21 @@ void Storage::SetGeneric(Key key, NormalDataBase& node,
 
 void Storage::SetGeneric(Key key, InheritedDataBase& node,
                          bool has_existing_variable) {
+  // The existing variable, if any, becomes own before being replaced
+  CopyParentInherited();
+  impl_->inherited_snapshot.reset();
   impl_->DoSetGeneric(key, node);
   if (!has_existing_variable) {
     impl_->inherited_data_storage.push_front(impl_->data[key]);
   }
 }
 
-void Storage::EraseInherited(Key key) noexcept {
+void Storage::EraseInherited(Key key) {
   UASSERT(key < variable_count);
-  if (!impl_->data) return;
+  if (!GetGeneric(key)) return;
+
+  CopyParentInherited();
+  impl_->inherited_snapshot.reset();
 
   auto& data_ptr = impl_->data[key];
   auto* const data = data_ptr.ptr;
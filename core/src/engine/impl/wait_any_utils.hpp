@@ -16,7 +16,9 @@ class WaitAnyWaitStrategy final : public WaitStrategy {
  public:
   WaitAnyWaitStrategy(Deadline deadline, utils::span<ContextAccessor*> targets,
                       TaskContext& current)
-      : WaitStrategy(deadline), current_(current), targets_(targets) {}
+      : WaitStrategy(deadline, WaitReason::kTask),
+        current_(current),
+        targets_(targets) {}
 
   void SetupWakeups() override {
     for (auto& target : targets_) {
@@ -3,6 +3,7 @@
 #include <boost/intrusive/list.hpp>
 
 #include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
 
 #include <userver/utils/assert.hpp>
 
@@ -74,6 +75,8 @@ void WaitList::WakeupOne(Lock& lock) {
 
 void WaitList::WakeupAll(Lock& lock) {
   UASSERT(lock);
+  // the woken up tasks are enqueued at once when the batch is destroyed
+  const TaskProcessor::ScheduleBatch schedule_batch;
   while (!waiting_contexts_->empty()) {
     boost::intrusive_ptr<impl::TaskContext> context(&waiting_contexts_->front(),
                                                     kAdopt);
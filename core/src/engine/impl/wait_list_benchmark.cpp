@@ -1,11 +1,17 @@
 #include <benchmark/benchmark.h>
 
 #include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/condition_variable.hpp>
 #include <userver/engine/impl/task_context_holder.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
 
 #include <engine/impl/wait_list.hpp>
 #include <engine/task/task_context.hpp>
@@ -197,4 +203,64 @@ BENCHMARK(wait_list_add_remove_contention_unbalanced)
     ->Unit(benchmark::kMillisecond)
     ->UseRealTime();
 
+// Wakes up range(0) tasks sleeping on a ConditionVariable with NotifyAll and
+// waits for all of them to go to sleep again
+void wait_list_broadcast(benchmark::State& state) {
+  const auto waiters_count = static_cast<std::size_t>(state.range(0));
+  engine::RunStandalone(state.range(1), [&] {
+    engine::Mutex mutex;
+    engine::ConditionVariable cv;
+    std::uint64_t generation = 0;
+    bool is_stopped = false;
+    std::size_t sleeping = 0;
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(waiters_count);
+    for (std::size_t i = 0; i < waiters_count; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        std::unique_lock lock{mutex};
+        while (!is_stopped) {
+          const auto seen_generation = generation;
+          ++sleeping;
+          const bool is_woken = cv.Wait(lock, [&] {
+            return generation != seen_generation || is_stopped;
+          });
+          if (!is_woken) return;
+        }
+      }));
+    }
+
+    const auto wait_all_sleeping = [&] {
+      while (true) {
+        {
+          const std::lock_guard lock{mutex};
+          if (sleeping == waiters_count) {
+            sleeping = 0;
+            ++generation;
+            return;
+          }
+        }
+        engine::Yield();
+      }
+    };
+
+    wait_all_sleeping();
+    for ([[maybe_unused]] auto _ : state) {
+      cv.NotifyAll();
+      wait_all_sleeping();
+    }
+
+    {
+      const std::lock_guard lock{mutex};
+      is_stopped = true;
+    }
+    cv.NotifyAll();
+    for (auto& task : tasks) task.Get();
+  });
+  state.SetItemsProcessed(state.iterations() * waiters_count);
+}
+BENCHMARK(wait_list_broadcast)
+    ->ArgsProduct({{16, 256, 4096}, {1, 4}})
+    ->UseRealTime();
+
 USERVER_NAMESPACE_END
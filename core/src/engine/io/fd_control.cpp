@@ -6,11 +6,13 @@
 
 #include <memory>
 #include <stdexcept>
+#include <thread>
 
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/ev/thread_control.hpp>
 #include <engine/task/task_context.hpp>
 #include <utils/check_syscall.hpp>
 
@@ -65,7 +67,8 @@ Direction::SingleUserGuard::~SingleUserGuard() {
 }
 #endif  // #ifndef NDEBUG
 
-Direction::Direction(Kind kind) : kind_(kind) {}
+Direction::Direction(Kind kind)
+    : kind_(kind), io_uring_(current_task::GetEventThread().GetIoUring()) {}
 
 Direction::~Direction() = default;
 
@@ -77,6 +80,44 @@ void Direction::Reset(int fd) { poller_.Reset(fd, kind_); }
 
 void Direction::Invalidate() { poller_.Invalidate(); }
 
+bool Direction::ShouldUseIoUring(int error_code, size_t processed_bytes,
+                                 TransferMode mode) const {
+  // Mirrors the conditions under which TryHandleError waits for readiness
+  return io_uring_ &&
+         (error_code == EWOULDBLOCK
+#if EWOULDBLOCK != EAGAIN
+          || error_code == EAGAIN
+#endif
+          ) &&
+         (processed_bytes == 0 || mode == TransferMode::kWhole) &&
+         !current_task::ShouldCancel();
+}
+
+bool Direction::AwaitIoUring(IoUringOperation& operation, Deadline deadline) {
+  if (operation.event_.WaitForEventUntil(deadline)) return true;
+
+  CancelIoUring();
+
+  // The kernel may still be using the buffers, so we have to wait for the
+  // completion regardless of cancellations
+  const TaskCancellationBlocker block_cancels;
+  while (!operation.event_.WaitForEvent()) {
+  }
+  return false;
+}
+
+void Direction::CancelIoUring() noexcept {
+  const auto* operation = io_uring_operation_.load();
+  if (!operation) return;
+
+  UASSERT(io_uring_);
+  // The operation may complete concurrently, cancellation of a completed
+  // operation is a no-op for the kernel.
+  while (!io_uring_->SubmitCancel(*operation)) {
+    std::this_thread::yield();
+  }
+}
+
 FdControl::FdControl()
     : read_(Direction::Kind::kRead), write_(Direction::Kind::kWrite) {}
 
@@ -103,6 +144,10 @@ void FdControl::Close() {
   if (!IsValid()) return;
   Invalidate();
 
+  // close(2) does not interrupt in-flight io_uring operations
+  read_.CancelIoUring();
+  write_.CancelIoUring();
+
   const auto fd = Fd();
   if (::close(fd) == -1) {
     const auto error_code = errno;
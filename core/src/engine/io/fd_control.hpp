@@ -1,17 +1,23 @@
 #pragma once
 
 #include <sys/uio.h>
+#include <unistd.h>
 #include <atomic>
 #include <cerrno>
+#include <optional>
 
 #include <userver/engine/io/exception.hpp>
 #include <userver/engine/io/fd_control_holder.hpp>
 #include <userver/engine/io/fd_poller.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+#include <userver/utils/meta_light.hpp>
 
+#include <engine/ev/io_uring.hpp>
 #include <engine/task/task_context.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 
@@ -41,6 +47,49 @@ enum class ErrorMode {
   kFatal,      ///< break execute operation
 };
 
+/// IoFunc for Direction::PerformIo, may be completed via io_uring
+struct ReadFunc final {
+  [[nodiscard]] ssize_t operator()(int fd, void* buf, size_t len) const {
+    return ::read(fd, buf, len);
+  }
+
+  [[nodiscard]] static bool SubmitToIoUring(
+      ev::IoUring& io_uring, int fd, void* buf, size_t len,
+      ev::IoUring::Completion& completion) {
+    return io_uring.SubmitRead(fd, buf, len, completion);
+  }
+};
+
+/// IoFunc for Direction::PerformIo, may be completed via io_uring
+struct WriteFunc final {
+  [[nodiscard]] ssize_t operator()(int fd, const void* buf, size_t len) const {
+    return ::write(fd, buf, len);
+  }
+
+  [[nodiscard]] static bool SubmitToIoUring(
+      ev::IoUring& io_uring, int fd, const void* buf, size_t len,
+      ev::IoUring::Completion& completion) {
+    return io_uring.SubmitWrite(fd, buf, len, completion);
+  }
+};
+
+/// An io_uring operation awaited by a coroutine
+class IoUringOperation final : public ev::IoUring::Completion {
+ public:
+  void OnComplete(int result) noexcept override {
+    result_ = result;
+    event_.Send();
+  }
+
+  int GetResult() const noexcept { return result_; }
+
+ private:
+  friend class Direction;
+
+  int result_{0};
+  SingleConsumerEvent event_{SingleConsumerEvent::NoAutoReset{}};
+};
+
 class FdControl;
 
 class Direction final {
@@ -86,6 +135,25 @@ class Direction final {
                     TransferMode mode, Deadline deadline,
                     const Context&... context);
 
+  // (IoFunc*)(int, size_t offset, size_t len), e.g. sendfile
+  template <typename IoFunc, typename... Context>
+  size_t PerformIoAt(SingleUserGuard& guard, IoFunc&& io_func, size_t offset,
+                     size_t len, TransferMode mode, Deadline deadline,
+                     const Context&... context);
+
+  /// Submits an operation to io_uring and waits for its completion.
+  ///
+  /// `submit` is called as `submit(ev::IoUring&, int fd, Completion&)`.
+  /// Returns std::nullopt if io_uring is not used for this fd or the
+  /// operation could not be submitted, in that case the caller should fall
+  /// back to waiting for readiness. Otherwise returns a syscall-like result,
+  /// with errno set on failure.
+  template <typename Submit, typename... Context>
+  std::optional<ssize_t> TryPerformIoUring(Submit&& submit,
+                                           size_t processed_bytes,
+                                           Deadline deadline,
+                                           const Context&... context);
+
  private:
   friend class FdControl;
   explicit Direction(Kind kind);
@@ -101,10 +169,25 @@ class Direction final {
                            TransferMode mode, Deadline deadline,
                            Context&... context);
 
+  bool ShouldUseIoUring(int error_code, size_t processed_bytes,
+                        TransferMode mode) const;
+
+  // Returns false if the operation was cancelled due to deadline or task
+  // cancellation. The operation is completed in any case.
+  bool AwaitIoUring(IoUringOperation& operation, Deadline deadline);
+
+  // Cancels the in-flight io_uring operation, if any
+  void CancelIoUring() noexcept;
+
   FdPoller poller_;
   Kind kind_;
+  ev::IoUring* io_uring_;
+  std::atomic<const IoUringOperation*> io_uring_operation_{nullptr};
 };
 
+template <typename IoFunc>
+using HasIoUringSubmit = decltype(&std::decay_t<IoFunc>::SubmitToIoUring);
+
 class FdControl final {
  public:
   // fd will be silently forced to nonblocking mode
@@ -185,6 +268,41 @@ ErrorMode Direction::TryHandleError(int error_code, size_t processed_bytes,
   return ErrorMode::kProcessed;
 }
 
+template <typename Submit, typename... Context>
+std::optional<ssize_t> Direction::TryPerformIoUring(Submit&& submit,
+                                                    size_t processed_bytes,
+                                                    Deadline deadline,
+                                                    const Context&... context) {
+  if (!io_uring_) return std::nullopt;
+
+  IoUringOperation operation;
+  io_uring_operation_.store(&operation);
+  const utils::FastScopeGuard reset_guard(
+      [this]() noexcept { io_uring_operation_.store(nullptr); });
+  if (!submit(*io_uring_, Fd(), operation)) return std::nullopt;
+
+  const bool completed = AwaitIoUring(operation, deadline);
+  const int result = operation.GetResult();
+  if (!completed && result == -ECANCELED) {
+    if (current_task::ShouldCancel()) {
+      throw(IoCancelled(/*bytes_transferred =*/processed_bytes)
+            << ... << context);
+    } else {
+      throw(IoTimeout(/*bytes_transferred =*/processed_bytes)
+            << ... << context);
+    }
+  }
+  if (!IsValid()) {
+    throw((IoException() << "Fd closed during ") << ... << context);
+  }
+
+  if (result < 0) {
+    errno = -result;
+    return -1;
+  }
+  return result;
+}
+
 template <typename IoFunc, typename... Context>
 size_t Direction::PerformIoV(SingleUserGuard&, IoFunc&& io_func,
                              struct iovec* list, std::size_t list_size,
@@ -195,6 +313,24 @@ size_t Direction::PerformIoV(SingleUserGuard&, IoFunc&& io_func,
   std::size_t processed_bytes = 0;
   do {
     auto chunk_size = io_func(Fd(), list, list_size);
+    if constexpr (meta::kIsDetected<HasIoUringSubmit, IoFunc>) {
+      if (chunk_size == -1 &&
+          ShouldUseIoUring(errno, processed_bytes, mode)) {
+        const int error_code = errno;
+        const auto result = TryPerformIoUring(
+            [&](ev::IoUring& io_uring, int fd,
+                ev::IoUring::Completion& completion) {
+              return io_func.SubmitToIoUring(io_uring, fd, list, list_size,
+                                             completion);
+            },
+            processed_bytes, deadline, context...);
+        if (result) {
+          chunk_size = *result;
+        } else {
+          errno = error_code;
+        }
+      }
+    }
 
     if (chunk_size > 0) {
       processed_bytes += chunk_size;
@@ -235,6 +371,23 @@ size_t Direction::PerformIo(SingleUserGuard&, IoFunc&& io_func, void* buf,
 
   while (pos < end) {
     auto chunk_size = io_func(Fd(), pos, end - pos);
+    if constexpr (meta::kIsDetected<HasIoUringSubmit, IoFunc>) {
+      if (chunk_size == -1 && ShouldUseIoUring(errno, pos - begin, mode)) {
+        const int error_code = errno;
+        const auto result = TryPerformIoUring(
+            [&](ev::IoUring& io_uring, int fd,
+                ev::IoUring::Completion& completion) {
+              return io_func.SubmitToIoUring(io_uring, fd, pos, end - pos,
+                                             completion);
+            },
+            pos - begin, deadline, context...);
+        if (result) {
+          chunk_size = *result;
+        } else {
+          errno = error_code;
+        }
+      }
+    }
 
     if (chunk_size > 0) {
       pos += chunk_size;
@@ -249,6 +402,29 @@ size_t Direction::PerformIo(SingleUserGuard&, IoFunc&& io_func, void* buf,
   return pos - begin;
 }
 
+template <typename IoFunc, typename... Context>
+size_t Direction::PerformIoAt(SingleUserGuard&, IoFunc&& io_func, size_t offset,
+                              size_t len, TransferMode mode, Deadline deadline,
+                              const Context&... context) {
+  size_t processed_bytes = 0;
+  while (processed_bytes < len) {
+    const auto chunk_size =
+        io_func(Fd(), offset + processed_bytes, len - processed_bytes);
+
+    if (chunk_size > 0) {
+      processed_bytes += chunk_size;
+      if (mode == TransferMode::kOnce) {
+        break;
+      }
+    } else if (!chunk_size ||
+               TryHandleError(errno, processed_bytes, mode, deadline,
+                              context...) == ErrorMode::kFatal) {
+      break;
+    }
+  }
+  return processed_bytes;
+}
+
 }  // namespace engine::io::impl
 
 USERVER_NAMESPACE_END
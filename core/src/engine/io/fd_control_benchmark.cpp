@@ -2,6 +2,7 @@
 
 #include <unistd.h>
 
+#include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <utils/check_syscall.hpp>
 
@@ -94,4 +95,59 @@ void fd_control_construct_wait_destroy(benchmark::State& state) {
 }
 BENCHMARK(fd_control_construct_wait_destroy);
 
+void fd_control_pipe_ping_pong(benchmark::State& state, bool use_io_uring) {
+  engine::TaskProcessorPoolsConfig config;
+  config.ev_use_io_uring = use_io_uring;
+  engine::RunStandalone(2, config, [&] {
+    const auto deadline = Deadline::FromDuration(std::chrono::seconds{60});
+    Pipe request_pipe;
+    Pipe response_pipe;
+    auto request_in = FdControl::Adopt(request_pipe.ExtractIn());
+    auto request_out = FdControl::Adopt(request_pipe.ExtractOut());
+    auto response_in = FdControl::Adopt(response_pipe.ExtractIn());
+    auto response_out = FdControl::Adopt(response_pipe.ExtractOut());
+
+    auto echo = engine::AsyncNoSpan([&] {
+      auto& read_dir = request_in->Read();
+      auto& write_dir = response_out->Write();
+      char c = 0;
+      for (;;) {
+        {
+          io::impl::Direction::SingleUserGuard guard(read_dir);
+          if (read_dir.PerformIo(guard, io::impl::ReadFunc{}, &c, 1,
+                                 io::impl::TransferMode::kWhole, deadline,
+                                 "echo read") != 1) {
+            return;
+          }
+        }
+        io::impl::Direction::SingleUserGuard guard(write_dir);
+        [[maybe_unused]] auto written = write_dir.PerformIo(
+            guard, io::impl::WriteFunc{}, &c, 1,
+            io::impl::TransferMode::kWhole, deadline, "echo write");
+      }
+    });
+
+    auto& write_dir = request_out->Write();
+    auto& read_dir = response_in->Read();
+    for ([[maybe_unused]] auto _ : state) {
+      char c = 'a';
+      {
+        io::impl::Direction::SingleUserGuard guard(write_dir);
+        [[maybe_unused]] auto written = write_dir.PerformIo(
+            guard, io::impl::WriteFunc{}, &c, 1,
+            io::impl::TransferMode::kWhole, deadline, "write");
+      }
+      io::impl::Direction::SingleUserGuard guard(read_dir);
+      benchmark::DoNotOptimize(read_dir.PerformIo(
+          guard, io::impl::ReadFunc{}, &c, 1, io::impl::TransferMode::kWhole,
+          deadline, "read"));
+    }
+
+    request_out->Close();
+    echo.Get();
+  });
+}
+BENCHMARK_CAPTURE(fd_control_pipe_ping_pong, libev, false);
+BENCHMARK_CAPTURE(fd_control_pipe_ping_pong, io_uring, true);
+
 USERVER_NAMESPACE_END
@@ -1,8 +1,13 @@
 #include <userver/engine/io/fd_poller.hpp>
 
+#include <poll.h>
+
+#include <cerrno>
+
 #include <engine/ev/watcher.hpp>
 #include <engine/impl/wait_list_light.hpp>
 #include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
 
 template <>
 struct fmt::formatter<USERVER_NAMESPACE::engine::io::FdPoller::State> {
@@ -64,6 +69,28 @@ FdPoller::Kind GetUserMode(int ev_events) {
   UINVARIANT(false, "Failed to recognize events that happened on the socket.");
 }
 
+short GetPollEvents(FdPoller::Kind kind) {
+  switch (kind) {
+    case FdPoller::Kind::kRead:
+      return POLLIN;
+    case FdPoller::Kind::kWrite:
+      return POLLOUT;
+    case FdPoller::Kind::kReadWrite:
+      return POLLIN | POLLOUT;
+  }
+  UINVARIANT(false, "Invalid kind: " + std::to_string(static_cast<int>(kind)));
+}
+
+FdPoller::Kind GetPolledKind(short revents, FdPoller::Kind requested) {
+  const bool readable = revents & POLLIN;
+  const bool writable = revents & POLLOUT;
+  if (readable && writable) return FdPoller::Kind::kReadWrite;
+  if (readable) return FdPoller::Kind::kRead;
+  if (writable) return FdPoller::Kind::kWrite;
+  // POLLERR or POLLHUP, the following I/O call reports the error
+  return requested;
+}
+
 }  // namespace
 
 namespace impl {
@@ -73,7 +100,7 @@ class DirectionWaitStrategy final : public engine::impl::WaitStrategy {
   DirectionWaitStrategy(Deadline deadline, engine::impl::WaitListLight& waiters,
                         ev::Watcher<ev_io>& watcher,
                         engine::impl::TaskContext& current)
-      : WaitStrategy(deadline),
+      : WaitStrategy(deadline, engine::impl::WaitReason::kIo),
         waiters_(waiters),
         watcher_(watcher),
         current_(current) {}
@@ -104,6 +131,10 @@ struct FdPoller::Impl {
 
   engine::impl::TaskContext::WakeupSource DoWait(Deadline deadline);
 
+  // Polls the fd right from the worker while the task processor has nothing
+  // else to run, skipping the ev thread round trip on a fast reply
+  bool TryPollOnWorker(Deadline deadline);
+
   bool IsValid() const noexcept;
 
   void Invalidate();
@@ -119,6 +150,7 @@ struct FdPoller::Impl {
   engine::impl::FastPimplWaitListLight waiters_;
   ev::Watcher<ev_io> watcher_;
   std::atomic<FdPoller::Kind> events_that_happened_{};
+  FdPoller::Kind kind_{};
 };
 
 void FdPoller::Impl::WakeupWaiters() { waiters_->WakeupOne(); }
@@ -133,6 +165,10 @@ engine::impl::TaskContext::WakeupSource FdPoller::Impl::DoWait(
     Deadline deadline) {
   UASSERT(IsValid());
 
+  if (TryPollOnWorker(deadline)) {
+    return engine::impl::TaskContext::WakeupSource::kWaitList;
+  }
+
   auto& current = current_task::GetCurrentTaskContext();
 
   impl::DirectionWaitStrategy wait_manager(deadline, *waiters_, watcher_,
@@ -147,6 +183,32 @@ engine::impl::TaskContext::WakeupSource FdPoller::Impl::DoWait(
   return ret;
 }
 
+bool FdPoller::Impl::TryPollOnWorker(Deadline deadline) {
+  auto& task_processor =
+      current_task::GetCurrentTaskContext().GetTaskProcessor();
+  const auto iterations = task_processor.GetIoPollIterations();
+
+  struct pollfd pfd {};
+  pfd.fd = fd_;
+  pfd.events = GetPollEvents(kind_);
+  for (std::size_t i = 0; i < iterations; ++i) {
+    const int res = ::poll(&pfd, 1, 0);
+    if (res > 0) {
+      events_that_happened_.store(GetPolledKind(pfd.revents, kind_),
+                                  std::memory_order_relaxed);
+      return true;
+    }
+    if (res < 0 && errno != EINTR) return false;
+
+    // Do not delay the other tasks, nor the deadline or cancellation
+    if (task_processor.GetTaskQueueSize() != 0 || deadline.IsReached() ||
+        current_task::ShouldCancel()) {
+      return false;
+    }
+  }
+  return false;
+}
+
 void FdPoller::Impl::Invalidate() {
   StopWatcher();
 
@@ -241,6 +303,7 @@ void FdPoller::Impl::Reset(int fd, Kind kind) {
   UASSERT(!IsValid());
   UASSERT(fd_ == fd || fd_ == -1);
   fd_ = fd;
+  kind_ = kind;
   watcher_.Set(fd_, GetEvMode(kind));
   state_ = State::kReadyToUse;
 }
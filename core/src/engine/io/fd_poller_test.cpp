@@ -0,0 +1,109 @@
+#include <userver/engine/io/fd_poller.hpp>
+
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor.hpp>
+#include <engine/task/wait_stats.hpp>
+#include <userver/utest/utest.hpp>
+#include <utils/check_syscall.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class Pipe final {
+ public:
+  Pipe() { utils::CheckSyscall(::pipe(fd_), "creating pipe"); }
+  ~Pipe() {
+    ::close(fd_[0]);
+    ::close(fd_[1]);
+  }
+
+  int In() { return fd_[0]; }
+  int Out() { return fd_[1]; }
+
+ private:
+  int fd_[2]{};
+};
+
+void WriteOne(int fd) {
+  std::array<char, 1> buf{'1'};
+  ASSERT_EQ(buf.size(), ::write(fd, buf.data(), buf.size()));
+}
+
+engine::impl::TaskProcessorHolder MakeTaskProcessor(
+    std::size_t io_poll_iterations) {
+  engine::TaskProcessorConfig config;
+  config.worker_threads = 1;
+  config.thread_name = "io-poll";
+  config.io_poll_iterations = io_poll_iterations;
+  return engine::impl::TaskProcessorHolder{
+      std::make_unique<engine::TaskProcessor>(
+          std::move(config), engine::impl::MakeTaskProcessorPools({}))};
+}
+
+std::uint64_t GetContextSwitches() {
+  const auto* const stats = engine::current_task::GetWaitStats();
+  EXPECT_TRUE(stats);
+  return stats ? stats->context_switches : 0;
+}
+
+}  // namespace
+
+TEST(FdPoller, PollOnWorkerReady) {
+  auto task_processor = MakeTaskProcessor(1000);
+
+  engine::impl::RunOnTaskProcessorSync(*task_processor, [] {
+    engine::current_task::EnableWaitStats();
+    Pipe pipe;
+    engine::io::FdPoller poller;
+    poller.Reset(pipe.In(), engine::io::FdPoller::Kind::kRead);
+
+    WriteOne(pipe.Out());
+    const auto switches_before = GetContextSwitches();
+    const auto kind =
+        poller.Wait(engine::Deadline::FromDuration(utest::kMaxTestWaitTime));
+    EXPECT_EQ(kind, engine::io::FdPoller::Kind::kRead);
+
+    // The fd was found ready by the poll on the worker, the task did not sleep
+    EXPECT_EQ(GetContextSwitches(), switches_before);
+    poller.Invalidate();
+  });
+}
+
+TEST(FdPoller, PollOnWorkerFallback) {
+  auto task_processor = MakeTaskProcessor(10);
+
+  engine::impl::RunOnTaskProcessorSync(*task_processor, [] {
+    engine::current_task::EnableWaitStats();
+    Pipe pipe;
+    engine::io::FdPoller poller;
+    poller.Reset(pipe.In(), engine::io::FdPoller::Kind::kRead);
+
+    // Written long after the polling budget is exhausted
+    std::thread writer([&pipe] {
+      std::this_thread::sleep_for(50ms);
+      WriteOne(pipe.Out());
+    });
+    const auto switches_before = GetContextSwitches();
+    const auto kind =
+        poller.Wait(engine::Deadline::FromDuration(utest::kMaxTestWaitTime));
+    writer.join();
+    EXPECT_EQ(kind, engine::io::FdPoller::Kind::kRead);
+
+    // The task has slept until the ev thread noticed the fd
+    EXPECT_GT(GetContextSwitches(), switches_before);
+    poller.Invalidate();
+  });
+}
+
+USERVER_NAMESPACE_END
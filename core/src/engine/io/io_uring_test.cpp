@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <array>
+#include <string_view>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/io/pipe.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <engine/ev/io_uring.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace io = engine::io;
+using Deadline = engine::Deadline;
+
+constexpr std::string_view kPayload = "ping";
+
+void RunWithIoUring(std::size_t worker_threads,
+                    utils::function_ref<void()> payload) {
+  engine::TaskProcessorPoolsConfig config;
+  config.ev_use_io_uring = true;
+  engine::RunStandalone(worker_threads, config, payload);
+}
+
+}  // namespace
+
+class IoUring : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (!engine::ev::IoUring::IsSupported()) {
+      GTEST_SKIP() << "io_uring is not supported by the kernel";
+    }
+  }
+};
+
+TEST_F(IoUring, SendRecv) {
+  RunWithIoUring(1, [] {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+    internal::net::TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(deadline);
+
+    // the receiver is blocked before the data arrives
+    auto receiver = engine::AsyncNoSpan([&server, deadline] {
+      std::array<char, kPayload.size()> buf{};
+      EXPECT_EQ(buf.size(), server.RecvAll(buf.data(), buf.size(), deadline));
+      EXPECT_EQ(kPayload, std::string_view(buf.data(), buf.size()));
+    });
+    engine::Yield();
+
+    EXPECT_EQ(kPayload.size(),
+              client.SendAll(kPayload.data(), kPayload.size(), deadline));
+    receiver.Get();
+
+    EXPECT_EQ(kPayload.size() * 2,
+              client.SendAll({{kPayload.data(), kPayload.size()},
+                              {kPayload.data(), kPayload.size()}},
+                             deadline));
+    std::array<char, kPayload.size() * 2> buf{};
+    EXPECT_EQ(buf.size(), server.RecvAll(buf.data(), buf.size(), deadline));
+  });
+}
+
+TEST_F(IoUring, RecvTimeout) {
+  RunWithIoUring(1, [] {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+    internal::net::TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(deadline);
+
+    std::array<char, 1> buf{};
+    EXPECT_THROW(
+        static_cast<void>(server.RecvSome(
+            buf.data(), buf.size(),
+            Deadline::FromDuration(std::chrono::milliseconds{10}))),
+        io::IoTimeout);
+
+    // the socket is still usable after the cancelled operation
+    EXPECT_EQ(1, client.SendAll(kPayload.data(), 1, deadline));
+    EXPECT_EQ(1, server.RecvSome(buf.data(), buf.size(), deadline));
+  });
+}
+
+TEST_F(IoUring, RecvCancel) {
+  RunWithIoUring(1, [] {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+    internal::net::TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(deadline);
+
+    auto receiver = engine::AsyncNoSpan([&server, deadline] {
+      std::array<char, 1> buf{};
+      EXPECT_THROW(
+          static_cast<void>(server.RecvSome(buf.data(), buf.size(), deadline)),
+          io::IoCancelled);
+    });
+    engine::Yield();
+    receiver.RequestCancel();
+    receiver.Get();
+  });
+}
+
+TEST_F(IoUring, AcceptConnect) {
+  RunWithIoUring(2, [] {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+    internal::net::TcpListener listener;
+
+    auto acceptor = engine::AsyncNoSpan([&listener, deadline] {
+      auto peer = listener.socket.Accept(deadline);
+      EXPECT_EQ(kPayload.size(),
+                peer.SendAll(kPayload.data(), kPayload.size(), deadline));
+    });
+
+    io::Socket client{listener.addr.Domain(), io::SocketType::kStream};
+    client.Connect(listener.addr, deadline);
+
+    std::array<char, kPayload.size()> buf{};
+    EXPECT_EQ(buf.size(), client.RecvAll(buf.data(), buf.size(), deadline));
+    acceptor.Get();
+  });
+}
+
+TEST_F(IoUring, ConnectFail) {
+  RunWithIoUring(1, [] {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+    internal::net::TcpListener listener;
+    const auto addr = listener.addr;
+    listener.socket.Close();
+
+    io::Socket client{addr.Domain(), io::SocketType::kStream};
+    EXPECT_THROW(client.Connect(addr, deadline), io::IoSystemError);
+  });
+}
+
+TEST_F(IoUring, Pipe) {
+  RunWithIoUring(1, [] {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+    io::Pipe pipe;
+    auto& reader = pipe.reader;
+    auto& writer = pipe.writer;
+
+    auto read_task = engine::AsyncNoSpan([&reader, deadline] {
+      std::array<char, kPayload.size()> buf{};
+      EXPECT_EQ(buf.size(), reader.ReadAll(buf.data(), buf.size(), deadline));
+      EXPECT_EQ(kPayload, std::string_view(buf.data(), buf.size()));
+    });
+    engine::Yield();
+
+    EXPECT_EQ(kPayload.size(),
+              writer.WriteAll(kPayload.data(), kPayload.size(), deadline));
+    read_task.Get();
+  });
+}
+
+USERVER_NAMESPACE_END
@@ -53,8 +53,9 @@ size_t PipeReader::ReadSome(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::SingleUserGuard guard(dir);
-  return dir.PerformIo(guard, &::read, buf, len, impl::TransferMode::kPartial,
-                       deadline, "ReadSome from pipe");
+  return dir.PerformIo(guard, impl::ReadFunc{}, buf, len,
+                       impl::TransferMode::kPartial, deadline,
+                       "ReadSome from pipe");
 }
 
 size_t PipeReader::ReadAll(void* buf, size_t len, Deadline deadline) {
@@ -63,8 +64,9 @@ size_t PipeReader::ReadAll(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::SingleUserGuard guard(dir);
-  return dir.PerformIo(guard, &::read, buf, len, impl::TransferMode::kWhole,
-                       deadline, "ReadAll from pipe");
+  return dir.PerformIo(guard, impl::ReadFunc{}, buf, len,
+                       impl::TransferMode::kWhole, deadline,
+                       "ReadAll from pipe");
 }
 
 int PipeReader::Fd() const {
@@ -98,7 +100,7 @@ size_t PipeWriter::WriteAll(const void* buf, size_t len, Deadline deadline) {
   auto& dir = fd_control_->Write();
   impl::Direction::SingleUserGuard guard(dir);
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  return dir.PerformIo(guard, &::write, const_cast<void*>(buf), len,
+  return dir.PerformIo(guard, impl::WriteFunc{}, const_cast<void*>(buf), len,
                        impl::TransferMode::kWhole, deadline,
                        "WriteAll to pipe");
 }
@@ -3,6 +3,8 @@
 #include <arpa/inet.h>
 
 #include <array>
+#include <cstddef>
+#include <cstring>
 #include <limits>
 #include <ostream>
 
@@ -17,6 +19,22 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 
+socklen_t Sockaddr::Size() const {
+  if (IsAbstractUnix()) {
+    const auto* sa = As<struct sockaddr_un>();
+    return offsetof(struct sockaddr_un, sun_path) + 1 +
+           ::strnlen(sa->sun_path + 1, sizeof(sa->sun_path) - 1);
+  }
+  return Addrlen(Domain());
+}
+
+bool Sockaddr::IsAbstractUnix() const {
+  if (Domain() != AddrDomain::kUnix) return false;
+  // An unnamed (e.g. accepted) socket address is all zeros
+  const auto* sa = As<struct sockaddr_un>();
+  return sa->sun_path[0] == '\0' && sa->sun_path[1] != '\0';
+}
+
 bool Sockaddr::HasPort() const {
   switch (Data()->sa_family) {
     case AF_INET:
@@ -89,9 +107,15 @@ std::string Sockaddr::PrimaryAddressString() const {
       return buf.data();
     } break;
 
-    case AddrDomain::kUnix:
-      return As<struct sockaddr_un>()->sun_path;
-      break;
+    case AddrDomain::kUnix: {
+      const auto* sa = As<struct sockaddr_un>();
+      if (IsAbstractUnix()) {
+        return '@' + std::string{sa->sun_path + 1,
+                                 ::strnlen(sa->sun_path + 1,
+                                           sizeof(sa->sun_path) - 1)};
+      }
+      return sa->sun_path;
+    } break;
 
     case AddrDomain::kUnspecified:
       break;
@@ -1,10 +1,15 @@
 #include <userver/engine/io/socket.hpp>
 
 #include <fcntl.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
 #include <sys/socket.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <string>
 #include <vector>
@@ -56,18 +61,72 @@ Sockaddr& MemoizeAddr(Sockaddr& addr, decltype(&::getpeername) getter,
 
 // IoFunc wrappers for Direction::PerformIo
 
-[[nodiscard]] ssize_t RecvWrapper(int fd, void* buf, size_t len) {
-  return ::recv(fd, buf, len, 0);
-}
-
-[[nodiscard]] ssize_t SendWrapper(int fd, const void* buf, size_t len) {
-  return ::send(fd, buf, len,
 // MAC_COMPAT: does not support MSG_NOSIGNAL
+constexpr int kSendFlags =
 #ifdef MSG_NOSIGNAL
-                MSG_NOSIGNAL |
+    MSG_NOSIGNAL |
 #endif
-                    0);
-}
+    0;
+
+struct RecvWrapper final {
+  [[nodiscard]] ssize_t operator()(int fd, void* buf, size_t len) const {
+    return ::recv(fd, buf, len, 0);
+  }
+
+  [[nodiscard]] static bool SubmitToIoUring(
+      ev::IoUring& io_uring, int fd, void* buf, size_t len,
+      ev::IoUring::Completion& completion) {
+    return io_uring.SubmitRecv(fd, buf, len, 0, completion);
+  }
+};
+
+struct SendWrapper final {
+  [[nodiscard]] ssize_t operator()(int fd, const void* buf, size_t len) const {
+    return ::send(fd, buf, len, kSendFlags);
+  }
+
+  [[nodiscard]] static bool SubmitToIoUring(
+      ev::IoUring& io_uring, int fd, const void* buf, size_t len,
+      ev::IoUring::Completion& completion) {
+    return io_uring.SubmitSend(fd, buf, len, kSendFlags, completion);
+  }
+};
+
+struct WritevWrapper final {
+  [[nodiscard]] ssize_t operator()(int fd, const struct iovec* list,
+                                   std::size_t list_size) const {
+    return ::writev(fd, list, static_cast<int>(list_size));
+  }
+
+  [[nodiscard]] static bool SubmitToIoUring(
+      ev::IoUring& io_uring, int fd, const struct iovec* list,
+      std::size_t list_size, ev::IoUring::Completion& completion) {
+    return io_uring.SubmitWritev(fd, list, list_size, completion);
+  }
+};
+
+struct SendFileWrapper final {
+  [[nodiscard]] ssize_t operator()(int fd, std::size_t offset,
+                                   std::size_t len) const {
+#ifdef __linux__
+    auto file_offset = static_cast<off_t>(offset);
+    return ::sendfile(fd, in_fd, &file_offset, len);
+#else
+    // MAC_COMPAT: sendfile has a different signature and semantics
+    std::array<char, kSendFileBufferSize> buffer;  // NOLINT
+    const auto read_bytes = ::pread(in_fd, buffer.data(),
+                                    std::min(len, buffer.size()), offset);
+    if (read_bytes <= 0) return read_bytes;
+    return ::send(fd, buffer.data(), read_bytes, kSendFlags);
+#endif
+  }
+
+#ifndef __linux__
+  static constexpr std::size_t kSendFileBufferSize = 16 * 1024;
+#endif
+
+  int in_fd;
+};
 
 class RecvFromWrapper {
  public:
@@ -149,7 +208,16 @@ void Socket::Connect(const Sockaddr& addr, Deadline deadline) {
 
   peername_ = addr;
 
-  if (!::connect(Fd(), addr.Data(), addr.Size())) {
+  // io_uring waits for the connection to be established by itself
+  const auto io_uring_result = fd_control_->Write().TryPerformIoUring(
+      [&addr](ev::IoUring& io_uring, int fd,
+              ev::IoUring::Completion& completion) {
+        return io_uring.SubmitConnect(fd, addr.Data(), addr.Size(),
+                                      completion);
+      },
+      0, deadline, "Connect to ", addr);
+  if (io_uring_result ? *io_uring_result == 0
+                      : !::connect(Fd(), addr.Data(), addr.Size())) {
     return;
   }
 
@@ -220,8 +288,46 @@ size_t Socket::RecvSome(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::SingleUserGuard guard(dir);
-  return dir.PerformIo(guard, &RecvWrapper, buf, len, impl::TransferMode::kOnce,
-                       deadline, "RecvSome from ", peername_);
+  return dir.PerformIo(guard, RecvWrapper{}, buf, len,
+                       impl::TransferMode::kOnce, deadline, "RecvSome from ",
+                       peername_);
+}
+
+utils::expected<size_t, IoInterruption> Socket::TryRecvSome(
+    void* buf, size_t len, Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to RecvSome from closed socket");
+  }
+  auto& dir = fd_control_->Read();
+  impl::Direction::SingleUserGuard guard(dir);
+  while (true) {
+    const auto result = ::recv(dir.Fd(), buf, len, 0);
+    if (result >= 0) return static_cast<size_t>(result);
+
+    const int error_code = errno;
+    if (error_code == EINTR) continue;
+    if (error_code != EWOULDBLOCK
+#if EWOULDBLOCK != EAGAIN
+        && error_code != EAGAIN
+#endif
+    ) {
+      IoSystemError ex(error_code, "Socket::TryRecvSome");
+      ex << "Error while RecvSome from " << peername_ << ", fd=" << dir.Fd();
+      throw std::move(ex);
+    }
+
+    if (current_task::ShouldCancel()) {
+      return utils::unexpected(IoInterruption::kCancelled);
+    }
+    if (!dir.Wait(deadline)) {
+      return utils::unexpected(current_task::ShouldCancel()
+                                   ? IoInterruption::kCancelled
+                                   : IoInterruption::kTimeout);
+    }
+    if (!dir.IsValid()) {
+      throw IoException() << "Fd closed during RecvSome from " << peername_;
+    }
+  }
 }
 
 size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
@@ -230,7 +336,7 @@ size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
   }
   auto& dir = fd_control_->Read();
   impl::Direction::SingleUserGuard guard(dir);
-  return dir.PerformIo(guard, &RecvWrapper, buf, len,
+  return dir.PerformIo(guard, RecvWrapper{}, buf, len,
                        impl::TransferMode::kWhole, deadline, "RecvAll from ",
                        peername_);
 }
@@ -265,7 +371,7 @@ size_t Socket::SendAll(const struct iovec* list, std::size_t list_size,
   auto& dir = fd_control_->Write();
   impl::Direction::SingleUserGuard guard(dir);
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  return dir.PerformIoV(guard, &writev, const_cast<struct iovec*>(list),
+  return dir.PerformIoV(guard, WritevWrapper{}, const_cast<struct iovec*>(list),
                         list_size, impl::TransferMode::kWhole, deadline,
                         "SendAll to ", peername_);
 }
@@ -277,11 +383,23 @@ size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
   auto& dir = fd_control_->Write();
   impl::Direction::SingleUserGuard guard(dir);
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  return dir.PerformIo(guard, &SendWrapper, const_cast<void*>(buf), len,
+  return dir.PerformIo(guard, SendWrapper{}, const_cast<void*>(buf), len,
                        impl::TransferMode::kWhole, deadline, "SendAll to ",
                        peername_);
 }
 
+size_t Socket::SendFile(int in_fd, std::size_t offset, std::size_t len,
+                        Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to SendFile to closed socket");
+  }
+  auto& dir = fd_control_->Write();
+  impl::Direction::SingleUserGuard guard(dir);
+  return dir.PerformIoAt(guard, SendFileWrapper{in_fd}, offset, len,
+                         impl::TransferMode::kWhole, deadline, "SendFile to ",
+                         peername_);
+}
+
 Socket::RecvFromResult Socket::RecvSomeFrom(void* buf, size_t len,
                                             Deadline deadline) {
   if (!IsValid()) {
@@ -337,6 +455,22 @@ Socket Socket::Accept(Deadline deadline) {
     int fd = ::accept(dir.Fd(), buf.Data(), &len);
 #endif
 
+#ifdef HAVE_ACCEPT4
+    if (fd == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      len = buf.Capacity();
+      const auto io_uring_result = dir.TryPerformIoUring(
+          [&buf, &len](ev::IoUring& io_uring, int listen_fd,
+                       ev::IoUring::Completion& completion) {
+            return io_uring.SubmitAccept(listen_fd, buf.Data(), &len,
+                                         SOCK_NONBLOCK | SOCK_CLOEXEC,
+                                         completion);
+          },
+          0, deadline, "Accept");
+      // on failure errno is set by TryPerformIoUring and handled below
+      if (io_uring_result) fd = static_cast<int>(*io_uring_result);
+    }
+#endif
+
     UASSERT(len <= buf.Capacity());
     if (fd != -1) {
       auto peersock = Socket(fd);
@@ -23,10 +23,16 @@ namespace {
 
 constexpr auto kDeadlineMaxTime = std::chrono::seconds{60};
 
+engine::TaskProcessorPoolsConfig MakePoolsConfig(bool use_io_uring) {
+  engine::TaskProcessorPoolsConfig config;
+  config.ev_use_io_uring = use_io_uring;
+  return config;
+}
+
 }  // namespace
 
-void socket_send_all(benchmark::State& state) {
-  engine::RunStandalone([&]() {
+void socket_send_all(benchmark::State& state, bool use_io_uring) {
+  engine::RunStandalone(1, MakePoolsConfig(use_io_uring), [&]() {
     const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
     internal::net::TcpListener listener;
     auto [server, client] = listener.MakeSocketPair(test_deadline);
@@ -49,10 +55,11 @@ void socket_send_all(benchmark::State& state) {
     task_reader.Get();
   });
 }
-BENCHMARK(socket_send_all);
+BENCHMARK_CAPTURE(socket_send_all, libev, false);
+BENCHMARK_CAPTURE(socket_send_all, io_uring, true);
 
-void socket_send_all_v(benchmark::State& state) {
-  engine::RunStandalone([&]() {
+void socket_send_all_v(benchmark::State& state, bool use_io_uring) {
+  engine::RunStandalone(1, MakePoolsConfig(use_io_uring), [&]() {
     const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
     internal::net::TcpListener listener;
     auto [server, client] = listener.MakeSocketPair(test_deadline);
@@ -74,7 +81,36 @@ void socket_send_all_v(benchmark::State& state) {
     task_reader.Get();
   });
 }
-BENCHMARK(socket_send_all_v);
+BENCHMARK_CAPTURE(socket_send_all_v, libev, false);
+BENCHMARK_CAPTURE(socket_send_all_v, io_uring, true);
+
+// Every receive has to wait for the data, so this measures the cost of
+// blocking I/O: readiness wait and a retried syscall for libev, a single
+// completion for io_uring.
+void socket_ping_pong(benchmark::State& state, bool use_io_uring) {
+  engine::RunStandalone(2, MakePoolsConfig(use_io_uring), [&]() {
+    const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
+    internal::net::TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(test_deadline);
+    auto task_echo = engine::AsyncNoSpan(
+        [test_deadline](auto&& server) {
+          char c = 0;
+          while (server.RecvAll(&c, 1, test_deadline) == 1 &&
+                 server.SendAll(&c, 1, test_deadline) == 1) {
+          }
+        },
+        std::move(server));
+    for ([[maybe_unused]] auto _ : state) {
+      char c = 'a';
+      [[maybe_unused]] auto sent = client.SendAll(&c, 1, test_deadline);
+      benchmark::DoNotOptimize(client.RecvAll(&c, 1, test_deadline));
+    }
+    client.Close();
+    task_echo.Get();
+  });
+}
+BENCHMARK_CAPTURE(socket_ping_pong, libev, false);
+BENCHMARK_CAPTURE(socket_ping_pong, io_uring, true);
 
 [[maybe_unused]] void socket_send_all_v_range(benchmark::State& state) {
   engine::RunStandalone(2, [&]() {
@@ -3,11 +3,14 @@
 #include <arpa/inet.h>
 #include <gtest/gtest.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <unistd.h>
 
 #include <array>
+#include <chrono>
 #include <cerrno>
 #include <cstdlib>
+#include <cstring>
 #include <string_view>
 
 #include <userver/engine/async.hpp>
@@ -17,6 +20,10 @@
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/internal/net/net_listener.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -126,6 +133,35 @@ UTEST(Socket, ListenConnect) {
   listen_task.Get();
 }
 
+UTEST(Socket, AbstractUnix) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  const std::string name =
+      "userver-socket-test-" + std::to_string(::getpid());
+  io::Sockaddr addr;
+  auto* sa = addr.As<sockaddr_un>();
+  sa->sun_family = AF_UNIX;
+  std::memcpy(sa->sun_path + 1, name.data(), name.size());
+  EXPECT_TRUE(addr.IsAbstractUnix());
+  EXPECT_EQ(addr.Size(), offsetof(sockaddr_un, sun_path) + 1 + name.size());
+  EXPECT_EQ('@' + name, addr.PrimaryAddressString());
+
+  io::Socket listener{addr.Domain(), io::SocketType::kStream};
+  listener.Bind(addr);
+  listener.Listen();
+  EXPECT_EQ('@' + name, listener.Getsockname().PrimaryAddressString());
+
+  io::Socket client{addr.Domain(), io::SocketType::kStream};
+  client.Connect(addr, test_deadline);
+  auto server = listener.Accept(test_deadline);
+  EXPECT_FALSE(server.Getpeername().IsAbstractUnix());
+
+  char c = 0;
+  ASSERT_EQ(1, client.SendAll("1", 1, test_deadline));
+  ASSERT_EQ(1, server.RecvAll(&c, 1, test_deadline));
+  EXPECT_EQ('1', c);
+}
+
 UTEST(Socket, ReleaseReuse) {
   const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
@@ -212,6 +248,40 @@ UTEST(Socket, SendAllVectorHeap) {
   EXPECT_EQ(bytes_sent, bytes_read);
 }
 
+UTEST(Socket, SendFile) {
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  // Large enough not to fit into the socket buffers at once
+  std::string contents(4 * 1024 * 1024, '\0');
+  for (std::size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = static_cast<char>('a' + i % 26);
+  }
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), contents);
+  const auto fd = fs::blocking::FileDescriptor::Open(
+      file.GetPath(), fs::blocking::OpenFlag::kRead);
+
+  TcpListener listener;
+  auto sockets = listener.MakeSocketPair(deadline);
+  constexpr std::size_t kOffset = 3;
+  const auto len = contents.size() - kOffset;
+
+  auto listen_task = engine::AsyncNoSpan([&] {
+    std::string buf(len, '\0');
+    EXPECT_EQ(sockets.first.RecvAll(buf.data(), buf.size(), deadline), len);
+    EXPECT_EQ(buf, std::string_view{contents}.substr(kOffset));
+  });
+
+  EXPECT_EQ(sockets.second.SendFile(fd.GetNative(), kOffset, len, deadline),
+            len);
+  listen_task.Get();
+
+  // The file is shorter than requested
+  EXPECT_EQ(sockets.second.SendFile(fd.GetNative(), contents.size() - 1, 10,
+                                    deadline),
+            1);
+}
+
 UTEST(Socket, Cancel) {
   const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
@@ -260,6 +330,30 @@ UTEST(Socket, Cancel) {
   });
 }
 
+UTEST(Socket, TryRecvSome) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener listener;
+  auto socket_pair = listener.MakeSocketPair(test_deadline);
+
+  char c = 0;
+  auto result = socket_pair.first.TryRecvSome(
+      &c, 1, Deadline::FromDuration(std::chrono::milliseconds{10}));
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(result.error(), io::IoInterruption::kTimeout);
+
+  ASSERT_EQ(1, socket_pair.second.SendAll("x", 1, test_deadline));
+  result = socket_pair.first.TryRecvSome(&c, 1, test_deadline);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result.value(), 1U);
+  EXPECT_EQ(c, 'x');
+
+  engine::current_task::GetCancellationToken().RequestCancel();
+  result = socket_pair.first.TryRecvSome(&c, 1, test_deadline);
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(result.error(), io::IoInterruption::kCancelled);
+}
+
 UTEST(Socket, ErrorPeername) {
   const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
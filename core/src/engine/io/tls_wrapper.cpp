@@ -1,19 +1,35 @@
 #include <userver/engine/io/tls_wrapper.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <exception>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
 
 #include <fmt/format.h>
 #include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 
 #include <crypto/helpers.hpp>
 #include <crypto/openssl.hpp>
 #include <engine/io/fd_control.hpp>
+#include <userver/cache/lru_map.hpp>
 #include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+// OpenSSL switches its own socket BIO to kTLS after the handshake
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L && !defined(OPENSSL_NO_KTLS)
+#define USERVER_IMPL_HAS_KTLS
+#endif
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
@@ -29,6 +45,13 @@ struct SslDeleter {
 };
 using Ssl = std::unique_ptr<SSL, SslDeleter>;
 
+struct SslSessionDeleter {
+  void operator()(SSL_SESSION* session) const noexcept {
+    SSL_SESSION_free(session);
+  }
+};
+using SslSession = std::unique_ptr<SSL_SESSION, SslSessionDeleter>;
+
 struct BioDeleter {
   void operator()(BIO* bio) const noexcept { BIO_free_all(bio); }
 };
@@ -225,6 +248,112 @@ SslCtx MakeSslCtx() {
   return ssl_ctx;
 }
 
+// Returns protocols in the ALPN wire format: each one prefixed with its length
+std::string MakeAlpnProtocolList(const std::vector<std::string>& protocols) {
+  std::string result;
+  for (const auto& protocol : protocols) {
+    if (protocol.empty() || protocol.size() > 255) {
+      throw TlsException(
+          fmt::format("Invalid ALPN protocol name '{}'", protocol));
+    }
+    result.push_back(static_cast<char>(protocol.size()));
+    result.append(protocol);
+  }
+  return result;
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+int SelectAlpnProtocol(SSL*, const unsigned char** out, unsigned char* outlen,
+                       const unsigned char* in, unsigned int inlen, void* arg) {
+  const auto& protocols = *static_cast<const std::string*>(arg);
+  unsigned char* selected = nullptr;
+  // Server preference order, the selected protocol is copied by OpenSSL
+  if (OPENSSL_NPN_NEGOTIATED !=
+      SSL_select_next_proto(
+          &selected, outlen,
+          reinterpret_cast<const unsigned char*>(protocols.data()),
+          protocols.size(), in, inlen)) {
+    return SSL_TLSEXT_ERR_NOACK;
+  }
+  *out = selected;
+  return SSL_TLSEXT_ERR_OK;
+}
+#endif
+
+// Server contexts are created per connection, so the session tickets are
+// encrypted with the keys shared by the whole process. The keys are derived
+// from a random secret for each rotation period, the tickets issued with the
+// previous keys are not resumed.
+constexpr std::chrono::hours kTicketKeysRotationPeriod{1};
+
+// Key name, HMAC secret and AES key for SSL_CTX_set_tlsext_ticket_keys: 48
+// bytes in OpenSSL 1.0, 80 bytes since 1.1
+using TicketKeys = std::array<unsigned char, 2 * 64>;
+
+TicketKeys GetTicketKeys() {
+  static const auto kSecret = [] {
+    std::array<unsigned char, 32> secret{};
+    if (1 != RAND_bytes(secret.data(), secret.size())) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to generate the session ticket secret: RAND_bytes"));
+    }
+    return secret;
+  }();
+
+  const std::uint64_t period =
+      std::chrono::system_clock::now().time_since_epoch() /
+      kTicketKeysRotationPeriod;
+  // secret, period and the index of the SHA-512 block
+  std::array<unsigned char, kSecret.size() + sizeof(period) + 1> material{};
+  std::copy(kSecret.begin(), kSecret.end(), material.begin());
+  for (std::size_t i = 0; i < sizeof(period); ++i) {
+    material[kSecret.size() + i] = static_cast<unsigned char>(period >> 8 * i);
+  }
+
+  TicketKeys keys{};
+  for (std::size_t block = 0; block < keys.size() / 64; ++block) {
+    material.back() = static_cast<unsigned char>(block);
+    if (1 != EVP_Digest(material.data(), material.size(),
+                        keys.data() + block * 64, nullptr, EVP_sha512(),
+                        nullptr)) {
+      throw TlsException(crypto::FormatSslError(
+          "Failed to derive the session ticket keys: EVP_Digest"));
+    }
+  }
+  return keys;
+}
+
+// Client sessions by destination, shared by all the client wrappers to
+// resume the sessions on reconnects
+class ClientSessionCache final {
+ public:
+  // Offers the cached session, if any, in the next handshake
+  void Resume(SSL* ssl, const std::string& key) {
+    const std::lock_guard lock{mutex_};
+    auto* session = sessions_.Get(key);
+    if (session && 1 != SSL_set_session(ssl, session->get())) {
+      LOG_LIMITED_WARNING() << crypto::FormatSslError(
+          "Failed to resume a TLS session: SSL_set_session");
+    }
+  }
+
+  void Store(const std::string& key, SslSession&& session) {
+    const std::lock_guard lock{mutex_};
+    sessions_.Put(key, std::move(session));
+  }
+
+ private:
+  static constexpr std::size_t kMaxSize = 1024;
+
+  std::mutex mutex_;
+  cache::LruMap<std::string, SslSession> sessions_{kMaxSize};
+};
+
+ClientSessionCache& GetClientSessionCache() {
+  static ClientSessionCache cache;
+  return cache;
+}
+
 enum InterruptAction {
   kPass,
   kFail,
@@ -239,20 +368,39 @@ class TlsWrapper::Impl {
   Impl(Impl&& other) noexcept
       : bio_data(std::move(other.bio_data)),
         ssl(std::move(other.ssl)),
-        is_in_shutdown(other.is_in_shutdown) {
+        is_in_shutdown(other.is_in_shutdown),
+        is_socket_bio(other.is_socket_bio),
+        session_cache_key(std::move(other.session_cache_key)) {
     UASSERT(SSL_get_rbio(ssl.get()) == SSL_get_wbio(ssl.get()));
-    SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
+    if (!is_socket_bio) SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
+    if (ssl) SSL_set_app_data(ssl.get(), this);
   }
 
-  void SetUp(SslCtx&& ssl_ctx) {
-    Bio socket_bio{BIO_new(GetSocketBioMethod())};
+  void SetUp(SslCtx&& ssl_ctx, KernelTls kernel_tls) {
+    Bio socket_bio;
+#ifdef USERVER_IMPL_HAS_KTLS
+    if (kernel_tls == KernelTls::kIfSupported) {
+      // The socket is non-blocking, the waits are done in WaitForSocket
+      socket_bio.reset(BIO_new_socket(bio_data.socket.Fd(), BIO_NOCLOSE));
+      if (!socket_bio) {
+        throw TlsException(crypto::FormatSslError(
+            "Failed to set up TLS wrapper: BIO_new_socket"));
+      }
+      is_socket_bio = true;
+    }
+#else
+    static_cast<void>(kernel_tls);
+#endif
     if (!socket_bio) {
-      throw TlsException(
-          crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
+      socket_bio.reset(BIO_new(GetSocketBioMethod()));
+      if (!socket_bio) {
+        throw TlsException(
+            crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
+      }
+      BIO_set_shutdown(socket_bio.get(), 0);
+      SyncBioData(socket_bio.get(), nullptr);
+      BIO_set_init(socket_bio.get(), 1);
     }
-    BIO_set_shutdown(socket_bio.get(), 0);
-    SyncBioData(socket_bio.get(), nullptr);
-    BIO_set_init(socket_bio.get(), 1);
 
     ssl.reset(SSL_new(ssl_ctx.get()));
     if (!ssl) {
@@ -261,11 +409,55 @@ class TlsWrapper::Impl {
     }
 #if OPENSSL_VERSION_NUMBER < 0x010100000L
     ssl->s3->flags |= SSL3_FLAGS_NO_RENEGOTIATE_CIPHERS;
+#endif
+    SSL_set_app_data(ssl.get(), this);
+#ifdef USERVER_IMPL_HAS_KTLS
+    // OpenSSL falls back to the userspace encryption by itself if the kernel
+    // or the negotiated cipher do not support kTLS
+    if (is_socket_bio) SSL_set_options(ssl.get(), SSL_OP_ENABLE_KTLS);
 #endif
     SSL_set_bio(ssl.get(), socket_bio.get(), socket_bio.get());
     [[maybe_unused]] const auto* disowned_bio = socket_bio.release();
   }
 
+  // Drives SSL_connect or SSL_accept to completion
+  int Handshake(int (*handshake_func)(SSL*), const char* context) {
+    while (true) {
+      const int ret = handshake_func(ssl.get());
+      if (ret == 1) return ret;
+      const int ssl_error = SSL_get_error(ssl.get(), ret);
+      if (!NeedsWait(ssl_error)) return ret;
+      bio_data.last_exception = WaitForSocket(ssl_error, 0, context);
+      if (bio_data.last_exception) return ret;
+    }
+  }
+
+  // The socket BIO does not wait on its own, the custom BIO waits in Socket
+  bool NeedsWait(int ssl_error) const {
+    return is_socket_bio && !bio_data.last_exception &&
+           (ssl_error == SSL_ERROR_WANT_READ ||
+            ssl_error == SSL_ERROR_WANT_WRITE);
+  }
+
+  std::exception_ptr WaitForSocket(int ssl_error, size_t bytes_transferred,
+                                   const char* context) {
+    auto& socket = bio_data.socket;
+    const auto deadline = bio_data.current_deadline;
+    const bool is_ready = (ssl_error == SSL_ERROR_WANT_READ)
+                              ? socket.WaitReadable(deadline)
+                              : socket.WaitWriteable(deadline);
+    if (is_ready) return {};
+    // The exceptions are not copyable, make_exception_ptr cannot be used
+    try {
+      if (current_task::ShouldCancel()) {
+        throw(IoCancelled(bytes_transferred) << context);
+      }
+      throw(IoTimeout(bytes_transferred) << context);
+    } catch (const IoInterrupted&) {
+      return std::current_exception();
+    }
+  }
+
   template <typename SslIoFunc>
   size_t PerformSslIo(SslIoFunc&& io_func, void* buf, size_t len,
                       impl::TransferMode mode, InterruptAction interrupt_action,
@@ -308,6 +500,10 @@ class TlsWrapper::Impl {
             UINVARIANT(false,
                        fmt::format("Unexpected SSL_ERROR: {}", ssl_error));
         }
+        if (NeedsWait(ssl_error)) {
+          bio_data.last_exception =
+              WaitForSocket(ssl_error, pos - begin, context);
+        }
         if (bio_data.last_exception) {
           if (interrupt_action == InterruptAction::kFail) {
             // Sometimes (when writing) we must either retry the io_func with
@@ -315,7 +511,7 @@ class TlsWrapper::Impl {
             // stalling, we do the latter.
             ssl.reset();
           }
-          std::rethrow_exception(bio_data.last_exception);
+          std::rethrow_exception(std::exchange(bio_data.last_exception, {}));
         }
         if (!ssl) {
           // openssl breakage
@@ -327,6 +523,21 @@ class TlsWrapper::Impl {
     return pos - begin;
   }
 
+  // Called by OpenSSL for each new client session, TLS 1.3 sends them after
+  // the handshake
+  static int StoreSession(SSL* ssl, SSL_SESSION* session) noexcept {
+    const auto* self = static_cast<const Impl*>(SSL_get_app_data(ssl));
+    if (!self || self->session_cache_key.empty()) return 0;
+    try {
+      GetClientSessionCache().Store(self->session_cache_key,
+                                    SslSession{session});
+    } catch (const std::exception& ex) {
+      LOG_LIMITED_WARNING() << "Failed to store a TLS session: " << ex;
+    }
+    // the reference is owned by the cache
+    return 1;
+  }
+
   void CheckAlive() const {
     if (!ssl) {
       throw TlsException("SSL connection is broken");
@@ -336,6 +547,10 @@ class TlsWrapper::Impl {
   SocketBioData bio_data;
   Ssl ssl;
   bool is_in_shutdown{false};
+  // OpenSSL socket BIO that can be switched to kTLS instead of the custom one
+  bool is_socket_bio{false};
+  // Destination of the client, empty for the server
+  std::string session_cache_key;
 
  private:
   void SyncBioData(BIO* bio,
@@ -349,7 +564,7 @@ TlsWrapper::TlsWrapper(Socket&& socket) : impl_(std::move(socket)) {}
 
 TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
                                       const std::string& server_name,
-                                      Deadline deadline) {
+                                      Deadline deadline, KernelTls kernel_tls) {
   auto ssl_ctx = MakeSslCtx();
 
   if (!server_name.empty()) {
@@ -366,8 +581,17 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
     SSL_CTX_set_verify(ssl_ctx.get(), SSL_VERIFY_PEER, nullptr);
   }
 
+  SSL_CTX_set_session_cache_mode(
+      ssl_ctx.get(), SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_sess_set_new_cb(ssl_ctx.get(), &Impl::StoreSession);
+  auto session_cache_key =
+      fmt::format("{}/{}", server_name, socket.Getpeername());
+
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  wrapper.impl_->SetUp(std::move(ssl_ctx), kernel_tls);
+  wrapper.impl_->session_cache_key = std::move(session_cache_key);
+  GetClientSessionCache().Resume(wrapper.impl_->ssl.get(),
+                                 wrapper.impl_->session_cache_key);
   if (!server_name.empty()) {
     // cast in openssl1.0 macro expansion
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
@@ -380,7 +604,7 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
 
   wrapper.impl_->bio_data.current_deadline = deadline;
 
-  auto ret = SSL_connect(wrapper.impl_->ssl.get());
+  auto ret = wrapper.impl_->Handshake(&SSL_connect, "SSL_connect");
   if (1 != ret) {
     if (wrapper.impl_->bio_data.last_exception) {
       std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
@@ -396,7 +620,8 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
 TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
-    const std::vector<crypto::Certificate>& cert_authorities) {
+    const std::vector<crypto::Certificate>& cert_authorities,
+    const std::vector<std::string>& alpn_protocols, KernelTls kernel_tls) {
   auto ssl_ctx = MakeSslCtx();
 
   if (!cert_authorities.empty()) {
@@ -419,11 +644,46 @@ TlsWrapper TlsWrapper::StartTlsServer(
         "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
   }
 
+  auto ticket_keys = GetTicketKeys();
+  const auto ticket_keys_size =
+      SSL_CTX_get_tlsext_ticket_keys(ssl_ctx.get(), nullptr, 0);
+  UASSERT(0 < ticket_keys_size &&
+          static_cast<std::size_t>(ticket_keys_size) <= ticket_keys.size());
+  if (1 != SSL_CTX_set_tlsext_ticket_keys(ssl_ctx.get(), ticket_keys.data(),
+                                          ticket_keys_size)) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: "
+        "SSL_CTX_set_tlsext_ticket_keys"));
+  }
+  static constexpr unsigned char kSessionIdContext[] = "userver";
+  if (1 != SSL_CTX_set_session_id_context(ssl_ctx.get(), kSessionIdContext,
+                                          sizeof(kSessionIdContext) - 1)) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_set_session_id_context"));
+  }
+
+  // Only used during the handshake, renegotiation is disabled
+  const auto alpn_protocol_list = MakeAlpnProtocolList(alpn_protocols);
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+  if (!alpn_protocol_list.empty()) {
+    SSL_CTX_set_alpn_select_cb(
+        ssl_ctx.get(), &SelectAlpnProtocol,
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        const_cast<std::string*>(&alpn_protocol_list));
+  }
+#endif
+
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
+  wrapper.impl_->SetUp(std::move(ssl_ctx), kernel_tls);
   wrapper.impl_->bio_data.current_deadline = deadline;
 
-  auto ret = SSL_accept(wrapper.impl_->ssl.get());
+  auto ret = wrapper.impl_->Handshake(&SSL_accept, "SSL_accept");
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+  if (!alpn_protocol_list.empty()) {
+    SSL_CTX_set_alpn_select_cb(SSL_get_SSL_CTX(wrapper.impl_->ssl.get()),
+                               nullptr, nullptr);
+  }
+#endif
   if (1 != ret) {
     if (wrapper.impl_->bio_data.last_exception) {
       std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
@@ -482,6 +742,55 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
                              deadline, "SendAll");
 }
 
+size_t TlsWrapper::WriteAllv(const IoData* list, std::size_t list_size,
+                             Deadline deadline) {
+  impl_->CheckAlive();
+
+  // The kernel splits the plaintext into records by itself
+  if (IsKernelTlsSend()) {
+    return impl_->bio_data.socket.WriteAllv(list, list_size, deadline);
+  }
+
+  // Maximum TLS record payload, larger writes are split by OpenSSL anyway
+  constexpr std::size_t kCoalesceSizeLimit = 16 * 1024;
+
+  std::size_t total_size = 0;
+  for (std::size_t i = 0; i < list_size; ++i) total_size += list[i].len;
+
+  std::string buffer;
+  std::size_t sent_bytes = 0;
+  const auto flush = [&] {
+    if (buffer.empty()) return true;
+    const auto sent = SendAll(buffer.data(), buffer.size(), deadline);
+    sent_bytes += sent;
+    const bool is_complete = (sent == buffer.size());
+    buffer.clear();
+    return is_complete;
+  };
+
+  for (std::size_t i = 0; i < list_size; ++i) {
+    const auto& io_data = list[i];
+    if (io_data.len >= kCoalesceSizeLimit) {
+      if (!flush()) return sent_bytes;
+      const auto sent = SendAll(io_data.data, io_data.len, deadline);
+      sent_bytes += sent;
+      if (sent != io_data.len) return sent_bytes;
+      continue;
+    }
+
+    if (buffer.size() + io_data.len > kCoalesceSizeLimit && !flush()) {
+      return sent_bytes;
+    }
+    if (buffer.capacity() == 0) {
+      buffer.reserve(std::min(total_size - sent_bytes, kCoalesceSizeLimit));
+    }
+    buffer.append(static_cast<const char*>(io_data.data), io_data.len);
+  }
+  flush();
+
+  return sent_bytes;
+}
+
 Socket TlsWrapper::StopTls(Deadline deadline) {
   if (impl_->ssl) {
     impl_->is_in_shutdown = true;
@@ -509,18 +818,61 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
             UINVARIANT(false,
                        fmt::format("Unexpected SSL_ERROR: {}", ssl_error));
         }
+        if (impl_->NeedsWait(ssl_error)) {
+          impl_->bio_data.last_exception =
+              impl_->WaitForSocket(ssl_error, 0, "StopTls");
+        }
         if (impl_->bio_data.last_exception) {
-          std::rethrow_exception(impl_->bio_data.last_exception);
+          std::rethrow_exception(
+              std::exchange(impl_->bio_data.last_exception, {}));
         }
       }
     }
+    const bool is_kernel_tls = IsKernelTlsSend() || IsKernelTlsRecv();
     impl_->ssl.reset();
+    if (is_kernel_tls) {
+      // The kernel keeps encrypting the socket, it cannot carry plain data
+      impl_->bio_data.socket.Close();
+      throw TlsException("Cannot return the socket from kernel TLS");
+    }
   }
   return std::move(impl_->bio_data.socket);
 }
 
 int TlsWrapper::GetRawFd() { return impl_->bio_data.socket.Fd(); }
 
+bool TlsWrapper::IsKernelTlsSend() const {
+#ifdef USERVER_IMPL_HAS_KTLS
+  return impl_->ssl && BIO_get_ktls_send(SSL_get_wbio(impl_->ssl.get()));
+#else
+  return false;
+#endif
+}
+
+bool TlsWrapper::IsKernelTlsRecv() const {
+#ifdef USERVER_IMPL_HAS_KTLS
+  return impl_->ssl && BIO_get_ktls_recv(SSL_get_rbio(impl_->ssl.get()));
+#else
+  return false;
+#endif
+}
+
+bool TlsWrapper::IsSessionReused() const {
+  return impl_->ssl && SSL_session_reused(impl_->ssl.get());
+}
+
+std::string TlsWrapper::GetAlpnProtocol() const {
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+  const unsigned char* data = nullptr;
+  unsigned int len = 0;
+  SSL_get0_alpn_selected(impl_->ssl.get(), &data, &len);
+  if (!data) return {};
+  return std::string(reinterpret_cast<const char*>(data), len);
+#else
+  return {};
+#endif
+}
+
 }  // namespace engine::io
 
 USERVER_NAMESPACE_END
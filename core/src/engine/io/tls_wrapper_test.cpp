@@ -261,6 +261,83 @@ UTEST(TlsWrapper, Move) {
   server_task.Get();
 }
 
+UTEST_MT(TlsWrapper, KernelTls, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+  auto server_task = engine::AsyncNoSpan(
+      [test_deadline](auto&& server) {
+        try {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server),
+              crypto::Certificate::LoadFromString(cert),
+              crypto::PrivateKey::LoadFromString(key), test_deadline, {}, {},
+              io::TlsWrapper::KernelTls::kIfSupported);
+          char c = 0;
+          EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+          EXPECT_EQ('1', c);
+          const io::IoData data[] = {{"2", 1}, {"34", 2}};
+          EXPECT_EQ(3, tls_server.WriteAllv(data, 2, test_deadline));
+        } catch (const std::exception& e) {
+          LOG_ERROR() << e;
+          FAIL() << e.what();
+        }
+      },
+      std::move(server));
+
+  auto tls_client =
+      io::TlsWrapper::StartTlsClient(std::move(client), {}, test_deadline,
+                                     io::TlsWrapper::KernelTls::kIfSupported);
+  EXPECT_EQ(1, tls_client.SendAll("1", 1, test_deadline));
+  char buf[3]{};
+  EXPECT_EQ(3, tls_client.RecvAll(buf, sizeof(buf), test_deadline));
+  EXPECT_EQ("234", std::string_view(buf, sizeof(buf)));
+  server_task.Get();
+
+  if (tls_client.IsKernelTlsSend() || tls_client.IsKernelTlsRecv()) {
+    EXPECT_THROW(static_cast<void>(tls_client.StopTls(test_deadline)),
+                 io::TlsException);
+  }
+}
+
+UTEST_MT(TlsWrapper, SessionResumption, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener tcp_listener;
+  const auto connect = [&] {
+    auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+    auto server_task = engine::AsyncNoSpan(
+        [test_deadline](auto&& server) {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server),
+              crypto::Certificate::LoadFromString(cert),
+              crypto::PrivateKey::LoadFromString(key), test_deadline);
+          char c = 0;
+          EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+          EXPECT_EQ(1, tls_server.SendAll(&c, 1, test_deadline));
+          return tls_server.IsSessionReused();
+        },
+        std::move(server));
+
+    auto tls_client =
+        io::TlsWrapper::StartTlsClient(std::move(client), {}, test_deadline);
+    char c = '1';
+    EXPECT_EQ(1, tls_client.SendAll(&c, 1, test_deadline));
+    // TLS 1.3 session tickets are received after the handshake
+    EXPECT_EQ(1, tls_client.RecvSome(&c, 1, test_deadline));
+    const bool is_server_reused = server_task.Get();
+    EXPECT_EQ(is_server_reused, tls_client.IsSessionReused());
+    return is_server_reused;
+  };
+
+  // the first session may be resumed from the other tests on the same port
+  connect();
+  EXPECT_TRUE(connect());
+}
+
 UTEST(TlsWrapper, ConnectTimeout) {
   const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
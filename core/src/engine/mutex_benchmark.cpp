@@ -130,13 +130,15 @@ void generic_unlock(benchmark::State& state) {
   }
 }
 
+// `concurrency` lockers per thread, the owner is not always running for
+// a concurrency above 1
 template <typename Mutex>
-void generic_contention(benchmark::State& state) {
+void generic_contention(benchmark::State& state, std::size_t concurrency = 1) {
   std::atomic<bool> run{true};
   std::atomic<std::size_t> lock_unlock_count{0};
   concurrent::impl::InterferenceShield<Mutex> m;
 
-  PoolFor<Mutex> pool(state.range(0) - 1, [&]() {
+  PoolFor<Mutex> pool(state.range(0) * concurrency - 1, [&]() {
     std::uint64_t local_lock_unlock_count = 0;
 
     while (run) {
@@ -253,6 +255,11 @@ void mutex_std_contention(benchmark::State& state) {
   generic_contention<std::mutex>(state);
 }
 
+void mutex_coro_contention_oversubscribed(benchmark::State& state) {
+  engine::RunStandalone(state.range(0),
+                        [&] { generic_contention<engine::Mutex>(state, 4); });
+}
+
 void single_waiting_task_mutex_contention(benchmark::State& state) {
   engine::RunStandalone(state.range(0), [&] {
     generic_contention<engine::SingleWaitingTaskMutex>(state);
@@ -288,6 +295,9 @@ BENCHMARK(single_waiting_task_mutex_unlock);
 
 BENCHMARK(mutex_coro_contention)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(mutex_std_contention)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK(mutex_coro_contention_oversubscribed)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
 BENCHMARK(single_waiting_task_mutex_contention)->Range(1, 2);
 
 BENCHMARK(mutex_coro_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
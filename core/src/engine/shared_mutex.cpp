@@ -1,5 +1,11 @@
 #include <userver/engine/shared_mutex.hpp>
 
+#include <array>
+#include <cstdint>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <engine/task/task_context.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/utils/scope_guard.hpp>
 
@@ -9,11 +15,57 @@ namespace engine {
 
 namespace {
 constexpr auto kWriterLock = std::numeric_limits<Semaphore::Counter>::max();
-}
+
+constexpr std::size_t kBiasedReaderSlotBits = 4;
+}  // namespace
+
+struct SharedMutex::BiasedReaders final {
+  using Slot = std::atomic<std::size_t>;
+
+  // Lock and unlock from the same task use the same slot, so each slot counts
+  // the readers that are inside right now
+  Slot& GetSlot() noexcept {
+    constexpr std::uint64_t kGoldenRatio = 0x9E3779B97F4A7C15;
+    const auto task = reinterpret_cast<std::uintptr_t>(
+        &current_task::GetCurrentTaskContext());
+    const auto mixed = static_cast<std::uint64_t>(task) * kGoldenRatio;
+    return *slots[mixed >> (64 - kBiasedReaderSlotBits)];
+  }
+
+  void Release(Slot& slot, const std::atomic_size_t& waiting_writers_count) {
+    const auto old_readers = slot.fetch_sub(1);
+    UASSERT_MSG(old_readers > 0, "unlock_shared without lock_shared");
+    if (old_readers == 1 && waiting_writers_count.load() != 0) {
+      drained_event.Send();
+    }
+  }
+
+  bool IsDrained() const noexcept {
+    for (const auto& slot : slots) {
+      if (slot->load() != 0) return false;
+    }
+    return true;
+  }
+
+  std::array<concurrent::impl::InterferenceShield<Slot>,
+             std::size_t{1} << kBiasedReaderSlotBits>
+      slots{};
+  SingleConsumerEvent drained_event;
+};
 
 SharedMutex::SharedMutex()
     : semaphore_(kWriterLock), waiting_writers_count_(0) {}
 
+SharedMutex::SharedMutex(Mode mode) : SharedMutex() {
+  if (mode == Mode::kReadBiased) {
+    biased_readers_ = std::make_unique<BiasedReaders>();
+  }
+}
+
+SharedMutex::~SharedMutex() {
+  UASSERT(!biased_readers_ || biased_readers_->IsDrained());
+}
+
 void SharedMutex::lock() {
   const auto ok = try_lock_until(Deadline{});
   UASSERT(ok);
@@ -42,19 +94,33 @@ void SharedMutex::DecWaitingWriters() {
 }
 
 bool SharedMutex::try_lock_until(Deadline deadline) {
-  waiting_writers_count_.fetch_add(1, std::memory_order_relaxed);
+  // seq_cst to see all the biased readers that have missed this writer
+  waiting_writers_count_.fetch_add(1);
 
   utils::ScopeGuard stop_wait([this] { DecWaitingWriters(); });
-  if (semaphore_.try_lock_shared_until_count(deadline, kWriterLock)) {
-    stop_wait.Release();
-    return true;
+  if (!semaphore_.try_lock_shared_until_count(deadline, kWriterLock)) {
+    return false;
+  }
+
+  if (biased_readers_ && !WaitForNoBiasedReaders(deadline)) {
+    semaphore_.unlock_shared_count(kWriterLock);
+    return false;
   }
-  return false;
+
+  stop_wait.Release();
+  return true;
 }
 
 bool SharedMutex::try_lock() { return try_lock_until(Deadline::Passed()); }
 
 void SharedMutex::lock_shared() {
+  if (biased_readers_) {
+    const engine::TaskCancellationBlocker block_cancels;
+    const auto ok = TryLockBiasedShared(Deadline{});
+    UASSERT(ok);
+    return;
+  }
+
   WaitForNoWaitingWriters(Deadline{});
 
   /*
@@ -67,20 +133,56 @@ void SharedMutex::lock_shared() {
   semaphore_.lock_shared();
 }
 
-void SharedMutex::unlock_shared() { semaphore_.unlock_shared(); }
+void SharedMutex::unlock_shared() {
+  if (biased_readers_) {
+    biased_readers_->Release(biased_readers_->GetSlot(),
+                             waiting_writers_count_);
+    return;
+  }
+
+  semaphore_.unlock_shared();
+}
 
 bool SharedMutex::try_lock_shared() {
+  if (biased_readers_) return TryLockBiasedShared(Deadline::Passed());
+
   if (HasWaitingWriter()) return false;
   return semaphore_.try_lock_shared();
 }
 
 bool SharedMutex::try_lock_shared_until(Deadline deadline) {
+  if (biased_readers_) return TryLockBiasedShared(deadline);
+
   if (!WaitForNoWaitingWriters(deadline)) return false;
 
   /* Same deliberate race, see comment in lock_shared() */
   return semaphore_.try_lock_shared_until(deadline);
 }
 
+bool SharedMutex::TryLockBiasedShared(Deadline deadline) {
+  auto& slot = biased_readers_->GetSlot();
+  while (true) {
+    // seq_cst, either this reader sees the writer or the writer sees it
+    slot.fetch_add(1);
+    if (waiting_writers_count_.load() == 0) return true;
+
+    // Writers have priority, step back and wait for them as the default mode
+    // readers do
+    biased_readers_->Release(slot, waiting_writers_count_);
+    if (!WaitForNoWaitingWriters(deadline)) return false;
+  }
+}
+
+bool SharedMutex::WaitForNoBiasedReaders(Deadline deadline) {
+  const engine::TaskCancellationBlocker block_cancels;
+  while (!biased_readers_->IsDrained()) {
+    if (!biased_readers_->drained_event.WaitForEventUntil(deadline)) {
+      return biased_readers_->IsDrained();
+    }
+  }
+  return true;
+}
+
 bool SharedMutex::HasWaitingWriter() const noexcept {
   return waiting_writers_count_.load() > 0;
 }
@@ -5,14 +5,18 @@
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/shared_mutex.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
-void shared_mutex_benchmark(benchmark::State& state) {
+namespace {
+
+void DoSharedMutexBenchmark(benchmark::State& state,
+                            engine::SharedMutex::Mode mode) {
   engine::RunStandalone(state.range(0), [&] {
     int variable = 0;
-    engine::SharedMutex mutex;
+    engine::SharedMutex mutex{mode};
     std::atomic<bool> is_running(true);
 
     std::vector<engine::TaskWithResult<void>> tasks;
@@ -44,6 +48,68 @@ void shared_mutex_benchmark(benchmark::State& state) {
     }
   });
 }
+
+// Readers on all the threads and a rare short writer
+void DoReadMostlyBenchmark(benchmark::State& state,
+                           engine::SharedMutex::Mode mode) {
+  engine::RunStandalone(state.range(0), [&] {
+    int variable = 0;
+    engine::SharedMutex mutex{mode};
+    std::atomic<bool> is_running(true);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(state.range(0));
+    for (int i = 0; i < state.range(0) - 1; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        while (is_running) {
+          std::shared_lock lock(mutex);
+          benchmark::DoNotOptimize(variable);
+        }
+      }));
+    }
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (is_running) {
+        {
+          std::unique_lock lock(mutex);
+          ++variable;
+        }
+        engine::SleepFor(std::chrono::milliseconds{1});
+      }
+    }));
+
+    for ([[maybe_unused]] auto _ : state) {
+      std::shared_lock lock(mutex);
+      benchmark::DoNotOptimize(variable);
+    }
+
+    is_running = false;
+
+    for (auto& task : tasks) {
+      task.Get();
+    }
+  });
+}
+
+}  // namespace
+
+void shared_mutex_benchmark(benchmark::State& state) {
+  DoSharedMutexBenchmark(state, engine::SharedMutex::Mode::kDefault);
+}
 BENCHMARK(shared_mutex_benchmark)->DenseRange(1, 6);
 
+void shared_mutex_read_biased_benchmark(benchmark::State& state) {
+  DoSharedMutexBenchmark(state, engine::SharedMutex::Mode::kReadBiased);
+}
+BENCHMARK(shared_mutex_read_biased_benchmark)->DenseRange(1, 6);
+
+void shared_mutex_read_mostly_benchmark(benchmark::State& state) {
+  DoReadMostlyBenchmark(state, engine::SharedMutex::Mode::kDefault);
+}
+BENCHMARK(shared_mutex_read_mostly_benchmark)->DenseRange(1, 6);
+
+void shared_mutex_read_biased_read_mostly_benchmark(benchmark::State& state) {
+  DoReadMostlyBenchmark(state, engine::SharedMutex::Mode::kReadBiased);
+}
+BENCHMARK(shared_mutex_read_biased_read_mostly_benchmark)->DenseRange(1, 6);
+
 USERVER_NAMESPACE_END
@@ -153,4 +153,76 @@ UTEST(SharedMutex, SampleSharedMutex) {
   /// [Sample engine::SharedMutex usage]
 }
 
+UTEST(SharedMutexReadBiased, SharedAndUniqueLock) {
+  engine::SharedMutex mutex{engine::SharedMutex::Mode::kReadBiased};
+
+  std::unique_lock<engine::SharedMutex> lock(mutex);
+  EXPECT_FALSE(mutex.try_lock_shared());
+  auto reader = utils::Async(
+      "", [&mutex] { std::shared_lock<engine::SharedMutex> lock(mutex); });
+
+  reader.WaitFor(std::chrono::milliseconds(50));
+  EXPECT_FALSE(reader.IsFinished());
+
+  lock.unlock();
+  UEXPECT_NO_THROW(reader.Get());
+
+  EXPECT_TRUE(mutex.try_lock_shared());
+  mutex.unlock_shared();
+}
+
+UTEST_MT(SharedMutexReadBiased, WriterWaitsForReaders, 2) {
+  engine::SharedMutex mutex{engine::SharedMutex::Mode::kReadBiased};
+
+  std::shared_lock<engine::SharedMutex> lock(mutex);
+  EXPECT_FALSE(mutex.try_lock());
+  EXPECT_FALSE(mutex.try_lock_for(std::chrono::milliseconds(10)));
+
+  auto writer = utils::Async(
+      "", [&mutex] { std::unique_lock<engine::SharedMutex> lock(mutex); });
+  writer.WaitFor(std::chrono::milliseconds(50));
+  EXPECT_FALSE(writer.IsFinished());
+
+  // the pending writer blocks the new readers
+  auto reader = utils::Async(
+      "", [&mutex] { std::shared_lock<engine::SharedMutex> lock(mutex); });
+  reader.WaitFor(std::chrono::milliseconds(50));
+  EXPECT_FALSE(reader.IsFinished());
+
+  lock.unlock();
+  UEXPECT_NO_THROW(writer.Get());
+  UEXPECT_NO_THROW(reader.Get());
+}
+
+UTEST_MT(SharedMutexReadBiased, ReadersAndWriters, 4) {
+  constexpr int kReaders = 6;
+  constexpr int kWrites = 1000;
+
+  engine::SharedMutex mutex{engine::SharedMutex::Mode::kReadBiased};
+  std::pair<int, int> data{0, 0};
+  std::atomic<bool> is_running{true};
+
+  std::vector<engine::TaskWithResult<void>> readers;
+  readers.reserve(kReaders);
+  for (int i = 0; i < kReaders; ++i) {
+    readers.push_back(utils::Async("reader", [&] {
+      while (is_running) {
+        std::shared_lock<engine::SharedMutex> lock(mutex);
+        ASSERT_EQ(data.first, data.second);
+      }
+    }));
+  }
+
+  for (int i = 0; i < kWrites; ++i) {
+    std::unique_lock<engine::SharedMutex> lock(mutex);
+    ++data.first;
+    engine::Yield();
+    ++data.second;
+  }
+  is_running = false;
+
+  for (auto& reader : readers) UEXPECT_NO_THROW(reader.Get());
+  EXPECT_EQ(data.first, kWrites);
+}
+
 USERVER_NAMESPACE_END
@@ -11,7 +11,9 @@ class SingleConsumerEvent::EventWaitStrategy final : public impl::WaitStrategy {
  public:
   EventWaitStrategy(SingleConsumerEvent& event, impl::TaskContext& current,
                     Deadline deadline)
-      : WaitStrategy(deadline), event_(event), current_(current) {}
+      : WaitStrategy(deadline, impl::WaitReason::kEvent),
+        event_(event),
+        current_(current) {}
 
   void SetupWakeups() override {
     if (event_.waiters_->GetSignalOrAppend(&current_)) {
@@ -16,7 +16,9 @@ class SingleUseEventWaitStrategy final : public impl::WaitStrategy {
  public:
   SingleUseEventWaitStrategy(std::atomic<std::uintptr_t>& state,
                              impl::TaskContext& current)
-      : WaitStrategy({}), state_(state), current_(current) {}
+      : WaitStrategy({}, impl::WaitReason::kEvent),
+        state_(state),
+        current_(current) {}
 
   void SetupWakeups() override {
     UASSERT_MSG(state_ == kNotSignaledState || state_ == kSignaledState,
@@ -45,6 +45,24 @@ BENCHMARK(run_in_ev_loop_benchmark);
 }
 BENCHMARK(successful_wait_for_benchmark);
 
+// A timeout that is set and then cancelled, should not touch the libev timers
+// for the timeouts served by engine::ev::TimerWheel
+void successful_wait_for_timeout_benchmark(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const std::chrono::milliseconds timeout{state.range(0)};
+    for ([[maybe_unused]] auto _ : state) {
+      auto task = engine::AsyncNoSpan([] { engine::Yield(); });
+      task.WaitFor(timeout);
+
+      if (!task.IsFinished()) abort();
+    }
+  });
+}
+BENCHMARK(successful_wait_for_timeout_benchmark)
+    ->Arg(5)
+    ->Arg(100)
+    ->Arg(10'000);
+
 void unreached_task_deadline_benchmark(benchmark::State& state,
                                        bool has_task_deadline) {
   engine::RunStandalone([&] {
@@ -1,13 +1,13 @@
 #include <userver/engine/subprocess/process_starter.hpp>
 
+#include <fcntl.h>
+#include <spawn.h>
 #include <sys/types.h>
-#include <sys/wait.h>
 #include <unistd.h>
 
 #include <csignal>
-#include <cstdio>
-#include <cstring>
-#include <iostream>
+#include <string_view>
+#include <system_error>
 
 #include <fmt/format.h>
 #include <boost/algorithm/string.hpp>
@@ -22,6 +22,7 @@
 #include <engine/ev/thread_pool.hpp>
 #include <engine/task/task_processor.hpp>
 #include <userver/engine/future.hpp>
+#include <userver/engine/io/pipe.hpp>
 #include <userver/engine/task/cancel.hpp>
 
 #include <engine/subprocess/child_process_impl.hpp>
@@ -31,44 +32,142 @@ USERVER_NAMESPACE_BEGIN
 namespace engine::subprocess {
 namespace {
 
-void DoExecve(const std::string& command, const std::vector<std::string>& args,
-              const EnvironmentVariables& env,
-              const std::optional<std::string>& stdout_file,
-              const std::optional<std::string>& stderr_file) {
-  if (stdout_file) {
-    if (!std::freopen(stdout_file->c_str(), "a", stdout)) {
-      utils::CheckSyscall(-1, "freopen stdout to {}", *stdout_file);
-    }
+void CheckSpawnError(int err, std::string_view action) {
+  if (err) {
+    throw std::system_error(std::error_code(err, std::system_category()),
+                            fmt::format("Error while {}", action));
   }
-  if (stderr_file) {
-    if (!std::freopen(stderr_file->c_str(), "a", stderr)) {
-      utils::CheckSyscall(-1, "freopen stderr to {}", *stdout_file);
-    }
+}
+
+class SpawnFileActions final {
+ public:
+  SpawnFileActions() {
+    CheckSpawnError(::posix_spawn_file_actions_init(&actions_),
+                    "initializing spawn file actions");
   }
-  std::vector<char*> argv_ptrs;
-  std::vector<std::string> envp_buf;
-  std::vector<char*> envp_ptrs;
-  argv_ptrs.reserve(args.size() + 2);
-  envp_buf.reserve(env.size());
-  envp_ptrs.reserve(env.size() + 1);
-
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-  argv_ptrs.push_back(const_cast<char*>(command.c_str()));
-  for (const auto& arg : args) {
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-    argv_ptrs.push_back(const_cast<char*>(arg.c_str()));
+
+  ~SpawnFileActions() { ::posix_spawn_file_actions_destroy(&actions_); }
+
+  SpawnFileActions(const SpawnFileActions&) = delete;
+  SpawnFileActions& operator=(const SpawnFileActions&) = delete;
+
+  // Same as freopen(path, "a", ...) in the child
+  void AddAppendFile(int fd, const std::string& path) {
+    CheckSpawnError(
+        ::posix_spawn_file_actions_addopen(&actions_, fd, path.c_str(),
+                                           O_WRONLY | O_CREAT | O_APPEND, 0666),
+        fmt::format("redirecting fd {} to {}", fd, path));
+  }
+
+  void AddPipe(int fd, io::PipeWriter& writer) {
+    // the writing end is used by the child only, it must not be non-blocking
+    const auto flags = utils::CheckSyscall(::fcntl(writer.Fd(), F_GETFL),
+                                           "getting pipe flags");
+    utils::CheckSyscall(::fcntl(writer.Fd(), F_SETFL, flags & ~O_NONBLOCK),
+                        "making pipe blocking");
+    CheckSpawnError(
+        ::posix_spawn_file_actions_adddup2(&actions_, writer.Fd(), fd),
+        fmt::format("redirecting fd {} to a pipe", fd));
   }
-  argv_ptrs.push_back(nullptr);
 
-  for (const auto& elem : env) {
-    envp_buf.emplace_back(elem.first + '=' + elem.second);
+  const posix_spawn_file_actions_t* Get() const { return &actions_; }
+
+ private:
+  posix_spawn_file_actions_t actions_{};
+};
+
+// The arguments are prepared before entering the ev thread
+class SpawnArgs final {
+ public:
+  SpawnArgs(const std::string& command, const std::vector<std::string>& args,
+            const EnvironmentVariables& env) {
+    argv_ptrs_.reserve(args.size() + 2);
+    envp_buf_.reserve(env.size());
+    envp_ptrs_.reserve(env.size() + 1);
+
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-    envp_ptrs.push_back(const_cast<char*>(envp_buf.back().c_str()));
+    argv_ptrs_.push_back(const_cast<char*>(command.c_str()));
+    for (const auto& arg : args) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      argv_ptrs_.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv_ptrs_.push_back(nullptr);
+
+    for (const auto& elem : env) {
+      envp_buf_.emplace_back(elem.first + '=' + elem.second);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      envp_ptrs_.push_back(const_cast<char*>(envp_buf_.back().c_str()));
+    }
+    envp_ptrs_.push_back(nullptr);
   }
-  envp_ptrs.push_back(nullptr);
 
-  utils::CheckSyscall(
-      execve(command.c_str(), argv_ptrs.data(), envp_ptrs.data()), "execve");
+  char* const* Argv() const { return argv_ptrs_.data(); }
+  char* const* Envp() const { return envp_ptrs_.data(); }
+
+ private:
+  std::vector<char*> argv_ptrs_;
+  std::vector<std::string> envp_buf_;
+  std::vector<char*> envp_ptrs_;
+};
+
+// posix_spawn does not copy the page tables of the parent (it uses vfork or
+// clone(CLONE_VM | CLONE_VFORK) internally), so the ev thread is blocked only
+// until the child calls execve. The child is registered in the same ev thread
+// iteration, that processes SIGCHLD.
+ChildProcess Spawn(ev::ThreadControl& thread_control,
+                   const std::string& command,
+                   const std::vector<std::string>& args,
+                   const EnvironmentVariables& env,
+                   const SpawnFileActions& file_actions) {
+  tracing::Span span("ProcessStarter::Exec");
+  span.AddTag("command", command);
+  LOG_DEBUG() << "do posix_spawn(), command=" << command << ", args=["
+              << (args.empty() ? "" : '\'' + boost::join(args, "' '") + '\'')
+              << "], env=["
+              << (env.empty()
+                      ? ""
+                      : boost::join(env | boost::adaptors::transformed(
+                                              [](const auto& key_value) {
+                                                return key_value.first + '=' +
+                                                       key_value.second;
+                                              }),
+                                    ", "))
+              << ']';
+  const SpawnArgs spawn_args{command, args, env};
+
+  Promise<ChildProcess> promise;
+  auto future = promise.get_future();
+  thread_control.RunInEvLoopAsync([&, promise = std::move(promise)]() mutable {
+    pid_t pid = 0;
+    const auto err =
+        ::posix_spawn(&pid, command.c_str(), file_actions.Get(), nullptr,
+                      spawn_args.Argv(), spawn_args.Envp());
+    if (err) {
+      promise.set_exception(std::make_exception_ptr(std::system_error(
+          std::error_code(err, std::system_category()),
+          "Cannot execute child '" + command + '\'')));
+      return;
+    }
+
+    span.AddTag("child-process-pid", pid);
+    LOG_DEBUG() << "Started child process with pid=" << pid;
+    Promise<ChildProcessStatus> exec_result_promise;
+    auto res = ChildProcessMapSet(
+        pid, ev::ChildProcessMapValue(std::move(exec_result_promise)));
+    if (res.second) {
+      promise.set_value(ChildProcess{
+          ChildProcessImpl{pid, res.first->status_promise.get_future()}});
+    } else {
+      std::string msg = "process with pid=" + std::to_string(pid) +
+                        " already exists in child_process_map";
+      LOG_ERROR() << msg << ", send SIGKILL";
+      ChildProcessImpl(pid, Future<ChildProcessStatus>{}).SendSignal(SIGKILL);
+      promise.set_exception(std::make_exception_ptr(std::runtime_error(msg)));
+    }
+  });
+
+  engine::TaskCancellationBlocker cancel_blocker;
+  return future.get();
 }
 
 }  // namespace
@@ -82,59 +181,26 @@ ChildProcess ProcessStarter::Exec(
     const EnvironmentVariables& env,
     const std::optional<std::string>& stdout_file,
     const std::optional<std::string>& stderr_file) {
-  tracing::Span span("ProcessStarter::Exec");
-  span.AddTag("command", command);
-  Promise<ChildProcess> promise;
-  auto future = promise.get_future();
-  thread_control_.RunInEvLoopAsync([&, promise = std::move(promise)]() mutable {
-    LOG_DEBUG() << "do fork() + execve(), command=" << command << ", args=["
-                << (args.empty() ? "" : '\'' + boost::join(args, "' '") + '\'')
-                << "], env=["
-                << (env.empty()
-                        ? ""
-                        : boost::join(env | boost::adaptors::transformed(
-                                                [](const auto& key_value) {
-                                                  return key_value.first + '=' +
-                                                         key_value.second;
-                                                }),
-                                      ", "))
-                << ']';
-    auto pid = utils::CheckSyscall(fork(), "fork");
-    if (pid) {
-      // in parent thread
-      span.AddTag("child-process-pid", pid);
-      LOG_DEBUG() << "Started child process with pid=" << pid;
-      Promise<ChildProcessStatus> exec_result_promise;
-      auto res = ChildProcessMapSet(
-          pid, ev::ChildProcessMapValue(std::move(exec_result_promise)));
-      if (res.second) {
-        promise.set_value(ChildProcess{
-            ChildProcessImpl{pid, res.first->status_promise.get_future()}});
-      } else {
-        std::string msg = "process with pid=" + std::to_string(pid) +
-                          " already exists in child_process_map";
-        LOG_ERROR() << msg << ", send SIGKILL";
-        ChildProcessImpl(pid, Future<ChildProcessStatus>{}).SendSignal(SIGKILL);
-        promise.set_exception(std::make_exception_ptr(std::runtime_error(msg)));
-      }
-    } else {
-      // in child thread
-      try {
-        try {
-          DoExecve(command, args, env, stdout_file, stderr_file);
-        } catch (const std::exception& ex) {
-          std::cerr << "Cannot execute child: " << ex.what();
-        }
-      } catch (...) {
-        // must not do anything in a child
-      }
-      // on success execve does not return
-      std::abort();
-    }
-  });
+  SpawnFileActions file_actions;
+  if (stdout_file) file_actions.AddAppendFile(STDOUT_FILENO, *stdout_file);
+  if (stderr_file) file_actions.AddAppendFile(STDERR_FILENO, *stderr_file);
+  return Spawn(thread_control_, command, args, env, file_actions);
+}
 
-  engine::TaskCancellationBlocker cancel_blocker;
-  return future.get();
+ChildProcess ProcessStarter::ExecWithPipes(const std::string& command,
+                                           const std::vector<std::string>& args,
+                                           const EnvironmentVariables& env,
+                                           io::Pipe* stdout_pipe,
+                                           io::Pipe* stderr_pipe) {
+  SpawnFileActions file_actions;
+  if (stdout_pipe) file_actions.AddPipe(STDOUT_FILENO, stdout_pipe->writer);
+  if (stderr_pipe) file_actions.AddPipe(STDERR_FILENO, stderr_pipe->writer);
+  auto child = Spawn(thread_control_, command, args, env, file_actions);
+
+  // the reading ends get EOF once the child exits
+  if (stdout_pipe && stdout_pipe->writer.IsValid()) stdout_pipe->writer.Close();
+  if (stderr_pipe && stderr_pipe->writer.IsValid()) stderr_pipe->writer.Close();
+  return child;
 }
 
 ChildProcess ProcessStarter::Exec(
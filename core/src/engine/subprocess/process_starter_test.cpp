@@ -3,8 +3,10 @@
 #include <sys/param.h>
 #include <unistd.h>
 
+#include <array>
 #include <chrono>
 #include <string>
+#include <system_error>
 #include <thread>
 #include <vector>
 
@@ -19,6 +21,7 @@
 
 #include <engine/ev/thread_control.hpp>
 #include <engine/ev/thread_pool.hpp>
+#include <userver/engine/io/pipe.hpp>
 #include <userver/engine/subprocess/child_process.hpp>
 #include <userver/engine/subprocess/process_starter.hpp>
 #include <userver/engine/task/task.hpp>
@@ -65,6 +68,43 @@ UTEST(Subprocess, False) {
   EXPECT_NE(0, status.GetExitCode());
 }
 
+UTEST(Subprocess, NotExecutable) {
+  engine::subprocess::ProcessStarter starter(
+      engine::current_task::GetTaskProcessor());
+
+  UEXPECT_THROW(starter.Exec("/nonexistent/program", {}), std::system_error);
+}
+
+UTEST(Subprocess, Pipes) {
+  engine::subprocess::ProcessStarter starter(
+      engine::current_task::GetTaskProcessor());
+
+  engine::io::Pipe stdout_pipe;
+  engine::io::Pipe stderr_pipe;
+  auto child = starter.ExecWithPipes(
+      "/bin/sh", {"-c", "echo out; echo err >&2"},
+      engine::subprocess::GetCurrentEnvironmentVariables(), &stdout_pipe,
+      &stderr_pipe);
+
+  const auto read_all = [](engine::io::PipeReader& reader) {
+    const auto deadline =
+        engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+    std::string result;
+    std::array<char, 16> buf{};
+    while (const auto size =
+               reader.ReadSome(buf.data(), buf.size(), deadline)) {
+      result.append(buf.data(), size);
+    }
+    return result;
+  };
+  EXPECT_EQ(read_all(stdout_pipe.reader), "out\n");
+  EXPECT_EQ(read_all(stderr_pipe.reader), "err\n");
+
+  const auto status = child.Get();
+  ASSERT_TRUE(status.IsExited());
+  EXPECT_EQ(0, status.GetExitCode());
+}
+
 UTEST(Subprocess, CheckLogClosesFds) {
   auto file = fs::blocking::TempFile::Create("/tmp", kLogFilePart);
   auto logger = logging::MakeFileLogger("to_file", file.GetPath(),
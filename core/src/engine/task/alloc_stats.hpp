@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+/// Heap usage of a task, accounted only after
+/// current_task::EnableAllocStats() and only if the service uses jemalloc
+struct TaskAllocStats final {
+  std::uint64_t allocated_bytes{0};
+  std::uint64_t deallocated_bytes{0};
+
+  // thread counters at the start of the current slice
+  std::uint64_t slice_allocated_start{0};
+  std::uint64_t slice_deallocated_start{0};
+};
+
+}  // namespace engine::impl
+
+namespace engine::current_task {
+
+/// Starts accounting the bytes allocated and freed by the current task
+void EnableAllocStats();
+
+/// nullptr if current_task::EnableAllocStats() was not called, includes the
+/// allocations made so far in the current slice of the task
+const impl::TaskAllocStats* GetAllocStats() noexcept;
+
+}  // namespace engine::current_task
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,38 @@
+#include <engine/task/alloc_stats.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kAllocationSize = 1 << 20;
+
+}  // namespace
+
+UTEST(AllocStats, DisabledByDefault) {
+  EXPECT_EQ(engine::current_task::GetAllocStats(), nullptr);
+}
+
+UTEST(AllocStats, AcrossSlices) {
+  engine::current_task::EnableAllocStats();
+  if (!engine::current_task::GetAllocStats()) {
+    GTEST_SKIP() << "The allocations are accounted with jemalloc only";
+  }
+
+  auto first = std::make_unique<std::vector<char>>(kAllocationSize);
+  engine::Yield();
+  auto second = std::make_unique<std::vector<char>>(kAllocationSize);
+  first.reset();
+
+  const auto* const stats = engine::current_task::GetAllocStats();
+  ASSERT_TRUE(stats);
+  EXPECT_GE(stats->allocated_bytes, 2 * kAllocationSize);
+  EXPECT_GE(stats->deallocated_bytes, kAllocationSize);
+}
+
+USERVER_NAMESPACE_END
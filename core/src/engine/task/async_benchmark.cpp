@@ -1,11 +1,16 @@
 #include <benchmark/benchmark.h>
 
 #include <array>
+#include <atomic>
 #include <thread>
+#include <vector>
 
+#include <engine/impl/standalone.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/impl/task_local_storage.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/fixed_array.hpp>
 
@@ -44,6 +49,18 @@ void async_comparisons_coro(benchmark::State& state) {
 }
 BENCHMARK(async_comparisons_coro)->RangeMultiplier(2)->Range(1, 32);
 
+void async_comparisons_stackless(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    std::uint64_t constructed_joined_count = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      engine::AsyncStacklessNoSpan([] {}).Wait();
+      ++constructed_joined_count;
+    }
+    benchmark::DoNotOptimize(constructed_joined_count);
+  });
+}
+BENCHMARK(async_comparisons_stackless)->RangeMultiplier(2)->Range(1, 32);
+
 void wrap_call_single(benchmark::State& state) {
   engine::RunStandalone([&] {
     for ([[maybe_unused]] auto _ : state) {
@@ -99,4 +116,60 @@ void async_comparisons_coro_spanned(benchmark::State& state) {
 }
 BENCHMARK(async_comparisons_coro_spanned)->RangeMultiplier(2)->Range(1, 32);
 
+// Every worker runs a producer that spawns short tasks and waits for them, so
+// the task queue is hammered by all the workers at once.
+void async_multi_producer_storm(benchmark::State& state,
+                                engine::TaskQueueType task_queue) {
+  auto task_processor = engine::impl::TaskProcessorHolder::Make(
+      state.range(0), "bench-worker", engine::impl::MakeTaskProcessorPools({}),
+      task_queue);
+  engine::impl::RunOnTaskProcessorSync(*task_processor, [&] {
+    constexpr std::size_t kBatchSize = 16;
+    std::atomic<std::uint64_t> tasks_spawned{0};
+
+    const auto produce = [&tasks_spawned] {
+      std::vector<engine::TaskWithResult<void>> batch;
+      batch.reserve(kBatchSize);
+      while (!engine::current_task::ShouldCancel()) {
+        for (std::size_t i = 0; i < kBatchSize; ++i) {
+          batch.push_back(engine::AsyncNoSpan([] {}));
+        }
+        for (auto& task : batch) task.Wait();
+        batch.clear();
+        tasks_spawned.fetch_add(kBatchSize, std::memory_order_relaxed);
+      }
+    };
+
+    std::vector<engine::TaskWithResult<void>> producers;
+    producers.reserve(state.range(0) - 1);
+    for (int i = 0; i < state.range(0) - 1; ++i) {
+      producers.push_back(engine::AsyncNoSpan(produce));
+    }
+
+    std::vector<engine::TaskWithResult<void>> batch;
+    batch.reserve(kBatchSize);
+    for ([[maybe_unused]] auto _ : state) {
+      for (std::size_t i = 0; i < kBatchSize; ++i) {
+        batch.push_back(engine::AsyncNoSpan([] {}));
+      }
+      for (auto& task : batch) task.Wait();
+      batch.clear();
+      tasks_spawned.fetch_add(kBatchSize, std::memory_order_relaxed);
+    }
+
+    for (auto& producer : producers) producer.SyncCancel();
+
+    state.counters["tasks"] =
+        benchmark::Counter(tasks_spawned.load(), benchmark::Counter::kIsRate);
+  });
+}
+BENCHMARK_CAPTURE(async_multi_producer_storm, global_task_queue,
+                  engine::TaskQueueType::kGlobalTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_CAPTURE(async_multi_producer_storm, work_stealing_task_queue,
+                  engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
 USERVER_NAMESPACE_END
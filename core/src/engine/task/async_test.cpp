@@ -1,6 +1,7 @@
 #include <userver/utest/utest.hpp>
 
 #include <atomic>
+#include <stdexcept>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
@@ -326,4 +327,38 @@ UTEST_MT(Async, CancelNotifyRace, 4) {
   }
 }
 
+UTEST_MT(AsyncStackless, Result, 2) {
+  auto task = engine::AsyncStacklessNoSpan([](int x) { return x * 2; }, 21);
+  EXPECT_EQ(task.Get(), 42);
+}
+
+UTEST(AsyncStackless, RunsWithoutCoroutine) {
+  auto task = engine::AsyncStacklessNoSpan([] {
+    auto& context = engine::current_task::GetCurrentTaskContext();
+    EXPECT_TRUE(context.IsStackless());
+    EXPECT_EQ(engine::current_task::GetStackSize(), 0);
+  });
+  UEXPECT_NO_THROW(task.Get());
+}
+
+UTEST(AsyncStackless, Exception) {
+  auto task = engine::AsyncStacklessNoSpan(
+      [] { throw std::runtime_error("stackless"); });
+  UEXPECT_THROW_MSG(task.Get(), std::runtime_error, "stackless");
+}
+
+UTEST(AsyncStackless, CancelledBeforeStart) {
+  std::atomic<bool> started{false};
+  auto task = engine::AsyncStacklessNoSpan([&started] { started = true; });
+  task.RequestCancel();
+  task.Wait();
+  EXPECT_EQ(task.GetState(), engine::Task::State::kCancelled);
+  EXPECT_FALSE(started);
+}
+
+UTEST_DEATH(AsyncStacklessDeathTest, Suspend) {
+  auto task = engine::AsyncStacklessNoSpan([] { engine::Yield(); });
+  EXPECT_UINVARIANT_FAILURE(task.Get());
+}
+
 USERVER_NAMESPACE_END
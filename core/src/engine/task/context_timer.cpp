@@ -7,12 +7,21 @@
 #include <userver/utils/assert.hpp>
 
 #include <engine/ev/data_pipe_to_ev.hpp>
+#include <engine/ev/timer_wheel.hpp>
 #include <engine/task/task_context.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::impl {
 
+namespace {
+
+// Shorter timeouts go to libev timers, as the wheel fires with up to
+// a TimerWheel::kTick delay, which is noticeable for short sleeps
+constexpr std::chrono::milliseconds kMinTimerWheelTimeout{20};
+
+}  // namespace
+
 enum class Action {
   kCancel,
   kWakeupByEpoch,
@@ -38,7 +47,8 @@ class TimerArmer : public ev::MultiShotAsyncPayload<TimerArmer<Derived>> {
 
 // NOLINTNEXTLINE(fuchsia-multiple-inheritance)
 class ContextTimer::Impl final : public TimerArmer<Impl>,
-                                 public Finalizer<Impl> {
+                                 public Finalizer<Impl>,
+                                 public ev::TimerWheel::Entry {
  public:
   struct Params {
     Action action{};
@@ -64,6 +74,12 @@ class ContextTimer::Impl final : public TimerArmer<Impl>,
  private:
   void StopTimerInEvThread() noexcept;
 
+  void ArmEvTimer(Params params);
+  void DisarmEvTimer();
+
+  void OnExpiredLocked() noexcept override;
+  void OnExpired() noexcept override;
+
   static void OnTimer(struct ev_loop*, ev_timer* w, int) noexcept;
   static void InvokeTimerFunction(const Params& params, TaskContext& context);
   void DoOnTimer();
@@ -73,6 +89,16 @@ class ContextTimer::Impl final : public TimerArmer<Impl>,
   Params params_;
   ev_timer timer_{};
   ev::DataPipeToEv<Params> params_pipe_to_ev_;
+
+  // TimerWheel path, wheel_params_ are only modified while disarmed
+  Params wheel_params_;
+  // Owned by the ev thread between OnExpiredLocked() and OnExpired()
+  Params fired_params_;
+  boost::intrusive_ptr<TaskContext> fired_context_;
+
+  bool is_ev_timer_armed_{false};
+  // Payloads referencing *this could be in the ev thread queue
+  bool is_ev_timer_used_{false};
 };
 
 ContextTimer::Impl::Impl() {
@@ -109,16 +135,55 @@ void ContextTimer::Impl::Restart(Params params) {
     return;
   }
 
+  auto* wheel = thread_control_->GetTimerWheel();
+  if (wheel && params.deadline.TimeLeftApprox() >= kMinTimerWheelTimeout) {
+    // Neither arming nor a later Finalize() touch the libev timers heap
+    wheel->Disarm(*this);
+    wheel_params_ = params;
+    wheel->Arm(*this, params.deadline);
+    if (is_ev_timer_armed_) DisarmEvTimer();
+    return;
+  }
+
+  if (wheel) wheel->Disarm(*this);
+  ArmEvTimer(std::move(params));
+}
+
+void ContextTimer::Impl::ArmEvTimer(Params params) {
+  is_ev_timer_armed_ = true;
+  is_ev_timer_used_ = true;
+
+  const auto deadline = params.deadline;
   params_pipe_to_ev_.Push(std::move(params));
   if (PrepareEnqueue()) {
-    thread_control_->RunPayloadInEvLoopDeferred(GetTimerArmer(),
-                                                params.deadline);
+    thread_control_->RunPayloadInEvLoopDeferred(GetTimerArmer(), deadline);
+  }
+}
+
+void ContextTimer::Impl::DisarmEvTimer() {
+  is_ev_timer_armed_ = false;
+
+  // An unreachable deadline stops the timer in DoArmTimerInEvThread()
+  params_pipe_to_ev_.Push({});
+  if (PrepareEnqueue()) {
+    thread_control_->RunPayloadInEvLoopDeferred(GetTimerArmer(), {});
   }
 }
 
 void ContextTimer::Impl::Finalize() {
   if (!WasStarted()) return;
 
+  if (auto* wheel = thread_control_->GetTimerWheel()) {
+    wheel->Disarm(*this);
+    if (!is_ev_timer_used_) {
+      // Nothing references *this in the ev thread, except for a firing
+      // wheel entry that holds its own context reference. The caller of
+      // Finalize() holds a context reference, so *this survives the reset.
+      context_.reset();
+      return;
+    }
+  }
+
   // We cannot use *this as payload here, because with MultiShotAsyncPayload,
   // two ev runs with the same data can happen. The first run would drop
   // 'context_', potentially destroying *this. The second run would
@@ -135,6 +200,10 @@ void ContextTimer::Impl::DoArmTimerInEvThread() {
   }
 
   params_ = std::move(*params);
+  if (!params_.deadline.IsReachable()) {
+    StopTimerInEvThread();
+    return;
+  }
 
   using LibEvDuration = std::chrono::duration<double>;
   const auto time_left =
@@ -204,6 +273,23 @@ void ContextTimer::Impl::DoOnTimer() {
   StopTimerInEvThread();
 }
 
+void ContextTimer::Impl::OnExpiredLocked() noexcept {
+  fired_params_ = wheel_params_;
+  fired_context_ = context_;
+}
+
+void ContextTimer::Impl::OnExpired() noexcept {
+  UASSERT(!engine::current_task::IsTaskProcessorThread());
+
+  const auto context = std::move(fired_context_);
+  try {
+    InvokeTimerFunction(fired_params_, *context);  // called in event loop
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "exception in ContextTimer::Impl::OnExpired(): " << ex;
+  }
+  // ContextTimer may be destroyed at this point
+}
+
 ContextTimer::ContextTimer() = default;
 
 ContextTimer::~ContextTimer() = default;
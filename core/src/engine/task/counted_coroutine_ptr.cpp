@@ -17,6 +17,16 @@ CountedCoroutinePtr::CoroPool::Coroutine& CountedCoroutinePtr::operator*() {
   return coro_->Get();
 }
 
+std::size_t CountedCoroutinePtr::GetStackSize() const {
+  UASSERT(coro_);
+  return coro_->GetStackSize();
+}
+
+void CountedCoroutinePtr::SetStackUsageTaskKind(std::string_view task_kind) {
+  UASSERT(coro_);
+  coro_->SetTaskKind(task_kind);
+}
+
 void CountedCoroutinePtr::ReturnToPool() && {
   if (coro_) std::move(*coro_).ReturnToPool();
   token_ = std::nullopt;
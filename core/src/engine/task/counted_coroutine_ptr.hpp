@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <string_view>
 
 #include <engine/coro/pool.hpp>
 #include <engine/task/task_counter.hpp>
@@ -28,6 +29,9 @@ class CountedCoroutinePtr final {
 
   CoroPool::Coroutine& operator*();
 
+  std::size_t GetStackSize() const;
+  void SetStackUsageTaskKind(std::string_view task_kind);
+
   void ReturnToPool() &&;
 
  private:
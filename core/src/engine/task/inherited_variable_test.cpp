@@ -127,6 +127,44 @@ UTEST(TaskInheritedVariable, IndependenceFromParentChanges) {
   sub_task.Get();
 }
 
+UTEST(TaskInheritedVariable, SharedBetweenChildren) {
+  constexpr std::string_view kValue1 = "value1";
+  constexpr std::string_view kValue2 = "value2";
+  constexpr std::string_view kNewValue1 = "new_value1";
+
+  kStringVariable.Emplace(kValue1);
+  kStringVariable2.Emplace(kValue2);
+  const auto* const parent_value = &kStringVariable.Get();
+
+  auto reader = utils::Async("reader", [&] {
+    // The same object is seen by all the descendants that do not modify it
+    EXPECT_EQ(&kStringVariable.Get(), parent_value);
+    auto grandchild = utils::Async("grandchild", [&] {
+      EXPECT_EQ(&kStringVariable.Get(), parent_value);
+      EXPECT_EQ(kStringVariable2.Get(), kValue2);
+    });
+    grandchild.Get();
+  });
+
+  auto writer = utils::Async("writer", [&] {
+    kStringVariable.Emplace(kNewValue1);
+    EXPECT_EQ(kStringVariable.Get(), kNewValue1);
+    EXPECT_EQ(kStringVariable2.Get(), kValue2);
+
+    auto grandchild = utils::Async("grandchild", [&] {
+      EXPECT_EQ(kStringVariable.Get(), kNewValue1);
+      EXPECT_EQ(kStringVariable2.Get(), kValue2);
+    });
+    grandchild.Get();
+  });
+
+  reader.Get();
+  writer.Get();
+
+  EXPECT_EQ(&kStringVariable.Get(), parent_value);
+  EXPECT_EQ(kStringVariable.Get(), kValue1);
+}
+
 UTEST(TaskInheritedVariable, Overwrite) {
   constexpr std::string_view kValue1 = "value1";
   constexpr std::string_view kValue2 = "value2";
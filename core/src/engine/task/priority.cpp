@@ -0,0 +1,21 @@
+#include <userver/engine/task/priority.hpp>
+
+#include <engine/task/task_context.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::current_task {
+
+void SetPriority(TaskPriority priority) {
+  GetCurrentTaskContext().SetPriority(priority);
+}
+
+TaskPriority GetPriority() { return GetCurrentTaskContext().GetPriority(); }
+
+void SetSchedulingDeadline(Deadline deadline) {
+  GetCurrentTaskContext().SetSchedulingDeadline(deadline);
+}
+
+}  // namespace engine::current_task
+
+USERVER_NAMESPACE_END
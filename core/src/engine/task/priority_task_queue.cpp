@@ -0,0 +1,152 @@
+#include <engine/task/priority_task_queue.hpp>
+
+#include <algorithm>
+
+#include <engine/task/task_context.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+constexpr std::size_t kSemaphoreInitialCount = 0;
+
+// Earliest deadline on top of the heap
+template <typename Entry>
+bool IsLater(const Entry& lhs, const Entry& rhs) noexcept {
+  return rhs.deadline < lhs.deadline;
+}
+
+}  // namespace
+
+void PriorityTaskQueue::DeadlineHeap::Push(impl::TaskContext* context,
+                                           Deadline deadline) {
+  const std::lock_guard lock(mutex_);
+  heap_.push_back({deadline, context});
+  std::push_heap(heap_.begin(), heap_.end(), IsLater<Entry>);
+  size_.store(heap_.size(), std::memory_order_relaxed);
+}
+
+bool PriorityTaskQueue::DeadlineHeap::TryPop(impl::TaskContext*& context) {
+  if (size_.load(std::memory_order_relaxed) == 0) return false;
+
+  const std::lock_guard lock(mutex_);
+  if (heap_.empty()) return false;
+  std::pop_heap(heap_.begin(), heap_.end(), IsLater<Entry>);
+  context = heap_.back().context;
+  heap_.pop_back();
+  size_.store(heap_.size(), std::memory_order_relaxed);
+  return true;
+}
+
+std::size_t PriorityTaskQueue::DeadlineHeap::GetSizeApproximate()
+    const noexcept {
+  return size_.load(std::memory_order_relaxed);
+}
+
+PriorityTaskQueue::Consumer::Consumer(PriorityTaskQueue& queue)
+    : tokens{moodycamel::ConsumerToken{queue.fifos_[kHigh]},
+             moodycamel::ConsumerToken{queue.fifos_[kDeadline]},
+             moodycamel::ConsumerToken{queue.fifos_[kNormal]},
+             moodycamel::ConsumerToken{queue.fifos_[kLow]}} {}
+
+PriorityTaskQueue::PriorityTaskQueue(const TaskProcessorConfig& config)
+    : starvation_limit_(config.priority_starvation_limit),
+      deadline_ordering_(config.priority_deadline_ordering),
+      queue_semaphore_(kSemaphoreInitialCount, config.spinning_iterations) {}
+
+void PriorityTaskQueue::Push(
+    boost::intrusive_ptr<impl::TaskContext>&& context) {
+  UASSERT(context);
+  DoPush(context.get());
+  context.detach();
+}
+
+boost::intrusive_ptr<impl::TaskContext> PriorityTaskQueue::PopBlocking() {
+  // Current thread handles only a single TaskProcessor, so it's safe to store
+  // the tokens for the task processor in a thread-local variable.
+  thread_local Consumer consumer(*this);
+
+  boost::intrusive_ptr<impl::TaskContext> context{DoPopBlocking(consumer),
+                                                  /* add_ref= */ false};
+
+  if (!context) {
+    // return "stop" token back
+    DoPush(nullptr);
+  }
+
+  return context;
+}
+
+void PriorityTaskQueue::StopProcessing() { DoPush(nullptr); }
+
+std::size_t PriorityTaskQueue::GetSizeApproximate() const noexcept {
+  std::size_t result = deadline_heap_.GetSizeApproximate();
+  for (const auto& fifo : fifos_) result += fifo.size_approx();
+  return result;
+}
+
+PriorityTaskQueue::Class PriorityTaskQueue::GetClass(
+    const impl::TaskContext* context) const noexcept {
+  // the stop signal must not wait behind the tasks
+  if (!context) return kHigh;
+
+  switch (context->GetPriority()) {
+    case TaskPriority::kHigh:
+      return kHigh;
+    case TaskPriority::kNormal:
+      if (deadline_ordering_ &&
+          context->GetSchedulingDeadline().IsReachable()) {
+        return kDeadline;
+      }
+      return kNormal;
+    case TaskPriority::kLow:
+      return kLow;
+  }
+  UASSERT_MSG(false, "Unexpected task priority");
+  return kNormal;
+}
+
+void PriorityTaskQueue::DoPush(impl::TaskContext* context) {
+  const auto task_class = GetClass(context);
+  if (task_class == kDeadline) {
+    deadline_heap_.Push(context, context->GetSchedulingDeadline());
+  } else {
+    GetFifo(task_class).enqueue(context);
+  }
+  queue_semaphore_.signal();
+}
+
+impl::TaskContext* PriorityTaskQueue::DoPopBlocking(Consumer& consumer) {
+  impl::TaskContext* context{};
+  queue_semaphore_.wait();
+
+  std::size_t first_class = kHigh;
+  ++consumer.pops_count;
+  if (starvation_limit_ != 0 && consumer.pops_count % starvation_limit_ == 0) {
+    const auto turn = consumer.pops_count / starvation_limit_;
+    first_class = 1 + turn % (kClassesCount - 1);
+  }
+
+  // The semaphore guarantees that a task is in one of the classes, it may be
+  // temporarily invisible, like in TaskQueue
+  while (true) {
+    for (std::size_t i = 0; i < kClassesCount; ++i) {
+      const auto task_class =
+          static_cast<Class>((first_class + i) % kClassesCount);
+      if (TryPop(consumer, task_class, context)) return context;
+    }
+  }
+}
+
+bool PriorityTaskQueue::TryPop(Consumer& consumer, Class task_class,
+                               impl::TaskContext*& context) {
+  if (task_class == kDeadline) return deadline_heap_.TryPop(context);
+  return GetFifo(task_class).try_dequeue(consumer.tokens[task_class], context);
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// A task queue with a FIFO queue per engine::TaskPriority. The `kNormal`
+/// tasks with a scheduling deadline are optionally ordered
+/// earliest-deadline-first.
+///
+/// Workers take the tasks of the highest non-empty class. To protect the
+/// lower classes from starvation, each `priority_starvation_limit`-th pop of
+/// a worker starts from one of the lower classes in turn.
+class PriorityTaskQueue final {
+ public:
+  explicit PriorityTaskQueue(const TaskProcessorConfig& config);
+
+  void Push(boost::intrusive_ptr<impl::TaskContext>&& context);
+
+  // Returns nullptr as a stop signal
+  boost::intrusive_ptr<impl::TaskContext> PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  // In the order of probing
+  enum Class : std::size_t { kHigh, kDeadline, kNormal, kLow, kClassesCount };
+
+  using Fifo = moodycamel::ConcurrentQueue<impl::TaskContext*>;
+
+  class DeadlineHeap final {
+   public:
+    void Push(impl::TaskContext* context, Deadline deadline);
+    bool TryPop(impl::TaskContext*& context);
+    std::size_t GetSizeApproximate() const noexcept;
+
+   private:
+    struct Entry final {
+      Deadline deadline;
+      impl::TaskContext* context;
+    };
+
+    std::mutex mutex_;
+    std::vector<Entry> heap_;
+    std::atomic<std::size_t> size_{0};
+  };
+
+  struct Consumer final {
+    explicit Consumer(PriorityTaskQueue& queue);
+
+    std::array<moodycamel::ConsumerToken, kClassesCount> tokens;
+    std::size_t pops_count{0};
+  };
+
+  Fifo& GetFifo(Class task_class) noexcept { return fifos_[task_class]; }
+
+  Class GetClass(const impl::TaskContext* context) const noexcept;
+
+  void DoPush(impl::TaskContext* context);
+
+  impl::TaskContext* DoPopBlocking(Consumer& consumer);
+
+  bool TryPop(Consumer& consumer, Class task_class,
+              impl::TaskContext*& context);
+
+  const std::size_t starvation_limit_;
+  const bool deadline_ordering_;
+
+  // fifos_[kDeadline] is unused, kept for the uniform indexing
+  std::array<Fifo, kClassesCount> fifos_;
+  DeadlineHeap deadline_heap_;
+  moodycamel::LightweightSemaphore queue_semaphore_;
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/priority.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+void RunPriority(std::size_t starvation_limit, bool deadline_ordering,
+                 utils::function_ref<void()> payload) {
+  engine::TaskProcessorConfig config;
+  config.worker_threads = 1;
+  config.thread_name = "prio-worker";
+  config.task_queue = engine::TaskQueueType::kPriorityTaskQueue;
+  config.priority_starvation_limit = starvation_limit;
+  config.priority_deadline_ordering = deadline_ordering;
+
+  engine::TaskProcessor task_processor{
+      std::move(config), engine::impl::MakeTaskProcessorPools({})};
+  engine::impl::RunOnTaskProcessorSync(task_processor, payload);
+}
+
+class Journal final {
+ public:
+  auto Record(std::string name) {
+    return [this, name = std::move(name)] {
+      const std::lock_guard lock(mutex_);
+      records_.push_back(name);
+    };
+  }
+
+  std::vector<std::string> Get() {
+    const std::lock_guard lock(mutex_);
+    return records_;
+  }
+
+ private:
+  engine::Mutex mutex_;
+  std::vector<std::string> records_;
+};
+
+template <typename Function>
+auto AsyncWithPriority(engine::TaskPriority priority, Function&& func) {
+  const auto old_priority = engine::current_task::GetPriority();
+  engine::current_task::SetPriority(priority);
+  auto task = engine::AsyncNoSpan(std::forward<Function>(func));
+  engine::current_task::SetPriority(old_priority);
+  return task;
+}
+
+}  // namespace
+
+TEST(PriorityTaskQueue, HighBeforeNormalBeforeLow) {
+  RunPriority(0, false, [] {
+    Journal journal;
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.push_back(
+        AsyncWithPriority(engine::TaskPriority::kLow, journal.Record("low")));
+    tasks.push_back(AsyncWithPriority(engine::TaskPriority::kNormal,
+                                      journal.Record("normal")));
+    tasks.push_back(
+        AsyncWithPriority(engine::TaskPriority::kHigh, journal.Record("high")));
+    for (auto& task : tasks) task.Get();
+
+    const std::vector<std::string> expected{"high", "normal", "low"};
+    EXPECT_EQ(journal.Get(), expected);
+  });
+}
+
+TEST(PriorityTaskQueue, PriorityIsInherited) {
+  RunPriority(0, false, [] {
+    EXPECT_EQ(engine::current_task::GetPriority(),
+              engine::TaskPriority::kNormal);
+    auto task = AsyncWithPriority(engine::TaskPriority::kLow, [] {
+      return engine::AsyncNoSpan([] {
+               return engine::current_task::GetPriority();
+             }).Get();
+    });
+    EXPECT_EQ(task.Get(), engine::TaskPriority::kLow);
+    EXPECT_EQ(engine::current_task::GetPriority(),
+              engine::TaskPriority::kNormal);
+  });
+}
+
+TEST(PriorityTaskQueue, StarvationProtection) {
+  constexpr std::size_t kHighTasks = 20;
+  RunPriority(4, false, [] {
+    Journal journal;
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.push_back(
+        AsyncWithPriority(engine::TaskPriority::kLow, journal.Record("low")));
+    for (std::size_t i = 0; i < kHighTasks; ++i) {
+      tasks.push_back(AsyncWithPriority(engine::TaskPriority::kHigh,
+                                        journal.Record("high")));
+    }
+    for (auto& task : tasks) task.Get();
+
+    const auto records = journal.Get();
+    ASSERT_EQ(records.size(), kHighTasks + 1);
+    EXPECT_NE(records.back(), "low");
+  });
+}
+
+TEST(PriorityTaskQueue, EarliestDeadlineFirst) {
+  RunPriority(0, true, [] {
+    Journal journal;
+    std::vector<engine::TaskWithResult<void>> tasks;
+
+    tasks.push_back(engine::AsyncNoSpan(journal.Record("no-deadline")));
+    for (const auto& [name, timeout] :
+         {std::pair{"late", 30s}, std::pair{"early", 10s},
+          std::pair{"middle", 20s}}) {
+      engine::current_task::SetSchedulingDeadline(
+          engine::Deadline::FromDuration(timeout));
+      tasks.push_back(engine::AsyncNoSpan(journal.Record(name)));
+    }
+    engine::current_task::SetSchedulingDeadline({});
+    for (auto& task : tasks) task.Get();
+
+    const std::vector<std::string> expected{"early", "middle", "late",
+                                            "no-deadline"};
+    EXPECT_EQ(journal.Get(), expected);
+  });
+}
+
+USERVER_NAMESPACE_END
@@ -36,6 +36,10 @@ SingleThreadedTaskProcessorsPool::SingleThreadedTaskProcessorsPool(
     auto proc_config = config;
     proc_config.name += std::to_string(i);
     proc_config.thread_name += std::to_string(i);
+    // Each processor gets a core of its own, so that the data it owns stays
+    // in the caches of that core
+    const auto& cpus = config.cpu_affinity.cpus;
+    if (!cpus.empty()) proc_config.cpu_affinity.cpus = {cpus[i % cpus.size()]};
     processors_.push_back(std::make_unique<engine::TaskProcessor>(
         std::move(proc_config), libev_pool));
   }
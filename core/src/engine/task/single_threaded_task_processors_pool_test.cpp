@@ -4,8 +4,11 @@
 #include <userver/utils/async.hpp>
 #include <userver/utils/strong_typedef.hpp>
 
+#include <sched.h>
+
 #include <array>
 #include <thread>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
@@ -60,4 +63,28 @@ UTEST_MT(SingleThreadedTaskprocessor, ConstructionWithoutComponentSystem, 2) {
   }
 }
 
+#ifdef __linux__
+UTEST(SingleThreadedTaskprocessor, CpuPerProcessor) {
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  ASSERT_EQ(::sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  std::vector<std::size_t> cpus;
+  for (std::size_t cpu = 0; cpu < CPU_SETSIZE && cpus.size() < 2; ++cpu) {
+    if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+  }
+
+  engine::TaskProcessorConfig config;
+  config.name = "test";
+  config.worker_threads = 4;
+  config.cpu_affinity.cpus = cpus;
+  Pool pool{config};
+
+  for (std::size_t i = 0; i < pool.GetSize(); ++i) {
+    const auto cpu =
+        utils::Async(pool.At(i), "test", [] { return ::sched_getcpu(); }).Get();
+    EXPECT_EQ(static_cast<std::size_t>(cpu), cpus[i % cpus.size()]);
+  }
+}
+#endif
+
 USERVER_NAMESPACE_END
@@ -175,12 +175,7 @@ TaskProcessor& GetTaskProcessor() {
   return GetCurrentTaskContext().GetTaskProcessor();
 }
 
-std::size_t GetStackSize() {
-  return GetTaskProcessor()
-      .GetTaskProcessorPools()
-      ->GetCoroPool()
-      .GetStackSize();
-}
+std::size_t GetStackSize() { return GetCurrentTaskContext().GetStackSize(); }
 
 ev::ThreadControl& GetEventThread() {
   return GetTaskProcessor().EventThreadPool().NextThread();
@@ -1,11 +1,15 @@
 #include <benchmark/benchmark.h>
 
 #include <atomic>
+#include <memory>
 #include <thread>
+#include <vector>
 
+#include <concurrent/impl/interference_shield.hpp>
 #include <engine/impl/standalone.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/single_threaded_task_processors_pool.hpp>
@@ -121,6 +125,129 @@ BENCHMARK(engine_task_yield_multiple_task_processors)
     ->RangeMultiplier(2)
     ->Range(1, 32);
 
+namespace {
+
+constexpr std::size_t kWaitersPerProducer = 8;
+
+void RunWithTaskQueue(std::size_t worker_threads,
+                      engine::TaskQueueType task_queue,
+                      utils::function_ref<void()> payload) {
+  auto task_processor = engine::impl::TaskProcessorHolder::Make(
+      worker_threads, "bench-worker", engine::impl::MakeTaskProcessorPools({}),
+      task_queue);
+  engine::impl::RunOnTaskProcessorSync(*task_processor, payload);
+}
+
+}  // namespace
+
+// Each iteration the main task wakes up all the producers, each producer wakes
+// up kWaitersPerProducer waiters, the last waiter wakes up the main task.
+void engine_task_wakeup_storm(benchmark::State& state,
+                              engine::TaskQueueType task_queue) {
+  const auto producers_count = static_cast<std::size_t>(state.range(0));
+  const auto waiters_count = producers_count * kWaitersPerProducer;
+
+  RunWithTaskQueue(state.range(0), task_queue, [&] {
+    using Event = concurrent::impl::InterferenceShield<
+        engine::SingleConsumerEvent>;
+    std::vector<std::unique_ptr<Event>> producer_events;
+    std::vector<std::unique_ptr<Event>> waiter_events;
+    for (std::size_t i = 0; i < producers_count; ++i) {
+      producer_events.push_back(std::make_unique<Event>());
+    }
+    for (std::size_t i = 0; i < waiters_count; ++i) {
+      waiter_events.push_back(std::make_unique<Event>());
+    }
+    engine::SingleConsumerEvent storm_finished;
+    std::atomic<std::size_t> waiters_left{0};
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(producers_count + waiters_count);
+    for (std::size_t i = 0; i < waiters_count; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&, &event = **waiter_events[i]] {
+        while (event.WaitForEvent()) {
+          if (waiters_left.fetch_sub(1) == 1) storm_finished.Send();
+        }
+      }));
+    }
+    for (std::size_t i = 0; i < producers_count; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&, i] {
+        auto& event = **producer_events[i];
+        while (event.WaitForEvent()) {
+          for (std::size_t j = 0; j < kWaitersPerProducer; ++j) {
+            (*waiter_events[i * kWaitersPerProducer + j])->Send();
+          }
+        }
+      }));
+    }
+
+    std::uint64_t wakeups = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      waiters_left = waiters_count;
+      for (auto& event : producer_events) (*event)->Send();
+      const bool finished = storm_finished.WaitForEvent();
+      if (!finished) break;
+      wakeups += producers_count + waiters_count + 1;
+    }
+
+    for (auto& task : tasks) task.RequestCancel();
+    for (auto& task : tasks) task.Wait();
+
+    state.counters["wakeups"] =
+        benchmark::Counter(wakeups, benchmark::Counter::kIsRate);
+  });
+}
+BENCHMARK_CAPTURE(engine_task_wakeup_storm, global_task_queue,
+                  engine::TaskQueueType::kGlobalTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_CAPTURE(engine_task_wakeup_storm, work_stealing_task_queue,
+                  engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
+void engine_task_yield_multiple_threads_work_stealing(benchmark::State& state) {
+  RunWithTaskQueue(
+      state.range(0), engine::TaskQueueType::kWorkStealingTaskQueue, [&] {
+        std::atomic<bool> keep_running{true};
+        std::vector<engine::TaskWithResult<std::uint64_t>> tasks;
+        tasks.reserve(state.range(0) - 1);
+
+        for (int i = 0; i < state.range(0) - 1; i++) {
+          tasks.push_back(engine::AsyncNoSpan([&] {
+            std::uint64_t yields_performed = 0;
+            while (keep_running) {
+              engine::Yield();
+              ++yields_performed;
+            }
+            return yields_performed;
+          }));
+        }
+
+        std::uint64_t yields_performed = 0;
+        for ([[maybe_unused]] auto _ : state) {
+          engine::Yield();
+          ++yields_performed;
+        }
+
+        keep_running = false;
+        for (auto& task : tasks) {
+          yields_performed += task.Get();
+        }
+
+        state.counters["yields"] =
+            benchmark::Counter(yields_performed, benchmark::Counter::kIsRate);
+        state.counters["yields/thread"] = benchmark::Counter(
+            static_cast<double>(yields_performed) / state.range(0),
+            benchmark::Counter::kIsRate);
+      });
+}
+BENCHMARK(engine_task_yield_multiple_threads_work_stealing)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->Arg(6)
+    ->Arg(12);
+
 void thread_yield(benchmark::State& state) {
   for ([[maybe_unused]] auto _ : state) std::this_thread::yield();
 }
@@ -1,6 +1,8 @@
 #include "task_context.hpp"
 
+#include <algorithm>
 #include <exception>
+#include <new>
 #include <utility>
 
 #include <fmt/format.h>
@@ -14,8 +16,10 @@
 #include <userver/logging/stacktrace_cache.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/underlying_value.hpp>
+#include <utils/jemalloc.hpp>
 
 #include <engine/ev/thread_pool.hpp>
+#include <engine/impl/cpu_profiler.hpp>
 #include <engine/impl/generic_wait_list.hpp>
 #include <engine/task/coro_unwinder.hpp>
 #include <engine/task/cxxabi_eh_globals.hpp>
@@ -66,6 +70,20 @@ impl::TaskContext* GetCurrentTaskContextUnchecked() noexcept {
   return current_task_context_ptr;
 }
 
+void EnableWaitStats() { GetCurrentTaskContext().EnableWaitStats(); }
+
+const impl::TaskWaitStats* GetWaitStats() noexcept {
+  auto* const context = GetCurrentTaskContextUnchecked();
+  return context ? context->GetWaitStats() : nullptr;
+}
+
+void EnableAllocStats() { GetCurrentTaskContext().EnableAllocStats(); }
+
+const impl::TaskAllocStats* GetAllocStats() noexcept {
+  auto* const context = GetCurrentTaskContextUnchecked();
+  return context ? context->GetAllocStats() : nullptr;
+}
+
 }  // namespace current_task
 
 namespace impl {
@@ -110,17 +128,24 @@ auto* const kFinishedDetachedToken =
 TaskContext::TaskContext(TaskProcessor& task_processor,
                          Task::Importance importance, Task::WaitMode wait_type,
                          Deadline deadline,
-                         utils::impl::WrappedCallBase& payload)
+                         utils::impl::WrappedCallBase& payload,
+                         std::size_t stack_size, bool is_stackless)
     : task_processor_(task_processor),
       task_counter_token_(task_processor_.GetTaskCounter()),
       is_critical_(importance == Task::Importance::kCritical),
+      is_stackless_(is_stackless),
       payload_(&payload),
       finish_waiters_(wait_type),
       cancel_deadline_(deadline),
-      trace_csw_left_(task_processor_.GetTaskTraceMaxCswForNewTask()) {
+      trace_csw_left_(task_processor_.GetTaskTraceMaxCswForNewTask()),
+      stack_size_(stack_size) {
   UASSERT(payload_);
-  LOG_TRACE() << "task with task_id="
-              << ReadableTaskId(current_task::GetCurrentTaskContextUnchecked())
+  auto* const parent = current_task::GetCurrentTaskContextUnchecked();
+  if (parent) {
+    priority_ = parent->priority_;
+    scheduling_deadline_ = parent->scheduling_deadline_;
+  }
+  LOG_TRACE() << "task with task_id=" << ReadableTaskId(parent)
               << " created task with task_id=" << ReadableTaskId(this)
               << logging::LogExtra::Stacktrace();
 }
@@ -180,7 +205,7 @@ class LockedWaitStrategy final : public WaitStrategy {
  public:
   LockedWaitStrategy(Deadline deadline, GenericWaitList& waiters,
                      TaskContext& current, const TaskContext& target)
-      : WaitStrategy(deadline),
+      : WaitStrategy(deadline, WaitReason::kTask),
         waiters_(waiters),
         current_(current),
         target_(target) {}
@@ -217,10 +242,14 @@ void TaskContext::WaitUntil(Deadline deadline) const {
 
 void TaskContext::DoStep() {
   if (IsFinished()) return;
+  if (is_stackless_) {
+    DoStepStackless();
+    return;
+  }
 
   SleepState::Flags clear_flags{SleepFlags::kSleeping};
   if (!coro_) {
-    coro_ = task_processor_.GetCoroutine();
+    coro_ = task_processor_.GetCoroutine(stack_size_);
     clear_flags |= SleepFlags::kWakeupByBootstrap;
     ArmCancellationTimer();
   }
@@ -230,31 +259,23 @@ void TaskContext::DoStep() {
   std::exception_ptr uncaught;
   {
     CurrentTaskScope current_task_scope(*this, eh_globals_);
+    StartAllocStatsSlice();
     try {
       SetState(Task::State::kRunning);
       (*coro_)(this);
     } catch (...) {
       uncaught = std::current_exception();
     }
+    StopAllocStatsSlice();
   }
   if (uncaught) std::rethrow_exception(uncaught);
 
   switch (yield_reason_) {
     case YieldReason::kTaskCancelled:
-    case YieldReason::kTaskComplete: {
+    case YieldReason::kTaskComplete:
       std::move(coro_).ReturnToPool();
-      auto new_state = (yield_reason_ == YieldReason::kTaskComplete)
-                           ? Task::State::kCompleted
-                           : Task::State::kCancelled;
-      if (cancellation_reason_.load(std::memory_order_relaxed) !=
-          TaskCancellationReason::kNone) {
-        GetTaskProcessor().GetTaskCounter().AccountTaskCancel();
-      }
-      SetState(new_state);
-      deadline_timer_.Finalize();
-      finish_waiters_->WakeupAll();
-      TraceStateTransition(new_state);
-    } break;
+      SetFinished();
+      break;
 
     case YieldReason::kTaskWaiting:
       SetState(Task::State::kSuspended);
@@ -283,6 +304,51 @@ void TaskContext::DoStep() {
   }
 }
 
+void TaskContext::DoStepStackless() {
+  // The only step of the task, there is no coroutine to switch to, so neither
+  // the cancellation timer nor the task pipe is needed
+  sleep_state_.ClearFlags<std::memory_order_relaxed>(
+      {SleepFlags::kSleeping, SleepFlags::kWakeupByBootstrap});
+  if (cancel_deadline_.IsReached()) {
+    RequestCancel(TaskCancellationReason::kDeadline);
+  }
+
+  std::exception_ptr uncaught;
+  {
+    CurrentTaskScope current_task_scope(*this, eh_globals_);
+    StartAllocStatsSlice();
+    try {
+      SetState(Task::State::kRunning);
+      yield_reason_ = YieldReason::kNone;
+      ProfilerStartExecution();
+      RunPayload();
+      ProfilerStopExecution();
+    } catch (...) {
+      uncaught = std::current_exception();
+    }
+    StopAllocStatsSlice();
+  }
+  if (uncaught) std::rethrow_exception(uncaught);
+
+  UASSERT(yield_reason_ == YieldReason::kTaskComplete ||
+          yield_reason_ == YieldReason::kTaskCancelled);
+  SetFinished();
+}
+
+void TaskContext::SetFinished() {
+  const auto new_state = (yield_reason_ == YieldReason::kTaskComplete)
+                             ? Task::State::kCompleted
+                             : Task::State::kCancelled;
+  if (cancellation_reason_.load(std::memory_order_relaxed) !=
+      TaskCancellationReason::kNone) {
+    GetTaskProcessor().GetTaskCounter().AccountTaskCancel();
+  }
+  SetState(new_state);
+  deadline_timer_.Finalize();
+  finish_waiters_->WakeupAll();
+  TraceStateTransition(new_state);
+}
+
 void TaskContext::RequestCancel(TaskCancellationReason reason) {
   auto expected = TaskCancellationReason::kNone;
   if (cancellation_reason_.compare_exchange_strong(expected, reason)) {
@@ -308,6 +374,9 @@ bool TaskContext::SetCancellable(bool value) {
 TaskContext::WakeupSource TaskContext::Sleep(WaitStrategy& wait_strategy) {
   UASSERT(IsCurrent());
   UASSERT(state_ == Task::State::kRunning);
+  UINVARIANT(!is_stackless_,
+             "A stackless task attempted to suspend, only non-blocking code "
+             "may run in engine::AsyncStacklessNoSpan");
 
   UASSERT_MSG(!std::exchange(within_sleep_, true),
               "Recursion in Sleep detected");
@@ -332,7 +401,10 @@ TaskContext::WakeupSource TaskContext::Sleep(WaitStrategy& wait_strategy) {
   UASSERT(task_pipe_);
   TraceStateTransition(Task::State::kSuspended);
   ProfilerStopExecution();
+  const auto wait_start = wait_stats_ ? std::chrono::steady_clock::now()
+                                      : std::chrono::steady_clock::time_point{};
   [[maybe_unused]] TaskContext* context = (*task_pipe_)().get();
+  if (wait_stats_) AccountWait(wait_strategy.GetWaitReason(), wait_start);
   ProfilerStartExecution();
   TraceStateTransition(Task::State::kRunning);
   UASSERT(context == this);
@@ -494,45 +566,59 @@ void TaskContext::CoroFunc(TaskPipe& task_pipe) {
 
     context->ProfilerStartExecution();
 
-    // We only let tasks ran with CriticalAsync enter function body, others
-    // get terminated ASAP.
-    if (context->IsCancelRequested() && !context->WasStartedAsCritical()) {
-      context->SetCancellable(false);
-      // It is important to destroy payload here as someone may want
-      // to synchronize in its dtor (e.g. lambda closure).
-      {
-        LocalStorageGuard local_storage_guard(*context);
-        context->ResetPayload();
-      }
-      context->yield_reason_ = YieldReason::kTaskCancelled;
-    } else {
-      try {
-        {
-          // Destroy contents of LocalStorage in the coroutine
-          // as dtors may want to schedule
-          LocalStorageGuard local_storage_guard(*context);
-
-          context->TraceStateTransition(Task::State::kRunning);
-          context->payload_->Perform();
-        }
-        context->yield_reason_ = YieldReason::kTaskComplete;
-      } catch (const CoroUnwinder&) {
-        context->yield_reason_ = YieldReason::kTaskCancelled;
-      } catch (...) {
-        utils::impl::AbortWithStacktrace(
-            "An exception that is not derived from std::exception has been "
-            "thrown: " +
-            boost::current_exception_diagnostic_information() +
-            " Such exceptions are not supported by userver.");
-      }
-    }
-
+    context->RunPayload();
     context->ProfilerStopExecution();
 
     context->task_pipe_ = nullptr;
   }
 }
 
+void TaskContext::RunPayload() {
+  // We only let tasks ran with CriticalAsync enter function body, others
+  // get terminated ASAP.
+  if (IsCancelRequested() && !WasStartedAsCritical()) {
+    SetCancellable(false);
+    // It is important to destroy payload here as someone may want
+    // to synchronize in its dtor (e.g. lambda closure).
+    {
+      LocalStorageGuard local_storage_guard(*this);
+      ResetPayload();
+    }
+    yield_reason_ = YieldReason::kTaskCancelled;
+    return;
+  }
+
+  try {
+    {
+      // Destroy contents of LocalStorage in the coroutine
+      // as dtors may want to schedule
+      LocalStorageGuard local_storage_guard(*this);
+
+      TraceStateTransition(Task::State::kRunning);
+      payload_->Perform();
+    }
+    yield_reason_ = YieldReason::kTaskComplete;
+  } catch (const CoroUnwinder&) {
+    yield_reason_ = YieldReason::kTaskCancelled;
+  } catch (...) {
+    utils::impl::AbortWithStacktrace(
+        "An exception that is not derived from std::exception has been "
+        "thrown: " +
+        boost::current_exception_diagnostic_information() +
+        " Such exceptions are not supported by userver.");
+  }
+}
+
+void TaskContext::SetPriority(TaskPriority priority) noexcept {
+  UASSERT(IsCurrent());
+  priority_ = priority;
+}
+
+void TaskContext::SetSchedulingDeadline(Deadline deadline) noexcept {
+  UASSERT(IsCurrent());
+  scheduling_deadline_ = deadline;
+}
+
 void TaskContext::SetCancelDeadline(Deadline deadline) {
   UASSERT(IsCurrent());
   UASSERT(state_ == Task::State::kRunning);
@@ -549,6 +635,78 @@ task_local::Storage& TaskContext::GetLocalStorage() noexcept {
   return *local_storage_;
 }
 
+std::size_t TaskContext::GetStackSize() const noexcept {
+  UASSERT(coro_ || is_stackless_);
+  return coro_ ? coro_.GetStackSize() : 0;
+}
+
+void TaskContext::EnableWaitStats() {
+  UASSERT(IsCurrent());
+  if (wait_stats_) return;
+  wait_stats_ = std::make_unique<TaskWaitStats>();
+
+  // the time in the queue before the first slice, if it was measured
+  if (task_queue_wait_timepoint_ != std::chrono::steady_clock::time_point{}) {
+    wait_stats_->queue_wait =
+        std::chrono::steady_clock::now() - task_queue_wait_timepoint_;
+  }
+}
+
+void TaskContext::EnableAllocStats() {
+  UASSERT(IsCurrent());
+  if (alloc_stats_ || !utils::jemalloc::GetThreadAllocCounters().allocated) {
+    return;
+  }
+  alloc_stats_ = std::make_unique<TaskAllocStats>();
+  // the rest of the current slice is accounted
+  StartAllocStatsSlice();
+}
+
+const TaskAllocStats* TaskContext::GetAllocStats() noexcept {
+  if (alloc_stats_ && IsCurrent()) {
+    StopAllocStatsSlice();
+    StartAllocStatsSlice();
+  }
+  return alloc_stats_.get();
+}
+
+void TaskContext::StartAllocStatsSlice() noexcept {
+  if (!alloc_stats_) return;
+  const auto counters = utils::jemalloc::GetThreadAllocCounters();
+  alloc_stats_->slice_allocated_start = *counters.allocated;
+  alloc_stats_->slice_deallocated_start = *counters.deallocated;
+}
+
+void TaskContext::StopAllocStatsSlice() noexcept {
+  if (!alloc_stats_) return;
+  // the counters of the thread that ran the slice
+  const auto counters = utils::jemalloc::GetThreadAllocCounters();
+  alloc_stats_->allocated_bytes +=
+      *counters.allocated - alloc_stats_->slice_allocated_start;
+  alloc_stats_->deallocated_bytes +=
+      *counters.deallocated - alloc_stats_->slice_deallocated_start;
+}
+
+void TaskContext::AccountWait(
+    WaitReason reason, std::chrono::steady_clock::time_point start) noexcept {
+  const std::chrono::nanoseconds total =
+      std::chrono::steady_clock::now() - start;
+  const auto queued =
+      std::min(std::exchange(wait_stats_->last_queue_wait, {}), total);
+  wait_stats_->WaitTime(reason) += total - queued;
+  ++wait_stats_->context_switches;
+}
+
+CpuProfilerTag* TaskContext::GetCpuProfilerTag() noexcept {
+  if (!cpu_profiler_tag_) {
+    auto* const tag = new (std::nothrow) CpuProfilerTag();
+    // the SIGPROF handler on this thread may read the pointer at any moment
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    cpu_profiler_tag_.reset(tag);
+  }
+  return cpu_profiler_tag_.get();
+}
+
 bool TaskContext::IsReady() const noexcept { return IsFinished(); }
 
 void TaskContext::AppendWaiter(impl::TaskContext& context) noexcept {
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include <ev.h>
@@ -11,17 +12,20 @@
 
 #include <engine/coro/pool.hpp>
 #include <engine/ev/thread_control.hpp>
+#include <engine/task/alloc_stats.hpp>
 #include <engine/task/context_timer.hpp>
 #include <engine/task/counted_coroutine_ptr.hpp>
 #include <engine/task/cxxabi_eh_globals.hpp>
 #include <engine/task/sleep_state.hpp>
 #include <engine/task/task_counter.hpp>
+#include <engine/task/wait_stats.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/impl/context_accessor.hpp>
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 #include <userver/engine/impl/task_local_storage.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 #include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/priority.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/flags.hpp>
@@ -33,6 +37,7 @@ namespace engine {
 namespace impl {
 
 class TaskContextHolder;
+struct CpuProfilerTag;
 
 [[noreturn]] void ReportDeadlock();
 
@@ -52,13 +57,18 @@ class WaitStrategy {
 
   Deadline GetDeadline() const { return deadline_; }
 
+  WaitReason GetWaitReason() const noexcept { return wait_reason_; }
+
  protected:
   ~WaitStrategy() = default;
 
-  constexpr WaitStrategy(Deadline deadline) noexcept : deadline_(deadline) {}
+  constexpr WaitStrategy(Deadline deadline,
+                         WaitReason wait_reason = WaitReason::kOther) noexcept
+      : deadline_(deadline), wait_reason_(wait_reason) {}
 
  private:
   const Deadline deadline_;
+  const WaitReason wait_reason_;
 };
 
 class TaskContext final : public ContextAccessor {
@@ -79,7 +89,8 @@ class TaskContext final : public ContextAccessor {
   };
 
   TaskContext(TaskProcessor&, Task::Importance, Task::WaitMode, Deadline,
-              utils::impl::WrappedCallBase& payload);
+              utils::impl::WrappedCallBase& payload,
+              std::size_t stack_size = 0, bool is_stackless = false);
 
   ~TaskContext() noexcept;
 
@@ -175,6 +186,44 @@ class TaskContext final : public ContextAccessor {
   bool HasLocalStorage() const noexcept;
   task_local::Storage& GetLocalStorage() noexcept;
 
+  // creates the tag on the first use, nullptr on allocation failure
+  CpuProfilerTag* GetCpuProfilerTag() noexcept;
+  const CpuProfilerTag* GetCpuProfilerTagUnchecked() const noexcept {
+    return cpu_profiler_tag_.get();
+  }
+
+  // coroutine stack size, only valid while the task runs, 0 for stackless
+  std::size_t GetStackSize() const noexcept;
+
+  // Scheduling class and deadline for the priority task queue. Inherited
+  // from the task that creates the context, only changed by the task itself
+  // while it runs, so the scheduler reads them without synchronization.
+  TaskPriority GetPriority() const noexcept { return priority_; }
+  void SetPriority(TaskPriority priority) noexcept;
+  Deadline GetSchedulingDeadline() const noexcept {
+    return scheduling_deadline_;
+  }
+  void SetSchedulingDeadline(Deadline deadline) noexcept;
+
+  // whether the payload runs right on the worker thread stack without
+  // a coroutine, such tasks must never suspend
+  bool IsStackless() const noexcept { return is_stackless_; }
+
+  // names the task for the stack usage sampling of its coroutine, only the
+  // first call counts
+  void SetStackUsageTaskKind(std::string_view task_kind) {
+    if (coro_) coro_.SetStackUsageTaskKind(task_kind);
+  }
+
+  void EnableWaitStats();
+  // nullptr if the off-CPU time is not accounted for this task
+  TaskWaitStats* GetWaitStats() noexcept { return wait_stats_.get(); }
+
+  void EnableAllocStats();
+  // nullptr if the heap usage is not accounted for this task, must be called
+  // from this context to include the current slice
+  const TaskAllocStats* GetAllocStats() noexcept;
+
   // ContextAccessor implementation
   bool IsReady() const noexcept final;
   void AppendWaiter(impl::TaskContext& context) noexcept final;
@@ -203,15 +252,26 @@ class TaskContext final : public ContextAccessor {
   void Schedule();
   static bool ShouldSchedule(SleepState::Flags flags, WakeupSource source);
 
+  void DoStepStackless();
+  void RunPayload();
+  void SetFinished();
+
   void ProfilerStartExecution();
   void ProfilerStopExecution();
 
+  void StartAllocStatsSlice() noexcept;
+  void StopAllocStatsSlice() noexcept;
+
+  void AccountWait(WaitReason reason,
+                   std::chrono::steady_clock::time_point start) noexcept;
+
   void TraceStateTransition(Task::State state);
 
   const uint64_t magic_{kMagic};
   TaskProcessor& task_processor_;
   TaskCounter::Token task_counter_token_;
   const bool is_critical_;
+  const bool is_stackless_;
   bool is_cancellable_{true};
   bool within_sleep_{false};
   EhGlobals eh_globals_;
@@ -227,12 +287,17 @@ class TaskContext final : public ContextAccessor {
   ContextTimer deadline_timer_;
   engine::Deadline cancel_deadline_;
 
+  TaskPriority priority_{TaskPriority::kNormal};
+  engine::Deadline scheduling_deadline_;
+
   // {} if not defined
   std::chrono::steady_clock::time_point task_queue_wait_timepoint_;
   std::chrono::steady_clock::time_point execute_started_;
   std::chrono::steady_clock::time_point last_state_change_timepoint_;
 
   size_t trace_csw_left_;
+  // 0 for the task processor default
+  const std::size_t stack_size_;
 
   AtomicSleepState sleep_state_{
       SleepState{SleepFlags::kSleeping, SleepState::Epoch{0}}};
@@ -244,6 +309,13 @@ class TaskContext final : public ContextAccessor {
 
   std::optional<task_local::Storage> local_storage_{};
 
+  // span names for engine::impl::CpuProfiler, only set while it runs
+  std::unique_ptr<CpuProfilerTag> cpu_profiler_tag_;
+
+  std::unique_ptr<TaskWaitStats> wait_stats_;
+
+  std::unique_ptr<TaskAllocStats> alloc_stats_;
+
   // refcounter for task abandoning (cancellation) in engine::SharedTask
   std::atomic<std::size_t> shared_task_usages_{1};
 
@@ -1,7 +1,9 @@
 #include "task_processor.hpp"
 
 #include <sys/types.h>
+#include <algorithm>
 #include <csignal>
+#include <type_traits>
 
 #include <fmt/format.h>
 
@@ -12,8 +14,10 @@
 #include <userver/utils/rand.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <userver/utils/threads.hpp>
+#include <utils/jemalloc.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
+#include <engine/impl/cpu_profiler.hpp>
 #include <engine/task/counted_coroutine_ptr.hpp>
 #include <engine/task/task_context.hpp>
 #include <engine/task/task_processor_pools.hpp>
@@ -23,10 +27,23 @@ USERVER_NAMESPACE_BEGIN
 namespace engine {
 namespace {
 
+std::optional<unsigned> MakeJemallocArena(const TaskProcessorConfig& config) {
+  if (!config.jemalloc_arena) return std::nullopt;
+  auto arena = utils::jemalloc::CreateArena();
+  if (!arena) {
+    LOG_WARNING() << "Failed to create a jemalloc arena for task processor "
+                  << config.name << ", the default arenas are used";
+  }
+  return arena;
+}
+
 void SetTaskQueueWaitTimepoint(impl::TaskContext* context) {
   static constexpr size_t kTaskTimestampInterval = 4;
   thread_local size_t task_count = 0;
-  if (task_count++ == kTaskTimestampInterval) {
+  if (context->GetWaitStats()) {
+    // the queue wait of the task is accounted precisely
+    context->SetQueueWaitTimepoint(std::chrono::steady_clock::now());
+  } else if (task_count++ == kTaskTimestampInterval) {
     task_count = 0;
     context->SetQueueWaitTimepoint(std::chrono::steady_clock::now());
   } else {
@@ -38,6 +55,8 @@ void SetTaskQueueWaitTimepoint(impl::TaskContext* context) {
   }
 }
 
+thread_local TaskProcessor::ScheduleBatch* current_schedule_batch = nullptr;
+
 // Hooks are modified only before task processors created and only in main
 // thread, so it doesn't need any synchronization.
 std::vector<std::function<void()>>& ThreadStartedHooks() {
@@ -68,9 +87,14 @@ void TaskProcessorThreadStartedHook() {
 TaskProcessor::TaskProcessor(TaskProcessorConfig config,
                              std::shared_ptr<impl::TaskProcessorPools> pools)
     : task_counter_(config.worker_threads),
-      task_queue_(config),
+      task_queue_(MakeTaskQueue(config)),
       config_(std::move(config)),
-      pools_(std::move(pools)) {
+      pools_(std::move(pools)),
+      default_stack_size_class_(
+          pools_->GetCoroPool().FindStackSizeClass(config_.stack_size)),
+      jemalloc_arena_(MakeJemallocArena(config_)),
+      active_workers_(config_.worker_threads),
+      running_contexts_(config_.worker_threads, nullptr) {
   utils::impl::FinishStaticRegistration();
   try {
     LOG_INFO() << "creating task_processor " << Name() << " "
@@ -83,7 +107,8 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
       workers_.emplace_back([this, i, &workers_left] {
         PrepareWorkerThread(i);
         workers_left.count_down();
-        ProcessTasks();
+        ProcessTasks(i);
+        impl::CpuProfiler::Get().UnregisterCurrentThread();
       });
     }
 
@@ -105,7 +130,7 @@ void TaskProcessor::Cleanup() noexcept {
   // Some tasks may be bound but not scheduled yet
   task_counter_.WaitForExhaustion();
 
-  task_queue_.StopProcessing();
+  std::visit([](auto& queue) { queue.StopProcessing(); }, task_queue_);
 
   for (auto& w : workers_) {
     w.join();
@@ -117,6 +142,10 @@ void TaskProcessor::Cleanup() noexcept {
 void TaskProcessor::InitiateShutdown() {
   is_shutting_down_ = true;
   detached_contexts_->RequestCancellation(TaskCancellationReason::kShutdown);
+
+  // Parked workers help to finish the remaining tasks
+  { const std::lock_guard lock(parked_workers_mutex_); }
+  parked_workers_cv_.notify_all();
 }
 
 void TaskProcessor::Schedule(impl::TaskContext* context) {
@@ -136,19 +165,93 @@ void TaskProcessor::Schedule(impl::TaskContext* context) {
 
   SetTaskQueueWaitTimepoint(context);
 
-  task_queue_.Push(context);
+  if (current_schedule_batch &&
+      current_schedule_batch->TryAdd(*this, context)) {
+    return;
+  }
+
+  std::visit([context](auto& queue) { queue.Push(context); }, task_queue_);
+}
+
+void TaskProcessor::ScheduleBulk(
+    utils::span<impl::TaskContext* const> contexts) {
+  if (contexts.size() == 1) {
+    // keeps the queue-specific handoffs of a single wakeup, e.g. LIFO slot
+    std::visit(
+        [context = contexts[0]](auto& queue) {
+          queue.Push({context, /*add_ref=*/false});
+        },
+        task_queue_);
+    return;
+  }
+
+  std::visit(
+      [contexts](auto& queue) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(queue)>,
+                                     TaskQueue>) {
+          queue.PushBulk(contexts);
+        } else {
+          for (auto* context : contexts) {
+            queue.Push({context, /*add_ref=*/false});
+          }
+        }
+      },
+      task_queue_);
+}
+
+TaskProcessor::ScheduleBatch::ScheduleBatch() noexcept
+    : is_outermost_(current_schedule_batch == nullptr) {
+  if (is_outermost_) current_schedule_batch = this;
+}
+
+TaskProcessor::ScheduleBatch::~ScheduleBatch() {
+  if (!is_outermost_) return;
+  current_schedule_batch = nullptr;
+  if (task_processor_) task_processor_->ScheduleBulk(contexts_);
+}
+
+bool TaskProcessor::ScheduleBatch::TryAdd(TaskProcessor& task_processor,
+                                          impl::TaskContext* context) {
+  if (task_processor_ && task_processor_ != &task_processor) return false;
+  task_processor_ = &task_processor;
+  boost::intrusive_ptr<impl::TaskContext> reference{context};
+  contexts_.push_back(reference.get());
+  reference.detach();
+  return true;
 }
 
 void TaskProcessor::Adopt(impl::TaskContext& context) {
   detached_contexts_->Add(context);
 }
 
+void TaskProcessor::SetActiveWorkerCount(std::size_t count) {
+  count = std::clamp<std::size_t>(count, 1, workers_.size());
+  const auto old_count = active_workers_.exchange(count);
+  if (count == old_count) return;
+
+  LOG_INFO() << "task_processor " << Name() << " active worker_threads "
+             << old_count << " -> " << count;
+  if (count > old_count) {
+    { const std::lock_guard lock(parked_workers_mutex_); }
+    parked_workers_cv_.notify_all();
+  }
+}
+
+size_t TaskProcessor::GetTaskQueueSize() const {
+  return std::visit(
+      [](const auto& queue) { return queue.GetSizeApproximate(); },
+      task_queue_);
+}
+
 ev::ThreadPool& TaskProcessor::EventThreadPool() {
   return pools_->EventThreadPool();
 }
 
-impl::CountedCoroutinePtr TaskProcessor::GetCoroutine() {
-  return {pools_->GetCoroPool().GetCoroutine(), *this};
+impl::CountedCoroutinePtr TaskProcessor::GetCoroutine(std::size_t stack_size) {
+  auto& pool = pools_->GetCoroPool();
+  return {pool.GetCoroutine(stack_size ? pool.FindStackSizeClass(stack_size)
+                                       : default_stack_size_class_),
+          *this};
 }
 
 void TaskProcessor::SetSettings(const TaskProcessorSettings& settings) {
@@ -240,28 +343,52 @@ void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
       break;
   }
 
+  impl::ApplyCpuAffinity(config_.cpu_affinity);
+
+  if (jemalloc_arena_) {
+    const auto ec = utils::jemalloc::BindThreadToArena(*jemalloc_arena_);
+    if (ec) {
+      LOG_WARNING() << "Failed to bind a worker of " << Name()
+                    << " to its jemalloc arena: " << ec.message();
+    }
+  }
+
   utils::SetCurrentThreadName(fmt::format("{}_{}", config_.thread_name, index));
 
   impl::SetLocalTaskCounterData(task_counter_, index);
+  impl::CpuProfiler::Get().RegisterCurrentThread();
 
   TaskProcessorThreadStartedHook();
 }
 
-void TaskProcessor::ProcessTasks() noexcept {
+bool TaskProcessor::IsRunningOnWorker(
+    const impl::TaskContext* context) const noexcept {
+  for (const auto& running : running_contexts_) {
+    if (running->load(std::memory_order_relaxed) == context) return true;
+  }
+  return false;
+}
+
+void TaskProcessor::ProcessTasks(std::size_t index) noexcept {
+  auto& running = *running_contexts_[index];
   while (true) {
-    auto context = task_queue_.PopBlocking();
+    ParkWorkerIfInactive(index);
+    auto context = std::visit(
+        [](auto& queue) { return queue.PopBlocking(); }, task_queue_);
     if (!context) break;
 
     GetTaskCounter().AccountTaskSwitchSlow();
     CheckWaitTime(*context);
 
     bool has_failed = false;
+    running.store(context.get(), std::memory_order_relaxed);
     try {
       context->DoStep();
     } catch (const std::exception& ex) {
       LOG_ERROR() << "uncaught exception from DoStep: " << ex;
       has_failed = true;
     }
+    running.store(nullptr, std::memory_order_relaxed);
 
     if (has_failed || context->IsFinished()) {
       context->FinishDetached();
@@ -269,7 +396,51 @@ void TaskProcessor::ProcessTasks() noexcept {
   }
 }
 
+void TaskProcessor::ParkWorkerIfInactive(std::size_t index) noexcept {
+  if (index < active_workers_.load(std::memory_order_relaxed)) return;
+
+  // Nobody wakes up a worker for the tasks in its own local queue, so they
+  // are handed over to the active workers before parking
+  std::visit(
+      [](auto& queue) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(queue)>,
+                                     WorkStealingTaskQueue>) {
+          queue.DrainCurrentConsumer();
+        }
+      },
+      task_queue_);
+
+  std::unique_lock lock(parked_workers_mutex_);
+  parked_workers_cv_.wait(lock, [this, index] {
+    return index < active_workers_.load() || is_shutting_down_.load();
+  });
+}
+
+TaskProcessor::TaskQueueVariant TaskProcessor::MakeTaskQueue(
+    const TaskProcessorConfig& config) {
+  switch (config.task_queue) {
+    case TaskQueueType::kGlobalTaskQueue:
+      return TaskQueueVariant{std::in_place_type<TaskQueue>, config};
+    case TaskQueueType::kWorkStealingTaskQueue:
+      return TaskQueueVariant{std::in_place_type<WorkStealingTaskQueue>,
+                              config};
+    case TaskQueueType::kPriorityTaskQueue:
+      return TaskQueueVariant{std::in_place_type<PriorityTaskQueue>, config};
+  }
+  UINVARIANT(false, "Unexpected task queue type");
+}
+
 void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
+  if (auto* const wait_stats = context.GetWaitStats()) {
+    const auto wait_timepoint = context.GetQueueWaitTimepoint();
+    if (wait_timepoint != std::chrono::steady_clock::time_point()) {
+      const std::chrono::nanoseconds wait_time =
+          std::chrono::steady_clock::now() - wait_timepoint;
+      wait_stats->queue_wait += wait_time;
+      wait_stats->last_queue_wait = wait_time;
+    }
+  }
+
   const auto max_wait_time = max_task_queue_wait_time_.load();
   const auto sensor_wait_time = sensor_task_queue_wait_time_.load();
 
@@ -1,22 +1,31 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
+#include <variant>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <concurrent/impl/interference_shield.hpp>
+#include <engine/task/priority_task_queue.hpp>
 #include <engine/task/task_counter.hpp>
 #include <engine/task/task_processor_config.hpp>
 #include <engine/task/task_queue.hpp>
+#include <engine/task/work_stealing_task_queue.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 #include <userver/logging/logger.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -33,7 +42,35 @@ class ThreadPool;
 }  // namespace ev
 
 class TaskProcessor final {
+  using TaskQueueVariant =
+      std::variant<TaskQueue, WorkStealingTaskQueue, PriorityTaskQueue>;
+
  public:
+  // While alive, collects the tasks that the current thread schedules and
+  // enqueues them at once on destruction, to avoid a queue operation and a
+  // worker wakeup per task on broadcast wakeups. Only the tasks of the first
+  // scheduled task processor are collected, others are scheduled as usual.
+  // Nested batches are merged into the outermost one.
+  class ScheduleBatch final {
+   public:
+    ScheduleBatch() noexcept;
+
+    ScheduleBatch(const ScheduleBatch&) = delete;
+    ScheduleBatch& operator=(const ScheduleBatch&) = delete;
+
+    ~ScheduleBatch();
+
+   private:
+    friend class TaskProcessor;
+
+    bool TryAdd(TaskProcessor& task_processor, impl::TaskContext* context);
+
+    const bool is_outermost_;
+    TaskProcessor* task_processor_{nullptr};
+    // hold references to the contexts
+    boost::container::small_vector<impl::TaskContext*, 16> contexts_;
+  };
+
   TaskProcessor(TaskProcessorConfig, std::shared_ptr<impl::TaskProcessorPools>);
   ~TaskProcessor();
 
@@ -41,9 +78,13 @@ class TaskProcessor final {
 
   void Schedule(impl::TaskContext*);
 
+  // Takes over the references to the contexts prepared by Schedule()
+  void ScheduleBulk(utils::span<impl::TaskContext* const> contexts);
+
   void Adopt(impl::TaskContext& context);
 
-  impl::CountedCoroutinePtr GetCoroutine();
+  // `stack_size` of 0 selects the task processor default
+  impl::CountedCoroutinePtr GetCoroutine(std::size_t stack_size);
 
   ev::ThreadPool& EventThreadPool();
 
@@ -57,12 +98,38 @@ class TaskProcessor final {
 
   const impl::TaskCounter& GetTaskCounter() const { return task_counter_; }
 
-  size_t GetTaskQueueSize() const { return task_queue_.GetSizeApproximate(); }
+  size_t GetTaskQueueSize() const;
 
   size_t GetWorkerCount() const { return workers_.size(); }
 
+  // Workers with indices starting from `count` park after finishing the
+  // current task, the count is clamped to [1, GetWorkerCount()]
+  void SetActiveWorkerCount(std::size_t count);
+
+  std::size_t GetActiveWorkerCount() const noexcept {
+    return active_workers_.load(std::memory_order_relaxed);
+  }
+
+  std::size_t GetIoPollIterations() const noexcept {
+    return config_.io_poll_iterations;
+  }
+
+  // The jemalloc arena of the workers, if the task processor has one
+  std::optional<unsigned> GetJemallocArena() const noexcept {
+    return jemalloc_arena_;
+  }
+
+  std::optional<std::size_t> GetNumaNode() const {
+    return config_.cpu_affinity.numa_node;
+  }
+
   void SetSettings(const TaskProcessorSettings& settings);
 
+  // Whether the last dequeued task exceeded the max task queue wait time
+  bool IsTaskQueueWaitTimeOverloaded() const noexcept {
+    return task_queue_wait_time_overloaded_->load(std::memory_order_relaxed);
+  }
+
   std::chrono::microseconds GetProfilerThreshold() const;
 
   bool ShouldProfilerForceStacktrace() const;
@@ -77,12 +144,19 @@ class TaskProcessor final {
 
   std::vector<std::uint8_t> CollectCurrentLoadPct() const;
 
+  // Whether the context is being executed by a worker of this task processor
+  // right now. Only compares the pointers, so the context may already be
+  // destroyed.
+  bool IsRunningOnWorker(const impl::TaskContext* context) const noexcept;
+
  private:
   void Cleanup() noexcept;
 
   void PrepareWorkerThread(std::size_t index) noexcept;
 
-  void ProcessTasks() noexcept;
+  void ProcessTasks(std::size_t index) noexcept;
+
+  void ParkWorkerIfInactive(std::size_t index) noexcept;
 
   void CheckWaitTime(impl::TaskContext& context);
 
@@ -90,16 +164,26 @@ class TaskProcessor final {
 
   void HandleOverload(impl::TaskContext& context);
 
+  static TaskQueueVariant MakeTaskQueue(const TaskProcessorConfig& config);
+
   impl::TaskCounter task_counter_;
   concurrent::impl::InterferenceShield<impl::DetachedTasksSyncBlock>
       detached_contexts_{impl::DetachedTasksSyncBlock::StopMode::kCancel};
   concurrent::impl::InterferenceShield<std::atomic<bool>>
       task_queue_wait_time_overloaded_{false};
-  TaskQueue task_queue_;
+  TaskQueueVariant task_queue_;
 
   const TaskProcessorConfig config_;
   const std::shared_ptr<impl::TaskProcessorPools> pools_;
+  const std::size_t default_stack_size_class_;
+  const std::optional<unsigned> jemalloc_arena_;
   std::vector<std::thread> workers_;
+  std::atomic<std::size_t> active_workers_;
+  std::mutex parked_workers_mutex_;
+  std::condition_variable parked_workers_cv_;
+  utils::FixedArray<concurrent::impl::InterferenceShield<
+      std::atomic<const impl::TaskContext*>>>
+      running_contexts_;
   logging::LoggerPtr task_trace_logger_{nullptr};
 
   std::atomic<std::chrono::microseconds> task_profiler_threshold_{{}};
@@ -45,17 +45,48 @@ OsScheduling Parse(const yaml_config::YamlConfig& value,
   return utils::ParseFromValueString(value, kMap);
 }
 
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>) {
+  static constexpr utils::TrivialBiMap kMap([](auto selector) {
+    return selector()
+        .Case(TaskQueueType::kGlobalTaskQueue, "global-task-queue")
+        .Case(TaskQueueType::kWorkStealingTaskQueue,
+              "work-stealing-task-queue")
+        .Case(TaskQueueType::kPriorityTaskQueue, "priority-task-queue");
+  });
+
+  return utils::ParseFromValueString(value, kMap);
+}
+
 TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
                           formats::parse::To<TaskProcessorConfig>) {
   TaskProcessorConfig config;
   config.should_guess_cpu_limit =
       value["guess-cpu-limit"].As<bool>(config.should_guess_cpu_limit);
   config.worker_threads = value["worker_threads"].As<std::size_t>();
+  config.should_autoscale =
+      value["autoscale"].As<bool>(config.should_autoscale);
+  config.min_worker_threads =
+      value["min-worker-threads"].As<std::size_t>(config.min_worker_threads);
   config.thread_name = value["thread_name"].As<std::string>({});
   config.os_scheduling =
       value["os-scheduling"].As<OsScheduling>(config.os_scheduling);
   config.spinning_iterations =
       value["spinning-iterations"].As<int>(config.spinning_iterations);
+  config.io_poll_iterations = value["io-poll-iterations"].As<std::size_t>(
+      config.io_poll_iterations);
+  config.jemalloc_arena =
+      value["jemalloc-arena"].As<bool>(config.jemalloc_arena);
+  config.task_queue =
+      value["task-processor-queue"].As<TaskQueueType>(config.task_queue);
+  config.priority_starvation_limit =
+      value["priority-starvation-limit"].As<std::size_t>(
+          config.priority_starvation_limit);
+  config.priority_deadline_ordering =
+      value["priority-deadline-ordering"].As<bool>(
+          config.priority_deadline_ordering);
+  config.cpu_affinity = impl::ParseCpuAffinity(value);
+  config.stack_size = value["stack-size"].As<std::size_t>(config.stack_size);
 
   const auto task_trace = value["task-trace"];
   if (!task_trace.IsMissing()) {
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <string>
 
+#include <engine/impl/cpu_affinity.hpp>
 #include <userver/formats/json_fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
@@ -21,14 +22,41 @@ enum class OsScheduling {
 OsScheduling Parse(const yaml_config::YamlConfig& value,
                    formats::parse::To<OsScheduling>);
 
+enum class TaskQueueType {
+  kGlobalTaskQueue,
+  kWorkStealingTaskQueue,
+  kPriorityTaskQueue,
+};
+
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>);
+
 struct TaskProcessorConfig {
   std::string name;
 
   bool should_guess_cpu_limit{false};
   std::size_t worker_threads{6};
+  // engine::TaskProcessorsLoadMonitor parks and unparks the workers at runtime,
+  // keeping at least min_worker_threads of them active
+  bool should_autoscale{false};
+  std::size_t min_worker_threads{1};
   std::string thread_name;
   OsScheduling os_scheduling{OsScheduling::kNormal};
   int spinning_iterations{10000};
+  // poll(2) calls a task makes on its socket before handing it over to the ev
+  // thread, while the task queue is empty; 0 disables the polling
+  std::size_t io_poll_iterations{0};
+  TaskQueueType task_queue{TaskQueueType::kGlobalTaskQueue};
+  // kPriorityTaskQueue only: each N-th pop starts from a lower class, 0 for
+  // the strict priorities
+  std::size_t priority_starvation_limit{16};
+  // kPriorityTaskQueue only: order the kNormal tasks by scheduling deadline
+  bool priority_deadline_ordering{false};
+  impl::CpuAffinityConfig cpu_affinity;
+  // coroutine stack size of the tasks, 0 for the coro_pool.stack_size
+  std::size_t stack_size{0};
+  // the workers allocate from a jemalloc arena of their own
+  bool jemalloc_arena{false};
 
   std::size_t task_trace_every{1000};
   std::size_t task_trace_max_csw{0};
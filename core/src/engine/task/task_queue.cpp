@@ -1,5 +1,7 @@
 #include <engine/task/task_queue.hpp>
 
+#include <algorithm>
+
 #include <engine/task/task_context.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +21,15 @@ void TaskQueue::Push(boost::intrusive_ptr<impl::TaskContext>&& context) {
   context.detach();
 }
 
+void TaskQueue::PushBulk(utils::span<impl::TaskContext* const> contexts) {
+  if (contexts.empty()) return;
+  UASSERT(std::all_of(contexts.begin(), contexts.end(),
+                      [](const auto* context) { return context != nullptr; }));
+  queue_.enqueue_bulk(contexts.data(), contexts.size());
+  queue_semaphore_.signal(
+      static_cast<moodycamel::LightweightSemaphore::ssize_t>(contexts.size()));
+}
+
 boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
   // Current thread handles only a single TaskProcessor, so it's safe to store
   // a token for the task processor in a thread-local variable.
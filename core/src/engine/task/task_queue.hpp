@@ -5,6 +5,7 @@
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <engine/task/task_processor_config.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -20,6 +21,10 @@ class TaskQueue final {
 
   void Push(boost::intrusive_ptr<impl::TaskContext>&& context);
 
+  // Takes over the references to the contexts. Enqueues them with a single
+  // queue operation and a single semaphore signal.
+  void PushBulk(utils::span<impl::TaskContext* const> contexts);
+
   // Returns nullptr as a stop signal
   boost::intrusive_ptr<impl::TaskContext> PopBlocking();
 
@@ -301,6 +301,29 @@ TEST(Task, CoroStackSizeSet) {
   });
 }
 
+TEST(Task, CoroStackSizeClasses) {
+  engine::TaskProcessorPoolsConfig config{};
+  config.coro_stack_size = 256 * 1024;
+  config.coro_stack_size_classes = {32 * 1024, 1024 * 1024};
+  engine::RunStandalone(1, config, []() {
+    EXPECT_EQ(engine::current_task::GetStackSize(), 256 * 1024);
+
+    const auto get_stack_size = [](std::size_t requested) {
+      return engine::AsyncNoSpan(
+                 engine::current_task::GetTaskProcessor(),
+                 engine::StackSize{requested},
+                 [] { return engine::current_task::GetStackSize(); })
+          .Get();
+    };
+    EXPECT_EQ(get_stack_size(16 * 1024), 32 * 1024);
+    EXPECT_EQ(get_stack_size(32 * 1024), 32 * 1024);
+    EXPECT_EQ(get_stack_size(100 * 1024), 256 * 1024);
+    EXPECT_EQ(get_stack_size(512 * 1024), 1024 * 1024);
+    // the biggest class is used if none fits
+    EXPECT_EQ(get_stack_size(4 * 1024 * 1024), 1024 * 1024);
+  });
+}
+
 // ASAN has issues with stacks of more than ~4MB, so we use 3MB stacks here
 TEST(Task, UseMediumStack) {
   engine::TaskProcessorPoolsConfig config{};
@@ -0,0 +1,37 @@
+#include <engine/task/wait_stats.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+std::string_view ToString(WaitReason reason) noexcept {
+  switch (reason) {
+    case WaitReason::kOther:
+      return "other";
+    case WaitReason::kMutex:
+      return "mutex";
+    case WaitReason::kSemaphore:
+      return "semaphore";
+    case WaitReason::kConditionVariable:
+      return "condition_variable";
+    case WaitReason::kEvent:
+      return "event";
+    case WaitReason::kFuture:
+      return "future";
+    case WaitReason::kTask:
+      return "task";
+    case WaitReason::kSleep:
+      return "sleep";
+    case WaitReason::kIo:
+      return "io";
+  }
+
+  UASSERT_MSG(false, "Unexpected WaitReason");
+  return "unknown";
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+/// What a task was blocked on, see WaitStrategy
+enum class WaitReason : std::uint8_t {
+  kOther,
+  kMutex,
+  kSemaphore,
+  kConditionVariable,
+  kEvent,
+  kFuture,
+  kTask,
+  kSleep,
+  kIo,
+};
+
+inline constexpr std::size_t kWaitReasonCount =
+    static_cast<std::size_t>(WaitReason::kIo) + 1;
+
+std::string_view ToString(WaitReason reason) noexcept;
+
+/// Off-CPU time of a task, accounted only after
+/// current_task::EnableWaitStats()
+struct TaskWaitStats final {
+  std::chrono::nanoseconds& WaitTime(WaitReason reason) noexcept {
+    return wait_time[static_cast<std::size_t>(reason)];
+  }
+
+  // blocked time by WaitReason, without the time in the task queue
+  std::array<std::chrono::nanoseconds, kWaitReasonCount> wait_time{};
+  // time in the task processor queue after the wakeups
+  std::chrono::nanoseconds queue_wait{0};
+  std::uint64_t context_switches{0};
+
+  // queue wait before the current slice, to be excluded from wait_time
+  std::chrono::nanoseconds last_queue_wait{0};
+};
+
+}  // namespace engine::impl
+
+namespace engine::current_task {
+
+/// Starts accounting the off-CPU time of the current task
+void EnableWaitStats();
+
+/// nullptr if current_task::EnableWaitStats() was not called
+const impl::TaskWaitStats* GetWaitStats() noexcept;
+
+}  // namespace engine::current_task
+
+USERVER_NAMESPACE_END
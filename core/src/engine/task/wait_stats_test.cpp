@@ -0,0 +1,60 @@
+#include <engine/task/wait_stats.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using engine::impl::WaitReason;
+
+std::chrono::nanoseconds GetWaitTime(WaitReason reason) {
+  const auto* const stats = engine::current_task::GetWaitStats();
+  EXPECT_TRUE(stats);
+  return stats ? stats->wait_time[static_cast<std::size_t>(reason)]
+               : std::chrono::nanoseconds{0};
+}
+
+}  // namespace
+
+UTEST(WaitStats, DisabledByDefault) {
+  engine::SleepFor(1ms);
+  EXPECT_EQ(engine::current_task::GetWaitStats(), nullptr);
+}
+
+UTEST(WaitStats, Sleep) {
+  engine::current_task::EnableWaitStats();
+  engine::SleepFor(20ms);
+
+  EXPECT_GE(GetWaitTime(WaitReason::kSleep), 20ms);
+  EXPECT_EQ(GetWaitTime(WaitReason::kMutex).count(), 0);
+  EXPECT_GE(engine::current_task::GetWaitStats()->context_switches, 1);
+}
+
+UTEST_MT(WaitStats, MutexAndTask, 2) {
+  engine::current_task::EnableWaitStats();
+
+  engine::Mutex mutex;
+  engine::SingleConsumerEvent locked;
+  auto task = engine::AsyncNoSpan([&] {
+    std::lock_guard lock{mutex};
+    locked.Send();
+    engine::SleepFor(20ms);
+  });
+
+  ASSERT_TRUE(locked.WaitForEvent());
+  { std::lock_guard lock{mutex}; }
+  task.Get();
+
+  EXPECT_GE(GetWaitTime(WaitReason::kMutex) + GetWaitTime(WaitReason::kTask),
+            10ms);
+  EXPECT_EQ(GetWaitTime(WaitReason::kSleep).count(), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,359 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <algorithm>
+#include <limits>
+
+#include <engine/task/task_context.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+// Limits the number of LIFO slot pops in a row, so that two tasks waking up
+// each other could not starve the rest of the local queue.
+constexpr std::size_t kMaxLifoPopsInRow = 3;
+
+// Every N-th pop checks the global queue first, so that tasks scheduled from
+// foreign threads could not starve while the local queue is busy.
+constexpr std::size_t kGlobalQueueCheckInterval = 61;
+
+// Max number of tasks moved into the local queue from the global one at once.
+constexpr std::size_t kGlobalQueueBatchSize = 32;
+
+// Max number of tasks moved from a sibling's local queue at once.
+constexpr std::size_t kMaxStealBatchSize = 16;
+
+struct CurrentConsumer final {
+  const void* queue{nullptr};
+  void* consumer{nullptr};
+};
+
+thread_local CurrentConsumer current_consumer;
+
+std::uint32_t NextRandom(std::uint32_t& state) noexcept {
+  // xorshift32
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+}  // namespace
+
+bool WorkStealingTaskQueue::LocalQueue::TryPush(
+    impl::TaskContext* context) noexcept {
+  const auto tail = tail_->load(std::memory_order_relaxed);
+  const auto head = head_->load(std::memory_order_acquire);
+  if (tail - head >= kCapacity) return false;
+
+  buffer_[tail % kCapacity].store(context, std::memory_order_relaxed);
+  tail_->store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::LocalQueue::TryPop() noexcept {
+  auto head = head_->load(std::memory_order_acquire);
+  while (true) {
+    const auto tail = tail_->load(std::memory_order_acquire);
+    if (head == tail) return nullptr;
+
+    // The slot cannot be overwritten by the owner until the head moves past
+    // it, so the value is valid if the CAS below succeeds.
+    auto* context = buffer_[head % kCapacity].load(std::memory_order_relaxed);
+    if (head_->compare_exchange_weak(head, head + 1, std::memory_order_acq_rel,
+                                     std::memory_order_acquire)) {
+      return context;
+    }
+  }
+}
+
+std::size_t WorkStealingTaskQueue::LocalQueue::GetSizeApproximate()
+    const noexcept {
+  const auto head = head_->load(std::memory_order_relaxed);
+  const auto tail = tail_->load(std::memory_order_relaxed);
+  return tail > head ? tail - head : 0;
+}
+
+WorkStealingTaskQueue::Consumer::Consumer(
+    moodycamel::ConcurrentQueue<impl::TaskContext*>& queue)
+    : semaphore(0, 0),
+      global_token(queue),
+      random_state(utils::RandRange(
+          std::uint32_t{1}, std::numeric_limits<std::uint32_t>::max())) {}
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(const TaskProcessorConfig& config)
+    : consumers_(config.worker_threads, global_queue_),
+      // Each steal round touches every sibling, so the total amount of
+      // spinning stays comparable with the TaskQueue semaphore spinning.
+      steal_rounds_before_park_(std::max<std::size_t>(
+          1, static_cast<std::size_t>(std::max(config.spinning_iterations, 0)) /
+                 std::max<std::size_t>(config.worker_threads, 1))) {
+  UINVARIANT(!consumers_.empty(), "Work stealing queue requires workers");
+  sleepers_.reserve(consumers_.size());
+}
+
+void WorkStealingTaskQueue::Push(
+    boost::intrusive_ptr<impl::TaskContext>&& context) {
+  UASSERT(context);
+  auto* const raw_context = context.detach();
+
+  auto* const consumer = GetCurrentConsumer();
+  if (!consumer) {
+    PushGlobal(raw_context);
+    WakeUpOne();
+    return;
+  }
+
+  if (!current_task::GetCurrentTaskContextUnchecked()) {
+    // Rescheduling outside of a coroutine happens on Yield() and on wakeups
+    // that came during the step. Such tasks go to the end of the local queue
+    // to give way to others.
+    PushLocal(*consumer, raw_context);
+    WakeUpOne();
+    return;
+  }
+
+  // The task was just woken up by the current coroutine, it is likely to
+  // touch the same data, so hand it off via the LIFO slot.
+  auto* const previous =
+      consumer->lifo_slot->exchange(raw_context, std::memory_order_acq_rel);
+  if (previous) {
+    PushLocal(*consumer, previous);
+    WakeUpOne();
+  }
+}
+
+boost::intrusive_ptr<impl::TaskContext> WorkStealingTaskQueue::PopBlocking() {
+  auto& consumer = GetOrBindConsumer();
+  return {DoPopBlocking(consumer), /* add_ref= */ false};
+}
+
+void WorkStealingTaskQueue::StopProcessing() {
+  is_stopped_.store(true);
+
+  std::lock_guard lock(sleepers_mutex_);
+  for (auto* consumer : sleepers_) {
+    consumer->semaphore.signal();
+  }
+  sleepers_count_->fetch_sub(sleepers_.size());
+  sleepers_.clear();
+}
+
+void WorkStealingTaskQueue::DrainCurrentConsumer() {
+  auto* const consumer = GetCurrentConsumer();
+  if (!consumer) return;
+
+  bool has_tasks = false;
+  if (auto* context =
+          consumer->lifo_slot->exchange(nullptr, std::memory_order_acq_rel)) {
+    PushGlobal(context);
+    has_tasks = true;
+  }
+  while (auto* context = consumer->local_queue.TryPop()) {
+    PushGlobal(context);
+    has_tasks = true;
+  }
+  if (has_tasks) WakeUpOne();
+}
+
+std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
+  std::size_t size = global_queue_.size_approx();
+  for (const auto& consumer : consumers_) {
+    size += consumer.local_queue.GetSizeApproximate();
+    if (consumer.lifo_slot->load(std::memory_order_relaxed)) ++size;
+  }
+  return size;
+}
+
+WorkStealingTaskQueue::Consumer* WorkStealingTaskQueue::GetCurrentConsumer()
+    const noexcept {
+  if (current_consumer.queue != this) return nullptr;
+  return static_cast<Consumer*>(current_consumer.consumer);
+}
+
+WorkStealingTaskQueue::Consumer& WorkStealingTaskQueue::GetOrBindConsumer() {
+  if (auto* consumer = GetCurrentConsumer()) return *consumer;
+
+  // Current thread handles only a single TaskProcessor, so it's safe to bind
+  // it to a consumer forever.
+  const auto index = bound_consumers_->fetch_add(1);
+  UINVARIANT(index < consumers_.size(),
+             "More threads are popping from the task queue than configured");
+  current_consumer = {this, &consumers_[index]};
+  return consumers_[index];
+}
+
+impl::TaskContext* WorkStealingTaskQueue::DoPopBlocking(Consumer& consumer) {
+  while (true) {
+    if (auto* context = TryPopLocal(consumer)) return context;
+
+    spinning_count_->fetch_add(1, std::memory_order_seq_cst);
+    for (std::size_t i = 0; i < steal_rounds_before_park_; ++i) {
+      if (auto* context = TryPopRemote(consumer)) {
+        StopSpinning(/*found_task=*/true);
+        return context;
+      }
+      if (is_stopped_.load(std::memory_order_relaxed)) break;
+    }
+    StopSpinning(/*found_task=*/false);
+    if (is_stopped_.load()) return nullptr;
+
+    if (auto* context = Park(consumer)) return context;
+    if (is_stopped_.load()) return nullptr;
+  }
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopLocal(Consumer& consumer) {
+  if (++consumer.pops_count % kGlobalQueueCheckInterval == 0) {
+    if (auto* context = TryPopGlobal(consumer)) return context;
+  }
+
+  auto& lifo_slot = *consumer.lifo_slot;
+  if (consumer.lifo_pops_in_row < kMaxLifoPopsInRow &&
+      lifo_slot.load(std::memory_order_relaxed)) {
+    if (auto* context =
+            lifo_slot.exchange(nullptr, std::memory_order_acq_rel)) {
+      ++consumer.lifo_pops_in_row;
+      return context;
+    }
+  }
+  consumer.lifo_pops_in_row = 0;
+
+  if (auto* context = consumer.local_queue.TryPop()) return context;
+
+  if (lifo_slot.load(std::memory_order_relaxed)) {
+    return lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+  }
+  return nullptr;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopGlobal(Consumer& consumer) {
+  std::array<impl::TaskContext*, kGlobalQueueBatchSize> batch{};
+  const auto count = global_queue_.try_dequeue_bulk(
+      consumer.global_token, batch.begin(), batch.size());
+  if (count == 0) return nullptr;
+
+  for (std::size_t i = 1; i < count; ++i) {
+    PushLocal(consumer, batch[i]);
+  }
+  if (count > 1) WakeUpOne();
+  return batch[0];
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TrySteal(Consumer& consumer) {
+  const auto consumers_count = consumers_.size();
+  const auto start = NextRandom(consumer.random_state) % consumers_count;
+
+  for (std::size_t i = 0; i < consumers_count; ++i) {
+    auto& victim = consumers_[(start + i) % consumers_count];
+    if (&victim == &consumer) continue;
+
+    auto* const context = victim.local_queue.TryPop();
+    if (context) {
+      // Take up to a half of the victim's tasks to avoid stealing again soon
+      const auto batch_size =
+          std::min(victim.local_queue.GetSizeApproximate() / 2,
+                   kMaxStealBatchSize);
+      for (std::size_t j = 0; j < batch_size; ++j) {
+        auto* const stolen = victim.local_queue.TryPop();
+        if (!stolen) break;
+        PushLocal(consumer, stolen);
+      }
+      return context;
+    }
+
+    auto& victim_lifo_slot = *victim.lifo_slot;
+    if (victim_lifo_slot.load(std::memory_order_relaxed)) {
+      if (auto* lifo_context =
+              victim_lifo_slot.exchange(nullptr, std::memory_order_acq_rel)) {
+        return lifo_context;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopRemote(Consumer& consumer) {
+  if (auto* context = TryPopGlobal(consumer)) return context;
+  return TrySteal(consumer);
+}
+
+void WorkStealingTaskQueue::PushLocal(Consumer& consumer,
+                                      impl::TaskContext* context) {
+  if (!consumer.local_queue.TryPush(context)) PushGlobal(context);
+}
+
+void WorkStealingTaskQueue::PushGlobal(impl::TaskContext* context) {
+  global_queue_.enqueue(context);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::Park(Consumer& consumer) {
+  {
+    std::lock_guard lock(sleepers_mutex_);
+    sleepers_.push_back(&consumer);
+    sleepers_count_->fetch_add(1, std::memory_order_seq_cst);
+  }
+
+  // Pairs with the fence in WakeUpOne(): either the producer sees us
+  // sleeping, or we see its task.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  auto* context = TryPopRemote(consumer);
+  if (context || is_stopped_.load()) {
+    if (!TryCancelPark(consumer)) {
+      // Somebody has already woken us up, consume the signal
+      consumer.semaphore.wait();
+    }
+    return context;
+  }
+
+  consumer.semaphore.wait();
+  return nullptr;
+}
+
+bool WorkStealingTaskQueue::TryCancelPark(Consumer& consumer) {
+  std::lock_guard lock(sleepers_mutex_);
+  const auto it = std::find(sleepers_.begin(), sleepers_.end(), &consumer);
+  if (it == sleepers_.end()) return false;
+
+  sleepers_.erase(it);
+  sleepers_count_->fetch_sub(1, std::memory_order_seq_cst);
+  return true;
+}
+
+void WorkStealingTaskQueue::StopSpinning(bool found_task) {
+  const auto previous_spinning_count =
+      spinning_count_->fetch_sub(1, std::memory_order_seq_cst);
+  if (found_task && previous_spinning_count == 1) {
+    // The last spinning worker is going to be busy, there may be more tasks
+    // that were not accompanied by a wakeup.
+    WakeUpOne();
+  }
+}
+
+void WorkStealingTaskQueue::WakeUpOne() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  // A spinning worker is guaranteed to see the new task, either while
+  // spinning or on the re-check in Park().
+  if (spinning_count_->load(std::memory_order_relaxed) != 0) return;
+  if (sleepers_count_->load(std::memory_order_relaxed) == 0) return;
+
+  Consumer* consumer = nullptr;
+  {
+    std::lock_guard lock(sleepers_mutex_);
+    if (sleepers_.empty()) return;
+    consumer = sleepers_.back();
+    sleepers_.pop_back();
+    sleepers_count_->fetch_sub(1, std::memory_order_seq_cst);
+  }
+  consumer->semaphore.signal();
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// A task queue with a bounded local run queue and a LIFO slot per worker.
+///
+/// Tasks woken from a coroutine running on a worker are put into the LIFO
+/// slot of that worker, the previous occupant of the slot goes to the local
+/// queue. Tasks scheduled from foreign threads go to a shared overflow queue.
+/// Idle workers take tasks from the overflow queue and steal from random
+/// siblings before going to sleep.
+class WorkStealingTaskQueue final {
+ public:
+  explicit WorkStealingTaskQueue(const TaskProcessorConfig& config);
+
+  void Push(boost::intrusive_ptr<impl::TaskContext>&& context);
+
+  // Returns nullptr as a stop signal
+  boost::intrusive_ptr<impl::TaskContext> PopBlocking();
+
+  void StopProcessing();
+
+  // Moves the tasks from the LIFO slot and the local queue of the current
+  // worker into the shared queue, so that the other workers could run them
+  // while the current one is parked.
+  void DrainCurrentConsumer();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  // Bounded ring buffer, only the owner pushes, anyone may pop.
+  class LocalQueue final {
+   public:
+    static constexpr std::size_t kCapacity = 256;
+
+    // Must only be called by the owning worker. Returns false if full.
+    bool TryPush(impl::TaskContext* context) noexcept;
+
+    impl::TaskContext* TryPop() noexcept;
+
+    std::size_t GetSizeApproximate() const noexcept;
+
+   private:
+    concurrent::impl::InterferenceShield<std::atomic<std::size_t>> head_{0};
+    concurrent::impl::InterferenceShield<std::atomic<std::size_t>> tail_{0};
+    std::array<std::atomic<impl::TaskContext*>, kCapacity> buffer_{};
+  };
+
+  struct alignas(
+      concurrent::impl::kDestructiveInterferenceSize) Consumer final {
+    explicit Consumer(moodycamel::ConcurrentQueue<impl::TaskContext*>& queue);
+
+    LocalQueue local_queue;
+    concurrent::impl::InterferenceShield<std::atomic<impl::TaskContext*>>
+        lifo_slot{nullptr};
+    moodycamel::LightweightSemaphore semaphore;
+
+    // Accessed by the owning worker only
+    moodycamel::ConsumerToken global_token;
+    std::uint32_t random_state;
+    std::size_t pops_count{0};
+    std::size_t lifo_pops_in_row{0};
+  };
+
+  Consumer* GetCurrentConsumer() const noexcept;
+  Consumer& GetOrBindConsumer();
+
+  impl::TaskContext* DoPopBlocking(Consumer& consumer);
+  impl::TaskContext* TryPopLocal(Consumer& consumer);
+  impl::TaskContext* TryPopGlobal(Consumer& consumer);
+  impl::TaskContext* TrySteal(Consumer& consumer);
+  impl::TaskContext* TryPopRemote(Consumer& consumer);
+
+  void PushLocal(Consumer& consumer, impl::TaskContext* context);
+  void PushGlobal(impl::TaskContext* context);
+
+  // Returns a task found after announcing the sleep, nullptr if the consumer
+  // has slept and was woken up.
+  impl::TaskContext* Park(Consumer& consumer);
+  // Returns true if consumer was still asleep and is now removed from sleepers
+  bool TryCancelPark(Consumer& consumer);
+  void StopSpinning(bool found_task);
+  void WakeUpOne();
+
+  moodycamel::ConcurrentQueue<impl::TaskContext*> global_queue_;
+  utils::FixedArray<Consumer> consumers_;
+  const std::size_t steal_rounds_before_park_;
+
+  concurrent::impl::InterferenceShield<std::atomic<std::size_t>>
+      bound_consumers_{0};
+  concurrent::impl::InterferenceShield<std::atomic<std::size_t>>
+      spinning_count_{0};
+  concurrent::impl::InterferenceShield<std::atomic<std::size_t>>
+      sleepers_count_{0};
+  std::atomic<bool> is_stopped_{false};
+
+  std::mutex sleepers_mutex_;
+  std::vector<Consumer*> sleepers_;
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kTasks = 10000;
+constexpr std::size_t kPairs = 16;
+constexpr std::size_t kIterations = 1000;
+constexpr std::size_t kThreads = 4;
+constexpr std::size_t kEventsPerThread = 1000;
+
+void RunWorkStealing(std::size_t worker_threads,
+                     utils::function_ref<void()> payload) {
+  auto task_processor = engine::impl::TaskProcessorHolder::Make(
+      worker_threads, "ws-worker", engine::impl::MakeTaskProcessorPools({}),
+      engine::TaskQueueType::kWorkStealingTaskQueue);
+  engine::impl::RunOnTaskProcessorSync(*task_processor, payload);
+}
+
+}  // namespace
+
+TEST(WorkStealingTaskQueue, Simple) {
+  RunWorkStealing(1, [] {
+    auto task = engine::AsyncNoSpan([] { return 42; });
+    EXPECT_EQ(task.Get(), 42);
+  });
+}
+
+TEST(WorkStealingTaskQueue, ManyTasks) {
+  RunWorkStealing(4, [] {
+    std::atomic<std::size_t> counter{0};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kTasks);
+    for (std::size_t i = 0; i < kTasks; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&counter] { ++counter; }));
+    }
+    for (auto& task : tasks) task.Get();
+    EXPECT_EQ(counter.load(), kTasks);
+  });
+}
+
+TEST(WorkStealingTaskQueue, YieldGivesWayToOthers) {
+  RunWorkStealing(1, [] {
+    std::atomic<bool> other_started{false};
+    auto other = engine::AsyncNoSpan([&] { other_started = true; });
+
+    while (!other_started) engine::Yield();
+    other.Get();
+  });
+}
+
+TEST(WorkStealingTaskQueue, PingPong) {
+  RunWorkStealing(4, [] {
+    std::vector<engine::TaskWithResult<void>> tasks;
+    std::vector<std::unique_ptr<engine::SingleConsumerEvent>> events;
+    for (std::size_t i = 0; i < kPairs * 2; ++i) {
+      events.push_back(std::make_unique<engine::SingleConsumerEvent>());
+    }
+
+    for (std::size_t pair = 0; pair < kPairs; ++pair) {
+      auto& ping = *events[pair * 2];
+      auto& pong = *events[pair * 2 + 1];
+      tasks.push_back(engine::AsyncNoSpan([&ping, &pong] {
+        for (std::size_t i = 0; i < kIterations; ++i) {
+          pong.Send();
+          ASSERT_TRUE(ping.WaitForEventFor(utest::kMaxTestWaitTime));
+        }
+      }));
+      tasks.push_back(engine::AsyncNoSpan([&ping, &pong] {
+        for (std::size_t i = 0; i < kIterations; ++i) {
+          ASSERT_TRUE(pong.WaitForEventFor(utest::kMaxTestWaitTime));
+          ping.Send();
+        }
+      }));
+    }
+
+    for (auto& task : tasks) task.Get();
+  });
+}
+
+TEST(WorkStealingTaskQueue, ScheduleFromForeignThreads) {
+  RunWorkStealing(3, [] {
+    std::atomic<std::size_t> received{0};
+    engine::SingleConsumerEvent event;
+
+    auto consumer = engine::AsyncNoSpan([&] {
+      while (received < kThreads * kEventsPerThread) {
+        ASSERT_TRUE(event.WaitForEventFor(utest::kMaxTestWaitTime));
+      }
+    });
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < kThreads; ++i) {
+      threads.emplace_back([&] {
+        for (std::size_t j = 0; j < kEventsPerThread; ++j) {
+          ++received;
+          event.Send();
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+
+    consumer.Get();
+  });
+}
+
+TEST(WorkStealingTaskQueue, BusyWorkerGetsRobbed) {
+  RunWorkStealing(2, [] {
+    std::atomic<std::size_t> finished{0};
+
+    // The current worker is busy and does not yield, so the tasks could only
+    // be executed by a sibling that steals them.
+    auto first = engine::AsyncNoSpan([&] { ++finished; });
+    auto second = engine::AsyncNoSpan([&] { ++finished; });
+
+    const auto deadline =
+        engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+    while (finished != 2 && !deadline.IsReached()) {
+      std::this_thread::yield();
+    }
+    EXPECT_EQ(finished.load(), 2);
+    first.Get();
+    second.Get();
+  });
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,95 @@
+#include <engine/task/worker_autoscaler.hpp>
+
+#include <algorithm>
+#include <charconv>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+std::optional<std::uint64_t> FindCounter(std::string_view contents,
+                                         std::string_view name) {
+  while (!contents.empty()) {
+    const auto line_end = contents.find('\n');
+    auto line = contents.substr(0, line_end);
+    contents.remove_prefix(line_end == std::string_view::npos ? contents.size()
+                                                              : line_end + 1);
+
+    if (line.size() <= name.size() || line.substr(0, name.size()) != name ||
+        line[name.size()] != ' ') {
+      continue;
+    }
+    line.remove_prefix(name.size() + 1);
+
+    std::uint64_t value = 0;
+    const auto [ptr, ec] =
+        std::from_chars(line.data(), line.data() + line.size(), value);
+    if (ec != std::errc{}) return std::nullopt;
+    return value;
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+std::optional<CgroupCpuStat> ParseCgroupCpuStat(std::string_view contents) {
+  const auto periods = FindCounter(contents, "nr_periods");
+  const auto throttled_periods = FindCounter(contents, "nr_throttled");
+  if (!periods || !throttled_periods) return std::nullopt;
+  return CgroupCpuStat{*periods, *throttled_periods};
+}
+
+double GetThrottledRatio(const CgroupCpuStat& previous,
+                         const CgroupCpuStat& current) noexcept {
+  if (current.periods <= previous.periods ||
+      current.throttled_periods < previous.throttled_periods) {
+    return 0.0;
+  }
+  return static_cast<double>(current.throttled_periods -
+                             previous.throttled_periods) /
+         static_cast<double>(current.periods - previous.periods);
+}
+
+WorkerAutoscaler::WorkerAutoscaler(std::size_t min_workers,
+                                   std::size_t max_workers,
+                                   const WorkerAutoscalerSettings& settings)
+    : min_workers_(std::clamp<std::size_t>(min_workers, 1, max_workers)),
+      max_workers_(max_workers),
+      settings_(settings),
+      active_workers_(max_workers) {
+  UINVARIANT(max_workers_ > 0, "Autoscaling requires workers");
+}
+
+std::size_t WorkerAutoscaler::Update(const Sample& sample) noexcept {
+  if (sample.throttled_ratio > settings_.max_throttled_ratio) {
+    scale_up_votes_ = 0;
+    if (active_workers_ > min_workers_) ++scale_down_votes_;
+  } else if (sample.queue_wait >= settings_.queue_wait_threshold &&
+             sample.throttled_ratio <= settings_.max_throttled_ratio / 2) {
+    scale_down_votes_ = 0;
+    if (active_workers_ < max_workers_) ++scale_up_votes_;
+  } else {
+    // Within the hysteresis band, keep the current count
+    scale_up_votes_ = 0;
+    scale_down_votes_ = 0;
+  }
+
+  const auto required_votes =
+      std::max<std::size_t>(settings_.hysteresis_samples, 1);
+  if (scale_down_votes_ >= required_votes) {
+    --active_workers_;
+    scale_down_votes_ = 0;
+  } else if (scale_up_votes_ >= required_votes) {
+    ++active_workers_;
+    scale_up_votes_ = 0;
+  }
+  return active_workers_;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+/// CFS bandwidth control counters from the `cpu.stat` file of a cgroup
+struct CgroupCpuStat final {
+  std::uint64_t periods{0};
+  std::uint64_t throttled_periods{0};
+};
+
+/// Parses `nr_periods` and `nr_throttled` from the `cpu.stat` of cgroup v1
+/// or v2, returns std::nullopt if the CPU quota accounting is not available
+std::optional<CgroupCpuStat> ParseCgroupCpuStat(std::string_view contents);
+
+/// Share of the throttled CFS periods between the two samples, 0 if no period
+/// has passed
+double GetThrottledRatio(const CgroupCpuStat& previous,
+                         const CgroupCpuStat& current) noexcept;
+
+struct WorkerAutoscalerSettings final {
+  // Workers are parked if more periods than this are throttled
+  double max_throttled_ratio{0.01};
+
+  // Workers are unparked if the tasks wait in the queue longer than this and
+  // there is more than a half of max_throttled_ratio left
+  std::chrono::microseconds queue_wait_threshold{1000};
+
+  // Number of consecutive samples voting for the same change of the active
+  // workers count before the change happens
+  std::size_t hysteresis_samples{3};
+};
+
+/// Decides on the number of active workers of a TaskProcessor. Each change is
+/// a single worker and requires a few samples in a row voting for it, so short
+/// spikes of throttling or of the queue wait time are ignored.
+class WorkerAutoscaler final {
+ public:
+  struct Sample final {
+    double throttled_ratio{0.0};
+    std::chrono::microseconds queue_wait{0};
+  };
+
+  WorkerAutoscaler(std::size_t min_workers, std::size_t max_workers,
+                   const WorkerAutoscalerSettings& settings);
+
+  /// @returns the new number of the active workers
+  std::size_t Update(const Sample& sample) noexcept;
+
+  std::size_t GetActiveWorkers() const noexcept { return active_workers_; }
+
+ private:
+  const std::size_t min_workers_;
+  const std::size_t max_workers_;
+  const WorkerAutoscalerSettings settings_;
+
+  std::size_t active_workers_;
+  std::size_t scale_up_votes_{0};
+  std::size_t scale_down_votes_{0};
+};
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
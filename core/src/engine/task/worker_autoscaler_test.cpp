@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include <engine/impl/standalone.hpp>
+#include <engine/task/task_processor.hpp>
+#include <engine/task/worker_autoscaler.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using engine::impl::WorkerAutoscaler;
+
+constexpr WorkerAutoscaler::Sample kThrottled{0.05, 0us};
+constexpr WorkerAutoscaler::Sample kQueueing{0.0, 10ms};
+constexpr WorkerAutoscaler::Sample kCalm{0.0, 10us};
+
+constexpr std::size_t kTasks = 1000;
+
+engine::impl::WorkerAutoscalerSettings MakeSettings() {
+  engine::impl::WorkerAutoscalerSettings settings;
+  settings.max_throttled_ratio = 0.01;
+  settings.queue_wait_threshold = 1ms;
+  settings.hysteresis_samples = 3;
+  return settings;
+}
+
+}  // namespace
+
+TEST(CgroupCpuStat, ParseV2) {
+  constexpr std::string_view kContents =
+      "usage_usec 53295951\n"
+      "user_usec 40287251\n"
+      "system_usec 13008700\n"
+      "nr_periods 1200\n"
+      "nr_throttled 17\n"
+      "throttled_usec 309106\n";
+  const auto stat = engine::impl::ParseCgroupCpuStat(kContents);
+  ASSERT_TRUE(stat);
+  EXPECT_EQ(stat->periods, 1200);
+  EXPECT_EQ(stat->throttled_periods, 17);
+}
+
+TEST(CgroupCpuStat, ParseV1) {
+  constexpr std::string_view kContents =
+      "nr_periods 42\nnr_throttled 0\nthrottled_time 0";
+  const auto stat = engine::impl::ParseCgroupCpuStat(kContents);
+  ASSERT_TRUE(stat);
+  EXPECT_EQ(stat->periods, 42);
+  EXPECT_EQ(stat->throttled_periods, 0);
+}
+
+TEST(CgroupCpuStat, NoQuota) {
+  EXPECT_FALSE(engine::impl::ParseCgroupCpuStat(
+      "usage_usec 1\nuser_usec 1\nsystem_usec 0\n"));
+  EXPECT_FALSE(
+      engine::impl::ParseCgroupCpuStat("nr_periods x\nnr_throttled 1"));
+}
+
+TEST(CgroupCpuStat, ThrottledRatio) {
+  EXPECT_DOUBLE_EQ(engine::impl::GetThrottledRatio({100, 1}, {200, 11}), 0.1);
+  EXPECT_DOUBLE_EQ(engine::impl::GetThrottledRatio({100, 1}, {100, 1}), 0.0);
+}
+
+TEST(WorkerAutoscaler, ParksOnThrottling) {
+  WorkerAutoscaler autoscaler(2, 4, MakeSettings());
+  EXPECT_EQ(autoscaler.GetActiveWorkers(), 4);
+
+  EXPECT_EQ(autoscaler.Update(kThrottled), 4);
+  EXPECT_EQ(autoscaler.Update(kThrottled), 4);
+  EXPECT_EQ(autoscaler.Update(kThrottled), 3);
+  for (int i = 0; i < 10; ++i) autoscaler.Update(kThrottled);
+  EXPECT_EQ(autoscaler.GetActiveWorkers(), 2);
+}
+
+TEST(WorkerAutoscaler, UnparksOnQueueWait) {
+  WorkerAutoscaler autoscaler(1, 3, MakeSettings());
+  for (int i = 0; i < 6; ++i) autoscaler.Update(kThrottled);
+  ASSERT_EQ(autoscaler.GetActiveWorkers(), 1);
+
+  EXPECT_EQ(autoscaler.Update(kQueueing), 1);
+  EXPECT_EQ(autoscaler.Update(kQueueing), 1);
+  EXPECT_EQ(autoscaler.Update(kQueueing), 2);
+  for (int i = 0; i < 10; ++i) autoscaler.Update(kQueueing);
+  EXPECT_EQ(autoscaler.GetActiveWorkers(), 3);
+}
+
+TEST(WorkerAutoscaler, Hysteresis) {
+  WorkerAutoscaler autoscaler(1, 4, MakeSettings());
+  for (int i = 0; i < 10; ++i) {
+    autoscaler.Update(kThrottled);
+    autoscaler.Update(kThrottled);
+    autoscaler.Update(kCalm);
+  }
+  EXPECT_EQ(autoscaler.GetActiveWorkers(), 4);
+
+  // Queueing near the throttling limit does not unpark the workers
+  for (int i = 0; i < 3; ++i) autoscaler.Update(kThrottled);
+  ASSERT_EQ(autoscaler.GetActiveWorkers(), 3);
+  for (int i = 0; i < 10; ++i) autoscaler.Update({0.008, 10ms});
+  EXPECT_EQ(autoscaler.GetActiveWorkers(), 3);
+}
+
+TEST(TaskProcessor, ParkedWorkers) {
+  auto task_processor = engine::impl::TaskProcessorHolder::Make(
+      4, "autoscaled", engine::impl::MakeTaskProcessorPools({}),
+      engine::TaskQueueType::kGlobalTaskQueue);
+  EXPECT_EQ(task_processor->GetActiveWorkerCount(), 4);
+
+  task_processor->SetActiveWorkerCount(0);
+  EXPECT_EQ(task_processor->GetActiveWorkerCount(), 1);
+
+  engine::impl::RunOnTaskProcessorSync(*task_processor, [] {
+    std::atomic<std::size_t> counter{0};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(kTasks);
+    for (std::size_t i = 0; i < kTasks; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&counter] { ++counter; }));
+    }
+    for (auto& task : tasks) task.Get();
+    EXPECT_EQ(counter.load(), kTasks);
+  });
+
+  task_processor->SetActiveWorkerCount(100);
+  EXPECT_EQ(task_processor->GetActiveWorkerCount(), 4);
+
+  // The parked workers must not block the task processor destruction
+  task_processor->SetActiveWorkerCount(2);
+}
+
+TEST(TaskProcessor, ParkedWorkersWorkStealing) {
+  auto task_processor = engine::impl::TaskProcessorHolder::Make(
+      4, "autoscaled", engine::impl::MakeTaskProcessorPools({}),
+      engine::TaskQueueType::kWorkStealingTaskQueue);
+
+  // The tasks are spawned into the local queue of a worker that is parked
+  // right after the current step, repeated to hit a non-zero worker
+  for (int i = 0; i < 10; ++i) {
+    task_processor->SetActiveWorkerCount(4);
+    engine::impl::RunOnTaskProcessorSync(*task_processor, [&task_processor] {
+      task_processor->SetActiveWorkerCount(1);
+
+      std::atomic<std::size_t> counter{0};
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(kTasks);
+      for (std::size_t j = 0; j < kTasks; ++j) {
+        tasks.push_back(engine::AsyncNoSpan([&counter] { ++counter; }));
+      }
+      for (auto& task : tasks) task.Get();
+      EXPECT_EQ(counter.load(), kTasks);
+    });
+  }
+}
+
+USERVER_NAMESPACE_END
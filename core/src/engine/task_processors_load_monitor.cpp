@@ -1,7 +1,14 @@
 #include <userver/engine/task_processors_load_monitor.hpp>
 
+#include <array>
+#include <optional>
+
 #include <userver/components/component_context.hpp>
 #include <userver/components/statistics_storage.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/fs/read.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/server/handlers/server_monitor.hpp>
 #include <userver/utils/enumerate.hpp>
 #include <userver/utils/fixed_array.hpp>
@@ -12,6 +19,7 @@
 #include <components/manager.hpp>
 #include <components/manager_config.hpp>
 #include <engine/task/task_processor.hpp>
+#include <engine/task/worker_autoscaler.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -47,6 +55,29 @@ TaskProcessor* GetMonitorTaskProcessor(
   return nullptr;
 }
 
+// cgroup v2 first, then the usual cgroup v1 mount points
+constexpr std::array<std::string_view, 3> kCgroupCpuStatPaths{
+    "/sys/fs/cgroup/cpu.stat",
+    "/sys/fs/cgroup/cpu/cpu.stat",
+    "/sys/fs/cgroup/cpu,cpuacct/cpu.stat",
+};
+
+impl::WorkerAutoscalerSettings ParseAutoscalerSettings(
+    const components::ComponentConfig& config) {
+  impl::WorkerAutoscalerSettings settings;
+  settings.max_throttled_ratio =
+      config["autoscale-max-throttled-ratio"].As<double>(
+          settings.max_throttled_ratio);
+  settings.queue_wait_threshold =
+      config["autoscale-queue-wait-threshold"].As<std::chrono::milliseconds>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              settings.queue_wait_threshold));
+  settings.hysteresis_samples =
+      config["autoscale-hysteresis-samples"].As<std::size_t>(
+          settings.hysteresis_samples);
+  return settings;
+}
+
 }  // namespace
 
 class TaskProcessorsLoadMonitor::Impl final {
@@ -89,15 +120,19 @@ class TaskProcessorsLoadMonitor::Impl final {
     statistics_holder_ = storage.RegisterWriter(
         "engine.task-processors-load-percent",
         [this](utils::statistics::Writer& writer) { ExtendWriter(writer); });
+
+    StartAutoscaling(config, context, *monitor_task_processor);
   }
 
   ~Impl() {
     statistics_holder_.Unregister();
+    autoscaler_.Stop();
     collector_.Stop();
   }
 
  private:
   static constexpr std::chrono::seconds kCollectInterval{5};
+  static constexpr std::chrono::milliseconds kDefaultAutoscaleInterval{1000};
 
   struct TaskProcessorMeta final {
     using LoadValue = utils::statistics::RelaxedCounter<std::uint8_t>;
@@ -106,6 +141,115 @@ class TaskProcessorsLoadMonitor::Impl final {
     utils::FixedArray<LoadValue> current_load;
   };
 
+  struct AutoscaledTaskProcessor final {
+    TaskProcessor& task_processor;
+    impl::WorkerAutoscaler autoscaler;
+
+    // A trivial task that measures the time it spent in the task queue
+    engine::TaskWithResult<std::chrono::microseconds> queue_wait_probe{};
+    std::chrono::steady_clock::time_point probe_started{};
+  };
+
+  void StartAutoscaling(const components::ComponentConfig& config,
+                        const components::ComponentContext& context,
+                        TaskProcessor& monitor_task_processor) {
+    const auto settings = ParseAutoscalerSettings(config);
+    const auto& manager = context.GetManager();
+    const auto& task_processors_map = manager.GetTaskProcessorsMap();
+    for (const auto& tp_config : manager.GetConfig().task_processors) {
+      if (!tp_config.should_autoscale) continue;
+      auto& tp = *task_processors_map.at(tp_config.name);
+      autoscaled_.push_back(
+          {tp, impl::WorkerAutoscaler{tp_config.min_worker_threads,
+                                      tp.GetWorkerCount(), settings}});
+    }
+    if (autoscaled_.empty()) return;
+
+    fs_task_processor_ = &context.GetTaskProcessor(
+        config["fs-task-processor"].As<std::string>("fs-task-processor"));
+
+    utils::PeriodicTask::Settings periodic_settings{
+        config["autoscale-interval"].As<std::chrono::milliseconds>(
+            kDefaultAutoscaleInterval)};
+    periodic_settings.task_processor = &monitor_task_processor;
+    autoscaler_.Start("task-processors-autoscaler", periodic_settings,
+                      [this] { Autoscale(); });
+  }
+
+  void Autoscale() {
+    double throttled_ratio = 0.0;
+    if (auto stat = ReadCgroupCpuStat()) {
+      if (cgroup_cpu_stat_) {
+        throttled_ratio = impl::GetThrottledRatio(*cgroup_cpu_stat_, *stat);
+      }
+      cgroup_cpu_stat_ = *stat;
+    }
+
+    for (auto& tp_meta : autoscaled_) {
+      const auto active_workers = tp_meta.autoscaler.Update(
+          {throttled_ratio, MeasureQueueWait(tp_meta)});
+      tp_meta.task_processor.SetActiveWorkerCount(active_workers);
+    }
+  }
+
+  std::optional<impl::CgroupCpuStat> ReadCgroupCpuStat() {
+    if (!cgroup_cpu_stat_path_) {
+      cgroup_cpu_stat_path_.emplace();
+      for (const auto path : kCgroupCpuStatPaths) {
+        if (TryReadCgroupCpuStat(path)) {
+          cgroup_cpu_stat_path_->assign(path);
+          break;
+        }
+      }
+      if (cgroup_cpu_stat_path_->empty()) {
+        LOG_WARNING() << "No cgroup CPU quota accounting is found, the "
+                         "task processors are autoscaled by the task queue "
+                         "wait time only";
+      }
+    }
+
+    if (cgroup_cpu_stat_path_->empty()) return std::nullopt;
+    return TryReadCgroupCpuStat(*cgroup_cpu_stat_path_);
+  }
+
+  std::optional<impl::CgroupCpuStat> TryReadCgroupCpuStat(
+      std::string_view path) {
+    try {
+      return impl::ParseCgroupCpuStat(
+          fs::ReadFileContents(*fs_task_processor_, std::string{path}));
+    } catch (const std::exception& e) {
+      LOG_DEBUG() << "Failed to read '" << path << "': " << e;
+      return std::nullopt;
+    }
+  }
+
+  static std::chrono::microseconds MeasureQueueWait(
+      AutoscaledTaskProcessor& tp_meta) {
+    const auto now = std::chrono::steady_clock::now();
+    auto& probe = tp_meta.queue_wait_probe;
+
+    std::chrono::microseconds queue_wait{0};
+    if (probe.IsValid()) {
+      if (!probe.IsFinished()) {
+        // The previous probe is still in the queue
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            now - tp_meta.probe_started);
+      }
+      try {
+        queue_wait = probe.Get();
+      } catch (const std::exception& e) {
+        LOG_DEBUG() << "Queue wait probe failed: " << e;
+      }
+    }
+
+    tp_meta.probe_started = now;
+    probe = engine::CriticalAsyncNoSpan(tp_meta.task_processor, [now] {
+      return std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - now);
+    });
+    return queue_wait;
+  }
+
   void CollectCurrentLoad() noexcept {
     for (auto& tp_meta : task_processors_) {
       const auto current_load = tp_meta.task_processor.CollectCurrentLoadPct();
@@ -135,8 +279,14 @@ class TaskProcessorsLoadMonitor::Impl final {
 
   std::vector<TaskProcessorMeta> task_processors_;
 
+  std::vector<AutoscaledTaskProcessor> autoscaled_;
+  TaskProcessor* fs_task_processor_{nullptr};
+  std::optional<std::string> cgroup_cpu_stat_path_;
+  std::optional<impl::CgroupCpuStat> cgroup_cpu_stat_;
+
   utils::statistics::Entry statistics_holder_;
   utils::PeriodicTask collector_;
+  utils::PeriodicTask autoscaler_;
 };
 
 TaskProcessorsLoadMonitor::TaskProcessorsLoadMonitor(
@@ -158,6 +308,35 @@ properties:
         description: name of the TaskProcessor to run monitoring on
         defaultDescription: |
           task_processor of ServerMonitor or none, if ServerMonitor is absent
+    fs-task-processor:
+        type: string
+        description: |
+            task processor to read the cgroup CPU stats on, used only if some
+            task processor has the `autoscale` option enabled
+        defaultDescription: fs-task-processor
+    autoscale-interval:
+        type: string
+        description: how often the autoscaled task processors are tuned
+        defaultDescription: 1s
+    autoscale-max-throttled-ratio:
+        type: number
+        description: |
+            workers are parked if a bigger share of the CFS periods is
+            throttled
+        defaultDescription: 0.01
+    autoscale-queue-wait-threshold:
+        type: string
+        description: |
+            workers are unparked if the tasks wait in the queue longer and
+            the throttling is below a half of autoscale-max-throttled-ratio
+        defaultDescription: 1ms
+    autoscale-hysteresis-samples:
+        type: integer
+        description: |
+            number of consecutive samples voting for a change of the active
+            workers count before the change happens
+        defaultDescription: 3
+        minimum: 1
 )");
 }
 
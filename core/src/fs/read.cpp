@@ -1,8 +1,13 @@
 #include <userver/fs/read.hpp>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/fs/blocking/mapped_file.hpp>
 #include <userver/fs/blocking/read.hpp>
-#include <userver/utils/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -10,12 +15,42 @@ namespace fs {
 
 namespace {
 
+// Small files are read in batches to avoid a task switch per file
+constexpr std::size_t kFilesPerTask = 16;
+
 bool IsHiddenFile(const boost::filesystem::path& path) {
   auto name = path.filename().native();
   UASSERT(!name.empty());
   return name != ".." && name != "." && name[0] == '.';
 }
 
+FileInfoWithData ReadFileInfoWithDataBlocking(
+    const std::string& path, std::optional<std::size_t> mmap_min_size) {
+  FileInfoWithData info{};
+  info.extension = boost::filesystem::path(path).extension().string();
+  if (mmap_min_size && boost::filesystem::file_size(path) >= *mmap_min_size) {
+    info.mapped_file = std::make_shared<const blocking::MappedFile>(
+        blocking::MappedFile::Open(path));
+  } else {
+    info.data = blocking::ReadFileContents(path);
+  }
+  return info;
+}
+
+std::vector<std::string> ListFilesBlocking(
+    const std::string& path, utils::Flags<SettingsReadFile> flags) {
+  std::vector<std::string> files;
+  for (boost::filesystem::recursive_directory_iterator it(path), end;
+       it != end; ++it) {
+    // only files
+    if (it->status().type() != boost::filesystem::regular_file) continue;
+    if ((flags & SettingsReadFile::kSkipHidden) && IsHiddenFile(it->path()))
+      continue;
+    files.push_back(it->path().string());
+  }
+  return files;
+}
+
 }  // namespace
 
 std::string GetLexicallyRelative(std::string_view path, std::string_view dir) {
@@ -31,28 +66,45 @@ std::string ReadFileContents(engine::TaskProcessor& async_tp,
       .Get();
 }
 
+FileInfoWithData ReadFileInfoWithData(
+    engine::TaskProcessor& async_tp, const std::string& path,
+    std::optional<std::size_t> mmap_min_size) {
+  return engine::AsyncNoSpan(async_tp, &ReadFileInfoWithDataBlocking, path,
+                             mmap_min_size)
+      .Get();
+}
+
 FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     engine::TaskProcessor& async_tp, const std::string& path,
-    utils::Flags<SettingsReadFile> flags) {
+    utils::Flags<SettingsReadFile> flags,
+    std::optional<std::size_t> mmap_min_size) {
+  const auto files =
+      engine::AsyncNoSpan(async_tp, &ListFilesBlocking, path, flags).Get();
+
+  using Batch = std::vector<std::pair<std::string, FileInfoWithDataConstPtr>>;
+  std::vector<engine::TaskWithResult<Batch>> tasks;
+  tasks.reserve((files.size() + kFilesPerTask - 1) / kFilesPerTask);
+  for (std::size_t begin = 0; begin < files.size(); begin += kFilesPerTask) {
+    const auto end = std::min(begin + kFilesPerTask, files.size());
+    tasks.push_back(engine::AsyncNoSpan(async_tp, [&, begin, end] {
+      Batch batch;
+      batch.reserve(end - begin);
+      for (auto i = begin; i < end; ++i) {
+        batch.emplace_back(
+            GetLexicallyRelative(files[i], path),
+            std::make_shared<const FileInfoWithData>(
+                ReadFileInfoWithDataBlocking(files[i], mmap_min_size)));
+      }
+      return batch;
+    }));
+  }
+
   FileInfoWithDataMap data{};
-  for (auto it =
-           utils::Async(
-               async_tp, "init",
-               [&path] {
-                 return boost::filesystem::recursive_directory_iterator(path);
-               })
-               .Get();
-       it != boost::filesystem::recursive_directory_iterator();
-       utils::Async(async_tp, "next", [&it] { ++it; }).Get()) {
-    // only files
-    if (it->status().type() != boost::filesystem::regular_file) continue;
-    if ((flags & SettingsReadFile::kSkipHidden) && IsHiddenFile(it->path()))
-      continue;
-    FileInfoWithData info{};
-    info.extension = it->path().extension().string();
-    info.data = ReadFileContents(async_tp, it->path().string());
-    data[GetLexicallyRelative(it->path().string(), path)] =
-        std::make_shared<const FileInfoWithData>(std::move(info));
+  data.reserve(files.size());
+  for (auto& task : tasks) {
+    for (auto& [relative_path, info] : task.Get()) {
+      data.emplace(std::move(relative_path), std::move(info));
+    }
   }
   return data;
 }
@@ -0,0 +1,38 @@
+#include <userver/fs/read.hpp>
+
+#include <cstdint>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+void fs_read_recursive_files(benchmark::State& state) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto& root = dir.GetPath();
+  const std::string contents(state.range(1), 'x');
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    fs::blocking::RewriteFileContents(fmt::format("{}/file{}", root, i),
+                                      contents);
+  }
+
+  engine::RunStandalone(4, [&] {
+    auto& async_tp = engine::current_task::GetTaskProcessor();
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(
+          fs::ReadRecursiveFilesInfoWithData(async_tp, root));
+    }
+  });
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(fs_read_recursive_files)
+    ->Ranges({{8, 1024}, {64, 4096}})
+    ->Unit(benchmark::kMicrosecond);
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,10 @@
-#include <gtest/gtest.h>
+#include <userver/utest/utest.hpp>
 
+#include <fmt/format.h>
+
+#include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/fs/read.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -9,4 +14,28 @@ TEST(Fs, GetLexicallyRelative) {
   EXPECT_EQ(fs::GetLexicallyRelative("/path/to/file", "/path"), "/to/file");
 }
 
+UTEST_MT(AsyncFs, ReadRecursiveFilesInfoWithData, 4) {
+  constexpr std::size_t kFilesCount = 50;
+
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto& root = dir.GetPath();
+  fs::blocking::CreateDirectories(root + "/nested");
+  for (std::size_t i = 0; i < kFilesCount; ++i) {
+    fs::blocking::RewriteFileContents(
+        fmt::format("{}/nested/file{}.txt", root, i), std::to_string(i));
+  }
+  fs::blocking::RewriteFileContents(root + "/.hidden", "hidden");
+
+  auto& async_tp = engine::current_task::GetTaskProcessor();
+  const auto files = fs::ReadRecursiveFilesInfoWithData(async_tp, root);
+
+  ASSERT_EQ(files.size(), kFilesCount);
+  for (std::size_t i = 0; i < kFilesCount; ++i) {
+    const auto it = files.find(fmt::format("/nested/file{}.txt", i));
+    ASSERT_NE(it, files.end());
+    EXPECT_EQ(it->second->GetContents(), std::to_string(i));
+    EXPECT_EQ(it->second->extension, ".txt");
+  }
+}
+
 USERVER_NAMESPACE_END
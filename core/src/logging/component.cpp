@@ -267,6 +267,10 @@ properties:
                     enum:
                       - discard
                       - block
+                deferred_formatting:
+                    type: boolean
+                    description: escape and format the log records on the logger task processor instead of the logging task
+                    defaultDescription: false
                 fs-task-processor:
                     type: string
                     description: task processor for disk I/O operations for this logger
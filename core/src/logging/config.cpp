@@ -52,6 +52,9 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
       value["overflow_behavior"].As<QueueOverflowBehavior>(
           config.queue_overflow_behavior);
 
+  config.deferred_formatting =
+      value["deferred_formatting"].As<bool>(config.deferred_formatting);
+
   config.fs_task_processor =
       value["fs-task-processor"].As<std::optional<std::string>>();
 
@@ -41,6 +41,8 @@ struct LoggerConfig final {
   QueueOverflowBehavior queue_overflow_behavior =
       QueueOverflowBehavior::kDiscard;
 
+  bool deferred_formatting = false;
+
   std::optional<std::string> fs_task_processor;
 
   std::optional<TestsuiteCaptureConfig> testsuite_capture;
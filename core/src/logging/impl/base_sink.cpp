@@ -14,6 +14,23 @@ void BaseSink::Log(const LogMessage& message) {
   }
 }
 
+void BaseSink::LogBatch(utils::span<const LogMessage> messages) {
+  const auto* batch_begin = messages.begin();
+  for (const auto* it = messages.begin(); it != messages.end(); ++it) {
+    if (!ShouldLog(it->level)) {
+      if (batch_begin != it) WriteBatch({batch_begin, it});
+      batch_begin = it + 1;
+    }
+  }
+  if (batch_begin != messages.end()) WriteBatch({batch_begin, messages.end()});
+}
+
+void BaseSink::WriteBatch(utils::span<const LogMessage> messages) {
+  for (const auto& message : messages) {
+    Write(message.payload);
+  }
+}
+
 void BaseSink::Flush() {}
 
 void BaseSink::Reopen(ReopenMode) {}
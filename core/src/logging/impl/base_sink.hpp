@@ -4,6 +4,7 @@
 
 #include <logging/impl/reopen_mode.hpp>
 #include <userver/logging/level.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -22,6 +23,9 @@ class BaseSink {
 
   void Log(const LogMessage& message);
 
+  /// Writes the messages that pass the level of the sink, preserving order
+  void LogBatch(utils::span<const LogMessage> messages);
+
   virtual void Flush();
 
   virtual void Reopen(ReopenMode);
@@ -35,6 +39,10 @@ class BaseSink {
 
   virtual void Write(std::string_view log) = 0;
 
+  /// Writes all the messages, by default one by one. Sinks that do a syscall
+  /// per Write should override it to write the batch at once.
+  virtual void WriteBatch(utils::span<const LogMessage> messages);
+
  private:
   std::atomic<Level> level_{Level::kTrace};
 };
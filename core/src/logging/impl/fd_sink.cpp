@@ -1,13 +1,63 @@
 #include "fd_sink.hpp"
 
+#include <sys/uio.h>
+
+#include <array>
+#include <cerrno>
+#include <system_error>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+constexpr std::size_t kMaxIovecs = 64;
+
+void WriteAll(int fd, ::iovec* iov, std::size_t count) {
+  while (count > 0) {
+    const ::ssize_t s = ::writev(fd, iov, static_cast<int>(count));
+    if (s < 0) {
+      if (errno == EAGAIN || errno == EINTR) continue;
+
+      const auto code = std::make_error_code(std::errc{errno});
+      throw std::system_error(code, "calling ::writev");
+    }
+
+    auto written = static_cast<std::size_t>(s);
+    while (count > 0 && written >= iov->iov_len) {
+      written -= iov->iov_len;
+      ++iov;
+      --count;
+    }
+    if (count > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+      iov->iov_len -= written;
+    }
+  }
+}
+
+}  // namespace
+
 FdSink::FdSink(fs::blocking::FileDescriptor fd) : fd_{std::move(fd)} {}
 
 void FdSink::Write(std::string_view log) { fd_.Write(log); }
 
+void FdSink::WriteBatch(utils::span<const LogMessage> messages) {
+  std::array<::iovec, kMaxIovecs> iov{};
+  const auto* it = messages.begin();
+  while (it != messages.end()) {
+    std::size_t count = 0;
+    for (; it != messages.end() && count < iov.size(); ++it) {
+      if (it->payload.empty()) continue;
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      iov[count++] = {const_cast<char*>(it->payload.data()),
+                      it->payload.size()};
+    }
+    WriteAll(fd_.GetNative(), iov.data(), count);
+  }
+}
+
 void FdSink::Flush() {
   if (fd_.IsOpen()) {
     fd_.FSync();
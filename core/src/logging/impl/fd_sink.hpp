@@ -21,6 +21,8 @@ class FdSink : public BaseSink {
  protected:
   void Write(std::string_view log) final;
 
+  void WriteBatch(utils::span<const LogMessage> messages) final;
+
   fs::blocking::FileDescriptor& GetFd();
 
   void SetFd(fs::blocking::FileDescriptor&& fd);
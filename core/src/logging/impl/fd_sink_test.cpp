@@ -43,6 +43,31 @@ UTEST(FdSink, PipeSinkLog) {
   read_task.Get();
 }
 
+UTEST(FdSink, UnownedSinkLogBatch) {
+  const auto file_scope = fs::blocking::TempFile::Create();
+
+  {
+    auto fd = fs::blocking::FileDescriptor::Open(
+        file_scope.GetPath(), fs::blocking::OpenFlag::kWrite);
+
+    auto sink = logging::impl::UnownedFdSink(fd.GetNative());
+    sink.SetLevel(logging::Level::kInfo);
+
+    std::vector<logging::impl::LogMessage> messages;
+    for (int i = 0; i < 100; ++i) {
+      messages.push_back({"message\n", logging::Level::kWarning});
+    }
+    messages.push_back({"skipped\n", logging::Level::kDebug});
+    messages.push_back({"last\n", logging::Level::kError});
+    EXPECT_NO_THROW(sink.LogBatch(messages));
+  }
+
+  std::string expected;
+  for (int i = 0; i < 100; ++i) expected += "message\n";
+  expected += "last\n";
+  EXPECT_EQ(fs::blocking::ReadFileContents(file_scope.GetPath()), expected);
+}
+
 UTEST(FdSink, PipeSinkLogStringView) {
   engine::io::Pipe fd_pipe{};
 
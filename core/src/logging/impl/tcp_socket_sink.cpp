@@ -6,6 +6,7 @@
 #include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <array>
 #include <cstring>
 
 USERVER_NAMESPACE_BEGIN
@@ -47,6 +48,19 @@ void TcpSocketClient::Send(const char* data, size_t n_bytes) {
   }
 }
 
+void TcpSocketClient::Send(const engine::io::IoData* list,
+                           std::size_t list_size) {
+  std::size_t n_bytes = 0;
+  for (std::size_t i = 0; i < list_size; ++i) n_bytes += list[i].len;
+
+  auto send_result = socket_.SendAll(list, list_size, {});
+  if (n_bytes != send_result) {
+    throw std::runtime_error(fmt::format(
+        "Failed to send {} bytes because the remote closed the connection",
+        n_bytes));
+  }
+}
+
 void TcpSocketClient::Close() { socket_.Close(); }
 
 bool TcpSocketClient::IsConnected() { return socket_.Fd() != -1; }
@@ -69,6 +83,25 @@ void TcpSocketSink::Write(std::string_view log) {
   client_.Send(log.data(), log.size());
 }
 
+void TcpSocketSink::WriteBatch(utils::span<const LogMessage> messages) {
+  constexpr std::size_t kMaxIoData = 64;
+  std::array<engine::io::IoData, kMaxIoData> list{};
+
+  const std::lock_guard lock{mutex_};
+  if (!client_.IsConnected()) {
+    client_.Connect();
+  }
+
+  const auto* it = messages.begin();
+  while (it != messages.end()) {
+    std::size_t count = 0;
+    for (; it != messages.end() && count < list.size(); ++it) {
+      list[count++] = {it->payload.data(), it->payload.size()};
+    }
+    client_.Send(list.data(), count);
+  }
+}
+
 }  // namespace logging::impl
 
 USERVER_NAMESPACE_END
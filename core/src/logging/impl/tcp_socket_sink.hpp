@@ -24,6 +24,7 @@ class TcpSocketClient final {
 
   void Connect();
   void Send(const char* data, size_t n_bytes);
+  void Send(const engine::io::IoData* list, std::size_t list_size);
   bool IsConnected();
   void Close();
 
@@ -45,6 +46,8 @@ class TcpSocketSink final : public BaseSink {
  protected:
   void Write(std::string_view log) final;
 
+  void WriteBatch(utils::span<const LogMessage> messages) final;
+
  private:
   std::mutex mutex_;
   impl::TcpSocketClient client_;
@@ -1,9 +1,13 @@
 #include "unix_socket_sink.hpp"
 
+#include <fcntl.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <iostream>
 
 #include <utils/check_syscall.hpp>
@@ -13,37 +17,58 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+constexpr int kSendFlags =
+// MAC_COMPAT: does not support MSG_NOSIGNAL
+#ifdef MSG_NOSIGNAL
+    MSG_NOSIGNAL |
+#endif
+    0;
+
+}  // namespace
+
 void UnixSocketClient::connect(std::string_view filename) {
+  close();
+
   struct sockaddr_un addr {};
   addr.sun_family = AF_UNIX;
-  std::strncpy(addr.sun_path, filename.data(), filename.size());
+  std::strncpy(addr.sun_path, filename.data(),
+               std::min(filename.size(), sizeof(addr.sun_path) - 1));
 
   socket_ =
       utils::CheckSyscall(::socket(AF_UNIX, SOCK_STREAM, 0), "create socket");
 
-  utils::CheckSyscall(
-      ::connect(socket_, reinterpret_cast<const struct sockaddr*>(&addr),
-                sizeof(addr)),
-      "connect to server by unix-socket");
+  try {
+    utils::CheckSyscall(
+        ::connect(socket_, reinterpret_cast<const struct sockaddr*>(&addr),
+                  sizeof(addr)),
+        "connect to server by unix-socket");
+    utils::CheckSyscall(::fcntl(socket_, F_SETFL, O_NONBLOCK),
+                        "set non-blocking mode of socket");
+  } catch (const std::exception&) {
+    close();
+    throw;
+  }
 }
 
-void UnixSocketClient::send(std::string_view message) {
+std::size_t UnixSocketClient::try_send(std::string_view message) noexcept {
   size_t bytes_sent = 0;
   while (bytes_sent < message.size()) {
-    auto write_res = ::send(socket_, message.data() + bytes_sent,
-                            message.size() - bytes_sent, 0);
-
+    const auto write_res = ::send(socket_, message.data() + bytes_sent,
+                                  message.size() - bytes_sent, kSendFlags);
     if (write_res < 0) {
-      const auto old_errno = errno;
-      close();
-      errno = old_errno;
-      utils::CheckSyscall(write_res, "write to socket");
+      if (errno == EINTR) continue;
+      if (errno != EAGAIN && errno != EWOULDBLOCK) close();
+      break;
     }
-
     bytes_sent += static_cast<size_t>(write_res);
   }
+  return bytes_sent;
 }
 
+bool UnixSocketClient::is_connected() const noexcept { return socket_ != -1; }
+
 void UnixSocketClient::close() {
   if (socket_ != -1) {
     if (::close(socket_) == -1) {
@@ -57,10 +82,97 @@ void UnixSocketClient::close() {
 
 UnixSocketClient::~UnixSocketClient() { close(); }
 
-void UnixSocketSink::Write(std::string_view log) { client_.send(log); }
+UnixSocketSink::UnixSocketSink(std::string_view filename,
+                               statistics::Counter* dropped)
+    : filename_{filename}, dropped_{dropped} {
+  client_.connect(filename_);
+}
+
+UnixSocketSink::~UnixSocketSink() { SendPending(); }
+
+void UnixSocketSink::Write(std::string_view log) {
+  Append(log);
+  SendPending();
+}
+
+void UnixSocketSink::WriteBatch(utils::span<const LogMessage> messages) {
+  for (const auto& message : messages) {
+    Append(message.payload);
+  }
+  SendPending();
+}
+
+void UnixSocketSink::Flush() { SendPending(); }
 
 void UnixSocketSink::Close() { client_.close(); }
 
+void UnixSocketSink::Append(std::string_view log) {
+  pending_.append(log);
+  pending_sizes_.push_back(log.size());
+  const std::size_t kept_records = front_partially_sent_ ? 1 : 0;
+  while (pending_.size() > kMaxPendingBytes &&
+         pending_sizes_.size() > kept_records) {
+    DropOldest();
+  }
+}
+
+void UnixSocketSink::SendPending() {
+  if (pending_.empty()) return;
+
+  if (!client_.is_connected()) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now < next_reconnect_) return;
+    try {
+      client_.connect(filename_);
+    } catch (const std::exception&) {
+      next_reconnect_ = now + kReconnectInterval;
+      return;
+    }
+  }
+
+  auto bytes_sent = client_.try_send(pending_);
+  std::size_t lines_sent = 0;
+  while (lines_sent < pending_sizes_.size() &&
+         pending_sizes_[lines_sent] <= bytes_sent) {
+    bytes_sent -= pending_sizes_[lines_sent];
+    ++lines_sent;
+  }
+  std::size_t erased_bytes = 0;
+  for (std::size_t i = 0; i < lines_sent; ++i) {
+    erased_bytes += pending_sizes_.front();
+    pending_sizes_.pop_front();
+  }
+  if (lines_sent != 0) front_partially_sent_ = false;
+
+  if (bytes_sent != 0) {
+    // The listener is slow, the rest of the record is sent later
+    pending_sizes_.front() -= bytes_sent;
+    erased_bytes += bytes_sent;
+    front_partially_sent_ = true;
+  }
+  if (front_partially_sent_ && !client_.is_connected()) {
+    // The rest of the record would be garbage for the next connection
+    erased_bytes += pending_sizes_.front();
+    pending_sizes_.pop_front();
+    front_partially_sent_ = false;
+    if (dropped_) ++*dropped_;
+  }
+  pending_.erase(0, erased_bytes);
+}
+
+void UnixSocketSink::DropOldest() {
+  // The rest of a partially sent record must go first to keep the stream valid
+  auto it = pending_sizes_.begin();
+  std::size_t offset = 0;
+  if (front_partially_sent_) {
+    offset = *it;
+    ++it;
+  }
+  pending_.erase(offset, *it);
+  pending_sizes_.erase(it);
+  if (dropped_) ++*dropped_;
+}
+
 }  // namespace logging::impl
 
 USERVER_NAMESPACE_END
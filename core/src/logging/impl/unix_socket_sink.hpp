@@ -1,9 +1,12 @@
 #pragma once
 
-#include <mutex>
+#include <chrono>
+#include <cstddef>
+#include <deque>
 #include <string>
 
 #include <logging/impl/base_sink.hpp>
+#include <logging/statistics/log_stats.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -20,27 +23,55 @@ class UnixSocketClient final {
   ~UnixSocketClient();
 
   void connect(std::string_view filename);
-  void send(std::string_view message);
+  /// Sends without blocking, returns the number of bytes sent. Closes the
+  /// socket on error.
+  std::size_t try_send(std::string_view message) noexcept;
+  bool is_connected() const noexcept;
   void close();
 
  private:
   int socket_{-1};
 };
 
+/// Writes the logs to a unix socket, a batch of records at once.
+///
+/// The socket is non-blocking: if the listener is slow or goes away, the
+/// records are kept in a bounded buffer and the sink reconnects at most once
+/// per kReconnectInterval. The oldest records are dropped on buffer overflow
+/// and counted in `dropped`.
 class UnixSocketSink final : public BaseSink {
  public:
-  explicit UnixSocketSink(std::string_view filename) : filename_{filename} {
-    client_.connect(filename_);
-  }
+  static constexpr std::size_t kMaxPendingBytes = 4 * 1024 * 1024;
+  static constexpr std::chrono::seconds kReconnectInterval{1};
+
+  explicit UnixSocketSink(std::string_view filename,
+                          statistics::Counter* dropped = nullptr);
+
+  ~UnixSocketSink() override;
 
   void Close();
 
+  void Flush() override;
+
+  std::size_t GetPendingBytes() const noexcept { return pending_.size(); }
+
  protected:
   void Write(std::string_view log) final;
 
+  void WriteBatch(utils::span<const LogMessage> messages) final;
+
  private:
+  void Append(std::string_view log);
+  void SendPending();
+  void DropOldest();
+
   const std::string filename_;
+  statistics::Counter* const dropped_;
   impl::UnixSocketClient client_;
+  std::string pending_;
+  std::deque<std::size_t> pending_sizes_;
+  bool front_partially_sent_{false};
+  std::chrono::steady_clock::time_point next_reconnect_{};
 };
 
 }  // namespace logging::impl
@@ -0,0 +1,54 @@
+#include "unix_socket_sink.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <cstring>
+#include <string>
+
+#include <userver/engine/io/socket.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+engine::io::Socket MakeListener(const std::string& path) {
+  fs::blocking::RemoveSingleFile(path);
+
+  struct sockaddr_un addr {};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, path.data(), path.size());
+
+  engine::io::Socket socket{engine::io::AddrDomain::kUnix,
+                            engine::io::SocketType::kStream};
+  socket.Bind(engine::io::Sockaddr(static_cast<const void*>(&addr)));
+  socket.Listen();
+  return socket;
+}
+
+}  // namespace
+
+UTEST(UnixSocketSink, SlowListenerDoesNotBlock) {
+  const auto socket_file = fs::blocking::TempFile::Create();
+  // The listener never reads, the socket buffers fill up
+  const auto listener = MakeListener(socket_file.GetPath());
+
+  logging::statistics::Counter dropped;
+  logging::impl::UnixSocketSink sink{socket_file.GetPath(), &dropped};
+
+  const std::string record(1024, 'x');
+  const auto records_count =
+      2 * logging::impl::UnixSocketSink::kMaxPendingBytes / record.size();
+  for (std::size_t i = 0; i < records_count; ++i) {
+    sink.Log({record, logging::Level::kInfo});
+  }
+
+  EXPECT_LE(sink.GetPendingBytes(),
+            logging::impl::UnixSocketSink::kMaxPendingBytes);
+  EXPECT_GT(dropped.Load().value, 0);
+}
+
+USERVER_NAMESPACE_END
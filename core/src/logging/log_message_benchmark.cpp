@@ -22,6 +22,13 @@ class NoopLogger : public logging::impl::LoggerBase {
   void Flush() override {}
 };
 
+// Measures the cost of the logging task only, the records are not rendered
+class DeferredNoopLogger final : public NoopLogger {
+ public:
+  DeferredNoopLogger() noexcept { SetFormattingDeferred(true); }
+  void LogDeferred(logging::Level, std::string_view) override {}
+};
+
 class PrependedTagLogger final : public NoopLogger {
  public:
   void PrependCommonTags(logging::impl::TagWriter writer) const override {
@@ -162,6 +169,21 @@ void LogPrependedTags(benchmark::State& state) {
 }
 BENCHMARK(LogPrependedTags);
 
+void LogStringDeferred(benchmark::State& state) {
+  const logging::DefaultLoggerGuard guard{
+      std::make_shared<DeferredNoopLogger>()};
+
+  const auto msg = Launder(std::string(state.range(0), '*'));
+  for ([[maybe_unused]] auto _ : state) {
+    LOG_INFO() << msg;
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(LogStringDeferred)
+    ->RangeMultiplier(2)
+    ->Range(8, 8 << 10)
+    ->Complexity();
+
 }  // namespace
 
 USERVER_NAMESPACE_END
@@ -67,6 +67,19 @@ TEST_F(LoggingTest, TskvEncode) {
       << "escaped sequence is present in the message";
 }
 
+TEST_F(LoggingTest, DeferredFormatting) {
+  GetStreamLogger()->SetFormattingDeferred(true);
+
+  EXPECT_EQ(ToStringViaLogging("line 1\nline 2"), "line 1\\nline 2");
+
+  LOG_CRITICAL() << "text" << logging::LogExtra{{"a.b", "x\ty"}};
+  logging::LogFlush();
+  EXPECT_THAT(GetStreamString(), testing::StartsWith("tskv\ttimestamp="));
+  EXPECT_THAT(GetStreamString(), testing::HasSubstr("\ta_b=x\\ty"));
+  EXPECT_THAT(GetStreamString(), testing::HasSubstr("\ttext=text"));
+  EXPECT_EQ(GetRecordsCount(), 1);
+}
+
 TEST_F(LoggingTest, TskvEncodeKeyWithDot) {
   logging::LogExtra le;
   le.Extend("http.port.ipv4", "4040");
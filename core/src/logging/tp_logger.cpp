@@ -3,6 +3,7 @@
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
+#include <logging/log_helper_impl.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
@@ -14,6 +15,13 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+// Maximum number of log records written to the sinks at once
+constexpr std::size_t kMaxLogBatchSize = 64;
+
+}  // namespace
+
 struct TpLogger::ActionVisitor final {
   TpLogger& logger;
 
@@ -57,6 +65,9 @@ void TpLogger::StartConsumerTask(engine::TaskProcessor& task_processor,
   max_queue_size_.store(max_queue_size);
   overflow_policy_.store(overflow_policy);
 
+  log_batch_.reserve(kMaxLogBatchSize);
+  log_batch_messages_.reserve(kMaxLogBatchSize);
+
   auto expected = State::kSync;
   const bool success = state_.compare_exchange_strong(expected, State::kAsync);
   UINVARIANT(success, "Logger can only be switched to async mode once");
@@ -126,13 +137,22 @@ void TpLogger::Flush() {
 statistics::LogStatistics& TpLogger::GetStatistics() noexcept { return stats_; }
 
 void TpLogger::Log(Level level, std::string_view msg) {
+  DoLog(level, msg, false);
+}
+
+void TpLogger::LogDeferred(Level level, std::string_view record) {
+  DoLog(level, record, true);
+}
+
+void TpLogger::DoLog(Level level, std::string_view payload, bool is_deferred) {
   ++stats_.by_level[static_cast<std::size_t>(level)];
 
   if (GetSinks().empty()) {
     return;
   }
 
-  impl::async::Log action{level, std::string{msg}};
+  impl::async::Log action{level, std::string{payload}};
+  action.is_deferred = is_deferred;
 
   if (TryWaitFreeQueueCapacity()) {
     // The queue might have concurrently become full, in which case the size
@@ -283,8 +303,38 @@ void TpLogger::ConsumeNode(
 
 void TpLogger::ConsumeQueueOnce(Queue::Consumer& consumer) noexcept {
   while (auto* const node_base = consumer.TryPop()) {
-    ConsumeNode(*node_base);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+    auto& action_node = static_cast<impl::async::ActionNode&>(*node_base);
+    if (&action_node != &stop_node_ &&
+        std::holds_alternative<impl::async::Log>(action_node.action)) {
+      log_batch_.push_back(&action_node);
+      if (log_batch_.size() == kMaxLogBatchSize) ConsumeLogBatch();
+      continue;
+    }
+
+    // Keep the order of the records relative to flushes and reopens
+    ConsumeLogBatch();
+    ConsumeNode(action_node);
+  }
+  ConsumeLogBatch();
+}
+
+void TpLogger::ConsumeLogBatch() noexcept {
+  if (log_batch_.empty()) return;
+
+  try {
+    BackendLogBatch(log_batch_);
+  } catch (const std::exception& e) {
+    UASSERT_MSG(false, fmt::format("Exception while doing an async logging: {}",
+                                   e.what()));
+  }
+
+  for (auto* const node : log_batch_) {
+    AccountLogConsumed();
+    delete node;
   }
+  log_batch_.clear();
+  log_batch_messages_.clear();
 }
 
 void TpLogger::CleanUpQueue(Queue::Consumer&& consumer) noexcept {
@@ -297,6 +347,12 @@ void TpLogger::BackendLog(impl::async::Log&& action) const {
   message.payload = action.payload;
   message.level = action.level;
 
+  LogBuffer rendered;
+  if (action.is_deferred) {
+    RenderDeferredRecord(GetFormat(), action.level, action.payload, rendered);
+    message.payload = std::string_view{rendered.data(), rendered.size()};
+  }
+
   for (const auto& sink : GetSinks()) {
     try {
       sink->Log(message);
@@ -311,6 +367,36 @@ void TpLogger::BackendLog(impl::async::Log&& action) const {
   }
 }
 
+void TpLogger::BackendLogBatch(
+    utils::span<impl::async::ActionNode* const> nodes) {
+  bool should_flush = false;
+  for (auto* const node : nodes) {
+    auto& action = std::get<impl::async::Log>(node->action);
+
+    if (action.is_deferred) {
+      LogBuffer rendered;
+      RenderDeferredRecord(GetFormat(), action.level, action.payload, rendered);
+      action.payload.assign(rendered.data(), rendered.size());
+    }
+
+    log_batch_messages_.push_back({action.payload, action.level});
+    should_flush = should_flush || ShouldFlush(action.level);
+  }
+
+  for (const auto& sink : GetSinks()) {
+    try {
+      sink->LogBatch(log_batch_messages_);
+    } catch (const std::exception& e) {
+      UASSERT_MSG(false, "While writing a log message caught an exception: " +
+                             std::string(e.what()));
+    }
+  }
+
+  if (should_flush) {
+    BackendFlush();
+  }
+}
+
 void TpLogger::BackendFlush() const {
   for (const auto& sink : GetSinks()) {
     try {
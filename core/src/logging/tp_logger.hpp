@@ -15,6 +15,7 @@
 #include <userver/engine/task/task.hpp>
 #include <userver/logging/format.hpp>
 #include <userver/logging/impl/logger_base.hpp>
+#include <userver/utils/span.hpp>
 
 #include <concurrent/impl/interference_shield.hpp>
 #include <concurrent/impl/intrusive_hooks.hpp>
@@ -36,6 +37,8 @@ struct Log {
   Level level{};
   std::string payload{};
   std::chrono::system_clock::time_point time{std::chrono::system_clock::now()};
+  // The payload is a record to be formatted by the consumer
+  bool is_deferred{false};
 };
 
 struct FlushCoro {
@@ -74,6 +77,7 @@ class TpLogger final : public LoggerBase {
   void StopConsumerTask();
 
   void Log(Level level, std::string_view msg) override;
+  void LogDeferred(Level level, std::string_view record) override;
   void Flush() override;
   void PrependCommonTags(TagWriter writer) const override;
 
@@ -100,6 +104,7 @@ class TpLogger final : public LoggerBase {
   using Queue = engine::impl::AsyncFlatCombiningQueue;
   using QueueSize = std::int64_t;
 
+  void DoLog(Level level, std::string_view payload, bool is_deferred);
   void ProcessingLoop();
   bool HasFreeQueueCapacity() noexcept;
   bool TryWaitFreeQueueCapacity();
@@ -107,10 +112,12 @@ class TpLogger final : public LoggerBase {
   void DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
   void ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
   void ConsumeQueueOnce(Queue::Consumer& consumer) noexcept;
+  void ConsumeLogBatch() noexcept;
   void CleanUpQueue(Queue::Consumer&& consumer) noexcept;
   void AccountLogConsumed() noexcept;
   void BackendPerform(impl::async::Action&& action) noexcept;
   void BackendLog(impl::async::Log&& action) const;
+  void BackendLogBatch(utils::span<impl::async::ActionNode* const> nodes);
   void BackendFlush() const;
   void BackendReopen(ReopenMode reopen_mode) const;
 
@@ -129,6 +136,10 @@ class TpLogger final : public LoggerBase {
   Queue::Consumer queue_consumer_;
   // A dummy action used for notifying the async task during stopping.
   impl::async::ActionNode stop_node_;
+  // Consecutive log actions popped by the consumer task, written to the sinks
+  // at once. Only accessed by the consumer task.
+  std::vector<impl::async::ActionNode*> log_batch_;
+  std::vector<LogMessage> log_batch_messages_;
 
   Queue queue_;
   concurrent::impl::InterferenceShield<std::atomic<QueueSize>> produced_{0};
@@ -42,6 +42,8 @@ class TpLoggerBenchmark : public benchmark::Fixture {
         [this]() noexcept { tp_logger_->StopConsumerTask(); });
   }
 
+  void EnableDeferredFormatting() { tp_logger_->SetFormattingDeferred(true); }
+
  private:
   std::shared_ptr<logging::impl::TpLogger> tp_logger_;
   std::optional<logging::DefaultLoggerGuard> guard_;
@@ -65,6 +67,23 @@ BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogString)
     ->Range(8, 8 << 10)
     ->Complexity();
 
+BENCHMARK_DEFINE_F(TpLoggerBenchmark, LogStringDeferred)
+(benchmark::State& state) {
+  EnableDeferredFormatting();
+  engine::RunStandalone(2, [&] {
+    auto scope = StartAsyncLoggerScope();
+    const auto msg = Launder(std::string(state.range(0), '*'));
+    for ([[maybe_unused]] auto _ : state) {
+      LOG_INFO() << msg;
+    }
+    state.SetComplexityN(state.range(0));
+  });
+}
+BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogStringDeferred)
+    ->RangeMultiplier(2)
+    ->Range(8, 8 << 10)
+    ->Complexity();
+
 namespace {
 
 __attribute__((noinline)) void LogDebug() { LOG_DEBUG() << 42; }
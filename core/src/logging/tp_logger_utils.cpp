@@ -38,17 +38,20 @@ void CreateLogDirectory(const std::string& logger_name,
   }
 }
 
-SinkPtr GetSinkFromFilename(const std::string& file_path) {
+SinkPtr GetSinkFromFilename(const std::string& file_path,
+                            statistics::LogStatistics& stats) {
   if (utils::text::StartsWith(file_path, kUnixSocketPrefix)) {
     // Use Unix-socket sink
     return std::make_unique<UnixSocketSink>(
-        file_path.substr(kUnixSocketPrefix.size()));
+        std::string_view{file_path}.substr(kUnixSocketPrefix.size()),
+        &stats.dropped);
   } else {
     return std::make_unique<BufferedFileSink>(file_path);
   }
 }
 
-SinkPtr MakeOptionalSink(const LoggerConfig& config) {
+SinkPtr MakeOptionalSink(const LoggerConfig& config,
+                         statistics::LogStatistics& stats) {
   if (config.file_path == "@null") {
     return nullptr;
   } else if (config.file_path == "@stderr") {
@@ -57,7 +60,7 @@ SinkPtr MakeOptionalSink(const LoggerConfig& config) {
     return std::make_unique<logging::impl::BufferedUnownedFileSink>(stdout);
   } else {
     CreateLogDirectory(config.logger_name, config.file_path);
-    return GetSinkFromFilename(config.file_path);
+    return GetSinkFromFilename(config.file_path, stats);
   }
 }
 
@@ -73,8 +76,9 @@ std::shared_ptr<TpLogger> MakeTpLogger(const LoggerConfig& config) {
   auto logger = std::make_shared<TpLogger>(config.format, config.logger_name);
   logger->SetLevel(config.level);
   logger->SetFlushOn(config.flush_level);
+  logger->SetFormattingDeferred(config.deferred_formatting);
 
-  if (auto basic_sink = MakeOptionalSink(config)) {
+  if (auto basic_sink = MakeOptionalSink(config, logger->GetStatistics())) {
     logger->AddSink(std::move(basic_sink));
   }
 
@@ -13,10 +13,17 @@
 
 USERVER_NAMESPACE_BEGIN
 
-template <int VariableCount>
+namespace {
+
+using HazardPointers = rcu::DefaultRcuTraits<std::uint64_t>;
+using Epoch = rcu::EpochRcuTraits<std::uint64_t>;
+
+}  // namespace
+
+template <typename RcuTraits, int VariableCount>
 void rcu_read(benchmark::State& state) {
   engine::RunStandalone([&] {
-    rcu::Variable<std::uint64_t> vars[VariableCount];
+    rcu::Variable<std::uint64_t, RcuTraits> vars[VariableCount];
     {
       std::uint64_t i = 0;
       for (auto& var : vars) {
@@ -33,14 +40,17 @@ void rcu_read(benchmark::State& state) {
     }
   });
 }
-BENCHMARK_TEMPLATE(rcu_read, 1);
-BENCHMARK_TEMPLATE(rcu_read, 2);
-BENCHMARK_TEMPLATE(rcu_read, 4);
-
-template <int VariableCount>
+BENCHMARK_TEMPLATE(rcu_read, HazardPointers, 1);
+BENCHMARK_TEMPLATE(rcu_read, HazardPointers, 2);
+BENCHMARK_TEMPLATE(rcu_read, HazardPointers, 4);
+BENCHMARK_TEMPLATE(rcu_read, Epoch, 1);
+BENCHMARK_TEMPLATE(rcu_read, Epoch, 2);
+BENCHMARK_TEMPLATE(rcu_read, Epoch, 4);
+
+template <typename RcuTraits, int VariableCount>
 void rcu_write(benchmark::State& state) {
   engine::RunStandalone([&] {
-    rcu::Variable<std::uint64_t> vars[VariableCount];
+    rcu::Variable<std::uint64_t, RcuTraits> vars[VariableCount];
 
     std::uint64_t i = 0;
     for ([[maybe_unused]] auto _ : state) {
@@ -49,10 +59,14 @@ void rcu_write(benchmark::State& state) {
     }
   });
 }
-BENCHMARK_TEMPLATE(rcu_write, 1);
-BENCHMARK_TEMPLATE(rcu_write, 2);
-BENCHMARK_TEMPLATE(rcu_write, 4);
-
+BENCHMARK_TEMPLATE(rcu_write, HazardPointers, 1);
+BENCHMARK_TEMPLATE(rcu_write, HazardPointers, 2);
+BENCHMARK_TEMPLATE(rcu_write, HazardPointers, 4);
+BENCHMARK_TEMPLATE(rcu_write, Epoch, 1);
+BENCHMARK_TEMPLATE(rcu_write, Epoch, 2);
+BENCHMARK_TEMPLATE(rcu_write, Epoch, 4);
+
+template <typename RcuTraits>
 void rcu_contention(benchmark::State& state) {
   const std::size_t readers_count = state.range(0);
   const std::size_t writers_count = state.range(1);
@@ -63,14 +77,14 @@ void rcu_contention(benchmark::State& state) {
 
   engine::RunStandalone(thread_count, [&] {
     std::atomic<bool> run{true};
-    rcu::Variable<std::uint64_t> var{0};
+    rcu::Variable<std::uint64_t, RcuTraits> var{0};
 
     std::vector<engine::TaskWithResult<void>> tasks;
     tasks.reserve(readers_count - 1 + writers_count);
 
     for (std::size_t j = 0; j < readers_count - 1; j++) {
       tasks.push_back(utils::Async("reader", [&] {
-        std::vector<rcu::ReadablePtr<std::uint64_t>> pointers;
+        std::vector<rcu::ReadablePtr<std::uint64_t, RcuTraits>> pointers;
         pointers.reserve(kept_readable_pointers_count);
 
         while (run) {
@@ -94,7 +108,7 @@ void rcu_contention(benchmark::State& state) {
     }
 
     {
-      std::queue<rcu::ReadablePtr<std::uint64_t>> pointers;
+      std::queue<rcu::ReadablePtr<std::uint64_t, RcuTraits>> pointers;
       for (std::size_t i = 0; i < kept_readable_pointers_count; i++) {
         pointers.push(var.Read());
       }
@@ -112,7 +126,11 @@ void rcu_contention(benchmark::State& state) {
     }
   });
 }
-BENCHMARK(rcu_contention)
+BENCHMARK_TEMPLATE(rcu_contention, HazardPointers)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 16}, {0, 1}, {1, 4}})
+    ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
+BENCHMARK_TEMPLATE(rcu_contention, Epoch)
     ->RangeMultiplier(2)
     ->Ranges({{1, 16}, {0, 1}, {1, 4}})
     ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
@@ -457,6 +457,120 @@ UTEST_MT(Rcu, TortureTest, kTotalTasks) {
   keep_running = false;
 }
 
+namespace {
+
+template <typename T>
+using EpochVariable = rcu::Variable<T, rcu::EpochRcuTraits<T>>;
+
+struct EpochLifetimeTag {};
+
+}  // namespace
+
+UTEST(RcuEpoch, ChangeRead) {
+  EpochVariable<X> ptr(1, 2);
+
+  auto reader1 = ptr.Read();
+  {
+    auto writer = ptr.StartWrite();
+    writer->first = 3;
+    writer.Commit();
+  }
+  EXPECT_EQ(std::make_pair(1, 2), *reader1);
+
+  auto reader2 = ptr.Read();
+  EXPECT_EQ(std::make_pair(3, 2), *reader2);
+
+  ptr.Assign({5, 6});
+  EXPECT_EQ(std::make_pair(5, 6), ptr.ReadCopy());
+}
+
+UTEST(RcuEpoch, Lifetime) {
+  using Counted = Counted<EpochLifetimeTag>;
+
+  EpochVariable<Counted> ptr(rcu::DestructionType::kSync);
+  EXPECT_EQ(1, Counted::counter);
+
+  {
+    auto reader = ptr.Read();
+    ptr.Emplace();
+    ptr.Emplace();
+    EXPECT_EQ(3, Counted::counter);
+
+    auto copy = reader;
+    EXPECT_EQ(1, copy->value);
+  }
+
+  // the replaced values are freed in a batch by the next writer
+  ptr.Emplace();
+  EXPECT_EQ(1, Counted::counter);
+
+  {
+    auto reader = ptr.Read();
+    ptr.Emplace();
+  }
+  ptr.Cleanup();
+  EXPECT_EQ(1, Counted::counter);
+}
+
+UTEST(RcuEpoch, ReadablePtrMoveAssign) {
+  EpochVariable<int> ptr(1);
+
+  auto reader1 = ptr.Read();
+  ptr.Assign(2);
+  auto reader2 = ptr.Read();
+
+  reader1 = std::move(reader2);
+  EXPECT_EQ(*reader1, 2);
+
+  auto reader3 = reader1;
+  reader1 = std::move(reader3);
+  EXPECT_EQ(*reader1, 2);
+}
+
+UTEST_MT(RcuEpoch, TortureTest, kTotalTasks) {
+  EpochVariable<CleaningUpInt> data{1};
+  std::atomic<bool> keep_running{true};
+
+  engine::Mutex ping_pong_mutex;
+  auto ptr = data.Read();
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+
+  for (std::size_t i = 0; i < kReadablePtrPingPongTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        std::lock_guard lock(ping_pong_mutex);
+        // release a ptr created by another thread
+        ptr = data.Read();
+        ASSERT_GT(ptr->value, 0);
+        engine::Yield();
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < kReadingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto local_ptr = data.Read();
+        const auto copy = local_ptr;
+        ASSERT_GT(copy->value, 0);
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < kWritingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto old = data.ReadCopy();
+        data.Assign(CleaningUpInt{old.value + 1});
+      }
+    }));
+  }
+
+  engine::SleepFor(std::chrono::milliseconds{100});
+  keep_running = false;
+}
+
 UTEST(Rcu, WritablePtrUnlocksInCommit) {
   rcu::Variable<int> var{1};
 
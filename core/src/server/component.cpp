@@ -97,7 +97,7 @@ properties:
                 defaultDescription: 0
             unix-socket:
                 type: string
-                description: unix socket to listen on instead of listening on a port
+                description: unix socket to listen on instead of listening on a port, '@name' for a socket in the abstract namespace
                 defaultDescription: ''
             max_connections:
                 type: integer
@@ -124,6 +124,10 @@ properties:
                     private-key-passphrase-name:
                         type: string
                         description: passphrase name located in secdist
+                    kernel-offload:
+                        type: boolean
+                        description: encrypt the records in the kernel (kTLS)
+                        defaultDescription: false
             handler-defaults:
                 type: object
                 description: handler defaults options
@@ -164,7 +168,7 @@ properties:
                 properties:
                     in_buffer_size:
                         type: integer
-                        description: "size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU"
+                        description: "maximum size of the buffer for request receive, the buffer grows while the reads fill it and shrinks to 1KB on idle connections: bigger values use more RAM and less CPU"
                         defaultDescription: 32 * 1024
                     requests_queue_size_threshold:
                         type: integer
@@ -174,9 +178,47 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    simd_request_parser:
+                        type: boolean
+                        description: parse HTTP/1.x requests by whole lines with SIMD instead of the http_parser library
+                        defaultDescription: false
+                    socket_send_buffer_size:
+                        type: integer
+                        description: SO_SNDBUF of the accepted sockets, e.g. a small value keeps the kernel memory of many unix socket connections from a sidecar low
+                        defaultDescription: system default
+                    socket_receive_buffer_size:
+                        type: integer
+                        description: SO_RCVBUF of the accepted sockets
+                        defaultDescription: system default
+                    http2:
+                        type: object
+                        description: HTTP/2 settings, the protocol is negotiated with ALPN for TLS connections, clients with prior knowledge are detected by the connection preface
+                        additionalProperties: false
+                        properties:
+                            enabled:
+                                type: boolean
+                                description: accept HTTP/2 connections
+                                defaultDescription: false
+                            max_concurrent_streams:
+                                type: integer
+                                description: maximum number of concurrently processed streams (requests) of a connection
+                                defaultDescription: 100
+                            initial_window_size:
+                                type: integer
+                                description: initial flow control window size in bytes for the request bodies of a stream and of the whole connection
+                                defaultDescription: 65535
             shards:
                 type: integer
-                description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
+                description: how many listening sockets to bind to the same port with SO_REUSEPORT, each one has its own accept loop; do not set if not sure what it is doing
+                defaultDescription: number of the event threads of the task processor
+            reuseport_cpu_steering:
+                type: boolean
+                description: pass each connection to the listening socket with the index of the CPU that received the SYN (modulo the shards count) instead of the hash of the connection addresses; gives better locality if the shards count matches the CPUs handling the NIC queues
+                defaultDescription: false
+            shard_task_processors:
+                type: string
+                description: name of a components::SingleThreadedTaskProcessors component; the N-th listener shard accepts and processes its connections on the N-th task processor of it (modulo its size) instead of `task_processor`
+                defaultDescription: ''
     listener-monitor:
         type: object
         description: describes the special monitoring socket, used for getting statistics and processing utility requests that should succeed even is the main socket is under heavy pressure
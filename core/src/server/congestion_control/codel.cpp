@@ -0,0 +1,39 @@
+#include <server/congestion_control/codel.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::congestion_control {
+
+bool CoDel::ShouldShed(Clock::duration delay, Clock::time_point now,
+                       const Settings& settings) noexcept {
+  const auto now_rep = now.time_since_epoch().count();
+  auto interval_end = interval_end_.load(std::memory_order_relaxed);
+
+  if (now_rep >= interval_end &&
+      interval_end_.compare_exchange_strong(
+          interval_end, now_rep + settings.interval.count(),
+          std::memory_order_relaxed)) {
+    // The winner closes the interval, the next one starts with its delay
+    const auto min_delay =
+        min_delay_.exchange(delay.count(), std::memory_order_relaxed);
+    is_overloaded_.store(min_delay > settings.target_delay.count(),
+                         std::memory_order_relaxed);
+  } else {
+    auto min_delay = min_delay_.load(std::memory_order_relaxed);
+    while (delay.count() < min_delay &&
+           !min_delay_.compare_exchange_weak(min_delay, delay.count(),
+                                             std::memory_order_relaxed)) {
+    }
+  }
+
+  return is_overloaded_.load(std::memory_order_relaxed) &&
+         delay > 2 * settings.target_delay;
+}
+
+bool CoDel::IsOverloaded() const noexcept {
+  return is_overloaded_.load(std::memory_order_relaxed);
+}
+
+}  // namespace server::congestion_control
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::congestion_control {
+
+/// CoDel-style active queue management of the requests that wait for a
+/// handler task to start.
+///
+/// The server is overloaded if the minimum queue delay over the last interval
+/// exceeded the target: a standing queue that does not drain between the
+/// bursts. While overloaded, the requests that waited longer than twice the
+/// target are shed, so the latency stays bounded without tuning RPS limits.
+///
+/// Thread-safe and lock-free.
+class CoDel final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Settings final {
+    Clock::duration target_delay;
+    Clock::duration interval;
+  };
+
+  /// Accounts the queue delay of a request that is about to be handled and
+  /// returns whether the request should be shed.
+  bool ShouldShed(Clock::duration delay, Clock::time_point now,
+                  const Settings& settings) noexcept;
+
+  /// Whether the minimum delay over the last closed interval exceeded the
+  /// target
+  bool IsOverloaded() const noexcept;
+
+ private:
+  std::atomic<Clock::rep> interval_end_{0};
+  std::atomic<Clock::rep> min_delay_{0};
+  std::atomic<bool> is_overloaded_{false};
+};
+
+}  // namespace server::congestion_control
+
+USERVER_NAMESPACE_END
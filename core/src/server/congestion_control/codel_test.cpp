@@ -0,0 +1,65 @@
+#include <server/congestion_control/codel.hpp>
+
+#include <userver/utest/utest.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using CoDel = server::congestion_control::CoDel;
+
+const CoDel::Settings kSettings{5ms, 100ms};
+
+// Feeds the requests with the same delay for the whole interval
+bool FeedInterval(CoDel& codel, CoDel::Clock::time_point& now,
+                  CoDel::Clock::duration delay) {
+  bool shed = false;
+  for (int i = 0; i < 10; ++i) {
+    shed = codel.ShouldShed(delay, now, kSettings);
+    now += 10ms;
+  }
+  return shed;
+}
+
+}  // namespace
+
+TEST(CoDel, NoShedWithoutStandingQueue) {
+  CoDel codel;
+  auto now = CoDel::Clock::time_point{} + 1h;
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_FALSE(FeedInterval(codel, now, 1ms));
+  }
+  EXPECT_FALSE(codel.IsOverloaded());
+
+  // A burst that drains within the interval is not an overload
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_FALSE(codel.ShouldShed(i == 5 ? 1ms : 50ms, now, kSettings));
+    now += 10ms;
+  }
+  EXPECT_FALSE(FeedInterval(codel, now, 50ms));
+  EXPECT_FALSE(codel.IsOverloaded());
+}
+
+TEST(CoDel, ShedsUnderStandingQueue) {
+  CoDel codel;
+  auto now = CoDel::Clock::time_point{} + 1h;
+
+  FeedInterval(codel, now, 20ms);
+  EXPECT_TRUE(FeedInterval(codel, now, 20ms));
+  EXPECT_TRUE(codel.IsOverloaded());
+
+  // Only the requests that waited for more than twice the target are shed
+  EXPECT_FALSE(codel.ShouldShed(7ms, now, kSettings));
+  EXPECT_TRUE(codel.ShouldShed(11ms, now, kSettings));
+
+  // The queue has drained
+  FeedInterval(codel, now, 1ms);
+  FeedInterval(codel, now, 1ms);
+  EXPECT_FALSE(codel.IsOverloaded());
+  EXPECT_FALSE(codel.ShouldShed(20ms, now, kSettings));
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,130 @@
+#include <userver/server/handlers/cpu_profiler.hpp>
+
+#include <fmt/format.h>
+
+#include <userver/components/component_config.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include <engine/impl/cpu_profiler.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+constexpr std::size_t kMaxFrequency = 10'000;
+
+std::chrono::microseconds ToPeriod(std::size_t frequency) {
+  return std::chrono::microseconds{1'000'000 / frequency};
+}
+
+}  // namespace
+
+CpuProfiler::CpuProfiler(const components::ComponentConfig& config,
+                         const components::ComponentContext& component_context)
+    : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
+      default_frequency_(config["frequency"].As<std::size_t>(100)) {
+  if (default_frequency_ == 0 || default_frequency_ > kMaxFrequency) {
+    throw std::runtime_error(
+        fmt::format("Invalid CPU profiler frequency {}, expected 1..{}",
+                    default_frequency_, kMaxFrequency));
+  }
+
+  collect_task_.Start(
+      "cpu-profiler-collect",
+      {config["collect-period"].As<std::chrono::milliseconds>(
+          std::chrono::seconds{1})},
+      [] {
+        auto& profiler = engine::impl::CpuProfiler::Get();
+        if (profiler.IsRunning()) profiler.Collect();
+      });
+
+  if (config["start-on-boot"].As<bool>(false)) {
+    engine::impl::CpuProfiler::Get().Start(ToPeriod(default_frequency_));
+  }
+}
+
+CpuProfiler::~CpuProfiler() {
+  collect_task_.Stop();
+  engine::impl::CpuProfiler::Get().Stop();
+}
+
+std::string CpuProfiler::HandleRequestThrow(const http::HttpRequest& request,
+                                            request::RequestContext&) const {
+  auto& profiler = engine::impl::CpuProfiler::Get();
+
+  const auto& command = request.GetPathArg("command");
+  if (command == "start") {
+    auto frequency = default_frequency_;
+    if (request.HasArg("frequency")) {
+      try {
+        frequency = utils::FromString<std::size_t>(request.GetArg("frequency"));
+      } catch (const std::exception& ex) {
+        request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+        return std::string{"invalid 'frequency' value: "} + ex.what();
+      }
+      if (frequency == 0 || frequency > kMaxFrequency) {
+        request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+        return fmt::format("'frequency' must be in 1..{}", kMaxFrequency);
+      }
+    }
+
+    if (profiler.IsRunning()) return "Already running\n";
+    profiler.Start(ToPeriod(frequency));
+    return "OK\n";
+  } else if (command == "stop") {
+    profiler.Stop();
+    return "OK\n";
+  } else if (command == "dump") {
+    return profiler.DumpFolded(request.GetArg("reset") == "true");
+  } else if (command == "status") {
+    const auto stats = profiler.GetStats();
+    return fmt::format(
+        "running: {}\nthreads: {}\nsamples: {}\ndropped_samples: {}\n"
+        "stacks: {}\n",
+        stats.is_running, stats.threads, stats.samples, stats.dropped_samples,
+        stats.stacks);
+  } else {
+    request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+    return "Unsupported command";
+  }
+}
+
+std::string CpuProfiler::GetResponseDataForLogging(
+    const http::HttpRequest&, request::RequestContext&,
+    const std::string&) const {
+  return "<cpu profile>";
+}
+
+yaml_config::Schema CpuProfiler::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: handler-cpu-profiler config
+additionalProperties: false
+properties:
+    start-on-boot:
+        type: boolean
+        description: whether to start the profiler at the service start
+        defaultDescription: false
+    frequency:
+        type: integer
+        description: default sampling frequency in Hz per thread
+        defaultDescription: 100
+        minimum: 1
+        maximum: 10000
+    collect-period:
+        type: string
+        description: |
+            how often the samples are moved from the per-thread buffers
+            into the aggregate
+        defaultDescription: 1s
+)");
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
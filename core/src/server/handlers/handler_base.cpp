@@ -95,6 +95,25 @@ properties:
         type: boolean
         description: allow decompression of the requests
         defaultDescription: false
+    compress_response:
+        type: boolean
+        description: |
+            compress the responses with gzip if the client accepts it in
+            Accept-Encoding
+        defaultDescription: false
+    compress_response_min_size:
+        type: integer
+        description: |
+            minimal size of a non-streamed response body to compress;
+            streamed bodies are always compressed
+        defaultDescription: 1024
+        minimum: 0
+    compress_response_level:
+        type: integer
+        description: gzip compression level of the responses
+        defaultDescription: 6
+        minimum: 1
+        maximum: 9
     throttling_enabled:
         type: boolean
         description: allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options
@@ -107,6 +126,71 @@ properties:
         type: boolean
         description: TODO
         defaultDescription: false
+    response-body-stream-buffer-size:
+        type: integer
+        description: |
+            coalesce the chunks of a streamed response body until this many
+            bytes are buffered, 0 to send each chunk as is
+        defaultDescription: 0
+        minimum: 0
+    response-body-stream-flush-delay:
+        type: string
+        description: |
+            max time a chunk of a streamed response body stays in the buffer
+            of `response-body-stream-buffer-size`
+        defaultDescription: 10ms
+    request-body-stream:
+        type: boolean
+        description: pass the request body to the handler as it is received, see server::http::HttpRequest::GetBodyStream()
+        defaultDescription: false
+    response-headers:
+        type: object
+        description: headers to add to each response, they are formatted once at start; the headers set by the handler take precedence
+        additionalProperties:
+            type: string
+            description: header value
+        properties: {}
+    response-cache:
+        type: object
+        description: |
+            cache the responses of the GET and HEAD requests and serve them
+            without calling the handler; only the 200 responses without
+            cookies, Content-Encoding and `Cache-Control: no-store/private`
+            are cached; the requests with `Authorization` or `Cookie` headers
+            bypass the cache unless the header is listed in `headers`
+        additionalProperties: false
+        properties:
+            ttl:
+                type: string
+                description: lifetime of a cached response
+                defaultDescription: 1s
+            size:
+                type: integer
+                description: max count of the cached responses
+                defaultDescription: 1000
+                minimum: 1
+            ways:
+                type: integer
+                description: count of the independently locked cache shards
+                defaultDescription: 16
+                minimum: 1
+            max-body-size:
+                type: integer
+                description: bigger responses are not cached
+                defaultDescription: 131072
+            args:
+                type: array
+                description: query arguments that make up the key along with the path
+                defaultDescription: the whole query string
+                items:
+                    type: string
+                    description: argument name
+            headers:
+                type: array
+                description: request headers that make up the key along with the path
+                items:
+                    type: string
+                    description: header name
     monitor-handler:
         type: boolean
         description: overrides the in-code `is_monitor` flag that makes the handler run either on 'server.listener' or on 'server.listener-monitor'
@@ -138,6 +222,28 @@ properties:
         defaultDescription: taken from server.listener.handler-defaults.deadline_expired_status_code
         minimum: 400
         maximum: 599
+    wait_time_stats:
+        type: boolean
+        description: |
+            account the off-CPU time of the requests by the wait reason
+            (mutex, semaphore, future, sleep, io ...) and the time in the task
+            processor queue; written into the span tags and into the handler
+            metrics under `wait`
+        defaultDescription: false
+    allocation_stats:
+        type: boolean
+        description: |
+            account the bytes allocated and freed by the requests, requires
+            jemalloc; written into the span tags and into the handler metrics
+            under `allocations`
+        defaultDescription: false
+    run_on_connection_task_processor:
+        type: boolean
+        description: |
+            run the requests on the task processor that reads the connection
+            instead of `task_processor`, which saves a hop between threads;
+            the handler must not block the task processor of the listener
+        defaultDescription: false
 )");
 }
 
@@ -31,6 +31,25 @@ FallbackHandler Parse(const yaml_config::YamlConfig& yaml,
   return FallbackHandlerFromString(value);
 }
 
+ResponseCacheConfig Parse(const yaml_config::YamlConfig& yaml,
+                          formats::parse::To<ResponseCacheConfig>) {
+  ResponseCacheConfig config;
+  config.ttl = yaml["ttl"].As<std::chrono::milliseconds>(config.ttl);
+  config.size = yaml["size"].As<std::size_t>(config.size);
+  config.ways = yaml["ways"].As<std::size_t>(config.ways);
+  config.max_body_size =
+      yaml["max-body-size"].As<std::size_t>(config.max_body_size);
+  config.args = yaml["args"].As<std::vector<std::string>>({});
+  config.headers = yaml["headers"].As<std::vector<std::string>>({});
+
+  if (config.ttl.count() <= 0 || config.size == 0 || config.ways == 0) {
+    throw std::runtime_error(fmt::format(
+        "'ttl', 'size' and 'ways' of {} should be greater than 0",
+        yaml.GetPath()));
+  }
+  return config;
+}
+
 HandlerConfig ParseHandlerConfigsWithDefaults(
     const yaml_config::YamlConfig& value,
     const server::ServerConfig& server_config, bool is_monitor) {
@@ -83,11 +102,24 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
   config.max_requests_per_second =
       value["max_requests_per_second"].As<std::optional<size_t>>();
   config.decompress_request = value["decompress_request"].As<bool>(true);
+  config.compress_response = value["compress_response"].As<bool>(false);
+  config.compress_response_min_size =
+      value["compress_response_min_size"].As<size_t>(
+          config.compress_response_min_size);
+  config.compress_response_level = value["compress_response_level"].As<int>(
+      config.compress_response_level);
   config.throttling_enabled = value["throttling_enabled"].As<bool>(true);
   config.set_response_server_hostname =
       value["set-response-server-hostname"].As<std::optional<bool>>();
 
   config.response_body_stream = value["response-body-stream"].As<bool>(false);
+  config.response_body_stream_buffer_size =
+      value["response-body-stream-buffer-size"].As<std::size_t>(
+          config.response_body_stream_buffer_size);
+  config.response_body_stream_flush_delay =
+      value["response-body-stream-flush-delay"].As<std::chrono::milliseconds>(
+          config.response_body_stream_flush_delay);
+  config.request_body_stream = value["request-body-stream"].As<bool>(false);
 
   if (config.max_requests_per_second &&
       config.max_requests_per_second.value() <= 0) {
@@ -96,6 +128,13 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
         std::to_string(config.max_requests_per_second.value()));
   }
 
+  if (config.compress_response_level < 1 ||
+      config.compress_response_level > 9) {
+    throw std::runtime_error(
+        "compress_response_level should be in [1, 9], current value is " +
+        std::to_string(config.compress_response_level));
+  }
+
   config.set_tracing_headers = value["set_tracing_headers"].As<bool>(
       handler_defaults.set_tracing_headers);
 
@@ -107,6 +146,23 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
       value["deadline_expired_status_code"].As<http::HttpStatus>(
           handler_defaults.deadline_expired_status_code);
 
+  config.wait_time_stats = value["wait_time_stats"].As<bool>(false);
+  config.allocation_stats = value["allocation_stats"].As<bool>(false);
+  config.run_on_connection_task_processor =
+      value["run_on_connection_task_processor"].As<bool>(false);
+
+  config.response_headers =
+      value["response-headers"]
+          .As<std::unordered_map<std::string, std::string>>({});
+
+  config.response_cache =
+      value["response-cache"].As<std::optional<ResponseCacheConfig>>();
+  if (config.response_cache && config.response_body_stream) {
+    throw std::runtime_error(
+        "'response-cache' is not supported for the handlers with "
+        "'response-body-stream: true'");
+  }
+
   return config;
 }
 
@@ -5,7 +5,9 @@
 
 #include <compression/gzip.hpp>
 #include <server/handlers/http_handler_base_statistics.hpp>
+#include <server/handlers/http_response_cache.hpp>
 #include <server/handlers/http_server_settings.hpp>
+#include <logging/log_helper_impl.hpp>
 #include <server/http/http_request_impl.hpp>
 #include <server/server_config.hpp>
 #include <userver/baggage/baggage.hpp>
@@ -16,10 +18,12 @@
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/inherited_variable.hpp>
+#include <userver/engine/task/priority.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/hostinfo/blocking/get_hostname.hpp>
 #include <userver/http/common_headers.hpp>
+#include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/level_serialization.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/server/component.hpp>
@@ -43,6 +47,7 @@
 #include <userver/utils/log.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/scope_guard.hpp>
+#include <userver/utils/str_icase.hpp>
 #include <userver/utils/text.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
@@ -82,6 +87,37 @@ std::vector<http::HttpMethod> InitAllowedMethods(const HandlerConfig& config) {
   return allowed_methods;
 }
 
+std::string_view TrimSpaces(std::string_view str) {
+  while (!str.empty() && (str.front() == ' ' || str.front() == '\t')) {
+    str.remove_prefix(1);
+  }
+  while (!str.empty() && (str.back() == ' ' || str.back() == '\t')) {
+    str.remove_suffix(1);
+  }
+  return str;
+}
+
+// RFC 9110, 12.5.3. A coding with "q=0" is explicitly not acceptable.
+bool IsGzipAccepted(const http::HttpRequest& http_request) {
+  const auto& accept_encoding = http_request.GetHeader(
+      USERVER_NAMESPACE::http::headers::kAcceptEncoding);
+  for (const auto coding :
+       utils::text::SplitIntoStringViewVector(accept_encoding, ",")) {
+    const auto params_pos = coding.find(';');
+    const auto name = TrimSpaces(coding.substr(0, params_pos));
+    if (!utils::StrIcaseEqual{}(name, "gzip") && name != "*") continue;
+
+    if (params_pos == std::string_view::npos) return true;
+    const auto params = TrimSpaces(coding.substr(params_pos + 1));
+    if (params.size() < 3 || params.substr(0, 2) != "q=") {
+      return true;
+    }
+    const auto qvalue = params.substr(2);
+    return qvalue.find_first_not_of("0.") != std::string_view::npos;
+  }
+  return false;
+}
+
 void SetFormattedErrorResponse(http::HttpResponse& http_response,
                                FormattedErrorData&& formatted_error_data) {
   http_response.SetData(std::move(formatted_error_data.external_body));
@@ -111,8 +147,9 @@ void SetUpBaggage(const http::HttpRequest& http_request,
     if (!baggage_header.empty()) {
       LOG_DEBUG() << "Got baggage header: " << baggage_header;
       const auto& baggage_settings = config_snapshot[baggage::kBaggageSettings];
-      auto baggage = baggage::TryMakeBaggage(std::move(baggage_header),
-                                             baggage_settings.allowed_keys);
+      auto baggage =
+          baggage::TryMakeBaggage(std::move(baggage_header),
+                                  baggage_settings.GetSharedAllowedKeys());
       if (baggage) {
         baggage::kInheritedBaggage.Set(std::move(*baggage));
       }
@@ -328,6 +365,7 @@ std::optional<std::chrono::milliseconds> ParseTimeout(
 struct DeadlinePropagationContext final {
   bool need_log_response{false};
   bool is_cancelled_by_deadline{false};
+  bool is_rejected_by_predicted_deadline{false};
 };
 
 void HandleDeadlineExpired(RequestProcessor& processor,
@@ -357,7 +395,8 @@ void HandleDeadlineExpired(RequestProcessor& processor,
 
 void SetUpInheritedDeadline(RequestProcessor& processor,
                             DeadlinePropagationContext& dp_context,
-                            request::TaskInheritedData& inherited_data) {
+                            request::TaskInheritedData& inherited_data,
+                            HttpHandlerMethodStatistics& method_statistics) {
   if (!processor.GetHandler().GetConfig().deadline_propagation_enabled) return;
 
   if (!processor.GetInitialDynamicConfig()[impl::kDeadlinePropagationEnabled]) {
@@ -383,13 +422,26 @@ void SetUpInheritedDeadline(RequestProcessor& processor,
     return;
   }
 
+  // The handler would most probably fail to answer in time, so the work is
+  // not even started
+  const auto& predictive_config =
+      processor.GetInitialDynamicConfig()[impl::kPredictiveDeadlineConfig];
+  if (method_statistics.IsPredictedToMissDeadline(deadline,
+                                                  predictive_config)) {
+    dp_context.is_rejected_by_predicted_deadline = true;
+    HandleDeadlineExpired(processor, dp_context,
+                          "Predicted timeout (deadline propagation)");
+    return;
+  }
+
   if (processor.GetInitialDynamicConfig()[kCancelHandleRequestByDeadline]) {
     engine::current_task::SetDeadline(deadline);
   }
 }
 
 void SetUpInheritedData(RequestProcessor& processor,
-                        DeadlinePropagationContext& dp_context) {
+                        DeadlinePropagationContext& dp_context,
+                        HttpHandlerMethodStatistics& method_statistics) {
   request::TaskInheritedData inherited_data{
       std::visit(
           utils::Overloaded{
@@ -404,10 +456,13 @@ void SetUpInheritedData(RequestProcessor& processor,
   };
 
   const utils::FastScopeGuard set_inherited_data_guard([&]() noexcept {
+    // earliest-deadline-first ordering of the request and its subtasks
+    engine::current_task::SetSchedulingDeadline(inherited_data.deadline);
     request::kTaskInheritedData.Set(std::move(inherited_data));
   });
 
-  SetUpInheritedDeadline(processor, dp_context, inherited_data);
+  SetUpInheritedDeadline(processor, dp_context, inherited_data,
+                         method_statistics);
 }
 
 void CompleteDeadlinePropagation(RequestProcessor& processor,
@@ -459,43 +514,53 @@ std::string CutTrailingSlash(
   return std::move(meta_type);
 }
 
-// Separate function to avoid heavy computations when the result is not going
-// to be logged
-logging::LogExtra LogRequestExtra(bool need_log_request_headers,
-                                  const http::HttpRequest& http_request,
-                                  const std::string& meta_type,
-                                  const std::string& body_to_log,
-                                  std::uint64_t body_length) {
-  logging::LogExtra log_extra;
+// Separate type to avoid heavy computations when the result is not going
+// to be logged. The tags are written directly into the log record, so the
+// request data is not copied into a LogExtra on each request.
+struct RequestLogTags final {
+  bool need_log_request_headers;
+  const http::HttpRequest& http_request;
+  const std::string& meta_type;
+  const std::string& body_to_log;
+  std::uint64_t body_length;
+};
 
-  if (need_log_request_headers) {
-    log_extra.Extend("request_headers", GetHeadersLogString(http_request));
+logging::LogHelper& operator<<(logging::LogHelper& lh,
+                               const RequestLogTags& tags) {
+  using logging::impl::RuntimeTagKey;
+
+  auto writer = lh.GetTagWriterAfterText({});
+  const auto& http_request = tags.http_request;
+
+  if (tags.need_log_request_headers) {
+    writer.PutTag("request_headers", GetHeadersLogString(http_request));
   }
-  log_extra.Extend(tracing::kHttpMetaType, meta_type);
-  log_extra.Extend(tracing::kType, kTracingTypeRequest);
-  log_extra.Extend("request_body_length", body_length);
-  log_extra.Extend(kTracingBody, body_to_log);
-  log_extra.Extend(kTracingUri, http_request.GetUrl());
-  log_extra.Extend(tracing::kHttpMethod, http_request.GetMethodStr());
+  writer.PutTag(RuntimeTagKey{tracing::kHttpMetaType}, tags.meta_type);
+  writer.PutTag(RuntimeTagKey{tracing::kType}, kTracingTypeRequest);
+  writer.PutTag("request_body_length", tags.body_length);
+  writer.PutTag(RuntimeTagKey{kTracingBody}, tags.body_to_log);
+  writer.PutTag(RuntimeTagKey{kTracingUri}, http_request.GetUrl());
+  writer.PutTag(RuntimeTagKey{tracing::kHttpMethod},
+                http_request.GetMethodStr());
 
   const auto& request_application = http_request.GetHeader(
       USERVER_NAMESPACE::http::headers::kXRequestApplication);
   if (!request_application.empty()) {
-    log_extra.Extend("request_application", request_application);
+    writer.PutTag("request_application", request_application);
   }
 
   const auto& user_agent =
       http_request.GetHeader(USERVER_NAMESPACE::http::headers::kUserAgent);
   if (!user_agent.empty()) {
-    log_extra.Extend(kUserAgentTag, user_agent);
+    writer.PutTag(RuntimeTagKey{kUserAgentTag}, user_agent);
   }
   const auto& accept_language =
       http_request.GetHeader(USERVER_NAMESPACE::http::headers::kAcceptLanguage);
   if (!accept_language.empty()) {
-    log_extra.Extend(kAcceptLanguageTag, accept_language);
+    writer.PutTag(RuntimeTagKey{kAcceptLanguageTag}, accept_language);
   }
 
-  return log_extra;
+  return lh;
 }
 
 std::unordered_map<int, logging::Level> ParseStatusCodesLogLevel(
@@ -507,6 +572,50 @@ std::unordered_map<int, logging::Level> ParseStatusCodesLogLevel(
   return result;
 }
 
+void AddWaitStatsTags(tracing::Span& span) {
+  const auto* const wait_stats = engine::current_task::GetWaitStats();
+  if (!wait_stats) return;
+
+  const auto to_us = [](std::chrono::nanoseconds duration) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        .count();
+  };
+  for (std::size_t i = 0; i < engine::impl::kWaitReasonCount; ++i) {
+    if (wait_stats->wait_time[i].count() == 0) continue;
+    span.AddNonInheritableTag(
+        fmt::format("wait_{}_us",
+                    ToString(static_cast<engine::impl::WaitReason>(i))),
+        to_us(wait_stats->wait_time[i]));
+  }
+  span.AddNonInheritableTag("queue_wait_us", to_us(wait_stats->queue_wait));
+  span.AddNonInheritableTag("context_switches", wait_stats->context_switches);
+}
+
+void AddAllocStatsTags(tracing::Span& span) {
+  const auto* const alloc_stats = engine::current_task::GetAllocStats();
+  if (!alloc_stats) return;
+
+  span.AddNonInheritableTag("allocated_bytes", alloc_stats->allocated_bytes);
+  span.AddNonInheritableTag("deallocated_bytes",
+                            alloc_stats->deallocated_bytes);
+}
+
+std::shared_ptr<const http::HttpResponse::PreparedHeaders> MakeStaticHeaders(
+    const HandlerConfig& config) {
+  if (config.response_headers.empty()) return nullptr;
+
+  http::HttpResponse::HeadersMap headers;
+  for (const auto& [name, value] : config.response_headers) {
+    headers.insert_or_assign(name, value);
+  }
+  try {
+    return http::HttpResponse::MakePreparedHeaders(std::move(headers));
+  } catch (const std::exception& ex) {
+    throw std::runtime_error(
+        fmt::format("invalid 'response-headers': {}", ex.what()));
+  }
+}
+
 }  // namespace
 
 HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
@@ -530,7 +639,12 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
           context.FindComponent<components::AuthCheckerSettings>().Get())),
       log_level_(config["log-level"].As<std::optional<logging::Level>>()),
       rate_limit_(utils::TokenBucket::MakeUnbounded()),
-      is_body_streamed_(config["response-body-stream"].As<bool>(false)) {
+      is_body_streamed_(config["response-body-stream"].As<bool>(false)),
+      response_cache_(GetConfig().response_cache
+                          ? std::make_unique<HttpResponseCache>(
+                                *GetConfig().response_cache)
+                          : nullptr),
+      static_headers_(MakeStaticHeaders(GetConfig())) {
   if (allowed_methods_.empty()) {
     LOG_WARNING() << "empty allowed methods list in " << config.Name();
   }
@@ -580,6 +694,9 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
         if constexpr (kIncludeServerHttpMetrics) {
           FormatStatistics(result["request"], *request_statistics_);
         }
+        if (response_cache_) {
+          response_cache_->WriteStatistics(result["response-cache"]);
+        }
       },
       std::move(labels));
 
@@ -601,6 +718,17 @@ void HttpHandlerBase::HandleRequestStream(
   auto& http_response = http_request.GetHttpResponse();
   server::http::ResponseBodyStream response_body_stream{
       response.GetBodyProducer(), http_response};
+  if (GetConfig().compress_response && IsGzipAccepted(http_request)) {
+    response_body_stream.EnableCompression(GetConfig().compress_response_level);
+  }
+  if (GetConfig().response_body_stream_buffer_size > 0) {
+    response_body_stream.EnableBuffering(
+        GetConfig().response_body_stream_buffer_size,
+        GetConfig().response_body_stream_flush_delay);
+  }
+  // The gzip trailer must be sent on any exit, including the exceptions
+  const utils::FastScopeGuard finish_guard(
+      [&response_body_stream]() noexcept { response_body_stream.Finish(); });
 
   // Just in case HandleStreamRequest() throws an exception.
   // Though it can be changed in HandleStreamRequest().
@@ -649,9 +777,13 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
   auto& http_request_impl = static_cast<http::HttpRequestImpl&>(request);
   http::HttpRequest http_request(http_request_impl);
   auto& response = http_request.GetHttpResponse();
+  if (static_headers_) response.SetPreparedHeaders(static_headers_);
   std::optional<tracing::Span> span_storage;
 
   try {
+    if (GetConfig().wait_time_stats) engine::current_task::EnableWaitStats();
+    if (GetConfig().allocation_stats) engine::current_task::EnableAllocStats();
+
     HttpHandlerStatisticsScope stats_scope(*handler_statistics_,
                                            http_request.GetMethod(), response);
     DeadlinePropagationContext dp_context;
@@ -672,8 +804,11 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
         [this, &http_request] { CheckRatelimit(http_request); });
 
     request_processor.ProcessRequestStepNoScopeTime(
-        "check_deadline_propagation", [&request_processor, &dp_context] {
-          SetUpInheritedData(request_processor, dp_context);
+        "check_deadline_propagation",
+        [this, &request_processor, &dp_context, &http_request] {
+          SetUpInheritedData(
+              request_processor, dp_context,
+              handler_statistics_->ForMethod(http_request.GetMethod()));
         });
 
     request_processor.ProcessRequestStep(
@@ -695,11 +830,11 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
       const bool need_log_request_headers =
           request_processor.GetInitialDynamicConfig()[kLogRequestHeaders];
       LOG_INFO() << "start handling"
-                 << LogRequestExtra(
+                 << RequestLogTags{
                         need_log_request_headers, http_request, meta_type,
                         GetRequestBodyForLoggingChecked(
                             http_request, context, http_request.RequestBody()),
-                        http_request.RequestBody().length());
+                        http_request.RequestBody().length()};
     }
 
     {
@@ -711,19 +846,33 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
         "http_handle_request", [this, &response, &http_request, &context] {
           if (response.IsBodyStreamed()) {
             HandleRequestStream(http_request, context);
+          } else if (response_cache_) {
+            response_cache_->Handle(http_request, [&] {
+              response.SetData(HandleRequestThrow(http_request, context));
+            });
           } else {
             // !IsBodyStreamed()
             response.SetData(HandleRequestThrow(http_request, context));
           }
         });
 
+    if (GetConfig().compress_response && !response.IsBodyStreamed()) {
+      request_processor.ProcessRequestStep(
+          "http_compress_response_body",
+          [this, &http_request] { CompressResponseBody(http_request); });
+    }
+
     CompleteDeadlinePropagation(request_processor, dp_context);
     if (GetConfig().set_tracing_headers) {
       tracing_manager_.FillResponseWithTracingContext(*span_storage, response);
     }
-    if (dp_context.is_cancelled_by_deadline) {
+    if (dp_context.is_rejected_by_predicted_deadline) {
+      stats_scope.OnRejectedByPredictedDeadline();
+    } else if (dp_context.is_cancelled_by_deadline) {
       stats_scope.OnCancelledByDeadline();
     }
+    AddWaitStatsTags(*span_storage);
+    AddAllocStatsTags(*span_storage);
   } catch (const std::exception& ex) {
     LOG_ERROR() << "unable to handle request: " << ex;
   }
@@ -874,7 +1023,10 @@ void HttpHandlerBase::CheckRatelimit(
 
 void HttpHandlerBase::DecompressRequestBody(
     http::HttpRequest& http_request) const {
-  if (!http_request.IsBodyCompressed()) return;
+  // The streamed body is passed to the handler as is
+  if (!http_request.IsBodyCompressed() || http_request.IsBodyStreamed()) {
+    return;
+  }
 
   const auto& content_encoding = http_request.GetHeader(
       USERVER_NAMESPACE::http::headers::kContentEncoding);
@@ -965,6 +1117,31 @@ void HttpHandlerBase::FormatStatistics(utils::statistics::Writer result,
   result = total;
 }
 
+void HttpHandlerBase::CompressResponseBody(
+    const http::HttpRequest& http_request) const {
+  auto& response = http_request.GetHttpResponse();
+  // The file bodies set with SetFileBody() are sent as is, the compressed
+  // data would take precedence over them
+  if (response.GetData().empty()) return;
+
+  response.SetHeader(USERVER_NAMESPACE::http::headers::kVary,
+                     "Accept-Encoding");
+
+  if (response.GetData().size() < GetConfig().compress_response_min_size) {
+    return;
+  }
+  if (response.HasHeader(USERVER_NAMESPACE::http::headers::kContentEncoding)) {
+    // The handler has already encoded the body by itself
+    return;
+  }
+  if (!IsGzipAccepted(http_request)) return;
+
+  response.SetData(compression::gzip::Compress(
+      response.GetData(), GetConfig().compress_response_level));
+  response.SetHeader(USERVER_NAMESPACE::http::headers::kContentEncoding,
+                     "gzip");
+}
+
 void HttpHandlerBase::SetResponseAcceptEncoding(
     http::HttpResponse& response) const {
   if (!GetConfig().decompress_request) return;
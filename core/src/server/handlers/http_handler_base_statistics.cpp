@@ -24,7 +24,17 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["rate-limit-reached"] = stats.rate_limit_reached;
   writer["deadline-received"] = stats.deadline_received;
   writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
+  writer["rejected-by-predicted-deadline"] =
+      stats.rejected_by_predicted_deadline;
   writer["timings"] = stats.timings;
+  if (stats.wait_time) writer["wait"] = *stats.wait_time;
+  if (stats.allocations) writer["allocations"] = *stats.allocations;
+}
+
+constexpr std::uint64_t kPredictionProbeInterval = 64;
+
+std::chrono::microseconds ToMicroseconds(std::chrono::nanoseconds duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration);
 }
 
 }  // namespace
@@ -36,6 +46,45 @@ void HttpHandlerMethodStatistics::Account(
   timings_.GetCurrentCounter().Account(stats.timing.count());
   if (stats.deadline.IsReachable()) ++deadline_received_;
   if (stats.cancelled_by_deadline) ++cancelled_by_deadline_;
+  if (stats.rejected_by_predicted_deadline) {
+    ++rejected_by_predicted_deadline_;
+  } else if (!stats.cancelled_by_deadline) {
+    latency_estimate_.Account(ToMicroseconds(stats.timing));
+  }
+
+  if (const auto* const wait_stats = stats.wait_stats) {
+    has_wait_stats_.store(true, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < engine::impl::kWaitReasonCount; ++i) {
+      wait_time_us_[i].Add(utils::statistics::Rate{static_cast<std::uint64_t>(
+          ToMicroseconds(wait_stats->wait_time[i]).count())});
+    }
+    queue_wait_time_us_.Add(utils::statistics::Rate{static_cast<std::uint64_t>(
+        ToMicroseconds(wait_stats->queue_wait).count())});
+    context_switches_.Add(
+        utils::statistics::Rate{wait_stats->context_switches});
+  }
+
+  if (const auto* const alloc_stats = stats.alloc_stats) {
+    has_alloc_stats_.store(true, std::memory_order_relaxed);
+    allocated_bytes_.Add(utils::statistics::Rate{alloc_stats->allocated_bytes});
+    deallocated_bytes_.Add(
+        utils::statistics::Rate{alloc_stats->deallocated_bytes});
+  }
+}
+
+bool HttpHandlerMethodStatistics::IsPredictedToMissDeadline(
+    engine::Deadline deadline,
+    const impl::PredictiveDeadlineConfig& config) noexcept {
+  if (!config.enabled || !deadline.IsReachable()) return false;
+  if (latency_estimate_.GetSamplesCount() < config.min_samples) return false;
+
+  const auto estimate = config.percentile == 50 ? latency_estimate_.GetP50()
+                                                : latency_estimate_.GetP90();
+  if (deadline.TimeLeft() >= estimate) return false;
+
+  return predicted_misses_.fetch_add(1, std::memory_order_relaxed) %
+             kPredictionProbeInterval !=
+         0;
 }
 
 std::size_t HttpHandlerMethodStatistics::GetInFlight() const noexcept {
@@ -59,7 +108,23 @@ HttpHandlerStatisticsSnapshot::HttpHandlerStatisticsSnapshot(
       too_many_requests_in_flight(stats.too_many_requests_in_flight_.Load()),
       rate_limit_reached(stats.rate_limit_reached_.Load()),
       deadline_received(stats.deadline_received_.Load()),
-      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()) {}
+      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()),
+      rejected_by_predicted_deadline(
+          stats.rejected_by_predicted_deadline_.Load()) {
+  if (stats.has_wait_stats_.load(std::memory_order_relaxed)) {
+    auto& snapshot = wait_time.emplace();
+    for (std::size_t i = 0; i < engine::impl::kWaitReasonCount; ++i) {
+      snapshot.wait_time_us[i] = stats.wait_time_us_[i].Load();
+    }
+    snapshot.queue_wait_time_us = stats.queue_wait_time_us_.Load();
+    snapshot.context_switches = stats.context_switches_.Load();
+  }
+  if (stats.has_alloc_stats_.load(std::memory_order_relaxed)) {
+    auto& snapshot = allocations.emplace();
+    snapshot.allocated_bytes = stats.allocated_bytes_.Load();
+    snapshot.deallocated_bytes = stats.deallocated_bytes_.Load();
+  }
+}
 
 void HttpHandlerStatisticsSnapshot::Add(
     const HttpHandlerStatisticsSnapshot& other) {
@@ -71,6 +136,53 @@ void HttpHandlerStatisticsSnapshot::Add(
   rate_limit_reached += other.rate_limit_reached;
   deadline_received += other.deadline_received;
   cancelled_by_deadline += other.cancelled_by_deadline;
+  rejected_by_predicted_deadline += other.rejected_by_predicted_deadline;
+  if (other.wait_time) {
+    if (wait_time) {
+      wait_time->Add(*other.wait_time);
+    } else {
+      wait_time = other.wait_time;
+    }
+  }
+  if (other.allocations) {
+    if (allocations) {
+      allocations->Add(*other.allocations);
+    } else {
+      allocations = other.allocations;
+    }
+  }
+}
+
+void HttpHandlerWaitTimeSnapshot::Add(
+    const HttpHandlerWaitTimeSnapshot& other) {
+  for (std::size_t i = 0; i < engine::impl::kWaitReasonCount; ++i) {
+    wait_time_us[i] += other.wait_time_us[i];
+  }
+  queue_wait_time_us += other.queue_wait_time_us;
+  context_switches += other.context_switches;
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const HttpHandlerWaitTimeSnapshot& stats) {
+  for (std::size_t i = 0; i < engine::impl::kWaitReasonCount; ++i) {
+    writer["time-us"].ValueWithLabels(
+        stats.wait_time_us[i],
+        {"wait_reason",
+         engine::impl::ToString(static_cast<engine::impl::WaitReason>(i))});
+  }
+  writer["queue-time-us"] = stats.queue_wait_time_us;
+  writer["context-switches"] = stats.context_switches;
+}
+
+void HttpHandlerAllocSnapshot::Add(const HttpHandlerAllocSnapshot& other) {
+  allocated_bytes += other.allocated_bytes;
+  deallocated_bytes += other.deallocated_bytes;
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const HttpHandlerAllocSnapshot& stats) {
+  writer["allocated-bytes"] = stats.allocated_bytes;
+  writer["deallocated-bytes"] = stats.deallocated_bytes;
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -112,6 +224,9 @@ HttpHandlerStatisticsScope::~HttpHandlerStatisticsScope() {
       finish_time - start_time_);
   stats.deadline = data ? data->deadline : engine::Deadline{};
   stats.cancelled_by_deadline = cancelled_by_deadline_;
+  stats.rejected_by_predicted_deadline = rejected_by_predicted_deadline_;
+  stats.wait_stats = engine::current_task::GetWaitStats();
+  stats.alloc_stats = engine::current_task::GetAllocStats();
   stats_.ForMethod(method_).Account(stats);
   stats_.ForMethod(method_).DecrementInFlight();
 }
@@ -120,6 +235,10 @@ void HttpHandlerStatisticsScope::OnCancelledByDeadline() noexcept {
   cancelled_by_deadline_ = true;
 }
 
+void HttpHandlerStatisticsScope::OnRejectedByPredictedDeadline() noexcept {
+  rejected_by_predicted_deadline_ = true;
+}
+
 }  // namespace server::handlers
 
 USERVER_NAMESPACE_END
@@ -1,14 +1,20 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <optional>
 #include <type_traits>
 
+#include <engine/task/alloc_stats.hpp>
+#include <engine/task/wait_stats.hpp>
 #include <server/http/handler_methods.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/handlers/impl/deadline_propagation_config.hpp>
 #include <userver/server/http/http_status.hpp>
+#include <userver/utils/statistics/latency_estimate.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/rate.hpp>
 #include <userver/utils/statistics/rate_counter.hpp>
@@ -25,8 +31,37 @@ struct HttpHandlerStatisticsEntry final {
   std::chrono::milliseconds timing{};
   engine::Deadline deadline{};
   bool cancelled_by_deadline{false};
+  bool rejected_by_predicted_deadline{false};
+  // nullptr if the handler does not account the off-CPU time
+  const engine::impl::TaskWaitStats* wait_stats{nullptr};
+  // nullptr if the handler does not account the heap usage
+  const engine::impl::TaskAllocStats* alloc_stats{nullptr};
 };
 
+// Off-CPU time of the requests, see engine::impl::TaskWaitStats
+struct HttpHandlerWaitTimeSnapshot final {
+  void Add(const HttpHandlerWaitTimeSnapshot& other);
+
+  std::array<utils::statistics::Rate, engine::impl::kWaitReasonCount>
+      wait_time_us;
+  utils::statistics::Rate queue_wait_time_us;
+  utils::statistics::Rate context_switches;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const HttpHandlerWaitTimeSnapshot& stats);
+
+// Heap usage of the requests, see engine::impl::TaskAllocStats
+struct HttpHandlerAllocSnapshot final {
+  void Add(const HttpHandlerAllocSnapshot& other);
+
+  utils::statistics::Rate allocated_bytes;
+  utils::statistics::Rate deallocated_bytes;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const HttpHandlerAllocSnapshot& stats);
+
 struct HttpHandlerStatisticsSnapshot;
 
 class HttpHandlerMethodStatistics final {
@@ -47,6 +82,13 @@ class HttpHandlerMethodStatistics final {
 
   void IncrementRateLimitReached() noexcept { ++rate_limit_reached_; }
 
+  // Whether the handling is expected to take longer than the time left. Every
+  // kPredictionProbeInterval-th request is let through anyway, otherwise
+  // the estimate would freeze once all the requests are rejected.
+  bool IsPredictedToMissDeadline(
+      engine::Deadline deadline,
+      const impl::PredictiveDeadlineConfig& config) noexcept;
+
  private:
   friend struct HttpHandlerStatisticsSnapshot;
 
@@ -63,6 +105,23 @@ class HttpHandlerMethodStatistics final {
   utils::statistics::RateCounter rate_limit_reached_;
   utils::statistics::RateCounter deadline_received_;
   utils::statistics::RateCounter cancelled_by_deadline_;
+  utils::statistics::RateCounter rejected_by_predicted_deadline_;
+
+  // the handling latency of the requests that were not cut by the deadline
+  utils::statistics::LatencyEstimate latency_estimate_;
+  std::atomic<std::uint64_t> predicted_misses_{0};
+
+  // the metrics are written after the first request with the wait stats
+  std::atomic<bool> has_wait_stats_{false};
+  std::array<utils::statistics::RateCounter, engine::impl::kWaitReasonCount>
+      wait_time_us_;
+  utils::statistics::RateCounter queue_wait_time_us_;
+  utils::statistics::RateCounter context_switches_;
+
+  // the metrics are written after the first request with the alloc stats
+  std::atomic<bool> has_alloc_stats_{false};
+  utils::statistics::RateCounter allocated_bytes_;
+  utils::statistics::RateCounter deallocated_bytes_;
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -84,6 +143,9 @@ struct HttpHandlerStatisticsSnapshot final {
   utils::statistics::Rate rate_limit_reached;
   utils::statistics::Rate deadline_received;
   utils::statistics::Rate cancelled_by_deadline;
+  utils::statistics::Rate rejected_by_predicted_deadline;
+  std::optional<HttpHandlerWaitTimeSnapshot> wait_time;
+  std::optional<HttpHandlerAllocSnapshot> allocations;
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -150,12 +212,15 @@ class HttpHandlerStatisticsScope final {
   //  symptom: we didn't send a normal response due to deadline expiration
   void OnCancelledByDeadline() noexcept;
 
+  void OnRejectedByPredictedDeadline() noexcept;
+
  private:
   HttpHandlerStatistics& stats_;
   const http::HttpMethod method_;
   const std::chrono::steady_clock::time_point start_time_;
   server::http::HttpResponse& response_;
   bool cancelled_by_deadline_{false};
+  bool rejected_by_predicted_deadline_{false};
 };
 
 }  // namespace server::handlers
@@ -1,5 +1,6 @@
 #include <userver/server/handlers/http_handler_json_base.hpp>
 
+#include <userver/components/component_config.hpp>
 #include <userver/formats/json/exception.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/http/content_type.hpp>
@@ -10,6 +11,7 @@
 #include <userver/server/handlers/legacy_json_error_builder.hpp>
 #include <userver/server/http/http_error.hpp>
 #include <userver/server/http/http_status.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
 #include <userver/yaml_config/schema.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +21,7 @@ namespace server::handlers {
 namespace {
 
 const std::string kRequestDataName = "__request_json";
+const std::string kLazyRequestDataName = "__lazy_request_json";
 const std::string kResponseDataName = "__response_json";
 const std::string kSerializeJson = "serialize_json";
 
@@ -27,26 +30,51 @@ const std::string kSerializeJson = "serialize_json";
 HttpHandlerJsonBase::HttpHandlerJsonBase(
     const components::ComponentConfig& config,
     const components::ComponentContext& component_context, bool is_monitor)
-    : HttpHandlerBase(config, component_context, is_monitor) {}
+    : HttpHandlerBase(config, component_context, is_monitor),
+      is_request_json_lazy_(config["lazy-request-json"].As<bool>(false)) {}
 
 std::string HttpHandlerJsonBase::HandleRequestThrow(
     const http::HttpRequest& request, request::RequestContext& context) const {
-  const auto& request_json =
-      context.GetData<const formats::json::Value&>(kRequestDataName);
-
   auto& response = request.GetHttpResponse();
   response.SetContentType(
       USERVER_NAMESPACE::http::content_type::kApplicationJson);
 
+  formats::json::Value response_json_value;
+  if (IsRequestJsonLazy()) {
+    const auto& request_json = context.GetData<const formats::json::LazyValue&>(
+        kLazyRequestDataName);
+    response_json_value =
+        HandleRequestLazyJsonThrow(request, request_json, context);
+  } else {
+    const auto& request_json =
+        context.GetData<const formats::json::Value&>(kRequestDataName);
+    response_json_value =
+        HandleRequestJsonThrow(request, request_json, context);
+  }
   const auto& response_json = context.SetData<const formats::json::Value>(
-      kResponseDataName,
-      HandleRequestJsonThrow(request, request_json, context));
+      kResponseDataName, std::move(response_json_value));
 
   const auto scope_time =
       tracing::Span::CurrentSpan().CreateScopeTime(kSerializeJson);
   return formats::json::ToString(response_json);
 }
 
+formats::json::Value HttpHandlerJsonBase::HandleRequestJsonThrow(
+    const http::HttpRequest&, const formats::json::Value&,
+    request::RequestContext&) const {
+  throw std::runtime_error(
+      "HandleRequestJsonThrow() is executed, but the handler doesn't "
+      "override HandleRequestJsonThrow().");
+}
+
+formats::json::Value HttpHandlerJsonBase::HandleRequestLazyJsonThrow(
+    const http::HttpRequest&, const formats::json::LazyValue&,
+    request::RequestContext&) const {
+  throw std::runtime_error(
+      "HandleRequestLazyJsonThrow() is executed, but the handler doesn't "
+      "override HandleRequestLazyJsonThrow().");
+}
+
 const formats::json::Value* HttpHandlerJsonBase::GetRequestJson(
     const request::RequestContext& context) {
   return context.GetDataOptional<const formats::json::Value>(kRequestDataName);
@@ -70,6 +98,22 @@ FormattedErrorData HttpHandlerJsonBase::GetFormattedExternalErrorBody(
 
 void HttpHandlerJsonBase::ParseRequestData(
     const http::HttpRequest& request, request::RequestContext& context) const {
+  if (IsRequestJsonLazy()) {
+    formats::json::LazyValue request_json;
+    try {
+      if (!request.RequestBody().empty())
+        request_json = formats::json::LazyValue{request.RequestBody()};
+    } catch (const formats::json::Exception& e) {
+      throw RequestParseError(
+          InternalMessage{"Invalid JSON body"},
+          ExternalBody{std::string("Invalid JSON body: ") + e.what()});
+    }
+
+    context.SetData<const formats::json::LazyValue>(kLazyRequestDataName,
+                                                    std::move(request_json));
+    return;
+  }
+
   formats::json::Value request_json;
   try {
     if (!request.RequestBody().empty())
@@ -84,9 +128,18 @@ void HttpHandlerJsonBase::ParseRequestData(
 }
 
 yaml_config::Schema HttpHandlerJsonBase::GetStaticConfigSchema() {
-  auto schema = HttpHandlerBase::GetStaticConfigSchema();
-  schema.UpdateDescription("HTTP handler JSON base config");
-  return schema;
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: HTTP handler JSON base config
+additionalProperties: false
+properties:
+    lazy-request-json:
+        type: boolean
+        description: |
+            pass the request body to HandleRequestLazyJsonThrow() as a
+            formats::json::LazyValue instead of parsing it
+        defaultDescription: false
+)");
 }
 
 }  // namespace server::handlers
@@ -52,8 +52,12 @@ std::string HttpHandlerStatic::HandleRequestThrow(
   const auto file = storage_.TryGetFile(request.GetRequestPath());
   if (file) {
     const auto config = config_.GetSnapshot();
-    request.GetHttpResponse().SetContentType(
-        config[kContentTypeMap][file->extension]);
+    auto& response = request.GetHttpResponse();
+    response.SetContentType(config[kContentTypeMap][file->extension]);
+    if (file->mapped_file) {
+      response.SetFileBody(file->mapped_file);
+      return {};
+    }
     return file->data;
   }
   request.GetResponse().SetStatusNotFound();
@@ -0,0 +1,221 @@
+#include <server/handlers/http_response_cache.hpp>
+
+#include <algorithm>
+#include <functional>
+
+#include <fmt/format.h>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/utils/str_icase.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+namespace headers = USERVER_NAMESPACE::http::headers;
+
+// Sent for each request anyway or describe the connection
+bool IsHeaderNotCached(std::string_view name) {
+  const utils::StrIcaseEqual equal;
+  return equal(name, headers::kDate) || equal(name, headers::kConnection) ||
+         equal(name, headers::kContentLength) ||
+         equal(name, headers::kTransferEncoding);
+}
+
+// The components are prefixed with their sizes, so that different requests
+// do not produce the same key
+void AppendKeyPart(std::string& key, std::string_view part) {
+  key += std::to_string(part.size());
+  key += ':';
+  key += part;
+}
+
+std::string_view TrimSpaces(std::string_view str) {
+  while (!str.empty() && (str.front() == ' ' || str.front() == '\t')) {
+    str.remove_prefix(1);
+  }
+  while (!str.empty() && (str.back() == ' ' || str.back() == '\t')) {
+    str.remove_suffix(1);
+  }
+  return str;
+}
+
+std::string_view GetQueryString(const std::string& url) {
+  const auto pos = url.find('?');
+  if (pos == std::string::npos) return {};
+  return std::string_view{url}.substr(pos + 1);
+}
+
+std::string_view RemoveWeakPrefix(std::string_view etag) {
+  if (utils::text::StartsWith(etag, "W/")) etag.remove_prefix(2);
+  return etag;
+}
+
+}  // namespace
+
+HttpResponseCache::HttpResponseCache(const ResponseCacheConfig& config)
+    : config_(config),
+      cache_(config.ways, std::max<std::size_t>(config.size / config.ways, 1)) {
+  cache_.SetMaxLifetime(config_.ttl);
+
+  const auto is_key_header = [this](std::string_view name) {
+    const utils::StrIcaseEqual equal;
+    return std::any_of(
+        config_.headers.begin(), config_.headers.end(),
+        [&](const std::string& header) { return equal(header, name); });
+  };
+  is_authorization_in_key_ = is_key_header(headers::kAuthorization);
+  is_cookie_in_key_ = is_key_header(headers::kCookie);
+}
+
+HttpResponseCache::~HttpResponseCache() = default;
+
+void HttpResponseCache::Handle(const http::HttpRequest& request,
+                               const std::function<void()>& handle) {
+  const auto method = request.GetMethod();
+  if ((method != http::HttpMethod::kGet &&
+       method != http::HttpMethod::kHead) ||
+      HasPrivateCredentials(request)) {
+    handle();
+    return;
+  }
+
+  auto& response = request.GetHttpResponse();
+  const auto key = MakeKey(request);
+  bool is_updater = false;
+  const auto cached = cache_.Get(key, [&](const std::string&) {
+    is_updater = true;
+    handle();
+    return MakeCachedResponse(response);
+  });
+
+  if (!cached) {
+    if (is_updater) {
+      // Not cacheable, do not keep the empty value
+      cache_.InvalidateByKey(key);
+    } else {
+      handle();
+    }
+    return;
+  }
+
+  if (is_updater) {
+    // The response has been filled by the handler
+    if (!response.HasHeader(headers::kETag)) {
+      response.SetHeader(headers::kETag, cached->etag);
+    }
+  }
+
+  if (MatchesETag(request.GetHeader(headers::kIfNoneMatch), cached->etag)) {
+    response.SetStatus(http::HttpStatus::kNotModified);
+    if (!is_updater) response.SetHeader(headers::kETag, cached->etag);
+    response.SetData({});
+    return;
+  }
+
+  if (!is_updater) {
+    response.SetStatus(cached->status);
+    response.SetPreparedHeaders(cached->headers);
+    response.SetData(cached->body);
+  }
+}
+
+void HttpResponseCache::WriteStatistics(
+    utils::statistics::Writer writer) const {
+  cache::DumpMetric(writer, cache_);
+}
+
+std::string HttpResponseCache::MakeKey(const http::HttpRequest& request) const {
+  std::string key;
+  // The responses to HEAD have no body and must not be served for GET
+  AppendKeyPart(key, http::ToString(request.GetMethod()));
+  AppendKeyPart(key, request.GetRequestPath());
+  if (config_.args.empty()) {
+    AppendKeyPart(key, GetQueryString(request.GetUrl()));
+  }
+  for (const auto& arg : config_.args) {
+    const auto& values = request.GetArgVector(arg);
+    key += std::to_string(values.size());
+    key += '#';
+    for (const auto& value : values) AppendKeyPart(key, value);
+  }
+  for (const auto& header : config_.headers) {
+    AppendKeyPart(key, request.GetHeader(header));
+  }
+  return key;
+}
+
+bool HttpResponseCache::HasPrivateCredentials(
+    const http::HttpRequest& request) const {
+  return (!is_authorization_in_key_ &&
+          request.HasHeader(headers::kAuthorization)) ||
+         (!is_cookie_in_key_ && request.HasHeader(headers::kCookie));
+}
+
+HttpResponseCache::CachedResponsePtr HttpResponseCache::MakeCachedResponse(
+    const http::HttpResponse& response) const {
+  if (response.GetStatus() != http::HttpStatus::kOk ||
+      response.IsBodyStreamed() ||
+      response.GetData().size() > config_.max_body_size ||
+      response.GetCookieNames().begin() != response.GetCookieNames().end() ||
+      response.HasHeader(headers::kContentEncoding)) {
+    return nullptr;
+  }
+  const auto& cache_control = response.GetHeader(headers::kCacheControl);
+  if (cache_control.find("no-store") != std::string::npos ||
+      cache_control.find("private") != std::string::npos) {
+    return nullptr;
+  }
+
+  auto cached = std::make_shared<CachedResponse>();
+  cached->status = response.GetStatus();
+  cached->body = response.GetData();
+  cached->etag = response.GetHeader(headers::kETag);
+  if (cached->etag.empty()) cached->etag = MakeETag(cached->body);
+
+  // The static headers of the handler are cached along with the ones set by
+  // the handler, the latter take precedence
+  http::HttpResponse::HeadersMap headers;
+  if (const auto& prepared = response.GetPreparedHeaders()) {
+    headers = prepared->headers;
+  }
+  for (const auto& name : response.GetHeaderNames()) {
+    if (IsHeaderNotCached(name)) continue;
+    headers.insert_or_assign(name, response.GetHeader(name));
+  }
+  headers.insert_or_assign(headers::kETag, cached->etag);
+
+  auto prepared = http::HttpResponse::MakePreparedHeaders(std::move(headers));
+  cached->headers = std::move(prepared);
+  return cached;
+}
+
+bool MatchesETag(std::string_view if_none_match, std::string_view etag) {
+  if_none_match = TrimSpaces(if_none_match);
+  if (if_none_match.empty() || etag.empty()) return false;
+  if (if_none_match == "*") return true;
+
+  etag = RemoveWeakPrefix(etag);
+  while (!if_none_match.empty()) {
+    const auto comma = if_none_match.find(',');
+    const auto candidate = TrimSpaces(if_none_match.substr(0, comma));
+    if (RemoveWeakPrefix(candidate) == etag) return true;
+    if (comma == std::string_view::npos) break;
+    if_none_match.remove_prefix(comma + 1);
+  }
+  return false;
+}
+
+std::string MakeETag(std::string_view body) {
+  return fmt::format("\"{:x}-{:016x}\"", body.size(),
+                     std::hash<std::string_view>{}(body));
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/server/handlers/handler_config.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+class HttpRequest;
+}  // namespace server::http
+
+namespace server::handlers {
+
+/// Cache of the non-streamed responses of a handler, keyed by the method, the
+/// path, the query string or the selected query arguments, and the selected
+/// request headers. Concurrent misses of a key are coalesced, so the handler
+/// computes the response once. The requests with `Authorization` or `Cookie`
+/// headers bypass the cache, unless the header is a part of the key.
+class HttpResponseCache final {
+ public:
+  explicit HttpResponseCache(const ResponseCacheConfig& config);
+  ~HttpResponseCache();
+
+  /// Serves the response from the cache, calls `handle` to fill the response
+  /// of the request on a miss or if the request is not cacheable. Answers
+  /// with 304 Not Modified if `If-None-Match` matches the ETag.
+  void Handle(const http::HttpRequest& request,
+              const std::function<void()>& handle);
+
+  void WriteStatistics(utils::statistics::Writer writer) const;
+
+ private:
+  struct CachedResponse {
+    http::HttpStatus status{http::HttpStatus::kOk};
+    std::shared_ptr<const http::HttpResponse::PreparedHeaders> headers;
+    std::string body;
+    std::string etag;
+  };
+
+  using CachedResponsePtr = std::shared_ptr<const CachedResponse>;
+
+  std::string MakeKey(const http::HttpRequest& request) const;
+
+  // The response may depend on the user, so it must not be shared
+  bool HasPrivateCredentials(const http::HttpRequest& request) const;
+
+  // nullptr if the response should not be cached
+  CachedResponsePtr MakeCachedResponse(
+      const http::HttpResponse& response) const;
+
+  const ResponseCacheConfig config_;
+  bool is_authorization_in_key_{false};
+  bool is_cookie_in_key_{false};
+  cache::ExpirableLruCache<std::string, CachedResponsePtr> cache_;
+};
+
+/// @returns true if the value of the `If-None-Match` request header matches
+/// the `etag` according to the weak comparison of RFC 9110
+bool MatchesETag(std::string_view if_none_match, std::string_view etag);
+
+/// @returns a strong ETag of the body
+std::string MakeETag(std::string_view body);
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
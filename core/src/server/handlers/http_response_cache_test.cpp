@@ -0,0 +1,280 @@
+#include <server/handlers/http_response_cache.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <server/http/create_parser_test.hpp>
+#include <server/http/http_request_impl.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_response_cookie.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace sh = server::handlers;
+namespace headers = http::headers;
+
+namespace {
+
+using server::http::HttpResponse;
+using server::http::HttpStatus;
+
+std::shared_ptr<server::http::HttpRequestImpl> ParseRequest(
+    std::string_view raw) {
+  std::shared_ptr<server::request::RequestBase> parsed;
+  auto parser = server::CreateTestParser(
+      [&parsed](std::shared_ptr<server::request::RequestBase>&& request) {
+        parsed = std::move(request);
+      });
+  parser.Parse(raw.data(), raw.size());
+  return std::dynamic_pointer_cast<server::http::HttpRequestImpl>(parsed);
+}
+
+// A handler behind the cache that counts its calls and answers with the
+// number of the call
+class CachedHandler final {
+ public:
+  explicit CachedHandler(sh::ResponseCacheConfig config = {})
+      : cache_(config) {}
+
+  std::shared_ptr<server::http::HttpRequestImpl> Handle(std::string_view raw) {
+    auto request_impl = ParseRequest(raw);
+    EXPECT_TRUE(request_impl);
+    const server::http::HttpRequest request{*request_impl};
+    cache_.Handle(request, [this, &request] {
+      auto& response = request.GetHttpResponse();
+      response.SetStatus(HttpStatus::kOk);
+      response.SetData(fmt::format("response-{}", ++calls_));
+      if (customize_) customize_(response);
+    });
+    return request_impl;
+  }
+
+  void SetCustomize(std::function<void(HttpResponse&)> customize) {
+    customize_ = std::move(customize);
+  }
+
+  int GetCalls() const { return calls_; }
+
+ private:
+  sh::HttpResponseCache cache_;
+  std::function<void(HttpResponse&)> customize_;
+  int calls_{0};
+};
+
+const std::string& GetBody(server::http::HttpRequestImpl& request) {
+  return request.GetHttpResponse().GetData();
+}
+
+}  // namespace
+
+TEST(HttpResponseCache, MatchesETag) {
+  EXPECT_TRUE(sh::MatchesETag("\"abc\"", "\"abc\""));
+  EXPECT_TRUE(sh::MatchesETag("*", "\"abc\""));
+  EXPECT_TRUE(sh::MatchesETag(" \"x\" , W/\"abc\"", "\"abc\""));
+  EXPECT_TRUE(sh::MatchesETag("\"abc\"", "W/\"abc\""));
+
+  EXPECT_FALSE(sh::MatchesETag("", "\"abc\""));
+  EXPECT_FALSE(sh::MatchesETag("\"abc\"", ""));
+  EXPECT_FALSE(sh::MatchesETag("\"ab\", \"abcd\"", "\"abc\""));
+  EXPECT_FALSE(sh::MatchesETag("abc", "\"abc\""));
+}
+
+TEST(HttpResponseCache, MakeETag) {
+  const auto etag = sh::MakeETag("hello");
+  EXPECT_EQ(etag.front(), '"');
+  EXPECT_EQ(etag.back(), '"');
+  EXPECT_EQ(etag, sh::MakeETag("hello"));
+  EXPECT_NE(etag, sh::MakeETag("hello!"));
+  EXPECT_TRUE(sh::MatchesETag(etag, etag));
+}
+
+UTEST(HttpResponseCache, HitAndMiss) {
+  CachedHandler handler;
+
+  const auto first = handler.Handle("GET /x HTTP/1.1\r\n\r\n");
+  EXPECT_EQ(GetBody(*first), "response-1");
+  EXPECT_EQ(first->GetHttpResponse().GetStatus(), HttpStatus::kOk);
+
+  const auto second = handler.Handle("GET /x HTTP/1.1\r\n\r\n");
+  EXPECT_EQ(GetBody(*second), "response-1");
+  EXPECT_EQ(second->GetHttpResponse().GetStatus(), HttpStatus::kOk);
+  EXPECT_EQ(handler.GetCalls(), 1);
+
+  EXPECT_EQ(GetBody(*handler.Handle("GET /y HTTP/1.1\r\n\r\n")), "response-2");
+  EXPECT_EQ(handler.GetCalls(), 2);
+}
+
+UTEST(HttpResponseCache, QueryStringInKey) {
+  CachedHandler handler;
+
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x?id=1 HTTP/1.1\r\n\r\n")),
+            "response-1");
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x?id=2 HTTP/1.1\r\n\r\n")),
+            "response-2");
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\n\r\n")),
+            "response-3");
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x?id=1 HTTP/1.1\r\n\r\n")),
+            "response-1");
+  EXPECT_EQ(handler.GetCalls(), 3);
+}
+
+UTEST(HttpResponseCache, ConfiguredArgsInKey) {
+  sh::ResponseCacheConfig config;
+  config.args = {"id"};
+  CachedHandler handler{config};
+
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x?id=1&t=1 HTTP/1.1\r\n\r\n")),
+            "response-1");
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x?t=2&id=1 HTTP/1.1\r\n\r\n")),
+            "response-1");
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x?id=2&t=1 HTTP/1.1\r\n\r\n")),
+            "response-2");
+  EXPECT_EQ(handler.GetCalls(), 2);
+}
+
+UTEST(HttpResponseCache, ConfiguredHeadersInKey) {
+  sh::ResponseCacheConfig config;
+  config.headers = {"X-Lang"};
+  CachedHandler handler{config};
+
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\nX-Lang: en\r\n\r\n")),
+            "response-1");
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\nX-Lang: ru\r\n\r\n")),
+            "response-2");
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\nX-Lang: en\r\n\r\n")),
+            "response-1");
+  EXPECT_EQ(handler.GetCalls(), 2);
+}
+
+UTEST(HttpResponseCache, PrivateRequestsBypass) {
+  CachedHandler handler;
+
+  EXPECT_EQ(GetBody(*handler.Handle(
+                "GET /x HTTP/1.1\r\nAuthorization: Bearer a\r\n\r\n")),
+            "response-1");
+  EXPECT_EQ(GetBody(*handler.Handle(
+                "GET /x HTTP/1.1\r\nAuthorization: Bearer b\r\n\r\n")),
+            "response-2");
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\nCookie: a=b\r\n\r\n")),
+            "response-3");
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\nCookie: a=c\r\n\r\n")),
+            "response-4");
+
+  // The responses to the private requests were not cached
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\n\r\n")), "response-5");
+  EXPECT_EQ(handler.GetCalls(), 5);
+}
+
+UTEST(HttpResponseCache, AuthorizationInKey) {
+  sh::ResponseCacheConfig config;
+  config.headers = {"authorization"};
+  CachedHandler handler{config};
+
+  EXPECT_EQ(GetBody(*handler.Handle(
+                "GET /x HTTP/1.1\r\nAuthorization: Bearer a\r\n\r\n")),
+            "response-1");
+  EXPECT_EQ(GetBody(*handler.Handle(
+                "GET /x HTTP/1.1\r\nAuthorization: Bearer b\r\n\r\n")),
+            "response-2");
+  EXPECT_EQ(GetBody(*handler.Handle(
+                "GET /x HTTP/1.1\r\nAuthorization: Bearer a\r\n\r\n")),
+            "response-1");
+
+  // Cookie is still not a part of the key
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\nAuthorization: Bearer "
+                                    "a\r\nCookie: a=b\r\n\r\n")),
+            "response-3");
+  EXPECT_EQ(handler.GetCalls(), 3);
+}
+
+UTEST(HttpResponseCache, IfNoneMatch) {
+  CachedHandler handler;
+
+  const auto first = handler.Handle("GET /x HTTP/1.1\r\n\r\n");
+  const auto etag = first->GetHttpResponse().GetHeader(headers::kETag);
+  ASSERT_FALSE(etag.empty());
+  EXPECT_EQ(etag, sh::MakeETag("response-1"));
+
+  const auto not_modified = handler.Handle(
+      fmt::format("GET /x HTTP/1.1\r\nIf-None-Match: {}\r\n\r\n", etag));
+  EXPECT_EQ(not_modified->GetHttpResponse().GetStatus(),
+            HttpStatus::kNotModified);
+  EXPECT_EQ(GetBody(*not_modified), "");
+  EXPECT_EQ(not_modified->GetHttpResponse().GetHeader(headers::kETag), etag);
+
+  const auto modified = handler.Handle(
+      "GET /x HTTP/1.1\r\nIf-None-Match: \"other\"\r\n\r\n");
+  EXPECT_EQ(modified->GetHttpResponse().GetStatus(), HttpStatus::kOk);
+  EXPECT_EQ(GetBody(*modified), "response-1");
+  EXPECT_EQ(handler.GetCalls(), 1);
+}
+
+UTEST(HttpResponseCache, HeadAndGetAreSeparate) {
+  CachedHandler handler;
+
+  EXPECT_EQ(GetBody(*handler.Handle("HEAD /x HTTP/1.1\r\n\r\n")), "response-1");
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\n\r\n")), "response-2");
+  EXPECT_EQ(GetBody(*handler.Handle("HEAD /x HTTP/1.1\r\n\r\n")), "response-1");
+  EXPECT_EQ(handler.GetCalls(), 2);
+}
+
+UTEST(HttpResponseCache, NotCacheableMethods) {
+  CachedHandler handler;
+
+  EXPECT_EQ(GetBody(*handler.Handle(
+                "POST /x HTTP/1.1\r\nContent-Length: 0\r\n\r\n")),
+            "response-1");
+  EXPECT_EQ(GetBody(*handler.Handle(
+                "POST /x HTTP/1.1\r\nContent-Length: 0\r\n\r\n")),
+            "response-2");
+  EXPECT_EQ(handler.GetCalls(), 2);
+}
+
+UTEST(HttpResponseCache, NotCacheableResponses) {
+  const std::function<void(HttpResponse&)> not_cacheable[] = {
+      [](HttpResponse& response) {
+        response.SetStatus(HttpStatus::kInternalServerError);
+      },
+      [](HttpResponse& response) {
+        response.SetHeader(headers::kCacheControl, std::string{"no-store"});
+      },
+      [](HttpResponse& response) {
+        response.SetHeader(headers::kCacheControl, std::string{"private"});
+      },
+      [](HttpResponse& response) {
+        response.SetHeader(headers::kContentEncoding, std::string{"gzip"});
+      },
+      [](HttpResponse& response) {
+        response.SetCookie(server::http::Cookie{"session", "secret"});
+      },
+  };
+
+  for (const auto& customize : not_cacheable) {
+    CachedHandler handler;
+    handler.SetCustomize(customize);
+    EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\n\r\n")),
+              "response-1");
+    EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\n\r\n")),
+              "response-2");
+    EXPECT_EQ(handler.GetCalls(), 2);
+  }
+}
+
+UTEST(HttpResponseCache, TooBigBody) {
+  sh::ResponseCacheConfig config;
+  config.max_body_size = 5;
+  CachedHandler handler{config};
+
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\n\r\n")), "response-1");
+  EXPECT_EQ(GetBody(*handler.Handle("GET /x HTTP/1.1\r\n\r\n")), "response-2");
+  EXPECT_EQ(handler.GetCalls(), 2);
+}
+
+USERVER_NAMESPACE_END
@@ -33,6 +33,25 @@ const dynamic_config::Key<CcCustomStatus> kCcCustomStatus{
 const dynamic_config::Key<bool> kStreamApiEnabled{
     "USERVER_HANDLER_STREAM_API_ENABLED", false};
 
+QueueDelayCcConfig Parse(const formats::json::Value& value,
+                         formats::parse::To<QueueDelayCcConfig>) {
+  const QueueDelayCcConfig defaults;
+  return QueueDelayCcConfig{
+      value["enabled"].As<bool>(defaults.enabled),
+      std::chrono::milliseconds{
+          value["target-delay-ms"].As<std::chrono::milliseconds::rep>(
+              defaults.target_delay.count())},
+      std::chrono::milliseconds{
+          value["interval-ms"].As<std::chrono::milliseconds::rep>(
+              defaults.interval.count())},
+  };
+}
+
+const dynamic_config::Key<QueueDelayCcConfig> kQueueDelayCcConfig{
+    "USERVER_QUEUE_DELAY_CCONTROL",
+    dynamic_config::DefaultAsJsonString{"{}"},
+};
+
 }  // namespace server::handlers
 
 USERVER_NAMESPACE_END
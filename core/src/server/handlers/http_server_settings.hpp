@@ -27,6 +27,17 @@ extern const dynamic_config::Key<CcCustomStatus> kCcCustomStatus;
 
 extern const dynamic_config::Key<bool> kStreamApiEnabled;
 
+struct QueueDelayCcConfig final {
+  bool enabled{false};
+  std::chrono::milliseconds target_delay{5};
+  std::chrono::milliseconds interval{100};
+};
+
+QueueDelayCcConfig Parse(const formats::json::Value& value,
+                         formats::parse::To<QueueDelayCcConfig>);
+
+extern const dynamic_config::Key<QueueDelayCcConfig> kQueueDelayCcConfig;
+
 }  // namespace server::handlers
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,9 @@
 #include <userver/server/handlers/impl/deadline_propagation_config.hpp>
 
+#include <stdexcept>
+
 #include <userver/dynamic_config/value.hpp>
+#include <userver/formats/json/value.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -9,6 +12,26 @@ namespace server::handlers::impl {
 const dynamic_config::Key<bool> kDeadlinePropagationEnabled{
     "USERVER_DEADLINE_PROPAGATION_ENABLED", true};
 
+PredictiveDeadlineConfig Parse(const formats::json::Value& value,
+                               formats::parse::To<PredictiveDeadlineConfig>) {
+  const PredictiveDeadlineConfig defaults;
+  PredictiveDeadlineConfig config{
+      value["enabled"].As<bool>(defaults.enabled),
+      value["percentile"].As<int>(defaults.percentile),
+      value["min-samples"].As<std::uint64_t>(defaults.min_samples),
+  };
+  if (config.percentile != 50 && config.percentile != 90) {
+    throw std::runtime_error(
+        "USERVER_DEADLINE_PREDICTIVE_SHEDDING.percentile must be 50 or 90");
+  }
+  return config;
+}
+
+const dynamic_config::Key<PredictiveDeadlineConfig> kPredictiveDeadlineConfig{
+    "USERVER_DEADLINE_PREDICTIVE_SHEDDING",
+    dynamic_config::DefaultAsJsonString{"{}"},
+};
+
 }  // namespace server::handlers::impl
 
 USERVER_NAMESPACE_END
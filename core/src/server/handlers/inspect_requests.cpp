@@ -5,6 +5,7 @@
 #include <server/http/http_request_impl.hpp>
 #include <server/requests_view.hpp>
 #include <userver/server/component.hpp>
+#include <userver/utils/from_string.hpp>
 #include <userver/yaml_config/schema.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -77,9 +78,22 @@ formats::json::Value InspectRequests::HandleRequestJsonThrow(
     const http::HttpRequest& request, const formats::json::Value&,
     request::RequestContext&) const {
   const bool with_body = !request.GetArg("body").empty();
+  const auto& slowest = request.GetArg("slowest");
 
   formats::json::ValueBuilder result(formats::json::Type::kArray);
-  auto requests = view_.GetAllRequests();
+  std::vector<std::shared_ptr<request::RequestBase>> requests;
+  if (slowest.empty()) {
+    requests = view_.GetAllRequests();
+  } else {
+    std::size_t count = 0;
+    try {
+      count = utils::FromString<std::size_t>(slowest);
+    } catch (const std::exception&) {
+      const std::string message = "invalid 'slowest' argument: " + slowest;
+      throw ClientError(InternalMessage{message}, ExternalBody{message});
+    }
+    requests = view_.GetSlowestRequests(count);
+  }
   LOG_INFO() << "Got " << requests.size() << " requests";
   for (const auto& base_request : requests) {
     /* TODO: change if we support non-HTTP requests */
@@ -1,9 +1,13 @@
 #include <userver/server/handlers/server_monitor.hpp>
 
+#include <mutex>
+
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/http/common_headers.hpp>
 #include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
 #include <userver/utils/statistics/graphite.hpp>
 #include <userver/utils/statistics/json.hpp>
 #include <userver/utils/statistics/pretty_format.hpp>
@@ -55,19 +59,30 @@ StatsFormat ParseFormat(std::string_view format) {
                   format, kToFormat.DescribeFirst())});
 }
 
-}  // namespace
+bool IsPrometheus(StatsFormat format) noexcept {
+  return format == StatsFormat::kPrometheus ||
+         format == StatsFormat::kPrometheusUntyped;
+}
 
-ServerMonitor::ServerMonitor(
-    const components::ComponentConfig& config,
-    const components::ComponentContext& component_context)
-    : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
-      statistics_storage_(
-          component_context.FindComponent<components::StatisticsStorage>()
-              .GetStorage()),
-      common_labels_{config["common-labels"].As<CommonLabels>({})} {}
+std::string_view GetContentType(StatsFormat format) noexcept {
+  switch (format) {
+    case StatsFormat::kJson:
+    case StatsFormat::kSolomon:
+    case StatsFormat::kInternal:
+      return "application/json";
+    default:
+      return "text/plain; charset=utf-8";
+  }
+}
 
-std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
-                                              request::RequestContext&) const {
+struct ParsedRequest {
+  StatsFormat format;
+  utils::statistics::Request statistics_request;
+};
+
+ParsedRequest ParseRequest(
+    const http::HttpRequest& request,
+    const std::unordered_map<std::string, std::string>& common_labels) {
   const auto& prefix = request.GetArg("prefix");
   const auto& path = request.GetArg("path");
   if (!path.empty() && !prefix.empty() && path != prefix) {
@@ -87,52 +102,125 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
   const auto format = ParseFormat(request.GetArg("format"));
 
   using utils::statistics::Request;
-  auto common_labels =
-      format == StatsFormat::kSolomon ? Request::AddLabels{} : common_labels_;
-  const auto statistics_request =
-      (path.empty() ? Request::MakeWithPrefix(prefix, std::move(common_labels),
-                                              std::move(labels))
-                    : Request::MakeWithPath(path, std::move(common_labels),
-                                            std::move(labels)));
-
-  request.GetHttpResponse().SetContentType("text/plain; charset=utf-8");
+  auto add_labels =
+      format == StatsFormat::kSolomon ? Request::AddLabels{} : common_labels;
+  return {format,
+          path.empty() ? Request::MakeWithPrefix(prefix, std::move(add_labels),
+                                                 std::move(labels))
+                       : Request::MakeWithPath(path, std::move(add_labels),
+                                               std::move(labels))};
+}
+
+std::string FormatNonPrometheus(
+    StatsFormat format, const utils::statistics::Storage& statistics_storage,
+    const std::unordered_map<std::string, std::string>& common_labels,
+    const utils::statistics::Request& statistics_request) {
   switch (format) {
     case StatsFormat::kGraphite:
-      return utils::statistics::ToGraphiteFormat(statistics_storage_,
+      return utils::statistics::ToGraphiteFormat(statistics_storage,
                                                  statistics_request);
 
-    case StatsFormat::kPrometheus:
-      return utils::statistics::ToPrometheusFormat(statistics_storage_,
-                                                   statistics_request);
-
-    case StatsFormat::kPrometheusUntyped:
-      return utils::statistics::ToPrometheusFormatUntyped(statistics_storage_,
-                                                          statistics_request);
-
     case StatsFormat::kJson:
-      request.GetHttpResponse().SetContentType("application/json");
-      return utils::statistics::ToJsonFormat(statistics_storage_,
+      return utils::statistics::ToJsonFormat(statistics_storage,
                                              statistics_request);
 
     case StatsFormat::kPretty:
-      return utils::statistics::ToPrettyFormat(statistics_storage_,
+      return utils::statistics::ToPrettyFormat(statistics_storage,
                                                statistics_request);
 
     case StatsFormat::kSolomon:
-      request.GetHttpResponse().SetContentType("application/json");
       return utils::statistics::ToSolomonFormat(
-          statistics_storage_, common_labels_, statistics_request);
+          statistics_storage, common_labels, statistics_request);
 
-    case StatsFormat::kInternal:
-      request.GetHttpResponse().SetContentType("application/json");
-      const auto json = statistics_storage_.GetAsJson();
+    case StatsFormat::kInternal: {
+      const auto json = statistics_storage.GetAsJson();
       UASSERT(utils::statistics::AreAllMetricsNumbers(json));
       return formats::json::ToString(json);
+    }
+
+    case StatsFormat::kPrometheus:
+    case StatsFormat::kPrometheusUntyped:
+      break;
   }
 
   UINVARIANT(false, "Unexpected 'format' value");
 }
 
+}  // namespace
+
+ServerMonitor::ServerMonitor(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& component_context)
+    : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
+      statistics_storage_(
+          component_context.FindComponent<components::StatisticsStorage>()
+              .GetStorage()),
+      common_labels_{config["common-labels"].As<CommonLabels>({})} {}
+
+std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
+                                              request::RequestContext&) const {
+  const auto [format, statistics_request] =
+      ParseRequest(request, common_labels_);
+
+  request.GetHttpResponse().SetContentType(std::string{GetContentType(format)});
+  if (IsPrometheus(format)) {
+    std::string result;
+    FormatPrometheus(format == StatsFormat::kPrometheus, statistics_request,
+                     [&result](std::string&& chunk) { result.append(chunk); });
+    return result;
+  }
+  return FormatNonPrometheus(format, statistics_storage_, common_labels_,
+                             statistics_request);
+}
+
+void ServerMonitor::HandleStreamRequest(
+    const http::HttpRequest& request, request::RequestContext&,
+    http::ResponseBodyStream& response_body_stream) const {
+  const auto [format, statistics_request] =
+      ParseRequest(request, common_labels_);
+
+  response_body_stream.SetStatusCode(http::HttpStatus::kOk);
+  response_body_stream.SetHeader(USERVER_NAMESPACE::http::headers::kContentType,
+                                 std::string{GetContentType(format)});
+  response_body_stream.SetEndOfHeaders();
+
+  if (IsPrometheus(format)) {
+    FormatPrometheus(format == StatsFormat::kPrometheus, statistics_request,
+                     [&response_body_stream](std::string&& chunk) {
+                       response_body_stream.PushBodyChunk(std::move(chunk),
+                                                          engine::Deadline{});
+                     });
+    return;
+  }
+  response_body_stream.PushBodyChunk(
+      FormatNonPrometheus(format, statistics_storage_, common_labels_,
+                          statistics_request),
+      engine::Deadline{});
+}
+
+void ServerMonitor::FormatPrometheus(
+    bool typed, const utils::statistics::Request& statistics_request,
+    utils::function_ref<void(std::string&&)> consumer) const {
+  const auto format_with_cache =
+      [&](utils::statistics::PrometheusFormatCache& cache) {
+        if (typed) {
+          utils::statistics::ToPrometheusFormat(
+              statistics_storage_, statistics_request, cache, consumer);
+        } else {
+          utils::statistics::ToPrometheusFormatUntyped(
+              statistics_storage_, statistics_request, cache, consumer);
+        }
+      };
+
+  std::unique_lock lock{prometheus_cache_mutex_, std::try_to_lock};
+  if (lock.owns_lock()) {
+    format_with_cache(prometheus_cache_);
+  } else {
+    utils::statistics::PrometheusFormatCache cache;
+    format_with_cache(cache);
+  }
+}
+
 std::string ServerMonitor::GetResponseDataForLogging(const http::HttpRequest&,
                                                      request::RequestContext&,
                                                      const std::string&) const {
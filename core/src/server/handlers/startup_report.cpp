@@ -0,0 +1,57 @@
+#include <userver/server/handlers/startup_report.hpp>
+
+#include <userver/components/component_context.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+#include <components/manager.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+StartupReport::StartupReport(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& component_context)
+    : HttpHandlerJsonBase(config, component_context, /* is_monitor = */ true),
+      manager_(component_context.GetManager()) {}
+
+formats::json::Value StartupReport::HandleRequestJsonThrow(
+    const http::HttpRequest&, const formats::json::Value&,
+    request::RequestContext&) const {
+  const auto report = manager_.GetStartupReport();
+
+  formats::json::ValueBuilder result(formats::json::Type::kObject);
+  result["load-ms"] = manager_.GetLoadDuration().count();
+
+  formats::json::ValueBuilder critical_path(formats::json::Type::kArray);
+  for (const auto& name : report.critical_path) critical_path.PushBack(name);
+  result["critical-path"] = std::move(critical_path);
+
+  formats::json::ValueBuilder components(formats::json::Type::kArray);
+  for (const auto& component : report.components) {
+    formats::json::ValueBuilder component_json(formats::json::Type::kObject);
+    component_json["name"] = component.name;
+    component_json["create-start-ms"] = component.create_start.count();
+    component_json["create-ms"] = component.create_duration.count();
+    component_json["dependencies-wait-ms"] =
+        component.dependencies_wait.count();
+    component_json["on-all-components-loaded-ms"] =
+        component.on_all_components_loaded.count();
+    component_json["critical-path"] = component.is_on_critical_path;
+    components.PushBack(std::move(component_json));
+  }
+  result["components"] = std::move(components);
+
+  return result.ExtractValue();
+}
+
+yaml_config::Schema StartupReport::GetStaticConfigSchema() {
+  auto schema = HttpHandlerBase::GetStaticConfigSchema();
+  schema.UpdateDescription("handler-startup-report config");
+  return schema;
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
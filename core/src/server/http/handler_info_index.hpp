@@ -3,8 +3,12 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/server/handlers/fallback_handlers.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
@@ -27,6 +31,10 @@ struct HandlerInfo {
 struct MatchRequestResult {
   enum class Status { kHandlerNotFound, kMethodNotAllowed, kOk };
 
+  /// Names point into the index, values point into the matched path
+  using PathArgs = boost::container::small_vector<
+      std::pair<std::string_view, std::string_view>, 8>;
+
   MatchRequestResult() = default;
   explicit MatchRequestResult(const HandlerInfo& handler_info)
       : handler_info(&handler_info) {}
@@ -34,7 +42,7 @@ struct MatchRequestResult {
   const HandlerInfo* handler_info = nullptr;
   size_t matched_path_length = 0;
   Status status = Status::kHandlerNotFound;
-  std::vector<std::pair<std::string, std::string>> args_from_path;
+  PathArgs args_from_path;
 };
 
 class HandlerInfoIndex final {
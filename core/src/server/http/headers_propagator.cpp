@@ -6,8 +6,20 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
+namespace {
+
+std::vector<USERVER_NAMESPACE::http::headers::PredefinedHeader>
+MakePredefinedHeaders(const std::vector<std::string>& names) {
+  std::vector<USERVER_NAMESPACE::http::headers::PredefinedHeader> result;
+  result.reserve(names.size());
+  for (const auto& name : names) result.emplace_back(name);
+  return result;
+}
+
+}  // namespace
+
 HeadersPropagator::HeadersPropagator(std::vector<std::string>&& headers)
-    : headers_(std::move(headers)) {}
+    : names_(std::move(headers)), headers_(MakePredefinedHeaders(names_)) {}
 
 void HeadersPropagator::PropagateHeaders(
     clients::http::RequestTracingEditor request) const {
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include <userver/clients/http/request_tracing_editor.hpp>
+#include <userver/http/predefined_header.hpp>
 #include <userver/server/http/http_request.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -14,10 +15,17 @@ class HeadersPropagator final {
  public:
   explicit HeadersPropagator(std::vector<std::string>&&);
 
+  HeadersPropagator(const HeadersPropagator&) = delete;
+  HeadersPropagator& operator=(const HeadersPropagator&) = delete;
+
   void PropagateHeaders(clients::http::RequestTracingEditor request) const;
 
  private:
-  const std::vector<std::string> headers_;
+  // Owns the names of headers_
+  const std::vector<std::string> names_;
+  // The hashes are computed once instead of on each lookup of each request
+  const std::vector<USERVER_NAMESPACE::http::headers::PredefinedHeader>
+      headers_;
 };
 
 }  // namespace server::http
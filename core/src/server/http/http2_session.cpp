@@ -0,0 +1,627 @@
+#include "http2_session.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+#include "http_request_constructor.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+// Output is gathered into the buffer to send several frames with a single
+// syscall
+constexpr std::size_t kMaxBufferedOutput = 64 * 1024;
+
+void CheckNghttp2(int rv, std::string_view what) {
+  if (rv != 0) {
+    throw std::runtime_error(
+        fmt::format("Failed to {}: {}", what, nghttp2_strerror(rv)));
+  }
+}
+
+template <typename Func>
+int CallNoexcept(Func&& func) noexcept {
+  try {
+    return func();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "HTTP/2 session callback failed: " << ex;
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  }
+}
+
+bool IsEndStream(const nghttp2_frame& frame) {
+  return (frame.hd.type == NGHTTP2_HEADERS || frame.hd.type == NGHTTP2_DATA) &&
+         (frame.hd.flags & NGHTTP2_FLAG_END_STREAM);
+}
+
+bool IsRequestHeaders(const nghttp2_frame& frame) {
+  return frame.hd.type == NGHTTP2_HEADERS &&
+         frame.headers.cat == NGHTTP2_HCAT_REQUEST;
+}
+
+}  // namespace
+
+struct Http2Session::Stream final {
+  explicit Stream(std::int32_t id) : id(id) {}
+
+  const std::int32_t id;
+
+  // Request, reset once the request is passed to on_new_request_cb_
+  std::optional<HttpRequestConstructor> request_constructor;
+  HttpMethod method{HttpMethod::kUnknown};
+  std::string authority;
+  bool is_url_complete{false};
+
+  // Unsent part of the response body
+  std::string_view body;
+  // Storage for the current part of the streamed body
+  std::string body_part;
+  bool is_body_complete{true};
+  std::size_t sent_bytes{0};
+
+  // The end of the response was written to out_buffer_
+  bool is_response_complete{false};
+  // The end of the response was written to the socket
+  bool is_sent{false};
+  bool is_closed{false};
+
+  engine::SingleConsumerEvent body_consumed_event;
+  engine::SingleConsumerEvent sent_event;
+};
+
+Http2Session::Http2Session(const net::Http2Config& config,
+                           const HandlerInfoIndex& handler_info_index,
+                           const request::HttpRequestConfig& request_config,
+                           OnNewRequestCb&& on_new_request_cb,
+                           net::ParserStats& stats,
+                           request::ResponseDataAccounter& data_accounter,
+                           engine::io::RwBase& socket)
+    : handler_info_index_(handler_info_index),
+      request_constructor_config_(request_config),
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      stats_(stats),
+      data_accounter_(data_accounter),
+      socket_(socket) {
+  nghttp2_session_callbacks* callbacks = nullptr;
+  CheckNghttp2(nghttp2_session_callbacks_new(&callbacks), "create callbacks");
+  const utils::FastScopeGuard callbacks_guard(
+      [callbacks]() noexcept { nghttp2_session_callbacks_del(callbacks); });
+
+  nghttp2_session_callbacks_set_on_begin_headers_callback(callbacks,
+                                                          &OnBeginHeaders);
+  nghttp2_session_callbacks_set_on_header_callback(callbacks, &OnHeader);
+  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks,
+                                                            &OnDataChunkRecv);
+  nghttp2_session_callbacks_set_on_frame_recv_callback(callbacks,
+                                                       &OnFrameRecv);
+  nghttp2_session_callbacks_set_on_frame_send_callback(callbacks,
+                                                       &OnFrameSend);
+  nghttp2_session_callbacks_set_on_stream_close_callback(callbacks,
+                                                         &OnStreamClose);
+
+  CheckNghttp2(nghttp2_session_server_new(&session_, callbacks, this),
+               "create HTTP/2 session");
+  utils::FastScopeGuard session_guard(
+      [this]() noexcept { nghttp2_session_del(session_); });
+
+  const std::array<nghttp2_settings_entry, 2> settings{{
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, config.max_concurrent_streams},
+      {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, config.initial_window_size},
+  }};
+  CheckNghttp2(nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE,
+                                       settings.data(), settings.size()),
+               "submit HTTP/2 settings");
+
+  // SETTINGS_INITIAL_WINDOW_SIZE does not apply to the connection window
+  if (config.initial_window_size > NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE) {
+    CheckNghttp2(
+        nghttp2_session_set_local_window_size(
+            session_, NGHTTP2_FLAG_NONE, 0,
+            static_cast<std::int32_t>(config.initial_window_size)),
+        "set HTTP/2 connection window size");
+  }
+
+  session_guard.Release();
+}
+
+Http2Session::~Http2Session() {
+  FailStreams();
+  nghttp2_session_del(session_);
+}
+
+bool Http2Session::Parse(const char* data, size_t size) {
+  std::vector<std::shared_ptr<request::RequestBase>> requests;
+  bool is_failed = false;
+  {
+    const std::lock_guard lock(mutex_);
+    if (is_stopped_) return false;
+
+    const auto rv = nghttp2_session_mem_recv(
+        session_, reinterpret_cast<const std::uint8_t*>(data), size);
+    if (rv < 0) {
+      LOG_WARNING() << "HTTP/2 session error: "
+                    << nghttp2_strerror(static_cast<int>(rv));
+      is_failed = true;
+    }
+    requests.swap(parsed_requests_);
+  }
+
+  // The callback may block until the previous requests are processed, and
+  // sending their responses requires mutex_
+  for (auto& request : requests) on_new_request_cb_(std::move(request));
+
+  // Sends GOAWAY if nghttp2 has queued it
+  Flush();
+  if (is_failed) return false;
+
+  const std::lock_guard lock(mutex_);
+  return !is_stopped_ && (nghttp2_session_want_read(session_) ||
+                          nghttp2_session_want_write(session_));
+}
+
+void Http2Session::SendResponse(HttpRequestImpl& request) {
+  auto& response = request.GetHttpResponse();
+  auto prepared = response.PrepareHttp2Response();
+
+  std::vector<nghttp2_nv> headers;
+  headers.reserve(prepared.headers.size());
+  for (auto& [name, value] : prepared.headers) {
+    headers.push_back({reinterpret_cast<std::uint8_t*>(name.data()),
+                       reinterpret_cast<std::uint8_t*>(value.data()),
+                       name.size(), value.size(), NGHTTP2_NV_FLAG_NONE});
+  }
+
+  StreamPtr stream;
+  {
+    const std::lock_guard lock(mutex_);
+    stream = GetStreamForResponse(request.GetStreamId());
+    stream->body = prepared.body;
+    stream->is_body_complete = !prepared.is_body_streamed;
+
+    nghttp2_data_provider data_provider{};
+    data_provider.source.ptr = stream.get();
+    data_provider.read_callback = &OnDataSourceRead;
+    const bool has_body = prepared.is_body_streamed || !prepared.body.empty();
+
+    const auto rv =
+        nghttp2_submit_response(session_, stream->id, headers.data(),
+                                headers.size(), has_body ? &data_provider
+                                                         : nullptr);
+    if (rv != 0) {
+      throw engine::io::IoException()
+          << "Failed to submit HTTP/2 response: " << nghttp2_strerror(rv);
+    }
+  }
+
+  // nghttp2 must not read the body of the response after it is destroyed
+  utils::FastScopeGuard reset_guard(
+      [this, &stream]() noexcept { ResetStream(*stream); });
+
+  Flush();
+
+  if (prepared.is_body_streamed) SendBodyStream(*stream, response);
+
+  if (!stream->sent_event.WaitForEvent() || !stream->is_sent) {
+    throw engine::io::IoException()
+        << "HTTP/2 stream " << stream->id
+        << " was closed before the response was sent";
+  }
+  reset_guard.Release();
+
+  response.SetSent(stream->sent_bytes, std::chrono::steady_clock::now());
+}
+
+void Http2Session::Stop() noexcept {
+  const std::lock_guard lock(mutex_);
+  FailStreams();
+}
+
+int Http2Session::OnBeginHeaders(nghttp2_session*, const nghttp2_frame* frame,
+                                 void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return CallNoexcept(
+      [&] { return http2_session->OnBeginHeadersImpl(*frame); });
+}
+
+int Http2Session::OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                           const std::uint8_t* name, size_t namelen,
+                           const std::uint8_t* value, size_t valuelen,
+                           std::uint8_t, void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return CallNoexcept([&] {
+    return http2_session->OnHeaderImpl(
+        *frame, {reinterpret_cast<const char*>(name), namelen},
+        {reinterpret_cast<const char*>(value), valuelen});
+  });
+}
+
+int Http2Session::OnDataChunkRecv(nghttp2_session*, std::uint8_t,
+                                  std::int32_t stream_id,
+                                  const std::uint8_t* data, size_t len,
+                                  void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return CallNoexcept([&] {
+    return http2_session->OnDataChunkRecvImpl(
+        stream_id, {reinterpret_cast<const char*>(data), len});
+  });
+}
+
+int Http2Session::OnFrameRecv(nghttp2_session*, const nghttp2_frame* frame,
+                              void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return CallNoexcept([&] { return http2_session->OnFrameRecvImpl(*frame); });
+}
+
+int Http2Session::OnFrameSend(nghttp2_session*, const nghttp2_frame* frame,
+                              void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return CallNoexcept([&] { return http2_session->OnFrameSendImpl(*frame); });
+}
+
+int Http2Session::OnStreamClose(nghttp2_session*, std::int32_t stream_id,
+                                std::uint32_t error_code, void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return CallNoexcept([&] {
+    return http2_session->OnStreamCloseImpl(stream_id, error_code);
+  });
+}
+
+ssize_t Http2Session::OnDataSourceRead(nghttp2_session*, std::int32_t,
+                                       std::uint8_t* buf, size_t length,
+                                       std::uint32_t* data_flags,
+                                       nghttp2_data_source* source, void*) {
+  auto& stream = *static_cast<Stream*>(source->ptr);
+
+  const auto size = std::min(length, stream.body.size());
+  if (size != 0) {
+    std::memcpy(buf, stream.body.data(), size);
+    stream.body.remove_prefix(size);
+    stream.sent_bytes += size;
+  }
+
+  if (stream.body.empty()) {
+    if (stream.is_body_complete) {
+      *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    } else {
+      // Waiting for the next part of the streamed body
+      stream.body_consumed_event.Send();
+      if (size == 0) return NGHTTP2_ERR_DEFERRED;
+    }
+  }
+  return static_cast<ssize_t>(size);
+}
+
+int Http2Session::OnBeginHeadersImpl(const nghttp2_frame& frame) {
+  if (!IsRequestHeaders(frame)) return 0;
+
+  LOG_TRACE() << "HTTP/2 stream " << frame.hd.stream_id << " begin";
+  auto stream = std::make_shared<Stream>(frame.hd.stream_id);
+  ++stats_.parsing_request_count;
+  stream->request_constructor.emplace(request_constructor_config_,
+                                      handler_info_index_, data_accounter_);
+  stream->request_constructor->SetStreamId(stream->id);
+  streams_.emplace(stream->id, std::move(stream));
+  return 0;
+}
+
+int Http2Session::OnHeaderImpl(const nghttp2_frame& frame,
+                               std::string_view name, std::string_view value) {
+  // Trailers are ignored
+  if (!IsRequestHeaders(frame)) return 0;
+
+  auto* stream = FindStream(frame.hd.stream_id);
+  if (!stream || !stream->request_constructor) return 0;
+
+  LOG_TRACE() << "header: '" << name << "': '" << value << '\'';
+  try {
+    // nghttp2 checks that the pseudo headers go before the regular ones
+    if (!name.empty() && name.front() == ':') {
+      if (name == ":method") {
+        stream->method = HttpMethodFromString(value);
+      } else if (name == ":path") {
+        stream->request_constructor->AppendUrl(value.data(), value.size());
+      } else if (name == ":authority") {
+        stream->authority = value;
+      }
+      return 0;
+    }
+
+    if (!CheckUrlComplete(*stream)) return 0;
+    stream->request_constructor->AppendHeader(name, value);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append header: " << ex;
+    FinalizeRequest(*stream);
+  }
+  return 0;
+}
+
+int Http2Session::OnDataChunkRecvImpl(std::int32_t stream_id,
+                                      std::string_view data) {
+  // Data of the streams with the finalized requests is dropped, the flow
+  // control windows are updated by nghttp2 anyway
+  auto* stream = FindStream(stream_id);
+  if (!stream || !stream->request_constructor) return 0;
+  if (!CheckUrlComplete(*stream)) return 0;
+
+  LOG_TRACE() << "body: '" << data << "'";
+  try {
+    stream->request_constructor->AppendBody(data.data(), data.size());
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append body: " << ex;
+    FinalizeRequest(*stream);
+  }
+  return 0;
+}
+
+int Http2Session::OnFrameRecvImpl(const nghttp2_frame& frame) {
+  if (!IsEndStream(frame)) return 0;
+
+  auto* stream = FindStream(frame.hd.stream_id);
+  if (!stream || !stream->request_constructor) return 0;
+  if (!CheckUrlComplete(*stream)) return 0;
+
+  LOG_TRACE() << "HTTP/2 stream " << stream->id << " request complete";
+  FinalizeRequest(*stream);
+  return 0;
+}
+
+int Http2Session::OnFrameSendImpl(const nghttp2_frame& frame) {
+  if (!IsEndStream(frame)) return 0;
+
+  const auto it = streams_.find(frame.hd.stream_id);
+  if (it == streams_.end()) return 0;
+
+  it->second->is_response_complete = true;
+  sent_streams_.push_back(it->second);
+  return 0;
+}
+
+int Http2Session::OnStreamCloseImpl(std::int32_t stream_id,
+                                    std::uint32_t error_code) {
+  const auto it = streams_.find(stream_id);
+  if (it == streams_.end()) return 0;
+
+  LOG_TRACE() << "HTTP/2 stream " << stream_id
+              << " closed, error_code=" << error_code;
+  const auto stream = std::move(it->second);
+  streams_.erase(it);
+  CloseStream(*stream);
+  return 0;
+}
+
+Http2Session::Stream* Http2Session::FindStream(std::int32_t stream_id) const {
+  const auto it = streams_.find(stream_id);
+  return it == streams_.end() ? nullptr : it->second.get();
+}
+
+Http2Session::StreamPtr Http2Session::GetStreamForResponse(
+    std::int32_t stream_id) const {
+  if (is_stopped_) {
+    throw engine::io::IoException() << "HTTP/2 session is stopped";
+  }
+  const auto it = streams_.find(stream_id);
+  if (it == streams_.end()) {
+    throw engine::io::IoException()
+        << "HTTP/2 stream " << stream_id << " is closed";
+  }
+  return it->second;
+}
+
+bool Http2Session::CheckUrlComplete(Stream& stream) {
+  if (stream.is_url_complete) return true;
+  stream.is_url_complete = true;
+
+  auto& request_constructor = *stream.request_constructor;
+  request_constructor.SetMethod(stream.method);
+  request_constructor.SetHttpMajor(2);
+  request_constructor.SetHttpMinor(0);
+  try {
+    request_constructor.ParseUrl();
+    if (!stream.authority.empty()) {
+      request_constructor.AppendHeader(USERVER_NAMESPACE::http::headers::kHost,
+                                       stream.authority);
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't parse url: " << ex;
+    FinalizeRequest(stream);
+    return false;
+  }
+  return true;
+}
+
+void Http2Session::FinalizeRequest(Stream& stream) {
+  UASSERT(stream.request_constructor);
+  auto request = stream.request_constructor->Finalize();
+  --stats_.parsing_request_count;
+  stream.request_constructor.reset();
+
+  if (request) {
+    parsed_requests_.push_back(std::move(request));
+  } else {
+    LOG_ERROR() << "request is null after Finalize()";
+  }
+}
+
+void Http2Session::SendBodyStream(Stream& stream, HttpResponse& response) {
+  UASSERT(response.body_stream_);
+
+  std::string body_part;
+  bool is_last_part = false;
+  while (!is_last_part) {
+    is_last_part = !response.body_stream_->Pop(body_part);
+    if (!is_last_part && body_part.empty()) continue;
+
+    // Only one part is buffered in the stream, so a slow peer slows down the
+    // producer instead of making the response accumulate in memory
+    for (;;) {
+      bool is_resumed = false;
+      {
+        const std::lock_guard lock(mutex_);
+        if (stream.is_closed || is_stopped_) {
+          throw engine::io::IoException()
+              << "HTTP/2 stream " << stream.id
+              << " was closed while sending the response body";
+        }
+        if (stream.body.empty()) {
+          if (is_last_part) {
+            stream.is_body_complete = true;
+          } else {
+            stream.body_part = std::move(body_part);
+            stream.body = stream.body_part;
+          }
+          // Fails if nghttp2 has not asked for the data yet, that's fine
+          static_cast<void>(nghttp2_session_resume_data(session_, stream.id));
+          is_resumed = true;
+        }
+      }
+      if (is_resumed) {
+        Flush();
+        break;
+      }
+
+      if (!stream.body_consumed_event.WaitForEvent()) {
+        throw engine::io::IoCancelled()
+            << "Interrupted while sending the response body";
+      }
+    }
+  }
+}
+
+void Http2Session::ResetStream(Stream& stream) noexcept {
+  try {
+    {
+      const std::lock_guard lock(mutex_);
+      stream.body = {};
+      stream.is_body_complete = true;
+      if (stream.is_closed || is_stopped_ || stream.is_response_complete) {
+        return;
+      }
+
+      CheckNghttp2(
+          nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream.id,
+                                    NGHTTP2_INTERNAL_ERROR),
+          "reset HTTP/2 stream");
+    }
+    Flush();
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to reset HTTP/2 stream " << stream.id << ": "
+                  << ex;
+  }
+}
+
+void Http2Session::Flush() {
+  // Holding write_mutex_ keeps the order of the output chunks, mutex_ is not
+  // held during the socket writes
+  const std::lock_guard write_lock(write_mutex_);
+  for (;;) {
+    std::string buffer;
+    std::vector<StreamPtr> sent_streams;
+    {
+      const std::lock_guard lock(mutex_);
+      if (is_stopped_) {
+        throw engine::io::IoException() << "HTTP/2 session is stopped";
+      }
+
+      try {
+        Serialize();
+      } catch (const std::exception&) {
+        // The session state is unknown, nghttp2 must not be used any more
+        FailStreams();
+        throw;
+      }
+      if (out_buffer_.empty()) break;
+      buffer.swap(out_buffer_);
+      sent_streams.swap(sent_streams_);
+    }
+
+    try {
+      WriteOut(buffer);
+    } catch (const std::exception&) {
+      {
+        const std::lock_guard lock(mutex_);
+        FailStreams();
+      }
+      for (const auto& stream : sent_streams) stream->sent_event.Send();
+      throw;
+    }
+
+    for (const auto& stream : sent_streams) {
+      stream->is_sent = true;
+      stream->sent_event.Send();
+    }
+  }
+}
+
+void Http2Session::Serialize() {
+  while (out_buffer_.size() < kMaxBufferedOutput) {
+    const std::uint8_t* data = nullptr;
+    const auto size = nghttp2_session_mem_send(session_, &data);
+    if (size < 0) {
+      throw engine::io::IoException() << "HTTP/2 session error: "
+                                      << nghttp2_strerror(
+                                             static_cast<int>(size));
+    }
+    if (size == 0) break;
+
+    out_buffer_.append(reinterpret_cast<const char*>(data),
+                       static_cast<std::size_t>(size));
+  }
+}
+
+void Http2Session::WriteOut(const std::string& buffer) {
+  const auto size = buffer.size();
+  if (socket_.WriteAll(buffer.data(), size, engine::Deadline{}) != size) {
+    throw engine::io::IoException() << "Connection closed by peer";
+  }
+}
+
+void Http2Session::CloseStream(Stream& stream) noexcept {
+  if (stream.request_constructor) {
+    // The request was not received completely
+    --stats_.parsing_request_count;
+    stream.request_constructor.reset();
+  }
+
+  stream.is_closed = true;
+  stream.body_consumed_event.Send();
+  if (!stream.is_response_complete) stream.sent_event.Send();
+}
+
+void Http2Session::FailStreams() noexcept {
+  is_stopped_ = true;
+
+  for (const auto& stream : sent_streams_) stream->sent_event.Send();
+  sent_streams_.clear();
+
+  for (const auto& [id, stream] : streams_) CloseStream(*stream);
+  streams_.clear();
+  out_buffer_.clear();
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
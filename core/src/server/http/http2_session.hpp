@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include <server/net/connection_config.hpp>
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+
+#include <userver/engine/io/common.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/server/request/request_config.hpp>
+
+#include "handler_info_index.hpp"
+#include "http_request_impl.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// HTTP/2 server session of a single connection.
+///
+/// Parse() feeds the received bytes to nghttp2 and produces a request for
+/// each stream that was received completely. SendResponse() sends the
+/// response into the stream of the request and may be called from different
+/// tasks concurrently: the session state is guarded by an internal mutex that
+/// is never held during the socket writes or while passing the new requests
+/// on, the writes are serialized with a separate mutex. Flow control of both
+/// directions is done by nghttp2.
+class Http2Session final : public request::RequestParser {
+ public:
+  using OnNewRequestCb =
+      std::function<void(std::shared_ptr<request::RequestBase>&&)>;
+
+  Http2Session(const net::Http2Config& config,
+               const HandlerInfoIndex& handler_info_index,
+               const request::HttpRequestConfig& request_config,
+               OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
+               request::ResponseDataAccounter& data_accounter,
+               engine::io::RwBase& socket);
+
+  ~Http2Session() override;
+
+  bool Parse(const char* data, size_t size) override;
+
+  /// Sends the response of the request and waits until it is written to the
+  /// socket.
+  /// @throws engine::io::IoException if the stream was reset by the peer or
+  /// the session is stopped
+  void SendResponse(HttpRequestImpl& request);
+
+  /// Fails all the responses that are being sent, including the ones waiting
+  /// for the peer to open the flow control window. Must be called once the
+  /// peer is not read any more.
+  void Stop() noexcept;
+
+ private:
+  struct Stream;
+  using StreamPtr = std::shared_ptr<Stream>;
+
+  static int OnBeginHeaders(nghttp2_session* session,
+                            const nghttp2_frame* frame, void* user_data);
+  static int OnHeader(nghttp2_session* session, const nghttp2_frame* frame,
+                      const std::uint8_t* name, size_t namelen,
+                      const std::uint8_t* value, size_t valuelen,
+                      std::uint8_t flags, void* user_data);
+  static int OnDataChunkRecv(nghttp2_session* session, std::uint8_t flags,
+                             std::int32_t stream_id, const std::uint8_t* data,
+                             size_t len, void* user_data);
+  static int OnFrameRecv(nghttp2_session* session, const nghttp2_frame* frame,
+                         void* user_data);
+  static int OnFrameSend(nghttp2_session* session, const nghttp2_frame* frame,
+                         void* user_data);
+  static int OnStreamClose(nghttp2_session* session, std::int32_t stream_id,
+                           std::uint32_t error_code, void* user_data);
+  static ssize_t OnDataSourceRead(nghttp2_session* session,
+                                  std::int32_t stream_id, std::uint8_t* buf,
+                                  size_t length, std::uint32_t* data_flags,
+                                  nghttp2_data_source* source, void* user_data);
+
+  int OnBeginHeadersImpl(const nghttp2_frame& frame);
+  int OnHeaderImpl(const nghttp2_frame& frame, std::string_view name,
+                   std::string_view value);
+  int OnDataChunkRecvImpl(std::int32_t stream_id, std::string_view data);
+  int OnFrameRecvImpl(const nghttp2_frame& frame);
+  int OnFrameSendImpl(const nghttp2_frame& frame);
+  int OnStreamCloseImpl(std::int32_t stream_id, std::uint32_t error_code);
+
+  Stream* FindStream(std::int32_t stream_id) const;
+  StreamPtr GetStreamForResponse(std::int32_t stream_id) const;
+
+  bool CheckUrlComplete(Stream& stream);
+  void FinalizeRequest(Stream& stream);
+
+  void SendBodyStream(Stream& stream, HttpResponse& response);
+  void ResetStream(Stream& stream) noexcept;
+
+  // Must be called with mutex_ unlocked
+  void Flush();
+  void WriteOut(const std::string& buffer);
+
+  // Must be called with mutex_ locked
+  void Serialize();
+  void CloseStream(Stream& stream) noexcept;
+  void FailStreams() noexcept;
+
+  const HandlerInfoIndex& handler_info_index_;
+  const request::HttpRequestConfig request_constructor_config_;
+  OnNewRequestCb on_new_request_cb_;
+  net::ParserStats& stats_;
+  request::ResponseDataAccounter& data_accounter_;
+  engine::io::RwBase& socket_;
+
+  engine::Mutex write_mutex_;
+  engine::Mutex mutex_;
+  nghttp2_session* session_{nullptr};
+  std::unordered_map<std::int32_t, StreamPtr> streams_;
+  // Requests finalized by nghttp2 callbacks, passed on with mutex_ unlocked
+  std::vector<std::shared_ptr<request::RequestBase>> parsed_requests_;
+  // Streams with the response written to out_buffer_
+  std::vector<StreamPtr> sent_streams_;
+  std::string out_buffer_;
+  bool is_stopped_{false};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
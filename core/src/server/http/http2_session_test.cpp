@@ -0,0 +1,220 @@
+#include <userver/utest/utest.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include <server/http/http2_session.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/internal/net/net_listener.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr server::request::HttpRequestConfig kTestRequestConfig{
+    /*.max_url_size = */ 8192,
+    /*.max_request_size = */ 1024 * 1024,
+    /*.max_headers_size = */ 65536,
+    /*.parse_args_from_body = */ false,
+    /*.testing_mode = */ true,
+    /*.decompress_request = */ false,
+};
+
+// Minimal HTTP/2 client, collects the response of the first stream
+class TestClient final {
+ public:
+  TestClient() {
+    nghttp2_session_callbacks* callbacks = nullptr;
+    nghttp2_session_callbacks_new(&callbacks);
+    nghttp2_session_callbacks_set_on_header_callback(
+        callbacks, [](nghttp2_session*, const nghttp2_frame*,
+                      const std::uint8_t* name, size_t namelen,
+                      const std::uint8_t* value, size_t valuelen, std::uint8_t,
+                      void* user_data) {
+          auto& client = *static_cast<TestClient*>(user_data);
+          if (std::string_view(reinterpret_cast<const char*>(name), namelen) ==
+              ":status") {
+            client.status.assign(reinterpret_cast<const char*>(value),
+                                 valuelen);
+          }
+          return 0;
+        });
+    nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+        callbacks, [](nghttp2_session*, std::uint8_t, std::int32_t,
+                      const std::uint8_t* data, size_t len, void* user_data) {
+          static_cast<TestClient*>(user_data)->body.append(
+              reinterpret_cast<const char*>(data), len);
+          return 0;
+        });
+    nghttp2_session_client_new(&session_, callbacks, this);
+    nghttp2_session_callbacks_del(callbacks);
+    nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, nullptr, 0);
+  }
+
+  ~TestClient() { nghttp2_session_del(session_); }
+
+  void SubmitGet(std::string_view path) {
+    const auto header = [](std::string_view name, std::string_view value) {
+      return nghttp2_nv{
+          reinterpret_cast<std::uint8_t*>(const_cast<char*>(name.data())),
+          reinterpret_cast<std::uint8_t*>(const_cast<char*>(value.data())),
+          name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+    };
+    const std::array<nghttp2_nv, 5> headers{
+        header(":method", "GET"), header(":scheme", "http"),
+        header(":path", path), header(":authority", "localhost"),
+        header("x-test", "value")};
+    ASSERT_EQ(1, nghttp2_submit_request(session_, nullptr, headers.data(),
+                                        headers.size(), nullptr, nullptr));
+  }
+
+  std::string Send() {
+    std::string result;
+    const std::uint8_t* data = nullptr;
+    while (const auto size = nghttp2_session_mem_send(session_, &data)) {
+      result.append(reinterpret_cast<const char*>(data), size);
+    }
+    return result;
+  }
+
+  void Receive(std::string_view data) {
+    ASSERT_EQ(static_cast<ssize_t>(data.size()),
+              nghttp2_session_mem_recv(
+                  session_, reinterpret_cast<const std::uint8_t*>(data.data()),
+                  data.size()));
+  }
+
+  std::string status;
+  std::string body;
+
+ private:
+  nghttp2_session* session_{nullptr};
+};
+
+}  // namespace
+
+UTEST(Http2Session, RequestResponse) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  internal::net::TcpListener listener;
+  auto [server_socket, client_socket] = listener.MakeSocketPair(deadline);
+
+  const server::http::HandlerInfoIndex handler_info_index;
+  server::net::ParserStats stats;
+  server::request::ResponseDataAccounter accounter;
+  std::vector<std::shared_ptr<server::request::RequestBase>> requests;
+
+  server::http::Http2Session session(
+      {}, handler_info_index, kTestRequestConfig,
+      [&requests](std::shared_ptr<server::request::RequestBase>&& request) {
+        requests.push_back(std::move(request));
+      },
+      stats, accounter, server_socket);
+
+  TestClient client;
+  client.SubmitGet("/test?arg=1");
+  const auto request_data = client.Send();
+  ASSERT_TRUE(session.Parse(request_data.data(), request_data.size()));
+
+  ASSERT_EQ(requests.size(), 1);
+  auto& request = dynamic_cast<server::http::HttpRequestImpl&>(*requests[0]);
+  EXPECT_EQ(request.GetStreamId(), 1);
+  EXPECT_EQ(request.GetMethod(), server::http::HttpMethod::kGet);
+  EXPECT_EQ(request.GetHttpMajor(), 2);
+  EXPECT_EQ(request.GetRequestPath(), "/test");
+  EXPECT_EQ(request.GetHeader("X-Test"), "value");
+  EXPECT_EQ(request.GetHeader("Host"), "localhost");
+
+  auto& response = request.GetHttpResponse();
+  response.SetData("hello");
+  response.SetReady();
+  session.SendResponse(request);
+  EXPECT_TRUE(response.IsSent());
+  EXPECT_EQ(response.BytesSent(), 5);
+
+  // SETTINGS, SETTINGS ACK, HEADERS and DATA frames are already written
+  std::array<char, 1024> buf{};
+  while (client.body.size() < 5) {
+    const auto size = client_socket.RecvSome(buf.data(), buf.size(), deadline);
+    ASSERT_NE(size, 0);
+    client.Receive({buf.data(), size});
+  }
+  EXPECT_EQ(client.status, "200");
+  EXPECT_EQ(client.body, "hello");
+}
+
+UTEST(Http2Session, ResponseAfterStop) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  internal::net::TcpListener listener;
+  auto [server_socket, client_socket] = listener.MakeSocketPair(deadline);
+
+  const server::http::HandlerInfoIndex handler_info_index;
+  server::net::ParserStats stats;
+  server::request::ResponseDataAccounter accounter;
+  std::shared_ptr<server::request::RequestBase> request_ptr;
+
+  server::http::Http2Session session(
+      {}, handler_info_index, kTestRequestConfig,
+      [&request_ptr](std::shared_ptr<server::request::RequestBase>&& request) {
+        request_ptr = std::move(request);
+      },
+      stats, accounter, server_socket);
+
+  TestClient client;
+  client.SubmitGet("/");
+  const auto request_data = client.Send();
+  ASSERT_TRUE(session.Parse(request_data.data(), request_data.size()));
+  ASSERT_TRUE(request_ptr);
+
+  session.Stop();
+  EXPECT_FALSE(session.Parse(request_data.data(), request_data.size()));
+
+  auto& request = dynamic_cast<server::http::HttpRequestImpl&>(*request_ptr);
+  request.GetHttpResponse().SetReady();
+  EXPECT_THROW(session.SendResponse(request), engine::io::IoException);
+}
+
+UTEST(Http2Session, ResponseFromNewRequestCallback) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  internal::net::TcpListener listener;
+  auto [server_socket, client_socket] = listener.MakeSocketPair(deadline);
+
+  const server::http::HandlerInfoIndex handler_info_index;
+  server::net::ParserStats stats;
+  server::request::ResponseDataAccounter accounter;
+  std::unique_ptr<server::http::Http2Session> session;
+
+  // The callback blocks until the response is sent, like a full requests
+  // queue does
+  session = std::make_unique<server::http::Http2Session>(
+      server::net::Http2Config{}, handler_info_index, kTestRequestConfig,
+      [&session](std::shared_ptr<server::request::RequestBase>&& request) {
+        auto& request_impl =
+            dynamic_cast<server::http::HttpRequestImpl&>(*request);
+        request_impl.GetHttpResponse().SetData("hello");
+        request_impl.GetHttpResponse().SetReady();
+        engine::AsyncNoSpan([&] { session->SendResponse(request_impl); })
+            .Get();
+      },
+      stats, accounter, server_socket);
+
+  TestClient client;
+  client.SubmitGet("/");
+  const auto request_data = client.Send();
+  ASSERT_TRUE(session->Parse(request_data.data(), request_data.size()));
+
+  std::array<char, 1024> buf{};
+  while (client.body.size() < 5) {
+    const auto size = client_socket.RecvSome(buf.data(), buf.size(), deadline);
+    ASSERT_NE(size, 0);
+    client.Receive({buf.data(), size});
+  }
+  EXPECT_EQ(client.status, "200");
+  EXPECT_EQ(client.body, "hello");
+}
+
+USERVER_NAMESPACE_END
@@ -164,6 +164,16 @@ const std::string& HttpRequest::RequestBody() const {
   return impl_.RequestBody();
 }
 
+std::shared_ptr<const std::string> HttpRequest::GetSharedRequestBody() const {
+  return impl_.GetSharedRequestBody();
+}
+
+RequestBodyStream& HttpRequest::GetBodyStream() const {
+  return impl_.GetBodyStream();
+}
+
+bool HttpRequest::IsBodyStreamed() const { return impl_.IsBodyStreamed(); }
+
 const HttpRequest::HeadersMap& HttpRequest::RequestHeaders() const {
   return impl_.GetHeaders();
 }
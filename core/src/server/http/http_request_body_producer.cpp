@@ -0,0 +1,81 @@
+#include "http_request_body_producer.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+// A bigger input is split, so that the queue limit is not exceeded by a
+// single chunk
+constexpr std::size_t kMaxChunkSize = 64 * 1024;
+
+}  // namespace
+
+RequestBodyProducer::RequestBodyProducer(
+    RequestBodyStream::Queue::Producer&& queue_producer,
+    impl::BodyStreamStatusPtr status, std::size_t max_body_size)
+    : queue_producer_(std::move(queue_producer)),
+      status_(std::move(status)),
+      remaining_size_(max_body_size) {
+  UASSERT(status_);
+}
+
+RequestBodyProducer::~RequestBodyProducer() {
+  if (!is_done_) {
+    LOG_DEBUG() << "Request body stream is aborted";
+    Finish(impl::BodyStreamStatus::kReading);
+  }
+}
+
+bool RequestBodyProducer::Push(std::string_view data) {
+  UASSERT(!is_done_);
+  if (data.size() > remaining_size_) {
+    LOG_WARNING() << "request is too large, the body exceeds the remaining "
+                  << remaining_size_
+                  << " bytes (enforced by 'max_request_size' handler limit in "
+                     "config.yaml)";
+    Finish(impl::BodyStreamStatus::kTooLarge);
+    return false;
+  }
+  remaining_size_ -= data.size();
+
+  while (!data.empty()) {
+    const auto size = std::min(data.size(), kMaxChunkSize);
+    std::string chunk{data.substr(0, size)};
+    // Push() leaves the chunk intact on failure
+    while (!queue_producer_.Push(std::move(chunk))) {
+      // The handler has finished, the rest of the body is not needed
+      if (queue_producer_.Queue()->NoMoreConsumers()) return true;
+      if (engine::current_task::ShouldCancel()) {
+        Finish(impl::BodyStreamStatus::kReading);
+        return false;
+      }
+    }
+    data.remove_prefix(size);
+  }
+  return true;
+}
+
+void RequestBodyProducer::Complete() {
+  UASSERT(!is_done_);
+  Finish(impl::BodyStreamStatus::kComplete);
+}
+
+void RequestBodyProducer::Finish(impl::BodyStreamStatus status) {
+  // The status is stored before the consumer sees the end of the queue
+  status_->store(status);
+  std::move(queue_producer_).Reset();
+  is_done_ = true;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include <userver/server/http/http_request_body_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// Passes the request body from the connection to the RequestBodyStream of
+/// the handler
+class RequestBodyProducer final {
+ public:
+  RequestBodyProducer(RequestBodyStream::Queue::Producer&& queue_producer,
+                      impl::BodyStreamStatusPtr status,
+                      std::size_t max_body_size);
+
+  RequestBodyProducer(RequestBodyProducer&&) = delete;
+  RequestBodyProducer& operator=(RequestBodyProducer&&) = delete;
+
+  /// Aborts the body if Complete() was not called
+  ~RequestBodyProducer();
+
+  /// Waits while the handler is behind. The data is dropped if the handler
+  /// has already finished.
+  /// @returns false if the body exceeds the size limit or the task is
+  /// cancelled, the body is aborted in that case
+  [[nodiscard]] bool Push(std::string_view data);
+
+  void Complete();
+
+ private:
+  void Finish(impl::BodyStreamStatus status);
+
+  RequestBodyStream::Queue::Producer queue_producer_;
+  impl::BodyStreamStatusPtr status_;
+  std::size_t remaining_size_;
+  bool is_done_{false};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,89 @@
+#include <userver/server/http/http_request_body_stream.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+RequestBodyStream::RequestBodyStream(Queue::Consumer&& queue_consumer,
+                                     impl::BodyStreamStatusPtr status)
+    : queue_consumer_(std::move(queue_consumer)), status_(std::move(status)) {
+  UASSERT(status_);
+}
+
+RequestBodyStream::RequestBodyStream(std::string_view body)
+    : available_(body) {}
+
+RequestBodyStream::~RequestBodyStream() = default;
+
+std::size_t RequestBodyStream::ReadSome(char* buf, std::size_t size,
+                                        engine::Deadline deadline) {
+  if (size == 0) return 0;
+  if (available_.empty() && !FetchChunk(deadline)) return 0;
+
+  const auto bytes = std::min(size, available_.size());
+  std::memcpy(buf, available_.data(), bytes);
+  available_.remove_prefix(bytes);
+  return bytes;
+}
+
+bool RequestBodyStream::ReadChunk(std::string& output,
+                                  engine::Deadline deadline) {
+  if (available_.empty() && !FetchChunk(deadline)) {
+    output.clear();
+    return false;
+  }
+
+  if (available_.size() == chunk_.size()) {
+    output = std::move(chunk_);
+  } else {
+    output.assign(available_);
+  }
+  chunk_.clear();
+  available_ = {};
+  return true;
+}
+
+bool RequestBodyStream::FetchChunk(engine::Deadline deadline) {
+  UASSERT(available_.empty());
+  if (is_finished_) return false;
+  if (!queue_consumer_) {
+    is_finished_ = true;
+    return false;
+  }
+
+  if (!queue_consumer_->Pop(chunk_, deadline)) {
+    switch (status_->load()) {
+      case impl::BodyStreamStatus::kComplete:
+        // The last chunk could be pushed after Pop() gave up on the deadline
+        if (queue_consumer_->PopNoblock(chunk_)) break;
+        is_finished_ = true;
+        return false;
+      case impl::BodyStreamStatus::kTooLarge:
+        throw handlers::ClientError(
+            handlers::HandlerErrorCode::kPayloadTooLarge);
+      case impl::BodyStreamStatus::kReading:
+        if (queue_consumer_->Queue()->NoMoreProducers()) {
+          throw handlers::RequestParseError(
+              handlers::InternalMessage{"Request body is incomplete"});
+        }
+        if (engine::current_task::ShouldCancel()) {
+          throw engine::io::IoCancelled();
+        }
+        throw engine::io::IoTimeout();
+    }
+  }
+  available_ = chunk_;
+  return true;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
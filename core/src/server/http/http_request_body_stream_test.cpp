@@ -0,0 +1,129 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_request_body_stream.hpp>
+
+#include <server/http/http_request_body_producer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace sh = server::http;
+
+struct BodyStream {
+  std::unique_ptr<sh::RequestBodyStream> stream;
+  std::unique_ptr<sh::RequestBodyProducer> producer;
+};
+
+BodyStream MakeBodyStream(std::size_t queue_size, std::size_t max_body_size) {
+  auto queue = sh::RequestBodyStream::Queue::Create(queue_size);
+  auto status = std::make_shared<std::atomic<sh::impl::BodyStreamStatus>>(
+      sh::impl::BodyStreamStatus::kReading);
+  return {std::make_unique<sh::RequestBodyStream>(queue->GetConsumer(), status),
+          std::make_unique<sh::RequestBodyProducer>(
+              queue->GetProducer(), status, max_body_size)};
+}
+
+}  // namespace
+
+UTEST(RequestBodyStream, Buffered) {
+  sh::RequestBodyStream stream{"hello, world"};
+
+  char buf[5];
+  EXPECT_EQ(stream.ReadSome(buf, sizeof(buf)), sizeof(buf));
+  EXPECT_EQ(std::string_view(buf, sizeof(buf)), "hello");
+
+  std::string chunk;
+  EXPECT_TRUE(stream.ReadChunk(chunk));
+  EXPECT_EQ(chunk, ", world");
+  EXPECT_FALSE(stream.IsFinished());
+
+  EXPECT_FALSE(stream.ReadChunk(chunk));
+  EXPECT_TRUE(chunk.empty());
+  EXPECT_TRUE(stream.IsFinished());
+  EXPECT_EQ(stream.ReadSome(buf, sizeof(buf)), 0);
+}
+
+UTEST(RequestBodyStream, Backpressure) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto body = MakeBodyStream(4, 1024);
+
+  auto producer_task = engine::AsyncNoSpan([&producer = *body.producer] {
+    EXPECT_TRUE(producer.Push("abcd"));
+    EXPECT_TRUE(producer.Push("efgh"));
+    producer.Complete();
+  });
+
+  engine::Yield();
+  // The second chunk does not fit into the queue until the first one is read
+  EXPECT_FALSE(producer_task.IsFinished());
+
+  std::string result;
+  char buf[3];
+  while (const auto size = body.stream->ReadSome(buf, sizeof(buf), deadline)) {
+    result.append(buf, size);
+  }
+  EXPECT_EQ(result, "abcdefgh");
+  EXPECT_TRUE(body.stream->IsFinished());
+  UEXPECT_NO_THROW(producer_task.Get());
+}
+
+UTEST(RequestBodyStream, Aborted) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto body = MakeBodyStream(1024, 1024);
+
+  EXPECT_TRUE(body.producer->Push("abc"));
+  body.producer.reset();
+
+  std::string chunk;
+  EXPECT_TRUE(body.stream->ReadChunk(chunk, deadline));
+  EXPECT_EQ(chunk, "abc");
+  UEXPECT_THROW(body.stream->ReadChunk(chunk, deadline),
+                server::handlers::RequestParseError);
+}
+
+UTEST(RequestBodyStream, TooLarge) {
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  auto body = MakeBodyStream(1024, 5);
+
+  EXPECT_TRUE(body.producer->Push("abc"));
+  EXPECT_FALSE(body.producer->Push("def"));
+
+  std::string chunk;
+  EXPECT_TRUE(body.stream->ReadChunk(chunk, deadline));
+  UEXPECT_THROW(body.stream->ReadChunk(chunk, deadline),
+                server::handlers::ClientError);
+}
+
+UTEST(RequestBodyStream, Timeout) {
+  auto body = MakeBodyStream(1024, 1024);
+
+  std::string chunk;
+  UEXPECT_THROW(body.stream->ReadChunk(
+                    chunk, engine::Deadline::FromDuration(
+                               std::chrono::milliseconds{10})),
+                engine::io::IoTimeout);
+
+  body.producer->Complete();
+  EXPECT_FALSE(body.stream->ReadChunk(chunk));
+}
+
+UTEST(RequestBodyStream, ConsumerGone) {
+  auto body = MakeBodyStream(4, 1024);
+
+  EXPECT_TRUE(body.producer->Push("abcd"));
+  body.stream.reset();
+  // The rest of the body is dropped instead of waiting for the reader
+  EXPECT_TRUE(body.producer->Push("efgh"));
+  body.producer->Complete();
+}
+
+USERVER_NAMESPACE_END
@@ -17,6 +17,9 @@ namespace server::http {
 
 namespace {
 
+// Received but not yet read by the handler part of a streamed body
+constexpr std::size_t kMaxBufferedBodyStreamSize = 256 * 1024;
+
 inline void Strip(const char*& begin, const char*& end) {
   while (begin < end && isspace(*begin)) ++begin;
   while (begin < end && isspace(end[-1])) --end;
@@ -46,7 +49,8 @@ HttpRequestConstructor::HttpRequestConstructor(
     request::ResponseDataAccounter& data_accounter)
     : config_(config),
       handler_info_index_(handler_info_index),
-      request_(std::make_shared<HttpRequestImpl>(data_accounter)) {}
+      request_(request::RequestArena::MakeShared<HttpRequestImpl>(
+          data_accounter)) {}
 
 void HttpRequestConstructor::SetMethod(HttpMethod method) {
   request_->method_ = method;
@@ -95,7 +99,7 @@ void HttpRequestConstructor::ParseUrl() {
   const auto* handler_info = match_result.handler_info;
 
   request_->SetMatchedPathLength(match_result.matched_path_length);
-  request_->SetPathArgs(std::move(match_result.args_from_path));
+  request_->SetPathArgs(match_result.args_from_path);
 
   if (!handler_info && request_->GetMethod() == HttpMethod::kOptions &&
       match_result.status == MatchRequestResult::Status::kMethodNotAllowed) {
@@ -112,6 +116,7 @@ void HttpRequestConstructor::ParseUrl() {
     config_.parse_args_from_body =
         handler_config.request_config.parse_args_from_body;
     if (handler_config.decompress_request) config_.decompress_request = true;
+    request_body_stream_ = handler_config.request_body_stream;
 
     request_->SetTaskProcessor(handler_info->task_processor);
     request_->SetHttpHandler(handler_info->handler);
@@ -156,15 +161,55 @@ void HttpRequestConstructor::AppendHeaderValue(const char* data, size_t size) {
   header_value_.append(data, size);
 }
 
+void HttpRequestConstructor::AppendHeader(std::string_view name,
+                                          std::string_view value) {
+  UASSERT(!header_field_flag_ && !header_value_flag_);
+
+  AccountHeadersSize(name.size() + value.size());
+  AccountRequestSize(name.size() + value.size());
+
+  header_field_.assign(name);
+  header_value_.assign(value);
+  header_field_flag_ = true;
+  AddHeader();
+  header_field_flag_ = false;
+}
+
 void HttpRequestConstructor::AppendBody(const char* data, size_t size) {
   AccountRequestSize(size);
-  request_->request_body_.append(data, size);
+  auto& body = request_->request_body_;
+  if (!body) body = std::make_shared<std::string>();
+  body->append(data, size);
 }
 
 void HttpRequestConstructor::SetIsFinal(bool is_final) {
   request_->is_final_ = is_final;
 }
 
+void HttpRequestConstructor::SetStreamId(std::int32_t stream_id) {
+  request_->stream_id_ = stream_id;
+}
+
+bool HttpRequestConstructor::IsBodyStreamRequested() const {
+  return request_body_stream_ && status_ == Status::kOk;
+}
+
+std::unique_ptr<RequestBodyProducer> HttpRequestConstructor::StartBodyStream() {
+  UASSERT(IsBodyStreamRequested());
+  UASSERT(request_->RequestBody().empty());
+
+  auto queue = RequestBodyStream::Queue::Create(kMaxBufferedBodyStreamSize);
+  auto status = std::make_shared<std::atomic<impl::BodyStreamStatus>>(
+      impl::BodyStreamStatus::kReading);
+  request_->body_stream_.emplace(queue->GetConsumer(), status);
+  request_->is_body_streamed_ = true;
+
+  UASSERT(request_size_ <= config_.max_request_size);
+  return std::make_unique<RequestBodyProducer>(
+      queue->GetProducer(), std::move(status),
+      config_.max_request_size - request_size_);
+}
+
 std::shared_ptr<request::RequestBase> HttpRequestConstructor::Finalize() {
   LOG_TRACE() << "method=" << request_->GetMethodStr();
 
@@ -188,10 +233,10 @@ void HttpRequestConstructor::FinalizeImpl() {
 
   try {
     ParseArgs(parsed_url_);
-    if (config_.parse_args_from_body) {
+    if (config_.parse_args_from_body && !request_->is_body_streamed_) {
       if (!config_.decompress_request || !request_->IsBodyCompressed())
-        ParseArgs(request_->request_body_.data(),
-                  request_->request_body_.size());
+        ParseArgs(request_->RequestBody().data(),
+                  request_->RequestBody().size());
     }
   } catch (const std::exception& ex) {
     LOG_WARNING() << "can't parse args: " << ex;
@@ -218,7 +263,9 @@ void HttpRequestConstructor::FinalizeImpl() {
 
   const auto& content_type =
       request_->GetHeader(USERVER_NAMESPACE::http::headers::kContentType);
-  if (IsMultipartFormDataContentType(content_type)) {
+  // The streamed body is parsed by MultipartFormDataStream
+  if (!request_->is_body_streamed_ &&
+      IsMultipartFormDataContentType(content_type)) {
     if (!ParseMultipartFormData(content_type, request_->RequestBody(),
                                 request_->form_data_args_)) {
       SetStatus(Status::kParseMultipartFormDataError);
@@ -236,10 +283,10 @@ void HttpRequestConstructor::ParseArgs(const http_parser_url& url) {
 }
 
 void HttpRequestConstructor::ParseArgs(const char* data, size_t size) {
-  USERVER_NAMESPACE::http::parser::ParseAndConsumeArgs(
+  USERVER_NAMESPACE::http::parser::ParseAndConsumeArgViews(
       std::string_view(data, size),
-      [this](std::string&& key, std::string&& value) {
-        request_->request_args_[std::move(key)].push_back(std::move(value));
+      [this](std::string_view key, std::string_view value) {
+        request_->AddRequestArg(key, value);
       });
 }
 
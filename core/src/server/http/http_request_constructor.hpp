@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string_view>
 
 #include <http_parser.h>
 
@@ -11,6 +13,7 @@
 #include <server/request/request_constructor.hpp>
 
 #include "handler_info_index.hpp"
+#include "http_request_body_producer.hpp"
 #include "http_request_impl.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -50,9 +53,19 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   void ParseUrl();
   void AppendHeaderField(const char* data, size_t size);
   void AppendHeaderValue(const char* data, size_t size);
+  // Adds a complete header, e.g. decoded by HPACK. Must not be mixed with
+  // AppendHeaderField/AppendHeaderValue.
+  void AppendHeader(std::string_view name, std::string_view value);
   void AppendBody(const char* data, size_t size);
 
   void SetIsFinal(bool is_final);
+  void SetStreamId(std::int32_t stream_id);
+
+  // Whether the handler of the request reads the body as it is received
+  bool IsBodyStreamRequested() const;
+  // Must be called before Finalize(), the body is passed to the request by
+  // the returned producer instead of AppendBody()
+  std::unique_ptr<RequestBodyProducer> StartBodyStream();
 
   std::shared_ptr<request::RequestBase> Finalize() override;
 
@@ -84,6 +97,7 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   size_t url_size_ = 0;
   size_t headers_size_ = 0;
   bool url_parsed_ = false;
+  bool request_body_stream_ = false;
   Status status_ = Status::kOk;
 
   std::shared_ptr<HttpRequestImpl> request_;
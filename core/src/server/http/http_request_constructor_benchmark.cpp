@@ -1,6 +1,11 @@
 #include <benchmark/benchmark.h>
 
+#include <fmt/format.h>
+
 #include <server/http/http_request_constructor.hpp>
+#include <server/http/http_request_parser.hpp>
+#include <server/http/simd_http_request_parser.hpp>
+#include <userver/http/parser/http_request_parse_args.hpp>
 #include <utils/gbench_auxilary.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,9 +21,74 @@ void http_request_constructor_url_decode(benchmark::State& state) {
   for ([[maybe_unused]] auto _ : state)
     benchmark::DoNotOptimize(USERVER_NAMESPACE::http::parser::UrlDecode(input));
 }
+
+void http_request_parse_args(benchmark::State& state) {
+  std::string args;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    if (!args.empty()) args += '&';
+    args += fmt::format("arg{}=value%20{}", i % 4, i);
+  }
+
+  for ([[maybe_unused]] auto _ : state) {
+    std::size_t size = 0;
+    USERVER_NAMESPACE::http::parser::ParseAndConsumeArgViews(
+        args, [&size](std::string_view key, std::string_view value) {
+          size += key.size() + value.size();
+        });
+    benchmark::DoNotOptimize(size);
+  }
+  state.SetBytesProcessed(state.iterations() * args.size());
+}
+
+constexpr std::string_view kRequest =
+    "POST /v1/endpoint?arg=value&other=1 HTTP/1.1\r\n"
+    "Host: localhost:8080\r\n"
+    "User-Agent: benchmark/1.0\r\n"
+    "Accept: */*\r\n"
+    "Content-Type: application/json\r\n"
+    "Content-Length: 16\r\n"
+    "\r\n"
+    "{\"key\": \"value\"}";
+
+// Parses a pipeline of state.range(0) requests from a single buffer
+template <typename Parser>
+void http_request_parser_parse(benchmark::State& state) {
+  const server::http::HandlerInfoIndex handler_info_index;
+  server::request::HttpRequestConfig config;
+  config.testing_mode = true;
+  server::net::ParserStats stats;
+  server::request::ResponseDataAccounter accounter;
+
+  std::string input;
+  for (int64_t i = 0; i < state.range(0); i++) input += kRequest;
+
+  std::size_t requests_count = 0;
+  Parser parser(
+      handler_info_index, config,
+      [&requests_count](std::shared_ptr<server::request::RequestBase>&&) {
+        ++requests_count;
+      },
+      stats, accounter);
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(parser.Parse(input.data(), input.size()));
+  }
+  benchmark::DoNotOptimize(requests_count);
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
 }  // namespace
 BENCHMARK(http_request_constructor_url_decode)
     ->RangeMultiplier(2)
     ->Range(1, 1024);
 
+BENCHMARK(http_request_parse_args)->RangeMultiplier(4)->Range(1, 64);
+
+BENCHMARK_TEMPLATE(http_request_parser_parse, server::http::HttpRequestParser)
+    ->Arg(1)
+    ->Arg(16);
+BENCHMARK_TEMPLATE(http_request_parser_parse,
+                   server::http::SimdHttpRequestParser)
+    ->Arg(1)
+    ->Arg(16);
+
 USERVER_NAMESPACE_END
@@ -15,4 +15,32 @@ TEST(HttpRequestConstructor, DecodeUrlPlus) {
   EXPECT_EQ("Some String", http::parser::UrlDecode(str));
 }
 
+TEST(HttpRequestConstructor, DecodeUrlLong) {
+  const std::string chunk = "0123456789abcdef";
+  EXPECT_EQ(chunk + chunk + " " + chunk + "/",
+            http::parser::UrlDecode(chunk + chunk + "+" + chunk + "%2F"));
+  EXPECT_EQ(chunk + "/" + chunk,
+            http::parser::UrlDecode(chunk + "%2f" + chunk));
+}
+
+TEST(HttpRequestConstructor, DecodeUrlInvalid) {
+  EXPECT_THROW(http::parser::UrlDecode("abc%"), std::runtime_error);
+  EXPECT_THROW(http::parser::UrlDecode("abc%2"), std::runtime_error);
+  EXPECT_THROW(http::parser::UrlDecode("abc%2xdef"), std::runtime_error);
+  EXPECT_THROW(http::parser::UrlDecode("%G0"), std::runtime_error);
+}
+
+TEST(HttpRequestConstructor, ParseArgViews) {
+  const std::string_view args = "a=1&b=x+y&a=%32&=skip&c&d=";
+  std::vector<std::pair<std::string, std::string>> result;
+  http::parser::ParseAndConsumeArgViews(
+      args, [&result](std::string_view key, std::string_view value) {
+        result.emplace_back(key, value);
+      });
+
+  const std::vector<std::pair<std::string, std::string>> expected{
+      {"a", "1"}, {"b", "x y"}, {"a", "2"}, {"d", ""}};
+  EXPECT_EQ(result, expected);
+}
+
 USERVER_NAMESPACE_END
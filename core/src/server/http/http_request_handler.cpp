@@ -81,6 +81,9 @@ namespace {
 utils::statistics::MetricTag<std::atomic<size_t>> kCcStatusCodeIsCustom{
     "congestion-control.rps.is-custom-status-activated"};
 
+utils::statistics::MetricTag<std::atomic<size_t>> kCcQueueDelayShed{
+    "congestion-control.queue-delay.shed-requests"};
+
 }  // namespace
 
 engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
@@ -110,6 +113,13 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
     // by HttpRequestConstructor::CheckStatus
     return StartFailsafeTask(std::move(request));
   }
+  if (handler->GetConfig().run_on_connection_task_processor) {
+    // The request is handled on the task processor that reads the connection,
+    // which is a single thread with `shard_task_processors`. It is meant for
+    // the non-blocking handlers only: a handler that waits for a blocking
+    // syscall or a long computation stalls every connection of the shard.
+    task_processor = &engine::current_task::GetTaskProcessor();
+  }
   auto throttling_enabled = handler->GetConfig().throttling_enabled;
 
   if (throttling_enabled && http_response.IsLimitReached()) {
@@ -161,12 +171,30 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
     http_response.SetStreamBody();
   }
 
-  auto payload = [request = std::move(request), handler] {
+  std::optional<congestion_control::CoDel::Settings> codel_settings;
+  if (!is_monitor_ && throttling_enabled) {
+    const auto& queue_delay_config = config[handlers::kQueueDelayCcConfig];
+    if (queue_delay_config.enabled) {
+      codel_settings.emplace(congestion_control::CoDel::Settings{
+          queue_delay_config.target_delay, queue_delay_config.interval});
+    }
+  }
+
+  auto payload = [this, request = std::move(request), handler,
+                  codel_settings] {
     server::request::kTaskInheritedRequest.Set(
         std::static_pointer_cast<HttpRequestImpl>(request));
 
     request->SetTaskStartTime();
 
+    if (codel_settings &&
+        ShouldShedByQueueDelay(*request, *handler, *codel_settings)) {
+      const auto now = std::chrono::steady_clock::now();
+      request->SetResponseNotifyTime(now);
+      request->GetResponse().SetReady(now);
+      return;
+    }
+
     request::RequestContext context;
     handler->HandleRequest(*request, context);
 
@@ -182,6 +210,33 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
   }
 }  // namespace http
 
+bool HttpRequestHandler::ShouldShedByQueueDelay(
+    request::RequestBase& request, const handlers::HttpHandlerBase& handler,
+    const congestion_control::CoDel::Settings& settings) const {
+  // Only the wait in the task processor queue, the time of receiving the
+  // request body does not count
+  const auto now = request.TaskStartTime();
+  const auto delay = now - request.TaskCreateTime();
+  if (!codel_.ShouldShed(delay, now, settings)) return false;
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+  auto& http_request = static_cast<http::HttpRequestImpl&>(request);
+  auto& http_response = http_request.GetHttpResponse();
+  SetThrottleReason(
+      http_response, "queue delay congestion control",
+      std::string{USERVER_NAMESPACE::http::headers::ratelimit_reason::kCC});
+  http_response.SetStatus(HttpStatus::kTooManyRequests);
+  handler.ReportMalformedRequest(request);
+  ++metrics_->GetMetric(kCcQueueDelayShed);
+
+  LOG_LIMITED_WARNING()
+      << "Request throttled (queue delay congestion control, "
+         "limit via USERVER_QUEUE_DELAY_CCONTROL), queue_delay="
+      << std::chrono::duration_cast<std::chrono::milliseconds>(delay)
+      << ", url=" << http_request.GetUrl();
+  return true;
+}
+
 void HttpRequestHandler::DisableAddHandler() {
   const auto was_enabled = !add_handler_disabled_.exchange(true);
   UASSERT(was_enabled);
@@ -2,6 +2,7 @@
 
 #include <optional>
 
+#include <server/congestion_control/codel.hpp>
 #include <server/http/request_handler_base.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/engine/mutex.hpp>
@@ -51,6 +52,11 @@ class HttpRequestHandler final : public RequestHandlerBase {
   void SetRpsRatelimitStatusCode(HttpStatus status_code);
 
  private:
+  // Sets the response if the request waited for too long under overload
+  bool ShouldShedByQueueDelay(
+      request::RequestBase& request, const handlers::HttpHandlerBase& handler,
+      const congestion_control::CoDel::Settings& settings) const;
+
   logging::LoggerPtr logger_access_;
   logging::LoggerPtr logger_access_tskv_;
 
@@ -67,6 +73,7 @@ class HttpRequestHandler final : public RequestHandlerBase {
   mutable utils::TokenBucket rate_limit_;
   std::atomic<HttpStatus> cc_status_code_{HttpStatus::kTooManyRequests};
   std::chrono::steady_clock::time_point cc_enabled_tp_;
+  mutable congestion_control::CoDel codel_;
   utils::statistics::MetricsStoragePtr metrics_;
   dynamic_config::Source config_source_;
 };
@@ -1,6 +1,8 @@
 #include <benchmark/benchmark.h>
 
 #include <server/http/http_request_constructor.hpp>
+#include <server/http/http_request_parser.hpp>
+#include <server/http/simd_http_request_parser.hpp>
 #include <userver/http/predefined_header.hpp>
 
 #include <utils/gbench_auxilary.hpp>
@@ -51,6 +53,37 @@ void http_request_headers_get(benchmark::State& state) {
   }
 }
 
+// Parses a request with state.range(0) headers of typical size
+template <typename Parser>
+void http_request_headers_parse(benchmark::State& state) {
+  const server::http::HandlerInfoIndex handler_info_index;
+  server::request::HttpRequestConfig config;
+  config.testing_mode = true;
+  server::net::ParserStats stats;
+  server::request::ResponseDataAccounter accounter;
+
+  std::string input = "GET /v1/endpoint HTTP/1.1\r\n";
+  for (int i = 0; i < state.range(0); i++) {
+    input += kHeadersArray[i];
+    input += ": some-typical-header-value-";
+    input += std::to_string(i);
+    input += "\r\n";
+  }
+  input += "\r\n";
+
+  Parser parser(
+      handler_info_index, config,
+      [](std::shared_ptr<server::request::RequestBase>&& request) {
+        benchmark::DoNotOptimize(request);
+      },
+      stats, accounter);
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(parser.Parse(input.data(), input.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+
 }  // namespace
 BENCHMARK(http_request_headers_insert)
     ->RangeMultiplier(2)
@@ -58,4 +91,12 @@ BENCHMARK(http_request_headers_insert)
 
 BENCHMARK(http_request_headers_get);
 
+BENCHMARK_TEMPLATE(http_request_headers_parse, server::http::HttpRequestParser)
+    ->RangeMultiplier(4)
+    ->Range(1, kHeadersCount);
+BENCHMARK_TEMPLATE(http_request_headers_parse,
+                   server::http::SimdHttpRequestParser)
+    ->RangeMultiplier(4)
+    ->Range(1, kHeadersCount);
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include "http_request_impl.hpp"
 
+#include <algorithm>
+
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/engine/task/task.hpp>
@@ -74,11 +76,14 @@ namespace server::http {
 // Use hash_function() magic to pass out the same RNG seed among all
 // unordered_maps because we don't need different seeds and want to avoid its
 // overhead.
-HttpRequestImpl::HttpRequestImpl(request::ResponseDataAccounter& data_accounter)
-    : form_data_args_(kZeroAllocationBucketCount,
+HttpRequestImpl::HttpRequestImpl(request::RequestArena& arena,
+                                 request::ResponseDataAccounter& data_accounter)
+    : request_args_(kZeroAllocationBucketCount, utils::StrCaseHash{},
+                    std::equal_to<>{}, request::ArenaAllocator<char>{arena}),
+      form_data_args_(kZeroAllocationBucketCount,
                       request_args_.hash_function()),
-      path_args_by_name_index_(kZeroAllocationBucketCount,
-                               request_args_.hash_function()),
+      path_args_(request::ArenaAllocator<char>{arena}),
+      path_arg_names_(request::ArenaAllocator<char>{arena}),
       headers_(kBucketCount),
       cookies_(kZeroAllocationBucketCount, request_args_.hash_function()),
       response_(*this, data_accounter) {}
@@ -166,11 +171,8 @@ std::vector<std::string> HttpRequestImpl::FormDataArgNames() const {
 
 const std::string& HttpRequestImpl::GetPathArg(
     std::string_view arg_name) const {
-  const auto* ptr =
-      utils::impl::FindTransparentOrNullptr(path_args_by_name_index_, arg_name);
-  if (!ptr) return kEmptyString;
-  UASSERT(*ptr < path_args_.size());
-  return path_args_[*ptr];
+  const auto index = FindPathArg(arg_name);
+  return index < path_args_.size() ? path_args_[index] : kEmptyString;
 }
 
 const std::string& HttpRequestImpl::GetPathArg(size_t index) const {
@@ -178,8 +180,7 @@ const std::string& HttpRequestImpl::GetPathArg(size_t index) const {
 }
 
 bool HttpRequestImpl::HasPathArg(std::string_view arg_name) const {
-  return !!utils::impl::FindTransparentOrNullptr(path_args_by_name_index_,
-                                                 arg_name);
+  return FindPathArg(arg_name) < path_args_.size();
 }
 
 bool HttpRequestImpl::HasPathArg(size_t index) const {
@@ -253,20 +254,45 @@ const HttpRequest::CookiesMap& HttpRequestImpl::GetCookies() const {
   return cookies_;
 }
 
+const std::string& HttpRequestImpl::RequestBody() const {
+  static const std::string kEmptyBody;
+  return request_body_ ? *request_body_ : kEmptyBody;
+}
+
+std::shared_ptr<const std::string> HttpRequestImpl::GetSharedRequestBody()
+    const {
+  static const auto kEmptyBody = std::make_shared<const std::string>();
+  if (!request_body_) return kEmptyBody;
+  return request_body_;
+}
+
 void HttpRequestImpl::SetRequestBody(std::string body) {
-  request_body_ = std::move(body);
+  request_body_ = std::make_shared<std::string>(std::move(body));
 }
 
 void HttpRequestImpl::ParseArgsFromBody() {
   UASSERT_MSG(
       request_args_.empty(),
       "References to arguments could be invalidated by ParseArgsFromBody()");
-  USERVER_NAMESPACE::http::parser::ParseAndConsumeArgs(
-      request_body_, [this](std::string&& key, std::string&& value) {
-        request_args_[std::move(key)].push_back(std::move(value));
+  USERVER_NAMESPACE::http::parser::ParseAndConsumeArgViews(
+      RequestBody(), [this](std::string_view key, std::string_view value) {
+        AddRequestArg(key, value);
       });
 }
 
+void HttpRequestImpl::AddRequestArg(std::string_view key,
+                                    std::string_view value) {
+  // The lookup by view does not allocate the key for the repeated arguments
+  auto* values = utils::impl::FindTransparentOrNullptr(request_args_, key);
+  if (!values) values = &request_args_[std::string{key}];
+  values->emplace_back(value);
+}
+
+RequestBodyStream& HttpRequestImpl::GetBodyStream() const {
+  if (!body_stream_) body_stream_.emplace(std::string_view{RequestBody()});
+  return *body_stream_;
+}
+
 bool HttpRequestImpl::IsBodyCompressed() const {
   const auto& encoding =
       GetHeader(USERVER_NAMESPACE::http::headers::kContentEncoding);
@@ -279,19 +305,25 @@ void HttpRequestImpl::DoUpgrade(std::unique_ptr<engine::io::RwBase>&& socket,
 }
 
 void HttpRequestImpl::SetPathArgs(
-    std::vector<std::pair<std::string, std::string>> args) {
+    utils::span<const std::pair<std::string_view, std::string_view>> args) {
   path_args_.clear();
   path_args_.reserve(args.size());
+  path_arg_names_.clear();
+  path_arg_names_.reserve(args.size());
 
-  path_args_by_name_index_.clear();
-  for (auto& [name, value] : args) {
-    path_args_.push_back(std::move(value));
-    if (!name.empty()) {
-      path_args_by_name_index_[std::move(name)] = path_args_.size() - 1;
-    }
+  for (const auto& [name, value] : args) {
+    path_args_.emplace_back(value);
+    path_arg_names_.push_back(name);
   }
 }
 
+std::size_t HttpRequestImpl::FindPathArg(std::string_view arg_name) const {
+  if (arg_name.empty()) return path_args_.size();
+  const auto it =
+      std::find(path_arg_names_.begin(), path_arg_names_.end(), arg_name);
+  return it - path_arg_names_.begin();
+}
+
 void HttpRequestImpl::SetMatchedPathLength(size_t length) {
   path_suffix_ = request_path_.substr(length);
 }
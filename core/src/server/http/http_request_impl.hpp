@@ -1,8 +1,12 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <unordered_map>
 #include <vector>
 
@@ -10,12 +14,16 @@
 
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_request_body_stream.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
 #include <userver/utils/impl/transparent_hash.hpp>
+#include <userver/utils/span.hpp>
 #include <userver/utils/str_icase.hpp>
 
+#include <server/request/request_arena.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server {
@@ -28,7 +36,10 @@ namespace http {
 
 class HttpRequestImpl final : public request::RequestBase {
  public:
-  HttpRequestImpl(request::ResponseDataAccounter& data_accounter);
+  /// Use request::RequestArena::MakeShared() to create the request, the
+  /// internal containers draw from the `arena`.
+  HttpRequestImpl(request::RequestArena& arena,
+                  request::ResponseDataAccounter& data_accounter);
   ~HttpRequestImpl() override;
 
   const HttpMethod& GetMethod() const { return method_; }
@@ -82,7 +93,8 @@ class HttpRequestImpl final : public request::RequestBase {
   HttpRequest::CookiesMapKeys GetCookieNames() const;
   const HttpRequest::CookiesMap& GetCookies() const;
 
-  const std::string& RequestBody() const { return request_body_; }
+  const std::string& RequestBody() const;
+  std::shared_ptr<const std::string> GetSharedRequestBody() const;
   void SetRequestBody(std::string body);
   void ParseArgsFromBody();
   void SetResponseStatus(HttpStatus status) const {
@@ -91,8 +103,14 @@ class HttpRequestImpl final : public request::RequestBase {
 
   bool IsBodyCompressed() const;
 
+  RequestBodyStream& GetBodyStream() const;
+  bool IsBodyStreamed() const override { return is_body_streamed_; }
+
   bool IsFinal() const override { return is_final_; }
 
+  // HTTP/2 stream identifier, 0 for HTTP/1.x requests
+  std::int32_t GetStreamId() const { return stream_id_; }
+
   using UpgradeCallback = std::function<void(
       std::unique_ptr<engine::io::RwBase>&&, engine::io::Sockaddr&&)>;
 
@@ -120,7 +138,9 @@ class HttpRequestImpl final : public request::RequestBase {
                           utils::datetime::WallCoarseClock::time_point tp,
                           const std::string& remote_address) const;
 
-  void SetPathArgs(std::vector<std::pair<std::string, std::string>> args);
+  /// The names must outlive the request
+  void SetPathArgs(
+      utils::span<const std::pair<std::string_view, std::string_view>> args);
 
   void SetMatchedPathLength(size_t length) override;
 
@@ -139,25 +159,42 @@ class HttpRequestImpl final : public request::RequestBase {
   friend class HttpRequestConstructor;
 
  private:
+  void AddRequestArg(std::string_view key, std::string_view value);
+
+  // path_args_.size() if not found
+  std::size_t FindPathArg(std::string_view arg_name) const;
+
+  template <typename Value>
+  using ArenaArgsMap = utils::impl::TransparentMap<
+      std::string, Value, utils::StrCaseHash, std::equal_to<>,
+      request::ArenaAllocator<std::pair<const std::string, Value>>>;
+
   HttpMethod method_{HttpMethod::kUnknown};
   unsigned short http_major_{1};
   unsigned short http_minor_{1};
   std::string url_;
   std::string request_path_;
-  std::string request_body_;
+  // Allocated with the first body chunk, may be shared with the requests
+  // of the HTTP client to proxy the body without a copy
+  std::shared_ptr<std::string> request_body_;
   std::string path_suffix_;
-  utils::impl::TransparentMap<std::string, std::vector<std::string>,
-                              utils::StrCaseHash>
-      request_args_;
+  ArenaArgsMap<std::vector<std::string>> request_args_;
   utils::impl::TransparentMap<std::string, std::vector<FormDataArg>,
                               utils::StrCaseHash>
       form_data_args_;
-  std::vector<std::string> path_args_;
-  utils::impl::TransparentMap<std::string, size_t, utils::StrCaseHash>
-      path_args_by_name_index_;
+  std::vector<std::string, request::ArenaAllocator<std::string>> path_args_;
+  // Empty for the unnamed args, there are few path args so the lookup is
+  // linear
+  std::vector<std::string_view, request::ArenaAllocator<std::string_view>>
+      path_arg_names_;
   HttpRequest::HeadersMap headers_;
   HttpRequest::CookiesMap cookies_;
+  // Set by HttpRequestConstructor for the streamed bodies, emplaced on the
+  // first use otherwise
+  mutable std::optional<RequestBodyStream> body_stream_;
+  bool is_body_streamed_{false};
   bool is_final_{false};
+  std::int32_t stream_id_{0};
   UpgradeCallback upgrade_websocket_cb_;
 
   mutable HttpResponse response_;
@@ -64,10 +64,19 @@ HttpRequestParser::HttpRequestParser(
 
 bool HttpRequestParser::Parse(const char* data, size_t size) {
   size_t parsed = http_parser_execute(&parser_, &parser_settings, data, size);
+  if (HTTP_PARSER_ERRNO(&parser_) == HPE_PAUSED) {
+    // The streamed body of the final request is complete
+    return false;
+  }
   if (parsed != size) {
     LOG_WARNING() << "parsed=" << parsed << " size=" << size
                   << " error_description="
                   << http_errno_description(HTTP_PARSER_ERRNO(&parser_));
+    if (body_producer_) {
+      // The request is already passed to the handler, its body is aborted
+      body_producer_.reset();
+      return false;
+    }
     FinalizeRequest();
     return false;
   }
@@ -181,11 +190,17 @@ int HttpRequestParser::OnHeadersCompleteImpl(http_parser* p) {
     return -1;
   }
   LOG_TRACE() << "headers complete";
+  if (request_constructor_->IsBodyStreamRequested() && !p->upgrade) {
+    if (!StartBodyStream(p)) return -1;
+  }
   return 0;
 }
 
 int HttpRequestParser::OnBodyImpl(http_parser* p, const char* data,
                                   size_t size) {
+  if (body_producer_) {
+    return body_producer_->Push(std::string_view(data, size)) ? 0 : -1;
+  }
   UASSERT(request_constructor_);
   if (!CheckUrlComplete(p)) return -1;
   LOG_TRACE() << "body: '" << std::string_view(data, size) << "'";
@@ -199,6 +214,14 @@ int HttpRequestParser::OnBodyImpl(http_parser* p, const char* data,
 }
 
 int HttpRequestParser::OnMessageCompleteImpl(http_parser* p) {
+  if (body_producer_) {
+    LOG_TRACE() << "streamed message complete";
+    body_producer_->Complete();
+    body_producer_.reset();
+    // The rest of the input is ignored after the final request
+    if (!http_should_keep_alive(p)) http_parser_pause(p, 1);
+    return 0;
+  }
   UASSERT(request_constructor_);
   if (p->upgrade) {
     return -1;  // error
@@ -233,6 +256,14 @@ bool HttpRequestParser::CheckUrlComplete(http_parser* p) {
   return true;
 }
 
+bool HttpRequestParser::StartBodyStream(http_parser* p) {
+  request_constructor_->SetIsFinal(!http_should_keep_alive(p));
+  auto body_producer = request_constructor_->StartBodyStream();
+  if (!FinalizeRequest()) return false;
+  body_producer_ = std::move(body_producer);
+  return true;
+}
+
 bool HttpRequestParser::FinalizeRequest() {
   bool res = FinalizeRequestImpl();
   --stats_.parsing_request_count;
@@ -54,6 +54,8 @@ class HttpRequestParser final : public request::RequestParser {
 
   bool CheckUrlComplete(http_parser* p);
 
+  bool StartBodyStream(http_parser* p);
+
   bool FinalizeRequest();
   bool FinalizeRequestImpl();
 
@@ -66,6 +68,9 @@ class HttpRequestParser final : public request::RequestParser {
 
   http_parser parser_{};
   std::optional<HttpRequestConstructor> request_constructor_;
+  // Body of the already finalized request that is passed to the handler as
+  // it is received
+  std::unique_ptr<RequestBodyProducer> body_producer_;
 
   static const http_parser_settings parser_settings;
   net::ParserStats& stats_;
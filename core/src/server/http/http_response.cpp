@@ -7,6 +7,7 @@
 
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/fs/blocking/mapped_file.hpp>
 #include <userver/hostinfo/blocking/get_hostname.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/http/content_type.hpp>
@@ -36,6 +37,10 @@ constexpr std::string_view kKeyValueHeaderSeparator = ": ";
 // charset https://www.iana.org/assignments/media-types/application/octet-stream
 constexpr std::string_view kDefaultContentType = "application/octet-stream";
 
+// Enough for "\r\n{:x}\r\n" of any std::size_t
+constexpr std::size_t kChunkSizeBufferSize = 2 + sizeof(std::size_t) * 2 + 2;
+constexpr std::size_t kMaxChunksPerWrite = 16;
+
 constexpr std::string_view kClose = "close";
 constexpr std::string_view kKeepAlive = "keep-alive";
 
@@ -78,6 +83,23 @@ bool IsBodyForbiddenForStatus(server::http::HttpStatus status) {
          (static_cast<int>(status) >= 100 && static_cast<int>(status) < 200);
 }
 
+// RFC 9113, section 8.2.2
+bool IsConnectionSpecificHeader(std::string_view name) {
+  const utils::StrIcaseEqual equal;
+  return equal(name, USERVER_NAMESPACE::http::headers::kConnection) ||
+         equal(name, USERVER_NAMESPACE::http::headers::kTransferEncoding) ||
+         equal(name, USERVER_NAMESPACE::http::headers::kUpgrade) ||
+         equal(name, "Keep-Alive") || equal(name, "Proxy-Connection");
+}
+
+std::string ToLowerAscii(std::string_view str) {
+  std::string result{str};
+  for (auto& c : result) {
+    if (c >= 'A' && c <= 'Z') c = c - 'A' + 'a';
+  }
+  return result;
+}
+
 void AppendToCharArray(char*& data, const std::string_view what) {
   std::memcpy(data, what.begin(), what.size());
   data += what.size();
@@ -85,6 +107,58 @@ void AppendToCharArray(char*& data, const std::string_view what) {
 
 const std::string kEmptyString{};
 
+template <typename Name>
+const std::string& GetPreparedHeader(
+    const server::http::HttpResponse::PreparedHeaders& prepared,
+    const Name& name) {
+  const auto it = prepared.headers.find(name);
+  if (it == prepared.headers.end()) return kEmptyString;
+  return it->second;
+}
+
+// Rendered once for each status of HTTP/1.0 and HTTP/1.1
+class StatusLines final {
+ public:
+  StatusLines() {
+    for (int minor = 0; minor < kHttpMinorVersions; ++minor) {
+      for (int code = kMinStatus; code <= kMaxStatus; ++code) {
+        lines_[minor][code - kMinStatus] = fmt::format(
+            FMT_COMPILE("HTTP/1.{} {} {}\r\n"), minor, code,
+            HttpStatusString(static_cast<server::http::HttpStatus>(code)));
+      }
+    }
+  }
+
+  // Empty for the versions and statuses out of the table
+  std::string_view Find(int major, int minor, int code) const {
+    if (major != 1 || minor < 0 || minor >= kHttpMinorVersions ||
+        code < kMinStatus || code > kMaxStatus) {
+      return {};
+    }
+    return lines_[minor][code - kMinStatus];
+  }
+
+ private:
+  static constexpr int kHttpMinorVersions = 2;
+  static constexpr int kMinStatus = 100;
+  static constexpr int kMaxStatus = 599;
+
+  std::array<std::array<std::string, kMaxStatus - kMinStatus + 1>,
+             kHttpMinorVersions>
+      lines_;
+};
+
+const StatusLines kStatusLines;
+
+// Connection-related and per-response headers are formatted by HttpResponse
+bool IsPreparedHeaderForbidden(std::string_view name) {
+  const utils::StrIcaseEqual equal;
+  return equal(name, USERVER_NAMESPACE::http::headers::kDate) ||
+         equal(name, USERVER_NAMESPACE::http::headers::kConnection) ||
+         equal(name, USERVER_NAMESPACE::http::headers::kContentLength) ||
+         equal(name, USERVER_NAMESPACE::http::headers::kTransferEncoding);
+}
+
 }  // namespace
 
 namespace server::http {
@@ -184,6 +258,7 @@ bool HttpResponse::ClearHeaders() {
   }
 
   headers_.clear();
+  prepared_headers_.reset();
   return true;
 }
 
@@ -208,26 +283,32 @@ HttpResponse::HeadersMapKeys HttpResponse::GetHeaderNames() const {
 
 const std::string& HttpResponse::GetHeader(std::string_view header_name) const {
   auto it = headers_.find(header_name);
-  if (it == headers_.end()) return kEmptyString;
-  return it->second;
+  if (it != headers_.end()) return it->second;
+  return prepared_headers_ ? GetPreparedHeader(*prepared_headers_, header_name)
+                           : kEmptyString;
 }
 
 const std::string& HttpResponse::GetHeader(
     const USERVER_NAMESPACE::http::headers::PredefinedHeader& header_name)
     const {
   auto it = headers_.find(header_name);
-  if (it == headers_.end()) return kEmptyString;
-  return it->second;
+  if (it != headers_.end()) return it->second;
+  return prepared_headers_ ? GetPreparedHeader(*prepared_headers_, header_name)
+                           : kEmptyString;
 }
 
 bool HttpResponse::HasHeader(std::string_view header_name) const {
-  return headers_.find(header_name) != headers_.end();
+  return headers_.find(header_name) != headers_.end() ||
+         (prepared_headers_ && prepared_headers_->headers.find(header_name) !=
+                                   prepared_headers_->headers.end());
 }
 
 bool HttpResponse::HasHeader(
     const USERVER_NAMESPACE::http::headers::PredefinedHeader& header_name)
     const {
-  return headers_.find(header_name) != headers_.end();
+  return headers_.find(header_name) != headers_.end() ||
+         (prepared_headers_ && prepared_headers_->headers.find(header_name) !=
+                                   prepared_headers_->headers.end());
 }
 
 HttpResponse::CookiesMapKeys HttpResponse::GetCookieNames() const {
@@ -238,6 +319,64 @@ const Cookie& HttpResponse::GetCookie(std::string_view cookie_name) const {
   return cookies_.at(cookie_name.data());
 }
 
+void HttpResponse::SetFileBody(
+    std::shared_ptr<const fs::blocking::MappedFile> file) {
+  file_body_ = std::move(file);
+}
+
+std::shared_ptr<const HttpResponse::PreparedHeaders>
+HttpResponse::MakePreparedHeaders(HeadersMap headers) {
+  auto result = std::make_shared<PreparedHeaders>();
+  for (const auto& [name, value] : headers) {
+    CheckHeaderName(name);
+    CheckHeaderValue(value);
+    if (IsPreparedHeaderForbidden(name)) {
+      throw std::runtime_error(
+          fmt::format("header '{}' is set for each response and cannot be "
+                      "prepared in advance",
+                      name));
+    }
+  }
+
+  USERVER_NAMESPACE::http::headers::HeadersString formatted;
+  headers.OutputInHttpFormat(formatted);
+  result->http1.assign(formatted.data(), formatted.size());
+  result->headers = std::move(headers);
+  return result;
+}
+
+void HttpResponse::SetPreparedHeaders(
+    std::shared_ptr<const PreparedHeaders> headers) {
+  prepared_headers_ = std::move(headers);
+}
+
+bool HttpResponse::IsPreparedHeaderOverridden(std::string_view name) const {
+  return !headers_.empty() && headers_.find(name) != headers_.end();
+}
+
+void HttpResponse::OutputPreparedHeaders(
+    USERVER_NAMESPACE::http::headers::HeadersString& header) const {
+  UASSERT(prepared_headers_);
+  bool is_overridden = false;
+  for (const auto& [name, value] : headers_) {
+    if (prepared_headers_->headers.find(name) !=
+        prepared_headers_->headers.end()) {
+      is_overridden = true;
+      break;
+    }
+  }
+
+  if (!is_overridden) {
+    header.append(prepared_headers_->http1);
+    return;
+  }
+  for (const auto& [name, value] : prepared_headers_->headers) {
+    if (!IsPreparedHeaderOverridden(name)) {
+      impl::OutputHeader(header, name, value);
+    }
+  }
+}
+
 void HttpResponse::SetHeadersEnd() { headers_end_.Send(); }
 
 bool HttpResponse::WaitForHeadersEnd() { return headers_end_.WaitForEvent(); }
@@ -246,18 +385,25 @@ void HttpResponse::SendResponse(engine::io::RwBase& socket) {
   utils::SmallString<USERVER_NAMESPACE::http::headers::kTypicalHeadersSize>
       header;
 
-  header.resize_and_overwrite(
-      USERVER_NAMESPACE::http::headers::kTypicalHeadersSize,
-      [&](char* data, std::size_t) {
-        char* old_data_pointer = data;
-        AppendToCharArray(data, "HTTP/");
-        data = fmt::format_to(data, FMT_COMPILE("{}.{} {} "),
-                              request_.GetHttpMajor(), request_.GetHttpMinor(),
-                              static_cast<int>(status_));
-        AppendToCharArray(data, HttpStatusString(status_));
-        AppendToCharArray(data, kCrlf);
-        return data - old_data_pointer;
-      });
+  const auto status_line = kStatusLines.Find(
+      request_.GetHttpMajor(), request_.GetHttpMinor(),
+      static_cast<int>(status_));
+  if (!status_line.empty()) {
+    header.append(status_line);
+  } else {
+    header.resize_and_overwrite(
+        USERVER_NAMESPACE::http::headers::kTypicalHeadersSize,
+        [&](char* data, std::size_t) {
+          char* old_data_pointer = data;
+          AppendToCharArray(data, "HTTP/");
+          data = fmt::format_to(
+              data, FMT_COMPILE("{}.{} {} "), request_.GetHttpMajor(),
+              request_.GetHttpMinor(), static_cast<int>(status_));
+          AppendToCharArray(data, HttpStatusString(status_));
+          AppendToCharArray(data, kCrlf);
+          return data - old_data_pointer;
+        });
+  }
 
   headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
   const auto end = headers_.end();
@@ -266,11 +412,12 @@ void HttpResponse::SendResponse(engine::io::RwBase& socket) {
                        // impl::GetCachedDate() must not cross thread boundaries
                        impl::GetCachedDate());
   }
-  if (headers_.find(USERVER_NAMESPACE::http::headers::kContentType) == end) {
+  if (!HasHeader(USERVER_NAMESPACE::http::headers::kContentType)) {
     impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kContentType,
                        kDefaultContentType);
   }
   headers_.OutputInHttpFormat(header);
+  if (prepared_headers_) OutputPreparedHeaders(header);
   if (headers_.find(USERVER_NAMESPACE::http::headers::kConnection) == end) {
     impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kConnection,
                        (request_.IsFinal() ? kClose : kKeepAlive));
@@ -300,6 +447,8 @@ void HttpResponse::SendResponse(engine::io::RwBase& socket) {
 
   if (IsBodyStreamed() && GetData().empty()) {
     sent_bytes = SetBodyStreamed(socket, header);
+  } else if (file_body_ && GetData().empty()) {
+    sent_bytes = SetBodyFromFile(socket, header);
   } else {
     // e.g. a CustomHandlerException
     sent_bytes = SetBodyNotStreamed(socket, header);
@@ -308,6 +457,59 @@ void HttpResponse::SendResponse(engine::io::RwBase& socket) {
   SetSent(sent_bytes, std::chrono::steady_clock::now());
 }
 
+HttpResponse::Http2Response HttpResponse::PrepareHttp2Response() {
+  Http2Response result;
+  result.is_body_streamed = IsBodyStreamed() && GetData().empty();
+  const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
+  const auto body = (GetData().empty() && file_body_)
+                        ? file_body_->GetView()
+                        : std::string_view{GetData()};
+
+  if (is_body_forbidden && !body.empty()) {
+    LOG_LIMITED_WARNING()
+        << "Non-empty body provided for response with HTTP code "
+        << static_cast<int>(status_)
+        << " which does not allow one, it will be dropped";
+  }
+
+  auto& headers = result.headers;
+  headers.reserve(headers_.size() + cookies_.size() + 4);
+  headers.emplace_back(
+      ":status", fmt::format(FMT_COMPILE("{}"), static_cast<int>(status_)));
+
+  headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
+  const auto end = headers_.end();
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
+    // impl::GetCachedDate() must not cross thread boundaries
+    headers.emplace_back("date", std::string{impl::GetCachedDate()});
+  }
+  if (!HasHeader(USERVER_NAMESPACE::http::headers::kContentType)) {
+    headers.emplace_back("content-type", std::string{kDefaultContentType});
+  }
+  for (const auto& [name, value] : headers_) {
+    if (IsConnectionSpecificHeader(name)) continue;
+    headers.emplace_back(ToLowerAscii(name), value);
+  }
+  if (prepared_headers_) {
+    for (const auto& [name, value] : prepared_headers_->headers) {
+      if (IsPreparedHeaderOverridden(name)) continue;
+      headers.emplace_back(ToLowerAscii(name), value);
+    }
+  }
+  for (const auto& cookie : cookies_) {
+    headers.emplace_back("set-cookie", cookie.second.ToString());
+  }
+  if (!result.is_body_streamed && !is_body_forbidden) {
+    headers.emplace_back("content-length",
+                         fmt::format(FMT_COMPILE("{}"), body.size()));
+  }
+
+  if (!is_body_forbidden && request_.GetMethod() != HttpMethod::kHead) {
+    result.body = body;
+  }
+  return result;
+}
+
 std::size_t HttpResponse::SetBodyNotStreamed(
     engine::io::RwBase& socket,
     USERVER_NAMESPACE::http::headers::HeadersString& header) {
@@ -341,34 +543,105 @@ std::size_t HttpResponse::SetBodyNotStreamed(
   return sent_bytes;
 }
 
+std::size_t HttpResponse::SetBodyFromFile(
+    engine::io::RwBase& socket,
+    USERVER_NAMESPACE::http::headers::HeadersString& header) {
+  UASSERT(file_body_);
+  const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
+  const bool is_head_request = request_.GetMethod() == HttpMethod::kHead;
+  const auto contents = file_body_->GetView();
+
+  if (!is_body_forbidden) {
+    impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kContentLength,
+                       fmt::format(FMT_COMPILE("{}"), contents.size()));
+  }
+  header.append(kCrlf);
+
+  if (is_head_request || is_body_forbidden) {
+    return socket.WriteAll(header.data(), header.size(), engine::Deadline{});
+  }
+
+  // TLS has to encrypt the data in the userspace anyway
+  auto* tcp_socket = dynamic_cast<engine::io::Socket*>(&socket);
+  if (!tcp_socket) {
+    return socket.WriteAll(
+        {{header.data(), header.size()}, {contents.data(), contents.size()}},
+        engine::Deadline{});
+  }
+
+  const auto header_bytes =
+      tcp_socket->SendAll(header.data(), header.size(), engine::Deadline{});
+  if (header_bytes != header.size()) return header_bytes;
+  return header_bytes + tcp_socket->SendFile(file_body_->GetNative(), 0,
+                                             contents.size(),
+                                             engine::Deadline{});
+}
+
 std::size_t HttpResponse::SetBodyStreamed(
     engine::io::RwBase& socket,
     USERVER_NAMESPACE::http::headers::HeadersString& header) {
   impl::OutputHeader(
       header, USERVER_NAMESPACE::http::headers::kTransferEncoding, "chunked");
 
-  // send HTTP headers
-  size_t sent_bytes = socket.WriteAll(header.data(), header.size(), {});
-  header.clear();
-  header.shrink_to_fit();  // free memory before time-consuming operation
-
-  // Transmit HTTP response body
-  std::string body_part;
-  while (body_stream_->Pop(body_part)) {
-    if (body_part.empty()) {
-      LOG_DEBUG() << "Zero size body_part in http_response.cpp";
-      continue;
+  // Body parts that are already in the queue are sent along with the headers
+  // and with each other in a single vectored write. The buffers are reused
+  // between the writes.
+  std::array<std::string, kMaxChunksPerWrite> body_parts;
+  std::array<std::array<char, kChunkSizeBufferSize>, kMaxChunksPerWrite>
+      chunk_sizes{};
+  std::array<engine::io::IoData, kMaxChunksPerWrite * 2 + 2> io_data{};
+
+  std::size_t io_data_size = 0;
+  io_data[io_data_size++] = {header.data(), header.size()};
+  bool are_headers_sent = false;
+
+  size_t sent_bytes = 0;
+  bool is_finished = false;
+  while (!is_finished) {
+    std::size_t chunks_count = 0;
+    while (chunks_count < kMaxChunksPerWrite) {
+      auto& body_part = body_parts[chunks_count];
+      // Block only if there is nothing to send
+      if (io_data_size == 0) {
+        if (!body_stream_->Pop(body_part)) {
+          is_finished = true;
+          break;
+        }
+      } else if (!body_stream_->PopNoblock(body_part)) {
+        break;
+      }
+
+      if (body_part.empty()) {
+        LOG_DEBUG() << "Zero size body_part in http_response.cpp";
+        continue;
+      }
+
+      auto& chunk_size = chunk_sizes[chunks_count];
+      const auto chunk_size_length =
+          fmt::format_to_n(chunk_size.data(), chunk_size.size(),
+                           FMT_COMPILE("\r\n{:x}\r\n"), body_part.size())
+              .size;
+      io_data[io_data_size++] = {chunk_size.data(), chunk_size_length};
+      io_data[io_data_size++] = {body_part.data(), body_part.size()};
+      ++chunks_count;
     }
 
-    auto size = fmt::format("\r\n{:x}\r\n", body_part.size());
-    sent_bytes += socket.WriteAll(
-        {{size.data(), size.size()}, {body_part.data(), body_part.size()}},
-        engine::Deadline{});
-  }
+    if (is_finished) {
+      constexpr std::string_view kTerminatingChunk{"\r\n0\r\n\r\n"};
+      io_data[io_data_size++] = {kTerminatingChunk.data(),
+                                 kTerminatingChunk.size()};
+    }
+
+    sent_bytes +=
+        socket.WriteAllv(io_data.data(), io_data_size, engine::Deadline{});
+    io_data_size = 0;
 
-  const constexpr std::string_view terminating_chunk{"\r\n0\r\n\r\n"};
-  sent_bytes +=
-      socket.WriteAll(terminating_chunk.data(), terminating_chunk.size(), {});
+    if (!are_headers_sent) {
+      are_headers_sent = true;
+      header.clear();
+      header.shrink_to_fit();  // free memory before time-consuming operation
+    }
+  }
 
   // TODO: exceptions?
   body_stream_producer_.reset();
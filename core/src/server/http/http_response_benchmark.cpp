@@ -1,9 +1,17 @@
 #include <benchmark/benchmark.h>
 
 #include <fmt/compile.h>
+#include <array>
+#include <atomic>
 #include <sstream>
+#include <string>
+#include <vector>
 
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/http/common_headers.hpp>
+#include <userver/internal/net/net_listener.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/http/http_status.hpp>
 #include <userver/utils/small_string.hpp>
@@ -73,6 +81,28 @@ void http_headers_serialization_inplace(benchmark::State& state) {
   }
 }
 
+// Status line and static headers rendered in advance, as with the
+// `response-headers` of a handler
+void http_headers_serialization_prepared(benchmark::State& state) {
+  const std::string status_line = fmt::format(
+      "HTTP/1.1 200 {}\r\n",
+      HttpStatusString(server::http::HttpStatus::kOk));
+  USERVER_NAMESPACE::http::headers::HeadersString formatted;
+  kHeaders.OutputInHttpFormat(formatted);
+  const std::string prepared{formatted.data(), formatted.size()};
+
+  for ([[maybe_unused]] auto _ : state) {
+    USERVER_NAMESPACE::http::headers::HeadersString os;
+    os.append(status_line);
+    os.append(prepared);
+    server::http::impl::OutputHeader(
+        os, USERVER_NAMESPACE::http::headers::kContentLength,
+        fmt::format(FMT_COMPILE("{}"), 1024));
+
+    benchmark::DoNotOptimize(os);
+  }
+}
+
 void http_headers_serialization_no_ostreams(benchmark::State& state) {
   for ([[maybe_unused]] auto _ : state) {
     std::string os;
@@ -120,10 +150,65 @@ void http_headers_serialization_ostreams(benchmark::State& state) {
   }
 }
 
+// Writes a streamed response of headers and state.range(0) chunks, either with
+// a write per buffer or with a single vectored write.
+template <bool IsVectored>
+void http_response_write_chunks(benchmark::State& state) {
+  engine::RunStandalone(2, [&] {
+    const auto deadline =
+        engine::Deadline::FromDuration(std::chrono::minutes{1});
+    internal::net::TcpListener listener;
+    auto [server, client] = listener.MakeSocketPair(deadline);
+
+    std::atomic<bool> reading{true};
+    auto reader = engine::AsyncNoSpan([&] {
+      std::array<char, 16 * 1024> buf{};
+      while (reading && client.RecvSome(buf.data(), buf.size(), deadline) > 0) {
+      }
+    });
+
+    const std::string headers(512, 'h');
+    const std::string chunk(128, 'c');
+    const std::string chunk_size = fmt::format("\r\n{:x}\r\n", chunk.size());
+    const std::size_t chunks_count = state.range(0);
+
+    std::vector<engine::io::IoData> io_data;
+    for ([[maybe_unused]] auto _ : state) {
+      engine::io::RwBase& socket = server;
+      std::size_t sent_bytes = 0;
+      if constexpr (IsVectored) {
+        io_data.clear();
+        io_data.push_back({headers.data(), headers.size()});
+        for (std::size_t i = 0; i < chunks_count; ++i) {
+          io_data.push_back({chunk_size.data(), chunk_size.size()});
+          io_data.push_back({chunk.data(), chunk.size()});
+        }
+        sent_bytes += socket.WriteAllv(io_data.data(), io_data.size(), {});
+      } else {
+        sent_bytes += socket.WriteAll(headers.data(), headers.size(), {});
+        for (std::size_t i = 0; i < chunks_count; ++i) {
+          sent_bytes +=
+              socket.WriteAll({{chunk_size.data(), chunk_size.size()},
+                               {chunk.data(), chunk.size()}},
+                              {});
+        }
+      }
+      benchmark::DoNotOptimize(sent_bytes);
+    }
+
+    reading = false;
+    server.Close();
+    reader.Get();
+  });
+}
+
 }  // namespace
 
 BENCHMARK(http_headers_serialization_inplace);
+BENCHMARK(http_headers_serialization_prepared);
 BENCHMARK(http_headers_serialization_no_ostreams);
 BENCHMARK(http_headers_serialization_ostreams);
+BENCHMARK_TEMPLATE(http_response_write_chunks, false)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(http_response_write_chunks, true)->Arg(1)->Arg(4)->Arg(16);
 
 USERVER_NAMESPACE_END
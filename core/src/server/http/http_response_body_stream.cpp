@@ -1,25 +1,144 @@
 #include <userver/server/http/http_response_body_stream.hpp>
 
+#include <mutex>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <compression/gzip.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
+// Coalesces the chunks into a single queue item. The background task sends the
+// buffer once its first chunk has waited for `flush_delay`.
+struct ResponseBodyStream::Buffer final {
+  Buffer(HttpResponse::Queue::Producer&& producer,
+         compression::gzip::Compressor* compressor, std::size_t buffer_size,
+         std::chrono::milliseconds flush_delay)
+      : producer(std::move(producer)),
+        compressor(compressor),
+        buffer_size(buffer_size),
+        flush_delay(flush_delay),
+        flusher(engine::AsyncNoSpan([this] { RunFlusher(); })) {}
+
+  void Push(std::string&& chunk, engine::Deadline deadline) {
+    const std::unique_lock lock{mutex};
+    if (data.empty()) {
+      if (chunk.size() >= buffer_size) {
+        Send(std::move(chunk), deadline);
+        return;
+      }
+      data.reserve(buffer_size);
+      flush_deadline = engine::Deadline::FromDuration(flush_delay);
+      cv.NotifyOne();
+    }
+    data.append(chunk);
+    if (data.size() >= buffer_size || flush_deadline.IsReached()) {
+      Send(std::exchange(data, {}), deadline);
+    }
+  }
+
+  void Flush(engine::Deadline deadline) {
+    const std::unique_lock lock{mutex};
+    if (!data.empty()) Send(std::exchange(data, {}), deadline);
+  }
+
+  // Stops the background task and sends the rest of the data
+  void Finish(bool send_rest) noexcept {
+    flusher.SyncCancel();
+    if (!send_rest) return;
+
+    try {
+      const std::unique_lock lock{mutex};
+      if (compressor && !compressor->IsFinished()) {
+        data = compressor->Finish(data);
+      }
+      if (!data.empty()) {
+        [[maybe_unused]] const auto success =
+            producer.Push(std::exchange(data, {}), engine::Deadline{});
+      }
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "Failed to send the buffered response body: " << ex;
+    }
+  }
+
+  // Must be called with the mutex locked
+  void Send(std::string&& chunk, engine::Deadline deadline) {
+    if (compressor) {
+      chunk = compressor->Compress(chunk);
+      if (chunk.empty()) return;
+    }
+    // Blocks while the client does not read the previous chunks
+    [[maybe_unused]] const auto success =
+        producer.Push(std::move(chunk), deadline);
+  }
+
+  void RunFlusher() {
+    std::unique_lock lock{mutex};
+    while (cv.Wait(lock, [this] { return !data.empty(); })) {
+      // The producer has sent the data by itself
+      if (cv.WaitUntil(lock, flush_deadline, [this] { return data.empty(); })) {
+        continue;
+      }
+      if (engine::current_task::ShouldCancel()) return;
+      if (flush_deadline.IsReached()) {
+        Send(std::exchange(data, {}), engine::Deadline{});
+      }
+    }
+  }
+
+  HttpResponse::Queue::Producer producer;
+  compression::gzip::Compressor* const compressor;
+  const std::size_t buffer_size;
+  const std::chrono::milliseconds flush_delay;
+
+  engine::Mutex mutex;
+  engine::ConditionVariable cv;
+  std::string data;
+  engine::Deadline flush_deadline;
+
+  // Must be the last member, it uses the other ones
+  engine::TaskWithResult<void> flusher;
+};
+
 ResponseBodyStream::ResponseBodyStream(
     server::http::HttpResponse::Queue::Producer&& queue_producer,
     server::http::HttpResponse& http_response)
     : queue_producer_(std::move(queue_producer)),
       http_response_(http_response) {}
 
+ResponseBodyStream::ResponseBodyStream(ResponseBodyStream&&) noexcept = default;
+
+ResponseBodyStream::~ResponseBodyStream() { Finish(); }
+
 void ResponseBodyStream::PushBodyChunk(std::string&& chunk,
                                        engine::Deadline deadline) {
   UASSERT_MSG(headers_ended_,
               "SetEndOfHeaders() was not called before PushBodyChunk()");
+  if (buffer_) {
+    buffer_->Push(std::move(chunk), deadline);
+    return;
+  }
+  if (compressor_) {
+    chunk = compressor_->Compress(chunk);
+    if (chunk.empty()) return;
+  }
   const auto success = queue_producer_.Push(std::move(chunk), deadline);
   UASSERT(success);
 }
 
+void ResponseBodyStream::Flush(engine::Deadline deadline) {
+  if (buffer_) buffer_->Flush(deadline);
+}
+
 void ResponseBodyStream::SetHeader(const std::string& name,
                                    const std::string& value) {
   http_response_.SetHeader(name, value);
@@ -43,6 +162,45 @@ void ResponseBodyStream::SetStatusCode(HttpStatus status) {
   http_response_.SetStatus(status);
 }
 
+void ResponseBodyStream::EnableCompression(int level) {
+  UASSERT_MSG(!headers_ended_,
+              "EnableCompression() must be called before SetEndOfHeaders()");
+  compressor_ = std::make_unique<compression::gzip::Compressor>(level);
+  http_response_.SetHeader(USERVER_NAMESPACE::http::headers::kContentEncoding,
+                           "gzip");
+  http_response_.SetHeader(USERVER_NAMESPACE::http::headers::kVary,
+                           "Accept-Encoding");
+}
+
+void ResponseBodyStream::EnableBuffering(
+    std::size_t buffer_size, std::chrono::milliseconds flush_delay) {
+  UASSERT_MSG(!buffer_, "EnableBuffering() is called twice");
+  UASSERT(buffer_size > 0);
+  buffer_ = std::make_unique<Buffer>(std::move(queue_producer_),
+                                     compressor_.get(), buffer_size,
+                                     flush_delay);
+}
+
+void ResponseBodyStream::Finish() noexcept {
+  if (buffer_) {
+    buffer_->Finish(headers_ended_);
+  } else {
+    FinishCompression();
+  }
+}
+
+void ResponseBodyStream::FinishCompression() noexcept {
+  if (!compressor_ || compressor_->IsFinished() || !headers_ended_) return;
+
+  try {
+    auto tail = compressor_->Finish();
+    [[maybe_unused]] const auto success =
+        queue_producer_.Push(std::move(tail), engine::Deadline{});
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to finish the compressed response body: " << ex;
+  }
+}
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
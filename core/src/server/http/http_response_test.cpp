@@ -5,6 +5,7 @@
 #include <gmock/gmock.h>
 
 #include <server/http/http_request_impl.hpp>
+#include <server/request/request_arena.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/internal/net/net_listener.hpp>
@@ -13,13 +14,23 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace {
+
+std::shared_ptr<server::http::HttpRequestImpl> MakeRequest(
+    server::request::ResponseDataAccounter& accounter) {
+  return server::request::RequestArena::MakeShared<
+      server::http::HttpRequestImpl>(accounter);
+}
+
+}  // namespace
+
 UTEST(HttpResponse, Smoke) {
   const auto test_deadline =
       engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
 
   server::request::ResponseDataAccounter accounter;
-  server::http::HttpRequestImpl request{accounter};
-  server::http::HttpResponse response{request, accounter};
+  const auto request = MakeRequest(accounter);
+  server::http::HttpResponse response{*request, accounter};
 
   constexpr std::string_view kBody = "test data";
   response.SetData(std::string{kBody});
@@ -48,8 +59,8 @@ UTEST(HttpResponse, Smoke) {
 
 UTEST(HttpResponse, AccounterLifetimeIfNotSent) {
   auto accounter = std::make_unique<server::request::ResponseDataAccounter>();
-  const server::http::HttpRequestImpl request{*accounter};
-  request.GetHttpResponse().SetSendFailed(std::chrono::steady_clock::now());
+  const auto request = MakeRequest(*accounter);
+  request->GetHttpResponse().SetSendFailed(std::chrono::steady_clock::now());
   accounter.reset();
   // Now we just should not crash
 }
@@ -59,8 +70,8 @@ UTEST(HttpResponse, AccounterLifetimeIfSent) {
       engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
   auto accounter = std::make_unique<server::request::ResponseDataAccounter>();
 
-  const server::http::HttpRequestImpl request{*accounter};
-  auto& response = request.GetHttpResponse();
+  const auto request = MakeRequest(*accounter);
+  auto& response = request->GetHttpResponse();
 
   const std::string body = "test data";
   response.SetData(body);
@@ -90,8 +101,8 @@ UTEST_P(HttpResponseBody, ForbiddenBody) {
       engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
 
   server::request::ResponseDataAccounter accounter;
-  server::http::HttpRequestImpl request{accounter};
-  server::http::HttpResponse response{request, accounter};
+  const auto request = MakeRequest(accounter);
+  server::http::HttpResponse response{*request, accounter};
 
   response.SetData("test data");
   response.SetStatus(static_cast<server::http::HttpStatus>(GetParam()));
@@ -119,11 +130,65 @@ INSTANTIATE_UTEST_SUITE_P(HttpResponseForbiddenBody, HttpResponseBody,
 
 TEST(HttpResponse, GetHeaderDoesntThrow) {
   server::request::ResponseDataAccounter accounter{};
-  const server::http::HttpRequestImpl request_impl{accounter};
-  const server::http::HttpResponse response{request_impl, accounter};
+  const auto request = MakeRequest(accounter);
+  const server::http::HttpResponse response{*request, accounter};
 
   const auto& header = response.GetHeader("nonexistent-header");
   EXPECT_TRUE(header.empty());
 }
 
+UTEST(HttpResponse, PreparedHeaders) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  const auto request = MakeRequest(accounter);
+  server::http::HttpResponse response{*request, accounter};
+
+  server::http::HttpResponse::HeadersMap headers;
+  headers[std::string{"X-Static"}] = "static";
+  headers[std::string{"X-Overridden"}] = "static";
+  headers[http::headers::kContentType] = "text/plain";
+  response.SetPreparedHeaders(
+      server::http::HttpResponse::MakePreparedHeaders(std::move(headers)));
+  response.SetHeader(std::string_view{"X-Overridden"}, "dynamic");
+  response.SetData("test data");
+
+  EXPECT_EQ(response.GetHeader("X-Static"), "static");
+  EXPECT_EQ(response.GetHeader("X-Overridden"), "dynamic");
+  EXPECT_TRUE(response.HasHeader(http::headers::kContentType));
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) { response.SendResponse(socket); },
+      std::ref(response), std::move(server));
+
+  std::string buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+  buffer.resize(reply_size);
+
+  EXPECT_THAT(buffer, testing::StartsWith("HTTP/1.1 200 OK\r\n"));
+  EXPECT_THAT(buffer, testing::HasSubstr("\r\nX-Static: static\r\n"));
+  EXPECT_THAT(buffer, testing::HasSubstr("\r\nX-Overridden: dynamic\r\n"));
+  EXPECT_THAT(buffer, testing::Not(testing::HasSubstr("X-Overridden: static")));
+  EXPECT_THAT(buffer, testing::HasSubstr("\r\nContent-Type: text/plain\r\n"));
+  EXPECT_THAT(buffer, testing::Not(testing::HasSubstr("octet-stream")));
+}
+
+TEST(HttpResponse, PreparedHeadersForbidden) {
+  server::http::HttpResponse::HeadersMap headers;
+  headers[http::headers::kDate] = "Mon, 01 Jan 2024 00:00:00 GMT";
+  UEXPECT_THROW(
+      server::http::HttpResponse::MakePreparedHeaders(std::move(headers)),
+      std::runtime_error);
+
+  server::http::HttpResponse::HeadersMap invalid;
+  invalid[std::string{"X-Invalid"}] = "line\nbreak";
+  UEXPECT_THROW(
+      server::http::HttpResponse::MakePreparedHeaders(std::move(invalid)),
+      std::runtime_error);
+}
+
 USERVER_NAMESPACE_END
@@ -6,6 +6,8 @@
 #include <userver/utils/assert.hpp>
 
 #include <array>
+#include <cstdint>
+#include <cstring>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -262,40 +264,26 @@ bool ParseMultipartFormDataHeaders(std::string_view& body,
   return SkipCrLf(body, crlf);
 }
 
-size_t FindBoundaryEnd(std::string_view body, std::string_view boundary,
-                       std::string_view crlf) {
-  size_t pos = 0;
-  while (pos < body.size()) {
-    if (body[pos] == crlf.front()) {
-      if (pos + crlf.size() < body.size() &&
-          body.substr(pos, crlf.size()) == crlf) {
-        pos += crlf.size();
-        if (pos < body.size() && body[pos] == '-') {
-          ++pos;
-          if (pos < body.size() && body[pos] == '-') {
-            ++pos;
-            size_t idx = 0;
-            while (idx < boundary.size() && pos + idx < body.size() &&
-                   body[pos + idx] == boundary[idx])
-              ++idx;
-            pos += idx;
-            if (idx == boundary.size()) return pos;
-          }
-        }
-      } else
-        ++pos;
-    } else
-      ++pos;
-  }
-  return std::string_view::npos;
+DelimiterSearcher MakeDelimiterSearcher(std::string_view boundary,
+                                        std::string_view crlf) {
+  std::string delimiter;
+  delimiter.reserve(crlf.size() + 2 + boundary.size());
+  delimiter.append(crlf).append("--").append(boundary);
+  return DelimiterSearcher{std::move(delimiter)};
+}
+
+size_t FindBoundaryEnd(std::string_view body,
+                       const DelimiterSearcher& delimiter) {
+  const auto pos = delimiter.Find(body);
+  if (pos == std::string_view::npos) return pos;
+  return pos + delimiter.GetDelimiter().size();
 }
 
 bool ParseMultipartFormDataValue(std::string_view& body,
-                                 std::string_view boundary,
+                                 const DelimiterSearcher& delimiter,
                                  FormDataArgInfo&& arg_info,
                                  std::optional<std::string>& charset,
-                                 FormDataArgs& form_data_args,
-                                 std::string_view crlf) {
+                                 FormDataArgs& form_data_args) {
   static const std::string kCharset = "_charset_";
 
   if (arg_info.arg.content_disposition.empty()) {
@@ -303,12 +291,13 @@ bool ParseMultipartFormDataValue(std::string_view& body,
     return false;
   }
 
-  size_t pos = FindBoundaryEnd(body, boundary, crlf);
+  size_t pos = FindBoundaryEnd(body, delimiter);
   if (pos == std::string_view::npos) {
     LOG_WARNING() << "Unexpected end of form-data part value";
     return false;
   }
-  arg_info.arg.value = body.substr(0, pos - boundary.size() - 2 - crlf.size());
+  arg_info.arg.value =
+      body.substr(0, pos - delimiter.GetDelimiter().size());
   if (arg_info.name == kCharset) {
     charset = arg_info.arg.value;
   } else {
@@ -336,7 +325,7 @@ bool ParseMultipartFormDataBody(std::string_view body,
     while (!body.empty() && body.front() != kCr && body.front() != kLf)
       body.remove_prefix(1);
     if (!strict_cr_lf) crlf = AutoDetectCrLf(body, crlf);
-    size_t pos = FindBoundaryEnd(body, boundary, crlf);
+    size_t pos = FindBoundaryEnd(body, MakeDelimiterSearcher(boundary, crlf));
     if (pos == std::string_view::npos) {
       LOG_WARNING() << "Unexpected request body end";
       return false;
@@ -349,6 +338,7 @@ bool ParseMultipartFormDataBody(std::string_view body,
   if (!default_charset.empty()) charset = std::move(default_charset);
 
   LOG_TRACE() << "crlf=" << crlf;
+  const auto delimiter = MakeDelimiterSearcher(boundary, crlf);
 
   while (!body.empty()) {
     if (body.front() == '-') {
@@ -381,8 +371,8 @@ bool ParseMultipartFormDataBody(std::string_view body,
     if (!ParseMultipartFormDataHeaders(body, arg_info, crlf)) return false;
     LOG_TRACE() << "ParseMultipartFormDataHeaders finished, body=" << body
                 << ", body.size()=" << body.size();
-    if (!ParseMultipartFormDataValue(body, boundary, std::move(arg_info),
-                                     charset, form_data_args, crlf)) {
+    if (!ParseMultipartFormDataValue(body, delimiter, std::move(arg_info),
+                                     charset, form_data_args)) {
       return false;
     }
   }
@@ -392,6 +382,33 @@ bool ParseMultipartFormDataBody(std::string_view body,
 
 }  // namespace
 
+DelimiterSearcher::DelimiterSearcher(std::string delimiter)
+    : delimiter_(std::move(delimiter)) {
+  UASSERT(!delimiter_.empty());
+  skip_.fill(delimiter_.size());
+  for (std::size_t i = 0; i + 1 < delimiter_.size(); ++i) {
+    skip_[static_cast<std::uint8_t>(delimiter_[i])] = delimiter_.size() - 1 - i;
+  }
+}
+
+std::size_t DelimiterSearcher::Find(std::string_view text) const {
+  const auto size = delimiter_.size();
+  if (text.size() < size) return std::string_view::npos;
+
+  const auto last = static_cast<std::uint8_t>(delimiter_.back());
+  const char* const data = text.data();
+  std::size_t pos = 0;
+  while (pos <= text.size() - size) {
+    const auto tail = static_cast<std::uint8_t>(data[pos + size - 1]);
+    if (tail == last &&
+        std::memcmp(data + pos, delimiter_.data(), size - 1) == 0) {
+      return pos;
+    }
+    pos += skip_[tail];
+  }
+  return std::string_view::npos;
+}
+
 bool IsMultipartFormDataContentType(std::string_view content_type) {
   if (!IEquals(content_type.substr(0, kMultipartFormData.size()),
                kMultipartFormData))
@@ -406,9 +423,9 @@ bool IsMultipartFormDataContentType(std::string_view content_type) {
   return false;
 }
 
-bool ParseMultipartFormData(const std::string& content_type,
-                            std::string_view body, FormDataArgs& form_data_args,
-                            bool strict_cr_lf) {
+bool ParseMultipartFormDataContentType(std::string_view content_type,
+                                       std::string& boundary,
+                                       std::string& charset) {
   static const std::string kBoundary = "boundary";
   static const std::string kCharset = "charset";
   static const std::string kBoundaryNotFound =
@@ -422,8 +439,8 @@ bool ParseMultipartFormData(const std::string& content_type,
   unparsed.remove_prefix(kMultipartFormData.size());
   SkipOptionalSpaces(unparsed);
 
-  std::string boundary;
-  std::string charset;
+  boundary.clear();
+  charset.clear();
   while (!unparsed.empty()) {
     if (!SkipSymbol(unparsed, ';')) return false;
     SkipOptionalSpaces(unparsed);
@@ -455,11 +472,153 @@ bool ParseMultipartFormData(const std::string& content_type,
     LOG_WARNING() << kBoundaryNotFound;
     return false;
   }
+  return true;
+}
+
+bool ParseMultipartFormData(const std::string& content_type,
+                            std::string_view body, FormDataArgs& form_data_args,
+                            bool strict_cr_lf) {
+  std::string boundary;
+  std::string charset;
+  if (!ParseMultipartFormDataContentType(content_type, boundary, charset)) {
+    return false;
+  }
 
   return ParseMultipartFormDataBody(body, boundary, std::move(charset),
                                     form_data_args, strict_cr_lf);
 }
 
+MultipartFormDataStreamParser::MultipartFormDataStreamParser(
+    std::string_view boundary)
+    : delimiter_(MakeDelimiterSearcher(boundary, "\r\n")),
+      // The body may start with the boundary without the preceding line break
+      buffer_("\r\n") {}
+
+void MultipartFormDataStreamParser::Append(std::string_view data) {
+  UASSERT(!is_end_of_input_);
+  if (pos_ != 0) {
+    buffer_.erase(0, pos_);
+    pos_ = 0;
+  }
+  buffer_.append(data);
+}
+
+MultipartFormDataStreamParser::Result MultipartFormDataStreamParser::Next(
+    std::string_view& data) {
+  static constexpr std::string_view kCrLf = "\r\n";
+  static constexpr std::string_view kHeadersEnd = "\r\n\r\n";
+  static constexpr std::size_t kMaxHeadersSize = 64 * 1024;
+
+  while (true) {
+    const auto input = std::string_view{buffer_}.substr(pos_);
+    switch (state_) {
+      case State::kPreamble:
+      case State::kValue: {
+        const auto delimiter_pos = delimiter_.Find(input);
+        if (delimiter_pos == std::string_view::npos) {
+          // The tail may be the beginning of a delimiter
+          const auto delimiter_size = delimiter_.GetDelimiter().size();
+          const auto size = input.size() < delimiter_size
+                                ? 0
+                                : input.size() - delimiter_size + 1;
+          pos_ += size;
+          if (state_ == State::kPreamble || size == 0) return NeedMoreData();
+          data = input.substr(0, size);
+          return Result::kPartData;
+        }
+        if (state_ == State::kValue && delimiter_pos != 0) {
+          pos_ += delimiter_pos;
+          data = input.substr(0, delimiter_pos);
+          return Result::kPartData;
+        }
+
+        pos_ += delimiter_pos + delimiter_.GetDelimiter().size();
+        const bool is_value_end = (state_ == State::kValue);
+        state_ = State::kDelimiterEnd;
+        if (is_value_end) return Result::kPartEnd;
+        break;
+      }
+
+      case State::kDelimiterEnd: {
+        if (input.size() < 2) return NeedMoreData();
+        if (input.substr(0, 2) == "--") {
+          // https://datatracker.ietf.org/doc/html/rfc2046#section-5.1.1
+          // the epilogue is ignored
+          state_ = State::kFinished;
+          return Result::kFinished;
+        }
+        // Optional transport padding
+        const auto padding_end = input.find_first_not_of(kOwsChars);
+        if (padding_end == std::string_view::npos ||
+            input.size() - padding_end < kCrLf.size()) {
+          return NeedMoreData();
+        }
+        if (input.substr(padding_end, kCrLf.size()) != kCrLf) {
+          return Fail("CRLF expected after the boundary");
+        }
+        pos_ += padding_end + kCrLf.size();
+        state_ = State::kHeaders;
+        break;
+      }
+
+      case State::kHeaders: {
+        if (input.size() < kCrLf.size()) return NeedMoreData();
+        if (input.substr(0, kCrLf.size()) == kCrLf) {
+          return Fail("Missing Content-Disposition header");
+        }
+        const auto headers_end = input.find(kHeadersEnd);
+        if (headers_end == std::string_view::npos) {
+          if (input.size() > kMaxHeadersSize) {
+            return Fail("Too large form-data part headers");
+          }
+          return NeedMoreData();
+        }
+
+        auto headers = input.substr(0, headers_end + kHeadersEnd.size());
+        FormDataArgInfo arg_info;
+        if (!ParseMultipartFormDataHeaders(headers, arg_info, kCrLf) ||
+            !headers.empty()) {
+          return Fail("Can't parse form-data part headers");
+        }
+        if (arg_info.arg.content_disposition.empty()) {
+          return Fail("Missing Content-Disposition header");
+        }
+
+        part_headers_.name = std::move(arg_info.name);
+        part_headers_.filename = std::move(arg_info.arg.filename);
+        part_headers_.content_type.reset();
+        if (arg_info.arg.content_type) {
+          part_headers_.content_type.emplace(*arg_info.arg.content_type);
+        }
+        part_headers_.content_disposition =
+            std::string{arg_info.arg.content_disposition};
+
+        pos_ += headers_end + kHeadersEnd.size();
+        state_ = State::kValue;
+        return Result::kPartHeaders;
+      }
+
+      case State::kFinished:
+        return Result::kFinished;
+      case State::kError:
+        return Result::kError;
+    }
+  }
+}
+
+MultipartFormDataStreamParser::Result MultipartFormDataStreamParser::Fail(
+    std::string_view reason) {
+  LOG_WARNING() << reason;
+  state_ = State::kError;
+  return Result::kError;
+}
+
+MultipartFormDataStreamParser::Result
+MultipartFormDataStreamParser::NeedMoreData() {
+  if (is_end_of_input_) return Fail("Unexpected request body end");
+  return Result::kNeedMoreData;
+}
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
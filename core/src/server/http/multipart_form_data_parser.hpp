@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <string>
 #include <string_view>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -18,10 +21,87 @@ using FormDataArgs =
                                 utils::StrCaseHash>;
 
 bool IsMultipartFormDataContentType(std::string_view content_type);
+bool ParseMultipartFormDataContentType(std::string_view content_type,
+                                       std::string& boundary,
+                                       std::string& charset);
 bool ParseMultipartFormData(const std::string& content_type,
                             std::string_view body, FormDataArgs& form_data_args,
                             bool strict_cr_lf = false);
 
+/// Boyer-Moore-Horspool search of a multipart delimiter (line break, "--" and
+/// the boundary). Part values are mostly binary data that rarely contains the
+/// last byte of the delimiter, so most of the windows are skipped by the whole
+/// delimiter length after a single byte comparison.
+class DelimiterSearcher final {
+ public:
+  explicit DelimiterSearcher(std::string delimiter);
+
+  /// @returns position of the first occurrence of the delimiter in `text` or
+  /// std::string_view::npos
+  std::size_t Find(std::string_view text) const;
+
+  const std::string& GetDelimiter() const { return delimiter_; }
+
+ private:
+  std::string delimiter_;
+  std::array<std::size_t, 256> skip_{};
+};
+
+/// Incremental multipart/form-data parser for the bodies that are not
+/// received as a whole. The part values are returned as they arrive and are
+/// not accumulated. Only CRLF line breaks are supported.
+class MultipartFormDataStreamParser final {
+ public:
+  enum class Result {
+    kNeedMoreData,
+    kPartHeaders,
+    kPartData,
+    kPartEnd,
+    kFinished,
+    kError,
+  };
+
+  struct PartHeaders {
+    std::string name;
+    std::optional<std::string> filename;
+    std::optional<std::string> content_type;
+    std::string content_disposition;
+  };
+
+  explicit MultipartFormDataStreamParser(std::string_view boundary);
+
+  /// Invalidates the data returned by Next()
+  void Append(std::string_view data);
+  void SetEndOfInput() { is_end_of_input_ = true; }
+
+  /// Parses the appended data. `data` is set to a part of the value for
+  /// Result::kPartData and is valid until the next call.
+  Result Next(std::string_view& data);
+
+  /// Headers of the current part, valid after Result::kPartHeaders
+  const PartHeaders& GetPartHeaders() const { return part_headers_; }
+
+ private:
+  enum class State {
+    kPreamble,
+    kDelimiterEnd,
+    kHeaders,
+    kValue,
+    kFinished,
+    kError,
+  };
+
+  Result Fail(std::string_view reason);
+  Result NeedMoreData();
+
+  DelimiterSearcher delimiter_;
+  std::string buffer_;
+  std::size_t pos_{0};
+  State state_{State::kPreamble};
+  bool is_end_of_input_{false};
+  PartHeaders part_headers_;
+};
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
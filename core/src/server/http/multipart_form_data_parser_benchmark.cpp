@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <server/http/multipart_form_data_parser.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kBoundary =
+    "------------------------8099aaf9723cd601";
+
+// A form with a single binary file of the given size
+std::string MakeBody(std::size_t file_size) {
+  std::string body;
+  body.append("--").append(kBoundary).append("\r\n");
+  body.append(
+      "Content-Disposition: form-data; name=\"file\"; filename=\"a.bin\"\r\n"
+      "Content-Type: application/octet-stream\r\n"
+      "\r\n");
+  for (std::size_t i = 0; i < file_size; ++i) {
+    body.push_back(static_cast<char>(utils::RandRange(256)));
+  }
+  body.append("\r\n--").append(kBoundary).append("--\r\n");
+  return body;
+}
+
+}  // namespace
+
+void multipart_form_data_parse(benchmark::State& state) {
+  const auto body = MakeBody(state.range(0));
+  const auto content_type =
+      "multipart/form-data; boundary=" + std::string{kBoundary};
+
+  for ([[maybe_unused]] auto _ : state) {
+    server::http::FormDataArgs args;
+    const bool is_ok =
+        server::http::ParseMultipartFormData(content_type, body, args);
+    benchmark::DoNotOptimize(is_ok);
+    benchmark::DoNotOptimize(args);
+  }
+  state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(multipart_form_data_parse)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 24);
+
+void multipart_form_data_stream_parse(benchmark::State& state) {
+  const auto body = MakeBody(state.range(0));
+  constexpr std::size_t kChunkSize = 64 * 1024;
+
+  for ([[maybe_unused]] auto _ : state) {
+    server::http::MultipartFormDataStreamParser parser{kBoundary};
+    std::size_t offset = 0;
+    std::string_view data;
+    auto result = parser.Next(data);
+    while (result != server::http::MultipartFormDataStreamParser::Result::
+                         kFinished &&
+           result != server::http::MultipartFormDataStreamParser::Result::
+                         kError) {
+      if (result ==
+          server::http::MultipartFormDataStreamParser::Result::kNeedMoreData) {
+        parser.Append(std::string_view{body}.substr(offset, kChunkSize));
+        offset += kChunkSize;
+        if (offset >= body.size()) parser.SetEndOfInput();
+      }
+      benchmark::DoNotOptimize(data);
+      result = parser.Next(data);
+    }
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK(multipart_form_data_stream_parse)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 24);
+
+USERVER_NAMESPACE_END
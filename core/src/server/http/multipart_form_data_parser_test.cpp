@@ -532,4 +532,164 @@ TEST(MultipartFormDataParser, ParseErrors) {
   EXPECT_TRUE(form_data_args.empty());
 }
 
+namespace {
+
+struct StreamedPart {
+  std::string name;
+  std::optional<std::string> filename;
+  std::optional<std::string> content_type;
+  std::string value;
+
+  bool operator==(const StreamedPart& other) const {
+    return name == other.name && filename == other.filename &&
+           content_type == other.content_type && value == other.value;
+  }
+};
+
+bool ParseStreamed(std::string_view boundary, std::string_view body,
+                   std::size_t chunk_size, std::vector<StreamedPart>& parts) {
+  using Result = server::http::MultipartFormDataStreamParser::Result;
+
+  server::http::MultipartFormDataStreamParser parser{boundary};
+  parts.clear();
+  while (true) {
+    std::string_view data;
+    switch (parser.Next(data)) {
+      case Result::kNeedMoreData:
+        if (body.empty()) {
+          parser.SetEndOfInput();
+        } else {
+          parser.Append(body.substr(0, chunk_size));
+          body.remove_prefix(std::min(chunk_size, body.size()));
+        }
+        break;
+      case Result::kPartHeaders: {
+        const auto& headers = parser.GetPartHeaders();
+        parts.push_back(
+            {headers.name, headers.filename, headers.content_type, {}});
+        break;
+      }
+      case Result::kPartData:
+        EXPECT_FALSE(data.empty());
+        parts.back().value.append(data);
+        break;
+      case Result::kPartEnd:
+        break;
+      case Result::kFinished:
+        return true;
+      case Result::kError:
+        return false;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(MultipartFormDataParser, DelimiterSearcher) {
+  const server::http::DelimiterSearcher searcher{"\r\n--abcab"};
+
+  EXPECT_EQ(searcher.Find(""), std::string_view::npos);
+  EXPECT_EQ(searcher.Find("\r\n--abca"), std::string_view::npos);
+  EXPECT_EQ(searcher.Find("\r\n--abcab"), 0U);
+  EXPECT_EQ(searcher.Find("xx\r\n--abcabyy"), 2U);
+  EXPECT_EQ(searcher.Find("\r\n--abcaa\r\n--abcab\r\n--abcab"), 10U);
+  EXPECT_EQ(searcher.Find("bbbbbbbbbb\r\n-\r\n--ab\r\n--abcab"), 20U);
+
+  // Compare with a naive search on all the positions
+  std::string text;
+  for (int i = 0; i < 1000; ++i) {
+    text += "\r\n--abc"[(i * 7 + i / 13) % 7];
+    if (i % 97 == 0) text += "\r\n--abcab";
+  }
+  for (std::size_t pos = 0; pos <= text.size(); ++pos) {
+    const auto suffix = std::string_view{text}.substr(pos);
+    EXPECT_EQ(searcher.Find(suffix), suffix.find("\r\n--abcab"));
+  }
+}
+
+TEST(MultipartFormDataStreamParser, ParseOk) {
+  const std::string kBoundary = "------------------------8099aaf9723cd601";
+  const std::string kBody =
+      "some trash\r\n"
+      "--------------------------8099aaf9723cd601\r\n"
+      "Content-Disposition: form-data; name=\"text\"\r\n"
+      "\r\n"
+      "default\r\n"
+      "--------------------------8099aaf9723cd601 \r\n"
+      "Content-Disposition: form-data; name=\"file1\"; filename=\"a.html\"\r\n"
+      "Content-Type: text/html\r\n"
+      "\r\n"
+      "<!DOCTYPE html><title>Content of a.html.</title>\n\r\n"
+      "--------------------------8099aaf9723cd601\r\n"
+      "Content-Disposition: form-data; name=\"empty\"\r\n"
+      "\r\n"
+      "\r\n"
+      "--------------------------8099aaf9723cd601\r\n"
+      "Content-Disposition: form-data; name=\"file1\"; filename=\"a.txt\"\r\n"
+      "Content-Type: text/plain\r\n"
+      "\r\n"
+      "\r\n--Content of a.txt.\r\n-\r\n"
+      "--------------------------8099aaf9723cd601--\r\n"
+      "trailing trash";
+
+  const std::vector<StreamedPart> kExpected{
+      {"text", std::nullopt, std::nullopt, "default"},
+      {"file1", "a.html", "text/html",
+       "<!DOCTYPE html><title>Content of a.html.</title>\n"},
+      {"empty", std::nullopt, std::nullopt, ""},
+      {"file1", "a.txt", "text/plain", "\r\n--Content of a.txt.\r\n-"},
+  };
+
+  std::vector<StreamedPart> parts;
+  for (std::size_t chunk_size = 1; chunk_size <= kBody.size(); ++chunk_size) {
+    ASSERT_TRUE(ParseStreamed(kBoundary, kBody, chunk_size, parts))
+        << "chunk_size=" << chunk_size;
+    EXPECT_TRUE(parts == kExpected) << "chunk_size=" << chunk_size;
+  }
+}
+
+TEST(MultipartFormDataStreamParser, ParseErrors) {
+  const std::string_view kBodies[] = {
+      // not a form-data
+      "--zzz\r\n"
+      "Content-Disposition: no-form-data; name=\"arg\"\r\n"
+      "\r\n"
+      "some text\r\n"
+      "--zzz--\r\n",
+      // no Content-Disposition
+      "--zzz\r\n"
+      "Content-Type: text/plain\r\n"
+      "\r\n"
+      "some text\r\n"
+      "--zzz--\r\n",
+      // no headers
+      "--zzz\r\n"
+      "\r\n"
+      "some text\r\n"
+      "--zzz--\r\n",
+      // no line break after the boundary
+      "--zzz"
+      "Content-Disposition: form-data; name=\"arg\"\r\n"
+      "\r\n"
+      "some text\r\n"
+      "--zzz--\r\n",
+      // no final boundary
+      "--zzz\r\n"
+      "Content-Disposition: form-data; name=\"arg\"\r\n"
+      "\r\n"
+      "some text\r\n"
+      "--zzz\r\n",
+      // no boundary at all
+      "some text",
+  };
+
+  std::vector<StreamedPart> parts;
+  for (const auto body : kBodies) {
+    for (std::size_t chunk_size = 1; chunk_size <= body.size(); ++chunk_size) {
+      EXPECT_FALSE(ParseStreamed("zzz", body, chunk_size, parts))
+          << "chunk_size=" << chunk_size << ", body=" << body;
+    }
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,151 @@
+#include <userver/server/http/multipart_form_data_stream.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_request_body_stream.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <server/http/multipart_form_data_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+using Result = MultipartFormDataStreamParser::Result;
+
+[[noreturn]] void ThrowMalformedBody() {
+  throw handlers::RequestParseError(
+      handlers::InternalMessage{"Malformed multipart/form-data body"});
+}
+
+}  // namespace
+
+MultipartFormDataStream::MultipartFormDataStream(const HttpRequest& request)
+    : body_(request.GetBodyStream()) {
+  std::string boundary;
+  std::string charset;
+  if (!ParseMultipartFormDataContentType(
+          request.GetHeader(USERVER_NAMESPACE::http::headers::kContentType),
+          boundary, charset)) {
+    throw handlers::RequestParseError(handlers::InternalMessage{
+        "Content-Type is not a valid multipart/form-data one"});
+  }
+  parser_ = std::make_unique<MultipartFormDataStreamParser>(boundary);
+}
+
+MultipartFormDataStream::~MultipartFormDataStream() = default;
+
+bool MultipartFormDataStream::NextPart(engine::Deadline deadline) {
+  available_ = {};
+  while (true) {
+    std::string_view data;
+    switch (parser_->Next(data)) {
+      case Result::kNeedMoreData:
+        FetchBody(deadline);
+        break;
+      case Result::kPartHeaders:
+        has_part_ = true;
+        is_part_finished_ = false;
+        return true;
+      case Result::kPartData:
+      case Result::kPartEnd:
+        // The rest of the current part is skipped
+        break;
+      case Result::kFinished:
+        has_part_ = false;
+        is_part_finished_ = true;
+        return false;
+      case Result::kError:
+        ThrowMalformedBody();
+    }
+  }
+}
+
+std::size_t MultipartFormDataStream::ReadSome(char* buf, std::size_t size,
+                                              engine::Deadline deadline) {
+  if (size == 0) return 0;
+  if (available_.empty() && !FetchValueData(deadline)) return 0;
+
+  const auto bytes = std::min(size, available_.size());
+  std::memcpy(buf, available_.data(), bytes);
+  available_.remove_prefix(bytes);
+  return bytes;
+}
+
+bool MultipartFormDataStream::ReadChunk(std::string& output,
+                                        engine::Deadline deadline) {
+  if (available_.empty() && !FetchValueData(deadline)) {
+    output.clear();
+    return false;
+  }
+  output.assign(available_);
+  available_ = {};
+  return true;
+}
+
+const std::string& MultipartFormDataStream::GetName() const {
+  UASSERT(has_part_);
+  return parser_->GetPartHeaders().name;
+}
+
+const std::optional<std::string>& MultipartFormDataStream::GetFilename()
+    const {
+  UASSERT(has_part_);
+  return parser_->GetPartHeaders().filename;
+}
+
+const std::optional<std::string>& MultipartFormDataStream::GetContentType()
+    const {
+  UASSERT(has_part_);
+  return parser_->GetPartHeaders().content_type;
+}
+
+const std::string& MultipartFormDataStream::GetContentDisposition() const {
+  UASSERT(has_part_);
+  return parser_->GetPartHeaders().content_disposition;
+}
+
+bool MultipartFormDataStream::FetchValueData(engine::Deadline deadline) {
+  UASSERT(available_.empty());
+  while (!is_part_finished_) {
+    std::string_view data;
+    switch (parser_->Next(data)) {
+      case Result::kNeedMoreData:
+        FetchBody(deadline);
+        break;
+      case Result::kPartData:
+        // Points into the parser buffer, that is not modified until the
+        // next Next() call
+        available_ = data;
+        return true;
+      case Result::kPartEnd:
+        is_part_finished_ = true;
+        break;
+      case Result::kError:
+        ThrowMalformedBody();
+      case Result::kPartHeaders:
+      case Result::kFinished:
+        UASSERT_MSG(false, "part value is not terminated by the boundary");
+        ThrowMalformedBody();
+    }
+  }
+  return false;
+}
+
+void MultipartFormDataStream::FetchBody(engine::Deadline deadline) {
+  if (body_.ReadChunk(chunk_, deadline)) {
+    parser_->Append(chunk_);
+  } else {
+    parser_->SetEndOfInput();
+  }
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
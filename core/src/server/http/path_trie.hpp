@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <userver/utils/impl/transparent_hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// @brief Trie of the path patterns, matched segment by segment without
+/// allocations.
+///
+/// A pattern is split by '/', a `{name}` segment matches any segment and the
+/// trailing `*` segment matches one or more trailing segments. On matching
+/// the fixed segments are preferred over the `{name}` ones, and those over
+/// the trailing `*`.
+template <typename Value>
+class PathTrie final {
+ public:
+  /// @returns the value of the pattern, default constructed on first access
+  Value& Emplace(std::string_view pattern);
+
+  /// @returns the value of the first pattern that matches the `path` and is
+  /// accepted by `predicate(const Value&)`, nullptr if none. On success
+  /// `suffix_pos` is the position of the `path` segments matched by the
+  /// trailing `*` of the pattern, std::string_view::npos if it has none.
+  template <typename Predicate>
+  const Value* Match(std::string_view path, Predicate&& predicate,
+                     std::size_t& suffix_pos) const;
+
+ private:
+  struct Node {
+    utils::impl::TransparentMap<std::string, std::unique_ptr<Node>> fixed;
+    std::unique_ptr<Node> wildcard;
+    /// The pattern ends at this node
+    std::unique_ptr<Value> value;
+    /// The pattern has the trailing `*` after this node
+    std::unique_ptr<Value> any_suffix_value;
+  };
+
+  // Position of the next segment after the last one
+  static constexpr std::size_t kNoSegments = std::string_view::npos;
+
+  template <typename Predicate>
+  static const Value* MatchNode(const Node& node, std::string_view path,
+                                std::size_t pos, Predicate& predicate,
+                                std::size_t& suffix_pos);
+
+  Node root_;
+};
+
+template <typename Value>
+Value& PathTrie<Value>::Emplace(std::string_view pattern) {
+  Node* node = &root_;
+  std::size_t pos = 0;
+  while (true) {
+    const auto end = pattern.find('/', pos);
+    const auto segment = pattern.substr(pos, end - pos);
+
+    if (end == std::string_view::npos && segment == "*") {
+      if (!node->any_suffix_value) {
+        node->any_suffix_value = std::make_unique<Value>();
+      }
+      return *node->any_suffix_value;
+    }
+
+    auto& next = (!segment.empty() && segment.front() == '{' &&
+                  segment.back() == '}')
+                     ? node->wildcard
+                     : node->fixed[std::string{segment}];
+    if (!next) next = std::make_unique<Node>();
+    node = next.get();
+
+    if (end == std::string_view::npos) break;
+    pos = end + 1;
+  }
+
+  if (!node->value) node->value = std::make_unique<Value>();
+  return *node->value;
+}
+
+template <typename Value>
+template <typename Predicate>
+const Value* PathTrie<Value>::Match(std::string_view path,
+                                    Predicate&& predicate,
+                                    std::size_t& suffix_pos) const {
+  return MatchNode(root_, path, 0, predicate, suffix_pos);
+}
+
+template <typename Value>
+template <typename Predicate>
+const Value* PathTrie<Value>::MatchNode(const Node& node, std::string_view path,
+                                        std::size_t pos, Predicate& predicate,
+                                        std::size_t& suffix_pos) {
+  if (pos == kNoSegments) {
+    if (node.value && predicate(*node.value)) {
+      suffix_pos = std::string_view::npos;
+      return node.value.get();
+    }
+    return nullptr;
+  }
+
+  const auto end = path.find('/', pos);
+  const auto next_pos = (end == std::string_view::npos) ? kNoSegments : end + 1;
+
+  if (!node.fixed.empty()) {
+    const auto* next = utils::impl::FindTransparentOrNullptr(
+        node.fixed, path.substr(pos, end - pos));
+    if (next) {
+      const auto* result =
+          MatchNode(**next, path, next_pos, predicate, suffix_pos);
+      if (result) return result;
+    }
+  }
+
+  if (node.wildcard) {
+    const auto* result =
+        MatchNode(*node.wildcard, path, next_pos, predicate, suffix_pos);
+    if (result) return result;
+  }
+
+  if (node.any_suffix_value && predicate(*node.any_suffix_value)) {
+    suffix_pos = pos;
+    return node.any_suffix_value.get();
+  }
+  return nullptr;
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
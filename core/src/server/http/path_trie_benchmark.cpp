@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <server/http/path_trie.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// A gateway-like set of routes, most of them with `{param}` segments
+std::vector<std::string> MakeRoutes(std::size_t count) {
+  std::vector<std::string> routes;
+  routes.reserve(count);
+  for (std::size_t i = 0; routes.size() < count; ++i) {
+    const auto service = i % 50;
+    const auto resource = i / 50;
+    switch (i % 4) {
+      case 0:
+        routes.push_back(
+            fmt::format("/api/v1/service{}/resource{}", service, resource));
+        break;
+      case 1:
+        routes.push_back(fmt::format("/api/v1/service{}/resource{}/{{id}}",
+                                     service, resource));
+        break;
+      case 2:
+        routes.push_back(
+            fmt::format("/api/v1/service{}/resource{}/{{id}}/items/{{item}}",
+                        service, resource));
+        break;
+      default:
+        routes.push_back(fmt::format(
+            "/api/v2/{{tenant}}/service{}/resource{}/{{id}}", service,
+            resource));
+        break;
+    }
+  }
+  return routes;
+}
+
+// The same routes with the params substituted
+std::vector<std::string> MakePaths(const std::vector<std::string>& routes) {
+  std::vector<std::string> paths;
+  paths.reserve(routes.size());
+  for (auto route : routes) {
+    for (const std::string_view param : {"{id}", "{item}", "{tenant}"}) {
+      const auto pos = route.find(param);
+      if (pos != std::string::npos) route.replace(pos, param.size(), "12345");
+    }
+    paths.push_back(std::move(route));
+  }
+  return paths;
+}
+
+void path_trie_match(benchmark::State& state) {
+  const auto routes = MakeRoutes(state.range(0));
+  const auto paths = MakePaths(routes);
+
+  server::http::impl::PathTrie<std::size_t> trie;
+  for (std::size_t i = 0; i < routes.size(); ++i) trie.Emplace(routes[i]) = i;
+
+  std::size_t i = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    std::size_t suffix_pos = 0;
+    const auto* value =
+        trie.Match(paths[i], [](std::size_t) { return true; }, suffix_pos);
+    benchmark::DoNotOptimize(value);
+    if (++i == paths.size()) i = 0;
+  }
+}
+
+}  // namespace
+
+BENCHMARK(path_trie_match)->Arg(100)->Arg(1000)->Arg(3000);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,100 @@
+#include <server/http/path_trie.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Trie = server::http::impl::PathTrie<std::string>;
+
+constexpr auto kNoSuffix = std::string_view::npos;
+
+Trie MakeTrie(std::initializer_list<std::string_view> patterns) {
+  Trie trie;
+  for (const auto pattern : patterns) trie.Emplace(pattern) = pattern;
+  return trie;
+}
+
+std::string Match(const Trie& trie, std::string_view path,
+                  std::size_t& suffix_pos) {
+  const auto* value =
+      trie.Match(path, [](const std::string&) { return true; }, suffix_pos);
+  return value ? *value : std::string{};
+}
+
+std::string Match(const Trie& trie, std::string_view path) {
+  std::size_t suffix_pos = 0;
+  return Match(trie, path, suffix_pos);
+}
+
+}  // namespace
+
+TEST(PathTrie, Fixed) {
+  const auto trie = MakeTrie({"/a", "/a/b", "/a/b/"});
+
+  EXPECT_EQ(Match(trie, "/a"), "/a");
+  EXPECT_EQ(Match(trie, "/a/b"), "/a/b");
+  EXPECT_EQ(Match(trie, "/a/b/"), "/a/b/");
+  EXPECT_EQ(Match(trie, "/a/"), "");
+  EXPECT_EQ(Match(trie, "/a/c"), "");
+  EXPECT_EQ(Match(trie, "/a/b/c"), "");
+  EXPECT_EQ(Match(trie, ""), "");
+}
+
+TEST(PathTrie, Wildcards) {
+  const auto trie = MakeTrie({"/v1/{id}", "/v1/{id}/items/{item}", "/v1/me"});
+
+  std::size_t suffix_pos = 0;
+  EXPECT_EQ(Match(trie, "/v1/42", suffix_pos), "/v1/{id}");
+  EXPECT_EQ(suffix_pos, kNoSuffix);
+  EXPECT_EQ(Match(trie, "/v1/me"), "/v1/me");
+  EXPECT_EQ(Match(trie, "/v1/42/items/7"), "/v1/{id}/items/{item}");
+  EXPECT_EQ(Match(trie, "/v1/me/items/7"), "/v1/{id}/items/{item}");
+  EXPECT_EQ(Match(trie, "/v1/42/items"), "");
+  EXPECT_EQ(Match(trie, "/v1"), "");
+}
+
+TEST(PathTrie, AnySuffix) {
+  const auto trie = MakeTrie({"/static/*", "/static/{file}/info", "/*"});
+
+  std::size_t suffix_pos = 0;
+  EXPECT_EQ(Match(trie, "/static/a/b", suffix_pos), "/static/*");
+  EXPECT_EQ(suffix_pos, 8);
+  EXPECT_EQ(Match(trie, "/static/", suffix_pos), "/static/*");
+  EXPECT_EQ(suffix_pos, 8);
+  EXPECT_EQ(Match(trie, "/static/a/info", suffix_pos), "/static/{file}/info");
+  EXPECT_EQ(suffix_pos, kNoSuffix);
+  EXPECT_EQ(Match(trie, "/static", suffix_pos), "/*");
+  EXPECT_EQ(suffix_pos, 1);
+}
+
+TEST(PathTrie, Backtracking) {
+  const auto trie = MakeTrie({"/a/b/c", "/a/{x}/d", "/{y}/b/e"});
+
+  EXPECT_EQ(Match(trie, "/a/b/c"), "/a/b/c");
+  EXPECT_EQ(Match(trie, "/a/b/d"), "/a/{x}/d");
+  EXPECT_EQ(Match(trie, "/a/b/e"), "/{y}/b/e");
+  EXPECT_EQ(Match(trie, "/a/b/f"), "");
+}
+
+TEST(PathTrie, Predicate) {
+  const auto trie = MakeTrie({"/a/b", "/a/{x}"});
+
+  std::size_t suffix_pos = 0;
+  std::size_t calls = 0;
+  const auto* value = trie.Match(
+      "/a/b",
+      [&calls](const std::string& value) {
+        ++calls;
+        return value != "/a/b";
+      },
+      suffix_pos);
+  ASSERT_TRUE(value);
+  EXPECT_EQ(*value, "/a/{x}");
+  EXPECT_EQ(calls, 2);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,508 @@
+#include "simd_http_request_parser.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+// Method, spaces and the protocol version
+constexpr std::size_t kMaxRequestLineOverhead = 64;
+
+bool IsControlChar(char c) noexcept {
+  const auto byte = static_cast<unsigned char>(c);
+  return (byte < 0x20 && c != '\t') || byte == 0x7f;
+}
+
+// Returns the first control character (except HT) or DEL, `end` if there are
+// none. A valid line ends at the first control character that is CR or LF.
+const char* FindControlChar(const char* begin, const char* end) noexcept {
+#ifdef __AVX2__
+  const auto max_ctl_avx = _mm256_set1_epi8(0x1f);
+  const auto tab_avx = _mm256_set1_epi8('\t');
+  const auto del_avx = _mm256_set1_epi8(0x7f);
+  while (end - begin >= 32) {
+    const auto block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const auto is_ctl =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(block, max_ctl_avx), block);
+    const auto is_stop = _mm256_or_si256(
+        _mm256_andnot_si256(_mm256_cmpeq_epi8(block, tab_avx), is_ctl),
+        _mm256_cmpeq_epi8(block, del_avx));
+    const auto mask =
+        static_cast<std::uint32_t>(_mm256_movemask_epi8(is_stop));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+    begin += 32;
+  }
+#endif
+
+#ifdef __SSE2__
+  const auto max_ctl = _mm_set1_epi8(0x1f);
+  const auto tab = _mm_set1_epi8('\t');
+  const auto del = _mm_set1_epi8(0x7f);
+  while (end - begin >= 16) {
+    const auto block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    // unsigned `block <= 0x1f`
+    const auto is_ctl = _mm_cmpeq_epi8(_mm_min_epu8(block, max_ctl), block);
+    const auto is_stop =
+        _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(block, tab), is_ctl),
+                     _mm_cmpeq_epi8(block, del));
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(is_stop));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+    begin += 16;
+  }
+#endif
+
+  return std::find_if(begin, end, &IsControlChar);
+}
+
+bool IsTokenChar(char c) noexcept {
+  static constexpr std::string_view kSpecials = "!#$%&'*+-.^_`|~";
+  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+         (c >= 'A' && c <= 'Z') || kSpecials.find(c) != std::string_view::npos;
+}
+
+std::string_view TrimOws(std::string_view value) noexcept {
+  const auto begin = value.find_first_not_of(" \t");
+  if (begin == std::string_view::npos) return {};
+  const auto end = value.find_last_not_of(" \t");
+  return value.substr(begin, end - begin + 1);
+}
+
+template <typename Func>
+void ForEachListElement(std::string_view value, Func&& func) {
+  while (!value.empty()) {
+    const auto comma = value.find(',');
+    func(TrimOws(value.substr(0, comma)));
+    if (comma == std::string_view::npos) break;
+    value.remove_prefix(comma + 1);
+  }
+}
+
+bool ParseNumber(std::string_view str, int base, std::uint64_t& result) {
+  if (str.empty()) return false;
+  const auto* end = str.data() + str.size();
+  const auto [ptr, ec] = std::from_chars(str.data(), end, result, base);
+  return ec == std::errc{} && ptr == end;
+}
+
+}  // namespace
+
+SimdHttpRequestParser::SimdHttpRequestParser(
+    const HandlerInfoIndex& handler_info_index,
+    const request::HttpRequestConfig& request_config,
+    OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
+    request::ResponseDataAccounter& data_accounter)
+    : handler_info_index_(handler_info_index),
+      request_constructor_config_{request_config},
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      stats_(stats),
+      data_accounter_(data_accounter) {}
+
+bool SimdHttpRequestParser::Parse(const char* data, size_t size) {
+  const auto handle_result = [this](LineResult result) {
+    if (result == LineResult::kError) FinalizeRequestOnError();
+    return result == LineResult::kOk;
+  };
+
+  std::string_view input{data, size};
+  while (!input.empty()) {
+    if (state_ == State::kBody || state_ == State::kChunkData) {
+      if (!handle_result(ProcessBody(input))) return false;
+      continue;
+    }
+
+    // CR was the last byte of the previous input
+    if (!pending_line_.empty() && pending_line_.back() == '\r') {
+      if (input.front() != '\n') {
+        LOG_WARNING() << "CR is not followed by LF";
+        FinalizeRequestOnError();
+        return false;
+      }
+      input.remove_prefix(1);
+      pending_line_.pop_back();
+      const auto result = ProcessLine(pending_line_);
+      pending_line_.clear();
+      if (!handle_result(result)) return false;
+      continue;
+    }
+
+    const auto* const input_end = input.data() + input.size();
+    const auto* const line_end = FindControlChar(input.data(), input_end);
+    if (line_end == input_end ||
+        (*line_end == '\r' && line_end + 1 == input_end)) {
+      pending_line_.append(input);
+      if (!CheckPendingLineSize()) {
+        FinalizeRequestOnError();
+        return false;
+      }
+      return true;
+    }
+
+    std::size_t eol_size = 1;
+    if (*line_end == '\r' && line_end[1] == '\n') {
+      eol_size = 2;
+    } else if (*line_end != '\n') {
+      LOG_WARNING() << "invalid character in line: "
+                    << static_cast<int>(static_cast<unsigned char>(*line_end));
+      FinalizeRequestOnError();
+      return false;
+    }
+
+    const auto line_size = static_cast<std::size_t>(line_end - input.data());
+    auto line = input.substr(0, line_size);
+    if (!pending_line_.empty()) {
+      pending_line_.append(line);
+      line = pending_line_;
+    }
+    input.remove_prefix(line_size + eol_size);
+
+    const auto result = ProcessLine(line);
+    pending_line_.clear();
+    if (!handle_result(result)) return false;
+  }
+  return true;
+}
+
+SimdHttpRequestParser::LineResult SimdHttpRequestParser::ProcessLine(
+    std::string_view line) {
+  switch (state_) {
+    case State::kRequestLine:
+      return ProcessRequestLine(line);
+    case State::kHeaders:
+      return ProcessHeaderLine(line);
+    case State::kChunkSize:
+      return ProcessChunkSize(line);
+    case State::kChunkDataEnd:
+      if (!line.empty()) {
+        LOG_WARNING() << "chunk data is not followed by CRLF";
+        return LineResult::kError;
+      }
+      state_ = State::kChunkSize;
+      return LineResult::kOk;
+    case State::kTrailers:
+      // Trailers are not passed to the request
+      if (!line.empty()) return LineResult::kOk;
+      return CompleteRequest();
+    case State::kBody:
+    case State::kChunkData:
+      break;
+  }
+  UASSERT_MSG(false, "body is not parsed by lines");
+  return LineResult::kError;
+}
+
+SimdHttpRequestParser::LineResult SimdHttpRequestParser::ProcessRequestLine(
+    std::string_view line) {
+  // RFC 9112 section 2.2: empty lines before the request line are ignored
+  if (line.empty()) return LineResult::kOk;
+
+  LOG_TRACE() << "request line: '" << line << '\'';
+  CreateRequestConstructor();
+
+  const auto method_end = line.find(' ');
+  const auto target_end = line.rfind(' ');
+  if (method_end == std::string_view::npos || method_end == target_end) {
+    LOG_WARNING() << "malformed request line";
+    return LineResult::kError;
+  }
+  const auto method_str = line.substr(0, method_end);
+  const auto target =
+      line.substr(method_end + 1, target_end - method_end - 1);
+  const auto version = line.substr(target_end + 1);
+
+  if (target.empty() || target.find(' ') != std::string_view::npos) {
+    LOG_WARNING() << "malformed request target";
+    return LineResult::kError;
+  }
+  if (version.size() != 8 || version.substr(0, 7) != "HTTP/1." ||
+      version[7] < '0' || version[7] > '9') {
+    LOG_WARNING() << "unsupported protocol version '" << version << '\'';
+    return LineResult::kError;
+  }
+
+  const auto method = HttpMethodFromString(method_str);
+  is_connect_ = method == HttpMethod::kConnect;
+  http_minor_ = static_cast<unsigned short>(version[7] - '0');
+
+  auto& request_constructor = *request_constructor_;
+  request_constructor.SetMethod(method);
+  request_constructor.SetHttpMajor(1);
+  request_constructor.SetHttpMinor(http_minor_);
+  try {
+    request_constructor.AppendUrl(target.data(), target.size());
+    request_constructor.ParseUrl();
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't parse url: " << ex;
+    return LineResult::kError;
+  }
+
+  state_ = State::kHeaders;
+  return LineResult::kOk;
+}
+
+SimdHttpRequestParser::LineResult SimdHttpRequestParser::ProcessHeaderLine(
+    std::string_view line) {
+  if (line.empty()) return ProcessHeadersEnd();
+
+  if (line.front() == ' ' || line.front() == '\t') {
+    LOG_WARNING() << "obsolete line folding in headers";
+    return LineResult::kError;
+  }
+
+  const auto colon = line.find(':');
+  if (colon == std::string_view::npos) {
+    LOG_WARNING() << "header without a colon";
+    return LineResult::kError;
+  }
+  const auto name = line.substr(0, colon);
+  if (name.empty() || !std::all_of(name.begin(), name.end(), &IsTokenChar)) {
+    LOG_WARNING() << "invalid header name '" << name << '\'';
+    return LineResult::kError;
+  }
+  const auto value = TrimOws(line.substr(colon + 1));
+
+  LOG_TRACE() << "header: '" << name << "': '" << value << '\'';
+  try {
+    request_constructor_->AppendHeader(name, value);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append header: " << ex;
+    return LineResult::kError;
+  }
+
+  return InspectHeader(name, value) ? LineResult::kOk : LineResult::kError;
+}
+
+bool SimdHttpRequestParser::InspectHeader(std::string_view name,
+                                          std::string_view value) {
+  const utils::StrIcaseEqual equal;
+
+  if (equal(name, "Content-Length")) {
+    std::uint64_t content_length = 0;
+    if (!ParseNumber(value, 10, content_length) ||
+        (content_length_ && *content_length_ != content_length)) {
+      LOG_WARNING() << "invalid Content-Length '" << value << '\'';
+      return false;
+    }
+    content_length_ = content_length;
+  } else if (equal(name, "Transfer-Encoding")) {
+    // RFC 9112 section 6.3: chunked must be the final coding of a request
+    std::string_view last_coding;
+    ForEachListElement(value,
+                       [&](std::string_view coding) { last_coding = coding; });
+    if (!equal(last_coding, "chunked")) {
+      LOG_WARNING() << "unsupported Transfer-Encoding '" << value << '\'';
+      return false;
+    }
+    is_chunked_ = true;
+  } else if (equal(name, "Connection")) {
+    ForEachListElement(value, [&](std::string_view option) {
+      if (equal(option, "close")) {
+        has_connection_close_ = true;
+      } else if (equal(option, "keep-alive")) {
+        has_connection_keep_alive_ = true;
+      } else if (equal(option, "upgrade")) {
+        has_connection_upgrade_ = true;
+      }
+    });
+  } else if (equal(name, "Upgrade")) {
+    has_upgrade_ = true;
+  }
+  return true;
+}
+
+SimdHttpRequestParser::LineResult SimdHttpRequestParser::ProcessHeadersEnd() {
+  LOG_TRACE() << "headers complete";
+
+  // Ambiguous message length, see RFC 9112 section 6.3
+  if (is_chunked_ && content_length_) {
+    LOG_WARNING() << "both Content-Length and Transfer-Encoding are set";
+    return LineResult::kError;
+  }
+
+  if (request_constructor_->IsBodyStreamRequested() && !IsUpgrade()) {
+    auto body_producer = request_constructor_->StartBodyStream();
+    if (!FinalizeRequest(!IsKeepAlive())) return LineResult::kStop;
+    body_producer_ = std::move(body_producer);
+  }
+
+  if (is_chunked_) {
+    state_ = State::kChunkSize;
+    return LineResult::kOk;
+  }
+  if (content_length_.value_or(0) != 0) {
+    body_remaining_ = *content_length_;
+    state_ = State::kBody;
+    return LineResult::kOk;
+  }
+  return CompleteRequest();
+}
+
+SimdHttpRequestParser::LineResult SimdHttpRequestParser::ProcessChunkSize(
+    std::string_view line) {
+  // Chunk extensions are ignored
+  const auto size_str = TrimOws(line.substr(0, line.find(';')));
+  std::uint64_t chunk_size = 0;
+  if (!ParseNumber(size_str, 16, chunk_size)) {
+    LOG_WARNING() << "invalid chunk size '" << size_str << '\'';
+    return LineResult::kError;
+  }
+
+  if (chunk_size == 0) {
+    state_ = State::kTrailers;
+  } else {
+    body_remaining_ = chunk_size;
+    state_ = State::kChunkData;
+  }
+  return LineResult::kOk;
+}
+
+SimdHttpRequestParser::LineResult SimdHttpRequestParser::ProcessBody(
+    std::string_view& data) {
+  const auto size = static_cast<std::size_t>(
+      std::min<std::uint64_t>(body_remaining_, data.size()));
+  if (body_producer_) {
+    if (!body_producer_->Push(data.substr(0, size))) return LineResult::kError;
+  } else {
+    UASSERT(request_constructor_);
+    try {
+      request_constructor_->AppendBody(data.data(), size);
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't append body: " << ex;
+      return LineResult::kError;
+    }
+  }
+  data.remove_prefix(size);
+  body_remaining_ -= size;
+
+  if (body_remaining_ != 0) return LineResult::kOk;
+  if (state_ == State::kChunkData) {
+    state_ = State::kChunkDataEnd;
+    return LineResult::kOk;
+  }
+  return CompleteRequest();
+}
+
+bool SimdHttpRequestParser::CheckPendingLineSize() {
+  // Too long lines are passed to the request constructor to fail the request
+  // with the appropriate status
+  try {
+    switch (state_) {
+      case State::kRequestLine:
+        if (pending_line_.size() <=
+            request_constructor_config_.max_url_size +
+                kMaxRequestLineOverhead) {
+          return true;
+        }
+        CreateRequestConstructor();
+        request_constructor_->AppendUrl(pending_line_.data(),
+                                        pending_line_.size());
+        break;
+      case State::kHeaders:
+        if (pending_line_.size() <=
+            request_constructor_config_.max_headers_size) {
+          return true;
+        }
+        request_constructor_->AppendHeader(pending_line_, {});
+        break;
+      default:
+        if (pending_line_.size() <=
+            request_constructor_config_.max_headers_size) {
+          return true;
+        }
+        break;
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append line: " << ex;
+    return false;
+  }
+  LOG_WARNING() << "too long line of " << pending_line_.size() << " bytes";
+  return false;
+}
+
+void SimdHttpRequestParser::CreateRequestConstructor() {
+  ++stats_.parsing_request_count;
+  request_constructor_.emplace(request_constructor_config_, handler_info_index_,
+                               data_accounter_);
+
+  http_minor_ = 1;
+  content_length_.reset();
+  body_remaining_ = 0;
+  is_chunked_ = false;
+  has_connection_close_ = false;
+  has_connection_keep_alive_ = false;
+  has_connection_upgrade_ = false;
+  has_upgrade_ = false;
+  is_connect_ = false;
+}
+
+bool SimdHttpRequestParser::IsKeepAlive() const {
+  return http_minor_ == 0
+             ? has_connection_keep_alive_ && !has_connection_close_
+             : !has_connection_close_;
+}
+
+bool SimdHttpRequestParser::IsUpgrade() const {
+  return is_connect_ || (has_upgrade_ && has_connection_upgrade_);
+}
+
+SimdHttpRequestParser::LineResult SimdHttpRequestParser::CompleteRequest() {
+  LOG_TRACE() << "message complete";
+  if (body_producer_) {
+    body_producer_->Complete();
+    body_producer_.reset();
+    state_ = State::kRequestLine;
+    // The rest of the input is ignored after the final request
+    return IsKeepAlive() ? LineResult::kOk : LineResult::kStop;
+  }
+
+  if (!FinalizeRequest(!IsKeepAlive())) return LineResult::kStop;
+  // The rest of the connection belongs to the new protocol
+  return IsUpgrade() ? LineResult::kStop : LineResult::kOk;
+}
+
+bool SimdHttpRequestParser::FinalizeRequest(bool is_final) {
+  UASSERT(request_constructor_);
+  request_constructor_->SetIsFinal(is_final);
+  auto request = request_constructor_->Finalize();
+  --stats_.parsing_request_count;
+  request_constructor_.reset();
+  state_ = State::kRequestLine;
+
+  if (!request) {
+    LOG_ERROR() << "request is null after Finalize()";
+    return false;
+  }
+  on_new_request_cb_(std::move(request));
+  return true;
+}
+
+void SimdHttpRequestParser::FinalizeRequestOnError() {
+  if (body_producer_) {
+    // The request is already passed to the handler, its body is aborted
+    body_producer_.reset();
+    return;
+  }
+  if (!request_constructor_) CreateRequestConstructor();
+  static_cast<void>(FinalizeRequest(true));
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+
+#include <userver/server/request/request_config.hpp>
+
+#include "http_request_constructor.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// HTTP/1.x request parser that works on whole lines instead of byte by byte
+/// callbacks.
+///
+/// Line ends are searched for with SIMD instructions (AVX2 or SSE2, depending
+/// on the build flags) in the same pass that rejects the control characters.
+/// The request line and the headers are passed to HttpRequestConstructor as
+/// complete values, several pipelined requests in one buffer are supported.
+/// Only an incomplete line is copied between the Parse() calls, the body is
+/// appended to the request directly from the input or is passed to the
+/// RequestBodyProducer if the handler streams it.
+class SimdHttpRequestParser final : public request::RequestParser {
+ public:
+  using OnNewRequestCb =
+      std::function<void(std::shared_ptr<request::RequestBase>&&)>;
+
+  SimdHttpRequestParser(const HandlerInfoIndex& handler_info_index,
+                        const request::HttpRequestConfig& request_config,
+                        OnNewRequestCb&& on_new_request_cb,
+                        net::ParserStats& stats,
+                        request::ResponseDataAccounter& data_accounter);
+
+  SimdHttpRequestParser(SimdHttpRequestParser&&) = delete;
+  SimdHttpRequestParser& operator=(SimdHttpRequestParser&&) = delete;
+
+  bool Parse(const char* data, size_t size) override;
+
+ private:
+  enum class State {
+    kRequestLine,
+    kHeaders,
+    kBody,
+    kChunkSize,
+    kChunkData,
+    kChunkDataEnd,
+    kTrailers,
+  };
+
+  enum class LineResult { kOk, kError, kStop };
+
+  LineResult ProcessLine(std::string_view line);
+  LineResult ProcessRequestLine(std::string_view line);
+  LineResult ProcessHeaderLine(std::string_view line);
+  bool InspectHeader(std::string_view name, std::string_view value);
+  LineResult ProcessHeadersEnd();
+  LineResult ProcessChunkSize(std::string_view line);
+  LineResult ProcessBody(std::string_view& data);
+
+  bool CheckPendingLineSize();
+
+  bool IsKeepAlive() const;
+  bool IsUpgrade() const;
+
+  void CreateRequestConstructor();
+  LineResult CompleteRequest();
+  bool FinalizeRequest(bool is_final);
+  void FinalizeRequestOnError();
+
+  const HandlerInfoIndex& handler_info_index_;
+  const HttpRequestConstructor::Config request_constructor_config_;
+
+  OnNewRequestCb on_new_request_cb_;
+
+  State state_{State::kRequestLine};
+  // Incomplete line from the previous Parse() calls
+  std::string pending_line_;
+  std::optional<HttpRequestConstructor> request_constructor_;
+  // Body of the already finalized request that is passed to the handler as
+  // it is received
+  std::unique_ptr<RequestBodyProducer> body_producer_;
+
+  // State of the current request
+  unsigned short http_minor_{1};
+  std::optional<std::uint64_t> content_length_;
+  std::uint64_t body_remaining_{0};
+  bool is_chunked_{false};
+  bool has_connection_close_{false};
+  bool has_connection_keep_alive_{false};
+  bool has_connection_upgrade_{false};
+  bool has_upgrade_{false};
+  bool is_connect_{false};
+
+  net::ParserStats& stats_;
+  request::ResponseDataAccounter& data_accounter_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,162 @@
+#include <userver/utest/utest.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <server/http/http_request_impl.hpp>
+#include <server/http/simd_http_request_parser.hpp>
+
+#include "create_parser_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using RequestPtr = std::shared_ptr<server::request::RequestBase>;
+
+constexpr std::string_view kPipelinedRequests =
+    "GET /first?arg=1 HTTP/1.1\r\n"
+    "Host: localhost\r\n"
+    "X-Test:  value \r\n"
+    "\r\n"
+    "POST /second HTTP/1.1\r\n"
+    "Content-Length: 5\r\n"
+    "\r\n"
+    "hello";
+
+struct ParsedRequests {
+  bool is_parsed{true};
+  std::vector<RequestPtr> requests;
+
+  const server::http::HttpRequestImpl& operator[](std::size_t i) const {
+    return dynamic_cast<const server::http::HttpRequestImpl&>(*requests.at(i));
+  }
+};
+
+// Feeds the data by parts of `part_size` bytes
+ParsedRequests ParseByParts(std::string_view data, std::size_t part_size) {
+  ParsedRequests result;
+  auto parser = server::CreateTestSimdParser(
+      [&result](RequestPtr&& request) {
+        result.requests.push_back(std::move(request));
+      });
+  while (!data.empty() && result.is_parsed) {
+    const auto part = data.substr(0, part_size);
+    result.is_parsed = parser.Parse(part.data(), part.size());
+    data.remove_prefix(part.size());
+  }
+  return result;
+}
+
+ParsedRequests ParseAll(std::string_view data) {
+  return ParseByParts(data, data.size());
+}
+
+}  // namespace
+
+TEST(SimdHttpRequestParser, Simple) {
+  const auto parsed = ParseAll(
+      "GET /path?arg=1 HTTP/1.1\r\nHost: localhost\r\nX-Test: value\r\n\r\n");
+  ASSERT_TRUE(parsed.is_parsed);
+  ASSERT_EQ(parsed.requests.size(), 1);
+
+  const auto& request = parsed[0];
+  EXPECT_EQ(request.GetMethod(), server::http::HttpMethod::kGet);
+  EXPECT_EQ(request.GetHttpMajor(), 1);
+  EXPECT_EQ(request.GetHttpMinor(), 1);
+  EXPECT_EQ(request.GetRequestPath(), "/path");
+  EXPECT_EQ(request.GetHeader("x-test"), "value");
+  EXPECT_EQ(request.GetHeader("Host"), "localhost");
+  EXPECT_FALSE(request.IsFinal());
+}
+
+TEST(SimdHttpRequestParser, Pipelined) {
+  const auto parsed = ParseAll(kPipelinedRequests);
+  ASSERT_TRUE(parsed.is_parsed);
+  ASSERT_EQ(parsed.requests.size(), 2);
+
+  EXPECT_EQ(parsed[0].GetRequestPath(), "/first");
+  EXPECT_EQ(parsed[0].GetHeader("X-Test"), "value");
+  EXPECT_EQ(parsed[1].GetMethod(), server::http::HttpMethod::kPost);
+  EXPECT_EQ(parsed[1].GetRequestPath(), "/second");
+  EXPECT_EQ(parsed[1].RequestBody(), "hello");
+}
+
+TEST(SimdHttpRequestParser, ByParts) {
+  for (std::size_t part_size = 1; part_size < kPipelinedRequests.size();
+       ++part_size) {
+    const auto parsed = ParseByParts(kPipelinedRequests, part_size);
+    ASSERT_TRUE(parsed.is_parsed) << "part_size=" << part_size;
+    ASSERT_EQ(parsed.requests.size(), 2) << "part_size=" << part_size;
+    EXPECT_EQ(parsed[0].GetHeader("X-Test"), "value");
+    EXPECT_EQ(parsed[1].RequestBody(), "hello");
+  }
+}
+
+TEST(SimdHttpRequestParser, Chunked) {
+  constexpr std::string_view kRequest =
+      "POST / HTTP/1.1\r\n"
+      "Transfer-Encoding: chunked\r\n"
+      "\r\n"
+      "5\r\nhello\r\n"
+      "6;ext=1\r\n world\r\n"
+      "0\r\n"
+      "X-Trailer: ignored\r\n"
+      "\r\n";
+  for (std::size_t part_size = 1; part_size <= kRequest.size(); ++part_size) {
+    const auto parsed = ParseByParts(kRequest, part_size);
+    ASSERT_TRUE(parsed.is_parsed) << "part_size=" << part_size;
+    ASSERT_EQ(parsed.requests.size(), 1) << "part_size=" << part_size;
+    EXPECT_EQ(parsed[0].RequestBody(), "hello world");
+  }
+}
+
+TEST(SimdHttpRequestParser, KeepAlive) {
+  EXPECT_TRUE(ParseAll("GET / HTTP/1.1\r\nConnection: close\r\n\r\n")[0]
+                  .IsFinal());
+  EXPECT_TRUE(ParseAll("GET / HTTP/1.0\r\n\r\n")[0].IsFinal());
+  EXPECT_FALSE(ParseAll("GET / HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n")[0]
+                   .IsFinal());
+}
+
+TEST(SimdHttpRequestParser, Upgrade) {
+  const auto parsed = ParseAll(
+      "GET /ws HTTP/1.1\r\nConnection: Upgrade\r\nUpgrade: websocket\r\n\r\n"
+      "\x81\x05hello");
+  EXPECT_FALSE(parsed.is_parsed);
+  ASSERT_EQ(parsed.requests.size(), 1);
+  EXPECT_EQ(parsed[0].GetRequestPath(), "/ws");
+}
+
+TEST(SimdHttpRequestParser, Malformed) {
+  for (const std::string_view request : {
+           "GET / HTTP/1.1\r\nNo colon\r\n\r\n",
+           "GET / HTTP/1.1\r\nName With Spaces: value\r\n\r\n",
+           "GET / HTTP/1.1\r\nX-Folded: value\r\n folded\r\n\r\n",
+           "GET / HTTP/1.1\r\nX-Bad: a\x01z\r\n\r\n",
+           "GET / HTTP/2.0\r\n\r\n",
+           "GET /\r\n\r\n",
+           "POST / HTTP/1.1\r\nContent-Length: 1x\r\n\r\n",
+           "POST / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n",
+           "POST / HTTP/1.1\r\nContent-Length: 1\r\n"
+           "Transfer-Encoding: chunked\r\n\r\n",
+           "POST / HTTP/1.1\r\nTransfer-Encoding: gzip\r\n\r\n",
+           "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n",
+       }) {
+    const auto parsed = ParseAll(request);
+    EXPECT_FALSE(parsed.is_parsed) << request;
+    // The request is passed on to respond with an error
+    EXPECT_EQ(parsed.requests.size(), 1) << request;
+  }
+}
+
+TEST(SimdHttpRequestParser, TooLongUrl) {
+  const auto parsed = ParseAll(
+      "GET /" +
+      std::string(server::impl::kTestRequestConfig.max_url_size * 2, 'a'));
+  EXPECT_FALSE(parsed.is_parsed);
+  EXPECT_EQ(parsed.requests.size(), 1);
+}
+
+USERVER_NAMESPACE_END
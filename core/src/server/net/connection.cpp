@@ -2,11 +2,15 @@
 
 #include <algorithm>
 #include <array>
+#include <memory>
 #include <stdexcept>
+#include <string_view>
 #include <system_error>
 #include <vector>
 
+#include <server/http/http_request_impl.hpp>
 #include <server/http/http_request_parser.hpp>
+#include <server/http/simd_http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
 
 #include <userver/engine/async.hpp>
@@ -23,6 +27,109 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+// Sent by the HTTP/2 clients with prior knowledge, RFC 9113 section 3.4
+constexpr std::string_view kHttp2Preface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+// The read buffer of an idle connection, ConnectionConfig::in_buffer_size is
+// the maximum one
+constexpr std::size_t kMinInBufferSize = 1024;
+
+// Up to this many bytes of the pipelined responses are sent together
+constexpr std::size_t kMaxCoalescedResponsesSize = 16 * 1024;
+
+// Power of 2 times kMinInBufferSize that is not less than `size`, limited by
+// `max_size`
+std::size_t GetInBufferSize(std::size_t size, std::size_t max_size) {
+  std::size_t result = std::min(kMinInBufferSize, max_size);
+  while (result < size && result < max_size) result *= 2;
+  return std::max<std::size_t>(std::min(result, max_size), 1);
+}
+
+// The buffer is shrunk only when it is this many times bigger than the data
+// read, so that the requests of varying sizes do not reallocate it each time
+constexpr std::size_t kInBufferShrinkFactor = 4;
+
+// Not value-initialized: the contents are always overwritten by the reads
+std::unique_ptr<char[]> AllocateInBuffer(std::size_t size) {
+  return std::unique_ptr<char[]>(new char[size]);
+}
+
+// Appends the writes to `buffer` while they fit into `max_buffered_size`,
+// sends the buffered data along with the first write that does not fit
+class CoalescingWriter final : public engine::io::RwBase {
+ public:
+  CoalescingWriter(engine::io::RwBase& socket, std::string& buffer,
+                   std::size_t max_buffered_size)
+      : socket_(socket),
+        buffer_(buffer),
+        max_buffered_size_(max_buffered_size) {}
+
+  bool IsValid() const override { return socket_.IsValid(); }
+
+  bool WaitReadable(engine::Deadline deadline) override {
+    return socket_.WaitReadable(deadline);
+  }
+
+  size_t ReadSome(void* buf, size_t len, engine::Deadline deadline) override {
+    return socket_.ReadSome(buf, len, deadline);
+  }
+
+  size_t ReadAll(void* buf, size_t len, engine::Deadline deadline) override {
+    return socket_.ReadAll(buf, len, deadline);
+  }
+
+  bool WaitWriteable(engine::Deadline deadline) override {
+    return socket_.WaitWriteable(deadline);
+  }
+
+  size_t WriteAll(const void* buf, size_t len,
+                  engine::Deadline deadline) override {
+    const engine::io::IoData io_data{buf, len};
+    return WriteAllv(&io_data, 1, deadline);
+  }
+
+  size_t WriteAllv(const engine::io::IoData* list, std::size_t list_size,
+                   engine::Deadline deadline) override {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < list_size; ++i) size += list[i].len;
+
+    if (buffer_.size() + size <= max_buffered_size_) {
+      for (std::size_t i = 0; i < list_size; ++i) {
+        buffer_.append(static_cast<const char*>(list[i].data), list[i].len);
+      }
+      return size;
+    }
+    if (buffer_.empty()) return socket_.WriteAllv(list, list_size, deadline);
+
+    std::vector<engine::io::IoData> io_data;
+    io_data.reserve(list_size + 1);
+    io_data.push_back({buffer_.data(), buffer_.size()});
+    io_data.insert(io_data.end(), list, list + list_size);
+    const auto buffered_size = buffer_.size();
+    std::string{}.swap(buffer_);
+
+    const auto sent =
+        socket_.WriteAllv(io_data.data(), io_data.size(), deadline);
+    return sent > buffered_size ? sent - buffered_size : 0;
+  }
+
+  void Flush(engine::Deadline deadline) {
+    if (buffer_.empty()) return;
+    [[maybe_unused]] const auto sent =
+        socket_.WriteAll(buffer_.data(), buffer_.size(), deadline);
+    std::string{}.swap(buffer_);
+  }
+
+ private:
+  engine::io::RwBase& socket_;
+  std::string& buffer_;
+  const std::size_t max_buffered_size_;
+};
+
+}  // namespace
+
 Connection::Connection(
     const ConnectionConfig& config,
     const request::HttpRequestConfig& handler_defaults_config,
@@ -82,6 +189,7 @@ void Connection::Shutdown() noexcept {
                  "requests) for fd "
               << Fd();
 
+  http2_session_.reset();
   peer_socket_.reset();
 
   --stats_->active_connections;
@@ -94,28 +202,93 @@ bool Connection::IsRequestTasksEmpty() const noexcept {
   return request_tasks_->GetSizeApproximate() == 0;
 }
 
+bool Connection::IsHttp2Negotiated() const {
+  auto* tls_socket = dynamic_cast<engine::io::TlsWrapper*>(peer_socket_.get());
+  return tls_socket && tls_socket->GetAlpnProtocol() == "h2";
+}
+
 void Connection::ListenForRequests(
     Queue::Producer producer, engine::TaskCancellationToken token) noexcept {
   using RequestBasePtr = std::shared_ptr<request::RequestBase>;
   utils::FastScopeGuard send_stopper([&]() noexcept { token.RequestCancel(); });
+  // Responses waiting for the peer would never be sent
+  const utils::FastScopeGuard http2_stopper([this]() noexcept {
+    if (http2_session_) http2_session_->Stop();
+  });
 
   try {
     request_tasks_->SetSoftMaxSize(config_.requests_queue_size_threshold);
 
-    http::HttpRequestParser request_parser(
-        request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
-        [this, &producer](RequestBasePtr&& request_ptr) {
-          if (!NewRequest(std::move(request_ptr), producer)) {
-            is_accepting_requests_ = false;
-          }
-        },
-        stats_->parser_stats, data_accounter_);
+    bool has_new_requests = false;
+    auto on_new_request = [this, &producer,
+                           &has_new_requests](RequestBasePtr&& request_ptr) {
+      has_new_requests = true;
+      if (!NewRequest(std::move(request_ptr), producer)) {
+        is_accepting_requests_ = false;
+      }
+    };
+
+    std::unique_ptr<request::RequestParser> http1_parser;
+    request::RequestParser* request_parser = nullptr;
+    const auto create_parser = [&](bool is_http2) {
+      if (is_http2) {
+        LOG_TRACE() << "Using HTTP/2 for fd " << Fd();
+        http2_session_ = std::make_unique<http::Http2Session>(
+            config_.http2, request_handler_.GetHandlerInfoIndex(),
+            handler_defaults_config_, on_new_request, stats_->parser_stats,
+            data_accounter_, *peer_socket_);
+        request_parser = http2_session_.get();
+      } else if (config_.simd_request_parser) {
+        http1_parser = std::make_unique<http::SimdHttpRequestParser>(
+            request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+            on_new_request, stats_->parser_stats, data_accounter_);
+        request_parser = http1_parser.get();
+      } else {
+        http1_parser = std::make_unique<http::HttpRequestParser>(
+            request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+            on_new_request, stats_->parser_stats, data_accounter_);
+        request_parser = http1_parser.get();
+      }
+    };
+
+    // Without ALPN the protocol is detected by the first bytes received
+    std::string preface;
+    if (!config_.http2.enabled) {
+      create_parser(false);
+    } else if (IsHttp2Negotiated()) {
+      create_parser(true);
+    }
 
-    std::vector<char> buf(config_.in_buffer_size);
+    // Grows while the reads fill it, shrinks before waiting for the next
+    // keepalive request, so that the idle connections take little memory.
+    // The data is always consumed by the parser before the buffer is
+    // reallocated, so nothing is copied.
+    std::size_t buf_size = GetInBufferSize(0, config_.in_buffer_size);
+    auto buf = AllocateInBuffer(buf_size);
     std::size_t last_bytes_read = 0;
     while (is_accepting_requests_) {
       auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
 
+      const bool is_buf_filled = (last_bytes_read == buf_size);
+      if (is_buf_filled) {
+        const auto new_size =
+            GetInBufferSize(buf_size * 2, config_.in_buffer_size);
+        if (new_size != buf_size) {
+          buf_size = new_size;
+          buf = AllocateInBuffer(buf_size);
+        }
+      } else if (has_new_requests) {
+        // The last read completed a request, the connection is likely to stay
+        // idle until the next one
+        const auto new_size =
+            GetInBufferSize(last_bytes_read, config_.in_buffer_size);
+        if (new_size * kInBufferShrinkFactor <= buf_size) {
+          buf_size = new_size;
+          buf = AllocateInBuffer(buf_size);
+        }
+      }
+      has_new_requests = false;
+
       bool is_readable = true;
       // If we didn't fill the buffer in the previous loop iteration we almost
       // certainly will hit EWOULDBLOCK on the subsequent recv syscall from
@@ -127,12 +300,12 @@ void Connection::ListenForRequests(
       // 3. recv (return some data)
       //
       // So instead we just do 2. and 3., shaving off a whole recv syscall
-      if (last_bytes_read != buf.size()) {
+      if (!is_buf_filled) {
         is_readable = peer_socket_->WaitReadable(deadline);
       }
 
       last_bytes_read =
-          is_readable ? peer_socket_->ReadSome(buf.data(), buf.size(), deadline)
+          is_readable ? peer_socket_->ReadSome(buf.get(), buf_size, deadline)
                       : 0;
       if (!last_bytes_read) {
         LOG_TRACE() << "Peer " << Getpeername() << " on fd " << Fd()
@@ -150,9 +323,25 @@ void Connection::ListenForRequests(
       LOG_TRACE() << "Received " << last_bytes_read << " byte(s) from "
                   << Getpeername() << " on fd " << Fd();
 
-      if (!request_parser.Parse(buf.data(), last_bytes_read)) {
-        LOG_DEBUG() << "Malformed request from " << Getpeername() << " on fd "
-                    << Fd();
+      std::string_view received{buf.get(), last_bytes_read};
+      if (!request_parser) {
+        preface.append(received);
+        if (kHttp2Preface.substr(0, preface.size()) == preface &&
+            preface.size() < kHttp2Preface.size()) {
+          continue;
+        }
+        create_parser(std::string_view{preface}.substr(
+                          0, kHttp2Preface.size()) == kHttp2Preface);
+        received = preface;
+      }
+
+      const bool is_parsed =
+          request_parser->Parse(received.data(), received.size());
+      if (!preface.empty()) preface = std::string{};
+
+      if (!is_parsed) {
+        LOG_DEBUG() << "Malformed or final request from " << Getpeername()
+                    << " on fd " << Fd();
 
         // Stop accepting new requests, send previous answers.
         is_accepting_requests_ = false;
@@ -191,19 +380,41 @@ bool Connection::NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
     return true;
   }
 
-  if (request_ptr->IsFinal()) {
+  // The streamed body of the final request is still to be read, the parser
+  // stops after it
+  if (request_ptr->IsFinal() && !request_ptr->IsBodyStreamed()) {
     is_accepting_requests_ = false;
   }
 
   ++stats_->active_request_count;
   auto task = request_handler_.StartRequestTask(request_ptr);
+  if (http2_session_) {
+    // The streams are independent, so the response is sent as soon as it is
+    // ready instead of waiting for the responses to the previous requests
+    task = engine::CriticalAsyncNoSpan(
+        [this](QueueItem item) {
+          HandleQueueItem(item);
+
+          // now we must complete processing
+          engine::TaskCancellationBlocker block_cancel;
+          SendResponse(*item.first);
+        },
+        QueueItem{request_ptr, std::move(task)});
+  }
   return producer.Push({std::move(request_ptr), std::move(task)});
 }
 
 void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
   try {
     QueueItem item;
-    while (consumer.Pop(item)) {
+    while (PopQueueItem(consumer, item)) {
+      if (http2_session_) {
+        WaitForStreamTask(item);
+        continue;
+      }
+
+      // The coalesced responses are not delayed by the slow handlers
+      if (!item.second.IsFinished()) FlushResponses();
       HandleQueueItem(item);
 
       // now we must complete processing
@@ -213,15 +424,57 @@ void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
        * until SendResponse() as the task produces body chunks.
        */
       SendResponse(*item.first);
-      if (item.first->IsUpgradeWebsocket())
+      if (item.first->IsUpgradeWebsocket()) {
+        FlushResponses();
         item.first->DoUpgrade(std::move(peer_socket_),
                               std::move(remote_address_));
+      }
       item.first.reset();
       item.second = {};
     }
   } catch (const std::exception& e) {
     LOG_ERROR() << "Exception for fd " << Fd() << ": " << e;
   }
+  FlushResponses();
+}
+
+bool Connection::PopQueueItem(Queue::Consumer& consumer, QueueItem& item) {
+  // The coalesced responses are sent before waiting for the next request
+  if (!pending_responses_.empty()) {
+    if (consumer.PopNoblock(item)) return true;
+    FlushResponses();
+  }
+  return consumer.Pop(item);
+}
+
+void Connection::FlushResponses() noexcept {
+  if (pending_responses_.empty()) return;
+
+  try {
+    if (is_response_chain_valid_ && peer_socket_) {
+      CoalescingWriter{*peer_socket_, pending_responses_, 0}.Flush(
+          engine::Deadline{});
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Error while sending the pipelined responses: " << ex;
+    is_response_chain_valid_ = false;
+  }
+  std::string{}.swap(pending_responses_);
+}
+
+void Connection::WaitForStreamTask(QueueItem& item) noexcept {
+  // The response is sent by the stream task itself, see NewRequest()
+  auto stream_task = std::move(item.second);
+  item.first.reset();
+
+  try {
+    stream_task.Get();
+  } catch (const engine::WaitInterruptedException&) {
+    LOG_DEBUG() << "Request processing interrupted";
+    stream_task.SyncCancel();
+  } catch (const std::exception& e) {
+    LOG_ERROR() << "Exception for fd " << Fd() << ": " << e;
+  }
 }
 
 void Connection::HandleQueueItem(QueueItem& item) noexcept {
@@ -268,8 +521,22 @@ void Connection::SendResponse(request::RequestBase& request) {
   request.SetStartSendResponseTime();
   if (is_response_chain_valid_ && peer_socket_) {
     try {
-      // Might be a stream reading or a fully constructed response
-      response.SendResponse(*peer_socket_);
+      if (http2_session_) {
+        http2_session_->SendResponse(
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+            static_cast<http::HttpRequestImpl&>(request));
+      } else if (const bool is_pipelined =
+                     !IsRequestTasksEmpty() && !response.IsBodyStreamed();
+                 is_pipelined || !pending_responses_.empty()) {
+        // The small responses to the pipelined requests are sent together,
+        // the rest are sent along with the buffered ones
+        CoalescingWriter writer{*peer_socket_, pending_responses_,
+                                is_pipelined ? kMaxCoalescedResponsesSize : 0};
+        response.SendResponse(writer);
+      } else {
+        // Might be a stream reading or a fully constructed response
+        response.SendResponse(*peer_socket_);
+      }
     } catch (const engine::io::IoSystemError& ex) {
       // working with raw values because std::errc compares error_category
       // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/request_handler_base.hpp>
 #include <server/net/connection_config.hpp>
 #include <server/net/stats.hpp>
@@ -42,6 +44,7 @@ class Connection final {
   void Shutdown() noexcept;
 
   bool IsRequestTasksEmpty() const noexcept;
+  bool IsHttp2Negotiated() const;
 
   void ListenForRequests(Queue::Producer producer,
                          engine::TaskCancellationToken token) noexcept;
@@ -49,6 +52,9 @@ class Connection final {
                   Queue::Producer&);
 
   void ProcessResponses(Queue::Consumer&) noexcept;
+  bool PopQueueItem(Queue::Consumer& consumer, QueueItem& item);
+  void FlushResponses() noexcept;
+  void WaitForStreamTask(QueueItem& item) noexcept;
   void HandleQueueItem(QueueItem& item) noexcept;
   void SendResponse(request::RequestBase& request);
 
@@ -65,9 +71,15 @@ class Connection final {
   std::string peer_name_;
 
   std::shared_ptr<Queue> request_tasks_;
+  // Set if the peer speaks HTTP/2, the responses are then sent by the request
+  // tasks themselves
+  std::unique_ptr<http::Http2Session> http2_session_;
+
+  // Responses to the pipelined requests waiting to be sent in one write
+  std::string pending_responses_;
 
   bool is_accepting_requests_{true};
-  bool is_response_chain_valid_{true};
+  std::atomic<bool> is_response_chain_valid_{true};
 };
 
 }  // namespace server::net
@@ -1,5 +1,6 @@
 #include <server/net/connection_config.hpp>
 
+#include <userver/formats/parse/common_containers.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -18,6 +19,21 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
   config.keepalive_timeout =
       value["keepalive_timeout"].As<std::chrono::seconds>(
           config.keepalive_timeout);
+  config.simd_request_parser =
+      value["simd_request_parser"].As<bool>(config.simd_request_parser);
+  config.socket_send_buffer_size =
+      value["socket_send_buffer_size"].As<std::optional<int>>();
+  config.socket_receive_buffer_size =
+      value["socket_receive_buffer_size"].As<std::optional<int>>();
+
+  const auto http2 = value["http2"];
+  config.http2.enabled = http2["enabled"].As<bool>(config.http2.enabled);
+  config.http2.max_concurrent_streams =
+      http2["max_concurrent_streams"].As<std::uint32_t>(
+          config.http2.max_concurrent_streams);
+  config.http2.initial_window_size =
+      http2["initial_window_size"].As<std::uint32_t>(
+          config.http2.initial_window_size);
 
   return config;
 }
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <userver/yaml_config/yaml_config.hpp>
@@ -9,10 +12,22 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+struct Http2Config {
+  bool enabled = false;
+  std::uint32_t max_concurrent_streams = 100;
+  std::uint32_t initial_window_size = 65535;
+};
+
 struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
+  bool simd_request_parser = false;
+  /// SO_SNDBUF/SO_RCVBUF of the accepted sockets, the system defaults if not
+  /// set
+  std::optional<int> socket_send_buffer_size;
+  std::optional<int> socket_receive_buffer_size;
+  Http2Config http2;
 };
 
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
@@ -274,6 +274,59 @@ UTEST(ServerNetConnection, KeepAlive) {
   EXPECT_EQ(handler.asyncs_finished, 2);
 }
 
+UTEST(ServerNetConnection, Pipelining) {
+  constexpr std::size_t kRequests = 5;
+  net::ListenerConfig config = CreateConfig();
+  auto request_socket = net::CreateSocket(config);
+
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  engine::io::Socket client{request_socket.Getsockname().Domain(),
+                            engine::io::SocketType::kStream};
+  client.Connect(request_socket.Getsockname(), deadline);
+
+  auto peer = request_socket.Accept(deadline);
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto task = engine::AsyncNoSpan([&] {
+    net::Connection connection(
+        config.connection_config, config.handler_defaults,
+        std::make_unique<engine::io::Socket>(std::move(peer)), {}, handler,
+        stats, data_accounter);
+
+    connection.Process();
+  });
+
+  std::string requests;
+  for (std::size_t i = 0; i < kRequests; ++i) {
+    requests += "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  }
+  ASSERT_EQ(client.SendAll(requests.data(), requests.size(), deadline),
+            requests.size());
+
+  std::string responses;
+  std::size_t statuses = 0;
+  while (statuses < kRequests) {
+    char buf[1024];
+    const auto received = client.RecvSome(buf, sizeof(buf), deadline);
+    ASSERT_NE(received, 0);
+    responses.append(buf, received);
+    statuses = 0;
+    for (auto pos = responses.find("HTTP/1.1 404"); pos != std::string::npos;
+         pos = responses.find("HTTP/1.1 404", pos + 1)) {
+      ++statuses;
+    }
+  }
+  EXPECT_EQ(statuses, kRequests);
+  EXPECT_EQ(handler.asyncs_finished, kRequests);
+
+  task.RequestCancel();
+  task.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(task.IsFinished());
+}
+
 UTEST(ServerNetConnection, CancelMultipleInFlight) {
   constexpr std::size_t kInFlightRequests = 10;
   constexpr std::size_t kMaxAttempts = 10;
@@ -1,14 +1,17 @@
 #include "create_socket.hpp"
 
 #include <arpa/inet.h>
+#include <linux/filter.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <cerrno>
 #include <cstdint>
 #include <cstring>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -21,6 +24,7 @@
 #include <userver/engine/sleep.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/logging/log.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -34,27 +38,37 @@ engine::io::Socket CreateUnixSocket(const std::string& path, int backlog) {
 
   if (path.size() >= sizeof(sa->sun_path))
     throw std::runtime_error("unix socket path is too long (" + path + ")");
-  if (path.empty())
-    throw std::runtime_error(
-        "unix socket path is empty, abstract sockets are not supported");
-  if (path[0] != '/')
-    throw std::runtime_error("unix socket path must be absolute (" + path +
-                             ")");
-  std::strncpy(sa->sun_path, path.c_str(), sizeof(sa->sun_path));
-
-  /* Use blocking API here, it is not critical as CreateUnixSocket() is called
-   * on startup only */
-
-  if (fs::blocking::GetFileType(path) ==
-      boost::filesystem::file_type::socket_file)
-    fs::blocking::RemoveSingleFile(path);
+  if (path.empty()) throw std::runtime_error("unix socket path is empty");
+
+  // '@name' is a socket in the abstract namespace: it has no file to clean
+  // up and no permissions, and it goes away with the last descriptor
+  const bool is_abstract = (path[0] == '@');
+  if (is_abstract) {
+    if (path.size() == 1)
+      throw std::runtime_error("abstract unix socket name is empty");
+    std::memcpy(sa->sun_path + 1, path.data() + 1, path.size() - 1);
+  } else {
+    if (path[0] != '/')
+      throw std::runtime_error("unix socket path must be absolute (" + path +
+                               ")");
+    std::strncpy(sa->sun_path, path.c_str(), sizeof(sa->sun_path));
+
+    /* Use blocking API here, it is not critical as CreateUnixSocket() is
+     * called on startup only */
+
+    if (fs::blocking::GetFileType(path) ==
+        boost::filesystem::file_type::socket_file)
+      fs::blocking::RemoveSingleFile(path);
+  }
 
   engine::io::Socket socket{addr.Domain(), engine::io::SocketType::kStream};
   socket.Bind(addr);
   socket.Listen(backlog);
 
-  auto perms = static_cast<boost::filesystem::perms>(0666);
-  fs::blocking::Chmod(path, perms);
+  if (!is_abstract) {
+    auto perms = static_cast<boost::filesystem::perms>(0666);
+    fs::blocking::Chmod(path, perms);
+  }
   return socket;
 }
 
@@ -82,6 +96,36 @@ engine::io::Socket CreateSocket(const ListenerConfig& config) {
     return CreateUnixSocket(config.unix_socket_path, config.backlog);
 }
 
+void AttachReuseportCpuSteering(engine::io::Socket& socket,
+                                std::size_t sockets_count) {
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+  // The program returns the index of the socket in the SO_REUSEPORT group,
+  // the indices follow the order in which the sockets started listening.
+  sock_filter code[] = {
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0,
+       static_cast<std::uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0,
+       static_cast<std::uint32_t>(sockets_count)},
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+  const sock_fprog program{static_cast<unsigned short>(std::size(code)), code};
+
+  if (::setsockopt(socket.Fd(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+                   &program, sizeof(program)) == -1) {
+    const std::error_code error{errno, std::system_category()};
+    LOG_WARNING() << "Failed to attach the CPU steering program to "
+                  << socket.Getsockname()
+                  << ", the connections are distributed by hash: "
+                  << error.message();
+  }
+#else
+  (void)sockets_count;
+  LOG_WARNING() << "SO_ATTACH_REUSEPORT_CBPF is not supported, the "
+                   "connections to "
+                << socket.Getsockname() << " are distributed by hash";
+#endif
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
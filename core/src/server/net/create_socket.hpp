@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include <server/net/listener_config.hpp>
 #include <userver/engine/io/socket.hpp>
 
@@ -9,6 +11,13 @@ namespace server::net {
 
 engine::io::Socket CreateSocket(const ListenerConfig& config);
 
+/// Makes the kernel pass the connections of the SO_REUSEPORT group of the
+/// `socket` to the listening socket with the index equal to the number of the
+/// CPU that received the SYN modulo `sockets_count`. Logs and keeps the
+/// default hash distribution if the kernel does not support it.
+void AttachReuseportCpuSteering(engine::io::Socket& socket,
+                                std::size_t sockets_count);
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
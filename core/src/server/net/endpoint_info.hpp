@@ -18,6 +18,8 @@ struct EndpointInfo {
   const ListenerConfig& listener_config;
   http::HttpRequestHandler& request_handler;
   Connection::Type connection_type{Connection::Type::kRequest};
+  // Listening sockets in the SO_REUSEPORT group, one per Listener
+  size_t listener_shards{1};
 
   std::atomic<size_t> connection_count{0};
 };
@@ -22,7 +22,11 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   config.max_connections =
       value["max_connections"].As<size_t>(config.max_connections);
   config.shards = value["shards"].As<std::optional<size_t>>(config.shards);
+  config.reuseport_cpu_steering = value["reuseport_cpu_steering"].As<bool>(
+      config.reuseport_cpu_steering);
   config.task_processor = value["task_processor"].As<std::string>();
+  config.shard_task_processors =
+      value["shard_task_processors"].As<std::string>({});
   config.backlog = value["backlog"].As<int>(config.backlog);
 
   if (config.port != 0 && !config.unix_socket_path.empty())
@@ -56,6 +60,7 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   if (!pkey_pass_name.empty()) {
     config.tls_private_key_passphrase_name = pkey_pass_name;
   }
+  config.tls_kernel_offload = value["tls"]["kernel-offload"].As<bool>(false);
 
   return config;
 }
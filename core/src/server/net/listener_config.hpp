@@ -22,13 +22,17 @@ struct ListenerConfig {
   int backlog = 1024;  // truncated to net.core.somaxconn
   size_t max_connections = 32768;
   std::optional<size_t> shards;
+  bool reuseport_cpu_steering{false};
   std::string task_processor;
+  // Name of the components::SingleThreadedTaskProcessors to run the shards on
+  std::string shard_task_processors;
 
   bool tls{false};
   crypto::Certificate tls_cert;
   std::string tls_private_key_path;
   std::string tls_private_key_passphrase_name;
   crypto::PrivateKey tls_private_key;
+  bool tls_kernel_offload{false};
 };
 
 ListenerConfig Parse(const yaml_config::YamlConfig& value,
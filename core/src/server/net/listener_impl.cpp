@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include <string>
 #include <system_error>
+#include <vector>
 
 #include <server/net/create_socket.hpp>
 #include <userver/engine/async.hpp>
@@ -14,6 +15,7 @@
 #include <userver/engine/io/socket.hpp>
 #include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/priority.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/write.hpp>
 #include <userver/logging/log.hpp>
@@ -24,6 +26,19 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+engine::io::Socket CreateListenerSocket(const EndpointInfo& endpoint_info) {
+  const auto& config = endpoint_info.listener_config;
+  auto socket = CreateSocket(config);
+  if (config.reuseport_cpu_steering && config.unix_socket_path.empty()) {
+    AttachReuseportCpuSteering(socket, endpoint_info.listener_shards);
+  }
+  return socket;
+}
+
+}  // namespace
+
 ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
                            std::shared_ptr<EndpointInfo> endpoint_info,
                            request::ResponseDataAccounter& data_accounter)
@@ -48,7 +63,7 @@ ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
               }
             }
           },
-          CreateSocket(endpoint_info_->listener_config))) {}
+          CreateListenerSocket(*endpoint_info_))) {}
 
 ListenerImpl::~ListenerImpl() {
   LOG_TRACE() << "Stopping socket listener task";
@@ -89,9 +104,25 @@ void ListenerImpl::AcceptConnection(engine::io::Socket& request_socket) {
 }
 
 void ListenerImpl::ProcessConnection(engine::io::Socket peer_socket) {
-  if (peer_socket.Getsockname().Domain() == engine::io::AddrDomain::kInet6 ||
-      peer_socket.Getsockname().Domain() == engine::io::AddrDomain::kInet)
+  if (endpoint_info_->connection_type == Connection::Type::kMonitor) {
+    // The request tasks inherit the priority, so health checks and monitoring
+    // do not wait behind the bulk work in a priority-task-queue
+    engine::current_task::SetPriority(engine::TaskPriority::kHigh);
+  }
+
+  const auto& connection_config =
+      endpoint_info_->listener_config.connection_config;
+  // Unix sockets have no TCP stack to tune
+  if (endpoint_info_->listener_config.unix_socket_path.empty())
     peer_socket.SetOption(IPPROTO_TCP, TCP_NODELAY, 1);
+  if (connection_config.socket_send_buffer_size) {
+    peer_socket.SetOption(SOL_SOCKET, SO_SNDBUF,
+                          *connection_config.socket_send_buffer_size);
+  }
+  if (connection_config.socket_receive_buffer_size) {
+    peer_socket.SetOption(SOL_SOCKET, SO_RCVBUF,
+                          *connection_config.socket_receive_buffer_size);
+  }
 
   const auto fd = peer_socket.Fd();
 
@@ -99,15 +130,26 @@ void ListenerImpl::ProcessConnection(engine::io::Socket peer_socket) {
   std::unique_ptr<engine::io::RwBase> socket;
   auto remote_address = peer_socket.Getpeername();
   if (endpoint_info_->listener_config.tls) {
-    socket = std::make_unique<engine::io::TlsWrapper>(
+    std::vector<std::string> alpn_protocols;
+    if (connection_config.http2.enabled) {
+      alpn_protocols = {"h2", "http/1.1"};
+    }
+    auto tls_socket = std::make_unique<engine::io::TlsWrapper>(
         engine::io::TlsWrapper::StartTlsServer(
             std::move(peer_socket), endpoint_info_->listener_config.tls_cert,
-            endpoint_info_->listener_config.tls_private_key, {}));
+            endpoint_info_->listener_config.tls_private_key, {}, {},
+            alpn_protocols,
+            endpoint_info_->listener_config.tls_kernel_offload
+                ? engine::io::TlsWrapper::KernelTls::kIfSupported
+                : engine::io::TlsWrapper::KernelTls::kDisabled));
+    ++stats_->tls_handshakes;
+    if (tls_socket->IsSessionReused()) ++stats_->tls_resumed_handshakes;
+    socket = std::move(tls_socket);
   } else {
     socket = std::make_unique<engine::io::Socket>(std::move(peer_socket));
   }
 
-  Connection connection_ptr(endpoint_info_->listener_config.connection_config,
+  Connection connection_ptr(connection_config,
                             endpoint_info_->listener_config.handler_defaults,
                             std::move(socket), std::move(remote_address),
                             endpoint_info_->request_handler, stats_,
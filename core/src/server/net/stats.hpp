@@ -27,6 +27,8 @@ struct Stats {
       : active_connections(other.active_connections.load()),
         connections_created(other.connections_created.load()),
         connections_closed(other.connections_closed.load()),
+        tls_handshakes(other.tls_handshakes.load()),
+        tls_resumed_handshakes(other.tls_resumed_handshakes.load()),
         parser_stats(other.parser_stats),
         active_request_count(other.active_request_count.load()),
         requests_processed_count(other.requests_processed_count.load()) {}
@@ -37,6 +39,8 @@ struct Stats {
   std::atomic<size_t> active_connections{0};
   std::atomic<size_t> connections_created{0};
   std::atomic<size_t> connections_closed{0};
+  std::atomic<size_t> tls_handshakes{0};
+  std::atomic<size_t> tls_resumed_handshakes{0};
 
   // per connection
   ParserStats parser_stats;
@@ -48,6 +52,8 @@ inline Stats& operator+=(Stats& lhs, const Stats& rhs) {
   lhs.active_connections += rhs.active_connections;
   lhs.connections_created += rhs.connections_created;
   lhs.connections_closed += rhs.connections_closed;
+  lhs.tls_handshakes += rhs.tls_handshakes;
+  lhs.tls_resumed_handshakes += rhs.tls_resumed_handshakes;
 
   lhs.parser_stats += rhs.parser_stats;
   lhs.active_request_count += rhs.active_request_count;
@@ -0,0 +1,73 @@
+#include <server/request/request_arena.hpp>
+
+#include <functional>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::request {
+
+namespace {
+
+constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+
+constexpr std::size_t AlignUp(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= kBlockAlignment);
+
+}  // namespace
+
+RequestArena& RequestArena::Create() {
+  void* block = ::operator new(kBlockSize);
+  auto* arena = new (block) RequestArena();
+  arena->used_ = AlignUp(sizeof(RequestArena), kBlockAlignment);
+  return *arena;
+}
+
+void* RequestArena::Allocate(std::size_t size, std::size_t alignment) {
+  UASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+  if (alignment <= kBlockAlignment) {
+    const auto offset = AlignUp(used_, alignment);
+    if (offset <= kBlockSize && size <= kBlockSize - offset) {
+      used_ = offset + size;
+      allocations_.fetch_add(1, std::memory_order_relaxed);
+      return reinterpret_cast<std::byte*>(this) + offset;
+    }
+  }
+
+  if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    return ::operator new(size, std::align_val_t{alignment});
+  }
+  return ::operator new(size);
+}
+
+void RequestArena::Deallocate(void* ptr, std::size_t /*size*/,
+                              std::size_t alignment) noexcept {
+  if (!IsInBlock(ptr)) {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      ::operator delete(ptr, std::align_val_t{alignment});
+    } else {
+      ::operator delete(ptr);
+    }
+    return;
+  }
+
+  if (allocations_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    this->~RequestArena();
+    ::operator delete(static_cast<void*>(this));
+  }
+}
+
+bool RequestArena::IsInBlock(const void* ptr) const noexcept {
+  const auto* begin = reinterpret_cast<const std::byte*>(this);
+  const auto* p = static_cast<const std::byte*>(ptr);
+  return std::less_equal<>{}(begin, p) && std::less<>{}(p, begin + kBlockSize);
+}
+
+}  // namespace server::request
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::request {
+
+/// Monotonic arena that holds the memory of a single request.
+///
+/// The arena is one block from the global allocator with the arena itself at
+/// its start. Allocations bump a pointer inside the block, the freed memory is
+/// never reused; allocations that do not fit go to the global allocator. The
+/// whole block is released at once when the last allocation from it is
+/// deallocated.
+///
+/// The request object is created with MakeShared(), so its shared_ptr control
+/// block lives in the arena and keeps it alive: the arena is released together
+/// with the last reference to the request, after the response is sent.
+///
+/// Allocate() must not be called concurrently, Deallocate() is thread-safe.
+class RequestArena final {
+ public:
+  static constexpr std::size_t kBlockSize = 4096;
+
+  RequestArena(const RequestArena&) = delete;
+  RequestArena& operator=(const RequestArena&) = delete;
+
+  /// Creates a new arena and constructs `T(arena, args...)` in it
+  template <typename T, typename... Args>
+  static std::shared_ptr<T> MakeShared(Args&&... args);
+
+  void* Allocate(std::size_t size, std::size_t alignment);
+  void Deallocate(void* ptr, std::size_t size, std::size_t alignment) noexcept;
+
+  /// Bytes of the block that are already handed out, for tests
+  std::size_t GetUsedBytes() const noexcept { return used_; }
+
+ private:
+  RequestArena() = default;
+  ~RequestArena() = default;
+
+  static RequestArena& Create();
+
+  bool IsInBlock(const void* ptr) const noexcept;
+
+  std::size_t used_{0};
+  std::atomic<std::size_t> allocations_{0};
+};
+
+/// Standard allocator that draws from the RequestArena
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(RequestArena& arena) noexcept : arena_(&arena) {}
+
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_(&other.GetArena()) {}
+
+  T* allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    arena_->Deallocate(ptr, n * sizeof(T), alignof(T));
+  }
+
+  RequestArena& GetArena() const noexcept { return *arena_; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ == &other.GetArena();
+  }
+
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  RequestArena* arena_;
+};
+
+template <typename T, typename... Args>
+std::shared_ptr<T> RequestArena::MakeShared(Args&&... args) {
+  // The object and the control block must fit into the block, otherwise the
+  // arena would have no allocations to keep it alive
+  static_assert(sizeof(T) <= kBlockSize / 2, "Too big for the request arena");
+
+  auto& arena = Create();
+  // If T() throws, the control block is deallocated and releases the arena
+  return std::allocate_shared<T>(ArenaAllocator<T>{arena}, arena,
+                                 std::forward<Args>(args)...);
+}
+
+}  // namespace server::request
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,77 @@
+#include <server/request/request_arena.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::request::ArenaAllocator;
+using server::request::RequestArena;
+
+struct Request {
+  Request(RequestArena& arena, int& destroyed)
+      : args(ArenaAllocator<char>{arena}), destroyed(destroyed) {}
+
+  ~Request() { ++destroyed; }
+
+  std::vector<std::string, ArenaAllocator<std::string>> args;
+  int& destroyed;
+};
+
+}  // namespace
+
+TEST(RequestArena, ObjectOwnsArena) {
+  int destroyed = 0;
+  auto request = RequestArena::MakeShared<Request>(destroyed);
+  auto& arena = request->args.get_allocator().GetArena();
+  const auto used = arena.GetUsedBytes();
+
+  request->args.emplace_back("first");
+  request->args.emplace_back("second");
+  EXPECT_GT(arena.GetUsedBytes(), used);
+  EXPECT_EQ(request->args.back(), "second");
+
+  const auto copy = request;
+  request.reset();
+  EXPECT_EQ(destroyed, 0);
+  EXPECT_EQ(copy->args.size(), 2);
+}
+
+TEST(RequestArena, DoesNotFit) {
+  int destroyed = 0;
+  auto request = RequestArena::MakeShared<Request>(destroyed);
+  auto& arena = request->args.get_allocator().GetArena();
+
+  request->args.reserve(RequestArena::kBlockSize);
+  const auto used = arena.GetUsedBytes();
+  EXPECT_LE(used, RequestArena::kBlockSize);
+
+  request->args.emplace_back("value");
+  request.reset();
+  EXPECT_EQ(destroyed, 1);
+}
+
+TEST(RequestArena, Containers) {
+  int destroyed = 0;
+  auto request = RequestArena::MakeShared<Request>(destroyed);
+  const ArenaAllocator<char> allocator{
+      request->args.get_allocator().GetArena()};
+
+  std::unordered_map<int, int, std::hash<int>, std::equal_to<>,
+                     ArenaAllocator<std::pair<const int, int>>>
+      map(0, std::hash<int>{}, std::equal_to<>{}, allocator);
+  for (int i = 0; i < 1000; ++i) map.emplace(i, i);
+
+  // The arena is kept alive by the memory of the map
+  request.reset();
+  EXPECT_EQ(destroyed, 1);
+  EXPECT_EQ(map.at(999), 999);
+  map.clear();
+}
+
+USERVER_NAMESPACE_END
@@ -1,93 +1,73 @@
 #include <server/requests_view.hpp>
-#include <userver/engine/async.hpp>
-#include <userver/engine/sleep.hpp>
-#include <userver/engine/task/cancel.hpp>
+
+#include <algorithm>
+
+#include <userver/utils/statistics/impl/sharding.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace {
-const auto kDequeueBulkSize = 10000;
-const auto kDequeuePollPeriod = std::chrono::milliseconds(100);
+constexpr std::size_t kMinCompactSize = 64;
 }  // namespace
 
 namespace server {
 
 RequestsView::RequestsView()
-    : queue_(std::make_shared<Queue>()), job_requests(kDequeueBulkSize) {}
-
-RequestsView::~RequestsView() { StopBackgroundWorker(); }
-
-std::vector<std::shared_ptr<request::RequestBase>>
-RequestsView::GetAllRequests() {
-  std::vector<std::shared_ptr<request::RequestBase>> result;
-
-  // Move all to-be-deleted items into delete_list
-  // to avoid deletion under mutex.
-  std::list<RequestWPtr> delete_list;
-
-  {
-    std::lock_guard<engine::Mutex> lock(requests_in_flight_mutex_);
-    result.reserve(requests_in_flight_.size());
-
-    for (auto it = requests_in_flight_.begin();
-         it != requests_in_flight_.end();) {
-      auto ptr = it->lock();
-      if (!ptr) {
-        auto old = it++;
-        delete_list.splice(delete_list.begin(), requests_in_flight_, old);
-        continue;
-      }
-
-      result.push_back(std::move(ptr));
-      ++it;
-    }
+    : shard_count_(utils::statistics::impl::GetShardCount()),
+      shards_(std::make_unique<ShieldedShard[]>(shard_count_)) {
+  for (std::size_t i = 0; i < shard_count_; ++i) {
+    shards_[i]->compact_at = kMinCompactSize;
   }
-
-  return result;
 }
 
-void RequestsView::StartBackgroundWorker() {
-  job_task_ = engine::CriticalAsyncNoSpan([this]() { DoJob(); });
-}
-
-void RequestsView::StopBackgroundWorker() { job_task_.SyncCancel(); }
-
-void RequestsView::GarbageCollect() {
-  // Move all to-be-deleted items into delete_list
-  // to avoid deletion under mutex.
-  std::list<RequestWPtr> delete_list;
+RequestsView::~RequestsView() = default;
 
-  std::lock_guard<engine::Mutex> lock(requests_in_flight_mutex_);
-  for (auto it = requests_in_flight_.begin();
-       it != requests_in_flight_.end();) {
-    if (!it->expired()) {
-      ++it;
-      continue;
-    }
+void RequestsView::Register(
+    const std::shared_ptr<request::RequestBase>& request) {
+  auto& shard = *shards_[utils::statistics::impl::GetCurrentShard()];
 
-    auto old = it++;
-    delete_list.splice(delete_list.begin(), requests_in_flight_, old);
+  const std::lock_guard lock(shard.mutex);
+  if (shard.requests.size() >= shard.compact_at) {
+    const auto expired_begin =
+        std::remove_if(shard.requests.begin(), shard.requests.end(),
+                       [](const RequestWPtr& ptr) { return ptr.expired(); });
+    shard.requests.erase(expired_begin, shard.requests.end());
+    shard.compact_at = std::max(kMinCompactSize, shard.requests.size() * 2);
   }
+  shard.requests.push_back(request);
 }
 
-void RequestsView::HandleQueue() {
-  std::lock_guard<engine::Mutex> lock(requests_in_flight_mutex_);
-  for (;;) {
-    const auto count =
-        queue_->try_dequeue_bulk(job_requests.begin(), job_requests.size());
-    if (count == 0) break;
+std::vector<std::shared_ptr<request::RequestBase>>
+RequestsView::GetAllRequests() {
+  std::vector<std::shared_ptr<request::RequestBase>> result;
 
-    for (size_t i = 0; i < count; ++i)
-      requests_in_flight_.push_back(std::move(job_requests[i]));
+  for (std::size_t i = 0; i < shard_count_; ++i) {
+    auto& shard = *shards_[i];
+    const std::lock_guard lock(shard.mutex);
+    result.reserve(result.size() + shard.requests.size());
+    for (const auto& request : shard.requests) {
+      // The requests are destroyed outside of the lock, with `result`
+      if (auto ptr = request.lock()) result.push_back(std::move(ptr));
+    }
   }
+
+  return result;
 }
 
-void RequestsView::DoJob() {
-  while (!engine::current_task::ShouldCancel()) {
-    GarbageCollect();
-    HandleQueue();
-    engine::InterruptibleSleepFor(kDequeuePollPeriod);
+std::vector<std::shared_ptr<request::RequestBase>>
+RequestsView::GetSlowestRequests(std::size_t count) {
+  auto requests = GetAllRequests();
+  const auto by_start_time = [](const auto& lhs, const auto& rhs) {
+    return lhs->StartTime() < rhs->StartTime();
+  };
+
+  if (requests.size() > count) {
+    std::nth_element(requests.begin(), requests.begin() + count,
+                     requests.end(), by_start_time);
+    requests.resize(count);
   }
+  std::sort(requests.begin(), requests.end(), by_start_time);
+  return requests;
 }
 
 }  // namespace server
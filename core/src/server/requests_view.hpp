@@ -1,46 +1,47 @@
 #pragma once
 
-#include <list>
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <vector>
 
-#include <moodycamel/concurrentqueue.h>
-#include <userver/engine/mutex.hpp>
+#include <concurrent/impl/interference_shield.hpp>
 #include <userver/server/request/request_base.hpp>
-#include <userver/utils/periodic_task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server {
 
+/// Remembers the in-flight requests for inspection. The requests are
+/// registered into per-CPU shards, so registering synchronizes only with the
+/// requests registered on the same CPU and with the rare snapshots. Expired
+/// requests are removed from a shard once it doubles in size.
 class RequestsView final {
  public:
   RequestsView();
   ~RequestsView();
 
   using RequestWPtr = std::weak_ptr<request::RequestBase>;
-  using Queue = moodycamel::ConcurrentQueue<RequestWPtr>;
 
-  std::shared_ptr<Queue> GetQueue() { return queue_; }
+  void Register(const std::shared_ptr<request::RequestBase>& request);
 
   std::vector<std::shared_ptr<request::RequestBase>> GetAllRequests();
 
-  void StartBackgroundWorker();
-
-  void StopBackgroundWorker();
+  /// @returns at most `count` in-flight requests, the longest running first
+  std::vector<std::shared_ptr<request::RequestBase>> GetSlowestRequests(
+      std::size_t count);
 
  private:
-  void DoJob();
-
-  void GarbageCollect();
-
-  void HandleQueue();
+  struct Shard {
+    std::mutex mutex;
+    std::vector<RequestWPtr> requests;
+    std::size_t compact_at;
+  };
 
-  std::shared_ptr<Queue> queue_;
-  engine::TaskWithResult<void> job_task_;
-  std::vector<RequestWPtr> job_requests;
+  using ShieldedShard = concurrent::impl::InterferenceShield<Shard>;
 
-  engine::Mutex requests_in_flight_mutex_;
-  std::list<RequestWPtr> requests_in_flight_;
+  const std::size_t shard_count_;
+  std::unique_ptr<ShieldedShard[]> shards_;
 };
 
 }  // namespace server
@@ -4,6 +4,8 @@
 #include <shared_mutex>
 #include <stdexcept>
 
+#include <userver/components/component_context.hpp>
+#include <userver/components/single_threaded_task_processors.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -60,13 +62,31 @@ void PortInfo::Init(const ServerConfig& config,
   endpoint_info_ =
       std::make_shared<net::EndpointInfo>(listener_config, *request_handler_);
 
+  engine::SingleThreadedTaskProcessorsPool* shard_task_processors = nullptr;
+  if (!listener_config.shard_task_processors.empty()) {
+    shard_task_processors =
+        &component_context
+             .FindComponent<components::SingleThreadedTaskProcessors>(
+                 listener_config.shard_task_processors)
+             .GetPool();
+  }
+
   const auto& event_thread_pool = task_processor.EventThreadPool();
-  size_t listener_shards = listener_config.shards ? *listener_config.shards
-                                                  : event_thread_pool.GetSize();
+  size_t listener_shards =
+      listener_config.shards ? *listener_config.shards
+      : shard_task_processors ? shard_task_processors->GetSize()
+                              : event_thread_pool.GetSize();
+
+  endpoint_info_->listener_shards = listener_shards;
 
   listeners_.reserve(listener_shards);
-  while (listener_shards--) {
-    listeners_.emplace_back(endpoint_info_, task_processor, data_accounter_);
+  for (size_t i = 0; i < listener_shards; ++i) {
+    auto& shard_task_processor =
+        shard_task_processors
+            ? shard_task_processors->At(i % shard_task_processors->GetSize())
+            : task_processor;
+    listeners_.emplace_back(endpoint_info_, shard_task_processor,
+                            data_accounter_);
   }
 }
 
@@ -173,10 +193,8 @@ void ServerImpl::StartPortInfos() {
   UASSERT(main_port_info_.request_handler_);
 
   if (has_requests_view_watchers_.load()) {
-    auto queue = requests_view_.GetQueue();
-    requests_view_.StartBackgroundWorker();
-    auto hook = [queue](std::shared_ptr<request::RequestBase> request) {
-      queue->enqueue(request);
+    auto hook = [this](std::shared_ptr<request::RequestBase> request) {
+      requests_view_.Register(request);
     };
     main_port_info_.request_handler_->SetNewRequestHook(hook);
     if (monitor_port_info_.request_handler_) {
@@ -331,6 +349,11 @@ void Server::WriteMonitorData(utils::statistics::Writer& writer) const {
     conn_stats["closed"] = server_stats.connections_closed;
   }
 
+  if (auto tls_stats = writer["tls"]) {
+    tls_stats["handshakes"] = server_stats.tls_handshakes;
+    tls_stats["resumed-handshakes"] = server_stats.tls_resumed_handshakes;
+  }
+
   if (auto request_stats = writer["requests"]) {
     request_stats["active"] = server_stats.active_request_count;
     request_stats["avg-lifetime-ms"] = pimpl->GetAvgRequestTimeMs().count();
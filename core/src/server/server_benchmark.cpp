@@ -0,0 +1,287 @@
+#include <benchmark/benchmark.h>
+
+#include <netinet/in.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/components/component.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/components/minimal_server_component_list.hpp>
+#include <userver/components/run.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/server/component.hpp>
+#include <userver/server/handlers/http_handler_json_base.hpp>
+#include <userver/server/handlers/ping.hpp>
+#include <userver/utils/from_string.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Each connection sends this many requests per benchmark iteration
+constexpr std::size_t kRequestsPerIteration = 100;
+constexpr std::chrono::seconds kTimeout{10};
+
+constexpr std::string_view kStaticConfig = R"(
+components_manager:
+  coro_pool:
+    initial_size: 500
+    max_size: 5000
+  default_task_processor: main-task-processor
+  event_thread_pool:
+    threads: 2
+  task_processors:
+    fs-task-processor:
+      worker_threads: 1
+    main-task-processor:
+      worker_threads: 4
+    bench-task-processor:
+      worker_threads: 2
+  components:
+    logging:
+      fs-task-processor: fs-task-processor
+      loggers:
+        default:
+          file_path: '@null'
+          level: error
+    server:
+      listener:
+        port: {0}
+        task_processor: main-task-processor
+    handler-ping:
+      path: /ping
+      method: GET
+      task_processor: main-task-processor
+      throttling_enabled: false
+    handler-json-echo:
+      path: /echo
+      method: POST
+      task_processor: main-task-processor
+)";
+
+struct LoadProfile final {
+  std::uint16_t port{0};
+  std::string_view request;
+  std::size_t connections{0};
+};
+
+class JsonEcho final : public server::handlers::HttpHandlerJsonBase {
+ public:
+  static constexpr std::string_view kName = "handler-json-echo";
+
+  using HttpHandlerJsonBase::HttpHandlerJsonBase;
+
+  formats::json::Value HandleRequestJsonThrow(
+      const server::http::HttpRequest&,
+      const formats::json::Value& request_json,
+      server::request::RequestContext&) const override {
+    return request_json;
+  }
+};
+
+// A keep-alive HTTP/1.1 connection without a client library in between, so
+// that mostly the server side of the exchange is measured
+class ClientConnection final {
+ public:
+  explicit ClientConnection(const engine::io::Sockaddr& addr)
+      : socket_(addr.Domain(), engine::io::SocketType::kStream) {
+    socket_.Connect(addr, engine::Deadline::FromDuration(kTimeout));
+  }
+
+  void Roundtrip(std::string_view request) {
+    const auto deadline = engine::Deadline::FromDuration(kTimeout);
+    if (socket_.SendAll(request.data(), request.size(), deadline) !=
+        request.size()) {
+      throw std::runtime_error("Failed to send a request");
+    }
+    ReadResponse(deadline);
+  }
+
+ private:
+  void ReadResponse(engine::Deadline deadline) {
+    constexpr std::string_view kHeadersEnd = "\r\n\r\n";
+    constexpr std::string_view kContentLength = "\r\nContent-Length: ";
+
+    std::size_t headers_end = 0;
+    while ((headers_end = buffer_.find(kHeadersEnd)) == std::string::npos) {
+      Recv(deadline);
+    }
+
+    const auto headers = std::string_view{buffer_}.substr(0, headers_end);
+    std::size_t body_size = 0;
+    if (const auto pos = headers.find(kContentLength);
+        pos != std::string_view::npos) {
+      auto value = headers.substr(pos + kContentLength.size());
+      value = value.substr(0, value.find("\r\n"));
+      body_size = utils::FromString<std::size_t>(value);
+    }
+
+    const auto response_size = headers_end + kHeadersEnd.size() + body_size;
+    while (buffer_.size() < response_size) Recv(deadline);
+    buffer_.erase(0, response_size);
+  }
+
+  void Recv(engine::Deadline deadline) {
+    std::array<char, 4096> chunk{};
+    const auto size = socket_.RecvSome(chunk.data(), chunk.size(), deadline);
+    if (size == 0) throw std::runtime_error("Connection closed by the server");
+    buffer_.append(chunk.data(), size);
+  }
+
+  engine::io::Socket socket_;
+  std::string buffer_;
+};
+
+// Set by the benchmark for the duration of components::RunOnce
+benchmark::State* current_state = nullptr;
+LoadProfile current_profile{};
+
+class LoadGenerator final : public components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "load-generator";
+
+  LoadGenerator(const components::ComponentConfig& config,
+                const components::ComponentContext& context)
+      : LoggableComponentBase(config, context),
+        task_processor_(context.GetTaskProcessor("bench-task-processor")) {
+    // Makes OnAllComponentsLoaded() run after the server has started
+    [[maybe_unused]] auto& server =
+        context.FindComponent<components::Server>();
+  }
+
+  // The server starts accepting requests in its OnAllComponentsLoaded(),
+  // which is called before the one of the components depending on it
+  void OnAllComponentsLoaded() override {
+    Run(*current_state, current_profile);
+  }
+
+ private:
+  void Run(benchmark::State& state, const LoadProfile& profile) {
+    engine::io::Sockaddr addr;
+    auto* sa = addr.As<struct sockaddr_in6>();
+    sa->sin6_family = AF_INET6;
+    sa->sin6_addr = in6addr_loopback;
+    addr.SetPort(profile.port);
+
+    std::vector<ClientConnection> connections;
+    connections.reserve(profile.connections);
+    for (std::size_t i = 0; i < profile.connections; ++i) {
+      connections.emplace_back(addr);
+    }
+
+    std::vector<std::chrono::steady_clock::duration> latencies;
+    latencies.reserve(profile.connections * kRequestsPerIteration);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(profile.connections);
+    for ([[maybe_unused]] auto _ : state) {
+      std::vector<std::vector<std::chrono::steady_clock::duration>> samples(
+          profile.connections);
+      for (std::size_t i = 0; i < profile.connections; ++i) {
+        tasks.push_back(engine::AsyncNoSpan(task_processor_, [&, i] {
+          samples[i].reserve(kRequestsPerIteration);
+          for (std::size_t j = 0; j < kRequestsPerIteration; ++j) {
+            const auto start = std::chrono::steady_clock::now();
+            connections[i].Roundtrip(profile.request);
+            samples[i].push_back(std::chrono::steady_clock::now() - start);
+          }
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+      tasks.clear();
+
+      state.PauseTiming();
+      for (const auto& connection_samples : samples) {
+        latencies.insert(latencies.end(), connection_samples.begin(),
+                         connection_samples.end());
+      }
+      state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * profile.connections *
+                            kRequestsPerIteration);
+    ReportPercentiles(state, latencies);
+  }
+
+  static void ReportPercentiles(
+      benchmark::State& state,
+      std::vector<std::chrono::steady_clock::duration>& latencies) {
+    if (latencies.empty()) return;
+    std::sort(latencies.begin(), latencies.end());
+    for (const auto percentile : {50, 90, 99}) {
+      const auto index = (latencies.size() - 1) * percentile / 100;
+      state.counters[fmt::format("p{}_us", percentile)] =
+          std::chrono::duration<double, std::micro>(latencies[index]).count();
+    }
+  }
+
+  engine::TaskProcessor& task_processor_;
+};
+
+}  // namespace
+
+template <>
+inline constexpr auto components::kConfigFileMode<LoadGenerator> =
+    components::ConfigFileMode::kNotRequired;
+
+namespace {
+
+std::uint16_t FindFreePort() {
+  std::uint16_t result{};
+  engine::RunStandalone([&result] {
+    const internal::net::TcpListener listener{};
+    result = listener.Port();
+  });
+  return result;
+}
+
+void RunServerBenchmark(benchmark::State& state, std::string_view request) {
+  const auto port = FindFreePort();
+  current_state = &state;
+  current_profile = {port, request, static_cast<std::size_t>(state.range(0))};
+
+  components::RunOnce(
+      components::InMemoryConfig{fmt::format(kStaticConfig, port)},
+      components::MinimalServerComponentList()
+          .Append<server::handlers::Ping>()
+          .Append<JsonEcho>()
+          .Append<LoadGenerator>());
+
+  current_state = nullptr;
+}
+
+}  // namespace
+
+void server_ping(benchmark::State& state) {
+  RunServerBenchmark(state,
+                     "GET /ping HTTP/1.1\r\n"
+                     "Host: localhost\r\n"
+                     "\r\n");
+}
+BENCHMARK(server_ping)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
+
+void server_json_echo(benchmark::State& state) {
+  RunServerBenchmark(state,
+                     "POST /echo HTTP/1.1\r\n"
+                     "Host: localhost\r\n"
+                     "Content-Type: application/json\r\n"
+                     "Content-Length: 47\r\n"
+                     "\r\n"
+                     R"({"id":42,"name":"userver","tags":["a","b","c"]})");
+}
+BENCHMARK(server_json_echo)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,244 @@
+#include <server/websocket/permessage_deflate.hpp>
+
+#include <algorithm>
+#include <limits>
+
+#include <zlib.h>
+
+#include <compression/error.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/text.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+namespace {
+
+constexpr std::string_view kExtensionName = "permessage-deflate";
+
+// The compressed payload is a raw deflate stream with this tail of the
+// Z_SYNC_FLUSH output removed
+constexpr std::string_view kDeflateTail{"\x00\x00\xff\xff", 4};
+
+constexpr int kMaxWindowBits = 15;
+// zlib does not support the raw deflate streams with 8 bits window
+constexpr int kMinWindowBits = 9;
+constexpr int kMemLevel = 8;
+
+// Room for the sync flush marker, that is not accounted by deflateBound()
+constexpr std::size_t kFlushReserve = 16;
+
+std::string_view TrimSpaces(std::string_view str) {
+  while (!str.empty() && (str.front() == ' ' || str.front() == '\t')) {
+    str.remove_prefix(1);
+  }
+  while (!str.empty() && (str.back() == ' ' || str.back() == '\t')) {
+    str.remove_suffix(1);
+  }
+  return str;
+}
+
+std::optional<int> ParseWindowBits(std::string_view value) {
+  if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+    value = value.substr(1, value.size() - 2);
+  }
+  if (value.empty() || value.size() > 2) return std::nullopt;
+
+  int bits = 0;
+  for (const char c : value) {
+    if (c < '0' || c > '9') return std::nullopt;
+    bits = bits * 10 + (c - '0');
+  }
+  if (bits < 8 || bits > kMaxWindowBits) return std::nullopt;
+  return bits;
+}
+
+std::optional<DeflateParams> ParseOffer(std::string_view offer) {
+  const auto params = utils::text::SplitIntoStringViewVector(offer, ";");
+  if (params.empty() || TrimSpaces(params.front()) != kExtensionName) {
+    return std::nullopt;
+  }
+
+  DeflateParams result;
+  bool has_server_max_window_bits = false;
+  bool has_client_max_window_bits = false;
+  for (std::size_t i = 1; i < params.size(); ++i) {
+    const auto param = TrimSpaces(params[i]);
+    const auto eq_pos = param.find('=');
+    const auto name = TrimSpaces(param.substr(0, eq_pos));
+    const auto value = eq_pos == std::string_view::npos
+                           ? std::optional<std::string_view>{}
+                           : TrimSpaces(param.substr(eq_pos + 1));
+
+    if (name == "server_no_context_takeover" && !value &&
+        !result.server_no_context_takeover) {
+      result.server_no_context_takeover = true;
+    } else if (name == "client_no_context_takeover" && !value &&
+               !result.client_no_context_takeover) {
+      result.client_no_context_takeover = true;
+    } else if (name == "server_max_window_bits" && value &&
+               !has_server_max_window_bits) {
+      const auto bits = ParseWindowBits(*value);
+      if (!bits || *bits < kMinWindowBits) return std::nullopt;
+      result.server_max_window_bits = *bits;
+      has_server_max_window_bits = true;
+    } else if (name == "client_max_window_bits" &&
+               !has_client_max_window_bits) {
+      // The client window is not limited in the response, the inflater
+      // handles any window size
+      if (value && !ParseWindowBits(*value)) return std::nullopt;
+      has_client_max_window_bits = true;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return result;
+}
+
+int ToZlibRawWindowBits(int window_bits) {
+  UASSERT(window_bits >= kMinWindowBits && window_bits <= kMaxWindowBits);
+  // Negative value selects the raw deflate stream without zlib header
+  return -window_bits;
+}
+
+Bytef* ToBytef(const void* ptr) {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  return static_cast<Bytef*>(const_cast<void*>(ptr));
+}
+
+}  // namespace
+
+std::optional<DeflateParams> NegotiateDeflate(std::string_view extensions,
+                                              const Config& config) {
+  if (!config.permessage_deflate) return std::nullopt;
+
+  for (const auto offer :
+       utils::text::SplitIntoStringViewVector(extensions, ",")) {
+    auto params = ParseOffer(offer);
+    if (!params) continue;
+
+    params->server_no_context_takeover |=
+        config.deflate_server_no_context_takeover;
+    params->client_no_context_takeover |=
+        config.deflate_client_no_context_takeover;
+    return params;
+  }
+  return std::nullopt;
+}
+
+std::string MakeDeflateResponse(const DeflateParams& params) {
+  std::string result{kExtensionName};
+  if (params.server_no_context_takeover) {
+    result += "; server_no_context_takeover";
+  }
+  if (params.client_no_context_takeover) {
+    result += "; client_no_context_takeover";
+  }
+  if (params.server_max_window_bits != kMaxWindowBits) {
+    result += "; server_max_window_bits=";
+    result += std::to_string(params.server_max_window_bits);
+  }
+  return result;
+}
+
+Deflater::Deflater(int window_bits, bool context_takeover)
+    : stream_(std::make_unique<z_stream>()),
+      context_takeover_(context_takeover) {
+  const auto ret =
+      deflateInit2(stream_.get(), Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                   ToZlibRawWindowBits(window_bits), kMemLevel,
+                   Z_DEFAULT_STRATEGY);
+  if (ret != Z_OK) {
+    throw compression::CompressionError(
+        "failed to initialize permessage-deflate compression");
+  }
+}
+
+Deflater::~Deflater() { deflateEnd(stream_.get()); }
+
+void Deflater::Compress(utils::span<const std::byte> data,
+                        std::string& output) {
+  UASSERT(data.size() <= std::numeric_limits<uInt>::max());
+
+  stream_->next_in = ToBytef(data.data());
+  stream_->avail_in = static_cast<uInt>(data.size());
+
+  output.resize(deflateBound(stream_.get(), data.size()) + kFlushReserve);
+  std::size_t size = 0;
+  while (true) {
+    stream_->next_out = ToBytef(output.data() + size);
+    stream_->avail_out = static_cast<uInt>(output.size() - size);
+
+    const auto ret = deflate(stream_.get(), Z_SYNC_FLUSH);
+    if (ret == Z_STREAM_ERROR) {
+      throw compression::CompressionError(
+          "failed to compress the websocket message");
+    }
+    size = output.size() - stream_->avail_out;
+
+    if (stream_->avail_out != 0) break;
+    output.resize(output.size() * 2);
+  }
+
+  UASSERT(size >= kDeflateTail.size() &&
+          std::string_view{output}.substr(0, size).substr(
+              size - kDeflateTail.size()) == kDeflateTail);
+  output.resize(size - kDeflateTail.size());
+
+  if (!context_takeover_) deflateReset(stream_.get());
+}
+
+Inflater::Inflater(bool context_takeover)
+    : stream_(std::make_unique<z_stream>()),
+      context_takeover_(context_takeover) {
+  // The client may use any window size, the biggest one fits all of them
+  if (inflateInit2(stream_.get(), ToZlibRawWindowBits(kMaxWindowBits)) !=
+      Z_OK) {
+    throw compression::CompressionError(
+        "failed to initialize permessage-deflate decompression");
+  }
+}
+
+Inflater::~Inflater() { inflateEnd(stream_.get()); }
+
+CloseStatus Inflater::Decompress(std::string& input, std::string& output,
+                                 std::size_t max_size) {
+  input.append(kDeflateTail);
+  UASSERT(input.size() <= std::numeric_limits<uInt>::max());
+
+  stream_->next_in = ToBytef(input.data());
+  stream_->avail_in = static_cast<uInt>(input.size());
+
+  // One byte over the limit detects the too big messages
+  const auto capacity = max_size + 1;
+  output.resize(std::min(input.size() * 4, capacity));
+  std::size_t size = 0;
+  while (true) {
+    stream_->next_out = ToBytef(output.data() + size);
+    stream_->avail_out = static_cast<uInt>(output.size() - size);
+
+    const auto ret = inflate(stream_.get(), Z_SYNC_FLUSH);
+    size = output.size() - stream_->avail_out;
+    if (ret == Z_STREAM_END) {
+      // The client has finished the deflate stream with the final block
+      inflateReset(stream_.get());
+      break;
+    }
+    if (ret != Z_OK && ret != Z_BUF_ERROR) return CloseStatus::kBadMessageData;
+
+    if (stream_->avail_in == 0 && stream_->avail_out != 0) break;
+    if (stream_->avail_out != 0) return CloseStatus::kBadMessageData;
+    if (output.size() == capacity) return CloseStatus::kTooBigData;
+    output.resize(std::min(output.size() * 2, capacity));
+  }
+  if (size > max_size) return CloseStatus::kTooBigData;
+  output.resize(size);
+
+  if (!context_takeover_) inflateReset(stream_.get());
+  return CloseStatus::kNone;
+}
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
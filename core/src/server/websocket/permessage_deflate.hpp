@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/server/websocket/server.hpp>
+#include <userver/utils/span.hpp>
+
+struct z_stream_s;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+/// Negotiated parameters of the permessage-deflate extension, see
+/// https://datatracker.ietf.org/doc/html/rfc7692#section-7.1
+struct DeflateParams final {
+  bool server_no_context_takeover{false};
+  bool client_no_context_takeover{false};
+  int server_max_window_bits{15};
+};
+
+/// Accepts the first supported permessage-deflate offer of the
+/// Sec-WebSocket-Extensions request header, returns std::nullopt if there is
+/// none.
+std::optional<DeflateParams> NegotiateDeflate(std::string_view extensions,
+                                              const Config& config);
+
+/// Sec-WebSocket-Extensions response header value for the accepted offer
+std::string MakeDeflateResponse(const DeflateParams& params);
+
+/// Compresses the messages into the payloads of the compressed frames
+class Deflater final {
+ public:
+  /// @throws compression::CompressionError
+  Deflater(int window_bits, bool context_takeover);
+  ~Deflater();
+
+  Deflater(Deflater&&) = delete;
+  Deflater& operator=(Deflater&&) = delete;
+
+  /// Replaces the `output` contents with the compressed `data`, reusing the
+  /// `output` memory.
+  /// @throws compression::CompressionError
+  void Compress(utils::span<const std::byte> data, std::string& output);
+
+ private:
+  std::unique_ptr<z_stream_s> stream_;
+  const bool context_takeover_;
+};
+
+/// Decompresses the payloads of the compressed messages
+class Inflater final {
+ public:
+  /// @throws compression::CompressionError
+  explicit Inflater(bool context_takeover);
+  ~Inflater();
+
+  Inflater(Inflater&&) = delete;
+  Inflater& operator=(Inflater&&) = delete;
+
+  /// Replaces the `output` contents with the decompressed `input`, reusing the
+  /// `output` memory. `input` is modified.
+  /// @returns CloseStatus::kNone on success or the status to close the
+  /// connection with
+  CloseStatus Decompress(std::string& input, std::string& output,
+                         std::size_t max_size);
+
+ private:
+  std::unique_ptr<z_stream_s> stream_;
+  const bool context_takeover_;
+};
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
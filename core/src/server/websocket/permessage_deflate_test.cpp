@@ -0,0 +1,118 @@
+#include <server/websocket/permessage_deflate.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::websocket::CloseStatus;
+namespace impl = server::websocket::impl;
+
+server::websocket::Config MakeConfig() {
+  server::websocket::Config config;
+  config.permessage_deflate = true;
+  return config;
+}
+
+utils::span<const std::byte> AsBytes(std::string_view data) {
+  return utils::as_bytes(utils::span<const char>(data));
+}
+
+}  // namespace
+
+TEST(WebsocketDeflate, Negotiate) {
+  const auto config = MakeConfig();
+
+  const auto params = impl::NegotiateDeflate(
+      "permessage-deflate; client_max_window_bits", config);
+  ASSERT_TRUE(params);
+  EXPECT_FALSE(params->server_no_context_takeover);
+  EXPECT_FALSE(params->client_no_context_takeover);
+  EXPECT_EQ(impl::MakeDeflateResponse(*params), "permessage-deflate");
+
+  const auto limited = impl::NegotiateDeflate(
+      "permessage-deflate; server_max_window_bits=10; "
+      "server_no_context_takeover",
+      config);
+  ASSERT_TRUE(limited);
+  EXPECT_EQ(impl::MakeDeflateResponse(*limited),
+            "permessage-deflate; server_no_context_takeover; "
+            "server_max_window_bits=10");
+}
+
+TEST(WebsocketDeflate, NegotiateFallback) {
+  const auto config = MakeConfig();
+
+  // zlib does not support 8 bits window, the second offer is accepted
+  const auto params = impl::NegotiateDeflate(
+      "permessage-deflate; server_max_window_bits=8, permessage-deflate; "
+      "client_no_context_takeover",
+      config);
+  ASSERT_TRUE(params);
+  EXPECT_TRUE(params->client_no_context_takeover);
+  EXPECT_EQ(params->server_max_window_bits, 15);
+
+  EXPECT_FALSE(impl::NegotiateDeflate("permessage-deflate; unknown", config));
+  EXPECT_FALSE(impl::NegotiateDeflate(
+      "permessage-deflate; server_no_context_takeover; "
+      "server_no_context_takeover",
+      config));
+  EXPECT_FALSE(impl::NegotiateDeflate("x-webkit-deflate-frame", config));
+  EXPECT_FALSE(impl::NegotiateDeflate("", config));
+
+  EXPECT_FALSE(impl::NegotiateDeflate("permessage-deflate",
+                                      server::websocket::Config{}));
+}
+
+TEST(WebsocketDeflate, NegotiateConfigOverrides) {
+  auto config = MakeConfig();
+  config.deflate_server_no_context_takeover = true;
+  config.deflate_client_no_context_takeover = true;
+
+  const auto params = impl::NegotiateDeflate("permessage-deflate", config);
+  ASSERT_TRUE(params);
+  EXPECT_EQ(impl::MakeDeflateResponse(*params),
+            "permessage-deflate; server_no_context_takeover; "
+            "client_no_context_takeover");
+}
+
+TEST(WebsocketDeflate, RoundTrip) {
+  for (const bool context_takeover : {true, false}) {
+    impl::Deflater deflater{15, context_takeover};
+    impl::Inflater inflater{context_takeover};
+
+    std::string compressed;
+    std::string decompressed;
+    const std::string messages[] = {"hello, hello, hello, hello",
+                                    "hello, world", std::string(10000, 'a'),
+                                    "x"};
+    for (const auto& message : messages) {
+      deflater.Compress(AsBytes(message), compressed);
+      EXPECT_EQ(inflater.Decompress(compressed, decompressed, 1 << 20),
+                CloseStatus::kNone);
+      EXPECT_EQ(decompressed, message);
+    }
+  }
+}
+
+TEST(WebsocketDeflate, DecompressErrors) {
+  impl::Deflater deflater{15, true};
+  impl::Inflater inflater{true};
+
+  const std::string message(1000, 'a');
+  std::string compressed;
+  std::string decompressed;
+  deflater.Compress(AsBytes(message), compressed);
+  EXPECT_EQ(inflater.Decompress(compressed, decompressed, 999),
+            CloseStatus::kTooBigData);
+
+  impl::Inflater broken_inflater{true};
+  std::string garbage = "\xff\xff\xff\xff";
+  EXPECT_EQ(broken_inflater.Decompress(garbage, decompressed, 1000),
+            CloseStatus::kBadMessageData);
+}
+
+USERVER_NAMESPACE_END
@@ -1,7 +1,14 @@
 #include <server/websocket/protocol.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include <cryptopp/sha.h>
 #include <boost/endian/conversion.hpp>
@@ -39,14 +46,26 @@ union Mask32 {
   uint8_t mask8[4];
 };
 
+// The mask is applied from the first byte of the frame payload
 void XorMaskInplace(uint8_t* dest, size_t len, Mask32 mask) {
-  auto* dest32 = reinterpret_cast<uint32_t*>(dest);
-  while (len >= sizeof(uint32_t)) {
-    *(dest32++) ^= mask.mask32;
-    len -= sizeof(uint32_t);
+  std::size_t i = 0;
+
+#ifdef __SSE2__
+  const auto mask128 = _mm_set1_epi32(static_cast<int>(mask.mask32));
+  for (; len - i >= sizeof(__m128i); i += sizeof(__m128i)) {
+    auto* block = reinterpret_cast<__m128i*>(dest + i);
+    _mm_storeu_si128(block, _mm_xor_si128(_mm_loadu_si128(block), mask128));
   }
-  auto* dest8 = reinterpret_cast<uint8_t*>(dest32);
-  for (unsigned i = 0; i < len; ++i) *(dest8++) ^= mask.mask8[i];
+#endif
+
+  const auto mask64 = std::uint64_t{mask.mask32} << 32 | mask.mask32;
+  for (; len - i >= sizeof(mask64); i += sizeof(mask64)) {
+    std::uint64_t block = 0;
+    std::memcpy(&block, dest + i, sizeof(block));
+    block ^= mask64;
+    std::memcpy(dest + i, &block, sizeof(block));
+  }
+  for (; i < len; ++i) dest[i] ^= mask.mask8[i % sizeof(mask.mask8)];
 }
 
 template <class T, class V>
@@ -61,7 +80,7 @@ namespace frames {
 
 boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
     utils::span<const std::byte> data, bool is_text,
-    Continuation is_continuation, Final is_final) {
+    Continuation is_continuation, Final is_final, Compressed is_compressed) {
   boost::container::small_vector<char, impl::kMaxFrameHeaderSize> frame;
 
   frame.resize(sizeof(WSHeader));
@@ -73,14 +92,18 @@ boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
   hdr->bytes = 0;
   hdr->bits.fin = is_final == Final::kYes ? 1 : 0;
   hdr->bits.opcode = is_text ? kText : kBinary;
-  if (is_continuation == Continuation::kYes) hdr->bits.opcode = kContinuation;
+  if (is_continuation == Continuation::kYes) {
+    hdr->bits.opcode = kContinuation;
+  } else if (is_compressed == Compressed::kYes) {
+    hdr->bits.reserved = kReservedCompressed;
+  }
 
   if (data.size() <= 125) {
     hdr->bits.payloadLen = data.size();
-  } else if (data.size() <= INT16_MAX) {
+  } else if (data.size() <= std::numeric_limits<std::uint16_t>::max()) {
     hdr->bits.payloadLen = 126;
     PushRaw(
-        boost::endian::native_to_big(static_cast<std::int16_t>(data.size())),
+        boost::endian::native_to_big(static_cast<std::uint16_t>(data.size())),
         frame);
   } else {
     hdr->bits.payloadLen = 127;
@@ -151,14 +174,65 @@ std::string WebsocketSecAnswer(std::string_view sec_key) {
                        sizeof(webSocketRespKeySHA1)));
 }
 
+BufferedReader::BufferedReader(engine::io::ReadableBase& io,
+                               std::size_t buffer_size)
+    : io_(io),
+      buffer_(std::make_unique<char[]>(buffer_size)),
+      buffer_size_(buffer_size) {}
+
+bool BufferedReader::IsValid() const { return io_.IsValid(); }
+
+bool BufferedReader::WaitReadable(engine::Deadline deadline) {
+  return begin_ != end_ || io_.WaitReadable(deadline);
+}
+
+size_t BufferedReader::ReadSome(void* buf, size_t len,
+                                engine::Deadline deadline) {
+  if (begin_ == end_) {
+    if (len >= buffer_size_) return io_.ReadSome(buf, len, deadline);
+
+    begin_ = 0;
+    end_ = io_.ReadSome(buffer_.get(), buffer_size_, deadline);
+  }
+
+  const auto size = std::min(len, end_ - begin_);
+  std::memcpy(buf, buffer_.get() + begin_, size);
+  begin_ += size;
+  return size;
+}
+
+size_t BufferedReader::ReadAll(void* buf, size_t len,
+                               engine::Deadline deadline) {
+  auto* const dest = static_cast<char*>(buf);
+  std::size_t size = 0;
+  while (size < len) {
+    const auto read = ReadSome(dest + size, len - size, deadline);
+    if (read == 0) break;
+    size += read;
+  }
+  return size;
+}
+
 CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
                         unsigned max_payload_size, std::size_t& payload_len) {
   WSHeader hdr;
   RecvExactly(io, AsWritableBytes(MakeSpan(&hdr, 1)), {});
   if (engine::current_task::ShouldCancel()) return CloseStatus::kGoingAway;
 
-  const bool isDataFrame =
-      (hdr.bits.opcode & (kText | kBinary)) || hdr.bits.opcode == kContinuation;
+  // Control opcodes have the highest bit set
+  const bool isDataFrame = !(hdr.bits.opcode & kClose);
+
+  if (hdr.bits.reserved & ~kReservedCompressed) {
+    return CloseStatus::kProtocolError;
+  }
+  if (hdr.bits.reserved & kReservedCompressed) {
+    // Only the first frame of a data message is marked as compressed
+    if (!frame.deflate_enabled || !isDataFrame ||
+        hdr.bits.opcode == kContinuation) {
+      return CloseStatus::kProtocolError;
+    }
+    frame.is_compressed = true;
+  }
   if (hdr.bits.payloadLen <= 125) {
     payload_len = hdr.bits.payloadLen;
   } else if (hdr.bits.payloadLen == 126) {
@@ -201,8 +275,9 @@ CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
     if (engine::current_task::ShouldCancel()) return CloseStatus::kGoingAway;
 
     if (mask.mask32)
-      XorMaskInplace(reinterpret_cast<uint8_t*>(frame.payload->data()),
-                     frame.payload->size(), mask);
+      XorMaskInplace(
+          reinterpret_cast<uint8_t*>(frame.payload->data() + newPayloadOffset),
+          payload_len, mask);
   }
   char opcode = hdr.bits.opcode;
   char fin = hdr.bits.fin;
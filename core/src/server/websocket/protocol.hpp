@@ -2,6 +2,8 @@
 
 #include <userver/server/websocket/server.hpp>
 
+#include <memory>
+#include <optional>
 #include <string>
 
 #include <boost/container/small_vector.hpp>
@@ -10,6 +12,8 @@
 #include <userver/tracing/span.hpp>
 #include <userver/utils/span.hpp>
 
+#include <server/websocket/permessage_deflate.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::websocket::impl {
@@ -60,6 +64,9 @@ union WSHeader {
 
 static_assert(sizeof(WSHeader) == 2);
 
+// RSV1 bit of WSHeader::bits::reserved, marks the compressed messages
+constexpr inline unsigned char kReservedCompressed = 0x4;
+
 constexpr inline unsigned int kMaxFrameHeaderSize =
     sizeof(WSHeader) + sizeof(uint64_t);
 
@@ -75,9 +82,15 @@ enum class Final {
   kNo,
 };
 
+enum class Compressed {
+  kYes,
+  kNo,
+};
+
 boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
     utils::span<const std::byte> data, bool is_text,
-    Continuation is_continuation, Final is_final);
+    Continuation is_continuation, Final is_final,
+    Compressed is_compressed = Compressed::kNo);
 std::array<char, sizeof(WSHeader)> MakeControlFrame(
     WSOpcodes opcode, utils::span<const std::byte> data = {});
 std::string CloseFrame(CloseStatusInt status_code);
@@ -94,14 +107,41 @@ struct FrameParserState {
   bool pong_received = false;
   bool waiting_continuation = false;
   bool is_text = false;
+  bool is_compressed = false;
+  bool deflate_enabled = false;
   CloseStatusInt remote_close_status = 0;
 
   std::string* payload = nullptr;
 };
 
+/// Reads the stream by big chunks, so that a small frame takes a single read
+/// instead of one per frame field. The reads that are bigger than the buffer
+/// go directly into the destination.
+class BufferedReader final : public engine::io::ReadableBase {
+ public:
+  BufferedReader(engine::io::ReadableBase& io, std::size_t buffer_size);
+
+  bool IsValid() const override;
+  bool WaitReadable(engine::Deadline deadline) override;
+  size_t ReadSome(void* buf, size_t len, engine::Deadline deadline) override;
+  size_t ReadAll(void* buf, size_t len, engine::Deadline deadline) override;
+
+ private:
+  engine::io::ReadableBase& io_;
+  std::unique_ptr<char[]> buffer_;
+  const std::size_t buffer_size_;
+  std::size_t begin_{0};
+  std::size_t end_{0};
+};
+
 CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
                         unsigned max_payload_size, std::size_t& payload_len);
 
+std::shared_ptr<WebSocketConnection> MakeWebSocket(
+    std::unique_ptr<engine::io::RwBase>&& socket,
+    engine::io::Sockaddr&& peer_name, const Config& config,
+    const std::optional<DeflateParams>& deflate_params);
+
 }  // namespace server::websocket::impl
 
 USERVER_NAMESPACE_END
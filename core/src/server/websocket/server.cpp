@@ -7,6 +7,7 @@
 #include <userver/utils/fast_scope_guard.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include "permessage_deflate.hpp"
 #include "protocol.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -14,6 +15,11 @@ USERVER_NAMESPACE_BEGIN
 namespace server::websocket {
 
 namespace {
+
+// Fits many small frames, a read of a bigger payload goes directly into the
+// message
+constexpr std::size_t kReadBufferSize = 4096;
+
 inline void SendExactly(engine::io::WritableBase& writable,
                         utils::span<const char> data1,
                         utils::span<const std::byte> data2) {
@@ -29,20 +35,62 @@ utils::span<const std::byte> MakeBinarySpan(utils::span<const char> span) {
   return utils::as_bytes(span);
 }
 
+std::string MakeFrame(utils::span<const std::byte> payload, bool is_text,
+                      impl::frames::Compressed is_compressed) {
+  const auto header = impl::frames::DataFrameHeader(
+      payload, is_text, impl::frames::Continuation::kNo,
+      impl::frames::Final::kYes, is_compressed);
+
+  std::string frame;
+  frame.reserve(header.size() + payload.size());
+  frame.append(header.data(), header.size());
+  frame.append(reinterpret_cast<const char*>(payload.data()), payload.size());
+  return frame;
+}
+
 }  // namespace
 
 Config Parse(const yaml_config::YamlConfig& config,
              formats::parse::To<Config>) {
-  return {
-      config["max-remote-payload"].As<unsigned>(65536),
-      config["fragment-size"].As<unsigned>(65536),
-  };
+  Config result;
+  result.max_remote_payload =
+      config["max-remote-payload"].As<unsigned>(result.max_remote_payload);
+  result.fragment_size =
+      config["fragment-size"].As<unsigned>(result.fragment_size);
+  result.permessage_deflate =
+      config["permessage-deflate"].As<bool>(result.permessage_deflate);
+  result.deflate_server_no_context_takeover =
+      config["deflate-server-no-context-takeover"].As<bool>(
+          result.deflate_server_no_context_takeover);
+  result.deflate_client_no_context_takeover =
+      config["deflate-client-no-context-takeover"].As<bool>(
+          result.deflate_client_no_context_takeover);
+  return result;
+}
+
+PreparedMessage::PreparedMessage(std::string_view data, bool is_text,
+                                 bool compress)
+    : frame_(MakeFrame(MakeBinarySpan(data), is_text,
+                       impl::frames::Compressed::kNo)),
+      payload_size_(data.size()) {
+  if (compress && !data.empty()) {
+    // A message compressed without the history is decompressed by the
+    // clients regardless of the previous messages
+    impl::Deflater deflater{15, false};
+    std::string compressed;
+    deflater.Compress(MakeBinarySpan(data), compressed);
+    if (compressed.size() < data.size()) {
+      compressed_frame_ = MakeFrame(MakeBinarySpan(compressed), is_text,
+                                    impl::frames::Compressed::kYes);
+    }
+  }
 }
 
 class WebSocketConnectionImpl final : public WebSocketConnection {
  public:
  private:
   std::unique_ptr<engine::io::RwBase> io;
+  impl::BufferedReader reader_;
 
   struct MessageExtended final {
     utils::span<const std::byte> data;
@@ -64,11 +112,32 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
 
   Config config;
 
+  // permessage-deflate state, the buffers are reused between the messages
+  std::optional<impl::Deflater> deflater_;
+  std::optional<impl::Inflater> inflater_;
+  std::string deflate_buffer_;
+  std::string inflate_buffer_;
+  // Whether the compressed frames of PreparedMessage could be sent
+  bool send_prepared_compressed_{false};
+
  public:
   WebSocketConnectionImpl(std::unique_ptr<engine::io::RwBase> io_,
                           const engine::io::Sockaddr& remote_addr,
-                          const Config& server_config)
-      : io(std::move(io_)), remote_addr_(remote_addr), config(server_config) {}
+                          const Config& server_config,
+                          const std::optional<impl::DeflateParams>& deflate)
+      : io(std::move(io_)),
+        reader_(*io, kReadBufferSize),
+        remote_addr_(remote_addr),
+        config(server_config) {
+    if (deflate) {
+      deflater_.emplace(deflate->server_max_window_bits,
+                        !deflate->server_no_context_takeover);
+      inflater_.emplace(!deflate->client_no_context_takeover);
+      frame_.deflate_enabled = true;
+      send_prepared_compressed_ = deflate->server_no_context_takeover &&
+                                  deflate->server_max_window_bits == 15;
+    }
+  }
 
   ~WebSocketConnectionImpl() override {
     LOG_TRACE() << "Websocket connection closed";
@@ -93,13 +162,20 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
       SendExactly(*io, close_frame, {});
     } else if (!message.data.empty()) {
       utils::span<const std::byte> data_to_send{message.data};
+      auto compressed = impl::frames::Compressed::kNo;
+      if (deflater_) {
+        deflater_->Compress(data_to_send, deflate_buffer_);
+        data_to_send = MakeBinarySpan(deflate_buffer_);
+        compressed = impl::frames::Compressed::kYes;
+      }
+
       auto continuation = impl::frames::Continuation::kNo;
       while (data_to_send.size() > config.fragment_size &&
              config.fragment_size > 0) {
         const auto data_frame_header = impl::frames::DataFrameHeader(
             data_to_send.first(config.fragment_size),
             message.opcode == impl::WSOpcodes::kText, continuation,
-            impl::frames::Final::kNo);
+            impl::frames::Final::kNo, compressed);
         SendExactly(*io, data_frame_header,
                     data_to_send.first(config.fragment_size));
         continuation = impl::frames::Continuation::kYes;
@@ -108,7 +184,7 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
       }
       const auto data_frame_header = impl::frames::DataFrameHeader(
           data_to_send, message.opcode == impl::WSOpcodes::kText, continuation,
-          impl::frames::Final::kYes);
+          impl::frames::Final::kYes, compressed);
       SendExactly(*io, data_frame_header, data_to_send);
     }
   }
@@ -131,17 +207,34 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
     SendExtended(mext);
   }
 
+  void SendPrepared(const PreparedMessage& message) override {
+    const auto& frame =
+        send_prepared_compressed_ && !message.compressed_frame_.empty()
+            ? message.compressed_frame_
+            : message.frame_;
+
+    stats_.msg_sent++;
+    stats_.bytes_sent += message.payload_size_;
+
+    const std::unique_lock lock(write_mutex_);
+    LOG_TRACE() << "Write prepared message " << message.payload_size_
+                << " bytes";
+    SendExactly(*io, frame, {});
+  }
+
   void Recv(Message& msg) override {
     msg.data.resize(0);  // do not call .clear() to keep the allocated memory
     frame_.payload = &msg.data;
     frame_.payload->resize(0);
+    frame_.is_text = false;
+    frame_.is_compressed = false;
 
     try {
       while (true) {
         size_t payload_len = 0;
         // ReadWSFrame() returns kGoingAway in case of task cancellation
-        CloseStatus status_raw =
-            ReadWSFrame(frame_, *io, config.max_remote_payload, payload_len);
+        CloseStatus status_raw = ReadWSFrame(
+            frame_, reader_, config.max_remote_payload, payload_len);
 
         auto status = static_cast<CloseStatusInt>(status_raw);
         LOG_TRACE() << fmt::format(
@@ -164,7 +257,9 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
 
         if (frame_.ping_received) {
           MessageExtended pongMsg{
-              MakeBinarySpan(*frame_.payload), impl::WSOpcodes::kPong, {}};
+              MakeBinarySpan(*frame_.payload).last(payload_len),
+              impl::WSOpcodes::kPong,
+              {}};
           SendExtended(pongMsg);
           frame_.payload->resize(frame_.payload->size() - payload_len);
           frame_.ping_received = false;
@@ -176,6 +271,19 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
         }
         if (frame_.waiting_continuation) continue;
 
+        if (frame_.is_compressed) {
+          const auto decompress_status = inflater_->Decompress(
+              msg.data, inflate_buffer_, config.max_remote_payload);
+          if (decompress_status != CloseStatus::kNone) {
+            MessageExtended close_msg{
+                {}, impl::WSOpcodes::kClose, decompress_status};
+            SendExtended(close_msg);
+            msg = CloseMessage(decompress_status);
+            return;
+          }
+          msg.data.swap(inflate_buffer_);
+        }
+
         msg.is_text = frame_.is_text;
         stats_.msg_recv++;
         stats_.bytes_recv += msg.data.size();
@@ -218,10 +326,22 @@ WebSocketConnection::~WebSocketConnection() = default;
 std::shared_ptr<WebSocketConnection> MakeWebSocket(
     std::unique_ptr<engine::io::RwBase>&& socket,
     engine::io::Sockaddr&& peer_name, const Config& config) {
+  return impl::MakeWebSocket(std::move(socket), std::move(peer_name), config,
+                             std::nullopt);
+}
+
+namespace impl {
+
+std::shared_ptr<WebSocketConnection> MakeWebSocket(
+    std::unique_ptr<engine::io::RwBase>&& socket,
+    engine::io::Sockaddr&& peer_name, const Config& config,
+    const std::optional<DeflateParams>& deflate_params) {
   return std::make_shared<WebSocketConnectionImpl>(
-      std::move(socket), std::move(peer_name), config);
+      std::move(socket), std::move(peer_name), config, deflate_params);
 }
 
+}  // namespace impl
+
 }  // namespace server::websocket
 
 USERVER_NAMESPACE_END
@@ -10,6 +10,7 @@
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include <userver/server/websocket/server.hpp>
+#include "permessage_deflate.hpp"
 #include "protocol.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -69,14 +70,24 @@ std::string WebsocketHandlerBase::HandleRequestThrow(
   response.SetHeader(USERVER_NAMESPACE::http::headers::kWebsocketAccept,
                      websocket::impl::WebsocketSecAnswer(secWebsocketKey));
 
+  auto deflate_params = websocket::impl::NegotiateDeflate(
+      request.GetHeader(USERVER_NAMESPACE::http::headers::kWebsocketExtensions),
+      config_);
+  if (deflate_params) {
+    response.SetHeader(
+        USERVER_NAMESPACE::http::headers::kWebsocketExtensions,
+        websocket::impl::MakeDeflateResponse(*deflate_params));
+  }
+
   request.SetUpgradeWebsocket(
       [context = std::make_shared<server::request::RequestContext>(
            std::move(context)),
+       deflate_params,
        this](std::unique_ptr<engine::io::RwBase> socket,
              engine::io::Sockaddr&& peer_name) {
         tracing::Span span("ws/" + HandlerName());
-        auto ws = websocket::MakeWebSocket(std::move(socket),
-                                           std::move(peer_name), config_);
+        auto ws = websocket::impl::MakeWebSocket(
+            std::move(socket), std::move(peer_name), config_, deflate_params);
         try {
           Handle(*ws, *context);
         } catch (const std::exception& e) {
@@ -112,6 +123,18 @@ properties:
         type: integer
         description: max output fragment size
         defaultDescription: 65536
+    permessage-deflate:
+        type: boolean
+        description: accept the permessage-deflate extension offered by the clients and compress the messages
+        defaultDescription: false
+    deflate-server-no-context-takeover:
+        type: boolean
+        description: compress each message independently, uses less memory and allows sending the compressed prepared messages
+        defaultDescription: false
+    deflate-client-no-context-takeover:
+        type: boolean
+        description: ask the clients to compress each message independently, uses less memory for the decompression
+        defaultDescription: false
 )");
 }
 
@@ -1,5 +1,8 @@
 #include <userver/tracing/component.hpp>
 
+#include <chrono>
+#include <optional>
+
 #include <userver/components/component.hpp>
 #include <userver/logging/component.hpp>
 #include <userver/tracing/tracer.hpp>
@@ -10,9 +13,25 @@ USERVER_NAMESPACE_BEGIN
 namespace components {
 
 namespace {
+
 constexpr std::string_view kNativeTrace = "native";
+
+std::optional<tracing::TailSamplingSettings> ParseTailSampling(
+    const ComponentConfig& config) {
+  const auto value = config["tail-sampling"];
+  if (value.IsMissing()) return std::nullopt;
+
+  tracing::TailSamplingSettings settings;
+  settings.max_spans = value["max-spans"].As<std::size_t>(settings.max_spans);
+  settings.latency_threshold =
+      value["latency-threshold"].As<std::chrono::milliseconds>(
+          settings.latency_threshold);
+  settings.sample_rate = value["sample-rate"].As<double>(settings.sample_rate);
+  return settings;
 }
 
+}  // namespace
+
 Tracer::Tracer(const ComponentConfig& config, const ComponentContext& context) {
   auto& logging_component = context.FindComponent<Logging>();
   auto opentracing_logger = logging_component.GetLoggerOptional("opentracing");
@@ -33,6 +52,7 @@ Tracer::Tracer(const ComponentConfig& config, const ComponentContext& context) {
 
     tracing::Tracer::SetTracer(tracing::MakeTracer(
         std::move(service_name), std::move(opentracing_logger), tracer_type));
+    tracing::Tracer::SetTailSampling(ParseTailSampling(config));
   } else {
     throw std::runtime_error("Tracer type is not supported: " + tracer_type);
   }
@@ -52,6 +72,28 @@ properties:
         type: string
         description: type of the tracer to trace, currently supported only 'native'
         defaultDescription: 'native'
+    tail-sampling:
+        type: object
+        description: |
+            if set, the spans of a trace are buffered until its root span
+            ends, and only failed, slow and randomly sampled traces are logged
+        additionalProperties: false
+        properties:
+            max-spans:
+                type: integer
+                description: spans of a trace over this number are dropped while the trace is buffered
+                defaultDescription: 1000
+                minimum: 1
+            latency-threshold:
+                type: string
+                description: traces with the root span at least this long are logged
+                defaultDescription: 1s
+            sample-rate:
+                type: number
+                description: probability to log a trace that is neither failed nor slow
+                defaultDescription: 0.01
+                minimum: 0
+                maximum: 1
 )");
 }
 
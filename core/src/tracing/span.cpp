@@ -1,19 +1,28 @@
 #include <tracing/span_impl.hpp>
 
+#include <cstdint>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <engine/impl/cpu_profiler.hpp>
 #include <engine/task/task_context.hpp>
 #include <logging/log_helper_impl.hpp>
+#include <userver/compiler/impl/constexpr.hpp>
+#include <userver/compiler/impl/tls.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/span_exporter.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/hex.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 #include <userver/utils/rand.hpp>
 #include <userver/utils/uuid4.hpp>
 #include <utils/internal_tag.hpp>
@@ -31,6 +40,9 @@ constexpr std::string_view kTotalTimeTag = "total_time";
 constexpr std::string_view kTimeUnitsTag = "stopwatch_units";
 constexpr std::string_view kStartTimestampTag = "start_timestamp";
 
+constexpr std::string_view kTailSamplingDroppedSpansTag =
+    "tail_sampling_dropped_spans";
+
 constexpr std::string_view kReferenceType = "span_ref_type";
 constexpr std::string_view kReferenceTypeChild = "child";
 constexpr std::string_view kReferenceTypeFollows = "follows";
@@ -59,12 +71,82 @@ TsBuffer StartTsToString(std::chrono::system_clock::time_point start) {
   return buffer;
 }
 
+// `true` is stored as int in logging::LogExtra::Value
+bool IsTrue(const logging::LogExtra::Value& value) {
+  const auto* flag = std::get_if<int>(&value);
+  return flag && *flag != 0;
+}
+
+// Keeps the memory of a few recently destroyed Span::Impl for the next spans
+// created on the same thread
+class SpanImplPool final {
+ public:
+  constexpr SpanImplPool() noexcept = default;
+
+  SpanImplPool(SpanImplPool&&) = delete;
+  SpanImplPool& operator=(SpanImplPool&&) = delete;
+
+  ~SpanImplPool() {
+    while (free_) ::operator delete(std::exchange(free_, free_->next));
+  }
+
+  void* Allocate() {
+    if (!free_) return ::operator new(sizeof(Span::Impl));
+    --size_;
+    return std::exchange(free_, free_->next);
+  }
+
+  void Deallocate(void* ptr) noexcept {
+    if (size_ == kMaxSize) {
+      ::operator delete(ptr);
+      return;
+    }
+    ++size_;
+    free_ = ::new (ptr) Node{free_};
+  }
+
+ private:
+  static constexpr std::size_t kMaxSize = 16;
+
+  struct Node final {
+    Node* next;
+  };
+
+  Node* free_{nullptr};
+  std::size_t size_{0};
+};
+
+thread_local USERVER_IMPL_CONSTINIT SpanImplPool local_span_impl_pool;
+
+USERVER_IMPL_PREVENT_TLS_CACHING SpanImplPool& GetLocalSpanImplPool() noexcept {
+  // NOLINTNEXTLINE
+  USERVER_IMPL_PREVENT_TLS_CACHING_ASM;
+
+  return local_span_impl_pool;
+}
+
 // Maintain coro-local span stack to identify "current span" in O(1).
 engine::TaskLocalVariable<SpanStack> task_local_spans;
 
+// Attributes the CPU profiler samples of the current task to its spans
+void UpdateCpuProfilerSpans() noexcept {
+  if (!engine::impl::CpuProfiler::IsRunning()) return;
+
+  auto* current = engine::current_task::GetCurrentTaskContextUnchecked();
+  if (current == nullptr || !current->HasLocalStorage()) return;
+
+  const auto* spans_ptr = task_local_spans.GetOptional();
+  if (!spans_ptr || spans_ptr->empty()) {
+    engine::impl::CpuProfiler::SetCurrentSpans({}, {});
+    return;
+  }
+  engine::impl::CpuProfiler::SetCurrentSpans(spans_ptr->front().GetName(),
+                                             spans_ptr->back().GetName());
+}
+
 std::string GenerateSpanId() {
-  std::uniform_int_distribution<std::uint64_t> dist;
-  auto random_value = dist(utils::DefaultRandom());
+  std::uint64_t random_value{};
+  utils::impl::FillRandomBytes(&random_value, sizeof(random_value));
 
   static_assert(sizeof(random_value) == 8);
   return utils::encoding::ToHex(&random_value, 8);
@@ -87,8 +169,9 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
       tracer_(std::move(tracer)),
       start_system_time_(std::chrono::system_clock::now()),
       start_steady_time_(std::chrono::steady_clock::now()),
-      trace_id_(parent ? parent->GetTraceId()
-                       : utils::generators::GenerateUuid()),
+      trace_id_(parent ? parent->trace_id_
+                       : std::make_shared<const std::string>(
+                             utils::generators::GenerateUuid())),
       span_id_(GenerateSpanId()),
       parent_id_(GetParentIdForLogging(parent)),
       reference_type_(reference_type),
@@ -96,14 +179,46 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
   if (parent) {
     log_extra_inheritable_ = parent->log_extra_inheritable_;
     local_log_level_ = parent->local_log_level_;
+    tail_sampler_ = parent->tail_sampler_;
+  } else if (auto tail_sampling = tracing::Tracer::GetTailSampling()) {
+    tail_sampler_ = std::make_shared<impl::TailSampler>(*tail_sampling);
+    is_tail_sampling_root_ = true;
   }
 }
 
 Span::Impl::~Impl() {
+  // runs before the hook is auto-unlinked after the members are destroyed
+  const utils::FastScopeGuard update_cpu_profiler([this]() noexcept {
+    if (is_linked() && engine::impl::CpuProfiler::IsRunning()) {
+      unlink();
+      UpdateCpuProfilerSpans();
+    }
+  });
+
+  if (auto exporter = tracing::Tracer::GetSpanExporter()) {
+    if (ShouldLog()) ExportTo(*exporter);
+  }
+
+  if (is_tail_sampling_root_ && tail_sampler_) {
+    const auto duration = std::chrono::steady_clock::now() - start_steady_time_;
+    if (!tail_sampler_->Decide(duration)) return;
+
+    if (const auto dropped = tail_sampler_->GetDroppedSpansCount()) {
+      if (!log_extra_local_) log_extra_local_.emplace();
+      log_extra_local_->Extend(std::string{kTailSamplingDroppedSpansTag},
+                               static_cast<std::uint64_t>(dropped));
+    }
+  }
+
   if (!ShouldLog()) {
     return;
   }
 
+  if (tail_sampler_ && !is_tail_sampling_root_ && tail_sampler_->IsPending()) {
+    std::move(*this).LogIntoTailSampler();
+    return;
+  }
+
   {
     const DetachLocalSpansScope ignore_local_span;
     logging::LogHelper lh{logging::GetDefaultLogger(), log_level_,
@@ -112,7 +227,8 @@ Span::Impl::~Impl() {
   }
 }
 
-void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer) && {
+void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer,
+                               bool log_opentracing) && {
   const auto steady_now = std::chrono::steady_clock::now();
   const auto duration = steady_now - start_steady_time_;
   const auto total_time_ms =
@@ -138,7 +254,38 @@ void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer) && {
   }
   writer.PutLogExtra(log_extra_inheritable_);
 
-  LogOpenTracing();
+  if (log_opentracing) LogOpenTracing();
+}
+
+void* Span::Impl::operator new(std::size_t size) {
+  UASSERT(size == sizeof(Span::Impl));
+  return GetLocalSpanImplPool().Allocate();
+}
+
+void Span::Impl::operator delete(void* ptr) noexcept {
+  GetLocalSpanImplPool().Deallocate(ptr);
+}
+
+void Span::Impl::MarkAsFailed() noexcept {
+  if (tail_sampler_) tail_sampler_->MarkAsFailed();
+}
+
+void Span::Impl::LogIntoTailSampler() && {
+  const DetachLocalSpansScope ignore_local_span;
+
+  auto opentracing_logger =
+      tracer_ ? tracer_->GetOptionalLogger() : logging::LoggerPtr{};
+  if (opentracing_logger) {
+    impl::TailSampler::Recorder recorder{*tail_sampler_,
+                                         std::move(opentracing_logger)};
+    logging::LogHelper lh(recorder, log_level_);
+    DoLogOpenTracing(lh.GetTagWriterAfterText({}));
+  }
+
+  impl::TailSampler::Recorder recorder{*tail_sampler_, nullptr};
+  logging::LogHelper lh{recorder, log_level_, source_location_};
+  std::move(*this).PutIntoLogger(lh.GetTagWriterAfterText({}),
+                                 /*log_opentracing=*/false);
 }
 
 void Span::Impl::LogTo(logging::impl::TagWriter writer) {
@@ -146,11 +293,21 @@ void Span::Impl::LogTo(logging::impl::TagWriter writer) {
   tracer_->LogSpanContextTo(*this, writer);
 }
 
-void Span::Impl::DetachFromCoroStack() { unlink(); }
+void Span::Impl::DetachFromCoroStack() {
+  unlink();
+  UpdateCpuProfilerSpans();
+}
 
 void Span::Impl::AttachToCoroStack() {
   UASSERT(!is_linked());
-  task_local_spans->push_back(*this);
+  auto& spans = *task_local_spans;
+  spans.push_back(*this);
+  UpdateCpuProfilerSpans();
+  if (&spans.front() == this) {
+    // names the task for the coroutine stack usage sampling
+    engine::current_task::GetCurrentTaskContext().SetStackUsageTaskKind(
+        name_);
+  }
 }
 
 std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
@@ -308,6 +465,7 @@ tracing::ScopeTime Span::CreateScopeTime(std::string name) {
 
 void Span::AddNonInheritableTag(std::string key,
                                 logging::LogExtra::Value value) {
+  if (key == kErrorFlag && IsTrue(value)) pimpl_->MarkAsFailed();
   if (!pimpl_->log_extra_local_) pimpl_->log_extra_local_.emplace();
   pimpl_->log_extra_local_->Extend(std::move(key), std::move(value));
 }
@@ -328,6 +486,7 @@ std::optional<logging::Level> Span::GetLocalLogLevel() const {
 }
 
 void Span::AddTag(std::string key, logging::LogExtra::Value value) {
+  if (key == kErrorFlag && IsTrue(value)) pimpl_->MarkAsFailed();
   pimpl_->log_extra_inheritable_.Extend(std::move(key), std::move(value));
 }
 
@@ -419,6 +578,7 @@ DetachLocalSpansScope::DetachLocalSpansScope() noexcept {
     if (auto* const spans_ptr = task_local_spans.GetOptional()) {
       old_spans_ = std::move(*spans_ptr);
       UASSERT(spans_ptr->empty());
+      UpdateCpuProfilerSpans();
     }
   }
 }
@@ -429,6 +589,7 @@ DetachLocalSpansScope::~DetachLocalSpansScope() {
               "A Span was constructed while in DetachLocalSpansScope");
   if (!old_spans_.empty()) {
     *task_local_spans = std::move(old_spans_);
+    UpdateCpuProfilerSpans();
   }
 }
 
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <list>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -18,6 +19,7 @@
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/impl/source_location.hpp>
 
+#include <tracing/tail_sampler.hpp>
 #include <tracing/time_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -45,34 +47,50 @@ class Span::Impl
 
   ~Impl();
 
+  // Span::Impl is allocated for every Span, so its memory is reused
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   impl::TimeStorage& GetTimeStorage() { return time_storage_; }
   const impl::TimeStorage& GetTimeStorage() const { return time_storage_; }
 
   // Log this Span specifically
-  void PutIntoLogger(logging::impl::TagWriter writer) &&;
+  void PutIntoLogger(logging::impl::TagWriter writer,
+                     bool log_opentracing = true) &&;
+
+  // Pass this finished Span to the exporter
+  void ExportTo(SpanExporter& exporter) const;
+
+  // Mark the trace as failed for the tail sampling
+  void MarkAsFailed() noexcept;
 
   // Add the context of this Span a non-Span-specific log record
   void LogTo(logging::impl::TagWriter writer);
 
-  const std::string& GetTraceId() const& noexcept { return trace_id_; }
+  const std::string& GetTraceId() const& noexcept { return *trace_id_; }
   const std::string& GetSpanId() const& noexcept { return span_id_; }
   const std::string& GetParentId() const& noexcept { return parent_id_; }
 
-  std::string GetTraceId() && noexcept { return std::move(trace_id_); }
+  std::string GetTraceId() && { return *trace_id_; }
   std::string GetSpanId() && noexcept { return std::move(span_id_); }
   std::string GetParentId() && noexcept { return std::move(parent_id_); }
 
-  void SetTraceId(std::string&& id) noexcept { trace_id_ = std::move(id); }
+  void SetTraceId(std::string&& id) {
+    trace_id_ = std::make_shared<const std::string>(std::move(id));
+  }
   void SetSpanId(std::string&& id) noexcept { span_id_ = std::move(id); }
   void SetParentId(std::string&& id) noexcept { parent_id_ = std::move(id); }
 
   ReferenceType GetReferenceType() const noexcept { return reference_type_; }
 
+  const std::string& GetName() const noexcept { return name_; }
+
   void DetachFromCoroStack();
   void AttachToCoroStack();
 
  private:
   void LogOpenTracing() const;
+  void LogIntoTailSampler() &&;
   void DoLogOpenTracing(logging::impl::TagWriter writer) const;
   static void AddOpentracingTags(formats::json::StringBuilder& output,
                                  const logging::LogExtra& input);
@@ -96,12 +114,17 @@ class Span::Impl
   const std::chrono::system_clock::time_point start_system_time_;
   const std::chrono::steady_clock::time_point start_steady_time_;
 
-  std::string trace_id_;
+  // Shared by the spans of a trace to avoid copying it into every child span
+  std::shared_ptr<const std::string> trace_id_;
   std::string span_id_;
   std::string parent_id_;
   const ReferenceType reference_type_;
   utils::impl::SourceLocation source_location_;
 
+  // Shared by all the spans of a trace if the tail sampling is enabled
+  std::shared_ptr<impl::TailSampler> tail_sampler_;
+  bool is_tail_sampling_root_{false};
+
   friend class Span;
   friend class SpanBuilder;
 };
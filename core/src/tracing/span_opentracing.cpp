@@ -1,10 +1,14 @@
 #include "span_impl.hpp"
 
+#include <chrono>
+#include <variant>
+
 #include <boost/container/small_vector.hpp>
 
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/log_extra.hpp>
+#include <userver/tracing/span_exporter.hpp>
 #include <userver/tracing/tags.hpp>
 #include <userver/utils/trivial_map.hpp>
 
@@ -104,7 +108,7 @@ void Span::Impl::DoLogOpenTracing(logging::impl::TagWriter writer) const {
   if (tracer_) {
     writer.PutTag(jaeger::kServiceName, tracer_->GetServiceName());
   }
-  writer.PutTag(jaeger::kTraceId, trace_id_);
+  writer.PutTag(jaeger::kTraceId, *trace_id_);
   writer.PutTag(jaeger::kParentId, parent_id_);
   writer.PutTag(jaeger::kSpanId, span_id_);
   writer.PutTag(jaeger::kStartTime, start_time);
@@ -135,6 +139,34 @@ void Span::Impl::AddOpentracingTags(formats::json::StringBuilder& output,
   }
 }
 
+void Span::Impl::ExportTo(SpanExporter& exporter) const {
+  ExportedSpan span;
+  span.name = name_;
+  span.trace_id = *trace_id_;
+  span.span_id = span_id_;
+  span.parent_id = parent_id_;
+  span.start_time = start_system_time_;
+  const auto duration = std::chrono::steady_clock::now() - start_steady_time_;
+  span.end_time =
+      start_system_time_ +
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(duration);
+
+  const auto add_attributes = [&span](const logging::LogExtra& log_extra) {
+    for (const auto& [key, value] : *log_extra.extra_) {
+      if (key == kErrorFlag) {
+        // `true` is stored as int in logging::LogExtra::Value
+        const auto* flag = std::get_if<int>(&value.GetValue());
+        if (flag && *flag != 0) span.is_failed = true;
+      }
+      span.attributes.emplace_back(key, value.GetValue());
+    }
+  };
+  add_attributes(log_extra_inheritable_);
+  if (log_extra_local_) add_attributes(*log_extra_local_);
+
+  exporter.Export(std::move(span));
+}
+
 }  // namespace tracing
 
 USERVER_NAMESPACE_END
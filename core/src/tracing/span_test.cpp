@@ -6,6 +6,7 @@
 #include <userver/engine/sleep.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utest/utest.hpp>
 #include <userver/utils/regex.hpp>
@@ -378,6 +379,65 @@ UTEST_F(Span, ConstructFromTracer) {
   EXPECT_EQ(tracing::Span::CurrentSpanUnchecked(), &span);
 }
 
+UTEST_F(Span, TailSamplingDrop) {
+  tracing::TailSamplingSettings settings;
+  settings.latency_threshold = std::chrono::hours{1};
+  settings.sample_rate = 0;
+  tracing::Tracer::SetTailSampling(settings);
+
+  {
+    tracing::Span root("tail_sampling_root");
+    tracing::Span child("tail_sampling_child");
+  }
+  logging::LogFlush();
+  EXPECT_EQ(GetStreamString().find("tail_sampling_"), std::string::npos);
+
+  tracing::Tracer::SetTailSampling(std::nullopt);
+}
+
+UTEST_F(Span, TailSamplingKeepFailed) {
+  tracing::TailSamplingSettings settings;
+  settings.max_spans = 1;
+  settings.latency_threshold = std::chrono::hours{1};
+  settings.sample_rate = 0;
+  tracing::Tracer::SetTailSampling(settings);
+
+  {
+    tracing::Span root("tail_sampling_root");
+    { tracing::Span child("tail_sampling_child"); }
+    { tracing::Span extra_child("tail_sampling_extra_child"); }
+    root.AddTag(tracing::kErrorFlag, true);
+  }
+  logging::LogFlush();
+
+  const auto logs = GetStreamString();
+  EXPECT_NE(logs.find("=tail_sampling_child"), std::string::npos);
+  EXPECT_NE(logs.find("=tail_sampling_root"), std::string::npos);
+  EXPECT_NE(logs.find("tail_sampling_dropped_spans=1"), std::string::npos);
+  EXPECT_EQ(logs.find("tail_sampling_extra_child"), std::string::npos);
+  EXPECT_LT(logs.find("tail_sampling_child"), logs.find("tail_sampling_root"));
+
+  tracing::Tracer::SetTailSampling(std::nullopt);
+}
+
+UTEST_F(Span, TailSamplingKeepSlow) {
+  tracing::TailSamplingSettings settings;
+  settings.latency_threshold = std::chrono::milliseconds{1};
+  settings.sample_rate = 0;
+  tracing::Tracer::SetTailSampling(settings);
+
+  {
+    tracing::Span root("tail_sampling_root");
+    tracing::Span child("tail_sampling_child");
+    engine::SleepFor(std::chrono::milliseconds{2});
+  }
+  logging::LogFlush();
+  EXPECT_NE(GetStreamString().find("=tail_sampling_child"), std::string::npos);
+  EXPECT_NE(GetStreamString().find("=tail_sampling_root"), std::string::npos);
+
+  tracing::Tracer::SetTailSampling(std::nullopt);
+}
+
 UTEST_F(Span, NoLogNames) {
   constexpr const char* kLogFirstSpan = "first_span_to_log";
   constexpr const char* kLogSecondSpan = "second_span_to_log";
@@ -0,0 +1,103 @@
+#include <tracing/tail_sampler.hpp>
+
+#include <random>
+#include <utility>
+
+#include <userver/logging/impl/tag_writer.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+logging::LoggerRef GetTargetLogger(const logging::LoggerPtr& logger) {
+  return logger ? *logger : logging::GetDefaultLogger();
+}
+
+}  // namespace
+
+TailSampler::TailSampler(const TailSamplingSettings& settings)
+    : settings_(settings) {}
+
+bool TailSampler::IsPending() const noexcept {
+  return decision_.load() == Decision::kPending;
+}
+
+void TailSampler::MarkAsFailed() noexcept { is_failed_.store(true); }
+
+bool TailSampler::Decide(std::chrono::steady_clock::duration root_duration) {
+  bool keep = is_failed_.load() || root_duration >= settings_.latency_threshold;
+  if (!keep) {
+    std::uniform_real_distribution<double> dist{0.0, 1.0};
+    keep = dist(utils::DefaultRandom()) < settings_.sample_rate;
+  }
+
+  std::vector<Record> records;
+  {
+    const std::lock_guard lock{mutex_};
+    decision_.store(keep ? Decision::kKeep : Decision::kDrop);
+    records = std::exchange(records_, {});
+  }
+
+  if (keep) {
+    for (const auto& record : records) Replay(record);
+  }
+  return keep;
+}
+
+std::size_t TailSampler::GetDroppedSpansCount() const {
+  const std::lock_guard lock{mutex_};
+  return dropped_spans_;
+}
+
+void TailSampler::Buffer(Record&& record) {
+  if (record.level >= logging::Level::kError) MarkAsFailed();
+
+  {
+    const std::lock_guard lock{mutex_};
+    switch (decision_.load()) {
+      case Decision::kPending:
+        if (records_.size() < settings_.max_spans) {
+          records_.push_back(std::move(record));
+        } else {
+          ++dropped_spans_;
+        }
+        return;
+      case Decision::kDrop:
+        return;
+      case Decision::kKeep:
+        break;
+    }
+  }
+
+  // The root span has already decided to keep the trace
+  Replay(record);
+}
+
+void TailSampler::Replay(const Record& record) {
+  GetTargetLogger(record.logger).Log(record.level, record.text);
+}
+
+TailSampler::Recorder::Recorder(TailSampler& sampler,
+                                logging::LoggerPtr target)
+    : LoggerBase(GetTargetLogger(target).GetFormat()),
+      sampler_(sampler),
+      target_(std::move(target)) {
+  SetLevel(logging::Level::kTrace);
+}
+
+void TailSampler::Recorder::Log(logging::Level level, std::string_view msg) {
+  sampler_.Buffer({target_, level, std::string{msg}});
+}
+
+void TailSampler::Recorder::PrependCommonTags(
+    logging::impl::TagWriter writer) const {
+  GetTargetLogger(target_).PrependCommonTags(writer);
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/logging/fwd.hpp>
+#include <userver/logging/impl/logger_base.hpp>
+#include <userver/logging/level.hpp>
+#include <userver/tracing/tracer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+/// Buffers the span records of a trace until its root span decides whether
+/// the whole trace is logged or dropped
+class TailSampler final {
+ public:
+  /// Captures the records of a span written via LogHelper into the sampler
+  class Recorder;
+
+  explicit TailSampler(const TailSamplingSettings& settings);
+
+  bool IsPending() const noexcept;
+
+  void MarkAsFailed() noexcept;
+
+  /// Decides on the trace once its root span ends, logs the buffered records
+  /// if the trace is kept. Returns whether the root span should be logged.
+  bool Decide(std::chrono::steady_clock::duration root_duration);
+
+  /// Number of span records dropped because of the max_spans limit
+  std::size_t GetDroppedSpansCount() const;
+
+ private:
+  enum class Decision { kPending, kKeep, kDrop };
+
+  struct Record final {
+    // nullptr for the default logger
+    logging::LoggerPtr logger;
+    logging::Level level;
+    std::string text;
+  };
+
+  void Buffer(Record&& record);
+  static void Replay(const Record& record);
+
+  const TailSamplingSettings settings_;
+  std::atomic<Decision> decision_{Decision::kPending};
+  std::atomic<bool> is_failed_{false};
+
+  mutable std::mutex mutex_;
+  std::vector<Record> records_;
+  std::size_t dropped_spans_{0};
+};
+
+class TailSampler::Recorder final : public logging::impl::LoggerBase {
+ public:
+  /// `target` is the logger to write the records to if the trace is kept,
+  /// nullptr for the default logger
+  Recorder(TailSampler& sampler, logging::LoggerPtr target);
+
+  void Log(logging::Level level, std::string_view msg) override;
+  void Flush() override {}
+  void PrependCommonTags(logging::impl::TagWriter writer) const override;
+
+ private:
+  TailSampler& sampler_;
+  const logging::LoggerPtr target_;
+};
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
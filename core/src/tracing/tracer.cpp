@@ -4,6 +4,7 @@
 
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/rcu/rcu.hpp>
+#include <userver/tracing/span_exporter.hpp>
 #include <userver/utils/uuid4.hpp>
 
 #include <tracing/no_log_spans.hpp>
@@ -40,6 +41,19 @@ auto& GlobalNoLogSpans() {
   return spans;
 }
 
+auto& GlobalTailSampling() {
+  static rcu::Variable<std::optional<TailSamplingSettings>> settings{};
+  return settings;
+}
+
+auto& GlobalSpanExporter() {
+  static rcu::Variable<std::shared_ptr<SpanExporter>> exporter{};
+  return exporter;
+}
+
+// Avoids reading the rcu::Variable for every span while there is no exporter
+std::atomic<bool> has_span_exporter{false};
+
 auto& GlobalTracer() {
   static rcu::Variable<TracerPtr> tracer(tracing::MakeTracer({}, {}));
   return tracer;
@@ -69,6 +83,8 @@ bool ValueMatchesOneOfPrefixes(const T& value,
 
 }  // namespace
 
+SpanExporter::~SpanExporter() = default;
+
 Tracer::~Tracer() = default;
 
 void Tracer::SetNoLogSpans(NoLogSpans&& spans) {
@@ -83,6 +99,29 @@ bool Tracer::IsNoLogSpan(const std::string& name) {
          spans->names.find(name) != spans->names.end();
 }
 
+void Tracer::SetTailSampling(std::optional<TailSamplingSettings> settings) {
+  if (settings) {
+    UINVARIANT(settings->max_spans > 0, "max_spans must be positive");
+    UINVARIANT(settings->sample_rate >= 0 && settings->sample_rate <= 1,
+               "sample_rate must be within [0, 1]");
+  }
+  GlobalTailSampling().Assign(std::move(settings));
+}
+
+std::optional<TailSamplingSettings> Tracer::GetTailSampling() {
+  return GlobalTailSampling().ReadCopy();
+}
+
+void Tracer::SetSpanExporter(std::shared_ptr<SpanExporter> exporter) {
+  has_span_exporter = static_cast<bool>(exporter);
+  GlobalSpanExporter().Assign(std::move(exporter));
+}
+
+std::shared_ptr<SpanExporter> Tracer::GetSpanExporter() {
+  if (!has_span_exporter) return {};
+  return GlobalSpanExporter().ReadCopy();
+}
+
 void Tracer::SetTracer(std::shared_ptr<Tracer> tracer) {
   GlobalTracer().Assign(std::move(tracer));
 }
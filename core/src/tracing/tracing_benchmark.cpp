@@ -18,6 +18,17 @@ void tracing_noop_ctr(benchmark::State& state) {
 }
 BENCHMARK(tracing_noop_ctr);
 
+void tracing_noop_child_ctr(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    auto tracer = tracing::MakeTracer("test_service", {});
+    const auto parent = tracer->CreateSpanWithoutParent("parent");
+
+    for ([[maybe_unused]] auto _ : state)
+      benchmark::DoNotOptimize(parent.CreateChild("name"));
+  });
+}
+BENCHMARK(tracing_noop_child_ctr);
+
 void tracing_happy_log(benchmark::State& state) {
   logging::DefaultLoggerGuard guard{logging::MakeNullLogger()};
 
@@ -1,5 +1,9 @@
 #include <utils/jemalloc.hpp>
 
+#include <sys/types.h>
+
+#include <fmt/format.h>
+
 #ifdef JEMALLOC_ENABLED
 #include <jemalloc/jemalloc.h>
 #else
@@ -31,11 +35,39 @@ std::error_code MallCtl(const char* name, T new_value) {
   return MakeErrorCode(rc);
 }
 
+template <typename T>
+std::error_code MallCtlRead(const char* name, T& value) {
+  std::size_t size = sizeof(value);
+  int rc = mallctl(name, &value, &size, nullptr, 0);
+  return MakeErrorCode(rc);
+}
+
+template <typename T>
+T* MallCtlPointer(const char* name) noexcept {
+  T* result = nullptr;
+  std::size_t size = sizeof(result);
+  if (mallctl(name, &result, &size, nullptr, 0) != 0) return nullptr;
+  return result;
+}
+
 std::error_code MallCtl(const char* name) {
   int rc = mallctl(name, nullptr, nullptr, nullptr, 0);
   return MakeErrorCode(rc);
 }
 
+// MALLCTL_ARENAS_ALL, the pseudo-index of all the arenas
+constexpr unsigned kAllArenas = 4096;
+
+std::error_code SetDecay(std::string_view option,
+                         std::chrono::milliseconds decay) {
+  const auto decay_ms = static_cast<ssize_t>(decay.count());
+  const auto new_arenas_ec =
+      MallCtl<ssize_t>(fmt::format("arenas.{}", option).c_str(), decay_ms);
+  if (new_arenas_ec) return new_arenas_ec;
+  return MallCtl<ssize_t>(
+      fmt::format("arena.{}.{}", kAllArenas, option).c_str(), decay_ms);
+}
+
 void MallocStatPrintCb(void* data, const char* msg) {
   auto* s = static_cast<std::string*>(data);
   *s += msg;
@@ -68,6 +100,59 @@ std::error_code StopBgThreads() {
   return MallCtl<bool>("background_thread", false);
 }
 
+ThreadAllocCounters GetThreadAllocCounters() noexcept {
+  thread_local const ThreadAllocCounters counters{
+      MallCtlPointer<std::uint64_t>("thread.allocatedp"),
+      MallCtlPointer<std::uint64_t>("thread.deallocatedp"),
+  };
+  return counters;
+}
+
+std::optional<unsigned> CreateArena() {
+  unsigned arena = 0;
+  if (MallCtlRead("arenas.create", arena)) return std::nullopt;
+  return arena;
+}
+
+std::error_code BindThreadToArena(unsigned arena) {
+  return MallCtl<unsigned>("thread.arena", arena);
+}
+
+std::error_code SetDirtyDecay(std::chrono::milliseconds decay) {
+  return SetDecay("dirty_decay_ms", decay);
+}
+
+std::error_code SetMuzzyDecay(std::chrono::milliseconds decay) {
+  return SetDecay("muzzy_decay_ms", decay);
+}
+
+std::error_code RefreshStats() { return MallCtl<std::uint64_t>("epoch", 1); }
+
+std::optional<ArenaStats> GetArenaStats(unsigned arena) {
+  std::size_t page_size = 0;
+  if (MallCtlRead("arenas.page", page_size)) return std::nullopt;
+
+  const auto read_pages = [arena](std::string_view name,
+                                  std::uint64_t& bytes) {
+    std::size_t pages = 0;
+    const auto ec = MallCtlRead(
+        fmt::format("stats.arenas.{}.{}", arena, name).c_str(), pages);
+    bytes = pages;
+    return !ec;
+  };
+
+  ArenaStats stats;
+  if (!read_pages("pactive", stats.active_bytes) ||
+      !read_pages("pdirty", stats.dirty_bytes) ||
+      !read_pages("pmuzzy", stats.muzzy_bytes)) {
+    return std::nullopt;
+  }
+  stats.active_bytes *= page_size;
+  stats.dirty_bytes *= page_size;
+  stats.muzzy_bytes *= page_size;
+  return stats;
+}
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
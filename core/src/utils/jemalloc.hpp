@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <system_error>
 
@@ -22,6 +25,40 @@ std::error_code EnableBgThreads();
 // blocking
 std::error_code StopBgThreads();
 
+/// Monotonic counters of the bytes allocated and freed by the current thread
+struct ThreadAllocCounters {
+  // both are nullptr without jemalloc
+  const std::uint64_t* allocated{nullptr};
+  const std::uint64_t* deallocated{nullptr};
+};
+
+/// Cached per thread, cheap to call on each context switch
+ThreadAllocCounters GetThreadAllocCounters() noexcept;
+
+/// Creates a new arena, std::nullopt without jemalloc
+std::optional<unsigned> CreateArena();
+
+/// Makes the current thread allocate from the arena
+std::error_code BindThreadToArena(unsigned arena);
+
+/// Sets the time after which the unused dirty (`dirty_decay_ms`) or muzzy
+/// (`muzzy_decay_ms`) pages are purged, for all the existing arenas and for
+/// the ones created later. -1 disables the purging, 0 purges immediately.
+std::error_code SetDirtyDecay(std::chrono::milliseconds decay);
+std::error_code SetMuzzyDecay(std::chrono::milliseconds decay);
+
+/// Refreshes the statistics returned by GetArenaStats
+std::error_code RefreshStats();
+
+struct ArenaStats {
+  std::uint64_t active_bytes{0};
+  std::uint64_t dirty_bytes{0};
+  std::uint64_t muzzy_bytes{0};
+};
+
+/// std::nullopt without jemalloc or if jemalloc is built without statistics
+std::optional<ArenaStats> GetArenaStats(unsigned arena);
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
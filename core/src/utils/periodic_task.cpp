@@ -1,15 +1,18 @@
 #include <userver/utils/periodic_task.hpp>
 
+#include <algorithm>
 #include <random>
 
 #include <fmt/format.h>
 
+#include <engine/task/task_processor.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 #include <userver/compiler/impl/tls.hpp>
 
@@ -28,6 +31,9 @@ std::minstd_rand& GetFastRandomBitsGenerator() {
   return rand;
 }
 
+// How often the overload is rechecked while an iteration is postponed
+constexpr std::chrono::milliseconds kOverloadRecheckInterval{50};
+
 }  // namespace
 
 PeriodicTask::PeriodicTask()
@@ -129,6 +135,7 @@ bool PeriodicTask::IsRunning() const { return task_.IsValid(); }
 
 void PeriodicTask::Run() {
   bool skip_step = false;
+  bool is_first_wait = true;
   {
     auto settings = settings_.Read();
     if (!(settings->flags & Flags::kNow)) {
@@ -137,10 +144,13 @@ void PeriodicTask::Run() {
   }
 
   while (!engine::current_task::ShouldCancel()) {
+    const bool should_step = !std::exchange(skip_step, false);
+    if (should_step) DeferOnOverload();
+
     const auto before = std::chrono::steady_clock::now();
     bool no_exception = true;
 
-    if (!std::exchange(skip_step, false)) {
+    if (should_step) {
       no_exception = Step();
     }
 
@@ -157,8 +167,12 @@ void PeriodicTask::Run() {
       start = std::chrono::steady_clock::now();
     }
 
-    while (changed_event_.WaitForEventUntil(start + MutatePeriod(period))) {
+    const bool spread = std::exchange(is_first_wait, false);
+    auto wakeup = MakeWakeupTime(start, period, spread);
+    bool is_forced = false;
+    while (changed_event_.WaitForEventUntil(wakeup)) {
       if (should_force_step_.exchange(false)) {
+        is_forced = true;
         break;
       }
       // The config variable value has been changed, reload
@@ -166,6 +180,73 @@ void PeriodicTask::Run() {
       period = settings->period;
       const auto exception_period = settings->exception_period.value_or(period);
       if (!no_exception) period = exception_period;
+      wakeup = MakeWakeupTime(start, period, spread);
+    }
+
+    if (!is_forced && !engine::current_task::ShouldCancel()) {
+      AccountWakeupLag(wakeup);
+    }
+  }
+}
+
+std::chrono::steady_clock::time_point PeriodicTask::MakeWakeupTime(
+    std::chrono::steady_clock::time_point start,
+    std::chrono::milliseconds period, bool is_first_wait) {
+  const auto settings = settings_.Read();
+
+  auto wait = MutatePeriod(period);
+  if (is_first_wait && (settings->flags & Flags::kSpread) &&
+      wait.count() > 0) {
+    wait = std::chrono::milliseconds{std::uniform_int_distribution<int64_t>(
+        0, wait.count())(GetFastRandomBitsGenerator())};
+  }
+
+  const auto wakeup = start + wait;
+  const auto quantum =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          settings->wakeup_quantum);
+  if (quantum.count() <= 0) return wakeup;
+
+  // Aligned to the clock rather than to the start, so that all the tasks
+  // share the same grid of wakeup times
+  const auto remainder = wakeup.time_since_epoch() % quantum;
+  if (remainder.count() == 0) return wakeup;
+  return wakeup + (quantum - remainder);
+}
+
+void PeriodicTask::AccountWakeupLag(
+    std::chrono::steady_clock::time_point planned) {
+  const auto lag = std::max(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - planned),
+      std::chrono::microseconds{0});
+
+  steps_.fetch_add(1, std::memory_order_relaxed);
+  last_lag_.store(lag, std::memory_order_relaxed);
+  auto max_lag = max_lag_.load(std::memory_order_relaxed);
+  while (max_lag < lag && !max_lag_.compare_exchange_weak(
+                              max_lag, lag, std::memory_order_relaxed)) {
+  }
+}
+
+void PeriodicTask::DeferOnOverload() {
+  const auto max_deferral = settings_.Read()->max_overload_deferral;
+  if (max_deferral.count() <= 0) return;
+
+  const auto& task_processor = engine::current_task::GetTaskProcessor();
+  if (!task_processor.IsTaskQueueWaitTimeOverloaded()) return;
+
+  deferred_steps_.fetch_add(1, std::memory_order_relaxed);
+  const auto deadline = std::chrono::steady_clock::now() + max_deferral;
+  while (task_processor.IsTaskQueueWaitTimeOverloaded() &&
+         !engine::current_task::ShouldCancel()) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) break;
+
+    const auto recheck = std::min(deadline, now + kOverloadRecheckInterval);
+    if (changed_event_.WaitForEventUntil(recheck) &&
+        should_force_step_.exchange(false)) {
+      break;
     }
   }
 }
@@ -250,6 +331,23 @@ PeriodicTask::Settings PeriodicTask::GetCurrentSettings() const {
   return *settings_ptr;
 }
 
+PeriodicTask::Statistics PeriodicTask::GetStatistics() const {
+  Statistics stats;
+  stats.steps = steps_.load(std::memory_order_relaxed);
+  stats.deferred_steps = deferred_steps_.load(std::memory_order_relaxed);
+  stats.last_lag = last_lag_.load(std::memory_order_relaxed);
+  stats.max_lag = max_lag_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void DumpMetric(statistics::Writer& writer,
+                const PeriodicTask::Statistics& stats) {
+  writer["steps"] = stats.steps;
+  writer["deferred-steps"] = stats.deferred_steps;
+  writer["last-lag-us"] = stats.last_lag.count();
+  writer["max-lag-us"] = stats.max_lag.count();
+}
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
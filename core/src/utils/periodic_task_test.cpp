@@ -1,5 +1,8 @@
 #include <userver/utest/utest.hpp>
 
+#include <memory>
+#include <vector>
+
 #include <boost/algorithm/string/split.hpp>
 
 #include <logging/logging_test.hpp>
@@ -340,6 +343,65 @@ UTEST(PeriodicTask, ForceStepAsyncPeriod) {
   task.Stop();
 }
 
+UTEST(PeriodicTask, Spread) {
+  SimpleTaskData simple;
+
+  // With a period this long the first iteration is only expected because of
+  // the spread, it happens after a random part of the period
+  constexpr auto period = 100ms;
+  constexpr Count n = 20;
+  std::vector<std::unique_ptr<utils::PeriodicTask>> tasks;
+  for (Count i = 0; i < n; ++i) {
+    tasks.push_back(std::make_unique<utils::PeriodicTask>(
+        "task",
+        utils::PeriodicTask::Settings(period,
+                                      utils::PeriodicTask::Flags::kSpread),
+        simple.GetTaskFunction()));
+  }
+
+  EXPECT_TRUE(simple.WaitFor(utest::kMaxTestWaitTime,
+                             [&simple]() { return simple.GetCount() > 0; }));
+  // Not all of the tasks are due at the start of the period
+  EXPECT_LT(simple.GetCount(), n);
+  for (auto& task : tasks) task->Stop();
+}
+
+UTEST(PeriodicTask, WakeupQuantum) {
+  SimpleTaskData simple;
+
+  constexpr auto period = 3ms;
+  constexpr Count n = 5;
+  utils::PeriodicTask::Settings settings(period);
+  settings.wakeup_quantum = 20ms;
+
+  const auto start = std::chrono::steady_clock::now();
+  utils::PeriodicTask task("task", settings, simple.GetTaskFunction());
+  EXPECT_TRUE(simple.WaitFor(settings.wakeup_quantum * n * kSlowRatio,
+                             [&simple]() { return simple.GetCount() >= n; }));
+  const auto finish = std::chrono::steady_clock::now();
+
+  // Each wakeup is moved to the next multiple of the quantum
+  EXPECT_GE(finish - start, settings.wakeup_quantum * (n - 1));
+
+  task.Stop();
+}
+
+UTEST(PeriodicTask, Statistics) {
+  SimpleTaskData simple;
+
+  constexpr auto period = 3ms;
+  constexpr Count n = 5;
+  utils::PeriodicTask task("task", period, simple.GetTaskFunction());
+  EXPECT_TRUE(simple.WaitFor(period * n * kSlowRatio,
+                             [&simple]() { return simple.GetCount() >= n; }));
+  task.Stop();
+
+  const auto stats = task.GetStatistics();
+  EXPECT_GE(stats.steps, n);
+  EXPECT_EQ(stats.deferred_steps, 0U);
+  EXPECT_LE(stats.last_lag, stats.max_lag);
+}
+
 UTEST(PeriodicTask, StopStop) {
   SimpleTaskData simple;
 
@@ -1,10 +1,15 @@
 #include <userver/utils/statistics/histogram.hpp>
 
+#include <vector>
+
 #include <benchmark/benchmark.h>
 #include <boost/range/irange.hpp>
 
 #include <userver/utils/algo.hpp>
 #include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/sharded_histogram.hpp>
+#include <userver/utils/statistics/sharded_rate_counter.hpp>
 #include <utils/gbench_auxilary.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -35,4 +40,62 @@ void HistogramAccount(benchmark::State& state) {
 // poorly (fixed).
 BENCHMARK(HistogramAccount)->DenseRange(10, 50, 10);
 
+namespace {
+
+const std::vector<double> kConcurrentBounds{1, 2, 5, 10, 20, 50, 100, 200};
+
+template <typename HistogramType>
+HistogramType& GetSharedHistogram() {
+  static HistogramType histogram{kConcurrentBounds};
+  return histogram;
+}
+
+template <typename CounterType>
+CounterType& GetSharedCounter() {
+  static CounterType counter;
+  return counter;
+}
+
+}  // namespace
+
+// Measures the contention of the accounts from many threads
+template <typename HistogramType>
+void HistogramAccountConcurrent(benchmark::State& state) {
+  auto& histogram = GetSharedHistogram<HistogramType>();
+  auto values_raw = std::vector<double>(1024);
+  for (auto& value : values_raw) {
+    value = utils::RandRange(0.0, 100.0);
+  }
+  const auto values = Launder(std::move(values_raw));
+
+  while (state.KeepRunningBatch(values.size())) {
+    for (const auto value : values) {
+      histogram.Account(value);
+    }
+  }
+}
+BENCHMARK_TEMPLATE(HistogramAccountConcurrent, utils::statistics::Histogram)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(HistogramAccountConcurrent,
+                   utils::statistics::ShardedHistogram)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+template <typename CounterType>
+void RateCounterIncrementConcurrent(benchmark::State& state) {
+  auto& counter = GetSharedCounter<CounterType>();
+  for ([[maybe_unused]] auto _ : state) {
+    ++counter;
+  }
+}
+BENCHMARK_TEMPLATE(RateCounterIncrementConcurrent,
+                   utils::statistics::RateCounter)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(RateCounterIncrementConcurrent,
+                   utils::statistics::ShardedRateCounter)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
 USERVER_NAMESPACE_END
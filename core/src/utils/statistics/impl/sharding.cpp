@@ -0,0 +1,37 @@
+#include <userver/utils/statistics/impl/sharding.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+std::size_t GetShardCount() noexcept {
+  static const std::size_t kShardCount =
+      std::max(std::thread::hardware_concurrency(), 1U);
+  return kShardCount;
+}
+
+std::size_t GetCurrentShard() noexcept {
+#ifdef __linux__
+  // vDSO on most platforms, does not enter the kernel
+  const int cpu = sched_getcpu();
+  if (cpu >= 0) return static_cast<std::size_t>(cpu) % GetShardCount();
+#endif
+
+  // Fallback: spread the threads over the shards in round-robin
+  static std::atomic<std::size_t> next_shard{0};
+  thread_local const std::size_t thread_shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) % GetShardCount();
+  return thread_shard;
+}
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,50 @@
+#include <userver/utils/statistics/latency_estimate.hpp>
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(LatencyEstimate, Empty) {
+  const utils::statistics::LatencyEstimate estimate;
+  EXPECT_EQ(estimate.GetSamplesCount(), 0);
+  EXPECT_EQ(estimate.GetP50(), 0us);
+  EXPECT_EQ(estimate.GetP90(), 0us);
+}
+
+TEST(LatencyEstimate, Constant) {
+  utils::statistics::LatencyEstimate estimate;
+  for (int i = 0; i < 100; ++i) estimate.Account(5ms);
+  EXPECT_EQ(estimate.GetSamplesCount(), 100);
+  EXPECT_EQ(estimate.GetP50(), 5ms);
+  EXPECT_EQ(estimate.GetP90(), 5ms);
+}
+
+TEST(LatencyEstimate, Quantiles) {
+  utils::statistics::LatencyEstimate estimate;
+  // NOLINTNEXTLINE(cert-msc32-c,cert-msc51-cpp)
+  std::minstd_rand rng;
+  std::uniform_int_distribution<int> distribution(1, 100'000);
+  for (int i = 0; i < 100'000; ++i) {
+    estimate.Account(std::chrono::microseconds{distribution(rng)});
+  }
+
+  EXPECT_NEAR(estimate.GetP50().count(), 50'000, 10'000);
+  EXPECT_NEAR(estimate.GetP90().count(), 90'000, 10'000);
+}
+
+TEST(LatencyEstimate, Adapts) {
+  utils::statistics::LatencyEstimate estimate;
+  for (int i = 0; i < 1000; ++i) estimate.Account(1ms);
+  for (int i = 0; i < 1000; ++i) estimate.Account(100ms);
+  EXPECT_GT(estimate.GetP50(), 90ms);
+
+  // The 90th percentile goes down slower, 1/10 of the samples may be slow
+  for (int i = 0; i < 3000; ++i) estimate.Account(1ms);
+  EXPECT_LT(estimate.GetP90(), 2ms);
+}
+
+USERVER_NAMESPACE_END
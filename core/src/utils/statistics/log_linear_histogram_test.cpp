@@ -0,0 +1,89 @@
+#include <userver/utils/statistics/log_linear_histogram.hpp>
+
+#include <fmt/format.h>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/fmt.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using SmallHistogram = utils::statistics::LogLinearHistogram<2, 6>;
+
+}  // namespace
+
+UTEST(StatisticsLogLinearHistogram, PreciseValues) {
+  utils::statistics::LogLinearHistogram<> histogram;
+  for (std::uint64_t i = 0; i < 64; ++i) histogram.Account(i);
+
+  EXPECT_EQ(histogram.Count(), 64);
+  EXPECT_EQ(histogram.GetPercentile(0), 0);
+  EXPECT_EQ(histogram.GetPercentile(50), 32);
+  EXPECT_EQ(histogram.GetPercentile(100), 63);
+}
+
+UTEST(StatisticsLogLinearHistogram, RelativeError) {
+  utils::statistics::LogLinearHistogram<> histogram;
+  for (const std::uint64_t value :
+       {std::uint64_t{100}, std::uint64_t{12'345}, std::uint64_t{1'000'000},
+        std::uint64_t{3'000'000'000}}) {
+    histogram.Reset();
+    histogram.Account(value);
+    const auto stored = histogram.GetPercentile(50);
+    EXPECT_GE(stored, value);
+    EXPECT_LE(stored - value, value / 32) << value;
+  }
+}
+
+UTEST(StatisticsLogLinearHistogram, Overflow) {
+  SmallHistogram histogram;
+  histogram.Account(1'000'000, 2);
+  EXPECT_EQ(histogram.Count(), 2);
+  EXPECT_EQ(histogram.GetPercentile(100), SmallHistogram::kMaxValue);
+}
+
+UTEST(StatisticsLogLinearHistogram, Add) {
+  SmallHistogram histogram1;
+  histogram1.Account(1);
+  histogram1.Account(20);
+
+  SmallHistogram histogram2;
+  histogram2.Account(20);
+  histogram2.Account(40, 2);
+
+  histogram1.Add(histogram2);
+  EXPECT_EQ(histogram1.Count(), 5);
+  EXPECT_EQ(histogram1.GetPercentile(50), 23);
+  EXPECT_EQ(histogram1.GetPercentile(100), 47);
+}
+
+UTEST(StatisticsLogLinearHistogram, RecentPeriod) {
+  utils::statistics::RecentPeriod<SmallHistogram, SmallHistogram> timings;
+  timings.GetCurrentCounter().Account(5);
+  timings.GetCurrentCounter().Account(50);
+
+  const auto stats = timings.GetStatsForPeriod();
+  EXPECT_EQ(stats.Count(), 2);
+}
+
+UTEST(StatisticsLogLinearHistogram, DumpMetric) {
+  utils::statistics::Storage storage;
+  SmallHistogram histogram;
+  histogram.Account(3);
+  histogram.Account(9);
+  histogram.Account(20, 2);
+  histogram.Account(100);
+
+  const auto statistics_holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+  EXPECT_EQ(fmt::to_string(
+                utils::statistics::Snapshot{storage}.SingleMetric("test")),
+            "[7]=1,[15]=1,[31]=2,[63]=1,[inf]=0");
+}
+
+USERVER_NAMESPACE_END
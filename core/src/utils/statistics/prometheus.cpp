@@ -1,9 +1,12 @@
 #include <userver/utils/statistics/prometheus.hpp>
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
 #include <unordered_map>
 
+#include <boost/container_hash/hash.hpp>
+
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
@@ -16,94 +19,274 @@ USERVER_NAMESPACE_BEGIN
 
 namespace utils::statistics {
 
+struct PrometheusFormatCache::Impl final {
+  struct Series final {
+    // label names and values, each followed by '\0'
+    std::string raw_labels;
+    // 'name1="value1",name2="value2"'
+    std::string rendered_labels;
+    std::uint64_t last_output{0};
+  };
+
+  struct Metric final {
+    std::string prometheus_name;
+    // the output the '# TYPE' line was last written in
+    std::uint64_t type_output{0};
+    // by the hash of the labels
+    std::unordered_map<std::size_t, Series> series;
+  };
+
+  void StartOutput() noexcept {
+    ++output;
+    used_series_count = 0;
+  }
+
+  // Evicts the series that were not output the last time, once there are
+  // too many of them
+  void FinishOutput() {
+    if (series_count <= 2 * used_series_count + kMinEvictedSeries) return;
+
+    for (auto it = metrics.begin(); it != metrics.end();) {
+      auto& series = it->second.series;
+      for (auto series_it = series.begin(); series_it != series.end();) {
+        if (series_it->second.last_output != output) {
+          series_it = series.erase(series_it);
+          --series_count;
+        } else {
+          ++series_it;
+        }
+      }
+      it = series.empty() ? metrics.erase(it) : std::next(it);
+    }
+  }
+
+  static constexpr std::size_t kMinEvictedSeries = 1024;
+
+  utils::impl::TransparentMap<std::string, Metric> metrics;
+  std::uint64_t output{0};
+  std::size_t series_count{0};
+  std::size_t used_series_count{0};
+};
+
+PrometheusFormatCache::PrometheusFormatCache()
+    : impl_(std::make_unique<Impl>()) {}
+
+PrometheusFormatCache::PrometheusFormatCache(PrometheusFormatCache&&) noexcept =
+    default;
+
+PrometheusFormatCache& PrometheusFormatCache::operator=(
+    PrometheusFormatCache&&) noexcept = default;
+
+PrometheusFormatCache::~PrometheusFormatCache() = default;
+
 namespace impl {
 
 namespace {
 
 enum class Typed { kYes, kNo };
 
+// Outputs are passed to the consumer in chunks of about this size
+constexpr std::size_t kChunkSize = 64 * 1024;
+
+using ChunkConsumer = utils::function_ref<void(std::string&& chunk)>;
+
+void RenderLabel(const utils::statistics::LabelView& label, std::string& out) {
+  out += impl::ToPrometheusLabel(label.Name());
+  out += "=\"";
+  const auto& value = label.Value();
+  std::replace_copy(value.cbegin(), value.cend(), std::back_inserter(out), '"',
+                    '\'');
+  out.push_back('"');
+}
+
+void RenderLabels(utils::statistics::LabelsSpan labels, std::string& out) {
+  bool sep = false;
+  for (const auto& label : labels) {
+    if (sep) {
+      out.push_back(',');
+    }
+    RenderLabel(label, out);
+    sep = true;
+  }
+}
+
+std::size_t HashLabels(utils::statistics::LabelsSpan labels) noexcept {
+  std::size_t seed = 0;
+  for (const auto& label : labels) {
+    boost::hash_combine(seed, std::hash<std::string_view>{}(label.Name()));
+    boost::hash_combine(seed, std::hash<std::string_view>{}(label.Value()));
+  }
+  return seed;
+}
+
+void AppendRawLabels(utils::statistics::LabelsSpan labels, std::string& out) {
+  for (const auto& label : labels) {
+    out.append(label.Name()).push_back('\0');
+    out.append(label.Value()).push_back('\0');
+  }
+}
+
+bool RawLabelsEqual(std::string_view raw,
+                    utils::statistics::LabelsSpan labels) noexcept {
+  const auto consume = [&raw](std::string_view part) {
+    if (raw.size() <= part.size() || raw.substr(0, part.size()) != part ||
+        raw[part.size()] != '\0') {
+      return false;
+    }
+    raw.remove_prefix(part.size() + 1);
+    return true;
+  };
+  for (const auto& label : labels) {
+    if (!consume(label.Name()) || !consume(label.Value())) return false;
+  }
+  return raw.empty();
+}
+
 template <Typed IsTyped>
 class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
  public:
-  explicit FormatBuilder() = default;
+  FormatBuilder(PrometheusFormatCache::Impl& cache, ChunkConsumer consumer)
+      : cache_(cache), consumer_(consumer) {
+    cache_.StartOutput();
+  }
 
   void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels,
                     const MetricValue& value) override {
+    auto& metric = GetMetric(path);
+    if (metric.type_output != cache_.output) {
+      metric.type_output = cache_.output;
+      DumpMetricType(metric.prometheus_name, value);
+    }
+
+    const auto rendered_labels = GetRenderedLabels(metric, labels);
     if (value.IsHistogram()) {
-      // TODO support histogram metrics using 'le', or better yet,
-      //  using Prometheus native histograms.
-      UASSERT_MSG(false,
-                  "Histogram metrics are not supported for Prometheus yet");
-      return;
+      DumpHistogram(metric.prometheus_name, rendered_labels,
+                    value.AsHistogram());
+    } else {
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}{{{}}} {}\n"),
+                     metric.prometheus_name, rendered_labels, value);
     }
-    DumpMetricNameAndType(path, value);
-    DumpLabels(labels);
-    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), value);
+
+    if (buf_.size() >= kChunkSize) Flush();
   }
 
-  std::string Release() { return fmt::to_string(buf_); }
+  void Finish() {
+    Flush();
+    cache_.FinishOutput();
+  }
 
  private:
-  void DumpMetricNameAndType(std::string_view name, const MetricValue& value) {
-    if (const auto* const converted =
-            utils::impl::FindTransparentOrNullptr(metrics_, name)) {
-      buf_.append(*converted);
-      return;
+  PrometheusFormatCache::Impl::Metric& GetMetric(std::string_view path) {
+    if (auto* const metric =
+            utils::impl::FindTransparentOrNullptr(cache_.metrics, path)) {
+      return *metric;
     }
 
-    auto prometheus_name = impl::ToPrometheusName(name);
-    DumpMetricType(prometheus_name, value);
-    buf_.append(prometheus_name);
-    metrics_.emplace(name, std::move(prometheus_name));
-  }
-
-  void DumpMetricType([[maybe_unused]] std::string_view prometheus_name,
-                      [[maybe_unused]] const MetricValue& value) {
-    if constexpr (IsTyped == Typed::kNo) {
-      const bool should_skip = value.Visit(utils::Overloaded{
-          [](std::int64_t) { return true; },
-          [](double) { return true; },
-          [](Rate) { return false; },
-          [](HistogramView) { return false; },
-      });
-      if (should_skip) return;
+    PrometheusFormatCache::Impl::Metric metric;
+    metric.prometheus_name = impl::ToPrometheusName(path);
+    return cache_.metrics.emplace(std::string{path}, std::move(metric))
+        .first->second;
+  }
+
+  std::string_view GetRenderedLabels(
+      PrometheusFormatCache::Impl::Metric& metric,
+      utils::statistics::LabelsSpan labels) {
+    auto [it, inserted] = metric.series.try_emplace(HashLabels(labels));
+    auto& series = it->second;
+    if (inserted) {
+      AppendRawLabels(labels, series.raw_labels);
+      RenderLabels(labels, series.rendered_labels);
+      ++cache_.series_count;
+    } else if (!RawLabelsEqual(series.raw_labels, labels)) {
+      // hash collision, the first series stays cached
+      scratch_.clear();
+      RenderLabels(labels, scratch_);
+      return scratch_;
     }
 
+    if (series.last_output != cache_.output) {
+      series.last_output = cache_.output;
+      ++cache_.used_series_count;
+    }
+    return series.rendered_labels;
+  }
+
+  void DumpMetricType(std::string_view prometheus_name,
+                      const MetricValue& value) {
+    // An empty type means no '# TYPE' line
     const auto type = value.Visit(utils::Overloaded{
-        [](std::int64_t) -> std::string_view { return "gauge"; },
-        [](double) -> std::string_view { return "gauge"; },
-        [](Rate) -> std::string_view { return "counter"; },
-        [](HistogramView) -> std::string_view {
-          UINVARIANT(false,
-                     "Histogram metrics are not supported for Prometheus yet");
+        [](std::int64_t) -> std::string_view {
+          return IsTyped == Typed::kNo ? "" : "gauge";
+        },
+        [](double) -> std::string_view {
+          return IsTyped == Typed::kNo ? "" : "gauge";
         },
+        [](Rate) -> std::string_view { return "counter"; },
+        // A Prometheus histogram requires the '_sum' series, which is not
+        // collected, so the '_bucket' and '_count' series stay untyped
+        [](HistogramView) -> std::string_view { return ""; },
     });
+    if (type.empty()) return;
+
     fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("# TYPE {} {}\n"),
                    prometheus_name, type);
   }
 
-  void DumpLabels(utils::statistics::LabelsSpan labels) {
-    buf_.push_back('{');
-    bool sep = false;
-    for (const auto& label : labels) {
-      if (sep) {
-        buf_.push_back(',');
-      }
-      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}=\""),
-                     impl::ToPrometheusLabel(label.Name()));
-      const auto& value = label.Value();
-      std::replace_copy(value.cbegin(), value.cend(), std::back_inserter(buf_),
-                        '"', '\'');
-      buf_.push_back('"');
-      sep = true;
+  // Prometheus buckets are cumulative and end with the mandatory '+Inf' one
+  void DumpHistogram(std::string_view prometheus_name,
+                     std::string_view rendered_labels,
+                     HistogramView histogram) {
+    const std::string_view sep = rendered_labels.empty() ? "" : ",";
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < histogram.GetBucketCount(); ++i) {
+      total += histogram.GetValueAt(i);
+      fmt::format_to(std::back_inserter(buf_),
+                     FMT_COMPILE("{}_bucket{{{}{}le=\"{}\"}} {}\n"),
+                     prometheus_name, rendered_labels, sep,
+                     histogram.GetUpperBoundAt(i), total);
     }
-    buf_.push_back('}');
+
+    total += histogram.GetValueAtInf();
+    fmt::format_to(std::back_inserter(buf_),
+                   FMT_COMPILE("{}_bucket{{{}{}le=\"+Inf\"}} {}\n"),
+                   prometheus_name, rendered_labels, sep, total);
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}_count{{{}}} {}\n"),
+                   prometheus_name, rendered_labels, total);
   }
 
+  void Flush() {
+    if (buf_.size() == 0) return;
+    consumer_(fmt::to_string(buf_));
+    buf_.clear();
+  }
+
+  PrometheusFormatCache::Impl& cache_;
+  ChunkConsumer consumer_;
   fmt::memory_buffer buf_;
-  utils::impl::TransparentMap<std::string, std::string> metrics_;
+  std::string scratch_;
 };
 
+template <Typed IsTyped>
+void FormatPrometheus(const utils::statistics::Storage& statistics,
+                      const utils::statistics::Request& request,
+                      PrometheusFormatCache::Impl& cache,
+                      ChunkConsumer consumer) {
+  FormatBuilder<IsTyped> builder{cache, consumer};
+  statistics.VisitMetrics(builder, request);
+  builder.Finish();
+}
+
+template <Typed IsTyped>
+std::string FormatPrometheus(const utils::statistics::Storage& statistics,
+                             const utils::statistics::Request& request) {
+  PrometheusFormatCache::Impl cache;
+  std::string result;
+  FormatPrometheus<IsTyped>(
+      statistics, request, cache,
+      [&result](std::string&& chunk) { result.append(chunk); });
+  return result;
+}
+
 }  // namespace
 
 std::string ToPrometheusName(std::string_view data) {
@@ -140,17 +323,29 @@ std::string ToPrometheusLabel(std::string_view name) {
 
 std::string ToPrometheusFormat(const utils::statistics::Storage& statistics,
                                const utils::statistics::Request& request) {
-  impl::FormatBuilder<impl::Typed::kYes> builder{};
-  statistics.VisitMetrics(builder, request);
-  return builder.Release();
+  return impl::FormatPrometheus<impl::Typed::kYes>(statistics, request);
 }
 
 std::string ToPrometheusFormatUntyped(
     const utils::statistics::Storage& statistics,
     const utils::statistics::Request& request) {
-  impl::FormatBuilder<impl::Typed::kNo> builder{};
-  statistics.VisitMetrics(builder, request);
-  return builder.Release();
+  return impl::FormatPrometheus<impl::Typed::kNo>(statistics, request);
+}
+
+void ToPrometheusFormat(
+    const utils::statistics::Storage& statistics,
+    const utils::statistics::Request& request, PrometheusFormatCache& cache,
+    utils::function_ref<void(std::string&& chunk)> consumer) {
+  impl::FormatPrometheus<impl::Typed::kYes>(statistics, request, *cache.impl_,
+                                            consumer);
+}
+
+void ToPrometheusFormatUntyped(
+    const utils::statistics::Storage& statistics,
+    const utils::statistics::Request& request, PrometheusFormatCache& cache,
+    utils::function_ref<void(std::string&& chunk)> consumer) {
+  impl::FormatPrometheus<impl::Typed::kNo>(statistics, request, *cache.impl_,
+                                           consumer);
 }
 
 }  // namespace utils::statistics
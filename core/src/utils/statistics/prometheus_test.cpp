@@ -409,6 +409,57 @@ child{application="processing"} 8
   }
 }
 
+UTEST(MetricsPrometheus, Cached) {
+  std::size_t series_count = 3;
+  int value = 0;
+  utils::statistics::Storage storage;
+  auto statistics_holder = storage.RegisterWriter(
+      "cached", [&](utils::statistics::Writer& writer) {
+        for (std::size_t i = 0; i < series_count; ++i) {
+          writer["value"].ValueWithLabels(
+              value, {"label", "v\"" + std::to_string(i)});
+        }
+        writer["rate"] = utils::statistics::Rate{42};
+      });
+
+  const auto request = utils::statistics::Request::MakeWithPrefix(
+      {}, {{"application", "processing"}});
+  utils::statistics::PrometheusFormatCache cache;
+  const auto to_string_cached = [&](bool typed) {
+    std::string result;
+    std::size_t chunks = 0;
+    const auto consumer = [&](std::string&& chunk) {
+      EXPECT_FALSE(chunk.empty());
+      result += chunk;
+      ++chunks;
+    };
+    if (typed) {
+      ToPrometheusFormat(storage, request, cache, consumer);
+    } else {
+      ToPrometheusFormatUntyped(storage, request, cache, consumer);
+    }
+    EXPECT_LE(chunks, 1 + result.size() / (64 * 1024));
+    return result;
+  };
+
+  for (; value < 3; ++value) {
+    EXPECT_EQ(to_string_cached(true), ToPrometheusFormat(storage, request));
+    EXPECT_EQ(to_string_cached(false),
+              ToPrometheusFormatUntyped(storage, request));
+  }
+
+  series_count = 10'000;
+  const auto many_series = ToPrometheusFormat(storage, request);
+  EXPECT_EQ(to_string_cached(true), many_series);
+  EXPECT_EQ(to_string_cached(true), many_series);
+
+  // the evicted series are rendered again once they reappear
+  series_count = 1;
+  EXPECT_EQ(to_string_cached(true), ToPrometheusFormat(storage, request));
+  series_count = 10'000;
+  EXPECT_EQ(to_string_cached(true), many_series);
+}
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,44 @@
+#include <userver/utils/statistics/sharded_histogram.hpp>
+
+#include <userver/utils/statistics/impl/sharding.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+ShardedHistogram::ShardedHistogram(utils::span<const double> upper_bounds) {
+  // Only the bucket arrays of the shards are written to, and they are
+  // allocated separately, so the shards themselves may be packed tightly
+  shards_.reserve(impl::GetShardCount());
+  for (std::size_t i = 0; i < impl::GetShardCount(); ++i) {
+    shards_.emplace_back(upper_bounds);
+  }
+}
+
+ShardedHistogram::~ShardedHistogram() = default;
+
+void ShardedHistogram::Account(double value, std::uint64_t count) noexcept {
+  shards_[impl::GetCurrentShard()].Account(value, count);
+}
+
+Histogram ShardedHistogram::Aggregate() const {
+  Histogram result{shards_.front().GetView()};
+  for (std::size_t i = 1; i < shards_.size(); ++i) {
+    result.Add(shards_[i].GetView());
+  }
+  return result;
+}
+
+void ResetMetric(ShardedHistogram& histogram) noexcept {
+  for (auto& shard : histogram.shards_) ResetMetric(shard);
+}
+
+void DumpMetric(Writer& writer, const ShardedHistogram& histogram) {
+  const auto aggregate = histogram.Aggregate();
+  writer = aggregate.GetView();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
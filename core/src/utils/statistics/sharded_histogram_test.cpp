@@ -0,0 +1,59 @@
+#include <userver/utils/statistics/sharded_histogram.hpp>
+
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/fmt.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+const std::vector<double> kBounds{1.5, 5, 42, 60};
+
+}  // namespace
+
+UTEST_MT(StatisticsShardedHistogram, Concurrent, 4) {
+  constexpr std::size_t kTasks = 8;
+
+  utils::statistics::ShardedHistogram histogram{kBounds};
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&histogram] {
+      histogram.Account(10);
+      histogram.Account(1.2);
+      histogram.Account(100, 2);
+    }));
+  }
+  engine::WaitAllChecked(tasks);
+
+  const auto aggregate = histogram.Aggregate();
+  EXPECT_EQ(fmt::to_string(aggregate.GetView()),
+            "[1.5]=8,[5]=0,[42]=8,[60]=0,[inf]=16");
+}
+
+UTEST(StatisticsShardedHistogram, DumpMetric) {
+  utils::statistics::Storage storage;
+  utils::statistics::ShardedHistogram histogram{kBounds};
+  histogram.Account(30, 4);
+
+  const auto statistics_holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+  EXPECT_EQ(fmt::to_string(
+                utils::statistics::Snapshot{storage}.SingleMetric("test")),
+            "[1.5]=0,[5]=0,[42]=4,[60]=0,[inf]=0");
+
+  ResetMetric(histogram);
+  EXPECT_EQ(fmt::to_string(
+                utils::statistics::Snapshot{storage}.SingleMetric("test")),
+            "[1.5]=0,[5]=0,[42]=0,[60]=0,[inf]=0");
+}
+
+USERVER_NAMESPACE_END
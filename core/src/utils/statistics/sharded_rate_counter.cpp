@@ -0,0 +1,54 @@
+#include <userver/utils/statistics/sharded_rate_counter.hpp>
+
+#include <atomic>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <userver/utils/statistics/impl/sharding.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+
+struct alignas(concurrent::impl::kDestructiveInterferenceSize)
+    RateCounterShard final {
+  std::atomic<Rate::ValueType> value{0};
+};
+
+}  // namespace impl
+
+ShardedRateCounter::ShardedRateCounter()
+    : shards_(std::make_unique<impl::RateCounterShard[]>(
+          impl::GetShardCount())) {}
+
+ShardedRateCounter::~ShardedRateCounter() = default;
+
+Rate ShardedRateCounter::Load() const noexcept {
+  Rate result;
+  for (std::size_t i = 0; i < impl::GetShardCount(); ++i) {
+    result.value += shards_[i].value.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void ShardedRateCounter::Add(Rate arg) noexcept {
+  shards_[impl::GetCurrentShard()].value.fetch_add(arg.value,
+                                                   std::memory_order_relaxed);
+}
+
+void ResetMetric(ShardedRateCounter& value) noexcept {
+  for (std::size_t i = 0; i < impl::GetShardCount(); ++i) {
+    value.shards_[i].value.store(0, std::memory_order_relaxed);
+  }
+}
+
+void DumpMetric(Writer& writer, const ShardedRateCounter& value) {
+  writer = value.Load();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,56 @@
+#include <userver/utils/statistics/sharded_rate_counter.hpp>
+
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+UTEST(ShardedRateCounter, Basic) {
+  ShardedRateCounter counter;
+  EXPECT_EQ(Rate{0}, counter.Load());
+
+  ++counter;
+  counter += Rate{10};
+  counter.Add(Rate{5});
+  EXPECT_EQ(Rate{16}, counter.Load());
+}
+
+UTEST_MT(ShardedRateCounter, Concurrent, 4) {
+  constexpr std::size_t kTasks = 8;
+  constexpr std::size_t kIncrements = 10'000;
+
+  ShardedRateCounter counter;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&counter] {
+      for (std::size_t j = 0; j < kIncrements; ++j) ++counter;
+    }));
+  }
+  engine::WaitAllChecked(tasks);
+
+  EXPECT_EQ(Rate{kTasks * kIncrements}, counter.Load());
+}
+
+UTEST(ShardedRateCounter, DumpMetric) {
+  Storage storage;
+  ShardedRateCounter counter;
+  counter += Rate{10};
+  const auto counter_scope = storage.RegisterWriter(
+      "test", [&counter](Writer& writer) { writer = counter; });
+
+  EXPECT_EQ(Snapshot{storage}.SingleMetric("test").AsRate(), 10);
+
+  ResetMetric(counter);
+  EXPECT_EQ(Snapshot{storage}.SingleMetric("test").AsRate(), 0);
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -8,6 +8,9 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
 #include <iterator>
 #include <string>
 #include <string_view>
@@ -20,8 +23,8 @@
 #include <userver/fs/blocking/read.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
-#include <userver/utils/from_string.hpp>
 #include <userver/utils/statistics/writer.hpp>
+#include <utils/strerror.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -29,6 +32,113 @@ namespace utils::statistics::impl {
 
 namespace {
 
+// All the files of interest are much smaller
+constexpr std::size_t kReadBufferSize = 4096;
+
+// /proc/vmstat has ~200 lines
+constexpr std::size_t kVmstatBufferSize = 16384;
+
+constexpr std::string_view kCgroupRoot = "/sys/fs/cgroup";
+
+std::optional<std::int64_t> ParseInt(std::string_view data) {
+  std::int64_t value = 0;
+  const auto [ptr, ec] =
+      std::from_chars(data.data(), data.data() + data.size(), value);
+  if (ec != std::errc{} || ptr == data.data()) return std::nullopt;
+  return value;
+}
+
+// Parses the `12.34` numbers of the PSI files
+std::optional<double> ParseFixedPoint(std::string_view data) {
+  const auto dot_pos = std::min(data.find('.'), data.size());
+  const auto integral = ParseInt(data.substr(0, dot_pos));
+  if (!integral) return std::nullopt;
+
+  double result = *integral;
+  double scale = 0.1;
+  for (auto i = dot_pos + 1; i < data.size(); ++i, scale /= 10) {
+    if (data[i] < '0' || data[i] > '9') break;
+    result += (data[i] - '0') * scale;
+  }
+  return result;
+}
+
+// Returns the value of a `key value` line
+std::optional<std::string_view> FindLineValue(std::string_view data,
+                                              std::string_view key) {
+  std::size_t pos = 0;
+  while (pos < data.size()) {
+    const auto next_newline_pos = std::min(data.find('\n', pos), data.size());
+    const auto line = data.substr(pos, next_newline_pos - pos);
+    if (line.size() > key.size() && line.substr(0, key.size()) == key &&
+        line[key.size()] == ' ') {
+      return line.substr(key.size() + 1);
+    }
+    pos = next_newline_pos + 1;
+  }
+  return std::nullopt;
+}
+
+// Returns the value of a `key=value` field of a space-separated line
+std::string_view FindFieldValue(std::string_view line, std::string_view key) {
+  std::size_t pos = 0;
+  while (pos < line.size()) {
+    const auto next_space_pos = std::min(line.find(' ', pos), line.size());
+    const auto field = line.substr(pos, next_space_pos - pos);
+    if (field.size() > key.size() && field.substr(0, key.size()) == key &&
+        field[key.size()] == '=') {
+      return field.substr(key.size() + 1);
+    }
+    pos = next_space_pos + 1;
+  }
+  return {};
+}
+
+std::optional<std::int64_t> CountOpenFiles(const std::string& fd_dir) {
+  boost::system::error_code ec;
+  boost::filesystem::directory_iterator it{fd_dir, ec};
+  if (ec) return std::nullopt;
+
+  std::int64_t open_files = 0;
+  while (!ec && it != boost::filesystem::directory_iterator{}) {
+    ++open_files;
+    it.increment(ec);
+  }
+  return open_files;
+}
+
+std::optional<fs::blocking::FileDescriptor> TryOpen(const std::string& path) {
+  try {
+    return fs::blocking::FileDescriptor::Open(path,
+                                              fs::blocking::OpenFlag::kRead);
+  } catch (const std::exception& ex) {
+    LOG_DEBUG() << "Statistics from " << path << " are not available: " << ex;
+    return std::nullopt;
+  }
+}
+
+template <std::size_t BufferSize>
+std::optional<std::string_view> ReadAll(
+    const std::optional<fs::blocking::FileDescriptor>& fd,
+    std::array<char, BufferSize>& buffer) {
+  if (!fd) return std::nullopt;
+
+  std::size_t size = 0;
+  while (size < buffer.size()) {
+    const auto read_res = ::pread(fd->GetNative(), buffer.data() + size,
+                                  buffer.size() - size, size);
+    if (read_res < 0) {
+      if (errno == EINTR) continue;
+      LOG_LIMITED_DEBUG() << "Failed to read statistics: "
+                          << utils::strerror(errno);
+      return std::nullopt;
+    }
+    if (read_res == 0) break;
+    size += static_cast<std::size_t>(read_res);
+  }
+  return std::string_view{buffer.data(), size};
+}
+
 #ifdef __linux__
 template <typename T>
 void MergeSingleStat(std::optional<T>& to, std::optional<T> from) {
@@ -58,6 +168,117 @@ bool IsAllDigits(const boost::filesystem::path& path) {
                      [](char c) { return c >= '0' && c <= '9'; });
 }
 
+std::string FindCgroupDir() {
+  try {
+    // cgroup v2 has the single `0::/path` line
+    const auto contents = fs::blocking::ReadFileContents("/proc/self/cgroup");
+    const auto pos = contents.find("0::/");
+    if (pos != std::string::npos && (pos == 0 || contents[pos - 1] == '\n')) {
+      const auto path_end = std::min(contents.find('\n', pos), contents.size());
+      auto dir = std::string{kCgroupRoot} +
+                 contents.substr(pos + 3, path_end - pos - 3);
+      // Inside of a container the cgroup of the process is usually mounted as
+      // the root
+      if (!boost::filesystem::exists(dir + "/cpu.stat")) {
+        dir = std::string{kCgroupRoot};
+      }
+      return dir;
+    }
+  } catch (const std::exception& ex) {
+    LOG_DEBUG() << "Could not find the cgroup of the process: " << ex;
+  }
+  return {};
+}
+
+SystemStats GetSystemStatisticsByProcPath(std::string_view path) {
+  SystemStats stats;
+  try {
+    ParseProcStat(fs::blocking::ReadFileContents(fmt::format("{}/stat", path)),
+                  stats);
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_DEBUG() << "Could not get stats from " << path << ": " << ex;
+  }
+
+  stats.open_files = CountOpenFiles(fmt::format("{}/fd", path));
+
+  try {
+    ParseProcStatIo(fs::blocking::ReadFileContents(fmt::format("{}/io", path)),
+                    stats);
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_DEBUG() << "Could not get I/O stats from " << path << ": "
+                        << ex;
+  }
+
+  return stats;
+}
+
+SystemStats GetSystemStatisticsByExeNameFromProc(std::string_view name) {
+  boost::system::error_code ec;
+  boost::filesystem::directory_iterator it("/proc", ec);
+  if (ec) {
+    LOG_LIMITED_DEBUG() << "Could not collect stats for " << name << ": "
+                        << ec.message();
+    return {};
+  }
+
+  SystemStats cumulative;
+  for (; !ec && it != boost::filesystem::directory_iterator{};
+       it.increment(ec)) {
+    if (!boost::filesystem::is_directory(it->status())) continue;
+    if (!IsAllDigits(it->path().filename())) continue;
+
+    std::string stat_data;
+    try {
+      stat_data =
+          fs::blocking::ReadFileContents((it->path() / "stat").native());
+    } catch (const std::exception&) {
+      // most likely not a process directory or insufficient permissions
+      continue;
+    }
+    auto exe_symlink = it->path() / "exe";
+
+    if (IsProcStatMatchesName(stat_data, name) ||
+        boost::filesystem::read_symlink(exe_symlink, ec).filename().native() ==
+            name) {
+      Merge(cumulative, GetSystemStatisticsByProcPath(it->path().native()));
+    }
+  }
+  return cumulative;
+}
+#endif
+
+#ifdef __APPLE__
+utils::statistics::impl::SystemStats GetSelfSystemStatisticsFromKernel() {
+  utils::statistics::impl::SystemStats stats;
+
+  {
+    struct mach_task_basic_info basic_info {};
+    mach_msg_type_number_t info_count = MACH_TASK_BASIC_INFO_COUNT;
+    if (::task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                    reinterpret_cast<task_info_t>(&basic_info),
+                    &info_count) == KERN_SUCCESS) {
+      stats.rss_kb = basic_info.resident_size / 1024;
+    }
+  }
+
+  stats.open_files = CountOpenFiles("/dev/fd");
+
+  {
+    struct rusage rusage {};
+    if (::getrusage(RUSAGE_SELF, &rusage) != -1) {
+      timeradd(&rusage.ru_utime, &rusage.ru_stime, &rusage.ru_utime);
+      stats.cpu_time_sec =
+          rusage.ru_utime.tv_sec + rusage.ru_utime.tv_usec * 1e-6;
+      stats.major_pagefaults = rusage.ru_majflt;
+    }
+  }
+
+  return stats;
+}
+#endif
+
+}  // namespace
+
 void ParseProcStat(std::string_view data, SystemStats& stats) {
   static const auto kTicksPerSecond = sysconf(_SC_CLK_TCK);
   static const auto kPageSizeKb = sysconf(_SC_PAGESIZE) / 1024;
@@ -77,8 +298,7 @@ void ParseProcStat(std::string_view data, SystemStats& stats) {
     size_t next_delim_pos = std::min(data.find(' ', pos), data.size());
 
     const auto get_current_value = [=] {
-      return utils::FromString<int64_t>(
-          std::string{data.substr(pos, next_delim_pos - pos)});
+      return ParseInt(data.substr(pos, next_delim_pos - pos));
     };
 
     switch (field_num) {
@@ -97,12 +317,12 @@ void ParseProcStat(std::string_view data, SystemStats& stats) {
         break;
 
       case kUtimeFieldNum:
-        utime_ticks = get_current_value();
+        utime_ticks = get_current_value().value_or(-1);
         break;
       case kStimeFieldNum:
         UASSERT(utime_ticks != -1);
-        {
-          const auto total_ticks = utime_ticks + get_current_value();
+        if (const auto stime_ticks = get_current_value()) {
+          const auto total_ticks = utime_ticks + *stime_ticks;
           stats.cpu_time_sec =
               int64_t{total_ticks / kTicksPerSecond} +
               static_cast<double>(total_ticks % kTicksPerSecond) /
@@ -111,7 +331,9 @@ void ParseProcStat(std::string_view data, SystemStats& stats) {
         break;
 
       case kRssFieldNum:
-        stats.rss_kb = get_current_value() * kPageSizeKb;
+        if (const auto rss_pages = get_current_value()) {
+          stats.rss_kb = *rss_pages * kPageSizeKb;
+        }
         break;
 
       default:;
@@ -137,8 +359,7 @@ void ParseProcStatIo(std::string_view data, SystemStats& stats) {
       auto value_pos = pos + header.size();
       UASSERT(value_pos < next_newline_pos);
       auto value_len = next_newline_pos - value_pos;
-      field = utils::FromString<int64_t>(
-          std::string{data.substr(value_pos, value_len)});
+      field = ParseInt(data.substr(value_pos, value_len));
     };
 
     parse_if_matches(stats.io_read_bytes, kReadBytesHeader);
@@ -148,114 +369,57 @@ void ParseProcStatIo(std::string_view data, SystemStats& stats) {
   }
 }
 
-SystemStats GetSystemStatisticsByProcPath(std::string_view path) {
-  SystemStats stats;
-  try {
-    ParseProcStat(fs::blocking::ReadFileContents(fmt::format("{}/stat", path)),
-                  stats);
-  } catch (const std::exception& ex) {
-    LOG_LIMITED_DEBUG() << "Could not get stats from " << path << ": " << ex;
-  }
+void ParseCgroupCpuStat(std::string_view data, CgroupStats& stats) {
+  const auto find_counter = [data](std::string_view key) {
+    const auto value = FindLineValue(data, key);
+    return value ? ParseInt(*value) : std::nullopt;
+  };
 
-  {
-    boost::system::error_code ec;
-    boost::filesystem::directory_iterator it{fmt::format("{}/fd", path), ec};
-    if (!ec) {
-      stats.open_files = 0;
-      while (!ec && it != boost::filesystem::directory_iterator{}) {
-        ++*stats.open_files;
-        it.increment(ec);
-      }
-    }
+  if (const auto usage_us = find_counter("usage_usec")) {
+    stats.cpu_usage_sec = static_cast<double>(*usage_us) / 1'000'000;
   }
-
-  try {
-    ParseProcStatIo(fs::blocking::ReadFileContents(fmt::format("{}/io", path)),
-                    stats);
-  } catch (const std::exception& ex) {
-    LOG_LIMITED_DEBUG() << "Could not get I/O stats from " << path << ": "
-                        << ex;
+  stats.cpu_periods = find_counter("nr_periods");
+  stats.cpu_throttled_periods = find_counter("nr_throttled");
+  if (const auto throttled_us = find_counter("throttled_usec")) {
+    stats.cpu_throttled_sec = static_cast<double>(*throttled_us) / 1'000'000;
   }
-
-  return stats;
 }
 
-SystemStats GetSystemStatisticsByExeNameFromProc(std::string_view name) {
-  boost::system::error_code ec;
-  boost::filesystem::directory_iterator it("/proc", ec);
-  if (ec) {
-    LOG_LIMITED_DEBUG() << "Could not collect stats for " << name << ": "
-                        << ec.message();
-    return {};
+PressureStats ParsePressure(std::string_view data) {
+  PressureStats stats;
+  if (const auto some = FindLineValue(data, "some")) {
+    stats.some_avg10 = ParseFixedPoint(FindFieldValue(*some, "avg10"));
+    stats.some_total_us = ParseInt(FindFieldValue(*some, "total"));
   }
-
-  SystemStats cumulative;
-  for (; !ec && it != boost::filesystem::directory_iterator{};
-       it.increment(ec)) {
-    if (!boost::filesystem::is_directory(it->status())) continue;
-    if (!IsAllDigits(it->path().filename())) continue;
-
-    std::string stat_data;
-    try {
-      stat_data =
-          fs::blocking::ReadFileContents((it->path() / "stat").native());
-    } catch (const std::exception&) {
-      // most likely not a process directory or insufficient permissions
-      continue;
-    }
-    auto exe_symlink = it->path() / "exe";
-
-    if (IsProcStatMatchesName(stat_data, name) ||
-        boost::filesystem::read_symlink(exe_symlink, ec).filename().native() ==
-            name) {
-      Merge(cumulative, GetSystemStatisticsByProcPath(it->path().native()));
-    }
+  if (const auto full = FindLineValue(data, "full")) {
+    stats.full_avg10 = ParseFixedPoint(FindFieldValue(*full, "avg10"));
+    stats.full_total_us = ParseInt(FindFieldValue(*full, "total"));
   }
-  return cumulative;
+  return stats;
 }
-#endif
-
-#ifdef __APPLE__
-utils::statistics::impl::SystemStats GetSelfSystemStatisticsFromKernel() {
-  utils::statistics::impl::SystemStats stats;
 
-  {
-    struct mach_task_basic_info basic_info {};
-    mach_msg_type_number_t info_count = MACH_TASK_BASIC_INFO_COUNT;
-    if (::task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
-                    reinterpret_cast<task_info_t>(&basic_info),
-                    &info_count) == KERN_SUCCESS) {
-      stats.rss_kb = basic_info.resident_size / 1024;
-    }
-  }
-
-  {
-    boost::system::error_code ec;
-    boost::filesystem::directory_iterator it{"/dev/fd", ec};
-    if (!ec) {
-      stats.open_files = 0;
-      while (!ec && it != boost::filesystem::directory_iterator{}) {
-        ++*stats.open_files;
-        it.increment(ec);
-      }
-    }
-  }
+void ParseSmapsRollup(std::string_view data, HugePagesStats& stats) {
+  // `AnonHugePages:    2048 kB`
+  const auto value = FindLineValue(data, "AnonHugePages:");
+  if (!value) return;
+  const auto first_digit = std::min(value->find_first_not_of(' '),
+                                    value->size());
+  stats.anon_huge_pages_kb = ParseInt(value->substr(first_digit));
+}
 
-  {
-    struct rusage rusage {};
-    if (::getrusage(RUSAGE_SELF, &rusage) != -1) {
-      timeradd(&rusage.ru_utime, &rusage.ru_stime, &rusage.ru_utime);
-      stats.cpu_time_sec =
-          rusage.ru_utime.tv_sec + rusage.ru_utime.tv_usec * 1e-6;
-      stats.major_pagefaults = rusage.ru_majflt;
-    }
-  }
+void ParseVmstat(std::string_view data, HugePagesStats& stats) {
+  const auto find_counter = [data](std::string_view key) {
+    const auto value = FindLineValue(data, key);
+    return value ? ParseInt(*value) : std::nullopt;
+  };
 
-  return stats;
+  stats.thp_fault_alloc = find_counter("thp_fault_alloc");
+  stats.thp_fault_fallback = find_counter("thp_fault_fallback");
+  stats.thp_collapse_alloc = find_counter("thp_collapse_alloc");
+  stats.compact_stall = find_counter("compact_stall");
+  stats.compact_success = find_counter("compact_success");
+  stats.compact_fail = find_counter("compact_fail");
 }
-#endif
-
-}  // namespace
 
 void DumpMetric(Writer& writer, const SystemStats& stats) {
   const auto put_field = [&writer](std::string_view name, const auto& value) {
@@ -269,7 +433,47 @@ void DumpMetric(Writer& writer, const SystemStats& stats) {
   put_field("io_write_bytes", stats.io_write_bytes);
 }
 
+void DumpMetric(Writer& writer, const PressureStats& stats) {
+  const auto put_field = [&writer](std::string_view name, const auto& value) {
+    if (value) writer[name] = *value;
+  };
+  put_field("some_avg10", stats.some_avg10);
+  put_field("some_total_us", stats.some_total_us);
+  put_field("full_avg10", stats.full_avg10);
+  put_field("full_total_us", stats.full_total_us);
+}
+
+void DumpMetric(Writer& writer, const CgroupStats& stats) {
+  const auto put_field = [&writer](std::string_view name, const auto& value) {
+    if (value) writer[name] = *value;
+  };
+  put_field("cpu_usage_sec", stats.cpu_usage_sec);
+  put_field("cpu_nr_periods", stats.cpu_periods);
+  put_field("cpu_nr_throttled", stats.cpu_throttled_periods);
+  put_field("cpu_throttled_sec", stats.cpu_throttled_sec);
+  put_field("memory_current_bytes", stats.memory_current_bytes);
+  writer["pressure"].ValueWithLabels(stats.cpu_pressure, {"resource", "cpu"});
+  writer["pressure"].ValueWithLabels(stats.memory_pressure,
+                                     {"resource", "memory"});
+  writer["pressure"].ValueWithLabels(stats.io_pressure, {"resource", "io"});
+}
+
+void DumpMetric(Writer& writer, const HugePagesStats& stats) {
+  const auto put_field = [&writer](std::string_view name, const auto& value) {
+    if (value) writer[name] = *value;
+  };
+  put_field("anon_huge_pages_kb", stats.anon_huge_pages_kb);
+  put_field("thp_fault_alloc", stats.thp_fault_alloc);
+  put_field("thp_fault_fallback", stats.thp_fault_fallback);
+  put_field("thp_collapse_alloc", stats.thp_collapse_alloc);
+  put_field("compact_stall", stats.compact_stall);
+  put_field("compact_success", stats.compact_success);
+  put_field("compact_fail", stats.compact_fail);
+}
+
 static_assert(kHasWriterSupport<SystemStats>);
+static_assert(kHasWriterSupport<CgroupStats>);
+static_assert(kHasWriterSupport<HugePagesStats>);
 
 SystemStats GetSelfSystemStatistics() {
 #if defined(__linux__)
@@ -291,6 +495,74 @@ SystemStats GetSystemStatisticsByExeName(std::string_view name) {
   return {};
 }
 
+SelfStatsReader::SelfStatsReader() {
+#ifdef __linux__
+  proc_stat_ = TryOpen("/proc/self/stat");
+  proc_io_ = TryOpen("/proc/self/io");
+  smaps_rollup_ = TryOpen("/proc/self/smaps_rollup");
+  vmstat_ = TryOpen("/proc/vmstat");
+
+  const auto cgroup_dir = FindCgroupDir();
+  if (cgroup_dir.empty()) return;
+  cgroup_cpu_stat_ = TryOpen(cgroup_dir + "/cpu.stat");
+  cgroup_memory_current_ = TryOpen(cgroup_dir + "/memory.current");
+  cgroup_cpu_pressure_ = TryOpen(cgroup_dir + "/cpu.pressure");
+  cgroup_memory_pressure_ = TryOpen(cgroup_dir + "/memory.pressure");
+  cgroup_io_pressure_ = TryOpen(cgroup_dir + "/io.pressure");
+#endif
+}
+
+SystemStats SelfStatsReader::ReadSystemStats() const {
+#ifdef __linux__
+  SystemStats stats;
+  std::array<char, kReadBufferSize> buffer;
+  if (const auto data = ReadAll(proc_stat_, buffer)) {
+    ParseProcStat(*data, stats);
+  }
+  stats.open_files = CountOpenFiles("/proc/self/fd");
+  if (const auto data = ReadAll(proc_io_, buffer)) {
+    ParseProcStatIo(*data, stats);
+  }
+  return stats;
+#else
+  return GetSelfSystemStatistics();
+#endif
+}
+
+CgroupStats SelfStatsReader::ReadCgroupStats() const {
+  CgroupStats stats;
+  std::array<char, kReadBufferSize> buffer;
+  if (const auto data = ReadAll(cgroup_cpu_stat_, buffer)) {
+    ParseCgroupCpuStat(*data, stats);
+  }
+  if (const auto data = ReadAll(cgroup_memory_current_, buffer)) {
+    stats.memory_current_bytes = ParseInt(*data);
+  }
+  if (const auto data = ReadAll(cgroup_cpu_pressure_, buffer)) {
+    stats.cpu_pressure = ParsePressure(*data);
+  }
+  if (const auto data = ReadAll(cgroup_memory_pressure_, buffer)) {
+    stats.memory_pressure = ParsePressure(*data);
+  }
+  if (const auto data = ReadAll(cgroup_io_pressure_, buffer)) {
+    stats.io_pressure = ParsePressure(*data);
+  }
+  return stats;
+}
+
+HugePagesStats SelfStatsReader::ReadHugePagesStats() const {
+  HugePagesStats stats;
+  std::array<char, kReadBufferSize> buffer;
+  if (const auto data = ReadAll(smaps_rollup_, buffer)) {
+    ParseSmapsRollup(*data, stats);
+  }
+  std::array<char, kVmstatBufferSize> vmstat_buffer;
+  if (const auto data = ReadAll(vmstat_, vmstat_buffer)) {
+    ParseVmstat(*data, stats);
+  }
+  return stats;
+}
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
@@ -2,8 +2,10 @@
 
 #include <cstdint>
 #include <optional>
+#include <string>
 #include <string_view>
 
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -21,9 +23,84 @@ struct SystemStats {
 
 void DumpMetric(Writer& writer, const SystemStats& stats);
 
+/// Pressure stall information, see
+/// https://docs.kernel.org/accounting/psi.html
+struct PressureStats {
+  std::optional<double> some_avg10;
+  std::optional<std::int64_t> some_total_us;
+  std::optional<double> full_avg10;
+  std::optional<std::int64_t> full_total_us;
+};
+
+void DumpMetric(Writer& writer, const PressureStats& stats);
+
+/// Counters of the cgroup v2 of the process
+struct CgroupStats {
+  std::optional<double> cpu_usage_sec;
+  std::optional<std::int64_t> cpu_periods;
+  std::optional<std::int64_t> cpu_throttled_periods;
+  std::optional<double> cpu_throttled_sec;
+  std::optional<std::int64_t> memory_current_bytes;
+  PressureStats cpu_pressure;
+  PressureStats memory_pressure;
+  PressureStats io_pressure;
+};
+
+void DumpMetric(Writer& writer, const CgroupStats& stats);
+
+/// Transparent huge pages usage of the process and the system-wide THP
+/// allocation and memory compaction counters
+struct HugePagesStats {
+  std::optional<std::int64_t> anon_huge_pages_kb;
+  std::optional<std::int64_t> thp_fault_alloc;
+  std::optional<std::int64_t> thp_fault_fallback;
+  std::optional<std::int64_t> thp_collapse_alloc;
+  std::optional<std::int64_t> compact_stall;
+  std::optional<std::int64_t> compact_success;
+  std::optional<std::int64_t> compact_fail;
+};
+
+void DumpMetric(Writer& writer, const HugePagesStats& stats);
+
 SystemStats GetSelfSystemStatistics();
 SystemStats GetSystemStatisticsByExeName(std::string_view name);
 
+/// Reads the statistics of the current process. Keeps the files of `/proc`
+/// and of the cgroup open and re-reads them with pread(2), so that a
+/// collection does not open files or allocate. Thread-safe.
+class SelfStatsReader final {
+ public:
+  SelfStatsReader();
+
+  SystemStats ReadSystemStats() const;
+
+  /// Returns the empty stats if the process is not in a cgroup v2
+  CgroupStats ReadCgroupStats() const;
+
+  /// Returns the empty stats if the kernel does not report THP usage
+  HugePagesStats ReadHugePagesStats() const;
+
+ private:
+  using OptionalFd = std::optional<fs::blocking::FileDescriptor>;
+
+  OptionalFd proc_stat_;
+  OptionalFd proc_io_;
+  OptionalFd cgroup_cpu_stat_;
+  OptionalFd cgroup_memory_current_;
+  OptionalFd cgroup_cpu_pressure_;
+  OptionalFd cgroup_memory_pressure_;
+  OptionalFd cgroup_io_pressure_;
+  OptionalFd smaps_rollup_;
+  OptionalFd vmstat_;
+};
+
+void ParseProcStat(std::string_view data, SystemStats& stats);
+void ParseProcStatIo(std::string_view data, SystemStats& stats);
+void ParseCgroupCpuStat(std::string_view data, CgroupStats& stats);
+PressureStats ParsePressure(std::string_view data);
+void ParseSmapsRollup(std::string_view data, HugePagesStats& stats);
+void ParseVmstat(std::string_view data, HugePagesStats& stats);
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
@@ -14,8 +14,12 @@ SystemStatisticsCollector::SystemStatisticsCollector(
     const ComponentConfig& config, const ComponentContext& context)
     : LoggableComponentBase(config, context),
       with_nginx_(config["with-nginx"].As<bool>(false)),
+      with_cgroup_(config["with-cgroup"].As<bool>(false)),
+      with_huge_pages_(config["with-huge-pages"].As<bool>(false)),
       fs_task_processor_(context.GetTaskProcessor(
-          config["fs-task-processor"].As<std::string>())) {
+          config["fs-task-processor"].As<std::string>())),
+      self_stats_reader_(
+          std::make_unique<utils::statistics::impl::SelfStatsReader>()) {
   statistics_holder_ =
       context.FindComponent<components::StatisticsStorage>()
           .GetStorage()
@@ -31,7 +35,13 @@ SystemStatisticsCollector::~SystemStatisticsCollector() {
 void SystemStatisticsCollector::ExtendStatistics(
     utils::statistics::Writer& writer) {
   engine::CriticalAsyncNoSpan(fs_task_processor_, [&] {
-    DumpMetric(writer, utils::statistics::impl::GetSelfSystemStatistics());
+    DumpMetric(writer, self_stats_reader_->ReadSystemStats());
+    if (with_cgroup_) {
+      writer["cgroup"] = self_stats_reader_->ReadCgroupStats();
+    }
+    if (with_huge_pages_) {
+      writer["huge_pages"] = self_stats_reader_->ReadHugePagesStats();
+    }
     if (with_nginx_) {
       writer.ValueWithLabels(
           utils::statistics::impl::GetSystemStatisticsByExeName("nginx"),
@@ -53,6 +63,18 @@ properties:
         type: boolean
         description: Whether to collect and report nginx processes statistics
         defaultDescription: false
+    with-cgroup:
+        type: boolean
+        description: |
+            Whether to report the CPU throttling, memory and pressure stall
+            statistics of the cgroup v2 of the process
+        defaultDescription: false
+    with-huge-pages:
+        type: boolean
+        description: |
+            Whether to report the transparent huge pages usage of the process
+            and the system-wide THP allocation and memory compaction counters
+        defaultDescription: false
 )");
 }
 
@@ -0,0 +1,113 @@
+#include <utils/statistics/system_statistics.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using utils::statistics::impl::CgroupStats;
+using utils::statistics::impl::HugePagesStats;
+using utils::statistics::impl::SystemStats;
+
+}  // namespace
+
+TEST(SystemStatistics, ProcStatIo) {
+  constexpr std::string_view kIo =
+      "rchar: 4292\n"
+      "wchar: 0\n"
+      "syscr: 13\n"
+      "syscw: 0\n"
+      "read_bytes: 8192\n"
+      "write_bytes: 4096\n"
+      "cancelled_write_bytes: 0\n";
+
+  SystemStats stats;
+  utils::statistics::impl::ParseProcStatIo(kIo, stats);
+  EXPECT_EQ(stats.io_read_bytes, 8192);
+  EXPECT_EQ(stats.io_write_bytes, 4096);
+}
+
+TEST(SystemStatistics, CgroupCpuStat) {
+  constexpr std::string_view kCpuStat =
+      "usage_usec 2500000\n"
+      "user_usec 2000000\n"
+      "system_usec 500000\n"
+      "nr_periods 120\n"
+      "nr_throttled 7\n"
+      "throttled_usec 1500000\n";
+
+  CgroupStats stats;
+  utils::statistics::impl::ParseCgroupCpuStat(kCpuStat, stats);
+  EXPECT_EQ(stats.cpu_usage_sec, 2.5);
+  EXPECT_EQ(stats.cpu_periods, 120);
+  EXPECT_EQ(stats.cpu_throttled_periods, 7);
+  EXPECT_EQ(stats.cpu_throttled_sec, 1.5);
+}
+
+TEST(SystemStatistics, CgroupCpuStatWithoutQuota) {
+  constexpr std::string_view kCpuStat =
+      "usage_usec 2500000\n"
+      "user_usec 2000000\n"
+      "system_usec 500000\n";
+
+  CgroupStats stats;
+  utils::statistics::impl::ParseCgroupCpuStat(kCpuStat, stats);
+  EXPECT_EQ(stats.cpu_usage_sec, 2.5);
+  EXPECT_FALSE(stats.cpu_periods);
+  EXPECT_FALSE(stats.cpu_throttled_sec);
+}
+
+TEST(SystemStatistics, Pressure) {
+  constexpr std::string_view kPressure =
+      "some avg10=1.25 avg60=0.50 avg300=0.10 total=123456\n"
+      "full avg10=0.05 avg60=0.00 avg300=0.00 total=789\n";
+
+  const auto stats = utils::statistics::impl::ParsePressure(kPressure);
+  ASSERT_TRUE(stats.some_avg10);
+  EXPECT_DOUBLE_EQ(*stats.some_avg10, 1.25);
+  EXPECT_EQ(stats.some_total_us, 123456);
+  ASSERT_TRUE(stats.full_avg10);
+  EXPECT_DOUBLE_EQ(*stats.full_avg10, 0.05);
+  EXPECT_EQ(stats.full_total_us, 789);
+}
+
+TEST(SystemStatistics, CpuPressureWithoutFull) {
+  constexpr std::string_view kPressure =
+      "some avg10=0.00 avg60=0.00 avg300=0.00 total=42\n";
+
+  const auto stats = utils::statistics::impl::ParsePressure(kPressure);
+  EXPECT_EQ(stats.some_total_us, 42);
+  EXPECT_FALSE(stats.full_total_us);
+}
+
+TEST(SystemStatistics, HugePages) {
+  constexpr std::string_view kSmapsRollup =
+      "55bcb0e25000-7ffe5acb8000 ---p 00000000 00:00 0 [rollup]\n"
+      "Rss:                1424 kB\n"
+      "Anonymous:           104 kB\n"
+      "AnonHugePages:      4096 kB\n"
+      "ShmemPmdMapped:        0 kB\n";
+  constexpr std::string_view kVmstat =
+      "compact_stall 3\n"
+      "compact_fail 1\n"
+      "compact_success 2\n"
+      "thp_fault_alloc 10\n"
+      "thp_fault_fallback 4\n"
+      "thp_fault_fallback_charge 0\n"
+      "thp_collapse_alloc 5\n"
+      "thp_collapse_alloc_failed 0\n";
+
+  HugePagesStats stats;
+  utils::statistics::impl::ParseSmapsRollup(kSmapsRollup, stats);
+  utils::statistics::impl::ParseVmstat(kVmstat, stats);
+  EXPECT_EQ(stats.anon_huge_pages_kb, 4096);
+  EXPECT_EQ(stats.thp_fault_alloc, 10);
+  EXPECT_EQ(stats.thp_fault_fallback, 4);
+  EXPECT_EQ(stats.thp_collapse_alloc, 5);
+  EXPECT_EQ(stats.compact_stall, 3);
+  EXPECT_EQ(stats.compact_success, 2);
+  EXPECT_EQ(stats.compact_fail, 1);
+}
+
+USERVER_NAMESPACE_END
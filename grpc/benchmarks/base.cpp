@@ -7,6 +7,7 @@
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/task_with_result.hpp>
+#include <userver/ugrpc/impl/statistics.hpp>
 #include <userver/ugrpc/tests/service.hpp>
 #include <userver/utils/algo.hpp>
 #include <userver/utils/fixed_array.hpp>
@@ -166,6 +167,46 @@ void BatchOfUnaryRPC(benchmark::State& state) {
 
 BENCHMARK(BatchOfUnaryRPC)->DenseRange(1, 8)->Unit(benchmark::kMillisecond);
 
+void BatchOfUnaryRPCCompletionQueues(benchmark::State& state) {
+  engine::RunStandalone(
+      state.range(0),
+      engine::TaskProcessorPoolsConfig{10000, 100000, 256 * 1024ULL, 1, "ev",
+                                       false, false},
+      [&] {
+        static constexpr std::size_t kBatchSize = 16;
+        server::ServerConfig server_config;
+        server_config.completion_queue_num = static_cast<int>(state.range(1));
+        GrpcClientTest client_factory{dynamic_config::MakeDefaultStorage({}),
+                                      std::move(server_config)};
+        auto clients =
+            utils::GenerateFixedArray(kBatchSize, [&client_factory](auto) {
+              return client_factory
+                  .MakeClient<sample::ugrpc::UnitTestServiceClient>();
+            });
+
+        for (auto _ : state) {
+          auto tasks =
+              utils::GenerateFixedArray(kBatchSize, [&clients](auto i) {
+                return engine::AsyncNoSpan(UnaryRPCPayloadRepeated,
+                                           std::ref(clients[i]));
+              });
+          engine::GetAll(tasks);
+        }
+
+        state.counters["rps"] = benchmark::Counter(
+            static_cast<std::size_t>(state.iterations()) * kBatchSize *
+                kUnaryRPCPayloadRepeatedRepetitions,
+            benchmark::Counter::kIsRate);
+      });
+}
+
+// Worker threads x completion queues. The clients are spread across the
+// queues, each queue has its own polling thread.
+BENCHMARK(BatchOfUnaryRPCCompletionQueues)
+    ->ArgsProduct({{2, 4, 8}, {1, 2, 4}})
+    ->ArgNames({"threads", "queues"})
+    ->Unit(benchmark::kMillisecond);
+
 void BatchOfUnaryRPCNewClient(benchmark::State& state) {
   engine::RunStandalone(
       state.range(0),
@@ -220,6 +261,20 @@ void BatchOfNewClient(benchmark::State& state) {
 
 BENCHMARK(BatchOfNewClient)->DenseRange(1, 8)->Unit(benchmark::kMillisecond);
 
+// The statistics accounted for each call of a method, from many threads at
+// once. Compare with UnaryRPC for the share of the statistics in a call.
+void MethodStatisticsAccount(benchmark::State& state) {
+  static impl::MethodStatistics stats;
+
+  for (auto _ : state) {
+    stats.AccountStarted();
+    stats.AccountTiming(std::chrono::milliseconds{1});
+    stats.AccountStatus(grpc::StatusCode::OK);
+  }
+}
+
+BENCHMARK(MethodStatisticsAccount)->ThreadRange(1, 8);
+
 }  // namespace ugrpc
 
 USERVER_NAMESPACE_END
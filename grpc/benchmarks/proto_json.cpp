@@ -0,0 +1,87 @@
+#include <userver/ugrpc/proto_json.hpp>
+
+#include <string>
+
+#include <google/protobuf/util/json_util.h>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
+
+#include <tests/messages.pb.h>
+
+#include <benchmark/benchmark.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// range(0) is the number of the elements in the repeated and map fields
+sample::ugrpc::JsonTranscodingMessage MakeMessage(std::int64_t size) {
+  sample::ugrpc::JsonTranscodingMessage message;
+  message.set_int32_value(42);
+  message.set_int64_value(1LL << 40);
+  message.set_double_value(3.14);
+  message.set_string_value("some string value");
+  message.set_kind(sample::ugrpc::JsonTranscodingMessage::KIND_FIRST);
+  message.mutable_nested()->set_name("nested");
+  for (std::int64_t i = 0; i < size; ++i) {
+    message.add_names("name " + std::to_string(i));
+    message.add_nested_list()->set_name("element " + std::to_string(i));
+    (*message.mutable_counters())["counter " + std::to_string(i)] =
+        static_cast<int>(i);
+  }
+  return message;
+}
+
+}  // namespace
+
+void proto_json_write_library(benchmark::State& state) {
+  const auto message = MakeMessage(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(ugrpc::ToJsonString(message));
+  }
+}
+BENCHMARK(proto_json_write_library)->Arg(1)->Arg(16)->Arg(256);
+
+void proto_json_write_library_value(benchmark::State& state) {
+  const auto message = MakeMessage(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(ugrpc::MessageToJson(message));
+  }
+}
+BENCHMARK(proto_json_write_library_value)->Arg(1)->Arg(16)->Arg(256);
+
+void proto_json_write_stream(benchmark::State& state) {
+  const auto message = MakeMessage(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    formats::json::StringBuilder sb;
+    ugrpc::WriteMessageToJson(message, sb);
+    benchmark::DoNotOptimize(sb.GetStringView());
+  }
+}
+BENCHMARK(proto_json_write_stream)->Arg(1)->Arg(16)->Arg(256);
+
+void proto_json_parse_library(benchmark::State& state) {
+  const auto json = formats::json::FromString(
+      ugrpc::ToJsonString(MakeMessage(state.range(0))));
+  sample::ugrpc::JsonTranscodingMessage message;
+  for ([[maybe_unused]] auto _ : state) {
+    const auto status = google::protobuf::util::JsonStringToMessage(
+        formats::json::ToString(json), &message);
+    benchmark::DoNotOptimize(status);
+  }
+}
+BENCHMARK(proto_json_parse_library)->Arg(1)->Arg(16)->Arg(256);
+
+void proto_json_parse_direct(benchmark::State& state) {
+  const auto json = formats::json::FromString(
+      ugrpc::ToJsonString(MakeMessage(state.range(0))));
+  sample::ugrpc::JsonTranscodingMessage message;
+  for ([[maybe_unused]] auto _ : state) {
+    ugrpc::JsonToMessage(json, message);
+    benchmark::DoNotOptimize(message);
+  }
+}
+BENCHMARK(proto_json_parse_direct)->Arg(1)->Arg(16)->Arg(256);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,31 @@
+#pragma once
+
+/// @file userver/ugrpc/byte_buffer_utils.hpp
+/// @brief Helper functions for working with `grpc::ByteBuffer`
+
+#include <google/protobuf/message.h>
+#include <grpcpp/support/byte_buffer.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc {
+
+/// @brief Serializes a protobuf message into a `grpc::ByteBuffer`
+/// @throws std::runtime_error on serialization failure
+grpc::ByteBuffer SerializeToByteBuffer(
+    const google::protobuf::Message& message);
+
+/// @brief Parses a protobuf message from a `grpc::ByteBuffer` without
+/// flattening it into a contiguous string first
+///
+/// The buffer is not consumed and may be forwarded afterwards. To only look
+/// at the fields required for routing, parse into a message type that declares
+/// just those fields: protobuf skips the rest of the payload.
+///
+/// @returns `false` if the buffer does not contain a valid `message`
+bool ParseFromByteBuffer(const grpc::ByteBuffer& buffer,
+                         google::protobuf::Message& message);
+
+}  // namespace ugrpc
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 /// @file userver/ugrpc/client/client_factory.hpp
 /// @brief @copybrief ugrpc::client::ClientFactory
 
+#include <atomic>
 #include <cstddef>
 
 #include <grpcpp/completion_queue.h>
@@ -13,12 +14,14 @@
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/testsuite/grpc_control.hpp>
+#include <userver/utils/statistics/entry.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
 #include <userver/ugrpc/client/impl/client_data.hpp>
 #include <userver/ugrpc/client/middlewares/base.hpp>
+#include <userver/ugrpc/impl/completion_queues.hpp>
 #include <userver/ugrpc/impl/statistics_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -42,6 +45,14 @@ struct ClientFactoryConfig {
   /// Number of underlying channels that will be created for every client
   /// in this factory.
   std::size_t channel_count{1};
+
+  /// The number of channels per endpoint may grow up to this value under
+  /// load. Values less than `channel_count` are treated as `channel_count`.
+  std::size_t max_channel_count{1};
+
+  /// A new channel is added if every channel has at least this many calls in
+  /// flight. Usually should not exceed `MAX_CONCURRENT_STREAMS` of the server.
+  std::size_t channel_in_flight_threshold{100};
 };
 
 ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
@@ -50,6 +61,16 @@ ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
 /// @brief Creates generated gRPC clients. Has a minimal built-in channel cache:
 /// as long as a channel to the same endpoint is used somewhere, the same
 /// channel is given out.
+///
+/// If multiple completion queues are passed, the clients are spread across
+/// them in a round-robin fashion.
+///
+/// Each call goes to the channel with the least calls in flight. The per
+/// channel in-flight counts are reported in `grpc.client.channels` metrics.
+///
+/// Besides `host:port`, the endpoint may be a unix socket, e.g. of a sidecar:
+/// `unix:/path/to/socket`, or `@name` (same as `unix-abstract:name`) for the
+/// abstract namespace.
 class ClientFactory final {
  public:
   ClientFactory(ClientFactoryConfig&& config,
@@ -59,6 +80,16 @@ class ClientFactory final {
                 testsuite::GrpcControl& testsuite_grpc,
                 dynamic_config::Source source);
 
+  ClientFactory(ClientFactoryConfig&& config,
+                engine::TaskProcessor& channel_task_processor,
+                MiddlewareFactories mws,
+                const ugrpc::impl::CompletionQueues& queues,
+                utils::statistics::Storage& statistics_storage,
+                testsuite::GrpcControl& testsuite_grpc,
+                dynamic_config::Source source);
+
+  ~ClientFactory();
+
   template <typename Client>
   Client MakeClient(const std::string& client_name,
                     const std::string& endpoint);
@@ -66,10 +97,14 @@ class ClientFactory final {
  private:
   impl::ChannelCache::Token GetChannel(const std::string& endpoint);
 
+  grpc::CompletionQueue& GetNextQueue() noexcept;
+
   engine::TaskProcessor& channel_task_processor_;
   MiddlewareFactories mws_;
-  grpc::CompletionQueue& queue_;
+  const ugrpc::impl::CompletionQueues queues_;
+  std::atomic<std::size_t> next_queue_{0};
   impl::ChannelCache channel_cache_;
+  utils::statistics::Entry channel_statistics_holder_;
   ugrpc::impl::StatisticsStorage client_statistics_storage_;
   const dynamic_config::Source config_source_;
   testsuite::GrpcControl& testsuite_grpc_;
@@ -86,9 +121,10 @@ Client ClientFactory::MakeClient(const std::string& client_name,
   for (const auto& mw_factory : mws_)
     mws.push_back(mw_factory->GetMiddleware(client_name));
 
-  return Client(impl::ClientParams{client_name, std::move(mws), queue_,
-                                   statistics, GetChannel(endpoint),
-                                   config_source_, testsuite_grpc_});
+  return Client(impl::ClientParams{client_name, std::move(mws),
+                                   GetNextQueue(), statistics,
+                                   GetChannel(endpoint), config_source_,
+                                   testsuite_grpc_});
 }
 
 }  // namespace ugrpc::client
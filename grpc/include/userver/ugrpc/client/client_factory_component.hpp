@@ -47,6 +47,9 @@ namespace ugrpc::client {
 /// auth-type | authentication method, see above | -
 /// default-service-config | default service config, see above | -
 /// channel-count | Number of underlying grpc::Channel objects | 1
+/// max-channel-count | Number of channels per endpoint may grow up to this value under load | channel-count
+/// channel-in-flight-threshold | Calls in flight per channel, after which a new channel is added | 100
+/// completion-queue-count | Number of completion queues to create if there is no gRPC server, otherwise the server queues are used | 1
 /// middlewares | middlewares names to use | []
 ///
 ///
@@ -0,0 +1,64 @@
+#pragma once
+
+/// @file userver/ugrpc/client/generic.hpp
+/// @brief @copybrief ugrpc::client::GenericClient
+
+#include <memory>
+#include <string_view>
+
+#include <grpcpp/client_context.h>
+#include <grpcpp/support/byte_buffer.h>
+
+#include <userver/ugrpc/client/impl/client_data.hpp>
+#include <userver/ugrpc/client/qos.hpp>
+#include <userver/ugrpc/client/rpc.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+/// @brief Allows to talk to any gRPC service in terms of raw
+/// `grpc::ByteBuffer`s, without knowing the protobuf schema
+///
+/// Intended for proxies: a request received by
+/// ugrpc::server::GenericServiceBase can be forwarded as is, without parsing
+/// and re-serializing it. Use
+/// ugrpc::ParseFromByteBuffer to inspect the fields required for routing.
+///
+/// Middlewares are invoked with a null request message. All the calls are
+/// accounted in statistics as a single `Generic/Generic` method.
+///
+/// Create using ClientFactory::MakeClient<GenericClient>.
+class GenericClient final {
+ public:
+  /// @brief Initiates a unary RPC
+  /// @param call_name fully-qualified method name without a leading slash,
+  /// e.g. `sample.ugrpc.UnitTestService/SayHello`; must outlive the call
+  /// @param request serialized request message
+  /// @param context the `grpc::ClientContext` to use for the call
+  /// @param qos per-call settings, only the ones from `qos` are applied
+  /// @returns the call handle, `Finish` returns the serialized response
+  ugrpc::client::UnaryCall<grpc::ByteBuffer> UnaryCall(
+      std::string_view call_name, const grpc::ByteBuffer& request,
+      std::unique_ptr<grpc::ClientContext> context =
+          std::make_unique<grpc::ClientContext>(),
+      const Qos& qos = {}) const;
+
+  /// @cond
+  // For internal use only
+  explicit GenericClient(impl::ClientParams&& client_params);
+
+  // For internal use only
+  static ugrpc::impl::StaticServiceMetadata GetMetadata();
+  /// @endcond
+
+ private:
+  template <typename Client>
+  friend impl::ClientData& impl::GetClientData(Client& client);
+
+  impl::ClientData impl_;
+};
+
+}  // namespace ugrpc::client
+
+USERVER_NAMESPACE_END
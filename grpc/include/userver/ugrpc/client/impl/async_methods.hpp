@@ -147,6 +147,7 @@ class RpcData final {
   grpc::CompletionQueue& queue_;
   RpcConfigValues config_values_;
   const Middlewares& mws_;
+  ChannelCache::InFlightGuard in_flight_;
 
   std::variant<std::monostate, AsyncMethodInvocation,
                FinishAsyncMethodInvocation>
@@ -24,6 +24,9 @@ struct CallParams {
   std::unique_ptr<grpc::ClientContext> context;
   ugrpc::impl::MethodStatistics& statistics;
   const Middlewares& mws;
+  // The least loaded channel, see ClientData::GetStub
+  std::size_t channel_index;
+  ChannelCache::InFlightGuard in_flight;
 };
 
 CallParams DoCreateCallParams(const ClientData&, std::size_t method_id,
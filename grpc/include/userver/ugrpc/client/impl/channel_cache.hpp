@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -12,6 +13,7 @@
 
 #include <userver/concurrent/variable.hpp>
 #include <userver/utils/fixed_array.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -19,6 +21,15 @@ namespace ugrpc::client::impl {
 
 class ChannelCache final {
  public:
+  /// @param channel_count the initial number of channels per endpoint
+  /// @param max_channel_count the number of channels per endpoint may grow up
+  /// to this value, if all the channels have at least
+  /// `channel_in_flight_threshold` calls in flight
+  ChannelCache(std::shared_ptr<grpc::ChannelCredentials>&& credentials,
+               const grpc::ChannelArguments& channel_args,
+               std::size_t channel_count, std::size_t max_channel_count,
+               std::size_t channel_in_flight_threshold);
+
   ChannelCache(std::shared_ptr<grpc::ChannelCredentials>&& credentials,
                const grpc::ChannelArguments& channel_args,
                std::size_t channel_count);
@@ -26,19 +37,31 @@ class ChannelCache final {
   ~ChannelCache();
 
   class Token;
+  class InFlightGuard;
 
   // The grpc::Channel is kept in cache as long as some Token pointing to it is
   // alive.
   Token Get(const std::string& endpoint);
 
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
  private:
+  struct ChannelSlot final {
+    std::shared_ptr<grpc::Channel> channel;
+    std::atomic<std::size_t> in_flight{0};
+  };
+
+  using ChannelSlots = utils::FixedArray<ChannelSlot>;
+
   struct CountedChannel final {
     CountedChannel(const std::string& endpoint,
                    const std::shared_ptr<grpc::ChannelCredentials>& credentials,
                    const grpc::ChannelArguments& channel_args,
-                   std::size_t count);
+                   std::size_t count, std::size_t max_count);
 
-    utils::FixedArray<std::shared_ptr<grpc::Channel>> channels;
+    // Shared with InFlightGuard, which may outlive the Token
+    std::shared_ptr<ChannelSlots> channels;
+    std::atomic<std::size_t> active_count;
     std::uint64_t counter{0};
   };
 
@@ -47,9 +70,31 @@ class ChannelCache final {
   const std::shared_ptr<grpc::ChannelCredentials> credentials_;
   const grpc::ChannelArguments channel_args_;
   const std::size_t channel_count_;
+  const std::size_t max_channel_count_;
+  const std::size_t channel_in_flight_threshold_;
   concurrent::Variable<Map> channels_;
 };
 
+/// Counts an in-flight call on a channel, see ChannelCache::Token::StartCall
+class ChannelCache::InFlightGuard final {
+ public:
+  InFlightGuard() noexcept = default;
+
+  InFlightGuard(InFlightGuard&&) noexcept = default;
+  InFlightGuard& operator=(InFlightGuard&&) noexcept;
+  ~InFlightGuard();
+
+  /// Stops counting the call, idempotent
+  void Release() noexcept;
+
+ private:
+  friend class ChannelCache::Token;
+
+  explicit InFlightGuard(std::shared_ptr<std::atomic<std::size_t>> in_flight);
+
+  std::shared_ptr<std::atomic<std::size_t>> in_flight_;
+};
+
 class ChannelCache::Token final {
  public:
   Token() noexcept = default;
@@ -62,11 +107,22 @@ class ChannelCache::Token final {
   Token& operator=(Token&&) noexcept;
   ~Token();
 
+  /// @returns the number of channels currently in use
   std::size_t GetChannelCount() const noexcept;
 
+  /// @returns the number of channels the endpoint may grow up to
+  std::size_t GetMaxChannelCount() const noexcept;
+
   const std::shared_ptr<grpc::Channel>& GetChannel(std::size_t index) const
       noexcept;
 
+  /// @returns the index of the channel with the least calls in flight. Adds
+  /// a new channel if all the channels are loaded above the threshold.
+  std::size_t SelectChannel() const noexcept;
+
+  /// Counts a new call in flight on the channel
+  InFlightGuard StartCall(std::size_t index) const;
+
  private:
   ChannelCache* cache_{nullptr};
   const std::string* endpoint_{nullptr};
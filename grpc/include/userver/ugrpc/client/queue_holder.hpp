@@ -3,28 +3,37 @@
 /// @file userver/ugrpc/client/queue_holder.hpp
 /// @brief @copybrief ugrpc::client::QueueHolder
 
+#include <cstddef>
+
 #include <grpcpp/completion_queue.h>
 
+#include <userver/ugrpc/impl/completion_queues.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client {
 
-/// @brief Manages a gRPC completion queue, usable only in clients
+/// @brief Manages gRPC completion queues, usable only in clients
+///
+/// Each queue is drained by its own thread.
 class QueueHolder final {
  public:
-  QueueHolder();
+  explicit QueueHolder(std::size_t queue_count = 1);
 
   QueueHolder(QueueHolder&&) = delete;
   QueueHolder& operator=(QueueHolder&&) = delete;
   ~QueueHolder();
 
+  /// @returns the first completion queue
   grpc::CompletionQueue& GetQueue();
 
+  /// @returns all the completion queues
+  const ugrpc::impl::CompletionQueues& GetQueues();
+
  private:
   struct Impl;
-  utils::FastPimpl<Impl, 144, 8> impl_;
+  utils::FastPimpl<Impl, 48, 8> impl_;
 };
 
 }  // namespace ugrpc::client
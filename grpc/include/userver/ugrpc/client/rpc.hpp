@@ -154,6 +154,9 @@ class [[nodiscard]] UnaryCall final : public CallAnyBase {
   ///
   /// `Finish` and `FinishAsync` should not be called together for the same RPC.
   ///
+  /// `response` may be allocated in a `google::protobuf::Arena` to avoid
+  /// the heap allocations when parsing deeply nested responses.
+  ///
   /// @returns the future for the single response
   UnaryFuture FinishAsync(Response& response);
 
@@ -164,6 +167,14 @@ class [[nodiscard]] UnaryCall final : public CallAnyBase {
       impl::CallParams&& params, Stub& stub,
       impl::RawResponseReaderPreparer<Stub, Request, Response> prepare_func,
       const Request& req);
+
+  // For internal use only, `request` is passed to the middlewares and may be
+  // null when the request is not a protobuf message
+  UnaryCall(impl::CallParams&& params,
+            utils::function_ref<impl::RawResponseReader<Response>(
+                grpc::ClientContext*, grpc::CompletionQueue*)>
+                prepare_func,
+            const ::google::protobuf::Message* request);
   /// @endcond
 
   UnaryCall(UnaryCall&&) noexcept = default;
@@ -455,15 +466,28 @@ UnaryCall<Response>::UnaryCall(
     impl::CallParams&& params, Stub& stub,
     impl::RawResponseReaderPreparer<Stub, Request, Response> prepare_func,
     const Request& req)
+    : UnaryCall(
+          std::move(params),
+          [&](grpc::ClientContext* context, grpc::CompletionQueue* queue) {
+            return (stub.*prepare_func)(context, req, queue);
+          },
+          &req) {}
+
+template <typename Response>
+UnaryCall<Response>::UnaryCall(
+    impl::CallParams&& params,
+    utils::function_ref<impl::RawResponseReader<Response>(
+        grpc::ClientContext*, grpc::CompletionQueue*)>
+        prepare_func,
+    const ::google::protobuf::Message* request)
     : CallAnyBase(std::move(params)) {
   impl::CallMiddlewares(
       GetData().GetMiddlewares(), *this,
       [&] {
-        reader_ = (stub.*prepare_func)(&GetData().GetContext(), req,
-                                       &GetData().GetQueue());
+        reader_ = prepare_func(&GetData().GetContext(), &GetData().GetQueue());
         reader_->StartCall();
       },
-      &req);
+      request);
   GetData().SetWritesFinished();
 }
 
@@ -5,13 +5,13 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 #include <grpcpp/support/status.h>
 
 #include <userver/utils/fixed_array.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 #include <userver/utils/statistics/percentile.hpp>
-#include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 
 #include <userver/ugrpc/impl/static_metadata.hpp>
@@ -20,9 +20,12 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::impl {
 
+/// The counters are sharded per CPU and summed up in DumpMetric, as the calls
+/// of a method are accounted from all the threads at once
 class MethodStatistics final {
  public:
   MethodStatistics();
+  ~MethodStatistics();
 
   void AccountStarted() noexcept;
 
@@ -51,21 +54,13 @@ class MethodStatistics final {
  private:
   using Percentile =
       utils::statistics::Percentile<2000, std::uint32_t, 256, 100>;
-  using RateCounter = utils::statistics::RateCounter;
-  // StatusCode enum cases have consecutive underlying values, starting from 0.
-  // UNAUTHENTICATED currently has the largest value.
-  static constexpr std::size_t kCodesCount =
-      static_cast<std::size_t>(grpc::StatusCode::UNAUTHENTICATED) + 1;
-
-  RateCounter started_{0};
-  std::array<RateCounter, kCodesCount> status_codes_{};
-  utils::statistics::RecentPeriod<Percentile, Percentile> timings_;
-  RateCounter network_errors_{0};
-  RateCounter internal_errors_{0};
-  RateCounter cancelled_{0};
 
-  RateCounter deadline_updated_{0};
-  RateCounter deadline_cancelled_{0};
+  struct CountersShard;
+
+  CountersShard& GetCurrentShard() noexcept;
+
+  std::unique_ptr<CountersShard[]> shards_;
+  utils::statistics::RecentPeriod<Percentile, Percentile> timings_;
 };
 
 class ServiceStatistics final {
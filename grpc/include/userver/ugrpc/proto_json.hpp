@@ -7,6 +7,7 @@
 
 #include <userver/formats/json.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -23,6 +24,29 @@ std::string ToString(const google::protobuf::Message& message);
 /// @throws formats::json::ConversionException
 std::string ToJsonString(const google::protobuf::Message& message);
 
+/// @brief Writes the JSON representation of protobuf message right into the
+/// builder, without intermediate strings or formats::json::Value.
+///
+/// The output follows the proto3 JSON mapping with the options of
+/// ToJsonString(), except that the members are written in the order of
+/// declaration and floating point numbers may be formatted differently.
+/// The field descriptors are resolved once per message type. The well-known
+/// types of `google/protobuf/` are delegated to the protobuf library.
+/// @throws formats::json::ConversionException
+void WriteMessageToJson(const google::protobuf::Message& message,
+                        formats::json::StringBuilder& sb);
+
+/// @brief Fills protobuf message from its JSON representation without
+/// intermediate strings, see WriteMessageToJson().
+///
+/// Accepts both the lowerCamelCase JSON names and the original field names,
+/// `null` members are skipped. The well-known types of `google/protobuf/` are
+/// delegated to the protobuf library.
+/// @throws formats::json::ConversionException on unknown members or values
+/// that do not match the type of the field
+void JsonToMessage(const formats::json::Value& json,
+                   google::protobuf::Message& message);
+
 }  // namespace ugrpc
 
 namespace formats::serialize {
@@ -0,0 +1,45 @@
+#pragma once
+
+/// @file userver/ugrpc/server/generic_service_base.hpp
+/// @brief @copybrief ugrpc::server::GenericServiceBase
+
+#include <grpcpp/support/byte_buffer.h>
+
+#include <userver/ugrpc/server/rpc.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server {
+
+/// @brief Allows to handle RPCs with dynamic method names, without parsing
+/// the messages.
+///
+/// Messages are passed as raw `grpc::ByteBuffer`s, so proxy services may
+/// forward them without a protobuf round-trip, e.g. using
+/// ugrpc::client::GenericClient. Use ugrpc::ParseFromByteBuffer to extract
+/// the fields needed for routing.
+///
+/// All the RPCs that are not handled by the regular services of the server go
+/// to the generic service. At most one generic service may be registered in
+/// a server. The server middlewares, including deadline propagation, are
+/// applied to the generic RPCs in the same way as for the regular ones.
+///
+/// Every RPC is represented as a bidirectional stream. For unary RPCs the
+/// handler should read a single request and respond with `WriteAndFinish`.
+///
+/// @see ugrpc::server::GenericServiceComponentBase
+class GenericServiceBase {
+ public:
+  /// The call type, `GetCallName` returns `package.Service/Method`
+  using Call = BidirectionalStream<grpc::ByteBuffer, grpc::ByteBuffer>;
+
+  GenericServiceBase& operator=(GenericServiceBase&&) = delete;
+  virtual ~GenericServiceBase();
+
+  /// @brief Override this method to handle the RPCs
+  virtual void Handle(Call& call) = 0;
+};
+
+}  // namespace ugrpc::server
+
+USERVER_NAMESPACE_END
@@ -31,6 +31,7 @@ struct ServiceSettings final {
   Middlewares middlewares;
   logging::LoggerPtr access_tskv_logger;
   const dynamic_config::Source config_source;
+  const bool use_arena;
 };
 
 /// @brief Listens to requests for a gRPC service, forwarding them to a
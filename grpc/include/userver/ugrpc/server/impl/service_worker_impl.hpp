@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <exception>
 #include <functional>
@@ -8,6 +9,7 @@
 #include <type_traits>
 #include <utility>
 
+#include <google/protobuf/arena.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/impl/service_type.h>
 #include <grpcpp/server_context.h>
@@ -20,6 +22,7 @@
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
+#include <userver/utils/fixed_array.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
 #include <userver/utils/lazy_prvalue.hpp>
 #include <userver/utils/statistics/entry.hpp>
@@ -55,6 +58,11 @@ void ReportCustomError(
 void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
                grpc::ServerContext& context, std::string_view call_name);
 
+google::protobuf::ArenaOptions MakeArenaOptions(std::size_t size_hint) noexcept;
+
+void UpdateArenaSizeHint(std::atomic<std::size_t>& size_hint,
+                         std::size_t space_used) noexcept;
+
 /// Per-gRPC-service data
 template <typename GrpcppService>
 struct ServiceData final {
@@ -72,6 +80,9 @@ struct ServiceData final {
   AsyncService<GrpcppService> async_service{metadata.method_full_names.size()};
   utils::impl::WaitTokenStorage wait_tokens;
   ugrpc::impl::ServiceStatistics& statistics;
+  // Running average of arena usage per method, see ServiceConfig::use_arena
+  utils::FixedArray<std::atomic<std::size_t>> arena_size_hints{
+      metadata.method_full_names.size(), 0};
 };
 
 /// Per-gRPC-method data
@@ -90,6 +101,8 @@ struct MethodData final {
       call_name.substr(service_data.metadata.service_full_name.size() + 1)};
   ugrpc::impl::MethodStatistics& statistics{
       service_data.statistics.GetMethodStatistics(method_id)};
+  std::atomic<std::size_t>& arena_size_hint{
+      service_data.arena_size_hints[method_id]};
 };
 
 template <typename GrpcppService, typename CallTraits>
@@ -100,6 +113,17 @@ class CallData final {
         method_data_(method_data) {
     UASSERT(method_data.method_id <
             method_data.service_data.metadata.method_full_names.size());
+
+    if constexpr (!std::is_same_v<InitialRequest, NoInitialRequest>) {
+      if (method_data.service_data.settings.use_arena) {
+        arena_.emplace(MakeArenaOptions(method_data.arena_size_hint.load(
+            std::memory_order_relaxed)));
+        initial_request_ =
+            google::protobuf::Arena::CreateMessage<InitialRequest>(&*arena_);
+        return;
+      }
+    }
+    initial_request_ = &heap_initial_request_.emplace();
   }
 
   void operator()() && {
@@ -118,7 +142,7 @@ class CallData final {
         method_data_.queue_num);
 
     method_data_.service_data.async_service.template Prepare<CallTraits>(
-        method_data_.method_id, context_, initial_request_, raw_responder_,
+        method_data_.method_id, context_, *initial_request_, raw_responder_,
         queue, queue, prepare_.GetTag());
 
     // Note: we ignore task cancellations here. Even if notify_when_done has
@@ -139,6 +163,10 @@ class CallData final {
 
     HandleRpc();
 
+    if (arena_) {
+      UpdateArenaSizeHint(method_data_.arena_size_hint, arena_->SpaceUsed());
+    }
+
     // Even if we finished before receiving notification that call is done, we
     // should wait on this async operation. CompletionQueue has a pointer to
     // stack-allocated object, that object is going to be freed upon exit. To
@@ -175,20 +203,21 @@ class CallData final {
     auto& access_tskv_logger =
         method_data_.service_data.settings.access_tskv_logger;
     Call responder(CallParams{context_, call_name, statistics_scope,
-                              *access_tskv_logger, span_->Get()},
+                              *access_tskv_logger, span_->Get(),
+                              arena_ ? &*arena_ : nullptr},
                    raw_responder_);
     auto do_call = [&] {
       if constexpr (std::is_same_v<InitialRequest, NoInitialRequest>) {
         (service.*service_method)(responder);
       } else {
-        (service.*service_method)(responder, std::move(initial_request_));
+        (service.*service_method)(responder, std::move(*initial_request_));
       }
     };
 
     try {
       ::google::protobuf::Message* initial_request = nullptr;
       if constexpr (!std::is_same_v<InitialRequest, NoInitialRequest>) {
-        initial_request = &initial_request_;
+        initial_request = initial_request_;
       }
 
       auto& middlewares = method_data_.service_data.settings.middlewares;
@@ -214,8 +243,12 @@ class CallData final {
 
   MethodData<GrpcppService, CallTraits> method_data_;
 
+  // The arena must outlive the messages allocated in it
+  std::optional<google::protobuf::Arena> arena_;
+  std::optional<InitialRequest> heap_initial_request_;
+  InitialRequest* initial_request_{nullptr};
+
   grpc::ServerContext context_{};
-  InitialRequest initial_request_{};
   RawCall raw_responder_{&context_};
   ugrpc::impl::AsyncMethodInvocation prepare_;
   std::optional<tracing::InPlaceSpan> span_{};
@@ -3,6 +3,10 @@
 /// @file userver/ugrpc/server/rpc.hpp
 /// @brief Classes representing an incoming RPC
 
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
 #include <grpcpp/impl/codegen/proto_utils.h>
 #include <grpcpp/server_context.h>
 
@@ -52,6 +56,12 @@ class CallAnyBase {
 
   tracing::Span& GetSpan() { return params_.call_span; }
 
+  /// @returns the arena that owns the request messages of this RPC, or
+  /// `nullptr` if `use-arena` is disabled for the service. Responses may be
+  /// allocated on it using `google::protobuf::Arena::CreateMessage`, they
+  /// must not outlive the handler call.
+  google::protobuf::Arena* GetArena() { return params_.arena; }
+
   virtual bool IsFinished() const = 0;
 
   /// @cond
@@ -156,6 +166,19 @@ class InputStream final : public CallAnyBase {
   State state_{State::kOpen};
 };
 
+/// @brief Limits for coalescing of the server stream writes, see
+/// OutputStream::SetWriteBuffering
+struct WriteBufferingConfig final {
+  /// Flush once this many messages are buffered
+  std::size_t max_messages{64};
+
+  /// Flush once the buffered messages take this many bytes
+  std::size_t max_bytes{64 * 1024};
+
+  /// Flush on the next write if the oldest buffered message is this old
+  std::chrono::milliseconds max_delay{5};
+};
+
 /// @brief Controls a single request -> response stream RPC
 ///
 /// This class is not thread-safe except for `GetContext`.
@@ -172,6 +195,27 @@ class OutputStream final : public CallAnyBase {
   /// @throws ugrpc::server::RpcError on an RPC error
   void Write(const Response& response);
 
+  /// @brief Coalesce the subsequent writes into fewer network writes
+  ///
+  /// By default each `Write` waits until the message is handed over to the
+  /// network, which limits the throughput of streams of small messages. With
+  /// buffering enabled, the messages are passed to gRPC with `buffer_hint`
+  /// and the stream is flushed once any of the `config` limits is reached,
+  /// on `Flush` and on `Finish`. At most the last written message is kept
+  /// (copied) in the stream until the next write or flush.
+  ///
+  /// `max_delay` is only checked on `Write`. Call `Flush` when no more
+  /// messages are expected soon, e.g. in event subscription scenarios,
+  /// otherwise the buffered messages are not delivered until the next write.
+  ///
+  /// @param config the limits, `std::nullopt` disables buffering and flushes
+  /// @throws ugrpc::server::RpcError on an RPC error
+  void SetWriteBuffering(std::optional<WriteBufferingConfig> config);
+
+  /// @brief Send the messages buffered by `SetWriteBuffering` to the network
+  /// @throws ugrpc::server::RpcError on an RPC error
+  void Flush();
+
   /// @brief Complete the RPC successfully
   ///
   /// `Finish` must not be called multiple times.
@@ -210,8 +254,20 @@ class OutputStream final : public CallAnyBase {
  private:
   enum class State { kNew, kOpen, kFinished };
 
+  // Writes the pending message, if any, either with 'buffer_hint' or with a
+  // flush
+  void WritePending(bool flush);
+
   impl::RawWriter<Response>& stream_;
   State state_{State::kNew};
+
+  std::optional<WriteBufferingConfig> buffering_;
+  // The last written message is held back, so that it can be sent without
+  // 'buffer_hint' on a flush
+  std::optional<Response> pending_;
+  std::size_t buffered_messages_{0};
+  std::size_t buffered_bytes_{0};
+  std::chrono::steady_clock::time_point buffered_since_;
 };
 
 /// @brief Controls a request stream -> response stream RPC
@@ -394,17 +450,76 @@ void OutputStream<Response>::Write(const Response& response) {
   // streams
   impl::SendInitialMetadataIfNew(stream_, GetCallName(), state_);
 
-  // Don't buffer writes, otherwise in an event subscription scenario, events
-  // may never actually be delivered
+  if (!buffering_) {
+    // Don't buffer writes, otherwise in an event subscription scenario, events
+    // may never actually be delivered
+    grpc::WriteOptions write_options{};
+
+    impl::Write(stream_, response, write_options, GetCallName());
+    return;
+  }
+
+  if (pending_) {
+    const bool flush =
+        buffered_messages_ >= buffering_->max_messages ||
+        buffered_bytes_ >= buffering_->max_bytes ||
+        std::chrono::steady_clock::now() - buffered_since_ >=
+            buffering_->max_delay;
+    WritePending(flush);
+  }
+
+  if (buffered_messages_ == 0) {
+    buffered_since_ = std::chrono::steady_clock::now();
+  }
+  pending_.emplace(response);
+  ++buffered_messages_;
+  buffered_bytes_ += response.ByteSizeLong();
+}
+
+template <typename Response>
+void OutputStream<Response>::SetWriteBuffering(
+    std::optional<WriteBufferingConfig> config) {
+  UINVARIANT(state_ != State::kFinished,
+             "'SetWriteBuffering' called on a finished stream");
+  if (!config) WritePending(/*flush=*/true);
+  buffering_ = config;
+}
+
+template <typename Response>
+void OutputStream<Response>::Flush() {
+  UINVARIANT(state_ != State::kFinished, "'Flush' called on a finished stream");
+  WritePending(/*flush=*/true);
+}
+
+template <typename Response>
+void OutputStream<Response>::WritePending(bool flush) {
+  if (!pending_) return;
+
   grpc::WriteOptions write_options{};
+  if (!flush) write_options.set_buffer_hint();
 
-  impl::Write(stream_, response, write_options, GetCallName());
+  impl::Write(stream_, *pending_, write_options, GetCallName());
+  pending_.reset();
+  if (flush) {
+    buffered_messages_ = 0;
+    buffered_bytes_ = 0;
+  }
 }
 
 template <typename Response>
 void OutputStream<Response>::Finish() {
   UINVARIANT(state_ != State::kFinished,
              "'Finish' called on a finished stream");
+  if (pending_) {
+    // The last buffered message is sent together with the status
+    const auto response = std::move(*pending_);
+    pending_.reset();
+    WriteAndFinish(response);
+    Statistics().OnExplicitFinish(grpc::StatusCode::OK);
+    ugrpc::impl::UpdateSpanWithStatus(GetSpan(), grpc::Status::OK);
+    return;
+  }
+
   state_ = State::kFinished;
   const auto status = grpc::Status::OK;
   LogFinish(status);
@@ -418,6 +533,8 @@ void OutputStream<Response>::FinishWithError(const grpc::Status& status) {
   UASSERT(!status.ok());
   UINVARIANT(state_ != State::kFinished,
              "'Finish' called on a finished stream");
+  // The messages written before the error are still delivered
+  WritePending(/*flush=*/false);
   state_ = State::kFinished;
   LogFinish(status);
   impl::Finish(stream_, status, GetCallName());
@@ -429,6 +546,7 @@ template <typename Response>
 void OutputStream<Response>::WriteAndFinish(const Response& response) {
   UINVARIANT(state_ != State::kFinished,
              "'WriteAndFinish' called on a finished stream");
+  WritePending(/*flush=*/false);
   state_ = State::kFinished;
 
   // Don't buffer writes, otherwise in an event subscription scenario, events
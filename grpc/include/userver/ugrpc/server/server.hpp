@@ -18,7 +18,9 @@
 #include <userver/utils/statistics/fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
+#include <userver/ugrpc/impl/completion_queues.hpp>
 #include <userver/ugrpc/impl/statistics.hpp>
+#include <userver/ugrpc/server/generic_service_base.hpp>
 #include <userver/ugrpc/server/middlewares/fwd.hpp>
 #include <userver/ugrpc/server/service_base.hpp>
 
@@ -74,6 +76,11 @@ class Server final {
   /// least until `Stop` is called.
   void AddService(ServiceBase& service, ServiceConfig&& config);
 
+  /// @brief Register a generic service implementation in the server, see
+  /// ugrpc::server::GenericServiceBase. The same lifetime requirements apply.
+  /// @note At most one generic service may be registered.
+  void AddService(GenericServiceBase& service, ServiceConfig&& config);
+
   /// @brief Get names of all registered services
   std::vector<std::string_view> GetServiceNames() const;
 
@@ -87,6 +94,12 @@ class Server final {
   /// usually no more than one instance per program.
   grpc::CompletionQueue& GetCompletionQueue() noexcept;
 
+  /// @returns all the completion queues of the server, each one is drained by
+  /// its own thread. Clients may be spread across them to avoid a single
+  /// polling thread becoming a bottleneck.
+  /// @note The same lifetime restrictions as for GetCompletionQueue apply.
+  const ugrpc::impl::CompletionQueues& GetCompletionQueues() noexcept;
+
   /// @brief Start accepting requests
   /// @note Must be called at most once after all the services are registered
   void Start();
@@ -19,6 +19,11 @@ struct ServiceConfig final {
 
   /// Server middlewares to use for the gRPC service.
   Middlewares middlewares;
+
+  /// Allocate the request messages of each call in a google::protobuf::Arena
+  /// owned by the call. Reduces the allocation and destruction overhead of
+  /// deeply nested messages.
+  bool use_arena{false};
 };
 
 /// @brief The type-erased base class for all gRPC service implementations
@@ -8,6 +8,7 @@
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 
+#include <userver/ugrpc/server/generic_service_base.hpp>
 #include <userver/ugrpc/server/middlewares/fwd.hpp>
 #include <userver/ugrpc/server/service_base.hpp>
 
@@ -28,6 +29,7 @@ class ServerComponent;
 /// ---- | ----------- | -------------
 /// task-processor | the task processor to use for responses | taken from grpc-server.service-defaults
 /// middlewares | middleware component names to use for each RPC call, can be empty array ([]) | taken from grpc-server.service-defaults
+/// use-arena | allocate request messages in a per-call google::protobuf::Arena, sized by the average arena usage of the previous calls of the method | taken from grpc-server.service-defaults or false
 
 // clang-format on
 
@@ -43,12 +45,66 @@ class ServiceComponentBase : public components::LoggableComponentBase {
   /// RegisterService with it
   void RegisterService(ServiceBase& service);
 
+  /// @overload
+  void RegisterService(GenericServiceBase& service);
+
  private:
   ServerComponent& server_;
   ServiceConfig config_;
   std::atomic<bool> registered_{false};
 };
 
+// clang-format off
+
+/// @ingroup userver_components userver_base_classes
+///
+/// @brief Base class for a component that handles the RPCs with dynamic
+/// method names, see ugrpc::server::GenericServiceBase.
+///
+/// ## Static options:
+/// The same as for ugrpc::server::ServiceComponentBase.
+///
+/// ## Example:
+/// @code
+/// class ProxyService final : public ugrpc::server::GenericServiceComponentBase {
+///  public:
+///   ProxyService(const components::ComponentConfig& config,
+///                const components::ComponentContext& context)
+///       : GenericServiceComponentBase(config, context),
+///         client_(context.FindComponent<ugrpc::client::ClientFactoryComponent>()
+///                     .GetFactory()
+///                     .MakeClient<ugrpc::client::GenericClient>(
+///                         "upstream", config["upstream-endpoint"].As<std::string>())) {}
+///
+///   void Handle(Call& call) override {
+///     grpc::ByteBuffer request;
+///     if (!call.Read(request)) return;
+///     auto response = client_.UnaryCall(call.GetCallName(), request).Finish();
+///     call.WriteAndFinish(response);
+///   }
+///
+///  private:
+///   ugrpc::client::GenericClient client_;
+/// };
+/// @endcode
+
+// clang-format on
+
+// NOLINTNEXTLINE(fuchsia-multiple-inheritance)
+class GenericServiceComponentBase : public ServiceComponentBase,
+                                    public GenericServiceBase {
+ public:
+  GenericServiceComponentBase(const components::ComponentConfig& config,
+                              const components::ComponentContext& context)
+      : ServiceComponentBase(config, context) {
+    // See the comment in impl::ServiceComponentBase
+    RegisterService(static_cast<GenericServiceBase&>(*this));
+  }
+
+ private:
+  using ServiceComponentBase::RegisterService;
+};
+
 namespace impl {
 
 template <typename ServiceInterface>
@@ -0,0 +1,41 @@
+#include <userver/ugrpc/byte_buffer_utils.hpp>
+
+#include <stdexcept>
+
+#include <grpcpp/impl/codegen/proto_buffer_reader.h>
+#include <grpcpp/impl/codegen/proto_buffer_writer.h>
+#include <grpcpp/impl/codegen/proto_utils.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc {
+
+grpc::ByteBuffer SerializeToByteBuffer(
+    const google::protobuf::Message& message) {
+  grpc::ByteBuffer buffer;
+  bool own_buffer = false;
+  const auto status =
+      grpc::GenericSerialize<grpc::ProtoBufferWriter,
+                             google::protobuf::Message>(message, &buffer,
+                                                        &own_buffer);
+  if (!status.ok()) {
+    throw std::runtime_error("Failed to serialize " +
+                             message.GetTypeName() + ": " +
+                             status.error_message());
+  }
+  return buffer;
+}
+
+bool ParseFromByteBuffer(const grpc::ByteBuffer& buffer,
+                         google::protobuf::Message& message) {
+  // GenericDeserialize clears the buffer it is given, so parse from a copy.
+  // Copying a ByteBuffer only increments the slice reference counts.
+  grpc::ByteBuffer copy{buffer};
+  return grpc::GenericDeserialize<grpc::ProtoBufferReader,
+                                  google::protobuf::Message>(&copy, &message)
+      .ok();
+}
+
+}  // namespace ugrpc
+
+USERVER_NAMESPACE_END
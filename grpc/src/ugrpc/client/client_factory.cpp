@@ -2,11 +2,15 @@
 
 #include <optional>
 #include <stdexcept>
+#include <utility>
 
 #include <fmt/format.h>
 
 #include <userver/engine/async.hpp>
 #include <userver/logging/level_serialization.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
 #include <userver/utils/trivial_map.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
@@ -80,6 +84,11 @@ ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
       value["native-log-level"].As<logging::Level>(config.native_log_level);
   config.channel_count =
       value["channel-count"].As<std::size_t>(config.channel_count);
+  config.max_channel_count =
+      value["max-channel-count"].As<std::size_t>(config.max_channel_count);
+  config.channel_in_flight_threshold =
+      value["channel-in-flight-threshold"].As<std::size_t>(
+          config.channel_in_flight_threshold);
 
   return config;
 }
@@ -91,20 +100,41 @@ ClientFactory::ClientFactory(ClientFactoryConfig&& config,
                              utils::statistics::Storage& statistics_storage,
                              testsuite::GrpcControl& testsuite_grpc,
                              dynamic_config::Source source)
+    : ClientFactory(std::move(config), channel_task_processor, std::move(mws),
+                    ugrpc::impl::CompletionQueues{{&queue}},
+                    statistics_storage, testsuite_grpc, source) {}
+
+ClientFactory::ClientFactory(ClientFactoryConfig&& config,
+                             engine::TaskProcessor& channel_task_processor,
+                             MiddlewareFactories mws,
+                             const ugrpc::impl::CompletionQueues& queues,
+                             utils::statistics::Storage& statistics_storage,
+                             testsuite::GrpcControl& testsuite_grpc,
+                             dynamic_config::Source source)
     : channel_task_processor_(channel_task_processor),
       mws_(mws),
-      queue_(queue),
+      queues_(queues),
       channel_cache_(testsuite_grpc.IsTlsEnabled()
                          ? config.credentials
                          : grpc::InsecureChannelCredentials(),
-                     config.channel_args, config.channel_count),
+                     config.channel_args, config.channel_count,
+                     config.max_channel_count,
+                     config.channel_in_flight_threshold),
       client_statistics_storage_(statistics_storage, "client"),
       config_source_(source),
       testsuite_grpc_(testsuite_grpc) {
+  UINVARIANT(!queues_.queues.empty(), "No completion queues passed");
   ugrpc::impl::SetupNativeLogging();
   ugrpc::impl::UpdateNativeLogLevel(config.native_log_level);
+
+  channel_statistics_holder_ = statistics_storage.RegisterWriter(
+      "grpc.client.channels", [this](utils::statistics::Writer& writer) {
+        channel_cache_.WriteStatistics(writer);
+      });
 }
 
+ClientFactory::~ClientFactory() { channel_statistics_holder_.Unregister(); }
+
 impl::ChannelCache::Token ClientFactory::GetChannel(
     const std::string& endpoint) {
   // Spawn a blocking task creating a gRPC channel
@@ -114,6 +144,11 @@ impl::ChannelCache::Token ClientFactory::GetChannel(
       .Get();
 }
 
+grpc::CompletionQueue& ClientFactory::GetNextQueue() noexcept {
+  const auto index = next_queue_.fetch_add(1, std::memory_order_relaxed);
+  return *queues_.queues[index % queues_.queues.size()];
+}
+
 }  // namespace ugrpc::client
 
 USERVER_NAMESPACE_END
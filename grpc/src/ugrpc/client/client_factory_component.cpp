@@ -20,13 +20,13 @@ ClientFactoryComponent::ClientFactoryComponent(
   auto& task_processor =
       context.GetTaskProcessor(config["task-processor"].As<std::string>());
 
-  grpc::CompletionQueue* queue = nullptr;
+  const ugrpc::impl::CompletionQueues* queues = nullptr;
   if (auto* const server =
           context.FindComponentOptional<ugrpc::server::ServerComponent>()) {
-    queue = &server->GetServer().GetCompletionQueue();
+    queues = &server->GetServer().GetCompletionQueues();
   } else {
-    queue_.emplace();
-    queue = &queue_->GetQueue();
+    queue_.emplace(config["completion-queue-count"].As<std::size_t>(1));
+    queues = &queue_->GetQueues();
   }
 
   auto& statistics_storage =
@@ -45,7 +45,7 @@ ClientFactoryComponent::ClientFactoryComponent(
     mws.push_back(component.GetMiddlewareFactory());
   }
   factory_.emplace(config.As<ClientFactoryConfig>(), task_processor, mws,
-                   *queue, statistics_storage, testsuite_grpc, config_source);
+                   *queues, statistics_storage, testsuite_grpc, config_source);
 }
 
 ClientFactory& ClientFactoryComponent::GetFactory() { return *factory_; }
@@ -95,6 +95,25 @@ properties:
         description: |
             Number of channels created for each endpoint.
         defaultDescription: 1
+    max-channel-count:
+        type: integer
+        description: |
+            Number of channels per endpoint may grow up to this value if all
+            the channels are loaded above channel-in-flight-threshold.
+        defaultDescription: channel-count
+    channel-in-flight-threshold:
+        type: integer
+        description: |
+            Calls in flight per channel, after which a new channel is added.
+        defaultDescription: 100
+        minimum: 1
+    completion-queue-count:
+        type: integer
+        description: |
+            Number of completion queues to create if there is no gRPC server
+            in the service. Otherwise the queues of the server are used.
+        defaultDescription: 1
+        minimum: 1
     middlewares:
         type: array
         items:
@@ -0,0 +1,62 @@
+#include <userver/ugrpc/client/generic.hpp>
+
+#include <string>
+
+#include <grpcpp/generic/generic_stub.h>
+
+#include <userver/ugrpc/client/impl/call_params.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+namespace {
+
+constexpr std::string_view kGenericServiceName = "Generic";
+constexpr std::string_view kGenericMethodFullNames[] = {"Generic/Generic"};
+constexpr std::size_t kGenericMethodId = 0;
+
+// Mimics a generated grpcpp service for impl::ClientData
+struct GenericService final {
+  using Stub = grpc::GenericStub;
+
+  static std::unique_ptr<Stub> NewStub(
+      const std::shared_ptr<grpc::Channel>& channel) {
+    return std::make_unique<Stub>(channel);
+  }
+};
+
+}  // namespace
+
+GenericClient::GenericClient(impl::ClientParams&& client_params)
+    : impl_(std::move(client_params), GetMetadata(),
+            std::in_place_type<GenericService>) {}
+
+ugrpc::client::UnaryCall<grpc::ByteBuffer> GenericClient::UnaryCall(
+    std::string_view call_name, const grpc::ByteBuffer& request,
+    std::unique_ptr<grpc::ClientContext> context, const Qos& qos) const {
+  ApplyQos(*context, qos, impl_.GetTestsuiteControl());
+
+  auto call_params =
+      impl::DoCreateCallParams(impl_, kGenericMethodId, std::move(context));
+  call_params.call_name = call_name;
+
+  auto& stub = impl_.GetStub<GenericService>(call_params.channel_index);
+  const std::string method = "/" + std::string{call_name};
+
+  return {std::move(call_params),
+          [&](grpc::ClientContext* client_context,
+              grpc::CompletionQueue* queue) {
+            return stub.PrepareUnaryCall(client_context, method, request,
+                                         queue);
+          },
+          nullptr};
+}
+
+ugrpc::impl::StaticServiceMetadata GenericClient::GetMetadata() {
+  return {kGenericServiceName, kGenericMethodFullNames};
+}
+
+}  // namespace ugrpc::client
+
+USERVER_NAMESPACE_END
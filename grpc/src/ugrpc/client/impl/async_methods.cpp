@@ -93,7 +93,8 @@ RpcData::RpcData(impl::CallParams&& params)
       stats_scope_(params.statistics),
       queue_(params.queue),
       config_values_(params.config),
-      mws_(params.mws) {
+      mws_(params.mws),
+      in_flight_(std::move(params.in_flight)) {
   UASSERT(context_);
   UASSERT(!client_name_.empty());
   SetupSpan(span_, *context_, call_name_);
@@ -165,6 +166,7 @@ void RpcData::SetFinished() noexcept {
   UASSERT(context_);
   UINVARIANT(!is_finished_, "Tried to finish already finished call");
   is_finished_ = true;
+  in_flight_.Release();
 }
 
 bool RpcData::IsFinished() const noexcept {
@@ -7,13 +7,17 @@ namespace ugrpc::client::impl {
 CallParams DoCreateCallParams(const ClientData& client_data,
                               std::size_t method_id,
                               std::unique_ptr<grpc::ClientContext> context) {
+  const auto& channel_token = client_data.GetChannelToken();
+  const auto channel_index = channel_token.SelectChannel();
   return CallParams{client_data.GetClientName(),
                     client_data.GetQueue(),
                     client_data.GetConfigSnapshot(),
                     client_data.GetMetadata().method_full_names[method_id],
                     std::move(context),
                     client_data.GetStatistics(method_id),
-                    client_data.GetMiddlewares()};
+                    client_data.GetMiddlewares(),
+                    channel_index,
+                    channel_token.StartCall(channel_index)};
 }
 
 }  // namespace ugrpc::client::impl
@@ -1,12 +1,15 @@
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
 
 #include <algorithm>
+#include <string>
 #include <utility>
 
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
 #include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 #include <ugrpc/impl/to_string.hpp>
 
@@ -14,6 +17,51 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client::impl {
 
+namespace {
+
+grpc::ChannelArguments MakeChannelArgs(grpc::ChannelArguments channel_args,
+                                       std::size_t max_channel_count) {
+  if (max_channel_count > 1) {
+    // Otherwise the channels share the subchannels and HTTP/2 connections
+    channel_args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+  }
+  return channel_args;
+}
+
+// '@name' is a unix socket in the abstract namespace, as in the server
+// listener and clients::http::Request::unix_socket_path
+std::string MakeGrpcTarget(const std::string& endpoint) {
+  if (!endpoint.empty() && endpoint[0] == '@') {
+    return "unix-abstract:" + endpoint.substr(1);
+  }
+  return endpoint;
+}
+
+}  // namespace
+
+ChannelCache::InFlightGuard::InFlightGuard(
+    std::shared_ptr<std::atomic<std::size_t>> in_flight)
+    : in_flight_(std::move(in_flight)) {
+  UASSERT(in_flight_);
+  in_flight_->fetch_add(1, std::memory_order_relaxed);
+}
+
+ChannelCache::InFlightGuard& ChannelCache::InFlightGuard::operator=(
+    InFlightGuard&& other) noexcept {
+  if (this == &other) return *this;
+  Release();
+  in_flight_ = std::move(other.in_flight_);
+  return *this;
+}
+
+ChannelCache::InFlightGuard::~InFlightGuard() { Release(); }
+
+void ChannelCache::InFlightGuard::Release() noexcept {
+  if (!in_flight_) return;
+  in_flight_->fetch_sub(1, std::memory_order_relaxed);
+  in_flight_.reset();
+}
+
 ChannelCache::Token::Token(ChannelCache& cache, const std::string& endpoint,
                            CountedChannel& counted_channel) noexcept
     : cache_(&cache), endpoint_(&endpoint), counted_channel_(&counted_channel) {
@@ -46,45 +94,131 @@ ChannelCache::Token::~Token() {
 const std::shared_ptr<grpc::Channel>& ChannelCache::Token::GetChannel(
     std::size_t index) const noexcept {
   UASSERT(counted_channel_);
-  UASSERT(index < counted_channel_->channels.size());
-  return counted_channel_->channels[index];
+  UASSERT(index < counted_channel_->channels->size());
+  return (*counted_channel_->channels)[index].channel;
 }
 
 std::size_t ChannelCache::Token::GetChannelCount() const noexcept {
   UASSERT(counted_channel_);
-  return counted_channel_->channels.size();
+  return counted_channel_->active_count.load(std::memory_order_acquire);
+}
+
+std::size_t ChannelCache::Token::GetMaxChannelCount() const noexcept {
+  UASSERT(counted_channel_);
+  return counted_channel_->channels->size();
+}
+
+std::size_t ChannelCache::Token::SelectChannel() const noexcept {
+  UASSERT(cache_);
+  UASSERT(counted_channel_);
+  const auto& channels = *counted_channel_->channels;
+  auto active_count =
+      counted_channel_->active_count.load(std::memory_order_acquire);
+  if (active_count == 1 && channels.size() == 1) return 0;
+
+  // Start from a random channel not to favor the first ones on ties
+  const auto start = utils::RandRange(active_count);
+  std::size_t best = start;
+  auto best_in_flight =
+      channels[start].in_flight.load(std::memory_order_relaxed);
+  for (std::size_t i = 1; i < active_count && best_in_flight != 0; ++i) {
+    const auto index = (start + i) % active_count;
+    const auto in_flight =
+        channels[index].in_flight.load(std::memory_order_relaxed);
+    if (in_flight < best_in_flight) {
+      best = index;
+      best_in_flight = in_flight;
+    }
+  }
+
+  if (best_in_flight >= cache_->channel_in_flight_threshold_ &&
+      active_count < channels.size() &&
+      counted_channel_->active_count.compare_exchange_strong(
+          active_count, active_count + 1, std::memory_order_acq_rel)) {
+    // The channel has been created beforehand. It stays idle and does not
+    // connect until the first call.
+    return active_count;
+  }
+  return best;
+}
+
+ChannelCache::InFlightGuard ChannelCache::Token::StartCall(
+    std::size_t index) const {
+  UASSERT(counted_channel_);
+  UASSERT(index < counted_channel_->channels->size());
+  const auto& channels = counted_channel_->channels;
+  return InFlightGuard{std::shared_ptr<std::atomic<std::size_t>>(
+      channels, &(*channels)[index].in_flight)};
 }
 
 ChannelCache::CountedChannel::CountedChannel(
     const std::string& endpoint,
     const std::shared_ptr<grpc::ChannelCredentials>& credentials,
-    const grpc::ChannelArguments& channel_args, std::size_t count) {
-  const auto endpoint_string = ugrpc::impl::ToGrpcString(endpoint);
-  channels = utils::GenerateFixedArray(count, [&](std::size_t) {
-    return grpc::CreateCustomChannel(endpoint_string, credentials,
-                                     channel_args);
-  });
+    const grpc::ChannelArguments& channel_args, std::size_t count,
+    std::size_t max_count)
+    : active_count(count) {
   UASSERT(count > 0);
+  UASSERT(count <= max_count);
+  const auto endpoint_string =
+      ugrpc::impl::ToGrpcString(MakeGrpcTarget(endpoint));
+  channels = std::make_shared<ChannelSlots>(
+      utils::GenerateFixedArray(max_count, [&](std::size_t) {
+        return ChannelSlot{
+            grpc::CreateCustomChannel(endpoint_string, credentials,
+                                      channel_args),
+        };
+      }));
 }
 
 ChannelCache::ChannelCache(
     std::shared_ptr<grpc::ChannelCredentials>&& credentials,
-    const grpc::ChannelArguments& channel_args, std::size_t channel_count)
+    const grpc::ChannelArguments& channel_args, std::size_t channel_count,
+    std::size_t max_channel_count, std::size_t channel_in_flight_threshold)
     : credentials_(std::move(credentials)),
-      channel_args_(channel_args),
-      channel_count_(channel_count) {
+      channel_args_(MakeChannelArgs(
+          channel_args, std::max(channel_count, max_channel_count))),
+      channel_count_(channel_count),
+      max_channel_count_(std::max(channel_count, max_channel_count)),
+      channel_in_flight_threshold_(channel_in_flight_threshold) {
   UINVARIANT(channel_count > 0, "Channels count must be greater than zero");
+  UINVARIANT(channel_in_flight_threshold > 0,
+             "Channel in-flight threshold must be greater than zero");
 }
 
+ChannelCache::ChannelCache(
+    std::shared_ptr<grpc::ChannelCredentials>&& credentials,
+    const grpc::ChannelArguments& channel_args, std::size_t channel_count)
+    : ChannelCache(std::move(credentials), channel_args, channel_count,
+                   channel_count, 1) {}
+
 ChannelCache::~ChannelCache() = default;
 
 ChannelCache::Token ChannelCache::Get(const std::string& endpoint) {
   auto channels = channels_.Lock();
-  const auto [it, _] = channels->try_emplace(endpoint, endpoint, credentials_,
-                                             channel_args_, channel_count_);
+  const auto [it, _] =
+      channels->try_emplace(endpoint, endpoint, credentials_, channel_args_,
+                            channel_count_, max_channel_count_);
   return {*this, it->first, it->second};
 }
 
+void ChannelCache::WriteStatistics(utils::statistics::Writer& writer) const {
+  const auto channels = channels_.Lock();
+  for (const auto& [endpoint, counted_channel] : *channels) {
+    const utils::statistics::LabelView endpoint_label{"endpoint", endpoint};
+    const auto active_count =
+        counted_channel.active_count.load(std::memory_order_relaxed);
+    writer["channel-count"].ValueWithLabels(active_count, endpoint_label);
+
+    for (std::size_t i = 0; i < active_count; ++i) {
+      const auto index = std::to_string(i);
+      writer["in-flight"].ValueWithLabels(
+          (*counted_channel.channels)[i].in_flight.load(
+              std::memory_order_relaxed),
+          {endpoint_label, {"channel", index}});
+    }
+  }
+}
+
 }  // namespace ugrpc::client::impl
 
 USERVER_NAMESPACE_END
@@ -1,21 +1,50 @@
 #include <userver/ugrpc/client/queue_holder.hpp>
 
+#include <memory>
+
 #include <userver/ugrpc/impl/queue_runner.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client {
 
+namespace {
+
+struct QueueSubHolder final {
+  std::unique_ptr<grpc::CompletionQueue> queue{
+      std::make_unique<grpc::CompletionQueue>()};
+  ugrpc::impl::QueueRunner queue_runner{*queue};
+};
+
+}  // namespace
+
 struct QueueHolder::Impl final {
-  grpc::CompletionQueue queue;
-  ugrpc::impl::QueueRunner queue_runner{queue};
+  explicit Impl(std::size_t queue_count)
+      : queue(utils::GenerateFixedArray(
+            queue_count, [](std::size_t) { return QueueSubHolder{}; })) {
+    for (auto& subholder : queue)
+      queues.queues.push_back(subholder.queue.get());
+  }
+
+  utils::FixedArray<QueueSubHolder> queue;
+  ugrpc::impl::CompletionQueues queues;
 };
 
-QueueHolder::QueueHolder() = default;
+QueueHolder::QueueHolder(std::size_t queue_count) : impl_(queue_count) {
+  UINVARIANT(queue_count >= 1, "At least one completion queue is required");
+}
 
 QueueHolder::~QueueHolder() = default;
 
-grpc::CompletionQueue& QueueHolder::GetQueue() { return impl_->queue; }
+grpc::CompletionQueue& QueueHolder::GetQueue() {
+  return *impl_->queue[0].queue;
+}
+
+const ugrpc::impl::CompletionQueues& QueueHolder::GetQueues() {
+  return impl_->queues;
+}
 
 }  // namespace ugrpc::client
 
@@ -2,6 +2,8 @@
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/enumerate.hpp>
+#include <userver/utils/statistics/impl/sharding.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/writer.hpp>
 #include <userver/utils/underlying_value.hpp>
 
@@ -30,15 +32,46 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["v2"] = stats.value;
 }
 
+// StatusCode enum cases have consecutive underlying values, starting from 0.
+// UNAUTHENTICATED currently has the largest value.
+constexpr std::size_t kCodesCount =
+    static_cast<std::size_t>(grpc::StatusCode::UNAUTHENTICATED) + 1;
+
+// Keeps the shards of different CPUs on different cache lines
+constexpr std::size_t kCacheLineSize = 64;
+
 }  // namespace
 
-MethodStatistics::MethodStatistics() = default;
+struct alignas(kCacheLineSize) MethodStatistics::CountersShard final {
+  using RateCounter = utils::statistics::RateCounter;
+
+  RateCounter started{0};
+  std::array<RateCounter, kCodesCount> status_codes{};
+  RateCounter network_errors{0};
+  RateCounter internal_errors{0};
+  RateCounter cancelled{0};
+
+  RateCounter deadline_updated{0};
+  RateCounter deadline_cancelled{0};
+};
 
-void MethodStatistics::AccountStarted() noexcept { ++started_; }
+MethodStatistics::MethodStatistics()
+    : shards_(std::make_unique<CountersShard[]>(
+          utils::statistics::impl::GetShardCount())) {}
+
+MethodStatistics::~MethodStatistics() = default;
+
+MethodStatistics::CountersShard& MethodStatistics::GetCurrentShard() noexcept {
+  return shards_[utils::statistics::impl::GetCurrentShard()];
+}
+
+void MethodStatistics::AccountStarted() noexcept {
+  ++GetCurrentShard().started;
+}
 
 void MethodStatistics::AccountStatus(grpc::StatusCode code) noexcept {
   if (static_cast<std::size_t>(code) < kCodesCount) {
-    ++status_codes_[static_cast<std::size_t>(code)];
+    ++GetCurrentShard().status_codes[static_cast<std::size_t>(code)];
   } else {
     LOG_ERROR() << "Invalid grpc::StatusCode " << utils::UnderlyingValue(code);
   }
@@ -49,32 +82,58 @@ void MethodStatistics::AccountTiming(
   timings_.GetCurrentCounter().Account(timing.count());
 }
 
-void MethodStatistics::AccountNetworkError() noexcept { ++network_errors_; }
+void MethodStatistics::AccountNetworkError() noexcept {
+  ++GetCurrentShard().network_errors;
+}
 
-void MethodStatistics::AccountInternalError() noexcept { ++internal_errors_; }
+void MethodStatistics::AccountInternalError() noexcept {
+  ++GetCurrentShard().internal_errors;
+}
 
 void MethodStatistics::AccountCancelledByDeadlinePropagation() noexcept {
-  ++deadline_cancelled_;
+  ++GetCurrentShard().deadline_cancelled;
 }
 
 void MethodStatistics::AccountDeadlinePropagated() noexcept {
-  ++deadline_updated_;
+  ++GetCurrentShard().deadline_updated;
 }
 
-void MethodStatistics::AccountCancelled() noexcept { ++cancelled_; }
+void MethodStatistics::AccountCancelled() noexcept {
+  ++GetCurrentShard().cancelled;
+}
 
 void DumpMetric(utils::statistics::Writer& writer,
                 const MethodStatistics& stats) {
   writer["timings"] = stats.timings_;
 
-  utils::statistics::Rate total_requests{0};
-  utils::statistics::Rate error_requests{0};
+  using utils::statistics::Rate;
+  Rate started_value{0};
+  std::array<Rate, kCodesCount> status_codes_values{};
+  Rate network_errors_value{0};
+  Rate abandoned_errors_value{0};
+  Rate cancelled_value{0};
+  Rate deadline_updated_value{0};
+  Rate deadline_cancelled_value{0};
+  for (std::size_t i = 0; i < utils::statistics::impl::GetShardCount(); ++i) {
+    const auto& shard = stats.shards_[i];
+    started_value += shard.started.Load();
+    for (std::size_t code = 0; code < kCodesCount; ++code) {
+      status_codes_values[code] += shard.status_codes[code].Load();
+    }
+    network_errors_value += shard.network_errors.Load();
+    abandoned_errors_value += shard.internal_errors.Load();
+    cancelled_value += shard.cancelled.Load();
+    deadline_updated_value += shard.deadline_updated.Load();
+    deadline_cancelled_value += shard.deadline_cancelled.Load();
+  }
+
+  Rate total_requests{0};
+  Rate error_requests{0};
 
   {
     auto status = writer["status"];
-    for (const auto& [idx, counter] : utils::enumerate(stats.status_codes_)) {
+    for (const auto& [idx, count] : utils::enumerate(status_codes_values)) {
       const auto code = static_cast<grpc::StatusCode>(idx);
-      const auto count = counter.Load();
       total_requests += count;
       if (code != grpc::StatusCode::OK) error_requests += count;
       status.ValueWithLabels(AsRateAndGauge{count},
@@ -82,11 +141,6 @@ void DumpMetric(utils::statistics::Writer& writer,
     }
   }
 
-  const auto network_errors_value = stats.network_errors_.Load();
-  const auto abandoned_errors_value = stats.internal_errors_.Load();
-  const auto deadline_cancelled_value = stats.deadline_cancelled_.Load();
-  const auto cancelled_value = stats.cancelled_.Load();
-
   // 'total_requests' and 'error_requests' originally only count RPCs that
   // finished with a status code. 'network_errors' are RPCs that finished
   // abruptly and didn't produce a status code. But these RPCs still need to
@@ -103,7 +157,7 @@ void DumpMetric(utils::statistics::Writer& writer,
   error_requests += cancelled_value;
 
   // "active" is not a rate metric. Also, beware of overflow
-  writer["active"] = static_cast<std::int64_t>(stats.started_.Load().value) -
+  writer["active"] = static_cast<std::int64_t>(started_value.value) -
                      static_cast<std::int64_t>(total_requests.value);
 
   writer["rps"] = AsRateAndGauge{total_requests};
@@ -113,8 +167,7 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["abandoned-error"] = AsRateAndGauge{abandoned_errors_value};
   writer["cancelled"] = AsRateAndGauge{cancelled_value};
 
-  writer["deadline-propagated"] =
-      AsRateAndGauge{stats.deadline_updated_.Load()};
+  writer["deadline-propagated"] = AsRateAndGauge{deadline_updated_value};
   writer["cancelled-by-deadline-propagation"] =
       AsRateAndGauge{deadline_cancelled_value};
 }
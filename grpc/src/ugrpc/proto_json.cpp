@@ -1,8 +1,25 @@
 #include <userver/ugrpc/proto_json.hpp>
 
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
 #include <grpcpp/support/config.h>
 
+#include <userver/crypto/base64.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/from_string.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -15,8 +32,509 @@ const google::protobuf::util::JsonPrintOptions kOptions = []() {
   options.always_print_primitive_fields = true;
   return options;
 }();
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+constexpr std::string_view kWellKnownPrefix = "google/protobuf/";
+constexpr std::string_view kNullValueType = "google.protobuf.NullValue";
+constexpr std::string_view kValueType = "google.protobuf.Value";
+
+struct FieldPlan final {
+  const FieldDescriptor* field{nullptr};
+  std::string json_name;
+  // unset fields with presence are not written
+  bool has_presence{false};
+  bool is_map{false};
+};
+
+// Everything the transcoding needs to know about a message type
+struct MessagePlan final {
+  explicit MessagePlan(const Descriptor& descriptor) {
+    const auto& file_name = descriptor.file()->name();
+    is_well_known = file_name.substr(0, kWellKnownPrefix.size()) ==
+                    kWellKnownPrefix.data();
+
+    fields.reserve(descriptor.field_count());
+    for (int i = 0; i < descriptor.field_count(); ++i) {
+      const auto* field = descriptor.field(i);
+      FieldPlan plan;
+      plan.field = field;
+      plan.json_name = std::string{field->json_name()};
+      plan.has_presence = field->has_presence();
+      plan.is_map = field->is_map();
+      fields.push_back(std::move(plan));
+    }
+
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+      by_name.emplace(fields[i].json_name, i);
+      by_name.emplace(std::string{fields[i].field->name()}, i);
+    }
+  }
+
+  const FieldPlan* Find(const std::string& name) const {
+    const auto it = by_name.find(name);
+    return it == by_name.end() ? nullptr : &fields[it->second];
+  }
+
+  bool is_well_known{false};
+  std::vector<FieldPlan> fields;
+  std::unordered_map<std::string, std::size_t> by_name;
+};
+
+using MessagePlanPtr = std::shared_ptr<const MessagePlan>;
+
+// The plans are built outside of coroutines as well
+struct PlanCacheTraits final
+    : rcu::DefaultRcuMapTraits<const Descriptor*, const MessagePlan> {
+  using MutexType = std::mutex;
+};
+
+MessagePlanPtr GetPlan(const Descriptor& descriptor) {
+  // Descriptors of the other pools may die, so that their addresses are reused
+  if (descriptor.file()->pool() !=
+      google::protobuf::DescriptorPool::generated_pool()) {
+    return std::make_shared<const MessagePlan>(descriptor);
+  }
+
+  static rcu::RcuMap<const Descriptor*, const MessagePlan, PlanCacheTraits>
+      plans;
+  if (auto plan = plans.Get(&descriptor)) return plan;
+  return plans.TryEmplace(&descriptor, descriptor).value;
+}
+
+[[noreturn]] void ThrowConversionError(const FieldDescriptor& field,
+                                       std::string_view reason) {
+  throw formats::json::ConversionException(
+      fmt::format("Cannot convert field '{}': {}",
+                  std::string{field.full_name()}, reason));
+}
+
+// A singular field or an element of a repeated field
+class FieldReader final {
+ public:
+  FieldReader(const Message& message, const FieldDescriptor& field, int index)
+      : message_(message),
+        reflection_(*message.GetReflection()),
+        field_(field),
+        index_(index) {}
+
+  std::int32_t GetInt32() const {
+    return index_ < 0 ? reflection_.GetInt32(message_, &field_)
+                      : reflection_.GetRepeatedInt32(message_, &field_, index_);
+  }
+  std::int64_t GetInt64() const {
+    return index_ < 0 ? reflection_.GetInt64(message_, &field_)
+                      : reflection_.GetRepeatedInt64(message_, &field_, index_);
+  }
+  std::uint32_t GetUInt32() const {
+    return index_ < 0
+               ? reflection_.GetUInt32(message_, &field_)
+               : reflection_.GetRepeatedUInt32(message_, &field_, index_);
+  }
+  std::uint64_t GetUInt64() const {
+    return index_ < 0
+               ? reflection_.GetUInt64(message_, &field_)
+               : reflection_.GetRepeatedUInt64(message_, &field_, index_);
+  }
+  double GetDouble() const {
+    return index_ < 0
+               ? reflection_.GetDouble(message_, &field_)
+               : reflection_.GetRepeatedDouble(message_, &field_, index_);
+  }
+  float GetFloat() const {
+    return index_ < 0 ? reflection_.GetFloat(message_, &field_)
+                      : reflection_.GetRepeatedFloat(message_, &field_, index_);
+  }
+  bool GetBool() const {
+    return index_ < 0 ? reflection_.GetBool(message_, &field_)
+                      : reflection_.GetRepeatedBool(message_, &field_, index_);
+  }
+  int GetEnumValue() const {
+    return index_ < 0
+               ? reflection_.GetEnumValue(message_, &field_)
+               : reflection_.GetRepeatedEnumValue(message_, &field_, index_);
+  }
+  const std::string& GetString(std::string& scratch) const {
+    return index_ < 0 ? reflection_.GetStringReference(message_, &field_,
+                                                       &scratch)
+                      : reflection_.GetRepeatedStringReference(
+                            message_, &field_, index_, &scratch);
+  }
+  const Message& GetMessage() const {
+    return index_ < 0
+               ? reflection_.GetMessage(message_, &field_)
+               : reflection_.GetRepeatedMessage(message_, &field_, index_);
+  }
+
+ private:
+  const Message& message_;
+  const Reflection& reflection_;
+  const FieldDescriptor& field_;
+  const int index_;
+};
+
+void WriteMessage(const Message& message, formats::json::StringBuilder& sb);
+
+template <typename Float>
+void WriteFloat(Float value, formats::json::StringBuilder& sb) {
+  if (std::isnan(value)) {
+    sb.WriteString("NaN");
+  } else if (std::isinf(value)) {
+    sb.WriteString(value > 0 ? "Infinity" : "-Infinity");
+  } else if constexpr (std::is_same_v<Float, float>) {
+    // the shortest representation of the float, not of the wider double
+    sb.WriteDouble(std::strtod(fmt::format("{}", value).c_str(), nullptr));
+  } else {
+    sb.WriteDouble(value);
+  }
 }
 
+void WriteValue(const FieldDescriptor& field, const FieldReader& reader,
+                formats::json::StringBuilder& sb) {
+  switch (field.cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      sb.WriteInt64(reader.GetInt32());
+      break;
+    case FieldDescriptor::CPPTYPE_INT64:
+      sb.WriteString(std::to_string(reader.GetInt64()));
+      break;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      sb.WriteUInt64(reader.GetUInt32());
+      break;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      sb.WriteString(std::to_string(reader.GetUInt64()));
+      break;
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      WriteFloat(reader.GetDouble(), sb);
+      break;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      WriteFloat(reader.GetFloat(), sb);
+      break;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      sb.WriteBool(reader.GetBool());
+      break;
+    case FieldDescriptor::CPPTYPE_ENUM: {
+      const auto& enum_type = *field.enum_type();
+      if (enum_type.full_name() == kNullValueType.data()) {
+        sb.WriteNull();
+        break;
+      }
+      const auto number = reader.GetEnumValue();
+      const auto* value = enum_type.FindValueByNumber(number);
+      if (value) {
+        sb.WriteString(std::string{value->name()});
+      } else {
+        sb.WriteInt64(number);
+      }
+      break;
+    }
+    case FieldDescriptor::CPPTYPE_STRING: {
+      std::string scratch;
+      const auto& value = reader.GetString(scratch);
+      if (field.type() == FieldDescriptor::TYPE_BYTES) {
+        sb.WriteString(crypto::base64::Base64Encode(value));
+      } else {
+        sb.WriteString(value);
+      }
+      break;
+    }
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+      WriteMessage(reader.GetMessage(), sb);
+      break;
+  }
+}
+
+std::string MapKeyToString(const FieldDescriptor& key_field,
+                           const FieldReader& reader) {
+  switch (key_field.cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      return std::to_string(reader.GetInt32());
+    case FieldDescriptor::CPPTYPE_INT64:
+      return std::to_string(reader.GetInt64());
+    case FieldDescriptor::CPPTYPE_UINT32:
+      return std::to_string(reader.GetUInt32());
+    case FieldDescriptor::CPPTYPE_UINT64:
+      return std::to_string(reader.GetUInt64());
+    case FieldDescriptor::CPPTYPE_BOOL:
+      return reader.GetBool() ? "true" : "false";
+    case FieldDescriptor::CPPTYPE_STRING: {
+      std::string scratch;
+      return reader.GetString(scratch);
+    }
+    default:
+      ThrowConversionError(key_field, "unsupported map key type");
+  }
+}
+
+void WriteMap(const Message& message, const FieldDescriptor& field,
+              formats::json::StringBuilder& sb) {
+  const auto& reflection = *message.GetReflection();
+  const auto& key_field = *field.message_type()->map_key();
+  const auto& value_field = *field.message_type()->map_value();
+
+  const formats::json::StringBuilder::ObjectGuard guard{sb};
+  const int size = reflection.FieldSize(message, &field);
+  for (int i = 0; i < size; ++i) {
+    const auto& entry = reflection.GetRepeatedMessage(message, &field, i);
+    sb.Key(MapKeyToString(key_field, FieldReader{entry, key_field, -1}));
+    WriteValue(value_field, FieldReader{entry, value_field, -1}, sb);
+  }
+}
+
+void WriteMessage(const Message& message, formats::json::StringBuilder& sb) {
+  const auto plan = GetPlan(*message.GetDescriptor());
+  if (plan->is_well_known) {
+    sb.WriteRawString(ToJsonString(message));
+    return;
+  }
+
+  const auto& reflection = *message.GetReflection();
+  const formats::json::StringBuilder::ObjectGuard guard{sb};
+  for (const auto& field_plan : plan->fields) {
+    const auto& field = *field_plan.field;
+    if (field_plan.is_map) {
+      sb.Key(field_plan.json_name);
+      WriteMap(message, field, sb);
+    } else if (field.is_repeated()) {
+      sb.Key(field_plan.json_name);
+      const formats::json::StringBuilder::ArrayGuard array_guard{sb};
+      const int size = reflection.FieldSize(message, &field);
+      for (int i = 0; i < size; ++i) {
+        WriteValue(field, FieldReader{message, field, i}, sb);
+      }
+    } else if (!field_plan.has_presence ||
+               reflection.HasField(message, &field)) {
+      sb.Key(field_plan.json_name);
+      WriteValue(field, FieldReader{message, field, -1}, sb);
+    }
+  }
+}
+
+// Sets a singular field or appends an element to a repeated field
+class FieldWriter final {
+ public:
+  FieldWriter(Message& message, const FieldDescriptor& field)
+      : message_(message),
+        reflection_(*message.GetReflection()),
+        field_(field) {}
+
+  void SetInt32(std::int32_t value) {
+    field_.is_repeated() ? reflection_.AddInt32(&message_, &field_, value)
+                         : reflection_.SetInt32(&message_, &field_, value);
+  }
+  void SetInt64(std::int64_t value) {
+    field_.is_repeated() ? reflection_.AddInt64(&message_, &field_, value)
+                         : reflection_.SetInt64(&message_, &field_, value);
+  }
+  void SetUInt32(std::uint32_t value) {
+    field_.is_repeated() ? reflection_.AddUInt32(&message_, &field_, value)
+                         : reflection_.SetUInt32(&message_, &field_, value);
+  }
+  void SetUInt64(std::uint64_t value) {
+    field_.is_repeated() ? reflection_.AddUInt64(&message_, &field_, value)
+                         : reflection_.SetUInt64(&message_, &field_, value);
+  }
+  void SetDouble(double value) {
+    field_.is_repeated() ? reflection_.AddDouble(&message_, &field_, value)
+                         : reflection_.SetDouble(&message_, &field_, value);
+  }
+  void SetFloat(float value) {
+    field_.is_repeated() ? reflection_.AddFloat(&message_, &field_, value)
+                         : reflection_.SetFloat(&message_, &field_, value);
+  }
+  void SetBool(bool value) {
+    field_.is_repeated() ? reflection_.AddBool(&message_, &field_, value)
+                         : reflection_.SetBool(&message_, &field_, value);
+  }
+  void SetEnumValue(int value) {
+    field_.is_repeated()
+        ? reflection_.AddEnumValue(&message_, &field_, value)
+        : reflection_.SetEnumValue(&message_, &field_, value);
+  }
+  void SetString(std::string value) {
+    field_.is_repeated()
+        ? reflection_.AddString(&message_, &field_, std::move(value))
+        : reflection_.SetString(&message_, &field_, std::move(value));
+  }
+  Message& MutableMessage() {
+    return field_.is_repeated()
+               ? *reflection_.AddMessage(&message_, &field_)
+               : *reflection_.MutableMessage(&message_, &field_);
+  }
+
+ private:
+  Message& message_;
+  const Reflection& reflection_;
+  const FieldDescriptor& field_;
+};
+
+void ParseMessage(const formats::json::Value& json, Message& message);
+
+// Numbers may be quoted, 64-bit integers are written quoted
+template <typename Number>
+Number ParseNumber(const FieldDescriptor& field,
+                   const formats::json::Value& json) {
+  try {
+    if (json.IsString()) {
+      return utils::FromString<Number>(json.As<std::string>());
+    }
+    return json.As<Number>();
+  } catch (const std::exception& e) {
+    ThrowConversionError(field, e.what());
+  }
+}
+
+template <typename Float>
+Float ParseFloat(const FieldDescriptor& field,
+                 const formats::json::Value& json) {
+  if (json.IsString()) {
+    const auto value = json.As<std::string>();
+    if (value == "NaN") return std::numeric_limits<Float>::quiet_NaN();
+    if (value == "Infinity") return std::numeric_limits<Float>::infinity();
+    if (value == "-Infinity") return -std::numeric_limits<Float>::infinity();
+    return ParseNumber<Float>(field, json);
+  }
+  if (!json.IsDouble()) ThrowConversionError(field, "expected a number");
+  return static_cast<Float>(json.As<double>());
+}
+
+void ParseValue(const FieldDescriptor& field, const formats::json::Value& json,
+                FieldWriter& writer) {
+  switch (field.cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      writer.SetInt32(ParseNumber<std::int32_t>(field, json));
+      break;
+    case FieldDescriptor::CPPTYPE_INT64:
+      writer.SetInt64(ParseNumber<std::int64_t>(field, json));
+      break;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      writer.SetUInt32(ParseNumber<std::uint32_t>(field, json));
+      break;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      writer.SetUInt64(ParseNumber<std::uint64_t>(field, json));
+      break;
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      writer.SetDouble(ParseFloat<double>(field, json));
+      break;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      writer.SetFloat(ParseFloat<float>(field, json));
+      break;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      if (!json.IsBool()) ThrowConversionError(field, "expected a bool");
+      writer.SetBool(json.As<bool>());
+      break;
+    case FieldDescriptor::CPPTYPE_ENUM: {
+      if (json.IsString()) {
+        const auto name = json.As<std::string>();
+        const auto* value = field.enum_type()->FindValueByName(name);
+        if (!value) ThrowConversionError(field, "unknown enum value " + name);
+        writer.SetEnumValue(value->number());
+      } else if (json.IsNull()) {
+        writer.SetEnumValue(0);
+      } else {
+        writer.SetEnumValue(ParseNumber<int>(field, json));
+      }
+      break;
+    }
+    case FieldDescriptor::CPPTYPE_STRING: {
+      if (!json.IsString()) ThrowConversionError(field, "expected a string");
+      auto value = json.As<std::string>();
+      if (field.type() == FieldDescriptor::TYPE_BYTES) {
+        const bool is_url = value.find_first_of("-_") != std::string::npos;
+        value = is_url ? crypto::base64::Base64UrlDecode(value)
+                       : crypto::base64::Base64Decode(value);
+      }
+      writer.SetString(std::move(value));
+      break;
+    }
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+      ParseMessage(json, writer.MutableMessage());
+      break;
+  }
+}
+
+void ParseMap(const FieldDescriptor& field, const formats::json::Value& json,
+              Message& message) {
+  if (!json.IsObject()) ThrowConversionError(field, "expected an object");
+  const auto& key_field = *field.message_type()->map_key();
+  const auto& value_field = *field.message_type()->map_value();
+
+  FieldWriter entries{message, field};
+  for (auto it = json.begin(); it != json.end(); ++it) {
+    auto& entry = entries.MutableMessage();
+    const auto key = it.GetName();
+    FieldWriter key_writer{entry, key_field};
+    switch (key_field.cpp_type()) {
+      case FieldDescriptor::CPPTYPE_BOOL:
+        if (key != "true" && key != "false") {
+          ThrowConversionError(field, "invalid bool map key " + key);
+        }
+        key_writer.SetBool(key == "true");
+        break;
+      case FieldDescriptor::CPPTYPE_STRING:
+        key_writer.SetString(key);
+        break;
+      default:
+        ParseValue(key_field, formats::json::ValueBuilder{key}.ExtractValue(),
+                   key_writer);
+    }
+    FieldWriter value_writer{entry, value_field};
+    ParseValue(value_field, *it, value_writer);
+  }
+}
+
+void ParseMessage(const formats::json::Value& json, Message& message) {
+  const auto plan = GetPlan(*message.GetDescriptor());
+  if (plan->is_well_known) {
+    const auto status = google::protobuf::util::JsonStringToMessage(
+        formats::json::ToString(json), &message);
+    if (!status.ok()) {
+      throw formats::json::ConversionException(
+          fmt::format("Cannot convert JSON to {}: {}",
+                      std::string{message.GetDescriptor()->full_name()},
+                      std::string{status.message()}));
+    }
+    return;
+  }
+
+  if (!json.IsObject()) {
+    throw formats::json::ConversionException(
+        fmt::format("Cannot convert JSON to {}: expected an object",
+                    std::string{message.GetDescriptor()->full_name()}));
+  }
+
+  for (auto it = json.begin(); it != json.end(); ++it) {
+    const auto* field_plan = plan->Find(it.GetName());
+    if (!field_plan) {
+      throw formats::json::ConversionException(
+          fmt::format("Cannot convert JSON to {}: unknown member '{}'",
+                      std::string{message.GetDescriptor()->full_name()},
+                      it.GetName()));
+    }
+    const auto& field = *field_plan->field;
+    const bool is_value_type =
+        field.message_type() &&
+        field.message_type()->full_name() == kValueType.data();
+    if (it->IsNull() && !is_value_type) continue;
+
+    if (field_plan->is_map) {
+      ParseMap(field, *it, message);
+    } else if (field.is_repeated()) {
+      if (!it->IsArray()) ThrowConversionError(field, "expected an array");
+      FieldWriter writer{message, field};
+      for (const auto& element : *it) ParseValue(field, element, writer);
+    } else {
+      FieldWriter writer{message, field};
+      ParseValue(field, *it, writer);
+    }
+  }
+}
+
+}  // namespace
+
 formats::json::Value MessageToJson(const google::protobuf::Message& message) {
   return formats::json::FromString(ToJsonString(message));
 }
@@ -39,6 +557,17 @@ std::string ToJsonString(const google::protobuf::Message& message) {
   return result;
 }
 
+void WriteMessageToJson(const google::protobuf::Message& message,
+                        formats::json::StringBuilder& sb) {
+  WriteMessage(message, sb);
+}
+
+void JsonToMessage(const formats::json::Value& json,
+                   google::protobuf::Message& message) {
+  message.Clear();
+  ParseMessage(json, message);
+}
+
 }  // namespace ugrpc
 
 namespace formats::serialize {
@@ -0,0 +1,11 @@
+#include <userver/ugrpc/server/generic_service_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server {
+
+GenericServiceBase::~GenericServiceBase() = default;
+
+}  // namespace ugrpc::server
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,168 @@
+#include <ugrpc/server/impl/generic_service_worker.hpp>
+
+#include <optional>
+#include <string_view>
+
+#include <userver/engine/async.hpp>
+#include <userver/utils/impl/wait_token_storage.hpp>
+#include <userver/utils/lazy_prvalue.hpp>
+
+#include <userver/ugrpc/impl/static_metadata.hpp>
+#include <userver/ugrpc/impl/statistics_scope.hpp>
+#include <userver/ugrpc/server/impl/async_method_invocation.hpp>
+#include <userver/ugrpc/server/impl/service_worker_impl.hpp>
+#include <userver/ugrpc/server/middlewares/base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::impl {
+
+namespace {
+
+// All the generic RPCs are accounted as a single pseudo-method not to blow up
+// the metrics with arbitrary method names
+constexpr std::string_view kGenericServiceName = "Generic";
+constexpr std::string_view kGenericMethodFullNames[] = {"Generic/Generic"};
+
+const ugrpc::impl::StaticServiceMetadata kGenericMetadata{
+    kGenericServiceName, kGenericMethodFullNames};
+
+struct GenericServiceData final {
+  GenericServiceData(GenericServiceBase& service, ServiceSettings&& settings)
+      : service(service),
+        settings(std::move(settings)),
+        statistics(this->settings.statistics_storage
+                       .GetServiceStatistics(kGenericMetadata)
+                       .GetMethodStatistics(0)) {}
+
+  GenericServiceBase& service;
+  const ServiceSettings settings;
+  ugrpc::impl::MethodStatistics& statistics;
+  grpc::AsyncGenericService async_service;
+  utils::impl::WaitTokenStorage wait_tokens;
+};
+
+class GenericCallData final {
+ public:
+  GenericCallData(GenericServiceData& service_data, int queue_num)
+      : wait_token_(service_data.wait_tokens.GetToken()),
+        service_data_(service_data),
+        queue_num_(queue_num) {}
+
+  void operator()() && {
+    // See the comments in CallData::operator()
+    RpcFinishedEvent notify_when_done(
+        engine::current_task::GetCancellationToken(), context_);
+
+    context_.AsyncNotifyWhenDone(notify_when_done.GetTag());
+
+    auto& queue = service_data_.settings.queue.GetQueue(queue_num_);
+    service_data_.async_service.RequestCall(&context_, &stream_, &queue, &queue,
+                                            prepare_.GetTag());
+
+    if (Wait(prepare_) != ugrpc::impl::AsyncMethodInvocation::WaitStatus::kOk) {
+      // the CompletionQueue is shutting down
+      return;
+    }
+
+    ListenAsync(service_data_, queue_num_);
+
+    HandleRpc();
+
+    notify_when_done.Wait();
+  }
+
+  static void ListenAsync(GenericServiceData& service_data, int queue_num) {
+    engine::CriticalAsyncNoSpan(service_data.settings.task_processor,
+                                utils::LazyPrvalue([&] {
+                                  return GenericCallData(service_data,
+                                                         queue_num);
+                                }))
+        .Detach();
+  }
+
+ private:
+  void HandleRpc() {
+    // "/package.Service/Method" -> "package.Service/Method"
+    std::string_view call_name = context_.method();
+    if (!call_name.empty() && call_name.front() == '/') {
+      call_name.remove_prefix(1);
+    }
+    const auto slash_pos = call_name.find('/');
+    const auto service_name = call_name.substr(0, slash_pos);
+    const auto method_name = slash_pos == std::string_view::npos
+                                 ? std::string_view{}
+                                 : call_name.substr(slash_pos + 1);
+
+    SetupSpan(span_, context_, call_name);
+    utils::FastScopeGuard destroy_span([&]() noexcept { span_.reset(); });
+
+    ugrpc::impl::RpcStatisticsScope statistics_scope(service_data_.statistics);
+
+    const auto& settings = service_data_.settings;
+    GenericServiceBase::Call responder(
+        CallParams{context_, call_name, statistics_scope,
+                   *settings.access_tskv_logger, span_->Get(), nullptr},
+        stream_);
+    auto do_call = [&] { service_data_.service.Handle(responder); };
+
+    try {
+      MiddlewareCallContext middleware_context(
+          settings.middlewares, responder, do_call, service_name, method_name,
+          settings.config_source.GetSnapshot(), nullptr);
+      middleware_context.Next();
+    } catch (
+        const USERVER_NAMESPACE::server::handlers::CustomHandlerException& ex) {
+      ReportCustomError(ex, responder, span_->Get());
+    } catch (const RpcInterruptedError& ex) {
+      ReportNetworkError(ex, call_name, span_->Get());
+      statistics_scope.OnNetworkError();
+    } catch (const std::exception& ex) {
+      ReportHandlerError(ex, call_name, span_->Get());
+    }
+  }
+
+  // 'wait_token_' must be the first field, because its lifetime keeps
+  // GenericServiceData alive during server shutdown.
+  const utils::impl::WaitTokenStorage::Token wait_token_;
+
+  GenericServiceData& service_data_;
+  const int queue_num_;
+
+  grpc::GenericServerContext context_{};
+  grpc::GenericServerAsyncReaderWriter stream_{&context_};
+  ugrpc::impl::AsyncMethodInvocation prepare_;
+  std::optional<tracing::InPlaceSpan> span_{};
+};
+
+}  // namespace
+
+struct GenericServiceWorker::Impl final {
+  Impl(GenericServiceBase& service, ServiceSettings&& settings)
+      : service_data(service, std::move(settings)) {}
+
+  ~Impl() { service_data.wait_tokens.WaitForAllTokens(); }
+
+  GenericServiceData service_data;
+};
+
+GenericServiceWorker::GenericServiceWorker(GenericServiceBase& service,
+                                           ServiceSettings&& settings)
+    : impl_(std::make_unique<Impl>(service, std::move(settings))) {}
+
+GenericServiceWorker::~GenericServiceWorker() = default;
+
+grpc::AsyncGenericService& GenericServiceWorker::GetService() {
+  return impl_->service_data.async_service;
+}
+
+void GenericServiceWorker::Start() {
+  auto& service_data = impl_->service_data;
+  for (std::size_t i = 0; i < service_data.settings.queue.GetSize(); ++i) {
+    GenericCallData::ListenAsync(service_data, static_cast<int>(i));
+  }
+}
+
+}  // namespace ugrpc::server::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+
+#include <grpcpp/generic/async_generic_service.h>
+
+#include <userver/ugrpc/server/generic_service_base.hpp>
+#include <userver/ugrpc/server/impl/service_worker.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::impl {
+
+/// @brief Listens to the RPCs for a generic service, forwarding them to a
+/// user-provided GenericServiceBase implementation.
+/// @note Must be destroyed after the corresponding `CompletionQueue`
+class GenericServiceWorker final {
+ public:
+  GenericServiceWorker(GenericServiceBase& service,
+                       ServiceSettings&& settings);
+
+  GenericServiceWorker(GenericServiceWorker&&) = delete;
+  GenericServiceWorker& operator=(GenericServiceWorker&&) = delete;
+  ~GenericServiceWorker();
+
+  /// Get the grpcpp service for registration in the `ServerBuilder`
+  grpc::AsyncGenericService& GetService();
+
+  /// Start serving requests. Should be called after the grpcpp server starts.
+  void Start();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace ugrpc::server::impl
+
+USERVER_NAMESPACE_END
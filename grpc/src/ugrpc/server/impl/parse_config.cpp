@@ -17,6 +17,7 @@ namespace {
 
 constexpr std::string_view kTaskProcessorKey = "task-processor";
 constexpr std::string_view kMiddlewaresKey = "middlewares";
+constexpr std::string_view kUseArenaKey = "use-arena";
 
 template <typename ParserFunc>
 auto ParseOptional(const yaml_config::YamlConfig& service_field,
@@ -47,6 +48,11 @@ engine::TaskProcessor& ParseTaskProcessor(
   return context.GetTaskProcessor(field.As<std::string>());
 }
 
+bool ParseUseArena(const yaml_config::YamlConfig& field,
+                   const components::ComponentContext& /*context*/) {
+  return field.As<bool>(false);
+}
+
 std::vector<std::string> ParseMiddlewares(
     const yaml_config::YamlConfig& field,
     const components::ComponentContext& /*context*/) {
@@ -72,6 +78,8 @@ ServiceDefaults ParseServiceDefaults(
                                        ParseTaskProcessor),
       /*middleware_names=*/
       ParseOptional(value[kMiddlewaresKey], context, ParseMiddlewares),
+      /*use_arena=*/
+      ParseOptional(value[kUseArenaKey], context, ParseUseArena),
   };
 }
 
@@ -88,6 +96,9 @@ server::ServiceConfig ParseServiceConfig(
           MergeField(value[kMiddlewaresKey], defaults.middleware_names, context,
                      ParseMiddlewares),
           context),
+      /*use_arena=*/
+      MergeField(value[kUseArenaKey], defaults.use_arena, context,
+                 ParseUseArena),
   };
 }
 
@@ -15,6 +15,7 @@ struct ServiceDefaults final {
   // using boost::optional to easily generalize to references
   boost::optional<engine::TaskProcessor&> task_processor;
   boost::optional<std::vector<std::string>> middleware_names;
+  boost::optional<bool> use_arena;
 };
 
 }  // namespace ugrpc::server::impl
@@ -1,5 +1,6 @@
 #include <userver/ugrpc/server/impl/service_worker_impl.hpp>
 
+#include <algorithm>
 #include <chrono>
 
 #include <grpc/support/time.h>
@@ -82,6 +83,40 @@ void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
                              ugrpc::impl::ToGrpcString(span.GetLink()));
 }
 
+namespace {
+
+// Do not let a single huge request bloat the arenas of all the later calls
+constexpr std::size_t kMaxArenaStartBlockSize = 1024 * 1024;
+
+// Weight of the previous average in the running average of arena usage
+constexpr std::size_t kArenaSizeHintInertia = 8;
+
+}  // namespace
+
+google::protobuf::ArenaOptions MakeArenaOptions(
+    std::size_t size_hint) noexcept {
+  google::protobuf::ArenaOptions options;
+  options.start_block_size =
+      std::clamp(size_hint, options.start_block_size, kMaxArenaStartBlockSize);
+  options.max_block_size =
+      std::max(options.max_block_size, options.start_block_size);
+  return options;
+}
+
+void UpdateArenaSizeHint(std::atomic<std::size_t>& size_hint,
+                         std::size_t space_used) noexcept {
+  // Concurrent updates may be lost, which is fine for a hint
+  const auto old_hint = size_hint.load(std::memory_order_relaxed);
+  if (old_hint == 0) {
+    size_hint.store(space_used, std::memory_order_relaxed);
+    return;
+  }
+  size_hint.store(
+      old_hint - old_hint / kArenaSizeHintInertia +
+          space_used / kArenaSizeHintInertia,
+      std::memory_order_relaxed);
+}
+
 }  // namespace ugrpc::server::impl
 
 USERVER_NAMESPACE_END
@@ -19,6 +19,7 @@
 
 #include <ugrpc/impl/logging.hpp>
 #include <ugrpc/impl/to_string.hpp>
+#include <ugrpc/server/impl/generic_service_worker.hpp>
 #include <ugrpc/server/impl/parse_config.hpp>
 #include <userver/ugrpc/impl/statistics_storage.hpp>
 #include <userver/ugrpc/server/impl/queue_holder.hpp>
@@ -76,12 +77,16 @@ class Server::Impl final {
 
   void AddService(ServiceBase& service, ServiceConfig&& config);
 
+  void AddService(GenericServiceBase& service, ServiceConfig&& config);
+
   std::vector<std::string_view> GetServiceNames() const;
 
   void WithServerBuilder(SetupHook setup);
 
   grpc::CompletionQueue& GetCompletionQueue() noexcept;
 
+  const ugrpc::impl::CompletionQueues& GetCompletionQueues() noexcept;
+
   void Start();
 
   int GetPort() const noexcept;
@@ -105,6 +110,7 @@ class Server::Impl final {
   std::optional<grpc::ServerBuilder> server_builder_;
   std::optional<int> port_;
   std::vector<std::unique_ptr<impl::ServiceWorker>> service_workers_;
+  std::unique_ptr<impl::GenericServiceWorker> generic_service_worker_;
   std::optional<impl::QueueHolder> queue_;
   std::unique_ptr<grpc::Server> server_;
   mutable engine::Mutex configuration_mutex_;
@@ -172,9 +178,29 @@ void Server::Impl::AddService(ServiceBase& service, ServiceConfig&& config) {
       std::move(config.middlewares),
       access_tskv_logger_,
       config_source_,
+      config.use_arena,
   }));
 }
 
+void Server::Impl::AddService(GenericServiceBase& service,
+                              ServiceConfig&& config) {
+  const std::lock_guard lock(configuration_mutex_);
+  UASSERT(state_ == State::kConfiguration);
+  UINVARIANT(!generic_service_worker_,
+             "Only one generic service may be registered in a gRPC server");
+
+  generic_service_worker_ = std::make_unique<impl::GenericServiceWorker>(
+      service, impl::ServiceSettings{
+                   *queue_,
+                   config.task_processor,
+                   statistics_storage_,
+                   std::move(config.middlewares),
+                   access_tskv_logger_,
+                   config_source_,
+                   config.use_arena,
+               });
+}
+
 std::vector<std::string_view> Server::Impl::GetServiceNames() const {
   std::vector<std::string_view> ret;
 
@@ -195,9 +221,13 @@ void Server::Impl::WithServerBuilder(SetupHook setup) {
 }
 
 grpc::CompletionQueue& Server::Impl::GetCompletionQueue() noexcept {
+  return *GetCompletionQueues().queues[0];
+}
+
+const ugrpc::impl::CompletionQueues&
+Server::Impl::GetCompletionQueues() noexcept {
   UASSERT(state_ == State::kConfiguration || state_ == State::kActive);
-  // TODO: https://st.yandex-team.ru/TAXICOMMON-7612
-  return *queue_->GetQueues().queues[0];
+  return queue_->GetQueues();
 }
 
 void Server::Impl::Start() {
@@ -233,6 +263,7 @@ void Server::Impl::Stop() noexcept {
     server_->Shutdown();
   }
   service_workers_.clear();
+  generic_service_worker_.reset();
   queue_.reset();
   server_.reset();
 
@@ -243,6 +274,7 @@ void Server::Impl::StopDebug() noexcept {
   UINVARIANT(server_, "The gRPC server is not running");
   server_->Shutdown();
   service_workers_.clear();
+  generic_service_worker_.reset();
 }
 
 void Server::Impl::DoStart() {
@@ -254,6 +286,10 @@ void Server::Impl::DoStart() {
   for (auto& worker : service_workers_) {
     server_builder_->RegisterService(&worker->GetService());
   }
+  if (generic_service_worker_) {
+    server_builder_->RegisterAsyncGenericService(
+        &generic_service_worker_->GetService());
+  }
 
   server_ = server_builder_->BuildAndStart();
   UINVARIANT(server_, "See grpcpp logs for details");
@@ -262,6 +298,7 @@ void Server::Impl::DoStart() {
   for (auto& worker : service_workers_) {
     worker->Start();
   }
+  if (generic_service_worker_) generic_service_worker_->Start();
 
   if (port_) {
     LOG_INFO() << "gRPC server started on port " << *port_;
@@ -282,6 +319,10 @@ void Server::AddService(ServiceBase& service, ServiceConfig&& config) {
   impl_->AddService(service, std::move(config));
 }
 
+void Server::AddService(GenericServiceBase& service, ServiceConfig&& config) {
+  impl_->AddService(service, std::move(config));
+}
+
 std::vector<std::string_view> Server::GetServiceNames() const {
   return impl_->GetServiceNames();
 }
@@ -294,6 +335,10 @@ grpc::CompletionQueue& Server::GetCompletionQueue() noexcept {
   return impl_->GetCompletionQueue();
 }
 
+const ugrpc::impl::CompletionQueues& Server::GetCompletionQueues() noexcept {
+  return impl_->GetCompletionQueues();
+}
+
 void Server::Start() { return impl_->Start(); }
 
 int Server::GetPort() const noexcept { return impl_->GetPort(); }
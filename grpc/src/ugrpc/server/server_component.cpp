@@ -91,6 +91,10 @@ properties:
                 items:
                     type: string
                     description: middleware component name
+            use-arena:
+                type: boolean
+                description: allocate request messages in a per-call protobuf arena
+                defaultDescription: false
 )");
 }
 
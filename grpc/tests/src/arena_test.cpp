@@ -0,0 +1,65 @@
+#include <userver/utest/utest.hpp>
+
+#include <google/protobuf/arena.h>
+
+#include <userver/engine/task/task.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+#include <userver/ugrpc/tests/service_fixtures.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class ArenaTestService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    auto* arena = call.GetArena();
+    if (!arena || request.GetArena() != arena) {
+      call.FinishWithError({grpc::StatusCode::INTERNAL, "No arena"});
+      return;
+    }
+
+    auto* response = google::protobuf::Arena::CreateMessage<
+        sample::ugrpc::GreetingResponse>(arena);
+    response->set_name("Hello " + request.name());
+    call.Finish(*response);
+  }
+};
+
+class GrpcServerArena : public ugrpc::tests::ServiceFixtureBase {
+ protected:
+  GrpcServerArena() {
+    GetServer().AddService(service_,
+                           ugrpc::server::ServiceConfig{
+                               engine::current_task::GetTaskProcessor(),
+                               {},
+                               /*use_arena=*/true,
+                           });
+    StartServer();
+  }
+
+  ~GrpcServerArena() override { StopServer(); }
+
+ private:
+  ArenaTestService service_;
+};
+
+}  // namespace
+
+UTEST_F(GrpcServerArena, RequestOnArena) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  for (int i = 0; i < 10; ++i) {
+    sample::ugrpc::GreetingRequest out;
+    out.set_name(std::string(100 * i, 'x'));
+    auto call = client.SayHello(out);
+
+    sample::ugrpc::GreetingResponse in;
+    UASSERT_NO_THROW(in = call.Finish());
+    EXPECT_EQ(in.name(), "Hello " + out.name());
+  }
+}
+
+USERVER_NAMESPACE_END
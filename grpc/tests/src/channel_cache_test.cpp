@@ -0,0 +1,67 @@
+#include <userver/ugrpc/client/impl/channel_cache.hpp>
+
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using ChannelCache = ugrpc::client::impl::ChannelCache;
+
+constexpr std::size_t kInFlightThreshold = 2;
+
+ChannelCache MakeChannelCache(std::size_t channel_count,
+                              std::size_t max_channel_count) {
+  return ChannelCache{grpc::InsecureChannelCredentials(),
+                      grpc::ChannelArguments{}, channel_count,
+                      max_channel_count, kInFlightThreshold};
+}
+
+}  // namespace
+
+UTEST(GrpcChannelCache, LeastInFlight) {
+  auto cache = MakeChannelCache(2, 2);
+  const auto token = cache.Get("[::1]:1");
+  ASSERT_EQ(token.GetChannelCount(), 2);
+
+  const auto first = token.SelectChannel();
+  auto first_call = token.StartCall(first);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_NE(token.SelectChannel(), first);
+  }
+
+  first_call.Release();
+  auto second_call = token.StartCall(1 - first);
+  EXPECT_EQ(token.SelectChannel(), first);
+}
+
+UTEST(GrpcChannelCache, Growth) {
+  auto cache = MakeChannelCache(1, 3);
+  const auto token = cache.Get("[::1]:1");
+  ASSERT_EQ(token.GetChannelCount(), 1);
+  ASSERT_EQ(token.GetMaxChannelCount(), 3);
+
+  std::vector<ChannelCache::InFlightGuard> calls;
+  for (std::size_t i = 0; i < 3 * kInFlightThreshold; ++i) {
+    calls.push_back(token.StartCall(token.SelectChannel()));
+  }
+  EXPECT_EQ(token.GetChannelCount(), 3);
+
+  // The limit is reached, the least loaded channel is used
+  calls.push_back(token.StartCall(token.SelectChannel()));
+  EXPECT_EQ(token.GetChannelCount(), 3);
+}
+
+UTEST(GrpcChannelCache, GuardOutlivesToken) {
+  auto cache = MakeChannelCache(1, 1);
+  ChannelCache::InFlightGuard call;
+  {
+    const auto token = cache.Get("[::1]:1");
+    call = token.StartCall(token.SelectChannel());
+  }
+  call.Release();
+}
+
+USERVER_NAMESPACE_END
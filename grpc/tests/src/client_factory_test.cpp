@@ -1,5 +1,7 @@
 #include <userver/ugrpc/client/client_factory.hpp>
 
+#include <set>
+
 #include <userver/engine/task/task.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/yaml/value.hpp>
@@ -46,4 +48,29 @@ UTEST(GrpcClient, ChannelsCount) {
   ASSERT_EQ(kChannelsCount, data.GetChannelToken().GetChannelCount());
 }
 
+UTEST(GrpcClient, CompletionQueuesRoundRobin) {
+  constexpr std::size_t kQueueCount = 3;
+  ugrpc::client::QueueHolder client_queues(kQueueCount);
+  ASSERT_EQ(client_queues.GetQueues().queues.size(), kQueueCount);
+
+  utils::statistics::Storage statistics_storage;
+  dynamic_config::StorageMock config_storage;
+  testsuite::GrpcControl ts({}, false);
+  ugrpc::client::ClientFactory client_factory(
+      {}, engine::current_task::GetTaskProcessor(), {},
+      client_queues.GetQueues(), statistics_storage, ts,
+      config_storage.GetSource());
+
+  const std::string endpoint{"[::]:50051"};
+  std::set<grpc::CompletionQueue*> used_queues;
+  for (std::size_t i = 0; i < kQueueCount; ++i) {
+    auto client =
+        client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>(
+            "test", endpoint);
+    used_queues.insert(&ugrpc::client::impl::GetClientData(client).GetQueue());
+  }
+
+  EXPECT_EQ(used_queues.size(), kQueueCount);
+}
+
 USERVER_NAMESPACE_END
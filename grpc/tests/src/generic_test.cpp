@@ -0,0 +1,102 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/engine/task/task.hpp>
+#include <userver/ugrpc/client/exceptions.hpp>
+#include <userver/ugrpc/byte_buffer_utils.hpp>
+#include <userver/ugrpc/client/generic.hpp>
+#include <userver/ugrpc/server/generic_service_base.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+#include <userver/ugrpc/tests/service_fixtures.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kSayHelloCallName =
+    "sample.ugrpc.UnitTestService/SayHello";
+
+class UnitTestService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+};
+
+class GenericEchoService final : public ugrpc::server::GenericServiceBase {
+ public:
+  void Handle(Call& call) override {
+    if (call.GetCallName() != kSayHelloCallName) {
+      call.FinishWithError({grpc::StatusCode::UNIMPLEMENTED, "Unknown"});
+      return;
+    }
+
+    grpc::ByteBuffer request_buffer;
+    sample::ugrpc::GreetingRequest request;
+    if (!call.Read(request_buffer) ||
+        !ugrpc::ParseFromByteBuffer(request_buffer, request)) {
+      call.FinishWithError({grpc::StatusCode::INVALID_ARGUMENT, "Bad"});
+      return;
+    }
+
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Generic " + request.name());
+    call.WriteAndFinish(ugrpc::SerializeToByteBuffer(response));
+  }
+};
+
+class GrpcGenericService : public ugrpc::tests::ServiceFixtureBase {
+ protected:
+  GrpcGenericService() {
+    GetServer().AddService(
+        service_, ugrpc::server::ServiceConfig{
+                      engine::current_task::GetTaskProcessor(), {}});
+    StartServer();
+  }
+
+  ~GrpcGenericService() override { StopServer(); }
+
+ private:
+  GenericEchoService service_;
+};
+
+using GrpcGenericClient = ugrpc::tests::ServiceFixture<UnitTestService>;
+
+}  // namespace
+
+UTEST_F(GrpcGenericService, HandlesTypedClient) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::GreetingRequest out;
+  out.set_name("userver");
+
+  sample::ugrpc::GreetingResponse in;
+  UASSERT_NO_THROW(in = client.SayHello(out).Finish());
+  EXPECT_EQ(in.name(), "Generic userver");
+
+  auto stream = client.Chat();
+  sample::ugrpc::StreamGreetingResponse response;
+  UEXPECT_THROW(static_cast<void>(stream.Read(response)),
+                ugrpc::client::UnimplementedError);
+}
+
+UTEST_F(GrpcGenericClient, CallsTypedService) {
+  auto client = MakeClient<ugrpc::client::GenericClient>();
+  sample::ugrpc::GreetingRequest out;
+  out.set_name("userver");
+
+  auto call =
+      client.UnaryCall(kSayHelloCallName, ugrpc::SerializeToByteBuffer(out));
+  EXPECT_EQ(call.GetCallName(), kSayHelloCallName);
+
+  grpc::ByteBuffer response_buffer;
+  UASSERT_NO_THROW(response_buffer = call.Finish());
+  sample::ugrpc::GreetingResponse in;
+  ASSERT_TRUE(ugrpc::ParseFromByteBuffer(response_buffer, in));
+  EXPECT_EQ(in.name(), "Hello userver");
+}
+
+USERVER_NAMESPACE_END
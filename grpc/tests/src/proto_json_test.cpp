@@ -0,0 +1,121 @@
+#include <userver/utest/utest.hpp>
+
+#include <cmath>
+#include <string>
+#include <string_view>
+
+#include <google/protobuf/util/message_differencer.h>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/ugrpc/proto_json.hpp>
+
+#include <tests/messages.pb.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+sample::ugrpc::JsonTranscodingMessage MakeMessage() {
+  sample::ugrpc::JsonTranscodingMessage message;
+  message.set_int32_value(-42);
+  message.set_int64_value(1LL << 60);
+  message.set_uint64_value(~0ULL);
+  message.set_double_value(1.5);
+  message.set_float_value(0.25F);
+  message.set_bool_value(true);
+  message.set_string_value("string \"quoted\"");
+  message.set_bytes_value(std::string{"\0\xff bytes", 8});
+  message.set_kind(sample::ugrpc::JsonTranscodingMessage::KIND_FIRST);
+  message.mutable_nested()->set_name("nested");
+  message.add_names("first");
+  message.add_names("second");
+  message.add_nested_list()->set_name("element");
+  (*message.mutable_counters())["counter"] = 7;
+  (*message.mutable_nested_map())[-3].set_name("mapped");
+  message.set_optional_value(0);
+  message.set_choice_number(5);
+  message.mutable_timestamp()->set_seconds(1'600'000'000);
+  return message;
+}
+
+std::string WriteToString(const google::protobuf::Message& message) {
+  formats::json::StringBuilder sb;
+  ugrpc::WriteMessageToJson(message, sb);
+  return sb.GetString();
+}
+
+}  // namespace
+
+TEST(ProtoJson, WriteMatchesLibrary) {
+  const auto message = MakeMessage();
+  EXPECT_EQ(formats::json::FromString(WriteToString(message)),
+            ugrpc::MessageToJson(message));
+}
+
+TEST(ProtoJson, WriteDefaults) {
+  const sample::ugrpc::JsonTranscodingMessage message;
+  const auto json = formats::json::FromString(WriteToString(message));
+
+  EXPECT_EQ(json["int32Value"].As<int>(), 0);
+  EXPECT_EQ(json["int64Value"].As<std::string>(), "0");
+  EXPECT_EQ(json["kind"].As<std::string>(), "KIND_UNSPECIFIED");
+  EXPECT_EQ(json["stringValue"].As<std::string>(), "");
+  EXPECT_TRUE(json["names"].IsArray());
+  EXPECT_TRUE(json["counters"].IsObject());
+  EXPECT_FALSE(json.HasMember("nested"));
+  EXPECT_FALSE(json.HasMember("optionalValue"));
+  EXPECT_FALSE(json.HasMember("choiceName"));
+  EXPECT_FALSE(json.HasMember("timestamp"));
+}
+
+TEST(ProtoJson, RoundTrip) {
+  const auto message = MakeMessage();
+
+  sample::ugrpc::JsonTranscodingMessage parsed;
+  ugrpc::JsonToMessage(formats::json::FromString(WriteToString(message)),
+                       parsed);
+  EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(message,
+                                                                  parsed))
+      << parsed.DebugString();
+}
+
+TEST(ProtoJson, ParseLenient) {
+  sample::ugrpc::JsonTranscodingMessage message;
+  ugrpc::JsonToMessage(formats::json::FromString(R"({
+    "int32_value": "12",
+    "int64Value": 13,
+    "floatValue": "NaN",
+    "kind": 1,
+    "nested": null,
+    "stringValue": null
+  })"),
+                       message);
+
+  EXPECT_EQ(message.int32_value(), 12);
+  EXPECT_EQ(message.int64_value(), 13);
+  EXPECT_TRUE(std::isnan(message.float_value()));
+  EXPECT_EQ(message.kind(), sample::ugrpc::JsonTranscodingMessage::KIND_FIRST);
+  EXPECT_FALSE(message.has_nested());
+}
+
+TEST(ProtoJson, ParseErrors) {
+  sample::ugrpc::JsonTranscodingMessage message;
+  const auto parse = [&message](std::string_view json) {
+    ugrpc::JsonToMessage(formats::json::FromString(json), message);
+  };
+
+  EXPECT_THROW(parse(R"({"unknown": 1})"),
+               formats::json::ConversionException);
+  EXPECT_THROW(parse(R"({"int32Value": "x"})"),
+               formats::json::ConversionException);
+  EXPECT_THROW(parse(R"({"int32Value": 1.5})"),
+               formats::json::ConversionException);
+  EXPECT_THROW(parse(R"({"kind": "KIND_UNKNOWN"})"),
+               formats::json::ConversionException);
+  EXPECT_THROW(parse(R"({"names": "first"})"),
+               formats::json::ConversionException);
+  EXPECT_THROW(parse("[]"), formats::json::ConversionException);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,63 @@
+#include <userver/utest/utest.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+#include <userver/ugrpc/tests/service_fixtures.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kMessagesCount = 1000;
+
+class BufferedStreamService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void ReadMany(ReadManyCall& call,
+                sample::ugrpc::StreamGreetingRequest&& request) override {
+    ugrpc::server::WriteBufferingConfig config;
+    config.max_messages = 10;
+    call.SetWriteBuffering(config);
+
+    sample::ugrpc::StreamGreetingResponse response;
+    response.set_name(request.name());
+    for (int i = 0; i < request.number(); ++i) {
+      response.set_number(i);
+      call.Write(response);
+      if (i == 0) call.Flush();
+    }
+    call.Finish();
+  }
+};
+
+using GrpcWriteBuffering = ugrpc::tests::ServiceFixture<BufferedStreamService>;
+
+void ReadAll(sample::ugrpc::UnitTestServiceClient& client, int count) {
+  sample::ugrpc::StreamGreetingRequest out;
+  out.set_name("userver");
+  out.set_number(count);
+  auto stream = client.ReadMany(out);
+
+  sample::ugrpc::StreamGreetingResponse in;
+  for (int i = 0; i < count; ++i) {
+    ASSERT_TRUE(stream.Read(in));
+    EXPECT_EQ(in.number(), i);
+    EXPECT_EQ(in.name(), "userver");
+  }
+  EXPECT_FALSE(stream.Read(in));
+}
+
+}  // namespace
+
+UTEST_F(GrpcWriteBuffering, AllMessagesDeliveredInOrder) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  ReadAll(client, kMessagesCount);
+}
+
+UTEST_F(GrpcWriteBuffering, FewMessages) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  ReadAll(client, 0);
+  ReadAll(client, 1);
+  ReadAll(client, 3);
+}
+
+USERVER_NAMESPACE_END
@@ -11,6 +11,7 @@
 #include <userver/formats/bson/types.hpp>
 #include <userver/formats/bson/value.hpp>
 #include <userver/formats/bson/value_builder.hpp>
+#include <userver/formats/bson/view.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -0,0 +1,104 @@
+#pragma once
+
+/// @file userver/formats/bson/stream_builder.hpp
+/// @brief @copybrief formats::bson::StreamBuilder
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+#include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/value.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+
+// clang-format off
+
+/// @ingroup userver_formats
+///
+/// @brief SAX like builder of a BSON document. Use only in performance
+/// critical parts of your code.
+///
+/// Unlike formats::bson::ValueBuilder it builds no intermediate tree: the
+/// values are appended right into the buffer of the resulting document, the
+/// nested documents and arrays are written in place into the buffer of their
+/// parent.
+///
+/// The builder itself is the root document: call Key() and then a Write*
+/// function or construct a guard for each member. The keys of the array
+/// elements are generated.
+///
+/// ## Example usage:
+///
+/// @snippet formats/bson/stream_builder_test.cpp  Sample formats::bson::StreamBuilder usage
+
+// clang-format on
+
+class StreamBuilder final {
+ public:
+  StreamBuilder();
+  ~StreamBuilder();
+
+  StreamBuilder(const StreamBuilder&) = delete;
+  StreamBuilder& operator=(const StreamBuilder&) = delete;
+
+  /// Construct this guard on new object start and its destructor will end the
+  /// object
+  class ObjectGuard final {
+   public:
+    explicit ObjectGuard(StreamBuilder& sb);
+    ~ObjectGuard();
+
+   private:
+    StreamBuilder& sb_;
+  };
+
+  /// Construct this guard on new array start and its destructor will end the
+  /// array
+  class ArrayGuard final {
+   public:
+    explicit ArrayGuard(StreamBuilder& sb);
+    ~ArrayGuard();
+
+   private:
+    StreamBuilder& sb_;
+  };
+
+  /// ONLY for objects: write key of the next member
+  void Key(std::string_view key);
+
+  void WriteNull();
+  void WriteBool(bool value);
+  void WriteInt32(std::int32_t value);
+  void WriteInt64(std::int64_t value);
+  /// @throws BsonException if the value does not fit into int64
+  void WriteUInt64(std::uint64_t value);
+  void WriteDouble(double value);
+  /// @throws BsonException if the value is not valid UTF-8
+  void WriteString(std::string_view value);
+  void WriteDateTime(std::chrono::system_clock::time_point value);
+
+  /// Appends a copy of the value
+  void WriteValue(const Value& value);
+
+  /// @brief Finishes the build, all the guards must be destroyed by now.
+  /// The builder must not be used afterwards.
+  Document ExtractDocument();
+
+ private:
+  struct Impl;
+
+  void StartObject();
+  void EndObject();
+  void StartArray();
+  void EndArray();
+
+  utils::FastPimpl<Impl, 128, 8> impl_;
+};
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
@@ -257,6 +257,7 @@ class Value {
 
  private:
   friend class ValueBuilder;
+  friend class StreamBuilder;
   friend class impl::BsonBuilder;
 
   impl::ValueImplPtr impl_;
@@ -0,0 +1,205 @@
+#pragma once
+
+/// @file userver/formats/bson/view.hpp
+/// @brief @copybrief formats::bson::DocumentView
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <bson/bson.h>
+
+#include <userver/formats/bson/types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+
+class Document;
+class DocumentView;
+
+/// @brief Non-owning view of a single element of a BSON document or array
+///
+/// The value is decoded directly from the binary document on access, without
+/// building a formats::bson::Value tree. Views returned by the accessors
+/// (`std::string_view`, formats::bson::DocumentView) point into the same
+/// binary document, which must outlive them.
+///
+/// Supported `As<T>()` types: `bool`, `int32_t`, `int64_t`, `uint64_t`,
+/// `double`, `std::string_view`, `std::string`,
+/// `std::chrono::system_clock::time_point`, formats::bson::Oid,
+/// formats::bson::DocumentView (for both documents and arrays).
+///
+/// @note Error messages only contain the element key, not the full path.
+class ElementView {
+ public:
+  /// Element key, decimal index for array elements
+  std::string_view Key() const {
+    return {bson_iter_key_unsafe(&iter_), bson_iter_key_len(&iter_)};
+  }
+
+  /// @name Type checking
+  /// @{
+  bool IsNull() const { return Type() == BSON_TYPE_NULL; }
+  bool IsBool() const { return Type() == BSON_TYPE_BOOL; }
+  bool IsInt32() const { return Type() == BSON_TYPE_INT32; }
+  bool IsInt64() const { return Type() == BSON_TYPE_INT64 || IsInt32(); }
+  bool IsDouble() const { return Type() == BSON_TYPE_DOUBLE || IsInt64(); }
+  bool IsString() const { return Type() == BSON_TYPE_UTF8; }
+  bool IsDateTime() const { return Type() == BSON_TYPE_DATE_TIME; }
+  bool IsOid() const { return Type() == BSON_TYPE_OID; }
+  bool IsDocument() const { return Type() == BSON_TYPE_DOCUMENT; }
+  bool IsArray() const { return Type() == BSON_TYPE_ARRAY; }
+  /// @}
+
+  /// @brief Extracts the value of the specified type
+  /// @throws TypeMismatchException if the value has an incompatible type
+  /// @throws ConversionException if the conversion loses precision
+  template <typename T>
+  T As() const;
+
+ private:
+  friend class DocumentView;
+
+  ElementView() = default;
+
+  bson_type_t Type() const { return bson_iter_type_unsafe(&iter_); }
+
+  bson_iter_t iter_{};
+};
+
+/// @brief Non-owning view of a BSON document or array for single-pass
+/// decoding into user types
+///
+/// Unlike formats::bson::Value, the view does not allocate or refcount
+/// anything: the elements are read directly from the binary document with
+/// `bson_iter_t`. This makes it a good fit for parsing large documents into
+/// structs in a single pass over the elements.
+///
+/// The viewed document must outlive the view, its elements and iterators.
+///
+/// ## Example usage:
+///
+/// @code
+/// Car ParseCar(formats::bson::DocumentView view) {
+///   Car car;
+///   for (const auto& element : view) {
+///     const auto key = element.Key();
+///     if (key == "model") {
+///       car.model = element.As<std::string>();
+///     } else if (key == "age") {
+///       car.age = element.As<int32_t>();
+///     }
+///   }
+///   return car;
+/// }
+///
+/// const auto car = ParseCar(formats::bson::DocumentView{doc});
+/// @endcode
+class DocumentView {
+ public:
+  /// Input iterator over the elements in the document order
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = ElementView;
+    using reference = const ElementView&;
+    using pointer = const ElementView*;
+
+    /// The past-the-end iterator
+    Iterator() = default;
+
+    reference operator*() const { return current_; }
+    pointer operator->() const { return &current_; }
+
+    /// @throws ParseException if the document is malformed
+    Iterator& operator++() {
+      Advance();
+      return *this;
+    }
+
+    /// Only the comparison with the past-the-end iterator is meaningful
+    bool operator==(const Iterator& other) const {
+      return is_end_ == other.is_end_;
+    }
+    bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+   private:
+    friend class DocumentView;
+
+    explicit Iterator(const DocumentView& view);
+
+    void Advance();
+
+    ElementView current_;
+    bool is_end_{true};
+  };
+
+  /// @brief Views the document, which must outlive the view
+  explicit DocumentView(const Document& document);
+
+  /// @throws ParseException if the document is malformed
+  Iterator begin() const { return Iterator{*this}; }
+  Iterator end() const { return {}; }
+
+  bool IsEmpty() const { return begin() == end(); }
+
+  /// @brief Finds the first element with the specified key
+  /// @note Scans the document linearly, iterate over all the elements at once
+  /// when several of them are needed.
+  /// @throws ParseException if the document is malformed
+  std::optional<ElementView> Find(std::string_view key) const;
+
+  /// Size of the binary document
+  std::size_t GetSize() const { return length_; }
+
+  /// @cond
+  // For internal use only
+  DocumentView(const uint8_t* data, uint32_t length) noexcept
+      : data_(data), length_(length) {}
+  /// @endcond
+
+ private:
+  const uint8_t* data_;
+  uint32_t length_;
+};
+
+template <>
+bool ElementView::As<bool>() const;
+
+template <>
+int32_t ElementView::As<int32_t>() const;
+
+template <>
+int64_t ElementView::As<int64_t>() const;
+
+template <>
+uint64_t ElementView::As<uint64_t>() const;
+
+template <>
+double ElementView::As<double>() const;
+
+template <>
+std::string_view ElementView::As<std::string_view>() const;
+
+template <>
+std::string ElementView::As<std::string>() const;
+
+template <>
+std::chrono::system_clock::time_point
+ElementView::As<std::chrono::system_clock::time_point>() const;
+
+template <>
+Oid ElementView::As<Oid>() const;
+
+template <>
+DocumentView ElementView::As<DocumentView>() const;
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,129 @@
+#pragma once
+
+/// @file userver/storages/mongo/batching_collection.hpp
+/// @brief @copybrief storages::mongo::BatchingCollection
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <variant>
+
+#include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/value.hpp>
+#include <userver/storages/mongo/bulk_ops.hpp>
+#include <userver/storages/mongo/collection.hpp>
+#include <userver/storages/mongo/options.hpp>
+#include <userver/storages/mongo/write_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+
+/// @brief Collection wrapper that coalesces single-document writes from
+/// concurrent tasks into unordered operations::Bulk submissions.
+///
+/// The first write of a batch waits for `max_delay`, the batch is sent earlier
+/// once it reaches `max_batch_size`. Each caller waits for its own write and
+/// gets its own result or exception, as if the write was executed alone.
+///
+/// The writes of a batch are unordered: they are not guaranteed to be applied
+/// in the order of the calls, and a failed write does not affect the others.
+///
+/// @note A bulk write reply does not contain the per-operation counters of
+/// updates, replaces and deletes. So these operations do not return a
+/// WriteResult: updates and replaces only report the upserted id, and deletes
+/// report nothing. Use Collection directly if the counters are required.
+///
+/// ## Example:
+///
+/// @code
+/// storages::mongo::BatchingCollection events{
+///     pool->GetCollection("events"),
+///     {/*max_batch_size=*/500, /*max_delay=*/std::chrono::milliseconds{2}}};
+///
+/// // Called concurrently from many tasks
+/// events.InsertOne(formats::bson::MakeDoc("type", "click"));
+/// @endcode
+class BatchingCollection final {
+ public:
+  struct Config final {
+    /// The batch is sent once it has this many writes
+    std::size_t max_batch_size{1000};
+
+    /// The longest time a write waits for the other ones to join its batch
+    std::chrono::milliseconds max_delay{5};
+
+    /// Write concern of the bulk operations, the pool default if not set
+    std::optional<options::WriteConcern> write_concern;
+  };
+
+  /// Result of a batched update or replace
+  struct UpdateResult final {
+    /// `_id` of the inserted document, if the write was an upsert that did
+    /// not match any document
+    std::optional<formats::bson::Value> upserted_id;
+  };
+
+  BatchingCollection(Collection collection, Config config);
+
+  /// Waits for the batches in flight; no writes may be in progress
+  ~BatchingCollection();
+
+  BatchingCollection(BatchingCollection&&) = delete;
+  BatchingCollection& operator=(BatchingCollection&&) = delete;
+
+  /// Inserts a single document into the collection
+  WriteResult InsertOne(formats::bson::Document document);
+
+  /// @brief Replaces a single matching document
+  /// @see options::Upsert
+  template <typename... Options>
+  UpdateResult ReplaceOne(formats::bson::Document selector,
+                          formats::bson::Document replacement,
+                          Options&&... options);
+
+  /// @brief Updates a single matching document
+  /// @see options::Upsert
+  template <typename... Options>
+  UpdateResult UpdateOne(formats::bson::Document selector,
+                         formats::bson::Document update, Options&&... options);
+
+  /// @brief Deletes a single matching document
+  /// @note Whether a document was deleted is not reported
+  void DeleteOne(formats::bson::Document selector);
+
+ private:
+  using Write = std::variant<bulk_ops::InsertOne, bulk_ops::ReplaceOne,
+                             bulk_ops::Update, bulk_ops::Delete>;
+
+  // Returns the upserted id, if any
+  std::optional<formats::bson::Value> Execute(Write&& write);
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+template <typename... Options>
+BatchingCollection::UpdateResult BatchingCollection::ReplaceOne(
+    formats::bson::Document selector, formats::bson::Document replacement,
+    Options&&... options) {
+  bulk_ops::ReplaceOne replace_subop(std::move(selector),
+                                     std::move(replacement));
+  (replace_subop.SetOption(std::forward<Options>(options)), ...);
+  return UpdateResult{Execute(std::move(replace_subop))};
+}
+
+template <typename... Options>
+BatchingCollection::UpdateResult BatchingCollection::UpdateOne(
+    formats::bson::Document selector, formats::bson::Document update,
+    Options&&... options) {
+  bulk_ops::Update update_subop(bulk_ops::Update::Mode::kSingle,
+                                std::move(selector), std::move(update));
+  (update_subop.SetOption(std::forward<Options>(options)), ...);
+  return UpdateResult{Execute(std::move(update_subop))};
+}
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
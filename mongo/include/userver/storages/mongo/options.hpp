@@ -276,6 +276,30 @@ class SuppressServerExceptions {};
 /// @see https://docs.mongodb.com/manual/core/tailable-cursors/
 class Tailable {};
 
+/// @brief Fetches the next batch of a cursor in background while the current
+/// one is being iterated
+///
+/// `batchSize` of the subsequent batches is adapted to the observed document
+/// sizes, aiming at about `TargetBatchBytes()` per batch. The target is
+/// increased when the cursor consumer has to wait for the batches and
+/// decreased back when the consumer is the bottleneck.
+///
+/// At most two batches are kept in memory in addition to the one being
+/// iterated.
+/// @note Ignored for tailable cursors.
+class Prefetch {
+ public:
+  static constexpr size_t kDefaultTargetBatchBytes = 1024 * 1024;
+
+  explicit Prefetch(size_t target_batch_bytes = kDefaultTargetBatchBytes)
+      : target_batch_bytes_(target_batch_bytes) {}
+
+  size_t TargetBatchBytes() const { return target_batch_bytes_; }
+
+ private:
+  size_t target_batch_bytes_;
+};
+
 /// Sets a comment for the operation, which would be visible in profile data
 class Comment {
  public:
@@ -54,7 +54,7 @@ struct PoolConfig final {
   std::chrono::milliseconds so_timeout = kDefaultSoTimeout;
   /// Connection queue wait time
   std::chrono::milliseconds queue_timeout = kDefaultQueueTimeout;
-  /// Initial connection count
+  /// Initial connection count, restored by the pool maintenance
   size_t initial_size = kDefaultInitialSize;
   /// Total connections limit
   size_t max_size = kDefaultMaxSize;
@@ -2,6 +2,7 @@
 
 #include <userver/formats/bson.hpp>
 #include <userver/formats/bson/serialize.hpp>
+#include <userver/formats/bson/view.hpp>
 #include <userver/formats/json.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -115,4 +116,25 @@ void bson_path_first_access(benchmark::State& state) {
 }
 BENCHMARK(bson_path_first_access);
 
+void bson_view_path_first_access(benchmark::State& state) {
+  const std::string_view kPath[] = {
+      "nested_very_long_long_long_long_path", "deeply", "deeply", "nested",
+      "bson", "value", "with", "some"};
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto bson = formats::bson::FromJsonString(bench_bson_data);
+    state.ResumeTiming();
+
+    formats::bson::DocumentView view{bson};
+    for (const auto key : kPath) {
+      view = view.Find(key)->As<formats::bson::DocumentView>();
+    }
+    const auto res = (view.Find("data")->As<std::string_view>() == "4");
+    benchmark::DoNotOptimize(res);
+    if (!res) throw std::runtime_error("unexpected");
+  }
+}
+BENCHMARK(bson_view_path_first_access);
+
 USERVER_NAMESPACE_END
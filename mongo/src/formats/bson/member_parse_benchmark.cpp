@@ -2,6 +2,8 @@
 
 #include <userver/formats/bson.hpp>
 #include <userver/formats/bson/serialize.hpp>
+#include <userver/formats/bson/stream_builder.hpp>
+#include <userver/formats/bson/view.hpp>
 #include <userver/formats/json.hpp>
 
 #include <array>
@@ -210,6 +212,175 @@ models::Profile Parse(const formats::bson::Value& val, To<models::Profile>) {
 
 }  // namespace models
 
+// The same parsing as above, in a single pass over formats::bson::DocumentView
+namespace view_models {
+
+using formats::bson::DocumentView;
+using formats::bson::ElementView;
+
+models::ProfileCar ParseCar(DocumentView view) {
+  models::ProfileCar car;
+  bool has_number = false;
+  for (const auto& element : view) {
+    const auto key = element.Key();
+    if (key == names::car::kNumber) {
+      car.number = element.As<std::string>();
+      has_number = true;
+    } else if (key == names::car::kModel) {
+      car.model = element.As<std::string>();
+    } else if (key == names::car::kMarkCode) {
+      car.mark_code = element.As<std::string>();
+    } else if (key == names::car::kAge) {
+      car.age = static_cast<short>(element.As<int32_t>());
+    } else if (key == names::car::kPrice) {
+      car.price = element.As<double>();
+    }
+  }
+  if (!has_number) throw formats::bson::MemberMissingException(names::kCar);
+  return car;
+}
+
+models::Requirements::ChildSeats ParseChildSeats(const ElementView& element) {
+  if (!element.IsArray()) return {};
+
+  models::Requirements::ChildSeats seats;
+  for (const auto& chair_supported_classes : element.As<DocumentView>()) {
+    if (!chair_supported_classes.IsArray()) return seats;
+
+    models::Requirements::ChildSeat seat;
+    for (const auto& chair_class : chair_supported_classes.As<DocumentView>()) {
+      if (!chair_class.IsInt64()) return seats;
+      seat.push_back(static_cast<short>(chair_class.As<int64_t>()));
+    }
+
+    std::sort(seat.begin(), seat.end());
+    seats.push_back(std::move(seat));
+  }
+
+  return seats;
+}
+
+models::Requirements ParseRequirements(DocumentView view) {
+  models::Requirements result;
+  for (const auto& element : view) {
+    const std::string name{element.Key()};
+    if (name == names::requirements::kChildSeats)
+      result.Add(name, ParseChildSeats(element));
+    else if (element.IsBool())
+      result.Add(name, element.As<bool>());
+    else if (element.IsInt64())
+      result.Add(name, static_cast<short>(element.As<int64_t>()));
+  }
+  return result;
+}
+
+models::ClassesGrade ParseGrades(DocumentView view) {
+  models::ClassesGrade ret;
+  for (const auto& grade : view) {
+    std::optional<std::string_view> class_name;
+    std::optional<models::ClassesGrade::value_t> value;
+    for (const auto& element : grade.As<DocumentView>()) {
+      if (element.Key() == names::kGradeClass) {
+        class_name = element.As<std::string_view>();
+      } else if (element.Key() == names::kGradeValue) {
+        value = static_cast<models::ClassesGrade::value_t>(
+            element.As<int32_t>());
+      }
+    }
+    if (!class_name || !value) {
+      throw formats::bson::MemberMissingException(names::kGrades);
+    }
+    ret.Set(std::string{*class_name}, *value);
+  }
+  return ret;
+}
+
+models::Profile ParseProfile(DocumentView view) {
+  models::Profile profile;
+  bool has_uuid = false;
+  bool has_car = false;
+  bool has_license = false;
+  for (const auto& element : view) {
+    const auto key = element.Key();
+    if (key == names::kUuid) {
+      profile.driver_id.uuid = element.As<std::string>();
+      profile.driver_id.dbid = profile.driver_id.uuid;  // changed
+      has_uuid = true;
+    } else if (key == names::kCar) {
+      profile.car = ParseCar(element.As<DocumentView>());
+      has_car = true;
+    } else if (key == names::kLicense) {
+      profile.license = element.As<std::string>();
+      has_license = true;
+    } else if (key == names::kRequirements && !element.IsNull()) {
+      profile.available_requirements =
+          ParseRequirements(element.As<DocumentView>());
+    } else if (key == names::kGrades && !element.IsNull()) {
+      profile.grades = ParseGrades(element.As<DocumentView>());
+    }
+  }
+  if (!has_uuid || !has_car || !has_license) {
+    throw formats::bson::MemberMissingException("profile");
+  }
+  return profile;
+}
+
+}  // namespace view_models
+
+// The profile is written back in the layout of the source documents
+namespace build {
+
+formats::bson::Document BuildWithValueBuilder(const models::Profile& profile) {
+  formats::bson::ValueBuilder car;
+  car[names::car::kNumber] = profile.car.number;
+  car[names::car::kModel] = profile.car.model;
+  car[names::car::kMarkCode] = profile.car.mark_code;
+  car[names::car::kAge] = profile.car.age;
+  car[names::car::kPrice] = static_cast<double>(profile.car.price);
+
+  formats::bson::ValueBuilder builder;
+  builder[names::kId] = profile.driver_id.dbid;
+  builder[names::kUuid] = profile.driver_id.uuid;
+  builder[names::kLicense] = profile.license;
+  builder[names::kCar] = std::move(car);
+  builder[names::kClasses].PushBack(names::kCar);
+  builder[names::kClasses].PushBack(names::kUuid);
+  return builder.ExtractValue();
+}
+
+formats::bson::Document BuildWithStreamBuilder(const models::Profile& profile) {
+  formats::bson::StreamBuilder sb;
+  sb.Key(names::kId);
+  sb.WriteString(profile.driver_id.dbid);
+  sb.Key(names::kUuid);
+  sb.WriteString(profile.driver_id.uuid);
+  sb.Key(names::kLicense);
+  sb.WriteString(profile.license);
+  sb.Key(names::kCar);
+  {
+    const formats::bson::StreamBuilder::ObjectGuard guard{sb};
+    sb.Key(names::car::kNumber);
+    sb.WriteString(profile.car.number);
+    sb.Key(names::car::kModel);
+    sb.WriteString(profile.car.model);
+    sb.Key(names::car::kMarkCode);
+    sb.WriteString(profile.car.mark_code);
+    sb.Key(names::car::kAge);
+    sb.WriteInt32(profile.car.age);
+    sb.Key(names::car::kPrice);
+    sb.WriteDouble(profile.car.price);
+  }
+  sb.Key(names::kClasses);
+  {
+    const formats::bson::StreamBuilder::ArrayGuard guard{sb};
+    sb.WriteString(names::kCar);
+    sb.WriteString(names::kUuid);
+  }
+  return sb.ExtractDocument();
+}
+
+}  // namespace build
+
 }  // anonymous namespace
 
 void bson_parse_full(benchmark::State& state) {
@@ -239,4 +410,57 @@ void bson_parse_access(benchmark::State& state) {
 }
 BENCHMARK(bson_parse_access);
 
+void bson_parse_view(benchmark::State& state) {
+  static unsigned i = 0;
+
+  for (auto _ : state) {
+    auto bson = formats::bson::Document(bench_bson_data[++i % kBenchRows]);
+
+    const auto res =
+        view_models::ParseProfile(formats::bson::DocumentView{bson});
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(bson_parse_view);
+
+void bson_build_value_builder(benchmark::State& state) {
+  const auto profile =
+      formats::bson::Document(bench_bson_data[0]).As<models::Profile>();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(build::BuildWithValueBuilder(profile));
+  }
+}
+BENCHMARK(bson_build_value_builder);
+
+void bson_build_stream(benchmark::State& state) {
+  const auto profile =
+      formats::bson::Document(bench_bson_data[0]).As<models::Profile>();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(build::BuildWithStreamBuilder(profile));
+  }
+}
+BENCHMARK(bson_build_stream);
+
+void bson_build_from_json_value(benchmark::State& state) {
+  const auto json = formats::bson::Document(bench_bson_data[0])
+                        .As<formats::json::Value>();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(json.As<formats::bson::Value>());
+  }
+}
+BENCHMARK(bson_build_from_json_value);
+
+void bson_build_from_json_string(benchmark::State& state) {
+  const auto json = formats::json::ToString(
+      formats::bson::Document(bench_bson_data[0]).As<formats::json::Value>());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(formats::bson::FromJsonString(json));
+  }
+}
+BENCHMARK(bson_build_from_json_string);
+
 USERVER_NAMESPACE_END
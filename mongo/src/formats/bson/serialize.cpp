@@ -5,6 +5,7 @@
 #include <bson/bson.h>
 
 #include <userver/formats/bson/exception.hpp>
+#include <userver/formats/bson/stream_builder.hpp>
 #include <userver/formats/bson/value_builder.hpp>
 #include <userver/formats/common/conversion_stack.hpp>
 #include <userver/formats/json/inline.hpp>
@@ -19,6 +20,43 @@ USERVER_NAMESPACE_BEGIN
 
 namespace formats::parse {
 
+namespace {
+
+// Mirrors PerformMinimalFormatConversion, but appends right into the buffer
+// of the resulting document
+void WriteJsonToStream(const json::Value& json, bson::StreamBuilder& sb) {
+  if (json.IsObject()) {
+    const bson::StreamBuilder::ObjectGuard guard{sb};
+    for (auto it = json.begin(); it != json.end(); ++it) {
+      sb.Key(it.GetName());
+      WriteJsonToStream(*it, sb);
+    }
+  } else if (json.IsArray()) {
+    const bson::StreamBuilder::ArrayGuard guard{sb};
+    for (const auto& element : json) WriteJsonToStream(element, sb);
+  } else if (json.IsBool()) {
+    sb.WriteBool(json.As<bool>());
+  } else if (json.IsInt()) {
+    sb.WriteInt32(json.As<int>());
+  } else if (json.IsInt64()) {
+    sb.WriteInt64(json.As<std::int64_t>());
+  } else if (json.IsUInt64()) {
+    sb.WriteUInt64(json.As<std::uint64_t>());
+  } else if (json.IsDouble()) {
+    sb.WriteDouble(json.As<double>());
+  } else if (json.IsString()) {
+    sb.WriteString(json.As<std::string>());
+  } else if (json.IsNull()) {
+    sb.WriteNull();
+  } else {
+    throw json::Exception(fmt::format(
+        "Failed to convert value at '{}' to BSON: unknown node type",
+        json.GetPath()));
+  }
+}
+
+}  // namespace
+
 json::Value Convert(const bson::Value& bson, parse::To<json::Value>) {
   formats::common::ConversionStack<bson::Value, json::ValueBuilder>
       conversion_stack(bson);
@@ -64,6 +102,14 @@ bson::Value Convert(const json::Value& json, parse::To<bson::Value>) {
   if (json.IsMissing()) {
     return bson::ValueBuilder{common::Type::kNull}.ExtractValue();
   }
+  if (json.IsObject()) {
+    bson::StreamBuilder sb;
+    for (auto it = json.begin(); it != json.end(); ++it) {
+      sb.Key(it.GetName());
+      WriteJsonToStream(*it, sb);
+    }
+    return sb.ExtractDocument();
+  }
   return formats::common::PerformMinimalFormatConversion<bson::Value>(json);
 }
 
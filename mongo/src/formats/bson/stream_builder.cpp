@@ -0,0 +1,203 @@
+#include <userver/formats/bson/stream_builder.hpp>
+
+#include <deque>
+#include <string>
+
+#include <bson/bson.h>
+
+#include <formats/bson/int_utils.hpp>
+#include <formats/bson/value_impl.hpp>
+#include <formats/bson/wrappers.hpp>
+#include <formats/common/validations.hpp>
+#include <userver/formats/bson/exception.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/text.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+
+namespace {
+
+// A nested document or array, written in place into the buffer of its parent
+class Level final {
+ public:
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+  Level(bson_t* parent, std::string_view key, bool is_array)
+      : parent_(parent), is_array_(is_array) {
+    if (is_array_) {
+      bson_append_array_begin(parent_, key.data(), key.size(), &bson_);
+    } else {
+      bson_append_document_begin(parent_, key.data(), key.size(), &bson_);
+    }
+  }
+
+  Level(const Level&) = delete;
+  Level& operator=(const Level&) = delete;
+
+  ~Level() {
+    if (is_array_) {
+      bson_append_array_end(parent_, &bson_);
+    } else {
+      bson_append_document_end(parent_, &bson_);
+    }
+    bson_destroy(&bson_);
+  }
+
+  bson_t* Get() { return &bson_; }
+
+  bool IsArray() const { return is_array_; }
+
+  impl::ArrayIndexer& Indexer() { return indexer_; }
+
+ private:
+  bson_t* const parent_;
+  const bool is_array_;
+  impl::ArrayIndexer indexer_;
+  bson_t bson_;
+};
+
+}  // namespace
+
+struct StreamBuilder::Impl {
+  bson_t* Current() {
+    return levels.empty() ? root.Get() : levels.back().Get();
+  }
+
+  // Calls func(bson, key) with the key of the next value of the current level
+  template <typename Func>
+  void Append(Func&& func) {
+    if (!levels.empty() && levels.back().IsArray()) {
+      auto& indexer = levels.back().Indexer();
+      func(Current(), indexer.GetKey());
+      indexer.Advance();
+      return;
+    }
+    UINVARIANT(has_key, "Key() must precede a member of a BSON document");
+    has_key = false;
+    func(Current(), std::string_view{key});
+  }
+
+  impl::MutableBson root;
+  std::deque<Level> levels;
+  std::string key;
+  bool has_key{false};
+};
+
+StreamBuilder::StreamBuilder() = default;
+
+StreamBuilder::~StreamBuilder() = default;
+
+StreamBuilder::ObjectGuard::ObjectGuard(StreamBuilder& sb) : sb_(sb) {
+  sb_.StartObject();
+}
+
+StreamBuilder::ObjectGuard::~ObjectGuard() { sb_.EndObject(); }
+
+StreamBuilder::ArrayGuard::ArrayGuard(StreamBuilder& sb) : sb_(sb) {
+  sb_.StartArray();
+}
+
+StreamBuilder::ArrayGuard::~ArrayGuard() { sb_.EndArray(); }
+
+void StreamBuilder::Key(std::string_view key) {
+  UINVARIANT(impl_->levels.empty() || !impl_->levels.back().IsArray(),
+             "Key() is not allowed in a BSON array");
+  UINVARIANT(!impl_->has_key, "Key() was called twice in a row");
+  impl_->key.assign(key.data(), key.size());
+  impl_->has_key = true;
+}
+
+void StreamBuilder::WriteNull() {
+  impl_->Append([](bson_t* bson, std::string_view key) {
+    bson_append_null(bson, key.data(), key.size());
+  });
+}
+
+void StreamBuilder::WriteBool(bool value) {
+  impl_->Append([value](bson_t* bson, std::string_view key) {
+    bson_append_bool(bson, key.data(), key.size(), value);
+  });
+}
+
+void StreamBuilder::WriteInt32(std::int32_t value) {
+  impl_->Append([value](bson_t* bson, std::string_view key) {
+    bson_append_int32(bson, key.data(), key.size(), value);
+  });
+}
+
+void StreamBuilder::WriteInt64(std::int64_t value) {
+  impl_->Append([value](bson_t* bson, std::string_view key) {
+    bson_append_int64(bson, key.data(), key.size(), value);
+  });
+}
+
+void StreamBuilder::WriteUInt64(std::uint64_t value) {
+  WriteInt64(impl::ToInt64(value));
+}
+
+void StreamBuilder::WriteDouble(double value) {
+  formats::common::ValidateFloat<BsonException>(value);
+  impl_->Append([value](bson_t* bson, std::string_view key) {
+    bson_append_double(bson, key.data(), key.size(), value);
+  });
+}
+
+void StreamBuilder::WriteString(std::string_view value) {
+  if (!utils::text::utf8::IsValid(
+          reinterpret_cast<const unsigned char*>(value.data()), value.size())) {
+    throw BsonException("BSON strings must be valid UTF-8");
+  }
+  impl_->Append([value](bson_t* bson, std::string_view key) {
+    bson_append_utf8(bson, key.data(), key.size(), value.data(), value.size());
+  });
+}
+
+void StreamBuilder::WriteDateTime(std::chrono::system_clock::time_point value) {
+  const auto ms_since_epoch =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          value.time_since_epoch())
+          .count();
+  impl_->Append([ms_since_epoch](bson_t* bson, std::string_view key) {
+    bson_append_date_time(bson, key.data(), key.size(), ms_since_epoch);
+  });
+}
+
+void StreamBuilder::WriteValue(const Value& value) {
+  value.impl_->CheckNotMissing();
+  impl_->Append([&value](bson_t* bson, std::string_view key) {
+    bson_append_value(bson, key.data(), key.size(), value.impl_->GetNative());
+  });
+}
+
+Document StreamBuilder::ExtractDocument() {
+  UINVARIANT(impl_->levels.empty(),
+             "All the guards must be destroyed before ExtractDocument()");
+  return Document(impl_->root.Extract());
+}
+
+void StreamBuilder::StartObject() {
+  impl_->Append([this](bson_t* bson, std::string_view key) {
+    impl_->levels.emplace_back(bson, key, false);
+  });
+}
+
+void StreamBuilder::EndObject() {
+  UASSERT(!impl_->levels.empty() && !impl_->levels.back().IsArray());
+  impl_->levels.pop_back();
+}
+
+void StreamBuilder::StartArray() {
+  impl_->Append([this](bson_t* bson, std::string_view key) {
+    impl_->levels.emplace_back(bson, key, true);
+  });
+}
+
+void StreamBuilder::EndArray() {
+  UASSERT(!impl_->levels.empty() && impl_->levels.back().IsArray());
+  impl_->levels.pop_back();
+}
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
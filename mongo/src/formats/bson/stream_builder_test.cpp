@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <limits>
+#include <string>
+
+#include <userver/formats/bson.hpp>
+#include <userver/formats/bson/stream_builder.hpp>
+#include <userver/formats/json.hpp>
+#include <userver/utest/assert_macros.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fb = formats::bson;
+
+TEST(BsonStreamBuilder, Sample) {
+  /// [Sample formats::bson::StreamBuilder usage]
+  fb::StreamBuilder sb;
+  sb.Key("name");
+  sb.WriteString("value");
+  sb.Key("nested");
+  {
+    const fb::StreamBuilder::ObjectGuard guard{sb};
+    sb.Key("flag");
+    sb.WriteBool(true);
+  }
+  sb.Key("numbers");
+  {
+    const fb::StreamBuilder::ArrayGuard guard{sb};
+    sb.WriteInt32(1);
+    sb.WriteInt64(2);
+    sb.WriteDouble(3.5);
+  }
+  const auto doc = sb.ExtractDocument();
+
+  EXPECT_EQ(doc, fb::MakeDoc("name", "value",                     //
+                             "nested", fb::MakeDoc("flag", true),  //
+                             "numbers", fb::MakeArray(1, int64_t{2}, 3.5)));
+  /// [Sample formats::bson::StreamBuilder usage]
+}
+
+TEST(BsonStreamBuilder, Empty) {
+  fb::StreamBuilder sb;
+  const auto doc = sb.ExtractDocument();
+  EXPECT_TRUE(doc.IsObject());
+  EXPECT_TRUE(doc.IsEmpty());
+}
+
+TEST(BsonStreamBuilder, Types) {
+  const auto now = std::chrono::system_clock::time_point{
+      std::chrono::milliseconds{1'600'000'000'000}};
+  const auto nested = fb::MakeDoc("a", 1);
+
+  fb::StreamBuilder sb;
+  sb.Key("null");
+  sb.WriteNull();
+  sb.Key("uint");
+  sb.WriteUInt64(42);
+  sb.Key("date");
+  sb.WriteDateTime(now);
+  sb.Key("value");
+  sb.WriteValue(nested);
+  const auto doc = sb.ExtractDocument();
+
+  EXPECT_TRUE(doc["null"].IsNull());
+  EXPECT_TRUE(doc["uint"].IsInt64());
+  EXPECT_EQ(doc["uint"].As<int64_t>(), 42);
+  EXPECT_EQ(doc["date"].As<std::chrono::system_clock::time_point>(), now);
+  EXPECT_EQ(doc["value"], nested);
+}
+
+TEST(BsonStreamBuilder, NestedArrays) {
+  fb::StreamBuilder sb;
+  sb.Key("matrix");
+  {
+    const fb::StreamBuilder::ArrayGuard rows{sb};
+    for (int i = 0; i < 2; ++i) {
+      const fb::StreamBuilder::ArrayGuard row{sb};
+      sb.WriteInt32(i);
+      const fb::StreamBuilder::ObjectGuard cell{sb};
+      sb.Key("i");
+      sb.WriteInt32(i);
+    }
+  }
+  const auto doc = sb.ExtractDocument();
+
+  const auto expected_rows =
+      fb::MakeArray(fb::MakeArray(0, fb::MakeDoc("i", 0)),
+                    fb::MakeArray(1, fb::MakeDoc("i", 1)));
+  EXPECT_EQ(doc, fb::MakeDoc("matrix", expected_rows));
+}
+
+TEST(BsonStreamBuilder, Errors) {
+  fb::StreamBuilder sb;
+  sb.Key("big");
+  UEXPECT_THROW(sb.WriteUInt64(std::numeric_limits<uint64_t>::max()),
+                fb::BsonException);
+  sb.Key("invalid");
+  UEXPECT_THROW(sb.WriteString("\xff"), fb::BsonException);
+}
+
+TEST(BsonStreamBuilder, FromJson) {
+  const auto json = formats::json::FromString(
+      R"({"s": "str", "i": 1, "l": 10000000000, "d": 1.5, "b": false,)"
+      R"( "n": null, "a": [1, {"o": []}], "e": {}})");
+
+  const auto bson = json.As<fb::Value>();
+  EXPECT_EQ(bson, fb::MakeDoc(
+                      "s", "str", "i", 1, "l", int64_t{10000000000}, "d", 1.5,
+                      "b", false, "n", nullptr,  //
+                      "a", fb::MakeArray(1, fb::MakeDoc("o", fb::MakeArray())),
+                      "e", fb::MakeDoc()));
+  EXPECT_EQ(bson.As<formats::json::Value>(), json);
+}
+
+USERVER_NAMESPACE_END
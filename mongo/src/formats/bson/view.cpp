@@ -0,0 +1,165 @@
+#include <userver/formats/bson/view.hpp>
+
+#include <cmath>
+#include <limits>
+
+#include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/exception.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+namespace {
+
+constexpr std::int64_t kMaxIntDouble{std::int64_t{1}
+                                     << std::numeric_limits<double>::digits};
+
+}  // namespace
+
+template <>
+bool ElementView::As<bool>() const {
+  if (IsBool()) return bson_iter_bool_unsafe(&iter_);
+  throw TypeMismatchException(Type(), BSON_TYPE_BOOL, Key());
+}
+
+template <>
+int32_t ElementView::As<int32_t>() const {
+  if (IsInt32()) return bson_iter_int32_unsafe(&iter_);
+  const auto value = As<int64_t>();
+  if (value < std::numeric_limits<int32_t>::min() ||
+      value > std::numeric_limits<int32_t>::max()) {
+    throw ConversionException("Integral overflow while converting ")
+        << Key() << '=' << value << " to int32";
+  }
+  return static_cast<int32_t>(value);
+}
+
+template <>
+int64_t ElementView::As<int64_t>() const {
+  switch (Type()) {
+    case BSON_TYPE_INT32:
+      return bson_iter_int32_unsafe(&iter_);
+    case BSON_TYPE_INT64:
+      return bson_iter_int64_unsafe(&iter_);
+    case BSON_TYPE_DOUBLE: {
+      const double as_double = bson_iter_double_unsafe(&iter_);
+      double int_part = 0.0;
+      const auto frac_part = std::modf(as_double, &int_part);
+      if (frac_part || std::abs(as_double) >= kMaxIntDouble) {
+        throw ConversionException("Conversion of ")
+            << Key() << '=' << as_double
+            << " to integer causes precision change";
+      }
+      return static_cast<int64_t>(as_double);
+    }
+    default:
+      throw TypeMismatchException(Type(), BSON_TYPE_INT64, Key());
+  }
+}
+
+template <>
+uint64_t ElementView::As<uint64_t>() const {
+  const auto value = As<int64_t>();
+  if (value < 0) {
+    throw ConversionException("Cannot convert to unsigned value from negative ")
+        << Key() << '=' << value;
+  }
+  return static_cast<uint64_t>(value);
+}
+
+template <>
+double ElementView::As<double>() const {
+  switch (Type()) {
+    case BSON_TYPE_DOUBLE:
+      return bson_iter_double_unsafe(&iter_);
+    case BSON_TYPE_INT32:
+      return bson_iter_int32_unsafe(&iter_);
+    case BSON_TYPE_INT64: {
+      const auto as_int = bson_iter_int64_unsafe(&iter_);
+      if (as_int == std::numeric_limits<int64_t>::min() ||
+          std::abs(as_int) > kMaxIntDouble) {
+        throw ConversionException("Conversion of ")
+            << Key() << '=' << as_int << " to double causes precision loss";
+      }
+      return static_cast<double>(as_int);
+    }
+    default:
+      throw TypeMismatchException(Type(), BSON_TYPE_DOUBLE, Key());
+  }
+}
+
+template <>
+std::string_view ElementView::As<std::string_view>() const {
+  if (IsString()) {
+    uint32_t length = 0;
+    const char* data = bson_iter_utf8(&iter_, &length);
+    return {data, length};
+  }
+  throw TypeMismatchException(Type(), BSON_TYPE_UTF8, Key());
+}
+
+template <>
+std::string ElementView::As<std::string>() const {
+  return std::string{As<std::string_view>()};
+}
+
+template <>
+std::chrono::system_clock::time_point
+ElementView::As<std::chrono::system_clock::time_point>() const {
+  if (IsDateTime()) {
+    return std::chrono::system_clock::time_point{
+        std::chrono::milliseconds{bson_iter_date_time(&iter_)}};
+  }
+  throw TypeMismatchException(Type(), BSON_TYPE_DATE_TIME, Key());
+}
+
+template <>
+Oid ElementView::As<Oid>() const {
+  if (IsOid()) return *bson_iter_oid(&iter_);
+  throw TypeMismatchException(Type(), BSON_TYPE_OID, Key());
+}
+
+template <>
+DocumentView ElementView::As<DocumentView>() const {
+  uint32_t length = 0;
+  const uint8_t* data = nullptr;
+  if (IsDocument()) {
+    bson_iter_document(&iter_, &length, &data);
+  } else if (IsArray()) {
+    bson_iter_array(&iter_, &length, &data);
+  } else {
+    throw TypeMismatchException(Type(), BSON_TYPE_DOCUMENT, Key());
+  }
+  return {data, length};
+}
+
+DocumentView::DocumentView(const Document& document)
+    : data_(bson_get_data(document.GetBson().get())),
+      length_(document.GetBson()->len) {}
+
+DocumentView::Iterator::Iterator(const DocumentView& view) : is_end_(false) {
+  if (!bson_iter_init_from_data(&current_.iter_, view.data_, view.length_)) {
+    throw ParseException("Malformed BSON document");
+  }
+  Advance();
+}
+
+void DocumentView::Iterator::Advance() {
+  if (bson_iter_next(&current_.iter_)) return;
+  is_end_ = true;
+  if (current_.iter_.err_off) {
+    throw ParseException("Malformed BSON document at offset ")
+        << current_.iter_.err_off;
+  }
+}
+
+std::optional<ElementView> DocumentView::Find(std::string_view key) const {
+  for (const auto& element : *this) {
+    if (element.Key() == key) return element;
+  }
+  return std::nullopt;
+}
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
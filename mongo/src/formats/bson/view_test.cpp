@@ -0,0 +1,94 @@
+#include <userver/formats/bson/view.hpp>
+
+#include <gtest/gtest.h>
+
+#include <userver/formats/bson.hpp>
+#include <userver/utest/assert_macros.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fb = formats::bson;
+
+namespace {
+
+const auto kDoc = fb::MakeDoc(
+    "str", "value", "i32", 42, "i64", int64_t{1} << 40, "d", 2.5, "bool", true,
+    "null", nullptr, "doc", fb::MakeDoc("nested", "x"), "arr",
+    fb::MakeArray(1, 2, 3));
+
+}  // namespace
+
+TEST(BsonView, Iteration) {
+  const fb::DocumentView view{kDoc};
+  std::vector<std::string_view> keys;
+  for (const auto& element : view) keys.push_back(element.Key());
+  EXPECT_EQ(keys, (std::vector<std::string_view>{"str", "i32", "i64", "d",
+                                                 "bool", "null", "doc",
+                                                 "arr"}));
+  EXPECT_FALSE(view.IsEmpty());
+  EXPECT_TRUE(fb::DocumentView{fb::Document{}}.IsEmpty());
+}
+
+TEST(BsonView, Scalars) {
+  const fb::DocumentView view{kDoc};
+  EXPECT_EQ(view.Find("str")->As<std::string_view>(), "value");
+  EXPECT_EQ(view.Find("str")->As<std::string>(), "value");
+  EXPECT_EQ(view.Find("i32")->As<int32_t>(), 42);
+  EXPECT_EQ(view.Find("i32")->As<int64_t>(), 42);
+  EXPECT_EQ(view.Find("i32")->As<double>(), 42.0);
+  EXPECT_EQ(view.Find("i64")->As<int64_t>(), int64_t{1} << 40);
+  EXPECT_EQ(view.Find("i64")->As<uint64_t>(), uint64_t{1} << 40);
+  EXPECT_EQ(view.Find("d")->As<double>(), 2.5);
+  EXPECT_TRUE(view.Find("bool")->As<bool>());
+  EXPECT_TRUE(view.Find("null")->IsNull());
+  EXPECT_FALSE(view.Find("missing"));
+}
+
+TEST(BsonView, Nested) {
+  const fb::DocumentView view{kDoc};
+  const auto nested = view.Find("doc")->As<fb::DocumentView>();
+  EXPECT_EQ(nested.Find("nested")->As<std::string_view>(), "x");
+
+  int64_t sum = 0;
+  for (const auto& element : view.Find("arr")->As<fb::DocumentView>()) {
+    sum += element.As<int64_t>();
+  }
+  EXPECT_EQ(sum, 6);
+}
+
+TEST(BsonView, Errors) {
+  const fb::DocumentView view{kDoc};
+  UEXPECT_THROW(view.Find("str")->As<int64_t>(), fb::TypeMismatchException);
+  UEXPECT_THROW(view.Find("i64")->As<int32_t>(), fb::ConversionException);
+  UEXPECT_THROW(view.Find("d")->As<int64_t>(), fb::ConversionException);
+  UEXPECT_THROW(view.Find("i32")->As<fb::DocumentView>(),
+                fb::TypeMismatchException);
+
+  const uint8_t kMalformed[] = {5, 0, 0, 0, 1};
+  UEXPECT_THROW(fb::DocumentView(kMalformed, sizeof(kMalformed)).begin(),
+                fb::ParseException);
+}
+
+TEST(BsonView, SameAsValue) {
+  const auto doc = fb::FromJsonString(
+      R"({"a": {"b": [1, 2.5, "s"]}, "ts": {"$date": 1600000000000}})");
+  const fb::DocumentView view{doc};
+
+  const auto arr = view.Find("a")
+                       ->As<fb::DocumentView>()
+                       .Find("b")
+                       ->As<fb::DocumentView>();
+  auto it = arr.begin();
+  EXPECT_EQ(it->As<int64_t>(), doc["a"]["b"][0].As<int64_t>());
+  ++it;
+  EXPECT_EQ(it->As<double>(), doc["a"]["b"][1].As<double>());
+  ++it;
+  EXPECT_EQ(it->As<std::string>(), doc["a"]["b"][2].As<std::string>());
+  ++it;
+  EXPECT_EQ(it, arr.end());
+
+  EXPECT_EQ(view.Find("ts")->As<std::chrono::system_clock::time_point>(),
+            doc["ts"].As<std::chrono::system_clock::time_point>());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,189 @@
+#include <userver/storages/mongo/batching_collection.hpp>
+
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/formats/bson/inline.hpp>
+#include <userver/storages/mongo/bulk.hpp>
+#include <userver/storages/mongo/exception.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+
+namespace {
+
+std::exception_ptr MakeExceptionPtr(const MongoError& error,
+                                    std::string prefix) {
+  try {
+    error.Throw(std::move(prefix));
+  } catch (const std::exception&) {
+    return std::current_exception();
+  }
+}
+
+}  // namespace
+
+class BatchingCollection::Impl final {
+ public:
+  Impl(Collection&& collection, Config&& config)
+      : collection_(std::move(collection)), config_(std::move(config)) {
+    UINVARIANT(config_.max_batch_size > 0, "max_batch_size must be positive");
+  }
+
+  ~Impl() { tasks_.CancelAndWait(); }
+
+  std::optional<formats::bson::Value> Execute(Write&& write);
+
+ private:
+  struct Request {
+    explicit Request(Write&& write) : write(std::move(write)) {}
+
+    Write write;
+    // the upserted id, if any
+    engine::Promise<std::optional<formats::bson::Value>> promise;
+  };
+
+  struct Batch {
+    std::vector<Request> requests;
+    engine::SingleConsumerEvent full;
+  };
+
+  void RunBatch(Batch& batch);
+  void ExecuteBatch(std::vector<Request>& requests);
+
+  Collection collection_;
+  const Config config_;
+  engine::Mutex mutex_;
+  std::shared_ptr<Batch> open_batch_;
+  concurrent::BackgroundTaskStorageCore tasks_;
+};
+
+std::optional<formats::bson::Value> BatchingCollection::Impl::Execute(
+    Write&& write) {
+  engine::Future<std::optional<formats::bson::Value>> future;
+  {
+    std::lock_guard lock{mutex_};
+    if (!open_batch_) {
+      open_batch_ = std::make_shared<Batch>();
+      // Critical, as the other tasks wait for the batch
+      tasks_.Detach(engine::CriticalAsyncNoSpan(
+          [this, batch = open_batch_] { RunBatch(*batch); }));
+    }
+    auto& request = open_batch_->requests.emplace_back(std::move(write));
+    future = request.promise.get_future();
+    if (open_batch_->requests.size() >= config_.max_batch_size) {
+      open_batch_->full.Send();
+      open_batch_.reset();
+    }
+  }
+  return future.get();
+}
+
+void BatchingCollection::Impl::RunBatch(Batch& batch) {
+  [[maybe_unused]] const bool is_full =
+      batch.full.WaitForEventFor(config_.max_delay);
+
+  std::vector<Request> requests;
+  {
+    std::lock_guard lock{mutex_};
+    if (open_batch_.get() == &batch) open_batch_.reset();
+    requests = std::move(batch.requests);
+  }
+
+  if (engine::current_task::ShouldCancel()) {
+    std::exception_ptr error;
+    try {
+      // MongoException is not copyable for std::make_exception_ptr
+      throw MongoException("Batching collection is being destroyed");
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+    for (auto& request : requests) request.promise.set_exception(error);
+    return;
+  }
+
+  ExecuteBatch(requests);
+}
+
+void BatchingCollection::Impl::ExecuteBatch(std::vector<Request>& requests) {
+  operations::Bulk bulk(operations::Bulk::Mode::kUnordered);
+  bulk.SetOption(options::SuppressServerExceptions{});
+  if (config_.write_concern) bulk.SetOption(*config_.write_concern);
+  for (const auto& request : requests) {
+    std::visit([&bulk](const auto& write) { bulk.Append(write); },
+               request.write);
+  }
+
+  WriteResult bulk_result;
+  try {
+    bulk_result = collection_.Execute(std::move(bulk));
+  } catch (const std::exception&) {
+    for (auto& request : requests) {
+      request.promise.set_exception(std::current_exception());
+    }
+    return;
+  }
+
+  const auto server_errors = bulk_result.ServerErrors();
+  const auto upserted_ids = bulk_result.UpsertedIds();
+  std::exception_ptr write_concern_error;
+  if (const auto wc_errors = bulk_result.WriteConcernErrors();
+      !wc_errors.empty()) {
+    write_concern_error =
+        MakeExceptionPtr(wc_errors.front(), "Write concern error");
+  }
+
+  for (std::size_t i = 0; i < requests.size(); ++i) {
+    auto& promise = requests[i].promise;
+    if (const auto it = server_errors.find(i); it != server_errors.end()) {
+      promise.set_exception(
+          MakeExceptionPtr(it->second, "Error executing a batched write"));
+    } else if (write_concern_error) {
+      promise.set_exception(write_concern_error);
+    } else {
+      std::optional<formats::bson::Value> upserted_id;
+      if (const auto it = upserted_ids.find(i); it != upserted_ids.end()) {
+        upserted_id = it->second;
+      }
+      promise.set_value(std::move(upserted_id));
+    }
+  }
+}
+
+BatchingCollection::BatchingCollection(Collection collection, Config config)
+    : impl_(std::make_unique<Impl>(std::move(collection), std::move(config))) {}
+
+BatchingCollection::~BatchingCollection() = default;
+
+WriteResult BatchingCollection::InsertOne(formats::bson::Document document) {
+  Execute(bulk_ops::InsertOne{std::move(document)});
+  // An insert either succeeds or throws, so the count is known
+  return WriteResult{formats::bson::MakeDoc("nInserted", 1)};
+}
+
+void BatchingCollection::DeleteOne(formats::bson::Document selector) {
+  Execute(
+      bulk_ops::Delete{bulk_ops::Delete::Mode::kSingle, std::move(selector)});
+}
+
+std::optional<formats::bson::Value> BatchingCollection::Execute(
+    Write&& write) {
+  return impl_->Execute(std::move(write));
+}
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
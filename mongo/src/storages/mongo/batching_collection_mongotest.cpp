@@ -0,0 +1,72 @@
+#include <userver/utest/utest.hpp>
+
+#include <vector>
+
+#include <storages/mongo/util_mongotest.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/formats/bson.hpp>
+#include <userver/storages/mongo.hpp>
+#include <userver/storages/mongo/batching_collection.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace bson = formats::bson;
+namespace mongo = storages::mongo;
+
+namespace {
+class BatchingCollection : public MongoPoolFixture {};
+}  // namespace
+
+UTEST_F_MT(BatchingCollection, ConcurrentInserts, 4) {
+  auto coll = GetDefaultPool().GetCollection("batching_inserts");
+  mongo::BatchingCollection batching{coll, {/*max_batch_size=*/16}};
+
+  constexpr int kWrites = 100;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kWrites);
+  for (int i = 0; i < kWrites; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&batching, i] {
+      const auto result = batching.InsertOne(bson::MakeDoc("_id", i));
+      EXPECT_EQ(1, result.InsertedCount());
+    }));
+  }
+  engine::WaitAllChecked(tasks);
+
+  EXPECT_EQ(kWrites, coll.CountApprox());
+}
+
+UTEST_F(BatchingCollection, Errors) {
+  auto coll = GetDefaultPool().GetCollection("batching_errors");
+  coll.InsertOne(bson::MakeDoc("_id", 1));
+  mongo::BatchingCollection batching{coll, {/*max_batch_size=*/2}};
+
+  auto duplicate = engine::AsyncNoSpan(
+      [&batching] { batching.InsertOne(bson::MakeDoc("_id", 1)); });
+  auto unique = engine::AsyncNoSpan(
+      [&batching] { return batching.InsertOne(bson::MakeDoc("_id", 2)); });
+
+  UEXPECT_THROW(duplicate.Get(), mongo::DuplicateKeyException);
+  EXPECT_EQ(1, unique.Get().InsertedCount());
+  EXPECT_EQ(2, coll.CountApprox());
+}
+
+UTEST_F(BatchingCollection, Upsert) {
+  auto coll = GetDefaultPool().GetCollection("batching_upsert");
+  mongo::BatchingCollection batching{coll, {}};
+
+  auto result = batching.UpdateOne(bson::MakeDoc("x", 1),
+                                   bson::MakeDoc("$set", bson::MakeDoc("y", 2)),
+                                   mongo::options::Upsert{});
+  ASSERT_TRUE(result.upserted_id);
+  EXPECT_EQ(1, coll.Count(bson::MakeDoc("_id", *result.upserted_id)));
+
+  result = batching.ReplaceOne(bson::MakeDoc("x", 1), bson::MakeDoc("x", 3));
+  EXPECT_FALSE(result.upserted_id);
+  EXPECT_EQ(1, coll.Count(bson::MakeDoc("x", 3)));
+
+  batching.DeleteOne(bson::MakeDoc("x", 3));
+  EXPECT_EQ(0, coll.CountApprox());
+}
+
+USERVER_NAMESPACE_END
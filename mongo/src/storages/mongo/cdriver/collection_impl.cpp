@@ -17,6 +17,7 @@
 #include <formats/bson/wrappers.hpp>
 #include <storages/mongo/cdriver/cursor_impl.hpp>
 #include <storages/mongo/cdriver/pool_impl.hpp>
+#include <storages/mongo/cdriver/prefetching_cursor_impl.hpp>
 #include <storages/mongo/cdriver/wrappers.hpp>
 #include <storages/mongo/operations_common.hpp>
 #include <storages/mongo/operations_impl.hpp>
@@ -266,6 +267,13 @@ Cursor CDriverCollectionImpl::Execute(const operations::Find& operation) const {
   impl::cdriver::CursorPtr cdriver_cursor(mongoc_collection_find_with_opts(
       context.collection.get(), native_filter_bson_ptr,
       impl::GetNative(options), operation.impl_->read_prefs.Get()));
+  if (operation.impl_->prefetch_target_batch_bytes &&
+      !operation.impl_->is_tailable) {
+    return Cursor(std::make_unique<impl::cdriver::CDriverPrefetchingCursorImpl>(
+        std::move(context.client), std::move(cdriver_cursor),
+        std::move(context.stats),
+        operation.impl_->prefetch_target_batch_bytes));
+  }
   return Cursor(std::make_unique<impl::cdriver::CDriverCursorImpl>(
       std::move(context.client), std::move(cdriver_cursor),
       std::move(context.stats)));
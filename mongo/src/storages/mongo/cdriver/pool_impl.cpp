@@ -1,6 +1,7 @@
 #include <storages/mongo/cdriver/pool_impl.hpp>
 
 #include <limits>
+#include <mutex>
 
 #include <bson/bson.h>
 #include <fmt/chrono.h>
@@ -31,6 +32,7 @@ utils::impl::UserverExperiment kServerSelectionTimeoutExperiment{
 
 const std::string kMaintenanceTaskName = "mongo_maintenance";
 constexpr size_t kIdleConnectionDropRate = 1;
+constexpr size_t kPrewarmConnectionRate = 1;
 
 int32_t CheckedDurationMs(const std::chrono::milliseconds& timeout,
                           const char* name) {
@@ -167,13 +169,12 @@ CDriverPoolImpl::CDriverPoolImpl(std::string id, const std::string& uri_string,
       init_data_{dns_resolver, {}},
       max_size_(config.max_size),
       idle_limit_(config.idle_limit),
+      initial_size_(config.initial_size),
       queue_timeout_(config.queue_timeout),
       size_(0),
       in_use_semaphore_(config.max_size),
       connecting_semaphore_(config.connecting_limit),
-      // FP?: pointer magic in boost.lockfree
-      // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-      queue_(config.max_size) {
+      idle_clients_(config.max_size) {
   static const GlobalInitializer kInitMongoc;
   GlobalInitializer::LogInitWarningsOnce();
   CheckAsyncStreamCompatible();
@@ -211,8 +212,8 @@ CDriverPoolImpl::~CDriverPoolImpl() {
   maintenance_task_.Stop();
 
   const ClientDeleter deleter;
-  mongoc_client_t* client = nullptr;
-  while (queue_.pop(client)) deleter(client);
+  for (auto* client : idle_clients_) deleter(client);
+  idle_clients_.clear();
 }
 
 size_t CDriverPoolImpl::InUseApprox() const {
@@ -319,7 +320,14 @@ void CDriverPoolImpl::Push(mongoc_client_t* client) noexcept {
     Drop(client);
     client = nullptr;
   }
-  if (client && !queue_.bounded_push(client)) Drop(client);
+  if (client) {
+    const std::lock_guard lock{idle_mutex_};
+    if (!idle_clients_.full()) {
+      idle_clients_.push_back(client);
+      client = nullptr;
+    }
+  }
+  Drop(client);
 
   in_use_semaphore_.unlock_shared();
 }
@@ -333,9 +341,19 @@ void CDriverPoolImpl::Drop(mongoc_client_t* client) noexcept {
 }
 
 mongoc_client_t* CDriverPoolImpl::TryGetIdle() {
-  mongoc_client_t* client = nullptr;
-  if (queue_.pop(client)) return client;
-  return nullptr;
+  const std::lock_guard lock{idle_mutex_};
+  if (idle_clients_.empty()) return nullptr;
+  auto* const client = idle_clients_.back();
+  idle_clients_.pop_back();
+  return client;
+}
+
+mongoc_client_t* CDriverPoolImpl::TryGetOldestIdle() {
+  const std::lock_guard lock{idle_mutex_};
+  if (idle_clients_.empty()) return nullptr;
+  auto* const client = idle_clients_.front();
+  idle_clients_.pop_front();
+  return client;
 }
 
 mongoc_client_t* CDriverPoolImpl::Create() {
@@ -378,11 +396,37 @@ void CDriverPoolImpl::DoMaintenance() {
   for (auto idle_drop_left = kIdleConnectionDropRate;
        idle_drop_left && size_.load() > idle_limit_; --idle_drop_left) {
     LOG_TRACE() << "Trying to drop idle connection";
-    Drop(TryGetIdle());
+    Drop(TryGetOldestIdle());
   }
+  Prewarm();
   LOG_DEBUG() << "Finished mongo pool '" << Id() << "' maintenance";
 }
 
+void CDriverPoolImpl::Prewarm() {
+  // Restores the connections lost on errors or on failed prepopulation in
+  // background, so that bursts do not have to establish them synchronously
+  for (auto prewarm_left = kPrewarmConnectionRate;
+       prewarm_left && size_.load() < initial_size_; --prewarm_left) {
+    engine::SemaphoreLock in_use_lock(in_use_semaphore_, std::try_to_lock);
+    if (!in_use_lock) return;
+    const engine::SemaphoreLock connecting_lock(connecting_semaphore_,
+                                                std::try_to_lock);
+    if (!connecting_lock) return;
+
+    LOG_TRACE() << "Trying to prewarm a connection";
+    try {
+      auto* client = Create();
+      // Push releases the in_use_semaphore_
+      in_use_lock.Release();
+      Push(client);
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "Failed to prewarm a connection in mongo pool '" << Id()
+                    << "': " << ex;
+      return;
+    }
+  }
+}
+
 }  // namespace storages::mongo::impl::cdriver
 
 USERVER_NAMESPACE_END
@@ -3,7 +3,7 @@
 #include <chrono>
 
 #include <mongoc/mongoc.h>
-#include <boost/lockfree/queue.hpp>
+#include <boost/circular_buffer.hpp>
 
 #include <storages/mongo/cdriver/async_stream.hpp>
 #include <storages/mongo/cdriver/wrappers.hpp>
@@ -11,6 +11,7 @@
 #include <storages/mongo/pool_impl.hpp>
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/semaphore.hpp>
 #include <userver/storages/mongo/pool_config.hpp>
 #include <userver/utils/assert.hpp>
@@ -59,10 +60,14 @@ class CDriverPoolImpl final : public PoolImpl {
   void Push(mongoc_client_t*) noexcept;
   void Drop(mongoc_client_t*) noexcept;
 
+  // The most recently used idle connection
   mongoc_client_t* TryGetIdle();
+  // The connection that has stayed idle for the longest time
+  mongoc_client_t* TryGetOldestIdle();
   mongoc_client_t* Create();
 
   void DoMaintenance();
+  void Prewarm();
 
   const std::string app_name_;
   std::string default_database_;
@@ -71,11 +76,16 @@ class CDriverPoolImpl final : public PoolImpl {
 
   std::atomic<size_t> max_size_;
   const size_t idle_limit_;
+  const size_t initial_size_;
   const std::chrono::milliseconds queue_timeout_;
   std::atomic<size_t> size_;
   engine::Semaphore in_use_semaphore_;
   engine::Semaphore connecting_semaphore_;
-  boost::lockfree::queue<mongoc_client_t*> queue_;
+  // Idle connections in the order they were returned to the pool. The most
+  // recently used ones at the back are reused first, the maintenance drops
+  // the ones at the front that have stayed idle the longest.
+  engine::Mutex idle_mutex_;
+  boost::circular_buffer<mongoc_client_t*> idle_clients_;
   utils::PeriodicTask maintenance_task_;
 };
 
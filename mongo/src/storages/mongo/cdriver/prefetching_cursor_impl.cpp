@@ -0,0 +1,215 @@
+#include <storages/mongo/cdriver/prefetching_cursor_impl.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <bson/bson.h>
+#include <mongoc/mongoc.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/storages/mongo/mongo_error.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <formats/bson/wrappers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Fallback to this function if mongoc.h does not
+// provide mongoc_cursor_get_batch_num
+template <class... T>
+int mongoc_cursor_get_batch_num(const T*...) noexcept {
+  return -1;
+}
+
+}  // namespace
+
+namespace storages::mongo::impl::cdriver {
+
+namespace {
+
+// The same as the server default for the initial batch
+constexpr std::size_t kInitialBatchSize = 101;
+constexpr std::size_t kMaxBatchSize = 100'000;
+
+// Well below the 16MiB server limit for a single batch
+constexpr std::size_t kMaxTargetBatchBytes = 8 * 1024 * 1024;
+
+}  // namespace
+
+BatchSizeTuner::BatchSizeTuner(std::size_t target_batch_bytes)
+    : min_target_bytes_(target_batch_bytes),
+      target_bytes_(target_batch_bytes) {
+  UASSERT(target_batch_bytes > 0);
+}
+
+void BatchSizeTuner::AccountDocument(std::size_t size) {
+  ++documents_;
+  bytes_ += size;
+}
+
+void BatchSizeTuner::OnConsumerStarved() {
+  target_bytes_ = std::max(std::min(target_bytes_ * 2, kMaxTargetBatchBytes),
+                           min_target_bytes_);
+}
+
+void BatchSizeTuner::OnConsumerBusy() {
+  target_bytes_ = std::max(target_bytes_ / 2, min_target_bytes_);
+}
+
+std::size_t BatchSizeTuner::GetBatchSize() const {
+  if (!documents_) return kInitialBatchSize;
+  const auto average_size = std::max<std::size_t>(bytes_ / documents_, 1);
+  return std::clamp<std::size_t>(target_bytes_ / average_size, 1,
+                                 kMaxBatchSize);
+}
+
+CDriverPrefetchingCursorImpl::CDriverPrefetchingCursorImpl(
+    cdriver::CDriverPoolImpl::BoundClientPtr client, cdriver::CursorPtr cursor,
+    std::shared_ptr<stats::OperationStatisticsItem> find_stats,
+    std::size_t target_batch_bytes)
+    : queue_(Queue::Create(1)),
+      consumer_starved_(std::make_shared<std::atomic<bool>>(false)),
+      consumer_(queue_->GetConsumer()) {
+  if (cursor) {
+    // Precondition: we've got a valid cursor (it could be errored-out right
+    // away due to stream selection error, for example).
+    MongoError error;
+    if (mongoc_cursor_error(cursor.get(), error.GetNative())) {
+      error.Throw("Error iterating over query results");
+    }
+    // Not sent yet, applies to the initial 'find'
+    mongoc_cursor_set_batch_size(cursor.get(), kInitialBatchSize);
+  }
+
+  fetch_task_ = engine::AsyncNoSpan(
+      &CDriverPrefetchingCursorImpl::Fetch, std::move(client),
+      std::move(cursor), std::move(find_stats),
+      BatchSizeTuner{target_batch_bytes}, queue_->GetProducer(),
+      consumer_starved_);
+
+  // Prime the cursor
+  PopBatch();
+}
+
+CDriverPrefetchingCursorImpl::~CDriverPrefetchingCursorImpl() = default;
+
+bool CDriverPrefetchingCursorImpl::IsValid() const {
+  return position_ < batch_.documents.size();
+}
+
+bool CDriverPrefetchingCursorImpl::HasMore() const { return !is_exhausted_; }
+
+const formats::bson::Document& CDriverPrefetchingCursorImpl::Current() const {
+  if (!IsValid()) throw std::logic_error("Reading from invalid cursor");
+  return batch_.documents[position_];
+}
+
+void CDriverPrefetchingCursorImpl::Next() {
+  if (!IsValid()) throw std::logic_error("Advancing cursor past the end");
+  if (++position_ < batch_.documents.size()) return;
+  PopBatch();
+}
+
+void CDriverPrefetchingCursorImpl::PopBatch() {
+  batch_ = {};
+  position_ = 0;
+  if (is_exhausted_) return;
+
+  if (!consumer_.PopNoblock(batch_)) {
+    consumer_starved_->store(true);
+    // Cancellation is not supported by the fetching, see AsyncStream
+    const engine::TaskCancellationBlocker block_cancel;
+    if (!consumer_.Pop(batch_)) {
+      is_exhausted_ = true;
+      return;
+    }
+  }
+
+  if (batch_.error) {
+    is_exhausted_ = true;
+    std::rethrow_exception(batch_.error);
+  }
+}
+
+void CDriverPrefetchingCursorImpl::Fetch(
+    cdriver::CDriverPoolImpl::BoundClientPtr client, cdriver::CursorPtr cursor,
+    std::shared_ptr<stats::OperationStatisticsItem> find_stats,
+    BatchSizeTuner tuner, Queue::Producer producer,
+    std::shared_ptr<std::atomic<bool>> consumer_starved) {
+  const auto push = [&](Batch&& batch) {
+    if (consumer_starved->exchange(false)) tuner.OnConsumerStarved();
+    if (producer.PushNoblock(std::move(batch))) return true;
+    tuner.OnConsumerBusy();
+    return producer.Push(std::move(batch));
+  };
+
+  Batch batch;
+  try {
+    std::size_t batch_size = kInitialBatchSize;
+    std::size_t batch_left = batch_size;
+    while (cursor && mongoc_cursor_more(cursor.get())) {
+      if (!batch_left) {
+        // The next document is fetched with a 'getMore', hand over the
+        // current batch before waiting for it
+        if (!batch.documents.empty() && !push(std::move(batch))) return;
+        batch = {};
+        batch_size = tuner.GetBatchSize();
+        batch_left = batch_size;
+        mongoc_cursor_set_batch_size(cursor.get(),
+                                     static_cast<uint32_t>(batch_size));
+      }
+
+      const auto batch_num_before = mongoc_cursor_get_batch_num(cursor.get());
+      stats::OperationStopwatch cursor_next_sw(find_stats, "find");
+
+      const bson_t* current_bson = nullptr;
+      bool has_document = false;
+      MongoError error;
+      while (!mongoc_cursor_error(cursor.get(), error.GetNative()) &&
+             mongoc_cursor_more(cursor.get())) {
+        if (mongoc_cursor_next(cursor.get(), &current_bson)) {
+          has_document = true;
+          break;
+        }
+      }
+      const auto batch_num_after = mongoc_cursor_get_batch_num(cursor.get());
+      if (batch_num_before == batch_num_after) {
+        cursor_next_sw.Discard();
+      } else if (!error) {
+        cursor_next_sw.AccountSuccess();
+      } else {
+        cursor_next_sw.AccountError(error.GetKind());
+      }
+      if (error) error.Throw("Error iterating over query results");
+      if (!has_document) break;
+
+      if (batch_num_before != batch_num_after && batch_left != batch_size) {
+        // The server has cut the previous batch short
+        batch_left = batch_size;
+      }
+      --batch_left;
+
+      tuner.AccountDocument(current_bson->len);
+      batch.documents.emplace_back(
+          formats::bson::impl::MutableBson::CopyNative(current_bson).Extract());
+    }
+    // Release the connection as soon as possible
+    cursor.reset();
+    client.reset();
+  } catch (const std::exception&) {
+    if (!batch.documents.empty() && !push(std::move(batch))) return;
+    batch = {};
+    batch.error = std::current_exception();
+  }
+
+  if (!batch.documents.empty() || batch.error) {
+    [[maybe_unused]] const bool is_pushed = push(std::move(batch));
+  }
+}
+
+}  // namespace storages::mongo::impl::cdriver
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/formats/bson/document.hpp>
+
+#include <storages/mongo/cdriver/pool_impl.hpp>
+#include <storages/mongo/cdriver/wrappers.hpp>
+#include <storages/mongo/cursor_impl.hpp>
+#include <storages/mongo/stats.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::impl::cdriver {
+
+/// Adapts the batch size to the observed document sizes and to the relative
+/// speed of the fetching and of the iteration
+class BatchSizeTuner final {
+ public:
+  explicit BatchSizeTuner(std::size_t target_batch_bytes);
+
+  void AccountDocument(std::size_t size);
+
+  // The consumer had to wait for a batch, fewer round trips are preferable
+  void OnConsumerStarved();
+
+  // The consumer is slower than the fetching, there is no point in larger
+  // batches
+  void OnConsumerBusy();
+
+  std::size_t GetBatchSize() const;
+
+ private:
+  const std::size_t min_target_bytes_;
+  std::size_t target_bytes_;
+  std::size_t documents_{0};
+  std::size_t bytes_{0};
+};
+
+/// Cursor that iterates over batches fetched by a background task
+class CDriverPrefetchingCursorImpl final : public CursorImpl {
+ public:
+  CDriverPrefetchingCursorImpl(
+      cdriver::CDriverPoolImpl::BoundClientPtr, cdriver::CursorPtr,
+      std::shared_ptr<stats::OperationStatisticsItem> find_stats,
+      std::size_t target_batch_bytes);
+
+  ~CDriverPrefetchingCursorImpl() override;
+
+  bool IsValid() const override;
+  bool HasMore() const override;
+
+  const formats::bson::Document& Current() const override;
+  void Next() override;
+
+ private:
+  struct Batch {
+    std::vector<formats::bson::Document> documents;
+    std::exception_ptr error;
+  };
+  using Queue = concurrent::SpscQueue<Batch>;
+
+  // Fetches the batches in the background task
+  static void Fetch(cdriver::CDriverPoolImpl::BoundClientPtr client,
+                    cdriver::CursorPtr cursor,
+                    std::shared_ptr<stats::OperationStatisticsItem> find_stats,
+                    BatchSizeTuner tuner, Queue::Producer producer,
+                    std::shared_ptr<std::atomic<bool>> consumer_starved);
+
+  void PopBatch();
+
+  const std::shared_ptr<Queue> queue_;
+  const std::shared_ptr<std::atomic<bool>> consumer_starved_;
+  engine::TaskWithResult<void> fetch_task_;
+  // Destroyed before 'fetch_task_' to interrupt the fetching
+  Queue::Consumer consumer_;
+  Batch batch_;
+  std::size_t position_{0};
+  bool is_exhausted_{false};
+};
+
+}  // namespace storages::mongo::impl::cdriver
+
+USERVER_NAMESPACE_END
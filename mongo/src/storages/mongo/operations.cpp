@@ -290,6 +290,7 @@ void Find::SetOption(options::Tailable) {
   for (const auto& option : {kTailable, kAwaitData, kNoCursorTimeout}) {
     impl::EnsureBuilder(impl_->options).Append(option, true);
   }
+  impl_->is_tailable = true;
 }
 
 void Find::SetOption(const options::Comment& comment) {
@@ -301,6 +302,14 @@ void Find::SetOption(const options::MaxServerTime& max_server_time) {
   AppendMaxServerTime(impl_->max_server_time, max_server_time);
 }
 
+void Find::SetOption(const options::Prefetch& prefetch) {
+  if (prefetch.TargetBatchBytes() == 0) {
+    throw InvalidQueryArgumentException(
+        "Prefetch target batch size must be positive");
+  }
+  impl_->prefetch_target_batch_bytes = prefetch.TargetBatchBytes();
+}
+
 InsertOne::InsertOne(formats::bson::Document document)
     : impl_(std::move(document)) {}
 
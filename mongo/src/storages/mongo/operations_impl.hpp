@@ -53,7 +53,10 @@ class Find::Impl {
   impl::cdriver::ReadPrefsPtr read_prefs;
   std::optional<formats::bson::impl::BsonBuilder> options;
   bool has_comment_option{false};
+  bool is_tailable{false};
   std::chrono::milliseconds max_server_time{kNoMaxServerTime};
+  // 0 if prefetching is disabled
+  size_t prefetch_target_batch_bytes{0};
 };
 
 class InsertOne::Impl {
@@ -633,6 +633,46 @@ UTEST_F(Options, Comment) {
   UEXPECT_NO_THROW(coll.FindOne({}, mongo::options::Comment{"snarky comment"}));
 }
 
+UTEST_F(Options, Prefetch) {
+  constexpr int kDocumentsCount = 1000;
+  auto coll = GetDefaultPool().GetCollection("prefetch");
+
+  {
+    mongo::operations::InsertMany insert_op;
+    for (int i = 0; i < kDocumentsCount; ++i) {
+      insert_op.Append(bson::MakeDoc("x", i, "payload", std::string(100, 'a')));
+    }
+    coll.Execute(insert_op);
+  }
+
+  const mongo::options::Sort sort{{"x", mongo::options::Sort::kAscending}};
+  for (const std::size_t target_batch_bytes : {1, 1000, 1024 * 1024}) {
+    int expected = 0;
+    for (const auto& doc :
+         coll.Find({}, sort, mongo::options::Prefetch{target_batch_bytes})) {
+      EXPECT_EQ(expected++, doc["x"].As<int>());
+    }
+    EXPECT_EQ(kDocumentsCount, expected);
+  }
+
+  {
+    // Abandoned in the middle of the iteration
+    auto cursor = coll.Find({}, sort, mongo::options::Prefetch{1000});
+    auto it = cursor.begin();
+    for (int i = 0; i < 150; ++i) ++it;
+    EXPECT_EQ(150, (*it)["x"].As<int>());
+  }
+
+  {
+    auto cursor = coll.Find(bson::MakeDoc("x", bson::MakeDoc("$lt", 0)),
+                            mongo::options::Prefetch{});
+    EXPECT_FALSE(cursor);
+  }
+
+  UEXPECT_THROW(coll.Find({}, mongo::options::Prefetch{0}),
+                mongo::InvalidQueryArgumentException);
+}
+
 UTEST_F(Options, MaxServerTime) {
   auto coll = GetDefaultPool().GetCollection("max_server_time");
 
@@ -15,6 +15,7 @@
 #include <userver/storages/mysql/cluster_host_type.hpp>
 #include <userver/storages/mysql/command_result_set.hpp>
 #include <userver/storages/mysql/cursor_result_set.hpp>
+#include <userver/storages/mysql/execution_result.hpp>
 #include <userver/storages/mysql/impl/bind_helper.hpp>
 #include <userver/storages/mysql/options.hpp>
 #include <userver/storages/mysql/query.hpp>
@@ -142,6 +143,45 @@ class Cluster final {
                                  ClusterHostType host_type, const Query& query,
                                  const Container& params) const;
 
+  /// @brief Executes a statement on a host of host_type with default deadline.
+  /// Fills placeholders of the statement with Container::value_type in a
+  /// bulk-manner, splitting the rows into chunks that fit into the
+  /// server `max_allowed_packet`.
+  /// Container is expected to be a std::Container, Container::value_type is
+  /// expected to be an aggregate of supported types.
+  /// See @ref scripts/docs/en/userver/mysql/supported_types.md for better
+  /// understanding of `Container::value_type` requirements.
+  ///
+  /// All the chunks are executed one after another on the same connection
+  /// with the same prepared statement, but not atomically: use a Transaction
+  /// if all-or-nothing semantics is required.
+  /// The resulting ExecutionResult sums up the affected rows of the chunks,
+  /// `last_insert_id` is the one of the first chunk.
+  ///
+  /// @note Requires MariaDB 10.2.6+ as a server
+  ///
+  /// UINVARIANTs on params count mismatch, doesn't validate types.
+  /// UINVARIANTs on empty params container.
+  template <typename Container>
+  ExecutionResult ExecuteBulkChunked(ClusterHostType host_type,
+                                     const Query& query,
+                                     const Container& params) const;
+
+  /// @brief Executes a statement on a host of host_type with provided
+  /// CommandControl.
+  /// Fills placeholders of the statement with Container::value_type in a
+  /// bulk-manner, splitting the rows into chunks that fit into the
+  /// server `max_allowed_packet`.
+  ///
+  /// @note The deadline is for all the chunks, not just for a single one.
+  ///
+  /// @see ExecuteBulkChunked
+  template <typename Container>
+  ExecutionResult ExecuteBulkChunked(OptionalCommandControl command_control,
+                                     ClusterHostType host_type,
+                                     const Query& query,
+                                     const Container& params) const;
+
   // TODO : don't require Container to be const, so Convert can move
   // clang-format off
   /// @brief Executes a statement on a host of host_type with default deadline,
@@ -271,6 +311,10 @@ class Cluster final {
                                impl::io::ParamsBinderBase& params,
                                std::optional<std::size_t> batch_size) const;
 
+  ExecutionResult DoExecuteBulkChunked(
+      OptionalCommandControl command_control, ClusterHostType host_type,
+      const Query& query, impl::io::BulkChunkerBase& chunker) const;
+
   std::unique_ptr<infra::topology::TopologyBase> topology_;
 };
 
@@ -329,6 +373,24 @@ StatementResultSet Cluster::ExecuteBulk(OptionalCommandControl command_control,
                    params_binder, std::nullopt);
 }
 
+template <typename Container>
+ExecutionResult Cluster::ExecuteBulkChunked(ClusterHostType host_type,
+                                            const Query& query,
+                                            const Container& params) const {
+  return ExecuteBulkChunked(std::nullopt, host_type, query, params);
+}
+
+template <typename Container>
+ExecutionResult Cluster::ExecuteBulkChunked(
+    OptionalCommandControl command_control, ClusterHostType host_type,
+    const Query& query, const Container& params) const {
+  UINVARIANT(!params.empty(), "Empty params in bulk execution");
+
+  auto chunker = impl::BindHelper::BindContainerInChunks(params);
+
+  return DoExecuteBulkChunked(command_control, host_type, query, chunker);
+}
+
 template <typename MapTo, typename Container>
 StatementResultSet Cluster::ExecuteBulkMapped(ClusterHostType host_type,
                                               const Query& query,
@@ -26,6 +26,13 @@ class CursorResultSet final {
   ///
   /// Usable when the result set is expected to be big enough to put too
   /// much memory pressure if fetched as a whole.
+  ///
+  /// Rows are fetched from the server `batch_size` (as passed to
+  /// `storages::mysql::Cluster::GetCursor`) at a time and decoded directly
+  /// into a single reusable instance of `T`, which is then moved into
+  /// row_callback, so memory usage doesn't depend on the result set size.
+  /// row_callback is invoked while the connection is held, so it shouldn't
+  /// block for long.
   // TODO : deadline?
   template <typename RowCallback>
   void ForEach(RowCallback&& row_callback, engine::Deadline deadline) &&;
@@ -51,20 +58,11 @@ void CursorResultSet<T>::ForEach(
     RowCallback&& row_callback,
     // TODO : think about separate deadline here
     [[maybe_unused]] engine::Deadline deadline) && {
-  using IntermediateStorage = std::vector<T>;
-
-  bool keep_going = true;
-  auto extractor = impl::io::TypedExtractor<IntermediateStorage, T, RowTag>{};
-
-  while (keep_going) {
-    tracing::ScopeTime fetch{impl::tracing::kFetchScope};
-    keep_going = result_set_.FetchResult(extractor);
+  auto extractor =
+      impl::io::StreamingExtractor<T, RowCallback>{row_callback};
 
-    fetch.Reset(impl::tracing::kForEachScope);
-    IntermediateStorage data{extractor.ExtractData()};
-    for (auto&& row : data) {
-      row_callback(std::move(row));
-    }
+  tracing::ScopeTime fetch{impl::tracing::kFetchScope};
+  while (result_set_.FetchResult(extractor)) {
   }
 }
 
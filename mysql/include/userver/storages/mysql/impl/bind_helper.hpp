@@ -2,6 +2,7 @@
 
 #include <boost/pfr/core.hpp>
 
+#include <userver/storages/mysql/impl/io/bulk_chunker.hpp>
 #include <userver/storages/mysql/impl/io/insert_binder.hpp>
 #include <userver/storages/mysql/impl/io/params_binder.hpp>
 
@@ -36,6 +37,12 @@ class BindHelper final {
     return io::InsertBinder{rows};
   }
 
+  template <typename Container>
+  static io::BulkChunker<Container> BindContainerInChunks(
+      const Container& rows) {
+    return io::BulkChunker<Container>{rows};
+  }
+
   template <typename MapTo, typename Container>
   static io::InsertBinder<Container, MapTo> BindContainerAsParamsMapped(
       const Container& rows) {
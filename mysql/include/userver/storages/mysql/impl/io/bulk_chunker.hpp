@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/meta.hpp>
+
+#include <userver/storages/mysql/impl/io/insert_binder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mysql::impl::io {
+
+class BulkChunkerBase {
+ public:
+  virtual bool HasMore() const = 0;
+
+  /// Binds the rows that follow the previous chunk, as many as fit into
+  /// `max_bytes` of their estimated size, but at least one
+  virtual ParamsBinderBase& BindNextChunk(std::size_t max_bytes) = 0;
+
+  /// Estimated size of the rows of the last bound chunk
+  virtual std::size_t GetChunkBytes() const = 0;
+
+ protected:
+  ~BulkChunkerBase() = default;
+};
+
+// Non-owning view of a subrange of a container, suitable for InsertBinder
+template <typename Container>
+class ContainerChunk final {
+ public:
+  using value_type = typename Container::value_type;
+  using const_iterator = typename Container::const_iterator;
+
+  ContainerChunk(const_iterator begin, const_iterator end, std::size_t size)
+      : begin_{begin}, end_{end}, size_{size} {}
+
+  const_iterator begin() const { return begin_; }
+  const_iterator end() const { return end_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  const_iterator begin_;
+  const_iterator end_;
+  std::size_t size_;
+};
+
+template <typename Container>
+class BulkChunker final : public BulkChunkerBase {
+ public:
+  explicit BulkChunker(const Container& container)
+      : container_{container}, chunk_end_{container_.begin()} {
+    UASSERT(!container_.empty());
+  }
+
+  bool HasMore() const final { return chunk_end_ != container_.end(); }
+
+  ParamsBinderBase& BindNextChunk(std::size_t max_bytes) final {
+    UASSERT(HasMore());
+
+    const auto chunk_begin = chunk_end_;
+    std::size_t rows = 0;
+    chunk_bytes_ = 0;
+    do {
+      chunk_bytes_ += EstimateRowSize(*chunk_end_);
+      ++chunk_end_;
+      ++rows;
+    } while (chunk_end_ != container_.end() &&
+             chunk_bytes_ + EstimateRowSize(*chunk_end_) <= max_bytes);
+
+    // the binder references the chunk
+    binder_.reset();
+    chunk_.emplace(chunk_begin, chunk_end_, rows);
+    return binder_.emplace(*chunk_);
+  }
+
+  std::size_t GetChunkBytes() const final { return chunk_bytes_; }
+
+ private:
+  using Row = typename Container::value_type;
+  using Chunk = ContainerChunk<Container>;
+
+  template <typename T>
+  static std::size_t EstimateSize(const T& value) {
+    if constexpr (std::is_same_v<T, std::string> ||
+                  std::is_same_v<T, std::string_view>) {
+      // length-encoded in the protocol
+      return sizeof(std::uint64_t) + value.size();
+    } else if constexpr (meta::kIsOptional<T>) {
+      return value ? EstimateSize(*value) : 1;
+    } else {
+      return sizeof(T);
+    }
+  }
+
+  static std::size_t EstimateRowSize(const Row& row) {
+    std::size_t size = 0;
+    boost::pfr::for_each_field(
+        row, [&size](const auto& field) { size += EstimateSize(field); });
+    return size;
+  }
+
+  const Container& container_;
+  typename Container::const_iterator chunk_end_;
+  std::size_t chunk_bytes_{0};
+
+  std::optional<Chunk> chunk_;
+  std::optional<InsertBinder<Chunk>> binder_;
+};
+
+}  // namespace storages::mysql::impl::io
+
+USERVER_NAMESPACE_END
@@ -124,6 +124,29 @@ class TypedExtractor final : public ExtractorBase {
   InternalStorageType storage_;
 };
 
+// Binds the result buffers directly to the fields of a single reusable row
+// and hands every fetched row to the callback, so that no intermediate
+// container is materialized.
+template <typename T, typename RowCallback>
+class StreamingExtractor final : public ExtractorBase {
+ public:
+  explicit StreamingExtractor(RowCallback& row_callback);
+
+  void Reserve(std::size_t size) final;
+
+  impl::bindings::OutputBindings& BindNextRow() final;
+
+  void CommitLastRow() final;
+
+  void RollbackLastRow() final;
+
+  std::size_t ColumnsCount() const final;
+
+ private:
+  T row_{};
+  RowCallback& row_callback_;
+};
+
 template <typename Container, typename MapFrom, typename ExtractionTag>
 TypedExtractor<Container, MapFrom, ExtractionTag>::TypedExtractor()
     : ExtractorBase{GetColumnsCount()},
@@ -234,6 +257,39 @@ Container&& ProxyingStorage<Container, MapFrom>::ExtractData() {
   return std::move(data_);
 }
 
+template <typename T, typename RowCallback>
+StreamingExtractor<T, RowCallback>::StreamingExtractor(
+    RowCallback& row_callback)
+    : ExtractorBase{boost::pfr::tuple_size_v<T>},
+      row_callback_{row_callback} {}
+
+template <typename T, typename RowCallback>
+void StreamingExtractor<T, RowCallback>::Reserve(std::size_t) {
+  // no-op, there is nothing to reserve
+}
+
+template <typename T, typename RowCallback>
+impl::bindings::OutputBindings&
+StreamingExtractor<T, RowCallback>::BindNextRow() {
+  // The row might have been moved out by the callback, so we rebind it
+  return binder_.BindTo(row_, RowTag{});
+}
+
+template <typename T, typename RowCallback>
+void StreamingExtractor<T, RowCallback>::CommitLastRow() {
+  row_callback_(std::move(row_));
+}
+
+template <typename T, typename RowCallback>
+void StreamingExtractor<T, RowCallback>::RollbackLastRow() {
+  // no-op, the row is only handed out on commit
+}
+
+template <typename T, typename RowCallback>
+std::size_t StreamingExtractor<T, RowCallback>::ColumnsCount() const {
+  return boost::pfr::tuple_size_v<T>;
+}
+
 }  // namespace storages::mysql::impl::io
 
 USERVER_NAMESPACE_END
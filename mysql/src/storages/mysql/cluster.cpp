@@ -1,5 +1,6 @@
 #include <userver/storages/mysql/cluster.hpp>
 
+#include <algorithm>
 #include <vector>
 
 #include <userver/components/component_config.hpp>
@@ -114,6 +115,37 @@ StatementResultSet Cluster::DoExecute(
   return {std::move(connection), std::move(fetcher), std::move(span)};
 }
 
+ExecutionResult Cluster::DoExecuteBulkChunked(
+    OptionalCommandControl command_control, ClusterHostType host_type,
+    const Query& query, impl::io::BulkChunkerBase& chunker) const {
+  const auto deadline =
+      GetDeadline(command_control, GetDefaultCommandControl());
+
+  tracing::Span span{impl::tracing::kExecuteSpan};
+
+  auto& pool = topology_->SelectPool(host_type);
+  auto connection = pool.Acquire(deadline);
+
+  // leave room for the protocol overhead and estimation errors
+  const auto max_chunk_bytes =
+      std::max(connection->GetMaxAllowedPacket(deadline) / 2, std::size_t{1});
+
+  ExecutionResult result{};
+  std::size_t chunks = 0;
+  while (chunker.HasMore()) {
+    auto& params = chunker.BindNextChunk(max_chunk_bytes);
+    const auto fetcher = connection->ExecuteStatement(
+        query.GetStatement(), params, deadline, std::nullopt);
+
+    result.rows_affected += fetcher.RowsAffected();
+    if (chunks++ == 0) result.last_insert_id = fetcher.LastInsertId();
+    pool.AccountBulkChunk(params.GetRowsCount(), chunker.GetChunkBytes());
+  }
+  span.AddTag("chunks", chunks);
+
+  return result;
+}
+
 }  // namespace storages::mysql
 
 USERVER_NAMESPACE_END
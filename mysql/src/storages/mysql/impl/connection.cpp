@@ -8,6 +8,7 @@
 #include <userver/clients/dns/resolver.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/from_string.hpp>
 #include <userver/tracing/scope_time.hpp>
 
 #include <storages/mysql/impl/metadata/native_client_info.hpp>
@@ -163,6 +164,19 @@ void Connection::Ping(engine::Deadline deadline) {
   });
 }
 
+std::size_t Connection::GetMaxAllowedPacket(engine::Deadline deadline) {
+  if (!max_allowed_packet_) {
+    const auto result = ExecuteQuery("SELECT @@max_allowed_packet", deadline);
+    if (result.RowsCount() != 1 || result.GetRow(0).FieldsCount() != 1) {
+      throw MySQLException{0, "Failed to get max_allowed_packet"};
+    }
+    max_allowed_packet_ =
+        utils::FromString<std::size_t>(result.GetRow(0).GetField(0));
+  }
+
+  return *max_allowed_packet_;
+}
+
 void Connection::Commit(engine::Deadline deadline) {
   auto guard = GetBrokenGuard();
 
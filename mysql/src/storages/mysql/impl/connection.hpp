@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -50,6 +51,9 @@ class Connection final {
 
   void Ping(engine::Deadline deadline);
 
+  // server @@max_allowed_packet, queried once per connection
+  std::size_t GetMaxAllowedPacket(engine::Deadline deadline);
+
   void Commit(engine::Deadline deadline);
   void Rollback(engine::Deadline deadline);
 
@@ -93,6 +97,7 @@ class Connection final {
   MYSQL mysql_{};
 
   metadata::ServerInfo server_info_{};
+  std::optional<std::size_t> max_allowed_packet_;
 
   StatementsCache statements_cache_;
 };
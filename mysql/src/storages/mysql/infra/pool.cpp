@@ -50,6 +50,14 @@ void Pool::Release(ConnectionUniquePtr connection) {
 void Pool::WriteStatistics(utils::statistics::Writer& writer) const {
   writer.ValueWithLabels(stats_,
                          {{"mysql_instance", settings_.endpoint_info.host}});
+  writer["bulk"].ValueWithLabels(
+      bulk_stats_, {{"mysql_instance", settings_.endpoint_info.host}});
+}
+
+void Pool::AccountBulkChunk(std::size_t rows, std::size_t bytes) {
+  ++bulk_stats_.chunks;
+  bulk_stats_.rows.Add(utils::statistics::Rate{rows});
+  bulk_stats_.bytes.Add(utils::statistics::Rate{bytes});
 }
 
 Pool::Pool(clients::dns::Resolver& resolver,
@@ -37,6 +37,8 @@ class Pool final
 
   void WriteStatistics(utils::statistics::Writer& writer) const;
 
+  void AccountBulkChunk(std::size_t rows, std::size_t bytes);
+
   Pool(clients::dns::Resolver& resolver,
        const settings::PoolSettings& pool_settings);
 
@@ -84,6 +86,7 @@ class Pool final
   const settings::PoolSettings settings_;
 
   PoolConnectionStatistics stats_{};
+  PoolBulkStatistics bulk_stats_{};
 
   PoolMonitor monitor_;
 };
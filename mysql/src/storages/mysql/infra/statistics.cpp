@@ -16,6 +16,13 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["busy"] = stats.acquired - stats.released;
 }
 
+void DumpMetric(utils::statistics::Writer& writer,
+                const PoolBulkStatistics& stats) {
+  writer["chunks"] = stats.chunks;
+  writer["rows"] = stats.rows;
+  writer["bytes"] = stats.bytes;
+}
+
 }  // namespace storages::mysql::infra
 
 USERVER_NAMESPACE_END
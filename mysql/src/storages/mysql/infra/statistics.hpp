@@ -2,6 +2,7 @@
 
 #include <cstdint>
 
+#include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/relaxed_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -18,9 +19,18 @@ struct PoolConnectionStatistics final {
   Counter released{};
 };
 
+struct PoolBulkStatistics final {
+  utils::statistics::RateCounter chunks{};
+  utils::statistics::RateCounter rows{};
+  utils::statistics::RateCounter bytes{};
+};
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const PoolConnectionStatistics& stats);
 
+void DumpMetric(utils::statistics::Writer& writer,
+                const PoolBulkStatistics& stats);
+
 }  // namespace storages::mysql::infra
 
 USERVER_NAMESPACE_END
@@ -105,6 +105,39 @@ void batch_insert(benchmark::State& state) {
 }
 BENCHMARK(batch_insert)->Range(1000, 100'000);
 
+void chunked_insert(benchmark::State& state) {
+  engine::RunStandalone([&state] {
+    tests::ClusterWrapper cluster{};
+
+    struct Row final {
+      std::int32_t id{};
+      std::string value;
+    };
+    std::vector<Row> rows_to_insert;
+    rows_to_insert.reserve(state.range(0));
+    for (int i = 0; i < state.range(0); ++i) {
+      rows_to_insert.push_back({i, std::string(1024, 'x')});
+    }
+
+    for (auto _ : state) {
+      state.PauseTiming();
+      tests::TmpTable table{cluster, "Id INT NOT NULL, Value TEXT NOT NULL"};
+      const storages::mysql::Query query{
+          table.FormatWithTableName("INSERT INTO {} VALUES(?, ?)")};
+      state.ResumeTiming();
+
+      cluster->ExecuteBulkChunked(ClusterHostType::kPrimary, query,
+                                  rows_to_insert);
+
+      state.PauseTiming();
+      table.DefaultExecute("DROP TABLE {}");
+      state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK(chunked_insert)->Range(1000, 100'000);
+
 }  // namespace storages::mysql::benches
 
 USERVER_NAMESPACE_END
@@ -86,6 +86,36 @@ UTEST(Cluster, InsertMany) {
   EXPECT_EQ(db_rows, rows_to_insert);
 }
 
+UTEST(Cluster, InsertManyChunked) {
+  ClusterWrapper cluster{};
+  TmpTable table{cluster, "Id INT NOT NULL, Value MEDIUMTEXT NOT NULL"};
+
+  const auto max_allowed_packet =
+      cluster.DefaultExecute("SELECT @@max_allowed_packet")
+          .AsSingleField<std::uint64_t>();
+
+  // the rows don't fit into a single packet
+  const std::string value(256 * 1024, 'x');
+  const auto rows_per_packet =
+      static_cast<int>(max_allowed_packet / value.size());
+  const int rows_count = rows_per_packet + rows_per_packet / 2;
+
+  std::vector<Row> rows_to_insert;
+  rows_to_insert.reserve(rows_count);
+  for (int i = 0; i < rows_count; ++i) rows_to_insert.push_back({i, value});
+
+  const auto result = cluster->ExecuteBulkChunked(
+      ClusterHostType::kPrimary,
+      table.FormatWithTableName("INSERT INTO {}(Id, Value) VALUES(?, ?)"),
+      rows_to_insert);
+  EXPECT_EQ(result.rows_affected, rows_count);
+
+  const auto db_ids = table.DefaultExecute("SELECT Id FROM {} ORDER BY Id")
+                          .AsVector<Id>();
+  ASSERT_EQ(db_ids.size(), rows_count);
+  for (int i = 0; i < rows_count; ++i) EXPECT_EQ(db_ids[i].id, i);
+}
+
 UTEST(Cluster, UpdateMany) {
   ClusterWrapper cluster{};
   TmpTable table{cluster, "Id INT PRIMARY KEY, Value TEXT NOT NULL"};
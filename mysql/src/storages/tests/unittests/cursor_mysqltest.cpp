@@ -82,6 +82,66 @@ UTEST(Cursor, StatementReuseWorks) {
   EXPECT_EQ(db_rows, rows_to_insert);
 }
 
+UTEST(Cursor, VaryingLengthValues) {
+  ClusterWrapper cluster{};
+  TmpTable table{cluster, "Id INT NOT NULL, Value TEXT NOT NULL"};
+
+  // rows are decoded into the same instance, values of different lengths
+  // make sure its buffers are rebound properly
+  constexpr std::size_t rows_count = 15;
+  std::vector<Row> rows_to_insert;
+  rows_to_insert.reserve(rows_count);
+  for (std::size_t i = 0; i < rows_count; ++i) {
+    rows_to_insert.push_back({static_cast<std::int32_t>(i),
+                              std::string((i * 37) % 100, 'a' + i)});
+  }
+  cluster->ExecuteBulk(
+      ClusterHostType::kPrimary,
+      table.FormatWithTableName("INSERT INTO {}(Id, Value) VALUES(?, ?)"),
+      rows_to_insert);
+
+  std::vector<Row> db_rows;
+  cluster
+      ->GetCursor<Row>(
+          ClusterHostType::kPrimary, 4,
+          table.FormatWithTableName("SELECT Id, Value FROM {} ORDER BY Id"))
+      .ForEach([&db_rows](Row&& row) { db_rows.push_back(std::move(row)); },
+               cluster.GetDeadline());
+  EXPECT_EQ(db_rows, rows_to_insert);
+}
+
+UTEST(Cursor, CallbackThrows) {
+  ClusterWrapper cluster{};
+  TmpTable table{cluster, "Id INT NOT NULL, Value TEXT NOT NULL"};
+
+  std::vector<Row> rows_to_insert;
+  for (std::int32_t i = 0; i < 10; ++i) {
+    rows_to_insert.push_back({i, utils::generators::GenerateUuid()});
+  }
+  cluster->ExecuteBulk(
+      ClusterHostType::kPrimary,
+      table.FormatWithTableName("INSERT INTO {}(Id, Value) VALUES(?, ?)"),
+      rows_to_insert);
+
+  std::size_t rows_seen = 0;
+  auto cursor = cluster->GetCursor<Row>(
+      ClusterHostType::kPrimary, 3,
+      table.FormatWithTableName("SELECT Id, Value FROM {}"));
+  UEXPECT_THROW(
+      std::move(cursor).ForEach(
+          [&rows_seen](Row&&) {
+            if (++rows_seen == 5) throw std::runtime_error{"stop"};
+          },
+          cluster.GetDeadline()),
+      std::runtime_error);
+  EXPECT_EQ(rows_seen, 5);
+
+  // the cluster is still usable
+  const auto db_rows =
+      table.DefaultExecute("SELECT Id, Value FROM {}").AsVector<Row>();
+  EXPECT_EQ(db_rows.size(), rows_to_insert.size());
+}
+
 }  // namespace storages::mysql::tests
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,84 @@
+#pragma once
+
+/// @file userver/otlp/exporter/component.hpp
+/// @brief @copybrief otlp::ExporterComponent
+
+#include <memory>
+
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+namespace impl {
+class Exporter;
+}
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Exports the spans and the metrics of the service to an
+/// OpenTelemetry collector over OTLP/gRPC
+///
+/// The finished spans are put into a bounded queue, that never blocks the
+/// traced code, and are sent to the collector in batches from a background
+/// task. The spans that do not fit into the queue, e.g. while the collector
+/// is unavailable, are dropped. The metrics of components::StatisticsStorage
+/// are sent periodically.
+///
+/// The spans are exported regardless of the tail sampling of the tracer logs.
+///
+/// ## Static configuration example:
+///
+/// ```
+/// # yaml
+/// otlp-exporter:
+///     endpoint: otel-collector:4317
+///     service-name: my-service
+///     max-batch-size: 512
+///     send-period: 1s
+///     metrics-period: 10s
+/// ```
+///
+/// ## Static options:
+/// Name              | Description                                                  | Default value
+/// ----------------- | ------------------------------------------------------------ | -------------
+/// endpoint          | 'host:port' of the OTLP/gRPC collector                       | -
+/// factory-component | name of the ugrpc::client::ClientFactoryComponent to use     | grpc-client-factory
+/// service-name      | value of the 'service.name' resource attribute               | -
+/// max-queue-size    | spans that do not fit into the queue are dropped             | 65536
+/// max-batch-size    | max spans in a single export request                         | 512
+/// send-period       | the queued spans are sent at least this often                | 1s
+/// metrics-period    | the metrics are sent this often                              | 10s
+/// timeout           | timeout of a single export request                           | 1s
+/// export-traces     | whether to export the spans                                  | true
+/// export-metrics    | whether to export the metrics                                | true
+
+// clang-format on
+
+class ExporterComponent final : public components::LoggableComponentBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of otlp::ExporterComponent
+  static constexpr std::string_view kName = "otlp-exporter";
+
+  ExporterComponent(const components::ComponentConfig& config,
+                    const components::ComponentContext& context);
+  ~ExporterComponent() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::shared_ptr<impl::Exporter> exporter_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace otlp
+
+template <>
+inline constexpr bool components::kHasValidate<otlp::ExporterComponent> = true;
+
+USERVER_NAMESPACE_END
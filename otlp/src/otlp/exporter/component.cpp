@@ -0,0 +1,126 @@
+#include <userver/otlp/exporter/component.hpp>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/tracing/tracer.hpp>
+#include <userver/ugrpc/client/client_factory_component.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <otlp/exporter/exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp {
+
+namespace {
+
+impl::ExporterSettings ParseSettings(
+    const components::ComponentConfig& config) {
+  impl::ExporterSettings settings;
+  settings.service_name = config["service-name"].As<std::string>();
+  settings.max_queue_size =
+      config["max-queue-size"].As<std::size_t>(settings.max_queue_size);
+  settings.max_batch_size =
+      config["max-batch-size"].As<std::size_t>(settings.max_batch_size);
+  settings.send_period = config["send-period"].As<std::chrono::milliseconds>(
+      settings.send_period);
+  settings.metrics_period =
+      config["metrics-period"].As<std::chrono::milliseconds>(
+          settings.metrics_period);
+  settings.timeout =
+      config["timeout"].As<std::chrono::milliseconds>(settings.timeout);
+  settings.export_traces =
+      config["export-traces"].As<bool>(settings.export_traces);
+  settings.export_metrics =
+      config["export-metrics"].As<bool>(settings.export_metrics);
+  return settings;
+}
+
+}  // namespace
+
+ExporterComponent::ExporterComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : LoggableComponentBase(config, context) {
+  auto& factory = context
+                      .FindComponent<ugrpc::client::ClientFactoryComponent>(
+                          config["factory-component"].As<std::string>(
+                              ugrpc::client::ClientFactoryComponent::kName))
+                      .GetFactory();
+  const auto endpoint = config["endpoint"].As<std::string>();
+  auto& storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+
+  exporter_ = std::make_shared<impl::Exporter>(
+      ParseSettings(config),
+      factory.MakeClient<impl::TraceServiceClient>(config.Name(), endpoint),
+      factory.MakeClient<impl::MetricsServiceClient>(config.Name(), endpoint),
+      storage);
+  tracing::Tracer::SetSpanExporter(exporter_);
+
+  statistics_holder_ = storage.RegisterWriter(
+      "otlp.exporter", [this](utils::statistics::Writer& writer) {
+        exporter_->WriteStatistics(writer);
+      });
+}
+
+ExporterComponent::~ExporterComponent() {
+  statistics_holder_.Unregister();
+  tracing::Tracer::SetSpanExporter(nullptr);
+  exporter_->Stop();
+}
+
+yaml_config::Schema ExporterComponent::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
+type: object
+description: Exports the spans and the metrics to an OpenTelemetry collector
+additionalProperties: false
+properties:
+    endpoint:
+        type: string
+        description: "'host:port' of the OTLP/gRPC collector"
+    factory-component:
+        type: string
+        description: name of the ugrpc::client::ClientFactoryComponent to use
+        defaultDescription: grpc-client-factory
+    service-name:
+        type: string
+        description: value of the 'service.name' resource attribute
+    max-queue-size:
+        type: integer
+        description: spans that do not fit into the queue are dropped
+        defaultDescription: 65536
+        minimum: 1
+    max-batch-size:
+        type: integer
+        description: max spans in a single export request
+        defaultDescription: 512
+        minimum: 1
+    send-period:
+        type: string
+        description: the queued spans are sent at least this often
+        defaultDescription: 1s
+    metrics-period:
+        type: string
+        description: the metrics are sent this often
+        defaultDescription: 10s
+    timeout:
+        type: string
+        description: timeout of a single export request
+        defaultDescription: 1s
+    export-traces:
+        type: boolean
+        description: whether to export the spans
+        defaultDescription: true
+    export-metrics:
+        type: boolean
+        description: whether to export the metrics
+        defaultDescription: true
+)");
+}
+
+}  // namespace otlp
+
+USERVER_NAMESPACE_END
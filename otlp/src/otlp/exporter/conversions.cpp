@@ -0,0 +1,168 @@
+#include <otlp/exporter/conversions.hpp>
+
+#include <type_traits>
+#include <variant>
+
+#include <userver/utils/encoding/hex.hpp>
+#include <userver/utils/overloaded.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp::impl {
+
+namespace {
+
+namespace proto = opentelemetry::proto;
+
+constexpr std::size_t kTraceIdSize = 16;
+constexpr std::size_t kSpanIdSize = 8;
+
+bool FromHexId(std::string_view hex, std::size_t size, std::string& out) {
+  if (hex.size() != size * 2) return false;
+  return utils::encoding::FromHex(hex, out) == hex.size();
+}
+
+}  // namespace
+
+std::uint64_t ToUnixNanos(std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+void FillAnyValue(const logging::LogExtra::Value& value,
+                  proto::common::v1::AnyValue& out) {
+  std::visit(
+      [&out](const auto& value) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+          out.set_string_value(value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+          out.set_double_value(value);
+        } else {
+          out.set_int_value(static_cast<std::int64_t>(value));
+        }
+      },
+      value);
+}
+
+bool FillSpan(tracing::ExportedSpan&& span, proto::trace::v1::Span& out) {
+  if (!FromHexId(span.trace_id, kTraceIdSize, *out.mutable_trace_id()) ||
+      !FromHexId(span.span_id, kSpanIdSize, *out.mutable_span_id())) {
+    return false;
+  }
+  if (!span.parent_id.empty() &&
+      !FromHexId(span.parent_id, kSpanIdSize, *out.mutable_parent_span_id())) {
+    // the parent is not an OTLP span, export as a root one
+    out.clear_parent_span_id();
+  }
+
+  out.set_name(std::move(span.name));
+  out.set_kind(proto::trace::v1::Span::SPAN_KIND_INTERNAL);
+  out.set_start_time_unix_nano(ToUnixNanos(span.start_time));
+  out.set_end_time_unix_nano(ToUnixNanos(span.end_time));
+
+  out.mutable_attributes()->Reserve(span.attributes.size());
+  for (auto& [key, value] : span.attributes) {
+    auto& attribute = *out.add_attributes();
+    FillAnyValue(value, *attribute.mutable_value());
+    attribute.set_key(std::move(key));
+  }
+
+  if (span.is_failed) {
+    out.mutable_status()->set_code(proto::trace::v1::Status::STATUS_CODE_ERROR);
+  }
+  return true;
+}
+
+MetricsBuilder::MetricsBuilder(proto::metrics::v1::ScopeMetrics& out,
+                               std::chrono::system_clock::time_point start_time,
+                               std::chrono::system_clock::time_point time)
+    : out_(out),
+      start_time_(ToUnixNanos(start_time)),
+      time_(ToUnixNanos(time)) {}
+
+void MetricsBuilder::HandleMetric(std::string_view path,
+                                  utils::statistics::LabelsSpan labels,
+                                  const utils::statistics::MetricValue& value) {
+  auto& metric = GetMetric(path);
+
+  // A path may only have metrics of a single type,
+  // the points of a mismatching type are skipped
+  const auto matches = [&metric](proto::metrics::v1::Metric::DataCase data) {
+    return metric.data_case() == proto::metrics::v1::Metric::DATA_NOT_SET ||
+           metric.data_case() == data;
+  };
+
+  value.Visit(utils::Overloaded{
+      [&](std::int64_t value) {
+        if (!matches(proto::metrics::v1::Metric::kGauge)) return;
+        auto& point = *metric.mutable_gauge()->add_data_points();
+        FillDataPoint(labels, point);
+        point.set_as_int(value);
+      },
+      [&](double value) {
+        if (!matches(proto::metrics::v1::Metric::kGauge)) return;
+        auto& point = *metric.mutable_gauge()->add_data_points();
+        FillDataPoint(labels, point);
+        point.set_as_double(value);
+      },
+      [&](utils::statistics::Rate value) {
+        if (!matches(proto::metrics::v1::Metric::kSum)) return;
+        auto& sum = *metric.mutable_sum();
+        sum.set_aggregation_temporality(
+            proto::metrics::v1::AGGREGATION_TEMPORALITY_CUMULATIVE);
+        sum.set_is_monotonic(true);
+        auto& point = *sum.add_data_points();
+        FillDataPoint(labels, point);
+        point.set_as_int(static_cast<std::int64_t>(value.value));
+      },
+      [&](utils::statistics::HistogramView value) {
+        if (!matches(proto::metrics::v1::Metric::kHistogram)) return;
+        auto& histogram = *metric.mutable_histogram();
+        histogram.set_aggregation_temporality(
+            proto::metrics::v1::AGGREGATION_TEMPORALITY_CUMULATIVE);
+        auto& point = *histogram.add_data_points();
+        FillDataPoint(labels, point);
+
+        const auto bucket_count = value.GetBucketCount();
+        point.mutable_explicit_bounds()->Reserve(bucket_count);
+        point.mutable_bucket_counts()->Reserve(bucket_count + 1);
+        std::uint64_t count = 0;
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+          point.add_explicit_bounds(value.GetUpperBoundAt(i));
+          point.add_bucket_counts(value.GetValueAt(i));
+          count += value.GetValueAt(i);
+        }
+        point.add_bucket_counts(value.GetValueAtInf());
+        count += value.GetValueAtInf();
+        point.set_count(count);
+      },
+  });
+}
+
+proto::metrics::v1::Metric& MetricsBuilder::GetMetric(std::string_view path) {
+  auto [it, inserted] = metrics_.try_emplace(std::string{path}, nullptr);
+  if (inserted) {
+    it->second = out_.add_metrics();
+    it->second->set_name(it->first);
+  }
+  return *it->second;
+}
+
+template <typename DataPoint>
+void MetricsBuilder::FillDataPoint(utils::statistics::LabelsSpan labels,
+                                   DataPoint& out) {
+  for (const auto& label : labels) {
+    auto& attribute = *out.add_attributes();
+    attribute.set_key(std::string{label.Name()});
+    attribute.mutable_value()->set_string_value(std::string{label.Value()});
+  }
+  out.set_start_time_unix_nano(start_time_);
+  out.set_time_unix_nano(time_);
+  ++data_points_;
+}
+
+}  // namespace otlp::impl
+
+USERVER_NAMESPACE_END
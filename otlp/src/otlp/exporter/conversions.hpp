@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <opentelemetry/proto/metrics/v1/metrics.pb.h>
+#include <opentelemetry/proto/trace/v1/trace.pb.h>
+
+#include <userver/tracing/span_exporter.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp::impl {
+
+std::uint64_t ToUnixNanos(std::chrono::system_clock::time_point time);
+
+void FillAnyValue(const logging::LogExtra::Value& value,
+                  opentelemetry::proto::common::v1::AnyValue& out);
+
+/// Returns false if the ids of the span are not the OTLP ones
+/// (16 and 8 bytes in hex), such span could not be exported
+[[nodiscard]] bool FillSpan(tracing::ExportedSpan&& span,
+                            opentelemetry::proto::trace::v1::Span& out);
+
+/// Converts the metrics of utils::statistics::Storage into OTLP metrics,
+/// one per metric path with a data point per set of labels:
+/// - integer and floating point metrics into gauges;
+/// - utils::statistics::Rate into monotonic cumulative sums;
+/// - utils::statistics::HistogramView into cumulative histograms.
+class MetricsBuilder final : public utils::statistics::BaseFormatBuilder {
+ public:
+  MetricsBuilder(opentelemetry::proto::metrics::v1::ScopeMetrics& out,
+                 std::chrono::system_clock::time_point start_time,
+                 std::chrono::system_clock::time_point time);
+
+  void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels,
+                    const utils::statistics::MetricValue& value) override;
+
+  std::size_t GetDataPointsCount() const noexcept { return data_points_; }
+
+ private:
+  opentelemetry::proto::metrics::v1::Metric& GetMetric(std::string_view path);
+
+  template <typename DataPoint>
+  void FillDataPoint(utils::statistics::LabelsSpan labels, DataPoint& out);
+
+  opentelemetry::proto::metrics::v1::ScopeMetrics& out_;
+  const std::uint64_t start_time_;
+  const std::uint64_t time_;
+  // pointers to the elements of RepeatedPtrField are stable
+  std::unordered_map<std::string, opentelemetry::proto::metrics::v1::Metric*>
+      metrics_;
+  std::size_t data_points_{0};
+};
+
+}  // namespace otlp::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,120 @@
+#include <otlp/exporter/conversions.hpp>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace proto = opentelemetry::proto;
+
+tracing::ExportedSpan MakeSpan() {
+  tracing::ExportedSpan span;
+  span.name = "handler";
+  span.trace_id = "0123456789abcdef0123456789abcdef";
+  span.span_id = "0011223344556677";
+  span.parent_id = "8899aabbccddeeff";
+  span.start_time =
+      std::chrono::system_clock::time_point{std::chrono::seconds{1}};
+  span.end_time = span.start_time + std::chrono::milliseconds{5};
+  span.attributes.emplace_back("meta_code", 200);
+  span.attributes.emplace_back("http_url", std::string{"/ping"});
+  return span;
+}
+
+}  // namespace
+
+TEST(OtlpConversions, Span) {
+  proto::trace::v1::Span out;
+  ASSERT_TRUE(otlp::impl::FillSpan(MakeSpan(), out));
+
+  EXPECT_EQ(out.name(), "handler");
+  EXPECT_EQ(out.trace_id(),
+            std::string("\x01\x23\x45\x67\x89\xab\xcd\xef"
+                        "\x01\x23\x45\x67\x89\xab\xcd\xef",
+                        16));
+  EXPECT_EQ(out.span_id(), std::string("\x00\x11\x22\x33\x44\x55\x66\x77", 8));
+  EXPECT_EQ(out.parent_span_id().size(), 8);
+  EXPECT_EQ(out.start_time_unix_nano(), 1'000'000'000);
+  EXPECT_EQ(out.end_time_unix_nano(), 1'005'000'000);
+  EXPECT_EQ(out.status().code(), proto::trace::v1::Status::STATUS_CODE_UNSET);
+
+  ASSERT_EQ(out.attributes_size(), 2);
+  EXPECT_EQ(out.attributes(0).key(), "meta_code");
+  EXPECT_EQ(out.attributes(0).value().int_value(), 200);
+  EXPECT_EQ(out.attributes(1).key(), "http_url");
+  EXPECT_EQ(out.attributes(1).value().string_value(), "/ping");
+}
+
+TEST(OtlpConversions, SpanFailed) {
+  auto span = MakeSpan();
+  span.is_failed = true;
+  span.parent_id = "not-an-otlp-id";
+
+  proto::trace::v1::Span out;
+  ASSERT_TRUE(otlp::impl::FillSpan(std::move(span), out));
+  EXPECT_EQ(out.status().code(), proto::trace::v1::Status::STATUS_CODE_ERROR);
+  EXPECT_TRUE(out.parent_span_id().empty());
+}
+
+TEST(OtlpConversions, SpanInvalidTraceId) {
+  auto span = MakeSpan();
+  span.trace_id = "custom-trace-id";
+
+  proto::trace::v1::Span out;
+  EXPECT_FALSE(otlp::impl::FillSpan(std::move(span), out));
+}
+
+UTEST(OtlpConversions, Metrics) {
+  utils::statistics::Storage storage;
+  utils::statistics::RateCounter requests{utils::statistics::Rate{42}};
+  utils::statistics::Histogram timings{std::vector<double>{10, 100}};
+  timings.Account(5);
+  timings.Account(50, 2);
+  timings.Account(500);
+
+  auto holder = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) {
+        writer["gauge"].ValueWithLabels(1.5, {{"a", "1"}});
+        writer["gauge"].ValueWithLabels(2.5, {{"a", "2"}});
+        writer["requests"] = requests;
+        writer["timings"] = timings;
+      });
+
+  proto::metrics::v1::ScopeMetrics out;
+  const auto now = std::chrono::system_clock::now();
+  otlp::impl::MetricsBuilder builder{out, now, now};
+  storage.VisitMetrics(builder);
+  EXPECT_EQ(builder.GetDataPointsCount(), 4);
+
+  ASSERT_EQ(out.metrics_size(), 3);
+  for (const auto& metric : out.metrics()) {
+    if (metric.name() == "test.gauge") {
+      ASSERT_TRUE(metric.has_gauge());
+      ASSERT_EQ(metric.gauge().data_points_size(), 2);
+      const auto& point = metric.gauge().data_points(0);
+      ASSERT_EQ(point.attributes_size(), 1);
+      EXPECT_EQ(point.attributes(0).key(), "a");
+    } else if (metric.name() == "test.requests") {
+      ASSERT_TRUE(metric.has_sum());
+      EXPECT_TRUE(metric.sum().is_monotonic());
+      EXPECT_EQ(metric.sum().data_points(0).as_int(), 42);
+    } else if (metric.name() == "test.timings") {
+      ASSERT_TRUE(metric.has_histogram());
+      const auto& point = metric.histogram().data_points(0);
+      EXPECT_EQ(point.count(), 4);
+      ASSERT_EQ(point.explicit_bounds_size(), 2);
+      ASSERT_EQ(point.bucket_counts_size(), 3);
+      EXPECT_EQ(point.bucket_counts(0), 1);
+      EXPECT_EQ(point.bucket_counts(1), 2);
+      EXPECT_EQ(point.bucket_counts(2), 1);
+    } else {
+      ADD_FAILURE() << "Unexpected metric " << metric.name();
+    }
+  }
+}
+
+USERVER_NAMESPACE_END
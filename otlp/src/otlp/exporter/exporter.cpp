@@ -0,0 +1,195 @@
+#include <otlp/exporter/exporter.hpp>
+
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+
+#include <otlp/exporter/conversions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp::impl {
+
+namespace {
+
+namespace proto = opentelemetry::proto;
+
+constexpr std::string_view kScopeName = "userver";
+
+void FillResource(const ExporterSettings& settings,
+                  proto::resource::v1::Resource& out) {
+  auto& attribute = *out.add_attributes();
+  attribute.set_key("service.name");
+  attribute.mutable_value()->set_string_value(settings.service_name);
+}
+
+std::unique_ptr<grpc::ClientContext> MakeContext(
+    std::chrono::milliseconds timeout) {
+  auto context = std::make_unique<grpc::ClientContext>();
+  context->set_deadline(engine::Deadline::FromDuration(timeout));
+  return context;
+}
+
+// The spans of the export itself are neither logged nor exported,
+// otherwise every export would produce more spans to export
+template <typename Func>
+std::optional<std::string> CallUntraced(std::string name, Func&& func) {
+  tracing::Span span{std::move(name)};
+  span.SetLocalLogLevel(logging::Level::kNone);
+  try {
+    func();
+    return std::nullopt;
+  } catch (const std::exception& ex) {
+    return ex.what();
+  }
+}
+
+}  // namespace
+
+Exporter::Exporter(ExporterSettings&& settings,
+                   TraceServiceClient&& trace_client,
+                   MetricsServiceClient&& metrics_client,
+                   const utils::statistics::Storage& storage)
+    : settings_(std::move(settings)),
+      storage_(storage),
+      start_time_(std::chrono::system_clock::now()),
+      trace_client_(std::move(trace_client)),
+      metrics_client_(std::move(metrics_client)),
+      queue_(Queue::Create(settings_.max_queue_size)),
+      producer_(queue_->GetMultiProducer()),
+      consumer_(queue_->GetConsumer()) {
+  if (settings_.export_traces) {
+    send_task_ = engine::CriticalAsyncNoSpan([this] { SendLoop(); });
+  }
+  if (settings_.export_metrics) {
+    metrics_task_.Start(
+        "otlp_metrics_exporter",
+        {settings_.metrics_period, {}, logging::Level::kNone},
+        [this] { SendMetrics(); });
+  }
+}
+
+Exporter::~Exporter() { Stop(); }
+
+void Exporter::Export(tracing::ExportedSpan&& span) {
+  if (!settings_.export_traces || !producer_.PushNoblock(std::move(span))) {
+    ++spans_dropped_;
+  }
+}
+
+void Exporter::Stop() noexcept {
+  metrics_task_.Stop();
+  if (!send_task_.IsValid()) return;
+  send_task_.SyncCancel();
+  send_task_ = {};
+
+  std::vector<tracing::ExportedSpan> spans;
+  tracing::ExportedSpan span;
+  while (consumer_.PopNoblock(span)) {
+    spans.push_back(std::move(span));
+    if (spans.size() >= settings_.max_batch_size) {
+      SendSpans(std::exchange(spans, {}));
+    }
+  }
+  if (!spans.empty()) SendSpans(std::move(spans));
+}
+
+void Exporter::WriteStatistics(utils::statistics::Writer& writer) const {
+  auto spans = writer["spans"];
+  spans["exported"] = spans_exported_;
+  spans["dropped"] = spans_dropped_;
+  spans["failed"] = spans_failed_;
+
+  auto metrics = writer["metrics"];
+  metrics["exported"] = metrics_exported_;
+  metrics["failed"] = metrics_failed_;
+}
+
+void Exporter::SendLoop() {
+  std::vector<tracing::ExportedSpan> spans;
+  spans.reserve(settings_.max_batch_size);
+
+  while (!engine::current_task::ShouldCancel()) {
+    const auto deadline = engine::Deadline::FromDuration(settings_.send_period);
+    tracing::ExportedSpan span;
+    while (spans.size() < settings_.max_batch_size &&
+           consumer_.Pop(span, deadline)) {
+      spans.push_back(std::move(span));
+    }
+    if (engine::current_task::ShouldCancel()) break;
+
+    if (!spans.empty()) {
+      SendSpans(std::exchange(spans, {}));
+      spans.reserve(settings_.max_batch_size);
+    }
+  }
+
+  // the remaining spans are sent by Stop()
+  for (auto& span : spans) {
+    if (!producer_.PushNoblock(std::move(span))) ++spans_dropped_;
+  }
+}
+
+void Exporter::SendSpans(std::vector<tracing::ExportedSpan>&& spans) {
+  proto::collector::trace::v1::ExportTraceServiceRequest request;
+  auto& resource_spans = *request.add_resource_spans();
+  FillResource(settings_, *resource_spans.mutable_resource());
+  auto& scope_spans = *resource_spans.add_scope_spans();
+  scope_spans.mutable_scope()->set_name(std::string{kScopeName});
+
+  scope_spans.mutable_spans()->Reserve(spans.size());
+  for (auto& span : spans) {
+    if (!FillSpan(std::move(span), *scope_spans.add_spans())) {
+      scope_spans.mutable_spans()->RemoveLast();
+      ++spans_dropped_;
+    }
+  }
+  const std::size_t count = scope_spans.spans_size();
+  if (count == 0) return;
+
+  const auto error = CallUntraced("otlp_export_spans", [&] {
+    trace_client_.Export(request, MakeContext(settings_.timeout)).Finish();
+  });
+  if (error) {
+    spans_failed_.Add(utils::statistics::Rate{count});
+    LOG_LIMITED_WARNING() << "Failed to export " << count
+                          << " spans to the OTLP collector: " << *error;
+    return;
+  }
+  spans_exported_.Add(utils::statistics::Rate{count});
+}
+
+void Exporter::SendMetrics() {
+  proto::collector::metrics::v1::ExportMetricsServiceRequest request;
+  auto& resource_metrics = *request.add_resource_metrics();
+  FillResource(settings_, *resource_metrics.mutable_resource());
+  auto& scope_metrics = *resource_metrics.add_scope_metrics();
+  scope_metrics.mutable_scope()->set_name(std::string{kScopeName});
+
+  MetricsBuilder builder{scope_metrics, start_time_,
+                         std::chrono::system_clock::now()};
+  storage_.VisitMetrics(builder);
+  const auto count = builder.GetDataPointsCount();
+  if (count == 0) return;
+
+  const auto error = CallUntraced("otlp_export_metrics", [&] {
+    metrics_client_.Export(request, MakeContext(settings_.timeout)).Finish();
+  });
+  if (error) {
+    metrics_failed_.Add(utils::statistics::Rate{count});
+    LOG_LIMITED_WARNING() << "Failed to export " << count
+                          << " metrics to the OTLP collector: " << *error;
+    return;
+  }
+  metrics_exported_.Add(utils::statistics::Rate{count});
+}
+
+}  // namespace otlp::impl
+
+USERVER_NAMESPACE_END
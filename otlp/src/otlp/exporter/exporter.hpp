@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <opentelemetry/proto/collector/metrics/v1/metrics_service_client.usrv.pb.hpp>
+#include <opentelemetry/proto/collector/trace/v1/trace_service_client.usrv.pb.hpp>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/tracing/span_exporter.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp::impl {
+
+struct ExporterSettings final {
+  std::string service_name;
+  std::size_t max_queue_size{65536};
+  std::size_t max_batch_size{512};
+  std::chrono::milliseconds send_period{1000};
+  std::chrono::milliseconds metrics_period{10000};
+  std::chrono::milliseconds timeout{1000};
+  bool export_traces{true};
+  bool export_metrics{true};
+};
+
+using TraceServiceClient =
+    opentelemetry::proto::collector::trace::v1::TraceServiceClient;
+using MetricsServiceClient =
+    opentelemetry::proto::collector::metrics::v1::MetricsServiceClient;
+
+/// Buffers the finished spans in a bounded queue and sends them to the OTLP
+/// collector in batches from a background task, periodically sends the
+/// metrics of the storage.
+class Exporter final : public tracing::SpanExporter {
+ public:
+  Exporter(ExporterSettings&& settings, TraceServiceClient&& trace_client,
+           MetricsServiceClient&& metrics_client,
+           const utils::statistics::Storage& storage);
+  ~Exporter() override;
+
+  /// Never blocks, drops the span if the queue is full
+  void Export(tracing::ExportedSpan&& span) override;
+
+  /// Stops the background tasks and sends the queued spans
+  void Stop() noexcept;
+
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
+ private:
+  using Queue = concurrent::NonFifoMpscQueue<tracing::ExportedSpan>;
+
+  void SendLoop();
+  void SendSpans(std::vector<tracing::ExportedSpan>&& spans);
+  void SendMetrics();
+
+  const ExporterSettings settings_;
+  const utils::statistics::Storage& storage_;
+  const std::chrono::system_clock::time_point start_time_;
+
+  TraceServiceClient trace_client_;
+  MetricsServiceClient metrics_client_;
+
+  std::shared_ptr<Queue> queue_;
+  Queue::MultiProducer producer_;
+  Queue::Consumer consumer_;
+
+  utils::statistics::RateCounter spans_exported_;
+  utils::statistics::RateCounter spans_dropped_;
+  utils::statistics::RateCounter spans_failed_;
+  utils::statistics::RateCounter metrics_exported_;
+  utils::statistics::RateCounter metrics_failed_;
+
+  engine::TaskWithResult<void> send_task_;
+  utils::PeriodicTask metrics_task_;
+};
+
+}  // namespace otlp::impl
+
+USERVER_NAMESPACE_END
@@ -18,6 +18,7 @@
 #include <userver/storages/postgres/detail/non_transaction.hpp>
 #include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/parameter_store.hpp>
 #include <userver/storages/postgres/query.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/storages/postgres/transaction.hpp>
@@ -159,6 +160,14 @@ class Cluster {
   /// @}
 
   /// @name Single-statement query in an auto-commit transaction
+  ///
+  /// If `pipeline_batching_window_us` of the pool settings is non-zero, the
+  /// statements with parameters of built-in types from different tasks are
+  /// sent together over a single connection in pipeline mode.
+  ///
+  /// The results of the named queries listed in
+  /// ClusterSettings::result_caches are taken from the client-side cache,
+  /// see ResultCacheSettings.
   /// @{
 
   /// @brief Execute a statement at host of specified type.
@@ -201,6 +210,12 @@ class Cluster {
   /// which effectively decreases the number of usable connections
   NotifyScope Listen(std::string_view channel, OptionalCommandControl = {});
 
+  /// @brief Listen for notifications on several channels over a single
+  /// connection
+  /// @see storages::postgres::NotifyListener for batched delivery
+  NotifyScope Listen(std::vector<std::string> channels,
+                     OptionalCommandControl = {});
+
   /// Replaces globally updated command control with a static user-provided one
   void SetDefaultCommandControl(CommandControl);
 
@@ -230,6 +245,14 @@ class Cluster {
  private:
   detail::NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
+  bool IsPipelineBatchingEnabled() const;
+  bool HasResultCache(const Query& query) const;
+  // Batches and caches the statement with the parameters written already
+  ResultSet ExecuteWithParams(ClusterHostTypeFlags, OptionalCommandControl,
+                              const Query& query,
+                              const detail::QueryParameters& params);
+  static const UserTypes& GetSystemTypes();
+
   OptionalCommandControl GetQueryCmdCtl(const std::string& query_name) const;
   OptionalCommandControl GetHandlersCmdCtl(
       OptionalCommandControl cmd_ctl) const;
@@ -251,6 +274,18 @@ ResultSet Cluster::Execute(ClusterHostTypeFlags flags,
     statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
   }
   statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
+  // User types are bound to a connection, so only the statements with
+  // built-in types of parameters may be batched
+  if constexpr (((io::IsTypeMappedToSystem<Args>() ||
+                  io::IsTypeMappedToSystemArray<Args>()) &&
+                 ...)) {
+    if (IsPipelineBatchingEnabled() || HasResultCache(query)) {
+      detail::StaticQueryParameters<sizeof...(args)> params;
+      params.Write(GetSystemTypes(), args...);
+      return ExecuteWithParams(flags, statement_cmd_ctl, query,
+                               detail::QueryParameters{params});
+    }
+  }
   auto ntrx = Start(flags, statement_cmd_ctl);
   return ntrx.Execute(statement_cmd_ctl, query, args...);
 }
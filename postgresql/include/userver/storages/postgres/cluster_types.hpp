@@ -44,6 +44,11 @@ enum class ClusterHostType {
 
   /// Chooses a host with the lowest RTT
   kNearest = 0x10,
+
+  /// Chooses a host of the nearest datacenter with the least load, see
+  /// TopologySettings::nearest_dc_rtt_margin. The load accounts for the
+  /// smoothed RTT, the replication lag and the connections in use.
+  kLatencyAware = 0x20,
   /// @}
 };
 
@@ -54,7 +59,8 @@ constexpr ClusterHostTypeFlags kClusterHostRolesMask{
     ClusterHostType::kSlave};
 
 constexpr ClusterHostTypeFlags kClusterHostStrategyMask{
-    ClusterHostType::kRoundRobin, ClusterHostType::kNearest};
+    ClusterHostType::kRoundRobin, ClusterHostType::kNearest,
+    ClusterHostType::kLatencyAware};
 
 std::string ToString(ClusterHostType);
 std::string ToString(ClusterHostTypeFlags);
@@ -47,6 +47,11 @@ namespace components {
 ///    max_pool_size: 15
 ///    max_queue_size: 200
 ///    max_statement_metrics: 50
+///    result_cache:
+///      select_zones:
+///        ttl: 5s
+///        size: 100
+///        invalidation_channel: zones_changed
 /// ```
 /// You must specify either `dbalias` or `conn_info`.
 /// If the component is configured with an alias, it will lookup connection data
@@ -59,6 +64,11 @@ namespace components {
 /// Note, however, that client-size lag detection is not precise in nature
 /// and can only provide the precision of couple seconds.
 ///
+/// `nearest_dc_rtt_margin` tells the hosts of the nearest datacenter from the
+/// others for the storages::postgres::ClusterHostType::kLatencyAware host
+/// selection: replicas of other datacenters are used only when the nearest
+/// ones are unavailable.
+///
 /// ## Secdist format
 ///
 /// A PosgreSQL alias in secdist is described as a JSON array of objects
@@ -115,6 +125,7 @@ namespace components {
 /// dbconnection            | connection DSN string (used if no dbalias specified)      | --
 /// blocking_task_processor | name of task processor for background blocking operations | --
 /// max_replication_lag     | replication lag limit for usable slaves                   | 60s
+/// nearest_dc_rtt_margin   | max RTT difference of the hosts of the nearest datacenter | 2ms
 /// min_pool_size           | number of connections created initially                   | 4
 /// max_pool_size           | limit of connections count                                | 15
 /// sync-start              | perform initial connections synchronously                 | false
@@ -126,12 +137,19 @@ namespace components {
 /// monitoring-dbalias      | name of the database for monitorings                      | calculated from dbalias or dbconnection options
 /// max_prepared_cache_size | prepared statements cache size limit                      | 5000
 /// max_statement_metrics   | limit of exported metrics for named statements            | 0
+/// slow_query_threshold_ms | run `EXPLAIN (ANALYZE, BUFFERS)` on a replica for the statements that run at least this long and log the plan (0 - disabled) | 0
+/// slow_query_explain_interval_ms | min interval between the plan captures of slow statements | 10000
 /// min_pool_size           | number of connections created initially                   | 4
 /// max_pool_size           | maximum number of created connections                     | 15
 /// max_queue_size          | maximum number of clients waiting for a connection        | 200
 /// connecting_limit        | limit for concurrent establishing connections number per pool (0 - unlimited) | 0
+/// pipeline_batching_window_us | single statements with built-in parameter types that arrive within this window are sent in a single pipelined batch over one connection (0 - disabled) | 0
+/// pipeline_batch_max_size | maximum number of statements in a pipelined batch         | 32
+/// spare_pool_size         | number of idle connections opened in background on top of the ones in use and awaited | 0
+/// prepare_warmup_size     | number of the statements prepared by most connections of the pool that a new connection prepares before serving queries (0 - disabled) | 0
 /// connlimit_mode          | max_connections setup mode (manual or auto), also see @ref scripts/docs/en/userver/pg_connlimit_mode_auto.md | auto
 /// error-injection         | artificial error injection settings, error_injection::Settings | --
+/// result_cache            | client-side result caches by query names, see storages::postgres::ResultCacheSettings (`ttl`, `size`, `invalidation_channel`) | --
 
 // clang-format on
 
@@ -0,0 +1,151 @@
+#pragma once
+
+/// @file userver/storages/postgres/copy.hpp
+/// @brief Binary COPY FROM STDIN and COPY TO STDOUT streaming
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/row_types.hpp>
+#include <userver/storages/postgres/io/traits.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/storages/postgres/query.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace detail {
+class Connection;
+}  // namespace detail
+
+/// @brief Streams rows into a `COPY ... FROM STDIN (FORMAT binary)`
+///
+/// The rows are serialized by the same formatters as the query parameters
+/// and are sent to the server in chunks of about `chunk_size` bytes, so the
+/// memory usage does not depend on the number of rows. The connection is busy
+/// until Finish() is called, the COPY is aborted if the writer is destroyed
+/// without calling Finish().
+///
+/// @code
+/// auto writer = trx.CopyFrom("COPY t (id, name) FROM STDIN (FORMAT binary)");
+/// for (const auto& [id, name] : data) writer.Write(id, name);
+/// const auto rows_copied = writer.Finish();
+/// @endcode
+class CopyWriter {
+ public:
+  static constexpr std::size_t kDefaultChunkSize = 64 * 1024;
+
+  CopyWriter(detail::Connection* conn, const Query& query,
+             std::size_t chunk_size, OptionalCommandControl cmd_ctl = {});
+
+  CopyWriter(CopyWriter&&) noexcept;
+  CopyWriter& operator=(CopyWriter&&) = delete;
+
+  CopyWriter(const CopyWriter&) = delete;
+  CopyWriter& operator=(const CopyWriter&) = delete;
+
+  ~CopyWriter();
+
+  /// Write a row consisting of the columns
+  template <typename... Columns>
+  void Write(const Columns&... columns) {
+    BeginRow(sizeof...(Columns));
+    (io::WriteRawBinary(*types_, buffer_, columns), ...);
+    EndRow();
+  }
+
+  /// Write a row of a @ref pg_composite_types "row type"
+  template <typename Row>
+  void WriteRow(const Row& row) {
+    static_assert(io::traits::kIsRowType<Row>,
+                  "Row type must be an aggregate, a tuple or have an "
+                  "Introspect method");
+    std::apply([this](const auto&... columns) { Write(columns...); },
+               io::RowType<Row>::GetTuple(row));
+  }
+
+  /// Send the rest of the data and finish the COPY, returns the number of rows
+  /// copied
+  std::size_t Finish();
+
+ private:
+  void BeginRow(std::size_t columns);
+  void EndRow();
+  detail::Connection& GetConnection();
+
+  detail::Connection* conn_;
+  const UserTypes* types_;
+  std::size_t chunk_size_;
+  std::string buffer_;
+};
+
+/// @brief Reads rows of a `COPY ... TO STDOUT (FORMAT binary)`
+///
+/// The rows are received one by one and parsed by the same parsers as the
+/// fields of a ResultSet. Unlike a ResultSet, the whole output of the COPY is
+/// never held in memory. The connection is busy until all the rows are read,
+/// destroying the reader earlier closes the connection.
+///
+/// @code
+/// auto reader = trx.CopyTo("COPY t (id, name) TO STDOUT (FORMAT binary)");
+/// int id{};
+/// std::string name;
+/// while (reader.Read(id, name)) Process(id, name);
+/// @endcode
+class CopyReader {
+ public:
+  CopyReader(detail::Connection* conn, const Query& query,
+             OptionalCommandControl cmd_ctl = {});
+
+  CopyReader(CopyReader&&) noexcept;
+  CopyReader& operator=(CopyReader&&) = delete;
+
+  CopyReader(const CopyReader&) = delete;
+  CopyReader& operator=(const CopyReader&) = delete;
+
+  ~CopyReader();
+
+  /// Read the next row into the columns, returns false after the last row
+  template <typename... Columns>
+  bool Read(Columns&... columns) {
+    auto buffer = NextRow(sizeof...(Columns));
+    if (!buffer) return false;
+    const auto& categories = GetTypeBufferCategories();
+    (buffer->ReadRaw(columns, categories,
+                     io::traits::kTypeBufferCategory<Columns>),
+     ...);
+    return true;
+  }
+
+  /// Read the next row into a @ref pg_composite_types "row type", returns
+  /// false after the last row
+  template <typename Row>
+  bool ReadRow(Row& row) {
+    static_assert(io::traits::kIsRowType<Row>,
+                  "Row type must be an aggregate, a tuple or have an "
+                  "Introspect method");
+    return std::apply(
+        [this](auto&... columns) { return Read(columns...); },
+        io::RowType<Row>::GetTuple(row));
+  }
+
+ private:
+  /// Returns the fields of the next row or std::nullopt after the last one
+  std::optional<io::FieldBuffer> NextRow(std::size_t columns);
+  const io::TypeBufferCategory& GetTypeBufferCategories() const;
+
+  detail::Connection* conn_;
+  std::string data_;
+  std::string row_;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
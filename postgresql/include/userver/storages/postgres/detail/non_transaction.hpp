@@ -66,6 +66,8 @@ class NonTransaction {
                     const std::string& statement, const ParameterStore& store);
   /// @}
  private:
+  friend class ClusterImpl;
+
   ResultSet DoExecute(const Query& query, const detail::QueryParameters& params,
                       OptionalCommandControl statement_cmd_ctl);
   const UserTypes& GetConnectionUserTypes() const;
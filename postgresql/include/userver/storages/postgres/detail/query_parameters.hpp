@@ -192,26 +192,39 @@ class DynamicQueryParameters {
   template <typename T>
   void WriteNullable(const UserTypes& types, const T& arg, std::false_type) {
     param_formats.push_back(io::kPgBinaryDataFormat);
-    parameters.push_back({});
-    auto& buffer = parameters.back();
+    const auto offset = buffer.size();
+    const auto capacity_before = buffer.capacity();
     io::WriteBuffer(types, buffer, arg);
-    auto size = buffer.size();
+    const auto size = buffer.size() - offset;
     param_lengths.push_back(size);
     if (size == 0) {
       param_buffers.push_back(empty_buffer);
     } else {
-      param_buffers.push_back(buffer.data());
+      param_buffers.push_back(buffer.data() + offset);
+    }
+    if (buffer.capacity() != capacity_before) RebaseParamBuffers();
+  }
+
+  // The values are laid out in `buffer` one after another, so their
+  // positions are restored from the lengths after a reallocation
+  void RebaseParamBuffers() {
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < param_buffers.size(); ++i) {
+      if (param_lengths[i] <= 0) continue;  // NULL or empty
+      param_buffers[i] = buffer.data() + offset;
+      offset += param_lengths[i];
     }
   }
 
   using OidList = std::vector<Oid>;
+  // Unlike std::string, keeps the data in place on move
   using BufferType = std::vector<char>;
-  using ParameterList = std::vector<BufferType>;
   using IntList = std::vector<int>;
 
   static constexpr const char* empty_buffer = "";
 
-  ParameterList parameters;  // TODO Replace with a single buffer
+  // All the values, one after another
+  BufferType buffer;
   OidList param_types;
   std::vector<const char*> param_buffers;
   IntList param_lengths;
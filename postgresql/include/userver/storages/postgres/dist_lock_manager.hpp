@@ -0,0 +1,146 @@
+#pragma once
+
+/// @file userver/storages/postgres/dist_lock_manager.hpp
+/// @brief @copybrief storages::postgres::DistLockManager
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/dist_lock/dist_lock_strategy.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+class Writer;
+}  // namespace utils::statistics
+
+namespace storages::postgres {
+
+/// Statistics of the locks of a DistLockManager
+struct DistLockManagerStatistics final {
+  /// Acquire statements sent to the database
+  utils::statistics::RelaxedCounter<std::uint64_t> batches{0};
+  /// Acquire and prolong requests of the locks
+  utils::statistics::RelaxedCounter<std::uint64_t> acquire_requests{0};
+  /// Requests that found the lock owned by another host
+  utils::statistics::RelaxedCounter<std::uint64_t> acquire_failures{0};
+  /// Strategies created by the manager and not yet destroyed
+  std::atomic<std::int64_t> locks{0};
+  /// Strategies that currently own their lock
+  std::atomic<std::int64_t> locks_held{0};
+};
+
+/// @brief DistLockManagerStatistics values support for
+/// utils::statistics::Writer
+void DumpMetric(utils::statistics::Writer& writer,
+                const DistLockManagerStatistics& stats);
+
+/// @brief Acquires and prolongs many Postgres distributed locks with one
+/// statement per batch and hands out fencing tokens to the lock owners.
+///
+/// A service that runs hundreds of dist_lock::DistLockedWorker makes a
+/// separate roundtrip to the master for each of them every prolong interval.
+/// Strategies created by the manager instead queue their requests, and a
+/// single background task sends all the requests that arrived while the
+/// previous statement was executing. Releases are rare and are not batched.
+///
+/// Each successful acquisition returns a fencing token: a number that grows
+/// every time the lock changes its owner and stays the same while the owner
+/// prolongs it. Storages modified by the lock owner may store the token and
+/// reject writes with a smaller one, so that a host that lost the lock during
+/// a pause can not overwrite the results of the new owner.
+///
+/// To keep the tokens monotonic, released locks are expired instead of being
+/// deleted. The table must have the following columns:
+/// @code{.sql}
+/// CREATE TABLE locks (
+///   key TEXT PRIMARY KEY,
+///   owner TEXT,
+///   expiration_time TIMESTAMPTZ,
+///   fencing_token BIGINT NOT NULL DEFAULT 0
+/// );
+/// @endcode
+///
+/// The manager must outlive all the strategies created from it.
+class DistLockManager final {
+ public:
+  DistLockManager(ClusterPtr cluster, const std::string& table,
+                  CommandControl cc);
+  ~DistLockManager();
+
+  DistLockManager(const DistLockManager&) = delete;
+  DistLockManager& operator=(const DistLockManager&) = delete;
+
+  void UpdateCommandControl(CommandControl cc);
+
+  const DistLockManagerStatistics& GetStatistics() const;
+
+ private:
+  friend class BatchedDistLockStrategy;
+
+  struct AcquireRequest;
+
+  // Returns the fencing token, std::nullopt if the lock is owned by another
+  // host
+  std::optional<std::int64_t> Acquire(const std::string& key,
+                                      const std::string& owner,
+                                      std::chrono::milliseconds ttl);
+  void Release(const std::string& key, const std::string& owner);
+
+  void RunFlusher();
+  std::vector<AcquireRequest> TakeBatch();
+  void ExecuteBatch(std::vector<AcquireRequest>& batch);
+
+  ClusterPtr cluster_;
+  rcu::Variable<CommandControl> cc_;
+  const std::string acquire_query_;
+  const std::string release_query_;
+  const std::string owner_prefix_;
+
+  DistLockManagerStatistics stats_;
+
+  engine::Mutex pending_mutex_;
+  std::vector<AcquireRequest> pending_;
+  engine::SingleConsumerEvent pending_event_;
+  engine::TaskWithResult<void> flusher_;
+};
+
+/// @brief Postgres distributed locking strategy that batches its acquire
+/// requests with the other strategies of the same DistLockManager.
+class BatchedDistLockStrategy final : public dist_lock::DistLockStrategyBase {
+ public:
+  BatchedDistLockStrategy(DistLockManager& manager, std::string lock_name);
+  ~BatchedDistLockStrategy() override;
+
+  void Acquire(std::chrono::milliseconds lock_ttl,
+               const std::string& locker_id) override;
+
+  void Release(const std::string& locker_id) override;
+
+  /// @returns the fencing token of the last successful acquisition, or
+  /// std::nullopt if the lock is not held
+  std::optional<std::int64_t> GetFencingToken() const;
+
+ private:
+  void SetHeld(bool is_held);
+
+  DistLockManager& manager_;
+  const std::string lock_name_;
+  std::atomic<std::int64_t> fencing_token_;
+  std::atomic<bool> is_held_{false};
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -938,6 +938,11 @@ class NotImplemented : public LogicError {
   using LogicError::LogicError;
 };
 
+/// Malformed or unexpected message of the logical replication stream
+class ReplicationError : public RuntimeError {
+  using RuntimeError::RuntimeError;
+};
+
 //@}
 
 //@{
@@ -6,11 +6,13 @@
 /// @ingroup userver_postgres_parse_and_format
 
 #include <array>
+#include <cstring>
 #include <iterator>
 #include <set>
 #include <unordered_set>
 #include <vector>
 
+#include <boost/endian/conversion.hpp>
 #include <boost/pfr/core.hpp>
 
 #include <userver/utils/impl/projecting_view.hpp>
@@ -18,6 +20,7 @@
 #include <userver/storages/postgres/exceptions.hpp>
 #include <userver/storages/postgres/io/buffer_io_base.hpp>
 #include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/integral_types.hpp>
 #include <userver/storages/postgres/io/row_types.hpp>
 #include <userver/storages/postgres/io/traits.hpp>
 #include <userver/storages/postgres/io/type_mapping.hpp>
@@ -48,6 +51,13 @@ namespace storages::postgres::io {
 /// - std::unordered_set
 /// - std::vector
 ///
+/// Arrays of integral and floating point types are parsed into std::vector
+/// in bulk, without going through the element parser.
+///
+/// Text arrays can be parsed into std::vector<std::string_view> without
+/// copying the strings. The views point into the result set buffer and
+/// are valid only while the ResultSet is alive.
+///
 /// ----------
 ///
 /// @htmlonly <div class="bottom-nav"> @endhtmlonly
@@ -145,6 +155,51 @@ inline bool ForceInitElementMapping() {
   }
 }
 
+template <typename T>
+inline constexpr bool kIsFixedWidthElement =
+    (std::is_integral_v<T> || std::is_floating_point_v<T>) &&
+    !std::is_same_v<T, bool> && !std::is_same_v<T, char> &&
+    (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+template <typename Container>
+struct IsFixedWidthVector : std::false_type {};
+
+template <typename T, typename Allocator>
+struct IsFixedWidthVector<std::vector<T, Allocator>>
+    : std::bool_constant<kIsFixedWidthElement<T>> {};
+
+/// Reads `count` elements of the wire size equal to `sizeof(T)` straight
+/// into the vector. Returns false and leaves the buffer intact if any of
+/// the elements is NULL or of another size, so that the caller falls back
+/// to the element parser that converts or reports them.
+template <typename T, typename Allocator>
+bool ReadFixedWidthElements(FieldBuffer& buffer, std::size_t count,
+                            std::vector<T, Allocator>& elems) {
+  using Bits = typename IntegralType<sizeof(T)>::type;
+  constexpr std::size_t kStride = sizeof(Integer) + sizeof(T);
+  const auto expected_length =
+      boost::endian::native_to_big(static_cast<Integer>(sizeof(T)));
+
+  if (buffer.length / kStride < count) return false;
+  const auto* data = buffer.buffer;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (std::memcmp(data + i * kStride, &expected_length, sizeof(Integer))) {
+      return false;
+    }
+  }
+
+  elems.resize(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    Bits bits;
+    std::memcpy(&bits, data + i * kStride + sizeof(Integer), sizeof(T));
+    bits = boost::endian::big_to_native(bits);
+    std::memcpy(&elems[i], &bits, sizeof(T));
+  }
+  buffer.buffer += count * kStride;
+  buffer.length -= count * kStride;
+  return true;
+}
+
 template <typename Container>
 struct ArrayBinaryParser : BufferParserBase<Container> {
   using BaseType = BufferParserBase<Container>;
@@ -249,6 +304,9 @@ struct ArrayBinaryParser : BufferParserBase<Container> {
                      BufferCategory elem_category,
                      const TypeBufferCategory& categories, Element& elem) {
     if constexpr (traits::kIsCompatibleContainer<Element>) {
+      if constexpr (IsFixedWidthVector<Element>::value) {
+        if (ReadFixedWidthElements(buffer, *dim, elem)) return;
+      }
       if constexpr (traits::kCanClear<Element>) {
         elem.clear();
       }
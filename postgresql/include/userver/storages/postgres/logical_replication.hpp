@@ -0,0 +1,90 @@
+#pragma once
+
+/// @file userver/storages/postgres/logical_replication.hpp
+/// @brief Row changes received over the PostgreSQL logical replication
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/storages/postgres/io/pg_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// Position in the write-ahead log
+using Lsn = std::uint64_t;
+
+/// Column of a replicated table
+struct ReplicationColumn {
+  std::string name;
+  Oid type_oid{0};
+  std::int32_t type_modifier{-1};
+  /// The column is a part of the replica identity, e.g. of the primary key
+  bool is_key{false};
+};
+
+/// Replicated table as described by the server before its first change
+struct ReplicationRelation {
+  Oid oid{0};
+  std::string schema;
+  std::string name;
+  std::vector<ReplicationColumn> columns;
+
+  /// @returns index of the column or std::nullopt if there is no such column
+  std::optional<std::size_t> FindColumn(std::string_view column) const;
+};
+
+/// Value of a column in a replicated row
+struct ReplicationValue {
+  enum class Kind {
+    kNull,
+    /// A TOASTed value that has not been changed by the UPDATE and is not sent
+    kUnchanged,
+    /// The value in PostgreSQL text format
+    kText,
+  };
+
+  Kind kind{Kind::kNull};
+  std::string text;
+};
+
+/// Values of a replicated row, in the order of ReplicationRelation::columns
+using ReplicationTuple = std::vector<ReplicationValue>;
+
+/// A single row change
+struct RowChange {
+  enum class Kind { kInsert, kUpdate, kDelete, kTruncate };
+
+  Kind kind{Kind::kInsert};
+  std::shared_ptr<const ReplicationRelation> relation;
+  /// The new row for kInsert and kUpdate
+  ReplicationTuple new_tuple;
+  /// The old row for kDelete and for kUpdate of the replica identity
+  /// columns. Contains only the key columns (the others are kNull) unless
+  /// the table has `REPLICA IDENTITY FULL`.
+  std::optional<ReplicationTuple> old_tuple;
+};
+
+/// All the row changes of a committed transaction
+struct ReplicationTransaction {
+  /// The changes may have been missed since the previous event, e.g.
+  /// the stream has been restarted over a new temporary slot. The
+  /// subscribers should reload their data, the event has no changes.
+  bool is_restart{false};
+  Lsn commit_lsn{0};
+  /// LSN right after the transaction, confirmed to the server once the
+  /// subscribers have processed the transaction
+  Lsn end_lsn{0};
+  std::chrono::system_clock::time_point commit_time;
+  std::vector<RowChange> changes;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,9 @@
 /// @file userver/storages/postgres/notify.hpp
 /// @brief Asynchronous notifications
 
+#include <string>
+#include <vector>
+
 #include <userver/storages/postgres/options.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
@@ -23,7 +26,7 @@ struct Notification {
 ///
 /// Used for waiting for notifications on PostgreSQL connections. Created by
 /// calling storages::postgres::Cluster::Listen(). Exclusively holds a
-/// connection from a pool.
+/// connection from a pool, which may listen on several channels at once.
 ///
 /// Non-copyable.
 ///
@@ -38,6 +41,8 @@ class [[nodiscard]] NotifyScope final {
  public:
   NotifyScope(detail::ConnectionPtr conn, std::string_view channel,
               OptionalCommandControl cmd_ctl);
+  NotifyScope(detail::ConnectionPtr conn, std::vector<std::string> channels,
+              OptionalCommandControl cmd_ctl);
 
   ~NotifyScope();
 
@@ -47,7 +52,7 @@ class [[nodiscard]] NotifyScope final {
   NotifyScope(const NotifyScope&) = delete;
   NotifyScope& operator=(const NotifyScope&) = delete;
 
-  /// Wait for notification on connection
+  /// Wait for notification on any of the channels of the connection
   Notification WaitNotify(engine::Deadline deadline);
 
  private:
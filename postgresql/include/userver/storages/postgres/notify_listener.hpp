@@ -0,0 +1,98 @@
+#pragma once
+
+/// @file userver/storages/postgres/notify_listener.hpp
+/// @brief @copybrief storages::postgres::NotifyListener
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/postgres/notify.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+struct NotifyListenerSettings final {
+  /// Notifications arriving within that time after the first one are
+  /// delivered in a single batch
+  std::chrono::milliseconds batch_window{100};
+  /// Delay before listening again after a connection failure
+  std::chrono::milliseconds relisten_interval{std::chrono::seconds{1}};
+};
+
+/// Notifications received within NotifyListenerSettings::batch_window
+struct NotificationBatch final {
+  /// The listening has been (re)started and the notifications may have been
+  /// missed since the previous batch. The subscribers should reload their
+  /// data, the batch has no notifications.
+  bool is_restart{false};
+  /// Unique notifications in the order of their first arrival, duplicates
+  /// with the same channel and payload are coalesced
+  std::vector<Notification> notifications;
+};
+
+// clang-format off
+
+/// @brief Listens for notifications on many channels over a single
+/// connection and delivers them in batches.
+///
+/// Unlike holding a NotifyScope per channel, a single connection is taken
+/// from the master pool for all the channels. The notifications are
+/// accumulated for NotifyListenerSettings::batch_window after the first one,
+/// the duplicates are coalesced, so that e.g. a burst of cache invalidations
+/// results in a single reload.
+///
+/// The callback is called from the listener task, one batch at a time. On a
+/// connection failure the listener waits for
+/// NotifyListenerSettings::relisten_interval, listens again and delivers a
+/// batch with NotificationBatch::is_restart set.
+///
+/// ## Example usage:
+///
+/// @code
+/// pg::NotifyListener listener{
+///     cluster, {"users_changed", "orders_changed"},
+///     [this](const pg::NotificationBatch& batch) { Invalidate(batch); }};
+/// @endcode
+
+// clang-format on
+
+class NotifyListener final {
+ public:
+  using Callback = std::function<void(const NotificationBatch&)>;
+  using ListenFunction =
+      std::function<NotifyScope(std::vector<std::string> channels)>;
+
+  /// Starts listening on `channels` of the cluster master in background
+  NotifyListener(ClusterPtr cluster, std::vector<std::string> channels,
+                 Callback callback, NotifyListenerSettings settings = {});
+
+  /// Starts listening on `channels` with scopes created by `listen`
+  NotifyListener(ListenFunction listen, std::vector<std::string> channels,
+                 Callback callback, NotifyListenerSettings settings = {});
+
+  /// Stops the listening, waits for the running callback
+  ~NotifyListener();
+
+  NotifyListener(const NotifyListener&) = delete;
+  NotifyListener& operator=(const NotifyListener&) = delete;
+
+ private:
+  void Run();
+  void ListenOnce();
+  void Deliver(const NotificationBatch& batch) const;
+
+  const ListenFunction listen_;
+  const std::vector<std::string> channels_;
+  const Callback callback_;
+  const NotifyListenerSettings settings_;
+  engine::TaskWithResult<void> task_;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -154,8 +154,33 @@ OptionalCommandControl GetQueryOptionalCommandControl(
 
 struct TopologySettings {
   std::chrono::milliseconds max_replication_lag{0};
+
+  /// Hosts with the smoothed RTT up to this much above the lowest one are
+  /// considered to be in the nearest datacenter by
+  /// ClusterHostType::kLatencyAware
+  std::chrono::milliseconds nearest_dc_rtt_margin{2};
+};
+
+/// @brief Client-side cache of the results of a named read query
+///
+/// The concurrent executions of the query with the same parameters wait for
+/// the single one to the database and share its ResultSet. Only the queries
+/// with the parameters of built-in types are cached.
+struct ResultCacheSettings {
+  /// Time to keep a result
+  std::chrono::milliseconds ttl{1000};
+
+  /// Max count of the results kept, one per distinct set of parameters
+  std::size_t size{1000};
+
+  /// Drop all the results on a NOTIFY to this channel, not used if empty
+  std::string invalidation_channel;
 };
 
+/// Result caches by query names
+using ResultCacheSettingsByQuery =
+    std::unordered_map<std::string, ResultCacheSettings>;
+
 /// Default initial pool connection count
 static constexpr size_t kDefaultPoolMinSize = 4;
 
@@ -168,6 +193,9 @@ static constexpr size_t kDefaultPoolMaxQueueSize = 200;
 /// Default limit for concurrent establishing connections number
 static constexpr size_t kDefaultConnectingLimit = 0;
 
+/// Default limit for the number of queries in a pipelined batch
+static constexpr size_t kDefaultPipelineBatchMaxSize = 32;
+
 /// @brief PostgreSQL connection pool options
 ///
 /// Dynamic option @ref POSTGRES_CONNECTION_POOL_SETTINGS
@@ -184,10 +212,29 @@ struct PoolSettings {
   /// Limits number of concurrent establishing connections (0 - unlimited)
   size_t connecting_limit{kDefaultConnectingLimit};
 
+  /// Single statements from different tasks that arrive within this window
+  /// are sent in a single pipelined batch over one connection (0 - disabled)
+  std::chrono::microseconds pipeline_batching_window{0};
+
+  /// Maximum number of statements in a pipelined batch
+  size_t pipeline_batch_max_size{kDefaultPipelineBatchMaxSize};
+
+  /// Number of idle connections opened in background on top of the ones in
+  /// use and awaited, so that load growth does not wait for new connections
+  size_t spare_size{0};
+
+  /// Number of the statements prepared by most connections of the pool that
+  /// a new connection prepares before serving queries (0 - disabled)
+  size_t prepare_warmup_size{0};
+
   bool operator==(const PoolSettings& rhs) const {
     return min_size == rhs.min_size && max_size == rhs.max_size &&
            max_queue_size == rhs.max_queue_size &&
-           connecting_limit == rhs.connecting_limit;
+           connecting_limit == rhs.connecting_limit &&
+           pipeline_batching_window == rhs.pipeline_batching_window &&
+           pipeline_batch_max_size == rhs.pipeline_batch_max_size &&
+           spare_size == rhs.spare_size &&
+           prepare_warmup_size == rhs.prepare_warmup_size;
   }
 };
 
@@ -275,9 +322,17 @@ struct ConnectionSettings {
 struct StatementMetricsSettings final {
   /// Store metrics in LRU of this size
   size_t max_statements{0};
+  /// Capture the plans of the statements that run at least this long,
+  /// zero to disable
+  std::chrono::milliseconds slow_query_threshold{0};
+  /// Capture at most one plan of a slow statement per this interval
+  std::chrono::milliseconds slow_query_explain_interval{
+      std::chrono::seconds{10}};
 
   bool operator==(const StatementMetricsSettings& other) const {
-    return max_statements == other.max_statements;
+    return max_statements == other.max_statements &&
+           slow_query_threshold == other.slow_query_threshold &&
+           slow_query_explain_interval == other.slow_query_explain_interval;
   }
 };
 
@@ -317,6 +372,9 @@ struct ClusterSettings {
 
   /// congestion control settings
   congestion_control::v2::LinearController::StaticConfig cc_config;
+
+  /// client-side result caches of the named queries
+  ResultCacheSettingsByQuery result_caches;
 };
 
 }  // namespace storages::postgres
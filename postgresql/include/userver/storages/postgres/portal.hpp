@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <userver/engine/deadline.hpp>
@@ -11,6 +14,7 @@
 #include <userver/storages/postgres/postgres_fwd.hpp>
 #include <userver/storages/postgres/query.hpp>
 #include <userver/storages/postgres/result_set.hpp>
+#include <userver/storages/postgres/typed_result_set.hpp>
 
 #include <userver/utils/fast_pimpl.hpp>
 #include <userver/utils/strong_typedef.hpp>
@@ -58,6 +62,82 @@ class Portal {
   USERVER_NAMESPACE::utils::FastPimpl<Impl, kImplSize, kImplAlign> pimpl_;
 };
 
+/// @brief Input range of typed rows fetched from a portal in chunks.
+///
+/// Only a single chunk of `chunk_size` rows is held in memory, a row is parsed
+/// when the iterator is dereferenced. Row fields of `std::string_view` type
+/// refer to the current chunk and are valid until the iterator is advanced
+/// past the chunk.
+///
+/// @code
+/// auto portal = trx.MakePortal("SELECT id, name FROM t");
+/// for (const auto& row : TypedPortalRows<MyRow, RowTag>{portal, 1000}) {
+///   Process(row);
+/// }
+/// @endcode
+template <typename T, typename ExtractionTag = FieldTag>
+class TypedPortalRows {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = typename TypedResultSet<T, ExtractionTag>::reference;
+    using pointer = void;
+
+    Iterator() = default;
+
+    reference operator*() const { return rows_->Current(); }
+
+    Iterator& operator++() {
+      if (!rows_->Next()) rows_ = nullptr;
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return rows_ == other.rows_;
+    }
+    bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+   private:
+    friend class TypedPortalRows;
+    explicit Iterator(TypedPortalRows* rows) : rows_{rows} {}
+
+    TypedPortalRows* rows_{nullptr};
+  };
+
+  TypedPortalRows(Portal& portal, std::uint32_t chunk_size)
+      : portal_{&portal}, chunk_size_{chunk_size} {}
+
+  /// May be called only once, fetches the first chunk
+  Iterator begin() { return Iterator{FetchChunk() ? this : nullptr}; }
+  Iterator end() { return Iterator{}; }
+
+ private:
+  typename Iterator::reference Current() const { return (*chunk_)[index_]; }
+
+  bool Next() { return ++index_ < chunk_->Size() || FetchChunk(); }
+
+  bool FetchChunk() {
+    index_ = 0;
+    chunk_.reset();
+    while (!portal_->Done()) {
+      auto res = portal_->Fetch(chunk_size_);
+      if (!res.IsEmpty()) {
+        chunk_.emplace(res.template AsSetOf<T>(ExtractionTag{}));
+        return true;
+      }
+    }
+    return false;
+  }
+
+  Portal* portal_;
+  std::uint32_t chunk_size_;
+  std::optional<TypedResultSet<T, ExtractionTag>> chunk_;
+  std::size_t index_{0};
+};
+
 }  // namespace storages::postgres
 
 USERVER_NAMESPACE_END
@@ -34,6 +34,8 @@
 /// - Portals for effective background cache updates;
 /// - Queries pipelining;
 /// - Mapping PostgreSQL user types to C++ types;
+/// - Logical replication streams for cache invalidation, see
+///   components::PostgresLogicalReplication;
 /// - @ref scripts/docs/en/userver/deadline_propagation.md .
 ///
 /// @section toc More information
@@ -21,6 +21,7 @@ class Cluster;
 using ClusterPtr = std::shared_ptr<Cluster>;
 
 namespace detail {
+class ClusterImpl;
 class Connection;
 class ConnectionImpl;
 class ConnectionPtr;
@@ -671,6 +671,11 @@ class ResultSet {
 
   /// @brief Extract data into a container.
   /// For more information see @ref psql_typed_results
+  ///
+  /// The container holds a parsed copy of all the rows along with the result
+  /// set. For large results consider iterating over AsSetOf(), which parses
+  /// rows one by one, or fetching the rows in chunks with
+  /// storages::postgres::TypedPortalRows.
   template <typename Container>
   Container AsContainer() const;
   template <typename Container>
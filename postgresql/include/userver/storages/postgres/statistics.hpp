@@ -9,6 +9,7 @@
 #include <userver/storages/postgres/detail/time_types.hpp>
 
 #include <userver/congestion_control/controllers/linear.hpp>
+#include <userver/utils/statistics/log_linear_histogram.hpp>
 #include <userver/utils/statistics/min_max_avg.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
@@ -133,6 +134,22 @@ using InstanceStatistics = InstanceStatisticsTemplate<
     USERVER_NAMESPACE::utils::statistics::RecentPeriod<MinMaxAvg, MinMaxAvg,
                                                        detail::SteadyClock>>;
 
+/// Log-linear histogram of durations in microseconds, up to ~2 minutes
+using PhaseHistogram =
+    USERVER_NAMESPACE::utils::statistics::LogLinearHistogram<4, 27>;
+
+/// @brief Durations of the phases of a named statement
+///
+/// The network round trips and the server work can not be told apart on
+/// the client, so each phase includes both.
+struct StatementPhaseTimings {
+  /// Parse and describe of the statement, accounted only for the executions
+  /// that had to prepare the statement on the connection
+  PhaseHistogram prepare;
+  /// Bind, execute and fetch of the result
+  PhaseHistogram execute;
+};
+
 using InstanceStatisticsNonatomicBase =
     InstanceStatisticsTemplate<uint32_t, Percentile, MinMaxAvg>;
 
@@ -208,7 +225,23 @@ struct InstanceStatisticsNonatomic : InstanceStatisticsNonatomicBase {
     return *this;
   }
 
+  InstanceStatisticsNonatomic& Add(
+      const std::unordered_map<std::string, StatementPhaseTimings>& timings) {
+    for (const auto& [name, phases] : timings) {
+      const auto [it, inserted] =
+          statement_phase_timings.try_emplace(name, phases);
+      if (!inserted) {
+        it->second.prepare.Add(phases.prepare);
+        it->second.execute.Add(phases.execute);
+      }
+    }
+
+    return *this;
+  }
+
   std::unordered_map<std::string, Percentile> statement_timings;
+  std::unordered_map<std::string, StatementPhaseTimings>
+      statement_phase_timings;
 };
 
 /// @brief Instance statistics with description
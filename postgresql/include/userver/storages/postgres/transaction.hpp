@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 
+#include <userver/storages/postgres/copy.hpp>
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
@@ -288,6 +289,21 @@ class Transaction {
   Portal MakePortal(OptionalCommandControl statement_cmd_ctl,
                     const Query& query, const ParameterStore& store);
 
+  /// Start a `COPY ... FROM STDIN (FORMAT binary)` statement, the rows are
+  /// streamed by the returned writer in chunks of about `chunk_size` bytes.
+  /// The transaction can't be used until the writer is finished or destroyed,
+  /// the writer must not outlive the transaction.
+  CopyWriter CopyFrom(const Query& query,
+                      std::size_t chunk_size = CopyWriter::kDefaultChunkSize,
+                      OptionalCommandControl statement_cmd_ctl = {});
+
+  /// Start a `COPY ... TO STDOUT (FORMAT binary)` statement, the rows are read
+  /// one by one with the returned reader.
+  /// The transaction can't be used until all the rows are read, the reader
+  /// must not outlive the transaction.
+  CopyReader CopyTo(const Query& query,
+                    OptionalCommandControl statement_cmd_ctl = {});
+
   /// Set a connection parameter
   /// https://www.postgresql.org/docs/current/sql-set.html
   /// The parameter is set for this transaction only
@@ -310,6 +326,8 @@ class Transaction {
   TimeoutDuration GetConnStatementTimeoutDebug() const;
 
  private:
+  friend class detail::ClusterImpl;
+
   ResultSet DoExecute(const Query& query, const detail::QueryParameters& params,
                       OptionalCommandControl statement_cmd_ctl);
   Portal MakePortal(const PortalName&, const Query& query,
@@ -50,7 +50,12 @@ Transaction Cluster::Begin(const std::string& name, ClusterHostTypeFlags flags,
 
 NotifyScope Cluster::Listen(std::string_view channel,
                             OptionalCommandControl cmd_ctl) {
-  return pimpl_->Listen(channel, cmd_ctl);
+  return pimpl_->Listen({std::string{channel}}, cmd_ctl);
+}
+
+NotifyScope Cluster::Listen(std::vector<std::string> channels,
+                            OptionalCommandControl cmd_ctl) {
+  return pimpl_->Listen(std::move(channels), cmd_ctl);
 }
 
 void Cluster::SetDefaultCommandControl(CommandControl cmd_ctl) {
@@ -95,6 +100,26 @@ detail::NonTransaction Cluster::Start(ClusterHostTypeFlags flags,
   return pimpl_->Start(flags, cmd_ctl);
 }
 
+bool Cluster::IsPipelineBatchingEnabled() const {
+  return pimpl_->IsPipelineBatchingEnabled();
+}
+
+bool Cluster::HasResultCache(const Query& query) const {
+  return pimpl_->HasResultCache(query);
+}
+
+ResultSet Cluster::ExecuteWithParams(ClusterHostTypeFlags flags,
+                                     OptionalCommandControl cmd_ctl,
+                                     const Query& query,
+                                     const detail::QueryParameters& params) {
+  return pimpl_->ExecuteWithParams(flags, cmd_ctl, query, params);
+}
+
+const UserTypes& Cluster::GetSystemTypes() {
+  static const UserTypes kSystemTypes;
+  return kSystemTypes;
+}
+
 OptionalCommandControl Cluster::GetQueryCmdCtl(
     const std::string& query_name) const {
   return pimpl_->GetQueryCmdCtl(query_name);
@@ -117,6 +142,10 @@ ResultSet Cluster::Execute(ClusterHostTypeFlags flags,
     statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
   }
   statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
+  if (IsPipelineBatchingEnabled() || HasResultCache(query)) {
+    return ExecuteWithParams(flags, statement_cmd_ctl, query,
+                             detail::QueryParameters{store.GetInternalData()});
+  }
   auto ntrx = Start(flags, statement_cmd_ctl);
   return ntrx.Execute(statement_cmd_ctl, query.Statement(), store);
 }
@@ -12,6 +12,7 @@
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/error_injection/settings.hpp>
+#include <userver/formats/parse/common_containers.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/cluster_types.hpp>
@@ -93,6 +94,12 @@ Postgres::Postgres(const ComponentConfig& config,
   initial_settings_.topology_settings.max_replication_lag =
       config["max_replication_lag"].As<std::chrono::milliseconds>(
           kDefaultMaxReplicationLag);
+  initial_settings_.result_caches =
+      config["result_cache"].As<storages::postgres::ResultCacheSettingsByQuery>(
+          storages::postgres::ResultCacheSettingsByQuery{});
+  initial_settings_.topology_settings.nearest_dc_rtt_margin =
+      config["nearest_dc_rtt_margin"].As<std::chrono::milliseconds>(
+          initial_settings_.topology_settings.nearest_dc_rtt_margin);
 
   initial_settings_.pool_settings =
       pg_config.pool_settings.GetOptional(name_).value_or(
@@ -220,6 +227,10 @@ properties:
         type: string
         description: replication lag limit for usable slaves
         defaultDescription: 60s
+    nearest_dc_rtt_margin:
+        type: string
+        description: max RTT difference of the hosts of the nearest datacenter for the latency-aware host selection
+        defaultDescription: 2ms
     min_pool_size:
         type: integer
         description: number of connections created initially
@@ -277,6 +288,18 @@ properties:
         type: integer
         description: limit of exported metrics for named statements
         defaultDescription: 0
+    slow_query_threshold_ms:
+        type: integer
+        description: |
+            run EXPLAIN (ANALYZE, BUFFERS) on a replica for the statements
+            that run at least this long and log the plan, 0 to disable
+        defaultDescription: 0
+        minimum: 0
+    slow_query_explain_interval_ms:
+        type: integer
+        description: min interval between the plan captures of slow statements
+        defaultDescription: 10000
+        minimum: 1
     error-injection:
         type: object
         description: error-injection options
@@ -314,12 +337,49 @@ properties:
         type: integer
         description: limit for concurrent establishing connections number per pool (0 - unlimited)
         defaultDescription: 0
+    pipeline_batching_window_us:
+        type: integer
+        description: single statements arriving within this window are sent in a single pipelined batch (0 - disabled)
+        defaultDescription: 0
+    pipeline_batch_max_size:
+        type: integer
+        description: maximum number of statements in a pipelined batch
+        defaultDescription: 32
+    spare_pool_size:
+        type: integer
+        description: number of idle connections opened in background on top of the ones in use and awaited
+        defaultDescription: 0
+    prepare_warmup_size:
+        type: integer
+        description: number of the statements prepared by most connections of the pool that a new connection prepares before serving queries (0 - disabled)
+        defaultDescription: 0
     connlimit_mode:
         type: string
         enum:
          - auto
          - manual
         description: how to learn a connection pool size
+    result_cache:
+        type: object
+        description: client-side caches of the results of the named read queries with the parameters of built-in types, by query names
+        properties: {}
+        additionalProperties:
+            type: object
+            description: result cache of the query
+            additionalProperties: false
+            properties:
+                ttl:
+                    type: string
+                    description: time to keep a result
+                    defaultDescription: 1s
+                size:
+                    type: integer
+                    description: max count of the results kept, one per distinct set of parameters
+                    defaultDescription: 1000
+                invalidation_channel:
+                    type: string
+                    description: drop all the results of the query on a NOTIFY to this channel
+                    defaultDescription: ''
 )");
 }
 
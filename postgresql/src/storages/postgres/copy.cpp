@@ -0,0 +1,152 @@
+#include <userver/storages/postgres/copy.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/io/integral_types.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace {
+
+// https://www.postgresql.org/docs/current/sql-copy.html#id-1.9.3.55.9.4.5
+constexpr std::string_view kSignature{"PGCOPY\n\377\r\n\0", 11};
+constexpr std::size_t kHeaderSize =
+    kSignature.size() + 2 * sizeof(Integer);
+constexpr Smallint kTrailer = -1;
+
+std::string MakeHeader(const UserTypes& types) {
+  std::string header{kSignature};
+  // Flags and header extension length
+  io::WriteBuffer(types, header, Integer{0});
+  io::WriteBuffer(types, header, Integer{0});
+  return header;
+}
+
+io::FieldBuffer MakeFieldBuffer(std::string_view data) {
+  return {false, io::BufferCategory::kPlainBuffer, data.size(),
+          reinterpret_cast<const std::uint8_t*>(data.data())};
+}
+
+}  // namespace
+
+CopyWriter::CopyWriter(detail::Connection* conn, const Query& query,
+                       std::size_t chunk_size, OptionalCommandControl cmd_ctl)
+    : conn_{conn},
+      types_{&conn->GetUserTypes()},
+      chunk_size_{chunk_size},
+      buffer_{MakeHeader(*types_)} {
+  buffer_.reserve(chunk_size_ + kHeaderSize);
+  conn_->CopyStart(query, std::move(cmd_ctl));
+}
+
+CopyWriter::CopyWriter(CopyWriter&& other) noexcept
+    : conn_{std::exchange(other.conn_, nullptr)},
+      types_{other.types_},
+      chunk_size_{other.chunk_size_},
+      buffer_{std::move(other.buffer_)} {}
+
+CopyWriter::~CopyWriter() {
+  if (conn_) conn_->CopyAbort();
+}
+
+std::size_t CopyWriter::Finish() {
+  auto& conn = GetConnection();
+  io::WriteBuffer(*types_, buffer_, kTrailer);
+  try {
+    conn.CopyPutData(buffer_);
+    buffer_.clear();
+    const auto res = std::exchange(conn_, nullptr)->CopyPutEnd();
+    return res.RowsAffected();
+  } catch (...) {
+    if (conn_) std::exchange(conn_, nullptr)->CopyAbort();
+    throw;
+  }
+}
+
+void CopyWriter::BeginRow(std::size_t columns) {
+  GetConnection();
+  io::WriteBuffer(*types_, buffer_, static_cast<Smallint>(columns));
+}
+
+void CopyWriter::EndRow() {
+  if (buffer_.size() < chunk_size_) return;
+  conn_->CopyPutData(buffer_);
+  buffer_.clear();
+}
+
+detail::Connection& CopyWriter::GetConnection() {
+  if (!conn_) throw LogicError{"COPY is already finished"};
+  return *conn_;
+}
+
+CopyReader::CopyReader(detail::Connection* conn, const Query& query,
+                       OptionalCommandControl cmd_ctl)
+    : conn_{conn} {
+  conn_->CopyStart(query, std::move(cmd_ctl));
+
+  // The header may be sent in a separate message or together with the first
+  // row
+  std::string header;
+  while (header.size() < kHeaderSize) {
+    if (!conn_->CopyGetData(data_)) {
+      conn_ = nullptr;
+      throw InvalidInputBufferSize{header.size(), "in COPY header"};
+    }
+    header += data_;
+  }
+  if (std::string_view{header}.substr(0, kSignature.size()) != kSignature) {
+    conn_->CopyAbort();
+    throw InvalidInputFormat{"Invalid binary COPY signature"};
+  }
+  auto buffer = MakeFieldBuffer(std::string_view{header}.substr(
+      kSignature.size() + sizeof(Integer)));
+  Integer extension_size{0};
+  buffer.Read(extension_size, io::BufferCategory::kPlainBuffer);
+  // The extension is skipped, no extensions are defined for now
+  data_ = header.substr(kHeaderSize + extension_size);
+}
+
+CopyReader::CopyReader(CopyReader&& other) noexcept
+    : conn_{std::exchange(other.conn_, nullptr)},
+      data_{std::move(other.data_)},
+      row_{std::move(other.row_)} {}
+
+CopyReader::~CopyReader() {
+  if (conn_) conn_->CopyAbort();
+}
+
+std::optional<io::FieldBuffer> CopyReader::NextRow(std::size_t columns) {
+  if (!conn_) return std::nullopt;
+  if (data_.empty() && !conn_->CopyGetData(data_)) {
+    conn_ = nullptr;
+    return std::nullopt;
+  }
+
+  row_.swap(data_);
+  data_.clear();
+  auto buffer = MakeFieldBuffer(row_);
+  Smallint field_count{0};
+  buffer.Read(field_count, io::BufferCategory::kPlainBuffer);
+  if (field_count == kTrailer) {
+    // The end of the COPY is received after the trailer
+    std::string rest;
+    while (conn_->CopyGetData(rest)) {
+    }
+    conn_ = nullptr;
+    return std::nullopt;
+  }
+  if (static_cast<std::size_t>(field_count) != columns) {
+    throw FieldTupleMismatch{static_cast<std::size_t>(field_count), columns};
+  }
+  return buffer;
+}
+
+const io::TypeBufferCategory& CopyReader::GetTypeBufferCategories() const {
+  return conn_->GetUserTypes().GetTypeBufferCategories();
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,12 @@
 #include <storages/postgres/detail/cluster_impl.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <unordered_set>
+
 #include <fmt/format.h>
 
 #include <userver/dynamic_config/value.hpp>
@@ -31,15 +38,61 @@ ClusterHostType Fallback(ClusterHostType ht) {
     case ClusterHostType::kNone:
     case ClusterHostType::kRoundRobin:
     case ClusterHostType::kNearest:
+    case ClusterHostType::kLatencyAware:
       throw ClusterError("Invalid ClusterHostType value for fallback " +
                          ToString(ht));
   }
   UINVARIANT(false, "Unexpected cluster host type");
 }
 
-size_t SelectDsnIndex(const topology::TopologyBase::DsnIndices& indices,
-                      ClusterHostTypeFlags flags,
-                      std::atomic<uint32_t>& rr_host_idx) {
+// 1ms of replication lag costs as much as 100us of RTT
+constexpr int kReplicationLagCostDivisor = 10;
+
+size_t SelectLatencyAwareDsnIndex(
+    const topology::TopologyBase::DsnIndices& indices,
+    const topology::TopologyBase& topology,
+    const std::vector<std::shared_ptr<ConnectionPool>>& host_pools,
+    std::atomic<uint32_t>& rr_host_idx) {
+  const auto latencies = topology.GetHostLatencies();
+
+  auto min_rtt = std::chrono::microseconds::max();
+  for (const auto idx : indices) {
+    UASSERT(idx < latencies->size());
+    min_rtt = std::min(min_rtt, (*latencies)[idx].rtt);
+  }
+  const auto max_rtt =
+      min_rtt + topology.GetTopologySettings().nearest_dc_rtt_margin;
+
+  // The scan starts from a rotating position, so that the hosts of the same
+  // cost share the load
+  const auto start = rr_host_idx.fetch_add(1, std::memory_order_relaxed);
+  size_t best_idx = indices.front();
+  auto best_cost = std::numeric_limits<std::int64_t>::max();
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const auto idx = indices[(start + i) % indices.size()];
+    const auto& latency = (*latencies)[idx];
+    if (latency.rtt > max_rtt) continue;
+
+    const auto effective_rtt =
+        latency.rtt + std::chrono::microseconds{latency.replication_lag} /
+                          kReplicationLagCostDivisor;
+    // +1 keeps the in-flight count relevant for a zero RTT
+    const auto cost =
+        (effective_rtt.count() + 1) *
+        static_cast<std::int64_t>(host_pools[idx]->GetInFlightApprox() + 1);
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_idx = idx;
+    }
+  }
+  return best_idx;
+}
+
+size_t SelectDsnIndex(
+    const topology::TopologyBase::DsnIndices& indices,
+    ClusterHostTypeFlags flags, const topology::TopologyBase& topology,
+    const std::vector<std::shared_ptr<ConnectionPool>>& host_pools,
+    std::atomic<uint32_t>& rr_host_idx) {
   UASSERT(!indices.empty());
   if (indices.empty()) {
     throw ClusterError("Cannot select host from an empty list");
@@ -54,6 +107,11 @@ size_t SelectDsnIndex(const topology::TopologyBase::DsnIndices& indices,
       idx_pos =
           rr_host_idx.fetch_add(1, std::memory_order_relaxed) % indices.size();
     }
+  } else if (strategy_flags == ClusterHostType::kLatencyAware) {
+    if (indices.size() != 1) {
+      return SelectLatencyAwareDsnIndex(indices, topology, host_pools,
+                                        rr_host_idx);
+    }
   } else if (strategy_flags != ClusterHostType::kNearest) {
     throw LogicError(
         fmt::format("Invalid strategy requested: {}, ensure only one is used",
@@ -112,14 +170,33 @@ ClusterImpl::ClusterImpl(DsnList dsns, clients::dns::Resolver* resolver,
   }
   LOG_DEBUG() << "Pools initialized";
 
+  slow_query_explainer_ = std::make_shared<SlowQueryExplainer>(
+      bg_task_processor_, cluster_settings.statement_metrics_settings,
+      [this](const Query& query, const QueryParameters& params,
+             TimeoutDuration timeout) {
+        return ExplainOnReplica(query, params, timeout);
+      });
+  for (const auto& pool : host_pools_) {
+    pool->SetSlowQueryExplainer(slow_query_explainer_);
+  }
+
   // Do not use IsConnlimitModeAuto() here because we don't care about
   // the current dynamic config value
   if (cluster_settings.connlimit_mode == ConnlimitMode::kAuto) {
     connlimit_watchdog_.Start();
   }
+
+  for (const auto& [query_name, settings] : cluster_settings.result_caches) {
+    result_caches_.emplace(query_name, std::make_unique<ResultCache>(settings));
+  }
+  StartResultCacheInvalidation();
 }
 
-ClusterImpl::~ClusterImpl() { connlimit_watchdog_.Stop(); }
+ClusterImpl::~ClusterImpl() {
+  slow_query_explainer_->Stop();
+  result_cache_listener_.reset();
+  connlimit_watchdog_.Stop();
+}
 
 ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
   auto cluster_stats = std::make_unique<ClusterStatistics>();
@@ -145,6 +222,9 @@ ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
     cluster_stats->master.stats.Add(host_pools_[dsn_index]
                                         ->GetStatementTimingsStorage()
                                         .GetTimingsPercentiles());
+    cluster_stats->master.stats.Add(host_pools_[dsn_index]
+                                        ->GetStatementTimingsStorage()
+                                        .GetPhaseTimings());
     is_host_pool_seen[dsn_index] = 1;
   }
 
@@ -162,6 +242,9 @@ ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
     cluster_stats->sync_slave.stats.Add(host_pools_[dsn_index]
                                             ->GetStatementTimingsStorage()
                                             .GetTimingsPercentiles());
+    cluster_stats->sync_slave.stats.Add(host_pools_[dsn_index]
+                                            ->GetStatementTimingsStorage()
+                                            .GetPhaseTimings());
     is_host_pool_seen[dsn_index] = 1;
   }
 
@@ -183,6 +266,9 @@ ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
       slave_desc.stats.Add(host_pools_[dsn_index]
                                ->GetStatementTimingsStorage()
                                .GetTimingsPercentiles());
+      slave_desc.stats.Add(host_pools_[dsn_index]
+                               ->GetStatementTimingsStorage()
+                               .GetPhaseTimings());
       is_host_pool_seen[dsn_index] = 1;
     }
   }
@@ -197,6 +283,8 @@ ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
     desc.stats.Add(host_pools_[i]->GetStatistics(), dsn_stats[i]);
     desc.stats.Add(
         host_pools_[i]->GetStatementTimingsStorage().GetTimingsPercentiles());
+    desc.stats.Add(
+        host_pools_[i]->GetStatementTimingsStorage().GetPhaseTimings());
 
     cluster_stats->unknown.push_back(std::move(desc));
   }
@@ -223,7 +311,8 @@ ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
     if (alive_dsn_indices->empty()) {
       throw ClusterUnavailable("None of cluster hosts are available");
     }
-    dsn_index = SelectDsnIndex(*alive_dsn_indices, flags, rr_host_idx_);
+    dsn_index = SelectDsnIndex(*alive_dsn_indices, flags, *topology_,
+                               host_pools_, rr_host_idx_);
   } else {
     auto host_role = static_cast<ClusterHostType>(role_flags.GetValue());
     auto dsn_indices_by_type = topology_->GetDsnIndicesByType();
@@ -245,7 +334,8 @@ ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
                       ToString(host_role), ToString(role_flags)));
     }
     LOG_TRACE() << "Starting transaction on " << host_role;
-    dsn_index = SelectDsnIndex(dsn_indices_it->second, flags, rr_host_idx_);
+    dsn_index = SelectDsnIndex(dsn_indices_it->second, flags, *topology_,
+                               host_pools_, rr_host_idx_);
   }
 
   UASSERT(dsn_index < host_pools_.size());
@@ -280,9 +370,124 @@ NonTransaction ClusterImpl::Start(ClusterHostTypeFlags flags,
   return FindPool(flags)->Start(cmd_ctl);
 }
 
-NotifyScope ClusterImpl::Listen(std::string_view channel,
+bool ClusterImpl::IsPipelineBatchingEnabled() const {
+  const auto settings = cluster_settings_.Read();
+  return settings->pool_settings.pipeline_batching_window >
+         std::chrono::microseconds::zero();
+}
+
+bool ClusterImpl::HasResultCache(const Query& query) const {
+  return !result_caches_.empty() && query.GetName() &&
+         result_caches_.count(query.GetName()->GetUnderlying()) != 0;
+}
+
+ResultSet ClusterImpl::ExecuteWithParams(ClusterHostTypeFlags flags,
+                                         OptionalCommandControl cmd_ctl,
+                                         const Query& query,
+                                         const QueryParameters& params) {
+  const auto execute = [&] {
+    if (IsPipelineBatchingEnabled()) {
+      return ExecuteBatched(flags, cmd_ctl, query, params);
+    }
+    auto ntrx = Start(flags, cmd_ctl);
+    return ntrx.DoExecute(query, params, cmd_ctl);
+  };
+
+  if (query.GetName() && !result_caches_.empty()) {
+    const auto it = result_caches_.find(query.GetName()->GetUnderlying());
+    if (it != result_caches_.end()) {
+      return it->second->Get(flags, params, execute);
+    }
+  }
+  return execute();
+}
+
+ResultSet ClusterImpl::ExecuteBatched(ClusterHostTypeFlags flags,
+                                      OptionalCommandControl cmd_ctl,
+                                      const Query& query,
+                                      const QueryParameters& params) {
+  if (!(flags & kClusterHostRolesMask)) {
+    throw LogicError(
+        "Host role must be specified for execution of a single statement");
+  }
+  LOG_TRACE() << "Requested batched statement on " << flags;
+  return FindPool(flags)->ExecuteBatched(query, params, cmd_ctl);
+}
+
+NotifyScope ClusterImpl::Listen(std::vector<std::string> channels,
                                 OptionalCommandControl cmd_ctl) {
-  return FindPool(ClusterHostType::kMaster)->Listen(channel, cmd_ctl);
+  return FindPool(ClusterHostType::kMaster)
+      ->Listen(std::move(channels), cmd_ctl);
+}
+
+void ClusterImpl::StartResultCacheInvalidation() {
+  for (const auto& [query_name, cache] : result_caches_) {
+    const auto& channel = cache->GetSettings().invalidation_channel;
+    if (!channel.empty()) {
+      result_caches_by_channel_[channel].push_back(cache.get());
+    }
+  }
+  if (result_caches_by_channel_.empty()) return;
+
+  // A single listening connection for all the channels
+  std::vector<std::string> channels;
+  channels.reserve(result_caches_by_channel_.size());
+  for (const auto& [channel, caches] : result_caches_by_channel_) {
+    LOG_INFO() << "Listening for result cache invalidations on " << channel;
+    channels.push_back(channel);
+  }
+  result_cache_listener_ = std::make_unique<NotifyListener>(
+      [this](std::vector<std::string> listen_channels) {
+        return Listen(std::move(listen_channels), {});
+      },
+      std::move(channels),
+      [this](const NotificationBatch& batch) {
+        InvalidateResultCaches(batch);
+      });
+}
+
+void ClusterImpl::InvalidateResultCaches(const NotificationBatch& batch) {
+  if (batch.is_restart) {
+    for (const auto& [channel, caches] : result_caches_by_channel_) {
+      for (auto* cache : caches) cache->Invalidate();
+    }
+    return;
+  }
+
+  // The batch is coalesced by payload, the channels may still repeat
+  std::unordered_set<std::string_view> invalidated;
+  for (const auto& notification : batch.notifications) {
+    if (!invalidated.insert(notification.channel).second) continue;
+    const auto it = result_caches_by_channel_.find(notification.channel);
+    if (it == result_caches_by_channel_.end()) continue;
+    LOG_DEBUG() << "Invalidating result caches on " << notification.channel;
+    for (auto* cache : it->second) cache->Invalidate();
+  }
+}
+
+std::vector<std::string> ClusterImpl::ExplainOnReplica(
+    const Query& query, const QueryParameters& params,
+    TimeoutDuration timeout) {
+  {
+    // FindPool falls back to the master, which must not get the extra load
+    const auto dsn_indices_by_type = topology_->GetDsnIndicesByType();
+    const auto it = dsn_indices_by_type->find(ClusterHostType::kSlave);
+    if (it == dsn_indices_by_type->end() || it->second.empty()) {
+      throw ClusterUnavailable("No replica to capture the plan on");
+    }
+  }
+
+  // EXPLAIN ANALYZE executes the statement, the read-only transaction
+  // rejects any writes
+  const CommandControl cmd_ctl{timeout, timeout};
+  auto trx = FindPool(ClusterHostType::kSlave)
+                 ->Begin(TransactionOptions{TransactionOptions::kReadOnly},
+                         cmd_ctl);
+  auto res = trx.DoExecute(
+      Query{"EXPLAIN (ANALYZE, BUFFERS) " + query.Statement()}, params,
+      cmd_ctl);
+  trx.Rollback();
+  return res.AsContainer<std::vector<std::string>>();
 }
 
 void ClusterImpl::SetDefaultCommandControl(CommandControl cmd_ctl,
@@ -364,6 +569,7 @@ void ClusterImpl::SetStatementMetricsSettings(
   for (const auto& pool : host_pools_) {
     pool->SetStatementMetricsSettings(settings);
   }
+  slow_query_explainer_->SetSettings(settings);
 }
 
 OptionalCommandControl ClusterImpl::GetQueryCmdCtl(
@@ -2,6 +2,8 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
@@ -14,11 +16,14 @@
 #include <storages/postgres/connlimit_watchdog.hpp>
 #include <storages/postgres/detail/pg_impl_types.hpp>
 #include <storages/postgres/detail/pool.hpp>
+#include <storages/postgres/detail/result_cache.hpp>
+#include <storages/postgres/detail/slow_query_explainer.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 #include <storages/postgres/detail/topology/base.hpp>
 #include <userver/storages/postgres/cluster_types.hpp>
 #include <userver/storages/postgres/detail/non_transaction.hpp>
 #include <userver/storages/postgres/notify.hpp>
+#include <userver/storages/postgres/notify_listener.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/storages/postgres/transaction.hpp>
@@ -47,7 +52,13 @@ class ClusterImpl {
 
   NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
-  NotifyScope Listen(std::string_view channel, OptionalCommandControl);
+  bool IsPipelineBatchingEnabled() const;
+  bool HasResultCache(const Query& query) const;
+  ResultSet ExecuteWithParams(ClusterHostTypeFlags, OptionalCommandControl,
+                              const Query& query,
+                              const QueryParameters& params);
+
+  NotifyScope Listen(std::vector<std::string> channels, OptionalCommandControl);
 
   void SetDefaultCommandControl(CommandControl, DefaultCommandControlSource);
   CommandControl GetDefaultCommandControl() const;
@@ -79,6 +90,17 @@ class ClusterImpl {
 
   ConnectionPoolPtr FindPool(ClusterHostTypeFlags);
 
+  ResultSet ExecuteBatched(ClusterHostTypeFlags, OptionalCommandControl,
+                           const Query& query, const QueryParameters& params);
+
+  void StartResultCacheInvalidation();
+  void InvalidateResultCaches(const NotificationBatch& batch);
+
+  /// @see SlowQueryExplainer::ExplainFunc
+  std::vector<std::string> ExplainOnReplica(const Query& query,
+                                            const QueryParameters& params,
+                                            TimeoutDuration timeout);
+
   DefaultCommandControls default_cmd_ctls_;
   rcu::Variable<ClusterSettings> cluster_settings_;
   std::unique_ptr<topology::TopologyBase> topology_;
@@ -87,6 +109,14 @@ class ClusterImpl {
   std::atomic<uint32_t> rr_host_idx_;
   dynamic_config::Source config_source_;
   ConnlimitWatchdog connlimit_watchdog_;
+  // Immutable after construction
+  std::unordered_map<std::string, std::unique_ptr<ResultCache>> result_caches_;
+  std::unordered_map<std::string, std::vector<ResultCache*>>
+      result_caches_by_channel_;
+  // Listens to the invalidations, must be stopped before the pools
+  std::unique_ptr<NotifyListener> result_cache_listener_;
+  // The pools refer to it weakly, must be stopped before the pools
+  std::shared_ptr<SlowQueryExplainer> slow_query_explainer_;
 };
 
 }  // namespace storages::postgres::detail
@@ -23,14 +23,14 @@ std::unique_ptr<Connection> Connection::Connect(
     ConnectionSettings settings, const DefaultCommandControls& default_cmd_ctls,
     const testsuite::PostgresControl& testsuite_pg_ctl,
     const error_injection::Settings& ei_settings,
-    engine::SemaphoreLock&& size_lock) {
+    engine::SemaphoreLock&& size_lock, StatementDescriptions* descriptions) {
   std::unique_ptr<Connection> conn(new Connection());
 
   const auto deadline = engine::Deadline::FromDuration(std::max(
       kMinConnectTimeout, default_cmd_ctls.GetDefaultCmdCtl().execute));
   conn->pimpl_ = std::make_unique<ConnectionImpl>(
       bg_task_processor, bg_task_storage, id, settings, default_cmd_ctls,
-      testsuite_pg_ctl, ei_settings, std::move(size_lock));
+      testsuite_pg_ctl, ei_settings, std::move(size_lock), descriptions);
   if (resolver) {
     try {
       conn->pimpl_->AsyncConnect(ResolveDsnHostaddrs(dsn, *resolver, deadline),
@@ -91,6 +91,10 @@ Connection::Statistics Connection::GetStatsAndReset() {
   return pimpl_->GetStatsAndReset();
 }
 
+std::chrono::microseconds Connection::GetLastPrepareDuration() const {
+  return pimpl_->GetLastPrepareDuration();
+}
+
 void Connection::Begin(const TransactionOptions& options,
                        SteadyClock::time_point trx_start_time,
                        OptionalCommandControl trx_cmd_ctl) {
@@ -139,6 +143,28 @@ ResultSet Connection::PortalExecute(StatementId statement_id,
                                std::move(statement_cmd_ctl));
 }
 
+void Connection::ExecutePipelined(std::vector<PipelinedStatement>& statements,
+                                  OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->ExecutePipelined(statements, std::move(statement_cmd_ctl));
+}
+
+void Connection::CopyStart(const Query& query,
+                           OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyStart(query, std::move(statement_cmd_ctl));
+}
+
+void Connection::CopyPutData(std::string_view data) {
+  pimpl_->CopyPutData(data);
+}
+
+ResultSet Connection::CopyPutEnd() { return pimpl_->CopyPutEnd(); }
+
+bool Connection::CopyGetData(std::string& data) {
+  return pimpl_->CopyGetData(data);
+}
+
+void Connection::CopyAbort() { pimpl_->CopyAbort(); }
+
 void Connection::CancelAndCleanup(TimeoutDuration timeout) {
   pimpl_->CancelAndCleanup(timeout);
 }
@@ -178,6 +204,12 @@ TimeoutDuration Connection::GetIdleDuration() const {
 
 void Connection::Ping() { pimpl_->Ping(); }
 
+void Connection::Prepare(const std::string& statement,
+                         const std::vector<Oid>& param_types,
+                         engine::Deadline deadline) {
+  pimpl_->Prepare(statement, param_types, deadline);
+}
+
 void Connection::MarkAsBroken() { pimpl_->MarkAsBroken(); }
 
 OptionalCommandControl Connection::GetQueryCmdCtl(
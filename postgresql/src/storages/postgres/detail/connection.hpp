@@ -2,7 +2,10 @@
 
 #include <atomic>
 #include <chrono>
+#include <exception>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/concurrent/background_task_storage_fwd.hpp>
@@ -38,6 +41,7 @@ enum class ConnectionState {
 namespace detail {
 
 class ConnectionImpl;
+class StatementDescriptions;
 
 /// @brief PostreSQL connection class
 /// Handles connecting to Postgres, sending commands, processing command results
@@ -113,6 +117,16 @@ class Connection {
   using SizeGuard =
       USERVER_NAMESPACE::utils::SizeGuard<std::shared_ptr<std::atomic<size_t>>>;
 
+  /// @brief A statement of a batch for ExecutePipelined
+  struct PipelinedStatement {
+    const Query* query{nullptr};
+    QueryParameters params;
+    /// Result of the statement, valid if `error` is not set
+    ResultSet result{nullptr};
+    /// Error reported by the server for the statement
+    std::exception_ptr error;
+  };
+
   Connection(const Connection&) = delete;
   Connection(Connection&&) = delete;
   ~Connection();
@@ -130,6 +144,8 @@ class Connection {
   /// @param testsuite_pg_ctl operation parameters customizer for testsuite
   /// @param ei_settings error injection settings
   /// @param size_guard structure to track the size of owning connection pool
+  /// @param descriptions prepared statements descriptions shared with other
+  ///                     connections of the pool, may be nullptr
   /// @throws ConnectionFailed, ConnectionTimeoutError
   // clang-format on
   static std::unique_ptr<Connection> Connect(
@@ -140,7 +156,8 @@ class Connection {
       const DefaultCommandControls& default_cmd_ctls,
       const testsuite::PostgresControl& testsuite_pg_ctl,
       const error_injection::Settings& ei_settings,
-      engine::SemaphoreLock&& size_lock = engine::SemaphoreLock{});
+      engine::SemaphoreLock&& size_lock = engine::SemaphoreLock{},
+      StatementDescriptions* descriptions = nullptr);
 
   /// Close the connection
   /// TODO When called from another thread/coroutine will wait for current
@@ -180,6 +197,10 @@ class Connection {
   /// @note May only be called when connection is not in transaction
   Statistics GetStatsAndReset();
 
+  /// Time spent to prepare the statement of the last Execute, zero if the
+  /// statement was already prepared on this connection
+  std::chrono::microseconds GetLastPrepareDuration() const;
+
   //@{
   /// Begin a transaction in Postgres with specific start time point
   /// Suspends coroutine for execution
@@ -234,6 +255,25 @@ class Connection {
   ResultSet PortalExecute(StatementId, const std::string& portal_name,
                           std::uint32_t n_rows, OptionalCommandControl);
 
+  /// Execute independent statements in a single round trip using the
+  /// pipeline mode, each statement fails separately.
+  /// Throws if the batch as a whole could not be executed, e.g. on network
+  /// errors and timeouts.
+  void ExecutePipelined(std::vector<PipelinedStatement>& statements,
+                        OptionalCommandControl statement_cmd_ctl);
+
+  /// Start a binary `COPY ... FROM STDIN` or `COPY ... TO STDOUT`, the
+  /// connection is busy until the COPY is finished or aborted
+  void CopyStart(const Query& query, OptionalCommandControl);
+  /// Send a chunk of COPY FROM data
+  void CopyPutData(std::string_view data);
+  /// Finish COPY FROM and wait for its result
+  ResultSet CopyPutEnd();
+  /// Receive a chunk of COPY TO data, returns false after the last one
+  bool CopyGetData(std::string& data);
+  /// Abort the COPY in progress, if any
+  void CopyAbort();
+
   /// Send cancel to the database backend
   /// Try to return connection to idle state discarding all results.
   /// If there is a transaction in progress - roll it back.
@@ -272,6 +312,11 @@ class Connection {
   /// The function will do a query roundtrip to the database
   void Ping();
 
+  /// Prepare the statement without executing it, e.g. to warm up a new
+  /// connection. Only the parameter types are used.
+  void Prepare(const std::string& statement,
+               const std::vector<Oid>& param_types, engine::Deadline deadline);
+
   void MarkAsBroken();
 
   OptionalCommandControl GetQueryCmdCtl(
@@ -14,6 +14,7 @@
 #include <userver/utils/text_light.hpp>
 #include <userver/utils/uuid4.hpp>
 
+#include <storages/postgres/detail/statement_descriptions.hpp>
 #include <storages/postgres/detail/tracing_tags.hpp>
 #include <storages/postgres/io/pg_type_parsers.hpp>
 #include <userver/storages/postgres/exceptions.hpp>
@@ -47,6 +48,21 @@ std::size_t QueryHash(const std::string& statement,
   return res;
 }
 
+// The parameter types without values, enough to prepare a statement
+class ParamTypesHolder {
+ public:
+  explicit ParamTypesHolder(const std::vector<Oid>& types) : types_(types) {}
+
+  std::size_t Size() const { return types_.size(); }
+  const Oid* ParamTypesBuffer() const { return types_.data(); }
+  const char* const* ParamBuffers() const { return nullptr; }
+  const int* ParamLengthsBuffer() const { return nullptr; }
+  const int* ParamFormatsBuffer() const { return nullptr; }
+
+ private:
+  const std::vector<Oid>& types_;
+};
+
 class CountExecute {
  public:
   CountExecute(Connection::Statistics& stats) : stats_(stats) {
@@ -181,11 +197,12 @@ ConnectionImpl::ConnectionImpl(
     ConnectionSettings settings, const DefaultCommandControls& default_cmd_ctls,
     const testsuite::PostgresControl& testsuite_pg_ctl,
     const error_injection::Settings& ei_settings,
-    engine::SemaphoreLock&& size_lock)
+    engine::SemaphoreLock&& size_lock, StatementDescriptions* descriptions)
     : uuid_{USERVER_NAMESPACE::utils::generators::GenerateUuid()},
       conn_wrapper_{bg_task_processor, bg_task_storage, id,
                     std::move(size_lock)},
       prepared_{settings.max_prepared_cache_size},
+      shared_descriptions_{descriptions},
       settings_{settings},
       default_cmd_ctls_(default_cmd_ctls),
       testsuite_pg_ctl_{testsuite_pg_ctl},
@@ -349,6 +366,7 @@ ResultSet ConnectionImpl::ExecuteCommand(
     const Query& query, const QueryParameters& params,
     OptionalCommandControl statement_cmd_ctl) {
   CheckBusy();
+  last_prepare_duration_ = {};
 
   auto pipeline_guard = std::optional<ScopeGuard>{};
   if (IsPipelineActive() &&
@@ -497,6 +515,181 @@ ResultSet ConnectionImpl::PortalExecute(
                     count_execute, span, scope, &prepared_info->description);
 }
 
+void ConnectionImpl::ExecutePipelined(
+    std::vector<Connection::PipelinedStatement>& statements,
+    OptionalCommandControl statement_cmd_ctl) {
+  if (statements.empty()) return;
+  CheckBusy();
+  const auto network_timeout = ExecuteTimeout(statement_cmd_ctl);
+  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout);
+#if LIBPQ_HAS_PIPELINING
+  const bool exit_pipeline = !IsPipelineActive();
+  if (exit_pipeline) conn_wrapper_.EnterPipelineMode();
+  ScopeGuard pipeline_guard{[this, exit_pipeline] {
+    if (!exit_pipeline) return;
+    try {
+      if (conn_wrapper_.IsSyncingPipeline()) {
+        throw LogicError{"Pipeline has unread results"};
+      }
+      conn_wrapper_.ExitPipelineMode();
+    } catch (const std::exception& e) {
+      LOG_LIMITED_WARNING() << "Failed to leave pipeline mode: " << e;
+      MarkAsBroken();
+    }
+  }};
+
+  // In pipeline mode the statement timeout is sent without waiting and is
+  // applied to the whole batch
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+  CheckDeadlineReached(deadline);
+
+  tracing::Span span{scopes::kPipelineBatch};
+  conn_wrapper_.FillSpanTags(span, {network_timeout, GetStatementTimeout()});
+  span.AddTag("pipeline_batch_size", statements.size());
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  for (std::size_t i = 0; i < statements.size(); ++i) {
+    conn_wrapper_.SendQuery(statements[i].query->Statement(),
+                            statements[i].params, scope);
+    // Each statement gets its own pipeline segment, so that an error does not
+    // abort the rest of the batch. The last segment is synced by the Flush.
+    if (i + 1 < statements.size()) conn_wrapper_.PipelineSync();
+  }
+  scope.Reset(scopes::kLibpqWaitResult);
+  conn_wrapper_.Flush(deadline);
+
+  for (auto& statement : statements) {
+    CountExecute count_execute(stats_);
+    try {
+      statement.result = conn_wrapper_.WaitPipelineResult(deadline);
+      if (!statement.result.IsEmpty()) FillBufferCategories(statement.result);
+      count_execute.AccountResult(statement.result);
+    } catch (const ServerLogicError&) {
+      statement.error = std::current_exception();
+    } catch (const ServerRuntimeError&) {
+      statement.error = std::current_exception();
+    } catch (const ConnectionTimeoutError& e) {
+      ++stats_.execute_timeout;
+      LOG_LIMITED_WARNING() << "Pipelined batch of " << statements.size()
+                            << " statements network timeout error: " << e
+                            << ". Network timeout was "
+                            << network_timeout.count() << "ms";
+      span.AddTag(tracing::kErrorFlag, true);
+      throw;
+    } catch (const std::exception&) {
+      span.AddTag(tracing::kErrorFlag, true);
+      throw;
+    }
+  }
+#else
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+  for (auto& statement : statements) {
+    try {
+      statement.result =
+          ExecuteCommandNoPrepare(*statement.query, statement.params, deadline);
+    } catch (const ServerLogicError&) {
+      statement.error = std::current_exception();
+    } catch (const ServerRuntimeError&) {
+      statement.error = std::current_exception();
+    }
+  }
+#endif
+}
+
+void ConnectionImpl::CopyStart(const Query& query,
+                               OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  copy_network_timeout_ = ExecuteTimeout(statement_cmd_ctl);
+  auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(copy_network_timeout_);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+
+  CheckDeadlineReached(deadline);
+  auto span =
+      MakeQuerySpan(query, {copy_network_timeout_, GetStatementTimeout()});
+  auto scope = span.CreateScopeTime();
+  if (IsPipelineActive()) {
+    // COPY is not allowed in pipeline mode, the queued commands are waited for
+    // and the connection returns to pipeline mode after the COPY is finished
+    conn_wrapper_.WaitResult(deadline, scope);
+    conn_wrapper_.ExitPipelineMode();
+    copy_exited_pipeline_ = true;
+  }
+
+  copy_statement_ = query.Statement();
+  try {
+    is_copy_in_ = conn_wrapper_.StartCopy(copy_statement_, deadline, scope);
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    FinishCopy();
+    throw;
+  }
+}
+
+void ConnectionImpl::CopyPutData(std::string_view data) {
+  conn_wrapper_.PutCopyData(
+      data, testsuite_pg_ctl_.MakeExecuteDeadline(copy_network_timeout_));
+}
+
+ResultSet ConnectionImpl::CopyPutEnd() {
+  conn_wrapper_.PutCopyEnd(
+      nullptr, testsuite_pg_ctl_.MakeExecuteDeadline(copy_network_timeout_));
+  return WaitCopyResult();
+}
+
+bool ConnectionImpl::CopyGetData(std::string& data) {
+  if (conn_wrapper_.GetCopyData(
+          data, testsuite_pg_ctl_.MakeExecuteDeadline(copy_network_timeout_))) {
+    return true;
+  }
+  WaitCopyResult();
+  return false;
+}
+
+void ConnectionImpl::CopyAbort() {
+  if (copy_statement_.empty()) return;
+  try {
+    if (!is_copy_in_) {
+      // The rest of COPY TO data is not worth reading
+      LOG_LIMITED_INFO() << "COPY `" << copy_statement_
+                         << "` was not read to the end, closing connection";
+      MarkAsBroken();
+    } else if (GetConnectionState() == ConnectionState::kTranActive) {
+      conn_wrapper_.PutCopyEnd(
+          "COPY aborted by the client",
+          testsuite_pg_ctl_.MakeExecuteDeadline(copy_network_timeout_));
+      WaitCopyResult();
+    }
+  } catch (const QueryCancelled&) {
+    // Expected result of the aborted COPY FROM
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to abort COPY `" << copy_statement_
+                          << "`: " << e;
+    MarkAsBroken();
+  }
+  FinishCopy();
+}
+
+ResultSet ConnectionImpl::WaitCopyResult() {
+  tracing::Span span{scopes::kQuery};
+  conn_wrapper_.FillSpanTags(span,
+                             {copy_network_timeout_, GetStatementTimeout()});
+  span.AddTag(tracing::kDatabaseStatement, copy_statement_);
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  CountExecute count_execute(stats_);
+  ScopeGuard copy_guard{[this] { FinishCopy(); }};
+  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(copy_network_timeout_);
+  return WaitResult(copy_statement_, deadline, copy_network_timeout_,
+                    count_execute, span, scope, nullptr);
+}
+
+void ConnectionImpl::FinishCopy() {
+  copy_statement_.clear();
+  is_copy_in_ = false;
+  if (std::exchange(copy_exited_pipeline_, false)) {
+    conn_wrapper_.EnterPipelineMode();
+  }
+}
+
 void ConnectionImpl::Listen(std::string_view channel,
                             OptionalCommandControl cmd_ctl) {
   ExecuteCommandNoPrepare(
@@ -599,6 +792,24 @@ void ConnectionImpl::Ping() {
   Finish();
 }
 
+void ConnectionImpl::Prepare(const std::string& statement,
+                             const std::vector<Oid>& param_types,
+                             engine::Deadline deadline) {
+  if (settings_.prepared_statements ==
+      ConnectionSettings::kNoPreparedStatements) {
+    return;
+  }
+
+  ParamTypesHolder holder{param_types};
+  const QueryParameters params{holder};
+  auto span = MakeQuerySpan(
+      Query{statement},
+      {std::chrono::duration_cast<TimeoutDuration>(deadline.TimeLeft()),
+       GetStatementTimeout()});
+  auto scope = span.CreateScopeTime();
+  PrepareStatement(statement, params, deadline, span, scope);
+}
+
 void ConnectionImpl::MarkAsBroken() { conn_wrapper_.MarkAsBroken(); }
 
 void ConnectionImpl::CheckBusy() const {
@@ -696,7 +907,8 @@ void ConnectionImpl::SetStatementTimeout(OptionalCommandControl cmd_ctl) {
 
 const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
     const std::string& statement, const QueryParameters& params,
-    engine::Deadline deadline, tracing::Span& span, tracing::ScopeTime& scope) {
+    engine::Deadline deadline, tracing::Span& span, tracing::ScopeTime& scope,
+    bool* is_prepare_deferred) {
   auto query_hash = QueryHash(statement, params);
   Connection::StatementId query_id{query_hash};
 
@@ -715,12 +927,24 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
       DiscardPreparedStatement(*statement_info, deadline);
       prepared_.Erase(statement_info->id);
     }
+    // Another connection of the pool might have already described the
+    // statement
+    auto description = shared_descriptions_
+                           ? shared_descriptions_->Get(query_id, statement)
+                           : std::nullopt;
     scope.Reset(scopes::kPrepare);
     LOG_TRACE() << "Query " << statement << " is not yet prepared";
     conn_wrapper_.SendPrepare(statement_name, statement, params, scope);
     // Mark the statement prepared as soon as the send works correctly
-    prepared_.Put(query_id,
-                  {query_id, statement, statement_name, ResultSet{nullptr}});
+    prepared_.Put(query_id, {query_id, statement, statement_name,
+                             description.value_or(ResultSet{nullptr})});
+    if (description && is_prepare_deferred && IsPipelineActive()) {
+      // The result of the prepare is read together with the result of the
+      // first execution
+      *is_prepare_deferred = true;
+      ++stats_.parse_total;
+      return *prepared_.Get(query_id);
+    }
     try {
       conn_wrapper_.WaitResult(deadline, scope);
     } catch (const DuplicatePreparedStatement& e) {
@@ -737,8 +961,13 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
       throw;
     }
 
-    conn_wrapper_.SendDescribePrepared(statement_name, scope);
     statement_info = prepared_.Get(query_id);
+    if (description) {
+      ++stats_.parse_total;
+      return *statement_info;
+    }
+
+    conn_wrapper_.SendDescribePrepared(statement_name, scope);
     auto res = conn_wrapper_.WaitResult(deadline, scope);
     if (!res.pimpl_) {
       throw CommandError("WaitResult() returned nullptr");
@@ -747,6 +976,9 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
     statement_info->description = res;
     // Ensure we've got binary format established
     res.GetRowDescription().CheckBinaryFormat(db_types_);
+    if (shared_descriptions_) {
+      shared_descriptions_->Put(query_id, statement, params, res);
+    }
     ++stats_.parse_total;
     return *statement_info;
   }
@@ -805,13 +1037,44 @@ ResultSet ConnectionImpl::ExecuteCommand(const Query& query,
   auto scope = span.CreateScopeTime();
   CountExecute count_execute(stats_);
 
-  auto const& prepared_info =
-      PrepareStatement(statement, params, deadline, span, scope);
+  bool is_prepare_deferred = false;
+  const auto parse_total = stats_.parse_total;
+  const auto prepare_start = SteadyClock::now();
+  auto const& prepared_info = PrepareStatement(
+      statement, params, deadline, span, scope, &is_prepare_deferred);
+  // A deferred prepare is waited for along with the execution
+  if (stats_.parse_total != parse_total && !is_prepare_deferred) {
+    last_prepare_duration_ =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            SteadyClock::now() - prepare_start);
+  }
 
   scope.Reset(scopes::kExec);
   conn_wrapper_.SendPreparedQuery(prepared_info.statement_name, params, scope);
-  return WaitResult(statement, deadline, network_timeout, count_execute, span,
-                    scope, &prepared_info.description);
+  if (!is_prepare_deferred) {
+    return WaitResult(statement, deadline, network_timeout, count_execute,
+                      span, scope, &prepared_info.description);
+  }
+
+  const auto statement_id = prepared_info.id;
+  try {
+    return WaitResult(statement, deadline, network_timeout, count_execute,
+                      span, scope, &prepared_info.description);
+  } catch (const DuplicatePreparedStatement&) {
+    // See PrepareStatement, the statement is there, but the execution within
+    // the aborted pipeline was skipped
+    ++stats_.duplicate_prepared_statements;
+    scope.Reset(scopes::kExec);
+    conn_wrapper_.SendPreparedQuery(prepared_info.statement_name, params,
+                                    scope);
+    return WaitResult(statement, deadline, network_timeout, count_execute,
+                      span, scope, &prepared_info.description);
+  } catch (const std::exception&) {
+    // We don't know whether the statement was prepared, it is prepared again
+    // on the next use
+    prepared_.Erase(statement_id);
+    throw;
+  }
 }
 
 ResultSet ConnectionImpl::ExecuteCommandNoPrepare(const Query& query,
@@ -959,6 +1222,7 @@ ResultSet ConnectionImpl::WaitResult(const std::string& statement,
           << "Scheduling prepared statements invalidation due to "
              "cached plan change";
       is_discard_prepared_pending_ = true;
+      if (shared_descriptions_) shared_descriptions_->Clear();
     }
     span.AddTag(tracing::kErrorFlag, true);
     throw;
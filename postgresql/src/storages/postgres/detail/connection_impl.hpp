@@ -5,6 +5,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/cache/lru_map.hpp>
 #include <userver/concurrent/background_task_storage_fwd.hpp>
@@ -36,7 +37,8 @@ class ConnectionImpl {
                  const DefaultCommandControls& default_cmd_ctls,
                  const testsuite::PostgresControl& testsuite_pg_ctl,
                  const error_injection::Settings& ei_settings,
-                 engine::SemaphoreLock&& size_lock);
+                 engine::SemaphoreLock&& size_lock,
+                 StatementDescriptions* descriptions);
 
   void AsyncConnect(const Dsn& dsn, engine::Deadline deadline);
   void Close();
@@ -64,6 +66,9 @@ class ConnectionImpl {
       const std::optional<Query::Name>& query_name) const;
 
   Connection::Statistics GetStatsAndReset();
+  std::chrono::microseconds GetLastPrepareDuration() const {
+    return last_prepare_duration_;
+  }
 
   ResultSet ExecuteCommand(const Query& query,
                            const detail::QueryParameters& params,
@@ -87,6 +92,15 @@ class ConnectionImpl {
                           const std::string& portal_name, std::uint32_t n_rows,
                           OptionalCommandControl statement_cmd_ctl);
 
+  void ExecutePipelined(std::vector<Connection::PipelinedStatement>& statements,
+                        OptionalCommandControl statement_cmd_ctl);
+
+  void CopyStart(const Query& query, OptionalCommandControl statement_cmd_ctl);
+  void CopyPutData(std::string_view data);
+  ResultSet CopyPutEnd();
+  bool CopyGetData(std::string& data);
+  void CopyAbort();
+
   void Listen(std::string_view channel, OptionalCommandControl);
   void Unlisten(std::string_view channel, OptionalCommandControl);
   Notification WaitNotify(engine::Deadline deadline);
@@ -104,6 +118,8 @@ class ConnectionImpl {
   TimeoutDuration GetStatementTimeout() const;
 
   void Ping();
+  void Prepare(const std::string& statement,
+               const std::vector<Oid>& param_types, engine::Deadline deadline);
   void MarkAsBroken();
 
  private:
@@ -137,10 +153,12 @@ class ConnectionImpl {
 
   void SetStatementTimeout(OptionalCommandControl cmd_ctl);
 
+  /// If `is_prepare_deferred` is not nullptr, the result of the prepare may be
+  /// left unread in pipeline mode, it is then read with the next query result
   const PreparedStatementInfo& PrepareStatement(
       const std::string& statement, const detail::QueryParameters& params,
       engine::Deadline deadline, tracing::Span& span,
-      tracing::ScopeTime& scope);
+      tracing::ScopeTime& scope, bool* is_prepare_deferred = nullptr);
   void DiscardOldPreparedStatements(engine::Deadline deadline);
   void DiscardPreparedStatement(const PreparedStatementInfo& info,
                                 engine::Deadline deadline);
@@ -178,10 +196,15 @@ class ConnectionImpl {
 
   void Cancel();
 
+  ResultSet WaitCopyResult();
+  void FinishCopy();
+
   const std::string uuid_;
   Connection::Statistics stats_;
+  std::chrono::microseconds last_prepare_duration_{};
   PGConnectionWrapper conn_wrapper_;
   PreparedStatements prepared_;
+  StatementDescriptions* const shared_descriptions_;
   UserTypes db_types_;
   bool is_in_recovery_ = true;
   bool is_read_only_ = true;
@@ -194,6 +217,11 @@ class ConnectionImpl {
   testsuite::PostgresControl testsuite_pg_ctl_;
   OptionalCommandControl transaction_cmd_ctl_;
   TimeoutDuration current_statement_timeout_{};
+  // State of the COPY in progress
+  std::string copy_statement_;
+  TimeoutDuration copy_network_timeout_{};
+  bool is_copy_in_ = false;
+  bool copy_exited_pipeline_ = false;
   const error_injection::Settings ei_settings_;
 };
 
@@ -28,7 +28,7 @@ ResultSet NonTransaction::Execute(OptionalCommandControl statement_cmd_ctl,
 ResultSet NonTransaction::DoExecute(const Query& query,
                                     const detail::QueryParameters& params,
                                     OptionalCommandControl statement_cmd_ctl) {
-  StatementTimer timer{query, conn_};
+  StatementTimer timer{query, params, conn_};
   auto res = conn_->Execute(query, params, statement_cmd_ctl);
   timer.Account();
   return res;
@@ -0,0 +1,38 @@
+#include <storages/postgres/detail/owned_query_parameters.hpp>
+
+#include <cstring>
+
+#include <userver/storages/postgres/io/traits.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+OwnedQueryParameters::OwnedQueryParameters(const QueryParameters& params)
+    : types_(params.ParamTypesBuffer(),
+             params.ParamTypesBuffer() + params.Size()),
+      lengths_(params.ParamLengthsBuffer(),
+               params.ParamLengthsBuffer() + params.Size()),
+      formats_(params.ParamFormatsBuffer(),
+               params.ParamFormatsBuffer() + params.Size()) {
+  values_.reserve(params.Size());
+  buffers_.reserve(params.Size());
+  for (std::size_t i = 0; i < params.Size(); ++i) {
+    const char* value = params.ParamBuffers()[i];
+    if (!value) {
+      values_.emplace_back();
+      continue;
+    }
+    const auto length = formats_[i] == io::kPgBinaryDataFormat
+                            ? static_cast<std::size_t>(lengths_[i])
+                            : std::strlen(value) + 1;
+    values_.emplace_back(value, length);
+  }
+  for (std::size_t i = 0; i < params.Size(); ++i) {
+    buffers_.push_back(params.ParamBuffers()[i] ? values_[i].data() : nullptr);
+  }
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
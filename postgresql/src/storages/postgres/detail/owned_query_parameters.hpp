@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// Copy of the query parameters that outlives the caller, e.g. if the caller
+/// has timed out while its statement is still in a batch
+class OwnedQueryParameters final {
+ public:
+  explicit OwnedQueryParameters(const QueryParameters& params);
+
+  OwnedQueryParameters(const OwnedQueryParameters&) = delete;
+  OwnedQueryParameters& operator=(const OwnedQueryParameters&) = delete;
+
+  std::size_t Size() const { return types_.size(); }
+  const char* const* ParamBuffers() const { return buffers_.data(); }
+  const Oid* ParamTypesBuffer() const { return types_.data(); }
+  const int* ParamLengthsBuffer() const { return lengths_.data(); }
+  const int* ParamFormatsBuffer() const { return formats_.data(); }
+
+ private:
+  std::vector<Oid> types_;
+  std::vector<int> lengths_;
+  std::vector<int> formats_;
+  std::vector<std::string> values_;
+  std::vector<const char*> buffers_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -552,6 +552,182 @@ ResultSet PGConnectionWrapper::WaitResult(Deadline deadline,
   return MakeResult(std::move(handle));
 }
 
+void PGConnectionWrapper::PipelineSync() {
+#if LIBPQ_HAS_PIPELINING
+  CheckError<CommandError>("PQpipelineSync", PQpipelineSync(conn_));
+  ++pipeline_sync_counter_;
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+#endif
+}
+
+ResultSet PGConnectionWrapper::WaitPipelineResult(Deadline deadline) {
+  auto handle = MakeResultHandle(nullptr);
+#if LIBPQ_HAS_PIPELINING
+  auto null_res_counter{0};
+  while (IsSyncingPipeline() && PQstatus(conn_) != CONNECTION_BAD) {
+    auto* pg_res = ReadResult(deadline);
+    if (!pg_res) {
+      // Same issue as with WaitResult
+      if (++null_res_counter > 2) {
+        MarkAsBroken();
+        throw RuntimeError{"Pipeline out of sync"};
+      }
+      continue;
+    }
+    null_res_counter = 0;
+    auto next_handle = MakeResultHandle(pg_res);
+    const auto status = PQresultStatus(pg_res);
+    if (status == PGRES_PIPELINE_SYNC) {
+      HandlePipelineSync();
+      break;
+    }
+    if (status != PGRES_PIPELINE_ABORTED) handle = std::move(next_handle);
+  }
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+#endif
+  return MakeResult(std::move(handle));
+}
+
+bool PGConnectionWrapper::StartCopy(const std::string& statement,
+                                    Deadline deadline,
+                                    tracing::ScopeTime& scope) {
+  SendQuery(statement, scope);
+  scope.Reset(scopes::kLibpqWaitResult);
+  Flush(deadline);
+  auto handle = MakeResultHandle(ReadResult(deadline));
+  const auto status =
+      handle ? PQresultStatus(handle.get()) : PGRES_EMPTY_QUERY;
+  if (status == PGRES_COPY_IN || status == PGRES_COPY_OUT) {
+    if (PQbinaryTuples(handle.get())) return status == PGRES_COPY_IN;
+    // Leave the COPY mode before reporting the error
+    if (status == PGRES_COPY_IN) {
+      PutCopyEnd("binary format is required", deadline);
+    } else {
+      std::string data;
+      while (GetCopyData(data, deadline)) {
+      }
+    }
+    DiscardInput(deadline);
+    throw LogicError{"COPY statement must use `(FORMAT binary)`"};
+  }
+
+  // An error or a statement other than COPY
+  DiscardInput(deadline);
+  MakeResult(std::move(handle));
+  throw LogicError{"Statement is not a COPY FROM STDIN or COPY TO STDOUT"};
+}
+
+void PGConnectionWrapper::PutCopyData(std::string_view data,
+                                      Deadline deadline) {
+  // Zero means that libpq buffers are full, they are emptied by Flush
+  while (true) {
+    const int res =
+        PQputCopyData(conn_, data.data(), static_cast<int>(data.size()));
+    if (res > 0) break;
+    if (res < 0) {
+      HandleSocketPostClose();
+      throw CommandError(PQerrorMessage(conn_));
+    }
+    Flush(deadline);
+  }
+  Flush(deadline);
+}
+
+void PGConnectionWrapper::PutCopyEnd(const char* error_message,
+                                     Deadline deadline) {
+  while (true) {
+    const int res = PQputCopyEnd(conn_, error_message);
+    if (res > 0) break;
+    if (res < 0) {
+      HandleSocketPostClose();
+      throw CommandError(PQerrorMessage(conn_));
+    }
+    Flush(deadline);
+  }
+  Flush(deadline);
+}
+
+bool PGConnectionWrapper::GetCopyData(std::string& data, Deadline deadline) {
+  while (true) {
+    char* buffer = nullptr;
+    const int res = PQgetCopyData(conn_, &buffer, /*async=*/1);
+    if (res > 0) {
+      const std::unique_ptr<char, decltype(&PQfreemem)> holder{buffer,
+                                                               &PQfreemem};
+      data.assign(buffer, res);
+      return true;
+    }
+    if (res == -1) return false;
+    if (res < -1) {
+      HandleSocketPostClose();
+      throw CommandError(PQerrorMessage(conn_));
+    }
+
+    // No complete row yet
+    if (!WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted("Task cancelled while receiving COPY data");
+      }
+      PGCW_LOG_LIMITED_WARNING()
+          << "Timeout while receiving COPY data from PostgreSQL connection";
+      throw ConnectionTimeoutError("Timed out while receiving COPY data");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+    UpdateLastUse();
+  }
+}
+
+void PGConnectionWrapper::StartCopyBoth(const std::string& statement,
+                                        Deadline deadline,
+                                        tracing::ScopeTime& scope) {
+  SendQuery(statement, scope);
+  scope.Reset(scopes::kLibpqWaitResult);
+  Flush(deadline);
+  auto handle = MakeResultHandle(ReadResult(deadline));
+  if (handle && PQresultStatus(handle.get()) == PGRES_COPY_BOTH) return;
+
+  DiscardInput(deadline);
+  MakeResult(std::move(handle));
+  throw LogicError{"Statement does not start a replication stream"};
+}
+
+bool PGConnectionWrapper::ReceiveCopyBothData(std::string& data,
+                                              Deadline deadline) {
+  while (true) {
+    char* buffer = nullptr;
+    const int res = PQgetCopyData(conn_, &buffer, /*async=*/1);
+    if (res > 0) {
+      const std::unique_ptr<char, decltype(&PQfreemem)> holder{buffer,
+                                                               &PQfreemem};
+      data.assign(buffer, res);
+      return true;
+    }
+    if (res == -1) {
+      // The result of the streaming command reports the error if any
+      auto handle = MakeResultHandle(ReadResult(deadline));
+      DiscardInput(deadline);
+      MakeResult(std::move(handle));
+      throw ConnectionError("Replication stream has been ended by the server");
+    }
+    if (res < -1) {
+      HandleSocketPostClose();
+      throw CommandError(PQerrorMessage(conn_));
+    }
+
+    if (!WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted(
+            "Task cancelled while receiving replication stream");
+      }
+      return false;
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+    UpdateLastUse();
+  }
+}
+
 Notification PGConnectionWrapper::WaitNotify(Deadline deadline) {
   auto notify = std::unique_ptr<PGnotify, decltype(&PQfreemem)>(
       PQnotifies(conn_), &PQfreemem);
@@ -107,6 +107,47 @@ class PGConnectionWrapper {
   /// Will return result or throw an exception
   ResultSet WaitResult(Deadline deadline, tracing::ScopeTime&);
 
+  /// @brief Wrapper for PQpipelineSync, ends a pipeline segment so that an
+  /// error in it does not abort the following ones
+  void PipelineSync();
+
+  /// @brief Send the buffered commands to the server, in pipeline mode the
+  /// last pipeline segment is synced
+  void Flush(Deadline deadline);
+
+  /// @brief Wait for the result of a single pipeline segment.
+  /// Will return result or throw an exception
+  ResultSet WaitPipelineResult(Deadline deadline);
+
+  /// @brief Send a COPY statement and wait for the server to enter the binary
+  /// COPY mode. Throws if the statement fails or is not a binary COPY.
+  /// Returns true for `COPY ... FROM STDIN` and false for `COPY ... TO STDOUT`.
+  bool StartCopy(const std::string& statement, Deadline deadline,
+                 tracing::ScopeTime&);
+
+  /// @brief Wrapper for PQputCopyData, sends the data to the server
+  void PutCopyData(std::string_view data, Deadline deadline);
+
+  /// @brief Wrapper for PQputCopyEnd, a non-null `error_message` makes the
+  /// COPY fail with the message
+  void PutCopyEnd(const char* error_message, Deadline deadline);
+
+  /// @brief Wrapper for PQgetCopyData, receives the next data row of COPY TO.
+  /// Returns false when the server has sent all the data, the result of the
+  /// COPY should be read with WaitResult then.
+  bool GetCopyData(std::string& data, Deadline deadline);
+
+  /// @brief Send a replication command that makes the server enter the
+  /// COPY BOTH mode, e.g. START_REPLICATION. Throws if the command fails.
+  void StartCopyBoth(const std::string& statement, Deadline deadline,
+                     tracing::ScopeTime&);
+
+  /// @brief Receive the next message of the COPY BOTH stream.
+  /// Returns false if nothing has been received before the deadline, throws
+  /// if the server has ended the stream. The messages are sent with
+  /// PutCopyData.
+  bool ReceiveCopyBothData(std::string& data, Deadline deadline);
+
   /// @brief Wait for notification
   Notification WaitNotify(Deadline deadline);
 
@@ -155,7 +196,6 @@ class PGConnectionWrapper {
   /// @return true if wait was successful, false if was awakened by the deadline
   [[nodiscard]] bool WaitSocketReadable(Deadline deadline);
 
-  void Flush(Deadline deadline);
 
   PGresult* ReadResult(Deadline deadline);
 
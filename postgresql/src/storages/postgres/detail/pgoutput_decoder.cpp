@@ -0,0 +1,265 @@
+#include <storages/postgres/detail/pgoutput_decoder.hpp>
+
+#include <cstring>
+
+#include <boost/endian/conversion.hpp>
+#include <fmt/format.h>
+
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+// 2000-01-01 00:00:00 UTC
+constexpr std::chrono::seconds kReplicationEpoch{946684800};
+
+// Big-endian fields of the protocol messages
+class MessageReader final {
+ public:
+  explicit MessageReader(std::string_view& message) : message_(message) {}
+
+  template <typename T>
+  T Read() {
+    T value;
+    std::memcpy(&value, Take(sizeof(T)).data(), sizeof(T));
+    return boost::endian::big_to_native(value);
+  }
+
+  char ReadByte() { return Take(1).front(); }
+
+  std::string_view ReadString() {
+    const auto end = message_.find('\0');
+    if (end == std::string_view::npos) {
+      throw ReplicationError("Unterminated string in replication message");
+    }
+    const auto result = message_.substr(0, end);
+    message_.remove_prefix(end + 1);
+    return result;
+  }
+
+  std::string_view Take(std::size_t size) {
+    if (message_.size() < size) {
+      throw ReplicationError("Replication message is truncated");
+    }
+    const auto result = message_.substr(0, size);
+    message_.remove_prefix(size);
+    return result;
+  }
+
+ private:
+  std::string_view& message_;
+};
+
+ReplicationTuple ReadTuple(MessageReader& reader) {
+  const auto size = reader.Read<std::int16_t>();
+  ReplicationTuple tuple(size);
+  for (auto& value : tuple) {
+    switch (reader.ReadByte()) {
+      case 'n':
+        value.kind = ReplicationValue::Kind::kNull;
+        break;
+      case 'u':
+        value.kind = ReplicationValue::Kind::kUnchanged;
+        break;
+      case 't': {
+        value.kind = ReplicationValue::Kind::kText;
+        const auto length = reader.Read<std::int32_t>();
+        if (length < 0) {
+          throw ReplicationError("Negative value length in replication tuple");
+        }
+        value.text = reader.Take(length);
+        break;
+      }
+      default:
+        throw ReplicationError("Unexpected value kind in replication tuple");
+    }
+  }
+  return tuple;
+}
+
+}  // namespace
+
+std::chrono::system_clock::time_point ReplicationTimeToTimePoint(
+    std::int64_t time) {
+  return std::chrono::system_clock::time_point{kReplicationEpoch} +
+         std::chrono::microseconds{time};
+}
+
+std::int64_t TimePointToReplicationTime(
+    std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             time.time_since_epoch() - kReplicationEpoch)
+      .count();
+}
+
+ReplicationMessage ParseReplicationMessage(std::string_view message) {
+  MessageReader reader{message};
+  ReplicationMessage result;
+  switch (reader.ReadByte()) {
+    case 'w':
+      result.kind = ReplicationMessage::Kind::kXLogData;
+      result.wal_start = reader.Read<Lsn>();
+      result.wal_end = reader.Read<Lsn>();
+      // Send time
+      reader.Take(sizeof(std::int64_t));
+      result.payload = message;
+      break;
+    case 'k':
+      result.kind = ReplicationMessage::Kind::kKeepalive;
+      result.wal_end = reader.Read<Lsn>();
+      reader.Take(sizeof(std::int64_t));
+      result.reply_requested = reader.ReadByte() != 0;
+      break;
+    default:
+      throw ReplicationError("Unexpected replication protocol message");
+  }
+  return result;
+}
+
+std::string MakeStandbyStatusUpdate(Lsn written, Lsn flushed,
+                                    std::chrono::system_clock::time_point now) {
+  std::string result;
+  result.reserve(1 + 4 * sizeof(std::int64_t) + 1);
+  const auto append = [&result](std::uint64_t value) {
+    value = boost::endian::native_to_big(value);
+    result.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  result.push_back('r');
+  append(written);
+  append(flushed);
+  // Applied, the subscribers apply the changes before confirming them
+  append(flushed);
+  append(TimePointToReplicationTime(now));
+  // Do not request a reply
+  result.push_back('\0');
+  return result;
+}
+
+std::optional<ReplicationTransaction> PgOutputDecoder::Decode(
+    std::string_view message) {
+  MessageReader reader{message};
+  const auto type = reader.ReadByte();
+  switch (type) {
+    case 'B': {
+      if (transaction_) {
+        throw ReplicationError("Nested transaction in replication stream");
+      }
+      auto& transaction = transaction_.emplace();
+      transaction.commit_lsn = reader.Read<Lsn>();
+      transaction.commit_time =
+          ReplicationTimeToTimePoint(reader.Read<std::int64_t>());
+      break;
+    }
+    case 'C': {
+      auto& transaction = GetTransaction();
+      [[maybe_unused]] const auto flags = reader.ReadByte();
+      transaction.commit_lsn = reader.Read<Lsn>();
+      transaction.end_lsn = reader.Read<Lsn>();
+      transaction.commit_time =
+          ReplicationTimeToTimePoint(reader.Read<std::int64_t>());
+      auto result = std::move(transaction_);
+      transaction_.reset();
+      return result;
+    }
+    case 'R':
+      DecodeRelation(message);
+      break;
+    case 'I':
+    case 'U':
+    case 'D':
+      DecodeChange(type, message);
+      break;
+    case 'T':
+      DecodeTruncate(message);
+      break;
+    case 'O':  // Origin
+    case 'Y':  // Type, the columns are sent in text format anyway
+    case 'M':  // Logical decoding message
+      break;
+    default:
+      throw ReplicationError(
+          fmt::format("Unexpected pgoutput message '{}'", type));
+  }
+  return std::nullopt;
+}
+
+void PgOutputDecoder::DecodeRelation(std::string_view& message) {
+  MessageReader reader{message};
+  auto relation = std::make_shared<ReplicationRelation>();
+  relation->oid = reader.Read<Oid>();
+  relation->schema = reader.ReadString();
+  relation->name = reader.ReadString();
+  [[maybe_unused]] const auto replica_identity = reader.ReadByte();
+
+  relation->columns.resize(reader.Read<std::int16_t>());
+  for (auto& column : relation->columns) {
+    column.is_key = (reader.ReadByte() & 1) != 0;
+    column.name = reader.ReadString();
+    column.type_oid = reader.Read<Oid>();
+    column.type_modifier = reader.Read<std::int32_t>();
+  }
+
+  // The changes already decoded keep the previous description
+  const auto oid = relation->oid;
+  relations_.insert_or_assign(oid, std::move(relation));
+}
+
+void PgOutputDecoder::DecodeChange(char type, std::string_view& message) {
+  MessageReader reader{message};
+  auto& transaction = GetTransaction();
+  auto& change = transaction.changes.emplace_back();
+  change.relation = GetRelation(reader.Read<Oid>());
+
+  auto tuple_type = reader.ReadByte();
+  if (tuple_type == 'K' || tuple_type == 'O') {
+    change.old_tuple = ReadTuple(reader);
+    if (type == 'D') {
+      change.kind = RowChange::Kind::kDelete;
+      return;
+    }
+    tuple_type = reader.ReadByte();
+  }
+  if (tuple_type != 'N' || type == 'D') {
+    throw ReplicationError("Unexpected tuple in replication message");
+  }
+  change.kind =
+      (type == 'I') ? RowChange::Kind::kInsert : RowChange::Kind::kUpdate;
+  change.new_tuple = ReadTuple(reader);
+}
+
+void PgOutputDecoder::DecodeTruncate(std::string_view& message) {
+  MessageReader reader{message};
+  auto& transaction = GetTransaction();
+  const auto count = reader.Read<std::int32_t>();
+  [[maybe_unused]] const auto options = reader.ReadByte();
+  for (std::int32_t i = 0; i < count; ++i) {
+    auto& change = transaction.changes.emplace_back();
+    change.kind = RowChange::Kind::kTruncate;
+    change.relation = GetRelation(reader.Read<Oid>());
+  }
+}
+
+std::shared_ptr<const ReplicationRelation> PgOutputDecoder::GetRelation(
+    Oid oid) const {
+  const auto it = relations_.find(oid);
+  if (it == relations_.end()) {
+    throw ReplicationError(
+        fmt::format("Change of relation {} before its description", oid));
+  }
+  return it->second;
+}
+
+ReplicationTransaction& PgOutputDecoder::GetTransaction() {
+  if (!transaction_) {
+    throw ReplicationError("Row change outside of a transaction");
+  }
+  return *transaction_;
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
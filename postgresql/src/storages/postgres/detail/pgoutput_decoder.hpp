@@ -0,0 +1,71 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <userver/storages/postgres/logical_replication.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// Time of the replication protocol, microseconds since 2000-01-01
+std::chrono::system_clock::time_point ReplicationTimeToTimePoint(
+    std::int64_t time);
+std::int64_t TimePointToReplicationTime(
+    std::chrono::system_clock::time_point time);
+
+/// Message of the streaming replication protocol sent by the server
+struct ReplicationMessage {
+  enum class Kind { kXLogData, kKeepalive };
+
+  Kind kind{Kind::kKeepalive};
+  Lsn wal_start{0};
+  Lsn wal_end{0};
+  /// The server asks for the standby status update (kKeepalive)
+  bool reply_requested{false};
+  /// The `pgoutput` message (kXLogData)
+  std::string_view payload;
+};
+
+/// @throws ReplicationError on malformed or unexpected messages
+ReplicationMessage ParseReplicationMessage(std::string_view message);
+
+/// Standby status update message, confirms receiving the WAL up to `written`
+/// and applying it up to `flushed`
+std::string MakeStandbyStatusUpdate(Lsn written, Lsn flushed,
+                                    std::chrono::system_clock::time_point now);
+
+/// @brief Decoder of the `pgoutput` logical decoding plugin messages,
+/// protocol version 1.
+///
+/// Accumulates the row changes of a transaction and keeps the descriptions of
+/// the relations, that are sent once per stream.
+class PgOutputDecoder final {
+ public:
+  /// Decodes the payload of the XLogData message.
+  /// @returns the transaction after its Commit message
+  /// @throws ReplicationError on malformed or unexpected messages
+  std::optional<ReplicationTransaction> Decode(std::string_view message);
+
+  /// A transaction has begun and has not been committed yet
+  bool IsInTransaction() const { return transaction_.has_value(); }
+
+ private:
+  void DecodeRelation(std::string_view& message);
+  void DecodeChange(char type, std::string_view& message);
+  void DecodeTruncate(std::string_view& message);
+
+  std::shared_ptr<const ReplicationRelation> GetRelation(Oid oid) const;
+  ReplicationTransaction& GetTransaction();
+
+  std::unordered_map<Oid, std::shared_ptr<const ReplicationRelation>>
+      relations_;
+  std::optional<ReplicationTransaction> transaction_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,126 @@
+#include <storages/postgres/detail/pipeline_batcher.hpp>
+
+#include <algorithm>
+#include <string>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+#include <storages/postgres/detail/owned_query_parameters.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+struct PipelineBatcher::Request {
+  Request(const Query& query, const QueryParameters& params)
+      : query{query}, params{params} {}
+
+  const Query query;
+  const OwnedQueryParameters params;
+  engine::Promise<ResultSet> promise;
+};
+
+struct PipelineBatcher::Batch {
+  explicit Batch(OptionalCommandControl cmd_ctl) : cmd_ctl{cmd_ctl} {}
+
+  const OptionalCommandControl cmd_ctl;
+  std::vector<std::shared_ptr<Request>> requests;
+  engine::SingleConsumerEvent full;
+};
+
+PipelineBatcher::PipelineBatcher(ExecuteBatchFunc execute_batch)
+    : execute_batch_{std::move(execute_batch)} {}
+
+PipelineBatcher::~PipelineBatcher() { CancelAndWait(); }
+
+void PipelineBatcher::CancelAndWait() noexcept { tasks_.CancelAndWait(); }
+
+ResultSet PipelineBatcher::Execute(const Query& query,
+                                   const QueryParameters& params,
+                                   OptionalCommandControl cmd_ctl,
+                                   engine::Deadline deadline,
+                                   std::chrono::microseconds window,
+                                   std::size_t max_batch_size) {
+  auto request = std::make_shared<Request>(query, params);
+  auto future = request->promise.get_future();
+  {
+    std::lock_guard lock{mutex_};
+    auto it = std::find_if(
+        open_batches_.begin(), open_batches_.end(),
+        [&cmd_ctl](const auto& batch) { return batch->cmd_ctl == cmd_ctl; });
+    if (it == open_batches_.end()) {
+      auto batch = std::make_shared<Batch>(cmd_ctl);
+      // Critical, as the other tasks wait for the batch
+      tasks_.Detach(engine::CriticalAsyncNoSpan([this, batch, window] {
+        RunBatch(*batch, window);
+      }));
+      it = open_batches_.insert(open_batches_.end(), std::move(batch));
+    }
+    auto& batch = **it;
+    batch.requests.push_back(std::move(request));
+    if (batch.requests.size() >= max_batch_size) {
+      batch.full.Send();
+      open_batches_.erase(it);
+    }
+  }
+
+  switch (future.wait_until(deadline)) {
+    case engine::FutureStatus::kReady:
+      return future.get();
+    case engine::FutureStatus::kTimeout:
+      throw ConnectionTimeoutError{"Timed out while waiting for a batch"};
+    case engine::FutureStatus::kCancelled:
+      throw ConnectionInterrupted{"Task cancelled while waiting for a batch"};
+  }
+  UINVARIANT(false, "Unexpected future status");
+}
+
+void PipelineBatcher::RunBatch(Batch& batch, std::chrono::microseconds window) {
+  [[maybe_unused]] const bool is_full = batch.full.WaitForEventFor(window);
+
+  std::vector<std::shared_ptr<Request>> requests;
+  {
+    std::lock_guard lock{mutex_};
+    CloseBatch(batch);
+    requests = std::move(batch.requests);
+  }
+
+  std::vector<Connection::PipelinedStatement> statements;
+  statements.reserve(requests.size());
+  for (const auto& request : requests) {
+    auto& statement = statements.emplace_back();
+    statement.query = &request->query;
+    statement.params = QueryParameters{request->params};
+  }
+
+  try {
+    execute_batch_(statements, batch.cmd_ctl);
+  } catch (const std::exception&) {
+    for (const auto& request : requests) {
+      request->promise.set_exception(std::current_exception());
+    }
+    return;
+  }
+
+  for (std::size_t i = 0; i < requests.size(); ++i) {
+    if (statements[i].error) {
+      requests[i]->promise.set_exception(statements[i].error);
+    } else {
+      requests[i]->promise.set_value(std::move(statements[i].result));
+    }
+  }
+}
+
+void PipelineBatcher::CloseBatch(const Batch& batch) {
+  const auto it = std::find_if(
+      open_batches_.begin(), open_batches_.end(),
+      [&batch](const auto& open_batch) { return open_batch.get() == &batch; });
+  if (it != open_batches_.end()) open_batches_.erase(it);
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// @brief Collects single statements from different tasks and executes them
+/// in batches, a batch takes a single connection and a single round trip.
+///
+/// The first statement of a batch waits for the batching window, the batch is
+/// sent earlier if it reaches the maximum size. Only the statements with the
+/// same command control get into the same batch.
+class PipelineBatcher final {
+ public:
+  /// Executes the batch and fills the results of the statements
+  using ExecuteBatchFunc = std::function<void(
+      std::vector<Connection::PipelinedStatement>&, OptionalCommandControl)>;
+
+  explicit PipelineBatcher(ExecuteBatchFunc execute_batch);
+  ~PipelineBatcher();
+
+  /// Cancels the batches in flight, their statements fail
+  void CancelAndWait() noexcept;
+
+  ResultSet Execute(const Query& query, const QueryParameters& params,
+                    OptionalCommandControl cmd_ctl, engine::Deadline deadline,
+                    std::chrono::microseconds window,
+                    std::size_t max_batch_size);
+
+ private:
+  struct Request;
+  struct Batch;
+
+  void RunBatch(Batch& batch, std::chrono::microseconds window);
+  void CloseBatch(const Batch& batch);
+
+  const ExecuteBatchFunc execute_batch_;
+  engine::Mutex mutex_;
+  std::vector<std::shared_ptr<Batch>> open_batches_;
+  concurrent::BackgroundTaskStorageCore tasks_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
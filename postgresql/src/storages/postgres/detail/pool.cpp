@@ -12,6 +12,7 @@
 #include <userver/storages/postgres/detail/time_types.hpp>
 #include <userver/storages/postgres/exceptions.hpp>
 #include <userver/utils/impl/userver_experiments.hpp>
+#include <userver/utils/scope_guard.hpp>
 
 #include <utils/impl/assert_extra.hpp>
 
@@ -82,6 +83,8 @@ ConnectionPool::ConnectionPool(
       db_name_{db_name},
       settings_{settings},
       conn_settings_{conn_settings},
+      descriptions_{std::max(std::size_t{1},
+                             conn_settings.max_prepared_cache_size)},
       bg_task_processor_{bg_task_processor},
       queue_{settings.max_size},
       size_semaphore_{settings.max_size},
@@ -102,13 +105,18 @@ ConnectionPool::ConnectionPool(
                      stats_.congestion_control, cc_config, config_source,
                      [](const dynamic_config::Snapshot& config) {
                        return config[kCcConfig];
-                     }) {
+                     }),
+      batcher_([this](std::vector<Connection::PipelinedStatement>& statements,
+                      OptionalCommandControl cmd_ctl) {
+        ExecuteBatch(statements, cmd_ctl);
+      }) {
   if (kCcExperiment.IsEnabled()) {
     cc_controller_.Start();
   }
 }
 
 ConnectionPool::~ConnectionPool() {
+  batcher_.CancelAndWait();
   StopMaintainTask();
   StopConnectTasks();
   Clear();
@@ -292,6 +300,11 @@ void ConnectionPool::Release(Connection* connection) {
   }
 }
 
+std::size_t ConnectionPool::GetInFlightApprox() const {
+  return stats_.connection.used.Load() +
+         wait_count_.load(std::memory_order_relaxed);
+}
+
 const InstanceStatistics& ConnectionPool::GetStatistics() const {
   auto settings = settings_.Read();
   stats_.connection.active = size_semaphore_.UsedApprox();
@@ -320,13 +333,41 @@ NonTransaction ConnectionPool::Start(OptionalCommandControl cmd_ctl) {
   return NonTransaction{std::move(conn), start_time};
 }
 
-NotifyScope ConnectionPool::Listen(std::string_view channel,
+ResultSet ConnectionPool::ExecuteBatched(const Query& query,
+                                         const QueryParameters& params,
+                                         OptionalCommandControl cmd_ctl) {
+  const auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl));
+  const auto [window, max_batch_size] = [this] {
+    const auto settings = settings_.Read();
+    return std::make_pair(settings->pipeline_batching_window,
+                          settings->pipeline_batch_max_size);
+  }();
+  return batcher_.Execute(query, params, cmd_ctl, deadline, window,
+                          max_batch_size);
+}
+
+void ConnectionPool::ExecuteBatch(
+    std::vector<Connection::PipelinedStatement>& statements,
+    OptionalCommandControl cmd_ctl) {
+  const auto start_time = detail::SteadyClock::now();
+  const auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl));
+  auto conn = Acquire(deadline);
+  UASSERT(conn);
+  conn->Start(start_time);
+  const USERVER_NAMESPACE::utils::ScopeGuard finish_guard{
+      [&conn] { conn->Finish(); }};
+  conn->ExecutePipelined(statements, cmd_ctl);
+}
+
+NotifyScope ConnectionPool::Listen(std::vector<std::string> channels,
                                    OptionalCommandControl cmd_ctl) {
   const auto deadline =
       testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl));
   auto conn = Acquire(deadline);
   UASSERT(conn);
-  return NotifyScope{std::move(conn), channel, cmd_ctl};
+  return NotifyScope{std::move(conn), std::move(channels), cmd_ctl};
 }
 
 TimeoutDuration ConnectionPool::GetExecuteTimeout(
@@ -371,6 +412,9 @@ void ConnectionPool::SetConnectionSettings(const ConnectionSettings& settings) {
     if (old_settings.RequiresConnectionReset(settings)) {
       writer->version = old_version + 1;
     }
+    if (settings.max_prepared_cache_size) {
+      descriptions_.SetMaxSize(settings.max_prepared_cache_size);
+    }
     writer.Commit();
   }
 }
@@ -380,6 +424,11 @@ void ConnectionPool::SetStatementMetricsSettings(
   sts_.SetSettings(settings);
 }
 
+void ConnectionPool::SetSlowQueryExplainer(
+    std::weak_ptr<SlowQueryExplainer> explainer) {
+  sts_.SetSlowQueryExplainer(std::move(explainer));
+}
+
 void ConnectionPool::SetMaxConnectionsCc(std::size_t max_connections) {
   cc_max_connections_ = max_connections;
 }
@@ -416,7 +465,7 @@ bool ConnectionPool::DoConnect(engine::SemaphoreLock size_lock) {
     connection = Connection::Connect(
         dsn_, resolver_, bg_task_processor_, close_task_storage_, conn_id,
         *conn_settings, default_cmd_ctls_, testsuite_pg_ctl_, ei_settings_,
-        std::move(size_lock));
+        std::move(size_lock), &descriptions_);
   } catch (const ConnectionTimeoutError&) {
     // No problem if it's connection error
     ++stats_.connection.error_timeout;
@@ -438,6 +487,8 @@ bool ConnectionPool::DoConnect(engine::SemaphoreLock size_lock) {
   }
   LOG_TRACE() << "PostgreSQL connection created";
 
+  WarmupPreparedStatements(*connection);
+
   // Clean up the statistics and not account it
   [[maybe_unused]] const auto& stats = connection->GetStatsAndReset();
 
@@ -461,6 +512,41 @@ void ConnectionPool::TryCreateConnectionAsync() {
   }
 }
 
+void ConnectionPool::WarmupPreparedStatements(Connection& connection) {
+  const auto count = [this] {
+    auto settings = settings_.Read();
+    return settings->prepare_warmup_size;
+  }();
+  if (!count) return;
+
+  const auto deadline = engine::Deadline::FromDuration(kConnectingTimeout);
+  for (const auto& hot : descriptions_.GetHot(count)) {
+    if (deadline.IsReached() || !connection.IsIdle()) break;
+    try {
+      connection.Prepare(hot.statement, hot.param_types, deadline);
+    } catch (const Error& e) {
+      LOG_LIMITED_WARNING() << "Failed to prepare a statement on a new "
+                               "connection: "
+                            << e;
+    }
+  }
+}
+
+std::size_t ConnectionPool::GetWantedSize(const PoolSettings& settings) const {
+  return std::min(settings.max_size,
+                  std::max(settings.min_size,
+                           GetInFlightApprox() + settings.spare_size));
+}
+
+void ConnectionPool::CheckSpareConnections() {
+  auto settings = settings_.Read();
+  if (!settings->spare_size) return;
+  // Connections being established are counted as spare ones
+  if (size_semaphore_.UsedApprox() < GetWantedSize(*settings)) {
+    TryCreateConnectionAsync();
+  }
+}
+
 void ConnectionPool::CheckMinPoolSizeUnderflow() {
   auto settings = settings_.Read();
   auto count = size_semaphore_.UsedApprox();
@@ -522,6 +608,7 @@ Connection* ConnectionPool::Pop(engine::Deadline deadline) {
       DropExpiredConnection(connection);
       continue;
     }
+    CheckSpareConnections();
     return connection;
   }
 
@@ -611,11 +698,14 @@ void ConnectionPool::DeleteBrokenConnection(Connection* connection) {
 void ConnectionPool::DropExpiredConnection(Connection* connection) {
   LOG_LIMITED_INFO() << "Dropping expired connection";
   DeleteConnection(connection);
+  // Replace it in background, so that the queries do not wait for it
+  TryCreateConnectionAsync();
 }
 
 void ConnectionPool::DropOutdatedConnection(Connection* connection) {
   LOG_LIMITED_INFO() << "Dropping connection with outdated settings";
   DeleteConnection(connection);
+  TryCreateConnectionAsync();
 }
 
 Connection* ConnectionPool::AcquireImmediate() {
@@ -662,7 +752,7 @@ void ConnectionPool::MaintainConnections() {
         break;
       }
       stale_connection = conn->GetIdleDuration() >= kMaxIdleDuration;
-      if (count > settings->min_size && drop_left > 0) {
+      if (count > GetWantedSize(*settings) && drop_left > 0) {
         --drop_left;
         --stats_.connection.used;
         LOG_DEBUG() << "Drop idle connection to `" << DsnCutPassword(dsn_)
@@ -688,6 +778,7 @@ void ConnectionPool::MaintainConnections() {
 
   // Check and maintain minimum count of connections
   CheckMinPoolSizeUnderflow();
+  CheckSpareConnections();
 }
 
 void ConnectionPool::StartMaintainTask() {
@@ -33,6 +33,8 @@
 
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/pg_impl_types.hpp>
+#include <storages/postgres/detail/pipeline_batcher.hpp>
+#include <storages/postgres/detail/statement_descriptions.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -72,12 +74,20 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   void Release(Connection* connection);
 
   const InstanceStatistics& GetStatistics() const;
+
+  /// Approximate number of the connections in use and of the waiters for them
+  std::size_t GetInFlightApprox() const;
   [[nodiscard]] Transaction Begin(const TransactionOptions& options,
                                   OptionalCommandControl trx_cmd_ctl = {});
 
   [[nodiscard]] NonTransaction Start(OptionalCommandControl cmd_ctl = {});
 
-  NotifyScope Listen(std::string_view channel,
+  /// Execute a single statement in a batch with the statements of other tasks,
+  /// see PoolSettings::pipeline_batching_window
+  ResultSet ExecuteBatched(const Query& query, const QueryParameters& params,
+                           OptionalCommandControl cmd_ctl = {});
+
+  NotifyScope Listen(std::vector<std::string> channels,
                      OptionalCommandControl cmd_ctl = {});
 
   CommandControl GetDefaultCommandControl() const;
@@ -88,6 +98,9 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
 
   void SetStatementMetricsSettings(const StatementMetricsSettings& settings);
 
+  /// @see StatementTimingsStorage::SetSlowQueryExplainer
+  void SetSlowQueryExplainer(std::weak_ptr<SlowQueryExplainer> explainer);
+
   const detail::StatementTimingsStorage& GetStatementTimingsStorage() const {
     return sts_;
   }
@@ -107,6 +120,10 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   bool DoConnect(engine::SemaphoreLock);
 
   void TryCreateConnectionAsync();
+  void WarmupPreparedStatements(Connection& connection);
+  /// Pool size for the current load, bounded by the pool size limits
+  std::size_t GetWantedSize(const PoolSettings& settings) const;
+  void CheckSpareConnections();
   void CheckMinPoolSizeUnderflow();
 
   void Push(Connection* connection);
@@ -130,6 +147,9 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
 
   void CheckUserTypes();
 
+  void ExecuteBatch(std::vector<Connection::PipelinedStatement>& statements,
+                    OptionalCommandControl cmd_ctl);
+
   using RecentCounter = USERVER_NAMESPACE::utils::statistics::RecentPeriod<
       USERVER_NAMESPACE::utils::statistics::RelaxedCounter<size_t>, size_t>;
 
@@ -139,6 +159,7 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   std::string db_name_;
   rcu::Variable<PoolSettings> settings_;
   rcu::Variable<ConnectionSettings> conn_settings_;
+  StatementDescriptions descriptions_;
   engine::TaskProcessor& bg_task_processor_;
   concurrent::BackgroundTaskStorageCore connect_task_storage_;
   concurrent::BackgroundTaskStorageCore close_task_storage_;
@@ -162,6 +183,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   cc::Limiter cc_limiter_;
   congestion_control::v2::LinearController cc_controller_;
   std::atomic<std::size_t> cc_max_connections_;
+
+  PipelineBatcher batcher_;
 };
 
 }  // namespace storages::postgres::detail
@@ -0,0 +1,100 @@
+#include <storages/postgres/detail/replication_connection.hpp>
+
+#include <chrono>
+
+#include <fmt/format.h>
+
+#include <userver/engine/semaphore.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utils/algo.hpp>
+#include <userver/utils/text_light.hpp>
+
+#include <storages/postgres/detail/pgoutput_decoder.hpp>
+#include <storages/postgres/detail/tracing_tags.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+// Replication connections are not counted by the pools
+constexpr std::uint32_t kReplicationConnectionId = 0;
+
+constexpr std::string_view kReplicationOptions =
+    "replication=database target_session_attrs=read-write";
+constexpr std::string_view kReplicationUriOptions =
+    "replication=database&target_session_attrs=read-write";
+
+}  // namespace
+
+ReplicationConnection::ReplicationConnection(
+    engine::TaskProcessor& bg_task_processor,
+    concurrent::BackgroundTaskStorageCore& bg_task_storage)
+    : conn_wrapper_{bg_task_processor, bg_task_storage,
+                    kReplicationConnectionId, engine::SemaphoreLock{}} {}
+
+void ReplicationConnection::Connect(const Dsn& dsn,
+                                    engine::Deadline deadline) {
+  tracing::Span span{scopes::kConnect};
+  auto scope = span.CreateScopeTime();
+  conn_wrapper_.AsyncConnect(MakeReplicationDsn(dsn), deadline, scope);
+}
+
+void ReplicationConnection::CreateTemporarySlot(const std::string& slot_name,
+                                                engine::Deadline deadline) {
+  tracing::Span span{scopes::kQuery};
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  conn_wrapper_.SendQuery(
+      fmt::format("CREATE_REPLICATION_SLOT {} TEMPORARY LOGICAL pgoutput "
+                  "NOEXPORT_SNAPSHOT",
+                  slot_name),
+      scope);
+  conn_wrapper_.WaitResult(deadline, scope);
+}
+
+void ReplicationConnection::StartReplication(
+    const std::string& slot_name, const std::vector<std::string>& publications,
+    engine::Deadline deadline) {
+  tracing::Span span{scopes::kQuery};
+  auto scope = span.CreateScopeTime(scopes::kExec);
+  // The stream starts at the confirmed position of the slot
+  conn_wrapper_.StartCopyBoth(
+      fmt::format("START_REPLICATION SLOT {} LOGICAL 0/0 "
+                  "(proto_version '1', publication_names '{}')",
+                  slot_name, fmt::join(publications, ",")),
+      deadline, scope);
+}
+
+bool ReplicationConnection::Receive(std::string& message,
+                                    engine::Deadline deadline) {
+  return conn_wrapper_.ReceiveCopyBothData(message, deadline);
+}
+
+void ReplicationConnection::SendStatusUpdate(Lsn written, Lsn flushed,
+                                             engine::Deadline deadline) {
+  conn_wrapper_.PutCopyData(
+      MakeStandbyStatusUpdate(written, flushed,
+                              std::chrono::system_clock::now()),
+      deadline);
+}
+
+void ReplicationConnection::Close() { conn_wrapper_.Close().Wait(); }
+
+Dsn MakeReplicationDsn(const Dsn& dsn) {
+  namespace text = USERVER_NAMESPACE::utils::text;
+  const auto& str = dsn.GetUnderlying();
+  if (text::StartsWith(str, "postgresql://") ||
+      text::StartsWith(str, "postgres://")) {
+    const std::string_view separator =
+        (str.find('?') == std::string::npos) ? "?" : "&";
+    return Dsn{USERVER_NAMESPACE::utils::StrCat(str, separator,
+                                                kReplicationUriOptions)};
+  }
+  return Dsn{
+      USERVER_NAMESPACE::utils::StrCat(str, " ", kReplicationOptions)};
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <userver/concurrent/background_task_storage_fwd.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/storages/postgres/dsn.hpp>
+#include <userver/storages/postgres/logical_replication.hpp>
+
+#include <storages/postgres/detail/pg_connection_wrapper.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// @brief Connection in the logical replication mode, streams the changes
+/// of a replication slot in the `pgoutput` format.
+class ReplicationConnection final {
+ public:
+  ReplicationConnection(engine::TaskProcessor& bg_task_processor,
+                        concurrent::BackgroundTaskStorageCore& bg_task_storage);
+
+  /// Connects to the read-write host of the DSN
+  void Connect(const Dsn& dsn, engine::Deadline deadline);
+
+  /// Creates a slot that is dropped by the server on disconnect, the stream
+  /// of the slot starts at the moment of its creation
+  void CreateTemporarySlot(const std::string& slot_name,
+                           engine::Deadline deadline);
+
+  /// Starts streaming the changes of the publications, the connection is in
+  /// the COPY BOTH mode afterwards. The slot name and the publication names
+  /// must be valid unquoted identifiers.
+  void StartReplication(const std::string& slot_name,
+                        const std::vector<std::string>& publications,
+                        engine::Deadline deadline);
+
+  /// Receives the next replication protocol message.
+  /// @returns false if nothing has been received before the deadline
+  bool Receive(std::string& message, engine::Deadline deadline);
+
+  /// Reports the processed position of the stream to the server
+  void SendStatusUpdate(Lsn written, Lsn flushed, engine::Deadline deadline);
+
+  void Close();
+
+ private:
+  PGConnectionWrapper conn_wrapper_;
+};
+
+/// Appends the options of the logical replication mode to the DSN
+Dsn MakeReplicationDsn(const Dsn& dsn);
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,45 @@
+#include <storages/postgres/detail/result_cache.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+// Shards of the cache and of its single-flight registry
+constexpr std::size_t kWays = 16;
+
+template <typename T>
+void AppendRaw(std::string& key, const T& value) {
+  key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+ResultCache::ResultCache(const ResultCacheSettings& settings)
+    : settings_(settings),
+      cache_(kWays, std::max<std::size_t>(settings.size / kWays, 1)) {
+  cache_.SetMaxLifetime(settings_.ttl);
+}
+
+void ResultCache::Invalidate() { cache_.Invalidate(); }
+
+std::string MakeResultCacheKey(ClusterHostTypeFlags roles,
+                               const QueryParameters& params) {
+  std::string key;
+  AppendRaw(key, (roles & kClusterHostRolesMask).GetValue());
+  for (std::size_t i = 0; i < params.Size(); ++i) {
+    // The lengths tell the parameters apart, NULL is a negative one
+    const auto length = params.ParamLengthsBuffer()[i];
+    AppendRaw(key, params.ParamTypesBuffer()[i]);
+    AppendRaw(key, length);
+    if (length > 0) key.append(params.ParamBuffers()[i], length);
+  }
+  return key;
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+
+#include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/storages/postgres/cluster_types.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// Results of a named query by its parameters, see ResultCacheSettings
+class ResultCache final {
+ public:
+  explicit ResultCache(const ResultCacheSettings& settings);
+
+  /// @returns the cached result of the query with the `params` or the one of
+  /// `execute()`, that is called once for the concurrent misses
+  template <typename ExecuteFunc>
+  ResultSet Get(ClusterHostTypeFlags roles, const QueryParameters& params,
+                const ExecuteFunc& execute);
+
+  /// Drops all the results
+  void Invalidate();
+
+  const ResultCacheSettings& GetSettings() const { return settings_; }
+
+ private:
+  const ResultCacheSettings settings_;
+  cache::ExpirableLruCache<std::string, ResultSet> cache_;
+};
+
+/// Binary representation of the host roles and the parameters
+std::string MakeResultCacheKey(ClusterHostTypeFlags roles,
+                               const QueryParameters& params);
+
+template <typename ExecuteFunc>
+ResultSet ResultCache::Get(ClusterHostTypeFlags roles,
+                           const QueryParameters& params,
+                           const ExecuteFunc& execute) {
+  return cache_.Get(MakeResultCacheKey(roles, params),
+                    [&execute](const std::string&) { return execute(); });
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,116 @@
+#include <storages/postgres/detail/slow_query_explainer.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+#include <storages/postgres/detail/owned_query_parameters.hpp>
+#include <storages/postgres/detail/tracing_tags.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+// The statement runs at least as long on a replica, so the timeout leaves
+// room for a colder cache or a busier host
+constexpr TimeoutDuration kMinExplainTimeout{1000};
+constexpr int kExplainTimeoutFactor = 2;
+
+// Huge plans are cut to keep the log records and the spans sane
+constexpr std::size_t kMaxPlanSize = 16 * 1024;
+
+USERVER_NAMESPACE::utils::TokenBucket::RefillPolicy MakeRefillPolicy(
+    const StatementMetricsSettings& settings) {
+  return {1, std::max(settings.slow_query_explain_interval,
+                      std::chrono::milliseconds{1})};
+}
+
+}  // namespace
+
+SlowQueryExplainer::SlowQueryExplainer(
+    engine::TaskProcessor& bg_task_processor,
+    const StatementMetricsSettings& settings, ExplainFunc explain)
+    : explain_{std::move(explain)},
+      rate_limit_{1, MakeRefillPolicy(settings)},
+      tasks_{bg_task_processor} {}
+
+void SlowQueryExplainer::SetSettings(const StatementMetricsSettings& settings) {
+  rate_limit_.SetRefillPolicy(MakeRefillPolicy(settings));
+}
+
+void SlowQueryExplainer::Explain(const Query& query,
+                                 const QueryParameters& params,
+                                 std::chrono::microseconds duration) {
+  if (in_flight_.load() || !rate_limit_.Obtain()) return;
+  if (in_flight_.exchange(true)) return;
+
+  std::lock_guard lock{mutex_};
+  if (stopped_) {
+    in_flight_ = false;
+    return;
+  }
+  // The caller's parameters do not outlive the statement
+  tasks_.AsyncDetach(
+      scopes::kExplainSlowQuery,
+      [this, query, duration,
+       owned_params = std::make_unique<OwnedQueryParameters>(params)] {
+        const USERVER_NAMESPACE::utils::FastScopeGuard in_flight_guard{
+            [this]() noexcept { in_flight_ = false; }};
+        DoExplain(query, *owned_params, duration);
+      });
+}
+
+void SlowQueryExplainer::Stop() noexcept {
+  {
+    std::lock_guard lock{mutex_};
+    if (stopped_) return;
+    stopped_ = true;
+  }
+  tasks_.CancelAndWait();
+}
+
+void SlowQueryExplainer::DoExplain(const Query& query,
+                                   const OwnedQueryParameters& params,
+                                   std::chrono::microseconds duration) const {
+  const auto duration_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+  const auto timeout = std::max(kMinExplainTimeout,
+                                duration_ms * kExplainTimeoutFactor);
+  const auto name =
+      query.GetName() ? query.GetName()->GetUnderlying() : std::string{};
+
+  auto& span = tracing::Span::CurrentSpan();
+  span.AddTag(tracing::kDatabaseStatementName, name);
+  span.AddTag("pg_slow_query_duration_ms", duration_ms.count());
+
+  std::string plan;
+  try {
+    for (const auto& row : explain_(query, QueryParameters{params}, timeout)) {
+      plan.append(row).append("\n");
+    }
+  } catch (const std::exception& e) {
+    LOG_WARNING() << "Failed to capture the plan of the slow statement '"
+                  << name << "': " << e;
+    return;
+  }
+
+  if (plan.size() > kMaxPlanSize) {
+    plan.resize(kMaxPlanSize);
+    plan.append("...");
+  }
+  span.AddTag("pg_explain", plan);
+  LOG_WARNING() << "Statement '" << name << "' took " << duration_ms.count()
+                << "ms, its plan on a replica:\n"
+                << plan;
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
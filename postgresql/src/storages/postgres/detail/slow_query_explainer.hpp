@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/utils/token_bucket.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+class OwnedQueryParameters;
+
+/// Captures the plans of the slow statements, see
+/// StatementMetricsSettings::slow_query_threshold
+///
+/// A slow statement is run again as `EXPLAIN (ANALYZE, BUFFERS)` in a
+/// background task. At most one plan is captured at a time and at most one
+/// per StatementMetricsSettings::slow_query_explain_interval. The plan is
+/// logged and written into the span of the task, that belongs to the trace of
+/// the slow statement.
+class SlowQueryExplainer final {
+ public:
+  /// Runs the statement on a replica in a read-only transaction and returns
+  /// the rows of the plan
+  using ExplainFunc = std::function<std::vector<std::string>(
+      const Query& query, const QueryParameters& params,
+      TimeoutDuration timeout)>;
+
+  SlowQueryExplainer(engine::TaskProcessor& bg_task_processor,
+                     const StatementMetricsSettings& settings,
+                     ExplainFunc explain);
+
+  void SetSettings(const StatementMetricsSettings& settings);
+
+  /// Starts a capture of the plan of the statement, unless another capture
+  /// is in progress or the interval has not passed yet
+  void Explain(const Query& query, const QueryParameters& params,
+               std::chrono::microseconds duration);
+
+  /// Cancels and waits for the capture in progress, no captures are started
+  /// afterwards
+  void Stop() noexcept;
+
+ private:
+  void DoExplain(const Query& query, const OwnedQueryParameters& params,
+                 std::chrono::microseconds duration) const;
+
+  const ExplainFunc explain_;
+  USERVER_NAMESPACE::utils::TokenBucket rate_limit_;
+  std::atomic<bool> in_flight_{false};
+
+  engine::Mutex mutex_;  // protects stopped_ against the task launch
+  bool stopped_{false};
+  concurrent::BackgroundTaskStorage tasks_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
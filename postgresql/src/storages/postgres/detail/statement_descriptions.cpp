@@ -0,0 +1,73 @@
+#include <storages/postgres/detail/statement_descriptions.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+StatementDescriptions::StatementDescriptions(std::size_t max_size)
+    : descriptions_{max_size} {}
+
+std::optional<ResultSet> StatementDescriptions::Get(
+    Connection::StatementId id, const std::string& statement) {
+  auto descriptions = descriptions_.Lock();
+  auto* description = descriptions->Get(id);
+  // Hash collisions are not likely, but are not fatal either
+  if (!description || description->statement != statement) {
+    return std::nullopt;
+  }
+  ++description->uses;
+  return description->description;
+}
+
+void StatementDescriptions::Put(Connection::StatementId id,
+                                const std::string& statement,
+                                const QueryParameters& params,
+                                const ResultSet& description) {
+  const auto* types = params.ParamTypesBuffer();
+  std::vector<Oid> param_types(types, types + params.Size());
+  auto descriptions = descriptions_.Lock();
+  descriptions->Put(id, {statement, std::move(param_types), description});
+}
+
+std::vector<StatementDescriptions::HotStatement> StatementDescriptions::GetHot(
+    std::size_t count) const {
+  std::vector<std::pair<std::size_t, HotStatement>> statements;
+  {
+    auto descriptions = descriptions_.Lock();
+    statements.reserve(descriptions->GetSize());
+    descriptions->VisitAll([&statements](const Connection::StatementId&,
+                                         const Description& description) {
+      statements.push_back(
+          {description.uses,
+           {description.statement, description.param_types}});
+    });
+  }
+
+  count = std::min(count, statements.size());
+  std::partial_sort(
+      statements.begin(), statements.begin() + count, statements.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+  std::vector<HotStatement> result;
+  result.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    result.push_back(std::move(statements[i].second));
+  }
+  return result;
+}
+
+void StatementDescriptions::Clear() {
+  auto descriptions = descriptions_.Lock();
+  descriptions->Clear();
+}
+
+void StatementDescriptions::SetMaxSize(std::size_t max_size) {
+  auto descriptions = descriptions_.Lock();
+  descriptions->SetMaxSize(max_size);
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// @brief Descriptions of the prepared statements shared by the connections
+/// of a pool.
+///
+/// A connection that prepares a statement already described by another
+/// connection does not need a describe round trip.
+class StatementDescriptions final {
+ public:
+  /// A statement to prepare on a new connection
+  struct HotStatement {
+    std::string statement;
+    std::vector<Oid> param_types;
+  };
+
+  explicit StatementDescriptions(std::size_t max_size);
+
+  std::optional<ResultSet> Get(Connection::StatementId id,
+                               const std::string& statement);
+  void Put(Connection::StatementId id, const std::string& statement,
+           const QueryParameters& params, const ResultSet& description);
+  /// @returns up to `count` statements prepared by most connections
+  std::vector<HotStatement> GetHot(std::size_t count) const;
+  /// Drop all the descriptions, e.g. after a schema change
+  void Clear();
+
+  void SetMaxSize(std::size_t max_size);
+
+ private:
+  struct Description {
+    std::string statement;
+    std::vector<Oid> param_types;
+    ResultSet description{nullptr};
+    /// Number of the connections that prepared the statement
+    std::size_t uses{1};
+  };
+  using Storage =
+      USERVER_NAMESPACE::cache::LruMap<Connection::StatementId, Description>;
+
+  USERVER_NAMESPACE::concurrent::Variable<Storage> descriptions_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include "statement_timer.hpp"
 
+#include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/query.hpp>
@@ -8,19 +9,24 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres::detail {
 
-StatementTimer::StatementTimer(const Query& query, const ConnectionPtr& conn)
+StatementTimer::StatementTimer(const Query& query,
+                               const QueryParameters& params,
+                               const ConnectionPtr& conn)
     : query_{query},
+      params_{params},
+      conn_{conn},
       sts_{conn.GetStatementTimingsStorage()},
       start_{sts_ != nullptr ? Now() : SteadyClock::time_point{}} {}
 
 void StatementTimer::Account() {
   if (sts_ == nullptr || !query_.GetName().has_value()) return;
 
-  const auto duration_ms =
-      std::chrono::duration_cast<std::chrono::milliseconds>(Now() - start_)
-          .count();
+  const auto duration =
+      std::chrono::duration_cast<std::chrono::microseconds>(Now() - start_);
 
-  sts_->Account(query_.GetName()->GetUnderlying(), duration_ms);
+  sts_->Account(query_.GetName()->GetUnderlying(), duration,
+                conn_->GetLastPrepareDuration());
+  sts_->AccountSlowQuery(query_, params_, duration);
 }
 
 SteadyClock::time_point StatementTimer::Now() { return SteadyClock::now(); }
@@ -8,11 +8,13 @@ USERVER_NAMESPACE_BEGIN
 namespace storages::postgres::detail {
 
 class ConnectionPtr;
+class QueryParameters;
 class StatementTimingsStorage;
 
 class StatementTimer final {
  public:
-  StatementTimer(const Query& query, const ConnectionPtr& conn);
+  StatementTimer(const Query& query, const QueryParameters& params,
+                 const ConnectionPtr& conn);
 
   void Account();
 
@@ -20,6 +22,8 @@ class StatementTimer final {
   static SteadyClock::time_point Now();
 
   const Query& query_;
+  const QueryParameters& params_;
+  const ConnectionPtr& conn_;
   const StatementTimingsStorage* sts_;
 
   const SteadyClock::time_point start_;
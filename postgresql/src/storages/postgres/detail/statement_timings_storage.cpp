@@ -1,5 +1,6 @@
 #include "statement_timings_storage.hpp"
 
+#include <storages/postgres/detail/slow_query_explainer.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utils/async.hpp>
 
@@ -15,10 +16,11 @@ StatementTimingsStorage::StatementTimingsStorage(
     const StatementMetricsSettings& settings)
     : settings_{settings},
       enabled_{settings.max_statements != 0},
+      slow_query_threshold_{settings.slow_query_threshold},
       data_{
           CreateStorageData(settings.max_statements, kDefaultEventsQueueSize)} {
-  data_.consumer_task =
-      utils::Async("pg_timings_events_consumer", [this]() { ProcessEvents(); });
+  data_.consumer_task = USERVER_NAMESPACE::utils::Async(
+      "pg_timings_events_consumer", [this]() { ProcessEvents(); });
 }
 
 StatementTimingsStorage::~StatementTimingsStorage() {
@@ -27,14 +29,27 @@ StatementTimingsStorage::~StatementTimingsStorage() {
   }
 }
 
-void StatementTimingsStorage::Account(const std::string& statement_name,
-                                      std::size_t duration_ms) const {
+void StatementTimingsStorage::Account(
+    const std::string& statement_name, std::chrono::microseconds duration,
+    std::chrono::microseconds prepare_duration) const {
   if (!IsEnabled()) return;
 
   const auto producer = data_.events_queue->GetProducer();
 
-  [[maybe_unused]] const auto success = producer.PushNoblock(
-      std::make_unique<StatementEvent>(statement_name, duration_ms));
+  [[maybe_unused]] const auto success =
+      producer.PushNoblock(std::make_unique<StatementEvent>(
+          statement_name, duration, prepare_duration));
+}
+
+void StatementTimingsStorage::AccountSlowQuery(
+    const Query& query, const QueryParameters& params,
+    std::chrono::microseconds duration) const {
+  const auto threshold = slow_query_threshold_.load();
+  if (threshold.count() == 0 || duration < threshold) return;
+
+  if (const auto explainer = slow_query_explainer_.lock()) {
+    explainer->Explain(query, params, duration);
+  }
 }
 
 std::unordered_map<std::string, StatementTimingsStorage::Percentile>
@@ -49,9 +64,27 @@ StatementTimingsStorage::GetTimingsPercentiles() const {
 
   timings.VisitAll(
       [&result](const std::string& key,
-                const std::unique_ptr<StatementTimingsStorage::RecentPeriod>&
-                    recent_period) {
-        result.emplace(key, recent_period->GetStatsForPeriod());
+                const std::unique_ptr<StatementTimings>& statement_timings) {
+        result.emplace(key, statement_timings->percentile.GetStatsForPeriod());
+      });
+
+  return result;
+}
+
+std::unordered_map<std::string, StatementPhaseTimings>
+StatementTimingsStorage::GetPhaseTimings() const {
+  if (!IsEnabled()) return {};
+
+  auto locked_ptr = data_.timings->SharedLock();
+  const auto& timings = *locked_ptr;
+
+  std::unordered_map<std::string, StatementPhaseTimings> result;
+  result.reserve(timings.GetSize());
+
+  timings.VisitAll(
+      [&result](const std::string& key,
+                const std::unique_ptr<StatementTimings>& statement_timings) {
+        result.emplace(key, statement_timings->phases);
       });
 
   return result;
@@ -62,6 +95,8 @@ void StatementTimingsStorage::SetSettings(
   const auto settings_ptr = settings_.Read();
   if (*settings_ptr == settings) return;
 
+  slow_query_threshold_ = settings.slow_query_threshold;
+
   const auto enabled = settings.max_statements != 0;
   if (enabled) {
     // we don't have any operations that hold this lock for long,
@@ -76,6 +111,11 @@ void StatementTimingsStorage::SetSettings(
   settings_.Assign(settings);
 }
 
+void StatementTimingsStorage::SetSlowQueryExplainer(
+    std::weak_ptr<SlowQueryExplainer> explainer) {
+  slow_query_explainer_ = std::move(explainer);
+}
+
 void StatementTimingsStorage::WaitForExhaustion() const {
   while (data_.events_queue->GetSizeApproximate()) {
     engine::SleepFor(std::chrono::milliseconds{2});
@@ -100,18 +140,25 @@ void StatementTimingsStorage::ProcessEvents() {
 
 void StatementTimingsStorage::AccountEvent(EventPtr event_ptr) const {
   const auto& name = event_ptr->statement_name;
-  const auto duration = event_ptr->duration_ms;
+  const auto duration = event_ptr->duration;
+  const auto prepare_duration = event_ptr->prepare_duration;
 
   auto locked_ptr = data_.timings->UniqueLock();
   auto& data = *locked_ptr;
 
   auto* timing_ptr = data.Get(name);
   if (!timing_ptr) {
-    data.Put(name, std::make_unique<RecentPeriod>());
+    data.Put(name, std::make_unique<StatementTimings>());
     timing_ptr = data.Get(name);
   }
   UASSERT(timing_ptr);
-  (*timing_ptr)->GetCurrentCounter().Account(duration);
+  auto& timings = **timing_ptr;
+  timings.percentile.GetCurrentCounter().Account(
+      std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+  if (prepare_duration.count() != 0) {
+    timings.phases.prepare.Account(prepare_duration.count());
+  }
+  timings.phases.execute.Account((duration - prepare_duration).count());
 }
 
 StatementTimingsStorage::StorageData StatementTimingsStorage::CreateStorageData(
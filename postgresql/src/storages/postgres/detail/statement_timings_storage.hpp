@@ -8,15 +8,21 @@
 #include <userver/formats/json_fwd.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/query.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 
+#include <chrono>
+#include <memory>
 #include <unordered_map>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres::detail {
 
+class QueryParameters;
+class SlowQueryExplainer;
+
 class StatementTimingsStorage final {
  public:
   using Percentile = postgres::Percentile;
@@ -25,22 +31,39 @@ class StatementTimingsStorage final {
   ~StatementTimingsStorage();
 
   void Account(const std::string& statement_name,
-               std::size_t duration_ms) const;
+               std::chrono::microseconds duration,
+               std::chrono::microseconds prepare_duration) const;
+
+  /// Starts a capture of the plan of the statement if it ran at least
+  /// StatementMetricsSettings::slow_query_threshold
+  void AccountSlowQuery(const Query& query, const QueryParameters& params,
+                        std::chrono::microseconds duration) const;
 
   std::unordered_map<std::string, Percentile> GetTimingsPercentiles() const;
 
+  std::unordered_map<std::string, StatementPhaseTimings> GetPhaseTimings()
+      const;
+
   void SetSettings(const StatementMetricsSettings& settings);
 
+  /// Must be called before the statements are executed
+  void SetSlowQueryExplainer(std::weak_ptr<SlowQueryExplainer> explainer);
+
   // For testing purposes, don't use directly
   void WaitForExhaustion() const;
 
  private:
   struct StatementEvent final {
-    StatementEvent(const std::string& statement_name_, size_t duration_)
-        : statement_name{statement_name_}, duration_ms{duration_} {}
+    StatementEvent(const std::string& statement_name_,
+                   std::chrono::microseconds duration_,
+                   std::chrono::microseconds prepare_duration_)
+        : statement_name{statement_name_},
+          duration{duration_},
+          prepare_duration{prepare_duration_} {}
 
     std::string statement_name;
-    std::size_t duration_ms;
+    std::chrono::microseconds duration;
+    std::chrono::microseconds prepare_duration;
   };
   using EventPtr = std::unique_ptr<StatementEvent>;
 
@@ -48,9 +71,13 @@ class StatementTimingsStorage final {
   using RecentPeriod =
       USERVER_NAMESPACE::utils::statistics::RecentPeriod<Percentile,
                                                          Percentile>;
+  struct StatementTimings final {
+    RecentPeriod percentile;
+    StatementPhaseTimings phases;
+  };
   using StorageType =
       USERVER_NAMESPACE::cache::LruMap<std::string,
-                                       std::unique_ptr<RecentPeriod>>;
+                                       std::unique_ptr<StatementTimings>>;
   using Storage =
       USERVER_NAMESPACE::concurrent::Variable<StorageType, engine::SharedMutex>;
 
@@ -71,6 +98,8 @@ class StatementTimingsStorage final {
 
   rcu::Variable<StatementMetricsSettings> settings_;
   std::atomic_bool enabled_;
+  std::atomic<std::chrono::microseconds> slow_query_threshold_;
+  std::weak_ptr<SlowQueryExplainer> slow_query_explainer_;
 
   StorageData data_;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -27,6 +28,13 @@ class TopologyBase {
   using DsnIndicesByType =
       std::unordered_map<ClusterHostType, DsnIndices, ClusterHostTypeHash>;
 
+  struct HostLatency {
+    /// Moving average of the check query RTT
+    std::chrono::microseconds rtt{0};
+    std::chrono::milliseconds replication_lag{0};
+  };
+  using HostLatencies = std::vector<HostLatency>;
+
   TopologyBase(engine::TaskProcessor& bg_task_processor, DsnList dsns,
                clients::dns::Resolver* resolver,
                const TopologySettings& topology_settings,
@@ -47,6 +55,9 @@ class TopologyBase {
   /// Currently accessible hosts
   virtual rcu::ReadablePtr<DsnIndices> GetAliveDsnIndices() const = 0;
 
+  /// Latencies of the hosts by DsnIndex, meaningful for the alive ones only
+  virtual rcu::ReadablePtr<HostLatencies> GetHostLatencies() const = 0;
+
   // Returns statistics for each DSN in DsnList
   virtual const std::vector<decltype(InstanceStatistics::topology)>&
   GetDsnStatistics() const = 0;
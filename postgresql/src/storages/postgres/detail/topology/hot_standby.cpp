@@ -36,6 +36,10 @@ constexpr Rtt kUnknownRtt{-1};
 
 using ReplicationLag = std::chrono::milliseconds;
 
+// The RTT moving average keeps 3/4 of the previous value
+constexpr int kRttSmoothingNumerator = 3;
+constexpr int kRttSmoothingDenominator = 4;
+
 constexpr const char* kDiscoveryTaskName = "pg_topology";
 
 const std::string kShowSyncStandbyNames = "SHOW synchronous_standby_names";
@@ -109,6 +113,8 @@ struct HotStandby::HostState {
     role = ClusterHostType::kNone;
     is_readonly = true;
     roundtrip_time = kUnknownRtt;
+    smoothed_rtt = kUnknownRtt;
+    replication_lag = {};
     wal_lsn = kUnknownLsn;
     current_xact_timestamp = {};
     detected_sync_slaves.clear();
@@ -124,6 +130,8 @@ struct HotStandby::HostState {
   ClusterHostType role = ClusterHostType::kNone;
   bool is_readonly = true;
   Rtt roundtrip_time{kUnknownRtt};
+  Rtt smoothed_rtt{kUnknownRtt};
+  ReplicationLag replication_lag{};
   Lsn wal_lsn{kUnknownLsn};
   std::chrono::system_clock::time_point current_xact_timestamp;
   std::vector<std::string> detected_sync_slaves;
@@ -162,6 +170,11 @@ rcu::ReadablePtr<TopologyBase::DsnIndices> HotStandby::GetAliveDsnIndices()
   return alive_dsn_indices_.Read();
 }
 
+rcu::ReadablePtr<TopologyBase::HostLatencies> HotStandby::GetHostLatencies()
+    const {
+  return host_latencies_.Read();
+}
+
 const std::vector<decltype(InstanceStatistics::topology)>&
 HotStandby::GetDsnStatistics() const {
   return dsn_stats_;
@@ -225,6 +238,7 @@ void HotStandby::RunDiscovery() {
     dsn_stats_[i].replication_lag.GetCurrentCounter().Account(
         std::chrono::duration_cast<std::chrono::milliseconds>(slave_lag)
             .count());
+    slave.replication_lag = slave_lag;
 
     if (slave_lag > GetTopologySettings().max_replication_lag) {
       // Demote lagged slave
@@ -264,8 +278,8 @@ void HotStandby::RunDiscovery() {
 
   std::sort(alive_dsn_indices.begin(), alive_dsn_indices.end(),
             [this](DsnIndex lhs, DsnIndex rhs) {
-              return host_states_[lhs].roundtrip_time <
-                     host_states_[rhs].roundtrip_time;
+              return host_states_[lhs].smoothed_rtt <
+                     host_states_[rhs].smoothed_rtt;
             });
   DsnIndicesByType dsn_indices_by_type;
   for (DsnIndex idx : alive_dsn_indices) {
@@ -278,6 +292,15 @@ void HotStandby::RunDiscovery() {
       dsn_indices_by_type[ClusterHostType::kSlave].push_back(idx);
     }
   }
+  HostLatencies host_latencies(host_states_.size());
+  for (DsnIndex i = 0; i < host_states_.size(); ++i) {
+    const auto& state = host_states_[i];
+    if (state.role == ClusterHostType::kNone) continue;
+    host_latencies[i] = {state.smoothed_rtt, state.replication_lag};
+  }
+
+  // Latencies first, so that the alive indices always have them
+  host_latencies_.Assign(std::move(host_latencies));
   dsn_indices_by_type_.Assign(std::move(dsn_indices_by_type));
   alive_dsn_indices_.Assign(std::move(alive_dsn_indices));
 }
@@ -306,8 +329,16 @@ void HotStandby::RunCheck(DsnIndex idx) {
     state.role = state.connection->IsInRecovery() ? ClusterHostType::kSlave
                                                   : ClusterHostType::kMaster;
     state.is_readonly = state.connection->IsReadOnly();
+    state.replication_lag = {};
     state.roundtrip_time = std::chrono::duration_cast<Rtt>(
         std::chrono::steady_clock::now() - start);
+    state.smoothed_rtt =
+        (state.smoothed_rtt == kUnknownRtt)
+            ? state.roundtrip_time
+            : (state.smoothed_rtt * kRttSmoothingNumerator +
+               state.roundtrip_time *
+                   (kRttSmoothingDenominator - kRttSmoothingNumerator)) /
+                  kRttSmoothingDenominator;
 
     const auto& wal_info_stmts =
         GetWalInfoStatementsForVersion(state.connection->GetServerVersion());
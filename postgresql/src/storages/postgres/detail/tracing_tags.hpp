@@ -20,6 +20,10 @@ const std::string kPrepare = "pg_prepare";
 const std::string kBind = "pg_bind";
 /// Execute query, driver level
 const std::string kExec = "pg_exec";
+/// Execute a batch of queries in pipeline mode, driver level
+const std::string kPipelineBatch = "pg_pipeline_batch";
+/// Capture the plan of a slow query on a replica, driver level
+const std::string kExplainSlowQuery = "pg_explain_slow_query";
 
 // libpq stages
 /// libpq async connect stage
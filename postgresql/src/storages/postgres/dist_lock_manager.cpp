@@ -0,0 +1,249 @@
+#include <userver/storages/postgres/dist_lock_manager.hpp>
+
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <userver/engine/future.hpp>
+#include <userver/hostinfo/blocking/get_hostname.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace {
+
+constexpr std::int64_t kNoFencingToken = -1;
+
+// keys - $1
+// owners - $2
+// timeouts in seconds - $3
+//
+// The keys of the batch are unique, so that each row is affected at most once
+std::string MakeAcquireQuery(const std::string& table) {
+  static constexpr auto kAcquireQueryFmt = R"(
+    INSERT INTO {} AS t (key, owner, expiration_time, fencing_token)
+    SELECT r.key, r.owner, current_timestamp + make_interval(secs => r.ttl), 1
+    FROM UNNEST($1::text[], $2::text[], $3::float8[]) AS r(key, owner, ttl)
+    ON CONFLICT (key) DO UPDATE
+    SET owner = excluded.owner, expiration_time = excluded.expiration_time,
+    fencing_token = t.fencing_token +
+      CASE WHEN t.owner = excluded.owner THEN 0 ELSE 1 END
+    WHERE (t.owner = excluded.owner) OR
+    (t.expiration_time <= current_timestamp)
+    RETURNING t.key, t.fencing_token;
+)";
+  return fmt::format(FMT_COMPILE(kAcquireQueryFmt), table);
+}
+
+// key - $1
+// owner - $2
+//
+// The row is kept to keep its fencing token
+std::string MakeReleaseQuery(const std::string& table) {
+  static constexpr auto kReleaseQueryFmt = R"(
+    UPDATE {}
+    SET expiration_time = current_timestamp
+    WHERE key = $1
+    AND owner = $2
+    RETURNING 1;
+)";
+  return fmt::format(FMT_COMPILE(kReleaseQueryFmt), table);
+}
+
+std::string MakeOwnerId(const std::string& prefix, const std::string& locker) {
+  return fmt::format(FMT_COMPILE("{}:{}"), prefix, locker);
+}
+
+}  // namespace
+
+struct DistLockManager::AcquireRequest {
+  std::string key;
+  std::string owner;
+  double ttl_seconds{0};
+  engine::Promise<std::optional<std::int64_t>> promise;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const DistLockManagerStatistics& stats) {
+  writer["batches"] = stats.batches;
+  writer["acquire-requests"] = stats.acquire_requests;
+  writer["acquire-failures"] = stats.acquire_failures;
+  writer["locks"] = stats.locks.load();
+  writer["locks-held"] = stats.locks_held.load();
+}
+
+DistLockManager::DistLockManager(ClusterPtr cluster, const std::string& table,
+                                 CommandControl cc)
+    : cluster_(std::move(cluster)),
+      cc_(cc),
+      acquire_query_(MakeAcquireQuery(table)),
+      release_query_(MakeReleaseQuery(table)),
+      owner_prefix_(hostinfo::blocking::GetRealHostName()) {
+  flusher_ = utils::CriticalAsync("pg-dist-lock-flusher",
+                                  [this] { RunFlusher(); });
+}
+
+DistLockManager::~DistLockManager() {
+  flusher_.SyncCancel();
+  // Promises of the remaining requests are broken, their waiters get an
+  // exception and treat the lock state as unknown
+}
+
+void DistLockManager::UpdateCommandControl(CommandControl cc) {
+  auto cc_ptr = cc_.StartWrite();
+  *cc_ptr = cc;
+  cc_ptr.Commit();
+}
+
+const DistLockManagerStatistics& DistLockManager::GetStatistics() const {
+  return stats_;
+}
+
+std::optional<std::int64_t> DistLockManager::Acquire(
+    const std::string& key, const std::string& owner,
+    std::chrono::milliseconds ttl) {
+  ++stats_.acquire_requests;
+
+  AcquireRequest request{key, MakeOwnerId(owner_prefix_, owner),
+                         ttl.count() / 1000.0, {}};
+  auto future = request.promise.get_future();
+  {
+    std::lock_guard lock(pending_mutex_);
+    pending_.push_back(std::move(request));
+  }
+  pending_event_.Send();
+
+  auto token = future.get();
+  if (!token) ++stats_.acquire_failures;
+  return token;
+}
+
+void DistLockManager::Release(const std::string& key,
+                              const std::string& owner) {
+  auto cc_ptr = cc_.Read();
+  cluster_->Execute(ClusterHostType::kMaster, *cc_ptr, release_query_, key,
+                    MakeOwnerId(owner_prefix_, owner));
+}
+
+void DistLockManager::RunFlusher() {
+  while (pending_event_.WaitForEvent()) {
+    auto batch = TakeBatch();
+    if (!batch.empty()) ExecuteBatch(batch);
+  }
+}
+
+std::vector<DistLockManager::AcquireRequest> DistLockManager::TakeBatch() {
+  std::vector<AcquireRequest> batch;
+  std::unordered_set<std::string> keys;
+
+  std::lock_guard lock(pending_mutex_);
+  std::vector<AcquireRequest> deferred;
+  for (auto& request : pending_) {
+    // A row can not be updated twice by a single INSERT ... ON CONFLICT
+    if (keys.insert(request.key).second) {
+      batch.push_back(std::move(request));
+    } else {
+      deferred.push_back(std::move(request));
+    }
+  }
+  pending_ = std::move(deferred);
+  if (!pending_.empty()) pending_event_.Send();
+
+  return batch;
+}
+
+void DistLockManager::ExecuteBatch(std::vector<AcquireRequest>& batch) {
+  std::vector<std::string> keys;
+  std::vector<std::string> owners;
+  std::vector<double> ttls;
+  keys.reserve(batch.size());
+  owners.reserve(batch.size());
+  ttls.reserve(batch.size());
+  for (const auto& request : batch) {
+    keys.push_back(request.key);
+    owners.push_back(request.owner);
+    ttls.push_back(request.ttl_seconds);
+  }
+
+  ++stats_.batches;
+  std::unordered_map<std::string, std::int64_t> tokens;
+  try {
+    auto cc_ptr = cc_.Read();
+    const auto result =
+        cluster_->Execute(ClusterHostType::kMaster, *cc_ptr, acquire_query_,
+                          keys, owners, ttls);
+    for (auto [key, token] :
+         result.AsSetOf<std::tuple<std::string, std::int64_t>>(kRowTag)) {
+      tokens.emplace(std::move(key), token);
+    }
+  } catch (const std::exception&) {
+    for (auto& request : batch) {
+      request.promise.set_exception(std::current_exception());
+    }
+    return;
+  }
+
+  for (auto& request : batch) {
+    const auto it = tokens.find(request.key);
+    request.promise.set_value(it == tokens.end()
+                                  ? std::nullopt
+                                  : std::optional<std::int64_t>{it->second});
+  }
+}
+
+BatchedDistLockStrategy::BatchedDistLockStrategy(DistLockManager& manager,
+                                                 std::string lock_name)
+    : manager_(manager),
+      lock_name_(std::move(lock_name)),
+      fencing_token_(kNoFencingToken) {
+  ++manager_.stats_.locks;
+}
+
+BatchedDistLockStrategy::~BatchedDistLockStrategy() {
+  SetHeld(false);
+  --manager_.stats_.locks;
+}
+
+void BatchedDistLockStrategy::Acquire(std::chrono::milliseconds lock_ttl,
+                                      const std::string& locker_id) {
+  const auto token = manager_.Acquire(lock_name_, locker_id, lock_ttl);
+  if (!token) {
+    fencing_token_ = kNoFencingToken;
+    SetHeld(false);
+    throw dist_lock::LockIsAcquiredByAnotherHostException();
+  }
+  fencing_token_ = *token;
+  SetHeld(true);
+}
+
+void BatchedDistLockStrategy::Release(const std::string& locker_id) {
+  fencing_token_ = kNoFencingToken;
+  SetHeld(false);
+  manager_.Release(lock_name_, locker_id);
+}
+
+std::optional<std::int64_t> BatchedDistLockStrategy::GetFencingToken() const {
+  const auto token = fencing_token_.load();
+  if (token == kNoFencingToken) return std::nullopt;
+  return token;
+}
+
+void BatchedDistLockStrategy::SetHeld(bool is_held) {
+  if (is_held_.exchange(is_held) == is_held) return;
+  if (is_held) {
+    ++manager_.stats_.locks_held;
+  } else {
+    --manager_.stats_.locks_held;
+  }
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,9 @@
 #include <benchmark/benchmark.h>
 
 #include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <storages/postgres/detail/connection.hpp>
 
@@ -53,6 +56,49 @@ BENCHMARK_F(PgConnection, Int64Roundtrip)(benchmark::State& state) {
   });
 }
 
+template <typename Array>
+void ParseArray(pg::detail::Connection& conn, benchmark::State& state,
+                const char* query) {
+  auto res = conn.Execute(query);
+  Array v;
+  for (auto _ : state) {
+    res.Front().To(v);
+    benchmark::DoNotOptimize(v);
+  }
+}
+
+BENCHMARK_F(PgConnection, Int64ArrayParse)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    ParseArray<std::vector<std::int64_t>>(
+        GetConnection(), state,
+        "select array_agg(i::int8) from generate_series(1, 10000) i");
+  });
+}
+
+BENCHMARK_F(PgConnection, DoubleArrayParse)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    ParseArray<std::vector<double>>(
+        GetConnection(), state,
+        "select array_agg(i::float8) from generate_series(1, 10000) i");
+  });
+}
+
+BENCHMARK_F(PgConnection, TextArrayParse)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    ParseArray<std::vector<std::string>>(
+        GetConnection(), state,
+        "select array_agg(i::text) from generate_series(1, 10000) i");
+  });
+}
+
+BENCHMARK_F(PgConnection, TextArrayParseStringView)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    ParseArray<std::vector<std::string_view>>(
+        GetConnection(), state,
+        "select array_agg(i::text) from generate_series(1, 10000) i");
+  });
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
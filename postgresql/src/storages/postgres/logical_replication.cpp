@@ -0,0 +1,17 @@
+#include <userver/storages/postgres/logical_replication.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+std::optional<std::size_t> ReplicationRelation::FindColumn(
+    std::string_view column) const {
+  for (std::size_t i = 0; i < columns.size(); ++i) {
+    if (columns[i].name == column) return i;
+  }
+  return std::nullopt;
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,211 @@
+#include <userver/storages/postgres/logical_replication_component.hpp>
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <storages/postgres/detail/pgoutput_decoder.hpp>
+#include <storages/postgres/detail/replication_connection.hpp>
+#include <userver/components/component.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/rand.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+namespace {
+
+namespace pg = storages::postgres;
+
+// Leaves room for the random suffix of the temporary slots, the limit of
+// the server is 63 characters
+constexpr std::size_t kMaxSlotNameLength = 48;
+
+constexpr std::chrono::seconds kStatusUpdateTimeout{1};
+
+bool IsValidIdentifier(std::string_view name) {
+  return !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+    return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
+  });
+}
+
+std::string ParseSlotName(const ComponentConfig& config) {
+  auto slot_name = config["slot_name"].As<std::string>();
+  if (!IsValidIdentifier(slot_name) || slot_name.size() > kMaxSlotNameLength) {
+    throw pg::InvalidConfig(fmt::format(
+        "Invalid replication slot name '{}', expected at most {} lowercase "
+        "letters, digits and underscores",
+        slot_name, kMaxSlotNameLength));
+  }
+  return slot_name;
+}
+
+std::vector<std::string> ParsePublications(const ComponentConfig& config) {
+  auto publications = config["publications"].As<std::vector<std::string>>();
+  if (publications.empty()) {
+    throw pg::InvalidConfig("No publications to replicate");
+  }
+  for (const auto& publication : publications) {
+    if (!IsValidIdentifier(publication)) {
+      throw pg::InvalidConfig(fmt::format(
+          "Invalid publication name '{}', expected lowercase letters, digits "
+          "and underscores",
+          publication));
+    }
+  }
+  return publications;
+}
+
+}  // namespace
+
+PostgresLogicalReplication::PostgresLogicalReplication(
+    const ComponentConfig& config, const ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      dsn_{config["dbconnection"].As<std::string>()},
+      slot_name_{ParseSlotName(config)},
+      temporary_slot_{config["temporary_slot"].As<bool>(true)},
+      publications_{ParsePublications(config)},
+      feedback_interval_{
+          config["feedback_interval"].As<std::chrono::milliseconds>(
+              std::chrono::seconds{10})},
+      connect_timeout_{config["connect_timeout"].As<std::chrono::milliseconds>(
+          std::chrono::seconds{5})},
+      restart_delay_{config["restart_delay"].As<std::chrono::milliseconds>(
+          std::chrono::seconds{1})},
+      bg_task_processor_{context.GetTaskProcessor(
+          config["blocking_task_processor"].As<std::string>())},
+      channel_{config.Name()} {}
+
+PostgresLogicalReplication::~PostgresLogicalReplication() {
+  if (task_.IsValid()) task_.SyncCancel();
+  bg_task_storage_.CancelAndWait();
+}
+
+PostgresLogicalReplication::EventSource&
+PostgresLogicalReplication::GetEventSource() {
+  return channel_;
+}
+
+void PostgresLogicalReplication::OnAllComponentsLoaded() {
+  task_ = utils::CriticalAsync("pg-logical-replication", [this] { Run(); });
+}
+
+void PostgresLogicalReplication::OnAllComponentsAreStopping() {
+  if (task_.IsValid()) task_.SyncCancel();
+}
+
+void PostgresLogicalReplication::Run() {
+  while (!engine::current_task::ShouldCancel()) {
+    try {
+      Stream();
+    } catch (const std::exception& e) {
+      if (engine::current_task::ShouldCancel()) break;
+      LOG_WARNING() << "Logical replication over slot " << slot_name_
+                    << " has failed, reconnecting in "
+                    << restart_delay_.count() << "ms: " << e;
+    }
+    engine::InterruptibleSleepFor(restart_delay_);
+  }
+}
+
+void PostgresLogicalReplication::Stream() {
+  pg::detail::ReplicationConnection connection{bg_task_processor_,
+                                               bg_task_storage_};
+  const auto connect_deadline =
+      engine::Deadline::FromDuration(connect_timeout_);
+  connection.Connect(dsn_, connect_deadline);
+
+  auto slot_name = slot_name_;
+  if (temporary_slot_) {
+    slot_name = fmt::format("{}_{:08x}", slot_name_, utils::Rand());
+    connection.CreateTemporarySlot(slot_name, connect_deadline);
+    // The changes since the previous slot are lost
+    pg::ReplicationTransaction restart;
+    restart.is_restart = true;
+    channel_.SendEvent(restart);
+  }
+  connection.StartReplication(slot_name, publications_, connect_deadline);
+  LOG_INFO() << "Started logical replication over slot " << slot_name;
+
+  pg::detail::PgOutputDecoder decoder;
+  pg::Lsn received = 0;
+  pg::Lsn flushed = 0;
+  std::string message;
+  auto feedback_deadline = engine::Deadline::FromDuration(feedback_interval_);
+  while (true) {
+    bool reply_requested = false;
+    if (connection.Receive(message, feedback_deadline)) {
+      const auto parsed = pg::detail::ParseReplicationMessage(message);
+      received = std::max(received, parsed.wal_end);
+      if (parsed.kind == pg::detail::ReplicationMessage::Kind::kXLogData) {
+        auto transaction = decoder.Decode(parsed.payload);
+        if (transaction) {
+          channel_.SendEvent(*transaction);
+          flushed = std::max(flushed, transaction->end_lsn);
+        }
+      } else {
+        // Nothing is pending, the WAL up to here has no published changes
+        if (!decoder.IsInTransaction()) {
+          flushed = std::max(flushed, parsed.wal_end);
+        }
+        reply_requested = parsed.reply_requested;
+      }
+    }
+
+    if (reply_requested || feedback_deadline.IsReached()) {
+      connection.SendStatusUpdate(
+          received, flushed,
+          engine::Deadline::FromDuration(kStatusUpdateTimeout));
+      feedback_deadline = engine::Deadline::FromDuration(feedback_interval_);
+    }
+  }
+}
+
+yaml_config::Schema PostgresLogicalReplication::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<LoggableComponentBase>(R"(
+type: object
+description: PostgreSQL logical replication consumer component
+additionalProperties: false
+properties:
+    dbconnection:
+        type: string
+        description: connection DSN string
+    blocking_task_processor:
+        type: string
+        description: name of task processor for background blocking operations
+    slot_name:
+        type: string
+        description: name of the replication slot, a random suffix is added to the temporary slots
+    temporary_slot:
+        type: boolean
+        description: create a temporary slot on each connect instead of using an existing persistent one
+        defaultDescription: true
+    publications:
+        type: array
+        description: names of the publications to stream
+        items:
+            type: string
+            description: publication name
+    feedback_interval:
+        type: string
+        description: interval of confirming the processed changes to the server
+        defaultDescription: 10s
+    connect_timeout:
+        type: string
+        description: timeout of connecting and of starting the stream
+        defaultDescription: 5s
+    restart_delay:
+        type: string
+        description: delay before reconnecting after an error
+        defaultDescription: 1s
+)");
+}
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
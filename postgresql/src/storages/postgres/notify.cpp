@@ -2,6 +2,7 @@
 
 #include <storages/postgres/detail/connection.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -9,12 +10,15 @@ namespace storages::postgres {
 
 struct NotifyScope::Impl {
   detail::ConnectionPtr conn_;
-  std::string channel_;
+  std::vector<std::string> channels_;
   OptionalCommandControl cmd_ctl_;
 
-  Impl(detail::ConnectionPtr conn, std::string_view channel,
+  Impl(detail::ConnectionPtr conn, std::vector<std::string> channels,
        OptionalCommandControl cmd_ctl)
-      : conn_{std::move(conn)}, channel_{channel}, cmd_ctl_{cmd_ctl} {
+      : conn_{std::move(conn)},
+        channels_{std::move(channels)},
+        cmd_ctl_{cmd_ctl} {
+    UINVARIANT(!channels_.empty(), "NotifyScope requires a channel");
     Listen();
   }
 
@@ -34,15 +38,29 @@ struct NotifyScope::Impl {
  private:
   void Listen() {
     UASSERT(conn_);
-    LOG_DEBUG() << "Start listening on channel '" << channel_ << "'";
-    conn_->Listen(channel_, cmd_ctl_);
+    std::size_t listening = 0;
+    try {
+      for (const auto& channel : channels_) {
+        LOG_DEBUG() << "Start listening on channel '" << channel << "'";
+        conn_->Listen(channel, cmd_ctl_);
+        ++listening;
+      }
+    } catch (const std::exception&) {
+      // The destructor is not called, the channels listened so far are
+      // unlistened here
+      channels_.resize(listening);
+      Unlisten();
+      throw;
+    }
   }
 
   void Unlisten() {
     if (!conn_) return;
     try {
-      LOG_DEBUG() << "Stop listening on channel '" << channel_ << "'";
-      conn_->Unlisten(channel_, cmd_ctl_);
+      for (const auto& channel : channels_) {
+        LOG_DEBUG() << "Stop listening on channel '" << channel << "'";
+        conn_->Unlisten(channel, cmd_ctl_);
+      }
     } catch (const std::exception& e) {
       LOG_LIMITED_ERROR() << "Exception while executing unlisten: " << e;
       // Will be closed to avoid unsolicited notifications in the future
@@ -53,7 +71,13 @@ struct NotifyScope::Impl {
 
 NotifyScope::NotifyScope(detail::ConnectionPtr conn, std::string_view channel,
                          OptionalCommandControl cmd_ctl)
-    : pimpl_{std::move(conn), channel, cmd_ctl} {}
+    : pimpl_{std::move(conn), std::vector<std::string>{std::string{channel}},
+             cmd_ctl} {}
+
+NotifyScope::NotifyScope(detail::ConnectionPtr conn,
+                         std::vector<std::string> channels,
+                         OptionalCommandControl cmd_ctl)
+    : pimpl_{std::move(conn), std::move(channels), cmd_ctl} {}
 
 NotifyScope::~NotifyScope() = default;
 
@@ -0,0 +1,118 @@
+#include <userver/storages/postgres/notify_listener.hpp>
+
+#include <optional>
+#include <set>
+#include <utility>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace {
+
+// Wake up periodically while there are no notifications
+constexpr auto kWaitTimeout = std::chrono::seconds{10};
+
+class BatchBuilder final {
+ public:
+  void Add(Notification&& notification) {
+    if (!seen_.emplace(notification.channel, notification.payload).second) {
+      return;
+    }
+    batch_.notifications.push_back(std::move(notification));
+  }
+
+  NotificationBatch Extract() { return std::move(batch_); }
+
+ private:
+  NotificationBatch batch_;
+  std::set<std::pair<std::string, std::optional<std::string>>> seen_;
+};
+
+}  // namespace
+
+NotifyListener::NotifyListener(ClusterPtr cluster,
+                               std::vector<std::string> channels,
+                               Callback callback,
+                               NotifyListenerSettings settings)
+    : NotifyListener(
+          [cluster = std::move(cluster)](std::vector<std::string> names) {
+            return cluster->Listen(std::move(names));
+          },
+          std::move(channels), std::move(callback), settings) {}
+
+NotifyListener::NotifyListener(ListenFunction listen,
+                               std::vector<std::string> channels,
+                               Callback callback,
+                               NotifyListenerSettings settings)
+    : listen_(std::move(listen)),
+      channels_(std::move(channels)),
+      callback_(std::move(callback)),
+      settings_(settings) {
+  UINVARIANT(!channels_.empty(), "NotifyListener requires a channel");
+  task_ = USERVER_NAMESPACE::utils::CriticalAsync("pg-notify-listener",
+                                                  [this] { Run(); });
+}
+
+NotifyListener::~NotifyListener() { task_.SyncCancel(); }
+
+void NotifyListener::Run() {
+  while (!engine::current_task::ShouldCancel()) {
+    try {
+      ListenOnce();
+    } catch (const std::exception& e) {
+      if (engine::current_task::ShouldCancel()) break;
+      LOG_WARNING() << "Failed to listen for notifications on "
+                    << channels_.size() << " channel(s): " << e;
+      engine::InterruptibleSleepFor(settings_.relisten_interval);
+    }
+  }
+}
+
+void NotifyListener::ListenOnce() {
+  auto scope = listen_(channels_);
+  // The notifications could have been missed while not listening
+  NotificationBatch restart;
+  restart.is_restart = true;
+  Deliver(restart);
+
+  while (!engine::current_task::ShouldCancel()) {
+    BatchBuilder builder;
+    try {
+      builder.Add(
+          scope.WaitNotify(engine::Deadline::FromDuration(kWaitTimeout)));
+    } catch (const ConnectionTimeoutError&) {
+      continue;
+    }
+
+    const auto window = engine::Deadline::FromDuration(settings_.batch_window);
+    while (!window.IsReached()) {
+      try {
+        builder.Add(scope.WaitNotify(window));
+      } catch (const ConnectionTimeoutError&) {
+        break;
+      }
+    }
+    Deliver(builder.Extract());
+  }
+}
+
+void NotifyListener::Deliver(const NotificationBatch& batch) const {
+  try {
+    callback_(batch);
+  } catch (const std::exception& e) {
+    LOG_ERROR() << "Notifications callback failed: " << e;
+  }
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -108,11 +108,26 @@ PoolSettings ParsePoolSettings(const ConfigType& config) {
       config["max_queue_size"].template As<size_t>(result.max_queue_size);
   result.connecting_limit =
       config["connecting_limit"].template As<size_t>(result.connecting_limit);
+  result.pipeline_batching_window =
+      std::chrono::microseconds{config["pipeline_batching_window_us"]
+                                    .template As<std::int64_t>(0)};
+  result.pipeline_batch_max_size =
+      config["pipeline_batch_max_size"].template As<size_t>(
+          result.pipeline_batch_max_size);
+  result.spare_size =
+      config["spare_pool_size"].template As<size_t>(result.spare_size);
+  result.prepare_warmup_size =
+      config["prepare_warmup_size"].template As<size_t>(
+          result.prepare_warmup_size);
 
   if (result.max_size == 0)
     throw InvalidConfig{"max_pool_size must be greater than 0"};
   if (result.max_size < result.min_size)
     throw InvalidConfig{"max_pool_size cannot be less than min_pool_size"};
+  if (result.pipeline_batching_window.count() < 0)
+    throw InvalidConfig{"pipeline_batching_window_us cannot be negative"};
+  if (result.pipeline_batch_max_size == 0)
+    throw InvalidConfig{"pipeline_batch_max_size must be greater than 0"};
 
   return result;
 }
@@ -137,6 +152,12 @@ StatementMetricsSettings ParseStatementMetricsSettings(
   StatementMetricsSettings result{};
   result.max_statements = config["max_statement_metrics"].template As<size_t>(
       result.max_statements);
+  result.slow_query_threshold = std::chrono::milliseconds{
+      config["slow_query_threshold_ms"].template As<int64_t>(
+          result.slow_query_threshold.count())};
+  result.slow_query_explain_interval = std::chrono::milliseconds{
+      config["slow_query_explain_interval_ms"].template As<int64_t>(
+          result.slow_query_explain_interval.count())};
 
   return result;
 }
@@ -153,6 +174,21 @@ StatementMetricsSettings Parse(const yaml_config::YamlConfig& config,
   return ParseStatementMetricsSettings(config);
 }
 
+ResultCacheSettings Parse(const yaml_config::YamlConfig& config,
+                          formats::parse::To<ResultCacheSettings>) {
+  ResultCacheSettings settings;
+  settings.ttl = config["ttl"].As<std::chrono::milliseconds>(settings.ttl);
+  settings.size = config["size"].As<std::size_t>(settings.size);
+  settings.invalidation_channel =
+      config["invalidation_channel"].As<std::string>(
+          settings.invalidation_channel);
+  if (settings.size == 0) {
+    throw InvalidConfig("Result cache size must be greater than zero in " +
+                        config.GetPath());
+  }
+  return settings;
+}
+
 Config Config::Parse(const dynamic_config::DocsMap& docs_map) {
   return Config{
       /*default_command_control=*/docs_map
@@ -31,6 +31,9 @@ StatementMetricsSettings Parse(const formats::json::Value& config,
 StatementMetricsSettings Parse(const yaml_config::YamlConfig& config,
                                formats::parse::To<StatementMetricsSettings>);
 
+ResultCacheSettings Parse(const yaml_config::YamlConfig& config,
+                          formats::parse::To<ResultCacheSettings>);
+
 struct Config final {
   static Config Parse(const dynamic_config::DocsMap& docs_map);
 
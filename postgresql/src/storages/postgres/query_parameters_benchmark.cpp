@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <string>
+
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+
+const pg::UserTypes kTypes;
+
+const std::string kShortString = "short";
+const std::string kLongString(1024, 'x');
+
+template <typename Params>
+void QueryParametersWriteFixedWidth(benchmark::State& state) {
+  for (auto _ : state) {
+    Params params;
+    params.Write(kTypes, pg::Bigint{42}, pg::Integer{42}, 3.14,
+                 std::optional<pg::Bigint>{});
+    benchmark::DoNotOptimize(params.ParamBuffers());
+  }
+}
+BENCHMARK_TEMPLATE(QueryParametersWriteFixedWidth,
+                   pg::detail::StaticQueryParameters<4>);
+BENCHMARK_TEMPLATE(QueryParametersWriteFixedWidth,
+                   pg::detail::DynamicQueryParameters);
+
+template <typename Params>
+void QueryParametersWriteStrings(benchmark::State& state) {
+  for (auto _ : state) {
+    Params params;
+    params.Write(kTypes, kShortString, kLongString, pg::Bigint{42});
+    benchmark::DoNotOptimize(params.ParamBuffers());
+  }
+}
+BENCHMARK_TEMPLATE(QueryParametersWriteStrings,
+                   pg::detail::StaticQueryParameters<3>);
+BENCHMARK_TEMPLATE(QueryParametersWriteStrings,
+                   pg::detail::DynamicQueryParameters);
+
+void QueryParametersWriteManyDynamic(benchmark::State& state) {
+  for (auto _ : state) {
+    pg::detail::DynamicQueryParameters params;
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+      params.Write(kTypes, pg::Bigint{i});
+    }
+    benchmark::DoNotOptimize(params.ParamBuffers());
+  }
+}
+BENCHMARK(QueryParametersWriteManyDynamic)->RangeMultiplier(4)->Range(4, 256);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -63,6 +63,15 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
       timings.ValueWithLabels(percentile, {"postgresql_query", name});
     }
   }
+  if (!stats.statement_phase_timings.empty()) {
+    auto phases = writer["statement_phase_timings"];
+    for (const auto& [name, timings] : stats.statement_phase_timings) {
+      phases["prepare"].ValueWithLabels(timings.prepare,
+                                        {"postgresql_query", name});
+      phases["execute"].ValueWithLabels(timings.execute,
+                                        {"postgresql_query", name});
+    }
+  }
 }
 
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
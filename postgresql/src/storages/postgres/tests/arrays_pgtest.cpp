@@ -645,6 +645,50 @@ TEST(PostgreIO, ArraysUnorderedSet) {
   }
 }
 
+TEST(PostgreIO, ArraysFixedWidth) {
+  const pg::io::TypeBufferCategory categories = GetTestTypeCategories();
+  {
+    const std::vector<pg::Bigint> src{1, -2, 0x0102030405060708};
+    pg::test::Buffer buffer;
+    UEXPECT_NO_THROW(io::WriteBuffer(types, buffer, src));
+    auto fb =
+        pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kArrayBuffer);
+    std::vector<pg::Bigint> tgt{42};
+    UEXPECT_NO_THROW(io::ReadBuffer(fb, tgt, categories));
+    EXPECT_EQ(src, tgt);
+  }
+  {
+    // Elements of another size go through the element parser
+    const std::vector<pg::Integer> src{1, 2, 3};
+    pg::test::Buffer buffer;
+    UEXPECT_NO_THROW(io::WriteBuffer(types, buffer, src));
+    auto fb =
+        pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kArrayBuffer);
+    std::vector<pg::Bigint> wide;
+    UEXPECT_NO_THROW(io::ReadBuffer(fb, wide, categories));
+    EXPECT_EQ(wide, (std::vector<pg::Bigint>{1, 2, 3}));
+  }
+  {
+    const std::vector<std::vector<pg::Smallint>> src{{1, 2}, {3, 4}};
+    pg::test::Buffer buffer;
+    UEXPECT_NO_THROW(io::WriteBuffer(types, buffer, src));
+    auto fb =
+        pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kArrayBuffer);
+    std::vector<std::vector<pg::Smallint>> tgt;
+    UEXPECT_NO_THROW(io::ReadBuffer(fb, tgt, categories));
+    EXPECT_EQ(src, tgt);
+  }
+  {
+    const static_test::one_dim_vector src{1, std::nullopt, 3};
+    pg::test::Buffer buffer;
+    UEXPECT_NO_THROW(io::WriteBuffer(types, buffer, src));
+    auto fb =
+        pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kArrayBuffer);
+    std::vector<pg::Integer> tgt;
+    UEXPECT_THROW(io::ReadBuffer(fb, tgt, categories), pg::TypeCannotBeNull);
+  }
+}
+
 UTEST_P(PostgreConnection, ArrayRoundtrip) {
   CheckConnection(GetConn());
   pg::ResultSet res{nullptr};
@@ -918,6 +962,25 @@ UTEST_P(PostgreConnection, ArrayOfBool) {
   EXPECT_EQ(src, tgt);
 }
 
+UTEST_P(PostgreConnection, ArrayBulkParsing) {
+  CheckConnection(GetConn());
+  pg::ResultSet res{nullptr};
+  UEXPECT_NO_THROW(res = GetConn()->Execute(
+                       "select array_agg(i), array_agg(i / 4.0::float8), "
+                       "array_agg(i::text) from generate_series(1, 1000) i"));
+  std::vector<pg::Bigint> ints;
+  std::vector<double> doubles;
+  std::vector<std::string_view> texts;
+  UEXPECT_NO_THROW(res.Front().To(ints, doubles, texts));
+  ASSERT_EQ(ints.size(), 1000);
+  ASSERT_EQ(doubles.size(), 1000);
+  ASSERT_EQ(texts.size(), 1000);
+  EXPECT_EQ(ints.front(), 1);
+  EXPECT_EQ(ints.back(), 1000);
+  EXPECT_EQ(doubles.back(), 250.0);
+  EXPECT_EQ(texts.back(), "1000");
+}
+
 void CheckSplit(const io::detail::ContainerSplitter<std::vector<int>>& split) {
   const auto& data = split.GetContainer();
 
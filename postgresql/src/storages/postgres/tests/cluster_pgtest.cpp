@@ -6,10 +6,13 @@
 
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/postgres_config.hpp>
+#include <userver/concurrent/variable.hpp>
 #include <userver/dynamic_config/test_helpers.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/dsn.hpp>
 #include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/notify_listener.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -262,6 +265,58 @@ UTEST_F(PostgreCluster, SingleQuery) {
   EXPECT_EQ(1, res.Size());
 }
 
+pg::Cluster CreateCachingCluster(const pg::DsnList& dsns,
+                                 engine::TaskProcessor& bg_task_processor,
+                                 testsuite::TestsuiteTasks& testsuite_tasks,
+                                 const std::string& invalidation_channel) {
+  pg::ClusterSettings settings{{},
+                               {utest::kMaxTestWaitTime},
+                               {0, 4, 4},
+                               kCachePreparedStatements,
+                               storages::postgres::InitMode::kAsync,
+                               "",
+                               {},
+                               {}};
+  settings.result_caches["cached_random"] = {std::chrono::seconds{100}, 10,
+                                             invalidation_channel};
+  return pg::Cluster(dsns, nullptr, bg_task_processor, settings,
+                     {kTestCmdCtl, {}, {}}, {}, {}, testsuite_tasks,
+                     dynamic_config::GetDefaultSource(), 0);
+}
+
+double ExecuteRandom(pg::Cluster& cluster, const std::string& name, int arg) {
+  return cluster
+      .Execute(pg::ClusterHostType::kMaster,
+               pg::Query{"select random() + $1", pg::Query::Name{name}}, arg)
+      .AsSingleRow<double>();
+}
+
+UTEST_F(PostgreCluster, ResultCache) {
+  testsuite::TestsuiteTasks testsuite_tasks{true};
+  auto cluster = CreateCachingCluster(GetDsnListFromEnv(), GetTaskProcessor(),
+                                      testsuite_tasks, {});
+
+  const auto first = ExecuteRandom(cluster, "cached_random", 1);
+  EXPECT_EQ(first, ExecuteRandom(cluster, "cached_random", 1));
+  EXPECT_NE(first, ExecuteRandom(cluster, "cached_random", 2));
+  EXPECT_NE(ExecuteRandom(cluster, "random", 1),
+            ExecuteRandom(cluster, "random", 1));
+}
+
+UTEST_F(PostgreCluster, ResultCacheInvalidation) {
+  testsuite::TestsuiteTasks testsuite_tasks{true};
+  auto cluster = CreateCachingCluster(GetDsnListFromEnv(), GetTaskProcessor(),
+                                      testsuite_tasks, "result_cache_test");
+
+  // The listener may subscribe after a notification, so it is repeated
+  const auto first = ExecuteRandom(cluster, "cached_random", 1);
+  while (ExecuteRandom(cluster, "cached_random", 1) == first) {
+    cluster.Execute(pg::ClusterHostType::kMaster,
+                    "select pg_notify('result_cache_test', NULL)");
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+}
+
 UTEST_F(PostgreCluster, HostSelectionSingleQuery) {
   testsuite::TestsuiteTasks testsuite_tasks{true};
   auto cluster = CreateCluster(GetDsnListFromEnv(), GetTaskProcessor(), 1,
@@ -296,11 +351,26 @@ UTEST_F(PostgreCluster, HostSelectionSingleQuery) {
                                          "select 1"));
   EXPECT_EQ(1, res.Size());
 
+  UEXPECT_NO_THROW(res = cluster.Execute({pg::ClusterHostType::kSlave,
+                                          pg::ClusterHostType::kLatencyAware},
+                                         "select 1"));
+  EXPECT_EQ(1, res.Size());
+  UEXPECT_NO_THROW(res = cluster.Execute({pg::ClusterHostType::kSlave,
+                                          pg::ClusterHostType::kMaster,
+                                          pg::ClusterHostType::kLatencyAware},
+                                         "select 1"));
+  EXPECT_EQ(1, res.Size());
+
   UEXPECT_THROW(cluster.Execute({pg::ClusterHostType::kSlave,
                                  pg::ClusterHostType::kRoundRobin,
                                  pg::ClusterHostType::kNearest},
                                 "select 1"),
                 pg::LogicError);
+  UEXPECT_THROW(cluster.Execute({pg::ClusterHostType::kSlave,
+                                 pg::ClusterHostType::kNearest,
+                                 pg::ClusterHostType::kLatencyAware},
+                                "select 1"),
+                pg::LogicError);
   UEXPECT_THROW(
       cluster.Execute(
           {pg::ClusterHostType::kSlave, pg::ClusterHostType::kMaster,
@@ -429,4 +499,54 @@ UTEST_F(PostgreCluster, ListenNotify) {
   UEXPECT_THROW(scope.WaitNotify(kNotifyDeadline), pg::ConnectionTimeoutError);
 }
 
+UTEST_F(PostgreCluster, NotifyListener) {
+  testsuite::TestsuiteTasks testsuite_tasks{true};
+  auto cluster = CreateCluster(GetDsnListFromEnv(), GetTaskProcessor(), 2,
+                               testsuite_tasks);
+
+  concurrent::Variable<std::vector<pg::NotificationBatch>> batches;
+  const auto get_batches = [&batches] {
+    const auto locked = batches.Lock();
+    return *locked;
+  };
+
+  pg::NotifyListenerSettings settings;
+  settings.batch_window = std::chrono::seconds{1};
+  pg::NotifyListener listener{
+      [&cluster](std::vector<std::string> channels) {
+        return cluster.Listen(std::move(channels));
+      },
+      {"foo", "bar"},
+      [&batches](const pg::NotificationBatch& batch) {
+        auto locked = batches.Lock();
+        locked->push_back(batch);
+      },
+      settings};
+
+  while (get_batches().empty()) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  EXPECT_TRUE(get_batches()[0].is_restart);
+
+  // Separate transactions, the server coalesces within a transaction itself
+  for (const auto* query :
+       {"select pg_notify('foo', 'x')", "select pg_notify('bar', NULL)",
+        "select pg_notify('foo', 'x')", "select pg_notify('foo', 'y')"}) {
+    cluster.Execute(pg::ClusterHostType::kMaster, query);
+  }
+  while (get_batches().size() < 2) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+
+  const auto batch = get_batches()[1];
+  EXPECT_FALSE(batch.is_restart);
+  ASSERT_EQ(batch.notifications.size(), 3);
+  EXPECT_EQ(batch.notifications[0].channel, "foo");
+  EXPECT_EQ(batch.notifications[0].payload, "x");
+  EXPECT_EQ(batch.notifications[1].channel, "bar");
+  EXPECT_FALSE(batch.notifications[1].payload);
+  EXPECT_EQ(batch.notifications[2].channel, "foo");
+  EXPECT_EQ(batch.notifications[2].payload, "y");
+}
+
 USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 #include <userver/engine/single_consumer_event.hpp>
 
 #include <storages/postgres/detail/connection.hpp>
+#include <storages/postgres/detail/statement_descriptions.hpp>
 #include <userver/storages/postgres/dsn.hpp>
 #include <userver/storages/postgres/exceptions.hpp>
 #include <userver/storages/postgres/io/chrono.hpp>
@@ -396,6 +397,27 @@ UTEST_P(PostgreConnection, CachedPlanChange) {
   UEXPECT_NO_THROW(GetConn()->Execute("SELECT * FROM plan_change_test"));
 }
 
+UTEST_P(PostgreConnection, SharedStatementDescriptions) {
+  pg::detail::StatementDescriptions descriptions{10};
+  const auto connect = [&] {
+    return pg::detail::Connection::Connect(
+        GetDsnFromEnv(), nullptr, GetTaskProcessor(), GetTaskStorage(),
+        kConnectionId, GetParam(), GetTestCmdCtls(), {}, {}, {},
+        &descriptions);
+  };
+  const pg::Query kQuery{"select 10 / $1::integer"};
+
+  auto first = connect();
+  EXPECT_EQ(5, first->Execute(kQuery, 2).AsSingleRow<int>());
+
+  // The second connection prepares the statement using the description
+  // obtained by the first one
+  auto second = connect();
+  UEXPECT_THROW(second->Execute(kQuery, 0), pg::DataException);
+  EXPECT_EQ(2, second->Execute(kQuery, 5).AsSingleRow<int>());
+  EXPECT_EQ(1, second->Execute(kQuery, 10).AsSingleRow<int>());
+}
+
 }  // namespace
 
 class PostgreCustomConnection : public PostgreSQLBase {};
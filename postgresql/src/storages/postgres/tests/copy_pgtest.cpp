@@ -0,0 +1,91 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/copy.hpp>
+#include <userver/storages/postgres/io/pg_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+const std::string kCreateTable =
+    "create temp table copy_test (id integer, name text)";
+const std::string kCopyFrom =
+    "copy copy_test (id, name) from stdin (format binary)";
+const std::string kCopyTo =
+    "copy (select id, name from copy_test order by id) to stdout "
+    "(format binary)";
+
+struct CopyRow {
+  pg::Integer id{};
+  std::optional<std::string> name;
+};
+
+constexpr std::size_t kRowsCount = 1000;
+
+UTEST_P(PostgreConnection, CopyFromTo) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn()), pg::TransactionOptions{}};
+  UEXPECT_NO_THROW(trx.Execute(kCreateTable));
+
+  // Small chunks to test the chunking
+  auto writer = trx.CopyFrom(kCopyFrom, 128);
+  for (std::size_t i = 0; i < kRowsCount; ++i) {
+    const auto id = static_cast<pg::Integer>(i);
+    if (i % 2) {
+      writer.Write(id, std::to_string(i));
+    } else {
+      writer.WriteRow(CopyRow{id, std::nullopt});
+    }
+  }
+  EXPECT_EQ(kRowsCount, writer.Finish());
+  EXPECT_ANY_THROW(writer.Write(pg::Integer{0}, std::string{}));
+
+  auto res = trx.Execute("select count(*), count(name) from copy_test");
+  EXPECT_EQ(kRowsCount, res.Front()[0].As<pg::Bigint>());
+  EXPECT_EQ(kRowsCount / 2, res.Front()[1].As<pg::Bigint>());
+
+  auto reader = trx.CopyTo(kCopyTo);
+  std::vector<CopyRow> rows;
+  CopyRow row;
+  while (reader.ReadRow(row)) rows.push_back(row);
+  ASSERT_EQ(kRowsCount, rows.size());
+  EXPECT_EQ(999, rows.back().id);
+  EXPECT_EQ("999", rows.back().name);
+  EXPECT_EQ(std::nullopt, rows.front().name);
+  EXPECT_FALSE(reader.ReadRow(row));
+
+  UEXPECT_NO_THROW(trx.Commit());
+}
+
+UTEST_P(PostgreConnection, CopyAbort) {
+  CheckConnection(GetConn());
+
+  pg::Transaction trx{std::move(GetConn()), pg::TransactionOptions{}};
+  UEXPECT_NO_THROW(trx.Execute(kCreateTable));
+  UEXPECT_NO_THROW(trx.Execute("savepoint copy"));
+  {
+    auto writer = trx.CopyFrom(kCopyFrom);
+    writer.Write(pg::Integer{1}, std::string{"1"});
+    UEXPECT_THROW(trx.Execute("select 1"), pg::ConnectionBusy);
+  }
+  UEXPECT_NO_THROW(trx.Execute("rollback to savepoint copy"));
+  auto res = trx.Execute("select count(*) from copy_test");
+  EXPECT_EQ(0, res.Front().As<pg::Bigint>());
+
+  UEXPECT_THROW(trx.CopyFrom("select 1"), pg::LogicError);
+  UEXPECT_THROW(trx.CopyTo("copy copy_test to stdout"), pg::LogicError);
+  UEXPECT_NO_THROW(trx.Execute("select 1"));
+  UEXPECT_NO_THROW(trx.Commit());
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,105 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fmt/format.h>
+
+#include <userver/utest/utest.hpp>
+
+#include <userver/dist_lock/dist_lock_strategy.hpp>
+#include <userver/dynamic_config/test_helpers.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/storages/postgres/cluster.hpp>
+#include <userver/storages/postgres/dist_lock_manager.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr std::chrono::seconds kLockTtl{10};
+constexpr std::string_view kTable = "dist_lock_manager_test";
+
+pg::ClusterPtr CreateCluster(const pg::DsnList& dsns,
+                             engine::TaskProcessor& bg_task_processor,
+                             testsuite::TestsuiteTasks& testsuite_tasks) {
+  auto source = dynamic_config::GetDefaultSource();
+  return std::make_shared<pg::Cluster>(
+      dsns, nullptr, bg_task_processor,
+      pg::ClusterSettings{{},
+                          {utest::kMaxTestWaitTime},
+                          {0, 4, 4},
+                          kCachePreparedStatements,
+                          pg::InitMode::kAsync,
+                          "",
+                          {},
+                          {}},
+      pg::DefaultCommandControls{kTestCmdCtl, {}, {}},
+      testsuite::PostgresControl{}, error_injection::Settings{},
+      testsuite_tasks, source, 0);
+}
+
+}  // namespace
+
+class PostgreDistLockManager : public PostgreSQLBase {};
+
+UTEST_F(PostgreDistLockManager, BatchedAcquire) {
+  testsuite::TestsuiteTasks testsuite_tasks{true};
+  auto cluster =
+      CreateCluster(GetDsnListFromEnv(), GetTaskProcessor(), testsuite_tasks);
+  cluster->Execute(pg::ClusterHostType::kMaster,
+                   fmt::format("DROP TABLE IF EXISTS {}", kTable));
+  cluster->Execute(pg::ClusterHostType::kMaster,
+                   fmt::format("CREATE TABLE {} (key TEXT PRIMARY KEY, "
+                               "owner TEXT, expiration_time TIMESTAMPTZ, "
+                               "fencing_token BIGINT NOT NULL DEFAULT 0)",
+                               kTable));
+
+  {
+    pg::DistLockManager manager{cluster, std::string{kTable}, kTestCmdCtl};
+
+    constexpr std::size_t kLocks = 32;
+    std::vector<std::unique_ptr<pg::BatchedDistLockStrategy>> strategies;
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (std::size_t i = 0; i < kLocks; ++i) {
+      strategies.push_back(std::make_unique<pg::BatchedDistLockStrategy>(
+          manager, fmt::format("lock-{}", i)));
+    }
+    for (auto& strategy : strategies) {
+      tasks.push_back(engine::AsyncNoSpan(
+          [&strategy] { strategy->Acquire(kLockTtl, "first"); }));
+    }
+    for (auto& task : tasks) UEXPECT_NO_THROW(task.Get());
+
+    const auto& stats = manager.GetStatistics();
+    EXPECT_EQ(stats.acquire_requests.Load(), kLocks);
+    EXPECT_LE(stats.batches.Load(), kLocks);
+    EXPECT_EQ(stats.locks.load(), static_cast<std::int64_t>(kLocks));
+    EXPECT_EQ(stats.locks_held.load(), static_cast<std::int64_t>(kLocks));
+
+    auto& first = *strategies.front();
+    EXPECT_EQ(first.GetFencingToken(), 1);
+
+    // Prolongation keeps the token
+    UEXPECT_NO_THROW(first.Acquire(kLockTtl, "first"));
+    EXPECT_EQ(first.GetFencingToken(), 1);
+
+    pg::BatchedDistLockStrategy second{manager, "lock-0"};
+    UEXPECT_THROW(second.Acquire(kLockTtl, "second"),
+                  dist_lock::LockIsAcquiredByAnotherHostException);
+    EXPECT_EQ(second.GetFencingToken(), std::nullopt);
+    EXPECT_EQ(manager.GetStatistics().acquire_failures.Load(), 1);
+
+    // A new owner gets a greater token
+    first.Release("first");
+    EXPECT_EQ(first.GetFencingToken(), std::nullopt);
+    UEXPECT_NO_THROW(second.Acquire(kLockTtl, "second"));
+    EXPECT_EQ(second.GetFencingToken(), 2);
+  }
+
+  cluster->Execute(pg::ClusterHostType::kMaster,
+                   fmt::format("DROP TABLE {}", kTable));
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <boost/endian/conversion.hpp>
+
+#include <storages/postgres/detail/pgoutput_decoder.hpp>
+#include <storages/postgres/detail/replication_connection.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+// Builds the messages in the wire format
+class MessageBuilder {
+ public:
+  explicit MessageBuilder(char type) { data_.push_back(type); }
+
+  template <typename T>
+  MessageBuilder& Int(T value) {
+    value = boost::endian::native_to_big(value);
+    data_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    return *this;
+  }
+
+  MessageBuilder& Byte(char value) {
+    data_.push_back(value);
+    return *this;
+  }
+
+  MessageBuilder& String(std::string_view value) {
+    data_.append(value);
+    data_.push_back('\0');
+    return *this;
+  }
+
+  MessageBuilder& Text(std::string_view value) {
+    Byte('t').Int(static_cast<std::int32_t>(value.size()));
+    data_.append(value);
+    return *this;
+  }
+
+  const std::string& Get() const { return data_; }
+
+ private:
+  std::string data_;
+};
+
+constexpr pg::Oid kRelationOid = 16385;
+
+std::string MakeRelation() {
+  return MessageBuilder{'R'}
+      .Int(kRelationOid)
+      .String("public")
+      .String("items")
+      .Byte('d')
+      .Int(std::int16_t{2})
+      .Byte(1)
+      .String("id")
+      .Int(pg::Oid{23})
+      .Int(std::int32_t{-1})
+      .Byte(0)
+      .String("value")
+      .Int(pg::Oid{25})
+      .Int(std::int32_t{-1})
+      .Get();
+}
+
+std::string MakeBegin(pg::Lsn lsn) {
+  return MessageBuilder{'B'}
+      .Int(lsn)
+      .Int(std::int64_t{0})
+      .Int(std::uint32_t{42})
+      .Get();
+}
+
+std::string MakeCommit(pg::Lsn lsn, pg::Lsn end_lsn) {
+  return MessageBuilder{'C'}
+      .Byte(0)
+      .Int(lsn)
+      .Int(end_lsn)
+      .Int(std::int64_t{1'000'000})
+      .Get();
+}
+
+}  // namespace
+
+TEST(PostgrePgOutput, Transaction) {
+  pg::detail::PgOutputDecoder decoder;
+  EXPECT_FALSE(decoder.Decode(MakeRelation()));
+  EXPECT_FALSE(decoder.Decode(MakeBegin(100)));
+  EXPECT_TRUE(decoder.IsInTransaction());
+
+  EXPECT_FALSE(decoder.Decode(MessageBuilder{'I'}
+                                  .Int(kRelationOid)
+                                  .Byte('N')
+                                  .Int(std::int16_t{2})
+                                  .Text("1")
+                                  .Byte('n')
+                                  .Get()));
+  EXPECT_FALSE(decoder.Decode(MessageBuilder{'U'}
+                                  .Int(kRelationOid)
+                                  .Byte('K')
+                                  .Int(std::int16_t{2})
+                                  .Text("1")
+                                  .Byte('n')
+                                  .Byte('N')
+                                  .Int(std::int16_t{2})
+                                  .Text("2")
+                                  .Byte('u')
+                                  .Get()));
+  EXPECT_FALSE(decoder.Decode(MessageBuilder{'D'}
+                                  .Int(kRelationOid)
+                                  .Byte('K')
+                                  .Int(std::int16_t{2})
+                                  .Text("2")
+                                  .Byte('n')
+                                  .Get()));
+  EXPECT_FALSE(decoder.Decode(MessageBuilder{'T'}
+                                  .Int(std::int32_t{1})
+                                  .Byte(0)
+                                  .Int(kRelationOid)
+                                  .Get()));
+
+  const auto transaction = decoder.Decode(MakeCommit(100, 120));
+  ASSERT_TRUE(transaction);
+  EXPECT_FALSE(decoder.IsInTransaction());
+  EXPECT_FALSE(transaction->is_restart);
+  EXPECT_EQ(transaction->commit_lsn, 100);
+  EXPECT_EQ(transaction->end_lsn, 120);
+  EXPECT_EQ(transaction->commit_time,
+            pg::detail::ReplicationTimeToTimePoint(1'000'000));
+  ASSERT_EQ(transaction->changes.size(), 4);
+
+  const auto& relation = *transaction->changes[0].relation;
+  EXPECT_EQ(relation.oid, kRelationOid);
+  EXPECT_EQ(relation.schema, "public");
+  EXPECT_EQ(relation.name, "items");
+  ASSERT_EQ(relation.columns.size(), 2);
+  EXPECT_TRUE(relation.columns[0].is_key);
+  EXPECT_EQ(relation.columns[1].name, "value");
+  EXPECT_EQ(relation.columns[1].type_oid, 25);
+  EXPECT_EQ(relation.FindColumn("value"), 1);
+  EXPECT_EQ(relation.FindColumn("missing"), std::nullopt);
+
+  const auto& insert = transaction->changes[0];
+  EXPECT_EQ(insert.kind, pg::RowChange::Kind::kInsert);
+  ASSERT_EQ(insert.new_tuple.size(), 2);
+  EXPECT_EQ(insert.new_tuple[0].kind, pg::ReplicationValue::Kind::kText);
+  EXPECT_EQ(insert.new_tuple[0].text, "1");
+  EXPECT_EQ(insert.new_tuple[1].kind, pg::ReplicationValue::Kind::kNull);
+  EXPECT_FALSE(insert.old_tuple);
+
+  const auto& update = transaction->changes[1];
+  EXPECT_EQ(update.kind, pg::RowChange::Kind::kUpdate);
+  ASSERT_TRUE(update.old_tuple);
+  EXPECT_EQ((*update.old_tuple)[0].text, "1");
+  EXPECT_EQ(update.new_tuple[0].text, "2");
+  EXPECT_EQ(update.new_tuple[1].kind, pg::ReplicationValue::Kind::kUnchanged);
+
+  const auto& remove = transaction->changes[2];
+  EXPECT_EQ(remove.kind, pg::RowChange::Kind::kDelete);
+  ASSERT_TRUE(remove.old_tuple);
+  EXPECT_EQ((*remove.old_tuple)[0].text, "2");
+  EXPECT_TRUE(remove.new_tuple.empty());
+
+  EXPECT_EQ(transaction->changes[3].kind, pg::RowChange::Kind::kTruncate);
+  EXPECT_EQ(transaction->changes[3].relation->name, "items");
+}
+
+TEST(PostgrePgOutput, Errors) {
+  pg::detail::PgOutputDecoder decoder;
+  // A change of an unknown relation
+  EXPECT_FALSE(decoder.Decode(MakeBegin(100)));
+  EXPECT_THROW(decoder.Decode(MessageBuilder{'I'}
+                                  .Int(kRelationOid)
+                                  .Byte('N')
+                                  .Int(std::int16_t{0})
+                                  .Get()),
+               pg::ReplicationError);
+  EXPECT_THROW(decoder.Decode(MakeBegin(200)), pg::ReplicationError);
+
+  pg::detail::PgOutputDecoder other;
+  EXPECT_THROW(other.Decode(MakeCommit(100, 120)), pg::ReplicationError);
+  EXPECT_THROW(other.Decode(MakeRelation().substr(0, 10)),
+               pg::ReplicationError);
+  EXPECT_THROW(other.Decode("X"), pg::ReplicationError);
+  EXPECT_THROW(other.Decode(""), pg::ReplicationError);
+}
+
+TEST(PostgrePgOutput, ProtocolMessages) {
+  const auto xlog = MessageBuilder{'w'}
+                        .Int(pg::Lsn{10})
+                        .Int(pg::Lsn{20})
+                        .Int(std::int64_t{0})
+                        .Get() +
+                    MakeBegin(10);
+  const auto data = pg::detail::ParseReplicationMessage(xlog);
+  EXPECT_EQ(data.kind, pg::detail::ReplicationMessage::Kind::kXLogData);
+  EXPECT_EQ(data.wal_start, 10);
+  EXPECT_EQ(data.wal_end, 20);
+  EXPECT_EQ(data.payload, MakeBegin(10));
+
+  const auto keepalive = pg::detail::ParseReplicationMessage(
+      MessageBuilder{'k'}.Int(pg::Lsn{30}).Int(std::int64_t{0}).Byte(1).Get());
+  EXPECT_EQ(keepalive.kind, pg::detail::ReplicationMessage::Kind::kKeepalive);
+  EXPECT_EQ(keepalive.wal_end, 30);
+  EXPECT_TRUE(keepalive.reply_requested);
+
+  EXPECT_THROW(pg::detail::ParseReplicationMessage("k"),
+               pg::ReplicationError);
+  EXPECT_THROW(pg::detail::ParseReplicationMessage("x"),
+               pg::ReplicationError);
+
+  const auto now = pg::detail::ReplicationTimeToTimePoint(5'000'000);
+  EXPECT_EQ(pg::detail::TimePointToReplicationTime(now), 5'000'000);
+  EXPECT_EQ(pg::detail::MakeStandbyStatusUpdate(30, 20, now),
+            MessageBuilder{'r'}
+                .Int(pg::Lsn{30})
+                .Int(pg::Lsn{20})
+                .Int(pg::Lsn{20})
+                .Int(std::int64_t{5'000'000})
+                .Byte(0)
+                .Get());
+}
+
+TEST(PostgrePgOutput, ReplicationDsn) {
+  EXPECT_EQ(pg::detail::MakeReplicationDsn(pg::Dsn{"host=localhost dbname=db"})
+                .GetUnderlying(),
+            "host=localhost dbname=db replication=database "
+            "target_session_attrs=read-write");
+  EXPECT_EQ(
+      pg::detail::MakeReplicationDsn(pg::Dsn{"postgresql://localhost/db"})
+          .GetUnderlying(),
+      "postgresql://localhost/db?replication=database&"
+      "target_session_attrs=read-write");
+  EXPECT_EQ(pg::detail::MakeReplicationDsn(
+                pg::Dsn{"postgresql://localhost/db?sslmode=disable"})
+                .GetUnderlying(),
+            "postgresql://localhost/db?sslmode=disable&replication=database&"
+            "target_session_attrs=read-write");
+}
+
+USERVER_NAMESPACE_END
@@ -383,6 +383,75 @@ UTEST_P(PostgrePool, CheckUserTypes) {
       pg::UserTypeError);
 }
 
+UTEST_P(PostgrePool, PipelineBatching) {
+  pg::PoolSettings pool_settings{1, 1, 10};
+  pool_settings.pipeline_batching_window = std::chrono::milliseconds{50};
+  pool_settings.pipeline_batch_max_size = 4;
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "", GetParam(),
+      pool_settings, kCachePreparedStatements, {}, GetTestCmdCtls(), {}, {},
+      {}, dynamic_config::GetDefaultSource());
+
+  const pg::UserTypes types;
+  std::vector<engine::TaskWithResult<pg::ResultSet>> tasks;
+  for (int i = 0; i < 10; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&pool, &types, i] {
+      pg::detail::StaticQueryParameters<1> params;
+      params.Write(types, i);
+      const pg::Query query{i == 5 ? "select 1/($1 - 5)" : "select $1"};
+      return pool->ExecuteBatched(query, pg::detail::QueryParameters{params});
+    }));
+  }
+  for (int i = 0; i < 10; ++i) {
+    if (i == 5) {
+      UEXPECT_THROW(tasks[i].Get(), pg::DataException);
+    } else {
+      EXPECT_EQ(i, tasks[i].Get().AsSingleRow<int>());
+    }
+  }
+
+  // The connection is usable after the batch
+  CheckConnection(pool->Acquire(MakeDeadline()));
+}
+
+UTEST_P(PostgrePool, SpareConnections) {
+  pg::PoolSettings pool_settings{0, 5, 10};
+  pool_settings.spare_size = 2;
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "", GetParam(),
+      pool_settings, kCachePreparedStatements, {}, GetTestCmdCtls(), {}, {},
+      {}, dynamic_config::GetDefaultSource());
+
+  auto conn = pool->Acquire(MakeDeadline());
+  // The spare connections are opened in background
+  while (pool->GetStatistics().connection.active < 3) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  CheckConnection(std::move(conn));
+  EXPECT_LE(pool->GetStatistics().connection.active, 3);
+}
+
+UTEST_P(PostgrePool, PrepareWarmup) {
+  pg::PoolSettings pool_settings{0, 2, 10};
+  pool_settings.prepare_warmup_size = 4;
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "", GetParam(),
+      pool_settings, kCachePreparedStatements, {}, GetTestCmdCtls(), {}, {},
+      {}, dynamic_config::GetDefaultSource());
+
+  const std::string statement = "select $1::integer + 1";
+  auto first = pool->Acquire(MakeDeadline());
+  EXPECT_EQ(2, first->Execute(statement, 1).AsSingleRow<int>());
+
+  // A new connection prepares the statement used by the first one
+  auto second = pool->Acquire(MakeDeadline());
+  EXPECT_EQ(1, second
+                   ->Execute("select count(*) from pg_prepared_statements "
+                             "where statement = $1",
+                             statement)
+                   .AsSingleRow<pg::Bigint>());
+}
+
 INSTANTIATE_UTEST_SUITE_P(
     PoolTests, PostgrePool,
     ::testing::Values(pg::InitMode::kAsync, pg::InitMode::kSync),
@@ -129,6 +129,34 @@ UTEST_F(PostgrePoolStats, RunSingleTransaction) {
   EXPECT_NE(stats.find(statement_name), stats.end());
 }
 
+UTEST_F(PostgrePoolStats, StatementPhaseTimings) {
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "",
+      storages::postgres::InitMode::kAsync, {1, 10, 10},
+      kCachePreparedStatements, {10}, GetTestCmdCtls(), {}, {}, {},
+      dynamic_config::GetDefaultSource());
+
+  const std::string statement_name = "statement_name";
+  const auto query = pg::Query{"select 1", pg::Query::Name{statement_name}};
+
+  pg::detail::ConnectionPtr conn{nullptr};
+  UASSERT_NO_THROW(conn = pool->Acquire(MakeDeadline()))
+      << "Obtained connection from pool";
+  CheckConnection(conn);
+
+  auto ntrx = pg::detail::NonTransaction{std::move(conn)};
+
+  UEXPECT_NO_THROW(ntrx.Execute(query));
+  UEXPECT_NO_THROW(ntrx.Execute(query));
+  pool->GetStatementTimingsStorage().WaitForExhaustion();
+  const auto stats = pool->GetStatementTimingsStorage().GetPhaseTimings();
+  const auto it = stats.find(statement_name);
+  ASSERT_NE(it, stats.end());
+  // The statement is prepared once per connection
+  EXPECT_EQ(it->second.prepare.Count(), 1);
+  EXPECT_EQ(it->second.execute.Count(), 2);
+}
+
 UTEST_F(PostgrePoolStats, RunTransactions) {
   auto pool = pg::detail::ConnectionPool::Create(
       GetDsnFromEnv(), nullptr, GetTaskProcessor(), "",
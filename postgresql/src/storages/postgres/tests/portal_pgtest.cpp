@@ -289,6 +289,33 @@ UTEST_P(PostgreConnection, PortalParallel) {
   EXPECT_EQ(second.FetchedSoFar(), kIterations);
 }
 
+UTEST_P(PostgreConnection, TypedPortalRows) {
+  constexpr int kRows = 25;
+  constexpr char kQuery[] =
+      "SELECT i, 'row ' || i::text FROM generate_series(1, $1) i";
+
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+  auto portal = trx.MakePortal(kQuery, kRows);
+
+  int expected = 0;
+  for (const auto& [id, name] :
+       pg::TypedPortalRows<std::tuple<int, std::string_view>, pg::RowTag>{
+           portal, 10}) {
+    ++expected;
+    EXPECT_EQ(expected, id);
+    EXPECT_EQ("row " + std::to_string(expected), name);
+  }
+  EXPECT_EQ(kRows, expected);
+  EXPECT_TRUE(portal.Done());
+
+  auto empty_portal = trx.MakePortal(kQuery, 0);
+  pg::TypedPortalRows<int> empty_rows{empty_portal, 10};
+  EXPECT_EQ(empty_rows.begin(), empty_rows.end());
+
+  UEXPECT_NO_THROW(trx.Commit());
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
@@ -120,6 +120,27 @@ TEST(PostgreIO, OutputFloatStatic) {
             params.ParamTypesBuffer()[0]);
 }
 
+TEST(PostgreIO, OutputManyDynamic) {
+  constexpr int kParamsCount = 100;
+  pg::detail::DynamicQueryParameters params;
+  for (int i = 0; i < kParamsCount; ++i) {
+    params.Write(types, std::string(i, 'a' + i % 26));
+    params.Write(types, std::optional<pg::Integer>{});
+  }
+
+  // values are kept in a single buffer, must stay valid after reallocations
+  // and a move
+  const auto moved = std::move(params);
+  ASSERT_EQ(2 * kParamsCount, moved.Size());
+  for (int i = 0; i < kParamsCount; ++i) {
+    EXPECT_EQ(i, moved.ParamLengthsBuffer()[2 * i]);
+    EXPECT_EQ(std::string(i, 'a' + i % 26),
+              std::string(moved.ParamBuffers()[2 * i],
+                          moved.ParamLengthsBuffer()[2 * i]));
+    EXPECT_EQ(nullptr, moved.ParamBuffers()[2 * i + 1]);
+  }
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+
+#include <storages/postgres/detail/result_cache.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+const pg::UserTypes types;
+
+template <typename... Args>
+std::string MakeKey(pg::ClusterHostTypeFlags flags, const Args&... args) {
+  pg::detail::StaticQueryParameters<sizeof...(args)> params;
+  params.Write(types, args...);
+  return pg::detail::MakeResultCacheKey(flags,
+                                        pg::detail::QueryParameters{params});
+}
+
+}  // namespace
+
+TEST(PostgreResultCache, Key) {
+  const pg::ClusterHostTypeFlags slave{pg::ClusterHostType::kSlave};
+  const pg::ClusterHostTypeFlags nearest_slave{pg::ClusterHostType::kSlave,
+                                               pg::ClusterHostType::kNearest};
+  const pg::ClusterHostTypeFlags master{pg::ClusterHostType::kMaster};
+
+  EXPECT_EQ(MakeKey(slave), MakeKey(slave));
+  EXPECT_EQ(MakeKey(slave, 1, std::string{"a"}),
+            MakeKey(slave, 1, std::string{"a"}));
+  // The strategy does not matter
+  EXPECT_EQ(MakeKey(slave, 1), MakeKey(nearest_slave, 1));
+
+  EXPECT_NE(MakeKey(slave, 1), MakeKey(master, 1));
+  EXPECT_NE(MakeKey(slave, 1), MakeKey(slave, 2));
+  EXPECT_NE(MakeKey(slave, 1), MakeKey(slave, pg::Bigint{1}));
+  EXPECT_NE(MakeKey(slave, std::string{"ab"}, std::string{"c"}),
+            MakeKey(slave, std::string{"a"}, std::string{"bc"}));
+  EXPECT_NE(MakeKey(slave, std::optional<std::string>{}),
+            MakeKey(slave, std::string{}));
+}
+
+USERVER_NAMESPACE_END
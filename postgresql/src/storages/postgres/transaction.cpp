@@ -68,7 +68,7 @@ ResultSet Transaction::DoExecute(const Query& query,
   auto source = conn_.GetConfigSource();
   if (source) CheckDeadlineIsExpired(source->GetSnapshot());
 
-  detail::StatementTimer timer{query, conn_};
+  detail::StatementTimer timer{query, params, conn_};
   auto res = conn_->Execute(query, params, std::move(statement_cmd_ctl));
   timer.Account();
   return res;
@@ -129,6 +129,27 @@ void Transaction::Rollback() {
   }
 }
 
+CopyWriter Transaction::CopyFrom(const Query& query, std::size_t chunk_size,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Copy called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  return CopyWriter{conn_.get(), query, chunk_size,
+                    std::move(statement_cmd_ctl)};
+}
+
+CopyReader Transaction::CopyTo(const Query& query,
+                               OptionalCommandControl statement_cmd_ctl) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Copy called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  return CopyReader{conn_.get(), query, std::move(statement_cmd_ctl)};
+}
+
 const UserTypes& Transaction::GetConnectionUserTypes() const {
   if (!conn_) {
     LOG_LIMITED_ERROR() << "Get user types called after transaction finished"
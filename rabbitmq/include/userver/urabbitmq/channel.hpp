@@ -15,6 +15,32 @@ namespace urabbitmq {
 
 class ConnectionPtr;
 
+namespace impl {
+class DeferredWrapper;
+}
+
+/// @brief A handle to the broker confirmation of a single message published
+/// with `ReliableChannel::PublishReliableAsync`.
+class PublishConfirmation final {
+ public:
+  ~PublishConfirmation();
+
+  PublishConfirmation(PublishConfirmation&& other) noexcept;
+  PublishConfirmation& operator=(PublishConfirmation&& other) noexcept;
+
+  /// @brief Waits for the broker to confirm the message.
+  ///
+  /// Throws if the message was rejected by the broker, the channel failed
+  /// or the deadline expired.
+  void Wait(engine::Deadline deadline);
+
+ private:
+  friend class ReliableChannel;
+  explicit PublishConfirmation(std::shared_ptr<impl::DeferredWrapper> wrapper);
+
+  std::shared_ptr<impl::DeferredWrapper> wrapper_;
+};
+
 /// @brief Publisher interface for the broker.
 /// You may use this class to publish your messages.
 ///
@@ -77,6 +103,28 @@ class ReliableChannel final : IReliableChannelInterface {
                     deadline);
   }
 
+  /// @brief Publishes a message without waiting for the broker to confirm it.
+  ///
+  /// Many messages could be awaiting their confirmations at once, which gives
+  /// a much higher throughput than `PublishReliable`, while the delivery
+  /// guarantees are the same once the returned confirmation is awaited.
+  /// The messages are published in order. The number of unconfirmed messages
+  /// is limited by `max_unconfirmed_publishes`, the call blocks until
+  /// the deadline once the limit is reached.
+  ///
+  /// The confirmations may be awaited after the channel is destroyed.
+  [[nodiscard]] PublishConfirmation PublishReliableAsync(
+      const Exchange& exchange, const std::string& routing_key,
+      const std::string& message, MessageType type, engine::Deadline deadline);
+
+  /// @overload
+  [[nodiscard]] PublishConfirmation PublishReliableAsync(
+      const Exchange& exchange, const std::string& routing_key,
+      const std::string& message, engine::Deadline deadline) {
+    return PublishReliableAsync(exchange, routing_key, message,
+                                MessageType::kTransient, deadline);
+  }
+
  private:
   utils::FastPimpl<ConnectionPtr, 32, 8> impl_;
 };
@@ -57,6 +57,11 @@ struct PoolSettings final {
   /// (tcp error/protocol error/write timeout) leads to a errors burst:
   /// all outstanding request will fails at once
   size_t max_in_flight_requests = 5;
+
+  /// A per-connection limit for messages published with
+  /// `ReliableChannel::PublishReliableAsync` and not yet confirmed by the
+  /// broker. Publishing blocks once the limit is reached.
+  size_t max_unconfirmed_publishes = 1000;
 };
 
 class TestsHelper;
@@ -6,6 +6,7 @@
 #include <memory>
 
 #include <userver/components/loggable_component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -34,10 +35,17 @@ namespace urabbitmq {
 /// @snippet samples/rabbitmq_service/static_config.yaml  RabbitMQ consumer sample - static config
 ///
 /// ## Static options:
-/// Name             | Description
-/// rabbit_name      | Name of the RabbitMQ component to use for consumption
-/// queue            | Name of the queue to consume from
-/// prefetch_count   | prefetch_count for the consumer, limits the amount of in-flight messages
+/// Name              | Description
+/// rabbit_name       | Name of the RabbitMQ component to use for consumption
+/// queue             | Name of the queue to consume from
+/// prefetch_count    | prefetch_count for the consumer, limits the amount of in-flight messages
+/// task_processor    | task processor to process the messages on, the task processor of the component by default
+/// max_parallelism   | limit for concurrently processed messages, 0 (the default) means it is only limited by prefetch_count
+/// batch_acks        | whether to acknowledge processed messages with `ack multiple` once a contiguous prefix of deliveries is processed, false by default
+/// autotune_prefetch | whether to adjust prefetch count between max_parallelism and prefetch_count based on the processing latency, false by default
+///
+/// Statistics of the consumer are reported as
+/// `rabbitmq_consumer.<component name>`.
 ///
 // clang-format on
 class ConsumerComponentBase : public components::LoggableComponentBase {
@@ -70,6 +78,7 @@ class ConsumerComponentBase : public components::LoggableComponentBase {
   // This is actually just a subclass of `ConsumerBase`
   class Impl;
   std::unique_ptr<Impl> impl_;
+  utils::statistics::Entry statistics_holder_;
 };
 
 }  // namespace urabbitmq
@@ -5,6 +5,7 @@
 
 #include <cstddef>
 
+#include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/urabbitmq/typedefs.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -24,6 +25,31 @@ struct ConsumerSettings final {
   /// Settings this value to 1 basically makes a consumer synchronous, which
   /// could be of use for some workloads
   std::uint16_t prefetch_count;
+
+  /// Task processor to run `Process` on. If not set, the task processor
+  /// of the task that starts the consumer is used
+  engine::TaskProcessor* task_processor{nullptr};
+
+  /// Limit for concurrently running `Process` calls, the remaining prefetched
+  /// messages wait for a free slot. If set to zero, parallelism is only
+  /// limited by `prefetch_count`
+  std::uint16_t max_parallelism{0};
+
+  /// Whether to acknowledge processed messages with a single `ack multiple`
+  /// once a contiguous prefix of deliveries is processed, instead of
+  /// acknowledging every message separately.
+  ///
+  /// Up to `prefetch_count / 4` processed messages might wait for the
+  /// acknowledgement while others are being processed, and all of them are
+  /// redelivered if the consumer fails in the meantime
+  bool batch_acks{false};
+
+  /// Whether to adjust the prefetch count of the channel at runtime
+  /// based on the processing latency, between `max_parallelism` and
+  /// `prefetch_count`: it is decreased when prefetched messages wait for
+  /// a free processing slot for too long, and increased when the prefetch
+  /// window is full while processing slots are idle
+  bool autotune_prefetch{false};
 };
 
 }  // namespace urabbitmq
@@ -234,4 +234,70 @@ UTEST(Consumer, ForDifferentQueuesWork) {
       .RemoveQueue(second_queue, client.GetDeadline());
 }
 
+UTEST(Consumer, PublishReliableAsyncWorks) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  const urabbitmq::ConsumerSettings settings{client.GetQueue(), 10};
+
+  const size_t messages_count = 1000;
+  std::vector<std::string> messages;
+  messages.reserve(messages_count);
+  std::vector<urabbitmq::PublishConfirmation> confirmations;
+  confirmations.reserve(messages_count);
+  {
+    auto channel = client->GetReliableChannel(client.GetDeadline());
+    for (size_t i = 0; i < messages_count; ++i) {
+      messages.push_back(std::to_string(i));
+      confirmations.push_back(channel.PublishReliableAsync(
+          client.GetExchange(), client.GetRoutingKey(), messages.back(),
+          client.GetDeadline()));
+    }
+  }
+  for (auto& confirmation : confirmations) {
+    UEXPECT_NO_THROW(confirmation.Wait(client.GetDeadline()));
+  }
+
+  Consumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(messages_count);
+  consumer.Start();
+
+  // a single channel publishes in order
+  EXPECT_EQ(consumer.Wait(), messages);
+}
+
+UTEST(Consumer, BatchedAcksWork) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  urabbitmq::ConsumerSettings settings{client.GetQueue(), 20};
+  settings.max_parallelism = 4;
+  settings.batch_acks = true;
+  settings.autotune_prefetch = true;
+
+  const size_t messages_count = 500;
+  {
+    std::vector<urabbitmq::PublishConfirmation> confirmations;
+    auto channel = client->GetReliableChannel(client.GetDeadline());
+    for (size_t i = 0; i < messages_count; ++i) {
+      confirmations.push_back(channel.PublishReliableAsync(
+          client.GetExchange(), client.GetRoutingKey(), std::to_string(i),
+          client.GetDeadline()));
+    }
+    for (auto& confirmation : confirmations) {
+      confirmation.Wait(client.GetDeadline());
+    }
+  }
+
+  Consumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(messages_count);
+  consumer.Start();
+  EXPECT_EQ(consumer.Wait().size(), messages_count);
+  consumer.Stop();
+
+  // All the messages are acked, nothing is redelivered
+  Consumer second_consumer{client.Get(), {client.GetQueue(), 10}};
+  second_consumer.Start();
+  engine::InterruptibleSleepFor(std::chrono::milliseconds{200});
+  EXPECT_TRUE(second_consumer.Get().empty());
+}
+
 USERVER_NAMESPACE_END
@@ -1,12 +1,34 @@
 #include <userver/urabbitmq/channel.hpp>
 
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
 #include <urabbitmq/connection_helper.hpp>
 #include <urabbitmq/connection_ptr.hpp>
+#include <urabbitmq/impl/deferred_wrapper.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace urabbitmq {
 
+PublishConfirmation::PublishConfirmation(
+    std::shared_ptr<impl::DeferredWrapper> wrapper)
+    : wrapper_{std::move(wrapper)} {}
+
+PublishConfirmation::~PublishConfirmation() = default;
+
+PublishConfirmation::PublishConfirmation(PublishConfirmation&& other) noexcept =
+    default;
+
+PublishConfirmation& PublishConfirmation::operator=(
+    PublishConfirmation&& other) noexcept = default;
+
+void PublishConfirmation::Wait(engine::Deadline deadline) {
+  UINVARIANT(wrapper_, "PublishConfirmation is moved out or already awaited");
+  std::exchange(wrapper_, nullptr)->Wait(deadline);
+}
+
 Channel::Channel(ConnectionPtr&& channel) : impl_{std::move(channel)} {}
 
 Channel::~Channel() = default;
@@ -44,6 +66,13 @@ void ReliableChannel::PublishReliable(const Exchange& exchange,
       .Wait(deadline);
 }
 
+PublishConfirmation ReliableChannel::PublishReliableAsync(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::string& message, MessageType type, engine::Deadline deadline) {
+  return PublishConfirmation{ConnectionHelper::PublishReliableAsync(
+      *impl_, exchange, routing_key, message, type, deadline)};
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
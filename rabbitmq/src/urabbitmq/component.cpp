@@ -72,6 +72,12 @@ properties:
         description: |
           per-connection limit for requests awaiting response from the broker
         defaultDescription: 5
+    max_unconfirmed_publishes:
+        type: integer
+        description: |
+          per-connection limit for asynchronously published messages
+          awaiting confirmation from the broker
+        defaultDescription: 1000
     use_secure_connection:
         type: boolean
         description: whether to use TLS for connections
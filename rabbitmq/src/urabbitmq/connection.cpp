@@ -7,11 +7,13 @@ namespace urabbitmq {
 Connection::Connection(clients::dns::Resolver& resolver,
                        const EndpointInfo& endpoint,
                        const AuthSettings& auth_settings,
-                       size_t max_in_flight_requests, bool secure,
+                       size_t max_in_flight_requests,
+                       size_t max_unconfirmed_publishes, bool secure,
                        statistics::ConnectionStatistics& stats,
                        engine::Deadline deadline)
     : handler_{resolver, endpoint, auth_settings, secure, stats, deadline},
-      connection_{handler_, max_in_flight_requests, deadline},
+      connection_{handler_, max_in_flight_requests, max_unconfirmed_publishes,
+                  deadline},
       channel_{connection_},
       reliable_channel_{connection_} {}
 
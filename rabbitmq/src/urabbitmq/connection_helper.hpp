@@ -57,6 +57,12 @@ class ConnectionHelper final {
       const std::string& routing_key, const std::string& message,
       MessageType type, engine::Deadline deadline);
 
+  [[nodiscard]] static std::shared_ptr<impl::DeferredWrapper>
+  PublishReliableAsync(const ConnectionPtr& connection,
+                       const Exchange& exchange, const std::string& routing_key,
+                       const std::string& message, MessageType type,
+                       engine::Deadline deadline);
+
  private:
   template <typename Func>
   static impl::ResponseAwaiter WithSpan(const char* name, Func&& fn) {
@@ -89,6 +89,7 @@ ConnectionPool::ConnectionUniquePtr ConnectionPool::DoCreateConnection(
     engine::Deadline deadline) {
   return std::make_unique<Connection>(resolver_, endpoint_info_, auth_settings_,
                                       pool_settings_.max_in_flight_requests,
+                                      pool_settings_.max_unconfirmed_publishes,
                                       use_secure_connection_, stats_, deadline);
 }
 
@@ -1,9 +1,11 @@
 #include "consumer_base_impl.hpp"
 
+#include <algorithm>
 #include <string>
 
 #include <fmt/format.h>
 
+#include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
@@ -12,6 +14,7 @@
 #include <urabbitmq/connection.hpp>
 #include <urabbitmq/impl/amqp_channel.hpp>
 #include <urabbitmq/impl/deferred_wrapper.hpp>
+#include <urabbitmq/statistics/consumer_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -20,16 +23,35 @@ namespace urabbitmq {
 namespace {
 
 constexpr std::chrono::milliseconds kStartTimeout{2000};
+constexpr std::chrono::milliseconds kSetQosTimeout{1000};
+constexpr std::chrono::seconds kPrefetchTuneInterval{1};
+
+std::int64_t ToMicroseconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+      .count();
+}
 
 }  // namespace
 
 ConsumerBaseImpl::ConsumerBaseImpl(ConnectionPtr&& connection,
-                                   const ConsumerSettings& settings)
-    : dispatcher_{engine::current_task::GetTaskProcessor()},
+                                   const ConsumerSettings& settings,
+                                   statistics::ConsumerStatistics& stats)
+    : dispatcher_{settings.task_processor
+                      ? *settings.task_processor
+                      : engine::current_task::GetTaskProcessor()},
       queue_name_{settings.queue.GetUnderlying()},
+      max_prefetch_count_{settings.prefetch_count},
+      min_prefetch_count_{std::clamp<uint16_t>(settings.max_parallelism, 1,
+                                               settings.prefetch_count)},
+      batch_acks_{settings.batch_acks},
+      autotune_prefetch_{settings.autotune_prefetch},
       prefetch_count_{settings.prefetch_count},
       connection_ptr_{std::move(connection)},
-      channel_{connection_ptr_->GetChannel()} {
+      channel_{connection_ptr_->GetChannel()},
+      stats_{stats},
+      parallelism_sema_{settings.max_parallelism != 0
+                            ? settings.max_parallelism
+                            : settings.prefetch_count} {
   // We take ownership of the connection, because if it remains pooled
   // things get messy with lifetimes and callbacks
   connection_ptr_.Adopt();
@@ -39,7 +61,8 @@ ConsumerBaseImpl::~ConsumerBaseImpl() { Stop(); }
 
 void ConsumerBaseImpl::Start(DispatchCallback cb) {
   const auto start_deadline = engine::Deadline::FromDuration(kStartTimeout);
-  channel_.SetQos(prefetch_count_, start_deadline);
+  channel_.SetQos(max_prefetch_count_, false, start_deadline);
+  stats_.SetPrefetchCount(max_prefetch_count_);
 
   dispatch_callback_ = std::move(cb);
 
@@ -65,11 +88,18 @@ void ConsumerBaseImpl::Start(DispatchCallback cb) {
       },
       start_deadline);
 
+  if (autotune_prefetch_ && min_prefetch_count_ < max_prefetch_count_) {
+    prefetch_tuner_.Start(
+        fmt::format("{}_consumer_prefetch_tuner", queue_name_),
+        {kPrefetchTuneInterval}, [this] { TunePrefetch(); });
+  }
+
   LOG_INFO() << "Started a consumer for '" << queue_name_ << "' queue";
 }
 
 void ConsumerBaseImpl::Stop() {
   stopped_ = true;
+  prefetch_tuner_.Stop();
   try {
     channel_.CancelConsumer(consumer_tag_);
   } catch (const std::exception&) {
@@ -78,6 +108,17 @@ void ConsumerBaseImpl::Stop() {
 
   // Cancel all the active dispatched tasks
   bts_.CancelAndWait();
+  stats_.AccountMessagesDropped(in_flight_.exchange(0));
+
+  if (batch_acks_) {
+    // Best effort, otherwise the processed messages would be redelivered
+    try {
+      std::lock_guard lock{acks_mutex_};
+      AckPending();
+    } catch (const std::exception&) {
+      // Connection is broken, the messages will be requeued by RabbitMQ
+    }
+  }
 
   // Destroy the connection: at this point all the remaining tasks are stopped,
   // consumer is either stopped or in unknown state - that could happen if we
@@ -93,6 +134,13 @@ bool ConsumerBaseImpl::IsBroken() const {
 
 void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
                                  uint64_t delivery_tag) {
+  const auto received_at = std::chrono::steady_clock::now();
+  ++in_flight_;
+  if (++unacked_ >= prefetch_count_.load()) {
+    prefetch_window_full_ = true;
+  }
+  stats_.AccountMessageReceived();
+
   std::string span_name{fmt::format("consume_{}_{}", queue_name_,
                                     consumer_tag_.value_or("ctag:unknown"))};
   std::string trace_id = message.headers().get("u-trace-id");
@@ -101,31 +149,137 @@ void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
   bts_.Detach(engine::AsyncNoSpan(
       dispatcher_, [this, message = std::move(message_data),
                     span_name = std::move(span_name),
-                    trace_id = std::move(trace_id), delivery_tag]() mutable {
+                    trace_id = std::move(trace_id), delivery_tag,
+                    received_at]() mutable {
         auto span = tracing::Span::MakeSpan(std::move(span_name), trace_id, {});
+        Process(std::move(message), delivery_tag, received_at);
+      }));
+}
 
-        bool success = false;
-        try {
-          dispatch_callback_(std::move(message));
-          success = true;
-        } catch (const std::exception& ex) {
-          LOG_ERROR() << "Failed to process the consumed message, " << ex.what()
-                      << "; would requeue";
-        }
+void ConsumerBaseImpl::Process(
+    std::string&& message, uint64_t delivery_tag,
+    std::chrono::steady_clock::time_point received_at) {
+  engine::SemaphoreLock slot{parallelism_sema_, engine::Deadline{}};
+  // We are cancelled, the message will be requeued by RabbitMQ
+  if (!slot.OwnsLock()) return;
 
-        try {
-          if (success) {
-            channel_.Ack(delivery_tag, {});
-            channel_.AccountMessageConsumed();
-          } else {
-            channel_.Reject(delivery_tag, true, {});
-          }
-        } catch (const std::exception& ex) {
-          LOG_WARNING()
-              << "Failed to " << (success ? "ack" : "requeue")
-              << " the message, it will be requeued by RabbitMQ at some point";
-        }
-      }));
+  const auto started_at = std::chrono::steady_clock::now();
+  stats_.AccountProcessingStarted(
+      std::chrono::duration_cast<std::chrono::milliseconds>(started_at -
+                                                            received_at));
+
+  bool success = false;
+  try {
+    dispatch_callback_(std::move(message));
+    success = true;
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to process the consumed message, " << ex.what()
+                << "; would requeue";
+  }
+  slot.Unlock();
+
+  const auto finished_at = std::chrono::steady_clock::now();
+  lag_us_sum_ += ToMicroseconds(started_at - received_at);
+  processing_us_sum_ += ToMicroseconds(finished_at - started_at);
+  ++processed_count_;
+  --in_flight_;
+  stats_.AccountMessageProcessed(
+      success, std::chrono::duration_cast<std::chrono::milliseconds>(
+                   finished_at - started_at));
+
+  try {
+    Settle(delivery_tag, success);
+  } catch (const std::exception& ex) {
+    LOG_WARNING()
+        << "Failed to " << (success ? "ack" : "requeue")
+        << " the message, it will be requeued by RabbitMQ at some point";
+  }
+}
+
+void ConsumerBaseImpl::Settle(uint64_t delivery_tag, bool success) {
+  if (batch_acks_) {
+    SettleBatched(delivery_tag, success);
+    return;
+  }
+
+  --unacked_;
+  if (success) {
+    channel_.Ack(delivery_tag, false, {});
+    channel_.AccountMessageConsumed();
+    stats_.AccountAckSent();
+  } else {
+    channel_.Reject(delivery_tag, true, {});
+  }
+}
+
+void ConsumerBaseImpl::SettleBatched(uint64_t delivery_tag, bool success) {
+  std::lock_guard lock{acks_mutex_};
+
+  if (!success) {
+    // Rejected right away, an `ack multiple` covering it later is fine:
+    // it only affects the outstanding messages
+    --unacked_;
+    channel_.Reject(delivery_tag, true, {});
+  }
+  settled_tags_.emplace(delivery_tag, success);
+
+  for (auto it = settled_tags_.begin();
+       it != settled_tags_.end() && it->first == settled_prefix_end_ + 1;
+       it = settled_tags_.erase(it)) {
+    settled_prefix_end_ = it->first;
+    if (it->second) {
+      last_ackable_tag_ = it->first;
+      ++pending_acks_;
+    }
+  }
+
+  const std::size_t ack_batch_size =
+      std::max(1, prefetch_count_.load() / 4);
+  // Nothing else is being processed and could extend the prefix soon
+  const bool is_idle = in_flight_.load() == 0;
+  if (pending_acks_ >= ack_batch_size || is_idle) {
+    AckPending();
+  }
+}
+
+void ConsumerBaseImpl::AckPending() {
+  if (last_ackable_tag_ <= last_acked_tag_) return;
+
+  channel_.Ack(last_ackable_tag_, true, {});
+  last_acked_tag_ = last_ackable_tag_;
+  unacked_ -= pending_acks_;
+  for (; pending_acks_ > 0; --pending_acks_) {
+    channel_.AccountMessageConsumed();
+  }
+  stats_.AccountAckSent();
+}
+
+void ConsumerBaseImpl::TunePrefetch() {
+  const auto processed = processed_count_.exchange(0);
+  const auto lag_us = lag_us_sum_.exchange(0);
+  const auto processing_us = processing_us_sum_.exchange(0);
+  const bool window_full = prefetch_window_full_.exchange(false);
+  if (processed == 0) return;
+
+  const uint16_t prefetch = prefetch_count_.load();
+  const uint16_t step = std::max(1, prefetch / 4);
+  uint16_t new_prefetch = prefetch;
+  if (lag_us > processing_us) {
+    // Prefetched messages wait for a free processing slot longer than they
+    // are processed: they could have been delivered to other consumers
+    new_prefetch = std::max<int>(min_prefetch_count_, prefetch - step);
+  } else if (window_full && lag_us * 4 < processing_us) {
+    // The broker waits for acks while there are free processing slots
+    new_prefetch = std::min<int>(max_prefetch_count_, prefetch + step);
+  }
+  if (new_prefetch == prefetch) return;
+
+  LOG_DEBUG() << "Changing prefetch_count of the consumer for '" << queue_name_
+              << "' queue from " << prefetch << " to " << new_prefetch;
+  channel_.SetQos(new_prefetch, true,
+                  engine::Deadline::FromDuration(kSetQosTimeout));
+  prefetch_count_ = new_prefetch;
+  stats_.SetPrefetchCount(new_prefetch);
 }
 
 }  // namespace urabbitmq
@@ -1,9 +1,14 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <map>
 
 #include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/semaphore.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/utils/periodic_task.hpp>
 
 #include <urabbitmq/connection_ptr.hpp>
 
@@ -19,10 +24,14 @@ namespace impl {
 class AmqpChannel;
 }
 
+namespace statistics {
+class ConsumerStatistics;
+}
+
 class ConsumerBaseImpl final {
  public:
-  ConsumerBaseImpl(ConnectionPtr&& connection,
-                   const ConsumerSettings& settings);
+  ConsumerBaseImpl(ConnectionPtr&& connection, const ConsumerSettings& settings,
+                   statistics::ConsumerStatistics& stats);
   ~ConsumerBaseImpl();
 
   using DispatchCallback = std::function<void(std::string message)>;
@@ -35,9 +44,22 @@ class ConsumerBaseImpl final {
   void OnMessage(const AMQP::Message& message, uint64_t delivery_tag);
   void Stop();
 
+  void Process(std::string&& message, uint64_t delivery_tag,
+               std::chrono::steady_clock::time_point received_at);
+  void Settle(uint64_t delivery_tag, bool success);
+  void SettleBatched(uint64_t delivery_tag, bool success);
+  // Should be called with acks_mutex_ held
+  void AckPending();
+
+  void TunePrefetch();
+
   engine::TaskProcessor& dispatcher_;
   const std::string queue_name_;
-  uint16_t prefetch_count_;
+  const uint16_t max_prefetch_count_;
+  const uint16_t min_prefetch_count_;
+  const bool batch_acks_;
+  const bool autotune_prefetch_;
+  std::atomic<uint16_t> prefetch_count_;
 
   ConnectionPtr connection_ptr_;
   impl::AmqpChannel& channel_;
@@ -46,6 +68,37 @@ class ConsumerBaseImpl final {
 
   DispatchCallback dispatch_callback_;
 
+  statistics::ConsumerStatistics& stats_;
+
+  engine::Semaphore parallelism_sema_;
+  // Received and not yet processed messages
+  std::atomic<std::size_t> in_flight_{0};
+  // Received and not yet acked or rejected messages, as seen by the broker
+  std::atomic<std::size_t> unacked_{0};
+
+  // Delivery tags are assigned by the broker sequentially starting from 1 and
+  // this channel is used by this consumer only, so every tag up to the last
+  // received one belongs to a message of this consumer.
+  engine::Mutex acks_mutex_;
+  // Tags beyond the contiguous settled prefix, mapped to whether the message
+  // was processed successfully
+  std::map<uint64_t, bool> settled_tags_;
+  // The last tag of the contiguous prefix of the settled messages
+  uint64_t settled_prefix_end_{0};
+  // The last successfully processed tag of the prefix: rejected messages are
+  // not outstanding anymore and can't be acked
+  uint64_t last_ackable_tag_{0};
+  uint64_t last_acked_tag_{0};
+  // Successfully processed messages up to last_ackable_tag_ awaiting the ack
+  std::size_t pending_acks_{0};
+
+  // Prefetch autotuning samples, reset by every TunePrefetch
+  std::atomic<std::int64_t> lag_us_sum_{0};
+  std::atomic<std::int64_t> processing_us_sum_{0};
+  std::atomic<std::int64_t> processed_count_{0};
+  std::atomic<bool> prefetch_window_full_{false};
+  utils::PeriodicTask prefetch_tuner_;
+
   std::atomic<bool> stopped_{false};
 
   // Underlying channel errored, just restart the consumer
@@ -1,7 +1,10 @@
 #include <userver/urabbitmq/consumer_component_base.hpp>
 
+#include <optional>
+
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include <userver/urabbitmq/component.hpp>
@@ -16,6 +19,11 @@ ConsumerSettings Parse(const yaml_config::YamlConfig& config,
   ConsumerSettings settings;
   settings.queue = Queue{config["queue"].As<std::string>()};
   settings.prefetch_count = config["prefetch_count"].As<uint16_t>();
+  settings.max_parallelism =
+      config["max_parallelism"].As<uint16_t>(settings.max_parallelism);
+  settings.batch_acks = config["batch_acks"].As<bool>(settings.batch_acks);
+  settings.autotune_prefetch =
+      config["autotune_prefetch"].As<bool>(settings.autotune_prefetch);
 
   UINVARIANT(settings.prefetch_count > 0, "prefetch_count is set to zero");
 
@@ -44,6 +52,22 @@ class ConsumerComponentBase::Impl final : public ConsumerBase {
   ConsumerComponentBase* parent_{nullptr};
 };
 
+namespace {
+
+ConsumerSettings ParseSettings(const components::ComponentConfig& config,
+                               const components::ComponentContext& context) {
+  auto settings = config.As<ConsumerSettings>();
+  const auto task_processor =
+      config["task_processor"].As<std::optional<std::string>>();
+  if (task_processor.has_value()) {
+    settings.task_processor = &context.GetTaskProcessor(*task_processor);
+  }
+
+  return settings;
+}
+
+}  // namespace
+
 ConsumerComponentBase::ConsumerComponentBase(
     const components::ComponentConfig& config,
     const components::ComponentContext& context)
@@ -53,9 +77,19 @@ ConsumerComponentBase::ConsumerComponentBase(
               .FindComponent<components::RabbitMQ>(
                   config["rabbit_name"].As<std::string>())
               .GetClient(),
-          config.As<ConsumerSettings>())} {}
+          ParseSettings(config, context))} {
+  auto& statistics_storage =
+      context.FindComponent<components::StatisticsStorage>();
+  statistics_holder_ = statistics_storage.GetStorage().RegisterWriter(
+      "rabbitmq_consumer." + config.Name(),
+      [this](utils::statistics::Writer& writer) {
+        impl_->WriteStatistics(writer);
+      });
+}
 
-ConsumerComponentBase::~ConsumerComponentBase() = default;
+ConsumerComponentBase::~ConsumerComponentBase() {
+  statistics_holder_.Unregister();
+}
 
 void ConsumerComponentBase::OnAllComponentsLoaded() { impl_->Start(this); }
 
@@ -75,7 +109,31 @@ properties:
         description: a queue to consume from
     prefetch_count:
         type: integer
-        description: prefetch_count for the consumer
+        description: |
+          prefetch_count for the consumer, the maximum one if
+          autotune_prefetch is enabled
+    task_processor:
+        type: string
+        description: task processor to process the messages on
+        defaultDescription: the task processor of the component
+    max_parallelism:
+        type: integer
+        description: |
+          limit for concurrently processed messages, 0 means
+          it is only limited by prefetch_count
+        defaultDescription: 0
+    batch_acks:
+        type: boolean
+        description: |
+          whether to acknowledge processed messages with 'ack multiple'
+          once a contiguous prefix of deliveries is processed
+        defaultDescription: false
+    autotune_prefetch:
+        type: boolean
+        description: |
+          whether to adjust prefetch count between max_parallelism and
+          prefetch_count based on the processing latency
+        defaultDescription: false
 )");
 }
 
@@ -180,10 +180,11 @@ void AmqpChannel::Publish(const Exchange& exchange,
   // We don't account publish here, because there's no way to ensure success
 }
 
-void AmqpChannel::Ack(uint64_t delivery_tag, engine::Deadline deadline) {
+void AmqpChannel::Ack(uint64_t delivery_tag, bool multiple,
+                      engine::Deadline deadline) {
   // No way to acknowledge success, no way to handle synchronous errors
   auto channel = conn_.GetChannel(deadline);
-  channel->ack(delivery_tag);
+  channel->ack(delivery_tag, multiple ? AMQP::multiple : 0);
 }
 
 void AmqpChannel::Reject(uint64_t delivery_tag, bool requeue,
@@ -193,12 +194,13 @@ void AmqpChannel::Reject(uint64_t delivery_tag, bool requeue,
   channel->reject(delivery_tag, requeue ? AMQP::requeue : 0);
 }
 
-void AmqpChannel::SetQos(uint16_t prefetch_count, engine::Deadline deadline) {
+void AmqpChannel::SetQos(uint16_t prefetch_count, bool global,
+                         engine::Deadline deadline) {
   auto deferred = DeferredWrapper::Create();
 
   {
     auto channel = conn_.GetChannel(deadline);
-    deferred->Wrap(channel->setQos(prefetch_count));
+    deferred->Wrap(channel->setQos(prefetch_count, global));
   }
 
   deferred->Wait(deadline);
@@ -238,26 +240,52 @@ ResponseAwaiter AmqpReliableChannel::Publish(const Exchange& exchange,
                                              const std::string& message,
                                              MessageType type,
                                              engine::Deadline deadline) {
+  auto awaiter = conn_.GetAwaiter(deadline);
+  DoPublish(exchange, routing_key, message, type, awaiter.GetWrapper(),
+            nullptr, deadline);
+
+  return awaiter;
+}
+
+std::shared_ptr<DeferredWrapper> AmqpReliableChannel::PublishAsync(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::string& message, MessageType type, engine::Deadline deadline) {
+  auto deferred = DeferredWrapper::Create();
+  // The slot is released once the broker confirms the message (or the channel
+  // fails) and AMQP::Reliable drops the callbacks holding it.
+  auto slot =
+      std::make_shared<engine::SemaphoreLock>(conn_.GetConfirmSlot(deadline));
+  DoPublish(exchange, routing_key, message, type, deferred, std::move(slot),
+            deadline);
+
+  return deferred;
+}
+
+void AmqpReliableChannel::DoPublish(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::string& message, MessageType type,
+    std::shared_ptr<DeferredWrapper> deferred,
+    std::shared_ptr<engine::SemaphoreLock> confirm_slot,
+    engine::Deadline deadline) {
   AMQP::Envelope envelope{message.data(), message.size()};
   envelope.setPersistent(type == MessageType::kPersistent);
   envelope.setHeaders(CreateHeaders());
 
-  auto awaiter = conn_.GetAwaiter(deadline);
-
-  {
-    auto reliable = conn_.GetReliableChannel(deadline);
-
-    reliable->publish(exchange.GetUnderlying(), routing_key, envelope)
-        .onAck([this, deferred = awaiter.GetWrapper()] {
-          AccountMessagePublished();
-          deferred->Ok();
-        })
-        .onError([deferred = awaiter.GetWrapper()](const char* error) {
-          deferred->Fail(error);
-        });
-  }
-
-  return awaiter;
+  auto reliable = conn_.GetReliableChannel(deadline);
+
+  // AMQP::Reliable tracks delivery tags of the published messages and
+  // resolves the ones covered by 'multiple' acks/nacks
+  reliable->publish(exchange.GetUnderlying(), routing_key, envelope)
+      .onAck([this, deferred, confirm_slot] {
+        AccountMessagePublished();
+        deferred->Ok();
+      })
+      .onNack([deferred, confirm_slot] {
+        deferred->Fail("Message was rejected by the broker");
+      })
+      .onError([deferred, confirm_slot](const char* error) {
+        deferred->Fail(error);
+      });
 }
 
 void AmqpReliableChannel::AccountMessagePublished() {
@@ -57,11 +57,13 @@ class AmqpChannel final {
                const std::string& message, MessageType type,
                engine::Deadline deadline);
 
-  void Ack(uint64_t delivery_tag, engine::Deadline deadline);
+  void Ack(uint64_t delivery_tag, bool multiple, engine::Deadline deadline);
 
   void Reject(uint64_t delivery_tag, bool requeue, engine::Deadline deadline);
 
-  void SetQos(uint16_t prefetch_count, engine::Deadline deadline);
+  // A global limit is shared by all the consumers of the channel and,
+  // unlike a per-consumer one, affects the already running consumers
+  void SetQos(uint16_t prefetch_count, bool global, engine::Deadline deadline);
 
   using ErrorCb = std::function<void(const char*)>;
   using SuccessCb = std::function<void(const std::string&)>;
@@ -90,7 +92,21 @@ class AmqpReliableChannel final {
                           const std::string& message, MessageType type,
                           engine::Deadline deadline);
 
+  // Doesn't occupy a request slot of the connection, so that many messages
+  // could await their confirms at once.
+  std::shared_ptr<DeferredWrapper> PublishAsync(const Exchange& exchange,
+                                                const std::string& routing_key,
+                                                const std::string& message,
+                                                MessageType type,
+                                                engine::Deadline deadline);
+
  private:
+  void DoPublish(const Exchange& exchange, const std::string& routing_key,
+                 const std::string& message, MessageType type,
+                 std::shared_ptr<DeferredWrapper> deferred,
+                 std::shared_ptr<engine::SemaphoreLock> confirm_slot,
+                 engine::Deadline deadline);
+
   void AccountMessagePublished();
 
   AmqpConnection& conn_;
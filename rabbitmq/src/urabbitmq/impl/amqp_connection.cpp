@@ -39,10 +39,12 @@ ConnectionLock::ConnectionLock(ConnectionLock&& other) noexcept
 
 AmqpConnection::AmqpConnection(AmqpConnectionHandler& handler,
                                size_t max_in_flight_requests,
+                               size_t max_unconfirmed_publishes,
                                engine::Deadline deadline)
     : handler_{handler},
       conn_{CreateConnection(handler_, deadline)},
       channel_{CreateChannel(deadline)},
+      unconfirmed_sema_{max_unconfirmed_publishes},
       reliable_channel_{CreateChannel(deadline)},
       waiters_sema_{max_in_flight_requests} {
   handler_.OnConnectionCreated(this, deadline);
@@ -94,6 +96,17 @@ ResponseAwaiter AmqpConnection::GetAwaiter(engine::Deadline deadline) {
   return ResponseAwaiter{std::move(lock)};
 }
 
+engine::SemaphoreLock AmqpConnection::GetConfirmSlot(
+    engine::Deadline deadline) {
+  engine::SemaphoreLock lock{unconfirmed_sema_, deadline};
+  if (!lock.OwnsLock()) {
+    throw std::runtime_error{
+        "Too many unconfirmed messages within specified deadline"};
+  }
+
+  return lock;
+}
+
 ConnectionLock AmqpConnection::Lock(engine::Deadline deadline) {
   return {mutex_, deadline};
 }
@@ -50,7 +50,7 @@ class LockedChannelProxy final {
 class AmqpConnection final {
  public:
   AmqpConnection(AmqpConnectionHandler& handler, size_t max_in_flight_requests,
-                 engine::Deadline deadline);
+                 size_t max_unconfirmed_publishes, engine::Deadline deadline);
   ~AmqpConnection();
 
   AMQP::Connection& GetNative();
@@ -67,6 +67,9 @@ class AmqpConnection final {
 
   ResponseAwaiter GetAwaiter(engine::Deadline deadline);
 
+  // Takes a slot in the window of messages awaiting publisher confirms
+  engine::SemaphoreLock GetConfirmSlot(engine::Deadline deadline);
+
  private:
   friend class AmqpConnectionLocker;
   [[nodiscard]] ConnectionLock Lock(engine::Deadline deadline);
@@ -93,6 +96,10 @@ class AmqpConnection final {
 
   AMQP::Channel channel_;
 
+  // Slots are held by the confirm handlers of reliable_,
+  // so this must outlive it.
+  engine::Semaphore unconfirmed_sema_;
+
   AMQP::Channel reliable_channel_;
   std::unique_ptr<ReliableChannel> reliable_;
 
@@ -0,0 +1,52 @@
+#include "consumer_statistics.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace urabbitmq::statistics {
+
+void ConsumerStatistics::AccountMessageReceived() {
+  ++messages_received_;
+  ++in_flight_;
+}
+
+void ConsumerStatistics::AccountProcessingStarted(
+    std::chrono::milliseconds lag) {
+  queue_lag_.GetCurrentCounter().Account(lag.count());
+}
+
+void ConsumerStatistics::AccountMessageProcessed(
+    bool success, std::chrono::milliseconds duration) {
+  --in_flight_;
+  if (success) {
+    ++messages_processed_;
+  } else {
+    ++messages_failed_;
+  }
+  processing_timings_.GetCurrentCounter().Account(duration.count());
+}
+
+void ConsumerStatistics::AccountMessagesDropped(std::size_t count) {
+  in_flight_ -= count;
+}
+
+void ConsumerStatistics::AccountAckSent() { ++acks_sent_; }
+
+void ConsumerStatistics::SetPrefetchCount(std::size_t prefetch_count) {
+  prefetch_count_ = prefetch_count;
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ConsumerStatistics& stats) {
+  writer["messages_received"] = stats.messages_received_;
+  writer["messages_processed"] = stats.messages_processed_;
+  writer["messages_failed"] = stats.messages_failed_;
+  writer["acks_sent"] = stats.acks_sent_;
+  writer["in_flight"] = stats.in_flight_.load();
+  writer["prefetch_count"] = stats.prefetch_count_.load();
+  writer["queue_lag"] = stats.queue_lag_;
+  writer["processing_timings"] = stats.processing_timings_;
+}
+
+}  // namespace urabbitmq::statistics
+
+USERVER_NAMESPACE_END
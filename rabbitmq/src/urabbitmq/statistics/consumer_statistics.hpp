@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace urabbitmq::statistics {
+
+class ConsumerStatistics final {
+ public:
+  using Timings = utils::statistics::RecentPeriod<
+      utils::statistics::Percentile<2048, std::uint32_t, 16, 256>,
+      utils::statistics::Percentile<2048, std::uint32_t, 16, 256>>;
+
+  // The message is received from the broker
+  void AccountMessageReceived();
+  // The message waited for `lag` in the consumer before being processed
+  void AccountProcessingStarted(std::chrono::milliseconds lag);
+  void AccountMessageProcessed(bool success,
+                               std::chrono::milliseconds duration);
+  // The messages were received, but won't be processed by this consumer
+  void AccountMessagesDropped(std::size_t count);
+  void AccountAckSent();
+
+  void SetPrefetchCount(std::size_t prefetch_count);
+
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const ConsumerStatistics& stats);
+
+ private:
+  utils::statistics::RelaxedCounter<std::size_t> messages_received_{0};
+  utils::statistics::RelaxedCounter<std::size_t> messages_processed_{0};
+  utils::statistics::RelaxedCounter<std::size_t> messages_failed_{0};
+  utils::statistics::RelaxedCounter<std::size_t> acks_sent_{0};
+
+  std::atomic<std::size_t> in_flight_{0};
+  std::atomic<std::size_t> prefetch_count_{0};
+
+  Timings queue_lag_;
+  Timings processing_timings_;
+};
+
+}  // namespace urabbitmq::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,182 @@
+#include "mock_redis_server.hpp"
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <optional>
+#include <string_view>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include <userver/utils/from_string.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::bench {
+
+namespace {
+
+constexpr std::string_view kCrLf = "\r\n";
+
+[[noreturn]] void ThrowSystemError(std::string_view what) {
+  throw std::system_error(errno, std::system_category(), std::string{what});
+}
+
+// Parses `<prefix><number>\r\n` at `pos`, moves `pos` past it
+std::optional<std::size_t> ParseHeader(std::string_view buffer,
+                                       std::size_t& pos, char prefix) {
+  if (pos >= buffer.size()) return std::nullopt;
+  if (buffer[pos] != prefix) {
+    throw std::runtime_error(
+        fmt::format("Unexpected RESP type '{}', '{}' expected", buffer[pos],
+                    prefix));
+  }
+  const auto end = buffer.find(kCrLf, pos);
+  if (end == std::string_view::npos) return std::nullopt;
+  const auto value =
+      utils::FromString<std::size_t>(buffer.substr(pos + 1, end - pos - 1));
+  pos = end + kCrLf.size();
+  return value;
+}
+
+// Parses a command at `pos`, returns its name and moves `pos` past it or
+// returns nullopt if the command is incomplete
+std::optional<std::string_view> ParseCommand(std::string_view buffer,
+                                             std::size_t& pos) {
+  auto current = pos;
+  const auto args_count = ParseHeader(buffer, current, '*');
+  if (!args_count) return std::nullopt;
+
+  std::string_view name;
+  for (std::size_t i = 0; i < *args_count; ++i) {
+    const auto size = ParseHeader(buffer, current, '$');
+    if (!size || buffer.size() < current + *size + kCrLf.size()) {
+      return std::nullopt;
+    }
+    if (i == 0) name = buffer.substr(current, *size);
+    current += *size + kCrLf.size();
+  }
+  pos = current;
+  return name;
+}
+
+void SendAll(int fd, std::string_view data) {
+  while (!data.empty()) {
+    const auto sent = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+    if (sent < 0) {
+      if (errno == EINTR) continue;
+      ThrowSystemError("send");
+    }
+    data.remove_prefix(static_cast<std::size_t>(sent));
+  }
+}
+
+}  // namespace
+
+MockRedisServer::MockRedisServer(std::size_t get_reply_size)
+    : get_reply_(fmt::format("${}\r\n{}\r\n", get_reply_size,
+                             std::string(get_reply_size, 'x'))) {
+  listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) ThrowSystemError("socket");
+
+  ::sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  auto* const sa = reinterpret_cast<::sockaddr*>(&addr);
+  ::socklen_t addr_len = sizeof(addr);
+  if (::bind(listen_fd_, sa, addr_len) != 0 ||
+      ::listen(listen_fd_, SOMAXCONN) != 0 ||
+      ::getsockname(listen_fd_, sa, &addr_len) != 0) {
+    const auto error = errno;
+    ::close(listen_fd_);
+    errno = error;
+    ThrowSystemError("bind/listen");
+  }
+  port_ = ntohs(addr.sin_port);
+
+  acceptor_ = std::thread([this] { AcceptLoop(); });
+}
+
+MockRedisServer::~MockRedisServer() {
+  stopped_ = true;
+  // wakes up the blocked accept() and recv() calls
+  ::shutdown(listen_fd_, SHUT_RDWR);
+  acceptor_.join();
+  {
+    const std::lock_guard lock{mutex_};
+    for (const auto fd : connection_fds_) ::shutdown(fd, SHUT_RDWR);
+  }
+  for (auto& worker : workers_) worker.join();
+  for (const auto fd : connection_fds_) ::close(fd);
+  ::close(listen_fd_);
+}
+
+void MockRedisServer::AcceptLoop() {
+  while (!stopped_) {
+    const int fd = ::accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) continue;
+      return;
+    }
+    const int nodelay = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+    const std::lock_guard lock{mutex_};
+    if (stopped_) {
+      ::close(fd);
+      return;
+    }
+    connection_fds_.push_back(fd);
+    workers_.emplace_back([this, fd] { Serve(fd); });
+  }
+}
+
+void MockRedisServer::Serve(int fd) {
+  std::string buffer;
+  std::string replies;
+  std::array<char, 16 * 1024> chunk{};
+  while (true) {
+    const auto received = ::recv(fd, chunk.data(), chunk.size(), 0);
+    if (received < 0 && errno == EINTR) continue;
+    if (received <= 0) return;
+
+    buffer.append(chunk.data(), static_cast<std::size_t>(received));
+    try {
+      buffer.erase(0, ProcessCommands(buffer, replies));
+      if (replies.empty()) continue;
+      SendAll(fd, replies);
+    } catch (const std::exception&) {
+      // a protocol error or a closed connection
+      return;
+    }
+    replies.clear();
+  }
+}
+
+std::size_t MockRedisServer::ProcessCommands(const std::string& buffer,
+                                             std::string& replies) {
+  std::size_t pos = 0;
+  while (const auto name = ParseCommand(buffer, pos)) {
+    if (*name == "PING") {
+      replies += "+PONG\r\n";
+    } else if (*name == "GET") {
+      replies += get_reply_;
+    } else if (*name == "INFO") {
+      replies += "$13\r\nrole:master\r\n\r\n";
+    } else {
+      replies += "+OK\r\n";
+    }
+  }
+  return pos;
+}
+
+}  // namespace storages::redis::bench
+
+USERVER_NAMESPACE_END
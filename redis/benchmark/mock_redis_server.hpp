@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::bench {
+
+/// @brief Minimal in-process server speaking RESP on loopback, so that the
+/// driver benchmarks do not depend on a live Redis and its timings.
+///
+/// Replies `+PONG` to PING, a bulk string of the configured size to GET and
+/// `+OK` to anything else. Replies to pipelined commands are sent at once.
+class MockRedisServer final {
+ public:
+  explicit MockRedisServer(std::size_t get_reply_size);
+  ~MockRedisServer();
+
+  MockRedisServer(MockRedisServer&&) = delete;
+  MockRedisServer& operator=(MockRedisServer&&) = delete;
+
+  int GetPort() const noexcept { return port_; }
+
+ private:
+  void AcceptLoop();
+  void Serve(int fd);
+  // Appends the replies to all the complete commands in the buffer, returns
+  // the number of bytes consumed
+  std::size_t ProcessCommands(const std::string& buffer, std::string& replies);
+
+  const std::string get_reply_;
+  int listen_fd_{-1};
+  int port_{0};
+  std::atomic<bool> stopped_{false};
+
+  std::mutex mutex_;
+  std::vector<int> connection_fds_;
+  std::vector<std::thread> workers_;
+  std::thread acceptor_;
+};
+
+}  // namespace storages::redis::bench
+
+USERVER_NAMESPACE_END
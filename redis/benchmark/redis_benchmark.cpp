@@ -1,5 +1,7 @@
+#include <chrono>
 #include <deque>
 #include <string>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -77,6 +79,42 @@ BENCHMARK_INSTANTIATE_TEMPLATE_F(Redis, PipelineGrind, Set)
     ->Args({16, 1024})
     ->Args({32, 1024});
 
+BENCHMARK_DEFINE_F(Redis, BufferedBatches)(benchmark::State& state) {
+  RunStandalone([this, &state] {
+    USERVER_NAMESPACE::redis::CommandsBufferingSettings settings;
+    settings.buffering_enabled = true;
+    settings.watch_command_timer_interval = std::chrono::microseconds{100};
+    settings.max_batch_size = state.range(1);
+    GetSentinel()->SetCommandsBufferingSettings(settings);
+
+    const auto client = GetClient();
+    std::vector<RequestGet> requests;
+    requests.reserve(state.range(0));
+
+    for (auto _ : state) {
+      for (auto i = 0; i < state.range(0); ++i) {
+        requests.push_back(client->Get("key" + std::to_string(i), {}));
+      }
+      for (auto& request : requests) request.Get();
+      requests.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    const auto stats = GetSentinel()->GetStatistics({});
+    const auto total = stats.GetShardGroupTotalStatistics();
+    for (auto p : {50, 100}) {
+      state.counters["batch_p" + std::to_string(p)] =
+          total.batch_size_percentile.GetPercentile(p);
+    }
+  });
+}
+
+// max_batch_size == 0 writes all the buffered commands at once
+BENCHMARK_REGISTER_F(Redis, BufferedBatches)
+    ->Args({256, 0})
+    ->Args({256, 16})
+    ->Args({256, 64});
+
 }  // namespace storages::redis::bench
 
 USERVER_NAMESPACE_END
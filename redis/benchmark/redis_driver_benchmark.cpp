@@ -0,0 +1,122 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/storages/redis/impl/base.hpp>
+#include <userver/storages/redis/impl/reply.hpp>
+#include <userver/storages/redis/impl/thread_pools.hpp>
+
+#include <storages/redis/impl/command.hpp>
+#include <storages/redis/impl/redis.hpp>
+
+#include "mock_redis_server.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::bench {
+
+namespace {
+
+namespace driver = USERVER_NAMESPACE::redis;
+
+using driver::CmdArgs;
+
+constexpr std::chrono::seconds kConnectTimeout{5};
+
+// Counts the replies delivered to the ev thread of the driver
+class RepliesCounter final {
+ public:
+  void OnReply(bool is_ok) {
+    if (!is_ok) has_errors_ = true;
+    if (++received_ == expected_) {
+      const std::lock_guard lock{mutex_};
+      cv_.notify_one();
+    }
+  }
+
+  void Expect(std::size_t count) {
+    received_ = 0;
+    expected_ = count;
+  }
+
+  void Wait() {
+    std::unique_lock lock{mutex_};
+    cv_.wait(lock, [this] { return received_ >= expected_; });
+  }
+
+  bool HasErrors() const { return has_errors_; }
+
+ private:
+  std::atomic<std::size_t> received_{0};
+  std::atomic<std::size_t> expected_{0};
+  std::atomic<bool> has_errors_{false};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+// Measures the client side of the driver: command serialization, the ev
+// thread loop and reply parsing, against an in-process server on loopback.
+// range(0) is the number of the commands in flight, range(1) is the size of
+// the GET reply.
+void RunMockRoundtrips(benchmark::State& state, const CmdArgs& args) {
+  MockRedisServer server{static_cast<std::size_t>(state.range(1))};
+
+  auto thread_pools = std::make_shared<driver::ThreadPools>(1, 1);
+  auto redis = std::make_shared<driver::Redis>(
+      thread_pools->GetRedisThreadPool(), driver::RedisCreationSettings{});
+  redis->Connect({"127.0.0.1"}, server.GetPort(), driver::Password(""));
+
+  const auto connect_deadline =
+      std::chrono::steady_clock::now() + kConnectTimeout;
+  while (redis->GetState() != driver::RedisState::kConnected) {
+    if (std::chrono::steady_clock::now() > connect_deadline) {
+      state.SkipWithError("Failed to connect to the mock server");
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  RepliesCounter counter;
+  const auto callback = [&counter](const driver::CommandPtr&,
+                                   driver::ReplyPtr reply) {
+    counter.OnReply(reply->status == driver::ReplyStatus::kOk);
+  };
+
+  const auto in_flight = static_cast<std::size_t>(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    counter.Expect(in_flight);
+    for (std::size_t i = 0; i < in_flight; ++i) {
+      redis->AsyncCommand(driver::PrepareCommand(args.Clone(), callback));
+    }
+    counter.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * in_flight);
+  if (counter.HasErrors()) state.SkipWithError("Some of the commands failed");
+}
+
+}  // namespace
+
+void redis_mock_ping(benchmark::State& state) {
+  RunMockRoundtrips(state, CmdArgs{"PING"});
+}
+BENCHMARK(redis_mock_ping)->Args({1, 0})->Args({16, 0})->Args({256, 0});
+
+void redis_mock_get(benchmark::State& state) {
+  RunMockRoundtrips(state, CmdArgs{"GET", "key"});
+}
+BENCHMARK(redis_mock_get)
+    ->Args({1, 16})
+    ->Args({16, 16})
+    ->Args({16, 4096})
+    ->Args({256, 16})
+    ->Args({256, 4096})
+    ->Args({16, 1 << 20});
+
+}  // namespace storages::redis::bench
+
+USERVER_NAMESPACE_END
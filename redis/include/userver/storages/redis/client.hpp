@@ -4,6 +4,7 @@
 /// @brief @copybrief storages::redis::Client
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -26,6 +27,13 @@ enum class PubShard {
   kRoundRobin,
 };
 
+/// Whether a request to many shards returns the results of the shards that
+/// succeeded if some of the shards failed
+enum class PartialResults {
+  kForbidden,
+  kAllowed,
+};
+
 using RetryNilFromMaster = USERVER_NAMESPACE::redis::RetryNilFromMaster;
 
 inline constexpr RetryNilFromMaster kRetryNilFromMaster{};
@@ -36,6 +44,13 @@ inline constexpr RetryNilFromMaster kRetryNilFromMaster{};
 ///
 /// Usually retrieved from components::Redis component.
 ///
+/// All the commands to a Redis instance are pipelined over a single
+/// connection, so the client provides no blocking commands (`BLPOP`,
+/// `XREAD BLOCK`, `WAIT`...): such a command would delay all the other
+/// commands to the instance until it returns. Use the polling variants with
+/// a retry loop instead, and keep slow Lua scripts out of latency sensitive
+/// shards.
+///
 /// ## Example usage:
 ///
 /// @snippet storages/redis/client_redistest.cpp  Sample Redis Client usage
@@ -480,7 +495,29 @@ class Client {
 
   RequestZscan Zscan(std::string key, const CommandControl& command_control);
 
+  /// @brief MGET of the keys from any shards.
+  ///
+  /// The keys are grouped by shard (by hash slot in Redis Cluster), an Mget()
+  /// is sent for each of the groups concurrently and the values are returned
+  /// in the order of `keys`. With PartialResults::kAllowed the values of the
+  /// keys from the failed (e.g. timed out) shards are std::nullopt instead of
+  /// throwing.
+  RequestMget MgetAcrossShards(
+      std::vector<std::string> keys, const CommandControl& command_control,
+      PartialResults partial_results = PartialResults::kForbidden);
+
+  /// @brief MSET of the key-values from any shards, grouped as in
+  /// MgetAcrossShards(). The operation is not atomic across the groups.
+  RequestMset MsetAcrossShards(
+      std::vector<std::pair<std::string, std::string>> key_values,
+      const CommandControl& command_control);
+
  protected:
+  /// Returns the function that maps the keys that may be used together in
+  /// one multi-key command to the same value; it is ShardByKey() by default
+  virtual std::function<size_t(const std::string&)> GetMultiKeyGroupByKey()
+      const;
+
   virtual RequestEvalCommon EvalCommon(
       std::string script, std::vector<std::string> keys,
       std::vector<std::string> args, const CommandControl& command_control) = 0;
@@ -51,6 +51,7 @@ namespace components {
 /// * @ref REDIS_COMMANDS_BUFFERING_SETTINGS
 /// * @ref REDIS_METRICS_SETTINGS
 /// * @ref REDIS_PUBSUB_METRICS_SETTINGS
+/// * @ref REDIS_HOT_KEYS_SETTINGS
 ///
 /// ## Static options:
 /// Name | Description | Default value
@@ -0,0 +1,116 @@
+#pragma once
+
+/// @file userver/storages/redis/distributed_rate_limiter.hpp
+/// @brief @copybrief storages::redis::DistributedRateLimiter
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include <userver/storages/redis/client_fwd.hpp>
+#include <userver/storages/redis/command_control.hpp>
+#include <userver/storages/redis/script_registry.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/token_bucket.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+struct DistributedRateLimiterSettings final {
+  /// Redis key prefix of the quota, shared by all the instances
+  std::string key;
+  /// Name of this instance, must be unique among the instances sharing the
+  /// quota, e.g. the host name
+  std::string instance_id;
+  /// Quota for all the instances together, tokens per second
+  double global_rate_ps{0};
+  /// Local bucket size, in seconds of the local rate
+  std::chrono::milliseconds burst{std::chrono::seconds{1}};
+  /// Period of reporting the demand and recomputing the local share
+  std::chrono::milliseconds sync_interval{std::chrono::seconds{1}};
+  /// An instance that has not synced for that long is considered dead and
+  /// its share is given to the others
+  std::chrono::milliseconds instance_ttl{std::chrono::seconds{5}};
+  /// Number of instances assumed until the first successful sync
+  std::size_t initial_instances_estimate{1};
+  /// Command control of the Redis requests
+  CommandControl command_control{};
+};
+
+// clang-format off
+
+/// @ingroup userver_clients
+///
+/// @brief Token bucket rate limiter, which shares a global quota between
+/// the service instances through Redis.
+///
+/// Obtain() only touches a local utils::TokenBucket and is lock-free. Each
+/// DistributedRateLimiterSettings::sync_interval the instance reports its
+/// demand (the number of Obtain() calls per second) to Redis and gets the
+/// number of live instances and their total demand back, in a single Lua
+/// script call. The local rate is then set to
+/// `global_rate_ps * (0.5 / instances + 0.5 * demand / total_demand)`: half of
+/// the quota is split equally, so that an idle instance can start serving
+/// right away, and half follows the demand.
+///
+/// If Redis is unavailable, the last computed rate is kept.
+///
+/// The limiter is not bound to a specific client, call Obtain() before
+/// a request of a handler, of an HTTP client or of a database client.
+///
+/// ## Example usage:
+///
+/// @snippet storages/redis/distributed_rate_limiter_redistest.cpp  Sample DistributedRateLimiter usage
+
+// clang-format on
+
+class DistributedRateLimiter final {
+ public:
+  DistributedRateLimiter(ClientPtr client,
+                         DistributedRateLimiterSettings settings);
+  ~DistributedRateLimiter();
+
+  DistributedRateLimiter(const DistributedRateLimiter&) = delete;
+  DistributedRateLimiter& operator=(const DistributedRateLimiter&) = delete;
+
+  /// @brief Start syncing with the other instances in background. Calling
+  /// this method on a running limiter has no effect.
+  void Start();
+
+  /// @brief Stop syncing, the instance expires from the quota after
+  /// DistributedRateLimiterSettings::instance_ttl
+  void Stop();
+
+  /// @returns true if a token was successfully obtained
+  [[nodiscard]] bool Obtain();
+
+  /// @returns true if the requested number of tokens was successfully
+  /// obtained
+  [[nodiscard]] bool ObtainAll(std::size_t count);
+
+  /// @returns the current local share of the global quota, tokens per second
+  double GetLocalRatePs() const noexcept;
+
+  /// @returns the number of live instances seen on the last sync
+  std::size_t GetInstancesCount() const noexcept;
+
+ private:
+  void Sync();
+  void SetLocalRate(double rate_ps);
+
+  const ClientPtr client_;
+  const DistributedRateLimiterSettings settings_;
+  ScriptRegistry scripts_;
+  utils::TokenBucket bucket_;
+  std::atomic<std::size_t> requested_{0};
+  std::atomic<double> local_rate_ps_{0};
+  std::atomic<std::size_t> instances_{0};
+  std::chrono::steady_clock::time_point last_sync_;
+  utils::PeriodicTask sync_task_;
+};
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
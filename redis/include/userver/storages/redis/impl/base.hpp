@@ -117,11 +117,15 @@ struct CommandsBufferingSettings {
   bool buffering_enabled{false};
   size_t commands_buffering_threshold{0};
   std::chrono::microseconds watch_command_timer_interval{0};
+  /// If non-zero, the buffered commands are written to the socket in batches
+  /// of at most this many commands, each batch in a single write
+  size_t max_batch_size{0};
 
   constexpr bool operator==(const CommandsBufferingSettings& o) const {
     return buffering_enabled == o.buffering_enabled &&
            commands_buffering_threshold == o.commands_buffering_threshold &&
-           watch_command_timer_interval == o.watch_command_timer_interval;
+           watch_command_timer_interval == o.watch_command_timer_interval &&
+           max_batch_size == o.max_batch_size;
   }
 };
 
@@ -214,6 +218,30 @@ struct ReplicationMonitoringSettings {
   bool restrict_requests{false};
 };
 
+struct HotKeysSettings {
+  bool enabled{false};
+  /// Every `sample_rate`-th read of a shard is accounted
+  size_t sample_rate{16};
+  /// Count of the keys tracked per shard
+  size_t capacity{64};
+  /// A key is hot if it got at least this percent of the sampled reads
+  size_t min_share_percent{5};
+  /// Windows with fewer sampled reads have no hot keys
+  size_t min_samples{100};
+  std::chrono::milliseconds window{1000};
+  /// Send the reads of the hot keys to any replica of the shard instead of
+  /// the replicas selected by CommandControl::strategy
+  bool offload_reads{true};
+
+  constexpr bool operator==(const HotKeysSettings& o) const {
+    return enabled == o.enabled && sample_rate == o.sample_rate &&
+           capacity == o.capacity &&
+           min_share_percent == o.min_share_percent &&
+           min_samples == o.min_samples && window == o.window &&
+           offload_reads == o.offload_reads;
+  }
+};
+
 struct PublishSettings {
   size_t shard{0};
   bool master{true};
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -9,6 +11,9 @@ namespace redis {
 
 void GetRedisKey(const std::string& key, size_t* key_start, size_t* key_len);
 
+/// Redis Cluster hash slot of the key, only the `{hash tag}` is hashed if any
+uint16_t KeySlot(std::string_view key);
+
 class KeyShard {
  public:
   virtual ~KeyShard() = default;
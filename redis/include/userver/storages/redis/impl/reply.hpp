@@ -124,6 +124,7 @@ class ReplyData final {
   ReplyData(Array&& array);
   ReplyData(std::string s);
   ReplyData(int value);
+  static ReplyData CreateInteger(int64_t value);
   static ReplyData CreateError(std::string&& error_msg);
   static ReplyData CreateStatus(std::string&& status_msg);
   static ReplyData CreateNil();
@@ -243,6 +244,8 @@ class Reply final {
   Reply(std::string cmd, redisReply* redis_reply, ReplyStatus status,
         std::string status_string);
   Reply(std::string cmd, ReplyData&& data);
+  Reply(std::string cmd, ReplyData&& data, ReplyStatus status,
+        std::string status_string);
 
   std::string server;
   ServerId server_id;
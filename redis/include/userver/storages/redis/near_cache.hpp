@@ -0,0 +1,113 @@
+#pragma once
+
+/// @file userver/storages/redis/near_cache.hpp
+/// @brief @copybrief storages::redis::NearCache
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <userver/cache/expirable_lru_cache.hpp>
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/storages/redis/client_fwd.hpp>
+#include <userver/storages/redis/command_options.hpp>
+#include <userver/storages/redis/subscription_token.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+struct NearCacheSettings final {
+  /// Number of ways of the LRU caches
+  std::size_t ways{16};
+  /// Size of each way of the LRU caches
+  std::size_t way_size{1024};
+  /// Values older than that are read from Redis again, it bounds the
+  /// staleness if an invalidation message is lost
+  std::chrono::milliseconds max_lifetime{std::chrono::seconds{1}};
+  /// Channel with the keys to invalidate, one key per message or an array of
+  /// keys as sent by `CLIENT TRACKING ... REDIRECT`. An empty message
+  /// invalidates all the keys.
+  std::string invalidation_channel{"__redis__:invalidate"};
+};
+
+struct NearCacheStatistics final {
+  std::atomic<std::uint64_t> hits{0};
+  std::atomic<std::uint64_t> misses{0};
+  std::atomic<std::uint64_t> invalidated{0};
+};
+
+/// @ingroup userver_clients
+///
+/// @brief Client-side cache of Get() and Hget() replies of a
+/// storages::redis::Client.
+///
+/// Repeated reads of the same keys are served from the local LRU caches
+/// until the key is invalidated by a message in
+/// NearCacheSettings::invalidation_channel or its lifetime expires.
+///
+/// To receive the invalidations from Redis, enable `CLIENT TRACKING` in the
+/// broadcasting mode with `REDIRECT` to a connection subscribed to
+/// `__redis__:invalidate`, or publish the changed keys to the invalidation
+/// channel on writes.
+///
+/// Messages may be lost on resubscription, so the values are not served
+/// for longer than NearCacheSettings::max_lifetime.
+class NearCache final {
+ public:
+  NearCache(ClientPtr client, SubscribeClient& subscribe_client,
+            const NearCacheSettings& settings);
+
+  ~NearCache();
+
+  std::optional<std::string> Get(const std::string& key,
+                                 const CommandControl& command_control);
+
+  std::optional<std::string> Hget(const std::string& key,
+                                  const std::string& field,
+                                  const CommandControl& command_control);
+
+  /// Drops the cached values of the key and of the fields of the hash
+  void Invalidate(const std::string& key);
+
+  /// Drops all the cached values
+  void InvalidateAll();
+
+  const NearCacheStatistics& GetStatistics() const noexcept;
+
+ private:
+  using HashFields =
+      std::unordered_map<std::string, std::optional<std::string>>;
+
+  void OnInvalidationMessage(const std::string& message);
+
+  // Stores the fetched value if no invalidation happened since `epoch`
+  template <typename Cache, typename Value>
+  void PutIfNotInvalidated(Cache& cache, const std::string& key,
+                           Value&& value, std::uint64_t epoch);
+
+  const ClientPtr client_;
+  NearCacheStatistics stats_;
+  // Incremented on each invalidation, the values fetched while it changed
+  // may be stale and are not cached
+  std::atomic<std::uint64_t> invalidations_epoch_{0};
+  // Orders the epoch check and the store of a value with the invalidations:
+  // shared for the stores, unique for the invalidations
+  engine::SharedMutex invalidation_mutex_;
+  cache::ExpirableLruCache<std::string, std::optional<std::string>> values_;
+  cache::ExpirableLruCache<std::string, std::shared_ptr<const HashFields>>
+      hashes_;
+  SubscriptionToken subscription_;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const NearCacheStatistics& stats);
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -36,6 +36,9 @@ ReplicationMonitoringSettings Parse(
 
 PubsubMetricsSettings Parse(const formats::json::Value& elem,
                             formats::parse::To<PubsubMetricsSettings>);
+
+HotKeysSettings Parse(const formats::json::Value& elem,
+                      formats::parse::To<HotKeysSettings>);
 }  // namespace redis
 
 namespace storages::redis {
@@ -54,6 +57,8 @@ struct Config final {
   dynamic_config::ValueDict<
       USERVER_NAMESPACE::redis::ReplicationMonitoringSettings>
       replication_monitoring_settings;
+  dynamic_config::ValueDict<USERVER_NAMESPACE::redis::HotKeysSettings>
+      hot_keys_settings;
   bool redis_cluster_autotopology_enabled{};
 };
 
@@ -0,0 +1,107 @@
+#pragma once
+
+/// @file userver/storages/redis/script_registry.hpp
+/// @brief @copybrief storages::redis::ScriptRegistry
+
+#include <string>
+#include <vector>
+
+#include <userver/concurrent/variable.hpp>
+#include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/impl/exception.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+/// @brief Lua script with its SHA1 digest computed once
+class Script final {
+ public:
+  explicit Script(std::string body);
+
+  const std::string& GetBody() const noexcept { return body_; }
+  const std::string& GetSha1() const noexcept { return sha1_; }
+
+ private:
+  std::string body_;
+  std::string sha1_;
+};
+
+// clang-format off
+
+/// @ingroup userver_clients
+///
+/// @brief Executes Lua scripts with EVALSHA, so that the script body is not
+/// sent on each call.
+///
+/// The registered scripts are loaded with SCRIPT LOAD to all the shards. If a
+/// server does not know the script (e.g. after a failover or a restart), the
+/// script is loaded to the shard and the call is retried once.
+///
+/// ## Example usage:
+///
+/// @snippet storages/redis/client_redistest.cpp  Sample ScriptRegistry usage
+
+// clang-format on
+
+class ScriptRegistry final {
+ public:
+  explicit ScriptRegistry(ClientPtr client);
+
+  /// @brief Loads the script to all the shards and remembers it for
+  /// LoadAll().
+  /// @throws redis::Exception if loading to some shard failed
+  Script Register(std::string body, const CommandControl& command_control);
+
+  /// @brief Loads all the registered scripts to all the shards, e.g. after a
+  /// topology change
+  /// @throws redis::Exception if loading to some shard failed
+  void LoadAll(const CommandControl& command_control);
+
+  /// @brief EVALSHA with transparent SCRIPT LOAD and retry on NOSCRIPT.
+  /// The shard is chosen by the first key, `keys` must not be empty.
+  template <typename ScriptResult, typename ReplyType = ScriptResult>
+  ReplyType Eval(const Script& script, std::vector<std::string> keys,
+                 std::vector<std::string> args,
+                 const CommandControl& command_control);
+
+ private:
+  void Load(const Script& script, size_t shard,
+            const CommandControl& command_control);
+  void LoadToAllShards(const std::vector<Script>& scripts,
+                       const CommandControl& command_control);
+  static void CheckLoaded(const Script& script, RequestScriptLoad request);
+
+  const ClientPtr client_;
+  concurrent::Variable<std::vector<Script>> scripts_;
+};
+
+template <typename ScriptResult, typename ReplyType>
+ReplyType ScriptRegistry::Eval(const Script& script,
+                               std::vector<std::string> keys,
+                               std::vector<std::string> args,
+                               const CommandControl& command_control) {
+  // keys and args are kept for the rare retry, they are much smaller than
+  // the script body
+  auto result = client_
+                    ->EvalSha<ScriptResult, ReplyType>(script.GetSha1(), keys,
+                                                       args, command_control)
+                    .Get();
+  if (!result.IsNoScriptError()) return result.Extract();
+
+  Load(script, client_->ShardByKey(keys.at(0)), command_control);
+  result = client_
+               ->EvalSha<ScriptResult, ReplyType>(
+                   script.GetSha1(), std::move(keys), std::move(args),
+                   command_control)
+               .Get();
+  if (result.IsNoScriptError()) {
+    throw USERVER_NAMESPACE::redis::Exception(
+        "NOSCRIPT after SCRIPT LOAD of script " + script.GetSha1());
+  }
+  return result.Extract();
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
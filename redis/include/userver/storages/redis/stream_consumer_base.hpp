@@ -0,0 +1,133 @@
+#pragma once
+
+/// @file userver/storages/redis/stream_consumer_base.hpp
+/// @brief @copybrief storages::redis::StreamConsumerBase
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <userver/storages/redis/client_fwd.hpp>
+#include <userver/storages/redis/command_control.hpp>
+#include <userver/storages/redis/script_registry.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+struct StreamConsumerSettings final {
+  /// Key of the stream
+  std::string stream;
+  /// Consumer group, created with `MKSTREAM` if it does not exist
+  std::string group;
+  /// Name of this consumer in the group, must be unique among the instances
+  std::string consumer;
+  /// `COUNT` of XREADGROUP and XAUTOCLAIM
+  std::size_t batch_size{100};
+  /// Limit for concurrently running `Process` calls
+  std::size_t max_parallelism{8};
+  /// Period of polling the stream when it has no new messages
+  std::chrono::milliseconds poll_interval{100};
+  /// Messages of any consumer pending for that long are reclaimed by this
+  /// consumer with XAUTOCLAIM, they are either failed or their consumer died
+  std::chrono::milliseconds min_idle_to_reclaim{std::chrono::seconds{30}};
+  /// Command control of the Redis requests
+  CommandControl command_control{};
+};
+
+struct StreamMessage final {
+  /// Stream entry id, e.g. "1700000000000-0"
+  std::string id;
+  std::vector<std::pair<std::string, std::string>> fields;
+};
+
+struct StreamConsumerStatistics final {
+  std::atomic<std::uint64_t> received{0};
+  std::atomic<std::uint64_t> reclaimed{0};
+  std::atomic<std::uint64_t> processed{0};
+  std::atomic<std::uint64_t> failed{0};
+  /// Age of the last received message by the time of its receiving, computed
+  /// from its id
+  std::atomic<std::int64_t> lag_ms{0};
+};
+
+// clang-format off
+
+/// @ingroup userver_base_classes
+///
+/// @brief Base class for consumers of a Redis stream in a consumer group.
+/// You should derive from it and override `Process` method, which gets called
+/// for each message of the stream.
+///
+/// The messages are read with XREADGROUP in batches of
+/// StreamConsumerSettings::batch_size, processed with bounded parallelism and
+/// acknowledged with a single XACK per batch. The messages that stay pending
+/// for StreamConsumerSettings::min_idle_to_reclaim, i.e. that failed or whose
+/// consumer died, are reclaimed with XAUTOCLAIM and processed again.
+///
+/// All the commands are executed as Lua scripts with EVALSHA, so the client
+/// does not need the stream commands and never blocks the connection. Requires
+/// Redis 6.2 or newer.
+///
+/// @note You must call `Stop` before derived class is destroyed, otherwise a
+/// race is possible, when `Process` is called concurrently with derived class
+/// destructor, which is UB.
+///
+/// @note The delivery is `at least once`, hence some deduplication might be
+/// needed on your side.
+
+// clang-format on
+
+class StreamConsumerBase {
+ public:
+  StreamConsumerBase(ClientPtr client, StreamConsumerSettings settings);
+  virtual ~StreamConsumerBase();
+
+  /// @brief Start consuming messages in background. Calling this method on
+  /// running consumer has no effect. Redis failures are retried in
+  /// background.
+  void Start();
+
+  /// @brief Stop consuming messages, waits for the running `Process` calls.
+  void Stop();
+
+  const StreamConsumerStatistics& GetStatistics() const noexcept;
+
+ protected:
+  /// @brief Override this method in derived class and implement message
+  /// handling logic.
+  ///
+  /// If this method returns successfully the message is acknowledged, if it
+  /// throws the message stays pending and is reclaimed later.
+  virtual void Process(const StreamMessage& message) = 0;
+
+ private:
+  void Poll();
+  void EnsureGroup();
+  /// @returns whether the batch was full and there may be more messages
+  bool ConsumeBatch(std::vector<StreamMessage> messages);
+  std::vector<StreamMessage> ReadNew();
+  std::vector<StreamMessage> Reclaim();
+  void Ack(std::vector<std::string> ids);
+
+  const ClientPtr client_;
+  const StreamConsumerSettings settings_;
+  ScriptRegistry scripts_;
+  StreamConsumerStatistics stats_;
+  bool group_created_{false};
+  std::string reclaim_cursor_{"0-0"};
+  utils::PeriodicTask poll_task_;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const StreamConsumerStatistics& stats);
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
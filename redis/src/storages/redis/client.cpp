@@ -1,11 +1,35 @@
 #include <userver/storages/redis/client.hpp>
 
+#include <functional>
+#include <unordered_map>
+
 #include <storages/redis/impl/sentinel.hpp>
+#include <storages/redis/request_data_impl.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::redis {
 
+namespace {
+
+// Positions of the items in `items`, grouped by the keys of the items
+template <typename T, typename GetKey>
+std::vector<std::vector<size_t>> GroupByKeys(
+    const std::function<size_t(const std::string&)>& group_by_key,
+    const std::vector<T>& items, GetKey get_key) {
+  std::vector<std::vector<size_t>> positions;
+  std::unordered_map<size_t, size_t> group_indices;
+  for (size_t i = 0; i < items.size(); ++i) {
+    const auto [it, inserted] = group_indices.emplace(
+        group_by_key(get_key(items[i])), positions.size());
+    if (inserted) positions.emplace_back();
+    positions[it->second].push_back(i);
+  }
+  return positions;
+}
+
+}  // namespace
+
 std::string CreateTmpKey(const std::string& key, std::string prefix) {
   return USERVER_NAMESPACE::redis::Sentinel::CreateTmpKey(key,
                                                           std::move(prefix));
@@ -59,6 +83,55 @@ ScanRequest<ScanTag::kZscan> Client::Zscan(
   return Zscan(std::move(key), {}, command_control);
 }
 
+std::function<size_t(const std::string&)> Client::GetMultiKeyGroupByKey()
+    const {
+  return [this](const std::string& key) { return ShardByKey(key); };
+}
+
+RequestMget Client::MgetAcrossShards(std::vector<std::string> keys,
+                                     const CommandControl& command_control,
+                                     PartialResults partial_results) {
+  const auto keys_count = keys.size();
+  auto key_positions = GroupByKeys(
+      GetMultiKeyGroupByKey(), keys,
+      [](const std::string& key) -> const std::string& { return key; });
+
+  std::vector<RequestMget> requests;
+  requests.reserve(key_positions.size());
+  for (const auto& positions : key_positions) {
+    std::vector<std::string> shard_keys;
+    shard_keys.reserve(positions.size());
+    for (auto pos : positions) shard_keys.push_back(std::move(keys[pos]));
+    requests.push_back(Mget(std::move(shard_keys), command_control));
+  }
+
+  return RequestMget(std::make_unique<MgetAcrossShardsRequestDataImpl>(
+      std::move(requests), std::move(key_positions), keys_count,
+      partial_results));
+}
+
+RequestMset Client::MsetAcrossShards(
+    std::vector<std::pair<std::string, std::string>> key_values,
+    const CommandControl& command_control) {
+  const auto key_positions = GroupByKeys(
+      GetMultiKeyGroupByKey(), key_values,
+      [](const auto& kv) -> const std::string& { return kv.first; });
+
+  std::vector<RequestMset> requests;
+  requests.reserve(key_positions.size());
+  for (const auto& positions : key_positions) {
+    std::vector<std::pair<std::string, std::string>> shard_key_values;
+    shard_key_values.reserve(positions.size());
+    for (auto pos : positions) {
+      shard_key_values.push_back(std::move(key_values[pos]));
+    }
+    requests.push_back(Mset(std::move(shard_key_values), command_control));
+  }
+
+  return RequestMset(
+      std::make_unique<MsetAcrossShardsRequestDataImpl>(std::move(requests)));
+}
+
 }  // namespace storages::redis
 
 USERVER_NAMESPACE_END
@@ -124,6 +124,37 @@ UTEST_F(RedisClusterClientTest, MgetCrossSlot) {
   }
 }
 
+UTEST_F(RedisClusterClientTest, MgetMsetAcrossShards) {
+  auto client = GetClient();
+
+  const size_t kNumKeys = 50;
+  const int add = 100;
+
+  std::vector<std::pair<std::string, std::string>> key_values;
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    key_values.emplace_back(MakeKey(i), std::to_string(add + i));
+    keys.push_back(MakeKey(i));
+  }
+  keys.push_back("missing_key");
+
+  UASSERT_NO_THROW(
+      client->MsetAcrossShards(std::move(key_values), kDefaultCc).Get());
+
+  const auto reply = client->MgetAcrossShards(keys, kDefaultCc).Get();
+  ASSERT_EQ(reply.size(), kNumKeys + 1);
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    ASSERT_TRUE(reply[i]);
+    EXPECT_EQ(*reply[i], std::to_string(add + i));
+  }
+  EXPECT_FALSE(reply.back());
+
+  for (size_t i = 0; i < kNumKeys; ++i) {
+    auto req = client->Del(MakeKey(i), kDefaultCc);
+    EXPECT_EQ(req.Get(), 1);
+  }
+}
+
 UTEST_F(RedisClusterClientTest, Transaction) {
   auto client = GetClient();
   auto transaction = client->Multi();
@@ -3,6 +3,7 @@
 #include <userver/utils/assert.hpp>
 
 #include <storages/redis/impl/sentinel.hpp>
+#include <storages/redis/impl/sentinel_impl.hpp>
 
 #include "request_impl.hpp"
 #include "transaction_impl.hpp"
@@ -50,6 +51,15 @@ size_t ClientImpl::ShardByKey(const std::string& key) const {
   return redis_client_->ShardByKey(key);
 }
 
+std::function<size_t(const std::string&)> ClientImpl::GetMultiKeyGroupByKey()
+    const {
+  // Multi-key commands fail for the keys from different hash slots
+  if (redis_client_->IsInClusterMode()) {
+    return &USERVER_NAMESPACE::redis::SentinelImpl::HashSlot;
+  }
+  return Client::GetMultiKeyGroupByKey();
+}
+
 const std::string& ClientImpl::GetAnyKeyForShard(size_t shard_idx) const {
   return redis_client_->GetAnyKeyForShard(shard_idx);
 }
@@ -437,6 +437,10 @@ class ClientImpl final : public Client,
 
   friend class TransactionImpl;
 
+ protected:
+  std::function<size_t(const std::string&)> GetMultiKeyGroupByKey()
+      const override;
+
  private:
   using CmdArgs = USERVER_NAMESPACE::redis::CmdArgs;
 
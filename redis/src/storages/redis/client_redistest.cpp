@@ -7,6 +7,7 @@
 #include <vector>
 
 #include <userver/engine/task/task.hpp>
+#include <userver/storages/redis/script_registry.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -35,6 +36,14 @@ std::optional<std::string> RedisClientCancelRequest(
 }
 /// [Sample Redis Cancel request]
 
+/// [Sample ScriptRegistry usage]
+std::int64_t RedisScriptRegistryUsage(storages::redis::ScriptRegistry& scripts,
+                                      const storages::redis::Script& incr) {
+  // EVALSHA, the script body is not sent unless the server lost the script
+  return scripts.Eval<std::int64_t>(incr, {"counter"}, {"5"}, {});
+}
+/// [Sample ScriptRegistry usage]
+
 }  // namespace
 
 UTEST_F(RedisClientTest, Sample) { RedisClientSampleUsage(*GetClient()); }
@@ -102,6 +111,20 @@ UTEST_F(RedisClientTest, Mget) {
   EXPECT_EQ(*result[1], "bar");
 }
 
+UTEST_F(RedisClientTest, MgetMsetAcrossShards) {
+  auto client = GetClient();
+  client->MsetAcrossShards({{"key0", "foo"}, {"key1", "bar"}}, {}).Get();
+
+  auto result =
+      client->MgetAcrossShards({"key1", "key2", "key0"}, {}).Get();
+  ASSERT_EQ(result.size(), 3);
+  EXPECT_EQ(*result[0], "bar");
+  EXPECT_FALSE(result[1]);
+  EXPECT_EQ(*result[2], "foo");
+
+  EXPECT_TRUE(client->MgetAcrossShards({}, {}).Get().empty());
+}
+
 UTEST_F(RedisClientTest, Unlink) {
   auto client = GetClient();
   client->Set("key0", "foo", {}).Get();
@@ -212,6 +235,22 @@ UTEST_F(RedisClientTest, EvalSha) {
   EXPECT_EQ(result_array[0], "key1");
 }
 
+UTEST_F(RedisClientTest, ScriptRegistry) {
+  auto client = GetClient();
+  storages::redis::ScriptRegistry scripts{client};
+
+  const auto incr =
+      scripts.Register("return redis.call('incrby', KEYS[1], ARGV[1])", {});
+  EXPECT_EQ(RedisScriptRegistryUsage(scripts, incr), 5);
+  EXPECT_EQ(RedisScriptRegistryUsage(scripts, incr), 10);
+
+  // not registered, loaded on NOSCRIPT
+  const storages::redis::Script unknown{"return KEYS[1] .. ARGV[1]"};
+  EXPECT_EQ(scripts.Eval<std::string>(unknown, {"key"}, {"1"}, {}), "key1");
+
+  scripts.LoadAll({});
+}
+
 UTEST_F(RedisClientTest, Exists) {
   auto client = GetClient();
   client->Set("key1", "Hello", {}).Get();
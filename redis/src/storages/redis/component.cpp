@@ -310,6 +310,9 @@ void Redis::OnConfigUpdate(const dynamic_config::Snapshot& cfg) {
     client->SetReplicationMonitoringSettings(
         redis_config.replication_monitoring_settings.GetOptional(name).value_or(
             redis::ReplicationMonitoringSettings{}));
+    client->SetHotKeysSettings(
+        redis_config.hot_keys_settings.GetOptional(name).value_or(
+            redis::HotKeysSettings{}));
     client->SetClusterAutoTopology(auto_topology);
   }
 
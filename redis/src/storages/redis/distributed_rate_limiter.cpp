@@ -0,0 +1,157 @@
+#include <userver/storages/redis/distributed_rate_limiter.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <userver/logging/log.hpp>
+#include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/reply.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+namespace {
+
+// KEYS[1] - instances by expiration time, KEYS[2] - demand by instance
+// ARGV - instance id, ttl ms, demand per second
+const Script kSyncScript{R"(
+if redis.replicate_commands then redis.replicate_commands() end
+local time = redis.call('TIME')
+local now_ms = time[1] * 1000 + math.floor(time[2] / 1000)
+local expired = redis.call('ZRANGEBYSCORE', KEYS[1], '-inf', now_ms)
+if #expired > 0 then
+  redis.call('ZREM', KEYS[1], unpack(expired))
+  redis.call('HDEL', KEYS[2], unpack(expired))
+end
+redis.call('ZADD', KEYS[1], now_ms + tonumber(ARGV[2]), ARGV[1])
+redis.call('HSET', KEYS[2], ARGV[1], ARGV[3])
+redis.call('PEXPIRE', KEYS[1], ARGV[2])
+redis.call('PEXPIRE', KEYS[2], ARGV[2])
+local total = 0
+for _, demand in ipairs(redis.call('HVALS', KEYS[2])) do
+  total = total + tonumber(demand)
+end
+return {redis.call('ZCARD', KEYS[1]), tostring(total)}
+)"};
+
+// Half of the quota is split equally, half follows the demand
+constexpr double kDemandWeight = 0.5;
+
+// Higher rates are refilled in batches each millisecond
+constexpr auto kMinRefillInterval = std::chrono::milliseconds{1};
+
+using SecondsDouble = std::chrono::duration<double>;
+
+}  // namespace
+
+DistributedRateLimiter::DistributedRateLimiter(
+    ClientPtr client, DistributedRateLimiterSettings settings)
+    : client_(std::move(client)),
+      settings_(std::move(settings)),
+      scripts_(client_) {
+  UINVARIANT(!settings_.key.empty(), "key must not be empty");
+  UINVARIANT(!settings_.instance_id.empty(), "instance_id must not be empty");
+  UINVARIANT(settings_.global_rate_ps >= 0,
+             "global_rate_ps must not be negative");
+  UINVARIANT(settings_.initial_instances_estimate > 0,
+             "initial_instances_estimate must be positive");
+  SetLocalRate(settings_.global_rate_ps /
+               static_cast<double>(settings_.initial_instances_estimate));
+}
+
+DistributedRateLimiter::~DistributedRateLimiter() { Stop(); }
+
+void DistributedRateLimiter::Start() {
+  if (sync_task_.IsRunning()) return;
+  last_sync_ = std::chrono::steady_clock::now();
+  sync_task_.Start(
+      "redis_rate_limiter_sync",
+      {settings_.sync_interval, {utils::PeriodicTask::Flags::kNow}},
+      [this] { Sync(); });
+}
+
+void DistributedRateLimiter::Stop() { sync_task_.Stop(); }
+
+bool DistributedRateLimiter::Obtain() {
+  requested_.fetch_add(1, std::memory_order_relaxed);
+  return bucket_.Obtain();
+}
+
+bool DistributedRateLimiter::ObtainAll(std::size_t count) {
+  requested_.fetch_add(count, std::memory_order_relaxed);
+  return bucket_.ObtainAll(count);
+}
+
+double DistributedRateLimiter::GetLocalRatePs() const noexcept {
+  return local_rate_ps_.load(std::memory_order_relaxed);
+}
+
+std::size_t DistributedRateLimiter::GetInstancesCount() const noexcept {
+  return instances_.load(std::memory_order_relaxed);
+}
+
+void DistributedRateLimiter::Sync() {
+  const auto now = std::chrono::steady_clock::now();
+  const auto elapsed = std::chrono::duration_cast<SecondsDouble>(
+      std::max(now - last_sync_, std::chrono::steady_clock::duration{
+                                     kMinRefillInterval}));
+  last_sync_ = now;
+  const double demand =
+      static_cast<double>(requested_.exchange(0, std::memory_order_relaxed)) /
+      elapsed.count();
+
+  // the hash tag keeps both keys on the same shard
+  const auto prefix = '{' + settings_.key + '}';
+  const auto reply = scripts_.Eval<ReplyData>(
+      kSyncScript, {prefix + ":instances", prefix + ":demand"},
+      {settings_.instance_id, std::to_string(settings_.instance_ttl.count()),
+       std::to_string(demand)},
+      settings_.command_control);
+  if (!reply.IsArray() || reply.GetArray().size() != 2) {
+    throw USERVER_NAMESPACE::redis::Exception(
+        "Unexpected rate limiter sync reply: " + reply.ToDebugString());
+  }
+
+  const auto instances =
+      std::max<std::int64_t>(reply.GetArray()[0].GetInt(), 1);
+  const double total_demand = std::stod(reply.GetArray()[1].GetString());
+  instances_.store(instances, std::memory_order_relaxed);
+
+  const double equal_share = 1.0 / static_cast<double>(instances);
+  const double demand_share =
+      total_demand > 0 ? demand / total_demand : equal_share;
+  SetLocalRate(settings_.global_rate_ps *
+               ((1 - kDemandWeight) * equal_share +
+                kDemandWeight * demand_share));
+}
+
+void DistributedRateLimiter::SetLocalRate(double rate_ps) {
+  local_rate_ps_.store(rate_ps, std::memory_order_relaxed);
+  if (rate_ps <= 0) {
+    bucket_.SetMaxSize(0);
+    bucket_.SetRefillPolicy({0, utils::TokenBucket::Duration::max()});
+    return;
+  }
+
+  const auto burst = std::chrono::duration_cast<SecondsDouble>(settings_.burst);
+  bucket_.SetMaxSize(
+      std::max<std::size_t>(1, std::llround(rate_ps * burst.count())));
+
+  const auto min_interval =
+      std::chrono::duration_cast<SecondsDouble>(kMinRefillInterval);
+  if (rate_ps * min_interval.count() >= 1) {
+    bucket_.SetRefillPolicy(
+        {static_cast<std::size_t>(std::llround(rate_ps * min_interval.count())),
+         kMinRefillInterval});
+  } else {
+    bucket_.SetRefillPolicy(
+        {1, std::chrono::duration_cast<utils::TokenBucket::Duration>(
+                SecondsDouble{1 / rate_ps})});
+  }
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,69 @@
+#include <storages/redis/client_redistest.hpp>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/storages/redis/distributed_rate_limiter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+storages::redis::DistributedRateLimiterSettings MakeSettings(
+    std::string instance_id) {
+  storages::redis::DistributedRateLimiterSettings settings;
+  settings.key = "downstream_quota";
+  settings.instance_id = std::move(instance_id);
+  settings.global_rate_ps = 100;
+  settings.sync_interval = std::chrono::milliseconds{20};
+  settings.instance_ttl = std::chrono::milliseconds{200};
+  return settings;
+}
+
+void WaitForInstances(const storages::redis::DistributedRateLimiter& limiter,
+                      std::size_t instances) {
+  while (limiter.GetInstancesCount() != instances) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+}
+
+}  // namespace
+
+UTEST_F(RedisClientTest, DistributedRateLimiter) {
+  auto client = GetClient();
+
+  /// [Sample DistributedRateLimiter usage]
+  storages::redis::DistributedRateLimiter limiter{client,
+                                                  MakeSettings("first")};
+  limiter.Start();
+  // ...
+  if (!limiter.Obtain()) {
+    // the shared quota is exhausted, reject the request
+  }
+  /// [Sample DistributedRateLimiter usage]
+
+  WaitForInstances(limiter, 1);
+  EXPECT_DOUBLE_EQ(limiter.GetLocalRatePs(), 100);
+
+  {
+    storages::redis::DistributedRateLimiter second{client,
+                                                   MakeSettings("second")};
+    second.Start();
+    WaitForInstances(limiter, 2);
+    WaitForInstances(second, 2);
+
+    // the demanding instance gets the larger share
+    while (limiter.GetLocalRatePs() <= second.GetLocalRatePs()) {
+      for (int i = 0; i < 10; ++i) {
+        [[maybe_unused]] const auto obtained = limiter.Obtain();
+      }
+      engine::SleepFor(std::chrono::milliseconds{10});
+    }
+    second.Stop();
+  }
+
+  // the stopped instance expires and its share is returned
+  WaitForInstances(limiter, 1);
+  EXPECT_DOUBLE_EQ(limiter.GetLocalRatePs(), 100);
+  limiter.Stop();
+}
+
+USERVER_NAMESPACE_END
@@ -1,9 +1,10 @@
 #include "cluster_sentinel_impl.hpp"
 
 #include <atomic>
+#include <charconv>
+#include <optional>
 
 #include <fmt/format.h>
-#include <boost/crc.hpp>
 
 #include <userver/concurrent/variable.hpp>
 #include <userver/rcu/rcu.hpp>
@@ -26,21 +27,15 @@ namespace redis {
 
 namespace {
 const auto kProcessCreationInterval = std::chrono::seconds(3);
+/// MOVED replies come in floods while resharding, the slot map is updated for
+/// each of them and the full topology at most once per this interval
+const auto kMovedTopologyUpdateInterval = std::chrono::seconds(1);
 
 bool CheckQuorum(size_t requests_sent, size_t responses_parsed) {
   const size_t quorum = requests_sent / 2 + 1;
   return responses_parsed >= quorum;
 }
 
-size_t HashSlot(const std::string& key) {
-  size_t start = 0;
-  size_t len = 0;
-  GetRedisKey(key, &start, &len);
-  return std::for_each(key.data() + start, key.data() + start + len,
-                       boost::crc_optimal<16, 0x1021>())() &
-         0x3fff;
-}
-
 std::string ParseMovedShard(const std::string& err_string) {
   static const auto kUnknownShard = std::string("");
   size_t pos = err_string.find(' ');  // skip "MOVED" or "ASK"
@@ -62,6 +57,20 @@ std::string ParseMovedShard(const std::string& err_string) {
   return err_string.substr(pos, colon_pos - pos) + ":" + std::to_string(port);
 }
 
+std::optional<uint16_t> ParseMovedSlot(const std::string& err_string) {
+  // "MOVED <slot> <host>:<port>"
+  const size_t pos = err_string.find(' ');
+  if (pos == std::string::npos) return std::nullopt;
+  uint16_t slot = 0;
+  const auto* begin = err_string.data() + pos + 1;
+  const auto* end = err_string.data() + err_string.size();
+  const auto [ptr, ec] = std::from_chars(begin, end, slot);
+  if (ec != std::errc{} || ptr == begin || slot >= kClusterHashSlots) {
+    return std::nullopt;
+  }
+  return slot;
+}
+
 struct CommandSpecialPrinter {
   const CommandPtr& command;
 };
@@ -133,11 +142,12 @@ class ClusterTopologyHolder
       const std::shared_ptr<engine::ev::ThreadPool>& redis_thread_pool,
       std::string shard_group_name, Password password,
       const std::vector<std::string>& /*shards*/,
-      const std::vector<ConnectionInfo>& conns)
+      const std::vector<ConnectionInfo>& conns, ConnectionMode mode)
       : ev_thread_(sentinel_thread_control),
         redis_thread_pool_(redis_thread_pool),
         shard_group_name_(std::move(shard_group_name)),
         password_(std::move(password)),
+        connection_mode_(mode),
         shards_names_(MakeShardNames()),
         conns_(conns),
         update_topology_timer_(
@@ -251,6 +261,30 @@ class ClusterTopologyHolder
 
   void SendUpdateClusterTopology() { update_topology_watch_.Send(); }
 
+  /// Applies a MOVED redirection to the slot map, the full topology update
+  /// is throttled unless the redirection is to an unknown node
+  void HandleMovedReply(const std::string& err_string) {
+    const auto slot = ParseMovedSlot(err_string);
+    bool is_moved = false;
+    if (slot) {
+      const auto topology = topology_.Read();
+      is_moved = topology->MoveSlot(*slot, ParseMovedShard(err_string));
+    }
+    if (!is_moved) {
+      SendUpdateClusterTopology();
+      return;
+    }
+    ++cluster_slot_updates_counter_;
+
+    const auto now = std::chrono::steady_clock::now();
+    auto last_update = last_moved_topology_update_.load();
+    if (now - last_update < kMovedTopologyUpdateInterval) return;
+    if (last_moved_topology_update_.compare_exchange_strong(last_update,
+                                                            now)) {
+      SendUpdateClusterTopology();
+    }
+  }
+
   std::shared_ptr<Redis> GetRedisInstance(const HostPort& host_port) const {
     const auto connection = nodes_.Get(host_port);
     if (!connection) {
@@ -309,6 +343,7 @@ class ClusterTopologyHolder
 
   std::string shard_group_name_;
   Password password_;
+  const ConnectionMode connection_mode_;
   std::shared_ptr<const std::vector<std::string>> shards_names_;
   std::vector<ConnectionInfo> conns_;
   std::shared_ptr<Shard> sentinels_;
@@ -341,6 +376,9 @@ class ClusterTopologyHolder
   std::atomic<bool> is_topology_received_{false};
   std::atomic<bool> is_nodes_received_{false};
   std::atomic<bool> update_cluster_slots_flag_{false};
+  std::atomic<std::chrono::steady_clock::time_point>
+      last_moved_topology_update_{};
+  std::atomic<size_t> cluster_slot_updates_counter_{0};
   bool IsInitialized() const {
     return is_nodes_received_.load() && is_topology_received_.load();
   }
@@ -542,7 +580,7 @@ ClusterTopologyHolder::CreateRedisInstance(const std::string& host_port) {
   return std::make_shared<RedisConnectionHolder>(
       ev_thread_, redis_thread_pool_, host, port, password_,
       buffering_settings_ptr->value_or(CommandsBufferingSettings{}),
-      *replication_monitoring_settings_ptr);
+      *replication_monitoring_settings_ptr, connection_mode_);
 }
 
 namespace {
@@ -629,6 +667,8 @@ void ClusterTopologyHolder::GetStatistics(
       cluster_slots_call_counter_.load(std::memory_order_relaxed);
   stats.internal.cluster_topology_updates =
       current_topology_version_.load(std::memory_order_relaxed);
+  stats.internal.cluster_slot_updates =
+      cluster_slot_updates_counter_.load(std::memory_order_relaxed);
 
   auto topology = GetTopology();
   topology->GetStatistics(settings, stats);
@@ -643,7 +683,7 @@ ClusterSentinelImpl::ClusterSentinelImpl(
     ConnectionSecurity /*connection_security*/,
     ReadyChangeCallback ready_callback,
     std::unique_ptr<KeyShard>&& /*key_shard*/,
-    dynamic_config::Source dynamic_config_source, ConnectionMode /*mode*/)
+    dynamic_config::Source dynamic_config_source, ConnectionMode mode)
     : sentinel_obj_(sentinel),
       ev_thread_(sentinel_thread_control),
       process_waiting_commands_timer_(
@@ -652,7 +692,7 @@ ClusterSentinelImpl::ClusterSentinelImpl(
               kSentinelGetHostsCheckInterval)),
       topology_holder_(std::make_shared<ClusterTopologyHolder>(
           ev_thread_, redis_thread_pool, shard_group_name, password, shards,
-          conns)),
+          conns, mode)),
       shard_group_name_(std::move(shard_group_name)),
       conns_(conns),
       ready_callback_(std::move(ready_callback)),
@@ -760,15 +800,13 @@ void ClusterSentinelImpl::AsyncCommand(const SentinelCommand& scommand,
         const bool error_ask = reply->data.IsErrorAsk();
         const bool error_moved = reply->data.IsErrorMoved();
         if (error_moved) {
-          auto topology = topology_holder_->GetTopology();
-
           const auto& args = ccommand->args.args;
           LOG_DEBUG() << "MOVED" << reply->status_string
                       << " c.instance_idx:" << ccommand->instance_idx
                       << " shard: " << shard
                       << " movedto:" << ParseMovedShard(reply->data.GetError())
                       << " args:" << args;
-          this->topology_holder_->SendUpdateClusterTopology();
+          this->topology_holder_->HandleMovedReply(reply->data.GetError());
         }
         const bool retry_to_master =
             !master && reply->data.IsNil() &&
@@ -852,7 +890,7 @@ void ClusterSentinelImpl::AsyncCommandToSentinel(CommandPtr /*command*/) {
 }
 
 size_t ClusterSentinelImpl::ShardByKey(const std::string& key) const {
-  const auto slot = HashSlot(key);
+  const auto slot = KeySlot(key);
   const auto ptr = topology_holder_->GetTopology();
   return ptr->GetShardIndexBySlot(slot);
 }
@@ -66,7 +66,7 @@ ClusterTopology::ClusterTopology(
     for (const auto& info : infos_) {
       for (const auto& interval : info.slot_intervals) {
         for (size_t i = interval.slot_min; i <= interval.slot_max; ++i) {
-          slot_to_shard_[i] = shard_index;
+          (*slot_to_shard_)[i].store(shard_index, std::memory_order_relaxed);
         }
       }
       ++shard_index;
@@ -76,6 +76,15 @@ ClusterTopology::ClusterTopology(
 
 ClusterTopology::~ClusterTopology() = default;
 
+bool ClusterTopology::MoveSlot(uint16_t slot,
+                               const std::string& host_port) const {
+  if (slot >= kClusterHashSlots) return false;
+  const auto shard = GetShardByHostPort(host_port);
+  if (!shard) return false;
+  slot_to_shard_->at(slot).store(*shard, std::memory_order_relaxed);
+  return true;
+}
+
 bool ClusterTopology::IsReady(WaitConnectedMode mode) const {
   return !cluster_shards_.empty() &&
          std::all_of(
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <optional>
@@ -46,9 +47,14 @@ class ClusterTopology {
   ~ClusterTopology();
 
   size_t GetShardIndexBySlot(uint16_t slot) const {
-    return slot_to_shard_.at(slot);
+    return slot_to_shard_->at(slot).load(std::memory_order_relaxed);
   }
 
+  /// Applies a MOVED redirection to the slot map without rebuilding the
+  /// topology, the copies of the topology share the slot map.
+  /// Returns false if `host_port` is not a node of this topology.
+  bool MoveSlot(uint16_t slot, const std::string& host_port) const;
+
   std::optional<size_t> GetShardByHostPort(const std::string& host_port) const {
     auto it = host_port_to_shard_.find(host_port);
     if (it == host_port_to_shard_.end()) {
@@ -91,7 +97,8 @@ class ClusterTopology {
  private:
   ClusterShardHostInfos infos_;
   Password password_;
-  std::array<uint16_t, kClusterHashSlots> slot_to_shard_{};
+  using SlotToShard = std::array<std::atomic<uint16_t>, kClusterHashSlots>;
+  std::shared_ptr<SlotToShard> slot_to_shard_{std::make_shared<SlotToShard>()};
 
   /// Special "Shard" containing all instances of cluster, master - is 0-shard
   /// master.
@@ -0,0 +1,109 @@
+#include <storages/redis/impl/hot_keys.hpp>
+
+#include <algorithm>
+
+#include <userver/utils/datetime.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+void HotKeysDetector::SetSettings(const HotKeysSettings& settings) {
+  std::lock_guard lock(mutex_);
+  if (settings_ == settings) return;
+
+  settings_ = settings;
+  counters_.clear();
+  samples_ = 0;
+  window_start_ = utils::datetime::SteadyNow();
+  if (!settings_.enabled) Publish({});
+
+  sample_rate_.store(std::max<size_t>(settings_.sample_rate, 1),
+                     std::memory_order_relaxed);
+  offload_reads_.store(settings_.offload_reads, std::memory_order_relaxed);
+  enabled_.store(settings_.enabled, std::memory_order_relaxed);
+}
+
+bool HotKeysDetector::AccountRead(const std::string& key) {
+  if (!IsEnabled()) return false;
+
+  const auto read = reads_.fetch_add(1, std::memory_order_relaxed);
+  if (read % sample_rate_.load(std::memory_order_relaxed) == 0) Sample(key);
+
+  if (hot_keys_count_.load(std::memory_order_relaxed) == 0) return false;
+  const auto hot_keys = hot_keys_.Read();
+  if (!hot_keys->keys.count(key)) return false;
+
+  hot_reads_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+std::vector<HotKey> HotKeysDetector::GetHotKeys() const {
+  const auto hot_keys = hot_keys_.Read();
+  return hot_keys->sorted;
+}
+
+void HotKeysDetector::Sample(const std::string& key) {
+  std::lock_guard lock(mutex_);
+  if (!settings_.enabled) return;
+
+  const auto now = utils::datetime::SteadyNow();
+  if (now - window_start_ >= settings_.window) FinishWindow(now);
+
+  ++samples_;
+  const auto it = counters_.find(key);
+  if (it != counters_.end()) {
+    ++it->second.count;
+    return;
+  }
+  if (counters_.size() < std::max<size_t>(settings_.capacity, 1)) {
+    counters_.emplace(key, Counter{1, 0});
+    return;
+  }
+
+  // Space-Saving: the new key replaces the least counted one and inherits its
+  // count as the possible overestimation
+  const auto min = std::min_element(
+      counters_.begin(), counters_.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second.count < rhs.second.count;
+      });
+  const auto min_count = min->second.count;
+  counters_.erase(min);
+  counters_.emplace(key, Counter{min_count + 1, min_count});
+}
+
+void HotKeysDetector::FinishWindow(std::chrono::steady_clock::time_point now) {
+  HotKeys hot_keys;
+  if (samples_ >= settings_.min_samples) {
+    for (const auto& [key, counter] : counters_) {
+      const auto guaranteed_count = counter.count - counter.error;
+      if (guaranteed_count * 100 >= samples_ * settings_.min_share_percent) {
+        hot_keys.sorted.push_back(
+            {key, 100.0 * static_cast<double>(guaranteed_count) /
+                      static_cast<double>(samples_)});
+      }
+    }
+    std::sort(hot_keys.sorted.begin(), hot_keys.sorted.end(),
+              [](const HotKey& lhs, const HotKey& rhs) {
+                return lhs.share_percent > rhs.share_percent;
+              });
+    for (const auto& hot_key : hot_keys.sorted) {
+      hot_keys.keys.insert(hot_key.key);
+    }
+  }
+  Publish(std::move(hot_keys));
+
+  counters_.clear();
+  samples_ = 0;
+  window_start_ = now;
+}
+
+void HotKeysDetector::Publish(HotKeys&& hot_keys) {
+  const auto count = hot_keys.keys.size();
+  hot_keys_.Assign(std::move(hot_keys));
+  hot_keys_count_.store(count, std::memory_order_relaxed);
+}
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <userver/rcu/rcu.hpp>
+#include <userver/storages/redis/impl/base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+struct HotKey {
+  std::string key;
+  /// Lower bound of the share of the key in the sampled reads of the last
+  /// finished window
+  double share_percent{0};
+};
+
+/// Detects the keys that get a big share of the reads of a shard.
+///
+/// Every HotKeysSettings::sample_rate-th read is accounted in a Space-Saving
+/// sketch of HotKeysSettings::capacity counters. When a window finishes, the
+/// keys whose guaranteed count makes at least
+/// HotKeysSettings::min_share_percent of the sampled reads become hot until
+/// the next window finishes.
+///
+/// The reads that are not sampled only check an atomic counter and, if there
+/// are hot keys, look the key up in a hash set.
+class HotKeysDetector final {
+ public:
+  void SetSettings(const HotKeysSettings& settings);
+
+  bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /// @see HotKeysSettings::offload_reads
+  bool IsOffloadEnabled() const {
+    return offload_reads_.load(std::memory_order_relaxed);
+  }
+
+  /// Accounts a read of the key, returns true if the key is hot
+  bool AccountRead(const std::string& key);
+
+  /// Hot keys of the last finished window, the hottest first
+  std::vector<HotKey> GetHotKeys() const;
+
+  /// Count of the reads of the hot keys
+  size_t GetHotReads() const {
+    return hot_reads_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Counter {
+    size_t count{0};
+    /// Max overestimation of `count` inherited from the evicted key
+    size_t error{0};
+  };
+
+  struct HotKeys {
+    std::unordered_set<std::string> keys;
+    std::vector<HotKey> sorted;
+  };
+
+  struct RcuTraits {
+    using MutexType = std::mutex;
+  };
+
+  void Sample(const std::string& key);
+  void FinishWindow(std::chrono::steady_clock::time_point now);
+  void Publish(HotKeys&& hot_keys);
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<bool> offload_reads_{false};
+  std::atomic<size_t> sample_rate_{1};
+  std::atomic<size_t> reads_{0};
+  std::atomic<size_t> hot_keys_count_{0};
+  std::atomic<size_t> hot_reads_{0};
+
+  std::mutex mutex_;  // protects the sketch
+  HotKeysSettings settings_;
+  std::unordered_map<std::string, Counter> counters_;
+  size_t samples_{0};
+  std::chrono::steady_clock::time_point window_start_;
+
+  rcu::Variable<HotKeys, RcuTraits> hot_keys_;
+};
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
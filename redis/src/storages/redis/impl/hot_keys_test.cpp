@@ -0,0 +1,109 @@
+#include <storages/redis/impl/hot_keys.hpp>
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/mock_now.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::chrono::seconds kWindow{1};
+
+redis::HotKeysSettings MakeSettings() {
+  redis::HotKeysSettings settings;
+  settings.enabled = true;
+  settings.sample_rate = 1;
+  settings.capacity = 8;
+  settings.min_share_percent = 20;
+  settings.min_samples = 10;
+  settings.window = kWindow;
+  return settings;
+}
+
+// Reads the hot key along with as many distinct cold keys
+void ReadWithColdKeys(redis::HotKeysDetector& detector, const std::string& key,
+                      int count) {
+  for (int i = 0; i < count; ++i) {
+    detector.AccountRead(key);
+    detector.AccountRead("cold-" + std::to_string(i));
+  }
+}
+
+}  // namespace
+
+TEST(RedisHotKeys, Detects) {
+  utils::datetime::MockNowSet(utils::datetime::Now());
+  redis::HotKeysDetector detector;
+  detector.SetSettings(MakeSettings());
+
+  ReadWithColdKeys(detector, "hot", 50);
+  EXPECT_TRUE(detector.GetHotKeys().empty());
+
+  utils::datetime::MockSleep(kWindow);
+  EXPECT_TRUE(detector.AccountRead("hot"));
+  EXPECT_FALSE(detector.AccountRead("cold-0"));
+  EXPECT_EQ(detector.GetHotReads(), 1);
+
+  const auto hot_keys = detector.GetHotKeys();
+  ASSERT_EQ(hot_keys.size(), 1);
+  EXPECT_EQ(hot_keys[0].key, "hot");
+  EXPECT_DOUBLE_EQ(hot_keys[0].share_percent, 50);
+
+  utils::datetime::MockNowUnset();
+}
+
+TEST(RedisHotKeys, Expires) {
+  utils::datetime::MockNowSet(utils::datetime::Now());
+  redis::HotKeysDetector detector;
+  detector.SetSettings(MakeSettings());
+
+  ReadWithColdKeys(detector, "hot", 50);
+  utils::datetime::MockSleep(kWindow);
+  EXPECT_TRUE(detector.AccountRead("hot"));
+
+  ReadWithColdKeys(detector, "other", 20);
+  utils::datetime::MockSleep(kWindow);
+  EXPECT_FALSE(detector.AccountRead("hot"));
+  EXPECT_TRUE(detector.AccountRead("other"));
+
+  utils::datetime::MockNowUnset();
+}
+
+TEST(RedisHotKeys, NotEnoughSamples) {
+  utils::datetime::MockNowSet(utils::datetime::Now());
+  redis::HotKeysDetector detector;
+  auto settings = MakeSettings();
+  settings.min_samples = 1000;
+  detector.SetSettings(settings);
+
+  ReadWithColdKeys(detector, "hot", 50);
+  utils::datetime::MockSleep(kWindow);
+  EXPECT_FALSE(detector.AccountRead("hot"));
+  EXPECT_TRUE(detector.GetHotKeys().empty());
+
+  utils::datetime::MockNowUnset();
+}
+
+TEST(RedisHotKeys, Disabled) {
+  utils::datetime::MockNowSet(utils::datetime::Now());
+  redis::HotKeysDetector detector;
+  detector.SetSettings(MakeSettings());
+
+  ReadWithColdKeys(detector, "hot", 50);
+  utils::datetime::MockSleep(kWindow);
+  EXPECT_TRUE(detector.AccountRead("hot"));
+
+  detector.SetSettings({});
+  EXPECT_FALSE(detector.IsEnabled());
+  EXPECT_FALSE(detector.AccountRead("hot"));
+  EXPECT_TRUE(detector.GetHotKeys().empty());
+
+  utils::datetime::MockNowUnset();
+}
+
+USERVER_NAMESPACE_END
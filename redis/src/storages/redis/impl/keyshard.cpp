@@ -1,6 +1,7 @@
 #include "keyshard_impl.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <vector>
 
@@ -19,6 +20,22 @@ namespace {
 const std::string kRawKeyEncoding = "UTF-8";
 const std::string kTaximeterCrcKeyEncoding = "WINDOWS-1252//TRANSLIT";
 
+constexpr uint16_t kClusterSlotMask = 0x3fff;
+
+// CRC16-CCITT (XMODEM) as used by Redis Cluster
+constexpr auto kCrc16Table = [] {
+  std::array<uint16_t, 256> table{};
+  for (uint16_t i = 0; i < table.size(); ++i) {
+    uint16_t crc = i << 8;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                           : static_cast<uint16_t>(crc << 1);
+    }
+    table[i] = crc;
+  }
+  return table;
+}();
+
 }  // namespace
 
 void GetRedisKey(const std::string& key, size_t* key_start, size_t* key_len) {
@@ -52,6 +69,24 @@ void GetRedisKey(const std::string& key, size_t* key_start, size_t* key_len) {
   *key_len = end - start - 1;
 }
 
+uint16_t KeySlot(std::string_view key) {
+  const auto open = key.find('{');
+  if (open != std::string_view::npos) {
+    const auto close = key.find('}', open + 1);
+    if (close != std::string_view::npos && close != open + 1) {
+      key = key.substr(open + 1, close - open - 1);
+    }
+  }
+
+  uint16_t crc = 0;
+  for (const char c : key) {
+    crc = static_cast<uint16_t>(
+        (crc << 8) ^
+        kCrc16Table[((crc >> 8) ^ static_cast<unsigned char>(c)) & 0xff]);
+  }
+  return crc & kClusterSlotMask;
+}
+
 KeyShardTaximeterCrc32::KeyShardTaximeterCrc32(size_t shard_count)
     : shard_count_(shard_count),
       converter_(kRawKeyEncoding, kTaximeterCrcKeyEncoding) {}
@@ -82,4 +82,18 @@ TEST(KeyShardTaximeterCrc32, Multithreads) {
   EXPECT_EQ(kCount, counts[key_shard.ShardByKey(kKey)]);
 }
 
+TEST(KeySlot, RedisCluster) {
+  EXPECT_EQ(redis::KeySlot("123456789"), 12739);
+  EXPECT_EQ(redis::KeySlot("foo"), 12182);
+  EXPECT_EQ(redis::KeySlot("bar"), 5061);
+  EXPECT_EQ(redis::KeySlot(""), 0);
+
+  // Hash tags
+  EXPECT_EQ(redis::KeySlot("{user1000}.following"), redis::KeySlot("user1000"));
+  EXPECT_EQ(redis::KeySlot("a{user1000}{b}"), redis::KeySlot("user1000"));
+  EXPECT_EQ(redis::KeySlot("{}foo"), 9500);
+  EXPECT_EQ(redis::KeySlot("foo{"), redis::KeySlot("foo{"));
+  EXPECT_LT(redis::KeySlot(kKey), 16384);
+}
+
 USERVER_NAMESPACE_END
@@ -25,6 +25,7 @@
 #include <storages/redis/impl/ev_wrapper.hpp>
 #include <storages/redis/impl/redis_info.hpp>
 #include <storages/redis/impl/redis_stats.hpp>
+#include <storages/redis/impl/reply_reader.hpp>
 #include <storages/redis/impl/tcp_socket.hpp>
 #include <userver/storages/redis/impl/reply.hpp>
 
@@ -217,6 +218,7 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
 
   void SetState(State state);
   void ProcessCommand(const CommandPtr& command);
+  void FlushCommandsBatch(size_t batch_size);
 
   void Authenticate();
   void SendReadOnly();
@@ -277,6 +279,8 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   std::atomic_bool enable_replication_monitoring_ = false;
   std::atomic_bool forbid_requests_to_syncing_replicas_ = false;
   const bool send_readonly_;
+  // The replies of hiredis are decoded straight into ReplyData
+  const bool is_reply_data_reader_;
   const ConnectionSecurity connection_security_;
   std::chrono::milliseconds ping_interval_{2000};
   std::chrono::milliseconds ping_timeout_{4000};
@@ -380,6 +384,8 @@ Redis::RedisImpl::RedisImpl(
       ev_thread_control_(thread_control),
       thread_pool_(thread_pool),
       send_readonly_(redis_settings.send_readonly),
+      is_reply_data_reader_(redis_settings.connection_mode ==
+                            ConnectionMode::kCommands),
       connection_security_(redis_settings.connection_security),
       server_id_(ServerId::Generate()) {
   SetCommandsBufferingSettings(CommandsBufferingSettings{});
@@ -467,6 +473,7 @@ bool Redis::RedisImpl::Connect(const std::string& host, int port,
     context_ = nullptr;
     return false;
   }
+  if (is_reply_data_reader_) SetReplyDataFunctions(*context_->c.reader);
 
   ev_thread_control_.RunInEvLoopBlocking([this, &host]() {
     bool err = false;
@@ -910,7 +917,8 @@ void Redis::RedisImpl::CommandLoopOnTimer(struct ev_loop*, ev_timer* w,
 }
 
 void Redis::RedisImpl::CommandLoopImpl() {
-  if (WatchCommandTimerEnabled(*commands_buffering_settings_.Get())) {
+  const auto commands_buffering_settings = commands_buffering_settings_.Get();
+  if (WatchCommandTimerEnabled(*commands_buffering_settings)) {
     if (std::exchange(watch_command_timer_started_, false)) {
       ev_thread_control_.Stop(watch_command_timer_);
     }
@@ -922,9 +930,35 @@ void Redis::RedisImpl::CommandLoopImpl() {
     std::swap(commands_, commands);
   }
   LOG_TRACE() << "commands size=" << commands.size();
+
+  const auto max_batch_size = commands_buffering_settings->max_batch_size;
+  if (!max_batch_size) {
+    // hiredis writes all the commands on the next write event
+    if (!commands.empty()) statistics_.AccountCommandsBatch(commands.size());
+    for (auto& command : commands) {
+      ProcessCommand(command);
+    }
+    return;
+  }
+
+  // Flushing may disconnect and drop the last reference to *this
+  const auto self = shared_from_this();
+  size_t batch_size = 0;
   for (auto& command : commands) {
     ProcessCommand(command);
+    if (++batch_size == max_batch_size) {
+      FlushCommandsBatch(batch_size);
+      batch_size = 0;
+    }
   }
+  if (batch_size) FlushCommandsBatch(batch_size);
+}
+
+void Redis::RedisImpl::FlushCommandsBatch(size_t batch_size) {
+  statistics_.AccountCommandsBatch(batch_size);
+  // Write the batch right away instead of waiting for the write event. What
+  // does not fit into the socket buffer is written on the write event.
+  if (context_ && state_ == State::kConnected) redisAsyncHandleWrite(context_);
 }
 
 void Redis::RedisImpl::OnConnect(const redisAsyncContext* c,
@@ -1113,9 +1147,11 @@ void Redis::RedisImpl::OnRedisReplyImpl(redisReply* redis_reply, void* privdata,
   ev_thread_control_.Stop(data->second->timer);
   pcommand = data->second.get();
 
-  auto reply = std::make_shared<Reply>(pcommand->cmd, redis_reply,
-                                       NativeToReplyStatus(status),
-                                       errstr ? errstr : "");
+  auto reply = std::make_shared<Reply>(
+      pcommand->cmd,
+      is_reply_data_reader_ ? ExtractReplyData(redis_reply)
+                            : ReplyData{redis_reply},
+      NativeToReplyStatus(status), errstr ? errstr : "");
 
   // After 'subscribe x' + 'unsubscribe x' + 'subscribe x' requests
   // 'unsubscribe' reply can be received as a reply to the second subscribe
@@ -1175,6 +1211,13 @@ void Redis::RedisImpl::ProcessCommand(const CommandPtr& command) {
     }
 
     const bool is_special = IsSubscribesCommand(args);
+    if (is_special && is_reply_data_reader_) {
+      // hiredis needs the whole redisReply trees for the subscriptions
+      LOG_ERROR() << log_extra_
+                  << "impossible for commands connection: " << args[0];
+      InvokeCommandError(command, args[0], ReplyStatus::kOtherError);
+      continue;
+    }
     if (is_special) subscriber_ = true;
     if (subscriber_ && !is_special) {
       LOG_ERROR() << log_extra_ << "impossible for subscriber: " << args[0];
@@ -22,7 +22,8 @@ class RedisConnectionHolder
       const std::shared_ptr<engine::ev::ThreadPool>& redis_thread_pool,
       const std::string& host, uint16_t port, Password password,
       CommandsBufferingSettings buffering_settings,
-      ReplicationMonitoringSettings replication_monitoring_settings);
+      ReplicationMonitoringSettings replication_monitoring_settings,
+      ConnectionMode connection_mode);
   ~RedisConnectionHolder();
   RedisConnectionHolder(const RedisConnectionHolder&) = delete;
   RedisConnectionHolder& operator=(const RedisConnectionHolder&) = delete;
@@ -51,6 +52,7 @@ class RedisConnectionHolder
   const std::string host_;
   const uint16_t port_;
   const Password password_;
+  const ConnectionMode connection_mode_;
   rcu::Variable<std::shared_ptr<Redis>, StdMutexRcuTraits> redis_;
   engine::ev::PeriodicWatcher connection_check_timer_;
 };
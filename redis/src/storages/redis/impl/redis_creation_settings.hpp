@@ -11,6 +11,7 @@ namespace redis {
 struct RedisCreationSettings {
   ConnectionSecurity connection_security = ConnectionSecurity::kNone;
   bool send_readonly{false};
+  ConnectionMode connection_mode{ConnectionMode::kCommands};
 };
 
 }  // namespace redis
@@ -162,6 +162,10 @@ void Statistics::AccountCommandSent(const CommandPtr& cmd) {
   }
 }
 
+void Statistics::AccountCommandsBatch(size_t batch_size) {
+  batch_size_percentile.GetCurrentCounter().Account(batch_size);
+}
+
 void Statistics::AccountReplyReceived(const ReplyPtr& reply,
                                       const CommandPtr& cmd) {
   reply_size_percentile.GetCurrentCounter().Account(reply->data.GetSize());
@@ -200,6 +204,7 @@ void DumpMetric(utils::statistics::Writer& writer,
 
   if (stats.settings.IsRequestSizesEnabled()) {
     writer["request_sizes"] = stats.request_size_percentile;
+    writer["batch_sizes"] = stats.batch_size_percentile;
   }
   if (stats.settings.IsReplySizesEnabled()) {
     writer["reply_sizes"] = stats.reply_size_percentile;
@@ -261,6 +266,16 @@ void DumpMetric(utils::statistics::Writer& writer,
       writer.ValueWithLabels(inst_stats, {"redis_instance", inst_name});
     }
   }
+  if (stats.hot_key_reads || !stats.hot_keys.empty()) {
+    auto hot_keys_writer = writer["hot_keys"];
+    hot_keys_writer["count"] = stats.hot_keys.size();
+    hot_keys_writer["reads"] = stats.hot_key_reads;
+    // HotKeysSettings::min_share_percent bounds the count of the labels
+    for (const auto& hot_key : stats.hot_keys) {
+      hot_keys_writer["share_percent"].ValueWithLabels(
+          hot_key.share_percent, {"redis_hot_key", hot_key.key});
+    }
+  }
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -274,6 +289,7 @@ void DumpMetric(utils::statistics::Writer& writer,
         stats.internal.cluster_topology_checks.load();
     writer["cluster_topology_updates"] =
         stats.internal.cluster_topology_updates.load();
+    writer["cluster_slot_updates"] = stats.internal.cluster_slot_updates.load();
   }
 
   ConnStateStatistic conn_stat_masters;
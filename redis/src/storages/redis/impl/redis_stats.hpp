@@ -13,6 +13,7 @@
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 
+#include <storages/redis/impl/hot_keys.hpp>
 #include <storages/redis/impl/reply_status_strings.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -31,6 +32,7 @@ class Statistics {
 
   void AccountStateChanged(RedisState new_state);
   void AccountCommandSent(const CommandPtr& cmd);
+  void AccountCommandsBatch(size_t batch_size);
   void AccountReplyReceived(const ReplyPtr& reply, const CommandPtr& cmd);
   void AccountPing(std::chrono::milliseconds ping);
   void AccountError(ReplyStatus code);
@@ -44,6 +46,7 @@ class Statistics {
   std::atomic_llong reconnects{0};
   std::atomic<std::chrono::milliseconds> session_start_time{};
   RecentPeriod request_size_percentile;
+  RecentPeriod batch_size_percentile;
   RecentPeriod reply_size_percentile;
   RecentPeriod timings_percentile;
   std::unordered_map<std::string_view, RecentPeriod> command_timings_percentile;
@@ -63,6 +66,7 @@ struct InstanceStatistics {
             other.session_start_time.load(std::memory_order_relaxed)),
         request_size_percentile(
             other.request_size_percentile.GetStatsForPeriod()),
+        batch_size_percentile(other.batch_size_percentile.GetStatsForPeriod()),
         reply_size_percentile(other.reply_size_percentile.GetStatsForPeriod()),
         timings_percentile(other.timings_percentile.GetStatsForPeriod()),
         last_ping_ms(other.last_ping_ms.load(std::memory_order_relaxed)),
@@ -84,6 +88,7 @@ struct InstanceStatistics {
   void Add(const InstanceStatistics& other) {
     reconnects += other.reconnects;
     request_size_percentile.Add(other.request_size_percentile);
+    batch_size_percentile.Add(other.batch_size_percentile);
     reply_size_percentile.Add(other.reply_size_percentile);
     timings_percentile.Add(other.timings_percentile);
 
@@ -99,6 +104,7 @@ struct InstanceStatistics {
   long long reconnects;
   std::chrono::milliseconds session_start_time;
   Statistics::Percentile request_size_percentile;
+  Statistics::Percentile batch_size_percentile;
   Statistics::Percentile reply_size_percentile;
   Statistics::Percentile timings_percentile;
   std::unordered_map<std::string, Statistics::Percentile>
@@ -117,6 +123,9 @@ struct ShardStatistics {
   std::map<std::string, InstanceStatistics> instances;
   bool is_ready = false;
   std::chrono::steady_clock::time_point last_ready_time;
+  /// Filled for the replicas if HotKeysSettings::enabled
+  std::vector<HotKey> hot_keys;
+  size_t hot_key_reads = 0;
 };
 
 struct SentinelStatisticsInternal {
@@ -126,12 +135,16 @@ struct SentinelStatisticsInternal {
         cluster_topology_checks(
             other.cluster_topology_checks.load(std::memory_order_relaxed)),
         cluster_topology_updates(
-            other.cluster_topology_updates.load(std::memory_order_relaxed)) {}
+            other.cluster_topology_updates.load(std::memory_order_relaxed)),
+        cluster_slot_updates(
+            other.cluster_slot_updates.load(std::memory_order_relaxed)) {}
 
   std::atomic_llong redis_not_ready{0};
   std::atomic_bool is_autotoplogy{false};
   std::atomic_size_t cluster_topology_checks{0};
   std::atomic_size_t cluster_topology_updates{0};
+  /// Slot map updates by MOVED replies
+  std::atomic_size_t cluster_slot_updates{0};
 };
 
 struct SentinelStatistics {
@@ -57,6 +57,13 @@ ReplyData::ReplyData(std::string s)
 
 ReplyData::ReplyData(int value) : type_(Type::kInteger), integer_(value) {}
 
+ReplyData ReplyData::CreateInteger(int64_t value) {
+  ReplyData data;
+  data.type_ = Type::kInteger;
+  data.integer_ = value;
+  return data;
+}
+
 ReplyData ReplyData::CreateError(std::string&& error_msg) {
   ReplyData data(std::move(error_msg));
   data.type_ = Type::kError;
@@ -273,6 +280,13 @@ Reply::Reply(std::string cmd, redisReply* redis_reply, ReplyStatus status,
 Reply::Reply(std::string cmd, ReplyData&& data)
     : cmd(std::move(cmd)), data(std::move(data)), status(ReplyStatus::kOk) {}
 
+Reply::Reply(std::string cmd, ReplyData&& data, ReplyStatus status,
+             std::string status_string)
+    : cmd(std::move(cmd)),
+      data(std::move(data)),
+      status(status),
+      status_string(std::move(status_string)) {}
+
 bool Reply::IsOk() const { return status == ReplyStatus::kOk; }
 
 bool Reply::IsLoggableError() const {
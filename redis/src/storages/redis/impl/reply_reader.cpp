@@ -0,0 +1,137 @@
+#include <storages/redis/impl/reply_reader.hpp>
+
+#include <string>
+#include <utility>
+
+#include <hiredis/hiredis.h>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+namespace {
+
+// The top level reply, hiredis reads its fields as of a redisReply
+struct RootReply final : redisReply {
+  RootReply(int reply_type, ReplyData&& reply_data)
+      : redisReply{}, data(std::move(reply_data)) {
+    type = reply_type;
+    if (data.IsInt()) {
+      integer = data.GetInt();
+    } else if (data.IsError()) {
+      str = data.GetError().data();
+      len = data.GetError().size();
+    }
+  }
+
+  ReplyData data;
+};
+
+RootReply& GetRoot(void* obj) {
+  return *static_cast<RootReply*>(static_cast<redisReply*>(obj));
+}
+
+// The nested elements are the ReplyData of the parent arrays, the space for
+// them is reserved on the creation of the array
+void* Store(const redisReadTask* task, ReplyData&& data) {
+  if (!task->parent) {
+    return static_cast<redisReply*>(new RootReply(task->type, std::move(data)));
+  }
+
+  const auto* parent = task->parent;
+  auto& parent_data = parent->parent ? *static_cast<ReplyData*>(parent->obj)
+                                     : GetRoot(parent->obj).data;
+  auto& array = parent_data.GetArray();
+  UASSERT(static_cast<size_t>(task->idx) == array.size());
+  UASSERT(array.size() < array.capacity());
+  return &array.emplace_back(std::move(data));
+}
+
+// The functions are called from C code, nullptr is treated as out of memory
+template <typename Func>
+void* StoreNoexcept(const redisReadTask* task, Func&& make_data) noexcept {
+  try {
+    return Store(task, make_data());
+  } catch (const std::exception&) {
+    return nullptr;
+  }
+}
+
+void* CreateString(const redisReadTask* task, char* str, size_t len) {
+  return StoreNoexcept(task, [&] {
+    std::string value{str, len};
+    switch (task->type) {
+      case REDIS_REPLY_ERROR:
+        return ReplyData::CreateError(std::move(value));
+      case REDIS_REPLY_STATUS:
+        return ReplyData::CreateStatus(std::move(value));
+      default:
+        return ReplyData{std::move(value)};
+    }
+  });
+}
+
+// The type of the size differs between the hiredis versions
+template <typename Size>
+void* CreateArray(const redisReadTask* task, Size elements) {
+  return StoreNoexcept(task, [elements] {
+    ReplyData::Array array;
+    array.reserve(static_cast<size_t>(elements));
+    return ReplyData{std::move(array)};
+  });
+}
+
+void* CreateInteger(const redisReadTask* task, long long value) {
+  return StoreNoexcept(task,
+                       [value] { return ReplyData::CreateInteger(value); });
+}
+
+void* CreateNil(const redisReadTask* task) {
+  return StoreNoexcept(task, [] { return ReplyData::CreateNil(); });
+}
+
+#if HIREDIS_MAJOR >= 1
+// RESP3 types, decoded as their RESP2 counterparts
+void* CreateDouble(const redisReadTask* task, double, char* str, size_t len) {
+  return StoreNoexcept(task, [&] { return ReplyData{std::string{str, len}}; });
+}
+
+void* CreateBool(const redisReadTask* task, int value) {
+  return StoreNoexcept(task,
+                       [value] { return ReplyData::CreateInteger(value); });
+}
+#endif
+
+void FreeObject(void* obj) { delete &GetRoot(obj); }
+
+redisReplyObjectFunctions MakeReplyDataFunctions() {
+  redisReplyObjectFunctions functions{};
+  functions.createString = &CreateString;
+  functions.createArray = &CreateArray;
+  functions.createInteger = &CreateInteger;
+  functions.createNil = &CreateNil;
+#if HIREDIS_MAJOR >= 1
+  functions.createDouble = &CreateDouble;
+  functions.createBool = &CreateBool;
+#endif
+  functions.freeObject = &FreeObject;
+  return functions;
+}
+
+redisReplyObjectFunctions kReplyDataFunctions = MakeReplyDataFunctions();
+
+}  // namespace
+
+void SetReplyDataFunctions(redisReader& reader) {
+  reader.fn = &kReplyDataFunctions;
+}
+
+ReplyData ExtractReplyData(redisReply* reply) {
+  if (!reply) return ReplyData{nullptr};
+  return std::move(GetRoot(reply).data);
+}
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <userver/storages/redis/impl/reply.hpp>
+
+struct redisReader;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+/// @brief Makes the hiredis reader decode the replies straight into
+/// ReplyData, without building the intermediate redisReply trees.
+///
+/// The strings are copied once from the read buffer. Only the type, the
+/// integer and the error string of the top level redisReply are filled,
+/// that is enough for hiredis to handle the replies to the regular commands.
+/// The subscriber connections must keep the default functions.
+void SetReplyDataFunctions(redisReader& reader);
+
+/// Takes the data out of a reply decoded by the reader with the functions of
+/// SetReplyDataFunctions(), the reply itself is freed by hiredis
+ReplyData ExtractReplyData(redisReply* reply);
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,82 @@
+#include <storages/redis/impl/reply_reader.hpp>
+
+#include <memory>
+#include <string_view>
+
+#include <gtest/gtest.h>
+#include <hiredis/hiredis.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class ReplyDataReader {
+ public:
+  ReplyDataReader() : reader_(redisReaderCreate(), &redisReaderFree) {
+    redis::SetReplyDataFunctions(*reader_);
+  }
+
+  // Returns an empty ReplyData if the reply is incomplete
+  redis::ReplyData Read(std::string_view input) {
+    EXPECT_EQ(redisReaderFeed(reader_.get(), input.data(), input.size()),
+              REDIS_OK);
+    void* reply = nullptr;
+    EXPECT_EQ(redisReaderGetReply(reader_.get(), &reply), REDIS_OK);
+    auto data = redis::ExtractReplyData(static_cast<redisReply*>(reply));
+    if (reply) reader_->fn->freeObject(reply);
+    return data;
+  }
+
+ private:
+  std::unique_ptr<redisReader, decltype(&redisReaderFree)> reader_;
+};
+
+}  // namespace
+
+TEST(ReplyReader, Scalars) {
+  ReplyDataReader reader;
+
+  auto data = reader.Read("$5\r\nvalue\r\n");
+  ASSERT_TRUE(data.IsString());
+  EXPECT_EQ(data.GetString(), "value");
+
+  data = reader.Read(":-42\r\n");
+  ASSERT_TRUE(data.IsInt());
+  EXPECT_EQ(data.GetInt(), -42);
+
+  data = reader.Read("+OK\r\n");
+  ASSERT_TRUE(data.IsStatus());
+  EXPECT_EQ(data.GetStatus(), "OK");
+
+  data = reader.Read("-MOVED 3999 127.0.0.1:6381\r\n");
+  EXPECT_TRUE(data.IsErrorMoved());
+
+  EXPECT_TRUE(reader.Read("$-1\r\n").IsNil());
+}
+
+TEST(ReplyReader, Arrays) {
+  ReplyDataReader reader;
+
+  const auto data = reader.Read(
+      "*4\r\n$3\r\nkey\r\n$-1\r\n*2\r\n:1\r\n*1\r\n+QUEUED\r\n*0\r\n");
+  ASSERT_TRUE(data.IsArray());
+  ASSERT_EQ(data.GetArray().size(), 4);
+  EXPECT_EQ(data[0].GetString(), "key");
+  EXPECT_TRUE(data[1].IsNil());
+  ASSERT_EQ(data[2].GetArray().size(), 2);
+  EXPECT_EQ(data[2][0].GetInt(), 1);
+  EXPECT_EQ(data[2][1][0].GetStatus(), "QUEUED");
+  EXPECT_TRUE(data[3].GetArray().empty());
+  EXPECT_EQ(data.ToDebugString(), "[key, (nil), [1, [QUEUED]], []]");
+}
+
+TEST(ReplyReader, Partial) {
+  ReplyDataReader reader;
+
+  EXPECT_FALSE(reader.Read("*2\r\n$3\r\nfoo\r\n$3\r\nb"));
+  const auto data = reader.Read("ar\r\n");
+  ASSERT_TRUE(data.IsArray());
+  EXPECT_EQ(data.ToDebugString(), "[foo, bar]");
+}
+
+USERVER_NAMESPACE_END
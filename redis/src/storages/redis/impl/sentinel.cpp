@@ -269,6 +269,8 @@ size_t Sentinel::ShardByKey(const std::string& key) const {
 
 size_t Sentinel::ShardsCount() const { return impl_->ShardsCount(); }
 
+bool Sentinel::IsInClusterMode() const { return impl_->IsInClusterMode(); }
+
 void Sentinel::CheckShardIdx(size_t shard_idx) const {
   CheckShardIdx(shard_idx, ShardsCount());
 }
@@ -301,6 +303,10 @@ void Sentinel::SetReplicationMonitoringSettings(
   impl_->SetReplicationMonitoringSettings(replication_monitoring_settings);
 }
 
+void Sentinel::SetHotKeysSettings(const HotKeysSettings& hot_keys_settings) {
+  impl_->SetHotKeysSettings(hot_keys_settings);
+}
+
 void Sentinel::SetClusterAutoTopology(bool auto_topology) {
   impl_->SetClusterAutoTopology(auto_topology);
 }
@@ -334,9 +340,21 @@ void Sentinel::OnSubscribeReply(const MessageCallback message_callback,
       unsubscribe_callback(reply->server_id, reply_array[1].GetString(),
                            reply_array[2].GetInt());
   } else if (!strcasecmp(reply_array[0].GetString().c_str(), "MESSAGE")) {
-    if (message_callback)
-      message_callback(reply->server_id, reply_array[1].GetString(),
-                       reply_array[2].GetString());
+    if (!message_callback) return;
+    const auto& channel = reply_array[1].GetString();
+    const auto& message = reply_array[2];
+    if (message.IsArray()) {
+      // `CLIENT TRACKING ... REDIRECT` invalidation messages carry an array
+      // of keys, the keys are passed as separate messages
+      for (const auto& key : message.GetArray()) {
+        if (key.IsString())
+          message_callback(reply->server_id, channel, key.GetString());
+      }
+    } else if (message.IsNil()) {
+      message_callback(reply->server_id, channel, {});
+    } else {
+      message_callback(reply->server_id, channel, message.GetString());
+    }
   }
 }
 
@@ -112,6 +112,7 @@ class Sentinel {
 
   size_t ShardByKey(const std::string& key) const;
   size_t ShardsCount() const;
+  bool IsInClusterMode() const;
   void CheckShardIdx(size_t shard_idx) const;
   static void CheckShardIdx(size_t shard_idx, size_t shard_count);
 
@@ -125,6 +126,8 @@ class Sentinel {
       CommandsBufferingSettings commands_buffering_settings);
   void SetReplicationMonitoringSettings(
       const ReplicationMonitoringSettings& replication_monitoring_settings);
+  /// Has no effect in cluster mode
+  void SetHotKeysSettings(const HotKeysSettings& hot_keys_settings);
   void SetClusterAutoTopology(bool auto_topology);
 
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
@@ -172,11 +175,20 @@ class Sentinel {
   virtual void SetConfigDefaultCommandControl(
       const std::shared_ptr<CommandControl>& cc);
 
-  using UserMessageCallback = std::function<void(const std::string& channel,
-                                                 const std::string& message)>;
-  using UserPmessageCallback =
-      std::function<void(const std::string& pattern, const std::string& channel,
-                         const std::string& message)>;
+  /// Message shared by all the local subscribers of a channel
+  using SharedMessage = std::shared_ptr<const std::string>;
+
+  /// State of the subscriber queue after a message has been delivered to it
+  struct MessageDelivery {
+    bool is_dropped{false};
+    size_t queue_length{0};
+  };
+
+  using UserMessageCallback = std::function<MessageDelivery(
+      const std::string& channel, const SharedMessage& message)>;
+  using UserPmessageCallback = std::function<MessageDelivery(
+      const std::string& pattern, const std::string& channel,
+      const SharedMessage& message)>;
 
   using MessageCallback =
       std::function<void(ServerId server_id, const std::string& channel,
@@ -5,7 +5,6 @@
 #include <thread>
 
 #include <boost/algorithm/string.hpp>
-#include <boost/crc.hpp>
 
 #include <fmt/format.h>
 
@@ -186,6 +185,7 @@ void SentinelImpl::InitShards(
     shard_options.shard_name = shard;
     shard_options.shard_group_name = shard_group_name_;
     shard_options.cluster_mode = IsInClusterMode();
+    shard_options.connection_mode = connection_mode_;
     shard_options.ready_change_callback = [i, shard,
                                            ready_callback](bool ready) {
       if (ready_callback) ready_callback(i, shard, ready);
@@ -546,6 +546,12 @@ void SentinelImpl::SetReplicationMonitoringSettings(
     shard->SetReplicationMonitoringSettings(replication_monitoring_settings);
 }
 
+void SentinelImpl::SetHotKeysSettings(
+    const HotKeysSettings& hot_keys_settings) {
+  for (auto& shard : master_shards_)
+    shard->SetHotKeysSettings(hot_keys_settings);
+}
+
 PublishSettings SentinelImpl::GetPublishSettings() {
   /// Why do we always publish to master? We can actually publish to any host in
   /// shard to distribute load evenly
@@ -922,14 +928,7 @@ size_t SentinelImpl::ParseMovedShard(const std::string& err_string) {
   return shard_info_.GetShard(host, port);
 }
 
-size_t SentinelImpl::HashSlot(const std::string& key) {
-  size_t start = 0;
-  size_t len = 0;
-  GetRedisKey(key, &start, &len);
-  return std::for_each(key.data() + start, key.data() + start + len,
-                       boost::crc_optimal<16, 0x1021>())() &
-         0x3fff;
-}
+size_t SentinelImpl::HashSlot(const std::string& key) { return KeySlot(key); }
 
 SentinelImpl::SlotInfo::SlotInfo() {
   for (size_t i = 0; i < kClusterHashSlots; ++i) {
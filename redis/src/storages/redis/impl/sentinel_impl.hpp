@@ -88,6 +88,7 @@ class SentinelImplBase {
       CommandsBufferingSettings commands_buffering_settings) = 0;
   virtual void SetReplicationMonitoringSettings(
       const ReplicationMonitoringSettings& replication_monitoring_settings) = 0;
+  virtual void SetHotKeysSettings(const HotKeysSettings& /*settings*/) {}
   virtual void SetClusterAutoTopology(bool /*auto_topology*/) {}
 
   virtual PublishSettings GetPublishSettings() = 0;
@@ -139,11 +140,14 @@ class SentinelImpl : public SentinelImplBase {
   std::vector<std::shared_ptr<const Shard>> GetMasterShards() const override;
   bool IsInClusterMode() const override;
 
+  static size_t HashSlot(const std::string& key);
+
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings) override;
   void SetReplicationMonitoringSettings(
       const ReplicationMonitoringSettings& replication_monitoring_settings)
       override;
+  void SetHotKeysSettings(const HotKeysSettings& hot_keys_settings) override;
   PublishSettings GetPublishSettings() override;
 
  private:
@@ -238,8 +242,6 @@ class SentinelImpl : public SentinelImplBase {
                   std::vector<std::shared_ptr<Shard>>& shard_objects,
                   const ReadyChangeCallback& ready_callback);
 
-  static size_t HashSlot(const std::string& key);
-
   void ProcessWaitingCommands();
 
   Sentinel& sentinel_obj_;
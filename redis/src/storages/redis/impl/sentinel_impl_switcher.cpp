@@ -154,6 +154,13 @@ void ClusterSentinelImplSwitcher::SetReplicationMonitoringSettings(
   impl->SetReplicationMonitoringSettings(replication_monitoring_settings);
 }
 
+void ClusterSentinelImplSwitcher::SetHotKeysSettings(
+    const HotKeysSettings& hot_keys_settings) {
+  auto impl = impl_.Get();
+  UASSERT(impl);
+  impl->SetHotKeysSettings(hot_keys_settings);
+}
+
 void ClusterSentinelImplSwitcher::SetClusterAutoTopology(bool auto_topology) {
   enabled_by_config_ = auto_topology;
   UpdateImpl(true, true);
@@ -67,7 +67,8 @@ Shard::Shard(Options options)
     : shard_name_(std::move(options.shard_name)),
       shard_group_name_(std::move(options.shard_group_name)),
       ready_change_callback_(std::move(options.ready_change_callback)),
-      cluster_mode_(options.cluster_mode) {
+      cluster_mode_(options.cluster_mode),
+      connection_mode_(options.connection_mode) {
   for (const auto& conn : options.connection_infos) {
     connection_infos_.emplace_back(conn);
   }
@@ -222,10 +223,17 @@ bool Shard::AsyncCommand(CommandPtr command) {
   std::shared_lock lock(mutex_);  // protects instances_ and destroying_
   if (destroying_) return false;
 
-  const auto& available_servers = GetAvailableServers(
+  auto available_servers = GetAvailableServers(
       command->control,
       !command->read_only || command->control.allow_reads_from_master,
       command->read_only);
+  if (IsHotKeyRead(*command)) {
+    // Spread the reads of a hot key over all the replicas instead of the
+    // ones selected by the strategy, e.g. the nearest by ping
+    for (size_t i = 0; i < instances_.size(); i++) {
+      if (instances_[i].info.IsReadOnly()) available_servers[i] = 1;
+    }
+  }
 
   auto max_attempts = instances_.size() + 1;
   for (size_t attempt = 0; attempt < max_attempts; attempt++) {
@@ -260,6 +268,18 @@ bool Shard::AsyncCommand(CommandPtr command) {
   return false;
 }
 
+bool Shard::IsHotKeyRead(const Command& command) {
+  if (!command.read_only || !hot_keys_.IsEnabled()) return false;
+  if (!command.control.force_server_id.IsAny()) return false;
+
+  // Only single commands are accounted, their key follows the command name
+  const auto& args = command.args.args;
+  if (args.size() != 1 || args.front().size() < 2) return false;
+
+  return hot_keys_.AccountRead(args.front()[1]) &&
+         hot_keys_.IsOffloadEnabled();
+}
+
 void Shard::Clean() {
   // clear 'instances_' and 'clean_wait_' when mutex_ locked
   // destroy ConnectionStatus objects from them when mutex_ unlocked
@@ -289,7 +309,8 @@ bool Shard::ProcessCreation(
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDelete)
   for (const auto& id : need_to_create) {
     const auto redis_settings = RedisCreationSettings{
-        id.GetConnectionSecurity(), cluster_mode_ && id.IsReadOnly()};
+        id.GetConnectionSecurity(), cluster_mode_ && id.IsReadOnly(),
+        connection_mode_};
     ConnectionStatus entry{
         id, std::make_shared<Redis>(
                 redis_thread_pool,
@@ -403,6 +424,10 @@ ShardStatistics Shard::GetStatistics(bool master,
     }
   }
   stats.last_ready_time = last_ready_time_;
+  if (!master && hot_keys_.IsEnabled()) {
+    stats.hot_keys = hot_keys_.GetHotKeys();
+    stats.hot_key_reads = hot_keys_.GetHotReads();
+  }
 
   return stats;
 }
@@ -459,6 +484,12 @@ void Shard::SetReplicationMonitoringSettings(
   }
 }
 
+void Shard::SetHotKeysSettings(const HotKeysSettings& hot_keys_settings) {
+  hot_keys_.SetSettings(hot_keys_settings);
+}
+
+std::vector<HotKey> Shard::GetHotKeys() const { return hot_keys_.GetHotKeys(); }
+
 std::vector<ConnectionInfoInt> Shard::GetConnectionInfosToCreate() const {
   std::shared_lock lock(mutex_);
 
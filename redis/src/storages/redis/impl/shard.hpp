@@ -9,6 +9,7 @@
 
 #include <userver/utils/swappingsmart.hpp>
 
+#include <storages/redis/impl/hot_keys.hpp>
 #include <storages/redis/impl/redis.hpp>
 #include <storages/redis/impl/redis_stats.hpp>
 
@@ -63,6 +64,7 @@ class Shard {
     std::string shard_name;
     std::string shard_group_name;
     bool cluster_mode{false};
+    ConnectionMode connection_mode{ConnectionMode::kCommands};
     std::function<void(bool ready)> ready_change_callback;
     std::vector<ConnectionInfo> connection_infos;
   };
@@ -99,6 +101,9 @@ class Shard {
       CommandsBufferingSettings commands_buffering_settings);
   void SetReplicationMonitoringSettings(
       const ReplicationMonitoringSettings& replication_monitoring_settings);
+  void SetHotKeysSettings(const HotKeysSettings& hot_keys_settings);
+
+  std::vector<HotKey> GetHotKeys() const;
 
  private:
   std::vector<unsigned char> GetAvailableServers(
@@ -108,6 +113,8 @@ class Shard {
       const CommandControl& command_control, bool with_masters,
       bool with_slaves) const;
 
+  bool IsHotKeyRead(const Command& command);
+
   std::vector<ConnectionInfoInt> GetConnectionInfosToCreate() const;
   bool UpdateCleanWaitQueue(std::vector<ConnectionStatus>&& add_clean_wait);
 
@@ -132,9 +139,11 @@ class Shard {
   boost::signals2::signal<void(ServerId, bool)> signal_instance_ready_;
 
   utils::SwappingSmart<CommandsBufferingSettings> commands_buffering_settings_;
+  HotKeysDetector hot_keys_;
 
   bool prev_connected_ = false;
   const bool cluster_mode_ = false;
+  const ConnectionMode connection_mode_ = ConnectionMode::kCommands;
 };
 
 }  // namespace redis
@@ -9,6 +9,8 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["messages"]["count"] = stats.messages_count;
   writer["messages"]["alien-count"] = stats.messages_alien_count;
   writer["messages"]["size"] = stats.messages_size;
+  writer["messages"]["dropped"] = stats.messages_dropped;
+  writer["max-queue-length"] = stats.max_queue_length;
 
   if (stats.server_id) {
     auto diff = std::chrono::steady_clock::now() - stats.subscription_timestamp;
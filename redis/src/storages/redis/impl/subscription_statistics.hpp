@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <optional>
 #include <string>
@@ -18,6 +19,10 @@ struct PubsubChannelStatistics {
   size_t messages_count{0};
   size_t messages_size{0};
   size_t messages_alien_count{0};
+  /// Messages discarded due to the overflow of the subscriber queues
+  size_t messages_dropped{0};
+  /// The longest subscriber queue after the last message
+  size_t max_queue_length{0};
 
   std::optional<ServerId> server_id;
 
@@ -28,11 +33,18 @@ struct PubsubChannelStatistics {
 
   void AccountAlienMessage() { messages_alien_count++; }
 
+  void AccountDelivery(size_t dropped, size_t queue_length) {
+    messages_dropped += dropped;
+    max_queue_length = queue_length;
+  }
+
   PubsubChannelStatistics& operator+=(const PubsubChannelStatistics& other) {
     subscription_timestamp = std::chrono::steady_clock::time_point();
     messages_count += other.messages_count;
     messages_size += other.messages_size;
     messages_alien_count += other.messages_alien_count;
+    messages_dropped += other.messages_dropped;
+    max_queue_length = std::max(max_queue_length, other.max_queue_length);
     return *this;
   }
 };
@@ -1,5 +1,6 @@
 #include "subscription_storage.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 
@@ -14,6 +15,28 @@
 USERVER_NAMESPACE_BEGIN
 
 namespace redis {
+namespace {
+
+// Delivers a message to the subscribers of a channel and accounts the state
+// of their queues
+template <typename Callbacks, typename... Args>
+void DeliverMessage(const Callbacks& callbacks,
+                    PubsubChannelStatistics& statistics, const Args&... args) {
+  size_t dropped = 0;
+  size_t max_queue_length = 0;
+  for (const auto& it : callbacks) {
+    try {
+      const auto delivery = it.second(args...);
+      if (delivery.is_dropped) ++dropped;
+      max_queue_length = std::max(max_queue_length, delivery.queue_length);
+    } catch (const std::exception& e) {
+      LOG_ERROR() << "Unhandled exception in subscriber: " << e.what();
+    }
+  }
+  statistics.AccountDelivery(dropped, max_queue_length);
+}
+
+}  // namespace
 
 SubscriptionToken::SubscriptionToken(
     std::weak_ptr<SubscriptionStorageBase> storage,
@@ -405,13 +428,11 @@ void SubscriptionStorageBase::SubscriptionStorageImpl<
   try {
     std::lock_guard<std::mutex> lock(mutex_);
     auto& m = callback_map_.at(channel);
-    for (const auto& it : m.callbacks) {
-      try {
-        it.second(channel, message);
-      } catch (const std::exception& e) {
-        LOG_ERROR() << "Unhandled exception in subscriber: " << e.what();
-      }
-    }
+    // A single copy for all the subscribers
+    const auto shared_message =
+        std::make_shared<const std::string>(message);
+    DeliverMessage(m.callbacks, m.GetInfo(shard_idx).statistics, channel,
+                   shared_message);
 
     m.GetInfo(shard_idx).AccountMessage(server_id, message.size());
   } catch (const std::out_of_range& e) {
@@ -430,13 +451,10 @@ void SubscriptionStorageBase::SubscriptionStorageImpl<
   try {
     std::lock_guard<std::mutex> lock(mutex_);
     auto& m = pattern_callback_map_.at(pattern);
-    for (const auto& it : m.callbacks) {
-      try {
-        it.second(pattern, channel, message);
-      } catch (const std::exception& e) {
-        LOG_ERROR() << "Unhandled exception in subscriber: " << e.what();
-      }
-    }
+    const auto shared_message =
+        std::make_shared<const std::string>(message);
+    DeliverMessage(m.callbacks, m.GetInfo(shard_idx).statistics, pattern,
+                   channel, shared_message);
 
     m.GetInfo(shard_idx).AccountMessage(server_id, message.size());
   } catch (const std::out_of_range& e) {
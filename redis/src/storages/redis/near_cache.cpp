@@ -0,0 +1,118 @@
+#include <userver/storages/redis/near_cache.hpp>
+
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+#include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/subscribe_client.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+NearCache::NearCache(ClientPtr client, SubscribeClient& subscribe_client,
+                     const NearCacheSettings& settings)
+    : client_(std::move(client)),
+      values_(settings.ways, settings.way_size),
+      hashes_(settings.ways, settings.way_size) {
+  values_.SetMaxLifetime(settings.max_lifetime);
+  hashes_.SetMaxLifetime(settings.max_lifetime);
+  subscription_ = subscribe_client.Subscribe(
+      settings.invalidation_channel,
+      [this](const std::string&, const std::string& message) {
+        OnInvalidationMessage(message);
+      });
+}
+
+NearCache::~NearCache() { subscription_.Unsubscribe(); }
+
+template <typename Cache, typename Value>
+void NearCache::PutIfNotInvalidated(Cache& cache, const std::string& key,
+                                    Value&& value, std::uint64_t epoch) {
+  // An invalidation either changes the epoch before the check, or drops the
+  // value after it is stored
+  const std::shared_lock lock(invalidation_mutex_);
+  if (invalidations_epoch_.load() == epoch) {
+    cache.Put(key, std::forward<Value>(value));
+  }
+}
+
+std::optional<std::string> NearCache::Get(
+    const std::string& key, const CommandControl& command_control) {
+  if (auto value = values_.GetOptionalNoUpdate(key)) {
+    ++stats_.hits;
+    return std::move(*value);
+  }
+  ++stats_.misses;
+
+  const auto epoch = invalidations_epoch_.load();
+  auto value = client_->Get(key, command_control).Get();
+  PutIfNotInvalidated(values_, key, value, epoch);
+  return value;
+}
+
+std::optional<std::string> NearCache::Hget(
+    const std::string& key, const std::string& field,
+    const CommandControl& command_control) {
+  auto fields = hashes_.GetOptionalNoUpdate(key);
+  if (fields) {
+    const auto it = (*fields)->find(field);
+    if (it != (*fields)->end()) {
+      ++stats_.hits;
+      return it->second;
+    }
+  }
+  ++stats_.misses;
+
+  const auto epoch = invalidations_epoch_.load();
+  auto value = client_->Hget(key, field, command_control).Get();
+
+  // Copy-on-write, so that the other fields of the hash stay cached
+  auto new_fields =
+      fields ? std::make_shared<HashFields>(**fields)
+             : std::make_shared<HashFields>();
+  new_fields->insert_or_assign(field, value);
+  PutIfNotInvalidated(hashes_, key, std::move(new_fields), epoch);
+  return value;
+}
+
+void NearCache::Invalidate(const std::string& key) {
+  const std::lock_guard lock(invalidation_mutex_);
+  ++invalidations_epoch_;
+  ++stats_.invalidated;
+  values_.InvalidateByKey(key);
+  hashes_.InvalidateByKey(key);
+}
+
+void NearCache::InvalidateAll() {
+  const std::lock_guard lock(invalidation_mutex_);
+  ++invalidations_epoch_;
+  ++stats_.invalidated;
+  values_.Invalidate();
+  hashes_.Invalidate();
+}
+
+const NearCacheStatistics& NearCache::GetStatistics() const noexcept {
+  return stats_;
+}
+
+void NearCache::OnInvalidationMessage(const std::string& message) {
+  // `CLIENT TRACKING` sends a nil instead of the keys on FLUSHALL/FLUSHDB
+  if (message.empty()) {
+    InvalidateAll();
+  } else {
+    Invalidate(message);
+  }
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const NearCacheStatistics& stats) {
+  writer["hits"] = stats.hits.load();
+  writer["misses"] = stats.misses.load();
+  writer["invalidated"] = stats.invalidated.load();
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,92 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/storages/redis/mock_client_google.hpp>
+#include <userver/storages/redis/mock_request.hpp>
+#include <userver/storages/redis/mock_subscribe_client.hpp>
+#include <userver/storages/redis/near_cache.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using storages::redis::CreateMockRequest;
+using testing::_;
+
+class NearCacheTest : public testing::Test {
+ protected:
+  NearCacheTest() {
+    EXPECT_CALL(subscribe_client_, Subscribe("__redis__:invalidate", _, _))
+        .WillOnce([this](std::string,
+                         storages::redis::SubscriptionToken::OnMessageCb cb,
+                         const storages::redis::CommandControl&) {
+          on_message_ = std::move(cb);
+          return storages::redis::SubscriptionToken{};
+        });
+  }
+
+  void Invalidate(const std::string& key) {
+    on_message_("__redis__:invalidate", key);
+  }
+
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  std::shared_ptr<storages::redis::GMockClient> client_ =
+      std::make_shared<storages::redis::GMockClient>();
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  storages::redis::MockSubscribeClient subscribe_client_;
+
+ private:
+  storages::redis::SubscriptionToken::OnMessageCb on_message_;
+};
+
+}  // namespace
+
+UTEST_F(NearCacheTest, Get) {
+  storages::redis::NearCache cache{client_, subscribe_client_, {}};
+
+  EXPECT_CALL(*client_, Get("key", _))
+      .Times(2)
+      .WillRepeatedly([](auto, const auto&) {
+        return CreateMockRequest<storages::redis::RequestGet>("value");
+      });
+  EXPECT_CALL(*client_, Get("missing", _)).WillOnce([](auto, const auto&) {
+    return CreateMockRequest<storages::redis::RequestGet>(std::nullopt);
+  });
+
+  EXPECT_EQ(cache.Get("key", {}), "value");
+  EXPECT_EQ(cache.Get("key", {}), "value");
+  EXPECT_EQ(cache.Get("missing", {}), std::nullopt);
+  EXPECT_EQ(cache.Get("missing", {}), std::nullopt);
+
+  Invalidate("key");
+  EXPECT_EQ(cache.Get("key", {}), "value");
+
+  const auto& stats = cache.GetStatistics();
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.invalidated, 1);
+}
+
+UTEST_F(NearCacheTest, Hget) {
+  storages::redis::NearCache cache{client_, subscribe_client_, {}};
+
+  EXPECT_CALL(*client_, Hget("hash", "a", _))
+      .Times(2)
+      .WillRepeatedly([](auto, auto, const auto&) {
+        return CreateMockRequest<storages::redis::RequestHget>("1");
+      });
+  EXPECT_CALL(*client_, Hget("hash", "b", _))
+      .WillOnce([](auto, auto, const auto&) {
+        return CreateMockRequest<storages::redis::RequestHget>("2");
+      });
+
+  EXPECT_EQ(cache.Hget("hash", "a", {}), "1");
+  EXPECT_EQ(cache.Hget("hash", "b", {}), "2");
+  EXPECT_EQ(cache.Hget("hash", "a", {}), "1");
+  EXPECT_EQ(cache.Hget("hash", "b", {}), "2");
+
+  // FLUSHALL
+  Invalidate({});
+  EXPECT_EQ(cache.Hget("hash", "a", {}), "1");
+}
+
+USERVER_NAMESPACE_END
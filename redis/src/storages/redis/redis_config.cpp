@@ -93,6 +93,7 @@ USERVER_NAMESPACE::redis::CommandsBufferingSettings Parse(
       elem["commands_buffering_threshold"].As<size_t>(0);
   result.watch_command_timer_interval = std::chrono::microseconds(
       elem["watch_command_timer_interval_us"].As<size_t>());
+  result.max_batch_size = elem["max_batch_size"].As<size_t>(0);
   return result;
 }
 
@@ -131,6 +132,21 @@ PubsubMetricsSettings Parse(const formats::json::Value& elem,
   return result;
 }
 
+HotKeysSettings Parse(const formats::json::Value& elem,
+                      formats::parse::To<HotKeysSettings>) {
+  HotKeysSettings result;
+  result.enabled = elem["enabled"].As<bool>(result.enabled);
+  result.sample_rate = elem["sample-rate"].As<size_t>(result.sample_rate);
+  result.capacity = elem["capacity"].As<size_t>(result.capacity);
+  result.min_share_percent =
+      elem["min-share-percent"].As<size_t>(result.min_share_percent);
+  result.min_samples = elem["min-samples"].As<size_t>(result.min_samples);
+  result.window = std::chrono::milliseconds{
+      elem["window-ms"].As<int64_t>(result.window.count())};
+  result.offload_reads = elem["offload-reads"].As<bool>(result.offload_reads);
+  return result;
+}
+
 }  // namespace redis
 
 namespace storages::redis {
@@ -160,6 +176,7 @@ Config Config::Parse(const dynamic_config::DocsMap& docs_map) {
        docs_map.Get("REDIS_PUBSUB_METRICS_SETTINGS"));
   Into(result.replication_monitoring_settings,
        docs_map.Get("REDIS_REPLICA_MONITORING_SETTINGS"));
+  Into(result.hot_keys_settings, docs_map.Get("REDIS_HOT_KEYS_SETTINGS"));
   Into(result.redis_cluster_autotopology_enabled,
        docs_map.Get("REDIS_CLUSTER_AUTOTOPOLOGY_ENABLED_V2"));
   return result;
@@ -196,6 +213,13 @@ const dynamic_config::Key<Config> kConfig{
             }
           }
         )"}},
+        {"REDIS_HOT_KEYS_SETTINGS", JsonString{R"(
+          {
+            "__default__": {
+              "enabled": false
+            }
+          }
+        )"}},
         {"REDIS_CLUSTER_AUTOTOPOLOGY_ENABLED_V2", true},
     },
 };
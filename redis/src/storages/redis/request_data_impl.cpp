@@ -1,6 +1,7 @@
 #include "request_data_impl.hpp"
 
 #include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -30,6 +31,66 @@ USERVER_NAMESPACE::redis::Request& RequestDataImplBase::GetRequest() {
   return request_;
 }
 
+MgetAcrossShardsRequestDataImpl::MgetAcrossShardsRequestDataImpl(
+    std::vector<RequestMget>&& requests,
+    std::vector<std::vector<size_t>>&& key_positions, size_t keys_count,
+    PartialResults partial_results)
+    : requests_(std::move(requests)),
+      key_positions_(std::move(key_positions)),
+      keys_count_(keys_count),
+      partial_results_(partial_results) {
+  UASSERT(requests_.size() == key_positions_.size());
+}
+
+void MgetAcrossShardsRequestDataImpl::Wait() {
+  for (auto& request : requests_) request.Wait();
+}
+
+RequestMget::Reply MgetAcrossShardsRequestDataImpl::Get(
+    const std::string& request_description) {
+  RequestMget::Reply result(keys_count_);
+  for (size_t i = 0; i < requests_.size(); ++i) {
+    RequestMget::Reply values;
+    try {
+      values = requests_[i].Get(request_description);
+    } catch (const USERVER_NAMESPACE::redis::RequestFailedException& ex) {
+      if (partial_results_ != PartialResults::kAllowed) throw;
+      LOG_WARNING() << "Mget of " << key_positions_[i].size()
+                    << " keys failed, returning partial results: " << ex;
+      continue;
+    }
+
+    const auto& positions = key_positions_[i];
+    UINVARIANT(values.size() == positions.size(),
+               "Unexpected number of values in Mget reply");
+    for (size_t j = 0; j < positions.size(); ++j) {
+      result[positions[j]] = std::move(values[j]);
+    }
+  }
+  return result;
+}
+
+ReplyPtr MgetAcrossShardsRequestDataImpl::GetRaw() {
+  UASSERT_MSG(false, "Unsupported");
+  return {};
+}
+
+void MsetAcrossShardsRequestDataImpl::Wait() {
+  for (auto& request : requests_) request.Wait();
+}
+
+void MsetAcrossShardsRequestDataImpl::Get(
+    const std::string& request_description) {
+  // Let all the shards finish before reporting a failure
+  Wait();
+  for (auto& request : requests_) request.Get(request_description);
+}
+
+ReplyPtr MsetAcrossShardsRequestDataImpl::GetRaw() {
+  UASSERT_MSG(false, "Unsupported");
+  return {};
+}
+
 }  // namespace storages::redis
 
 USERVER_NAMESPACE_END
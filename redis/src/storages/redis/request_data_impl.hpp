@@ -105,6 +105,43 @@ class AggregateRequestDataImpl final : public RequestDataBase<ReplyType> {
   std::vector<RequestDataPtr> requests_;
 };
 
+/// Reassembles the replies of Mget() to many shards in the order of the keys
+class MgetAcrossShardsRequestDataImpl final
+    : public RequestDataBase<RequestMget::Reply> {
+ public:
+  MgetAcrossShardsRequestDataImpl(
+      std::vector<RequestMget>&& requests,
+      std::vector<std::vector<size_t>>&& key_positions, size_t keys_count,
+      PartialResults partial_results);
+
+  void Wait() override;
+
+  RequestMget::Reply Get(const std::string& request_description) override;
+
+  ReplyPtr GetRaw() override;
+
+ private:
+  std::vector<RequestMget> requests_;
+  std::vector<std::vector<size_t>> key_positions_;
+  size_t keys_count_;
+  PartialResults partial_results_;
+};
+
+class MsetAcrossShardsRequestDataImpl final : public RequestDataBase<void> {
+ public:
+  explicit MsetAcrossShardsRequestDataImpl(std::vector<RequestMset>&& requests)
+      : requests_(std::move(requests)) {}
+
+  void Wait() override;
+
+  void Get(const std::string& request_description) override;
+
+  ReplyPtr GetRaw() override;
+
+ private:
+  std::vector<RequestMset> requests_;
+};
+
 template <typename Result, typename ReplyType>
 class DummyRequestDataImpl final : public RequestDataBase<ReplyType> {
  public:
@@ -0,0 +1,68 @@
+#include <userver/storages/redis/script_registry.hpp>
+
+#include <userver/crypto/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+Script::Script(std::string body)
+    : body_(std::move(body)), sha1_(crypto::hash::Sha1(body_)) {}
+
+ScriptRegistry::ScriptRegistry(ClientPtr client) : client_(std::move(client)) {}
+
+Script ScriptRegistry::Register(std::string body,
+                                const CommandControl& command_control) {
+  Script script{std::move(body)};
+  LoadToAllShards({script}, command_control);
+  auto scripts = scripts_.Lock();
+  scripts->push_back(script);
+  return script;
+}
+
+void ScriptRegistry::LoadAll(const CommandControl& command_control) {
+  std::vector<Script> scripts;
+  {
+    // loading is done without the lock
+    const auto locked_scripts = scripts_.Lock();
+    scripts = *locked_scripts;
+  }
+  LoadToAllShards(scripts, command_control);
+}
+
+void ScriptRegistry::Load(const Script& script, size_t shard,
+                          const CommandControl& command_control) {
+  CheckLoaded(script,
+              client_->ScriptLoad(script.GetBody(), shard, command_control));
+}
+
+void ScriptRegistry::LoadToAllShards(const std::vector<Script>& scripts,
+                                     const CommandControl& command_control) {
+  const auto shards_count = client_->ShardsCount();
+
+  // all the loads are sent before waiting for any of them
+  std::vector<RequestScriptLoad> requests;
+  requests.reserve(scripts.size() * shards_count);
+  for (const auto& script : scripts) {
+    for (size_t shard = 0; shard < shards_count; ++shard) {
+      requests.push_back(
+          client_->ScriptLoad(script.GetBody(), shard, command_control));
+    }
+  }
+  for (size_t i = 0; i < requests.size(); ++i) {
+    CheckLoaded(scripts[i / shards_count], std::move(requests[i]));
+  }
+}
+
+void ScriptRegistry::CheckLoaded(const Script& script,
+                                 RequestScriptLoad request) {
+  const auto sha1 = request.Get();
+  if (sha1 != script.GetSha1()) {
+    throw USERVER_NAMESPACE::redis::Exception(
+        "SCRIPT LOAD returned " + sha1 + " instead of " + script.GetSha1());
+  }
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
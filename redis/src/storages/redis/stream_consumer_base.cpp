@@ -0,0 +1,231 @@
+#include <userver/storages/redis/stream_consumer_base.hpp>
+
+#include <optional>
+
+#include <userver/engine/semaphore.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/reply.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/datetime.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+namespace {
+
+// KEYS[1] - stream, ARGV[1] - group
+const Script kCreateGroupScript{R"(
+local res = redis.pcall('XGROUP', 'CREATE', KEYS[1], ARGV[1], '$', 'MKSTREAM')
+if type(res) == 'table' and res.err and not string.find(res.err, 'BUSYGROUP')
+then
+  return redis.error_reply(res.err)
+end
+return 1
+)"};
+
+// KEYS[1] - stream, ARGV - group, consumer, count
+const Script kReadScript{R"(
+local res = redis.call('XREADGROUP', 'GROUP', ARGV[1], ARGV[2],
+                       'COUNT', ARGV[3], 'STREAMS', KEYS[1], '>')
+if not res then return {} end
+return res[1][2]
+)"};
+
+// KEYS[1] - stream, ARGV - group, consumer, min idle ms, cursor, count
+const Script kReclaimScript{R"(
+local res = redis.call('XAUTOCLAIM', KEYS[1], ARGV[1], ARGV[2], ARGV[3],
+                       ARGV[4], 'COUNT', ARGV[5])
+return {res[1], res[2]}
+)"};
+
+// KEYS[1] - stream, ARGV - group, ids...
+const Script kAckScript{R"(
+return redis.call('XACK', KEYS[1], ARGV[1], unpack(ARGV, 2))
+)"};
+
+std::vector<StreamMessage> ParseEntries(const ReplyData& entries) {
+  std::vector<StreamMessage> result;
+  if (!entries.IsArray()) return result;
+
+  result.reserve(entries.GetArray().size());
+  for (const auto& entry : entries.GetArray()) {
+    // deleted entries are nil in XAUTOCLAIM replies of Redis 6.2
+    if (!entry.IsArray() || entry.GetArray().size() != 2) continue;
+    const auto& id = entry.GetArray()[0];
+    const auto& fields = entry.GetArray()[1];
+    if (!id.IsString()) continue;
+
+    StreamMessage message;
+    message.id = id.GetString();
+    if (fields.IsArray()) {
+      const auto& values = fields.GetArray();
+      message.fields.reserve(values.size() / 2);
+      for (std::size_t i = 0; i + 1 < values.size(); i += 2) {
+        message.fields.emplace_back(values[i].GetString(),
+                                    values[i + 1].GetString());
+      }
+    }
+    result.push_back(std::move(message));
+  }
+  return result;
+}
+
+// Stream ids start with the milliseconds timestamp of the entry creation
+std::optional<std::int64_t> GetLagMs(const std::string& id) {
+  std::int64_t created_ms = 0;
+  const auto dash = id.find('-');
+  try {
+    created_ms = std::stoll(id.substr(0, dash));
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+  const auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          utils::datetime::Now().time_since_epoch())
+                          .count();
+  return now_ms - created_ms;
+}
+
+}  // namespace
+
+StreamConsumerBase::StreamConsumerBase(ClientPtr client,
+                                       StreamConsumerSettings settings)
+    : client_(std::move(client)),
+      settings_(std::move(settings)),
+      scripts_(client_) {
+  UINVARIANT(settings_.batch_size > 0, "batch_size must be positive");
+  UINVARIANT(settings_.max_parallelism > 0,
+             "max_parallelism must be positive");
+}
+
+StreamConsumerBase::~StreamConsumerBase() {
+  UASSERT_MSG(!poll_task_.IsRunning(),
+              "Stop() must be called before the consumer is destroyed");
+  poll_task_.Stop();
+}
+
+void StreamConsumerBase::Start() {
+  if (poll_task_.IsRunning()) return;
+  poll_task_.Start(
+      "redis_stream_consumer",
+      {settings_.poll_interval, {utils::PeriodicTask::Flags::kNow}},
+      [this] { Poll(); });
+}
+
+void StreamConsumerBase::Stop() { poll_task_.Stop(); }
+
+const StreamConsumerStatistics& StreamConsumerBase::GetStatistics()
+    const noexcept {
+  return stats_;
+}
+
+void StreamConsumerBase::Poll() {
+  if (!group_created_) {
+    EnsureGroup();
+    group_created_ = true;
+  }
+
+  ConsumeBatch(Reclaim());
+  while (ConsumeBatch(ReadNew()) && !engine::current_task::ShouldCancel()) {
+  }
+}
+
+void StreamConsumerBase::EnsureGroup() {
+  scripts_.Eval<std::int64_t>(kCreateGroupScript, {settings_.stream},
+                              {settings_.group}, settings_.command_control);
+}
+
+std::vector<StreamMessage> StreamConsumerBase::ReadNew() {
+  auto messages = ParseEntries(scripts_.Eval<ReplyData>(
+      kReadScript, {settings_.stream},
+      {settings_.group, settings_.consumer,
+       std::to_string(settings_.batch_size)},
+      settings_.command_control));
+
+  stats_.received += messages.size();
+  if (!messages.empty()) {
+    if (auto lag_ms = GetLagMs(messages.back().id)) stats_.lag_ms = *lag_ms;
+  }
+  return messages;
+}
+
+std::vector<StreamMessage> StreamConsumerBase::Reclaim() {
+  auto reply = scripts_.Eval<ReplyData>(
+      kReclaimScript, {settings_.stream},
+      {settings_.group, settings_.consumer,
+       std::to_string(settings_.min_idle_to_reclaim.count()), reclaim_cursor_,
+       std::to_string(settings_.batch_size)},
+      settings_.command_control);
+  if (!reply.IsArray() || reply.GetArray().size() != 2) return {};
+
+  const auto& cursor = reply.GetArray()[0];
+  if (cursor.IsString()) reclaim_cursor_ = cursor.GetString();
+
+  auto messages = ParseEntries(reply.GetArray()[1]);
+  stats_.reclaimed += messages.size();
+  return messages;
+}
+
+bool StreamConsumerBase::ConsumeBatch(std::vector<StreamMessage> messages) {
+  if (messages.empty()) return false;
+
+  engine::Semaphore slots{settings_.max_parallelism};
+  std::vector<engine::TaskWithResult<bool>> tasks;
+  tasks.reserve(messages.size());
+  for (const auto& message : messages) {
+    engine::SemaphoreLock slot{slots};
+    tasks.push_back(utils::Async(
+        "redis_stream_process",
+        [this, &message, slot = std::move(slot)] {
+          try {
+            Process(message);
+            return true;
+          } catch (const std::exception& ex) {
+            LOG_WARNING() << "Failed to process message " << message.id
+                          << " of Redis stream " << settings_.stream << ": "
+                          << ex;
+            return false;
+          }
+        }));
+  }
+
+  std::vector<std::string> processed_ids;
+  processed_ids.reserve(messages.size());
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    if (tasks[i].Get()) {
+      processed_ids.push_back(std::move(messages[i].id));
+    } else {
+      ++stats_.failed;
+    }
+  }
+  stats_.processed += processed_ids.size();
+
+  Ack(std::move(processed_ids));
+  return messages.size() >= settings_.batch_size;
+}
+
+void StreamConsumerBase::Ack(std::vector<std::string> ids) {
+  if (ids.empty()) return;
+
+  // a single XACK for the whole batch
+  ids.insert(ids.begin(), settings_.group);
+  scripts_.Eval<std::int64_t>(kAckScript, {settings_.stream}, std::move(ids),
+                              settings_.command_control);
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const StreamConsumerStatistics& stats) {
+  writer["received"] = stats.received.load();
+  writer["reclaimed"] = stats.reclaimed.load();
+  writer["processed"] = stats.processed.load();
+  writer["failed"] = stats.failed.load();
+  writer["lag-ms"] = stats.lag_ms.load();
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,101 @@
+#include <storages/redis/client_redistest.hpp>
+
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/storages/redis/stream_consumer_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class TestConsumer final : public storages::redis::StreamConsumerBase {
+ public:
+  using StreamConsumerBase::StreamConsumerBase;
+
+  ~TestConsumer() override { Stop(); }
+
+  std::set<std::string> GetValues() {
+    auto values = values_.Lock();
+    return *values;
+  }
+
+ protected:
+  void Process(const storages::redis::StreamMessage& message) override {
+    ASSERT_EQ(message.fields.size(), 1);
+    const auto& value = message.fields[0].second;
+    // the first attempt fails, the message is reclaimed
+    if (value == "fail" && !failed_.exchange(true)) {
+      throw std::runtime_error("test failure");
+    }
+    auto values = values_.Lock();
+    values->insert(value);
+  }
+
+ private:
+  std::atomic<bool> failed_{false};
+  concurrent::Variable<std::set<std::string>> values_;
+};
+
+void Add(storages::redis::Client& client, const std::string& value) {
+  client
+      .Eval<std::string>("return redis.call('XADD', KEYS[1], '*', 'v', "
+                         "ARGV[1])",
+                         {"stream"}, {value}, {})
+      .Get();
+}
+
+}  // namespace
+
+UTEST_F(RedisClientTest, StreamConsumer) {
+  Version since{6, 2, 0};
+  if (!CheckVersion(since)) {
+    GTEST_SKIP() << SkipMsgByVersion("XAUTOCLAIM", since);
+  }
+
+  auto client = GetClient();
+  storages::redis::StreamConsumerSettings settings;
+  settings.stream = "stream";
+  settings.group = "group";
+  settings.consumer = "consumer";
+  settings.batch_size = 2;
+  settings.poll_interval = std::chrono::milliseconds{10};
+  settings.min_idle_to_reclaim = std::chrono::milliseconds{50};
+
+  TestConsumer consumer{client, settings};
+  consumer.Start();
+  // wait for the group creation, it starts from the new messages
+  while (consumer.GetStatistics().received == 0) {
+    Add(*client, "first");
+    engine::SleepFor(std::chrono::milliseconds{20});
+  }
+
+  Add(*client, "second");
+  Add(*client, "fail");
+  Add(*client, "third");
+
+  const std::set<std::string> expected{"first", "second", "fail", "third"};
+  while (consumer.GetValues() != expected) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  consumer.Stop();
+
+  const auto& stats = consumer.GetStatistics();
+  EXPECT_EQ(stats.failed, 1);
+  EXPECT_GE(stats.reclaimed, 1);
+
+  // all the messages are acknowledged
+  const auto pending =
+      client
+          ->Eval<std::int64_t>(
+              "return redis.call('XPENDING', KEYS[1], ARGV[1])[1]", {"stream"},
+              {"group"}, {})
+          .Get();
+  EXPECT_EQ(pending, 0);
+}
+
+USERVER_NAMESPACE_END
@@ -33,6 +33,12 @@ bool SubscriptionQueue<Item>::PopMessage(Item& msg_ptr) {
   return consumer_.Pop(msg_ptr);
 }
 
+template <typename Item>
+size_t SubscriptionQueue<Item>::PopMessages(std::vector<Item>& items,
+                                            size_t max_count) {
+  return consumer_.PopBatch(items, max_count);
+}
+
 template <typename Item>
 void SubscriptionQueue<Item>::Unsubscribe() {
   token_->Unsubscribe();
@@ -48,16 +54,19 @@ SubscriptionQueue<Item>::GetSubscriptionToken(
     const USERVER_NAMESPACE::redis::CommandControl& command_control) {
   return subscribe_sentinel.Subscribe(
       channel,
-      [this](const std::string& channel, const std::string& message) {
-        if (!producer_.PushNoblock(Item(message))) {
+      [this](const std::string& channel, const SharedMessage& message) {
+        const bool pushed = producer_.PushNoblock(Item(message));
+        if (!pushed) {
           // Use SubscriptionQueue::SetMaxLength() or
           // SubscriptionToken::SetMaxQueueLength() if limit is too low
           LOG_ERROR()
-              << "failed to push message '" << message << "' from channel '"
+              << "failed to push message '" << *message << "' from channel '"
               << channel
               << "' into subscription queue due to overflow (max length="
               << queue_->GetSoftMaxSize() << ')';
         }
+        return USERVER_NAMESPACE::redis::Sentinel::MessageDelivery{
+            !pushed, queue_->GetSizeApproximate()};
       },
       command_control);
 }
@@ -73,16 +82,19 @@ SubscriptionQueue<Item>::GetSubscriptionToken(
   return subscribe_sentinel.Psubscribe(
       pattern,
       [this](const std::string& pattern, const std::string& channel,
-             const std::string& message) {
-        if (!producer_.PushNoblock(Item(channel, message))) {
+             const SharedMessage& message) {
+        const bool pushed = producer_.PushNoblock(Item(channel, message));
+        if (!pushed) {
           // Use SubscriptionQueue::SetMaxLength() or
           // SubscriptionToken::SetMaxQueueLength() if limit is too low
           LOG_ERROR()
-              << "failed to push pmessage '" << message << "' from channel '"
+              << "failed to push pmessage '" << *message << "' from channel '"
               << channel << "' from pattern '" << pattern
               << "' into subscription queue due to overflow (max length="
               << queue_->GetSoftMaxSize() << ')';
         }
+        return USERVER_NAMESPACE::redis::Sentinel::MessageDelivery{
+            !pushed, queue_->GetSizeApproximate()};
       },
       command_control);
 }
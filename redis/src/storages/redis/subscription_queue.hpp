@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <storages/redis/impl/subscribe_sentinel.hpp>
 #include <userver/concurrent/queue.hpp>
@@ -10,20 +11,23 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::redis {
 
+using SharedMessage = USERVER_NAMESPACE::redis::Sentinel::SharedMessage;
+
+// The message is shared with the other local subscribers of the channel
 struct ChannelSubscriptionQueueItem {
-  std::string message;
+  SharedMessage message;
 
   ChannelSubscriptionQueueItem() = default;
-  explicit ChannelSubscriptionQueueItem(std::string message)
+  explicit ChannelSubscriptionQueueItem(SharedMessage message)
       : message(std::move(message)) {}
 };
 
 struct PatternSubscriptionQueueItem {
   std::string channel;
-  std::string message;
+  SharedMessage message;
 
   PatternSubscriptionQueueItem() = default;
-  PatternSubscriptionQueueItem(std::string channel, std::string message)
+  PatternSubscriptionQueueItem(std::string channel, SharedMessage message)
       : channel(std::move(channel)), message(std::move(message)) {}
 };
 
@@ -43,6 +47,10 @@ class SubscriptionQueue {
 
   bool PopMessage(Item& msg_ptr);
 
+  /// Waits for the messages and pops up to `max_count` of them at once,
+  /// returns 0 when the queue is closed
+  size_t PopMessages(std::vector<Item>& items, size_t max_count);
+
   void Unsubscribe();
 
  private:
@@ -1,6 +1,7 @@
 #include "subscription_token_impl.hpp"
 
 #include <stdexcept>
+#include <vector>
 
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/tracing/span.hpp>
@@ -14,6 +15,9 @@ namespace {
 constexpr std::string_view kProcessRedisSubscriptionMessage =
     "process redis subscription message";
 
+// Amortizes the wakeups of the subscriber task under a burst of messages
+constexpr size_t kMaxMessagesBatchSize = 32;
+
 }  // namespace
 
 SubscriptionTokenImpl::SubscriptionTokenImpl(
@@ -39,10 +43,13 @@ void SubscriptionTokenImpl::Unsubscribe() {
 }
 
 void SubscriptionTokenImpl::ProcessMessages() {
-  ChannelSubscriptionQueueItem msg;
-  while (queue_.PopMessage(msg)) {
-    tracing::Span span(std::string{kProcessRedisSubscriptionMessage});
-    if (on_message_cb_) on_message_cb_(channel_, msg.message);
+  std::vector<ChannelSubscriptionQueueItem> messages;
+  while (queue_.PopMessages(messages, kMaxMessagesBatchSize)) {
+    for (const auto& msg : messages) {
+      tracing::Span span(std::string{kProcessRedisSubscriptionMessage});
+      if (on_message_cb_) on_message_cb_(channel_, *msg.message);
+    }
+    messages.clear();
   }
 }
 
@@ -69,10 +76,15 @@ void PsubscriptionTokenImpl::Unsubscribe() {
 }
 
 void PsubscriptionTokenImpl::ProcessMessages() {
-  PatternSubscriptionQueueItem msg;
-  while (queue_.PopMessage(msg)) {
-    tracing::Span span(std::string{kProcessRedisSubscriptionMessage});
-    if (on_pmessage_cb_) on_pmessage_cb_(pattern_, msg.channel, msg.message);
+  std::vector<PatternSubscriptionQueueItem> messages;
+  while (queue_.PopMessages(messages, kMaxMessagesBatchSize)) {
+    for (const auto& msg : messages) {
+      tracing::Span span(std::string{kProcessRedisSubscriptionMessage});
+      if (on_pmessage_cb_) {
+        on_pmessage_cb_(pattern_, msg.channel, *msg.message);
+      }
+    }
+    messages.clear();
   }
 }
 
@@ -1,11 +1,31 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <boost/program_options.hpp>
 
+#include <userver/congestion_control/concurrency_limiter.hpp>
 #include <userver/congestion_control/controller.hpp>
+#include <userver/congestion_control/controllers/linear.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/yaml/serialize.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/logger.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
 
 #include <userver/utest/using_namespace_userver.hpp>
 
@@ -14,6 +34,17 @@ using namespace congestion_control;
 struct Config {
   Policy policy;
   std::string log_level = "none";
+
+  // Trace replay mode, see ReplayTrace
+  std::string trace;
+  std::string trace_format = "tsv";
+  std::string controller = "v1";
+  std::string linear_config_json;
+  std::string gradient_config_yaml;
+  std::size_t workers = 32;
+  std::int64_t default_deadline_ms = 1000;
+  std::int64_t overload_wait_ms = 20;
+  bool timeline = false;
 };
 
 Config ParseArgs(int argc, char* argv[]) {
@@ -32,6 +63,38 @@ Config ParseArgs(int argc, char* argv[]) {
     ("policy,p",
      po::value(&policy_json)->default_value(std::string{}),
      "policy in JSON")
+    ("trace,t",
+     po::value(&config.trace)->default_value(config.trace),
+     "replay the request trace from the file instead of reading the sensor "
+     "data from stdin")
+    ("trace-format",
+     po::value(&config.trace_format)->default_value(config.trace_format),
+     "trace format: 'tsv' (arrival_ms service_ms [handler [deadline_ms]]) or "
+     "'access-tskv' (access_tskv.log of the server)")
+    ("controller,c",
+     po::value(&config.controller)->default_value(config.controller),
+     "controller to replay the trace against: 'none', 'v1' (RPS limit with "
+     "--policy), 'linear' (v2::LinearController with --linear-config) or "
+     "'gradient' (ConcurrencyLimiter with --gradient-config)")
+    ("linear-config",
+     po::value(&config.linear_config_json)->default_value(std::string{}),
+     "congestion_control::v2::Config in JSON")
+    ("gradient-config",
+     po::value(&config.gradient_config_yaml)->default_value(std::string{}),
+     "congestion_control::ConcurrencyLimiterSettings in YAML")
+    ("workers,w",
+     po::value(&config.workers)->default_value(config.workers),
+     "the number of requests the emulated server handles in parallel")
+    ("default-deadline-ms",
+     po::value(&config.default_deadline_ms)
+         ->default_value(config.default_deadline_ms),
+     "deadline of the requests that have none in the trace")
+    ("overload-wait-ms",
+     po::value(&config.overload_wait_ms)
+         ->default_value(config.overload_wait_ms),
+     "queue wait of a request that is reported as an overload event to 'v1'")
+    ("timeline", po::bool_switch(&config.timeline),
+     "print the stats of each second of the replay")
   ;
   // clang-format on
 
@@ -47,10 +110,445 @@ Config ParseArgs(int argc, char* argv[]) {
   if (!policy_json.empty()) {
     config.policy = formats::json::FromString(policy_json).As<Policy>();
   }
+  if (config.workers == 0) {
+    throw std::runtime_error("--workers must be positive");
+  }
 
   return config;
 }
 
+namespace {
+
+using Duration = std::chrono::microseconds;
+
+constexpr Duration kEpoch = std::chrono::seconds{1};
+
+struct TraceRequest {
+  Duration arrival;
+  Duration service_time;
+  Duration deadline;
+  std::string handler;
+};
+
+Duration FromMs(double ms) {
+  return std::chrono::duration_cast<Duration>(
+      std::chrono::duration<double, std::milli>{ms});
+}
+
+double ToMs(Duration duration) {
+  return std::chrono::duration<double, std::milli>{duration}.count();
+}
+
+// arrival_ms service_ms [handler [deadline_ms]], '#' starts a comment
+std::vector<TraceRequest> ReadTsvTrace(std::istream& input,
+                                       Duration default_deadline) {
+  std::vector<TraceRequest> trace;
+  std::string line;
+  while (std::getline(input, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields{line};
+    double arrival_ms = 0;
+    double service_ms = 0;
+    if (!(fields >> arrival_ms >> service_ms)) {
+      throw std::runtime_error("Invalid trace line: " + line);
+    }
+    TraceRequest request{FromMs(arrival_ms), FromMs(service_ms),
+                         default_deadline, "unknown"};
+    double deadline_ms = 0;
+    if (fields >> request.handler && fields >> deadline_ms) {
+      request.deadline = FromMs(deadline_ms);
+    }
+    trace.push_back(std::move(request));
+  }
+  return trace;
+}
+
+// The access log is written on the request completion with the time in
+// seconds, so the arrival times are only accurate up to a second and the
+// service times include the queue wait of the original run.
+std::vector<TraceRequest> ReadAccessTskvTrace(std::istream& input,
+                                              Duration default_deadline) {
+  std::vector<TraceRequest> trace;
+  std::string line;
+  while (std::getline(input, line)) {
+    std::optional<std::string_view> timestamp;
+    std::optional<std::string_view> request_time;
+    std::string_view url;
+
+    std::string_view rest{line};
+    while (!rest.empty()) {
+      const auto tab = rest.find('\t');
+      const auto field = rest.substr(0, tab);
+      rest = tab == std::string_view::npos ? std::string_view{}
+                                           : rest.substr(tab + 1);
+      const auto eq = field.find('=');
+      if (eq == std::string_view::npos) continue;
+      const auto key = field.substr(0, eq);
+      const auto value = field.substr(eq + 1);
+      if (key == "timestamp") timestamp = value;
+      if (key == "request_time") request_time = value;
+      if (key == "request") url = value.substr(0, value.find('?'));
+    }
+    if (!timestamp || !request_time) continue;
+
+    const auto completion = utils::datetime::Stringtime(
+        std::string{*timestamp}, "UTC", "%Y-%m-%dT%H:%M:%E*S");
+    const auto service_time =
+        FromMs(std::stod(std::string{*request_time}) * 1000);
+    const auto arrival =
+        std::chrono::duration_cast<Duration>(completion.time_since_epoch()) -
+        service_time;
+    trace.push_back({arrival, service_time, default_deadline,
+                     url.empty() ? "unknown" : std::string{url}});
+  }
+
+  // Relative to the first request, in the arrival order
+  std::sort(trace.begin(), trace.end(), [](const auto& a, const auto& b) {
+    return a.arrival < b.arrival;
+  });
+  if (!trace.empty()) {
+    const auto start = trace.front().arrival;
+    for (auto& request : trace) request.arrival -= start;
+  }
+  return trace;
+}
+
+struct EpochStats {
+  std::size_t arrived{0};
+  std::size_t admitted{0};
+  std::size_t completed{0};
+  std::size_t timeouts{0};
+  std::size_t overloads{0};
+  std::size_t max_in_flight{0};
+  Duration latency_sum{0};
+};
+
+// Decides which requests of the replayed trace are admitted
+class ReplayController {
+ public:
+  virtual ~ReplayController() = default;
+
+  virtual bool Admit(std::size_t in_flight,
+                     const EpochStats& current_epoch) = 0;
+
+  virtual void OnCompleted(Duration /*latency*/, std::size_t /*in_flight*/,
+                           bool /*timed_out*/) {}
+
+  virtual void OnEpoch(const EpochStats& /*epoch*/,
+                       std::size_t /*in_flight*/) {}
+
+  virtual std::optional<std::size_t> GetLimit() const = 0;
+};
+
+class NoLimitController final : public ReplayController {
+ public:
+  bool Admit(std::size_t, const EpochStats&) override { return true; }
+
+  std::optional<std::size_t> GetLimit() const override { return {}; }
+};
+
+// The RPS limit of the server, see server::congestion_control::Sensor
+class RpsController final : public ReplayController {
+ public:
+  explicit RpsController(const Policy& policy)
+      : dynamic_config_({{impl::kRpsCcConfig, {policy, true}}}),
+        controller_("cc", dynamic_config_.GetSource()) {}
+
+  bool Admit(std::size_t, const EpochStats& current_epoch) override {
+    return !limit_ || current_epoch.admitted < *limit_;
+  }
+
+  void OnEpoch(const EpochStats& epoch, std::size_t) override {
+    Sensor::Data data;
+    data.current_load = epoch.arrived;
+    data.overload_events_count = epoch.overloads;
+    data.no_overload_events_count = epoch.admitted - epoch.overloads;
+    controller_.Feed(data);
+    limit_ = controller_.GetLimit().load_limit;
+  }
+
+  std::optional<std::size_t> GetLimit() const override { return limit_; }
+
+ private:
+  dynamic_config::StorageMock dynamic_config_;
+  Controller controller_;
+  std::optional<std::size_t> limit_;
+};
+
+// The in-flight limit of the database pools
+class LinearReplayController final : public ReplayController,
+                                     private v2::Sensor,
+                                     private Limiter {
+ public:
+  explicit LinearReplayController(const v2::Config& config)
+      : controller_("cc", *this, *this, stats_, {},
+                    dynamic_config_.GetSource(),
+                    [config](const dynamic_config::Snapshot&) {
+                      return config;
+                    }) {}
+
+  bool Admit(std::size_t in_flight, const EpochStats&) override {
+    return !limit_.load_limit || in_flight < *limit_.load_limit;
+  }
+
+  void OnEpoch(const EpochStats& epoch, std::size_t in_flight) override {
+    data_.total = epoch.completed;
+    data_.timeouts = epoch.timeouts;
+    data_.timings_avg_ms =
+        epoch.completed ? static_cast<std::size_t>(ToMs(epoch.latency_sum) /
+                                                   epoch.completed)
+                        : 0;
+    data_.current_load = std::max(epoch.max_in_flight, in_flight);
+    controller_.Step();
+  }
+
+  std::optional<std::size_t> GetLimit() const override {
+    return limit_.load_limit;
+  }
+
+ private:
+  v2::Sensor::Data GetCurrent() override { return data_; }
+
+  void SetLimit(const Limit& new_limit) override { limit_ = new_limit; }
+
+  dynamic_config::StorageMock dynamic_config_;
+  v2::Stats stats_;
+  v2::Sensor::Data data_;
+  Limit limit_;
+  v2::LinearController controller_;
+};
+
+class GradientController final : public ReplayController {
+ public:
+  explicit GradientController(const ConcurrencyLimiterSettings& settings)
+      : limiter_(settings) {}
+
+  bool Admit(std::size_t in_flight, const EpochStats&) override {
+    return in_flight < limiter_.GetLimit();
+  }
+
+  void OnCompleted(Duration latency, std::size_t in_flight,
+                   bool timed_out) override {
+    limiter_.OnSample(latency, in_flight, timed_out);
+  }
+
+  std::optional<std::size_t> GetLimit() const override {
+    return limiter_.GetLimit();
+  }
+
+ private:
+  ConcurrencyLimiter limiter_;
+};
+
+std::unique_ptr<ReplayController> MakeReplayController(const Config& config) {
+  if (config.controller == "none") {
+    return std::make_unique<NoLimitController>();
+  } else if (config.controller == "v1") {
+    return std::make_unique<RpsController>(config.policy);
+  } else if (config.controller == "linear") {
+    return std::make_unique<LinearReplayController>(
+        config.linear_config_json.empty()
+            ? v2::Config{}
+            : formats::json::FromString(config.linear_config_json)
+                  .As<v2::Config>());
+  } else if (config.controller == "gradient") {
+    return std::make_unique<GradientController>(
+        config.gradient_config_yaml.empty()
+            ? ConcurrencyLimiterSettings{}
+            : yaml_config::YamlConfig{formats::yaml::FromString(
+                                          config.gradient_config_yaml),
+                                      {}}
+                  .As<ConcurrencyLimiterSettings>());
+  }
+  throw std::runtime_error("Unknown controller: " + config.controller);
+}
+
+struct HandlerReport {
+  std::size_t requests{0};
+  std::size_t shed{0};
+  std::size_t timeouts{0};
+  std::vector<Duration> latencies;
+};
+
+struct Completion {
+  Duration time;
+  Duration latency;
+  bool timed_out;
+
+  bool operator>(const Completion& other) const { return time > other.time; }
+};
+
+template <typename T>
+using MinQueue = std::priority_queue<T, std::vector<T>, std::greater<T>>;
+
+// A server with `workers` parallel slots and a FIFO queue in front of them.
+// A request that waited in the queue past its deadline is dropped without
+// taking a slot, like the server does with the expired deadlines.
+std::map<std::string, HandlerReport> Replay(
+    const std::vector<TraceRequest>& trace, ReplayController& controller,
+    const Config& config) {
+  const Duration overload_wait = std::chrono::milliseconds{
+      config.overload_wait_ms};
+
+  std::map<std::string, HandlerReport> reports;
+  MinQueue<Duration> free_workers;
+  for (std::size_t i = 0; i < config.workers; ++i) free_workers.push({});
+  MinQueue<Completion> completions;
+  std::size_t in_flight = 0;
+
+  EpochStats epoch;
+  Duration epoch_end = kEpoch;
+
+  if (config.timeline) {
+    std::cout << "second\tarrived\tadmitted\tcompleted\ttimeouts\tin_flight\t"
+                 "limit\n";
+  }
+
+  const auto advance = [&](Duration now) {
+    for (;;) {
+      if (!completions.empty() && completions.top().time <= epoch_end &&
+          completions.top().time <= now) {
+        const auto completion = completions.top();
+        completions.pop();
+        controller.OnCompleted(completion.latency, in_flight,
+                               completion.timed_out);
+        --in_flight;
+        ++epoch.completed;
+        if (completion.timed_out) ++epoch.timeouts;
+        epoch.latency_sum += completion.latency;
+      } else if (epoch_end <= now) {
+        controller.OnEpoch(epoch, in_flight);
+        if (config.timeline) {
+          const auto limit = controller.GetLimit();
+          std::cout << epoch_end / kEpoch - 1 << '\t' << epoch.arrived << '\t'
+                    << epoch.admitted << '\t' << epoch.completed << '\t'
+                    << epoch.timeouts << '\t' << in_flight << '\t'
+                    << (limit ? std::to_string(*limit) : "(none)") << '\n';
+        }
+        epoch = {};
+        epoch_end += kEpoch;
+      } else {
+        break;
+      }
+    }
+  };
+
+  for (const auto& request : trace) {
+    advance(request.arrival);
+
+    auto& report = reports[request.handler];
+    ++report.requests;
+    ++epoch.arrived;
+    if (!controller.Admit(in_flight, epoch)) {
+      ++report.shed;
+      continue;
+    }
+    ++epoch.admitted;
+
+    const auto start = std::max(request.arrival, free_workers.top());
+    Completion completion{};
+    if (start - request.arrival > request.deadline) {
+      completion = {request.arrival + request.deadline, request.deadline, true};
+    } else {
+      free_workers.pop();
+      free_workers.push(start + request.service_time);
+      const auto end = start + request.service_time;
+      completion = {end, end - request.arrival,
+                    end - request.arrival > request.deadline};
+    }
+    if (start - request.arrival > overload_wait) ++epoch.overloads;
+    if (completion.timed_out) ++report.timeouts;
+    report.latencies.push_back(completion.latency);
+
+    completions.push(completion);
+    ++in_flight;
+    epoch.max_in_flight = std::max(epoch.max_in_flight, in_flight);
+  }
+
+  // Drain the requests in flight
+  while (!completions.empty()) advance(completions.top().time + kEpoch);
+
+  return reports;
+}
+
+std::string Percentiles(std::vector<Duration>& latencies) {
+  if (latencies.empty()) return "-";
+  std::sort(latencies.begin(), latencies.end());
+  std::ostringstream result;
+  result << std::fixed << std::setprecision(1);
+  const char* separator = "";
+  for (const std::string_view percentile : {"50", "90", "99", "99.9"}) {
+    const auto percent = std::stod(std::string{percentile});
+    const auto index = std::min(
+        latencies.size() - 1,
+        static_cast<std::size_t>(percent / 100 * latencies.size()));
+    result << separator << 'p' << percentile << '=' << ToMs(latencies[index]);
+    separator = " ";
+  }
+  return result.str();
+}
+
+double Percent(std::size_t part, std::size_t total) {
+  return total ? 100.0 * part / total : 0;
+}
+
+void PrintReport(std::map<std::string, HandlerReport>& reports,
+                 Duration duration) {
+  HandlerReport total;
+  for (auto& [handler, report] : reports) {
+    total.requests += report.requests;
+    total.shed += report.shed;
+    total.timeouts += report.timeouts;
+    total.latencies.insert(total.latencies.end(), report.latencies.begin(),
+                           report.latencies.end());
+  }
+  const auto seconds =
+      std::max(std::chrono::duration<double>{duration}.count(), 1.0);
+
+  const auto print = [seconds](std::string_view name, HandlerReport& report) {
+    const auto good = report.requests - report.shed - report.timeouts;
+    std::cout << name << "\trequests=" << report.requests
+              << "\tgoodput_rps=" << good / seconds
+              << "\tshed_percent=" << Percent(report.shed, report.requests)
+              << "\ttimeout_percent="
+              << Percent(report.timeouts, report.requests)
+              << "\tlatency_ms=" << Percentiles(report.latencies) << '\n';
+  };
+
+  std::cout << std::fixed << std::setprecision(2);
+  print("total", total);
+  for (auto& [handler, report] : reports) print(handler, report);
+}
+
+// Replays the real requests against a controller to compare the settings
+// offline. The report contains the goodput (requests completed within their
+// deadlines per second), the share of the shed and of the timed out requests
+// and the latency percentiles of the admitted requests.
+void ReplayTrace(const Config& config) {
+  std::ifstream input{config.trace};
+  if (!input) throw std::runtime_error("Failed to open " + config.trace);
+
+  const Duration default_deadline =
+      std::chrono::milliseconds{config.default_deadline_ms};
+  std::vector<TraceRequest> trace;
+  if (config.trace_format == "tsv") {
+    trace = ReadTsvTrace(input, default_deadline);
+  } else if (config.trace_format == "access-tskv") {
+    trace = ReadAccessTskvTrace(input, default_deadline);
+  } else {
+    throw std::runtime_error("Unknown trace format: " + config.trace_format);
+  }
+  if (trace.empty()) throw std::runtime_error("The trace is empty");
+
+  engine::RunStandalone([&] {
+    const auto controller = MakeReplayController(config);
+    auto reports = Replay(trace, *controller, config);
+    PrintReport(reports, trace.back().arrival - trace.front().arrival);
+  });
+}
+
+}  // namespace
+
 int main(int argc, char* argv[]) {
   Config config = ParseArgs(argc, argv);
 
@@ -58,6 +556,11 @@ int main(int argc, char* argv[]) {
       logging::MakeStderrLogger("default", logging::Format::kTskv,
                                 logging::LevelFromString(config.log_level))};
 
+  if (!config.trace.empty()) {
+    ReplayTrace(config);
+    return 0;
+  }
+
   dynamic_config::StorageMock dynamic_config{
       {congestion_control::impl::kRpsCcConfig, {config.policy, true}}};
   Controller ctrl("cc", dynamic_config.GetSource());
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Count-min sketch of the recent access frequencies for the TinyLFU
+/// admission policy.
+///
+/// Like utils::FilterBloom, each key maps to a few counters by double hashing
+/// and only the smallest of them are incremented. The counters saturate at
+/// kMaxFrequency and are halved after the number of increments reaches
+/// 10 times the cache capacity, so the history of the old accesses fades out.
+template <typename T, typename Hash = std::hash<T>>
+class FrequencySketch final {
+ public:
+  static constexpr std::uint8_t kMaxFrequency = 15;
+
+  explicit FrequencySketch(std::size_t capacity, const Hash& hash = Hash());
+
+  void Increment(const T& key);
+
+  std::uint8_t Estimate(const T& key) const;
+
+  void Clear() noexcept;
+
+ private:
+  static constexpr std::size_t kHashFunctionsCount = 4;
+
+  static std::size_t GetCountersCount(std::size_t capacity) noexcept;
+
+  using Indices = std::array<std::size_t, kHashFunctionsCount>;
+
+  Indices GetIndices(const T& key) const;
+
+  std::uint8_t GetMin(const Indices& indices) const noexcept;
+
+  void Age() noexcept;
+
+  Hash hash_;
+  utils::FixedArray<std::uint8_t> counters_;
+  const std::size_t mask_;
+  const std::size_t sample_size_;
+  std::size_t increments_{0};
+};
+
+template <typename T, typename Hash>
+FrequencySketch<T, Hash>::FrequencySketch(std::size_t capacity,
+                                          const Hash& hash)
+    : hash_(hash),
+      counters_(GetCountersCount(capacity), 0),
+      mask_(counters_.size() - 1),
+      sample_size_(std::max<std::size_t>(capacity, 1) * 10) {}
+
+template <typename T, typename Hash>
+std::size_t FrequencySketch<T, Hash>::GetCountersCount(
+    std::size_t capacity) noexcept {
+  // 4 counters per cached element keep the estimation error low enough
+  std::size_t result = 64;
+  while (result < capacity * 4) result <<= 1;
+  return result;
+}
+
+template <typename T, typename Hash>
+auto FrequencySketch<T, Hash>::GetIndices(const T& key) const -> Indices {
+  const std::uint64_t hash_1 = hash_(key);
+  // The second hash is a cheap remix of the first one, the idea was taken
+  // from https://www.eecs.harvard.edu/~michaelm/postscripts/tr-02-05.pdf
+  const std::uint64_t hash_2 = ((hash_1 * 0x9E3779B97F4A7C15ULL) >> 17) | 1;
+
+  Indices result{};
+  for (std::size_t step = 0; step < kHashFunctionsCount; ++step) {
+    result[step] = (hash_1 + hash_2 * step) & mask_;
+  }
+  return result;
+}
+
+template <typename T, typename Hash>
+std::uint8_t FrequencySketch<T, Hash>::GetMin(
+    const Indices& indices) const noexcept {
+  std::uint8_t result = kMaxFrequency;
+  for (const auto index : indices) {
+    result = std::min(result, counters_[index]);
+  }
+  return result;
+}
+
+template <typename T, typename Hash>
+void FrequencySketch<T, Hash>::Increment(const T& key) {
+  const auto indices = GetIndices(key);
+  const auto frequency = GetMin(indices);
+  // Only the smallest counters grow. The update is branchless, the
+  // comparisons are hard to predict.
+  const bool can_grow = frequency < kMaxFrequency;
+  for (const auto index : indices) {
+    auto& counter = counters_[index];
+    counter += static_cast<std::uint8_t>(can_grow && counter == frequency);
+  }
+
+  if (++increments_ >= sample_size_) Age();
+}
+
+template <typename T, typename Hash>
+std::uint8_t FrequencySketch<T, Hash>::Estimate(const T& key) const {
+  return GetMin(GetIndices(key));
+}
+
+template <typename T, typename Hash>
+void FrequencySketch<T, Hash>::Clear() noexcept {
+  for (auto& counter : counters_) counter = 0;
+  increments_ = 0;
+}
+
+template <typename T, typename Hash>
+void FrequencySketch<T, Hash>::Age() noexcept {
+  for (auto& counter : counters_) counter /= 2;
+  increments_ /= 2;
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
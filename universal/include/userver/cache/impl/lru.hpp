@@ -130,6 +130,9 @@ class LruBase final {
 
   void Clear() noexcept;
 
+  template <typename Function>
+  void VisitEvictionCandidate(Function&& func);
+
   template <typename Function>
   void VisitAll(Function&& func) const;
 
@@ -273,6 +276,14 @@ void LruBase<T, U, Hash, Eq>::SetMaxSize(size_t new_max_size) {
   buckets_.swap(new_buckets);
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Function>
+void LruBase<T, U, Hash, Eq>::VisitEvictionCandidate(Function&& func) {
+  if (map_.size() < buckets_.size() || list_.empty()) return;
+  const auto& node = list_.front();
+  func(node.GetKey(), node.GetValue());
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 void LruBase<T, U, Hash, Eq>::Clear() noexcept {
   while (!list_.empty()) {
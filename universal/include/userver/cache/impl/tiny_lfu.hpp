@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/slru.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// W-TinyLFU: a small LRU window in front of the SLRU main part with a
+/// frequency based admission filter.
+///
+/// New keys always get into the window. The key evicted from the window
+/// replaces the least used key of the main part only if it was accessed more
+/// often recently, so a scan of the one-off keys passes through the window
+/// without flushing the frequently used keys.
+///
+/// The window takes 1% of the capacity, the protected segment takes 80% of
+/// the main part. The capacity is at least 3 elements.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class WTinyLfuBase final {
+ public:
+  using NodeType = std::unique_ptr<LruNode<T, U>>;
+
+  explicit WTinyLfuBase(std::size_t max_size, const Hash& hash = Hash(),
+                        const Equal& equal = Equal());
+
+  WTinyLfuBase(WTinyLfuBase&& other) noexcept = default;
+  WTinyLfuBase& operator=(WTinyLfuBase&& other) noexcept = default;
+
+  WTinyLfuBase(const WTinyLfuBase&) = delete;
+  WTinyLfuBase& operator=(const WTinyLfuBase&) = delete;
+
+  bool Put(const T& key, U value);
+
+  template <typename... Args>
+  U* Emplace(const T& key, Args&&... args);
+
+  void Erase(const T& key);
+
+  U* Get(const T& key);
+
+  const T* GetLeastUsedKey() const;
+
+  U* GetLeastUsedValue();
+
+  void SetMaxSize(std::size_t new_max_size);
+
+  void Clear() noexcept;
+
+  template <typename Function>
+  void VisitEvictionCandidate(Function&& func);
+
+  template <typename Function>
+  void VisitAll(Function&& func) const;
+
+  template <typename Function>
+  void VisitAll(Function&& func);
+
+  std::size_t GetSize() const;
+
+  std::size_t GetCapacity() const;
+
+ private:
+  struct Sizes final {
+    explicit Sizes(std::size_t max_size) noexcept;
+
+    std::size_t window;
+    std::size_t probation;
+    std::size_t protected_part;
+  };
+
+  WTinyLfuBase(const Sizes& sizes, std::size_t max_size, const Hash& hash,
+               const Equal& equal);
+
+  // Moves the least used key of the window to the main part if it is admitted
+  // there. Returns the node of the evicted key, if any.
+  NodeType EvictFromWindow();
+
+  // The admission decision of EvictFromWindow(), true for the candidate
+  bool ShouldEvictCandidate(const T& candidate) const;
+
+  LruBase<T, U, Hash, Equal> window_;
+  SlruBase<T, U, Hash, Equal> main_;
+  std::unique_ptr<FrequencySketch<T, Hash>> sketch_;
+  Hash hash_;
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+WTinyLfuBase<T, U, Hash, Equal>::Sizes::Sizes(std::size_t max_size) noexcept
+    : window(std::max<std::size_t>(max_size / 100, 1)) {
+  const auto main =
+      std::max<std::size_t>(max_size - std::min(max_size, window), 2);
+  protected_part = std::max<std::size_t>(main * 4 / 5, 1);
+  probation = std::max<std::size_t>(main - protected_part, 1);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+WTinyLfuBase<T, U, Hash, Equal>::WTinyLfuBase(std::size_t max_size,
+                                              const Hash& hash,
+                                              const Equal& equal)
+    : WTinyLfuBase(Sizes{max_size}, max_size, hash, equal) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+WTinyLfuBase<T, U, Hash, Equal>::WTinyLfuBase(const Sizes& sizes,
+                                              std::size_t max_size,
+                                              const Hash& hash,
+                                              const Equal& equal)
+    : window_(sizes.window, hash, equal),
+      main_(sizes.probation, sizes.protected_part, hash, equal),
+      sketch_(std::make_unique<FrequencySketch<T, Hash>>(max_size, hash)),
+      hash_(hash) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool WTinyLfuBase<T, U, Hash, Equal>::Put(const T& key, U value) {
+  auto* existing = window_.Get(key);
+  if (!existing) existing = main_.Get(key);
+  if (existing) {
+    sketch_->Increment(key);
+    *existing = std::move(value);
+    return false;
+  }
+
+  // A new key is counted after the admission decision, so that
+  // VisitEvictionCandidate() could predict it
+  NodeType node;
+  if (window_.GetSize() >= window_.GetCapacity()) node = EvictFromWindow();
+  sketch_->Increment(key);
+
+  if (!node) {
+    window_.Put(key, std::move(value));
+    return true;
+  }
+  // Reuse the node of the evicted key, as LruBase does
+  node->SetKey(key);
+  node->SetValue(std::move(value));
+  window_.InsertNode(std::move(node));
+  return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename... Args>
+U* WTinyLfuBase<T, U, Hash, Equal>::Emplace(const T& key, Args&&... args) {
+  if (auto* const existing = Get(key)) return existing;
+
+  if (window_.GetSize() >= window_.GetCapacity()) EvictFromWindow();
+  return window_.Emplace(key, std::forward<Args>(args)...);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void WTinyLfuBase<T, U, Hash, Equal>::Erase(const T& key) {
+  window_.Erase(key);
+  main_.Erase(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* WTinyLfuBase<T, U, Hash, Equal>::Get(const T& key) {
+  sketch_->Increment(key);
+
+  if (auto* const value = window_.Get(key)) return value;
+  return main_.Get(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+const T* WTinyLfuBase<T, U, Hash, Equal>::GetLeastUsedKey() const {
+  if (const auto* const key = main_.GetLeastUsedKey()) return key;
+  return window_.GetLeastUsedKey();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* WTinyLfuBase<T, U, Hash, Equal>::GetLeastUsedValue() {
+  if (auto* const value = main_.GetLeastUsedValue()) return value;
+  return window_.GetLeastUsedValue();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void WTinyLfuBase<T, U, Hash, Equal>::SetMaxSize(std::size_t new_max_size) {
+  if (new_max_size == GetCapacity()) return;
+
+  const Sizes sizes{new_max_size};
+  window_.SetMaxSize(sizes.window);
+  main_.SetMaxSize(sizes.probation, sizes.protected_part);
+  sketch_ = std::make_unique<FrequencySketch<T, Hash>>(new_max_size, hash_);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void WTinyLfuBase<T, U, Hash, Equal>::Clear() noexcept {
+  window_.Clear();
+  main_.Clear();
+  sketch_->Clear();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void WTinyLfuBase<T, U, Hash, Equal>::VisitEvictionCandidate(Function&& func) {
+  if (window_.GetSize() < window_.GetCapacity() ||
+      main_.GetSize() < main_.GetCapacity()) {
+    return;
+  }
+
+  const auto* const candidate = window_.GetLeastUsedKey();
+  if (!candidate) return;
+  if (ShouldEvictCandidate(*candidate)) {
+    func(*candidate, *window_.GetLeastUsedValue());
+  } else {
+    func(*main_.GetLeastUsedKey(), *main_.GetLeastUsedValue());
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void WTinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) const {
+  window_.VisitAll(func);
+  main_.VisitAll(std::forward<Function>(func));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void WTinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) {
+  window_.VisitAll(func);
+  main_.VisitAll(std::forward<Function>(func));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t WTinyLfuBase<T, U, Hash, Equal>::GetSize() const {
+  return window_.GetSize() + main_.GetSize();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t WTinyLfuBase<T, U, Hash, Equal>::GetCapacity() const {
+  return window_.GetCapacity() + main_.GetCapacity();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename WTinyLfuBase<T, U, Hash, Equal>::NodeType
+WTinyLfuBase<T, U, Hash, Equal>::EvictFromWindow() {
+  auto candidate = window_.ExtractLeastUsedNode();
+  if (!candidate) return candidate;
+
+  if (main_.GetSize() < main_.GetCapacity()) {
+    main_.InsertNode(std::move(candidate));
+    return NodeType{};
+  }
+
+  if (ShouldEvictCandidate(candidate->GetKey())) return candidate;
+
+  auto victim = main_.ExtractLeastUsedNode();
+  main_.InsertNode(std::move(candidate));
+  return victim;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool WTinyLfuBase<T, U, Hash, Equal>::ShouldEvictCandidate(
+    const T& candidate) const {
+  const auto* const victim = main_.GetLeastUsedKey();
+  return victim && sketch_->Estimate(candidate) <= sketch_->Estimate(*victim);
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
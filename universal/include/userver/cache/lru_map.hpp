@@ -3,20 +3,40 @@
 /// @file userver/cache/lru_map.hpp
 /// @brief @copybrief cache::LruMap
 
+#include <type_traits>
+
 #include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/tiny_lfu.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 /// Utilities for caching
 namespace cache {
 
+/// Eviction policy of the LRU caches
+enum class CachePolicy {
+  /// Evicts the least recently used element
+  kLru,
+  /// W-TinyLFU: a new element replaces the least used one only if it was
+  /// accessed more often recently. Keeps the frequently used elements on
+  /// scans, requires a capacity of at least 3 elements.
+  kWTinyLfu,
+  /// CLOCK approximation of LRU, the hits of cache::NWayLRU do not lock the
+  /// ways. Not supported by cache::LruMap.
+  kClock,
+};
+
 /// @ingroup userver_universal userver_containers
 ///
 /// LRU key value storage (LRU cache), thread safety matches Standard Library
 /// thread safety
 template <typename T, typename U, typename Hash = std::hash<T>,
-          typename Equal = std::equal_to<T>>
+          typename Equal = std::equal_to<T>,
+          CachePolicy Policy = CachePolicy::kLru>
 class LruMap final {
+  static_assert(Policy != CachePolicy::kClock,
+                "CachePolicy::kClock is supported by cache::NWayLRU only");
+
  public:
   explicit LruMap(size_t max_size, const Hash& hash = Hash(),
                   const Equal& equal = Equal())
@@ -60,6 +80,18 @@ class LruMap final {
   /// @warning Returned pointer may be freed on the next map access!
   U* GetLeastUsed() { return impl_.GetLeastUsedValue(); }
 
+  /// Returns pointer to the key of the least recently used value;
+  /// returns nullptr if LRU is empty.
+  /// @warning Returned pointer may be freed on the next map access!
+  const T* GetLeastUsedKey() const { return impl_.GetLeastUsedKey(); }
+
+  /// Calls `func(const T&, const U&)` for the element that the Put() of a new
+  /// key would evict, does nothing if there is free space.
+  template <typename Function>
+  void VisitEvictionCandidate(Function&& func) {
+    impl_.VisitEvictionCandidate(std::forward<Function>(func));
+  }
+
   /// Sets the max size of the LRU, truncates values if new_max_size < GetSize()
   void SetMaxSize(size_t new_max_size) {
     return impl_.SetMaxSize(new_max_size);
@@ -85,7 +117,10 @@ class LruMap final {
   std::size_t GetCapacity() const { return impl_.GetCapacity(); }
 
  private:
-  impl::LruBase<T, U, Hash, Equal> impl_;
+  std::conditional_t<Policy == CachePolicy::kLru,
+                     impl::LruBase<T, U, Hash, Equal>,
+                     impl::WTinyLfuBase<T, U, Hash, Equal>>
+      impl_;
 };
 
 }  // namespace cache
@@ -0,0 +1,77 @@
+#pragma once
+
+/// @file userver/cache/size_of.hpp
+/// @brief @copybrief cache::ApproximateSizeOf
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+template <typename T>
+std::size_t ApproximateSizeOf(const T& value);
+
+namespace impl {
+
+template <typename T>
+inline constexpr bool kIsPair = meta::kIsInstantiationOf<std::pair, T>;
+
+template <typename T>
+inline constexpr bool kIsSmartPointer =
+    meta::kIsInstantiationOf<std::unique_ptr, T> ||
+    meta::kIsInstantiationOf<std::shared_ptr, T>;
+
+// Bytes that the value owns outside of sizeof(T)
+template <typename T>
+std::size_t ApproximateHeapSizeOf(const T& value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    // Short strings are stored inline
+    return value.capacity() > std::string{}.capacity() ? value.capacity() + 1
+                                                       : 0;
+  } else if constexpr (kIsPair<T>) {
+    return ApproximateHeapSizeOf(value.first) +
+           ApproximateHeapSizeOf(value.second);
+  } else if constexpr (meta::kIsOptional<T>) {
+    return value ? ApproximateHeapSizeOf(*value) : 0;
+  } else if constexpr (kIsSmartPointer<T>) {
+    return value ? ApproximateSizeOf(*value) : 0;
+  } else if constexpr (meta::kIsRange<T>) {
+    std::size_t result = 0;
+    for (const auto& element : value) result += ApproximateSizeOf(element);
+    return result;
+  } else {
+    return 0;
+  }
+}
+
+}  // namespace impl
+
+/// @brief Approximate number of bytes used by the value, including the
+/// memory it owns.
+///
+/// Knows about std::string, std::pair, std::optional, std::unique_ptr,
+/// std::shared_ptr and the ranges of those. The allocator overhead and the
+/// nodes of the node based containers are not counted. For other types the
+/// result is `sizeof(T)`, pass a custom weigher to the cache to count them
+/// accurately.
+///
+/// Used as the default weigher of the memory bounded LRU caches, see
+/// cache::NWayLRU::SetWeigher. cache::LruCacheComponent calls it unqualified,
+/// define `ApproximateSizeOf(const T&)` in the namespace of `T` to customize
+/// it.
+template <typename T>
+std::size_t ApproximateSizeOf(const T& value) {
+  return sizeof(T) + impl::ApproximateHeapSizeOf(value);
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
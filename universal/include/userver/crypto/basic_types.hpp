@@ -8,6 +8,7 @@
 #include <userver/crypto/exception.hpp>
 
 /// @cond
+struct evp_md_ctx_st;
 struct evp_pkey_st;
 struct x509_st;
 /// @endcond
@@ -17,6 +18,7 @@ USERVER_NAMESPACE_BEGIN
 namespace crypto {
 
 /// @cond
+using EVP_MD_CTX = struct evp_md_ctx_st;
 using EVP_PKEY = struct evp_pkey_st;
 using X509 = struct x509_st;
 /// @endcond
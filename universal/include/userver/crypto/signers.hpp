@@ -81,6 +81,8 @@ class DsaSigner final : public Signer {
 
  private:
   PrivateKey pkey_;
+  // Initialized with the key, copied for each message
+  std::shared_ptr<EVP_MD_CTX> ctx_;
 };
 
 /// @name Outputs RSASSA signature using SHA-2 and PKCS1 padding.
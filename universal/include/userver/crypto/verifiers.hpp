@@ -87,6 +87,8 @@ class DsaVerifier final : public Verifier {
 
  private:
   PublicKey pkey_;
+  // Initialized with the key, copied for each message
+  std::shared_ptr<EVP_MD_CTX> ctx_;
 };
 
 /// @name Verifies RSASSA signature using SHA-2 and PKCS1 padding.
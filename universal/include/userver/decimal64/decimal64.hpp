@@ -18,8 +18,10 @@
 // Licence:     BSD
 // ==================================================================
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <ios>
 #include <iosfwd>
@@ -1208,6 +1210,47 @@ struct ParseResult {
   uint32_t error_position{-1U};
 };
 
+constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+/// Parses the common "-123.45" form with at most `Prec` fractional digits.
+/// Returns std::nullopt for anything else, leaving it to Parse to handle or
+/// to report.
+template <int Prec, typename RoundPolicy>
+constexpr std::optional<Decimal<Prec, RoundPolicy>> TryParseSimple(
+    std::string_view input) noexcept {
+  std::size_t pos = 0;
+  const bool is_negative = !input.empty() && input[0] == '-';
+  if (is_negative) pos = 1;
+
+  int64_t before = 0;
+  const auto before_start = pos;
+  for (; pos < input.size() && IsDigit(input[pos]); ++pos) {
+    if (pos - before_start == kMaxDecimalDigits) return std::nullopt;
+    before = 10 * before + (input[pos] - '0');
+  }
+  if (pos == before_start || before >= kMaxInt64 / kPow10<Prec>) {
+    return std::nullopt;
+  }
+
+  int64_t after = 0;
+  int after_digit_count = 0;
+  if (pos != input.size()) {
+    if (input[pos] != '.') return std::nullopt;
+    for (++pos; pos < input.size() && IsDigit(input[pos]); ++pos) {
+      if (after_digit_count == Prec) return std::nullopt;
+      after = 10 * after + (input[pos] - '0');
+      ++after_digit_count;
+    }
+    if (after_digit_count == 0 || pos != input.size()) return std::nullopt;
+  }
+
+  // Does not overflow due to the check of `before` above
+  const int64_t unbiased =
+      before * kPow10<Prec> + after * Pow10(Prec - after_digit_count);
+  return Decimal<Prec, RoundPolicy>::FromUnbiased(is_negative ? -unbiased
+                                                              : unbiased);
+}
+
 /// Parse Decimal from a CharSequence
 template <int Prec, typename RoundPolicy, typename CharSequence>
 [[nodiscard]] constexpr ParseResult<Prec, RoundPolicy> Parse(
@@ -1248,10 +1291,24 @@ void TrimTrailingZeros(int64_t& after, int& after_precision);
 std::string ToString(int64_t before, int64_t after, int precision,
                      const FormatOptions& format_options);
 
+/// The sign, the digits, a leading zero and the dot fit in it
+inline constexpr std::size_t kToCharsMaxSize = 24;
+
+/// Writes `unbiased / 10^precision` to `output`, with exactly `precision`
+/// fractional digits or with the trailing zeros trimmed. Returns the number of
+/// chars written.
+std::size_t ToChars(int64_t unbiased, int precision, bool trim_trailing_zeros,
+                    char* output) noexcept;
+
 }  // namespace impl
 
 template <int Prec, typename RoundPolicy>
 constexpr Decimal<Prec, RoundPolicy>::Decimal(std::string_view value) {
+  if (const auto simple = impl::TryParseSimple<Prec, RoundPolicy>(value)) {
+    *this = *simple;
+    return;
+  }
+
   const auto result = impl::Parse<Prec, RoundPolicy>(
       impl::StringCharSequence(value), impl::ParseOptions::kNone);
 
@@ -1265,6 +1322,10 @@ constexpr Decimal<Prec, RoundPolicy>::Decimal(std::string_view value) {
 template <int Prec, typename RoundPolicy>
 constexpr Decimal<Prec, RoundPolicy>
 Decimal<Prec, RoundPolicy>::FromStringPermissive(std::string_view input) {
+  if (const auto simple = impl::TryParseSimple<Prec, RoundPolicy>(input)) {
+    return *simple;
+  }
+
   const auto result = impl::Parse<Prec, RoundPolicy>(
       impl::StringCharSequence(input),
       {impl::ParseOptions::kAllowSpaces, impl::ParseOptions::kAllowBoundaryDot,
@@ -1287,7 +1348,9 @@ Decimal<Prec, RoundPolicy>::FromStringPermissive(std::string_view input) {
 /// @see ToStringFixed
 template <int Prec, typename RoundPolicy>
 std::string ToString(Decimal<Prec, RoundPolicy> dec) {
-  return fmt::to_string(dec);
+  char buffer[impl::kToCharsMaxSize];
+  const auto size = impl::ToChars(dec.AsUnbiased(), Prec, true, buffer);
+  return std::string(buffer, size);
 }
 
 /// @brief Converts Decimal to a string
@@ -1322,7 +1385,9 @@ std::string ToString(const Decimal<Prec, RoundPolicy>& dec,
 /// @see ToStringFixed
 template <int Prec, typename RoundPolicy>
 std::string ToStringTrailingZeros(Decimal<Prec, RoundPolicy> dec) {
-  return fmt::format(FMT_COMPILE("{:f}"), dec);
+  char buffer[impl::kToCharsMaxSize];
+  const auto size = impl::ToChars(dec.AsUnbiased(), Prec, false, buffer);
+  return std::string(buffer, size);
 }
 
 /// @brief Converts Decimal to a string with exactly `NewPrec` decimal digits
@@ -1396,6 +1461,9 @@ std::enable_if_t<formats::common::kIsFormatValue<Value>,
                  Decimal<Prec, RoundPolicy>>
 Parse(const Value& value, formats::parse::To<Decimal<Prec, RoundPolicy>>) {
   const std::string input = value.template As<std::string>();
+  if (const auto simple = impl::TryParseSimple<Prec, RoundPolicy>(input)) {
+    return *simple;
+  }
 
   const auto result = impl::Parse<Prec, RoundPolicy>(
       impl::StringCharSequence(std::string_view{input}),
@@ -1421,7 +1489,9 @@ TargetType Serialize(const Decimal<Prec, RoundPolicy>& object,
 template <int Prec, typename RoundPolicy, typename StringBuilder>
 void WriteToStream(const Decimal<Prec, RoundPolicy>& object,
                    StringBuilder& sw) {
-  WriteToStream(ToString(object), sw);
+  char buffer[impl::kToCharsMaxSize];
+  const auto size = impl::ToChars(object.AsUnbiased(), Prec, true, buffer);
+  WriteToStream(std::string_view{buffer, size}, sw);
 }
 
 }  // namespace decimal64
@@ -1480,6 +1550,13 @@ class fmt::formatter<USERVER_NAMESPACE::decimal64::Decimal<Prec, RoundPolicy>,
   auto format(
       const USERVER_NAMESPACE::decimal64::Decimal<Prec, RoundPolicy>& dec,
       FormatContext& ctx) const {
+    if (!custom_precision_) {
+      char buffer[USERVER_NAMESPACE::decimal64::impl::kToCharsMaxSize];
+      const auto size = USERVER_NAMESPACE::decimal64::impl::ToChars(
+          dec.AsUnbiased(), Prec, remove_trailing_zeros_, buffer);
+      return std::copy(buffer, buffer + size, ctx.out());
+    }
+
     int after_digits = custom_precision_.value_or(Prec);
     auto [before, after] =
         USERVER_NAMESPACE::decimal64::impl::AsUnpacked(dec, after_digits);
@@ -0,0 +1,71 @@
+#pragma once
+
+/// @file userver/formats/json/aggregate_fields.hpp
+/// @brief @copybrief formats::json::AggregateFields
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+#include <boost/pfr/core.hpp>
+#include <boost/pfr/tuple_size.hpp>
+
+#include <userver/utils/meta_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+/// @ingroup userver_universal userver_formats
+///
+/// @brief JSON names of the fields of an aggregate, in the order of
+/// declaration.
+///
+/// An aggregate with the names is serialized to JSON and parsed from JSON
+/// field by field, without writing the Parse, Serialize and WriteToStream
+/// functions by hand.
+///
+/// ## Example usage:
+///
+/// @snippet formats/json/aggregates_test.cpp  Sample formats::json::AggregateFields usage
+///
+/// @see @ref userver/formats/json/aggregates.hpp
+template <typename T>
+struct AggregateFields {};
+
+namespace impl {
+
+template <typename T>
+using AggregateFieldNames = decltype(AggregateFields<T>::kNames);
+
+template <typename T>
+constexpr bool IsReflectedAggregate() {
+  if constexpr (std::is_aggregate_v<T> &&
+                meta::kIsDetected<AggregateFieldNames, T>) {
+    static_assert(std::size(AggregateFields<T>::kNames) ==
+                      boost::pfr::tuple_size_v<T>,
+                  "formats::json::AggregateFields<T>::kNames must contain "
+                  "a name for each field of T");
+    return true;
+  } else {
+    return false;
+  }
+}
+
+template <typename T>
+inline constexpr bool kIsReflectedAggregate = IsReflectedAggregate<T>();
+
+template <typename T>
+inline constexpr std::size_t kAggregateSize = boost::pfr::tuple_size_v<T>;
+
+template <typename T, std::size_t Index>
+constexpr std::string_view GetFieldName() {
+  return AggregateFields<T>::kNames[Index];
+}
+
+}  // namespace impl
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
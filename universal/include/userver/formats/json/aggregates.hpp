@@ -0,0 +1,110 @@
+#pragma once
+
+/// @file userver/formats/json/aggregates.hpp
+/// @brief JSON serialization and parsing of the aggregates with
+/// formats::json::AggregateFields
+///
+/// @ingroup userver_universal userver_formats_parse userver_formats_serialize
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/formats/common/type.hpp>
+#include <userver/formats/json/aggregate_fields.hpp>
+#include <userver/formats/json/parser/aggregate_parser.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+#include <userver/formats/serialize/to.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+namespace impl {
+
+template <typename T, std::size_t... Indices>
+T ParseAggregateFields(const formats::json::Value& value,
+                       std::index_sequence<Indices...>) {
+  // `As`s are guaranteed to occur left-to-right in brace-init
+  return T{value[GetFieldName<T, Indices>()]
+               .template As<boost::pfr::tuple_element_t<Indices, T>>()...};
+}
+
+template <typename T, std::size_t... Indices>
+void SerializeAggregateFields(const T& value,
+                              formats::json::ValueBuilder& builder,
+                              std::index_sequence<Indices...>) {
+  ((builder[std::string{GetFieldName<T, Indices>()}] =
+        boost::pfr::get<Indices>(value)),
+   ...);
+}
+
+template <typename T, std::size_t... Indices>
+void WriteAggregateFields(const T& value, StringBuilder& sw,
+                          std::index_sequence<Indices...>) {
+  ((sw.Key(GetFieldName<T, Indices>()),
+    WriteToStream(boost::pfr::get<Indices>(value), sw)),
+   ...);
+}
+
+}  // namespace impl
+
+/// @brief Aggregates parsing from formats::json::Value.
+///
+/// All the fields except the std::optional ones are required.
+template <typename T>
+std::enable_if_t<impl::kIsReflectedAggregate<T>, T> Parse(const Value& value,
+                                                          parse::To<T>) {
+  value.CheckObject();
+  return impl::ParseAggregateFields<T>(
+      value, std::make_index_sequence<impl::kAggregateSize<T>>{});
+}
+
+/// @brief Aggregates serialization to formats::json::Value.
+template <typename T>
+std::enable_if_t<impl::kIsReflectedAggregate<T>, Value> Serialize(
+    const T& value, serialize::To<Value>) {
+  ValueBuilder builder{common::Type::kObject};
+  impl::SerializeAggregateFields(
+      value, builder, std::make_index_sequence<impl::kAggregateSize<T>>{});
+  return builder.ExtractValue();
+}
+
+/// @brief Aggregates SAX serialization, writes the fields directly to the
+/// StringBuilder.
+template <typename T>
+std::enable_if_t<impl::kIsReflectedAggregate<T>> WriteToStream(
+    const T& value, StringBuilder& sw) {
+  const StringBuilder::ObjectGuard guard{sw};
+  impl::WriteAggregateFields(
+      value, sw, std::make_index_sequence<impl::kAggregateSize<T>>{});
+}
+
+/// @brief Parses an aggregate, or a container of them, from JSON with
+/// parser::DefaultParser, without building a formats::json::Value.
+/// @throw parser::ParseError if the JSON is malformed or does not match T.
+template <typename T>
+T AggregateFromString(std::string_view json) {
+  return parser::ParseToType<T, parser::DefaultParser<T>>(json);
+}
+
+/// @brief Serializes an aggregate, or a container of them, to JSON with
+/// StringBuilder, without building a formats::json::Value.
+template <typename T>
+std::string AggregateToString(const T& value) {
+  StringBuilder sw;
+  WriteToStream(value, sw);
+  return sw.GetString();
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
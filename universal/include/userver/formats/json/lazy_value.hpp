@@ -0,0 +1,213 @@
+#pragma once
+
+/// @file userver/formats/json/lazy_value.hpp
+/// @brief @copybrief formats::json::LazyValue
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <userver/formats/common/path.hpp>
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+/// @ingroup userver_universal userver_containers userver_formats
+///
+/// @brief Read-only view of a JSON document that parses only the members
+/// it is asked for.
+///
+/// The document is kept as a string. Objects and arrays are indexed on the
+/// first access to their members: the index remembers where each member is,
+/// the member values themselves are not parsed. As() parses only the value
+/// it is called for, with all the `Parse()` customizations of
+/// formats::json::Value, so handlers that read a few fields of a big document
+/// do not build the whole tree.
+///
+/// Only the indexed parts of the document are checked for errors, the other
+/// parts are only skipped over. Each object or array is indexed once, the
+/// copies and the values returned by the member access share the document
+/// and the indexes, so they may be read from several threads at once.
+///
+/// ## Example usage:
+///
+/// @snippet formats/json/lazy_value_test.cpp  Sample formats::json::LazyValue usage
+class LazyValue final {
+ public:
+  using ParseException = formats::json::ParseException;
+
+  class const_iterator;
+
+  /// @brief Constructs a LazyValue that holds a null.
+  LazyValue();
+
+  /// @brief Takes the JSON document, only its outer structure is checked.
+  /// @throw ParseException if the document is empty or malformed.
+  explicit LazyValue(std::string json);
+
+  LazyValue(const LazyValue&);
+  LazyValue(LazyValue&&) noexcept;
+  LazyValue& operator=(const LazyValue&);
+  LazyValue& operator=(LazyValue&&) noexcept;
+  ~LazyValue();
+
+  /// @brief Access member by key for read, indexes the object on the first
+  /// call.
+  /// @throw TypeMismatchException if not a missing value, an object or null.
+  LazyValue operator[](std::string_view key) const;
+
+  /// @brief Access array member by index for read, indexes the array on the
+  /// first call.
+  /// @throw TypeMismatchException if not an array value.
+  /// @throw OutOfBoundsException if index is greater or equal than size.
+  LazyValue operator[](std::size_t index) const;
+
+  /// @brief Returns array size, object members count, or 0 for null.
+  /// @throw TypeMismatchException if not an array, object, or null.
+  std::size_t GetSize() const;
+
+  /// @brief Returns true if *this holds nothing.
+  bool IsMissing() const noexcept;
+  bool IsNull() const noexcept;
+  bool IsBool() const noexcept;
+  bool IsString() const noexcept;
+  bool IsArray() const noexcept;
+  bool IsObject() const noexcept;
+
+  /// @brief Returns an iterator to the first member of an object or array,
+  /// indexes it on the first call. Members of an object are iterated in the
+  /// document order.
+  /// @throw TypeMismatchException if not an array, object, or null.
+  const_iterator begin() const;
+
+  /// @brief Returns an iterator to the end of an object or array.
+  /// @throw TypeMismatchException if not an array, object, or null.
+  const_iterator end() const;
+
+  /// @brief Returns true if *this holds a `key`.
+  /// @throw TypeMismatchException if `*this` is not a map or null.
+  bool HasMember(std::string_view key) const;
+
+  /// @brief Returns value of *this converted to T, only *this is parsed.
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  /// @throw Anything derived from std::exception.
+  template <typename T>
+  T As() const;
+
+  /// @brief Returns value of *this converted to T or T(args) if
+  /// this->IsMissing() or this->IsNull().
+  template <typename T, typename First, typename... Rest>
+  T As(First&& default_arg, Rest&&... more_default_args) const;
+
+  /// @brief Returns value of *this converted to T or T() if this->IsMissing()
+  /// or this->IsNull().
+  template <typename T>
+  T As(Value::DefaultConstructed) const;
+
+  /// @brief Parses *this with all its members into a formats::json::Value.
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  /// @throw ParseException if the value is malformed.
+  Value Materialize() const;
+
+  /// @brief Returns the JSON text of *this without surrounding whitespace.
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  std::string_view GetRawJson() const;
+
+  /// @brief Returns full path to this value.
+  std::string GetPath() const;
+
+ private:
+  struct Index;
+
+  LazyValue(std::shared_ptr<const std::string> document, std::string_view json,
+            common::Path&& path, std::shared_ptr<Index> index) noexcept;
+
+  const Index& GetIndex() const;
+  std::size_t GetOffset(std::size_t pos) const noexcept;
+  void CheckNotMissing() const;
+  void CheckObjectOrNull() const;
+  [[noreturn]] void ThrowTypeMismatch(int expected) const;
+
+  std::shared_ptr<const std::string> document_;
+  // Points into `document_`, nullptr for the missing values
+  std::string_view json_;
+  common::Path path_;
+  // Not null for the objects and arrays, built on the first access
+  std::shared_ptr<Index> index_;
+};
+
+/// @brief Iterator over the members of a formats::json::LazyValue object or
+/// the elements of an array.
+class LazyValue::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = LazyValue;
+  using reference = const LazyValue&;
+  using pointer = const LazyValue*;
+
+  const_iterator(const const_iterator&);
+  const_iterator(const_iterator&&) noexcept;
+  const_iterator& operator=(const const_iterator&);
+  const_iterator& operator=(const_iterator&&) noexcept;
+  ~const_iterator();
+
+  const_iterator operator++(int);
+  const_iterator& operator++();
+  reference operator*() const;
+  pointer operator->() const;
+
+  bool operator==(const const_iterator& other) const noexcept;
+  bool operator!=(const const_iterator& other) const noexcept;
+
+  /// @brief Returns name of the referenced member
+  /// @throw TypeMismatchException if iterated value is not an object
+  std::string GetName() const;
+
+  /// @brief Returns index of the referenced element
+  /// @throw TypeMismatchException if iterated value is not an array
+  std::size_t GetIndex() const;
+
+ private:
+  friend class LazyValue;
+
+  const_iterator(LazyValue container, std::size_t pos) noexcept;
+
+  LazyValue container_;
+  std::size_t pos_;
+  // Temporary object replaced on every value access
+  mutable std::optional<LazyValue> current_;
+};
+
+template <typename T>
+T LazyValue::As() const {
+  CheckNotMissing();
+  return Materialize().As<T>();
+}
+
+template <typename T, typename First, typename... Rest>
+T LazyValue::As(First&& default_arg, Rest&&... more_default_args) const {
+  if (IsMissing() || IsNull()) {
+    // intended raw ctor call, sometimes casts
+    // NOLINTNEXTLINE(google-readability-casting)
+    return T(std::forward<First>(default_arg),
+             std::forward<Rest>(more_default_args)...);
+  }
+  return As<T>();
+}
+
+template <typename T>
+T LazyValue::As(Value::DefaultConstructed) const {
+  return (IsMissing() || IsNull()) ? T() : As<T>();
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
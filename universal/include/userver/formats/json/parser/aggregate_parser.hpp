@@ -0,0 +1,321 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/formats/json/aggregate_fields.hpp>
+#include <userver/formats/json/parser/array_parser.hpp>
+#include <userver/formats/json/parser/bool_parser.hpp>
+#include <userver/formats/json/parser/int_parser.hpp>
+#include <userver/formats/json/parser/map_parser.hpp>
+#include <userver/formats/json/parser/number_parser.hpp>
+#include <userver/formats/json/parser/parser_json.hpp>
+#include <userver/formats/json/parser/skip_parser.hpp>
+#include <userver/formats/json/parser/string_parser.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser {
+
+namespace impl {
+
+template <typename T, typename = void>
+struct DefaultParser {
+  static_assert(!sizeof(T),
+                "There is no SAX parser for the type. Use an aggregate with "
+                "formats::json::AggregateFields or write a parser");
+};
+
+}  // namespace impl
+
+/// SAX parser that is used for T by AggregateParser, VectorParser,
+/// OptionalParser and OwningMapParser
+template <typename T>
+using DefaultParser = typename impl::DefaultParser<T>::Type;
+
+/// Parser for null -> std::nullopt, other values are parsed by `Parser`
+template <typename T, typename Parser = DefaultParser<T>>
+class OptionalParser final : public TypedParser<std::optional<T>>,
+                             public Subscriber<T> {
+ public:
+  OptionalParser() { parser_.Subscribe(*this); }
+
+  OptionalParser(const OptionalParser&) = delete;
+  OptionalParser& operator=(const OptionalParser&) = delete;
+
+ protected:
+  void Null() override { this->SetResult(std::nullopt); }
+  void Bool(bool b) override { PushParser().Bool(b); }
+  void Int64(int64_t i) override { PushParser().Int64(i); }
+  void Uint64(uint64_t i) override { PushParser().Uint64(i); }
+  void Double(double d) override { PushParser().Double(d); }
+  void String(std::string_view sw) override { PushParser().String(sw); }
+  void StartObject() override { PushParser().StartObject(); }
+  void StartArray() override { PushParser().StartArray(); }
+
+  std::string Expected() const override { return "value or null"; }
+
+  std::string GetPathItem() const override { return {}; }
+
+ private:
+  BaseParser& PushParser() {
+    parser_.Reset();
+    this->parser_state_->PushParser(parser_.GetParser());
+    return parser_.GetParser();
+  }
+
+  void OnSend(T&& value) override {
+    this->SetResult(std::optional<T>{std::move(value)});
+  }
+
+  Parser parser_;
+};
+
+/// Proxy parser for array -> std::vector that owns the items parser
+template <typename Item>
+class VectorParser final {
+ public:
+  using ResultType = std::vector<Item>;
+
+  VectorParser() = default;
+  VectorParser(const VectorParser&) = delete;
+  VectorParser& operator=(const VectorParser&) = delete;
+
+  void Reset() { array_parser_.Reset(); }
+
+  void Subscribe(Subscriber<ResultType>& subscriber) {
+    array_parser_.Subscribe(subscriber);
+  }
+
+  auto& GetParser() { return array_parser_.GetParser(); }
+
+ private:
+  DefaultParser<Item> item_parser_;
+  ArrayParser<Item, DefaultParser<Item>> array_parser_{item_parser_};
+};
+
+/// Proxy parser for object -> map with std::string keys that owns the values
+/// parser
+template <typename Map>
+class OwningMapParser final {
+ public:
+  using ResultType = Map;
+
+  OwningMapParser() = default;
+  OwningMapParser(const OwningMapParser&) = delete;
+  OwningMapParser& operator=(const OwningMapParser&) = delete;
+
+  void Reset() { map_parser_.Reset(); }
+
+  void Subscribe(Subscriber<ResultType>& subscriber) {
+    map_parser_.Subscribe(subscriber);
+  }
+
+  auto& GetParser() { return map_parser_.GetParser(); }
+
+ private:
+  using ValueParser = DefaultParser<typename Map::mapped_type>;
+
+  ValueParser value_parser_;
+  MapParser<Map, ValueParser> map_parser_{value_parser_};
+};
+
+namespace impl {
+
+template <typename T, typename Indices>
+struct AggregateParserFields;
+
+template <typename T, std::size_t Index>
+using AggregateField = boost::pfr::tuple_element_t<Index, T>;
+
+template <typename T, std::size_t... Indices>
+struct AggregateParserFields<T, std::index_sequence<Indices...>> {
+  using Parsers =
+      std::tuple<parser::DefaultParser<AggregateField<T, Indices>>...>;
+  using Sinks = std::tuple<SubscriberSink<AggregateField<T, Indices>>...>;
+
+  static Sinks MakeSinks(T& result) {
+    return Sinks{boost::pfr::get<Indices>(result)...};
+  }
+
+  static constexpr std::array<bool, sizeof...(Indices)> kIsRequired{
+      !meta::kIsOptional<AggregateField<T, Indices>>...};
+};
+
+}  // namespace impl
+
+/// @brief SAX parser for aggregates with formats::json::AggregateFields
+///
+/// Fields are parsed by their DefaultParser, unknown fields are skipped.
+/// All the fields except the std::optional ones are required.
+template <typename T>
+class AggregateParser final : public TypedParser<T> {
+ public:
+  AggregateParser() { SubscribeFields(Indices{}); }
+
+  AggregateParser(const AggregateParser&) = delete;
+  AggregateParser& operator=(const AggregateParser&) = delete;
+
+  void Reset() override {
+    state_ = State::kStart;
+    result_ = T{};
+    seen_.reset();
+    key_.clear();
+  }
+
+ protected:
+  void StartObject() override {
+    if (state_ != State::kStart) this->Throw("object");
+    state_ = State::kInside;
+  }
+
+  void Key(std::string_view key) override {
+    key_ = key;
+
+    const auto& names = formats::json::AggregateFields<T>::kNames;
+    for (std::size_t i = 0; i < kSize; ++i) {
+      if (names[i] == key) {
+        seen_[i] = true;
+        PushFieldParser(i, Indices{});
+        return;
+      }
+    }
+
+    skip_parser_.Reset();
+    this->parser_state_->PushParser(skip_parser_);
+  }
+
+  void EndObject() override {
+    key_.clear();
+    for (std::size_t i = 0; i < kSize; ++i) {
+      if (Fields::kIsRequired[i] && !seen_[i]) {
+        throw InternalParseError(
+            "Missing required field '" +
+            std::string{formats::json::AggregateFields<T>::kNames[i]} + "'");
+      }
+    }
+    this->SetResult(std::move(result_));
+  }
+
+  std::string Expected() const override {
+    return state_ == State::kStart ? "object" : "field name or '}'";
+  }
+
+  std::string GetPathItem() const override { return key_; }
+
+ private:
+  static constexpr std::size_t kSize = formats::json::impl::kAggregateSize<T>;
+  using Indices = std::make_index_sequence<kSize>;
+  using Fields = impl::AggregateParserFields<T, Indices>;
+
+  template <std::size_t... I>
+  void SubscribeFields(std::index_sequence<I...>) {
+    (std::get<I>(parsers_).Subscribe(std::get<I>(sinks_)), ...);
+  }
+
+  template <std::size_t... I>
+  void PushFieldParser(std::size_t index, std::index_sequence<I...>) {
+    ((index == I && (PushParser(std::get<I>(parsers_)), true)) || ...);
+  }
+
+  template <typename Parser>
+  void PushParser(Parser& parser) {
+    parser.Reset();
+    this->parser_state_->PushParser(parser.GetParser());
+  }
+
+  enum class State {
+    kStart,
+    kInside,
+  };
+
+  State state_{State::kStart};
+  T result_{};
+  typename Fields::Parsers parsers_;
+  typename Fields::Sinks sinks_{Fields::MakeSinks(result_)};
+  SkipParser skip_parser_;
+  std::bitset<kSize> seen_;
+  std::string key_;
+};
+
+namespace impl {
+
+template <>
+struct DefaultParser<bool> {
+  using Type = BoolParser;
+};
+
+template <>
+struct DefaultParser<std::int32_t> {
+  using Type = Int32Parser;
+};
+
+template <>
+struct DefaultParser<std::int64_t> {
+  using Type = Int64Parser;
+};
+
+template <>
+struct DefaultParser<double> {
+  using Type = DoubleParser;
+};
+
+template <>
+struct DefaultParser<float> {
+  using Type = FloatParser;
+};
+
+template <>
+struct DefaultParser<std::string> {
+  using Type = StringParser;
+};
+
+template <>
+struct DefaultParser<formats::json::Value> {
+  using Type = JsonValueParser;
+};
+
+template <typename T>
+struct DefaultParser<std::optional<T>> {
+  using Type = OptionalParser<T>;
+};
+
+template <typename T>
+struct DefaultParser<std::vector<T>> {
+  using Type = VectorParser<T>;
+};
+
+template <typename Map, typename = void>
+inline constexpr bool kIsStringKeyMap = false;
+
+template <typename Map>
+inline constexpr bool
+    kIsStringKeyMap<Map, std::enable_if_t<meta::kIsUniqueMap<Map>>> =
+        std::is_same_v<typename Map::key_type, std::string>;
+
+template <typename Map>
+struct DefaultParser<Map, std::enable_if_t<kIsStringKeyMap<Map>>> {
+  using Type = OwningMapParser<Map>;
+};
+
+template <typename T>
+struct DefaultParser<
+    T, std::enable_if_t<formats::json::impl::kIsReflectedAggregate<T>>> {
+  using Type = AggregateParser<T>;
+};
+
+}  // namespace impl
+
+}  // namespace formats::json::parser
+
+USERVER_NAMESPACE_END
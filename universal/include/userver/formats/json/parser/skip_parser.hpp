@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+
+#include <userver/formats/json/parser/base_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser {
+
+/// SAX-parser that consumes any single JSON value and discards it
+class SkipParser final : public BaseParser {
+ public:
+  void Reset() { depth_ = 0; }
+
+  SkipParser& GetParser() { return *this; }
+
+ protected:
+  void Null() override;
+  void Bool(bool) override;
+  void Int64(int64_t) override;
+  void Uint64(uint64_t) override;
+  void Double(double) override;
+  void String(std::string_view) override;
+  void StartObject() override;
+  void Key(std::string_view key) override;
+  void EndObject() override;
+  void StartArray() override;
+  void EndArray() override;
+
+  std::string Expected() const override;
+
+  std::string GetPathItem() const override { return {}; }
+
+ private:
+  void MaybePopSelf();
+
+  std::size_t depth_{0};
+};
+
+}  // namespace formats::json::parser
+
+USERVER_NAMESPACE_END
@@ -158,6 +158,11 @@ class ValueBuilder final {
   /// @throw `TypeMismatchException` if not an array or null.
   void Resize(std::size_t size);
 
+  /// @brief Reserves the storage for `capacity` array elements or object
+  /// members, does nothing for a null value.
+  /// @throw `TypeMismatchException` if not an array, an object or null.
+  void Reserve(std::size_t capacity);
+
   /// @brief Add element into the last position of array.
   /// @throw `TypeMismatchException` if not an array or null.
   void PushBack(ValueBuilder&& bld);
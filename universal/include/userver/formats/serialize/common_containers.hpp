@@ -4,8 +4,11 @@
 /// @brief Serializers for standard containers and optional
 /// @ingroup userver_universal userver_formats_serialize
 
+#include <cstddef>
+#include <iterator>
 #include <optional>
 #include <type_traits>
+#include <utility>
 
 #include <userver/formats/common/type.hpp>
 #include <userver/formats/serialize/to.hpp>
@@ -24,6 +27,22 @@ struct StrongTypedefTag;
 /// Common serializers
 namespace formats::serialize {
 
+namespace impl {
+
+template <typename Builder>
+using HasReserve =
+    decltype(std::declval<Builder&>().Reserve(std::declval<std::size_t>()));
+
+template <typename Builder, typename T>
+void ReserveIfPossible(Builder& builder, const T& container) {
+  if constexpr (meta::kIsSizable<const T&> &&
+                meta::kIsDetected<HasReserve, Builder>) {
+    builder.Reserve(std::size(container));
+  }
+}
+
+}  // namespace impl
+
 /// Common containers serialization (vector/set)
 template <typename T, typename Value>
 std::enable_if_t<meta::kIsRange<T> && !meta::kIsMap<T> &&
@@ -33,6 +52,7 @@ std::enable_if_t<meta::kIsRange<T> && !meta::kIsMap<T> &&
                  Value>
 Serialize(const T& value, To<Value>) {
   typename Value::Builder builder(formats::common::Type::kArray);
+  impl::ReserveIfPossible(builder, value);
   for (const auto& item : value) {
     // explicit cast for vector<bool> shenanigans
     builder.PushBack(static_cast<const meta::RangeValueType<T>&>(item));
@@ -45,6 +65,7 @@ template <typename T, typename Value>
 std::enable_if_t<meta::kIsUniqueMap<T>, Value> Serialize(const T& value,
                                                          To<Value>) {
   typename Value::Builder builder(formats::common::Type::kObject);
+  impl::ReserveIfPossible(builder, value);
   for (const auto& [key, value] : value) {
     builder[key] = value;
   }
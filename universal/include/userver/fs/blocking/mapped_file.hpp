@@ -0,0 +1,60 @@
+#pragma once
+
+/// @file userver/fs/blocking/mapped_file.hpp
+/// @brief @copybrief fs::blocking::MappedFile
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <userver/fs/blocking/file_descriptor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::blocking {
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief A read-only memory mapping of a whole file
+/// @details The file descriptor is kept open along with the mapping, so the
+/// contents could be passed to the kernel without copying, e.g. via sendfile.
+/// The mapping and the file are closed in the destructor.
+/// @warning The mapping reflects the in-place modifications of the file.
+/// Accessing the memory past the end of a file that was truncated after
+/// mapping terminates the process with SIGBUS. Replace the files atomically
+/// (e.g. via rename) instead of overwriting them.
+class MappedFile final {
+ public:
+  /// @brief Open a file and map its contents into memory
+  /// @throws std::runtime_error
+  static MappedFile Open(const std::string& path);
+
+  MappedFile() = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  ~MappedFile();
+
+  /// Returns the mapped contents of the file
+  std::string_view GetView() const noexcept {
+    return {static_cast<const char*>(data_), size_};
+  }
+
+  /// Returns the file size at the moment of mapping
+  std::size_t GetSize() const noexcept { return size_; }
+
+  /// Returns the native file handle
+  int GetNative() const { return fd_.GetNative(); }
+
+ private:
+  MappedFile(FileDescriptor fd, void* data, std::size_t size) noexcept;
+
+  void Unmap() noexcept;
+
+  FileDescriptor fd_;
+  void* data_;
+  std::size_t size_;
+};
+
+}  // namespace fs::blocking
+
+USERVER_NAMESPACE_END
@@ -6,9 +6,11 @@
 
 #include <functional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include <userver/utils/function_ref.hpp>
 #include <userver/utils/str_icase.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -18,6 +20,10 @@ namespace http::parser {
 /// Strict URL decoder that throws std::runtime_error on bad input
 std::string UrlDecode(std::string_view url);
 
+/// Strict URL decoder that throws std::runtime_error on bad input, writes the
+/// result to `out` reusing its capacity
+void UrlDecode(std::string_view url, std::string& out);
+
 void ParseArgs(std::string_view args,
                std::unordered_map<std::string, std::vector<std::string>,
                                   utils::StrCaseHash>& result);
@@ -27,6 +33,15 @@ using ArgsConsumer =
 
 void ParseAndConsumeArgs(std::string_view args, ArgsConsumer handler);
 
+/// The key and the value are valid only during the call. They point into
+/// `args` if they need no decoding.
+using ArgViewsConsumer =
+    utils::function_ref<void(std::string_view key, std::string_view value)>;
+
+/// @brief Same as ParseAndConsumeArgs, but allocates only for the arguments
+/// that are percent-encoded, reusing the buffers between them.
+void ParseAndConsumeArgViews(std::string_view args, ArgViewsConsumer handler);
+
 }  // namespace http::parser
 
 USERVER_NAMESPACE_END
@@ -4,10 +4,12 @@
 /// @brief URL manipulation functions
 /// @ingroup userver_universal
 
+#include <initializer_list>
 #include <map>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 
 #include <userver/utils/impl/internal_tag_fwd.hpp>
 #include <userver/utils/str_icase.hpp>
@@ -23,6 +25,9 @@ UrlDecode(std::string_view range);
 /// @brief Encode as URL
 std::string UrlEncode(std::string_view input_string);
 
+/// @brief Encode as URL into `out`, reusing its capacity
+void UrlEncode(std::string_view input_string, std::string& out);
+
 using Args = std::unordered_map<std::string, std::string, utils::StrCaseHash>;
 using MultiArgs = std::multimap<std::string, std::string>;
 
@@ -38,6 +43,12 @@ std::string MakeQuery(
     std::initializer_list<std::pair<std::string_view, std::string_view>>
         query_args);
 
+/// @brief Make an URL query into `out`, reusing its capacity
+void MakeQuery(
+    std::initializer_list<std::pair<std::string_view, std::string_view>>
+        query_args,
+    std::string& out);
+
 /// @brief Make an URL with query arguments
 std::string MakeUrl(std::string_view path, const Args& query_args);
 
@@ -56,6 +67,13 @@ std::string MakeUrl(
     std::initializer_list<std::pair<std::string_view, std::string_view>>
         query_args);
 
+/// @brief Make an URL with query arguments into `out`, reusing its capacity
+void MakeUrl(
+    std::string_view path,
+    std::initializer_list<std::pair<std::string_view, std::string_view>>
+        query_args,
+    std::string& out);
+
 /// @brief Returns URL part before the first '?' character
 std::string ExtractMetaTypeFromUrl(const std::string& url);
 
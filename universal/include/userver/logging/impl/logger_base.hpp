@@ -26,6 +26,11 @@ class LoggerBase {
 
   virtual void Log(Level level, std::string_view msg) = 0;
 
+  /// @brief Logs a record written by LogHelper with the deferred formatting.
+  /// @details The default implementation formats the record and calls Log().
+  /// @see SetFormattingDeferred
+  virtual void LogDeferred(Level level, std::string_view record);
+
   virtual void Flush();
 
   virtual void PrependCommonTags(TagWriter writer) const;
@@ -39,6 +44,12 @@ class LoggerBase {
   void SetFlushOn(Level level);
   bool ShouldFlush(Level level) const;
 
+  /// @brief If set, LogHelper only copies the tags into a compact record on
+  /// the logging thread and the record is escaped and formatted in
+  /// LogDeferred().
+  void SetFormattingDeferred(bool is_deferred) noexcept;
+  bool IsFormattingDeferred() const noexcept;
+
  protected:
   virtual bool DoShouldLog(Level level) const noexcept;
 
@@ -46,6 +57,7 @@ class LoggerBase {
   const Format format_;
   std::atomic<Level> level_{Level::kNone};
   std::atomic<Level> flush_level_{Level::kWarning};
+  std::atomic<bool> is_formatting_deferred_{false};
 };
 
 bool ShouldLogNoSpan(const LoggerBase& logger, Level level) noexcept;
@@ -0,0 +1,110 @@
+#pragma once
+
+/// @file userver/utils/blocked_bloom_filter.hpp
+/// @brief @copybrief utils::BlockedBloomFilter
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Bloom filter for negative lookups: MayContain(item) is false only
+/// if the item was definitely not added.
+///
+/// The filter is split into cache line sized blocks, and all the bits of an
+/// item are in a single block, one bit per 64-bit word of the block. A lookup
+/// touches one cache line, and the probing of the 8 words is branchless, so
+/// that the compilers vectorize it. With 12 bits per item the false positive
+/// rate is about 1%.
+///
+/// Not thread-safe for Add; build the filter once, e.g. on each full update
+/// of a cache, and share it for reads.
+template <typename T, typename Hash = std::hash<T>>
+class BlockedBloomFilter final {
+ public:
+  static constexpr std::size_t kDefaultBitsPerItem = 12;
+
+  /// @brief Constructs a filter for up to `expected_items` items
+  explicit BlockedBloomFilter(std::size_t expected_items,
+                              std::size_t bits_per_item = kDefaultBitsPerItem,
+                              Hash hash = Hash{})
+      : blocks_(std::max<std::size_t>(
+            1, (expected_items * bits_per_item + kBlockBits - 1) / kBlockBits)),
+        hash_(std::move(hash)) {}
+
+  void Add(const T& item) {
+    const auto hash = Mix(hash_(item));
+    auto& block = blocks_[hash % blocks_.size()];
+    const auto mask = MakeMask(static_cast<std::uint32_t>(hash));
+    for (std::size_t i = 0; i < kWords; ++i) block.words[i] |= mask[i];
+  }
+
+  /// @returns false if the item was definitely not added, true if it
+  /// probably was
+  bool MayContain(const T& item) const {
+    const auto hash = Mix(hash_(item));
+    const auto& block = blocks_[hash % blocks_.size()];
+    const auto mask = MakeMask(static_cast<std::uint32_t>(hash));
+    bool result = true;
+    for (std::size_t i = 0; i < kWords; ++i) {
+      result &= (block.words[i] & mask[i]) == mask[i];
+    }
+    return result;
+  }
+
+  void Clear() noexcept {
+    for (auto& block : blocks_) block.words.fill(0);
+  }
+
+  /// @returns the memory used by the bits of the filter
+  std::size_t GetSizeBytes() const noexcept {
+    return blocks_.size() * sizeof(Block);
+  }
+
+ private:
+  static constexpr std::size_t kWords = 8;
+  static constexpr std::size_t kBlockBits = kWords * 64;
+
+  struct alignas(64) Block final {
+    std::array<std::uint64_t, kWords> words{};
+  };
+
+  using Mask = std::array<std::uint64_t, kWords>;
+
+  // Spreads the bits of identity-like hashes, e.g. std::hash<int>
+  static std::uint64_t Mix(std::size_t hash) noexcept {
+    auto mixed = static_cast<std::uint64_t>(hash);
+    mixed ^= mixed >> 33;
+    mixed *= 0xFF51AFD7ED558CCDULL;
+    mixed ^= mixed >> 33;
+    return mixed;
+  }
+
+  // A bit per word, see "Split Block Bloom Filters" of Apache Parquet
+  static Mask MakeMask(std::uint32_t hash) noexcept {
+    static constexpr std::array<std::uint32_t, kWords> kSalts{
+        0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+        0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+    Mask mask{};
+    for (std::size_t i = 0; i < kWords; ++i) {
+      mask[i] = std::uint64_t{1} << ((hash * kSalts[i]) >> 26);
+    }
+    return mask;
+  }
+
+  std::vector<Block> blocks_;
+  Hash hash_;
+};
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
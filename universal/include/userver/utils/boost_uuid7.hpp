@@ -0,0 +1,22 @@
+#pragma once
+
+/// @file userver/utils/boost_uuid7.hpp
+/// @brief @copybrief utils::generators::GenerateBoostUuidV7()
+
+#include <boost/uuid/uuid.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::generators {
+
+/// @brief Generates a time-ordered UUID version 7 (RFC 9562): the first 48
+/// bits are the Unix timestamp in milliseconds, the rest are random.
+///
+/// The UUIDs generated in different milliseconds sort in the order of their
+/// generation, which keeps the B-tree indexes compact when used as database
+/// primary keys. Within a millisecond the order is random.
+boost::uuids::uuid GenerateBoostUuidV7();
+
+}  // namespace utils::generators
+
+USERVER_NAMESPACE_END
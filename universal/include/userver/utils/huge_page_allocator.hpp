@@ -0,0 +1,95 @@
+#pragma once
+
+/// @file userver/utils/huge_page_allocator.hpp
+/// @brief @copybrief utils::HugePageAllocator
+
+#include <cstddef>
+#include <memory>  // std::allocator
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace impl {
+
+inline constexpr std::size_t kHugePageSize = 2 * 1024 * 1024;
+
+// Maps a huge page aligned region of at least `bytes` and advises the kernel
+// to back it with transparent huge pages. Throws std::bad_alloc on failure.
+void* AllocateHugePages(std::size_t bytes);
+
+// Unmaps a region previously returned by AllocateHugePages(bytes)
+void DeallocateHugePages(void* ptr, std::size_t bytes) noexcept;
+
+// Advises the kernel to back the huge page aligned parts of the region with
+// transparent huge pages. Does nothing on platforms without THP.
+void AdviseHugePages(void* ptr, std::size_t bytes) noexcept;
+
+}  // namespace impl
+
+// clang-format off
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Allocator for bulk storage of big long-living data, e.g. values of
+/// caches::CachingComponentBase.
+///
+/// Allocations of at least 2MiB are mmap-ed at a 2MiB boundary and advised
+/// with MADV_HUGEPAGE, so that the kernel backs them with transparent huge
+/// pages even if THP is configured in `madvise` mode. This reduces TLB misses
+/// on lookups in big caches. Smaller allocations are forwarded to
+/// std::allocator.
+///
+/// Each big allocation is rounded up to a multiple of 2MiB, so the allocator
+/// fits containers that are filled once and then only read, e.g. a
+/// std::vector that is reserve()-d before the cache update:
+///
+/// @snippet src/utils/huge_page_allocator_test.cpp  Sample HugePageAllocator
+///
+/// The effect on RSS could be monitored via the `with-huge-pages` option of
+/// components::SystemStatisticsCollector.
+
+// clang-format on
+
+template <typename T>
+class HugePageAllocator {
+ public:
+  using value_type = T;
+
+  HugePageAllocator() noexcept = default;
+
+  template <typename U>
+  HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    if (!IsHuge(n)) return std::allocator<T>{}.allocate(n);
+    return static_cast<T*>(impl::AllocateHugePages(n * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    if (!IsHuge(n)) return std::allocator<T>{}.deallocate(ptr, n);
+    impl::DeallocateHugePages(ptr, n * sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const HugePageAllocator<U>&) const noexcept {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const HugePageAllocator<U>&) const noexcept {
+    return false;
+  }
+
+ private:
+  static_assert(alignof(T) <= impl::kHugePageSize,
+                "Over-aligned types are not supported");
+
+  static constexpr bool IsHuge(std::size_t n) noexcept {
+    return n >= impl::kHugePageSize / sizeof(T);
+  }
+};
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <random>
 
@@ -40,6 +41,13 @@ namespace impl {
 /// @warning Don't pass the returned `Random` across thread boundaries
 RandomBase& DefaultRandomForHashSeed();
 
+/// @brief Fills `size` bytes at `dst` with random data from a thread-local
+/// 64-bit generator, without a virtual call and a distribution per 32 bits
+/// as with DefaultRandom(). Used for the identifiers, e.g. UUIDs and span
+/// ids.
+/// @note The random data is not cryptographically secure
+void FillRandomBytes(void* dst, std::size_t size) noexcept;
+
 }  // namespace impl
 
 /// @brief Generates a random number in range [from, to)
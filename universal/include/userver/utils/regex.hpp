@@ -3,7 +3,11 @@
 /// @file userver/utils/regex.hpp
 /// @brief @copybrief utils::regex
 
+#include <cstddef>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <userver/utils/fast_pimpl.hpp>
 
@@ -35,6 +39,51 @@ class regex final {
   friend bool regex_search(std::string_view str, const regex& pattern);
 };
 
+/// @brief Returns the compiled regular expression for the pattern from a
+/// process-wide cache of the recently used patterns.
+///
+/// Use it for the patterns that are built at runtime, e.g. from configs, to
+/// avoid compiling the same pattern on every use. Copies of utils::regex
+/// share the compiled pattern, so the result is cheap to store.
+regex GetCachedRegex(std::string_view pattern);
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief A set of regular expressions that are matched against a string in a
+/// single pass, e.g. for routing or filtering.
+///
+/// The patterns are combined into a single regular expression, so that the
+/// common prefixes are not rescanned for each of them.
+///
+/// @warning Backreferences by number (e.g. `\1`) in the patterns are not
+/// supported, as the numbering of the groups changes in the combined regular
+/// expression.
+class RegexSet final {
+ public:
+  /// @throws std::runtime_error if any of the patterns is invalid
+  explicit RegexSet(const std::vector<std::string>& patterns);
+
+  ~RegexSet();
+
+  RegexSet(const RegexSet&);
+  RegexSet(RegexSet&&) noexcept;
+
+  RegexSet& operator=(const RegexSet&);
+  RegexSet& operator=(RegexSet&&) noexcept;
+
+  /// @returns the index of the first pattern (in the order of the
+  /// constructor arguments) that matches the entire `str`, std::nullopt if
+  /// none does.
+  std::optional<std::size_t> FindFirstMatch(std::string_view str) const;
+
+  /// @returns the count of the patterns in the set
+  std::size_t Size() const noexcept;
+
+ private:
+  struct Impl;
+  utils::FastPimpl<Impl, 40, 8> impl_;
+};
+
 /// @brief Determines whether the regular expression matches the entire target
 /// character sequence
 bool regex_match(std::string_view str, const regex& pattern);
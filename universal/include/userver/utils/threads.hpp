@@ -4,6 +4,10 @@
 /// @brief Functions to work with OS threads.
 /// @ingroup userver_universal
 
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils {
@@ -19,6 +23,25 @@ void SetCurrentThreadIdleScheduling();
 /// @throws std::system_error
 void SetCurrentThreadLowPriorityScheduling();
 
+/// @brief Restrict the OS thread to run only on the specified CPUs
+/// @throws std::system_error, std::runtime_error if not supported by the OS
+void SetCurrentThreadAffinity(const std::vector<std::size_t>& cpus);
+
+/// @brief Returns the sorted list of CPUs the OS thread is allowed to run on
+/// @throws std::system_error, std::runtime_error if not supported by the OS
+std::vector<std::size_t> GetCurrentThreadAffinity();
+
+/// @brief Parse a CPU list in the Linux `cpulist` format, e.g. "0-3,8,10-11".
+/// @returns sorted list of CPUs without duplicates
+/// @throws std::runtime_error on invalid input
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list);
+
+/// @brief Returns CPUs that belong to the NUMA node `node`
+/// @note Does blocking file IO, use only at startup
+/// @throws std::runtime_error if the node does not exist or the platform does
+/// not support NUMA
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t node);
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
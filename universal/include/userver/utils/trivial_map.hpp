@@ -3,10 +3,13 @@
 /// @file userver/utils/trivial_map.hpp
 /// @brief Bidirectional map|sets over string literals or other trivial types.
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -368,28 +371,33 @@ class SwitchTypesDetector final {
   }
 };
 
+// Counts the Case statements in the type, so that the count is usable as an
+// array size
+template <std::size_t Count>
 class CaseCounter final {
  public:
+  static constexpr std::size_t kCount = Count;
+
   template <typename First, typename Second>
-  constexpr CaseCounter& Case(First, Second) noexcept {
-    ++count_;
-    return *this;
+  constexpr CaseCounter<Count + 1> Case(First, Second) const noexcept {
+    return {};
   }
 
   template <typename First>
-  constexpr CaseCounter& Case(First) noexcept {
-    ++count_;
-    return *this;
-  }
-
-  [[nodiscard]] constexpr std::size_t Extract() const noexcept {
-    return count_;
+  constexpr CaseCounter<Count + 1> Case(First) const noexcept {
+    return {};
   }
+};
 
- private:
-  std::size_t count_{0};
+class CaseCounterSelector final {
+ public:
+  constexpr CaseCounter<0> operator()() const noexcept { return {}; }
 };
 
+template <typename BuilderFunc>
+inline constexpr std::size_t kCasesCount =
+    std::invoke_result_t<const BuilderFunc&, CaseCounterSelector>::kCount;
+
 class CaseDescriber final {
  public:
   template <typename First, typename Second>
@@ -458,6 +466,194 @@ class CaseSecondDescriber final {
   std::string description_{};
 };
 
+// The case insensitive lookups are a chain of comparisons that the compilers
+// do not turn into a switch. Maps with that many Case statements get a hash
+// index for them.
+inline constexpr std::size_t kMinCasesForIndex = 32;
+
+inline constexpr std::size_t kNotFound = kInvalidSize;
+
+constexpr std::uint64_t ToLowerAscii(char c) noexcept {
+  return static_cast<unsigned char>(('A' <= c && c <= 'Z') ? c - 'A' + 'a'
+                                                           : c);
+}
+
+// Hashes the length and a few ASCII lowercased chars. Hashing all the chars is
+// a long dependency chain that takes longer than the rest of the lookup.
+constexpr std::uint64_t HashICase(std::string_view value) noexcept {
+  const auto size = value.size();
+  if (size == 0) return 0;
+
+  const auto hash = (size ^ (ToLowerAscii(value[0]) << 8) ^
+                     (ToLowerAscii(value[size / 2]) << 16) ^
+                     (ToLowerAscii(value[size - 1 - (size > 1)]) << 24) ^
+                     (ToLowerAscii(value[size - 1]) << 32)) *
+                    0x9E3779B97F4A7C15ULL;
+  return hash ^ (hash >> 29);
+}
+
+template <typename First, typename Second, std::size_t Size>
+class CaseCollector final {
+ public:
+  using SecondStorage =
+      std::conditional_t<std::is_void_v<Second>, bool, Second>;
+
+  constexpr CaseCollector& Case(First first, SecondStorage second) noexcept {
+    firsts[count_] = first;
+    seconds[count_] = second;
+    ++count_;
+    return *this;
+  }
+
+  constexpr CaseCollector& Case(First first) noexcept {
+    firsts[count_] = first;
+    ++count_;
+    return *this;
+  }
+
+  std::array<First, Size> firsts{};
+  std::array<SecondStorage, Size> seconds{};
+
+ private:
+  std::size_t count_{0};
+};
+
+template <typename First, typename Second, std::size_t Size>
+class CaseCollectorSelector final {
+ public:
+  constexpr CaseCollector<First, Second, Size> operator()() const noexcept {
+    return {};
+  }
+};
+
+// Open addressing hash table with linear probing over the positions of Case
+// statements, built at compile time. The first Case wins for duplicate keys,
+// just like in a chain of Case statements.
+template <typename First, typename Second, std::size_t Size>
+class CaseIndex final {
+  using Cases = CaseCollector<First, Second, Size>;
+  using SecondStorage = typename Cases::SecondStorage;
+
+ public:
+  template <typename BuilderFunc>
+  constexpr explicit CaseIndex(const BuilderFunc& func) noexcept
+      : cases_(func(CaseCollectorSelector<First, Second, Size>{})),
+        first_slots_(MakeSlots(cases_.firsts)),
+        second_slots_(MakeSlots(cases_.seconds)) {}
+
+  // Returns the position of the Case or kNotFound
+  constexpr std::size_t FindFirstICase(std::string_view key) const noexcept {
+    return FindICase(first_slots_, cases_.firsts, key);
+  }
+
+  // Returns the position of the Case or kNotFound
+  constexpr std::size_t FindSecondICase(std::string_view key) const noexcept {
+    return FindICase(second_slots_, cases_.seconds, key);
+  }
+
+  constexpr First GetFirst(std::size_t pos) const noexcept {
+    return cases_.firsts[pos];
+  }
+
+  constexpr SecondStorage GetSecond(std::size_t pos) const noexcept {
+    return cases_.seconds[pos];
+  }
+
+ private:
+  static constexpr std::size_t MakeCapacity() noexcept {
+    std::size_t capacity = 1;
+    while (capacity < Size * 2) capacity *= 2;
+    return capacity;
+  }
+
+  static constexpr std::size_t kCapacity = MakeCapacity();
+  static constexpr std::size_t kMask = kCapacity - 1;
+  static constexpr std::uint16_t kEmptySlot =
+      std::numeric_limits<std::uint16_t>::max();
+  static_assert(Size < kEmptySlot, "Too many Case statements");
+
+  // Only the std::string_view side is indexed
+  template <typename Key>
+  using Slots =
+      std::array<std::uint16_t,
+                 std::is_same_v<Key, std::string_view> ? kCapacity : 0>;
+
+  static constexpr std::size_t GetStartPos(std::string_view key) noexcept {
+    return static_cast<std::size_t>(HashICase(key)) & kMask;
+  }
+
+  template <typename Key>
+  static constexpr Slots<Key> MakeSlots(
+      const std::array<Key, Size>& keys) noexcept {
+    Slots<Key> slots{};
+    if constexpr (std::is_same_v<Key, std::string_view>) {
+      for (auto& slot : slots) slot = kEmptySlot;
+      for (std::size_t i = 0; i < Size; ++i) {
+        auto pos = GetStartPos(keys[i]);
+        while (slots[pos] != kEmptySlot && keys[slots[pos]] != keys[i]) {
+          pos = (pos + 1) & kMask;
+        }
+        if (slots[pos] == kEmptySlot) {
+          slots[pos] = static_cast<std::uint16_t>(i);
+        }
+      }
+    }
+    return slots;
+  }
+
+  static constexpr std::size_t FindICase(
+      const Slots<std::string_view>& slots,
+      const std::array<std::string_view, Size>& keys,
+      std::string_view key) noexcept {
+    // The table is at most half full, there is always an empty slot
+    for (auto pos = GetStartPos(key);; pos = (pos + 1) & kMask) {
+      const auto slot = slots[pos];
+      if (slot == kEmptySlot) return kNotFound;
+      const auto lowercase = keys[slot];
+      if (lowercase.size() == key.size() &&
+          ICaseEqualLowercase(lowercase, key)) {
+        return slot;
+      }
+    }
+  }
+
+  const Cases cases_;
+  const Slots<First> first_slots_;
+  const Slots<SecondStorage> second_slots_;
+};
+
+class NoCaseIndex final {
+ public:
+  template <typename BuilderFunc>
+  constexpr explicit NoCaseIndex(const BuilderFunc& /*func*/) noexcept {}
+};
+
+template <typename First, typename Second, std::size_t Size>
+inline constexpr bool kHasCaseIndex =
+    Size >= kMinCasesForIndex &&
+    (std::is_same_v<First, std::string_view> ||
+     std::is_same_v<Second, std::string_view>) &&
+    std::is_default_constructible_v<First> &&
+    (std::is_void_v<Second> || std::is_default_constructible_v<Second>);
+
+template <typename First, typename Second, std::size_t Size>
+using CaseIndexFor = std::conditional_t<kHasCaseIndex<First, Second, Size>,
+                                        CaseIndex<First, Second, Size>,
+                                        NoCaseIndex>;
+
+template <typename Selector>
+struct CaseChain final {
+  // An lvalue reference for the selectors that return *this from Case
+  Selector selector;
+
+  template <typename Key, typename Value>
+  constexpr auto operator|(std::tuple<const Key&, const Value&> args) && {
+    using Result =
+        decltype(selector.Case(std::get<0>(args), std::get<1>(args)));
+    return CaseChain<Result>{
+        selector.Case(std::get<0>(args), std::get<1>(args))};
+  }
+};
 }  // namespace impl
 
 /// @ingroup userver_universal userver_containers
@@ -477,6 +673,11 @@ class CaseSecondDescriber final {
 /// length and an integral comparison (rather than a std::memcmp call). In other
 /// words, it usually takes O(1) to find the match in the map.
 ///
+/// Case insensitive search is a chain of comparisons, so maps and sets with 32
+/// or more Case statements build a hash table of the string literals at
+/// compile time for it. Such maps are not empty objects, pass them by
+/// reference.
+///
 /// The same story with integral or enum mappings - compiler optimizes them
 /// into a switch and it usually takes O(1) to find the match.
 ///
@@ -498,7 +699,8 @@ class TrivialBiMap final {
   using MappedTypeFor =
       std::conditional_t<std::is_convertible_v<T, First>, Second, First>;
 
-  constexpr TrivialBiMap(BuilderFunc&& func) noexcept : func_(std::move(func)) {
+  constexpr TrivialBiMap(BuilderFunc&& func) noexcept
+      : func_(std::move(func)), index_(func_) {
     static_assert(std::is_empty_v<BuilderFunc>,
                   "Mapping function should not capture variables");
     static_assert(std::is_trivially_copyable_v<First>,
@@ -541,8 +743,13 @@ class TrivialBiMap final {
   /// string literal.
   constexpr std::optional<Second> TryFindICaseByFirst(
       std::string_view value) const noexcept {
-    return func_([value]() { return impl::SwitchByFirstICase<Second>{value}; })
-        .Extract();
+    if constexpr (kIsFirstIndexed) {
+      return GetSecondAt(index_.FindFirstICase(value));
+    } else {
+      return func_(
+                 [value]() { return impl::SwitchByFirstICase<Second>{value}; })
+          .Extract();
+    }
   }
 
   /// @brief Case insensitive search for value.
@@ -551,8 +758,13 @@ class TrivialBiMap final {
   /// string literal.
   constexpr std::optional<First> TryFindICaseBySecond(
       std::string_view value) const noexcept {
-    return func_([value]() { return impl::SwitchBySecondICase<First>{value}; })
-        .Extract();
+    if constexpr (kIsSecondIndexed) {
+      return GetFirstAt(index_.FindSecondICase(value));
+    } else {
+      return func_(
+                 [value]() { return impl::SwitchBySecondICase<First>{value}; })
+          .Extract();
+    }
   }
 
   /// @brief Case insensitive search for value that calls either
@@ -573,7 +785,7 @@ class TrivialBiMap final {
 
   /// Returns count of Case's in mapping
   constexpr std::size_t size() const noexcept {
-    return func_([]() { return impl::CaseCounter{}; }).Extract();
+    return impl::kCasesCount<BuilderFunc>;
   }
 
   /// Returns a string of comma separated quoted values of Case parameters.
@@ -621,7 +833,28 @@ class TrivialBiMap final {
   }
 
  private:
+  using Index =
+      impl::CaseIndexFor<First, Second, impl::kCasesCount<BuilderFunc>>;
+
+  static constexpr bool kIsFirstIndexed =
+      !std::is_same_v<Index, impl::NoCaseIndex> &&
+      std::is_same_v<First, std::string_view>;
+  static constexpr bool kIsSecondIndexed =
+      !std::is_same_v<Index, impl::NoCaseIndex> &&
+      std::is_same_v<Second, std::string_view>;
+
+  constexpr std::optional<First> GetFirstAt(std::size_t pos) const noexcept {
+    if (pos == impl::kNotFound) return std::nullopt;
+    return index_.GetFirst(pos);
+  }
+
+  constexpr std::optional<Second> GetSecondAt(std::size_t pos) const noexcept {
+    if (pos == impl::kNotFound) return std::nullopt;
+    return index_.GetSecond(pos);
+  }
+
   const BuilderFunc func_;
+  const Index index_;
 };
 
 template <typename BuilderFunc>
@@ -642,7 +875,8 @@ class TrivialSet final {
   using First = typename TypesPair::first_type;
   using Second = typename TypesPair::second_type;
 
-  constexpr TrivialSet(BuilderFunc&& func) noexcept : func_(std::move(func)) {
+  constexpr TrivialSet(BuilderFunc&& func) noexcept
+      : func_(std::move(func)), index_(func_) {
     static_assert(std::is_empty_v<BuilderFunc>,
                   "Mapping function should not capture variables");
     static_assert(std::is_trivially_copyable_v<First>,
@@ -661,12 +895,16 @@ class TrivialSet final {
     static_assert(std::is_convertible_v<First, std::string_view>,
                   "ContainsICase works only with std::string_view");
 
-    return func_([value]() { return impl::SwitchByFirstICase<void>{value}; })
-        .Extract();
+    if constexpr (kIsIndexed) {
+      return index_.FindFirstICase(value) != impl::kNotFound;
+    } else {
+      return func_([value]() { return impl::SwitchByFirstICase<void>{value}; })
+          .Extract();
+    }
   }
 
   constexpr std::size_t size() const noexcept {
-    return func_([]() { return impl::CaseCounter{}; }).Extract();
+    return impl::kCasesCount<BuilderFunc>;
   }
 
   /// Returns a string of comma separated quoted values of Case parameters.
@@ -679,7 +917,13 @@ class TrivialSet final {
   }
 
  private:
+  using Index =
+      impl::CaseIndexFor<First, Second, impl::kCasesCount<BuilderFunc>>;
+
+  static constexpr bool kIsIndexed = !std::is_same_v<Index, impl::NoCaseIndex>;
+
   const BuilderFunc func_;
+  const Index index_;
 };
 
 template <typename BuilderFunc>
@@ -691,7 +935,8 @@ TrivialSet(BuilderFunc) -> TrivialSet<BuilderFunc>;
 /// string, or if `value` is not contained in `map`.
 /// @see @ref scripts/docs/en/userver/formats.md
 template <typename ExceptionType = void, typename Value, typename BuilderFunc>
-auto ParseFromValueString(const Value& value, TrivialBiMap<BuilderFunc> map) {
+auto ParseFromValueString(const Value& value,
+                          const TrivialBiMap<BuilderFunc>& map) {
   if constexpr (!std::is_void_v<ExceptionType>) {
     if (!value.IsString()) {
       throw ExceptionType(fmt::format(
@@ -719,7 +964,8 @@ namespace impl {
 // contained in `map`, then crashes the service in Debug builds, or throws
 // utils::InvariantError in Release builds.
 template <typename Enum, typename BuilderFunc>
-std::string_view EnumToStringView(Enum value, TrivialBiMap<BuilderFunc> map) {
+std::string_view EnumToStringView(Enum value,
+                                  const TrivialBiMap<BuilderFunc>& map) {
   static_assert(std::is_enum_v<Enum>);
   if (const auto string = map.TryFind(value)) return *string;
 
@@ -733,12 +979,12 @@ template <typename Selector, typename Keys, typename Values,
           std::size_t... Indices>
 constexpr auto TrivialBiMapMultiCase(Selector selector, const Keys& keys,
                                      const Values& values,
-                                     std::index_sequence<0, Indices...>) {
-  auto selector2 = selector.Case(std::data(keys)[0], std::data(values)[0]);
-  ((selector2 =
-        selector2.Case(std::data(keys)[Indices], std::data(values)[Indices])),
-   ...);
-  return selector2;
+                                     std::index_sequence<Indices...>) {
+  // Case may return a new selector type, e.g. impl::CaseCounter
+  return (CaseChain<Selector&>{selector} | ... |
+          std::forward_as_tuple(std::data(keys)[Indices],
+                                std::data(values)[Indices]))
+      .selector;
 }
 
 }  // namespace impl
@@ -0,0 +1,20 @@
+#pragma once
+
+/// @file userver/utils/uuid7.hpp
+/// @brief @copybrief utils::generators::GenerateUuidV7
+/// @ingroup userver_universal
+
+#include <string>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::generators {
+
+/// @brief Generate a time-ordered UUID version 7 string in the same format
+/// as utils::generators::GenerateUuid()
+/// @see utils::generators::GenerateBoostUuidV7()
+std::string GenerateUuidV7();
+
+}  // namespace utils::generators
+
+USERVER_NAMESPACE_END
@@ -62,8 +62,8 @@ class Iterator final {
   // Pointer to the 'container' yaml - because substitution parsing
   // only works with container[index/key] statements
   const value_type* container_{nullptr};
-  // Iterator over container. We actually only use its GetIndex/GetName
-  // members
+  // Iterator over container. We only use its GetIndex/GetName members and
+  // the object members it points to
   YamlIterator it_;
   mutable std::optional<value_type> current_;
 };
@@ -185,6 +185,12 @@ class YamlConfig {
   const_iterator end() const;
 
  private:
+  friend class Iterator<IterTraits>;
+
+  // Applies the substitutions to the already found `value` of member `key`
+  YamlConfig MakeMember(std::string_view key,
+                        formats::yaml::Value value) const;
+
   formats::yaml::Value yaml_;
   formats::yaml::Value config_vars_;
   Mode mode_{Mode::kSecure};
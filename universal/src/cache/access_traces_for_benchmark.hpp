@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::bench {
+
+// Keys drawn from the Zipf distribution with the exponent `skew`: key 0 is
+// the most popular one. The traces are generated with a fixed seed to keep
+// the hit ratios comparable between runs.
+inline std::vector<unsigned> MakeZipfTrace(std::size_t length,
+                                           unsigned keys_count,
+                                           double skew = 0.99) {
+  std::vector<double> cdf(keys_count);
+  double sum = 0;
+  for (unsigned i = 0; i < keys_count; ++i) {
+    sum += 1.0 / std::pow(i + 1, skew);
+    cdf[i] = sum;
+  }
+  for (auto& value : cdf) value /= sum;
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::vector<unsigned> trace(length);
+  for (auto& key : trace) {
+    const auto it =
+        std::lower_bound(cdf.begin(), cdf.end(), distribution(generator));
+    key = static_cast<unsigned>(
+        std::min<std::size_t>(it - cdf.begin(), keys_count - 1));
+  }
+  return trace;
+}
+
+// Zipf trace interleaved with sequential scans of the one-off keys, each
+// `scan_period` accesses a scan of `scan_length` unique keys is inserted.
+inline std::vector<unsigned> MakeScanMixedTrace(std::size_t length,
+                                                unsigned keys_count,
+                                                std::size_t scan_period,
+                                                std::size_t scan_length) {
+  const auto zipf = MakeZipfTrace(length, keys_count);
+  std::vector<unsigned> trace;
+  trace.reserve(length + length / scan_period * scan_length);
+
+  unsigned scan_key = keys_count;
+  for (std::size_t i = 0; i < zipf.size(); ++i) {
+    if (i % scan_period == 0) {
+      for (std::size_t j = 0; j < scan_length; ++j) trace.push_back(++scan_key);
+    }
+    trace.push_back(zipf[i]);
+  }
+  return trace;
+}
+
+// Replays the trace with get-or-put accesses, reports the number of accesses
+// per second and the share of the hits
+template <typename Cache, typename Get, typename Put>
+void RunTrace(benchmark::State& state, Cache& cache,
+              const std::vector<unsigned>& trace, Get get, Put put) {
+  std::size_t hits = 0;
+  std::size_t accesses = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto key : trace) {
+      if (get(cache, key)) {
+        ++hits;
+      } else {
+        put(cache, key);
+      }
+    }
+    accesses += trace.size();
+  }
+
+  state.SetItemsProcessed(accesses);
+  state.counters["hit_ratio"] =
+      accesses ? static_cast<double>(hits) / accesses : 0.0;
+}
+
+}  // namespace cache::bench
+
+USERVER_NAMESPACE_END
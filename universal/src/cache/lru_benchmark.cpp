@@ -1,7 +1,10 @@
 #include <benchmark/benchmark.h>
 
+#include <userver/cache/lru_map.hpp>
 #include <userver/cache/lru_set.hpp>
 
+#include "access_traces_for_benchmark.hpp"
+
 USERVER_NAMESPACE_BEGIN
 
 namespace {
@@ -51,4 +54,40 @@ void LruPutOverflow(benchmark::State& state) {
 }
 BENCHMARK(LruPutOverflow);
 
+namespace {
+
+constexpr std::size_t kTraceLength = 100'000;
+constexpr unsigned kTraceKeysCount = 10 * kElementsCount;
+
+template <cache::CachePolicy Policy>
+void RunLruMapTrace(benchmark::State& state,
+                    const std::vector<unsigned>& trace) {
+  cache::LruMap<unsigned, unsigned, std::hash<unsigned>,
+                std::equal_to<unsigned>, Policy>
+      map(kElementsCount);
+  cache::bench::RunTrace(
+      state, map, trace, [](auto& map, unsigned key) { return map.Get(key); },
+      [](auto& map, unsigned key) { map.Put(key, key); });
+}
+
+}  // namespace
+
+template <cache::CachePolicy Policy>
+void LruMapZipf(benchmark::State& state) {
+  const auto trace =
+      cache::bench::MakeZipfTrace(kTraceLength, kTraceKeysCount);
+  RunLruMapTrace<Policy>(state, trace);
+}
+BENCHMARK_TEMPLATE(LruMapZipf, cache::CachePolicy::kLru);
+BENCHMARK_TEMPLATE(LruMapZipf, cache::CachePolicy::kWTinyLfu);
+
+template <cache::CachePolicy Policy>
+void LruMapScanMixed(benchmark::State& state) {
+  const auto trace = cache::bench::MakeScanMixedTrace(
+      kTraceLength, kTraceKeysCount, kElementsCount, 2 * kElementsCount);
+  RunLruMapTrace<Policy>(state, trace);
+}
+BENCHMARK_TEMPLATE(LruMapScanMixed, cache::CachePolicy::kLru);
+BENCHMARK_TEMPLATE(LruMapScanMixed, cache::CachePolicy::kWTinyLfu);
+
 USERVER_NAMESPACE_END
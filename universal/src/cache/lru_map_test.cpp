@@ -213,4 +213,25 @@ TEST(Lru, NotMovable) {
   EXPECT_EQ(cache.GetLeastUsed()->value, 4);
 }
 
+TEST(Lru, VisitEvictionCandidate) {
+  cache::LruMap<int, int> cache{2};
+  int visits = 0;
+  const auto visitor = [&visits](int key, int) {
+    EXPECT_EQ(key, 2);
+    ++visits;
+  };
+
+  cache.Put(1, 1);
+  cache.VisitEvictionCandidate(visitor);
+  EXPECT_EQ(visits, 0);
+
+  cache.Put(2, 2);
+  cache.Get(1);
+  cache.VisitEvictionCandidate(visitor);
+  EXPECT_EQ(visits, 1);
+
+  cache.Put(3, 3);
+  EXPECT_FALSE(cache.Get(2));
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,39 @@
+#include <userver/cache/size_of.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(ApproximateSizeOf, Trivial) {
+  EXPECT_EQ(cache::ApproximateSizeOf(42), sizeof(int));
+  EXPECT_EQ(cache::ApproximateSizeOf(std::optional<int>{}),
+            sizeof(std::optional<int>));
+}
+
+TEST(ApproximateSizeOf, String) {
+  EXPECT_EQ(cache::ApproximateSizeOf(std::string{"short"}),
+            sizeof(std::string));
+
+  const std::string long_string(1000, 'a');
+  EXPECT_GT(cache::ApproximateSizeOf(long_string),
+            sizeof(std::string) + long_string.size());
+}
+
+TEST(ApproximateSizeOf, Containers) {
+  const std::vector<std::string> strings(10, std::string(100, 'a'));
+  EXPECT_GE(cache::ApproximateSizeOf(strings),
+            sizeof(strings) + 10 * (sizeof(std::string) + 100));
+
+  const auto pointer = std::make_shared<std::vector<int>>(100);
+  EXPECT_EQ(cache::ApproximateSizeOf(pointer),
+            sizeof(pointer) + sizeof(std::vector<int>) + 100 * sizeof(int));
+  EXPECT_EQ(cache::ApproximateSizeOf(std::shared_ptr<int>{}),
+            sizeof(std::shared_ptr<int>));
+}
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,9 @@
 #include <benchmark/benchmark.h>
 
 #include <userver/cache/impl/slru.hpp>
+#include <userver/cache/impl/tiny_lfu.hpp>
+
+#include "access_traces_for_benchmark.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -81,4 +84,49 @@ void SlruPutOverflow(benchmark::State& state) {
 }
 BENCHMARK(SlruPutOverflow);
 
+namespace {
+
+using WTinyLfu = cache::impl::WTinyLfuBase<unsigned, unsigned>;
+
+constexpr std::size_t kTraceLength = 100'000;
+constexpr unsigned kTraceKeysCount = 10 * kElementsCount;
+
+const auto kGet = [](auto& cache, unsigned key) { return cache.Get(key); };
+const auto kPut = [](auto& cache, unsigned key) { cache.Put(key, key); };
+
+std::vector<unsigned> MakeScanMixedTrace() {
+  return cache::bench::MakeScanMixedTrace(kTraceLength, kTraceKeysCount,
+                                          kElementsCount, 2 * kElementsCount);
+}
+
+}  // namespace
+
+void SlruZipf(benchmark::State& state) {
+  Slru slru(kProbationPart, kProtectedPart);
+  const auto trace =
+      cache::bench::MakeZipfTrace(kTraceLength, kTraceKeysCount);
+  cache::bench::RunTrace(state, slru, trace, kGet, kPut);
+}
+BENCHMARK(SlruZipf);
+
+void WTinyLfuZipf(benchmark::State& state) {
+  WTinyLfu cache(kElementsCount);
+  const auto trace =
+      cache::bench::MakeZipfTrace(kTraceLength, kTraceKeysCount);
+  cache::bench::RunTrace(state, cache, trace, kGet, kPut);
+}
+BENCHMARK(WTinyLfuZipf);
+
+void SlruScanMixed(benchmark::State& state) {
+  Slru slru(kProbationPart, kProtectedPart);
+  cache::bench::RunTrace(state, slru, MakeScanMixedTrace(), kGet, kPut);
+}
+BENCHMARK(SlruScanMixed);
+
+void WTinyLfuScanMixed(benchmark::State& state) {
+  WTinyLfu cache(kElementsCount);
+  cache::bench::RunTrace(state, cache, MakeScanMixedTrace(), kGet, kPut);
+}
+BENCHMARK(WTinyLfuScanMixed);
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,122 @@
+#include <userver/cache/impl/tiny_lfu.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/lru_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using WTinyLfu = cache::impl::WTinyLfuBase<std::size_t, std::size_t>;
+
+}  // namespace
+
+TEST(FrequencySketch, Estimate) {
+  cache::impl::FrequencySketch<std::size_t> sketch(100);
+  EXPECT_EQ(sketch.Estimate(1), 0);
+
+  for (int i = 0; i < 5; ++i) sketch.Increment(1);
+  sketch.Increment(2);
+
+  EXPECT_GE(sketch.Estimate(1), 5);
+  EXPECT_GE(sketch.Estimate(2), 1);
+  EXPECT_LT(sketch.Estimate(2), sketch.Estimate(1));
+
+  sketch.Clear();
+  EXPECT_EQ(sketch.Estimate(1), 0);
+}
+
+TEST(FrequencySketch, Saturation) {
+  cache::impl::FrequencySketch<std::size_t> sketch(100);
+  for (int i = 0; i < 100; ++i) sketch.Increment(1);
+  EXPECT_EQ(sketch.Estimate(1),
+            cache::impl::FrequencySketch<std::size_t>::kMaxFrequency);
+}
+
+TEST(FrequencySketch, Aging) {
+  constexpr std::size_t kCapacity = 10;
+  cache::impl::FrequencySketch<std::size_t> sketch(kCapacity);
+  for (int i = 0; i < 8; ++i) sketch.Increment(1);
+  const auto before = sketch.Estimate(1);
+
+  // Other keys fill the sample, then all the counters are halved
+  for (std::size_t i = 0; i < kCapacity * 10; ++i) sketch.Increment(i + 100);
+  EXPECT_LT(sketch.Estimate(1), before);
+}
+
+TEST(WTinyLfuBase, PutGet) {
+  cache::impl::WTinyLfuBase<std::string, int> cache(10);
+  EXPECT_TRUE(cache.Put("a", 1));
+  EXPECT_FALSE(cache.Put("a", 2));
+  EXPECT_TRUE(cache.Put("b", 3));
+
+  ASSERT_TRUE(cache.Get("a"));
+  EXPECT_EQ(*cache.Get("a"), 2);
+  EXPECT_EQ(cache.GetSize(), 2);
+
+  cache.Erase("a");
+  EXPECT_FALSE(cache.Get("a"));
+  EXPECT_EQ(*cache.Emplace("c", 4), 4);
+  EXPECT_EQ(*cache.Emplace("c", 5), 4);
+
+  cache.Clear();
+  EXPECT_EQ(cache.GetSize(), 0);
+}
+
+TEST(WTinyLfuBase, Capacity) {
+  WTinyLfu cache(100);
+  EXPECT_EQ(cache.GetCapacity(), 100);
+
+  for (std::size_t i = 0; i < 1000; ++i) cache.Put(i, i);
+  EXPECT_LE(cache.GetSize(), 100);
+
+  cache.SetMaxSize(10);
+  EXPECT_LE(cache.GetSize(), cache.GetCapacity());
+  EXPECT_LE(cache.GetCapacity(), 10);
+
+  std::size_t visited = 0;
+  cache.VisitAll([&visited](std::size_t key, std::size_t value) {
+    EXPECT_EQ(key, value);
+    ++visited;
+  });
+  EXPECT_EQ(visited, cache.GetSize());
+}
+
+TEST(WTinyLfuBase, ScanResistance) {
+  constexpr std::size_t kCapacity = 100;
+  constexpr std::size_t kHotKeys = 50;
+  WTinyLfu cache(kCapacity);
+
+  for (int round = 0; round < 5; ++round) {
+    for (std::size_t i = 0; i < kHotKeys; ++i) {
+      if (!cache.Get(i)) cache.Put(i, i);
+    }
+  }
+
+  // One-off keys pass through the window without evicting the hot keys
+  for (std::size_t i = 0; i < kCapacity * 5; ++i) {
+    cache.Put(kHotKeys + i, i);
+  }
+
+  std::size_t hits = 0;
+  for (std::size_t i = 0; i < kHotKeys; ++i) {
+    if (cache.Get(i)) ++hits;
+  }
+  EXPECT_GE(hits, kHotKeys * 9 / 10);
+}
+
+TEST(LruMap, WTinyLfuPolicy) {
+  cache::LruMap<int, int, std::hash<int>, std::equal_to<int>,
+                cache::CachePolicy::kWTinyLfu>
+      map(10);
+  for (int i = 0; i < 100; ++i) map.Put(i, i);
+  EXPECT_LE(map.GetSize(), 10);
+  EXPECT_TRUE(map.Put(1000, 1));
+  EXPECT_EQ(*map.Get(1000), 1);
+}
+
+USERVER_NAMESPACE_END
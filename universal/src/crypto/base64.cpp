@@ -1,5 +1,14 @@
 #include <userver/crypto/base64.hpp>
 
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
 #include <cryptopp/base64.h>
 
 #include <userver/crypto/exception.hpp>
@@ -14,25 +23,207 @@ namespace crypto::base64 {
 
 namespace {
 
-template <typename Base64Encoder>
-std::string Base64Encode(std::string_view data, Pad pad) {
-  std::string response;
-  try {
-    Base64Encoder encoder(new CryptoPP::StringSink(response));
-    CryptoPP::AlgorithmParameters params =
-        CryptoPP::MakeParameters(CryptoPP::Name::Pad(), Pad::kWith == pad)(
-            CryptoPP::Name::InsertLineBreaks(), false);
-    encoder.IsolatedInitialize(params);
-    encoder.PutMessageEnd(reinterpret_cast<const byte*>(data.data()),
-                          data.size());
-  } catch (const CryptoPP::Exception& exc) {
-    throw crypto::CryptoException(exc.what());
+constexpr std::string_view kStandardChars =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr std::string_view kUrlChars =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+using DecodingTable = std::array<std::int8_t, 256>;
+
+constexpr DecodingTable MakeDecodingTable(std::string_view chars) {
+  DecodingTable table{};
+  for (auto& value : table) value = -1;
+  for (std::size_t i = 0; i < chars.size(); ++i) {
+    table[static_cast<unsigned char>(chars[i])] = static_cast<std::int8_t>(i);
   }
-  return response;
+  return table;
+}
+
+constexpr DecodingTable kStandardTable = MakeDecodingTable(kStandardChars);
+constexpr DecodingTable kUrlTable = MakeDecodingTable(kUrlChars);
+
+struct Alphabet final {
+  std::string_view chars;
+  const DecodingTable& table;
+  bool is_url;
+};
+
+constexpr Alphabet kStandard{kStandardChars, kStandardTable, false};
+constexpr Alphabet kUrl{kUrlChars, kUrlTable, true};
+
+#ifdef __SSSE3__
+// The kernels follow http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html
+// and http://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html
+
+// Encodes the first 12 bytes of the block into 16 chars
+__m128i EncodeBlock(__m128i block, bool is_url) {
+  block = _mm_shuffle_epi8(
+      block, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+  // Spread each 3 bytes into 4 bytes of 6 bits
+  const auto t0 = _mm_and_si128(block, _mm_set1_epi32(0x0fc0fc00));
+  const auto t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const auto t2 = _mm_and_si128(block, _mm_set1_epi32(0x003f03f0));
+  const auto t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  const auto indices = _mm_or_si128(t1, t3);
+
+  // 0 for [26, 51], 1..10 for the digits, 11 and 12 for the last two chars,
+  // 13 for the capital letters
+  const auto is_capital = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  const auto reduced =
+      _mm_or_si128(_mm_subs_epu8(indices, _mm_set1_epi8(51)),
+                   _mm_and_si128(is_capital, _mm_set1_epi8(13)));
+
+  const auto digit = static_cast<char>('0' - 52);
+  const auto shifts = _mm_setr_epi8(
+      'a' - 26, digit, digit, digit, digit, digit, digit, digit, digit, digit,
+      digit, static_cast<char>((is_url ? '-' : '+') - 62),
+      static_cast<char>((is_url ? '_' : '/') - 63), 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(shifts, reduced), indices);
+}
+
+__m128i InRange(__m128i block, char first, char last) {
+  return _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(first - 1)),
+                       _mm_cmpgt_epi8(_mm_set1_epi8(last + 1), block));
+}
+
+// Decodes 16 chars into the first 12 bytes of `result`. Returns false if some
+// of the chars are not in the alphabet.
+bool DecodeBlock(__m128i block, bool is_url, __m128i& result) {
+  const auto capital = InRange(block, 'A', 'Z');
+  const auto small = InRange(block, 'a', 'z');
+  const auto digit = InRange(block, '0', '9');
+  const char char62 = is_url ? '-' : '+';
+  const char char63 = is_url ? '_' : '/';
+  const auto is_62 = _mm_cmpeq_epi8(block, _mm_set1_epi8(char62));
+  const auto is_63 = _mm_cmpeq_epi8(block, _mm_set1_epi8(char63));
+
+  const auto valid =
+      _mm_or_si128(_mm_or_si128(capital, small),
+                   _mm_or_si128(digit, _mm_or_si128(is_62, is_63)));
+  if (_mm_movemask_epi8(valid) != 0xffff) return false;
+
+  const auto letters_shift =
+      _mm_or_si128(_mm_and_si128(capital, _mm_set1_epi8(-'A')),
+                   _mm_and_si128(small, _mm_set1_epi8(26 - 'a')));
+  const auto others_shift = _mm_or_si128(
+      _mm_and_si128(digit, _mm_set1_epi8(52 - '0')),
+      _mm_or_si128(_mm_and_si128(is_62, _mm_set1_epi8(62 - char62)),
+                   _mm_and_si128(is_63, _mm_set1_epi8(63 - char63))));
+  const auto values =
+      _mm_add_epi8(block, _mm_or_si128(letters_shift, others_shift));
+
+  // Glue 4 values of 6 bits into 3 bytes
+  const auto pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const auto quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  result = _mm_shuffle_epi8(quads, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                                 14, 13, 12, -1, -1, -1, -1));
+  return true;
+}
+#endif
+
+std::string Encode(std::string_view data, Pad pad, const Alphabet& alphabet) {
+  const auto* const src = reinterpret_cast<const unsigned char*>(data.data());
+  const auto chars = alphabet.chars;
+
+  std::string result;
+  result.resize((data.size() + 2) / 3 * 4);
+  char* dst = result.data();
+  std::size_t i = 0;
+
+#ifdef __SSSE3__
+  // A block is read as 16 bytes, only 12 of them are encoded
+  for (; data.size() - i >= 16; i += 12, dst += 16) {
+    const auto block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                     EncodeBlock(block, alphabet.is_url));
+  }
+#endif
+
+  for (; data.size() - i >= 3; i += 3) {
+    const std::uint32_t triple =
+        (src[i] << 16) | (src[i + 1] << 8) | src[i + 2];
+    *dst++ = chars[(triple >> 18) & 0x3f];
+    *dst++ = chars[(triple >> 12) & 0x3f];
+    *dst++ = chars[(triple >> 6) & 0x3f];
+    *dst++ = chars[triple & 0x3f];
+  }
+
+  const auto rest = data.size() - i;
+  if (rest == 0) return result;
+
+  const std::uint32_t triple =
+      (src[i] << 16) | (rest == 2 ? src[i + 1] << 8 : 0);
+  *dst++ = chars[(triple >> 18) & 0x3f];
+  *dst++ = chars[(triple >> 12) & 0x3f];
+  if (rest == 2) *dst++ = chars[(triple >> 6) & 0x3f];
+
+  if (pad == Pad::kWith) {
+    while (dst != result.data() + result.size()) *dst++ = '=';
+  } else {
+    result.resize(dst - result.data());
+  }
+  return result;
+}
+
+// Handles the well-formed input only: the chars of the alphabet followed by
+// optional padding. The rest is left to CryptoPP, which skips the unknown
+// chars.
+std::optional<std::string> TryDecodeStrict(std::string_view data,
+                                           const Alphabet& alphabet) {
+  while (!data.empty() && data.back() == '=') data.remove_suffix(1);
+
+  const auto* const src = reinterpret_cast<const unsigned char*>(data.data());
+  const auto& table = alphabet.table;
+
+  std::string result;
+  // The vectorized stores write 4 bytes past the decoded ones
+  result.resize(data.size() / 4 * 3 + 4);
+  char* dst = result.data();
+  std::size_t i = 0;
+
+#ifdef __SSSE3__
+  for (; data.size() - i >= 16; i += 16, dst += 12) {
+    const auto block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i decoded;
+    if (!DecodeBlock(block, alphabet.is_url, decoded)) return std::nullopt;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), decoded);
+  }
+#endif
+
+  std::uint32_t quad = 0;
+  std::size_t count = 0;
+  for (; i < data.size(); ++i) {
+    const auto value = table[src[i]];
+    if (value < 0) return std::nullopt;
+    quad = (quad << 6) | static_cast<std::uint32_t>(value);
+    if (++count == 4) {
+      *dst++ = static_cast<char>(quad >> 16);
+      *dst++ = static_cast<char>(quad >> 8);
+      *dst++ = static_cast<char>(quad);
+      quad = 0;
+      count = 0;
+    }
+  }
+
+  // The bits that do not form a whole byte are dropped
+  if (count == 2) {
+    *dst++ = static_cast<char>(quad >> 4);
+  } else if (count == 3) {
+    *dst++ = static_cast<char>(quad >> 10);
+    *dst++ = static_cast<char>(quad >> 2);
+  }
+
+  result.resize(dst - result.data());
+  return result;
 }
 
 template <typename Base64Decoder>
-std::string Base64Decode(std::string_view data) {
+std::string Base64Decode(std::string_view data, const Alphabet& alphabet) {
+  if (auto result = TryDecodeStrict(data, alphabet)) return std::move(*result);
+
   std::string response;
   try {
     Base64Decoder decoder(new CryptoPP::StringSink(response));
@@ -47,20 +238,20 @@ std::string Base64Decode(std::string_view data) {
 }  // namespace
 
 std::string Base64Encode(std::string_view data, Pad pad) {
-  return Base64Encode<CryptoPP::Base64Encoder>(data, pad);
+  return Encode(data, pad, kStandard);
 }
 
 std::string Base64Decode(std::string_view data) {
-  return Base64Decode<CryptoPP::Base64Decoder>(data);
+  return Base64Decode<CryptoPP::Base64Decoder>(data, kStandard);
 }
 
 #ifndef USERVER_NO_CRYPTOPP_BASE64_URL
 std::string Base64UrlEncode(std::string_view data, Pad pad) {
-  return Base64Encode<CryptoPP::Base64URLEncoder>(data, pad);
+  return Encode(data, pad, kUrl);
 }
 
 std::string Base64UrlDecode(std::string_view data) {
-  return Base64Decode<CryptoPP::Base64URLDecoder>(data);
+  return Base64Decode<CryptoPP::Base64URLDecoder>(data, kUrl);
 }
 #endif
 
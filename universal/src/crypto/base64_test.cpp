@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include <userver/crypto/base64.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -17,6 +19,27 @@ TEST(Crypto, Base64) {
   EXPECT_EQ("U/8=", crypto::base64::Base64Encode("S\xff"));
 }
 
+TEST(Crypto, Base64Long) {
+  std::string data;
+  for (int i = 0; i < 100; ++i) {
+    const auto encoded = crypto::base64::Base64Encode(data);
+    EXPECT_EQ(encoded.size(), (data.size() + 2) / 3 * 4);
+    EXPECT_EQ(data, crypto::base64::Base64Decode(encoded));
+    data += static_cast<char>(i * 37);
+  }
+
+  constexpr std::string_view kText = "The quick brown fox jumps over the dog";
+  constexpr std::string_view kEncoded =
+      "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBkb2c=";
+  EXPECT_EQ(kEncoded, crypto::base64::Base64Encode(kText));
+  EXPECT_EQ(kText, crypto::base64::Base64Decode(kEncoded));
+
+  // the unknown chars are skipped
+  EXPECT_EQ(kText, crypto::base64::Base64Decode("VGhlIHF1aWNrIGJy\n"
+                                                "b3duIGZveCBqdW1wcyBvdmVy\n"
+                                                "IHRoZSBkb2c="));
+}
+
 #ifndef USERVER_NO_CRYPTOPP_BASE64_URL
 TEST(Crypto, Base64Url) {
   EXPECT_EQ("U_8=", crypto::base64::Base64UrlEncode("S\xff"));
@@ -24,6 +47,11 @@ TEST(Crypto, Base64Url) {
                        "S\xff", crypto::base64::Pad::kWithout));
   EXPECT_EQ("S\xFF", crypto::base64::Base64UrlDecode("U_8"));
   EXPECT_EQ("S\xFF", crypto::base64::Base64UrlDecode("U_8="));
+
+  const std::string data(100, '\xff');
+  const auto encoded = crypto::base64::Base64UrlEncode(data);
+  EXPECT_EQ(std::string(132, '_') + "_w==", encoded);
+  EXPECT_EQ(data, crypto::base64::Base64UrlDecode(encoded));
 }
 #endif
 
@@ -94,6 +94,20 @@ EvpMdCtx::~EvpMdCtx() {
 EvpMdCtx::EvpMdCtx(EvpMdCtx&& other) noexcept
     : ctx_(std::exchange(other.ctx_, nullptr)) {}
 
+std::shared_ptr<EVP_MD_CTX> MakeSharedEvpMdCtx() {
+  auto ctx = std::make_shared<EvpMdCtx>();
+  return {ctx, ctx->Get()};
+}
+
+EVP_MD_CTX* CopyToThreadLocalEvpMdCtx(const EVP_MD_CTX* prototype) {
+  thread_local EvpMdCtx ctx;
+  if (1 != EVP_MD_CTX_copy_ex(ctx.Get(), prototype)) {
+    throw CryptoException(
+        FormatSslError("Failed to copy the context: EVP_MD_CTX_copy_ex"));
+  }
+  return ctx.Get();
+}
+
 decltype(&crypto::hash::HmacSha256) GetHmacFuncByEnum(DigestSize bits) {
   switch (bits) {
     case DigestSize::k160:
@@ -30,6 +30,14 @@ class EvpMdCtx {
   EVP_MD_CTX* ctx_;
 };
 
+std::shared_ptr<EVP_MD_CTX> MakeSharedEvpMdCtx();
+
+/// Copies the initialized `prototype` into the context of the current thread.
+/// The copy is cheaper than EVP_DigestSignInit/EVP_DigestVerifyInit with the
+/// key checks and the padding setup. The result is valid until the next call
+/// on this thread, it must not be used across the context switches.
+EVP_MD_CTX* CopyToThreadLocalEvpMdCtx(const EVP_MD_CTX* prototype);
+
 constexpr size_t GetDigestLength(DigestSize digest_size) {
   size_t bits = 0;
   switch (digest_size) {
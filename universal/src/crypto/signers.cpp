@@ -170,14 +170,10 @@ DsaSigner<type, bits>::DsaSigner(const std::string& key,
       throw SignError("Non-RSA key supplied for " + Name() + " signer");
     }
   }
-}
 
-template <DsaType type, DigestSize bits>
-std::string DsaSigner<type, bits>::Sign(
-    std::initializer_list<std::string_view> data) const {
-  EvpMdCtx ctx;
+  ctx_ = MakeSharedEvpMdCtx();
   EVP_PKEY_CTX* pkey_ctx = nullptr;  // non-owning
-  if (1 != EVP_DigestSignInit(ctx.Get(), &pkey_ctx, GetShaMdByEnum(bits),
+  if (1 != EVP_DigestSignInit(ctx_.get(), &pkey_ctx, GetShaMdByEnum(bits),
                               nullptr, pkey_.GetNative())) {
     throw SignError(FormatSslError("Failed to sign: EVP_DigestSignInit"));
   }
@@ -185,22 +181,27 @@ std::string DsaSigner<type, bits>::Sign(
   if constexpr (type == DsaType::kRsaPss) {
     SetupJwaRsaPssPadding(pkey_ctx, bits);
   }
+}
 
+template <DsaType type, DigestSize bits>
+std::string DsaSigner<type, bits>::Sign(
+    std::initializer_list<std::string_view> data) const {
+  auto* const ctx = CopyToThreadLocalEvpMdCtx(ctx_.get());
   for (const auto& part : data) {
-    if (1 != EVP_DigestSignUpdate(ctx.Get(), part.data(), part.size())) {
+    if (1 != EVP_DigestSignUpdate(ctx, part.data(), part.size())) {
       throw SignError(FormatSslError("Failed to sign: EVP_DigestSignUpdate"));
     }
   }
 
   size_t siglen = 0;
-  if (1 != EVP_DigestSignFinal(ctx.Get(), nullptr, &siglen)) {
+  if (1 != EVP_DigestSignFinal(ctx, nullptr, &siglen)) {
     throw SignError(
         FormatSslError("Failed to sign: EVP_DigestSignFinal (size check)"));
   }
 
   std::string signature(siglen, '\0');
   if (1 != EVP_DigestSignFinal(
-               ctx.Get(), reinterpret_cast<unsigned char*>(signature.data()),
+               ctx, reinterpret_cast<unsigned char*>(signature.data()),
                &siglen)) {
     throw SignError(FormatSslError("Failed to sign: EVP_DigestSignFinal"));
   }
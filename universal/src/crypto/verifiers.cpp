@@ -170,19 +170,10 @@ DsaVerifier<type, bits>::DsaVerifier(PublicKey pubkey)
                               " verifier");
     }
   }
-}
-
-template <DsaType type, DigestSize bits>
-DsaVerifier<type, bits>::DsaVerifier(std::string_view key)
-    : DsaVerifier{PublicKey::LoadFromString(key)} {}
 
-template <DsaType type, DigestSize bits>
-void DsaVerifier<type, bits>::Verify(
-    std::initializer_list<std::string_view> data,
-    std::string_view raw_signature) const {
-  EvpMdCtx ctx;
+  ctx_ = MakeSharedEvpMdCtx();
   EVP_PKEY_CTX* pkey_ctx = nullptr;
-  if (1 != EVP_DigestVerifyInit(ctx.Get(), &pkey_ctx, GetShaMdByEnum(bits),
+  if (1 != EVP_DigestVerifyInit(ctx_.get(), &pkey_ctx, GetShaMdByEnum(bits),
                                 nullptr, pkey_.GetNative())) {
     throw VerificationError(
         FormatSslError("Failed to verify: EVP_DigestVerifyInit"));
@@ -191,9 +182,19 @@ void DsaVerifier<type, bits>::Verify(
   if constexpr (type == DsaType::kRsaPss) {
     SetupJwaRsaPssPadding(pkey_ctx, bits);
   }
+}
+
+template <DsaType type, DigestSize bits>
+DsaVerifier<type, bits>::DsaVerifier(std::string_view key)
+    : DsaVerifier{PublicKey::LoadFromString(key)} {}
 
+template <DsaType type, DigestSize bits>
+void DsaVerifier<type, bits>::Verify(
+    std::initializer_list<std::string_view> data,
+    std::string_view raw_signature) const {
+  auto* const ctx = CopyToThreadLocalEvpMdCtx(ctx_.get());
   for (const auto& part : data) {
-    if (1 != EVP_DigestVerifyUpdate(ctx.Get(), part.data(), part.size())) {
+    if (1 != EVP_DigestVerifyUpdate(ctx, part.data(), part.size())) {
       throw VerificationError(
           FormatSslError("Failed to verify: EVP_DigestVerifyUpdate"));
     }
@@ -202,11 +203,11 @@ void DsaVerifier<type, bits>::Verify(
   int verification_result = -1;
   if constexpr (type == DsaType::kEc) {
     auto der_signature = ConvertEcSignature(raw_signature);
-    verification_result = EVP_DigestVerifyFinal(ctx.Get(), der_signature.data(),
+    verification_result = EVP_DigestVerifyFinal(ctx, der_signature.data(),
                                                 der_signature.size());
   } else {
     verification_result = EVP_DigestVerifyFinal(
-        ctx.Get(), reinterpret_cast<const unsigned char*>(raw_signature.data()),
+        ctx, reinterpret_cast<const unsigned char*>(raw_signature.data()),
         raw_signature.size());
   }
 
@@ -1,5 +1,7 @@
 #include <userver/decimal64/decimal64.hpp>
 
+#include <array>
+#include <cstring>
 #include <string_view>
 
 #include <fmt/format.h>
@@ -41,6 +43,43 @@ std::string_view ErrorDescription(ParseErrorCode error_code) {
   UINVARIANT(false, "Unexpected decimal64 error code");
 }
 
+constexpr std::array<char, 200> MakeDigitPairs() {
+  std::array<char, 200> pairs{};
+  for (int i = 0; i < 100; ++i) {
+    pairs[2 * i] = static_cast<char>('0' + i / 10);
+    pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+  }
+  return pairs;
+}
+
+constexpr std::array<char, 200> kDigitPairs = MakeDigitPairs();
+
+// Writes exactly `count` lower digits of `value` backwards from `end`
+char* WriteDigitsBackward(uint64_t value, int count, char* end) noexcept {
+  for (; count >= 2; count -= 2) {
+    end -= 2;
+    std::memcpy(end, &kDigitPairs[2 * (value % 100)], 2);
+    value /= 100;
+  }
+  if (count == 1) *--end = static_cast<char>('0' + value % 10);
+  return end;
+}
+
+char* WriteDigitsBackward(uint64_t value, char* end) noexcept {
+  while (value >= 100) {
+    end -= 2;
+    std::memcpy(end, &kDigitPairs[2 * (value % 100)], 2);
+    value /= 100;
+  }
+  if (value >= 10) {
+    end -= 2;
+    std::memcpy(end, &kDigitPairs[2 * value], 2);
+  } else {
+    *--end = static_cast<char>('0' + value);
+  }
+  return end;
+}
+
 }  // namespace
 
 std::string GetErrorMessage(std::string_view source, std::string_view path,
@@ -128,6 +167,44 @@ std::string ToString(int64_t before, int64_t after, int precision,
   return result;
 }
 
+std::size_t ToChars(int64_t unbiased, int precision, bool trim_trailing_zeros,
+                    char* output) noexcept {
+  UASSERT(precision >= 0 && precision <= kMaxDecimalDigits);
+
+  // INT64_MIN has no positive counterpart in int64_t
+  const bool is_negative = unbiased < 0;
+  const auto abs_value = is_negative ? -static_cast<uint64_t>(unbiased)
+                                     : static_cast<uint64_t>(unbiased);
+  const auto factor = static_cast<uint64_t>(Pow10(precision));
+  auto before = abs_value / factor;
+  auto after = abs_value % factor;
+
+  if (trim_trailing_zeros) {
+    if (after == 0) {
+      precision = 0;
+    } else {
+      while (after % 10 == 0) {
+        after /= 10;
+        --precision;
+      }
+    }
+  }
+
+  char buffer[kToCharsMaxSize];
+  char* const end = buffer + kToCharsMaxSize;
+  char* begin = end;
+  if (precision != 0) {
+    begin = WriteDigitsBackward(after, precision, begin);
+    *--begin = '.';
+  }
+  begin = WriteDigitsBackward(before, begin);
+  if (is_negative) *--begin = '-';
+
+  const auto size = static_cast<std::size_t>(end - begin);
+  std::memcpy(output, begin, size);
+  return size;
+}
+
 }  // namespace impl
 
 }  // namespace decimal64
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/decimal64/decimal64.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Dec4 = decimal64::Decimal<4>;
+
+const std::vector<std::string> kSources{
+    "0",         "1",          "-1",           "12.34",
+    "-0.0001",   "1000000",    "123456.7890",  "-98765.4321",
+    "42.5",      "3.1415",     "-271828.1828", "922337203685476.9999",
+    "0.1",       "99.99",      "-100",         "5000.0005",
+};
+
+std::vector<Dec4> GenerateDecimals() {
+  std::vector<Dec4> result;
+  result.reserve(kSources.size());
+  for (const auto& source : kSources) result.emplace_back(source);
+  return result;
+}
+
+}  // namespace
+
+void decimal64_from_string(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& source : kSources) {
+      benchmark::DoNotOptimize(Dec4{source});
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kSources.size());
+}
+BENCHMARK(decimal64_from_string);
+
+void decimal64_to_string(benchmark::State& state) {
+  const auto decimals = GenerateDecimals();
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto dec : decimals) {
+      benchmark::DoNotOptimize(decimal64::ToString(dec));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * decimals.size());
+}
+BENCHMARK(decimal64_to_string);
+
+void decimal64_to_string_trailing_zeros(benchmark::State& state) {
+  const auto decimals = GenerateDecimals();
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto dec : decimals) {
+      benchmark::DoNotOptimize(decimal64::ToStringTrailingZeros(dec));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * decimals.size());
+}
+BENCHMARK(decimal64_to_string_trailing_zeros);
+
+void decimal64_fmt_format(benchmark::State& state) {
+  const auto decimals = GenerateDecimals();
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto dec : decimals) {
+      benchmark::DoNotOptimize(fmt::format("{}", dec));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * decimals.size());
+}
+BENCHMARK(decimal64_fmt_format);
+
+USERVER_NAMESPACE_END
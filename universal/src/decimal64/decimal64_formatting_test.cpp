@@ -1,5 +1,6 @@
 #include <userver/decimal64/decimal64.hpp>
 
+#include <limits>
 #include <sstream>
 
 #include <gtest/gtest.h>
@@ -128,6 +129,23 @@ TEST(Decimal64, ToStringFixed) {
   EXPECT_EQ(decimal64::ToStringFixed<2>(decimal64::Decimal<18>{"1"}), "1.00");
 }
 
+TEST(Decimal64, ToStringExtremes) {
+  using Dec18 = decimal64::Decimal<18>;
+  constexpr auto kMax = std::numeric_limits<int64_t>::max();
+  constexpr auto kMin = std::numeric_limits<int64_t>::min();
+
+  EXPECT_EQ(ToString(Dec4::FromUnbiased(kMax)), "922337203685477.5807");
+  EXPECT_EQ(ToString(Dec4::FromUnbiased(kMin)), "-922337203685477.5808");
+  EXPECT_EQ(ToString(Dec18::FromUnbiased(kMin)), "-9.223372036854775808");
+  EXPECT_EQ(ToString(decimal64::Decimal<0>::FromUnbiased(kMin)),
+            "-9223372036854775808");
+  EXPECT_EQ(ToStringTrailingZeros(Dec18::FromUnbiased(-1)),
+            "-0.000000000000000001");
+  EXPECT_EQ(ToStringTrailingZeros(Dec4::FromUnbiased(-12'3400)), "-12.3400");
+  EXPECT_EQ(fmt::format("{:f}", Dec4::FromUnbiased(kMax)),
+            "922337203685477.5807");
+}
+
 TEST(Decimal64, ZerosFullyTrimmed) {
   EXPECT_EQ(ToString(decimal64::Decimal<0>{"1"}), "1");
   EXPECT_EQ(ToString(decimal64::Decimal<1>{"0.1"}), "0.1");
@@ -79,6 +79,29 @@ TEST(Decimal64, ConstructFromString) {
   EXPECT_THROW(Dec4{"-1 .0"}, decimal64::ParseError);
 }
 
+TEST(Decimal64, ConstructFromStringExtremes) {
+  using Dec18 = decimal64::Decimal<18>;
+  using Dec0 = decimal64::Decimal<0>;
+
+  EXPECT_EQ(Dec4{"922337203685476.9999"}.AsUnbiased(), 922337203685476'9999LL);
+  EXPECT_EQ(Dec4{"-922337203685476.9999"}.AsUnbiased(),
+            -922337203685476'9999LL);
+  EXPECT_THROW(Dec4{"922337203685477.0001"}, decimal64::ParseError);
+  EXPECT_EQ(Dec18{"-0.000000000000000001"}.AsUnbiased(), -1);
+  EXPECT_EQ(Dec18{"8.999999999999999999"}.AsUnbiased(), 8999999999999999999LL);
+  EXPECT_THROW(Dec18{"9.000000000000000001"}, decimal64::ParseError);
+  EXPECT_EQ(Dec0{"999999999999999999"}.AsUnbiased(), 999999999999999999LL);
+  EXPECT_THROW(Dec0{"9223372036854775807"}, decimal64::ParseError);
+  EXPECT_EQ(Dec0{"-12"}.AsUnbiased(), -12);
+  EXPECT_THROW(Dec0{"1.5"}, decimal64::ParseError);
+  EXPECT_THROW(Dec4{"-"}, decimal64::ParseError);
+  EXPECT_THROW(Dec4{""}, decimal64::ParseError);
+  EXPECT_THROW(Dec4{"1.2.3"}, decimal64::ParseError);
+  EXPECT_THROW(Dec4{"--1"}, decimal64::ParseError);
+
+  static_assert(Dec4{"-12.34"}.AsUnbiased() == -12'3400);
+}
+
 // NOLINTNEXTLINE(readability-function-size)
 TEST(Decimal64, FromStringPermissive) {
   EXPECT_EQ(Dec4::FromStringPermissive("1234.5678"), Dec4{"1234.5678"});
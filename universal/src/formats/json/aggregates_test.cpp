@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/aggregates.hpp>
+#include <userver/formats/json/serialize.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+/// [Sample formats::json::AggregateFields usage]
+struct Tag {
+  std::string name;
+  std::optional<double> weight;
+};
+
+struct Item {
+  std::int64_t id{0};
+  std::string name;
+  bool active{false};
+  std::vector<Tag> tags;
+  std::map<std::string, int> counters;
+  std::optional<std::string> comment;
+};
+
+}  // namespace
+
+template <>
+struct formats::json::AggregateFields<Tag> {
+  static constexpr std::string_view kNames[] = {"name", "weight"};
+};
+
+template <>
+struct formats::json::AggregateFields<Item> {
+  static constexpr std::string_view kNames[] = {
+      "id", "name", "active", "tags", "counters", "comment"};
+};
+/// [Sample formats::json::AggregateFields usage]
+
+namespace {
+
+bool operator==(const Tag& lhs, const Tag& rhs) {
+  return lhs.name == rhs.name && lhs.weight == rhs.weight;
+}
+
+bool operator==(const Item& lhs, const Item& rhs) {
+  return lhs.id == rhs.id && lhs.name == rhs.name &&
+         lhs.active == rhs.active && lhs.tags == rhs.tags &&
+         lhs.counters == rhs.counters && lhs.comment == rhs.comment;
+}
+
+constexpr std::string_view kItemJson =
+    R"({"id":42,"name":"item","active":true,)"
+    R"("tags":[{"name":"a","weight":1.5},{"name":"b","weight":null}],)"
+    R"("counters":{"x":1},"comment":null})";
+
+const Item kItem{42, "item", true, {{"a", 1.5}, {"b", {}}}, {{"x", 1}}, {}};
+
+}  // namespace
+
+TEST(FormatsJsonAggregates, ToString) {
+  EXPECT_EQ(formats::json::AggregateToString(kItem), kItemJson);
+  EXPECT_EQ(formats::json::AggregateToString(std::vector<Tag>{{"c", 2}}),
+            R"([{"name":"c","weight":2.0}])");
+}
+
+TEST(FormatsJsonAggregates, FromString) {
+  EXPECT_EQ(formats::json::AggregateFromString<Item>(kItemJson), kItem);
+
+  const auto item = formats::json::AggregateFromString<Item>(
+      R"({"unknown": {"a": [1, {"b": []}]}, "id": 1, "name": "x",
+          "active": false, "tags": [], "counters": {}})");
+  EXPECT_EQ(item.id, 1);
+  EXPECT_EQ(item.comment, std::nullopt);
+
+  const auto tags = formats::json::AggregateFromString<std::vector<Tag>>(
+      R"([{"name": "a"}, {"name": "b", "weight": 3}])");
+  ASSERT_EQ(tags.size(), 2);
+  EXPECT_EQ(tags[1].weight, 3.0);
+}
+
+TEST(FormatsJsonAggregates, FromStringErrors) {
+  using formats::json::AggregateFromString;
+  using formats::json::parser::ParseError;
+
+  EXPECT_THROW(AggregateFromString<Tag>("[]"), ParseError);
+  EXPECT_THROW(AggregateFromString<Tag>(R"({"name": 1})"), ParseError);
+  try {
+    AggregateFromString<Item>(
+        R"({"id": 1, "name": "x", "active": true, "counters": {},
+            "tags": [{"weight": 1}]})");
+    FAIL() << "ParseError expected";
+  } catch (const ParseError& e) {
+    EXPECT_NE(std::string_view{e.what()}.find(
+                  "path 'tags.[0]': Missing required field 'name'"),
+              std::string_view::npos)
+        << e.what();
+  }
+}
+
+TEST(FormatsJsonAggregates, Value) {
+  const auto json = formats::json::FromString(kItemJson);
+  EXPECT_EQ(json.As<Item>(), kItem);
+  EXPECT_EQ(formats::json::ValueBuilder{kItem}.ExtractValue(), json);
+
+  EXPECT_THROW(
+      formats::json::FromString(R"({"weight": 1})").As<Tag>(),
+      formats::json::MemberMissingException);
+  EXPECT_THROW(formats::json::FromString("[]").As<Tag>(),
+               formats::json::TypeMismatchException);
+}
+
+USERVER_NAMESPACE_END
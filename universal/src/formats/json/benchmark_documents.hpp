@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/aggregate_fields.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::bench {
+
+/// Document like a typical API response of `min_size` bytes or slightly more:
+/// {"items": [{"id": 0, "name": "...", "price": 1.5, ...}, ...], "total": N}
+inline std::string MakeLargeDocument(std::size_t min_size) {
+  std::string result = R"({"items":[)";
+  std::size_t count = 0;
+  while (result.size() < min_size) {
+    if (count > 0) result += ',';
+    result += fmt::format(
+        R"({{"id":{0},"name":"Item number {0} with a longer name",)"
+        R"("price":{1}.{2},"discount":-0.{2}5,"active":{3},)"
+        R"("tags":["tag{2}","common","файл"],)"
+        R"("attributes":{{"color":"red","size":"XL","weight":{0}e-3,)"
+        R"("description":"Quoted \"text\" with escapes\nand a new line"}},)"
+        R"("parent":null}})",
+        count, count % 1000, count % 10, count % 2 == 0);
+    ++count;
+  }
+  result += fmt::format(R"(],"total":{}}})", count);
+  return result;
+}
+
+/// Types of the MakeLargeDocument() documents
+struct Attributes {
+  std::string color;
+  std::string size;
+  double weight{0};
+  std::string description;
+};
+
+struct Item {
+  std::int64_t id{0};
+  std::string name;
+  double price{0};
+  double discount{0};
+  bool active{false};
+  std::vector<std::string> tags;
+  Attributes attributes;
+  std::optional<std::int64_t> parent;
+};
+
+struct Document {
+  std::vector<Item> items;
+  std::int64_t total{0};
+};
+
+}  // namespace formats::json::bench
+
+template <>
+struct formats::json::AggregateFields<formats::json::bench::Attributes> {
+  static constexpr std::string_view kNames[] = {"color", "size", "weight",
+                                                "description"};
+};
+
+template <>
+struct formats::json::AggregateFields<formats::json::bench::Item> {
+  static constexpr std::string_view kNames[] = {
+      "id", "name", "price", "discount", "active", "tags", "attributes",
+      "parent"};
+};
+
+template <>
+struct formats::json::AggregateFields<formats::json::bench::Document> {
+  static constexpr std::string_view kNames[] = {"items", "total"};
+};
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,171 @@
+#include <formats/json/impl/simdjson_parse.hpp>
+
+#ifdef USERVER_SIMDJSON_ENABLED
+
+#include <string>
+#include <variant>
+
+#include <boost/container/small_vector.hpp>
+#include <rapidjson/document.h>
+#include <simdjson.h>
+
+#include <formats/json/impl/json_tree.hpp>
+
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+#ifdef USERVER_SIMDJSON_ENABLED
+
+namespace {
+
+struct ArrayRange {
+  simdjson::dom::array::iterator it;
+  simdjson::dom::array::iterator end;
+};
+
+struct ObjectRange {
+  simdjson::dom::object::iterator it;
+  simdjson::dom::object::iterator end;
+};
+
+struct Frame {
+  Value* target;
+  std::variant<ArrayRange, ObjectRange> range;
+};
+
+// The document is converted without recursion, like rapidjson parses it with
+// kParseIterativeFlag, to keep the coroutine stack usage bounded
+using ConvertStack = boost::container::small_vector<Frame, kInitialStackDepth>;
+
+rapidjson::SizeType ToSizeType(std::size_t size) {
+  return static_cast<rapidjson::SizeType>(size);
+}
+
+std::string_view AsStringView(simdjson::dom::element element) {
+  return element.get_string().value_unsafe();
+}
+
+// Sets the scalar value or an empty container, a non-empty container gets a
+// frame on the stack to be filled later
+void ConvertValue(simdjson::dom::element element, Value& out,
+                  ConvertStack& stack, rapidjson::CrtAllocator& allocator) {
+  using simdjson::dom::element_type;
+
+  switch (element.type()) {
+    case element_type::ARRAY: {
+      const auto array = element.get_array().value_unsafe();
+      out.SetArray();
+      // size() saturates for huge arrays, PushBack grows the rest
+      out.Reserve(ToSizeType(array.size()), allocator);
+      stack.push_back({&out, ArrayRange{array.begin(), array.end()}});
+      return;
+    }
+    case element_type::OBJECT: {
+      const auto object = element.get_object().value_unsafe();
+      out.SetObject();
+      out.MemberReserve(ToSizeType(object.size()), allocator);
+      stack.push_back({&out, ObjectRange{object.begin(), object.end()}});
+      return;
+    }
+    case element_type::INT64:
+      out.SetInt64(element.get_int64().value_unsafe());
+      return;
+    case element_type::UINT64:
+      out.SetUint64(element.get_uint64().value_unsafe());
+      return;
+    case element_type::DOUBLE:
+      out.SetDouble(element.get_double().value_unsafe());
+      return;
+    case element_type::STRING: {
+      const auto str = AsStringView(element);
+      out.SetString(str.data(), ToSizeType(str.size()), allocator);
+      return;
+    }
+    case element_type::BOOL:
+      out.SetBool(element.get_bool().value_unsafe());
+      return;
+    case element_type::NULL_VALUE:
+      out.SetNull();
+      return;
+  }
+}
+
+void Convert(simdjson::dom::element root, Document& json) {
+  auto& allocator = json.GetAllocator();
+  ConvertStack stack;
+  ConvertValue(root, json, stack, allocator);
+
+  while (!stack.empty()) {
+    auto& frame = stack.back();
+    Value* target = frame.target;
+
+    // The new child is always appended to the container on the top of the
+    // stack, so a reallocation of its storage moves only finished values
+    if (auto* array = std::get_if<ArrayRange>(&frame.range)) {
+      if (array->it == array->end) {
+        stack.pop_back();
+        continue;
+      }
+      const auto element = *array->it;
+      ++array->it;
+
+      Value item;
+      target->PushBack(item, allocator);
+      ConvertValue(element, *(target->End() - 1), stack, allocator);
+    } else {
+      auto& object = std::get<ObjectRange>(frame.range);
+      if (object.it == object.end) {
+        stack.pop_back();
+        continue;
+      }
+      const auto field = *object.it;
+      ++object.it;
+
+      Value name{field.key.data(), ToSizeType(field.key.size()), allocator};
+      Value item;
+      target->AddMember(name, item, allocator);
+      ConvertValue(field.value, (target->MemberEnd() - 1)->value, stack,
+                   allocator);
+    }
+  }
+}
+
+}  // namespace
+
+bool IsSimdjsonEnabled() noexcept { return true; }
+
+bool TryParseWithSimdjson(std::string_view doc, Document& json) {
+  // Parsing never suspends, so the buffers are safely reused by all the
+  // coroutines of the thread
+  thread_local simdjson::dom::parser parser;
+  thread_local std::string padded_doc;
+
+  padded_doc.resize(doc.size() + simdjson::SIMDJSON_PADDING);
+  doc.copy(padded_doc.data(), doc.size());
+
+  simdjson::dom::element root;
+  const auto error = parser.parse(padded_doc.data(), doc.size(),
+                                  /*realloc_if_needed=*/false)
+                         .get(root);
+  if (error != simdjson::SUCCESS) return false;
+
+  Convert(root, json);
+  return true;
+}
+
+#else
+
+bool IsSimdjsonEnabled() noexcept { return false; }
+
+bool TryParseWithSimdjson(std::string_view /*doc*/, Document& /*json*/) {
+  return false;
+}
+
+#endif
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string_view>
+
+#include <userver/formats/json/impl/types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+/// Whether the library is built with USERVER_FEATURE_SIMDJSON
+bool IsSimdjsonEnabled() noexcept;
+
+/// Parses the `doc` with simdjson and converts it into the rapidjson `json`.
+///
+/// Returns false if simdjson is disabled, rejects the document or can not
+/// represent it (e.g. an integer that does not fit into 64 bits). The caller
+/// should parse such documents with rapidjson to get the usual result and
+/// error messages.
+bool TryParseWithSimdjson(std::string_view doc, Document& json);
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
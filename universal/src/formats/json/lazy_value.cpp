@@ -0,0 +1,466 @@
+#include <userver/formats/json/lazy_value.hpp>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+#include <fmt/format.h>
+
+#include <formats/json/impl/exttypes.hpp>
+#include <formats/json/impl/json_tree.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+namespace {
+
+constexpr std::string_view kNull = "null";
+
+// Characters that change the nesting while skipping over a container
+constexpr auto kStructuralChars = [] {
+  std::array<bool, 256> result{};
+  for (const unsigned char c : std::string_view{"\"{}[]"}) result[c] = true;
+  return result;
+}();
+
+bool IsWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool IsScalarEnd(char c) {
+  return IsWhitespace(c) || c == ',' || c == ']' || c == '}' || c == ':';
+}
+
+// Same text as formats::json::FromString() uses
+[[noreturn]] void ThrowParseError(std::size_t offset, std::string_view what) {
+  throw ParseException(
+      fmt::format("JSON parse error at offset {}: {}", offset, what));
+}
+
+std::size_t SkipWhitespace(std::string_view json, std::size_t pos) {
+  while (pos < json.size() && IsWhitespace(json[pos])) ++pos;
+  return pos;
+}
+
+// `json[pos]` is the opening quote, returns the position after the closing one
+std::size_t FindStringEnd(std::string_view json, std::size_t pos) {
+  const auto begin = pos;
+  for (;;) {
+    pos = json.find('"', pos + 1);
+    if (pos == std::string_view::npos) {
+      ThrowParseError(begin, "missing a closing quotation mark in string");
+    }
+
+    // The quote is escaped if it follows an odd number of backslashes
+    std::size_t backslashes = 0;
+    while (json[pos - backslashes - 1] == '\\') ++backslashes;
+    if (backslashes % 2 == 0) return pos + 1;
+  }
+}
+
+// `json[pos]` is the first character of a value, returns the position after
+// the value. The contents of the strings and the scalars are not checked.
+std::size_t FindValueEnd(std::string_view json, std::size_t pos) {
+  UASSERT(pos < json.size());
+  const char first = json[pos];
+  if (first == '"') return FindStringEnd(json, pos);
+
+  if (first == '{' || first == '[') {
+    boost::container::small_vector<char, impl::kInitialStackDepth> closers;
+    closers.push_back(first == '{' ? '}' : ']');
+    ++pos;
+    while (!closers.empty()) {
+      while (pos < json.size() &&
+             !kStructuralChars[static_cast<unsigned char>(json[pos])]) {
+        ++pos;
+      }
+      if (pos == json.size()) {
+        ThrowParseError(pos, "unexpected end of the document");
+      }
+
+      switch (const char c = json[pos]) {
+        case '"':
+          pos = FindStringEnd(json, pos);
+          continue;
+        case '{':
+          closers.push_back('}');
+          break;
+        case '[':
+          closers.push_back(']');
+          break;
+        default:
+          if (c != closers.back()) {
+            ThrowParseError(pos, fmt::format("unexpected '{}'", c));
+          }
+          closers.pop_back();
+      }
+      ++pos;
+    }
+    return pos;
+  }
+
+  const auto end = static_cast<std::size_t>(
+      std::find_if(json.begin() + pos, json.end(), IsScalarEnd) -
+      json.begin());
+  if (end == pos) ThrowParseError(pos, fmt::format("unexpected '{}'", first));
+  return end;
+}
+
+std::string UnescapeKey(std::string_view quoted_key) {
+  if (quoted_key.find('\\') == std::string_view::npos) {
+    return std::string{quoted_key.substr(1, quoted_key.size() - 2)};
+  }
+  return FromString(quoted_key).As<std::string>();
+}
+
+}  // namespace
+
+struct LazyValue::Index final {
+  struct Member final {
+    // Unescaped key, empty for the array elements
+    std::string key;
+    std::string_view json;
+    // Shared by all the values of the member
+    std::shared_ptr<Index> index;
+  };
+
+  // Returns nullptr for the values that are not objects or arrays
+  static std::shared_ptr<Index> Make(std::string_view json) {
+    if (json.empty() || (json.front() != '{' && json.front() != '[')) {
+      return {};
+    }
+    return std::make_shared<Index>();
+  }
+
+  const Member* FindMember(std::string_view key) const {
+    const auto it = std::lower_bound(
+        sorted_members.begin(), sorted_members.end(), key,
+        [](const Member* member, std::string_view key) {
+          return member->key < key;
+        });
+    if (it == sorted_members.end() || (*it)->key != key) return nullptr;
+    return *it;
+  }
+
+  std::once_flag build_flag;
+  // Object members or array elements in the document order
+  std::vector<Member> members;
+  // Object members sorted by the key
+  std::vector<const Member*> sorted_members;
+};
+
+
+LazyValue::LazyValue() : json_(kNull) {}
+
+LazyValue::LazyValue(std::string json)
+    : document_(std::make_shared<const std::string>(std::move(json))) {
+  const std::string_view document = *document_;
+  const auto begin = SkipWhitespace(document, 0);
+  if (begin == document.size()) {
+    throw ParseException("JSON document is empty");
+  }
+
+  const auto end = FindValueEnd(document, begin);
+  if (SkipWhitespace(document, end) != document.size()) {
+    ThrowParseError(end, "the root value is followed by other data");
+  }
+  json_ = document.substr(begin, end - begin);
+  index_ = Index::Make(json_);
+}
+
+LazyValue::LazyValue(std::shared_ptr<const std::string> document,
+                     std::string_view json, common::Path&& path,
+                     std::shared_ptr<Index> index) noexcept
+    : document_(std::move(document)),
+      json_(json),
+      path_(std::move(path)),
+      index_(std::move(index)) {}
+
+LazyValue::LazyValue(const LazyValue&) = default;
+
+LazyValue::LazyValue(LazyValue&&) noexcept = default;
+
+LazyValue& LazyValue::operator=(const LazyValue&) = default;
+
+LazyValue& LazyValue::operator=(LazyValue&&) noexcept = default;
+
+LazyValue::~LazyValue() = default;
+
+LazyValue LazyValue::operator[](std::string_view key) const {
+  if (IsMissing() || IsNull()) {
+    return {document_, {}, path_.MakeChildPath(key), {}};
+  }
+  if (!IsObject()) ThrowTypeMismatch(impl::objectValue);
+
+  const auto* member = GetIndex().FindMember(key);
+  if (!member) return {document_, {}, path_.MakeChildPath(key), {}};
+  return {document_, member->json, path_.MakeChildPath(key), member->index};
+}
+
+LazyValue LazyValue::operator[](std::size_t index) const {
+  CheckNotMissing();
+  if (!IsArray()) ThrowTypeMismatch(impl::arrayValue);
+
+  const auto& members = GetIndex().members;
+  if (index >= members.size()) {
+    throw OutOfBoundsException(index, members.size(), GetPath());
+  }
+  const auto& member = members[index];
+  return {document_, member.json, path_.MakeChildPath(index), member.index};
+}
+
+std::size_t LazyValue::GetSize() const {
+  CheckNotMissing();
+  if (IsNull()) return 0;
+  if (!IsObject() && !IsArray()) ThrowTypeMismatch(impl::arrayValue);
+  return GetIndex().members.size();
+}
+
+LazyValue::const_iterator LazyValue::begin() const {
+  // Checks the type and indexes the value
+  static_cast<void>(GetSize());
+  return {*this, 0};
+}
+
+LazyValue::const_iterator LazyValue::end() const { return {*this, GetSize()}; }
+
+bool LazyValue::IsMissing() const noexcept { return json_.data() == nullptr; }
+
+bool LazyValue::IsNull() const noexcept {
+  return !IsMissing() && json_.front() == 'n';
+}
+
+bool LazyValue::IsBool() const noexcept {
+  return !IsMissing() && (json_.front() == 't' || json_.front() == 'f');
+}
+
+bool LazyValue::IsString() const noexcept {
+  return !IsMissing() && json_.front() == '"';
+}
+
+bool LazyValue::IsArray() const noexcept {
+  return !IsMissing() && json_.front() == '[';
+}
+
+bool LazyValue::IsObject() const noexcept {
+  return !IsMissing() && json_.front() == '{';
+}
+
+bool LazyValue::HasMember(std::string_view key) const {
+  CheckObjectOrNull();
+  if (IsNull()) return false;
+
+  return GetIndex().FindMember(key) != nullptr;
+}
+
+Value LazyValue::Materialize() const {
+  CheckNotMissing();
+  return FromString(json_);
+}
+
+std::string_view LazyValue::GetRawJson() const {
+  CheckNotMissing();
+  return json_;
+}
+
+std::string LazyValue::GetPath() const { return path_.ToString(); }
+
+const LazyValue::Index& LazyValue::GetIndex() const {
+  UASSERT(index_);
+  std::call_once(index_->build_flag, [this] {
+    // Positions are counted from the start of the document for the errors
+    const std::string_view document = *document_;
+    const auto end = GetOffset(json_.size());
+    const auto expect = [document, end](std::size_t pos) {
+      if (pos >= end) ThrowParseError(pos, "unexpected end of value");
+      return document[pos];
+    };
+
+    const char closer = IsObject() ? '}' : ']';
+    std::vector<Index::Member> members;
+    auto pos = SkipWhitespace(document, GetOffset(1));
+    if (expect(pos) != closer) {
+      for (;;) {
+        std::string key;
+        if (IsObject()) {
+          if (expect(pos) != '"') ThrowParseError(pos, "missing a name");
+          const auto key_end = FindStringEnd(document, pos);
+          key = UnescapeKey(document.substr(pos, key_end - pos));
+
+          pos = SkipWhitespace(document, key_end);
+          if (expect(pos) != ':') {
+            ThrowParseError(pos, "missing a colon after a name");
+          }
+          pos = SkipWhitespace(document, pos + 1);
+          expect(pos);
+        }
+
+        const auto value_end = FindValueEnd(document, pos);
+        const auto value = document.substr(pos, value_end - pos);
+        members.push_back({std::move(key), value, Index::Make(value)});
+
+        pos = SkipWhitespace(document, value_end);
+        const char c = expect(pos);
+        if (c == closer) break;
+        if (c != ',') ThrowParseError(pos, fmt::format("unexpected '{}'", c));
+        pos = SkipWhitespace(document, pos + 1);
+      }
+    }
+
+    std::vector<const Index::Member*> sorted_members;
+    if (IsObject()) {
+      sorted_members.reserve(members.size());
+      for (const auto& member : members) sorted_members.push_back(&member);
+      std::sort(sorted_members.begin(), sorted_members.end(),
+                [](const auto* lhs, const auto* rhs) {
+                  return lhs->key < rhs->key;
+                });
+      const auto duplicate = std::adjacent_find(
+          sorted_members.begin(), sorted_members.end(),
+          [](const auto* lhs, const auto* rhs) {
+            return lhs->key == rhs->key;
+          });
+      if (duplicate != sorted_members.end()) {
+        throw ParseException("Duplicate key: " + (*duplicate)->key + " at " +
+                             GetPath());
+      }
+    }
+
+    // Filled only on success, the failed build is retried on the next call
+    index_->members = std::move(members);
+    index_->sorted_members = std::move(sorted_members);
+  });
+  return *index_;
+}
+
+std::size_t LazyValue::GetOffset(std::size_t pos) const noexcept {
+  return static_cast<std::size_t>(json_.data() - document_->data()) + pos;
+}
+
+void LazyValue::CheckNotMissing() const {
+  if (IsMissing()) throw MemberMissingException(GetPath());
+}
+
+void LazyValue::CheckObjectOrNull() const {
+  CheckNotMissing();
+  if (!IsObject() && !IsNull()) ThrowTypeMismatch(impl::objectValue);
+}
+
+void LazyValue::ThrowTypeMismatch(int expected) const {
+  impl::Type actual = impl::realValue;
+  switch (json_.front()) {
+    case 'n':
+      actual = impl::nullValue;
+      break;
+    case 't':
+    case 'f':
+      actual = impl::booleanValue;
+      break;
+    case '"':
+      actual = impl::stringValue;
+      break;
+    case '[':
+      actual = impl::arrayValue;
+      break;
+    case '{':
+      actual = impl::objectValue;
+      break;
+    default:
+      if (json_.find_first_of(".eE") == std::string_view::npos) {
+        actual = json_.front() == '-' ? impl::intValue : impl::uintValue;
+      }
+  }
+  throw TypeMismatchException(actual, expected, GetPath());
+}
+
+LazyValue::const_iterator::const_iterator(LazyValue container,
+                                          std::size_t pos) noexcept
+    : container_(std::move(container)), pos_(pos) {}
+
+LazyValue::const_iterator::const_iterator(const const_iterator& other)
+    : container_(other.container_), pos_(other.pos_) {}
+
+LazyValue::const_iterator::const_iterator(const_iterator&& other) noexcept
+    : container_(std::move(other.container_)), pos_(other.pos_) {}
+
+LazyValue::const_iterator& LazyValue::const_iterator::operator=(
+    const const_iterator& other) {
+  if (this == &other) return *this;
+
+  container_ = other.container_;
+  pos_ = other.pos_;
+  current_.reset();
+  return *this;
+}
+
+LazyValue::const_iterator& LazyValue::const_iterator::operator=(
+    const_iterator&& other) noexcept {
+  container_ = std::move(other.container_);
+  pos_ = other.pos_;
+  current_.reset();
+  return *this;
+}
+
+LazyValue::const_iterator::~const_iterator() = default;
+
+LazyValue::const_iterator LazyValue::const_iterator::operator++(int) {
+  auto result = *this;
+  ++*this;
+  return result;
+}
+
+LazyValue::const_iterator& LazyValue::const_iterator::operator++() {
+  ++pos_;
+  current_.reset();
+  return *this;
+}
+
+LazyValue::const_iterator::reference LazyValue::const_iterator::operator*()
+    const {
+  if (!current_) {
+    if (container_.IsObject()) {
+      const auto& member = container_.GetIndex().members[pos_];
+      current_ = LazyValue{container_.document_, member.json,
+                           container_.path_.MakeChildPath(member.key),
+                           member.index};
+    } else {
+      current_ = container_[pos_];
+    }
+  }
+  return *current_;
+}
+
+LazyValue::const_iterator::pointer LazyValue::const_iterator::operator->()
+    const {
+  return &**this;
+}
+
+bool LazyValue::const_iterator::operator==(
+    const const_iterator& other) const noexcept {
+  return container_.json_.data() == other.container_.json_.data() &&
+         pos_ == other.pos_;
+}
+
+bool LazyValue::const_iterator::operator!=(
+    const const_iterator& other) const noexcept {
+  return !(*this == other);
+}
+
+std::string LazyValue::const_iterator::GetName() const {
+  if (!container_.IsObject()) container_.ThrowTypeMismatch(impl::objectValue);
+  return container_.GetIndex().members[pos_].key;
+}
+
+std::size_t LazyValue::const_iterator::GetIndex() const {
+  if (!container_.IsArray()) container_.ThrowTypeMismatch(impl::arrayValue);
+  return pos_;
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
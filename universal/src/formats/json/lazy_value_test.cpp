@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/lazy_value.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Item {
+  std::string name;
+  int count{0};
+};
+
+Item Parse(const formats::json::Value& value, formats::parse::To<Item>) {
+  return {value["name"].As<std::string>(), value["count"].As<int>(0)};
+}
+
+}  // namespace
+
+TEST(FormatsJsonLazyValue, ExampleUsage) {
+  /// [Sample formats::json::LazyValue usage]
+  // #include <userver/formats/json/lazy_value.hpp>
+
+  const formats::json::LazyValue json{R"({
+    "key1": 1,
+    "key2": {"key3": "val"},
+    "big": [1, 2, 3]
+  })"};
+
+  const auto key1 = json["key1"].As<int>();
+  ASSERT_EQ(key1, 1);
+
+  // only "key2" and then "key3" are parsed, "big" is skipped
+  const auto key3 = json["key2"]["key3"].As<std::string>();
+  ASSERT_EQ(key3, "val");
+  /// [Sample formats::json::LazyValue usage]
+}
+
+TEST(FormatsJsonLazyValue, Types) {
+  const formats::json::LazyValue json{
+      R"({"n": null, "b": true, "s": "str", "a": [], "o": {}, "i": -1})"};
+  EXPECT_TRUE(json.IsObject());
+  EXPECT_TRUE(json["n"].IsNull());
+  EXPECT_TRUE(json["b"].IsBool());
+  EXPECT_TRUE(json["s"].IsString());
+  EXPECT_TRUE(json["a"].IsArray());
+  EXPECT_TRUE(json["o"].IsObject());
+  EXPECT_TRUE(json["missing"].IsMissing());
+  EXPECT_FALSE(json["i"].IsMissing());
+
+  EXPECT_EQ(json.GetSize(), 6);
+  EXPECT_EQ(json["a"].GetSize(), 0);
+  EXPECT_EQ(json["n"].GetSize(), 0);
+  EXPECT_TRUE(json.HasMember("s"));
+  EXPECT_FALSE(json.HasMember("x"));
+
+  EXPECT_THROW(json["s"]["key"], formats::json::TypeMismatchException);
+  EXPECT_THROW(json["o"][0], formats::json::TypeMismatchException);
+  EXPECT_THROW(json["i"].GetSize(), formats::json::TypeMismatchException);
+}
+
+TEST(FormatsJsonLazyValue, As) {
+  const formats::json::LazyValue json{R"({
+    "items": [{"name": "first", "count": 2}, {"name": "second"}],
+    "escaped\nkey": "value!",
+    "nested": {"deeper": {"numbers": [1, 2.5, 18446744073709551615]}}
+  })"};
+
+  const auto items = json["items"].As<std::vector<Item>>();
+  ASSERT_EQ(items.size(), 2);
+  EXPECT_EQ(items[1].name, "second");
+  EXPECT_EQ(json["items"][0].As<Item>().count, 2);
+
+  EXPECT_EQ(json["escaped\nkey"].As<std::string>(), "value!");
+  const auto numbers = json["nested"]["deeper"]["numbers"];
+  EXPECT_EQ(numbers[0].As<int>(), 1);
+  EXPECT_DOUBLE_EQ(numbers[1].As<double>(), 2.5);
+  EXPECT_EQ(numbers[2].As<std::uint64_t>(), 18446744073709551615ULL);
+  EXPECT_EQ(numbers.GetPath(), "nested.deeper.numbers");
+  EXPECT_EQ(numbers.GetRawJson(), "[1, 2.5, 18446744073709551615]");
+
+  EXPECT_EQ(json["missing"].As<int>(42), 42);
+  EXPECT_EQ(json["missing"]["deeper"].As<std::string>({}), "");
+  EXPECT_THROW(json["missing"].As<int>(),
+               formats::json::MemberMissingException);
+  EXPECT_THROW(numbers[3], formats::json::OutOfBoundsException);
+
+  EXPECT_EQ(json["nested"].Materialize(),
+            formats::json::FromString(
+                R"({"deeper": {"numbers": [1, 2.5, 18446744073709551615]}})"));
+}
+
+TEST(FormatsJsonLazyValue, Malformed) {
+  using formats::json::LazyValue;
+  using formats::json::ParseException;
+
+  EXPECT_THROW(LazyValue{""}, ParseException);
+  EXPECT_THROW(LazyValue{" \n "}, ParseException);
+  EXPECT_THROW(LazyValue{R"({"a": [1, 2})"}, ParseException);
+  EXPECT_THROW(LazyValue{R"({"a": "1})"}, ParseException);
+  EXPECT_THROW(LazyValue{"[1] [2]"}, ParseException);
+
+  EXPECT_THROW(LazyValue{R"({"a" 1})"}.GetSize(), ParseException);
+  EXPECT_THROW(LazyValue{R"({"a": 1 "b": 2})"}.GetSize(), ParseException);
+  EXPECT_THROW(LazyValue{R"({"a": 1, "a": 2})"}["a"], ParseException);
+  EXPECT_THROW(LazyValue{"[1, , 2]"}[0], ParseException);
+
+  // Untouched members are not checked
+  const LazyValue json{R"({"good": 1, "bad": [tru]})"};
+  EXPECT_EQ(json["good"].As<int>(), 1);
+  EXPECT_THROW(json["bad"][0].As<bool>(), ParseException);
+}
+
+TEST(FormatsJsonLazyValue, Iteration) {
+  const formats::json::LazyValue json{
+      R"({"b": [1, 2, 3], "a": {"x": "y"}, "c": null})"};
+
+  std::vector<std::string> names;
+  for (auto it = json.begin(); it != json.end(); ++it) {
+    names.push_back(it.GetName());
+    EXPECT_EQ(it->GetPath(), it.GetName());
+    EXPECT_THROW(it.GetIndex(), formats::json::TypeMismatchException);
+  }
+  EXPECT_EQ(names, (std::vector<std::string>{"b", "a", "c"}));
+
+  int sum = 0;
+  std::size_t expected_index = 0;
+  const auto array = json["b"];
+  for (auto it = array.begin(); it != array.end(); ++it) {
+    EXPECT_EQ(it.GetIndex(), expected_index++);
+    sum += it->As<int>();
+  }
+  EXPECT_EQ(sum, 6);
+
+  for (const auto& value : json["c"]) {
+    ADD_FAILURE() << "null has no members: " << value.GetRawJson();
+  }
+  EXPECT_THROW(json["a"]["x"].begin(), formats::json::TypeMismatchException);
+  EXPECT_THROW(json["missing"].begin(), formats::json::MemberMissingException);
+}
+
+TEST(FormatsJsonLazyValue, ConcurrentAccess) {
+  const formats::json::LazyValue json{
+      R"({"items": [{"id": 0}, {"id": 1}, {"id": 2}, {"id": 3}]})"};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&json, i] {
+      const auto items = json["items"];
+      EXPECT_EQ(items.GetSize(), 4);
+      EXPECT_EQ(items[i]["id"].As<int>(), i);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+TEST(FormatsJsonLazyValue, ErrorText) {
+  using formats::json::LazyValue;
+
+  try {
+    LazyValue{R"({"a": 1 "b": 2})"}.GetSize();
+    FAIL() << "ParseException was not thrown";
+  } catch (const formats::json::ParseException& ex) {
+    EXPECT_EQ(std::string{ex.what()},
+              "JSON parse error at offset 8: unexpected '\"'");
+  }
+}
+
+USERVER_NAMESPACE_END
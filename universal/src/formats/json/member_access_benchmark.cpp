@@ -2,7 +2,9 @@
 
 #include <benchmark/benchmark.h>
 
+#include <formats/json/benchmark_documents.hpp>
 #include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/lazy_value.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/value_builder.hpp>
 
@@ -102,6 +104,72 @@ void json_path_long_and_deeply_nested(benchmark::State& state) {
 }
 BENCHMARK(json_path_long_and_deeply_nested);
 
+void json_large_document_read(benchmark::State& state) {
+  const auto input = formats::json::bench::MakeLargeDocument(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    const auto json = formats::json::FromString(input);
+    double sum = 0;
+    for (const auto& item : json["items"]) {
+      sum += item["price"].As<double>() +
+             item["attributes"]["weight"].As<double>();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(json_large_document_read)
+    ->RangeMultiplier(4)
+    ->Range(100 << 10, 5 << 20);
+
+template <typename Json>
+std::size_t ReadFewFields(const Json& json) {
+  return json["total"].template As<std::size_t>() +
+         json["items"][10]["name"].template As<std::string>().size() +
+         json["items"][20]["attributes"]["size"]
+             .template As<std::string>()
+             .size();
+}
+
+void json_large_document_read_few(benchmark::State& state) {
+  const auto input = formats::json::bench::MakeLargeDocument(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(ReadFewFields(formats::json::FromString(input)));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(json_large_document_read_few)
+    ->RangeMultiplier(4)
+    ->Range(100 << 10, 5 << 20);
+
+void json_large_document_lazy_read_few(benchmark::State& state) {
+  const auto input = formats::json::bench::MakeLargeDocument(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(ReadFewFields(formats::json::LazyValue{input}));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(json_large_document_lazy_read_few)
+    ->RangeMultiplier(4)
+    ->Range(100 << 10, 5 << 20);
+
+void json_large_document_iterate(benchmark::State& state) {
+  const auto json = formats::json::FromString(
+      formats::json::bench::MakeLargeDocument(state.range(0)));
+  for ([[maybe_unused]] auto _ : state) {
+    std::size_t names_size = 0;
+    for (const auto& item : json["items"]) {
+      names_size += item["name"].As<std::string>().size();
+      for (const auto& tag : item["tags"]) {
+        names_size += tag.As<std::string>().size();
+      }
+    }
+    benchmark::DoNotOptimize(names_size);
+  }
+}
+BENCHMARK(json_large_document_iterate)
+    ->RangeMultiplier(4)
+    ->Range(100 << 10, 5 << 20);
+
 formats::json::ValueBuilder Build(size_t count) {
   formats::json::ValueBuilder builder;
   for (size_t i = 0; i < count; i++) builder[std::to_string(i)] = i;
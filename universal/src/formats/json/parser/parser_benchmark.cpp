@@ -2,6 +2,7 @@
 
 #include <fmt/format.h>
 
+#include <formats/json/benchmark_documents.hpp>
 #include <userver/formats/json/inline.hpp>
 #include <userver/formats/json/parser/parser.hpp>
 #include <userver/formats/json/serialize.hpp>
@@ -100,6 +101,31 @@ void JsonParseValueSax(benchmark::State& state) {
 }
 BENCHMARK(JsonParseValueSax)->RangeMultiplier(2)->Range(1, 16);
 
+void JsonParseLargeDocumentDom(benchmark::State& state) {
+  const auto input = formats::json::bench::MakeLargeDocument(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    const auto res = formats::json::FromString(input);
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParseLargeDocumentDom)
+    ->RangeMultiplier(4)
+    ->Range(100 << 10, 5 << 20);
+
+void JsonParseLargeDocumentSax(benchmark::State& state) {
+  const auto input = formats::json::bench::MakeLargeDocument(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    const auto res = formats::json::parser::ParseToType<
+        formats::json::Value, formats::json::parser::JsonValueParser>(input);
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParseLargeDocumentSax)
+    ->RangeMultiplier(4)
+    ->Range(100 << 10, 5 << 20);
+
 namespace {
 
 struct SomeValue final {
@@ -0,0 +1,47 @@
+#include <userver/formats/json/parser/skip_parser.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser {
+
+void SkipParser::Null() { MaybePopSelf(); }
+
+void SkipParser::Bool(bool) { MaybePopSelf(); }
+
+void SkipParser::Int64(int64_t) { MaybePopSelf(); }
+
+void SkipParser::Uint64(uint64_t) { MaybePopSelf(); }
+
+void SkipParser::Double(double) { MaybePopSelf(); }
+
+void SkipParser::String(std::string_view) { MaybePopSelf(); }
+
+void SkipParser::StartObject() { ++depth_; }
+
+void SkipParser::Key(std::string_view) {}
+
+void SkipParser::EndObject() {
+  UASSERT(depth_ > 0);
+  --depth_;
+  MaybePopSelf();
+}
+
+void SkipParser::StartArray() { ++depth_; }
+
+void SkipParser::EndArray() {
+  UASSERT(depth_ > 0);
+  --depth_;
+  MaybePopSelf();
+}
+
+std::string SkipParser::Expected() const { return "value"; }
+
+void SkipParser::MaybePopSelf() {
+  if (depth_ == 0) parser_state_->PopMe(*this);
+}
+
+}  // namespace formats::json::parser
+
+USERVER_NAMESPACE_END
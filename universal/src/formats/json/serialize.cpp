@@ -17,6 +17,7 @@
 
 #include <formats/json/impl/accept.hpp>
 #include <formats/json/impl/json_tree.hpp>
+#include <formats/json/impl/simdjson_parse.hpp>
 #include <formats/json/impl/types_impl.hpp>
 #include <userver/formats/json/exception.hpp>
 #include <userver/formats/json/value.hpp>
@@ -94,6 +95,12 @@ Value FromString(std::string_view doc) {
   }
 
   impl::Document json{&g_allocator};
+  if (impl::TryParseWithSimdjson(doc, json)) {
+    return Value{EnsureValid(std::move(json))};
+  }
+
+  // rapidjson reports the errors and handles the documents simdjson can not
+  // represent, e.g. integers that do not fit into 64 bits
   rapidjson::ParseResult ok =
       json.Parse<rapidjson::kParseDefaultFlags |
                  rapidjson::kParseIterativeFlag |
@@ -3,9 +3,13 @@
 #include <benchmark/benchmark.h>
 #include <rapidjson/document.h>
 
+#include <formats/json/benchmark_documents.hpp>
+#include <userver/formats/json/aggregates.hpp>
 #include <userver/formats/json/impl/types.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/json/value.hpp>
+#include <userver/formats/json/value_builder.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -1179,6 +1183,111 @@ BENCHMARK(DeepJson);
 
 BENCHMARK(DeepWidthJson);
 
+void JsonParseLargeDocumentToStructDom(benchmark::State& state) {
+  const auto input = formats::json::bench::MakeLargeDocument(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    const auto res =
+        formats::json::FromString(input).As<formats::json::bench::Document>();
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParseLargeDocumentToStructDom)
+    ->RangeMultiplier(4)
+    ->Range(100 << 10, 5 << 20);
+
+void JsonParseLargeDocumentToStructSax(benchmark::State& state) {
+  const auto input = formats::json::bench::MakeLargeDocument(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    const auto res = formats::json::AggregateFromString<
+        formats::json::bench::Document>(input);
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParseLargeDocumentToStructSax)
+    ->RangeMultiplier(4)
+    ->Range(100 << 10, 5 << 20);
+
+// An answer full of text fields: 100 strings of the given length with a rare
+// character to escape
+std::string MakeLongText(std::size_t length) {
+  std::string text;
+  text.reserve(length);
+  for (std::size_t i = 0; i < length; ++i) {
+    text += (i % 200 == 199) ? '\n' : static_cast<char>('a' + i % 26);
+  }
+  return text;
+}
+
+formats::json::Value MakeStringHeavyDocument(std::size_t length) {
+  const auto text = MakeLongText(length);
+  formats::json::ValueBuilder builder{formats::common::Type::kArray};
+  for (int i = 0; i < 100; ++i) {
+    formats::json::ValueBuilder item;
+    item["id"] = i;
+    item["text"] = text;
+    builder.PushBack(std::move(item));
+  }
+  return builder.ExtractValue();
+}
+
+void JsonSerializeLongStrings(benchmark::State& state) {
+  const auto doc = MakeStringHeavyDocument(state.range(0));
+  std::size_t size = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    const auto res = formats::json::ToString(doc);
+    size = res.size();
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(JsonSerializeLongStrings)->RangeMultiplier(8)->Range(16, 16 << 10);
+
+void JsonStringBuilderLongStrings(benchmark::State& state) {
+  const auto text = MakeLongText(state.range(0));
+  std::size_t size = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    formats::json::StringBuilder sb;
+    {
+      const formats::json::StringBuilder::ArrayGuard guard{sb};
+      for (int i = 0; i < 100; ++i) {
+        const formats::json::StringBuilder::ObjectGuard item_guard{sb};
+        sb.Key("id");
+        sb.WriteInt64(i);
+        sb.Key("text");
+        sb.WriteString(text);
+      }
+    }
+    size = sb.GetStringView().size();
+    benchmark::DoNotOptimize(sb.GetStringView());
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(JsonStringBuilderLongStrings)
+    ->RangeMultiplier(8)
+    ->Range(16, 16 << 10);
+
+template <bool Reserve>
+void JsonValueBuilderLargeArray(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    formats::json::ValueBuilder builder{formats::common::Type::kArray};
+    if constexpr (Reserve) builder.Reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      formats::json::ValueBuilder item{formats::common::Type::kObject};
+      if constexpr (Reserve) item.Reserve(2);
+      item["id"] = i;
+      item["name"] = "item";
+      builder.PushBack(std::move(item));
+    }
+    benchmark::DoNotOptimize(builder.ExtractValue());
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK_TEMPLATE(JsonValueBuilderLargeArray, false)->Arg(100)->Arg(10000);
+BENCHMARK_TEMPLATE(JsonValueBuilderLargeArray, true)->Arg(100)->Arg(10000);
+
 }  // namespace
 
 USERVER_NAMESPACE_END
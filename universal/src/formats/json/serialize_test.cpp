@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <limits>
 #include <map>
 
 #include <boost/range/adaptor/reversed.hpp>
@@ -83,6 +85,28 @@ TEST(FormatsJson, ParseFromBadFile) {
   }
 }
 
+// The same results are expected with and without USERVER_FEATURE_SIMDJSON
+TEST(FormatsJson, FromStringNumbers) {
+  using formats::json::FromString;
+
+  EXPECT_TRUE(FromString("-1").IsInt());
+  EXPECT_TRUE(FromString("18446744073709551615").IsUInt64());
+  EXPECT_EQ(FromString("-9223372036854775808").As<std::int64_t>(),
+            std::numeric_limits<std::int64_t>::min());
+  EXPECT_TRUE(FromString("1.5").IsDouble());
+
+  // Does not fit into 64 bits
+  const auto big = FromString("123456789012345678901234567890");
+  EXPECT_TRUE(big.IsDouble());
+  EXPECT_DOUBLE_EQ(big.As<double>(), 1.2345678901234568e+29);
+}
+
+TEST(FormatsJson, FromStringDeeplyNested) {
+  constexpr std::size_t kDepth = 5000;
+  const auto doc = std::string(kDepth, '[') + std::string(kDepth, ']');
+  EXPECT_EQ(formats::json::ToString(formats::json::FromString(doc)), doc);
+}
+
 class FmtFormatterParameterized : public testing::TestWithParam<std::string> {};
 
 TEST_P(FmtFormatterParameterized, FormatsJsonFmt) {
@@ -287,6 +311,27 @@ TEST(JsonToSortedString, NonASCII) {
             formats::json::ToStableString(unescaped));
 }
 
+TEST(FormatsJson, ToStringEscapesLongStrings) {
+  // The escaped characters at all the offsets relative to the vectorized
+  // blocks of the writer
+  const std::pair<char, std::string_view> kEscapes[] = {
+      {'"', R"(\")"}, {'\\', R"(\\)"}, {'\n', R"(\n)"}, {'\x01', R"(\u0001)"}};
+  for (std::size_t length = 1; length < 70; ++length) {
+    for (std::size_t pos = 0; pos < length; ++pos) {
+      for (const auto& [c, escaped] : kEscapes) {
+        std::string str(length, 'a');
+        str[pos] = c;
+        const auto expected = '"' + std::string(pos, 'a') +
+                              std::string{escaped} +
+                              std::string(length - pos - 1, 'a') + '"';
+        EXPECT_EQ(formats::json::ToString(
+                      formats::json::ValueBuilder{str}.ExtractValue()),
+                  expected);
+      }
+    }
+  }
+}
+
 TEST(JsonToPrettyStringCycle, IsPretty) {
   static constexpr std::string_view kInitialJson =
       R"({"a":1,"b":[],"c":{},"d":{"x":[42]},"e":[5,"foo"]})";
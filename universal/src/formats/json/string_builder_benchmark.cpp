@@ -1,5 +1,8 @@
 #include <benchmark/benchmark.h>
 
+#include <formats/json/benchmark_documents.hpp>
+#include <userver/formats/json/aggregates.hpp>
+#include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/json/value_builder.hpp>
 
@@ -74,4 +77,29 @@ void JsonStringBuilder(benchmark::State& state) {
 }
 BENCHMARK(JsonStringBuilder)->RangeMultiplier(4)->Range(1, 1024);
 
+bench::Document MakeLargeStruct(std::size_t min_size) {
+  return AggregateFromString<bench::Document>(
+      bench::MakeLargeDocument(min_size));
+}
+
+void JsonSerializeStruct(benchmark::State& state) {
+  const auto document = MakeLargeStruct(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    auto str = ToString(ValueBuilder{document}.ExtractValue());
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(JsonSerializeStruct)->RangeMultiplier(4)->Range(100 << 10, 5 << 20);
+
+void JsonStringBuilderStruct(benchmark::State& state) {
+  const auto document = MakeLargeStruct(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    auto str = AggregateToString(document);
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(JsonStringBuilderStruct)
+    ->RangeMultiplier(4)
+    ->Range(100 << 10, 5 << 20);
+
 USERVER_NAMESPACE_END
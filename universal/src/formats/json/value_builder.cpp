@@ -212,6 +212,25 @@ void ValueBuilder::Resize(std::size_t size) {
   }
 }
 
+void ValueBuilder::Reserve(std::size_t capacity) {
+  value_->CheckObjectOrArrayOrNull();
+  auto& native = value_->GetNative();
+  const auto new_capacity = static_cast<::rapidjson::SizeType>(capacity);
+
+  // notify wrapper when elements capacity (and thus location) changes
+  if (native.IsArray()) {
+    const auto old_capacity = native.Capacity();
+    if (new_capacity <= old_capacity) return;
+    native.Reserve(new_capacity, g_allocator);
+    if (old_capacity) value_.OnMembersChange();
+  } else if (native.IsObject()) {
+    const auto old_capacity = native.MemberCapacity();
+    if (new_capacity <= old_capacity) return;
+    native.MemberReserve(new_capacity, g_allocator);
+    if (old_capacity) value_.OnMembersChange();
+  }
+}
+
 void ValueBuilder::PushBack(ValueBuilder&& bld) {
   value_->CheckArrayOrNull();
   auto& native = value_->GetNative();
@@ -124,6 +124,32 @@ TEST(JsonValueBuilder, ExampleCustomization) {
   ASSERT_EQ(json["example"]["field2"].As<int>(), 1);
 }
 
+TEST(JsonValueBuilder, Reserve) {
+  formats::json::ValueBuilder builder;
+  builder.Reserve(10);
+  EXPECT_TRUE(builder.IsNull());
+
+  builder["array"] = formats::common::Type::kArray;
+  auto array = builder["array"];
+  array.PushBack(1);
+  // Relocates the elements, the nested builders must stay valid
+  auto first = array[0];
+  array.Reserve(1000);
+  for (int i = 1; i < 1000; ++i) array.PushBack(i);
+  first = 42;
+
+  builder.Reserve(100);
+  builder["other"] = "value";
+
+  formats::json::ValueBuilder number{1};
+  EXPECT_THROW(number.Reserve(10), formats::json::TypeMismatchException);
+
+  const auto value = builder.ExtractValue();
+  EXPECT_EQ(value["array"].GetSize(), 1000);
+  EXPECT_EQ(value["array"][0].As<int>(), 42);
+  EXPECT_EQ(value["other"].As<std::string>(), "value");
+}
+
 TEST(JsonValueBuilder, StringViewRemove) {
   formats::json::ValueBuilder builder;
   const std::string str = "ab";
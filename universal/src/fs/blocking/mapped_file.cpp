@@ -0,0 +1,59 @@
+#include <userver/fs/blocking/mapped_file.hpp>
+
+#include <sys/mman.h>
+
+#include <utility>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::blocking {
+
+MappedFile::MappedFile(FileDescriptor fd, void* data, std::size_t size) noexcept
+    : fd_(std::move(fd)), data_(data), size_(size) {}
+
+MappedFile MappedFile::Open(const std::string& path) {
+  auto fd = FileDescriptor::Open(path, OpenFlag::kRead);
+  const auto size = fd.GetSize();
+
+  // mmap does not accept zero length
+  if (size == 0) return MappedFile{std::move(fd), nullptr, 0};
+
+  void* const data = utils::CheckSyscallNotEquals(
+      ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd.GetNative(), 0),
+      MAP_FAILED, "mapping file '{}'", path);
+  return MappedFile{std::move(fd), data, size};
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : fd_(std::move(other.fd_)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (&other != this) {
+    Unmap();
+    fd_ = std::move(other.fd_);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { Unmap(); }
+
+void MappedFile::Unmap() noexcept {
+  if (!data_) return;
+  if (::munmap(data_, size_) == -1) {
+    LOG_ERROR() << "Failed to unmap file, errno=" << errno;
+  }
+  data_ = nullptr;
+  size_ = 0;
+}
+
+}  // namespace fs::blocking
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include <userver/fs/blocking/mapped_file.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using MappedFile = fs::blocking::MappedFile;
+
+TEST(MappedFile, Contents) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/foo";
+  fs::blocking::RewriteFileContents(path, "123456");
+
+  const auto file = MappedFile::Open(path);
+  EXPECT_EQ(file.GetView(), "123456");
+  EXPECT_EQ(file.GetSize(), 6);
+  EXPECT_NE(file.GetNative(), -1);
+}
+
+TEST(MappedFile, Empty) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/foo";
+  fs::blocking::RewriteFileContents(path, "");
+
+  const auto file = MappedFile::Open(path);
+  EXPECT_TRUE(file.GetView().empty());
+  EXPECT_EQ(file.GetSize(), 0);
+}
+
+TEST(MappedFile, Move) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/foo", "foo");
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/bar", "bar");
+
+  auto file = MappedFile::Open(dir.GetPath() + "/foo");
+  auto other = std::move(file);
+  EXPECT_EQ(other.GetView(), "foo");
+
+  other = MappedFile::Open(dir.GetPath() + "/bar");
+  EXPECT_EQ(other.GetView(), "bar");
+}
+
+TEST(MappedFile, NoFile) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  EXPECT_THROW(MappedFile::Open(dir.GetPath() + "/foo"), std::system_error);
+}
+
+USERVER_NAMESPACE_END
@@ -1,62 +1,126 @@
 #include <userver/http/parser/http_request_parse_args.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <stdexcept>
 
-#include <userver/utils/encoding/hex.hpp>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 USERVER_NAMESPACE_BEGIN
 
 namespace http::parser {
 
+namespace {
+
+bool IsEscape(char c) noexcept { return c == '%' || c == '+'; }
+
+// Returns the first '%' or '+', `end` if there are none
+const char* FindEscape(const char* begin, const char* end) noexcept {
+#ifdef __SSE2__
+  const auto percent = _mm_set1_epi8('%');
+  const auto plus = _mm_set1_epi8('+');
+  while (end - begin >= 16) {
+    const auto block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const auto is_escape = _mm_or_si128(_mm_cmpeq_epi8(block, percent),
+                                        _mm_cmpeq_epi8(block, plus));
+    const auto mask =
+        static_cast<std::uint32_t>(_mm_movemask_epi8(is_escape));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+    begin += 16;
+  }
+#endif
+
+  return std::find_if(begin, end, &IsEscape);
+}
+
+int HexValue(char c) noexcept {
+  if (c >= '0' && c <= '9') return c - '0';
+  c = static_cast<char>(c | 0x20);
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+[[noreturn]] void ThrowInvalidPercentEncoding(std::string_view url,
+                                              const char* ptr) {
+  static constexpr std::size_t kMaxOutputLength = 100;
+  std::string data_short{url.substr(0, kMaxOutputLength)};
+  if (url.size() > kMaxOutputLength) data_short += "<...>";
+  const auto percent_encoded_len =
+      std::min(static_cast<std::size_t>(url.data() + url.size() - ptr),
+               std::size_t{3});
+
+  throw std::runtime_error("invalid percent-encoding sequence '" +
+                           std::string(ptr, percent_encoded_len) +
+                           "\' in input '" + std::move(data_short) + '\'');
+}
+
+}  // namespace
+
 void ParseArgs(std::string_view args,
                std::unordered_map<std::string, std::vector<std::string>,
                                   utils::StrCaseHash>& result) {
-  ParseAndConsumeArgs(args, [&result](std::string key, std::string value) {
-    result[std::move(key)].push_back(std::move(value));
-  });
+  ParseAndConsumeArgViews(
+      args, [&result](std::string_view key, std::string_view value) {
+        result[std::string{key}].emplace_back(value);
+      });
 }
 
 std::string UrlDecode(std::string_view url) {
-  const auto* data = url.data();
-  const auto* data_end = url.data() + url.size();
-  // Fast path: no %, just id
-  if (!memchr(data, '%', data_end - data) &&
-      !memchr(data, '+', data_end - data)) {
-    return {data, data_end};
-  }
+  std::string result;
+  UrlDecode(url, result);
+  return result;
+}
 
-  std::string res;
-  for (const char* ptr = data; ptr < data_end; ++ptr) {
-    if (*ptr == '%') {
-      if (ptr + 2 < data_end &&
-          utils::encoding::FromHex({ptr + 1, 2}, res) == 2) {
-        ptr += 2;
-      } else {
-        static constexpr std::size_t kMaxOutputLength = 100;
-        std::string data_short(data, data_end - data);
-        if (data_short.size() > kMaxOutputLength) {
-          data_short = data_short.substr(0, kMaxOutputLength);
-          data_short += "<...>";
-        }
-        const auto percent_encoded_len =
-            std::min(static_cast<std::size_t>(data_end - ptr), std::size_t{3});
+void UrlDecode(std::string_view url, std::string& out) {
+  out.clear();
+  const auto* ptr = url.data();
+  const auto* const data_end = url.data() + url.size();
 
-        throw std::runtime_error("invalid percent-encoding sequence '" +
-                                 std::string(ptr, percent_encoded_len) +
-                                 "\' in input '" + std::move(data_short) +
-                                 '\'');
-      }
-    } else if (*ptr == '+') {
-      res += ' ';
-    } else {
-      res += *ptr;
+  // Copies the spans without escapes as a whole
+  for (;;) {
+    const auto* const escape = FindEscape(ptr, data_end);
+    out.append(ptr, escape);
+    if (escape == data_end) return;
+
+    ptr = escape;
+    if (*ptr == '+') {
+      out += ' ';
+      ++ptr;
+      continue;
     }
+
+    const int high = ptr + 2 < data_end ? HexValue(ptr[1]) : -1;
+    const int low = high >= 0 ? HexValue(ptr[2]) : -1;
+    if (low < 0) ThrowInvalidPercentEncoding(url, ptr);
+    out += static_cast<char>(high * 16 + low);
+    ptr += 3;
   }
-  return res;
 }
 
 void ParseAndConsumeArgs(std::string_view args, ArgsConsumer handler) {
+  ParseAndConsumeArgViews(
+      args, [&handler](std::string_view key, std::string_view value) {
+        handler(std::string{key}, std::string{value});
+      });
+}
+
+void ParseAndConsumeArgViews(std::string_view args, ArgViewsConsumer handler) {
+  std::string key_buffer;
+  std::string value_buffer;
+  const auto decode = [](std::string_view input,
+                         std::string& buffer) -> std::string_view {
+    if (FindEscape(input.data(), input.data() + input.size()) ==
+        input.data() + input.size()) {
+      return input;
+    }
+    UrlDecode(input, buffer);
+    return buffer;
+  };
+
   const char* end = args.data() + args.size();
   const char* key_begin = args.data();
   const char* key_end = args.data();
@@ -69,8 +133,7 @@ void ParseAndConsumeArgs(std::string_view args, ArgsConsumer handler) {
         if (key_begin < key_end && value_begin <= value_end) {
           std::string_view key(key_begin, key_end - key_begin);
           std::string_view value(value_begin, value_end - value_begin);
-          handler(USERVER_NAMESPACE::http::parser::UrlDecode(key),
-                  USERVER_NAMESPACE::http::parser::UrlDecode(value));
+          handler(decode(key, key_buffer), decode(value, value_buffer));
         }
       }
       parse_key = true;
@@ -12,34 +12,39 @@ namespace {
 
 const std::string_view kSchemaSeparator = "://";
 
+constexpr std::array<bool, 256> MakeUnreservedTable() {
+  std::array<bool, 256> table{};
+  for (int c = '0'; c <= '9'; ++c) table[c] = true;
+  for (int c = 'a'; c <= 'z'; ++c) table[c] = true;
+  for (int c = 'A'; c <= 'Z'; ++c) table[c] = true;
+  for (const char c : std::string_view{"-_.!~*()'"}) {
+    table[static_cast<unsigned char>(c)] = true;
+  }
+  return table;
+}
+
+constexpr std::array<bool, 256> kUnreserved = MakeUnreservedTable();
+
+constexpr std::string_view kHexDigits = "0123456789ABCDEF";
+
+// Appends the encoded `input_string` to `result`
 void UrlEncodeTo(std::string_view input_string, std::string& result) {
-  for (char symbol : input_string) {
-    if (isalnum(symbol)) {
-      result.append(1, symbol);
-      continue;
-    }
-    switch (symbol) {
-      case '-':
-      case '_':
-      case '.':
-      case '!':
-      case '~':
-      case '*':
-      case '(':
-      case ')':
-      case '\'':
-        result.append(1, symbol);
-        break;
-      default:
-        std::array<char, 3> bytes = {'%', 0, 0};
-        bytes[1] = (symbol & 0xF0) / 16;
-        bytes[1] += (bytes[1] > 9) ? 'A' - 10 : '0';
-        bytes[2] = symbol & 0x0F;
-        bytes[2] += (bytes[2] > 9) ? 'A' - 10 : '0';
-        result.append(bytes.data(), bytes.size());
-        break;
+  const auto old_size = result.size();
+  result.resize(old_size + 3 * input_string.size());
+  char* dst = result.data() + old_size;
+
+  for (const char symbol : input_string) {
+    const auto byte = static_cast<unsigned char>(symbol);
+    if (kUnreserved[byte]) {
+      *dst++ = symbol;
+    } else {
+      dst[0] = '%';
+      dst[1] = kHexDigits[byte >> 4];
+      dst[2] = kHexDigits[byte & 0x0F];
+      dst += 3;
     }
   }
+  result.resize(dst - result.data());
 }
 
 }  // namespace
@@ -52,6 +57,11 @@ std::string UrlEncode(std::string_view input_string) {
   return result;
 }
 
+void UrlEncode(std::string_view input_string, std::string& out) {
+  out.clear();
+  UrlEncodeTo(input_string, out);
+}
+
 std::string UrlDecode(std::string_view range) {
   return impl::UrlDecode(utils::impl::InternalTag{}, range);
 }
@@ -94,13 +104,19 @@ std::string DoMakeQuery(T begin, T end) {
 }
 
 template <typename T>
-std::string MakeUrl(std::string_view path, T begin, T end) {
-  std::string result;
+void MakeUrlTo(std::string_view path, T begin, T end, std::string& result) {
+  result.clear();
   result.reserve(path.size() + 1 + GetInitialQueryCapacity(begin, end));
 
   result.append(path);
   result.append(1, '?');
   DoMakeQueryTo(begin, end, result);
+}
+
+template <typename T>
+std::string MakeUrl(std::string_view path, T begin, T end) {
+  std::string result;
+  MakeUrlTo(path, begin, end, result);
   return result;
 }
 
@@ -131,6 +147,14 @@ std::string MakeUrl(
   return MakeUrl(path, query_args.begin(), query_args.end());
 }
 
+void MakeUrl(
+    std::string_view path,
+    std::initializer_list<std::pair<std::string_view, std::string_view>>
+        query_args,
+    std::string& out) {
+  MakeUrlTo(path, query_args.begin(), query_args.end(), out);
+}
+
 std::string MakeQuery(const Args& query_args) {
   return DoMakeQuery(query_args.begin(), query_args.end());
 }
@@ -146,6 +170,15 @@ std::string MakeQuery(
   return DoMakeQuery(query_args.begin(), query_args.end());
 }
 
+void MakeQuery(
+    std::initializer_list<std::pair<std::string_view, std::string_view>>
+        query_args,
+    std::string& out) {
+  out.clear();
+  out.reserve(GetInitialQueryCapacity(query_args.begin(), query_args.end()));
+  DoMakeQueryTo(query_args.begin(), query_args.end(), out);
+}
+
 std::string ExtractMetaTypeFromUrl(const std::string& url) {
   auto pos = url.find('?');
   if (pos == std::string::npos) return url;
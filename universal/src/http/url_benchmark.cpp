@@ -26,6 +26,18 @@ BENCHMARK(make_url_small);
 void make_url_big(benchmark::State& state) { make_url(state, 5000); }
 BENCHMARK(make_url_big);
 
+void make_url_to_buffer(benchmark::State& state) {
+  const std::string path = "http://example.com/v1/something";
+  const std::string latins(50, 'a');
+  const std::string latins_with_spaces = std::string(50, ' ') + latins;
+  std::string buffer;
+  for ([[maybe_unused]] auto _ : state) {
+    http::MakeUrl(path, {{"a", latins}, {"c", latins_with_spaces}}, buffer);
+    benchmark::DoNotOptimize(buffer);
+  }
+}
+BENCHMARK(make_url_to_buffer);
+
 void make_query(benchmark::State& state) {
   http::Args query_args;
   const auto agrs_count = state.range(0);
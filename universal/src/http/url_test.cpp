@@ -29,6 +29,18 @@ TEST(UrlEncode, Special) {
   EXPECT_EQ("Text%20with%20spaces%2C%3F%26%3D", UrlEncode(str));
 }
 
+TEST(UrlEncode, NonAscii) {
+  EXPECT_EQ("%D0%AF%00%FF", UrlEncode(std::string_view{"\xD0\xAF\0\xFF", 4}));
+}
+
+TEST(UrlEncode, ToBuffer) {
+  std::string buffer = "garbage";
+  UrlEncode("a b", buffer);
+  EXPECT_EQ("a%20b", buffer);
+  UrlEncode("", buffer);
+  EXPECT_EQ("", buffer);
+}
+
 TEST(UrlDecode, Empty) { EXPECT_EQ("", UrlDecode("")); }
 
 TEST(UrlDecode, Latin) {
@@ -77,6 +89,15 @@ TEST(MakeUrl, QueryAndMultiquery) {
             http::MakeUrl("path", {{"k", "v"}}, {{"a", "b"}, {"a", "c"}}));
 }
 
+TEST(MakeUrl, ToBuffer) {
+  std::string buffer = "garbage";
+  http::MakeUrl("path", {{"a", "b c"}, {"d", ""}}, buffer);
+  EXPECT_EQ("path?a=b%20c&d=", buffer);
+
+  http::MakeQuery({{"k", "v"}}, buffer);
+  EXPECT_EQ("k=v", buffer);
+}
+
 TEST(ExtractMetaTypeFromUrl, Empty) {
   EXPECT_EQ("", http::ExtractMetaTypeFromUrl(""));
 }
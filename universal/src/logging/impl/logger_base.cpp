@@ -2,6 +2,8 @@
 
 #include <userver/logging/impl/tag_writer.hpp>
 
+#include <logging/log_helper_impl.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
@@ -10,6 +12,12 @@ LoggerBase::LoggerBase(Format format) noexcept : format_(format) {}
 
 LoggerBase::~LoggerBase() = default;
 
+void LoggerBase::LogDeferred(Level level, std::string_view record) {
+  LogBuffer buffer;
+  RenderDeferredRecord(GetFormat(), level, record, buffer);
+  Log(level, std::string_view{buffer.data(), buffer.size()});
+}
+
 void LoggerBase::Flush() {}
 
 void LoggerBase::PrependCommonTags(TagWriter /*writer*/) const {}
@@ -30,6 +38,14 @@ bool LoggerBase::ShouldFlush(Level level) const {
   return flush_level_ <= level;
 }
 
+void LoggerBase::SetFormattingDeferred(bool is_deferred) noexcept {
+  is_formatting_deferred_ = is_deferred;
+}
+
+bool LoggerBase::IsFormattingDeferred() const noexcept {
+  return is_formatting_deferred_;
+}
+
 bool LoggerBase::DoShouldLog(Level /*level*/) const noexcept { return true; }
 
 bool ShouldLogNoSpan(const LoggerBase& logger, Level level) noexcept {
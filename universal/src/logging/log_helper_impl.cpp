@@ -1,5 +1,8 @@
 #include "log_helper_impl.hpp"
 
+#include <cstdint>
+#include <cstring>
+
 #include <fmt/chrono.h>
 #include <fmt/compile.h>
 #include <fmt/format.h>
@@ -55,6 +58,78 @@ std::string_view GetCurrentTimeString(TimePoint now) noexcept {
   return {cached_time_string, kTemplate.size()};
 }
 
+using DeferredSize = std::uint32_t;
+using DeferredTimestamp = std::int64_t;
+
+template <typename T>
+void AppendTrivial(LogBuffer& buffer, T value) {
+  const auto old_size = buffer.size();
+  buffer.resize(old_size + sizeof(T));
+  std::memcpy(buffer.data() + old_size, &value, sizeof(T));
+}
+
+template <typename T>
+T ExtractTrivial(std::string_view& record) {
+  UINVARIANT(record.size() >= sizeof(T), "Truncated deferred log record");
+  T value{};
+  std::memcpy(&value, record.data(), sizeof(T));
+  record.remove_prefix(sizeof(T));
+  return value;
+}
+
+std::string_view ExtractSizePrefixed(std::string_view& record) {
+  const auto size = ExtractTrivial<DeferredSize>(record);
+  UINVARIANT(record.size() >= size, "Truncated deferred log record");
+  const auto result = record.substr(0, size);
+  record.remove_prefix(size);
+  return result;
+}
+
+void PutHeader(Format format, Level level, TimePoint now, LogBuffer& msg) {
+  switch (format) {
+    case Format::kTskv: {
+      constexpr std::string_view kTemplate =
+          "tskv\ttimestamp=0000-00-00T00:00:00.000000\tlevel=";
+      const auto level_string = logging::ToUpperCaseString(level);
+      const auto old_size = msg.size();
+      msg.resize(old_size + kTemplate.size() + level_string.size());
+      fmt::format_to(
+          msg.data() + old_size,
+          FMT_COMPILE("tskv\ttimestamp={}.{:06}\tlevel={}"),
+          GetCurrentTimeString(now), FractionalMicroseconds(now), level_string);
+      return;
+    }
+    case Format::kLtsv: {
+      constexpr std::string_view kTemplate =
+          "timestamp:0000-00-00T00:00:00.000000\tlevel:";
+      const auto level_string = logging::ToUpperCaseString(level);
+      const auto old_size = msg.size();
+      msg.resize(old_size + kTemplate.size() + level_string.size());
+      fmt::format_to(msg.data() + old_size,
+                     FMT_COMPILE("timestamp:{}.{:06}\tlevel:{}"),
+                     GetCurrentTimeString(now), FractionalMicroseconds(now),
+                     level_string);
+      return;
+    }
+    case Format::kRaw: {
+      msg.append(std::string_view{"tskv"});
+      return;
+    }
+  }
+  UASSERT_MSG(false, "Invalid value of Format enum");
+}
+
+void PutEscapedKey(LogBuffer& msg, std::string_view key, char separator) {
+  msg.push_back(utils::encoding::kTskvPairsSeparator);
+  if (!utils::encoding::ShouldKeyBeEscaped(key)) {
+    msg.append(key);
+  } else {
+    utils::encoding::EncodeTskv(
+        msg, key, utils::encoding::EncodeTskvMode::kKeyReplacePeriod);
+  }
+  msg.push_back(separator);
+}
+
 }  // namespace
 
 auto LogHelper::Impl::BufferStd::overflow(int_type c) -> int_type {
@@ -72,7 +147,8 @@ std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s,
 LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
     : logger_(&logger),
       level_(std::max(level, logger_->GetLevel())),
-      key_value_separator_(GetSeparatorFromLogger(*logger_)) {
+      key_value_separator_(GetSeparatorFromLogger(*logger_)),
+      is_deferred_(logger_->IsFormattingDeferred()) {
   static_assert(sizeof(LogHelper::Impl) < 4096,
                 "Structures with size more than 4096 would consume at least "
                 "8KB memory in allocator.");
@@ -84,41 +160,26 @@ LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
 void LogHelper::Impl::PutMessageBegin() {
   UASSERT(msg_.size() == 0);
 
-  switch (logger_->GetFormat()) {
-    case Format::kTskv: {
-      constexpr std::string_view kTemplate =
-          "tskv\ttimestamp=0000-00-00T00:00:00.000000\tlevel=";
-      const auto now = TimePoint::clock::now();
-      const auto level_string = logging::ToUpperCaseString(level_);
-      msg_.resize(kTemplate.size() + level_string.size());
-      fmt::format_to(
-          msg_.data(), FMT_COMPILE("tskv\ttimestamp={}.{:06}\tlevel={}"),
-          GetCurrentTimeString(now), FractionalMicroseconds(now), level_string);
-      return;
-    }
-    case Format::kLtsv: {
-      constexpr std::string_view kTemplate =
-          "timestamp:0000-00-00T00:00:00.000000\tlevel:";
-      const auto now = TimePoint::clock::now();
-      const auto level_string = logging::ToUpperCaseString(level_);
-      msg_.resize(kTemplate.size() + level_string.size());
-      fmt::format_to(msg_.data(), FMT_COMPILE("timestamp:{}.{:06}\tlevel:{}"),
-                     GetCurrentTimeString(now), FractionalMicroseconds(now),
-                     level_string);
-      return;
-    }
-    case Format::kRaw: {
-      msg_.append(std::string_view{"tskv"});
-      return;
-    }
+  const auto now = TimePoint::clock::now();
+  if (is_deferred_) {
+    AppendTrivial<DeferredTimestamp>(
+        msg_, std::chrono::duration_cast<std::chrono::microseconds>(
+                  now.time_since_epoch())
+                  .count());
+    return;
   }
-  UASSERT_MSG(false, "Invalid value of Format enum");
+  PutHeader(logger_->GetFormat(), level_, now, msg_);
 }
 
-void LogHelper::Impl::PutMessageEnd() { msg_.push_back('\n'); }
+void LogHelper::Impl::PutMessageEnd() {
+  if (is_deferred_) return;
+  msg_.push_back('\n');
+}
 
 void LogHelper::Impl::PutKey(std::string_view key) {
-  if (!utils::encoding::ShouldKeyBeEscaped(key)) {
+  if (is_deferred_) {
+    PutDeferredKey(key);
+  } else if (!utils::encoding::ShouldKeyBeEscaped(key)) {
     PutRawKey(key);
   } else {
     UASSERT(!std::exchange(is_within_value_, true));
@@ -131,6 +192,11 @@ void LogHelper::Impl::PutKey(std::string_view key) {
 }
 
 void LogHelper::Impl::PutRawKey(std::string_view key) {
+  if (is_deferred_) {
+    PutDeferredKey(key);
+    return;
+  }
+
   UASSERT(!std::exchange(is_within_value_, true));
   CheckRepeatedKeys(key);
   const auto old_size = msg_.size();
@@ -143,14 +209,32 @@ void LogHelper::Impl::PutRawKey(std::string_view key) {
   *(position++) = key_value_separator_;
 }
 
+void LogHelper::Impl::PutDeferredKey(std::string_view key) {
+  UASSERT(!std::exchange(is_within_value_, true));
+  CheckRepeatedKeys(key);
+  AppendTrivial(msg_, static_cast<DeferredSize>(key.size()));
+  msg_.append(key);
+  // The size of the value is filled in MarkValueEnd
+  value_size_position_ = msg_.size();
+  AppendTrivial(msg_, DeferredSize{0});
+}
+
 void LogHelper::Impl::PutValuePart(std::string_view value) {
   UASSERT(is_within_value_);
+  if (is_deferred_) {
+    msg_.append(value);
+    return;
+  }
   utils::encoding::EncodeTskv(msg_, value,
                               utils::encoding::EncodeTskvMode::kValue);
 }
 
 void LogHelper::Impl::PutValuePart(char text_part) {
   UASSERT(is_within_value_);
+  if (is_deferred_) {
+    msg_.push_back(text_part);
+    return;
+  }
   utils::encoding::EncodeTskv(fmt::appender(msg_), text_part,
                               utils::encoding::EncodeTskvMode::kValue);
 }
@@ -162,6 +246,12 @@ LogBuffer& LogHelper::Impl::GetBufferForRawValuePart() noexcept {
 
 void LogHelper::Impl::MarkValueEnd() noexcept {
   UASSERT(std::exchange(is_within_value_, false));
+  if (is_deferred_) {
+    const auto value_size = static_cast<DeferredSize>(
+        msg_.size() - value_size_position_ - sizeof(DeferredSize));
+    std::memcpy(msg_.data() + value_size_position_, &value_size,
+                sizeof(value_size));
+  }
 }
 
 void LogHelper::Impl::StartText() {
@@ -184,7 +274,11 @@ void LogHelper::Impl::LogTheMessage() const {
 
   UASSERT(logger_);
   const std::string_view message(msg_.data(), msg_.size());
-  logger_->Log(level_, message);
+  if (is_deferred_) {
+    logger_->LogDeferred(level_, message);
+  } else {
+    logger_->Log(level_, message);
+  }
 }
 
 void LogHelper::Impl::MarkAsBroken() noexcept { logger_ = nullptr; }
@@ -197,6 +291,29 @@ void LogHelper::Impl::CheckRepeatedKeys(
               fmt::format("Repeated tag in logs: '{}'", raw_key));
 }
 
+namespace impl {
+
+void RenderDeferredRecord(Format format, Level level, std::string_view record,
+                          LogBuffer& out) {
+  const auto timestamp = ExtractTrivial<DeferredTimestamp>(record);
+  PutHeader(format, level,
+            TimePoint{std::chrono::duration_cast<TimePoint::duration>(
+                std::chrono::microseconds{timestamp})},
+            out);
+
+  const char separator = format == Format::kLtsv ? ':' : '=';
+  while (!record.empty()) {
+    const auto key = ExtractSizePrefixed(record);
+    const auto value = ExtractSizePrefixed(record);
+    PutEscapedKey(out, key, separator);
+    utils::encoding::EncodeTskv(out, value,
+                                utils::encoding::EncodeTskvMode::kValue);
+  }
+  out.push_back('\n');
+}
+
+}  // namespace impl
+
 }  // namespace logging
 
 USERVER_NAMESPACE_END
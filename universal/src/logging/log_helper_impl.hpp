@@ -6,6 +6,7 @@
 
 #include <fmt/format.h>
 
+#include <userver/logging/format.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/log_extra.hpp>
@@ -78,17 +79,33 @@ class LogHelper::Impl final {
 
   void CheckRepeatedKeys(std::string_view raw_key);
 
+  void PutDeferredKey(std::string_view key);
+
   impl::LoggerBase* logger_;
   const Level level_;
   const char key_value_separator_;
+  const bool is_deferred_;
   LogBuffer msg_;
   std::optional<LazyInitedStream> lazy_stream_;
   LogExtra extra_;
   std::size_t initial_length_{0};
   bool is_within_value_{false};
+  std::size_t value_size_position_{0};
   std::optional<std::unordered_set<std::string>> debug_tag_keys_;
 };
 
+namespace impl {
+
+/// @brief Renders a record, that was written by LogHelper for a logger with
+/// deferred formatting, in the `format`.
+///
+/// The record consists of the timestamp followed by the size-prefixed
+/// unescaped keys and values of the tags.
+void RenderDeferredRecord(Format format, Level level, std::string_view record,
+                          LogBuffer& out);
+
+}  // namespace impl
+
 }  // namespace logging
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,43 @@
+#include <userver/utils/blocked_bloom_filter.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(BlockedBloomFilter, NoFalseNegatives) {
+  constexpr int kItems = 10000;
+  utils::BlockedBloomFilter<int> filter(kItems);
+  for (int i = 0; i < kItems; ++i) filter.Add(i);
+
+  for (int i = 0; i < kItems; ++i) {
+    EXPECT_TRUE(filter.MayContain(i)) << i;
+  }
+}
+
+TEST(BlockedBloomFilter, FalsePositiveRate) {
+  constexpr int kItems = 10000;
+  utils::BlockedBloomFilter<std::string> filter(kItems);
+  for (int i = 0; i < kItems; ++i) filter.Add(std::to_string(i));
+
+  int false_positives = 0;
+  for (int i = kItems; i < 2 * kItems; ++i) {
+    false_positives += filter.MayContain(std::to_string(i));
+  }
+  // about 1% with the default 12 bits per item
+  EXPECT_LT(false_positives, kItems / 30);
+}
+
+TEST(BlockedBloomFilter, Clear) {
+  utils::BlockedBloomFilter<int> filter(0);
+  EXPECT_FALSE(filter.MayContain(42));
+  filter.Add(42);
+  EXPECT_TRUE(filter.MayContain(42));
+  EXPECT_EQ(filter.GetSizeBytes(), 64U);
+
+  filter.Clear();
+  EXPECT_FALSE(filter.MayContain(42));
+}
+
+USERVER_NAMESPACE_END
@@ -2,7 +2,6 @@
 
 #include <array>
 
-#include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
@@ -105,9 +104,13 @@ boost::uuids::uuid FromChars(const char* begin, const char* end) {
 namespace generators {
 
 boost::uuids::uuid GenerateBoostUuid() {
-  thread_local boost::uuids::basic_random_generator<RandomBase> generator(
-      DefaultRandom());
-  return generator();
+  boost::uuids::uuid uuid{};
+  impl::FillRandomBytes(uuid.data, uuid.size());
+
+  // version 4, variant 10xx as in RFC 9562
+  uuid.data[6] = (uuid.data[6] & 0x0f) | 0x40;
+  uuid.data[8] = (uuid.data[8] & 0x3f) | 0x80;
+  return uuid;
 }
 
 }  // namespace generators
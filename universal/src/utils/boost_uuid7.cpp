@@ -0,0 +1,33 @@
+#include <userver/utils/boost_uuid7.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::generators {
+
+boost::uuids::uuid GenerateBoostUuidV7() {
+  boost::uuids::uuid uuid{};
+  impl::FillRandomBytes(uuid.data + 6, uuid.size() - 6);
+
+  const auto unix_ts_ms = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+  // big-endian 48-bit timestamp
+  for (int i = 0; i < 6; ++i) {
+    uuid.data[i] = static_cast<std::uint8_t>(unix_ts_ms >> (40 - 8 * i));
+  }
+
+  // version 7, variant 10xx as in RFC 9562
+  uuid.data[6] = (uuid.data[6] & 0x0f) | 0x70;
+  uuid.data[8] = (uuid.data[8] & 0x3f) | 0x80;
+  return uuid;
+}
+
+}  // namespace utils::generators
+
+USERVER_NAMESPACE_END
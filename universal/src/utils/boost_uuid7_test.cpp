@@ -0,0 +1,43 @@
+#include <userver/utils/boost_uuid7.hpp>
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/boost_uuid4.hpp>
+#include <userver/utils/uuid7.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(UUIDv7, VersionAndVariant) {
+  const auto uuid = utils::generators::GenerateBoostUuidV7();
+  EXPECT_EQ(uuid.data[6] >> 4, 7);
+  EXPECT_EQ(uuid.variant(), boost::uuids::uuid::variant_rfc_4122);
+
+  const auto uuid4 = utils::generators::GenerateBoostUuid();
+  EXPECT_EQ(uuid4.version(), boost::uuids::uuid::version_random_number_based);
+  EXPECT_EQ(uuid4.variant(), boost::uuids::uuid::variant_rfc_4122);
+}
+
+TEST(UUIDv7, TimeOrdered) {
+  const auto first = utils::generators::GenerateBoostUuidV7();
+  const auto first_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now().time_since_epoch());
+  // wait for the next millisecond
+  while (std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch()) == first_ms) {
+  }
+  const auto second = utils::generators::GenerateBoostUuidV7();
+
+  EXPECT_LT(first, second);
+  EXPECT_LT(utils::ToString(first), utils::ToString(second));
+}
+
+TEST(UUIDv7, String) {
+  constexpr unsigned kUuidLength = 32;
+  EXPECT_EQ(utils::generators::GenerateUuidV7().size(), kUuidLength);
+  EXPECT_NE(utils::generators::GenerateUuidV7(),
+            utils::generators::GenerateUuidV7());
+}
+
+USERVER_NAMESPACE_END
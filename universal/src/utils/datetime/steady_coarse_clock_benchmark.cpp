@@ -2,6 +2,10 @@
 
 #include <chrono>
 
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
 #include <benchmark/benchmark.h>
 
 USERVER_NAMESPACE_BEGIN
@@ -20,4 +24,21 @@ void steady_coarse_clock_benchmark(benchmark::State& state) {
 }
 BENCHMARK(steady_coarse_clock_benchmark);
 
+void steady_coarse_clock_resolution_benchmark(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(utils::datetime::SteadyCoarseClock::resolution());
+  }
+}
+BENCHMARK(steady_coarse_clock_resolution_benchmark);
+
+#if defined(__x86_64__)
+// The lower bound for a TSC based clock, without the conversion to time
+void rdtsc_benchmark(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(__rdtsc());
+  }
+}
+BENCHMARK(rdtsc_benchmark);
+#endif
+
 USERVER_NAMESPACE_END
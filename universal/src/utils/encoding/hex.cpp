@@ -5,6 +5,8 @@
 
 #ifdef __SSSE3__
 #include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
 #endif
 
 USERVER_NAMESPACE_BEGIN
@@ -111,6 +113,37 @@ const auto kDigitsMask = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
                                        '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
 #endif
 
+#ifdef __SSE2__
+__m128i InRange(__m128i chars, char first, char last) noexcept {
+  return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(first - 1)),
+                       _mm_cmpgt_epi8(_mm_set1_epi8(last + 1), chars));
+}
+
+/// Converts 16 xDigits into 8 bytes stored in the lower half of `result`.
+/// Returns false if some of the chars are not xDigits.
+bool DecodeXDigits(__m128i chars, __m128i& result) noexcept {
+  const auto is_digit = InRange(chars, '0', '9');
+  // 'A'..'F' become 'a'..'f', the digits are not changed
+  const auto lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+  const auto is_letter = InRange(lower, 'a', 'f');
+  if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff) {
+    return false;
+  }
+
+  const auto values = _mm_or_si128(
+      _mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+      _mm_and_si128(is_letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+
+  // Each 16-bit lane holds the high 4 bits in the lower byte and the low
+  // 4 bits in the higher byte
+  const auto bytes = _mm_or_si128(
+      _mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0xff)), 4),
+      _mm_srli_epi16(values, 8));
+  result = _mm_packus_epi16(bytes, bytes);
+  return true;
+}
+#endif
+
 }  // namespace detail
 
 std::string_view GetHexPart(std::string_view encoded) noexcept {
@@ -190,6 +223,25 @@ size_t FromHex(std::string_view encoded, std::string& out) noexcept {
   const char* first = encoded.data();
   const char* pair_ptr = first;
   const char* last = first + encoded.size();
+
+  const auto old_size = out.size();
+  out.resize(old_size + encoded.size() / 2);
+  auto* dst = out.data() + old_size;
+
+#ifdef __SSE2__
+  while (last - pair_ptr >= 16) {
+    __m128i bytes;
+    const auto chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pair_ptr));
+    // the scalar loop finds where the hex data ends
+    if (!detail::DecodeXDigits(chars, bytes)) break;
+
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), bytes);
+    pair_ptr += 16;
+    dst += 8;
+  }
+#endif
+
   for (; pair_ptr != last; pair_ptr += 2) {
     if (!detail::IsXDigit(pair_ptr[0])) {
       break;
@@ -203,10 +255,11 @@ size_t FromHex(std::string_view encoded, std::string& out) noexcept {
       break;
     }
 
-    out.push_back((detail::GetXDigitValue(pair_ptr[0]) << 4) |
-                  (detail::GetXDigitValue(pair_ptr[1])));
+    *(dst++) = (detail::GetXDigitValue(pair_ptr[0]) << 4) |
+               (detail::GetXDigitValue(pair_ptr[1]));
   }
 
+  out.resize(static_cast<size_t>(dst - out.data()));
   return static_cast<size_t>(std::distance(first, pair_ptr));
 }
 
@@ -104,6 +104,25 @@ TEST(Hex, FromHex) {
   }
 }
 
+TEST(Hex, FromHexLong) {
+  constexpr std::string_view data{"32316533306339326166653534333936"};
+  constexpr std::string_view reference{"21e30c92afe54396"};
+  EXPECT_EQ(reference, FromHex(data));
+
+  const std::string mixed_case{"3231653330633932AFFE5A3433393600"};
+  EXPECT_EQ(std::string_view("21e30c92\xaf\xfeZ4396\0", 16),
+            FromHex(mixed_case));
+
+  // A wrong symbol at each position of the vectorized blocks
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    std::string corrupted{data};
+    corrupted[i] = 'g';
+    std::string result;
+    EXPECT_EQ(i / 2 * 2, FromHex(corrupted, result));
+    EXPECT_EQ(reference.substr(0, i / 2), result);
+  }
+}
+
 TEST(Hex, GetHexPart) {
   // Test simple case - everything is correct
   {
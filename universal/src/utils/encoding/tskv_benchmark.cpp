@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <userver/utils/encoding/tskv.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// A log message with an escaped char once in a while
+std::string GenerateSource(std::size_t size) {
+  std::string source;
+  source.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    source.push_back(i % 100 == 99 ? '\t' : static_cast<char>('a' + i % 26));
+  }
+  return source;
+}
+
+}  // namespace
+
+void tskv_encode_value_benchmark(benchmark::State& state) {
+  const auto source = GenerateSource(state.range(0));
+  std::string out;
+
+  for ([[maybe_unused]] auto _ : state) {
+    out.clear();
+    utils::encoding::EncodeTskv(out, source,
+                                utils::encoding::EncodeTskvMode::kValue);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(tskv_encode_value_benchmark)->RangeMultiplier(8)->Range(8, 32 << 10);
+
+void tskv_encode_key_benchmark(benchmark::State& state) {
+  const auto source = GenerateSource(state.range(0));
+  std::string out;
+
+  for ([[maybe_unused]] auto _ : state) {
+    out.clear();
+    utils::encoding::EncodeTskv(out, source,
+                                utils::encoding::EncodeTskvMode::kKey);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(tskv_encode_key_benchmark)->RangeMultiplier(8)->Range(8, 4 << 10);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,59 @@
+#include <userver/utils/huge_page_allocator.hpp>
+
+#include <sys/mman.h>
+
+#include <cstdint>
+#include <new>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+namespace {
+
+std::size_t RoundUpToHugePage(std::size_t bytes) noexcept {
+  return (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+}
+
+}  // namespace
+
+void* AllocateHugePages(std::size_t bytes) {
+  const auto size = RoundUpToHugePage(bytes);
+  // mmap only guarantees the page alignment, map one more huge page and
+  // trim the unaligned head and tail
+  const auto mapped_size = size + kHugePageSize;
+  void* mapped = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) throw std::bad_alloc{};
+
+  const auto begin = reinterpret_cast<std::uintptr_t>(mapped);
+  const auto aligned = (begin + kHugePageSize - 1) / kHugePageSize *
+                       kHugePageSize;
+  const auto head = aligned - begin;
+  const auto tail = kHugePageSize - head;
+  if (head != 0) ::munmap(mapped, head);
+  if (tail != 0) ::munmap(reinterpret_cast<void*>(aligned + size), tail);
+
+  auto* result = reinterpret_cast<void*>(aligned);
+  AdviseHugePages(result, size);
+  return result;
+}
+
+void DeallocateHugePages(void* ptr, std::size_t bytes) noexcept {
+  [[maybe_unused]] const auto res = ::munmap(ptr, RoundUpToHugePage(bytes));
+  UASSERT_MSG(res == 0, "Failed to unmap huge pages");
+}
+
+void AdviseHugePages([[maybe_unused]] void* ptr,
+                     [[maybe_unused]] std::size_t bytes) noexcept {
+#ifdef MADV_HUGEPAGE
+  // Fails on kernels without THP, the memory is still usable
+  ::madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
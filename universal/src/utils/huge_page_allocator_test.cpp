@@ -0,0 +1,51 @@
+#include <userver/utils/huge_page_allocator.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+bool IsHugePageAligned(const void* ptr) {
+  return reinterpret_cast<std::uintptr_t>(ptr) %
+             utils::impl::kHugePageSize ==
+         0;
+}
+
+}  // namespace
+
+TEST(HugePageAllocator, Sample) {
+  constexpr std::size_t kValuesCount = 1'000'000;
+
+  /// [Sample HugePageAllocator]
+  std::vector<std::uint64_t, utils::HugePageAllocator<std::uint64_t>> values;
+  values.reserve(kValuesCount);
+  for (std::size_t i = 0; i < kValuesCount; ++i) {
+    values.push_back(i);
+  }
+  /// [Sample HugePageAllocator]
+
+  EXPECT_TRUE(IsHugePageAligned(values.data()));
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), std::uint64_t{0}),
+            kValuesCount * (kValuesCount - 1) / 2);
+}
+
+TEST(HugePageAllocator, Small) {
+  std::vector<int, utils::HugePageAllocator<int>> values(100, 42);
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 4200);
+}
+
+TEST(HugePageAllocator, Reallocation) {
+  std::vector<char, utils::HugePageAllocator<char>> values;
+  for (std::size_t i = 0; i < 3 * utils::impl::kHugePageSize; ++i) {
+    values.push_back(static_cast<char>(i));
+  }
+  EXPECT_TRUE(IsHugePageAligned(values.data()));
+  EXPECT_EQ(values[utils::impl::kHugePageSize + 1], 1);
+}
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 #include <emmintrin.h>
 #endif
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <limits>
@@ -20,6 +21,25 @@ inline std::uint64_t RotateLeft(std::uint64_t x, std::uint64_t b) noexcept {
   return (x << b) | (x >> (64UL - b));
 }
 
+// Sets the 6-th bit of the bytes in ['A'; 'Z'], SIMD within a register.
+// Adding a constant to the 7 lower bits of a byte carries into its 8-th bit
+// iff the byte is not less than the bound, no carry crosses the bytes. The
+// bytes with the 8-th bit set are not ASCII letters.
+inline std::uint64_t LowercaseSwar(std::uint64_t value) noexcept {
+  constexpr std::uint64_t kOnes = 0x0101010101010101ULL;
+  constexpr std::uint64_t kHighBits = kOnes * 0x80;
+
+  const auto heptets = value & ~kHighBits;
+  const auto is_ge_a = heptets + kOnes * (0x80 - 'A');
+  const auto is_gt_z = heptets + kOnes * (0x7f - 'Z');
+  const auto is_upper = (is_ge_a ^ is_gt_z) & ~value & kHighBits;
+  return value | (is_upper >> 2);
+}
+
+inline const std::uint8_t* ToBytes(std::string_view data) noexcept {
+  return reinterpret_cast<const std::uint8_t*>(data.data());
+}
+
 struct CaseFetcher final {
   static inline std::uint64_t Fetch8(const std::uint8_t* data) noexcept {
     std::uint64_t result{};
@@ -38,44 +58,32 @@ struct CaseFetcher final {
                                      std::size_t n) noexcept {
     UASSERT(n < 8);
 
-    std::uint64_t res = 0;
-    // n is always <= 7 by algorithm construction
-    // NOLINTNEXTLINE(hicpp-multiway-paths-covered)
-    switch (n) {
-      case 7:
-        res |= static_cast<std::uint64_t>(data[6]) << 48;
-        [[fallthrough]];
-      case 6:
-        res |= static_cast<std::uint64_t>(data[5]) << 40;
-        [[fallthrough]];
-      case 5:
-        res |= static_cast<std::uint64_t>(data[4]) << 32;
-        [[fallthrough]];
-      case 4:
-        res |= static_cast<std::uint64_t>(data[3]) << 24;
-        [[fallthrough]];
-      case 3:
-        res |= static_cast<std::uint64_t>(data[2]) << 16;
-        [[fallthrough]];
-      case 2:
-        res |= static_cast<std::uint64_t>(data[1]) << 8;
-        [[fallthrough]];
-      case 1: {
-        res |= static_cast<std::uint64_t>(data[0]);
-        break;
-      }
-      case 0:
-        break;
+    // Two overlapping loads instead of a byte per case of a switch, the
+    // overlapping bytes are the same and OR-ing them is harmless
+    if (n >= 4) {
+      const std::uint64_t high = Fetch4(data + n - 4);
+      return Fetch4(data) | (high << ((n - 4) * 8));
     }
+    if (n == 0) return 0;
+    return static_cast<std::uint64_t>(data[0]) |
+           (static_cast<std::uint64_t>(data[n / 2]) << ((n / 2) * 8)) |
+           (static_cast<std::uint64_t>(data[n - 1]) << ((n - 1) * 8));
+  }
 
-    return res;
+ private:
+  static inline std::uint32_t Fetch4(const std::uint8_t* data) noexcept {
+    std::uint32_t result{};
+    std::memcpy(&result, data, 4);
+    return result;
   }
 };
 
 #ifdef __SSE2__
 struct CaseInsensitiveSSEFetcher final {
+  // Lowercasing within a register is faster than a round trip through SSE
+  // registers for 8 bytes and less
   static inline std::uint64_t Fetch8(const std::uint8_t* data) noexcept {
-    return LowercaseBytes(Load8(data)).first;
+    return LowercaseSwar(CaseFetcher::Fetch8(data));
   }
 
   static inline std::pair<std::uint64_t, std::uint64_t> Fetch16(
@@ -85,10 +93,7 @@ struct CaseInsensitiveSSEFetcher final {
 
   static inline std::uint64_t FetchN(const std::uint8_t* data,
                                      std::size_t n) noexcept {
-    const auto value = CaseFetcher::FetchN(data, n);
-    return LowercaseBytes(
-               _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&value)))
-        .first;
+    return LowercaseSwar(CaseFetcher::FetchN(data, n));
   }
 
   static inline bool FailFastCompare8(const std::uint8_t* lhs,
@@ -183,16 +188,12 @@ struct CaseInsensitiveSSEFetcher final {
 
 struct CaseInsensitiveFetcher final {
   static inline std::uint64_t Fetch8(const std::uint8_t* data) noexcept {
-    std::array<std::uint8_t, 8> lowercase{};
-    Lowercase(lowercase.data(), data, 8);
-    return CaseFetcher::Fetch8(lowercase.data());
+    return LowercaseSwar(CaseFetcher::Fetch8(data));
   }
 
   static inline std::pair<std::uint64_t, std::uint64_t> Fetch16(
       const std::uint8_t* data) noexcept {
-    std::array<std::uint8_t, 16> lowercase{};
-    Lowercase(lowercase.data(), data, 16);
-    return CaseFetcher::Fetch16(lowercase.data());
+    return {Fetch8(data), Fetch8(data + 8)};
   }
 
   static inline std::uint64_t FetchN(const std::uint8_t* data,
@@ -200,9 +201,7 @@ struct CaseInsensitiveFetcher final {
     // n should be less than 8 by algorithm construction
     UASSERT(n < 8);
 
-    std::array<std::uint8_t, 8> lowercase{};
-    Lowercase(lowercase.data(), data, n);
-    return CaseFetcher::FetchN(lowercase.data(), n);
+    return LowercaseSwar(CaseFetcher::FetchN(data, n));
   }
 
   static inline bool FailFastCompare8(const std::uint8_t* lhs,
@@ -214,16 +213,6 @@ struct CaseInsensitiveFetcher final {
                                        const std::uint8_t* rhs) noexcept {
     return Fetch16(lhs) == Fetch16(rhs);
   }
-
- private:
-  static inline void Lowercase(std::uint8_t* dst, const std::uint8_t* src,
-                               std::size_t len) noexcept {
-    for (std::size_t i = 0; i < len; ++i) {
-      const std::uint8_t c = src[i];
-      const char mask = (c >= 'A' && c <= 'Z') ? 32 : 0;
-      dst[i] = c | mask;
-    }
-  }
 };
 
 template <typename Fetcher>
@@ -268,10 +257,9 @@ std::uint64_t SipHash13(std::uint64_t k0, std::uint64_t k1,
     sip_round();
   };
 
-  // the switch in FetchN is hard to optimize further (and it gets even worse
-  // with lowercase fetcher), so we return early for short strings, and for
-  // strings > 8 we gather the leftover suffix as 8 bytes and shift it to the
-  // right. NOTE: this implies LE.
+  // FetchN is slower than Fetch8, so we use it for short strings only, and
+  // for strings > 8 we gather the leftover suffix as 8 bytes and shift it to
+  // the right. NOTE: this implies LE.
   if (data.size() < 8) {
     b |= Fetcher::FetchN(reinterpret_cast<const std::uint8_t*>(data.data()),
                          data.size());
@@ -366,11 +354,17 @@ inline bool NoCaseEqual(std::string_view lhs, std::string_view rhs) noexcept {
     return false;
   }
 
-  if (lhs.size() < 8) {
-    // we can't do SSE for short strings, so this is actually decently fast.
+  if (lhs.size() < 4) {
     return CompareNaive(lhs, rhs);
   }
 
+  if (lhs.size() < 8) {
+    // too short for SSE, two overlapping loads and lowercasing within
+    // a register are branchless
+    return LowercaseSwar(CaseFetcher::FetchN(ToBytes(lhs), lhs.size())) ==
+           LowercaseSwar(CaseFetcher::FetchN(ToBytes(rhs), rhs.size()));
+  }
+
   auto lhs_suffix = lhs.substr(lhs.size() - 8, 8);
   auto rhs_suffix = rhs.substr(rhs.size() - 8, 8);
 
@@ -390,6 +384,46 @@ inline bool NoCaseEqual(std::string_view lhs, std::string_view rhs) noexcept {
   return lhs.empty() || CompareAndAdvance<Fetcher, 8>(lhs_suffix, rhs_suffix);
 }
 
+// Returns the difference of the first differing lowercased bytes, the words
+// are in LE
+inline int CompareWords(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+  UASSERT(lhs != rhs);
+  const auto shift = __builtin_ctzll(lhs ^ rhs) / 8 * 8;
+  return static_cast<int>((lhs >> shift) & 0xff) -
+         static_cast<int>((rhs >> shift) & 0xff);
+}
+
+template <typename Fetcher>
+int NoCaseCompareThreeWay(std::string_view lhs, std::string_view rhs) noexcept {
+  const auto* const lhs_data = ToBytes(lhs);
+  const auto* const rhs_data = ToBytes(rhs);
+  const auto min_len = std::min(lhs.size(), rhs.size());
+
+  std::size_t i = 0;
+  for (; min_len - i >= 16; i += 16) {
+    const auto [lhs_low, lhs_high] = Fetcher::Fetch16(lhs_data + i);
+    const auto [rhs_low, rhs_high] = Fetcher::Fetch16(rhs_data + i);
+    if (lhs_low != rhs_low) return CompareWords(lhs_low, rhs_low);
+    if (lhs_high != rhs_high) return CompareWords(lhs_high, rhs_high);
+  }
+
+  if (min_len - i >= 8) {
+    const auto lhs_word = Fetcher::Fetch8(lhs_data + i);
+    const auto rhs_word = Fetcher::Fetch8(rhs_data + i);
+    if (lhs_word != rhs_word) return CompareWords(lhs_word, rhs_word);
+    i += 8;
+  }
+
+  if (i != min_len) {
+    const auto lhs_word = Fetcher::FetchN(lhs_data + i, min_len - i);
+    const auto rhs_word = Fetcher::FetchN(rhs_data + i, min_len - i);
+    if (lhs_word != rhs_word) return CompareWords(lhs_word, rhs_word);
+  }
+
+  if (lhs.size() != rhs.size()) return lhs.size() < rhs.size() ? -1 : 1;
+  return 0;
+}
+
 }  // namespace
 
 SipHasher::SipHasher(std::uint64_t k0, std::uint64_t k1) noexcept
@@ -436,6 +470,22 @@ bool CaseInsensitiveEqualNoSse::operator()(std::string_view lhs,
   return NoCaseEqual<CaseInsensitiveFetcher>(lhs, rhs);
 }
 
+int CaseInsensitiveCompareThreeWay::operator()(std::string_view lhs,
+                                               std::string_view rhs) const
+    noexcept {
+#ifdef __SSE2__
+  return NoCaseCompareThreeWay<CaseInsensitiveSSEFetcher>(lhs, rhs);
+#else
+  return CaseInsensitiveCompareThreeWayNoSse{}(lhs, rhs);
+#endif
+}
+
+int CaseInsensitiveCompareThreeWayNoSse::operator()(std::string_view lhs,
+                                                    std::string_view rhs) const
+    noexcept {
+  return NoCaseCompareThreeWay<CaseInsensitiveFetcher>(lhs, rhs);
+}
+
 }  // namespace utils::impl
 
 USERVER_NAMESPACE_END
@@ -57,6 +57,18 @@ class CaseInsensitiveEqualNoSse final {
   bool operator()(std::string_view lhs, std::string_view rhs) const noexcept;
 };
 
+// Compares lowercased bytes as unsigned chars, returns <0 when `lhs < rhs`,
+// >0 when `lhs > rhs` and 0 otherwise.
+class CaseInsensitiveCompareThreeWay final {
+ public:
+  int operator()(std::string_view lhs, std::string_view rhs) const noexcept;
+};
+
+class CaseInsensitiveCompareThreeWayNoSse final {
+ public:
+  int operator()(std::string_view lhs, std::string_view rhs) const noexcept;
+};
+
 }  // namespace utils::impl
 
 USERVER_NAMESPACE_END
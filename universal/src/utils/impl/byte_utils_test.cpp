@@ -1,9 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <cctype>
 #include <cstdint>
 #include <cstring>
+#include <string>
+#include <string_view>
 
 #include <utils/impl/byte_utils.hpp>
 
@@ -366,6 +369,55 @@ void TestCaseInsensitiveEqual() {
   }
 }
 
+int ReferenceCompareThreeWay(std::string_view lhs, std::string_view rhs) {
+  const auto min_len = std::min(lhs.size(), rhs.size());
+  for (std::size_t i = 0; i < min_len; ++i) {
+    const auto a = std::tolower(static_cast<unsigned char>(lhs[i]));
+    const auto b = std::tolower(static_cast<unsigned char>(rhs[i]));
+    if (a != b) return a - b;
+  }
+  if (lhs.size() != rhs.size()) return lhs.size() < rhs.size() ? -1 : 1;
+  return 0;
+}
+
+int Sign(int value) { return (value > 0) - (value < 0); }
+
+template <typename Compare>
+void TestCaseInsensitiveCompareThreeWay() {
+  const Compare cmp{};
+
+  for (std::size_t len = 0; len <= kAllPossibleBytesString.size(); ++len) {
+    const auto lhs = std::string_view{kAllPossibleBytesString}.substr(0, len);
+    ASSERT_EQ(cmp(lhs, lhs), 0);
+
+    // differ in the first byte of each length
+    for (std::size_t diff_at = 0; diff_at < len; ++diff_at) {
+      for (const char replacement : {'\0', 'A', 'z', '\x80', '\xff'}) {
+        std::string rhs{lhs};
+        rhs[diff_at] = replacement;
+        ASSERT_EQ(cmp(lhs, rhs), ReferenceCompareThreeWay(lhs, rhs))
+            << "len=" << len << " diff_at=" << diff_at;
+        ASSERT_EQ(cmp(rhs, lhs), ReferenceCompareThreeWay(rhs, lhs))
+            << "len=" << len << " diff_at=" << diff_at;
+      }
+    }
+
+    // a prefix is less
+    const auto shorter = lhs.substr(0, len / 2);
+    ASSERT_EQ(Sign(cmp(shorter, lhs)), len == 0 ? 0 : -1);
+    ASSERT_EQ(Sign(cmp(lhs, shorter)), len == 0 ? 0 : 1);
+  }
+
+  // strings differ in case only
+  std::string upper{kAllPossibleBytesString};
+  for (auto& c : upper) c = std::toupper(static_cast<unsigned char>(c));
+  for (std::size_t len = 0; len <= upper.size(); ++len) {
+    ASSERT_EQ(cmp(std::string_view{kAllPossibleBytesString}.substr(0, len),
+                  std::string_view{upper}.substr(0, len)),
+              0);
+  }
+}
+
 }  // namespace
 
 TEST(SipHashCase, MatchesReferenceImplementation) {
@@ -390,4 +442,14 @@ TEST(CaseInsensitiveEqualNoSse, Correctness) {
   TestCaseInsensitiveEqual<utils::impl::CaseInsensitiveEqualNoSse>();
 }
 
+TEST(CaseInsensitiveCompareThreeWay, Correctness) {
+  TestCaseInsensitiveCompareThreeWay<
+      utils::impl::CaseInsensitiveCompareThreeWay>();
+}
+
+TEST(CaseInsensitiveCompareThreeWayNoSse, Correctness) {
+  TestCaseInsensitiveCompareThreeWay<
+      utils::impl::CaseInsensitiveCompareThreeWayNoSse>();
+}
+
 USERVER_NAMESPACE_END
@@ -1,6 +1,8 @@
 #include <userver/utils/rand.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 
 #include <userver/compiler/impl/tls.hpp>
 
@@ -13,20 +15,30 @@ namespace {
 // 256 bits of randomness is enough for everyone
 constexpr std::size_t kRandomSeedInts = 8;
 
+template <typename Generator>
+void SeedFromDevice(Generator& gen) {
+  std::random_device device;
+
+  std::array<std::seed_seq::result_type, kRandomSeedInts> random_chunks{};
+  for (auto& random_chunk : random_chunks) {
+    random_chunk = device();
+  }
+
+  std::seed_seq seed(random_chunks.begin(), random_chunks.end());
+  gen.seed(seed);
+}
+
+std::mt19937_64 MakeSeededGenerator64() {
+  // NOLINTNEXTLINE(cert-msc51-cpp)
+  std::mt19937_64 gen;
+  SeedFromDevice(gen);
+  return gen;
+}
+
 class RandomImpl final : public RandomBase {
  public:
   // NOLINTNEXTLINE(cert-msc51-cpp)
-  RandomImpl() {
-    std::random_device device;
-
-    std::array<std::seed_seq::result_type, kRandomSeedInts> random_chunks{};
-    for (auto& random_chunk : random_chunks) {
-      random_chunk = device();
-    }
-
-    std::seed_seq seed(random_chunks.begin(), random_chunks.end());
-    gen_.seed(seed);
-  }
+  RandomImpl() { SeedFromDevice(gen_); }
 
   result_type operator()() override { return gen_(); }
 
@@ -54,6 +66,23 @@ RandomBase& impl::DefaultRandomForHashSeed() {
   return random;
 }
 
+USERVER_IMPL_PREVENT_TLS_CACHING
+void impl::FillRandomBytes(void* dst, std::size_t size) noexcept {
+  thread_local std::mt19937_64 gen = MakeSeededGenerator64();
+
+  // NOLINTNEXTLINE
+  USERVER_IMPL_PREVENT_TLS_CACHING_ASM;
+
+  auto* bytes = static_cast<char*>(dst);
+  while (size != 0) {
+    const std::uint64_t value = gen();
+    const auto chunk = std::min(size, sizeof(value));
+    std::memcpy(bytes, &value, chunk);
+    bytes += chunk;
+    size -= chunk;
+  }
+}
+
 uint32_t Rand() {
   return std::uniform_int_distribution<uint32_t>{0}(DefaultRandom());
 }
@@ -1,7 +1,11 @@
 #include <userver/utils/regex.hpp>
 
+#include <mutex>
+
 #include <boost/regex.hpp>
 
+#include <userver/cache/lru_map.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils {
@@ -30,6 +34,89 @@ regex& regex::operator=(regex&& r) noexcept {
   return *this;
 }
 
+namespace {
+
+constexpr std::size_t kMaxCachedRegexes = 1024;
+
+class RegexCache final {
+ public:
+  regex Get(std::string_view pattern) {
+    std::string key{pattern};
+    {
+      const std::lock_guard lock{mutex_};
+      if (const auto* cached = regexes_.Get(key)) return *cached;
+    }
+
+    // compiled without the lock, concurrent misses of a pattern may compile
+    // it twice
+    regex compiled{pattern};
+    const std::lock_guard lock{mutex_};
+    regexes_.Put(std::move(key), compiled);
+    return compiled;
+  }
+
+ private:
+  std::mutex mutex_;
+  cache::LruMap<std::string, regex> regexes_{kMaxCachedRegexes};
+};
+
+}  // namespace
+
+regex GetCachedRegex(std::string_view pattern) {
+  static RegexCache cache;
+  return cache.Get(pattern);
+}
+
+struct RegexSet::Impl {
+  boost::regex combined;
+  // index of the group that wraps each pattern in the combined regex
+  std::vector<std::size_t> groups;
+};
+
+RegexSet::RegexSet(const std::vector<std::string>& patterns) {
+  std::string combined;
+  std::size_t group = 1;
+  impl_->groups.reserve(patterns.size());
+  for (const auto& pattern : patterns) {
+    // validates the pattern on its own, so that it can not break out of its
+    // group in the combined regex
+    const boost::regex compiled{pattern};
+    if (!combined.empty()) combined += '|';
+    combined += '(';
+    combined += pattern;
+    combined += ')';
+    impl_->groups.push_back(group);
+    group += 1 + compiled.mark_count();
+  }
+  if (!patterns.empty()) impl_->combined.assign(combined);
+}
+
+RegexSet::~RegexSet() = default;
+
+RegexSet::RegexSet(const RegexSet&) = default;
+
+RegexSet::RegexSet(RegexSet&&) noexcept = default;
+
+RegexSet& RegexSet::operator=(const RegexSet&) = default;
+
+RegexSet& RegexSet::operator=(RegexSet&&) noexcept = default;
+
+std::optional<std::size_t> RegexSet::FindFirstMatch(
+    std::string_view str) const {
+  if (impl_->groups.empty()) return std::nullopt;
+
+  boost::match_results<std::string_view::const_iterator> match;
+  if (!boost::regex_match(str.begin(), str.end(), match, impl_->combined)) {
+    return std::nullopt;
+  }
+  for (std::size_t i = 0; i < impl_->groups.size(); ++i) {
+    if (match[impl_->groups[i]].matched) return i;
+  }
+  return std::nullopt;
+}
+
+std::size_t RegexSet::Size() const noexcept { return impl_->groups.size(); }
+
 bool regex_match(std::string_view str, const regex& pattern) {
   return boost::regex_match(str.begin(), str.end(), pattern.impl_->r);
 }
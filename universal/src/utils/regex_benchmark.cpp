@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/utils/regex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kPattern = R"(^/v1/users/([0-9]+)/orders/[a-z]+$)";
+constexpr std::string_view kPath = "/v1/users/123456/orders/pending";
+
+// Patterns of a router, the last one matches kSetPath
+std::vector<std::string> MakeRoutes(std::size_t count) {
+  std::vector<std::string> routes;
+  routes.reserve(count);
+  for (std::size_t i = 0; i + 1 < count; ++i) {
+    routes.push_back(fmt::format("/v{}/items/([0-9]+)", i));
+  }
+  routes.emplace_back("/last/items/([0-9]+)");
+  return routes;
+}
+
+constexpr std::string_view kSetPath = "/last/items/42";
+
+}  // namespace
+
+void regex_compile_and_match(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    const utils::regex r{kPattern};
+    benchmark::DoNotOptimize(utils::regex_match(kPath, r));
+  }
+}
+BENCHMARK(regex_compile_and_match);
+
+void regex_cached_and_match(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    const auto r = utils::GetCachedRegex(kPattern);
+    benchmark::DoNotOptimize(utils::regex_match(kPath, r));
+  }
+}
+BENCHMARK(regex_cached_and_match);
+
+void regex_match_precompiled(benchmark::State& state) {
+  const utils::regex r{kPattern};
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(utils::regex_match(kPath, r));
+  }
+}
+BENCHMARK(regex_match_precompiled);
+
+void regex_match_each_route(benchmark::State& state) {
+  std::vector<utils::regex> routes;
+  for (const auto& route : MakeRoutes(state.range(0))) {
+    routes.emplace_back(route);
+  }
+
+  for ([[maybe_unused]] auto _ : state) {
+    std::size_t index = 0;
+    while (index < routes.size() &&
+           !utils::regex_match(kSetPath, routes[index])) {
+      ++index;
+    }
+    benchmark::DoNotOptimize(index);
+  }
+}
+BENCHMARK(regex_match_each_route)->RangeMultiplier(4)->Range(4, 256);
+
+void regex_match_set(benchmark::State& state) {
+  const utils::RegexSet set{MakeRoutes(state.range(0))};
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(set.FindFirstMatch(kSetPath));
+  }
+}
+BENCHMARK(regex_match_set)->RangeMultiplier(4)->Range(4, 256);
+
+USERVER_NAMESPACE_END
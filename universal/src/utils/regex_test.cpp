@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include <userver/utils/regex.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -35,4 +38,35 @@ TEST(Regex, Search) {
   EXPECT_TRUE(utils::regex_search("a123a", r));
 }
 
+TEST(Regex, Cached) {
+  const auto r1 = utils::GetCachedRegex("^[a-z][0-9]+");
+  const auto r2 = utils::GetCachedRegex("^[a-z][0-9]+");
+  EXPECT_TRUE(utils::regex_match("a123", r1));
+  EXPECT_TRUE(utils::regex_match("a123", r2));
+  EXPECT_FALSE(utils::regex_match("123", r2));
+  EXPECT_ANY_THROW(utils::GetCachedRegex("(unbalanced"));
+}
+
+TEST(RegexSet, FindFirstMatch) {
+  const utils::RegexSet set{
+      {"/v1/(a|b)+", "/v1/.*", "/v2/([0-9]+)/x", "/v2/.*"}};
+  EXPECT_EQ(set.Size(), 4U);
+  EXPECT_EQ(set.FindFirstMatch("/v1/abab"), 0U);
+  EXPECT_EQ(set.FindFirstMatch("/v1/c"), 1U);
+  EXPECT_EQ(set.FindFirstMatch("/v2/12/x"), 2U);
+  EXPECT_EQ(set.FindFirstMatch("/v2/12/y"), 3U);
+  EXPECT_EQ(set.FindFirstMatch("/v3"), std::nullopt);
+  EXPECT_EQ(set.FindFirstMatch("prefix/v1/c"), std::nullopt);
+}
+
+TEST(RegexSet, Empty) {
+  const utils::RegexSet set{std::vector<std::string>{}};
+  EXPECT_EQ(set.Size(), 0U);
+  EXPECT_EQ(set.FindFirstMatch(""), std::nullopt);
+}
+
+TEST(RegexSet, Invalid) {
+  EXPECT_ANY_THROW(utils::RegexSet({"a", "b)|(c"}));
+}
+
 USERVER_NAMESPACE_END
@@ -1,7 +1,5 @@
 #include <userver/utils/str_icase.hpp>
 
-#include <algorithm>  // for std::min
-
 #include <userver/utils/rand.hpp>
 
 #include <utils/impl/byte_utils.hpp>
@@ -10,12 +8,6 @@ USERVER_NAMESPACE_BEGIN
 
 namespace utils {
 
-constexpr std::size_t kUppercaseToLowerMask = 32;
-static_assert((static_cast<std::size_t>('A') | kUppercaseToLowerMask) == 'a');
-static_assert((static_cast<std::size_t>('Z') | kUppercaseToLowerMask) == 'z');
-static_assert((static_cast<std::size_t>('a') | kUppercaseToLowerMask) == 'a');
-static_assert((static_cast<std::size_t>('z') | kUppercaseToLowerMask) == 'z');
-
 StrIcaseHash::StrIcaseHash()
     : StrIcaseHash{HashSeed{std::uniform_int_distribution<std::uint64_t>{}(
                                 impl::DefaultRandomForHashSeed()),
@@ -50,21 +42,7 @@ std::size_t StrCaseHash::operator()(std::string_view s) const& noexcept {
 
 int StrIcaseCompareThreeWay::operator()(std::string_view lhs,
                                         std::string_view rhs) const noexcept {
-  const auto min_len = std::min(lhs.size(), rhs.size());
-  for (std::size_t i = 0; i < min_len; ++i) {
-    unsigned char a = lhs[i];
-    unsigned char b = rhs[i];
-
-    if (a == b) continue;
-    if ('A' <= a && a <= 'Z') a |= kUppercaseToLowerMask;
-    if ('A' <= b && b <= 'Z') b |= kUppercaseToLowerMask;
-    if (a == b) continue;
-
-    return static_cast<int>(a) - static_cast<int>(b);
-  }
-
-  if (lhs.size() != rhs.size()) return lhs.size() < rhs.size() ? -1 : 1;
-  return 0;
+  return impl::CaseInsensitiveCompareThreeWay{}(lhs, rhs);
 }
 
 bool StrIcaseEqual::operator()(std::string_view lhs, std::string_view rhs) const
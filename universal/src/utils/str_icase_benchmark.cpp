@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 
+#include <string>
 #include <vector>
 
 #include <userver/utils/rand.hpp>
@@ -28,8 +29,73 @@ std::string GenerateRandomLowercaseString(std::size_t len) {
   return result;
 }
 
+// Typical HTTP header names, from 4 to 27 chars
+const std::vector<std::string> kHeaderNames{
+    "Host",
+    "Accept",
+    "Cookie",
+    "X-Real-IP",
+    "User-Agent",
+    "Connection",
+    "X-YaTraceId",
+    "Content-Type",
+    "X-YaRequestId",
+    "Cache-Control",
+    "Content-Length",
+    "Accept-Encoding",
+    "Accept-Language",
+    "X-Forwarded-For",
+    "X-Requested-With",
+    "Transfer-Encoding",
+    "Access-Control-Allow-Origin",
+};
+
+std::vector<std::string> SwitchCase(std::vector<std::string> strings) {
+  for (auto& s : strings) {
+    for (auto& c : s) {
+      if (c >= 'a' && c <= 'z') {
+        c = 'A' + (c - 'a');
+      } else if (c >= 'A' && c <= 'Z') {
+        c = 'a' + (c - 'A');
+      }
+    }
+  }
+  return strings;
+}
+
 }  // namespace
 
+template <typename Hasher>
+void HashHeaderNames(benchmark::State& state) {
+  const Hasher hasher{};
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& name : kHeaderNames) {
+      benchmark::DoNotOptimize(hasher(name));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kHeaderNames.size());
+}
+
+BENCHMARK_TEMPLATE(HashHeaderNames, utils::StrCaseHash);
+BENCHMARK_TEMPLATE(HashHeaderNames, utils::StrIcaseHash);
+
+template <typename Compare>
+void CompareHeaderNames(benchmark::State& state) {
+  const auto other_case = SwitchCase(kHeaderNames);
+  const Compare cmp{};
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (std::size_t i = 0; i < kHeaderNames.size(); ++i) {
+      benchmark::DoNotOptimize(cmp(kHeaderNames[i], other_case[i]));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kHeaderNames.size());
+}
+
+BENCHMARK_TEMPLATE(CompareHeaderNames, utils::StrIcaseEqual);
+BENCHMARK_TEMPLATE(CompareHeaderNames, utils::StrIcaseLess);
+
 template <typename Hasher>
 void HashLowercaseString(benchmark::State& state) {
   const Hasher hasher{};
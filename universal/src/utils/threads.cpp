@@ -17,9 +17,15 @@
 #endif
 
 #include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
 
 #include <fmt/format.h>
 
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text_light.hpp>
+
 #include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -79,6 +85,113 @@ void SetCurrentThreadLowPriorityScheduling() {
                       "setting thread scheduling parameters");
 }
 
+void SetCurrentThreadAffinity(const std::vector<std::size_t>& cpus) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      throw std::runtime_error(
+          fmt::format("CPU {} is out of the supported range", cpu));
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  static constexpr ::pid_t kThisThreadPid = 0;
+  utils::CheckSyscall(
+      ::sched_setaffinity(kThisThreadPid, sizeof(cpu_set), &cpu_set),
+      "setting thread CPU affinity");
+#else
+  (void)cpus;
+  throw std::runtime_error("Thread CPU affinity is not supported on this OS");
+#endif
+}
+
+std::vector<std::size_t> GetCurrentThreadAffinity() {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+
+  static constexpr ::pid_t kThisThreadPid = 0;
+  utils::CheckSyscall(
+      ::sched_getaffinity(kThisThreadPid, sizeof(cpu_set), &cpu_set),
+      "getting thread CPU affinity");
+
+  std::vector<std::size_t> result;
+  for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpu_set)) result.push_back(cpu);
+  }
+  return result;
+#else
+  throw std::runtime_error("Thread CPU affinity is not supported on this OS");
+#endif
+}
+
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list) {
+  const auto parse_cpu = [cpu_list](std::string_view cpu) {
+    try {
+      return utils::FromString<std::size_t>(text::Trim(std::string{cpu}));
+    } catch (const std::exception& ex) {
+      throw std::runtime_error(
+          fmt::format("Invalid CPU list '{}': {}", cpu_list, ex.what()));
+    }
+  };
+
+  std::vector<std::size_t> result;
+  if (text::Trim(std::string{cpu_list}).empty()) return result;
+
+  std::string_view rest = cpu_list;
+  while (true) {
+    const auto comma_pos = rest.find(',');
+    const auto item = rest.substr(0, comma_pos);
+    const auto dash_pos = item.find('-');
+
+    if (dash_pos == std::string_view::npos) {
+      result.push_back(parse_cpu(item));
+    } else {
+      const auto first = parse_cpu(item.substr(0, dash_pos));
+      const auto last = parse_cpu(item.substr(dash_pos + 1));
+      if (first > last) {
+        throw std::runtime_error(
+            fmt::format("Invalid CPU list '{}': range {}-{} is empty",
+                        cpu_list, first, last));
+      }
+      for (auto cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+    }
+
+    if (comma_pos == std::string_view::npos) break;
+    rest.remove_prefix(comma_pos + 1);
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t node) {
+#ifdef __linux__
+  const auto path =
+      fmt::format("/sys/devices/system/node/node{}/cpulist", node);
+  std::ifstream file(path);
+  std::string cpu_list;
+  if (!file || !std::getline(file, cpu_list)) {
+    throw std::runtime_error(
+        fmt::format("Failed to read CPUs of NUMA node {} from {}", node, path));
+  }
+
+  auto cpus = ParseCpuList(cpu_list);
+  if (cpus.empty()) {
+    throw std::runtime_error(fmt::format("NUMA node {} has no CPUs", node));
+  }
+  return cpus;
+#else
+  throw std::runtime_error(fmt::format(
+      "NUMA node {} CPUs could not be detected: NUMA is not supported on this "
+      "OS",
+      node));
+#endif
+}
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,9 @@
 #include <userver/utils/threads.hpp>
 
+#include <sched.h>
 #include <sys/resource.h>
+#include <algorithm>
+#include <stdexcept>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -28,4 +31,51 @@ TEST(Threads, NotMainThreadLowPriority) {
   EXPECT_EQ(main_priority, ::getpriority(PRIO_PROCESS, 0));
 }
 
+TEST(Threads, ParseCpuList) {
+  using Cpus = std::vector<std::size_t>;
+  EXPECT_EQ(utils::ParseCpuList(""), Cpus{});
+  EXPECT_EQ(utils::ParseCpuList("0"), Cpus{0});
+  EXPECT_EQ(utils::ParseCpuList("0-3"), (Cpus{0, 1, 2, 3}));
+  EXPECT_EQ(utils::ParseCpuList("8,0-2,10-11\n"), (Cpus{0, 1, 2, 8, 10, 11}));
+  EXPECT_EQ(utils::ParseCpuList("1,1,0-1"), (Cpus{0, 1}));
+
+  EXPECT_THROW(utils::ParseCpuList("3-1"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("a"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("1,"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("-1"), std::runtime_error);
+}
+
+#ifdef __linux__
+TEST(Threads, SetCurrentThreadAffinity) {
+  std::thread another_thread([] {
+    cpu_set_t initial_set;
+    ASSERT_EQ(::sched_getaffinity(0, sizeof(initial_set), &initial_set), 0);
+
+    std::size_t allowed_cpu = 0;
+    while (!CPU_ISSET(allowed_cpu, &initial_set)) ++allowed_cpu;
+
+    utils::SetCurrentThreadAffinity({allowed_cpu});
+
+    cpu_set_t new_set;
+    ASSERT_EQ(::sched_getaffinity(0, sizeof(new_set), &new_set), 0);
+    EXPECT_EQ(CPU_COUNT(&new_set), 1);
+    EXPECT_TRUE(CPU_ISSET(allowed_cpu, &new_set));
+  });
+  another_thread.join();
+}
+
+TEST(Threads, GetCurrentThreadAffinity) {
+  std::thread another_thread([] {
+    const auto initial_cpus = utils::GetCurrentThreadAffinity();
+    ASSERT_FALSE(initial_cpus.empty());
+    EXPECT_TRUE(std::is_sorted(initial_cpus.begin(), initial_cpus.end()));
+
+    utils::SetCurrentThreadAffinity({initial_cpus.back()});
+    EXPECT_EQ(utils::GetCurrentThreadAffinity(),
+              std::vector<std::size_t>{initial_cpus.back()});
+  });
+  another_thread.join();
+}
+#endif
+
 USERVER_NAMESPACE_END
@@ -6,6 +6,7 @@
 
 #include <benchmark/benchmark.h>
 
+#include <userver/http/predefined_header.hpp>
 #include <utils/gbench_auxilary.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -447,6 +448,37 @@ void MappingHugeUnorderedLast(benchmark::State& state) {
 }
 BENCHMARK(MappingHugeUnorderedLast);
 
+void MappingHugeTrivialBiMapICase(benchmark::State& state) {
+  auto hello = MyLaunder("AAAAAAAAAAAAAAAA_HELLO");
+  auto f9 = MyLaunder("aaaaaaaaaaaaaaaa_F9");
+  auto z9 = MyLaunder("Aaaaaaaaaaaaaaaa_z9");
+  auto missing = MyLaunder("aaaaaaaaaaaaaaaa_y9");
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(kHugeTrivialBiMap.TryFindICase(hello));
+    benchmark::DoNotOptimize(kHugeTrivialBiMap.TryFindICase(f9));
+    benchmark::DoNotOptimize(kHugeTrivialBiMap.TryFindICase(z9));
+    benchmark::DoNotOptimize(kHugeTrivialBiMap.TryFindICase(missing));
+  }
+}
+BENCHMARK(MappingHugeTrivialBiMapICase);
+
+void MappingKnownHeadersICase(benchmark::State& state) {
+  auto content_type = MyLaunder("Content-Type");
+  auto trace_id = MyLaunder("X-YaTraceId");
+  auto span_id = MyLaunder("X-B3-SpanId");
+  auto unknown = MyLaunder("X-Custom-Header");
+
+  const auto& map = http::headers::impl::kKnownHeadersLowercaseMap;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(map.TryFindICaseByFirst(content_type));
+    benchmark::DoNotOptimize(map.TryFindICaseByFirst(trace_id));
+    benchmark::DoNotOptimize(map.TryFindICaseByFirst(span_id));
+    benchmark::DoNotOptimize(map.TryFindICaseByFirst(unknown));
+  }
+}
+BENCHMARK(MappingKnownHeadersICase);
+
 void MappingEnumsTrivialBiMap(benchmark::State& state) {
   const auto enum2 = Launder(Enum2::C7);
 
@@ -333,4 +333,146 @@ TEST(TrivialBiMap, StringICase) {
       "\xf0\xe1\xf2\xf3\xf4\xf5\xf6\xf7\xf8\xf9\xfa\xfb\xfc\xfd\xfe\xff"));
 }
 
+constexpr std::string_view kLargeMapKeys[] = {
+    "content-type",  "content-length", "content-encoding", "host",
+    "accept",        "user-agent",     "date",             "warning",
+    "server",        "set-cookie",     "cookie",           "connection",
+    "allow",         "baggage",        "traceparent",      "tracestate",
+    "x-b3-traceid",  "x-b3-spanid",    "x-b3-sampled",     "x-requestid",
+    "key-00",        "key-01",         "key-02",           "key-03",
+    "key-04",        "key-05",         "key-06",           "key-07",
+    "key-08",        "key-09",         "key-10",           "key-11",
+    "key-12",        "key-13",         "key-14",           "key-15",
+    "host",          "key-16",         "key-17",           "key-18",
+};
+
+constexpr std::string_view kLargeMapValues[] = {
+    "v00", "v01", "v02", "v03", "v04", "v05", "v06", "v07", "v08", "v09",
+    "v10", "v11", "v12", "v13", "v14", "v15", "v16", "v17", "v18", "v19",
+    "v20", "v21", "v22", "v23", "v24", "v25", "v26", "v27", "v28", "v29",
+    "v30", "v31", "v32", "v33", "v34", "v35", "v36", "v37", "v38", "v39",
+};
+
+TEST(TrivialBiMap, Large) {
+  static constexpr auto kMap =
+      utils::MakeTrivialBiMap<kLargeMapKeys, kLargeMapValues>();
+  static_assert(kMap.size() == 40);
+  static_assert(kMap.TryFindByFirst("key-13") == "v33");
+  static_assert(kMap.TryFindBySecond("v33") == "key-13");
+
+  for (std::size_t i = 0; i < std::size(kLargeMapKeys); ++i) {
+    // The first Case wins for the duplicate "host"
+    const auto expected =
+        kLargeMapKeys[i] == "host" ? "v03" : kLargeMapValues[i];
+    EXPECT_EQ(kMap.TryFindByFirst(kLargeMapKeys[i]), expected);
+    EXPECT_EQ(kMap.TryFindBySecond(kLargeMapValues[i]), kLargeMapKeys[i]);
+  }
+
+  EXPECT_EQ(kMap.TryFindByFirst("key-19"), std::nullopt);
+  EXPECT_EQ(kMap.TryFindByFirst("Content-Type"), std::nullopt);
+  EXPECT_EQ(kMap.TryFindByFirst(""), std::nullopt);
+  EXPECT_EQ(kMap.TryFindBySecond("v40"), std::nullopt);
+
+  EXPECT_EQ(kMap.TryFindICaseByFirst("Content-Type"), "v00");
+  EXPECT_EQ(kMap.TryFindICaseByFirst("X-B3-SPANID"), "v17");
+  EXPECT_EQ(kMap.TryFindICaseByFirst("X-B3-SPANID2"), std::nullopt);
+  EXPECT_EQ(kMap.TryFindICaseBySecond("V39"), "key-18");
+}
+
+TEST(TrivialBiMap, LargeToInt) {
+  static constexpr utils::TrivialBiMap kMap = [](auto selector) {
+    return selector()
+        .Case("a0", 0)
+        .Case("a1", 1)
+        .Case("a2", 2)
+        .Case("a3", 3)
+        .Case("a4", 4)
+        .Case("a5", 5)
+        .Case("a6", 6)
+        .Case("a7", 7)
+        .Case("a8", 8)
+        .Case("a9", 9)
+        .Case("b0", 10)
+        .Case("b1", 11)
+        .Case("b2", 12)
+        .Case("b3", 13)
+        .Case("b4", 14)
+        .Case("b5", 15)
+        .Case("b6", 16)
+        .Case("b7", 17)
+        .Case("b8", 18)
+        .Case("b9", 19)
+        .Case("c0", 20)
+        .Case("c1", 21)
+        .Case("c2", 22)
+        .Case("c3", 23)
+        .Case("c4", 24)
+        .Case("c5", 25)
+        .Case("c6", 26)
+        .Case("c7", 27)
+        .Case("c8", 28)
+        .Case("c9", 29)
+        .Case("d0", 30)
+        .Case("d1", 31)
+        .Case("d2", 32);
+  };
+  static_assert(kMap.size() == 33);
+  static_assert(kMap.TryFind("d2") == 32);
+  static_assert(kMap.TryFind(32) == "d2");
+
+  EXPECT_EQ(kMap.TryFind("b7"), 17);
+  EXPECT_EQ(kMap.TryFindICase("B7"), 17);
+  EXPECT_EQ(kMap.TryFind("B7"), std::nullopt);
+  EXPECT_EQ(kMap.TryFind("e0"), std::nullopt);
+  EXPECT_EQ(kMap.TryFind(17), "b7");
+  EXPECT_EQ(kMap.TryFind(33), std::nullopt);
+}
+
+TEST(TrivialSet, Large) {
+  static constexpr utils::TrivialSet kSet = [](auto selector) {
+    return selector()
+        .Case("a0")
+        .Case("a1")
+        .Case("a2")
+        .Case("a3")
+        .Case("a4")
+        .Case("a5")
+        .Case("a6")
+        .Case("a7")
+        .Case("a8")
+        .Case("a9")
+        .Case("b0")
+        .Case("b1")
+        .Case("b2")
+        .Case("b3")
+        .Case("b4")
+        .Case("b5")
+        .Case("b6")
+        .Case("b7")
+        .Case("b8")
+        .Case("b9")
+        .Case("c0")
+        .Case("c1")
+        .Case("c2")
+        .Case("c3")
+        .Case("c4")
+        .Case("c5")
+        .Case("c6")
+        .Case("c7")
+        .Case("c8")
+        .Case("c9")
+        .Case("d0")
+        .Case("d1")
+        .Case("d2");
+  };
+  static_assert(kSet.size() == 33);
+  static_assert(kSet.Contains("d2"));
+
+  EXPECT_TRUE(kSet.Contains("c5"));
+  EXPECT_FALSE(kSet.Contains("C5"));
+  EXPECT_FALSE(kSet.Contains("e0"));
+  EXPECT_TRUE(kSet.ContainsICase("C5"));
+  EXPECT_FALSE(kSet.ContainsICase("E0"));
+}
+
 USERVER_NAMESPACE_END
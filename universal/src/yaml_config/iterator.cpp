@@ -50,7 +50,8 @@ void Iterator<iter_traits>::UpdateValue() const {
     current_ = (*container_)[it_.GetIndex()];
   } else {
     UASSERT(it_.GetIteratorType() == formats::common::Type::kObject);
-    current_ = (*container_)[it_.GetName()];
+    // The member lookup by name is linear in the number of members
+    current_ = container_->MakeMember(it_.GetName(), *it_);
   }
 }
 
@@ -83,6 +83,11 @@ YamlConfig::YamlConfig(formats::yaml::Value yaml,
 const formats::yaml::Value& YamlConfig::Yaml() const { return yaml_; }
 
 YamlConfig YamlConfig::operator[](std::string_view key) const {
+  return MakeMember(key, yaml_[key]);
+}
+
+YamlConfig YamlConfig::MakeMember(std::string_view key,
+                                  formats::yaml::Value value) const {
   if (boost::algorithm::ends_with(key, "#env")) {
     auto env_value = GetFromEnvByKey(key, yaml_, mode_);
     if (env_value) {
@@ -94,8 +99,6 @@ YamlConfig YamlConfig::operator[](std::string_view key) const {
     return MakeMissingConfig(*this, key);
   }
 
-  auto value = yaml_[key];
-
   if (IsSubstitution(value)) {
     const auto var_name = GetSubstitutionVarName(value);
 
@@ -572,4 +572,44 @@ TEST(YamlConfig, IteratorArray) {
   EXPECT_NE(cit, it);
 }
 
+TEST(YamlConfig, IteratorObject) {
+  auto vmap = formats::yaml::FromString(R"(
+    int: 42
+  )");
+
+  auto node = formats::yaml::FromString(R"(
+    root:
+      plain: hello
+      substituted: $int
+      missing: $unknown
+      missing#fallback: 10
+      nested:
+        value: $int
+  )");
+  yaml_config::YamlConfig conf(std::move(node), std::move(vmap));
+
+  std::size_t count = 0;
+  for (const auto& [name, value] : Items(conf["root"])) {
+    ++count;
+    // Iteration applies the same substitutions as the lookup by name
+    EXPECT_EQ(formats::yaml::ToString(value.Yaml()),
+              formats::yaml::ToString(conf["root"][name].Yaml()))
+        << name;
+    EXPECT_EQ(value.GetPath(), conf["root"][name].GetPath()) << name;
+  }
+  EXPECT_EQ(count, 5);
+
+  const auto root = conf["root"];
+  auto it = root.begin();
+  EXPECT_EQ(it->As<std::string>(), "hello");
+  ++it;
+  EXPECT_EQ(it->As<int>(), 42);
+  ++it;
+  EXPECT_EQ(it->As<int>(), 10);
+  ++it;
+  EXPECT_EQ(it->As<int>(), 10);
+  ++it;
+  EXPECT_EQ((*it)["value"].As<int>(), 42);
+}
+
 USERVER_NAMESPACE_END